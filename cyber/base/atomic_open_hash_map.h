@@ -0,0 +1,326 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_ATOMIC_OPEN_HASH_MAP_H_
+#define CYBER_BASE_ATOMIC_OPEN_HASH_MAP_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+/**
+ * @brief A lock-free hash map with open addressing that grows
+ *
+ * Keys live in one linear probing table. When it is half full the next
+ * writer publishes a table twice as large and writers move the entries
+ * over a chunk at a time; until the old table is drained readers look in
+ * the new table first and fall back to the old one, so nobody waits for
+ * the move. Erase leaves a tombstone that a later Set of the key reuses and
+ * the next growth drops. Like AtomicHashMap a value pointer handed out by
+ * Get stays valid until the map is destroyed, replaced and erased values
+ * are only freed then.
+ *
+ * @tparam K Type of key, must be integral
+ * @tparam V Type of value
+ * @tparam InitSize Size of the first table, a power of two
+ */
+template <typename K, typename V, std::size_t InitSize = 128,
+          typename std::enable_if<std::is_integral<K>::value &&
+                                      (InitSize & (InitSize - 1)) == 0,
+                                  int>::type = 0>
+class AtomicOpenHashMap {
+ public:
+  AtomicOpenHashMap() : table_(new Table(std::max<std::size_t>(InitSize, 2))) {}
+  AtomicOpenHashMap(const AtomicOpenHashMap &other) = delete;
+  AtomicOpenHashMap &operator=(const AtomicOpenHashMap &other) = delete;
+
+  ~AtomicOpenHashMap() {
+    Table *table = table_.load(std::memory_order_acquire);
+    Table *older = table->older.load(std::memory_order_acquire);
+    delete table;
+    delete older;
+    table = retired_tables_.load(std::memory_order_acquire);
+    while (table != nullptr) {
+      Table *next = table->retired_next;
+      delete table;
+      table = next;
+    }
+    ValueNode *node = values_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      ValueNode *next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  bool Has(K key) {
+    V *value = nullptr;
+    return Get(key, &value);
+  }
+
+  bool Get(K key, V **value) {
+    uint64_t hash = Hash(key);
+    Table *table = table_.load(std::memory_order_acquire);
+    // loaded before the probe: once the older table is gone, all of its
+    // entries are in table
+    Table *older = table->older.load(std::memory_order_acquire);
+    V *val = Lookup(table, key, hash);
+    if (val == nullptr && older != nullptr) {
+      val = Lookup(older, key, hash);
+    }
+    if (val == nullptr || val == Erased()) {
+      return false;
+    }
+    *value = val;
+    return true;
+  }
+
+  bool Get(K key, V *value) {
+    V *val = nullptr;
+    bool res = Get(key, &val);
+    if (res) {
+      *value = *val;
+    }
+    return res;
+  }
+
+  void Set(K key) { Store(key, NewValue()); }
+
+  void Set(K key, const V &value) { Store(key, NewValue(value)); }
+
+  void Set(K key, V &&value) { Store(key, NewValue(std::forward<V>(value))); }
+
+  // returns false if the key was not there
+  bool Erase(K key) {
+    if (!Has(key)) {
+      return false;
+    }
+    Store(key, Erased());
+    return true;
+  }
+
+ private:
+  enum SlotState : uint32_t { EMPTY = 0, BUSY = 1, FULL = 2 };
+
+  static const std::size_t kMigrateChunk = 64;
+
+  struct Slot {
+    std::atomic<uint32_t> state = {EMPTY};
+    K key = 0;
+    // nullptr until the first store, look in the older table then
+    std::atomic<V *> value = {nullptr};
+  };
+
+  struct Table {
+    explicit Table(std::size_t size)
+        : capacity(size), mask(size - 1), slots(new Slot[size]) {}
+    ~Table() { delete[] slots; }
+
+    const std::size_t capacity;
+    const std::size_t mask;
+    Slot *slots;
+    // slots taken, the table takes no new key at half the capacity
+    std::atomic<std::size_t> used = {0};
+    // the table being moved into this one
+    std::atomic<Table *> older = {nullptr};
+    // chunks of this table claimed and done by the movers
+    std::atomic<std::size_t> next_chunk = {0};
+    std::atomic<std::size_t> done_chunks = {0};
+    Table *retired_next = nullptr;
+  };
+
+  // every value ever stored, freed with the map
+  struct ValueNode {
+    template <typename... Args>
+    explicit ValueNode(Args &&... args) : value(std::forward<Args>(args)...) {}
+
+    V value;
+    ValueNode *next = nullptr;
+  };
+
+  static V *Erased() {
+    return reinterpret_cast<V *>(static_cast<uintptr_t>(1));
+  }
+
+  static uint64_t Hash(K key) {
+    // murmur3 finalizer, ids that are already hashes lose nothing and small
+    // sequential ids do not end up in one run
+    uint64_t h = static_cast<uint64_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  static uint32_t WaitFull(Slot *slot, uint32_t state) {
+    while (unlikely(state == BUSY)) {
+      cpu_relax();
+      state = slot->state.load(std::memory_order_acquire);
+    }
+    return state;
+  }
+
+  // the value of key in table, nullptr if table has none
+  static V *Lookup(Table *table, K key, uint64_t hash) {
+    for (std::size_t i = 0; i < table->capacity; ++i) {
+      Slot *slot = &table->slots[(hash + i) & table->mask];
+      uint32_t state =
+          WaitFull(slot, slot->state.load(std::memory_order_acquire));
+      if (state == EMPTY) {
+        return nullptr;
+      }
+      if (slot->key == key) {
+        return slot->value.load(std::memory_order_acquire);
+      }
+    }
+    return nullptr;
+  }
+
+  // finds or claims the slot of key, nullptr if the table is closed for new
+  // keys unless force is set
+  static Slot *FindOrInsert(Table *table, K key, uint64_t hash, bool force) {
+    for (std::size_t i = 0; i < table->capacity; ++i) {
+      Slot *slot = &table->slots[(hash + i) & table->mask];
+      uint32_t state = slot->state.load(std::memory_order_acquire);
+      if (state == EMPTY) {
+        if (!force && table->used.load(std::memory_order_relaxed) >=
+                          table->capacity / 2) {
+          return nullptr;
+        }
+        if (slot->state.compare_exchange_strong(state, BUSY,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+          table->used.fetch_add(1, std::memory_order_relaxed);
+          slot->key = key;
+          slot->state.store(FULL, std::memory_order_release);
+          return slot;
+        }
+      }
+      if (WaitFull(slot, state) == FULL && slot->key == key) {
+        return slot;
+      }
+    }
+    return nullptr;
+  }
+
+  void Store(K key, V *value) {
+    uint64_t hash = Hash(key);
+    while (true) {
+      Table *table = table_.load(std::memory_order_seq_cst);
+      if (table->older.load(std::memory_order_acquire) != nullptr) {
+        Migrate(table, 1);
+      }
+      Slot *slot = FindOrInsert(table, key, hash, false);
+      if (slot == nullptr) {
+        Grow(table);
+        continue;
+      }
+      slot->value.store(value, std::memory_order_seq_cst);
+      // a mover may have passed the slot already, store into the new table
+      if (table_.load(std::memory_order_seq_cst) == table) {
+        return;
+      }
+    }
+  }
+
+  void Grow(Table *table) {
+    // never more than two tables
+    Migrate(table, table->capacity);
+    Table *grown = new Table(table->capacity * 2);
+    grown->older.store(table, std::memory_order_relaxed);
+    Table *expected = table;
+    if (!table_.compare_exchange_strong(expected, grown,
+                                        std::memory_order_seq_cst)) {
+      delete grown;
+      return;
+    }
+    Migrate(grown, grown->capacity);
+  }
+
+  // moves up to max_chunks chunks of the older table of table into it
+  void Migrate(Table *table, std::size_t max_chunks) {
+    Table *older = table->older.load(std::memory_order_acquire);
+    if (older == nullptr) {
+      return;
+    }
+    std::size_t chunk_num = (older->capacity + kMigrateChunk - 1) /
+                            kMigrateChunk;
+    for (std::size_t n = 0; n < max_chunks; ++n) {
+      std::size_t chunk = older->next_chunk.fetch_add(1);
+      if (chunk >= chunk_num) {
+        return;
+      }
+      std::size_t end = std::min(older->capacity, (chunk + 1) * kMigrateChunk);
+      for (std::size_t i = chunk * kMigrateChunk; i < end; ++i) {
+        Slot *slot = &older->slots[i];
+        uint32_t state =
+            WaitFull(slot, slot->state.load(std::memory_order_acquire));
+        if (state != FULL) {
+          continue;
+        }
+        V *value = slot->value.load(std::memory_order_seq_cst);
+        if (value == nullptr || value == Erased()) {
+          continue;
+        }
+        Slot *moved =
+            FindOrInsert(table, slot->key, Hash(slot->key), true);
+        V *expected = nullptr;
+        // a newer store into table wins
+        moved->value.compare_exchange_strong(expected, value,
+                                             std::memory_order_seq_cst);
+      }
+      if (older->done_chunks.fetch_add(1) + 1 == chunk_num) {
+        table->older.store(nullptr, std::memory_order_release);
+        older->retired_next = retired_tables_.load(std::memory_order_relaxed);
+        while (!retired_tables_.compare_exchange_weak(
+            older->retired_next, older, std::memory_order_release,
+            std::memory_order_relaxed)) {
+        }
+        return;
+      }
+    }
+  }
+
+  template <typename... Args>
+  V *NewValue(Args &&... args) {
+    ValueNode *node = new ValueNode(std::forward<Args>(args)...);
+    node->next = values_.load(std::memory_order_relaxed);
+    while (!values_.compare_exchange_weak(node->next, node,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    return &node->value;
+  }
+
+  std::atomic<Table *> table_;
+  std::atomic<Table *> retired_tables_ = {nullptr};
+  std::atomic<ValueNode *> values_ = {nullptr};
+};
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_ATOMIC_OPEN_HASH_MAP_H_
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/atomic_open_hash_map.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(AtomicOpenHashMapTest, int_int) {
+  AtomicOpenHashMap<int, int, 16> map;
+  int value = 0;
+  for (int i = 0; i < 1000; i++) {
+    map.Set(i, i);
+    EXPECT_TRUE(map.Has(i));
+    EXPECT_TRUE(map.Get(i, &value));
+    EXPECT_EQ(i, value);
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    map.Set(1000 - i, i);
+    EXPECT_TRUE(map.Has(1000 - i));
+    EXPECT_TRUE(map.Get(1000 - i, &value));
+    EXPECT_EQ(i, value);
+  }
+}
+
+TEST(AtomicOpenHashMapTest, int_str) {
+  AtomicOpenHashMap<uint64_t, std::string> map;
+  std::string value("");
+  for (uint64_t i = 0; i < 1000; i++) {
+    map.Set(i << 40, std::to_string(i));
+    EXPECT_TRUE(map.Has(i << 40));
+    EXPECT_TRUE(map.Get(i << 40, &value));
+    EXPECT_EQ(std::to_string(i), value);
+  }
+  map.Set(100);
+  EXPECT_TRUE(map.Get(100, &value));
+  EXPECT_TRUE(value.empty());
+  map.Set(100, std::move(std::string("test")));
+  EXPECT_TRUE(map.Get(100, &value));
+  EXPECT_EQ("test", value);
+}
+
+TEST(AtomicOpenHashMapTest, erase) {
+  AtomicOpenHashMap<int, std::string, 16> map;
+  for (int i = 0; i < 100; i++) {
+    map.Set(i, std::to_string(i));
+  }
+  std::string* str = nullptr;
+  EXPECT_TRUE(map.Get(42, &str));
+  EXPECT_TRUE(map.Erase(42));
+  EXPECT_FALSE(map.Erase(42));
+  EXPECT_FALSE(map.Erase(100));
+  EXPECT_FALSE(map.Has(42));
+  EXPECT_FALSE(map.Get(42, &str));
+  // still valid after the erase
+  EXPECT_EQ("42", *str);
+
+  map.Set(42, "again");
+  std::string value;
+  EXPECT_TRUE(map.Get(42, &value));
+  EXPECT_EQ("again", value);
+}
+
+TEST(AtomicOpenHashMapTest, concurrency) {
+  AtomicOpenHashMap<int, std::string, 16> map;
+  int thread_num = 32;
+  std::thread t[32];
+  std::atomic<bool> ready = {false};
+  std::atomic<bool> done = {false};
+
+  // a reader racing the growth must see every key it saw once
+  std::thread reader([&]() {
+    while (!done.load()) {
+      std::string* str = nullptr;
+      if (map.Get(0, &str)) {
+        EXPECT_EQ("0", *str);
+        EXPECT_TRUE(map.Has(0));
+      }
+    }
+  });
+  for (int i = 0; i < thread_num; i++) {
+    t[i] = std::thread([&, i]() {
+      while (!ready.load()) {
+        asm volatile("rep; nop" ::: "memory");
+      }
+      for (int j = 0; j < thread_num * 128; j++) {
+        map.Set(j, std::to_string(j));
+      }
+    });
+  }
+  ready = true;
+  for (int i = 0; i < thread_num; i++) {
+    t[i].join();
+  }
+  done = true;
+  reader.join();
+
+  std::string value("");
+  for (int i = 0; i < thread_num * 128; i++) {
+    EXPECT_TRUE(map.Get(i, &value));
+    EXPECT_EQ(std::to_string(i), value);
+  }
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
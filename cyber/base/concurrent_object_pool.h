@@ -17,6 +17,7 @@
 #ifndef CYBER_BASE_CONCURRENT_OBJECT_POOL_H_
 #define CYBER_BASE_CONCURRENT_OBJECT_POOL_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <cstring>
@@ -32,6 +33,11 @@ namespace apollo {
 namespace cyber {
 namespace base {
 
+// Lock-free fixed size pool. In front of the shared free list every thread
+// has a magazine, a small cache it gets from and releases to; magazines are
+// refilled and flushed half at a time with a single CAS on the free list.
+// A thread finding both empty takes from the magazines of the others, so
+// no object is stranded. Pools too small to spare the magazines skip them.
 template <typename T>
 class CCObjectPool : public std::enable_shared_from_this<CCObjectPool<T>> {
  public:
@@ -59,18 +65,54 @@ class CCObjectPool : public std::enable_shared_from_this<CCObjectPool<T>> {
     Node *node;
   };
 
+  static const uint32_t kMagazineNum = 16;
+  static const uint32_t kMaxMagazineSize = 32;
+
+  struct alignas(CACHELINE_SIZE) Magazine {
+    void Lock() {
+      while (flag.test_and_set(std::memory_order_acquire)) {
+        cpu_relax();
+      }
+    }
+    void Unlock() { flag.clear(std::memory_order_release); }
+
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    uint32_t count = 0;
+    Node *nodes[kMaxMagazineSize];
+  };
+
  private:
   CCObjectPool(CCObjectPool &) = delete;
   CCObjectPool &operator=(CCObjectPool &) = delete;
   bool FindFreeHead(Head *head);
+  Node *GetNode();
+  uint32_t PopNodes(uint32_t num, Node **nodes);
+  void PushNodes(Node *first, Node *last);
+
+  static uint32_t MagazineIndex() {
+    static std::atomic<uint32_t> next_index = {0};
+    static thread_local uint32_t index =
+        next_index.fetch_add(1, std::memory_order_relaxed) % kMagazineNum;
+    return index;
+  }
 
   std::atomic<Head> free_head_;
   Node *node_arena_ = nullptr;
   uint32_t capacity_ = 0;
+  uint32_t magazine_size_ = 0;
+  Magazine magazines_[kMagazineNum];
 };
 
 template <typename T>
-CCObjectPool<T>::CCObjectPool(uint32_t size) : capacity_(size) {
+const uint32_t CCObjectPool<T>::kMagazineNum;
+
+template <typename T>
+const uint32_t CCObjectPool<T>::kMaxMagazineSize;
+
+template <typename T>
+CCObjectPool<T>::CCObjectPool(uint32_t size)
+    : capacity_(size),
+      magazine_size_(std::min(kMaxMagazineSize, size / (2 * kMagazineNum))) {
   node_arena_ = static_cast<Node *>(CheckedCalloc(capacity_, sizeof(Node)));
   FOR_EACH(i, 0, capacity_ - 1) { node_arena_[i].next = node_arena_ + 1 + i; }
   node_arena_[capacity_ - 1].next = nullptr;
@@ -107,26 +149,102 @@ bool CCObjectPool<T>::FindFreeHead(Head *head) {
   return true;
 }
 
+template <typename T>
+uint32_t CCObjectPool<T>::PopNodes(uint32_t num, Node **nodes) {
+  Head new_head;
+  Head old_head = free_head_.load(std::memory_order_acquire);
+  uint32_t count = 0;
+  do {
+    if (unlikely(old_head.node == nullptr)) {
+      return 0;
+    }
+    // the chain may change under us, the count makes such a CAS fail
+    Node *last = old_head.node;
+    count = 1;
+    while (count < num && last->next != nullptr) {
+      last = last->next;
+      ++count;
+    }
+    new_head.node = last->next;
+    new_head.count = old_head.count + 1;
+  } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+  Node *node = old_head.node;
+  FOR_EACH(i, 0, count) {
+    nodes[i] = node;
+    node = node->next;
+  }
+  return count;
+}
+
+template <typename T>
+void CCObjectPool<T>::PushNodes(Node *first, Node *last) {
+  Head new_head;
+  Head old_head = free_head_.load(std::memory_order_acquire);
+  do {
+    last->next = old_head.node;
+    new_head.node = first;
+    new_head.count = old_head.count + 1;
+  } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+}
+
+template <typename T>
+typename CCObjectPool<T>::Node *CCObjectPool<T>::GetNode() {
+  if (magazine_size_ == 0) {
+    Head free_head;
+    return FindFreeHead(&free_head) ? free_head.node : nullptr;
+  }
+
+  auto &magazine = magazines_[MagazineIndex()];
+  Node *node = nullptr;
+  magazine.Lock();
+  if (magazine.count == 0) {
+    magazine.count = PopNodes(magazine_size_ / 2 + 1, magazine.nodes);
+  }
+  if (likely(magazine.count > 0)) {
+    node = magazine.nodes[--magazine.count];
+  }
+  magazine.Unlock();
+  if (likely(node != nullptr)) {
+    return node;
+  }
+
+  for (auto &other : magazines_) {
+    other.Lock();
+    if (other.count > 0) {
+      node = other.nodes[--other.count];
+    }
+    other.Unlock();
+    if (node != nullptr) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
 template <typename T>
 std::shared_ptr<T> CCObjectPool<T>::GetObject() {
-  Head free_head;
-  if (unlikely(!FindFreeHead(&free_head))) {
+  Node *node = GetNode();
+  if (unlikely(node == nullptr)) {
     return nullptr;
   }
   auto self = this->shared_from_this();
-  return std::shared_ptr<T>(reinterpret_cast<T *>(free_head.node),
+  return std::shared_ptr<T>(reinterpret_cast<T *>(node),
                             [self](T *object) { self->ReleaseObject(object); });
 }
 
 template <typename T>
 template <typename... Args>
 std::shared_ptr<T> CCObjectPool<T>::ConstructObject(Args &&... args) {
-  Head free_head;
-  if (unlikely(!FindFreeHead(&free_head))) {
+  Node *node = GetNode();
+  if (unlikely(node == nullptr)) {
     return nullptr;
   }
   auto self = this->shared_from_this();
-  T *ptr = new (free_head.node) T(std::forward<Args>(args)...);
+  T *ptr = new (node) T(std::forward<Args>(args)...);
   return std::shared_ptr<T>(ptr, [self](T *object) {
     object->~T();
     self->ReleaseObject(object);
@@ -135,16 +253,25 @@ std::shared_ptr<T> CCObjectPool<T>::ConstructObject(Args &&... args) {
 
 template <typename T>
 void CCObjectPool<T>::ReleaseObject(T *object) {
-  Head new_head;
   Node *node = reinterpret_cast<Node *>(object);
-  Head old_head = free_head_.load(std::memory_order_acquire);
-  do {
-    node->next = old_head.node;
-    new_head.node = node;
-    new_head.count = old_head.count + 1;
-  } while (!free_head_.compare_exchange_weak(old_head, new_head,
-                                             std::memory_order_acq_rel,
-                                             std::memory_order_acquire));
+  if (magazine_size_ == 0) {
+    PushNodes(node, node);
+    return;
+  }
+
+  auto &magazine = magazines_[MagazineIndex()];
+  magazine.Lock();
+  if (magazine.count == magazine_size_) {
+    // flush the older half as one chain
+    auto num = magazine_size_ / 2;
+    FOR_EACH(i, 0, num - 1) { magazine.nodes[i]->next = magazine.nodes[i + 1]; }
+    PushNodes(magazine.nodes[0], magazine.nodes[num - 1]);
+    std::copy(magazine.nodes + num, magazine.nodes + magazine.count,
+              magazine.nodes);
+    magazine.count -= num;
+  }
+  magazine.nodes[magazine.count++] = node;
+  magazine.Unlock();
 }
 
 }  // namespace base
@@ -82,6 +82,34 @@ TEST(CCObjectPoolTest, multi_thread) {
   vec.clear();
 }
 
+TEST(CCObjectPoolTest, cross_thread_release) {
+  const uint32_t capacity = 1024;
+  auto pool = std::make_shared<CCObjectPool<TestNode>>(capacity);
+  std::vector<std::shared_ptr<TestNode>> vec;
+  std::thread producer([pool, &vec, capacity]() {
+    FOR_EACH(i, 0, capacity) { vec.push_back(pool->ConstructObject(i)); }
+  });
+  producer.join();
+  EXPECT_EQ(nullptr, pool->ConstructObject(10));
+
+  // released into the magazines of other threads, still reachable from here
+  std::vector<std::thread> consumers;
+  FOR_EACH(i, 0, 4) {
+    consumers.emplace_back([&vec, i, capacity]() {
+      FOR_EACH(j, i * capacity / 4, (i + 1) * capacity / 4) { vec[j].reset(); }
+    });
+  }
+  for (auto& thread : consumers) {
+    thread.join();
+  }
+  FOR_EACH(i, 0, capacity) {
+    vec[i] = pool->ConstructObject(i);
+    EXPECT_NE(nullptr, vec[i]);
+  }
+  EXPECT_EQ(nullptr, pool->ConstructObject(10));
+  vec.clear();
+}
+
 TEST(CCObjectPoolTest, construct_object) {
   const uint32_t capacity = 1024;
   auto pool = std::make_shared<CCObjectPool<TestNode>>(capacity);
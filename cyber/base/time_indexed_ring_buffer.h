@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_BASE_TIME_INDEXED_RING_BUFFER_H_
+#define CYBER_BASE_TIME_INDEXED_RING_BUFFER_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+/**
+ * @brief A history of timestamped values written by one thread and read by
+ * any number of threads without locks
+ *
+ * Values are pushed with strictly increasing timestamps into a ring that
+ * keeps the latest capacity of them, so a lookup is a binary search over
+ * the ring. Every slot carries a sequence number that the writer makes odd
+ * while it overwrites the slot; a reader copies the slot and checks the
+ * number did not move, and starts the lookup over when the writer lapped
+ * it. Readers never block the writer and never see a torn value, T should
+ * be a plain value type whose copy does not follow pointers.
+ *
+ * @tparam T Type of the value kept per timestamp
+ */
+template <typename T>
+class TimeIndexedRingBuffer {
+ public:
+  struct Entry {
+    double timestamp = 0.0;
+    T value;
+  };
+
+  explicit TimeIndexedRingBuffer(uint64_t capacity)
+      : capacity_(std::max<uint64_t>(capacity, 2)),
+        slots_(new Slot[capacity_ + 1]) {}
+  TimeIndexedRingBuffer(const TimeIndexedRingBuffer& other) = delete;
+  TimeIndexedRingBuffer& operator=(const TimeIndexedRingBuffer& other) =
+      delete;
+
+  /**
+   * @brief Append a value, only one thread may call Push and Clear
+   * @return false if timestamp is not newer than the latest one
+   */
+  bool Push(double timestamp, const T& value);
+
+  /**
+   * @brief Drop all values, only one thread may call Push and Clear
+   */
+  void Clear();
+
+  uint64_t Capacity() const { return capacity_; }
+  uint64_t Size() const;
+  bool Empty() const { return Size() == 0; }
+
+  bool GetOldest(Entry* entry) const;
+  bool GetLatest(Entry* entry) const;
+
+  /**
+   * @brief Find the two values around a timestamp, before is the latest one
+   * older than timestamp and after the one right next to it
+   * @return false if timestamp is not newer than the oldest value or newer
+   * than the latest one
+   */
+  bool GetBracket(double timestamp, Entry* before, Entry* after) const;
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence = {0};
+    Entry entry;
+  };
+
+  // Values [begin, end) of the ring that are safe to read, the slot the
+  // writer fills next is left out.
+  void GetRange(uint64_t* begin, uint64_t* end) const;
+  bool Read(uint64_t index, Entry* entry) const;
+
+  const uint64_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // Only touched by the writer.
+  double latest_timestamp_ = 0.0;
+  bool has_latest_ = false;
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> begin_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> end_ = {0};
+};
+
+template <typename T>
+bool TimeIndexedRingBuffer<T>::Push(double timestamp, const T& value) {
+  if (has_latest_ && timestamp <= latest_timestamp_) {
+    return false;
+  }
+  const uint64_t index = end_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[index % (capacity_ + 1)];
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.entry.timestamp = timestamp;
+  slot.entry.value = value;
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+  end_.store(index + 1, std::memory_order_release);
+  latest_timestamp_ = timestamp;
+  has_latest_ = true;
+  return true;
+}
+
+template <typename T>
+void TimeIndexedRingBuffer<T>::Clear() {
+  begin_.store(end_.load(std::memory_order_relaxed),
+               std::memory_order_release);
+  has_latest_ = false;
+}
+
+template <typename T>
+uint64_t TimeIndexedRingBuffer<T>::Size() const {
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  GetRange(&begin, &end);
+  return end - begin;
+}
+
+template <typename T>
+bool TimeIndexedRingBuffer<T>::GetOldest(Entry* entry) const {
+  while (true) {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    GetRange(&begin, &end);
+    if (begin == end) {
+      return false;
+    }
+    if (Read(begin, entry)) {
+      return true;
+    }
+  }
+}
+
+template <typename T>
+bool TimeIndexedRingBuffer<T>::GetLatest(Entry* entry) const {
+  while (true) {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    GetRange(&begin, &end);
+    if (begin == end) {
+      return false;
+    }
+    if (Read(end - 1, entry)) {
+      return true;
+    }
+  }
+}
+
+template <typename T>
+bool TimeIndexedRingBuffer<T>::GetBracket(double timestamp, Entry* before,
+                                          Entry* after) const {
+  Entry probe;
+  while (true) {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    GetRange(&begin, &end);
+    // lower bound of timestamp in [begin, end)
+    uint64_t low = begin;
+    uint64_t high = end;
+    bool lapped = false;
+    while (low < high) {
+      const uint64_t middle = low + (high - low) / 2;
+      if (!Read(middle, &probe)) {
+        lapped = true;
+        break;
+      }
+      if (probe.timestamp < timestamp) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (lapped) {
+      continue;
+    }
+    if (low == begin || low == end) {
+      return false;
+    }
+    if (Read(low - 1, before) && Read(low, after)) {
+      return true;
+    }
+  }
+}
+
+template <typename T>
+void TimeIndexedRingBuffer<T>::GetRange(uint64_t* begin, uint64_t* end) const {
+  *end = end_.load(std::memory_order_acquire);
+  *begin = std::max(begin_.load(std::memory_order_acquire),
+                    *end > capacity_ ? *end - capacity_ : 0);
+  *begin = std::min(*begin, *end);
+}
+
+template <typename T>
+bool TimeIndexedRingBuffer<T>::Read(uint64_t index, Entry* entry) const {
+  const Slot& slot = slots_[index % (capacity_ + 1)];
+  const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence != 2 * index + 2) {
+    return false;
+  }
+  *entry = slot.entry;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_TIME_INDEXED_RING_BUFFER_H_
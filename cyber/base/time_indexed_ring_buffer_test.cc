@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/base/time_indexed_ring_buffer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+struct Sample {
+  double x = 0.0;
+  double y = 0.0;
+};
+
+TEST(TimeIndexedRingBufferTest, Push) {
+  TimeIndexedRingBuffer<int> buffer(10);
+  TimeIndexedRingBuffer<int>::Entry entry;
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.GetLatest(&entry));
+  EXPECT_FALSE(buffer.GetOldest(&entry));
+  for (int i = 0; i < 25; ++i) {
+    EXPECT_TRUE(buffer.Push(static_cast<double>(i), i));
+    EXPECT_EQ(std::min(i + 1, 10), static_cast<int>(buffer.Size()));
+  }
+  EXPECT_FALSE(buffer.Push(24.0, 0));
+  EXPECT_FALSE(buffer.Push(23.0, 0));
+  EXPECT_TRUE(buffer.GetLatest(&entry));
+  EXPECT_EQ(24.0, entry.timestamp);
+  EXPECT_EQ(24, entry.value);
+  EXPECT_TRUE(buffer.GetOldest(&entry));
+  EXPECT_EQ(15.0, entry.timestamp);
+  EXPECT_EQ(15, entry.value);
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.GetLatest(&entry));
+  EXPECT_TRUE(buffer.Push(1.0, 1));
+  EXPECT_TRUE(buffer.GetOldest(&entry));
+  EXPECT_EQ(1, entry.value);
+  EXPECT_EQ(1, static_cast<int>(buffer.Size()));
+}
+
+TEST(TimeIndexedRingBufferTest, GetBracket) {
+  TimeIndexedRingBuffer<int> buffer(8);
+  TimeIndexedRingBuffer<int>::Entry before;
+  TimeIndexedRingBuffer<int>::Entry after;
+  EXPECT_FALSE(buffer.GetBracket(1.0, &before, &after));
+  for (int i = 0; i < 20; ++i) {
+    buffer.Push(0.5 * i, i);
+  }
+  // values 12 to 19 are left, at 6.0 to 9.5
+  EXPECT_TRUE(buffer.GetBracket(7.2, &before, &after));
+  EXPECT_EQ(14, before.value);
+  EXPECT_EQ(15, after.value);
+  EXPECT_TRUE(buffer.GetBracket(7.5, &before, &after));
+  EXPECT_EQ(14, before.value);
+  EXPECT_EQ(15, after.value);
+  EXPECT_TRUE(buffer.GetBracket(9.5, &before, &after));
+  EXPECT_EQ(18, before.value);
+  EXPECT_EQ(19, after.value);
+  EXPECT_TRUE(buffer.GetBracket(6.1, &before, &after));
+  EXPECT_EQ(12, before.value);
+  EXPECT_EQ(13, after.value);
+  EXPECT_FALSE(buffer.GetBracket(6.0, &before, &after));
+  EXPECT_FALSE(buffer.GetBracket(2.0, &before, &after));
+  EXPECT_FALSE(buffer.GetBracket(9.6, &before, &after));
+}
+
+TEST(TimeIndexedRingBufferTest, ConcurrentRead) {
+  TimeIndexedRingBuffer<Sample> buffer(16);
+  std::atomic<bool> done = {false};
+  std::atomic<int> torn = {0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      TimeIndexedRingBuffer<Sample>::Entry before;
+      TimeIndexedRingBuffer<Sample>::Entry after;
+      TimeIndexedRingBuffer<Sample>::Entry latest;
+      while (!done.load()) {
+        if (!buffer.GetLatest(&latest)) {
+          continue;
+        }
+        if (!buffer.GetBracket(latest.timestamp - 5.5, &before, &after)) {
+          continue;
+        }
+        if (before.value.x != before.timestamp ||
+            before.value.y != -before.timestamp ||
+            after.value.x != after.timestamp ||
+            after.value.y != -after.timestamp ||
+            after.timestamp != before.timestamp + 1.0) {
+          ++torn;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 200000; ++i) {
+    Sample sample;
+    sample.x = static_cast<double>(i);
+    sample.y = -sample.x;
+    EXPECT_TRUE(buffer.Push(sample.x, sample));
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, torn.load());
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
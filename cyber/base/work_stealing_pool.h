@@ -0,0 +1,328 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_WORK_STEALING_POOL_H_
+#define CYBER_BASE_WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+// Move-only void() callable. Callables up to kInlineSize bytes, e.g. a lambda
+// capturing a few pointers, live inside the object, so submitting them does
+// not allocate the way std::function does; larger ones fall back to the heap.
+class InlineTask {
+ public:
+  static const size_t kInlineSize = 48;
+
+  InlineTask() = default;
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<
+                typename std::decay<F>::type, InlineTask>::value>::type>
+  InlineTask(F&& f) {  // NOLINT
+    using T = typename std::decay<F>::type;
+    Construct<T>(std::forward<F>(f), std::integral_constant<bool, Fits<T>()>());
+  }
+
+  InlineTask(InlineTask&& other) noexcept { MoveFrom(&other); }
+
+  InlineTask& operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(&other);
+    }
+    return *this;
+  }
+
+  InlineTask(const InlineTask&) = delete;
+  InlineTask& operator=(const InlineTask&) = delete;
+
+  ~InlineTask() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(&storage_); }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+ private:
+  using Storage = typename std::aligned_storage<kInlineSize>::type;
+
+  struct Ops {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename T>
+  static constexpr bool Fits() {
+    return sizeof(T) <= sizeof(Storage) && alignof(T) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<T>::value;
+  }
+
+  template <typename T>
+  struct InlineOps {
+    static void Invoke(void* p) { (*static_cast<T*>(p))(); }
+    static void Move(void* dst, void* src) {
+      new (dst) T(std::move(*static_cast<T*>(src)));
+      static_cast<T*>(src)->~T();
+    }
+    static void Destroy(void* p) { static_cast<T*>(p)->~T(); }
+    static const Ops ops;
+  };
+
+  template <typename T>
+  struct HeapOps {
+    static void Invoke(void* p) { (**static_cast<T**>(p))(); }
+    static void Move(void* dst, void* src) {
+      *static_cast<T**>(dst) = *static_cast<T**>(src);
+    }
+    static void Destroy(void* p) { delete *static_cast<T**>(p); }
+    static const Ops ops;
+  };
+
+  template <typename T, typename F>
+  void Construct(F&& f, std::true_type) {
+    new (&storage_) T(std::forward<F>(f));
+    ops_ = &InlineOps<T>::ops;
+  }
+
+  template <typename T, typename F>
+  void Construct(F&& f, std::false_type) {
+    *reinterpret_cast<T**>(&storage_) = new T(std::forward<F>(f));
+    ops_ = &HeapOps<T>::ops;
+  }
+
+  void MoveFrom(InlineTask* other) {
+    if (other->ops_ != nullptr) {
+      other->ops_->move(&storage_, &other->storage_);
+      ops_ = other->ops_;
+      other->ops_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const Ops* ops_ = nullptr;
+};
+
+template <typename T>
+const InlineTask::Ops InlineTask::InlineOps<T>::ops = {
+    &InlineOps<T>::Invoke, &InlineOps<T>::Move, &InlineOps<T>::Destroy};
+
+template <typename T>
+const InlineTask::Ops InlineTask::HeapOps<T>::ops = {
+    &HeapOps<T>::Invoke, &HeapOps<T>::Move, &HeapOps<T>::Destroy};
+
+// Thread pool with one deque per worker. A worker pushes and pops its own
+// tasks at the back and steals from the front of the others when it runs
+// dry, so workers only meet on a lock when stealing. Tasks submitted from
+// outside the pool are spread round robin.
+class WorkStealingPool {
+ public:
+  // |set_thread_attr| is called on every worker once it is created, e.g.
+  // with scheduler::Instance()->SetInnerThreadAttr to follow the sched conf.
+  explicit WorkStealingPool(
+      size_t thread_num,
+      const std::function<void(std::thread*)>& set_thread_attr = nullptr);
+
+  // runs what is still queued, then joins all threads
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  // Fire and forget, false after the pool is stopped.
+  template <typename F>
+  bool Submit(F&& f);
+
+  // before using the return value, you should check value.valid()
+  template <typename F, typename... Args>
+  auto Enqueue(F&& f, Args&&... args)
+      -> std::future<typename std::result_of<F(Args...)>::type>;
+
+  size_t size() const { return workers_.size(); }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<InlineTask> tasks;
+  };
+
+  struct Current {
+    WorkStealingPool* pool = nullptr;
+    size_t index = 0;
+  };
+
+  static Current& CurrentWorker() {
+    static thread_local Current current;
+    return current;
+  }
+
+  void Run(size_t index);
+  bool Pop(size_t index, InlineTask* task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_queue_ = {0};
+  // queued and not yet popped
+  std::atomic<size_t> pending_ = {0};
+  std::atomic<size_t> sleepers_ = {0};
+  std::atomic<bool> stop_ = {false};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+};
+
+inline WorkStealingPool::WorkStealingPool(
+    size_t thread_num,
+    const std::function<void(std::thread*)>& set_thread_attr) {
+  thread_num = thread_num > 0 ? thread_num : 1;
+  for (size_t i = 0; i < thread_num; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  workers_.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; ++i) {
+    workers_.emplace_back([this, i]() { Run(i); });
+    if (set_thread_attr) {
+      set_thread_attr(&workers_[i]);
+    }
+  }
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+  if (stop_.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+template <typename F>
+bool WorkStealingPool::Submit(F&& f) {
+  // don't allow enqueueing after stopping the pool
+  if (stop_.load()) {
+    return false;
+  }
+  auto& current = CurrentWorker();
+  auto index = current.pool == this
+                   ? current.index
+                   : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                         queues_.size();
+  // counted before the push so that a concurrent Pop never drives it below
+  // zero, and seq_cst so that it pairs with the sleep predicate
+  pending_.fetch_add(1);
+  {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back(std::forward<F>(f));
+  }
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.notify_one();
+  }
+  return true;
+}
+
+template <typename F, typename... Args>
+auto WorkStealingPool::Enqueue(F&& f, Args&&... args)
+    -> std::future<typename std::result_of<F(Args...)>::type> {
+  using return_type = typename std::result_of<F(Args...)>::type;
+
+  auto task = std::make_shared<std::packaged_task<return_type()>>(
+      std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+  std::future<return_type> res = task->get_future();
+  if (!Submit([task]() { (*task)(); })) {
+    return std::future<return_type>();
+  }
+  return res;
+}
+
+inline void WorkStealingPool::Run(size_t index) {
+  auto& current = CurrentWorker();
+  current.pool = this;
+  current.index = index;
+
+  InlineTask task;
+  while (true) {
+    if (Pop(index, &task)) {
+      task();
+      task.Reset();
+      continue;
+    }
+    if (stop_.load()) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleepers_.fetch_add(1);
+    sleep_cv_.wait(lock,
+                   [this]() { return stop_.load() || pending_.load() > 0; });
+    sleepers_.fetch_sub(1);
+  }
+}
+
+inline bool WorkStealingPool::Pop(size_t index, InlineTask* task) {
+  if (pending_.load() == 0) {
+    return false;
+  }
+  auto num = queues_.size();
+  for (size_t i = 0; i < num; ++i) {
+    auto& queue = *queues_[(index + i) % num];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    pending_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_WORK_STEALING_POOL_H_
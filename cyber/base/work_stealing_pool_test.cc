@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/work_stealing_pool.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(InlineTaskTest, InlineAndHeap) {
+  int count = 0;
+  InlineTask small([&count]() { ++count; });
+  small();
+  EXPECT_EQ(1, count);
+
+  std::array<char, 2 * InlineTask::kInlineSize> big = {};
+  big[0] = 2;
+  InlineTask large([&count, big]() { count += big[0]; });
+  InlineTask moved(std::move(large));
+  EXPECT_FALSE(large);
+  ASSERT_TRUE(moved);
+  moved();
+  EXPECT_EQ(3, count);
+
+  auto owned = std::make_shared<int>(0);
+  {
+    InlineTask task([owned]() {});
+    EXPECT_EQ(2, owned.use_count());
+    small = std::move(task);
+  }
+  EXPECT_EQ(2, owned.use_count());
+  small.Reset();
+  EXPECT_EQ(1, owned.use_count());
+}
+
+TEST(WorkStealingPoolTest, Enqueue) {
+  WorkStealingPool pool(4);
+  EXPECT_EQ(4, pool.size());
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.emplace_back(pool.Enqueue([](int x) { return x * x; }, i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(results[i].valid());
+    EXPECT_EQ(i * i, results[i].get());
+  }
+}
+
+TEST(WorkStealingPoolTest, DrainOnDestruction) {
+  std::atomic<int> count = {0};
+  {
+    WorkStealingPool pool(2);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_TRUE(pool.Submit([&count]() { ++count; }));
+    }
+  }
+  EXPECT_EQ(1000, count.load());
+}
+
+TEST(WorkStealingPoolTest, SubmitFromWorker) {
+  std::atomic<int> count = {0};
+  {
+    WorkStealingPool pool(4);
+    // every child lands on the parent's own queue, the idle workers have to
+    // steal it
+    pool.Submit([&pool, &count]() {
+      for (int i = 0; i < 100; ++i) {
+        pool.Submit([&count]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+          ++count;
+        });
+      }
+    });
+    while (count.load() < 100) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_EQ(100, count.load());
+}
+
+TEST(WorkStealingPoolTest, ThreadAttr) {
+  std::atomic<int> count = {0};
+  WorkStealingPool pool(3, [&count](std::thread* thread) {
+    EXPECT_TRUE(thread->joinable());
+    ++count;
+  });
+  EXPECT_EQ(3, count.load());
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
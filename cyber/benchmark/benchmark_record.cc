@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/benchmark/benchmark_record.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+namespace {
+
+std::string Quote(const std::string& str) {
+  std::string quoted("\"");
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      default:
+        quoted += c;
+        break;
+    }
+  }
+  quoted += '"';
+  return quoted;
+}
+
+std::string Micros(uint64_t nanos) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(nanos) / 1000.0);
+  return buf;
+}
+
+}  // namespace
+
+BenchmarkRecord::BenchmarkRecord(const std::string& benchmark) {
+  Set("benchmark", benchmark);
+}
+
+BenchmarkRecord& BenchmarkRecord::Set(const std::string& key,
+                                      const std::string& value) {
+  fields_.emplace_back(key, Quote(value));
+  return *this;
+}
+
+BenchmarkRecord& BenchmarkRecord::Set(const std::string& key,
+                                      const char* value) {
+  return Set(key, std::string(value));
+}
+
+BenchmarkRecord& BenchmarkRecord::Set(const std::string& key,
+                                      uint64_t value) {
+  fields_.emplace_back(key, std::to_string(value));
+  return *this;
+}
+
+BenchmarkRecord& BenchmarkRecord::Set(const std::string& key, double value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.3f", value);
+  fields_.emplace_back(key, buf);
+  return *this;
+}
+
+BenchmarkRecord& BenchmarkRecord::SetLatency(
+    const transport::LatencyHistogram& histogram) {
+  fields_.emplace_back("latency_count", std::to_string(histogram.count()));
+  if (histogram.count() == 0) {
+    return *this;
+  }
+  fields_.emplace_back("latency_min_us", Micros(histogram.min()));
+  fields_.emplace_back("latency_mean_us", Micros(histogram.mean()));
+  fields_.emplace_back("latency_p50_us", Micros(histogram.Percentile(50)));
+  fields_.emplace_back("latency_p90_us", Micros(histogram.Percentile(90)));
+  fields_.emplace_back("latency_p99_us", Micros(histogram.Percentile(99)));
+  fields_.emplace_back("latency_p999_us", Micros(histogram.Percentile(99.9)));
+  fields_.emplace_back("latency_max_us", Micros(histogram.max()));
+  return *this;
+}
+
+std::string BenchmarkRecord::ToJson() const {
+  std::ostringstream json;
+  json << '{';
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (i > 0) {
+      json << ", ";
+    }
+    json << Quote(fields_[i].first) << ": " << fields_[i].second;
+  }
+  json << '}';
+  return json.str();
+}
+
+void BenchmarkRecord::Write(std::ostream* os) const {
+  *os << ToJson() << std::endl;
+}
+
+bool ParseSizeList(const std::string& list, std::vector<uint64_t>* sizes) {
+  std::vector<std::string> items;
+  ParseNameList(list, &items);
+  sizes->clear();
+  for (auto& item : items) {
+    char* end = nullptr;
+    uint64_t size = strtoull(item.c_str(), &end, 10);
+    if (end == item.c_str()) {
+      return false;
+    }
+    if (*end == 'K' || *end == 'k') {
+      size *= 1024;
+      ++end;
+    } else if (*end == 'M' || *end == 'm') {
+      size *= 1024 * 1024;
+      ++end;
+    }
+    if (*end != '\0') {
+      return false;
+    }
+    sizes->push_back(size);
+  }
+  return true;
+}
+
+void ParseNameList(const std::string& list, std::vector<std::string>* names) {
+  names->clear();
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      names->push_back(item);
+    }
+  }
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_BENCHMARK_BENCHMARK_RECORD_H_
+#define CYBER_BENCHMARK_BENCHMARK_RECORD_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cyber/transport/common/latency_statistics.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+// One result of a benchmark run, written as a single line of JSON so the
+// output of many runs can be collected and compared by scripts.
+class BenchmarkRecord {
+ public:
+  explicit BenchmarkRecord(const std::string& benchmark);
+
+  BenchmarkRecord& Set(const std::string& key, const std::string& value);
+  BenchmarkRecord& Set(const std::string& key, const char* value);
+  BenchmarkRecord& Set(const std::string& key, uint64_t value);
+  BenchmarkRecord& Set(const std::string& key, double value);
+  // count, min, mean, p50, p90, p99, p999 and max, in microseconds
+  BenchmarkRecord& SetLatency(const transport::LatencyHistogram& histogram);
+
+  std::string ToJson() const;
+  void Write(std::ostream* os) const;
+
+ private:
+  // values are JSON encoded already
+  std::vector<std::pair<std::string, std::string>> fields_;
+};
+
+// Parses a comma separated list like "64,1024,1M", K and M multiply by
+// 1024. Returns false if an item isn't a number.
+bool ParseSizeList(const std::string& list, std::vector<uint64_t>* sizes);
+void ParseNameList(const std::string& list, std::vector<std::string>* names);
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BENCHMARK_BENCHMARK_RECORD_H_
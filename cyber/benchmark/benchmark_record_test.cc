@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/benchmark/benchmark_record.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+TEST(BenchmarkRecordTest, ToJson) {
+  BenchmarkRecord record("transport");
+  record.Set("mode", "shm")
+      .Set("size", static_cast<uint64_t>(1024))
+      .Set("mb_per_sec", 12.5)
+      .Set("note", std::string("a \"b\"\n"));
+  EXPECT_EQ(
+      "{\"benchmark\": \"transport\", \"mode\": \"shm\", \"size\": 1024, "
+      "\"mb_per_sec\": 12.500, \"note\": \"a \\\"b\\\"\\n\"}",
+      record.ToJson());
+
+  std::ostringstream os;
+  record.Write(&os);
+  EXPECT_EQ(record.ToJson() + "\n", os.str());
+}
+
+TEST(BenchmarkRecordTest, SetLatency) {
+  transport::LatencyHistogram histogram;
+  BenchmarkRecord empty("test");
+  empty.SetLatency(histogram);
+  EXPECT_EQ("{\"benchmark\": \"test\", \"latency_count\": 0}",
+            empty.ToJson());
+
+  histogram.Add(2000);
+  BenchmarkRecord record("test");
+  record.SetLatency(histogram);
+  auto json = record.ToJson();
+  EXPECT_NE(std::string::npos, json.find("\"latency_count\": 1"));
+  EXPECT_NE(std::string::npos, json.find("\"latency_p99_us\""));
+  EXPECT_NE(std::string::npos, json.find("\"latency_max_us\""));
+}
+
+TEST(BenchmarkRecordTest, ParseSizeList) {
+  std::vector<uint64_t> sizes;
+  EXPECT_TRUE(ParseSizeList("64,1K,16k,,8M", &sizes));
+  EXPECT_EQ((std::vector<uint64_t>{64, 1024, 16384, 8 * 1024 * 1024}), sizes);
+  EXPECT_TRUE(ParseSizeList("", &sizes));
+  EXPECT_TRUE(sizes.empty());
+  EXPECT_FALSE(ParseSizeList("64,K", &sizes));
+  EXPECT_FALSE(ParseSizeList("64KB", &sizes));
+}
+
+TEST(BenchmarkRecordTest, ParseNameList) {
+  std::vector<std::string> names;
+  ParseNameList("intra,shm,,rtps", &names);
+  EXPECT_EQ((std::vector<std::string>{"intra", "shm", "rtps"}), names);
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
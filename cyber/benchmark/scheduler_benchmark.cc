@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+// Latency from a write to the reader callback, which runs in a croutine,
+// while croutines busy with other work compete for the processors. Every
+// result is printed as one line of JSON.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/benchmark/benchmark_record.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/scheduler/scheduler_factory.h"
+
+DEFINE_string(load_task_nums, "0,4,16,64",
+              "busy croutines running next to the reader");
+DEFINE_uint32(load_slice_us, 500, "time a busy croutine runs before yielding");
+DEFINE_uint32(msg_num, 2000, "messages written per run");
+DEFINE_uint32(interval_us, 1000, "write interval");
+DEFINE_uint32(timeout_ms, 5000, "wait for the last messages of a run");
+DEFINE_string(output, "", "file for the results, stdout if empty");
+
+using apollo::cyber::benchmark::BenchmarkRecord;
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::transport::LatencyHistogram;
+
+namespace {
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Run(uint32_t load_task_num, std::ostream* os) {
+  auto scheduler = apollo::cyber::scheduler::Instance();
+  std::atomic<bool> stop = {false};
+  std::atomic<uint64_t> load_slices = {0};
+  std::vector<std::string> load_tasks;
+  for (uint32_t i = 0; i < load_task_num; ++i) {
+    std::string name = "scheduler_benchmark_load_" +
+                       std::to_string(load_task_num) + "_" +
+                       std::to_string(i);
+    scheduler->CreateTask(
+        [&stop, &load_slices]() {
+          while (!stop.load()) {
+            uint64_t slice_end = NowNs() + FLAGS_load_slice_us * 1000UL;
+            while (NowNs() < slice_end) {
+            }
+            load_slices.fetch_add(1);
+            CRoutine::Yield();
+          }
+        },
+        name);
+    load_tasks.emplace_back(name);
+  }
+
+  std::string channel_name =
+      "/cyber/benchmark/scheduler/" + std::to_string(load_task_num);
+  auto node = apollo::cyber::CreateNode("scheduler_benchmark_" +
+                                        std::to_string(load_task_num));
+  std::vector<std::atomic<uint64_t>> send_times(FLAGS_msg_num);
+  LatencyHistogram histogram;
+  std::atomic<uint64_t> received = {0};
+  auto reader = node->CreateReader<RawMessage>(
+      channel_name, [&](const std::shared_ptr<RawMessage>& msg) {
+        uint64_t now = NowNs();
+        uint64_t seq = UINT64_MAX;
+        if (msg->message.size() >= sizeof(seq)) {
+          std::memcpy(&seq, msg->message.data(), sizeof(seq));
+        }
+        if (seq < send_times.size()) {
+          uint64_t sent = send_times[seq].load(std::memory_order_acquire);
+          histogram.Add(now > sent ? now - sent : 0);
+        }
+        received.fetch_add(1);
+      });
+  auto writer = node->CreateWriter<RawMessage>(channel_name);
+  // let the topology connect both ends
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  uint64_t slices_begin = load_slices.load();
+  uint64_t begin = NowNs();
+  for (uint64_t seq = 0; seq < FLAGS_msg_num; ++seq) {
+    uint64_t target = begin + seq * FLAGS_interval_us * 1000UL;
+    while (NowNs() < target) {
+      std::this_thread::yield();
+    }
+    auto msg = std::make_shared<RawMessage>(std::string(sizeof(seq), '\0'));
+    std::memcpy(&msg->message[0], &seq, sizeof(seq));
+    send_times[seq].store(NowNs(), std::memory_order_release);
+    writer->Write(msg);
+  }
+  uint64_t deadline = NowNs() + FLAGS_timeout_ms * 1000000UL;
+  while (received.load() < FLAGS_msg_num && NowNs() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  double seconds = static_cast<double>(NowNs() - begin) * 1e-9;
+  uint64_t slices = load_slices.load() - slices_begin;
+
+  stop.store(true);
+  reader->Shutdown();
+  writer->Shutdown();
+  for (auto& name : load_tasks) {
+    scheduler->RemoveTask(name);
+  }
+
+  BenchmarkRecord record("scheduler");
+  record.Set("load_task_num", static_cast<uint64_t>(load_task_num))
+      .Set("load_slice_us", static_cast<uint64_t>(FLAGS_load_slice_us))
+      .Set("task_pool_size", static_cast<uint64_t>(scheduler->TaskPoolSize()))
+      .Set("interval_us", static_cast<uint64_t>(FLAGS_interval_us))
+      .Set("published", static_cast<uint64_t>(FLAGS_msg_num))
+      .Set("received", received.load())
+      .Set("load_slices_per_sec",
+           seconds > 0 ? static_cast<double>(slices) / seconds : 0.0)
+      .SetLatency(histogram);
+  record.Write(os);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+
+  std::vector<uint64_t> load_task_nums;
+  if (!apollo::cyber::benchmark::ParseSizeList(FLAGS_load_task_nums,
+                                               &load_task_nums)) {
+    std::cerr << "invalid --load_task_nums" << std::endl;
+    return -1;
+  }
+
+  std::ofstream file;
+  std::ostream* os = &std::cout;
+  if (!FLAGS_output.empty()) {
+    file.open(FLAGS_output);
+    if (!file.is_open()) {
+      std::cerr << "can't open " << FLAGS_output << std::endl;
+      return -1;
+    }
+    os = &file;
+  }
+
+  for (auto load_task_num : load_task_nums) {
+    Run(static_cast<uint32_t>(load_task_num), os);
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
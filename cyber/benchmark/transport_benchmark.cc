@@ -0,0 +1,359 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+// Latency percentiles and throughput of the transports for a range of
+// message sizes and reader numbers, plus the wakeup latency of the shm
+// notifiers. Every result is printed as one line of JSON.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/benchmark/benchmark_record.h"
+#include "cyber/common/global_data.h"
+#include "cyber/init.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/shm/futex_notifier.h"
+#include "cyber/transport/shm/multicast_notifier.h"
+#include "cyber/transport/transport.h"
+
+DEFINE_string(modes, "intra,shm,rtps,hybrid", "transports to measure");
+DEFINE_string(sizes, "64,1K,16K,256K,1M,8M", "message sizes in bytes");
+DEFINE_string(reader_nums, "1,4", "readers of the channel");
+DEFINE_string(notifiers, "condition,futex,multicast",
+              "shm notifiers whose wakeup latency is measured");
+DEFINE_uint32(msg_num, 1000, "messages published per run");
+DEFINE_uint64(max_bytes_per_run, 1024UL * 1024 * 1024,
+              "caps the messages of a run by their total size");
+DEFINE_uint32(interval_us, 1000,
+              "publish interval of the latency runs, throughput runs "
+              "publish back to back");
+DEFINE_uint32(timeout_ms, 5000, "wait for the last messages of a run");
+DEFINE_string(output, "", "file for the results, stdout if empty");
+
+using apollo::cyber::benchmark::BenchmarkRecord;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::OptionalMode;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::transport::ConditionNotifier;
+using apollo::cyber::transport::FutexNotifier;
+using apollo::cyber::transport::Identity;
+using apollo::cyber::transport::LatencyHistogram;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::MulticastNotifier;
+using apollo::cyber::transport::NotifierBase;
+using apollo::cyber::transport::ReadableInfo;
+using apollo::cyber::transport::Receiver;
+using apollo::cyber::transport::Transmitter;
+using apollo::cyber::transport::Transport;
+
+namespace {
+
+// the payload starts with the sequence number of the message
+const size_t kMinMsgSize = sizeof(uint64_t);
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void SleepUntilNs(uint64_t target) {
+  while (NowNs() < target) {
+    std::this_thread::yield();
+  }
+}
+
+bool ParseMode(const std::string& name, OptionalMode* mode) {
+  if (name == "intra") {
+    *mode = OptionalMode::INTRA;
+  } else if (name == "shm") {
+    *mode = OptionalMode::SHM;
+  } else if (name == "rtps") {
+    *mode = OptionalMode::RTPS;
+  } else if (name == "hybrid") {
+    *mode = OptionalMode::HYBRID;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+RoleAttributes MakeAttr(const std::string& channel_name) {
+  RoleAttributes attr;
+  attr.set_host_name(GlobalData::Instance()->HostName());
+  attr.set_host_ip(GlobalData::Instance()->HostIp());
+  attr.set_process_id(GlobalData::Instance()->ProcessId());
+  attr.set_channel_name(channel_name);
+  attr.set_channel_id(GlobalData::RegisterChannel(channel_name));
+  Identity id;
+  attr.set_id(id.HashValue());
+  return attr;
+}
+
+struct RunParam {
+  std::string mode_name;
+  OptionalMode mode;
+  uint64_t msg_size;
+  uint32_t reader_num;
+  uint32_t msg_num;
+  // 0 publishes back to back
+  uint32_t interval_us;
+};
+
+void RunTransport(const RunParam& param, std::ostream* os) {
+  std::string channel_name = "/cyber/benchmark/" + param.mode_name + "/" +
+                             std::to_string(param.msg_size) + "/" +
+                             std::to_string(param.reader_num) + "/" +
+                             std::to_string(param.interval_us);
+  auto writer_attr = MakeAttr(channel_name);
+  writer_attr.mutable_qos_profile()->set_depth(16);
+
+  std::vector<std::atomic<uint64_t>> send_times(param.msg_num);
+  LatencyHistogram histogram;
+  std::atomic<uint64_t> received = {0};
+  auto listener = [&](const std::shared_ptr<RawMessage>& msg,
+                      const MessageInfo&, const RoleAttributes&) {
+    uint64_t now = NowNs();
+    uint64_t seq = 0;
+    if (msg->message.size() >= kMinMsgSize) {
+      std::memcpy(&seq, msg->message.data(), sizeof(seq));
+    }
+    if (seq < send_times.size()) {
+      uint64_t sent = send_times[seq].load(std::memory_order_acquire);
+      histogram.Add(now > sent ? now - sent : 0);
+    }
+    received.fetch_add(1);
+  };
+
+  auto transport = Transport::Instance();
+  auto transmitter =
+      transport->CreateTransmitter<RawMessage>(writer_attr, param.mode);
+  std::vector<std::shared_ptr<Receiver<RawMessage>>> receivers;
+  for (uint32_t i = 0; i < param.reader_num; ++i) {
+    auto reader_attr = MakeAttr(channel_name);
+    auto receiver = transport->CreateReceiver<RawMessage>(
+        reader_attr, listener, param.mode);
+    if (param.mode == OptionalMode::HYBRID) {
+      // what the topology does once both ends discover each other
+      transmitter->Enable(reader_attr);
+      receiver->Enable(writer_attr);
+    }
+    receivers.emplace_back(receiver);
+  }
+  // let rtps match the endpoints
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+      param.mode == OptionalMode::RTPS ? 500 : 50));
+
+  // intra delivers synchronously, others copy, so a few buffers are enough
+  std::vector<std::shared_ptr<RawMessage>> msgs;
+  for (int i = 0; i < 4; ++i) {
+    msgs.emplace_back(std::make_shared<RawMessage>(
+        std::string(std::max(param.msg_size, kMinMsgSize), 'b')));
+  }
+
+  uint64_t begin = NowNs();
+  for (uint64_t seq = 0; seq < param.msg_num; ++seq) {
+    if (param.interval_us > 0) {
+      SleepUntilNs(begin + seq * param.interval_us * 1000);
+    }
+    auto& msg = msgs[seq % msgs.size()];
+    std::memcpy(&msg->message[0], &seq, sizeof(seq));
+    send_times[seq].store(NowNs(), std::memory_order_release);
+    transmitter->Transmit(msg);
+  }
+  uint64_t expected =
+      static_cast<uint64_t>(param.msg_num) * param.reader_num;
+  uint64_t deadline = NowNs() + FLAGS_timeout_ms * 1000000UL;
+  uint64_t last_received = 0;
+  uint64_t end = NowNs();
+  while (received.load() < expected && NowNs() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    if (received.load() != last_received) {
+      last_received = received.load();
+      end = NowNs();
+    }
+  }
+  if (received.load() >= expected) {
+    end = NowNs();
+  }
+
+  for (auto& receiver : receivers) {
+    receiver->Disable();
+  }
+  transmitter->Disable();
+
+  double seconds = static_cast<double>(end - begin) * 1e-9;
+  uint64_t count = received.load();
+  BenchmarkRecord record("transport");
+  record.Set("mode", param.mode_name)
+      .Set("phase", param.interval_us > 0 ? "latency" : "throughput")
+      .Set("msg_size", param.msg_size)
+      .Set("reader_num", static_cast<uint64_t>(param.reader_num))
+      .Set("interval_us", static_cast<uint64_t>(param.interval_us))
+      .Set("published", static_cast<uint64_t>(param.msg_num))
+      .Set("received", count)
+      .Set("lost", expected > count ? expected - count : 0)
+      .Set("seconds", seconds)
+      .Set("msgs_per_sec", seconds > 0 ? static_cast<double>(count) / seconds
+                                       : 0.0)
+      .Set("mb_per_sec",
+           seconds > 0 ? static_cast<double>(count * param.msg_size) /
+                             seconds / (1024.0 * 1024.0)
+                       : 0.0)
+      .SetLatency(histogram);
+  record.Write(os);
+}
+
+std::shared_ptr<NotifierBase> GetNotifier(const std::string& name) {
+  if (name == ConditionNotifier::Type()) {
+    return ConditionNotifier::Instance();
+  } else if (name == FutexNotifier::Type()) {
+    return FutexNotifier::Instance();
+  } else if (name == MulticastNotifier::Type()) {
+    return MulticastNotifier::Instance();
+  }
+  return nullptr;
+}
+
+// From Notify to the return of Listen in another thread, which is the
+// wakeup part of the shm transport latency.
+void RunNotifier(const std::string& name, std::ostream* os) {
+  auto notifier = GetNotifier(name);
+  if (notifier == nullptr) {
+    std::cerr << "unknown notifier: " << name << std::endl;
+    return;
+  }
+
+  const uint64_t channel_id =
+      GlobalData::RegisterChannel("/cyber/benchmark/notifier/" + name);
+  const uint64_t host_id = apollo::cyber::common::Hash(
+      GlobalData::Instance()->HostIp());
+  std::vector<std::atomic<uint64_t>> send_times(FLAGS_msg_num);
+  LatencyHistogram histogram;
+  std::atomic<bool> stop = {false};
+  std::atomic<uint64_t> received = {0};
+  std::thread listener([&]() {
+    ReadableInfo info;
+    while (!stop.load()) {
+      if (!notifier->Listen(10, &info) || info.channel_id() != channel_id ||
+          info.block_index() >= send_times.size()) {
+        continue;
+      }
+      uint64_t now = NowNs();
+      uint64_t sent =
+          send_times[info.block_index()].load(std::memory_order_acquire);
+      histogram.Add(now > sent ? now - sent : 0);
+      received.fetch_add(1);
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  uint64_t begin = NowNs();
+  for (uint32_t i = 0; i < FLAGS_msg_num; ++i) {
+    SleepUntilNs(begin + static_cast<uint64_t>(i) * FLAGS_interval_us * 1000);
+    send_times[i].store(NowNs(), std::memory_order_release);
+    notifier->Notify(ReadableInfo(host_id, i, channel_id));
+  }
+  uint64_t deadline = NowNs() + FLAGS_timeout_ms * 1000000UL;
+  while (received.load() < FLAGS_msg_num && NowNs() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  stop.store(true);
+  listener.join();
+
+  BenchmarkRecord record("notifier");
+  record.Set("notifier", name)
+      .Set("interval_us", static_cast<uint64_t>(FLAGS_interval_us))
+      .Set("published", static_cast<uint64_t>(FLAGS_msg_num))
+      .Set("received", received.load())
+      .SetLatency(histogram);
+  record.Write(os);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+
+  std::vector<std::string> modes;
+  std::vector<uint64_t> sizes;
+  std::vector<uint64_t> reader_nums;
+  std::vector<std::string> notifiers;
+  apollo::cyber::benchmark::ParseNameList(FLAGS_modes, &modes);
+  apollo::cyber::benchmark::ParseNameList(FLAGS_notifiers, &notifiers);
+  if (!apollo::cyber::benchmark::ParseSizeList(FLAGS_sizes, &sizes) ||
+      !apollo::cyber::benchmark::ParseSizeList(FLAGS_reader_nums,
+                                               &reader_nums)) {
+    std::cerr << "invalid --sizes or --reader_nums" << std::endl;
+    return -1;
+  }
+
+  std::ofstream file;
+  std::ostream* os = &std::cout;
+  if (!FLAGS_output.empty()) {
+    file.open(FLAGS_output);
+    if (!file.is_open()) {
+      std::cerr << "can't open " << FLAGS_output << std::endl;
+      return -1;
+    }
+    os = &file;
+  }
+
+  for (auto& name : modes) {
+    RunParam param;
+    param.mode_name = name;
+    if (!ParseMode(name, &param.mode)) {
+      std::cerr << "unknown mode: " << name << std::endl;
+      continue;
+    }
+    for (auto size : sizes) {
+      param.msg_size = size;
+      param.msg_num = static_cast<uint32_t>(std::max<uint64_t>(
+          std::min<uint64_t>(FLAGS_msg_num,
+                             FLAGS_max_bytes_per_run / std::max<uint64_t>(
+                                                           size, 1)),
+          10));
+      for (auto reader_num : reader_nums) {
+        param.reader_num = static_cast<uint32_t>(reader_num);
+        param.interval_us = FLAGS_interval_us;
+        RunTransport(param, os);
+        param.interval_us = 0;
+        RunTransport(param, os);
+      }
+    }
+  }
+  for (auto& name : notifiers) {
+    RunNotifier(name, os);
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
@@ -68,6 +68,7 @@ class Blocker : public BlockerBase {
   using MessageType = T;
   using MessagePtr = std::shared_ptr<T>;
   using MessageQueue = std::list<MessagePtr>;
+  using MessageQueuePtr = std::shared_ptr<MessageQueue>;
   using Callback = std::function<void(const MessagePtr&)>;
   using CallbackMap = std::unordered_map<std::string, Callback>;
   using Iterator = typename std::list<std::shared_ptr<T>>::const_iterator;
@@ -103,10 +104,14 @@ class Blocker : public BlockerBase {
   void Reset() override;
   void Enqueue(const MessagePtr& msg);
   void Notify(const MessagePtr& msg);
+  MessageQueue* MutablePublishedQueue();
 
   BlockerAttr attr_;
-  MessageQueue observed_msg_queue_;
-  MessageQueue published_msg_queue_;
+  // Observe() shares the published queue with the observed one instead of
+  // copying it, the published queue is copied on its next write only while
+  // the two are still shared.
+  MessageQueuePtr observed_msg_queue_;
+  MessageQueuePtr published_msg_queue_;
   mutable std::mutex msg_mutex_;
 
   CallbackMap published_callbacks_;
@@ -116,12 +121,16 @@ class Blocker : public BlockerBase {
 };
 
 template <typename T>
-Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {}
+Blocker<T>::Blocker(const BlockerAttr& attr)
+    : attr_(attr),
+      observed_msg_queue_(std::make_shared<MessageQueue>()),
+      published_msg_queue_(std::make_shared<MessageQueue>()),
+      dummy_msg_() {}
 
 template <typename T>
 Blocker<T>::~Blocker() {
-  published_msg_queue_.clear();
-  observed_msg_queue_.clear();
+  published_msg_queue_.reset();
+  observed_msg_queue_.reset();
   published_callbacks_.clear();
 }
 
@@ -140,8 +149,8 @@ template <typename T>
 void Blocker<T>::Reset() {
   {
     std::lock_guard<std::mutex> lock(msg_mutex_);
-    observed_msg_queue_.clear();
-    published_msg_queue_.clear();
+    observed_msg_queue_ = std::make_shared<MessageQueue>();
+    published_msg_queue_ = std::make_shared<MessageQueue>();
   }
   {
     std::lock_guard<std::mutex> lock(cb_mutex_);
@@ -152,13 +161,13 @@ void Blocker<T>::Reset() {
 template <typename T>
 void Blocker<T>::ClearObserved() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  observed_msg_queue_.clear();
+  observed_msg_queue_ = std::make_shared<MessageQueue>();
 }
 
 template <typename T>
 void Blocker<T>::ClearPublished() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.clear();
+  published_msg_queue_ = std::make_shared<MessageQueue>();
 }
 
 template <typename T>
@@ -170,13 +179,13 @@ void Blocker<T>::Observe() {
 template <typename T>
 bool Blocker<T>::IsObservedEmpty() const {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  return observed_msg_queue_.empty();
+  return observed_msg_queue_->empty();
 }
 
 template <typename T>
 bool Blocker<T>::IsPublishedEmpty() const {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  return published_msg_queue_.empty();
+  return published_msg_queue_->empty();
 }
 
 template <typename T>
@@ -199,47 +208,47 @@ bool Blocker<T>::Unsubscribe(const std::string& callback_id) {
 template <typename T>
 auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
+  if (observed_msg_queue_->empty()) {
     return dummy_msg_;
   }
-  return *observed_msg_queue_.front();
+  return *observed_msg_queue_->front();
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
+  if (observed_msg_queue_->empty()) {
     return nullptr;
   }
-  return observed_msg_queue_.front();
+  return observed_msg_queue_->front();
 }
 
 template <typename T>
 auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
+  if (observed_msg_queue_->empty()) {
     return nullptr;
   }
-  return observed_msg_queue_.back();
+  return observed_msg_queue_->back();
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (published_msg_queue_.empty()) {
+  if (published_msg_queue_->empty()) {
     return nullptr;
   }
-  return published_msg_queue_.front();
+  return published_msg_queue_->front();
 }
 
 template <typename T>
 auto Blocker<T>::ObservedBegin() const -> Iterator {
-  return observed_msg_queue_.begin();
+  return observed_msg_queue_->begin();
 }
 
 template <typename T>
 auto Blocker<T>::ObservedEnd() const -> Iterator {
-  return observed_msg_queue_.end();
+  return observed_msg_queue_->end();
 }
 
 template <typename T>
@@ -251,8 +260,12 @@ template <typename T>
 void Blocker<T>::set_capacity(size_t capacity) {
   std::lock_guard<std::mutex> lock(msg_mutex_);
   attr_.capacity = capacity;
-  while (published_msg_queue_.size() > capacity) {
-    published_msg_queue_.pop_back();
+  if (published_msg_queue_->size() <= capacity) {
+    return;
+  }
+  auto queue = MutablePublishedQueue();
+  while (queue->size() > capacity) {
+    queue->pop_back();
   }
 }
 
@@ -267,10 +280,21 @@ void Blocker<T>::Enqueue(const MessagePtr& msg) {
     return;
   }
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.push_front(msg);
-  while (published_msg_queue_.size() > attr_.capacity) {
-    published_msg_queue_.pop_back();
+  auto queue = MutablePublishedQueue();
+  queue->push_front(msg);
+  while (queue->size() > attr_.capacity) {
+    queue->pop_back();
+  }
+}
+
+template <typename T>
+auto Blocker<T>::MutablePublishedQueue() -> MessageQueue* {
+  // only the observed queue shares it, both are guarded by msg_mutex_
+  if (published_msg_queue_ == observed_msg_queue_) {
+    published_msg_queue_ =
+        std::make_shared<MessageQueue>(*published_msg_queue_);
   }
+  return published_msg_queue_.get();
 }
 
 template <typename T>
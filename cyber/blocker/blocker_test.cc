@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "cyber/proto/unit_test.pb.h"
 
@@ -105,6 +107,49 @@ TEST(BlockerTest, subscribe) {
   EXPECT_FALSE(res);
 }
 
+TEST(BlockerTest, observe_snapshot) {
+  BlockerAttr attr(2, "channel");
+  Blocker<UnitTest> blocker(attr);
+
+  auto msg1 = std::make_shared<UnitTest>();
+  msg1->set_case_name("observe_1");
+  auto msg2 = std::make_shared<UnitTest>();
+  msg2->set_case_name("observe_2");
+  auto msg3 = std::make_shared<UnitTest>();
+  msg3->set_case_name("observe_3");
+
+  blocker.Publish(msg1);
+  blocker.Publish(msg2);
+  blocker.Observe();
+  // the observed messages are the published ones, not copies
+  EXPECT_EQ(blocker.GetLatestObservedPtr(), msg2);
+  EXPECT_EQ(blocker.GetOldestObservedPtr(), msg1);
+
+  // publishing after observing leaves the observed messages untouched
+  blocker.Publish(msg3);
+  EXPECT_EQ(blocker.GetLatestPublishedPtr(), msg3);
+  EXPECT_EQ(blocker.GetLatestObservedPtr(), msg2);
+  EXPECT_EQ(blocker.GetOldestObservedPtr(), msg1);
+  std::vector<std::string> observed;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed.push_back((*it)->case_name());
+  }
+  EXPECT_EQ(observed, std::vector<std::string>({"observe_2", "observe_1"}));
+
+  blocker.ClearPublished();
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+  EXPECT_FALSE(blocker.IsObservedEmpty());
+
+  blocker.Observe();
+  EXPECT_TRUE(blocker.IsObservedEmpty());
+  blocker.Publish(msg1);
+  EXPECT_TRUE(blocker.IsObservedEmpty());
+  blocker.Observe();
+  blocker.set_capacity(0);
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+  EXPECT_EQ(blocker.GetLatestObservedPtr(), msg1);
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
@@ -191,7 +191,7 @@ auto IntraReader<MessageT>::End() const -> Iterator {
   auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
       this->role_attr_.channel_name());
   ACHECK(blocker != nullptr);
-  return blocker->ObservedBegin();
+  return blocker->ObservedEnd();
 }
 
 template <typename MessageT>
@@ -158,6 +158,19 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
     }
   };
 
+  if (likely(is_reality_mode) && config.readers(0).fused()) {
+    // writers of the channel in this process call Proc directly, a blocker
+    // without capacity keeps no message
+    auto blocker = blocker::BlockerManager::Instance()->GetOrCreateBlocker<M0>(
+        blocker::BlockerAttr(0, reader_cfg.channel_name));
+    if (blocker == nullptr || !blocker->Subscribe(node_->Name(), func)) {
+      AERROR << "Component fuse reader failed.";
+      return false;
+    }
+    fused_blockers_.emplace_back(std::move(blocker));
+    return true;
+  }
+
   std::shared_ptr<Reader<M0>> reader = nullptr;
 
   if (likely(is_reality_mode)) {
@@ -182,6 +195,7 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0>(func, dv);
   auto sched = scheduler::Instance();
+  sched->SetTaskDeadline(node_->Name(), config.period_ms(), config.budget_ms());
   return sched->CreateTask(factory, node_->Name());
 }
 
@@ -275,9 +289,11 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list,
+                                                        config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1>(func, dv);
+  sched->SetTaskDeadline(node_->Name(), config.period_ms(), config.budget_ms());
   return sched->CreateTask(factory, node_->Name());
 }
 
@@ -385,9 +401,11 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list,
+                                                            config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2>(func, dv);
+  sched->SetTaskDeadline(node_->Name(), config.period_ms(), config.budget_ms());
   return sched->CreateTask(factory, node_->Name());
 }
 
@@ -508,9 +526,11 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(
+      config_list, config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2, M3>(func, dv);
+  sched->SetTaskDeadline(node_->Name(), config.period_ms(), config.budget_ms());
   return sched->CreateTask(factory, node_->Name());
 }
 
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "cyber/blocker/blocker.h"
 #include "cyber/class_loader/class_loader.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
@@ -54,6 +55,9 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     for (auto& reader : readers_) {
       reader->Shutdown();
     }
+    for (auto& blocker : fused_blockers_) {
+      blocker->Unsubscribe(node_->Name());
+    }
     scheduler::Instance()->RemoveTask(node_->Name());
   }
 
@@ -111,6 +115,7 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
   std::shared_ptr<Node> node_ = nullptr;
   std::string config_file_path_ = "";
   std::vector<std::shared_ptr<ReaderBase>> readers_;
+  std::vector<std::shared_ptr<blocker::BlockerBase>> fused_blockers_;
 };
 
 }  // namespace cyber
@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 
+#include "cyber/cyber.h"
 #include "cyber/init.h"
 #include "cyber/message/raw_message.h"
 
@@ -67,6 +68,22 @@ class Component_C : public Component<M0> {
   bool Proc(const std::shared_ptr<M0> &) { return ret_proc; }
 };
 
+template <typename M0>
+class Component_D : public Component<M0> {
+ public:
+  Component_D() {}
+  bool Init() { return true; }
+  int proc_count() const { return proc_count_; }
+
+ private:
+  bool Proc(const std::shared_ptr<M0> &) {
+    ++proc_count_;
+    return true;
+  }
+
+  int proc_count_ = 0;
+};
+
 TEST(TimerComponent, init) {
   ret_proc = true;
   ret_init = true;
@@ -135,6 +152,29 @@ TEST(TimerComponentFail, init) {
   EXPECT_EQ(false, comA->Process(msg_str1, msg_str2, msg_str3, msg_str4));
 }
 
+TEST(FusedComponent, proc) {
+  apollo::cyber::proto::ComponentConfig compcfg;
+  compcfg.set_name("fused");
+  apollo::cyber::proto::ReaderOption *read_opt = compcfg.add_readers();
+  read_opt->set_channel("/fused/channel");
+  read_opt->set_fused(true);
+  auto comD = std::make_shared<Component_D<RawMessage>>();
+  EXPECT_TRUE(comD->Initialize(compcfg));
+
+  auto node = CreateNode("fused_writer");
+  auto writer = node->CreateWriter<RawMessage>("/fused/channel");
+  ASSERT_NE(writer, nullptr);
+  // Proc runs within Write
+  EXPECT_TRUE(writer->Write(std::make_shared<RawMessage>("fused")));
+  EXPECT_EQ(1, comD->proc_count());
+  EXPECT_TRUE(writer->Write(RawMessage("fused")));
+  EXPECT_EQ(2, comD->proc_count());
+
+  comD->Shutdown();
+  EXPECT_TRUE(writer->Write(RawMessage("fused")));
+  EXPECT_EQ(2, comD->proc_count());
+}
+
 }  // namespace cyber
 }  // namespace apollo
 
@@ -31,6 +31,10 @@ bool TimerComponent::Process() {
   return Proc();
 }
 
+const TimerStatistics* TimerComponent::timer_statistics() const {
+  return timer_ ? &timer_->statistics() : nullptr;
+}
+
 bool TimerComponent::Initialize(const TimerComponentConfig& config) {
   if (!config.has_name() || !config.has_interval()) {
     AERROR << "Missing required field in config file.";
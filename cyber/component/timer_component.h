@@ -25,6 +25,7 @@ namespace apollo {
 namespace cyber {
 
 class Timer;
+struct TimerStatistics;
 
 class TimerComponent : public ComponentBase {
  public:
@@ -34,6 +35,9 @@ class TimerComponent : public ComponentBase {
   bool Initialize(const TimerComponentConfig& config) override;
   bool Process();
 
+  // fire jitter of the component's timer, nullptr before Initialize
+  const TimerStatistics* timer_statistics() const;
+
  private:
   virtual bool Proc() = 0;
   virtual bool Init() = 0;
@@ -16,12 +16,13 @@
 
 #include "cyber/croutine/croutine.h"
 
+#include <sched.h>
 #include <utility>
 
-#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/detail/stack_pool.h"
 #include "cyber/event/perf_event_cache.h"
 
 namespace apollo {
@@ -35,8 +36,14 @@ thread_local CRoutine *CRoutine::current_routine_ = nullptr;
 thread_local char *CRoutine::main_stack_ = nullptr;
 
 namespace {
-std::shared_ptr<base::CCObjectPool<RoutineContext>> context_pool = nullptr;
 std::once_flag pool_init_flag;
+size_t default_stack_size = STACK_SIZE;
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
 
 void CRoutineEntry(void *arg) {
   CRoutine *r = static_cast<CRoutine *>(arg);
@@ -45,23 +52,27 @@ void CRoutineEntry(void *arg) {
 }
 }  // namespace
 
-CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
+CRoutine::CRoutine(const std::function<void()> &func, size_t stack_size)
+    : func_(func) {
   std::call_once(pool_init_flag, [&]() {
-    auto routine_num = 100;
     auto &global_conf = common::GlobalData::Instance()->Config();
-    if (global_conf.has_scheduler_conf() &&
-        global_conf.scheduler_conf().has_routine_num()) {
-      routine_num = global_conf.scheduler_conf().routine_num();
+    if (global_conf.has_scheduler_conf()) {
+      auto &sched_conf = global_conf.scheduler_conf();
+      // routine_num bounds the stacks cached for reuse.
+      if (sched_conf.has_routine_num()) {
+        StackPool::Instance()->SetMaxCached(sched_conf.routine_num());
+      }
+      if (sched_conf.has_default_stack_size_kb()) {
+        default_stack_size = sched_conf.default_stack_size_kb() * 1024;
+      }
     }
-    context_pool.reset(new base::CCObjectPool<RoutineContext>(routine_num));
   });
 
-  context_ = context_pool->GetObject();
-  if (context_ == nullptr) {
-    AWARN << "Maximum routine context number exceeded! Please check "
-             "[routine_num] in config file.";
-    context_.reset(new RoutineContext());
+  if (stack_size == 0) {
+    stack_size = default_stack_size;
   }
+  context_ = StackPool::Instance()->GetContext(stack_size);
+  ACHECK(context_ != nullptr) << "Failed to allocate croutine stack.";
 
   MakeContext(CRoutineEntry, this, context_.get());
   state_ = RoutineState::READY;
@@ -81,6 +92,12 @@ RoutineState CRoutine::Resume() {
     return state_;
   }
 
+  auto start = NowNs();
+  auto notified = notify_time_.exchange(0, std::memory_order_relaxed);
+  if (notified != 0 && notified < start) {
+    statistics_.wait_time.Add(start - notified);
+  }
+
   current_routine_ = this;
   PerfEventCache::Instance()->AddSchedEvent(
       SchedPerf::SWAP_IN, id_, processor_id_, static_cast<int>(state_));
@@ -88,11 +105,28 @@ RoutineState CRoutine::Resume() {
   PerfEventCache::Instance()->AddSchedEvent(
       SchedPerf::SWAP_OUT, id_, processor_id_, static_cast<int>(state_));
   current_routine_ = nullptr;
+
+  auto end = NowNs();
+  statistics_.run_time.Add(end - start);
+  statistics_.switch_count.store(
+      statistics_.switch_count.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  statistics_.cpu.store(sched_getcpu(), std::memory_order_relaxed);
+  if (state_ == RoutineState::READY) {
+    // still runnable, it waits from now on for a processor
+    uint64_t expected = 0;
+    notify_time_.compare_exchange_strong(expected, end,
+                                         std::memory_order_relaxed);
+  }
   return state_;
 }
 
 void CRoutine::Stop() { force_stop_ = true; }
 
+size_t CRoutine::StackHighWater() const {
+  return StackPool::HighWater(*context_);
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
@@ -27,6 +27,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/detail/routine_statistics.h"
 
 namespace apollo {
 namespace cyber {
@@ -39,7 +40,8 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 
 class CRoutine {
  public:
-  explicit CRoutine(const RoutineFunc &func);
+  // stack_size of 0 takes default_stack_size_kb of the scheduler conf
+  explicit CRoutine(const RoutineFunc &func, size_t stack_size = 0);
   virtual ~CRoutine();
 
   // static interfaces
@@ -88,6 +90,12 @@ class CRoutine {
 
   std::chrono::steady_clock::time_point wake_time() const;
 
+  const RoutineStatistics &statistics() const { return statistics_; }
+
+  size_t stack_size() const { return context_->stack_size; }
+  // Deepest stack usage so far, cheap enough to sample periodically.
+  size_t StackHighWater() const;
+
   void set_group_name(const std::string &group_name) {
     group_name_ = group_name;
   }
@@ -110,6 +118,10 @@ class CRoutine {
   std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
   std::atomic_flag updated_ = ATOMIC_FLAG_INIT;
 
+  // steady clock ns of the first wakeup not yet served, 0 if none
+  std::atomic<uint64_t> notify_time_ = {0};
+  RoutineStatistics statistics_;
+
   bool force_stop_ = false;
 
   int processor_id_ = -1;
@@ -118,6 +130,8 @@ class CRoutine {
 
   std::string group_name_;
 
+  void MarkNotified();
+
   static thread_local CRoutine *current_routine_;
   static thread_local char *main_stack_;
 };
@@ -150,7 +164,10 @@ inline std::chrono::steady_clock::time_point CRoutine::wake_time() const {
   return wake_time_;
 }
 
-inline void CRoutine::Wake() { state_ = RoutineState::READY; }
+inline void CRoutine::Wake() {
+  MarkNotified();
+  state_ = RoutineState::READY;
+}
 
 inline void CRoutine::HangUp() { CRoutine::Yield(RoutineState::DATA_WAIT); }
 
@@ -203,9 +220,22 @@ inline void CRoutine::Release() {
 }
 
 inline void CRoutine::SetUpdateFlag() {
+  MarkNotified();
   updated_.clear(std::memory_order_release);
 }
 
+inline void CRoutine::MarkNotified() {
+  if (notify_time_.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+  uint64_t expected = 0;
+  notify_time_.compare_exchange_strong(
+      expected, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count(),
+      std::memory_order_relaxed);
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
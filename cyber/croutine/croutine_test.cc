@@ -15,7 +15,11 @@
  *****************************************************************************/
 #include "cyber/croutine/croutine.h"
 
+#include <cstring>
+#include <thread>
+
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/detail/stack_pool.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
 #include "gtest/gtest.h"
@@ -48,6 +52,82 @@ TEST(Croutine, croutinetest) {
   EXPECT_EQ(cr->Resume(), RoutineState::FINISHED);
 }
 
+void deep_function() {
+  volatile char buf[64 * 1024];
+  for (size_t i = 0; i < sizeof(buf); i += 512) {
+    buf[i] = 1;
+  }
+  CRoutine::Yield(RoutineState::IO_WAIT);
+}
+
+TEST(Croutine, stack_high_water) {
+  auto cr = std::make_shared<CRoutine>(deep_function, 256 * 1024);
+  EXPECT_EQ(256 * 1024, cr->stack_size());
+  auto initial = cr->StackHighWater();
+  EXPECT_GT(initial, 0);
+  EXPECT_LT(initial, 64 * 1024);
+
+  cr->Resume();
+  EXPECT_EQ(cr->state(), RoutineState::IO_WAIT);
+  EXPECT_GE(cr->StackHighWater(), 64 * 1024);
+  EXPECT_LE(cr->StackHighWater(), 256 * 1024);
+}
+
+TEST(Croutine, statistics) {
+  RoutineHistogram hist;
+  EXPECT_EQ(0, hist.Percentile(50));
+  for (uint64_t i = 1; i <= 100; ++i) {
+    hist.Add(i * 1000);
+  }
+  EXPECT_EQ(100, hist.count());
+  EXPECT_EQ(50500, hist.mean());
+  EXPECT_EQ(100000, hist.max());
+  EXPECT_GE(hist.Percentile(50), 50000);
+  EXPECT_LE(hist.Percentile(50), 2 * 50000);
+  EXPECT_EQ(RoutineHistogram::kBucketNum - 1,
+            RoutineHistogram::BucketIndex(UINT64_MAX));
+
+  auto cr = std::make_shared<CRoutine>(
+      []() { CRoutine::Yield(RoutineState::DATA_WAIT); });
+  cr->Resume();
+  auto& stats = cr->statistics();
+  EXPECT_EQ(1, stats.switch_count.load());
+  EXPECT_EQ(1, stats.run_time.count());
+  EXPECT_EQ(0, stats.wait_time.count());
+  EXPECT_GE(stats.cpu.load(), 0);
+
+  cr->SetUpdateFlag();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  cr->UpdateState();
+  cr->Resume();
+  EXPECT_EQ(2, stats.switch_count.load());
+  EXPECT_EQ(1, stats.wait_time.count());
+  EXPECT_GE(stats.wait_time.max(), 2000000);
+}
+
+TEST(Croutine, stack_pool) {
+  auto pool = StackPool::Instance();
+  EXPECT_EQ(StackPool::RoundUp(100), StackPool::RoundUp(1));
+  EXPECT_EQ(StackPool::RoundUp(32 * 1024), 32 * 1024);
+
+  auto ctx = pool->GetContext(32 * 1024);
+  ASSERT_NE(nullptr, ctx);
+  auto stack = ctx->stack;
+  std::memset(stack, 1, ctx->stack_size);
+  EXPECT_EQ(32 * 1024, StackPool::HighWater(*ctx));
+  EXPECT_DEATH(stack[-1] = 0, "");
+
+  auto cached = pool->cached_num();
+  ctx.reset();
+  EXPECT_EQ(cached + 1, pool->cached_num());
+
+  // reused stacks start out untouched
+  ctx = pool->GetContext(32 * 1024);
+  EXPECT_EQ(stack, ctx->stack);
+  EXPECT_EQ(0, StackPool::HighWater(*ctx));
+  EXPECT_EQ(cached, pool->cached_num());
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
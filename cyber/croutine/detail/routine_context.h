@@ -35,8 +35,10 @@ constexpr size_t STACK_SIZE = 2 * 1024 * 1024;
 constexpr size_t REGISTERS_SIZE = 56;
 
 typedef void (*func)(void*);
+// The stack is owned by StackPool, just below it sits a guard page.
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  char* stack = nullptr;
+  size_t stack_size = 0;
   char* sp = nullptr;
 };
 
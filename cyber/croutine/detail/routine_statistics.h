@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_ROUTINE_STATISTICS_H_
+#define CYBER_CROUTINE_DETAIL_ROUTINE_STATISTICS_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Power of two histogram of durations in nanoseconds. Add is only called by
+// the processor holding the croutine, so plain relaxed stores suffice and
+// readers may see a slightly stale snapshot.
+class RoutineHistogram {
+ public:
+  // the last bucket collects everything above 2^(kBucketNum - 1) ns
+  static const uint32_t kBucketNum = 36;
+
+  RoutineHistogram() {
+    for (auto& bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void Add(uint64_t value) {
+    auto& bucket = buckets_[BucketIndex(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed)) {
+      max_.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t mean() const {
+    auto count = this->count();
+    return count ? sum_.load(std::memory_order_relaxed) / count : 0;
+  }
+
+  // upper bound of the bucket holding |percentile| in [0, 100]
+  uint64_t Percentile(double percentile) const {
+    auto count = this->count();
+    if (count == 0) {
+      return 0;
+    }
+    auto rank =
+        static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < kBucketNum; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen > rank) {
+        return i + 1 < kBucketNum ? (1ULL << i) : max();
+      }
+    }
+    return max();
+  }
+
+  static uint32_t BucketIndex(uint64_t value) {
+    uint32_t index = value ? 64 - __builtin_clzll(value) : 0;
+    return index < kBucketNum ? index : kBucketNum - 1;
+  }
+
+ private:
+  std::atomic<uint64_t> buckets_[kBucketNum];
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> sum_ = {0};
+  std::atomic<uint64_t> max_ = {0};
+};
+
+struct RoutineStatistics {
+  // from SetUpdateFlag, Wake or a ready yield until the next Resume
+  RoutineHistogram wait_time;
+  RoutineHistogram run_time;
+  std::atomic<uint64_t> switch_count = {0};
+  std::atomic<int> cpu = {-1};
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_ROUTINE_STATISTICS_H_
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+namespace {
+constexpr size_t MIN_STACK_SIZE = 16 * 1024;
+
+size_t PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+}  // namespace
+
+StackPool::StackPool() {}
+
+StackPool::~StackPool() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  for (auto& item : free_stacks_) {
+    for (auto stack : item.second) {
+      munmap(stack - PageSize(), item.first + PageSize());
+    }
+  }
+  free_stacks_.clear();
+}
+
+size_t StackPool::RoundUp(size_t stack_size) {
+  auto page_size = PageSize();
+  stack_size = std::max(stack_size, MIN_STACK_SIZE);
+  return (stack_size + page_size - 1) / page_size * page_size;
+}
+
+std::shared_ptr<RoutineContext> StackPool::GetContext(size_t stack_size) {
+  auto size = RoundUp(stack_size);
+  char* stack = nullptr;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    auto& stacks = free_stacks_[size];
+    if (!stacks.empty()) {
+      stack = stacks.back();
+      stacks.pop_back();
+      --cached_num_;
+    }
+  }
+
+  if (stack == nullptr) {
+    auto page_size = PageSize();
+    void* base = mmap(nullptr, size + page_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+      AERROR << "mmap croutine stack of " << size
+             << " bytes failed: " << std::strerror(errno);
+      return nullptr;
+    }
+    if (mprotect(base, page_size, PROT_NONE) != 0) {
+      AWARN << "protect croutine stack guard page failed: "
+            << std::strerror(errno);
+    }
+    stack = static_cast<char*>(base) + page_size;
+  }
+
+  auto ctx = new RoutineContext();
+  ctx->stack = stack;
+  ctx->stack_size = size;
+  return std::shared_ptr<RoutineContext>(
+      ctx, [this](RoutineContext* ctx) { Recycle(ctx); });
+}
+
+void StackPool::Recycle(RoutineContext* ctx) {
+  // give the pages back, which also resets the high water mark
+  madvise(ctx->stack, ctx->stack_size, MADV_DONTNEED);
+
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (cached_num_ < max_cached_) {
+      free_stacks_[ctx->stack_size].emplace_back(ctx->stack);
+      ++cached_num_;
+      cached = true;
+    }
+  }
+
+  if (!cached) {
+    munmap(ctx->stack - PageSize(), ctx->stack_size + PageSize());
+  }
+  delete ctx;
+}
+
+size_t StackPool::cached_num() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  return cached_num_;
+}
+
+size_t StackPool::HighWater(const RoutineContext& ctx) {
+  auto page_size = PageSize();
+  auto page_num = ctx.stack_size / page_size;
+  std::vector<unsigned char> resident(page_num);
+  if (mincore(ctx.stack, ctx.stack_size, resident.data()) != 0) {
+    return 0;
+  }
+
+  // the stack grows down, the lowest resident page is the deepest one
+  for (size_t i = 0; i < page_num; ++i) {
+    if (resident[i] & 1) {
+      return (page_num - i) * page_size;
+    }
+  }
+  return 0;
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
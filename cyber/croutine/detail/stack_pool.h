@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+#define CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Hands out mmap backed croutine stacks with a PROT_NONE guard page below
+// each of them, so an overflow faults instead of corrupting the heap.
+// Released stacks are dropped from RSS and cached per size for reuse.
+class StackPool {
+ public:
+  ~StackPool();
+
+  std::shared_ptr<RoutineContext> GetContext(size_t stack_size);
+
+  // Bytes of the stack touched so far, sampled with page granularity.
+  static size_t HighWater(const RoutineContext& ctx);
+  static size_t RoundUp(size_t stack_size);
+
+  void SetMaxCached(size_t max_cached) { max_cached_ = max_cached; }
+  size_t cached_num();
+
+ private:
+  void Recycle(RoutineContext* ctx);
+
+  std::mutex mutex_;
+  size_t max_cached_ = 100;
+  size_t cached_num_ = 0;
+  std::unordered_map<size_t, std::vector<char*>> free_stacks_;
+
+  DECLARE_SINGLETON(StackPool)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_POOL_H_
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_ATOMIC_CACHE_BUFFER_H_
+#define CYBER_DATA_ATOMIC_CACHE_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+enum class ReadResult { OK, NOT_READY, OVERWRITTEN };
+
+// Ring buffer with the indexing of CacheBuffer that is safe for many writers
+// and one reader without a buffer wide mutex. Writers reserve a position with
+// one fetch_add, readers validate every slot by the position stored in it.
+// A slot is only guarded by a spin flag held for a single copy of the value,
+// so a writer and the reader contend only when they touch the same slot.
+template <typename T>
+class AtomicCacheBuffer {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  explicit AtomicCacheBuffer(uint32_t size)
+      : capacity_(std::max<uint32_t>(size, 1)),
+        slots_(new Slot[capacity_]) {}
+
+  AtomicCacheBuffer(const AtomicCacheBuffer& other) = delete;
+  AtomicCacheBuffer& operator=(const AtomicCacheBuffer& other) = delete;
+
+  uint64_t Head() const {
+    auto tail = Tail();
+    return tail > capacity_ ? tail - capacity_ + 1 : 1;
+  }
+  // highest position filled so far, lower positions may still be in flight
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  uint64_t Size() const { return std::min<uint64_t>(Tail(), capacity_); }
+  uint64_t Capacity() const { return capacity_; }
+
+  bool Empty() const { return Tail() == 0; }
+  bool Full() const { return Tail() >= capacity_; }
+
+  void Fill(const T& value) {
+    auto pos = next_.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto& slot = slots_[pos % capacity_];
+    slot.Lock();
+    // a slower writer must not clobber a newer lap
+    if (slot.pos < pos) {
+      slot.value = value;
+      slot.pos = pos;
+    }
+    slot.Unlock();
+
+    auto tail = tail_.load(std::memory_order_relaxed);
+    while (tail < pos && !tail_.compare_exchange_weak(
+                             tail, pos, std::memory_order_release,
+                             std::memory_order_relaxed)) {
+    }
+  }
+
+  ReadResult Read(uint64_t pos, T* value) const {
+    auto& slot = slots_[pos % capacity_];
+    slot.Lock();
+    auto slot_pos = slot.pos;
+    if (slot_pos == pos) {
+      *value = slot.value;
+    }
+    slot.Unlock();
+
+    if (slot_pos == pos) {
+      return ReadResult::OK;
+    }
+    return slot_pos < pos ? ReadResult::NOT_READY : ReadResult::OVERWRITTEN;
+  }
+
+ private:
+  struct Slot {
+    void Lock() {
+      while (flag.test_and_set(std::memory_order_acquire)) {
+        cpu_relax();
+      }
+    }
+    void Unlock() { flag.clear(std::memory_order_release); }
+
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    uint64_t pos = 0;
+    T value;
+  };
+
+  const uint64_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> next_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
+};
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_ATOMIC_CACHE_BUFFER_H_
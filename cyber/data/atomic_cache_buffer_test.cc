@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/atomic_cache_buffer.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+using Result = ReadResult;
+
+TEST(AtomicCacheBufferTest, fill_and_read) {
+  AtomicCacheBuffer<int> buffer(4);
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(0, buffer.Size());
+
+  int value = -1;
+  EXPECT_EQ(Result::NOT_READY, buffer.Read(1, &value));
+  for (int i = 1; i <= 4; ++i) {
+    buffer.Fill(i * 10);
+    EXPECT_EQ(i, buffer.Tail());
+  }
+  EXPECT_TRUE(buffer.Full());
+  EXPECT_EQ(4, buffer.Size());
+  EXPECT_EQ(1, buffer.Head());
+  EXPECT_EQ(Result::OK, buffer.Read(1, &value));
+  EXPECT_EQ(10, value);
+
+  buffer.Fill(50);
+  EXPECT_EQ(2, buffer.Head());
+  EXPECT_EQ(5, buffer.Tail());
+  EXPECT_EQ(Result::OVERWRITTEN, buffer.Read(1, &value));
+  EXPECT_EQ(Result::OK, buffer.Read(5, &value));
+  EXPECT_EQ(50, value);
+  EXPECT_EQ(Result::NOT_READY, buffer.Read(6, &value));
+}
+
+TEST(AtomicCacheBufferTest, multi_writer) {
+  const int writer_num = 4;
+  const int fill_num = 20000;
+  AtomicCacheBuffer<std::shared_ptr<int>> buffer(16);
+
+  std::vector<std::thread> writers;
+  for (int w = 0; w < writer_num; ++w) {
+    writers.emplace_back([&buffer, w]() {
+      for (int i = 0; i < fill_num; ++i) {
+        buffer.Fill(std::make_shared<int>(w));
+      }
+    });
+  }
+
+  // the reader only ever sees completely written values
+  uint64_t read_num = 0;
+  std::shared_ptr<int> value;
+  while (buffer.Tail() < writer_num * fill_num) {
+    auto tail = buffer.Tail();
+    if (tail != 0 && buffer.Read(tail, &value) == Result::OK) {
+      ASSERT_NE(nullptr, value);
+      EXPECT_LT(*value, writer_num);
+      ++read_num;
+    }
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  EXPECT_EQ(writer_num * fill_num, buffer.Tail());
+  for (auto pos = buffer.Head(); pos <= buffer.Tail(); ++pos) {
+    EXPECT_EQ(Result::OK, buffer.Read(pos, &value));
+  }
+  EXPECT_GT(read_num, 0);
+}
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
@@ -20,10 +20,12 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/data/atomic_cache_buffer.h"
 #include "cyber/data/data_notifier.h"
 #include "cyber/proto/component_conf.pb.h"
 
@@ -36,7 +38,7 @@ using apollo::cyber::common::GlobalData;
 template <typename T>
 class ChannelBuffer {
  public:
-  using BufferType = CacheBuffer<std::shared_ptr<T>>;
+  using BufferType = AtomicCacheBuffer<std::shared_ptr<T>>;
   ChannelBuffer(uint64_t channel_id, BufferType* buffer)
       : channel_id_(channel_id), buffer_(buffer) {}
 
@@ -57,52 +59,67 @@ class ChannelBuffer {
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
+  while (true) {
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index == tail + 1) {
+      return false;
+    } else if (*index < buffer_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail
+            << "] ";
+      *index = tail;
+    }
+
+    switch (buffer_->Read(*index, &m)) {
+      case ReadResult::OK:
+        return true;
+      case ReadResult::NOT_READY:
+        // a writer has reserved it but not filled it yet
+        return false;
+      case ReadResult::OVERWRITTEN:
+        // lapped between the head check and the read, skip ahead
+        *index = buffer_->Tail();
+        break;
+    }
   }
-  m = buffer_->at(*index);
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+  auto tail = buffer_->Tail();
+  for (auto index = tail; index >= buffer_->Head() && index > 0; --index) {
+    if (buffer_->Read(index, &m) == ReadResult::OK) {
+      return true;
+    }
   }
-
-  m = buffer_->Back();
-  return true;
+  return false;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+  auto tail = buffer_->Tail();
+  if (tail == 0) {
     return false;
   }
 
   auto num = std::min(buffer_->Size(), fetch_size);
   vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  std::shared_ptr<T> m;
+  for (auto index = tail - num + 1; index <= tail; ++index) {
+    if (buffer_->Read(index, &m) == ReadResult::OK) {
+      vec->emplace_back(std::move(m));
+    }
   }
-  return true;
+  return !vec->empty();
 }
 
 }  // namespace data
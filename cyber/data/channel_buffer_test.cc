@@ -29,7 +29,7 @@ namespace data {
 auto channel0 = common::Hash("/channel0");
 
 TEST(ChannelBufferTest, Fetch) {
-  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(2);
+  auto cache_buffer = new AtomicCacheBuffer<std::shared_ptr<int>>(2);
   auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
   std::shared_ptr<int> msg;
   uint64_t index = 0;
@@ -52,7 +52,7 @@ TEST(ChannelBufferTest, Fetch) {
 }
 
 TEST(ChannelBufferTest, Latest) {
-  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(10);
+  auto cache_buffer = new AtomicCacheBuffer<std::shared_ptr<int>>(10);
   auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
   std::shared_ptr<int> msg;
   EXPECT_FALSE(buffer->Latest(msg));
@@ -69,7 +69,7 @@ TEST(ChannelBufferTest, Latest) {
 }
 
 TEST(ChannelBufferTest, FetchMulti) {
-  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(2);
+  auto cache_buffer = new AtomicCacheBuffer<std::shared_ptr<int>>(2);
   auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
   std::vector<std::shared_ptr<int>> vector;
   EXPECT_FALSE(buffer->FetchMulti(1, &vector));
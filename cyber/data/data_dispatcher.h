@@ -19,8 +19,10 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
+#include "cyber/base/atomic_open_hash_map.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/data/channel_buffer.h"
@@ -32,23 +34,27 @@ namespace cyber {
 namespace data {
 
 using apollo::cyber::Time;
-using apollo::cyber::base::AtomicHashMap;
+using apollo::cyber::base::AtomicOpenHashMap;
 
 template <typename T>
 class DataDispatcher {
  public:
   using BufferVector =
-      std::vector<std::weak_ptr<CacheBuffer<std::shared_ptr<T>>>>;
+      std::vector<std::weak_ptr<typename ChannelBuffer<T>::BufferType>>;
   ~DataDispatcher() {}
 
   void AddBuffer(const ChannelBuffer<T>& channel_buffer);
+  void RemoveBuffer(const ChannelBuffer<T>& channel_buffer);
 
   bool Dispatch(const uint64_t channel_id, const std::shared_ptr<T>& msg);
 
  private:
   DataNotifier* notifier_ = DataNotifier::Instance();
+  // Dispatch iterates an immutable snapshot without locking. Writers publish
+  // a new snapshot under buffers_map_mutex_; AtomicOpenHashMap never frees
+  // a replaced value, so dispatchers still holding the old one stay valid.
   std::mutex buffers_map_mutex_;
-  AtomicHashMap<uint64_t, BufferVector> buffers_map_;
+  AtomicOpenHashMap<uint64_t, BufferVector> buffers_map_;
 
   DECLARE_SINGLETON(DataDispatcher)
 };
@@ -59,14 +65,36 @@ inline DataDispatcher<T>::DataDispatcher() {}
 template <typename T>
 void DataDispatcher<T>::AddBuffer(const ChannelBuffer<T>& channel_buffer) {
   std::lock_guard<std::mutex> lock(buffers_map_mutex_);
-  auto buffer = channel_buffer.Buffer();
+  BufferVector new_buffers;
   BufferVector* buffers = nullptr;
   if (buffers_map_.Get(channel_buffer.channel_id(), &buffers)) {
-    buffers->emplace_back(buffer);
-  } else {
-    BufferVector new_buffers = {buffer};
-    buffers_map_.Set(channel_buffer.channel_id(), new_buffers);
+    for (auto& buffer : *buffers) {
+      if (!buffer.expired()) {
+        new_buffers.emplace_back(buffer);
+      }
+    }
+  }
+  new_buffers.emplace_back(channel_buffer.Buffer());
+  buffers_map_.Set(channel_buffer.channel_id(), std::move(new_buffers));
+}
+
+template <typename T>
+void DataDispatcher<T>::RemoveBuffer(const ChannelBuffer<T>& channel_buffer) {
+  std::lock_guard<std::mutex> lock(buffers_map_mutex_);
+  BufferVector* buffers = nullptr;
+  if (!buffers_map_.Get(channel_buffer.channel_id(), &buffers)) {
+    return;
+  }
+
+  auto target = channel_buffer.Buffer();
+  BufferVector new_buffers;
+  for (auto& buffer : *buffers) {
+    auto ptr = buffer.lock();
+    if (ptr != nullptr && ptr != target) {
+      new_buffers.emplace_back(buffer);
+    }
   }
+  buffers_map_.Set(channel_buffer.channel_id(), std::move(new_buffers));
 }
 
 template <typename T>
@@ -79,7 +107,6 @@ bool DataDispatcher<T>::Dispatch(const uint64_t channel_id,
   if (buffers_map_.Get(channel_id, &buffers)) {
     for (auto& buffer_wptr : *buffers) {
       if (auto buffer = buffer_wptr.lock()) {
-        std::lock_guard<std::mutex> lock(buffer->Mutex());
         buffer->Fill(msg);
       }
     }
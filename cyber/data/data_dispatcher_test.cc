@@ -28,15 +28,15 @@ namespace data {
 
 template <typename T>
 using BufferVector =
-    std::vector<std::weak_ptr<CacheBuffer<std::shared_ptr<T>>>>;
+    std::vector<std::weak_ptr<AtomicCacheBuffer<std::shared_ptr<T>>>>;
 
 auto channel0 = common::Hash("/channel0");
 auto channel1 = common::Hash("/channel1");
 
 TEST(DataDispatcher, AddBuffer) {
-  auto cache_buffer1 = new CacheBuffer<std::shared_ptr<int>>(2);
+  auto cache_buffer1 = new AtomicCacheBuffer<std::shared_ptr<int>>(2);
   auto buffer0 = ChannelBuffer<int>(channel0, cache_buffer1);
-  auto cache_buffer2 = new CacheBuffer<std::shared_ptr<int>>(2);
+  auto cache_buffer2 = new AtomicCacheBuffer<std::shared_ptr<int>>(2);
   auto buffer1 = ChannelBuffer<int>(channel1, cache_buffer2);
   auto dispatcher = DataDispatcher<int>::Instance();
   dispatcher->AddBuffer(buffer0);
@@ -44,7 +44,7 @@ TEST(DataDispatcher, AddBuffer) {
 }
 
 TEST(DataDispatcher, Dispatch) {
-  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(10);
+  auto cache_buffer = new AtomicCacheBuffer<std::shared_ptr<int>>(10);
   auto buffer = ChannelBuffer<int>(channel0, cache_buffer);
   auto dispatcher = DataDispatcher<int>::Instance();
   auto msg = std::make_shared<int>(1);
@@ -57,6 +57,32 @@ TEST(DataDispatcher, Dispatch) {
   EXPECT_TRUE(dispatcher->Dispatch(channel0, msg));
 }
 
+TEST(DataDispatcher, RemoveBuffer) {
+  auto channel2 = common::Hash("/channel2");
+  auto buffer0 = ChannelBuffer<int>(
+      channel2, new AtomicCacheBuffer<std::shared_ptr<int>>(10));
+  auto buffer1 = ChannelBuffer<int>(
+      channel2, new AtomicCacheBuffer<std::shared_ptr<int>>(10));
+  auto dispatcher = DataDispatcher<int>::Instance();
+  auto notifier = std::make_shared<Notifier>();
+  DataNotifier::Instance()->AddNotifier(channel2, notifier);
+  dispatcher->AddBuffer(buffer0);
+  dispatcher->AddBuffer(buffer1);
+
+  EXPECT_TRUE(dispatcher->Dispatch(channel2, std::make_shared<int>(1)));
+  EXPECT_EQ(1, buffer0.Buffer()->Size());
+  EXPECT_EQ(1, buffer1.Buffer()->Size());
+
+  dispatcher->RemoveBuffer(buffer0);
+  EXPECT_TRUE(dispatcher->Dispatch(channel2, std::make_shared<int>(2)));
+  EXPECT_EQ(1, buffer0.Buffer()->Size());
+  EXPECT_EQ(2, buffer1.Buffer()->Size());
+
+  DataNotifier::Instance()->RemoveNotifier(channel2, notifier);
+  EXPECT_FALSE(dispatcher->Dispatch(channel2, std::make_shared<int>(3)));
+  EXPECT_EQ(3, buffer1.Buffer()->Size());
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -19,8 +19,10 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
+#include "cyber/base/atomic_open_hash_map.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/data/cache_buffer.h"
@@ -32,7 +34,7 @@ namespace cyber {
 namespace data {
 
 using apollo::cyber::Time;
-using apollo::cyber::base::AtomicHashMap;
+using apollo::cyber::base::AtomicOpenHashMap;
 using apollo::cyber::event::PerfEventCache;
 
 struct Notifier {
@@ -47,11 +49,15 @@ class DataNotifier {
   void AddNotifier(uint64_t channel_id,
                    const std::shared_ptr<Notifier>& notifier);
 
+  void RemoveNotifier(uint64_t channel_id,
+                      const std::shared_ptr<Notifier>& notifier);
+
   bool Notify(const uint64_t channel_id);
 
  private:
+  // copy on write like DataDispatcher, Notify never takes the mutex
   std::mutex notifies_map_mutex_;
-  AtomicHashMap<uint64_t, NotifyVector> notifies_map_;
+  AtomicOpenHashMap<uint64_t, NotifyVector> notifies_map_;
 
   DECLARE_SINGLETON(DataNotifier)
 };
@@ -61,13 +67,34 @@ inline DataNotifier::DataNotifier() {}
 inline void DataNotifier::AddNotifier(
     uint64_t channel_id, const std::shared_ptr<Notifier>& notifier) {
   std::lock_guard<std::mutex> lock(notifies_map_mutex_);
+  NotifyVector new_notify;
   NotifyVector* notifies = nullptr;
   if (notifies_map_.Get(channel_id, &notifies)) {
-    notifies->emplace_back(notifier);
-  } else {
-    NotifyVector new_notify = {notifier};
-    notifies_map_.Set(channel_id, new_notify);
+    new_notify = *notifies;
+  }
+  new_notify.emplace_back(notifier);
+  notifies_map_.Set(channel_id, std::move(new_notify));
+}
+
+inline void DataNotifier::RemoveNotifier(
+    uint64_t channel_id, const std::shared_ptr<Notifier>& notifier) {
+  std::lock_guard<std::mutex> lock(notifies_map_mutex_);
+  NotifyVector* notifies = nullptr;
+  if (!notifies_map_.Get(channel_id, &notifies)) {
+    return;
+  }
+
+  NotifyVector new_notify;
+  for (auto& item : *notifies) {
+    if (item != notifier) {
+      new_notify.emplace_back(item);
+    }
+  }
+  if (new_notify.empty()) {
+    notifies_map_.Erase(channel_id);
+    return;
   }
+  notifies_map_.Set(channel_id, std::move(new_notify));
 }
 
 inline bool DataNotifier::Notify(const uint64_t channel_id) {
@@ -78,7 +105,7 @@ inline bool DataNotifier::Notify(const uint64_t channel_id) {
         notifier->callback();
       }
     }
-    return true;
+    return !notifies->empty();
   }
   return false;
 }
@@ -27,6 +27,7 @@
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/data/data_visitor_base.h"
 #include "cyber/data/fusion/all_latest.h"
+#include "cyber/data/fusion/approximate_time.h"
 #include "cyber/data/fusion/data_fusion.h"
 
 namespace apollo {
@@ -41,13 +42,19 @@ struct VisitorConfig {
 };
 
 template <typename T>
-using BufferType = CacheBuffer<std::shared_ptr<T>>;
+using BufferType = typename ChannelBuffer<T>::BufferType;
+
+inline uint64_t WindowNs(const proto::FusionOption& fusion) {
+  return static_cast<uint64_t>(fusion.window_ms()) * 1000000;
+}
 
 template <typename M0, typename M1 = NullType, typename M2 = NullType,
           typename M3 = NullType>
 class DataVisitor : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& fusion = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -61,8 +68,13 @@ class DataVisitor : public DataVisitorBase {
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     DataDispatcher<M3>::Instance()->AddBuffer(buffer_m3_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
-        buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    if (fusion.policy() == proto::FusionOption::APPROXIMATE_TIME) {
+      data_fusion_ = new fusion::ApproximateTime<M0, M1, M2, M3>(
+          WindowNs(fusion), buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    } else {
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
+          buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    }
   }
 
   ~DataVisitor() {
@@ -70,6 +82,11 @@ class DataVisitor : public DataVisitorBase {
       delete data_fusion_;
       data_fusion_ = nullptr;
     }
+    data_notifier_->RemoveNotifier(buffer_m0_.channel_id(), notifier_);
+    DataDispatcher<M0>::Instance()->RemoveBuffer(buffer_m0_);
+    DataDispatcher<M1>::Instance()->RemoveBuffer(buffer_m1_);
+    DataDispatcher<M2>::Instance()->RemoveBuffer(buffer_m2_);
+    DataDispatcher<M3>::Instance()->RemoveBuffer(buffer_m3_);
   }
 
   bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,    // NOLINT
@@ -92,7 +109,9 @@ class DataVisitor : public DataVisitorBase {
 template <typename M0, typename M1, typename M2>
 class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& fusion = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -103,8 +122,13 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ =
-        new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_, buffer_m2_);
+    if (fusion.policy() == proto::FusionOption::APPROXIMATE_TIME) {
+      data_fusion_ = new fusion::ApproximateTime<M0, M1, M2>(
+          WindowNs(fusion), buffer_m0_, buffer_m1_, buffer_m2_);
+    } else {
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_,
+                                                       buffer_m2_);
+    }
   }
 
   ~DataVisitor() {
@@ -112,6 +136,10 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
       delete data_fusion_;
       data_fusion_ = nullptr;
     }
+    data_notifier_->RemoveNotifier(buffer_m0_.channel_id(), notifier_);
+    DataDispatcher<M0>::Instance()->RemoveBuffer(buffer_m0_);
+    DataDispatcher<M1>::Instance()->RemoveBuffer(buffer_m1_);
+    DataDispatcher<M2>::Instance()->RemoveBuffer(buffer_m2_);
   }
 
   bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,  // NOLINT
@@ -133,7 +161,9 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
 template <typename M0, typename M1>
 class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& fusion = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -141,7 +171,12 @@ class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    if (fusion.policy() == proto::FusionOption::APPROXIMATE_TIME) {
+      data_fusion_ = new fusion::ApproximateTime<M0, M1>(
+          WindowNs(fusion), buffer_m0_, buffer_m1_);
+    } else {
+      data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    }
   }
 
   ~DataVisitor() {
@@ -149,6 +184,9 @@ class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
       delete data_fusion_;
       data_fusion_ = nullptr;
     }
+    data_notifier_->RemoveNotifier(buffer_m0_.channel_id(), notifier_);
+    DataDispatcher<M0>::Instance()->RemoveBuffer(buffer_m0_);
+    DataDispatcher<M1>::Instance()->RemoveBuffer(buffer_m1_);
   }
 
   bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1) {  // NOLINT
@@ -180,6 +218,11 @@ class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
     data_notifier_->AddNotifier(buffer_.channel_id(), notifier_);
   }
 
+  ~DataVisitor() {
+    data_notifier_->RemoveNotifier(buffer_.channel_id(), notifier_);
+    DataDispatcher<M0>::Instance()->RemoveBuffer(buffer_);
+  }
+
   bool TryFetch(std::shared_ptr<M0>& m0) {  // NOLINT
     if (buffer_.Fetch(&next_msg_index_, m0)) {
       next_msg_index_++;
@@ -0,0 +1,284 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
+#define CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/types.h"
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/fusion/data_fusion.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+template <typename T, typename = void>
+struct HasHeaderTimestamp : std::false_type {};
+
+template <typename T>
+struct HasHeaderTimestamp<
+    T, decltype(void(std::declval<const T&>().header().timestamp_sec()))>
+    : std::true_type {};
+
+// Messages carrying an apollo common Header are indexed by its timestamp,
+// everything else by the time the fusion first saw it.
+template <typename T>
+typename std::enable_if<HasHeaderTimestamp<T>::value, uint64_t>::type
+MessageTime(const T& msg, uint64_t fallback) {
+  auto sec = msg.header().timestamp_sec();
+  return sec > 0 ? static_cast<uint64_t>(sec * 1e9) : fallback;
+}
+
+template <typename T>
+typename std::enable_if<!HasHeaderTimestamp<T>::value, uint64_t>::type
+MessageTime(const T&, uint64_t fallback) {
+  return fallback;
+}
+
+class TimeQueueBase {
+ public:
+  virtual ~TimeQueueBase() {}
+  virtual void Drain(uint64_t now) = 0;
+  virtual void PopFront(size_t num) = 0;
+
+  bool Empty() const { return times_.empty(); }
+  size_t Size() const { return times_.size(); }
+  uint64_t Time(size_t i) const { return times_[i]; }
+  uint64_t NewestTime() const { return times_.back(); }
+
+ protected:
+  std::deque<uint64_t> times_;
+};
+
+template <typename T>
+class TimeQueue : public TimeQueueBase {
+ public:
+  explicit TimeQueue(const ChannelBuffer<T>& buffer)
+      : buffer_(buffer), capacity_(buffer.Buffer()->Capacity()) {}
+
+  void Drain(uint64_t now) override {
+    if (index_ == 0) {
+      // Fetch would start at the newest, keep the backlog for matching
+      index_ = buffer_.Buffer()->Head();
+    }
+    std::shared_ptr<T> msg;
+    while (buffer_.Fetch(&index_, msg)) {
+      ++index_;
+      times_.emplace_back(MessageTime(*msg, now));
+      msgs_.emplace_back(std::move(msg));
+      if (msgs_.size() > capacity_) {
+        PopFront(1);
+      }
+    }
+  }
+
+  void PopFront(size_t num) override {
+    for (size_t i = 0; i < num && !msgs_.empty(); ++i) {
+      times_.pop_front();
+      msgs_.pop_front();
+    }
+  }
+
+  const std::shared_ptr<T>& Msg(size_t i) const { return msgs_[i]; }
+
+ private:
+  ChannelBuffer<T> buffer_;
+  uint64_t index_ = 0;
+  uint64_t capacity_;
+  std::deque<std::shared_ptr<T>> msgs_;
+};
+
+// Channel 0 is the pivot: its oldest pending message is matched against the
+// nearest message of every other channel. A set fires once all of them are
+// within window of the pivot; a pivot that can no longer match (another
+// channel already moved past its window) is dropped. Each message is used
+// at most once.
+class ApproximateTimeMatcher {
+ public:
+  ApproximateTimeMatcher(uint64_t window_ns,
+                         std::vector<TimeQueueBase*> queues)
+      : window_ns_(window_ns),
+        queues_(std::move(queues)),
+        selected_(queues_.size(), 0) {}
+
+  bool Match() {
+    auto now = Time::Now().ToNanosecond();
+    for (auto queue : queues_) {
+      queue->Drain(now);
+    }
+
+    auto pivot = queues_[0];
+    while (!pivot->Empty()) {
+      auto t0 = pivot->Time(0);
+      bool matched = true;
+      for (size_t k = 1; k < queues_.size() && matched; ++k) {
+        auto queue = queues_[k];
+        while (!queue->Empty() && queue->Time(0) + window_ns_ < t0) {
+          queue->PopFront(1);
+        }
+        if (queue->Empty()) {
+          return false;
+        }
+        if (!Nearest(queue, t0, &selected_[k])) {
+          if (queue->NewestTime() <= t0 + window_ns_) {
+            return false;
+          }
+          matched = false;
+        }
+      }
+      if (matched) {
+        selected_[0] = 0;
+        return true;
+      }
+      pivot->PopFront(1);
+    }
+    return false;
+  }
+
+  size_t Selected(size_t k) const { return selected_[k]; }
+
+  void Consume() {
+    for (size_t k = 0; k < queues_.size(); ++k) {
+      queues_[k]->PopFront(selected_[k] + 1);
+    }
+  }
+
+ private:
+  bool Nearest(const TimeQueueBase* queue, uint64_t t0, size_t* index) const {
+    uint64_t best = UINT64_MAX;
+    for (size_t i = 0; i < queue->Size(); ++i) {
+      auto t = queue->Time(i);
+      auto diff = t > t0 ? t - t0 : t0 - t;
+      if (diff < best) {
+        best = diff;
+        *index = i;
+      }
+    }
+    return best <= window_ns_;
+  }
+
+  uint64_t window_ns_;
+  std::vector<TimeQueueBase*> queues_;
+  std::vector<size_t> selected_;
+};
+
+template <typename M0, typename M1 = NullType, typename M2 = NullType,
+          typename M3 = NullType>
+class ApproximateTime : public DataFusion<M0, M1, M2, M3> {
+ public:
+  ApproximateTime(uint64_t window_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1,
+                  const ChannelBuffer<M2>& buffer_2,
+                  const ChannelBuffer<M3>& buffer_3)
+      : queue_m0_(buffer_0),
+        queue_m1_(buffer_1),
+        queue_m2_(buffer_2),
+        queue_m3_(buffer_3),
+        matcher_(window_ns,
+                 {&queue_m0_, &queue_m1_, &queue_m2_, &queue_m3_}) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2, std::shared_ptr<M3>& m3) override {
+    if (!matcher_.Match()) {
+      return false;
+    }
+    m0 = queue_m0_.Msg(matcher_.Selected(0));
+    m1 = queue_m1_.Msg(matcher_.Selected(1));
+    m2 = queue_m2_.Msg(matcher_.Selected(2));
+    m3 = queue_m3_.Msg(matcher_.Selected(3));
+    matcher_.Consume();
+    return true;
+  }
+
+ private:
+  TimeQueue<M0> queue_m0_;
+  TimeQueue<M1> queue_m1_;
+  TimeQueue<M2> queue_m2_;
+  TimeQueue<M3> queue_m3_;
+  ApproximateTimeMatcher matcher_;
+};
+
+template <typename M0, typename M1, typename M2>
+class ApproximateTime<M0, M1, M2, NullType> : public DataFusion<M0, M1, M2> {
+ public:
+  ApproximateTime(uint64_t window_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1,
+                  const ChannelBuffer<M2>& buffer_2)
+      : queue_m0_(buffer_0),
+        queue_m1_(buffer_1),
+        queue_m2_(buffer_2),
+        matcher_(window_ns, {&queue_m0_, &queue_m1_, &queue_m2_}) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2) override {
+    if (!matcher_.Match()) {
+      return false;
+    }
+    m0 = queue_m0_.Msg(matcher_.Selected(0));
+    m1 = queue_m1_.Msg(matcher_.Selected(1));
+    m2 = queue_m2_.Msg(matcher_.Selected(2));
+    matcher_.Consume();
+    return true;
+  }
+
+ private:
+  TimeQueue<M0> queue_m0_;
+  TimeQueue<M1> queue_m1_;
+  TimeQueue<M2> queue_m2_;
+  ApproximateTimeMatcher matcher_;
+};
+
+template <typename M0, typename M1>
+class ApproximateTime<M0, M1, NullType, NullType> : public DataFusion<M0, M1> {
+ public:
+  ApproximateTime(uint64_t window_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1)
+      : queue_m0_(buffer_0),
+        queue_m1_(buffer_1),
+        matcher_(window_ns, {&queue_m0_, &queue_m1_}) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0,
+              std::shared_ptr<M1>& m1) override {
+    if (!matcher_.Match()) {
+      return false;
+    }
+    m0 = queue_m0_.Msg(matcher_.Selected(0));
+    m1 = queue_m1_.Msg(matcher_.Selected(1));
+    matcher_.Consume();
+    return true;
+  }
+
+ private:
+  TimeQueue<M0> queue_m0_;
+  TimeQueue<M1> queue_m1_;
+  ApproximateTimeMatcher matcher_;
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
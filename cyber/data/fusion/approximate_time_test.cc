@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/approximate_time.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+struct Header {
+  double timestamp_sec() const { return stamp; }
+  double stamp = 0.0;
+};
+
+struct Stamped {
+  explicit Stamped(double t) { h.stamp = t; }
+  const Header& header() const { return h; }
+  Header h;
+};
+
+template <typename T>
+ChannelBuffer<T> MakeBuffer(const std::string& channel) {
+  return ChannelBuffer<T>(
+      common::Hash(channel),
+      new typename ChannelBuffer<T>::BufferType(10));
+}
+
+void Fill(const ChannelBuffer<Stamped>& buffer, double t) {
+  buffer.Buffer()->Fill(std::make_shared<Stamped>(t));
+}
+
+TEST(ApproximateTimeTest, message_time) {
+  EXPECT_TRUE(HasHeaderTimestamp<Stamped>::value);
+  EXPECT_FALSE(HasHeaderTimestamp<int>::value);
+  EXPECT_EQ(1500000000, MessageTime(Stamped(1.5), 7));
+  EXPECT_EQ(7, MessageTime(Stamped(0.0), 7));
+  EXPECT_EQ(7, MessageTime(1, 7));
+}
+
+TEST(ApproximateTimeTest, two_channels) {
+  auto b0 = MakeBuffer<Stamped>("/at/two/0");
+  auto b1 = MakeBuffer<Stamped>("/at/two/1");
+  ApproximateTime<Stamped, Stamped> fusion(20000000, b0, b1);
+  uint64_t index = 0;
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+
+  // lidar not there yet, wait for it
+  Fill(b0, 1.00);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  Fill(b1, 0.95);
+  Fill(b1, 1.01);
+  Fill(b1, 1.10);
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(1.00, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.01, m1->header().timestamp_sec());
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  // 1.05 can never match, 1.10 already consumed the window
+  Fill(b0, 1.05);
+  Fill(b0, 1.11);
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(1.11, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.10, m1->header().timestamp_sec());
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+}
+
+TEST(ApproximateTimeTest, four_channels) {
+  auto b0 = MakeBuffer<Stamped>("/at/four/0");
+  auto b1 = MakeBuffer<Stamped>("/at/four/1");
+  auto b2 = MakeBuffer<Stamped>("/at/four/2");
+  auto b3 = MakeBuffer<Stamped>("/at/four/3");
+  ApproximateTime<Stamped, Stamped, Stamped, Stamped> fusion(10000000, b0,
+                                                             b1, b2, b3);
+  uint64_t index = 0;
+  std::shared_ptr<Stamped> m0, m1, m2, m3;
+
+  Fill(b0, 2.000);
+  Fill(b1, 2.005);
+  Fill(b2, 1.995);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3));
+  Fill(b3, 2.030);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3));
+
+  Fill(b0, 2.030);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3));
+  Fill(b1, 2.032);
+  Fill(b2, 2.027);
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1, m2, m3));
+  EXPECT_DOUBLE_EQ(2.030, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(2.032, m1->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(2.027, m2->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(2.030, m3->header().timestamp_sec());
+}
+
+TEST(ApproximateTimeTest, arrival_time) {
+  auto b0 = MakeBuffer<int>("/at/arrival/0");
+  auto b1 = MakeBuffer<int>("/at/arrival/1");
+  ApproximateTime<int, int> fusion(10000000, b0, b1);
+  uint64_t index = 0;
+  std::shared_ptr<int> m0;
+  std::shared_ptr<int> m1;
+
+  b0.Buffer()->Fill(std::make_shared<int>(1));
+  b1.Buffer()->Fill(std::make_shared<int>(2));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_EQ(1, *m0);
+  EXPECT_EQ(2, *m1);
+}
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/latency_reporter.h"
+
+#include <chrono>
+
+#include "cyber/common/global_data.h"
+#include "cyber/event/report_writer.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/transport/common/latency_statistics.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+using common::GlobalData;
+using proto::LatencyStats;
+using transport::LatencyStatistics;
+
+LatencyReporter::LatencyReporter() {}
+
+LatencyReporter::~LatencyReporter() { Shutdown(); }
+
+void LatencyReporter::Start() {
+  if (!LatencyStatistics::Instance()->enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+
+  proto::LatencyConf latency_conf;
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_transport_conf() &&
+      global_conf.transport_conf().has_latency_conf()) {
+    latency_conf.CopyFrom(global_conf.transport_conf().latency_conf());
+  }
+  interval_ms_ = latency_conf.report_interval_ms();
+
+  writer_ = CreateReportWriter<LatencyStats>("latency_reporter",
+                                             latency_conf.report_channel());
+  if (writer_ == nullptr) {
+    return;
+  }
+
+  running_ = true;
+  report_thread_ = std::thread(&LatencyReporter::Run, this);
+  scheduler::Instance()->SetInnerThreadAttr("latency_report",
+                                            &report_thread_);
+}
+
+void LatencyReporter::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (report_thread_.joinable()) {
+    report_thread_.join();
+  }
+  writer_->Shutdown();
+  writer_ = nullptr;
+}
+
+void LatencyReporter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                 [this] { return !running_; });
+    if (!running_) {
+      break;
+    }
+    auto stats = std::make_shared<LatencyStats>();
+    LatencyStatistics::Instance()->Dump(stats.get());
+    lock.unlock();
+    writer_->Write(stats);
+    lock.lock();
+  }
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
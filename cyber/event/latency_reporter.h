@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_LATENCY_REPORTER_H_
+#define CYBER_EVENT_LATENCY_REPORTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/node/writer.h"
+#include "cyber/proto/latency_stats.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Periodically publishes the transport latency histograms of this process
+// on the channel configured in transport_conf.latency_conf.
+class LatencyReporter {
+ public:
+  ~LatencyReporter();
+
+  void Start();
+  void Shutdown();
+
+ private:
+  void Run();
+
+  std::shared_ptr<Writer<proto::LatencyStats>> writer_;
+  std::thread report_thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  uint32_t interval_ms_ = 1000;
+
+  DECLARE_SINGLETON(LatencyReporter)
+};
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_LATENCY_REPORTER_H_
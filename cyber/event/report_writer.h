@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_REPORT_WRITER_H_
+#define CYBER_EVENT_REPORT_WRITER_H_
+
+#include <memory>
+#include <string>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/node/writer.h"
+#include "cyber/transport/qos/qos_profile_conf.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Creates a writer for a statistics reporter without going through a Node,
+// returns nullptr if the writer can not be initialized.
+template <typename MessageT>
+std::shared_ptr<Writer<MessageT>> CreateReportWriter(
+    const std::string& node_prefix, const std::string& channel) {
+  auto global_data = common::GlobalData::Instance();
+  std::string node_name =
+      node_prefix + "_" + std::to_string(global_data->ProcessId());
+  proto::RoleAttributes attr;
+  attr.set_host_name(global_data->HostName());
+  attr.set_host_ip(global_data->HostIp());
+  attr.set_process_id(global_data->ProcessId());
+  attr.set_node_name(node_name);
+  attr.set_node_id(common::GlobalData::RegisterNode(node_name));
+  attr.set_channel_name(channel);
+  attr.set_channel_id(common::GlobalData::RegisterChannel(channel));
+  attr.set_message_type(message::MessageType<MessageT>());
+  std::string proto_desc("");
+  message::GetDescriptorString<MessageT>(attr.message_type(), &proto_desc);
+  attr.set_proto_desc(proto_desc);
+  attr.mutable_qos_profile()->CopyFrom(
+      transport::QosProfileConf::QOS_PROFILE_DEFAULT);
+
+  auto writer = std::make_shared<Writer<MessageT>>(attr);
+  if (!writer->Init()) {
+    AERROR << node_name << " writer init failed.";
+    return nullptr;
+  }
+  return writer;
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_REPORT_WRITER_H_
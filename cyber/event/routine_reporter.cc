@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/routine_reporter.h"
+
+#include <chrono>
+
+#include "cyber/common/global_data.h"
+#include "cyber/event/report_writer.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+using common::GlobalData;
+using proto::RoutineStats;
+
+RoutineReporter::RoutineReporter() {}
+
+RoutineReporter::~RoutineReporter() { Shutdown(); }
+
+void RoutineReporter::Start() {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (!global_conf.has_scheduler_conf() ||
+      !global_conf.scheduler_conf().routine_stats_conf().enable()) {
+    return;
+  }
+  auto& stats_conf = global_conf.scheduler_conf().routine_stats_conf();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  interval_ms_ = stats_conf.report_interval_ms();
+
+  writer_ = CreateReportWriter<RoutineStats>("routine_reporter",
+                                             stats_conf.report_channel());
+  if (writer_ == nullptr) {
+    return;
+  }
+
+  running_ = true;
+  report_thread_ = std::thread(&RoutineReporter::Run, this);
+  scheduler::Instance()->SetInnerThreadAttr("routine_report",
+                                            &report_thread_);
+}
+
+void RoutineReporter::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (report_thread_.joinable()) {
+    report_thread_.join();
+  }
+  writer_->Shutdown();
+  writer_ = nullptr;
+}
+
+void RoutineReporter::Run() {
+  auto global_data = GlobalData::Instance();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                 [this] { return !running_; });
+    if (!running_) {
+      break;
+    }
+    lock.unlock();
+    auto stats = std::make_shared<RoutineStats>();
+    stats->set_host_name(global_data->HostName());
+    stats->set_process_id(global_data->ProcessId());
+    stats->set_timestamp(Time::Now().ToNanosecond());
+    scheduler::Instance()->GetRoutineStats(stats.get());
+    writer_->Write(stats);
+    lock.lock();
+  }
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
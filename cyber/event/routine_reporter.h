@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_ROUTINE_REPORTER_H_
+#define CYBER_EVENT_ROUTINE_REPORTER_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/node/writer.h"
+#include "cyber/proto/routine_stats.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Periodically publishes the wait time, run time and stack usage of every
+// croutine of this process on scheduler_conf.routine_stats_conf's channel.
+class RoutineReporter {
+ public:
+  ~RoutineReporter();
+
+  void Start();
+  void Shutdown();
+
+ private:
+  void Run();
+
+  std::shared_ptr<Writer<proto::RoutineStats>> writer_;
+  std::thread report_thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  uint32_t interval_ms_ = 1000;
+
+  DECLARE_SINGLETON(RoutineReporter)
+};
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_ROUTINE_REPORTER_H_
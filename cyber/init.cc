@@ -27,6 +27,8 @@
 #include "cyber/binary.h"
 #include "cyber/common/global_data.h"
 #include "cyber/data/data_dispatcher.h"
+#include "cyber/event/latency_reporter.h"
+#include "cyber/event/routine_reporter.h"
 #include "cyber/logger/async_logger.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
@@ -106,6 +108,8 @@ bool Init(const char* binary_name) {
     g_atexit_registered = true;
   }
   SetState(STATE_INITIALIZED);
+  event::LatencyReporter::Instance()->Start();
+  event::RoutineReporter::Instance()->Start();
   return true;
 }
 
@@ -114,6 +118,8 @@ void Clear() {
   if (GetState() == STATE_SHUTDOWN || GetState() == STATE_UNINITIALIZED) {
     return;
   }
+  event::LatencyReporter::CleanUp();
+  event::RoutineReporter::CleanUp();
   TaskManager::CleanUp();
   TimerManager::CleanUp();
   scheduler::CleanUp();
@@ -104,9 +104,9 @@ void PollHandler::ResponseCallback(const PollResponse& rsp) {
 
   response_ = rsp;
 
-  if (routine_->state() == RoutineState::IO_WAIT) {
-    routine_->SetUpdateFlag();
-  }
+  // The request is armed before the routine yields, so the response may
+  // come first. The update flag keeps it until the routine is in IO_WAIT.
+  routine_->SetUpdateFlag();
 }
 
 }  // namespace io
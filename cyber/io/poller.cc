@@ -22,6 +22,8 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/time/time.h"
@@ -60,24 +62,41 @@ bool Poller::Register(const PollRequest& req) {
     return false;
   }
 
-  PollCtrlParam ctrl_param;
-  ctrl_param.fd = req.fd;
-  ctrl_param.event.data.fd = req.fd;
-  ctrl_param.event.events = req.events;
+  epoll_event event;
+  event.data.fd = req.fd;
+  event.events = req.events;
+  uint64_t deadline_ns = kNoDeadline;
+  if (req.timeout_ms >= 0) {
+    deadline_ns = Time::Now().ToNanosecond() +
+                  static_cast<uint64_t>(req.timeout_ms) * 1000000;
+  }
 
+  bool need_notify = false;
   {
+    // epoll_ctl is thread safe, so the request is armed right here instead
+    // of waking up the poll thread to do it.
     WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    if (requests_.count(req.fd) == 0) {
-      ctrl_param.operation = EPOLL_CTL_ADD;
-      requests_[req.fd] = std::make_shared<PollRequest>();
-    } else {
-      ctrl_param.operation = EPOLL_CTL_MOD;
+    auto search = entries_.find(req.fd);
+    int operation = EPOLL_CTL_MOD;
+    if (search == entries_.end()) {
+      operation = EPOLL_CTL_ADD;
+      search = entries_.emplace(req.fd, PollEntry()).first;
+    }
+    search->second.request = req;
+    search->second.deadline_ns = deadline_ns;
+    if (epoll_ctl(epoll_fd_, operation, req.fd, &event) != 0) {
+      AERROR << "epoll ctl failed, " << strerror(errno);
+      entries_.erase(search);
+      return false;
     }
-    *requests_[req.fd] = req;
-    ctrl_params_[ctrl_param.fd] = ctrl_param;
+    // the poll thread only has to wake up when it would sleep past the
+    // timeout
+    need_notify = deadline_ns < wakeup_ns_.load();
   }
 
-  Notify();
+  if (need_notify) {
+    Notify();
+  }
   return true;
 }
 
@@ -91,21 +110,19 @@ bool Poller::Unregister(const PollRequest& req) {
     return false;
   }
 
-  {
-    WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    auto size = requests_.erase(req.fd);
-    if (size == 0) {
-      AERROR << "unregister failed, can't find fd: " << req.fd;
-      return false;
-    }
-
-    PollCtrlParam ctrl_param;
-    ctrl_param.operation = EPOLL_CTL_DEL;
-    ctrl_param.fd = req.fd;
-    ctrl_params_[ctrl_param.fd] = ctrl_param;
+  WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
+  auto size = entries_.erase(req.fd);
+  if (size == 0) {
+    AERROR << "unregister failed, can't find fd: " << req.fd;
+    return false;
   }
 
-  Notify();
+  // a closed fd has already left the epoll set
+  epoll_event event;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, req.fd, &event) != 0 &&
+      errno != EBADF && errno != ENOENT) {
+    AERROR << "epoll ctl failed, " << strerror(errno);
+  }
   return true;
 }
 
@@ -131,24 +148,25 @@ bool Poller::Init() {
   }
 
   // add pipe[0] to epoll
-  auto request = std::make_shared<PollRequest>();
-  request->fd = pipe_fd_[0];
-  request->events = EPOLLIN;
-  request->timeout_ms = -1;
-  request->callback = [this](const PollResponse&) {
+  PollEntry& entry = entries_[pipe_fd_[0]];
+  entry.request.fd = pipe_fd_[0];
+  entry.request.events = EPOLLIN;
+  entry.request.timeout_ms = -1;
+  entry.request.callback = [this](const PollResponse&) {
     char c = 0;
     while (read(pipe_fd_[0], &c, 1) > 0) {
     }
   };
-  requests_[request->fd] = request;
 
-  PollCtrlParam ctrl_param;
-  ctrl_param.operation = EPOLL_CTL_ADD;
-  ctrl_param.fd = pipe_fd_[0];
-  ctrl_param.event.data.fd = pipe_fd_[0];
-  ctrl_param.event.events = EPOLLIN;
-  ctrl_params_[ctrl_param.fd] = ctrl_param;
+  epoll_event event;
+  event.data.fd = pipe_fd_[0];
+  event.events = EPOLLIN;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, pipe_fd_[0], &event) != 0) {
+    AERROR << "epoll ctl failed, " << strerror(errno);
+    return false;
+  }
 
+  events_.resize(kPollSize);
   is_shutdown_.exchange(false);
   thread_ = std::thread(&Poller::ThreadFunc, this);
   scheduler::Instance()->SetInnerThreadAttr("io_poller", &thread_);
@@ -177,68 +195,44 @@ void Poller::Clear() {
 
   {
     WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    requests_.clear();
-    ctrl_params_.clear();
+    entries_.clear();
   }
 }
 
 void Poller::Poll(int timeout_ms) {
-  epoll_event evt[kPollSize];
-  auto before_time_ns = Time::Now().ToNanosecond();
-  int ready_num = epoll_wait(epoll_fd_, evt, kPollSize, timeout_ms);
-  auto after_time_ns = Time::Now().ToNanosecond();
-  int interval_ms =
-      static_cast<int>((after_time_ns - before_time_ns) / 1000000);
-  if (interval_ms == 0) {
-    interval_ms = 1;
-  }
-
-  std::unordered_map<int, PollResponse> responses;
-  {
-    ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    for (auto& item : requests_) {
-      auto& request = item.second;
-      if (ctrl_params_.count(request->fd) != 0) {
-        continue;
-      }
-
-      if (request->timeout_ms > 0) {
-        request->timeout_ms -= interval_ms;
-        if (request->timeout_ms < 0) {
-          request->timeout_ms = 0;
-        }
-      }
-
-      if (request->timeout_ms == 0) {
-        responses[item.first] = PollResponse();
-        request->timeout_ms = -1;
-      }
+  int ready_num = epoll_wait(epoll_fd_, events_.data(), kPollSize, timeout_ms);
+  if (ready_num < 0) {
+    if (errno != EINTR) {
+      AERROR << "epoll wait failed, " << strerror(errno);
     }
+    ready_num = 0;
   }
+  wakeup_ns_.store(0);
 
-  if (ready_num > 0) {
+  ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
+  // Dispatch every ready event of this wakeup, and keep draining while the
+  // event buffer comes back full. One-shot requests are disarmed once they
+  // fire, so this ends.
+  while (ready_num > 0) {
     for (int i = 0; i < ready_num; ++i) {
-      int fd = evt[i].data.fd;
-      uint32_t events = evt[i].events;
-      responses[fd] = PollResponse(events);
+      auto search = entries_.find(events_[i].data.fd);
+      if (search != entries_.end()) {
+        search->second.deadline_ns = kNoDeadline;
+        search->second.request.callback(PollResponse(events_[i].events));
+      }
     }
-  }
-
-  for (auto& item : responses) {
-    int fd = item.first;
-    auto& response = item.second;
-
-    ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    auto search = requests_.find(fd);
-    if (search != requests_.end()) {
-      search->second->timeout_ms = -1;
-      search->second->callback(response);
+    if (ready_num < kPollSize) {
+      break;
     }
+    ready_num = epoll_wait(epoll_fd_, events_.data(), kPollSize, 0);
   }
 
-  if (ready_num < 0) {
-    if (errno != EINTR) {
-      AERROR << "epoll wait failed, " << strerror(errno);
+  const uint64_t now_ns = Time::Now().ToNanosecond();
+  for (auto& item : entries_) {
+    auto& entry = item.second;
+    if (entry.deadline_ns <= now_ns) {
+      entry.deadline_ns = kNoDeadline;
+      entry.request.callback(PollResponse());
     }
   }
 }
@@ -250,45 +244,29 @@ void Poller::ThreadFunc() {
   pthread_sigmask(SIG_BLOCK, &signal_set, NULL);
 
   while (!is_shutdown_.load()) {
-    HandleChanges();
     int timeout_ms = GetTimeoutMs();
     ADEBUG << "this poll timeout ms: " << timeout_ms;
     Poll(timeout_ms);
   }
 }
 
-void Poller::HandleChanges() {
-  CtrlParamMap local_params;
+// min heap can be used to optimize
+int Poller::GetTimeoutMs() {
+  const uint64_t now_ns = Time::Now().ToNanosecond();
+  uint64_t wakeup_ns = now_ns + static_cast<uint64_t>(kPollTimeoutMs) * 1000000;
   {
     ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    if (ctrl_params_.empty()) {
-      return;
-    }
-    local_params.swap(ctrl_params_);
-  }
-
-  for (auto& pair : local_params) {
-    auto& item = pair.second;
-    ADEBUG << "epoll ctl, op[" << item.operation << "] fd[" << item.fd
-           << "] events[" << item.event.events << "]";
-    if (epoll_ctl(epoll_fd_, item.operation, item.fd, &item.event) != 0 &&
-        errno != EBADF) {
-      AERROR << "epoll ctl failed, " << strerror(errno);
+    for (auto& item : entries_) {
+      wakeup_ns = std::min(wakeup_ns, item.second.deadline_ns);
     }
+    // requests registered from here on notify when they are due earlier
+    wakeup_ns_.store(wakeup_ns);
   }
-}
-
-// min heap can be used to optimize
-int Poller::GetTimeoutMs() {
-  int timeout_ms = kPollTimeoutMs;
-  ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-  for (auto& item : requests_) {
-    auto& req = item.second;
-    if (req->timeout_ms >= 0 && req->timeout_ms < timeout_ms) {
-      timeout_ms = req->timeout_ms;
-    }
+  if (wakeup_ns <= now_ns) {
+    return 0;
   }
-  return timeout_ms;
+  // round up, so that the deadline has passed on return
+  return static_cast<int>((wakeup_ns - now_ns + 999999) / 1000000);
 }
 
 void Poller::Notify() {
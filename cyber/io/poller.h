@@ -17,9 +17,9 @@
 #ifndef CYBER_IO_POLLER_H_
 #define CYBER_IO_POLLER_H_
 
+#include <stdint.h>
+
 #include <atomic>
-#include <list>
-#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -35,10 +35,6 @@ namespace io {
 
 class Poller {
  public:
-  using RequestPtr = std::shared_ptr<PollRequest>;
-  using RequestMap = std::unordered_map<int, RequestPtr>;
-  using CtrlParamMap = std::unordered_map<int, PollCtrlParam>;
-
   virtual ~Poller();
 
   void Shutdown();
@@ -47,11 +43,20 @@ class Poller {
   bool Unregister(const PollRequest& req);
 
  private:
+  // A registered request, with its timeout as an absolute deadline so that
+  // requests registered while the poll thread sleeps keep their full timeout.
+  struct PollEntry {
+    PollRequest request;
+    uint64_t deadline_ns = kNoDeadline;
+  };
+  using EntryMap = std::unordered_map<int, PollEntry>;
+
+  static constexpr uint64_t kNoDeadline = UINT64_MAX;
+
   bool Init();
   void Clear();
   void Poll(int timeout_ms);
   void ThreadFunc();
-  void HandleChanges();
   int GetTimeoutMs();
   void Notify();
 
@@ -62,10 +67,15 @@ class Poller {
   int pipe_fd_[2] = {-1, -1};
   std::mutex pipe_mutex_;
 
-  RequestMap requests_;
-  CtrlParamMap ctrl_params_;
+  EntryMap entries_;
   base::AtomicRWLock poll_data_lock_;
 
+  // when the running epoll_wait returns at the latest
+  std::atomic<uint64_t> wakeup_ns_ = {0};
+
+  // only touched by the poll thread, reused across wakeups
+  std::vector<epoll_event> events_;
+
   const int kPollSize = 32;
   const int kPollTimeoutMs = 100;
 
@@ -17,6 +17,8 @@
 #include "cyber/logger/async_logger.h"
 
 #include <stdlib.h>
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -31,14 +33,37 @@ namespace logger {
 
 static std::unordered_map<std::string, LogFileObject*> moduleLoggerMap;
 
+namespace {
+
+std::atomic<uint64_t> g_next_logger_id = {1};
+
+int32_t LevelOf(const char* message) {
+  switch (message[0]) {
+    case 'F':
+      return 3;
+    case 'E':
+      return 2;
+    case 'W':
+      return 1;
+    case 'I':
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+}  // namespace
+
+const int AsyncLogger::kRingsPerBuffer;
+const int AsyncLogger::kPollIntervalMs;
+const int AsyncLogger::kFlushIntervalMs;
+
 AsyncLogger::AsyncLogger(google::base::Logger* wrapped, int max_buffer_bytes)
-    : max_buffer_bytes_(max_buffer_bytes),
-      wrapped_(wrapped),
-      active_buf_(new Buffer()),
-      flushing_buf_(new Buffer()) {
-  if (max_buffer_bytes_ <= 0) {
-    max_buffer_bytes_ = 2 * 1024 * 1024;
+    : id_(g_next_logger_id.fetch_add(1)), wrapped_(wrapped) {
+  if (max_buffer_bytes <= 0) {
+    max_buffer_bytes = 2 * 1024 * 1024;
   }
+  ring_bytes_ = std::max(max_buffer_bytes / kRingsPerBuffer, 4096);
 }
 
 AsyncLogger::~AsyncLogger() {
@@ -50,7 +75,7 @@ AsyncLogger::~AsyncLogger() {
 }
 
 void AsyncLogger::Start() {
-  CHECK_EQ(state_, INITTED);
+  CHECK_EQ(state_.load(), INITTED);
   state_ = RUNNING;
   thread_ = std::thread(&AsyncLogger::RunThread, this);
   // std::cout << "Async Logger Start!" << std::endl;
@@ -59,59 +84,71 @@ void AsyncLogger::Start() {
 void AsyncLogger::Stop() {
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    CHECK_EQ(state_, RUNNING);
+    CHECK_EQ(state_.load(), RUNNING);
     state_ = STOPPED;
+    wake_ = true;
     wake_flusher_cv_.notify_one();
   }
   thread_.join();
-  CHECK(active_buf_->messages.empty());
-  CHECK(flushing_buf_->messages.empty());
   // std::cout << "Async Logger Stop!" << std::endl;
 }
 
+AsyncLogger::Writer* AsyncLogger::LocalWriter() {
+  struct Holder {
+    ~Holder() {
+      if (writer != nullptr) {
+        writer->exited = true;
+      }
+    }
+
+    uint64_t logger_id = 0;
+    std::shared_ptr<Writer> writer;
+  };
+  static thread_local Holder local;
+
+  if (unlikely(local.logger_id != id_)) {
+    if (local.writer != nullptr) {
+      local.writer->exited = true;
+    }
+    local.writer = std::make_shared<Writer>(ring_bytes_);
+    local.logger_id = id_;
+    std::lock_guard<std::mutex> lock(writers_mutex_);
+    writers_.push_back(local.writer);
+  }
+  return local.writer.get();
+}
+
 void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
                         int message_len) {
-  // drop message when acitve buffer full
-  if (unlikely(BufferFull(*active_buf_))) {
+  if (unlikely(state_.load(std::memory_order_acquire) != RUNNING)) {
+    // std::cout << "Async Logger not running!" << std::endl;
     return;
   }
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (state_ != RUNNING) {
-      // std::cout << "Async Logger not running!" << std::endl;
-      return;
-    }
 
-    switch (message[0]) {
-      case 'F': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 3),
-                         force_flush);
-        break;
-      }
-      case 'E': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 2),
-                         force_flush);
-        break;
-      }
-      case 'W': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 1),
-                         force_flush);
-        break;
-      }
-      case 'I': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 0),
-                         force_flush);
-        break;
-      }
-      default: {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), -1),
-                         force_flush);
-      }
-    }
-    wake_flusher_cv_.notify_one();
+  auto level = LevelOf(message);
+  auto writer = LocalWriter();
+  writer->ring.Write(timestamp, level, message,
+                     static_cast<uint32_t>(message_len));
+  if (unlikely(level == 3)) {
+    // the process is about to abort
+    Flush();
+    return;
+  }
+  if (force_flush) {
+    flush_requested_ = true;
+  }
+  if ((force_flush || writer->ring.Used() > writer->ring.Capacity() / 2) &&
+      flusher_sleeping_.load()) {
+    Wake();
   }
 }
 
+void AsyncLogger::Wake() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  wake_ = true;
+  wake_flusher_cv_.notify_one();
+}
+
 void AsyncLogger::Flush() {
   std::unique_lock<std::mutex> lock(mutex_);
   if (state_ != RUNNING) {
@@ -120,10 +157,11 @@ void AsyncLogger::Flush() {
   }
 
   // Wake up the writer thread at least twice.
-  // This ensures both buffers were completely flushed.
+  // This ensures a drain started after this call has completed.
   uint64_t orig_flush_count = flush_count_;
   while (flush_count_ < (orig_flush_count + 2) && state_ == RUNNING) {
-    active_buf_->flush = true;
+    flush_requested_ = true;
+    wake_ = true;
     wake_flusher_cv_.notify_one();
     flush_complete_cv_.wait(lock);
   }
@@ -131,56 +169,95 @@ void AsyncLogger::Flush() {
 
 uint32_t AsyncLogger::LogSize() { return wrapped_->LogSize(); }
 
-void AsyncLogger::RunThread() {
-  std::unique_lock<std::mutex> lock(mutex_);
-  while (state_ == RUNNING || active_buf_->needs_flush_or_write()) {
-    while (!active_buf_->needs_flush_or_write() && state_ == RUNNING) {
-      if (wake_flusher_cv_.wait_for(lock, std::chrono::seconds(2)) ==
-          std::cv_status::timeout) {
-        active_buf_->flush = true;
-      }
-    }
+void AsyncLogger::WriteMessage(time_t ts, int32_t level,
+                               std::string* message) {
+  std::string module_name;
+  FindModuleName(message, &module_name);
 
-    active_buf_.swap(flushing_buf_);
-    lock.unlock();
+  LogFileObject* fileobject = nullptr;
+  if (moduleLoggerMap.find(module_name) != moduleLoggerMap.end()) {
+    fileobject = moduleLoggerMap[module_name];
+  } else {
+    fileobject = new LogFileObject(google::INFO, module_name.c_str());
+    fileobject->SetSymlinkBasename(module_name.c_str());
+    moduleLoggerMap[module_name] = fileobject;
+  }
+  if (fileobject) {
+    const bool should_flush = level > 0;
+    fileobject->Write(should_flush, ts, message->data(),
+                      static_cast<int>(message->size()));
+  }
+}
 
-    for (auto& msg : flushing_buf_->messages) {
-      std::string module_name;
-      FindModuleName(&msg.message, &module_name);
-
-      LogFileObject* fileobject = nullptr;
-      if (moduleLoggerMap.find(module_name) != moduleLoggerMap.end()) {
-        fileobject = moduleLoggerMap[module_name];
-      } else {
-        fileobject = new LogFileObject(google::INFO, module_name.c_str());
-        fileobject->SetSymlinkBasename(module_name.c_str());
-        moduleLoggerMap[module_name] = fileobject;
-      }
-      if (fileobject) {
-        const bool should_flush = msg.level > 0;
-        fileobject->Write(should_flush, msg.ts, msg.message.data(),
-                          static_cast<int>(msg.message.size()));
-      }
+uint64_t AsyncLogger::DrainWriters() {
+  std::vector<std::shared_ptr<Writer>> writers;
+  {
+    std::lock_guard<std::mutex> lock(writers_mutex_);
+    writers = writers_;
+  }
+
+  uint64_t num = 0;
+  std::string message;
+  for (auto& writer : writers) {
+    // a ring seen exited before the drain gets nothing more
+    bool exited = writer->exited.load();
+    num += writer->ring.Drain(
+        [this, &message](time_t ts, int32_t level, const char* data,
+                         uint32_t len) {
+          message.assign(data, len);
+          WriteMessage(ts, level, &message);
+        });
+
+    auto dropped = writer->ring.TakeDropped();
+    if (unlikely(dropped > 0)) {
+      message = "W AsyncLogger dropped " + std::to_string(dropped) +
+                " log messages, the log buffer of a thread was full.\n";
+      WriteMessage(time(nullptr), 1, &message);
+      ++num;
+    }
+
+    if (exited) {
+      std::lock_guard<std::mutex> lock(writers_mutex_);
+      writers_.erase(std::find(writers_.begin(), writers_.end(), writer));
     }
+  }
+  return num;
+}
+
+void AsyncLogger::RunThread() {
+  auto last_flush = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    bool stopping = state_ != RUNNING;
+    wake_ = false;
+    lock.unlock();
 
-    if (flushing_buf_->flush) {
+    auto num = DrainWriters();
+    auto now = std::chrono::steady_clock::now();
+    if (flush_requested_.exchange(false) || stopping ||
+        now - last_flush > std::chrono::milliseconds(kFlushIntervalMs)) {
       for (auto& module_logger : moduleLoggerMap) {
         module_logger.second->Flush();
       }
+      last_flush = now;
     }
-    flushing_buf_->clear();
 
     lock.lock();
     flush_count_++;
     flush_complete_cv_.notify_all();
+    if (stopping) {
+      break;
+    }
+    if (num == 0 && !wake_) {
+      flusher_sleeping_ = true;
+      wake_flusher_cv_.wait_for(lock,
+                                std::chrono::milliseconds(kPollIntervalMs),
+                                [this]() { return wake_; });
+      flusher_sleeping_ = false;
+    }
   }
 }
 
-bool AsyncLogger::BufferFull(const Buffer& buf) const {
-  // We evenly divide our total buffer space into two buffers.
-  return buf.size > (max_buffer_bytes_ / 2);
-}
-
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "cyber/common/macros.h"
+#include "cyber/logger/log_ring_buffer.h"
 #include "glog/logging.h"
 
 namespace apollo {
@@ -38,31 +39,29 @@ namespace logger {
 
 // Wrapper for a glog Logger which asynchronously writes log messages.
 // This class starts a new thread responsible for forwarding the messages
-// to the logger, and performs double buffering. Writers append to the
-// current buffer and then wake up the logger thread. The logger swaps in
-// a new buffer and writes any accumulated messages to the wrapped
-// Logger.
+// to the logger. Every thread that logs gets a ring buffer of its own
+// (see LogRingBuffer), so a Write is a copy of the formatted line into the
+// ring of the calling thread: no lock, no allocation and no wake up of the
+// logger thread for every message. The logger thread drains all rings,
+// looks up the module file of every message and writes it there.
 //
-// This double-buffering design dramatically improves performance, especially
-// for logging messages which require flushing the underlying file (i.e WARNING
-// and above for default). The flush can take a couple of milliseconds, and in
-// some cases can even block for hundreds of milliseconds or more. With the
-// double-buffered approach, threads can proceed with useful work while the IO
-// thread blocks.
+// The logger thread polls the rings every kPollIntervalMs. Writers only wake
+// it early for messages glog wants flushed (WARNING and above by default)
+// or when their ring is half full. Messages of one thread keep their order,
+// messages of different threads are written ring by ring.
 //
 // The semantics provided by this wrapper are slightly weaker than the default
 // glog semantics. By default, glog will immediately (synchronously) flush
-// WARNING
-// and above to the underlying file, whereas here we are deferring that flush to
-// a separate thread. This means that a crash just after a 'LOG_WARN' would
-// may be missing the message in the logs, but the perf benefit is probably
-// worth it. We do take care that a glog FATAL message flushes all buffered log
-// messages before exiting.
+// WARNING and above to the underlying file, whereas here we are deferring
+// that flush to a separate thread. This means that a crash just after a
+// 'LOG_WARN' may be missing the message in the logs, but the perf benefit
+// is probably worth it. A FATAL message is flushed, together with all
+// buffered messages, before Write returns.
 //
-// NOTE: the logger limits the total amount of buffer space, so if the
-// underlying
-// log blocks for too long, eventually the threads generating the log messages
-// will block as well. This prevents runaway memory usage.
+// NOTE: each ring holds max_buffer_bytes / kRingsPerBuffer bytes. When the
+// logger thread falls that far behind, new messages of the thread are
+// dropped rather than blocking it, and the logger writes a warning with
+// the number of messages lost once it catches up.
 class AsyncLogger : public google::base::Logger {
  public:
   explicit AsyncLogger(google::base::Logger* wrapped, int max_buffer_bytes);
@@ -82,13 +81,11 @@ class AsyncLogger : public google::base::Logger {
   // Write a message to the log.
   //
   // 'force_flush' is set by the GLog library based on the configured
-  // '--logbuflevel' flag.
-  // Any messages logged at the configured level or higher result in
-  // 'force_flush'
-  // being set to true, indicating that the message should be immediately
-  // written to the
-  // log rather than buffered in memory. See the class-level docs above for more
-  // details about the implementation provided here.
+  // '--logbuflevel' flag. Any messages logged at the configured level or
+  // higher result in 'force_flush' being set to true, indicating that the
+  // message should be written to the log soon rather than buffered in
+  // memory. See the class-level docs above for more details about the
+  // implementation provided here.
   //
   // REQUIRES: Start() must have been called.
   void Write(bool force_flush, time_t timestamp, const char* message,
@@ -105,97 +102,61 @@ class AsyncLogger : public google::base::Logger {
   const std::thread* LogThread() const { return &thread_; }
 
  private:
-  // A buffered message.
-  //
-  // TODO(todd): using std::string for buffered messages is convenient but not
-  // as efficient as it could be. It's better to make the buffers just be
-  // Arenas and allocate both the message data and Msg struct from them, forming
-  // a linked list.
-  struct Msg {
-    time_t ts;
-    std::string message;
-    int32_t level;
-
-    Msg(time_t ts, std::string&& message, int32_t level)
-        : ts(ts), message(std::move(message)), level(level) {}
-  };
-
-  // A buffer of messages waiting to be flushed.
-  struct Buffer {
-    std::vector<Msg> messages;
-
-    // Estimate of the size of 'messages'.
-    std::atomic<int> size = {0};
-
-    // Whether this buffer needs an explicit flush of the
-    // underlying logger.
-    bool flush = false;
-
-    Buffer() {}
+  static const int kRingsPerBuffer = 16;
+  static const int kPollIntervalMs = 100;
+  static const int kFlushIntervalMs = 2000;
 
-    inline void clear() {
-      messages.clear();
-      size = 0;
-      flush = false;
-    }
+  // The ring of one writing thread, freed by the logger thread after the
+  // writing thread exited and the ring was drained.
+  struct Writer {
+    explicit Writer(uint32_t capacity) : ring(capacity) {}
 
-    inline void add(Msg&& msg, bool force_flush) {
-      size +=
-          static_cast<int>(sizeof(msg)) + static_cast<int>(msg.message.size());
-      messages.emplace_back(std::move(msg));
-      flush |= force_flush;
-    }
-
-    inline bool needs_flush_or_write() const {
-      return flush || !messages.empty();
-    }
-
-   private:
-    DISALLOW_COPY_AND_ASSIGN(Buffer);
+    LogRingBuffer ring;
+    std::atomic<bool> exited = {false};
   };
 
-  bool BufferFull(const Buffer& buf) const;
+  Writer* LocalWriter();
+  void Wake();
+  // returns the number of messages written
+  uint64_t DrainWriters();
+  void WriteMessage(time_t ts, int32_t level, std::string* message);
   void RunThread();
 
-  // The maximum number of bytes used by the entire class.
-  int max_buffer_bytes_;
+  // Tells the rings of this logger from those of an earlier one at the
+  // same address.
+  const uint64_t id_;
+
+  // The size of the ring of every writing thread.
+  int ring_bytes_ = 0;
 
   google::base::Logger* const wrapped_;
   std::thread thread_;
 
-  // Count of how many times the writer thread has flushed the buffers.
+  // Count of how many times the writer thread has drained the rings.
   // 64 bits should be enough to never worry about overflow.
   uint64_t flush_count_ = 0;
 
-  // Count of how many times the writer thread has dropped the log messages.
-  // 64 bits should be enough to never worry about overflow.
-  uint64_t drop_count_ = 0;
+  // Protects 'writers_'.
+  std::mutex writers_mutex_;
+  std::vector<std::shared_ptr<Writer>> writers_;
 
-  // Protects buffers as well as 'state_'.
+  // Protects 'state_' transitions, 'wake_' and 'flush_count_'.
   std::mutex mutex_;
 
-  // Signaled by app threads to wake up the flusher, either for new
-  // data or because 'state_' changed.
+  // Signaled to wake up the flusher, either for new data or because
+  // 'state_' changed.
   std::condition_variable wake_flusher_cv_;
 
-  // Signaled by the flusher thread when the flusher has swapped in
-  // a free buffer to write to.
-  // std::condition_variable free_buffer_cv_;
-
-  // Signaled by the flusher thread when it has completed flushing
-  // the current buffer.
+  // Signaled by the flusher thread when it has completed a drain.
   std::condition_variable flush_complete_cv_;
 
-  // The buffer to which application threads append new log messages.
-  std::unique_ptr<Buffer> active_buf_;
-
-  // The buffer currently being flushed by the logger thread, cleared
-  // after a successful flush.
-  std::unique_ptr<Buffer> flushing_buf_;
+  bool wake_ = false;
+  std::atomic<bool> flusher_sleeping_ = {false};
+  std::atomic<bool> flush_requested_ = {false};
 
   // Trigger for the logger thread to stop.
   enum State { INITTED, RUNNING, STOPPED };
-  State state_ = INITTED;
+  std::atomic<State> state_ = {INITTED};
 
   DISALLOW_COPY_AND_ASSIGN(AsyncLogger);
 };
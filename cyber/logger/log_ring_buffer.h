@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_LOGGER_LOG_RING_BUFFER_H_
+#define CYBER_LOGGER_LOG_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+// Single producer, single consumer ring of raw log records. The producer
+// copies a record in place and publishes it with one release store, no lock
+// and no allocation. A record that does not fit is dropped and counted, the
+// producer never waits for the consumer.
+class LogRingBuffer {
+ public:
+  // |capacity| is rounded up to a power of two
+  explicit LogRingBuffer(uint32_t capacity)
+      : capacity_(RoundUp(capacity)),
+        mask_(capacity_ - 1),
+        buffer_(new char[capacity_]) {}
+
+  LogRingBuffer(const LogRingBuffer&) = delete;
+  LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+  // producer side
+  bool Write(time_t ts, int32_t level, const char* data, uint32_t len) {
+    auto size = RecordSize(len);
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_acquire);
+    auto offset = head & mask_;
+    auto contiguous = capacity_ - offset;
+    auto needed = contiguous < size ? size + contiguous : size;
+    if (unlikely(size > capacity_ || head + needed - tail > capacity_)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (contiguous < size) {
+      // records never wrap, the rest of the lap is skipped
+      Header* padding = reinterpret_cast<Header*>(&buffer_[offset]);
+      padding->len = kPadding;
+      head += contiguous;
+      offset = 0;
+    }
+    Header* header = reinterpret_cast<Header*>(&buffer_[offset]);
+    header->len = len;
+    header->level = level;
+    header->ts = static_cast<int64_t>(ts);
+    std::memcpy(header + 1, data, len);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side, calls func(ts, level, data, len) for every record and
+  // returns how many there were
+  template <typename F>
+  uint64_t Drain(F&& func) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    auto head = head_.load(std::memory_order_acquire);
+    uint64_t num = 0;
+    while (tail < head) {
+      auto offset = tail & mask_;
+      const Header* header = reinterpret_cast<const Header*>(&buffer_[offset]);
+      if (header->len == kPadding) {
+        tail += capacity_ - offset;
+        continue;
+      }
+      func(static_cast<time_t>(header->ts), header->level,
+           reinterpret_cast<const char*>(header + 1), header->len);
+      tail += RecordSize(header->len);
+      tail_.store(tail, std::memory_order_release);
+      ++num;
+    }
+    tail_.store(tail, std::memory_order_release);
+    return num;
+  }
+
+  // bytes written and not drained yet
+  uint64_t Used() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+  uint64_t Capacity() const { return capacity_; }
+
+  // records dropped since the last call
+  uint64_t TakeDropped() {
+    return dropped_.exchange(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct Header {
+    uint32_t len;
+    int32_t level;
+    int64_t ts;
+  };
+
+  static const uint32_t kPadding = UINT32_MAX;
+
+  static uint64_t RoundUp(uint32_t capacity) {
+    uint64_t size = sizeof(Header);
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  // a multiple of the header size so that a header always fits at the end
+  static uint64_t RecordSize(uint32_t len) {
+    return (sizeof(Header) + len + sizeof(Header) - 1) / sizeof(Header) *
+           sizeof(Header);
+  }
+
+  const uint64_t capacity_;
+  const uint64_t mask_;
+  std::unique_ptr<char[]> buffer_;
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> head_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
+  std::atomic<uint64_t> dropped_ = {0};
+};
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_LOGGER_LOG_RING_BUFFER_H_
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/logger/log_ring_buffer.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+TEST(LogRingBufferTest, write_and_drain) {
+  LogRingBuffer ring(1000);
+  EXPECT_EQ(1024, ring.Capacity());
+  std::string message = "I cyber logger test";
+  EXPECT_TRUE(ring.Write(10, 0, message.data(), message.size()));
+  EXPECT_TRUE(ring.Write(11, 1, message.data(), 1));
+  EXPECT_GT(ring.Used(), 0);
+
+  std::vector<std::string> messages;
+  EXPECT_EQ(2, ring.Drain([&](time_t ts, int32_t level, const char* data,
+                              uint32_t len) {
+    EXPECT_EQ(10 + level, ts);
+    messages.emplace_back(data, len);
+  }));
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ(message, messages[0]);
+  EXPECT_EQ("I", messages[1]);
+  EXPECT_EQ(0, ring.Used());
+  EXPECT_EQ(0, ring.TakeDropped());
+}
+
+TEST(LogRingBufferTest, overflow_and_wrap) {
+  LogRingBuffer ring(256);
+  std::string message(100, 'x');
+  int written = 0;
+  while (ring.Write(0, 0, message.data(), message.size())) {
+    ++written;
+  }
+  EXPECT_EQ(2, written);
+  EXPECT_FALSE(ring.Write(0, 0, message.data(), message.size()));
+  EXPECT_EQ(2, ring.TakeDropped());
+  EXPECT_EQ(0, ring.TakeDropped());
+
+  // every later lap wraps somewhere else
+  for (int i = 0; i < 100; ++i) {
+    auto num = ring.Drain(
+        [&](time_t, int32_t, const char* data, uint32_t len) {
+          EXPECT_GT(len, 84);
+          EXPECT_EQ(message.substr(0, len), std::string(data, len));
+        });
+    EXPECT_GE(num, 1);
+    EXPECT_TRUE(ring.Write(0, 0, message.data(), message.size() - i % 16));
+  }
+
+  std::string huge(300, 'x');
+  EXPECT_FALSE(ring.Write(0, 0, huge.data(), huge.size()));
+}
+
+TEST(LogRingBufferTest, concurrency) {
+  LogRingBuffer ring(4096);
+  const int num = 100000;
+  std::thread producer([&ring, num]() {
+    for (int i = 0; i < num; ++i) {
+      auto message = std::to_string(i);
+      while (!ring.Write(i, 0, message.data(), message.size())) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int next = 0;
+  while (next < num) {
+    ring.Drain([&next](time_t ts, int32_t, const char* data, uint32_t len) {
+      EXPECT_EQ(next, ts);
+      EXPECT_EQ(std::to_string(next), std::string(data, len));
+      ++next;
+    });
+  }
+  producer.join();
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
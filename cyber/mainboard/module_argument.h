@@ -44,12 +44,14 @@ class ModuleArgument {
   inline std::list<std::string> GetDAGConfList() const {
     return dag_conf_list_;
   }
+  inline uint32_t GetInitThreadNum() const { return init_thread_num_; }
 
  private:
   std::list<std::string> dag_conf_list_;
   std::string binary_name_;
   std::string process_group_;
   std::string sched_name_;
+  uint32_t init_thread_num_ = 1;
 };
 
 }  // namespace mainboard
@@ -16,11 +16,15 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <algorithm>
+#include <future>
 #include <utility>
 
+#include "cyber/base/work_stealing_pool.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/component/component_base.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -37,6 +41,7 @@ void ModuleController::Clear() {
     component->Shutdown();
   }
   component_list_.clear();  // keep alive
+  pending_groups_.clear();
   class_loader_manager_.UnloadAllLibrary();
 }
 
@@ -66,7 +71,7 @@ bool ModuleController::LoadAll() {
       return false;
     }
   }
-  return true;
+  return InitPendingGroups();
 }
 
 bool ModuleController::LoadModule(const DagConfig& dag_config) {
@@ -88,6 +93,7 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
 
     class_loader_manager_.LoadLibrary(load_path);
 
+    ComponentGroup group;
     for (auto& component : module_config.components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
@@ -95,11 +101,12 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
       if (base == nullptr) {
         return false;
       }
-
-      if (!base->Initialize(component.config())) {
-        return false;
-      }
-      component_list_.emplace_back(std::move(base));
+      PendingComponent pending;
+      pending.name = component.config().name();
+      pending.component = base;
+      auto config = component.config();
+      pending.init = [base, config]() { return base->Initialize(config); };
+      group.emplace_back(std::move(pending));
     }
 
     for (auto& component : module_config.timer_components()) {
@@ -109,16 +116,103 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
       if (base == nullptr) {
         return false;
       }
+      PendingComponent pending;
+      pending.name = component.config().name();
+      pending.component = base;
+      auto config = component.config();
+      pending.init = [base, config]() { return base->Initialize(config); };
+      group.emplace_back(std::move(pending));
+    }
 
-      if (!base->Initialize(component.config())) {
-        return false;
-      }
-      component_list_.emplace_back(std::move(base));
+    if (args_.GetInitThreadNum() > 1) {
+      pending_groups_.emplace_back(std::move(group));
+      continue;
+    }
+    bool is_initialized = InitComponentGroup(&group);
+    AddInitialized(group);
+    ReportInitTime({group});
+    if (!is_initialized) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ModuleController::InitComponentGroup(ComponentGroup* group) {
+  for (auto& pending : *group) {
+    uint64_t start_ns = Time::MonoTime().ToNanosecond();
+    pending.is_initialized = pending.init();
+    pending.init_time_ns = Time::MonoTime().ToNanosecond() - start_ns;
+    if (!pending.is_initialized) {
+      AERROR << "Failed to initialize component: " << pending.name;
+      return false;
     }
   }
   return true;
 }
 
+bool ModuleController::InitPendingGroups() {
+  std::vector<ComponentGroup> groups;
+  groups.swap(pending_groups_);
+  if (groups.empty()) {
+    return true;
+  }
+  uint64_t start_ns = Time::MonoTime().ToNanosecond();
+  std::vector<std::future<bool>> results;
+  {
+    // joins every worker when it goes out of scope
+    base::WorkStealingPool pool(
+        std::min<size_t>(args_.GetInitThreadNum(), groups.size()));
+    for (auto& group : groups) {
+      ComponentGroup* group_ptr = &group;
+      results.emplace_back(pool.Enqueue(
+          [this, group_ptr]() { return InitComponentGroup(group_ptr); }));
+    }
+  }
+  bool is_initialized = true;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    if (!results[i].valid() || !results[i].get()) {
+      is_initialized = false;
+    }
+    AddInitialized(groups[i]);
+  }
+  ReportInitTime(groups);
+  AINFO << "Initialized " << groups.size() << " module libraries with "
+        << args_.GetInitThreadNum() << " threads in "
+        << (Time::MonoTime().ToNanosecond() - start_ns) / 1000000 << " ms";
+  return is_initialized;
+}
+
+void ModuleController::AddInitialized(const ComponentGroup& group) {
+  for (const auto& pending : group) {
+    if (pending.is_initialized) {
+      component_list_.emplace_back(pending.component);
+    }
+  }
+}
+
+void ModuleController::ReportInitTime(
+    const std::vector<ComponentGroup>& groups) {
+  std::vector<const PendingComponent*> components;
+  for (const auto& group : groups) {
+    for (const auto& pending : group) {
+      if (pending.init_time_ns > 0) {
+        components.push_back(&pending);
+      }
+    }
+  }
+  // slowest first
+  std::sort(components.begin(), components.end(),
+            [](const PendingComponent* lhs, const PendingComponent* rhs) {
+              return lhs->init_time_ns > rhs->init_time_ns;
+            });
+  for (const auto* pending : components) {
+    AINFO << "Component " << pending->name
+          << (pending->is_initialized ? " initialized in " : " failed in ")
+          << pending->init_time_ns / 1000000 << " ms";
+  }
+}
+
 bool ModuleController::LoadModule(const std::string& path) {
   DagConfig dag_config;
   if (!common::GetProtoFromFile(path, &dag_config)) {
@@ -16,6 +16,7 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,10 +42,27 @@ class ModuleController {
   void Clear();
 
  private:
+  struct PendingComponent {
+    std::string name;
+    std::shared_ptr<ComponentBase> component;
+    std::function<bool()> init;
+    bool is_initialized = false;
+    uint64_t init_time_ns = 0;
+  };
+  // components of one module library, initialized in dag order since they
+  // may share the state of the library
+  using ComponentGroup = std::vector<PendingComponent>;
+
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  bool InitComponentGroup(ComponentGroup* group);
+  // initializes the deferred groups at once, with init_threads above 1
+  bool InitPendingGroups();
+  void AddInitialized(const ComponentGroup& group);
+  void ReportInitTime(const std::vector<ComponentGroup>& groups);
 
   ModuleArgument args_;
+  std::vector<ComponentGroup> pending_groups_;
   class_loader::ClassLoaderManager class_loader_manager_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
 };
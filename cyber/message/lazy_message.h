@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_LAZY_MESSAGE_H_
+#define CYBER_MESSAGE_LAZY_MESSAGE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cstring>
+#include <string>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "cyber/message/message_traits.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+// Keeps the serialized bytes of a T and parses them only on first access.
+// A reader of LazyMessage<T> receives messages written as T, so callbacks
+// that drop most messages (e.g. by timestamp) don't pay for parsing them.
+template <typename T>
+class LazyMessage {
+ public:
+  using MessagePtr = std::shared_ptr<T>;
+
+  LazyMessage() : has_data_(true), parsed_(false) {}
+  // wraps a message that was never serialized, e.g. one sent intra process
+  explicit LazyMessage(const MessagePtr& message)
+      : has_data_(false), message_(message), parsed_(true) {}
+
+  // parses the bytes on the first call, nullptr if they can't be parsed
+  MessagePtr Get() const;
+  bool IsParsed() const { return parsed_.load(std::memory_order_acquire); }
+
+  // Parses only the sub message |field_name| of T into |field|, without
+  // parsing the rest of the message.
+  template <typename FieldT>
+  bool ParseField(const std::string& field_name, FieldT* field) const;
+  template <typename HeaderT>
+  bool ParseHeader(HeaderT* header) const {
+    return ParseField("header", header);
+  }
+
+  const std::string& data() const { return data_; }
+
+  static std::string TypeName() { return MessageType<T>(); }
+  static void GetDescriptorString(const std::string& type,
+                                  std::string* desc_str) {
+    message::GetDescriptorString<T>(type, desc_str);
+  }
+
+  bool SerializeToArray(void* data, int size) const;
+  bool SerializeToString(std::string* str) const;
+  bool ParseFromArray(const void* data, int size);
+  bool ParseFromString(const std::string& str);
+  int ByteSize() const;
+
+ private:
+  std::string data_;
+  bool has_data_;
+  mutable MessagePtr message_;
+  mutable std::atomic<bool> parsed_;
+  mutable std::mutex mutex_;
+};
+
+template <typename T>
+typename LazyMessage<T>::MessagePtr LazyMessage<T>::Get() const {
+  if (IsParsed()) {
+    return message_;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!parsed_.load(std::memory_order_relaxed)) {
+    auto message = std::make_shared<T>();
+    if (message::ParseFromArray(data_.data(), static_cast<int>(data_.size()),
+                                message.get())) {
+      message_ = message;
+    }
+    parsed_.store(true, std::memory_order_release);
+  }
+  return message_;
+}
+
+template <typename T>
+template <typename FieldT>
+bool LazyMessage<T>::ParseField(const std::string& field_name,
+                                FieldT* field) const {
+  using google::protobuf::internal::WireFormatLite;
+  if (field == nullptr) {
+    return false;
+  }
+  auto field_desc = T::descriptor()->FindFieldByName(field_name);
+  if (field_desc == nullptr ||
+      field_desc->type() != google::protobuf::FieldDescriptor::TYPE_MESSAGE ||
+      field_desc->is_repeated()) {
+    return false;
+  }
+
+  if (!has_data_) {
+    if (message_ == nullptr) {
+      return false;
+    }
+    auto reflection = message_->GetReflection();
+    if (!reflection->HasField(*message_, field_desc)) {
+      return false;
+    }
+    field->CopyFrom(reflection->GetMessage(*message_, field_desc));
+    return true;
+  }
+
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t*>(data_.data()),
+      static_cast<int>(data_.size()));
+  bool found = false;
+  uint32_t tag = 0;
+  while ((tag = input.ReadTag()) != 0) {
+    if (WireFormatLite::GetTagFieldNumber(tag) ==
+            static_cast<int>(field_desc->number()) &&
+        WireFormatLite::GetTagWireType(tag) ==
+            WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      // occurrences of a singular message field are merged
+      if (!WireFormatLite::ReadMessage(&input, field)) {
+        return false;
+      }
+      found = true;
+    } else if (!WireFormatLite::SkipField(&input, tag)) {
+      return false;
+    }
+  }
+  return found;
+}
+
+template <typename T>
+bool LazyMessage<T>::SerializeToArray(void* data, int size) const {
+  if (!has_data_) {
+    return message_ != nullptr &&
+           message::SerializeToArray(*message_, data, size);
+  }
+  if (data == nullptr || size < ByteSize()) {
+    return false;
+  }
+  memcpy(data, data_.data(), data_.size());
+  return true;
+}
+
+template <typename T>
+bool LazyMessage<T>::SerializeToString(std::string* str) const {
+  if (!has_data_) {
+    return message_ != nullptr && message::SerializeToString(*message_, str);
+  }
+  if (str == nullptr) {
+    return false;
+  }
+  *str = data_;
+  return true;
+}
+
+template <typename T>
+bool LazyMessage<T>::ParseFromArray(const void* data, int size) {
+  if (data == nullptr || size < 0) {
+    return false;
+  }
+  data_.assign(reinterpret_cast<const char*>(data), size);
+  has_data_ = true;
+  message_ = nullptr;
+  parsed_.store(false, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool LazyMessage<T>::ParseFromString(const std::string& str) {
+  return ParseFromArray(str.data(), static_cast<int>(str.size()));
+}
+
+template <typename T>
+int LazyMessage<T>::ByteSize() const {
+  if (!has_data_) {
+    return message_ == nullptr ? 0 : message::ByteSize(*message_);
+  }
+  return static_cast<int>(data_.size());
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_LAZY_MESSAGE_H_
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/lazy_message.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+using apollo::cyber::proto::Chatter;
+using apollo::cyber::proto::ChatterWithHeader;
+using apollo::cyber::proto::UnitTest;
+
+TEST(LazyMessageTest, parse_on_access) {
+  ChatterWithHeader origin;
+  origin.mutable_header()->set_class_name("LazyMessageTest");
+  origin.mutable_header()->set_case_name("parse_on_access");
+  origin.mutable_chatter()->set_seq(7);
+  origin.mutable_chatter()->set_content(std::string(1024, 'c'));
+  std::string data;
+  ASSERT_TRUE(origin.SerializeToString(&data));
+
+  EXPECT_TRUE(HasSerializer<LazyMessage<ChatterWithHeader>>::value);
+  EXPECT_EQ(MessageType<ChatterWithHeader>(),
+            MessageType<LazyMessage<ChatterWithHeader>>());
+
+  LazyMessage<ChatterWithHeader> lazy;
+  EXPECT_TRUE(message::ParseFromString(data, &lazy));
+  EXPECT_FALSE(lazy.IsParsed());
+  EXPECT_EQ(data.size(), message::ByteSize(lazy));
+
+  UnitTest header;
+  EXPECT_TRUE(lazy.ParseHeader(&header));
+  EXPECT_FALSE(lazy.IsParsed());
+  EXPECT_EQ("parse_on_access", header.case_name());
+  Chatter chatter;
+  EXPECT_TRUE(lazy.ParseField("chatter", &chatter));
+  EXPECT_EQ(7, chatter.seq());
+  EXPECT_FALSE(lazy.ParseField("unknown", &chatter));
+
+  std::string serialized;
+  EXPECT_TRUE(message::SerializeToString(lazy, &serialized));
+  EXPECT_EQ(data, serialized);
+  EXPECT_FALSE(lazy.IsParsed());
+
+  auto msg = lazy.Get();
+  ASSERT_NE(nullptr, msg);
+  EXPECT_TRUE(lazy.IsParsed());
+  EXPECT_EQ(msg, lazy.Get());
+  EXPECT_EQ(1024, msg->chatter().content().size());
+}
+
+TEST(LazyMessageTest, wrap_message) {
+  auto origin = std::make_shared<ChatterWithHeader>();
+  origin->mutable_header()->set_case_name("wrap_message");
+  LazyMessage<ChatterWithHeader> lazy(origin);
+  EXPECT_TRUE(lazy.IsParsed());
+  EXPECT_EQ(origin, lazy.Get());
+
+  UnitTest header;
+  EXPECT_TRUE(lazy.ParseHeader(&header));
+  EXPECT_EQ("wrap_message", header.case_name());
+  Chatter chatter;
+  EXPECT_FALSE(lazy.ParseField("chatter", &chatter));
+
+  std::string serialized;
+  EXPECT_TRUE(message::SerializeToString(lazy, &serialized));
+  ChatterWithHeader parsed;
+  EXPECT_TRUE(parsed.ParseFromString(serialized));
+  EXPECT_EQ("wrap_message", parsed.header().case_name());
+}
+
+TEST(LazyMessageTest, bad_data) {
+  LazyMessage<ChatterWithHeader> lazy;
+  std::string data("\xff\xff\xff", 3);
+  EXPECT_TRUE(message::ParseFromString(data, &lazy));
+  UnitTest header;
+  EXPECT_FALSE(lazy.ParseHeader(&header));
+  EXPECT_EQ(nullptr, lazy.Get());
+  EXPECT_TRUE(lazy.IsParsed());
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -17,7 +17,9 @@
 #ifndef CYBER_MESSAGE_MESSAGE_TRAITS_H_
 #define CYBER_MESSAGE_MESSAGE_TRAITS_H_
 
+#include <cstring>
 #include <string>
+#include <type_traits>
 
 #include "cyber/base/macros.h"
 #include "cyber/common/log.h"
@@ -52,6 +54,23 @@ class HasSerializer {
 template <typename T>
 constexpr bool HasSerializer<T>::value;
 
+// Fixed-layout messages are trivially copyable classes without any
+// serialization method. Their in-memory representation is used as the wire
+// format, so the shm transport can loan blocks to writers and hand blocks to
+// readers without serializing or parsing.
+template <typename T>
+class IsFixedLayout {
+ public:
+  static constexpr bool value =
+      std::is_class<T>::value && std::is_trivially_copyable<T>::value &&
+      !HasByteSize<T>::value && !HasSerializeToString<T>::value &&
+      !HasParseFromString<T>::value && !HasSerializeToArray<T>::value &&
+      !HasParseFromArray<T>::value;
+};
+
+template <typename T>
+constexpr bool IsFixedLayout<T>::value;
+
 template <typename T,
           typename std::enable_if<HasType<T>::value &&
                                       std::is_member_function_pointer<
@@ -125,9 +144,17 @@ typename std::enable_if<HasByteSize<T>::value, int>::type ByteSize(
 }
 
 template <typename T>
-typename std::enable_if<!HasByteSize<T>::value, int>::type ByteSize(
+typename std::enable_if<IsFixedLayout<T>::value, int>::type ByteSize(
     const T& message) {
   (void)message;
+  return static_cast<int>(sizeof(T));
+}
+
+template <typename T>
+typename std::enable_if<!HasByteSize<T>::value && !IsFixedLayout<T>::value,
+                        int>::type
+ByteSize(const T& message) {
+  (void)message;
   return -1;
 }
 
@@ -147,7 +174,16 @@ typename std::enable_if<HasParseFromArray<T>::value, bool>::type ParseFromArray(
 }
 
 template <typename T>
-typename std::enable_if<!HasParseFromArray<T>::value, bool>::type
+typename std::enable_if<IsFixedLayout<T>::value, bool>::type ParseFromArray(
+    const void* data, int size, T* message) {
+  RETURN_VAL_IF(data == nullptr || size != static_cast<int>(sizeof(T)), false);
+  std::memcpy(static_cast<void*>(message), data, sizeof(T));
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<
+    !HasParseFromArray<T>::value && !IsFixedLayout<T>::value, bool>::type
 ParseFromArray(const void* data, int size, T* message) {
   return false;
 }
@@ -159,7 +195,14 @@ ParseFromString(const std::string& str, T* message) {
 }
 
 template <typename T>
-typename std::enable_if<!HasParseFromString<T>::value, bool>::type
+typename std::enable_if<IsFixedLayout<T>::value, bool>::type ParseFromString(
+    const std::string& str, T* message) {
+  return ParseFromArray(str.data(), static_cast<int>(str.size()), message);
+}
+
+template <typename T>
+typename std::enable_if<
+    !HasParseFromString<T>::value && !IsFixedLayout<T>::value, bool>::type
 ParseFromString(const std::string& str, T* message) {
   return false;
 }
@@ -190,7 +233,16 @@ SerializeToArray(const T& message, void* data, int size) {
 }
 
 template <typename T>
-typename std::enable_if<!HasSerializeToArray<T>::value, bool>::type
+typename std::enable_if<IsFixedLayout<T>::value, bool>::type SerializeToArray(
+    const T& message, void* data, int size) {
+  RETURN_VAL_IF(data == nullptr || size < static_cast<int>(sizeof(T)), false);
+  std::memcpy(data, static_cast<const void*>(&message), sizeof(T));
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<
+    !HasSerializeToArray<T>::value && !IsFixedLayout<T>::value, bool>::type
 SerializeToArray(const T& message, void* data, int size) {
   return false;
 }
@@ -202,7 +254,16 @@ SerializeToString(const T& message, std::string* str) {
 }
 
 template <typename T>
-typename std::enable_if<!HasSerializeToString<T>::value, bool>::type
+typename std::enable_if<IsFixedLayout<T>::value, bool>::type SerializeToString(
+    const T& message, std::string* str) {
+  RETURN_VAL_IF_NULL(str, false);
+  str->assign(reinterpret_cast<const char*>(&message), sizeof(T));
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<
+    !HasSerializeToString<T>::value && !IsFixedLayout<T>::value, bool>::type
 SerializeToString(const T& message, std::string* str) {
   return false;
 }
@@ -77,6 +77,11 @@ class PbMessage {
   static std::string TypeName() { return "protobuf"; }
 };
 
+struct FixedLayout {
+  uint64_t timestamp;
+  double values[4];
+};
+
 TEST(MessageTraitsTest, type_trait) {
   EXPECT_FALSE(HasType<Data>::value);
   EXPECT_FALSE(HasSerializer<Data>::value);
@@ -305,6 +310,35 @@ TEST(MessageTraitsTest, descriptor) {
   EXPECT_EQ("message", desc);
 }
 
+TEST(MessageTraitsTest, fixed_layout) {
+  EXPECT_TRUE(IsFixedLayout<FixedLayout>::value);
+  EXPECT_FALSE(IsFixedLayout<Data>::value);
+  EXPECT_FALSE(IsFixedLayout<Message>::value);
+  EXPECT_FALSE(IsFixedLayout<proto::UnitTest>::value);
+  EXPECT_FALSE(IsFixedLayout<RawMessage>::value);
+  EXPECT_FALSE(IsFixedLayout<int>::value);
+
+  FixedLayout msg{123, {1.0, 2.0, 3.0, 4.0}};
+  EXPECT_EQ(ByteSize(msg), sizeof(FixedLayout));
+
+  char array[sizeof(FixedLayout)] = {0};
+  EXPECT_FALSE(SerializeToArray(msg, array, sizeof(array) - 1));
+  EXPECT_TRUE(SerializeToArray(msg, array, sizeof(array)));
+
+  FixedLayout parsed{0, {0.0, 0.0, 0.0, 0.0}};
+  EXPECT_FALSE(ParseFromArray(array, sizeof(array) - 1, &parsed));
+  EXPECT_TRUE(ParseFromArray(array, sizeof(array), &parsed));
+  EXPECT_EQ(parsed.timestamp, 123);
+  EXPECT_EQ(parsed.values[3], 4.0);
+
+  std::string str;
+  EXPECT_TRUE(SerializeToString(msg, &str));
+  EXPECT_EQ(str.size(), sizeof(FixedLayout));
+  parsed.timestamp = 0;
+  EXPECT_TRUE(ParseFromString(str, &parsed));
+  EXPECT_EQ(parsed.timestamp, 123);
+}
+
 }  // namespace message
 }  // namespace cyber
 }  // namespace apollo
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_NODE_LOANED_MESSAGE_H_
+#define CYBER_NODE_LOANED_MESSAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/transmitter/transmitter.h"
+
+namespace apollo {
+namespace cyber {
+
+template <typename MessageT>
+class Writer;
+
+/**
+ * @brief A fixed-layout message built in place. When the channel has shm
+ * readers the message lives in a loaned shared memory block and is published
+ * without being serialized; otherwise it falls back to a heap message that is
+ * written like any other. An unpublished loan is returned on destruction.
+ */
+template <typename MessageT>
+class LoanedMessage {
+ public:
+  using TransmitterPtr = std::shared_ptr<transport::Transmitter<MessageT>>;
+
+  LoanedMessage() = default;
+  explicit LoanedMessage(const TransmitterPtr& transmitter);
+  ~LoanedMessage() { Release(); }
+
+  LoanedMessage(LoanedMessage&& other) noexcept { *this = std::move(other); }
+  LoanedMessage& operator=(LoanedMessage&& other) noexcept;
+
+  LoanedMessage(const LoanedMessage&) = delete;
+  LoanedMessage& operator=(const LoanedMessage&) = delete;
+
+  bool IsLoaned() const { return msg_ != nullptr && heap_msg_ == nullptr; }
+
+  MessageT* get() const { return msg_; }
+  MessageT* operator->() const { return msg_; }
+  MessageT& operator*() const { return *msg_; }
+  explicit operator bool() const { return msg_ != nullptr; }
+
+ private:
+  friend class Writer<MessageT>;
+
+  bool PublishLoanedBlock();
+  std::shared_ptr<MessageT> TakeHeapMessage();
+  void Release();
+
+  TransmitterPtr transmitter_ = nullptr;
+  transport::WritableBlock block_;
+  std::shared_ptr<MessageT> heap_msg_ = nullptr;
+  MessageT* msg_ = nullptr;
+};
+
+template <typename MessageT>
+LoanedMessage<MessageT>::LoanedMessage(const TransmitterPtr& transmitter)
+    : transmitter_(transmitter) {
+  static_assert(message::IsFixedLayout<MessageT>::value,
+                "only fixed-layout messages can be loaned");
+  static_assert(alignof(MessageT) <= alignof(uint64_t),
+                "shm blocks are only 8-byte aligned");
+  if (transmitter_ != nullptr &&
+      transmitter_->AcquireLoanedBlock(sizeof(MessageT), &block_)) {
+    msg_ = new (block_.buf) MessageT();
+    return;
+  }
+  heap_msg_ = std::make_shared<MessageT>();
+  msg_ = heap_msg_.get();
+}
+
+template <typename MessageT>
+LoanedMessage<MessageT>& LoanedMessage<MessageT>::operator=(
+    LoanedMessage&& other) noexcept {
+  if (this != &other) {
+    Release();
+    transmitter_ = std::move(other.transmitter_);
+    block_ = other.block_;
+    heap_msg_ = std::move(other.heap_msg_);
+    msg_ = other.msg_;
+    other.transmitter_ = nullptr;
+    other.heap_msg_ = nullptr;
+    other.msg_ = nullptr;
+  }
+  return *this;
+}
+
+template <typename MessageT>
+bool LoanedMessage<MessageT>::PublishLoanedBlock() {
+  if (!IsLoaned()) {
+    return false;
+  }
+  bool result = transmitter_->TransmitLoanedBlock(block_);
+  // the block belongs to the readers now, whether or not it was delivered
+  msg_ = nullptr;
+  transmitter_ = nullptr;
+  return result;
+}
+
+template <typename MessageT>
+std::shared_ptr<MessageT> LoanedMessage<MessageT>::TakeHeapMessage() {
+  auto msg = std::move(heap_msg_);
+  heap_msg_ = nullptr;
+  msg_ = nullptr;
+  transmitter_ = nullptr;
+  return msg;
+}
+
+template <typename MessageT>
+void LoanedMessage<MessageT>::Release() {
+  if (IsLoaned() && transmitter_ != nullptr) {
+    transmitter_->ReturnLoanedBlock(block_);
+  }
+  transmitter_ = nullptr;
+  heap_msg_ = nullptr;
+  msg_ = nullptr;
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_LOANED_MESSAGE_H_
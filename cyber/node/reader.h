@@ -109,8 +109,15 @@ Reader<MessageT>::Reader(const proto::RoleAttributes& role_attr,
     : ReaderBase(role_attr),
       pending_queue_size_(pending_queue_size),
       reader_func_(reader_func) {
-  blocker_.reset(new blocker::Blocker<MessageT>(blocker::BlockerAttr(
-      role_attr.qos_profile().depth(), role_attr.channel_name())));
+  uint32_t depth = role_attr.qos_profile().depth();
+  if (role_attr.qos_profile().history() ==
+      proto::QosHistoryPolicy::HISTORY_KEEP_LATEST) {
+    // a newer message overwrites the one not taken yet
+    pending_queue_size_ = 1;
+    depth = 1;
+  }
+  blocker_.reset(new blocker::Blocker<MessageT>(
+      blocker::BlockerAttr(depth, role_attr.channel_name())));
 }
 
 template <typename MessageT>
@@ -98,6 +98,8 @@ auto ReceiverManager<MessageT>::GetReceiver(
   // because multi reader for one channel will write datacache multi times,
   // so reader for datacache we use map to keep one instance for per channel
   const std::string& channel_name = role_attr.channel_name();
+  bool keep_latest = role_attr.qos_profile().history() ==
+                     proto::QosHistoryPolicy::HISTORY_KEEP_LATEST;
   if (receiver_map_.count(channel_name) == 0) {
     receiver_map_[channel_name] =
         transport::Transport::Instance()->CreateReceiver<MessageT>(
@@ -115,6 +117,11 @@ auto ReceiverManager<MessageT>::GetReceiver(
                   TransPerf::WRITE_NOTIFY, reader_attr.channel_id(),
                   msg_info.seq_num());
             });
+    receiver_map_[channel_name]->SetKeepLatest(keep_latest);
+  } else if (!keep_latest) {
+    // the receiver is shared, superseded messages may only be dropped when
+    // every reader of the channel keeps the latest one
+    receiver_map_[channel_name]->SetKeepLatest(false);
   }
   return receiver_map_[channel_name];
 }
@@ -21,7 +21,9 @@
 #include <string>
 #include <vector>
 
+#include "cyber/blocker/blocker_manager.h"
 #include "cyber/common/log.h"
+#include "cyber/node/loaned_message.h"
 #include "cyber/node/writer_base.h"
 #include "cyber/proto/topology_change.pb.h"
 #include "cyber/service_discovery/topology_manager.h"
@@ -46,6 +48,12 @@ class Writer : public WriterBase {
   virtual bool Write(const MessageT& msg);
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  // Zero-copy path for fixed-layout messages: fill the loaned message in
+  // place, then hand it to Write. Readers in other processes get a view of
+  // the same shm block.
+  LoanedMessage<MessageT> Loan();
+  bool Write(LoanedMessage<MessageT>* loaned_msg);
+
   bool HasReader() override;
   void GetReaders(std::vector<proto::RoleAttributes>* readers) override;
 
@@ -55,6 +63,8 @@ class Writer : public WriterBase {
   void OnChannelChange(const proto::ChangeMsg& change_msg);
 
   TransmitterPtr transmitter_;
+  // calls the fused components of the channel, see ReaderOption.fused
+  std::shared_ptr<blocker::Blocker<MessageT>> fused_blocker_;
 
   ChangeConnection change_conn_;
   service_discovery::ChannelManagerPtr channel_manager_;
@@ -82,6 +92,9 @@ bool Writer<MessageT>::Init() {
     if (transmitter_ == nullptr) {
       return false;
     }
+    fused_blocker_ =
+        blocker::BlockerManager::Instance()->GetOrCreateBlocker<MessageT>(
+            blocker::BlockerAttr(0, role_attr_.channel_name()));
     init_ = true;
   }
   this->role_attr_.set_id(transmitter_->id().HashValue());
@@ -115,7 +128,29 @@ bool Writer<MessageT>::Write(const MessageT& msg) {
 template <typename MessageT>
 bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   RETURN_VAL_IF(!WriterBase::IsInit(), false);
-  return transmitter_->Transmit(msg_ptr);
+  if (!transmitter_->Transmit(msg_ptr)) {
+    return false;
+  }
+  if (fused_blocker_ != nullptr) {
+    fused_blocker_->Publish(msg_ptr);
+  }
+  return true;
+}
+
+template <typename MessageT>
+LoanedMessage<MessageT> Writer<MessageT>::Loan() {
+  return LoanedMessage<MessageT>(transmitter_);
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::Write(LoanedMessage<MessageT>* loaned_msg) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  RETURN_VAL_IF_NULL(loaned_msg, false);
+  RETURN_VAL_IF(!(*loaned_msg), false);
+  if (loaned_msg->IsLoaned()) {
+    return loaned_msg->PublishLoanedBlock();
+  }
+  return Write(loaned_msg->TakeHeapMessage());
 }
 
 template <typename MessageT>
@@ -21,21 +21,47 @@
 namespace apollo {
 namespace cyber {
 
+using apollo::cyber::base::AtomicRWLock;
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+
 ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
-                                 const std::string& service_node_name)
-    : node_(node) {
+                                 const std::string& service_node_name,
+                                 bool enable_cache)
+    : node_(node), cache_enabled_(enable_cache) {
   get_parameter_client_ = node_->CreateClient<ParamName, Param>(
       FixParameterServiceName(service_node_name, GET_PARAMETER_SERVICE_NAME));
 
+  get_parameters_client_ = node_->CreateClient<ParamNames, Params>(
+      FixParameterServiceName(service_node_name, GET_PARAMETERS_SERVICE_NAME));
+
   set_parameter_client_ = node_->CreateClient<Param, BoolResult>(
       FixParameterServiceName(service_node_name, SET_PARAMETER_SERVICE_NAME));
 
   list_parameters_client_ = node_->CreateClient<NodeName, Params>(
       FixParameterServiceName(service_node_name, LIST_PARAMETERS_SERVICE_NAME));
+
+  if (cache_enabled_) {
+    param_event_reader_ = node_->CreateReader<Param>(
+        FixParameterServiceName(service_node_name,
+                                PARAMETER_EVENTS_CHANNEL_NAME),
+        [this](const std::shared_ptr<Param>& param) { OnParamEvent(param); });
+  }
 }
 
 bool ParameterClient::GetParameter(const std::string& param_name,
                                    Parameter* parameter) {
+  Param param;
+  if (GetCache(param_name, &param)) {
+    parameter->FromProtoParam(param);
+    return true;
+  }
+
+  uint64_t epoch = 0;
+  if (cache_enabled_) {
+    ReadLockGuard<AtomicRWLock> lock(cache_lock_);
+    epoch = cache_epoch_;
+  }
   auto request = std::make_shared<ParamName>();
   request->set_value(param_name);
   auto response = get_parameter_client_->SendRequest(request);
@@ -47,10 +73,54 @@ bool ParameterClient::GetParameter(const std::string& param_name,
     AWARN << "Parameter " << param_name << " not exists yet.";
     return false;
   }
+  PutCache(*response, epoch);
   parameter->FromProtoParam(*response);
   return true;
 }
 
+bool ParameterClient::GetParameters(const std::vector<std::string>& param_names,
+                                    std::vector<Parameter>* parameters) {
+  std::unordered_map<std::string, Param> found;
+  auto request = std::make_shared<ParamNames>();
+  for (auto& param_name : param_names) {
+    Param param;
+    if (GetCache(param_name, &param)) {
+      found[param_name] = param;
+    } else {
+      request->add_value(param_name);
+    }
+  }
+
+  if (request->value_size() > 0) {
+    uint64_t epoch = 0;
+    if (cache_enabled_) {
+      ReadLockGuard<AtomicRWLock> lock(cache_lock_);
+      epoch = cache_epoch_;
+    }
+    auto response = get_parameters_client_->SendRequest(request);
+    if (response == nullptr) {
+      AERROR << "Call " << get_parameters_client_->ServiceName() << " failed";
+      return false;
+    }
+    for (auto& param : response->param()) {
+      PutCache(param, epoch);
+      found[param.name()] = param;
+    }
+  }
+
+  for (auto& param_name : param_names) {
+    auto ite = found.find(param_name);
+    if (ite == found.end()) {
+      AWARN << "Parameter " << param_name << " not exists yet.";
+      continue;
+    }
+    Parameter parameter;
+    parameter.FromProtoParam(ite->second);
+    parameters->emplace_back(parameter);
+  }
+  return true;
+}
+
 bool ParameterClient::SetParameter(const Parameter& parameter) {
   auto request = std::make_shared<Param>(parameter.ToProtoParam());
   auto response = set_parameter_client_->SendRequest(request);
@@ -58,6 +128,10 @@ bool ParameterClient::SetParameter(const Parameter& parameter) {
     AERROR << "Call " << set_parameter_client_->ServiceName() << " failed";
     return false;
   }
+  if (response->value()) {
+    // the event of this change may arrive later, read our own write now
+    OnParamEvent(request);
+  }
   return response->value();
 }
 
@@ -77,5 +151,41 @@ bool ParameterClient::ListParameters(std::vector<Parameter>* parameters) {
   return true;
 }
 
+bool ParameterClient::GetCache(const std::string& param_name, Param* param) {
+  if (!cache_enabled_) {
+    return false;
+  }
+  ReadLockGuard<AtomicRWLock> lock(cache_lock_);
+  auto ite = cache_.find(param_name);
+  if (ite == cache_.end()) {
+    return false;
+  }
+  *param = ite->second;
+  return true;
+}
+
+void ParameterClient::PutCache(const Param& param, uint64_t epoch) {
+  if (!cache_enabled_) {
+    return;
+  }
+  WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+  if (epoch == cache_epoch_) {
+    cache_[param.name()] = param;
+  }
+}
+
+void ParameterClient::OnParamEvent(const std::shared_ptr<Param>& param) {
+  if (!cache_enabled_) {
+    return;
+  }
+  WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+  ++cache_epoch_;
+  // only names read before are cached, the others are fetched on demand
+  auto ite = cache_.find(param->name());
+  if (ite != cache_.end()) {
+    ite->second = *param;
+  }
+}
+
 }  // namespace cyber
 }  // namespace apollo
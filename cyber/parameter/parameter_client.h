@@ -19,8 +19,11 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/node/reader.h"
 #include "cyber/parameter/parameter.h"
 #include "cyber/proto/parameter.pb.h"
 #include "cyber/service/client.h"
@@ -35,9 +38,11 @@ class ParameterClient {
   using Param = apollo::cyber::proto::Param;
   using NodeName = apollo::cyber::proto::NodeName;
   using ParamName = apollo::cyber::proto::ParamName;
+  using ParamNames = apollo::cyber::proto::ParamNames;
   using BoolResult = apollo::cyber::proto::BoolResult;
   using Params = apollo::cyber::proto::Params;
   using GetParameterClient = Client<ParamName, Param>;
+  using GetParametersClient = Client<ParamNames, Params>;
   using SetParameterClient = Client<Param, BoolResult>;
   using ListParametersClient = Client<NodeName, Params>;
   /**
@@ -45,9 +50,13 @@ class ParameterClient {
    *
    * @param node shared_ptr of the node handler
    * @param service_node_name node name which provide a param services
+   * @param enable_cache keep the parameters read so far in a local cache
+   *        that follows the change events of the server, so that repeated
+   *        reads do not call the service
    */
   ParameterClient(const std::shared_ptr<Node>& node,
-                  const std::string& service_node_name);
+                  const std::string& service_node_name,
+                  bool enable_cache = false);
 
   /**
    * @brief Get the Parameter object
@@ -59,6 +68,19 @@ class ParameterClient {
    */
   bool GetParameter(const std::string& param_name, Parameter* parameter);
 
+  /**
+   * @brief Get many Parameter objects with at most one service call, names
+   * which are answered by the cache are not requested
+   *
+   * @param param_names names of the parameters
+   * @param parameters pointer of vector to store the parameters that exist,
+   *        in the order of param_names
+   * @return true
+   * @return false call service fail or timeout
+   */
+  bool GetParameters(const std::vector<std::string>& param_names,
+                     std::vector<Parameter>* parameters);
+
   /**
    * @brief Set the Parameter object
    *
@@ -80,10 +102,22 @@ class ParameterClient {
   bool ListParameters(std::vector<Parameter>* parameters);
 
  private:
+  bool GetCache(const std::string& param_name, Param* param);
+  // drops results that a change event overtook while they were in flight
+  void PutCache(const Param& param, uint64_t epoch);
+  void OnParamEvent(const std::shared_ptr<Param>& param);
+
   std::shared_ptr<Node> node_;
   std::shared_ptr<GetParameterClient> get_parameter_client_;
+  std::shared_ptr<GetParametersClient> get_parameters_client_;
   std::shared_ptr<SetParameterClient> set_parameter_client_;
   std::shared_ptr<ListParametersClient> list_parameters_client_;
+
+  bool cache_enabled_ = false;
+  std::shared_ptr<Reader<Param>> param_event_reader_;
+  base::AtomicRWLock cache_lock_;
+  uint64_t cache_epoch_ = 0;
+  std::unordered_map<std::string, Param> cache_;
 };
 
 }  // namespace cyber
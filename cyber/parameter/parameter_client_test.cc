@@ -76,6 +76,46 @@ TEST_F(ParameterClientTest, get_parameter) {
   EXPECT_FALSE(pc_->GetParameter("int", &parameter));
 }
 
+TEST_F(ParameterClientTest, get_parameters) {
+  ps_->SetParameter(Parameter("int", 1));
+  ps_->SetParameter(Parameter("string", "1"));
+  std::vector<Parameter> parameters;
+  EXPECT_TRUE(pc_->GetParameters({"string", "double", "int"}, &parameters));
+  EXPECT_EQ(2, parameters.size());
+  EXPECT_EQ("string", parameters[0].Name());
+  EXPECT_EQ("1", parameters[0].AsString());
+  EXPECT_EQ("int", parameters[1].Name());
+  EXPECT_EQ(1, parameters[1].AsInt64());
+
+  ps_.reset();
+  EXPECT_FALSE(pc_->GetParameters({"int"}, &parameters));
+}
+
+TEST_F(ParameterClientTest, cached_parameter) {
+  ParameterClient pc(node_, "parameter_server", true);
+  ps_->SetParameter(Parameter("int", 1));
+  Parameter parameter;
+  EXPECT_TRUE(pc.GetParameter("int", &parameter));
+  EXPECT_EQ(1, parameter.AsInt64());
+
+  ps_->SetParameter(Parameter("int", 2));
+  usleep(100000);
+  EXPECT_TRUE(pc.GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+
+  EXPECT_TRUE(pc.SetParameter(Parameter("int", 3)));
+  EXPECT_TRUE(pc.GetParameter("int", &parameter));
+  EXPECT_EQ(3, parameter.AsInt64());
+
+  // answered from the cache without the server
+  ps_.reset();
+  std::vector<Parameter> parameters;
+  EXPECT_TRUE(pc.GetParameters({"int"}, &parameters));
+  EXPECT_EQ(1, parameters.size());
+  EXPECT_EQ(3, parameters[0].AsInt64());
+  EXPECT_FALSE(pc.GetParameter("double", &parameter));
+}
+
 TEST_F(ParameterClientTest, list_parameter) {
   ps_->SetParameter(Parameter("int", 1));
   std::vector<Parameter> parameters;
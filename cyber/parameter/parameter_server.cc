@@ -24,6 +24,8 @@ namespace cyber {
 ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
     : node_(node) {
   auto name = node_->Name();
+  param_event_writer_ = node_->CreateWriter<Param>(
+      FixParameterServiceName(name, PARAMETER_EVENTS_CHANNEL_NAME));
   get_parameter_service_ = node_->CreateService<ParamName, Param>(
       FixParameterServiceName(name, GET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<ParamName>& request,
@@ -36,12 +38,28 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
         }
       });
 
+  get_parameters_service_ = node_->CreateService<ParamNames, Params>(
+      FixParameterServiceName(name, GET_PARAMETERS_SERVICE_NAME),
+      [this](const std::shared_ptr<ParamNames>& request,
+             std::shared_ptr<Params>& response) {
+        std::lock_guard<std::mutex> lock(param_map_mutex_);
+        for (auto& param_name : request->value()) {
+          auto ite = param_map_.find(param_name);
+          if (ite != param_map_.end()) {
+            response->add_param()->CopyFrom(ite->second);
+          }
+        }
+      });
+
   set_parameter_service_ = node_->CreateService<Param, BoolResult>(
       FixParameterServiceName(name, SET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<Param>& request,
              std::shared_ptr<BoolResult>& response) {
-        std::lock_guard<std::mutex> lock(param_map_mutex_);
-        param_map_[request->name()] = *request;
+        {
+          std::lock_guard<std::mutex> lock(param_map_mutex_);
+          param_map_[request->name()] = *request;
+        }
+        param_event_writer_->Write(request);
         response->set_value(true);
       });
 
@@ -58,8 +76,12 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
 }
 
 void ParameterServer::SetParameter(const Parameter& parameter) {
-  std::lock_guard<std::mutex> lock(param_map_mutex_);
-  param_map_[parameter.Name()] = parameter.ToProtoParam();
+  auto param = std::make_shared<Param>(parameter.ToProtoParam());
+  {
+    std::lock_guard<std::mutex> lock(param_map_mutex_);
+    param_map_[parameter.Name()] = *param;
+  }
+  param_event_writer_->Write(param);
 }
 
 bool ParameterServer::GetParameter(const std::string& parameter_name,
@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cyber/node/writer.h"
 #include "cyber/parameter/parameter.h"
 #include "cyber/proto/parameter.pb.h"
 #include "cyber/service/service.h"
@@ -36,6 +37,7 @@ class ParameterServer {
   using Param = apollo::cyber::proto::Param;
   using NodeName = apollo::cyber::proto::NodeName;
   using ParamName = apollo::cyber::proto::ParamName;
+  using ParamNames = apollo::cyber::proto::ParamNames;
   using BoolResult = apollo::cyber::proto::BoolResult;
   using Params = apollo::cyber::proto::Params;
   /**
@@ -72,8 +74,11 @@ class ParameterServer {
  private:
   std::shared_ptr<Node> node_;
   std::shared_ptr<Service<ParamName, Param>> get_parameter_service_;
+  std::shared_ptr<Service<ParamNames, Params>> get_parameters_service_;
   std::shared_ptr<Service<Param, BoolResult>> set_parameter_service_;
   std::shared_ptr<Service<NodeName, Params>> list_parameters_service_;
+  // every change is published here so that clients can keep a cache
+  std::shared_ptr<Writer<Param>> param_event_writer_;
 
   std::mutex param_map_mutex_;
   std::unordered_map<std::string, Param> param_map_;
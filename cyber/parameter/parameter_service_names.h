@@ -25,7 +25,9 @@ namespace cyber {
 constexpr auto SERVICE_NAME_DELIMITER = "/";
 constexpr auto GET_PARAMETER_SERVICE_NAME = "get_parameter";
 constexpr auto SET_PARAMETER_SERVICE_NAME = "set_parameter";
+constexpr auto GET_PARAMETERS_SERVICE_NAME = "get_parameters";
 constexpr auto LIST_PARAMETERS_SERVICE_NAME = "list_parameters";
+constexpr auto PARAMETER_EVENTS_CHANNEL_NAME = "parameter_events";
 
 static inline std::string FixParameterServiceName(const std::string& node_name,
                                                   const char* service_name) {
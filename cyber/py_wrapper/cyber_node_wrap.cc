@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "cyber/py_wrapper/py_buffer.h"
 #include "cyber/py_wrapper/py_node.h"
 
 #define PYOBJECT_NULL_STRING PyString_FromStringAndSize("", 0)
@@ -163,6 +164,42 @@ PyObject *cyber_PyReader_read(PyObject *self, PyObject *args) {
   return PyString_FromStringAndSize(reader_ret.c_str(), reader_ret.size());
 }
 
+// like PyReader_read, the message comes as a memoryview of the received
+// bytes instead of a copy, an empty string if there is none
+PyObject *cyber_PyReader_read_buffer(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  PyObject *pyobj_iswait = nullptr;
+
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OO:cyber_PyReader_read_buffer"),
+                        &pyobj_reader, &pyobj_iswait)) {
+    AINFO << "cyber_PyReader_read_buffer:PyArg_ParseTuple failed!";
+    return Py_None;
+  }
+  apollo::cyber::PyReader *reader = PyObjectToPtr<apollo::cyber::PyReader *>(
+      pyobj_reader, "apollo_cyber_pyreader");
+  if (nullptr == reader) {
+    AINFO << "cyber_PyReader_read_buffer:PyReader ptr is null!";
+    return Py_None;
+  }
+
+  int r = PyObject_IsTrue(pyobj_iswait);
+  if (r == -1) {
+    AINFO << "cyber_PyReader_read_buffer:pyobj_iswait is error!";
+    return Py_None;
+  }
+
+  std::shared_ptr<const apollo::cyber::message::PyMessageWrap> message;
+  Py_BEGIN_ALLOW_THREADS
+  message = reader->read_message(r == 1);
+  Py_END_ALLOW_THREADS
+  if (message == nullptr) {
+    return PYOBJECT_NULL_STRING;
+  }
+  const std::string &data = message->data();
+  return apollo::cyber::PyMemoryViewOf(message, data.data(), data.size());
+}
+
 PyObject *cyber_PyReader_register_func(PyObject *self, PyObject *args) {
   PyObject *pyobj_regist_fun = 0;
   PyObject *pyobj_reader = 0;
@@ -611,6 +648,7 @@ static PyMethodDef _cyber_node_methods[] = {
     {"delete_PyReader", cyber_delete_PyReader, METH_VARARGS, ""},
     {"PyReader_register_func", cyber_PyReader_register_func, METH_VARARGS, ""},
     {"PyReader_read", cyber_PyReader_read, METH_VARARGS, ""},
+    {"PyReader_read_buffer", cyber_PyReader_read_buffer, METH_VARARGS, ""},
 
     // PyClient fun
     {"new_PyClient", cyber_new_PyClient, METH_VARARGS, ""},
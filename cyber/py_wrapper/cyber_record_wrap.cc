@@ -18,6 +18,7 @@
 #include <set>
 #include <string>
 
+#include "cyber/py_wrapper/py_buffer.h"
 #include "cyber/py_wrapper/py_record.h"
 
 #define PYOBJECT_NULL_STRING PyString_FromStringAndSize("", 0)
@@ -64,33 +65,15 @@ PyObject *cyber_delete_PyRecordReader(PyObject *self, PyObject *args) {
   return Py_None;
 }
 
-PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
-  PyObject *pyobj_reader = nullptr;
-  uint64_t begin_time = 0;
-  uint64_t end_time = UINT64_MAX;
-  if (!PyArg_ParseTuple(args,
-                        const_cast<char *>("OKK:PyRecordReader_ReadMessage"),
-                        &pyobj_reader, &begin_time, &end_time)) {
-    return nullptr;
-  }
-
-  auto reader = (apollo::cyber::record::PyRecordReader *)PyCapsule_GetPointer(
-      pyobj_reader, "apollo_cyber_record_pyrecordfilereader");
-  if (nullptr == reader) {
-    AERROR << "PyRecordReader_ReadMessage ptr is null!";
-    return nullptr;
-  }
-
-  apollo::cyber::record::BagMessage result;
-  result = reader->ReadMessage(begin_time, end_time);
+// takes over the reference to |bld_data|
+PyObject *BagMessageToPyDict(const apollo::cyber::record::BagMessage &result,
+                             PyObject *bld_data) {
   PyObject *pyobj_bag_message = PyDict_New();
 
   PyObject *bld_name = Py_BuildValue("s", result.channel_name.c_str());
   PyDict_SetItemString(pyobj_bag_message, "channel_name", bld_name);
   Py_DECREF(bld_name);
 
-  PyObject *bld_data =
-      Py_BuildValue("s#", result.data.c_str(), result.data.length());
   PyDict_SetItemString(pyobj_bag_message, "data", bld_data);
   Py_DECREF(bld_data);
 
@@ -111,6 +94,65 @@ PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
   return pyobj_bag_message;
 }
 
+PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t begin_time = 0;
+  uint64_t end_time = UINT64_MAX;
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OKK:PyRecordReader_ReadMessage"),
+                        &pyobj_reader, &begin_time, &end_time)) {
+    return nullptr;
+  }
+
+  auto reader = (apollo::cyber::record::PyRecordReader *)PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader");
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessage ptr is null!";
+    return nullptr;
+  }
+
+  apollo::cyber::record::BagMessage result;
+  result = reader->ReadMessage(begin_time, end_time);
+  PyObject *bld_data =
+      Py_BuildValue("s#", result.data.c_str(), result.data.length());
+  return BagMessageToPyDict(result, bld_data);
+}
+
+// like PyRecordReader_ReadMessage, data is a memoryview of the content
+PyObject *cyber_PyRecordReader_ReadMessageBuffer(PyObject *self,
+                                                 PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t begin_time = 0;
+  uint64_t end_time = UINT64_MAX;
+  if (!PyArg_ParseTuple(
+          args, const_cast<char *>("OKK:PyRecordReader_ReadMessageBuffer"),
+          &pyobj_reader, &begin_time, &end_time)) {
+    return nullptr;
+  }
+
+  auto reader = (apollo::cyber::record::PyRecordReader *)PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader");
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessageBuffer ptr is null!";
+    return nullptr;
+  }
+
+  apollo::cyber::record::BagMessage result;
+  result = reader->ReadSharedMessage(begin_time, end_time);
+  PyObject *bld_data = nullptr;
+  if (result.shared_data == nullptr) {
+    bld_data = PYOBJECT_NULL_STRING;
+  } else {
+    bld_data = apollo::cyber::PyMemoryViewOf(result.shared_data,
+                                             result.shared_data->data(),
+                                             result.shared_data->size());
+    if (bld_data == nullptr) {
+      return nullptr;
+    }
+  }
+  return BagMessageToPyDict(result, bld_data);
+}
+
 PyObject *cyber_PyRecordReader_GetMessageNumber(PyObject *self,
                                                 PyObject *args) {
   PyObject *pyobj_reader = nullptr;
@@ -505,6 +547,8 @@ static PyMethodDef _cyber_record_methods[] = {
     {"delete_PyRecordReader", cyber_delete_PyRecordReader, METH_VARARGS, ""},
     {"PyRecordReader_ReadMessage", cyber_PyRecordReader_ReadMessage,
      METH_VARARGS, ""},
+    {"PyRecordReader_ReadMessageBuffer", cyber_PyRecordReader_ReadMessageBuffer,
+     METH_VARARGS, ""},
     {"PyRecordReader_GetMessageNumber", cyber_PyRecordReader_GetMessageNumber,
      METH_VARARGS, ""},
     {"PyRecordReader_GetMessageType", cyber_PyRecordReader_GetMessageType,
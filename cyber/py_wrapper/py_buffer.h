@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef PYTHON_WRAPPER_PY_BUFFER_H_
+#define PYTHON_WRAPPER_PY_BUFFER_H_
+
+#include <Python.h>
+
+#include <memory>
+
+namespace apollo {
+namespace cyber {
+
+// Read-only bytes owned by a C++ object, exported through the buffer
+// protocol. Memoryviews of it keep |owner| alive, so Python reads received
+// messages where they are instead of from a bytes copy.
+struct PyCyberBuffer {
+  PyObject_HEAD
+  std::shared_ptr<const void>* owner;
+  const char* data;
+  Py_ssize_t size;
+};
+
+inline int PyCyberBuffer_GetBuffer(PyObject* obj, Py_buffer* view,
+                                   int flags) {
+  auto self = reinterpret_cast<PyCyberBuffer*>(obj);
+  return PyBuffer_FillInfo(view, obj, const_cast<char*>(self->data),
+                           self->size, 1, flags);
+}
+
+inline void PyCyberBuffer_Dealloc(PyObject* obj) {
+  auto self = reinterpret_cast<PyCyberBuffer*>(obj);
+  delete self->owner;
+  self->owner = nullptr;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+inline PyTypeObject* PyCyberBufferType() {
+  static PyBufferProcs buffer_procs;
+  static PyTypeObject type;
+  static bool ready = false;
+  if (!ready) {
+    buffer_procs.bf_getbuffer = PyCyberBuffer_GetBuffer;
+    buffer_procs.bf_releasebuffer = nullptr;
+    type.tp_name = "cyber.Buffer";
+    type.tp_basicsize = sizeof(PyCyberBuffer);
+    type.tp_dealloc = PyCyberBuffer_Dealloc;
+    type.tp_as_buffer = &buffer_procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+#ifdef Py_TPFLAGS_HAVE_NEWBUFFER
+    type.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+    if (PyType_Ready(&type) < 0) {
+      return nullptr;
+    }
+    ready = true;
+  }
+  return &type;
+}
+
+// Returns a memoryview of |size| bytes at |data|, which must stay valid as
+// long as |owner| does, or nullptr with the Python error set.
+inline PyObject* PyMemoryViewOf(const std::shared_ptr<const void>& owner,
+                                const char* data, size_t size) {
+  PyTypeObject* type = PyCyberBufferType();
+  if (type == nullptr) {
+    return nullptr;
+  }
+  auto buffer = PyObject_New(PyCyberBuffer, type);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  buffer->owner = new std::shared_ptr<const void>(owner);
+  buffer->data = data;
+  buffer->size = static_cast<Py_ssize_t>(size);
+  PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+  // the memoryview holds its own reference to the buffer
+  Py_DECREF(buffer);
+  return view;
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // PYTHON_WRAPPER_PY_BUFFER_H_
@@ -100,23 +100,22 @@ class PyReader {
   void register_func(int (*func)(const char *)) { func_ = func; }
 
   std::string read(bool wait = false) {
-    std::string msg("");
-    std::unique_lock<std::mutex> ul(msg_lock_);
-    if (!cache_.empty()) {
-      msg = std::move(cache_.front());
-      cache_.pop_front();
-    }
+    auto message = read_message(wait);
+    return message == nullptr ? std::string("") : message->data();
+  }
 
-    if (!wait) {
-      return msg;
+  // the received message itself, for access to its bytes without a copy
+  std::shared_ptr<const message::PyMessageWrap> read_message(
+      bool wait = false) {
+    std::shared_ptr<const message::PyMessageWrap> msg = nullptr;
+    std::unique_lock<std::mutex> ul(msg_lock_);
+    if (wait) {
+      msg_cond_.wait(ul, [this] { return !this->cache_.empty(); });
     }
-
-    msg_cond_.wait(ul, [this] { return !this->cache_.empty(); });
     if (!cache_.empty()) {
       msg = std::move(cache_.front());
       cache_.pop_front();
     }
-
     return msg;
   }
 
@@ -125,7 +124,7 @@ class PyReader {
               &message) {
     {
       std::lock_guard<std::mutex> lg(msg_lock_);
-      cache_.push_back(message->data());
+      cache_.push_back(message);
     }
     if (func_) {
       func_(channel_name_.c_str());
@@ -139,7 +138,7 @@ class PyReader {
   int (*func_)(const char *) = nullptr;
   std::shared_ptr<apollo::cyber::Reader<apollo::cyber::message::PyMessageWrap>>
       reader_;
-  std::deque<std::string> cache_;
+  std::deque<std::shared_ptr<const message::PyMessageWrap>> cache_;
   std::mutex msg_lock_;
   std::condition_variable msg_cond_;
 };
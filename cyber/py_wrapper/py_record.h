@@ -46,6 +46,8 @@ struct BagMessage {
   uint64_t timestamp = 0;
   std::string channel_name = "";
   std::string data = "";
+  // holds the content instead of data when read by ReadSharedMessage
+  std::shared_ptr<const std::string> shared_data = nullptr;
   std::string data_type = "";
   bool end = true;
 };
@@ -68,13 +70,25 @@ class PyRecordReader {
 
     ret_msg.end = false;
     ret_msg.channel_name = record_message.channel_name;
-    ret_msg.data = record_message.content;
+    ret_msg.data = std::move(record_message.content);
     ret_msg.timestamp = record_message.time;
     ret_msg.data_type =
         record_reader_->GetMessageType(record_message.channel_name);
     return ret_msg;
   }
 
+  // the content is left in one shared buffer that can be handed out as is
+  BagMessage ReadSharedMessage(uint64_t begin_time = 0,
+                               uint64_t end_time = UINT64_MAX) {
+    BagMessage ret_msg = ReadMessage(begin_time, end_time);
+    if (!ret_msg.end) {
+      ret_msg.shared_data =
+          std::make_shared<const std::string>(std::move(ret_msg.data));
+      ret_msg.data.clear();
+    }
+    return ret_msg;
+  }
+
   uint64_t GetMessageNumber(const std::string& channel_name) {
     return record_reader_->GetMessageNumber(channel_name);
   }
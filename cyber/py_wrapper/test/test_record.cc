@@ -67,6 +67,17 @@ TEST(CyberRecordTest, record_readerwriter) {
   EXPECT_EQ(1, header.chunk_number());
   EXPECT_EQ(1, header.channel_number());
   EXPECT_TRUE(header.is_complete());
+
+  rec_reader.Reset();
+  bag_msg = rec_reader.ReadSharedMessage();
+  EXPECT_FALSE(bag_msg.end);
+  ASSERT_NE(nullptr, bag_msg.shared_data);
+  EXPECT_EQ(STR_10B, *bag_msg.shared_data);
+  EXPECT_TRUE(bag_msg.data.empty());
+  EXPECT_EQ(888, bag_msg.timestamp);
+  bag_msg = rec_reader.ReadSharedMessage();
+  EXPECT_TRUE(bag_msg.end);
+  EXPECT_EQ(nullptr, bag_msg.shared_data);
 }
 
 int main(int argc, char** argv) {
@@ -186,6 +186,14 @@ class Node(object):
         reader callback
         """
         sub = self.subs[name]
+        if sub[4]:
+            msg_buf = _CYBER_NODE.PyReader_read_buffer(sub[0], False)
+            if len(msg_buf) > 0:
+                if sub[2] is None:
+                    sub[1](msg_buf)
+                else:
+                    sub[1](msg_buf, sub[2])
+            return 0
         msg_str = _CYBER_NODE.PyReader_read(sub[0], False)
         if len(msg_str) > 0:
             proto = sub[3]()
@@ -209,6 +217,23 @@ class Node(object):
                    i.e. fn(data, args)
         @args any: additional arguments to pass to the callback
         """
+        return self._create_reader(name, data_type, callback, args, False)
+
+    def create_buffer_reader(self, name, data_type, callback, args=None):
+        """
+        create a topic reader which passes every message to the callback
+        as a read-only memoryview of the received bytes, without a copy.
+        The view keeps the message alive, parse it or wrap it, e.g. with
+        numpy.frombuffer, when only parts of it are needed.
+        @param self
+        @param name str: topic name
+        @param data_type proto: message class of the topic
+        @callback fn: function to call (fn(view)) when data is received
+        @args any: additional arguments to pass to the callback
+        """
+        return self._create_reader(name, data_type, callback, args, True)
+
+    def _create_reader(self, name, data_type, callback, args, raw):
         self.mutex.acquire()
         if name in self.subs.keys():
             self.mutex.release()
@@ -221,7 +246,7 @@ class Node(object):
         if reader is None:
             return None
         self.list_reader.append(reader)
-        sub = (reader, callback, args, data_type, False)
+        sub = (reader, callback, args, data_type, raw)
 
         self.mutex.acquire()
         self.subs[name] = sub
@@ -249,7 +274,10 @@ class Node(object):
         """
         self.mutex.acquire()
         for _, item in self.subs.items():
-            msg_str = _CYBER_NODE.PyReader_read(item[0], False)
+            if item[4]:
+                msg_str = _CYBER_NODE.PyReader_read_buffer(item[0], False)
+            else:
+                msg_str = _CYBER_NODE.PyReader_read(item[0], False)
             if len(msg_str) > 0:
                 if item[4]:
                     if item[2] is None:
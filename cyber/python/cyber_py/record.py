@@ -47,17 +47,22 @@ class RecordReader(object):
     def __del__(self):
         _CYBER_RECORD.delete_PyRecordReader(self.record_reader)
 
-    def read_messages(self, start_time=0, end_time=18446744073709551615):
+    def read_messages(self, start_time=0, end_time=18446744073709551615,
+                      zero_copy=False):
         """
         read message from bag file.
         @param self
         @param start_time:
         @param end_time:
+        @param zero_copy: message is a read-only memoryview of the content
         @return: generator of (message, data_type, timestamp)
         """
+        if zero_copy:
+            read_message = _CYBER_RECORD.PyRecordReader_ReadMessageBuffer
+        else:
+            read_message = _CYBER_RECORD.PyRecordReader_ReadMessage
         while True:
-            message = _CYBER_RECORD.PyRecordReader_ReadMessage(
-                  self.record_reader, start_time, end_time)
+            message = read_message(self.record_reader, start_time, end_time)
 
             if not message["end"]:
                 yield PyBagMessage(message["channel_name"], message["data"],
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compressor.h"
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include <limits>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+namespace {
+
+const size_t kRawSizeBytes = sizeof(uint64_t);
+// the zstd default, archiving tools can recompress harder offline
+const int kZstdLevel = 3;
+
+void PutRawSize(uint64_t size, std::string* out) {
+  char bytes[kRawSizeBytes];
+  for (size_t i = 0; i < kRawSizeBytes; ++i) {
+    bytes[i] = static_cast<char>((size >> (8 * i)) & 0xff);
+  }
+  out->assign(bytes, kRawSizeBytes);
+}
+
+uint64_t GetRawSize(const char* in) {
+  uint64_t size = 0;
+  for (size_t i = 0; i < kRawSizeBytes; ++i) {
+    size |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  }
+  return size;
+}
+
+}  // namespace
+
+bool IsCompressSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_LZ4 ||
+         type == CompressType::COMPRESS_ZSTD;
+}
+
+bool CompressChunkBody(CompressType type, const std::string& raw,
+                       std::string* compressed) {
+  size_t bound = 0;
+  switch (type) {
+    case CompressType::COMPRESS_LZ4:
+      if (raw.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+        AERROR << "Chunk too large for lz4, size: " << raw.size();
+        return false;
+      }
+      bound = LZ4_compressBound(static_cast<int>(raw.size()));
+      break;
+    case CompressType::COMPRESS_ZSTD:
+      bound = ZSTD_compressBound(raw.size());
+      break;
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+
+  PutRawSize(raw.size(), compressed);
+  compressed->resize(kRawSizeBytes + bound);
+  char* dst = &(*compressed)[kRawSizeBytes];
+  size_t size = 0;
+  if (type == CompressType::COMPRESS_LZ4) {
+    int ret = LZ4_compress_default(raw.data(), dst,
+                                   static_cast<int>(raw.size()),
+                                   static_cast<int>(bound));
+    if (ret <= 0) {
+      AERROR << "Lz4 compress failed, size: " << raw.size();
+      return false;
+    }
+    size = ret;
+  } else {
+    size = ZSTD_compress(dst, bound, raw.data(), raw.size(), kZstdLevel);
+    if (ZSTD_isError(size)) {
+      AERROR << "Zstd compress failed: " << ZSTD_getErrorName(size);
+      return false;
+    }
+  }
+  compressed->resize(kRawSizeBytes + size);
+  return true;
+}
+
+bool DecompressChunkBody(CompressType type, const char* compressed,
+                         size_t size, std::string* raw) {
+  if (size < kRawSizeBytes) {
+    AERROR << "Compressed chunk too short, size: " << size;
+    return false;
+  }
+  uint64_t raw_size = GetRawSize(compressed);
+  if (raw_size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+    AERROR << "Chunk body too large, size: " << raw_size;
+    return false;
+  }
+  raw->resize(raw_size);
+  const char* src = compressed + kRawSizeBytes;
+  size_t src_size = size - kRawSizeBytes;
+  char* dst = raw_size > 0 ? &(*raw)[0] : nullptr;
+  if (type == CompressType::COMPRESS_LZ4) {
+    int ret = LZ4_decompress_safe(src, dst, static_cast<int>(src_size),
+                                  static_cast<int>(raw_size));
+    if (ret < 0 || static_cast<uint64_t>(ret) != raw_size) {
+      AERROR << "Lz4 decompress failed, expect: " << raw_size
+             << ", actual: " << ret;
+      return false;
+    }
+    return true;
+  }
+  if (type == CompressType::COMPRESS_ZSTD) {
+    size_t ret = ZSTD_decompress(dst, raw_size, src, src_size);
+    if (ZSTD_isError(ret) || ret != raw_size) {
+      AERROR << "Zstd decompress failed, expect: " << raw_size << ", actual: "
+             << (ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "short");
+      return false;
+    }
+    return true;
+  }
+  AERROR << "Unsupported compress type: " << type;
+  return false;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+#define CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+
+#include <cstddef>
+#include <string>
+
+#include "cyber/record/file/record_file_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+// A compressed chunk body is the size of the serialized ChunkBody as a
+// little endian uint64 followed by one LZ4 block or one Zstd frame.
+bool IsCompressSupported(CompressType type);
+
+bool CompressChunkBody(CompressType type, const std::string& raw,
+                       std::string* compressed);
+
+bool DecompressChunkBody(CompressType type, const char* compressed,
+                         size_t size, std::string* raw);
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/record_file_mmap_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "cyber/common/log.h"
+#include "cyber/record/file/chunk_compressor.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+RecordFileMmapReader::~RecordFileMmapReader() { Close(); }
+
+bool RecordFileMmapReader::Open(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+  fd_ = open(path_.data(), O_RDONLY);
+  if (fd_ < 0) {
+    AERROR << "Open file failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) < 0 || file_stat.st_size <= 0) {
+    AERROR << "Stat file failed, file: " << path_ << ", errno: " << errno;
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  // the mapping keeps the file open
+  close(fd_);
+  fd_ = -1;
+  if (addr == MAP_FAILED) {
+    AERROR << "Mmap file failed, file: " << path_ << ", errno: " << errno;
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<const char*>(addr);
+  // the player jumps around, readahead of the whole file is wasted
+  madvise(addr, size_, MADV_RANDOM);
+
+  if (!ReadHeader() || !ReadIndex()) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void RecordFileMmapReader::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+  chunks_.clear();
+  channel_names_.clear();
+}
+
+bool RecordFileMmapReader::ReadSection(uint64_t position, SectionType type,
+                                       Section* section,
+                                       const char** data) const {
+  if (position > size_ || size_ - position < sizeof(Section)) {
+    AERROR << "Section out of file, position: " << position
+           << ", file size: " << size_;
+    return false;
+  }
+  std::memcpy(section, data_ + position, sizeof(Section));
+  if (section->type != type) {
+    AERROR << "Check section type failed, expect: " << type
+           << ", actual: " << section->type;
+    return false;
+  }
+  uint64_t begin = position + sizeof(Section);
+  if (section->size < 0 || section->size > INT_MAX ||
+      static_cast<uint64_t>(section->size) > size_ - begin) {
+    AERROR << "Section size out of file, size: " << section->size;
+    return false;
+  }
+  *data = data_ + begin;
+  return true;
+}
+
+bool RecordFileMmapReader::ReadHeader() {
+  Section section;
+  const char* data = nullptr;
+  if (!ReadSection(0, SectionType::SECTION_HEADER, &section, &data) ||
+      !header_.ParseFromArray(data, static_cast<int>(section.size))) {
+    AERROR << "Read header section fail, file: " << path_;
+    return false;
+  }
+  return true;
+}
+
+bool RecordFileMmapReader::ReadIndex() {
+  if (!header_.is_complete()) {
+    ADEBUG << "Record file is not complete, file: " << path_;
+    return false;
+  }
+  Section section;
+  const char* data = nullptr;
+  if (!ReadSection(header_.index_position(), SectionType::SECTION_INDEX,
+                   &section, &data) ||
+      !index_.ParseFromArray(data, static_cast<int>(section.size))) {
+    AERROR << "Read index section fail, file: " << path_;
+    return false;
+  }
+
+  uint64_t max_end_time = 0;
+  for (const auto& single_index : index_.indexes()) {
+    if (single_index.type() == SectionType::SECTION_CHANNEL) {
+      channel_names_.push_back(single_index.channel_cache().name());
+      continue;
+    }
+    if (single_index.type() != SectionType::SECTION_CHUNK_HEADER ||
+        !single_index.has_chunk_header_cache()) {
+      continue;
+    }
+    const auto& cache = single_index.chunk_header_cache();
+    max_end_time = std::max(max_end_time, cache.end_time());
+    // the writer indexes a chunk header with the position right after it
+    chunks_.push_back({cache.begin_time(), cache.end_time(), max_end_time,
+                       single_index.position(), &cache});
+  }
+  return true;
+}
+
+size_t RecordFileMmapReader::FindChunk(uint64_t begin_time) const {
+  auto it = std::lower_bound(chunks_.begin(), chunks_.end(), begin_time,
+                             [](const ChunkEntry& chunk, uint64_t time) {
+                               return chunk.max_end_time < time;
+                             });
+  return it - chunks_.begin();
+}
+
+bool RecordFileMmapReader::ChunkHasChannel(
+    size_t index, const std::vector<bool>& wanted) const {
+  const auto& channel_index = chunks_[index].cache->channel_index();
+  if (channel_index.empty()) {
+    return true;
+  }
+  for (uint32_t i : channel_index) {
+    if (i >= wanted.size() || wanted[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RecordFileMmapReader::ReadChunk(size_t index, ChunkBody* body) const {
+  if (index >= chunks_.size()) {
+    return false;
+  }
+  Section section;
+  const char* data = nullptr;
+  if (!ReadSection(chunks_[index].position, SectionType::SECTION_CHUNK_BODY,
+                   &section, &data)) {
+    AERROR << "Read chunk body section fail, chunk: " << index;
+    return false;
+  }
+  if (header_.compress() == CompressType::COMPRESS_NONE) {
+    if (!body->ParseFromArray(data, static_cast<int>(section.size))) {
+      AERROR << "Parse chunk body failed, chunk: " << index;
+      return false;
+    }
+    return true;
+  }
+  std::string raw;
+  if (!DecompressChunkBody(header_.compress(), data,
+                           static_cast<size_t>(section.size), &raw) ||
+      !body->ParseFromString(raw)) {
+    AERROR << "Decompress chunk body failed, chunk: " << index;
+    return false;
+  }
+  return true;
+}
+
+void RecordFileMmapReader::WillNeedChunk(size_t index) const {
+  Section section;
+  const char* data = nullptr;
+  if (index >= chunks_.size() ||
+      !ReadSection(chunks_[index].position, SectionType::SECTION_CHUNK_BODY,
+                   &section, &data)) {
+    return;
+  }
+  // madvise wants a page aligned start
+  static const uintptr_t kPageSize = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(kPageSize - 1);
+  uintptr_t end = reinterpret_cast<uintptr_t>(data) + section.size;
+  madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_RECORD_FILE_MMAP_READER_H_
+#define CYBER_RECORD_FILE_RECORD_FILE_MMAP_READER_H_
+
+#include <string>
+#include <vector>
+
+#include "cyber/record/file/record_file_base.h"
+#include "cyber/record/file/section.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+// Maps a complete record file and reads chunks straight from the index,
+// so finding the chunk of a timestamp is a binary search instead of a scan
+// over every section before it. Open fails on files without an index, use
+// RecordFileReader to read those section by section.
+class RecordFileMmapReader : public RecordFileBase {
+ public:
+  RecordFileMmapReader() { fd_ = -1; }
+  virtual ~RecordFileMmapReader();
+  bool Open(const std::string& path) override;
+  void Close() override;
+
+  size_t ChunkNumber() const { return chunks_.size(); }
+  uint64_t ChunkBeginTime(size_t index) const {
+    return chunks_[index].begin_time;
+  }
+  uint64_t ChunkEndTime(size_t index) const { return chunks_[index].end_time; }
+
+  // names of the channel sections in index order
+  const std::vector<std::string>& ChannelNames() const {
+    return channel_names_;
+  }
+  // whether chunk holds a channel i with wanted[i] set, always true when the
+  // file does not list the channels of its chunks
+  bool ChunkHasChannel(size_t index, const std::vector<bool>& wanted) const;
+
+  // first chunk that may hold a message at or after begin_time, all chunks
+  // before it end earlier, ChunkNumber() if there is none
+  size_t FindChunk(uint64_t begin_time) const;
+  bool ReadChunk(size_t index, ChunkBody* body) const;
+  // asks the kernel to read the chunk in ahead of ReadChunk
+  void WillNeedChunk(size_t index) const;
+
+ private:
+  struct ChunkEntry {
+    uint64_t begin_time;
+    uint64_t end_time;
+    // largest end_time of this and all earlier chunks, sorted
+    uint64_t max_end_time;
+    // where the chunk body section starts
+    uint64_t position;
+    const ChunkHeaderCache* cache;
+  };
+
+  bool ReadSection(uint64_t position, SectionType type, Section* section,
+                   const char** data) const;
+  bool ReadHeader();
+  bool ReadIndex();
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<ChunkEntry> chunks_;
+  std::vector<std::string> channel_names_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_RECORD_FILE_MMAP_READER_H_
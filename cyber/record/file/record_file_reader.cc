@@ -17,6 +17,7 @@
 #include "cyber/record/file/record_file_reader.h"
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 
 namespace apollo {
 namespace cyber {
@@ -130,6 +131,37 @@ bool RecordFileReader::ReadSection(Section* section) {
   return true;
 }
 
+bool RecordFileReader::ReadCompressedSection(
+    int64_t size, google::protobuf::Message* message) {
+  std::string compressed(static_cast<size_t>(size), '\0');
+  size_t offset = 0;
+  while (offset < compressed.size()) {
+    ssize_t count =
+        read(fd_, &compressed[offset], compressed.size() - offset);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      AERROR << "Read compressed section failed, expect: " << size
+             << ", actual: " << offset << ", errno: " << errno;
+      end_of_file_ = count == 0;
+      return false;
+    }
+    offset += count;
+  }
+  std::string raw;
+  if (!DecompressChunkBody(header_.compress(), compressed.data(),
+                           compressed.size(), &raw)) {
+    AERROR << "Decompress section failed, file: " << path_;
+    return false;
+  }
+  if (!message->ParseFromString(raw)) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
 bool RecordFileReader::SkipSection(int64_t size) {
   int64_t pos = CurrentPosition();
   if (size > INT64_MAX - pos) {
@@ -212,6 +212,129 @@ TEST(RecordFileTest, TestOneChunkFile) {
   ASSERT_EQ(3, rfw->GetHeader().message_number());
 }
 
+TEST(RecordFileTest, TestCompressedChunks) {
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    RecordFileWriter* rfw = new RecordFileWriter();
+    ASSERT_TRUE(rfw->Open(TEST_FILE));
+
+    // a new chunk every 5 messages
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 50);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+    ASSERT_TRUE(rfw->WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(CHAN_1);
+    chan1.set_message_type(MSG_TYPE);
+    chan1.set_proto_desc(STR_10B);
+    ASSERT_TRUE(rfw->WriteChannel(chan1));
+
+    const int message_num = 100;
+    for (int i = 0; i < message_num; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(std::string(STR_10B) + std::to_string(i));
+      msg.set_time((i + 1) * 1e9);
+      ASSERT_TRUE(rfw->WriteMessage(msg));
+    }
+    rfw->Close();
+    ASSERT_EQ(20, rfw->GetHeader().chunk_number());
+    ASSERT_EQ(message_num, rfw->GetHeader().message_number());
+    delete rfw;
+
+    RecordFileReader* rfr = new RecordFileReader();
+    ASSERT_TRUE(rfr->Open(TEST_FILE));
+    ASSERT_EQ(type, rfr->GetHeader().compress());
+    int index = 0;
+    Section sec;
+    while (rfr->ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr->SkipSection(sec.size));
+        continue;
+      }
+      ChunkBody body;
+      ASSERT_TRUE(rfr->ReadSection<ChunkBody>(sec.size, &body));
+      for (auto& msg : body.messages()) {
+        ASSERT_EQ(std::string(STR_10B) + std::to_string(index), msg.content());
+        ++index;
+      }
+    }
+    ASSERT_EQ(message_num, index);
+    delete rfr;
+  }
+}
+
+TEST(RecordFileTest, TestWriterOptions) {
+  for (auto policy : {SyncPolicy::NONE, SyncPolicy::WRITEBACK,
+                      SyncPolicy::EVERY_CHUNK}) {
+    RecordFileWriter* rfw = new RecordFileWriter();
+    WriterOptions options;
+    options.max_pending_chunk_num = 1;
+    options.non_blocking = true;
+    options.sync_policy = policy;
+    rfw->SetOptions(options);
+    ASSERT_TRUE(rfw->Open(TEST_FILE));
+
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 50);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw->WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(CHAN_1);
+    chan1.set_message_type(MSG_TYPE);
+    chan1.set_proto_desc(STR_10B);
+    ASSERT_TRUE(rfw->WriteChannel(chan1));
+
+    // a busy flush thread makes chunks grow instead of blocking
+    const int message_num = 100;
+    for (int i = 0; i < message_num; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(std::string(STR_10B) + std::to_string(i));
+      msg.set_time((i + 1) * 1e9);
+      ASSERT_TRUE(rfw->WriteMessage(msg));
+    }
+    rfw->Close();
+    auto stats = rfw->GetStats();
+    ASSERT_EQ(0, stats.pending_chunk_num);
+    ASSERT_EQ(0, stats.pending_raw_size);
+    ASSERT_EQ(1, stats.max_pending_chunk_num);
+    ASSERT_EQ(rfw->GetHeader().chunk_number(), stats.written_chunk_num);
+    ASSERT_LE(stats.written_chunk_num + stats.deferred_chunk_num, 20);
+    ASSERT_GE(stats.max_write_latency_ns, stats.last_write_latency_ns);
+    ASSERT_EQ(message_num, rfw->GetHeader().message_number());
+    delete rfw;
+
+    RecordFileReader* rfr = new RecordFileReader();
+    ASSERT_TRUE(rfr->Open(TEST_FILE));
+    ASSERT_TRUE(rfr->GetHeader().is_complete());
+    int index = 0;
+    Section sec;
+    while (rfr->ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr->SkipSection(sec.size));
+        continue;
+      }
+      ChunkBody body;
+      ASSERT_TRUE(rfr->ReadSection<ChunkBody>(sec.size, &body));
+      for (auto& msg : body.messages()) {
+        ASSERT_EQ(std::string(STR_10B) + std::to_string(index), msg.content());
+        ++index;
+      }
+    }
+    ASSERT_EQ(message_num, index);
+    delete rfr;
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -17,14 +17,22 @@
 #include "cyber/record/file/record_file_writer.h"
 
 #include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+namespace {
+const size_t kCompressThreadNum = 2;
+}  // namespace
+
 RecordFileWriter::RecordFileWriter() {}
 
 RecordFileWriter::~RecordFileWriter() { Close(); }
@@ -43,7 +51,8 @@ bool RecordFileWriter::Open(const std::string& path) {
     return false;
   }
   chunk_active_.reset(new Chunk());
-  chunk_flush_.reset(new Chunk());
+  writeback_begin_ = 0;
+  writeback_end_ = 0;
   is_writing_ = true;
   flush_thread_ = std::make_shared<std::thread>([this]() { this->Flush(); });
   if (flush_thread_ == nullptr) {
@@ -55,29 +64,18 @@ bool RecordFileWriter::Open(const std::string& path) {
 
 void RecordFileWriter::Close() {
   if (is_writing_) {
-    // wait for the flush operation that may exist now
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    // last swap
+    // the flush thread writes everything queued before it quits
+    PushChunk(true);
     {
-      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-      chunk_flush_.swap(chunk_active_);
-      flush_cv_.notify_one();
+      std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+      is_writing_ = false;
     }
-
-    // wait for the last flush opertation
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    is_writing_ = false;
     flush_cv_.notify_all();
     if (flush_thread_ && flush_thread_->joinable()) {
       flush_thread_->join();
       flush_thread_ = nullptr;
     }
+    compress_pool_.reset();
 
     if (!WriteIndex()) {
       AERROR << "Write index section failed, file: " << path_;
@@ -87,6 +85,9 @@ void RecordFileWriter::Close() {
     if (!WriteHeader(header_)) {
       AERROR << "Overwrite header section failed, file: " << path_;
     }
+    if (options_.sync_policy != SyncPolicy::NONE && fsync(fd_) < 0) {
+      AERROR << "Sync file failed, file: " << path_ << ", errno: " << errno;
+    }
 
     if (close(fd_) < 0) {
       AERROR << "Close file failed, file: " << path_ << ", fd: " << fd_
@@ -99,6 +100,15 @@ void RecordFileWriter::Close() {
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
   header_ = header;
+  if (!IsCompressSupported(header_.compress())) {
+    AERROR << "Unsupported compress type: " << header_.compress()
+           << ", write chunks uncompressed.";
+    header_.set_compress(CompressType::COMPRESS_NONE);
+  }
+  if (header_.compress() != CompressType::COMPRESS_NONE &&
+      compress_pool_ == nullptr) {
+    compress_pool_.reset(new base::WorkStealingPool(kCompressThreadNum));
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -133,6 +143,8 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
     AERROR << "Write section fail";
     return false;
   }
+  channel_index_map_.emplace(channel.name(),
+                            static_cast<uint32_t>(header_.channel_number()));
   header_.set_channel_number(header_.channel_number() + 1);
   SingleIndex* single_index = index_.add_indexes();
   single_index->set_type(SectionType::SECTION_CHANNEL);
@@ -146,8 +158,33 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
   return true;
 }
 
+bool RecordFileWriter::WriteSection(SectionType type,
+                                    const std::string& data) {
+  Section section = {type, static_cast<int64_t>(data.size())};
+  ssize_t count = write(fd_, &section, sizeof(section));
+  if (count != sizeof(section)) {
+    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+    return false;
+  }
+  size_t written = 0;
+  while (written < data.size()) {
+    count = write(fd_, data.data() + written, data.size() - written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    written += count;
+  }
+  header_.set_size(CurrentPosition());
+  return true;
+}
+
 bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
-                                  const ChunkBody& chunk_body) {
+                                  const ChunkBody& chunk_body,
+                                  const std::string* compressed_body) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (!WriteSection<ChunkHeader>(chunk_header)) {
     AERROR << "Write chunk header fail";
@@ -161,8 +198,27 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   chunk_header_cache->set_end_time(chunk_header.end_time());
   chunk_header_cache->set_message_number(chunk_header.message_number());
   chunk_header_cache->set_raw_size(chunk_header.raw_size());
+  std::vector<bool> has_channel(channel_index_map_.size(), false);
+  bool all_known = true;
+  for (const auto& message : chunk_body.messages()) {
+    auto it = channel_index_map_.find(message.channel_name());
+    if (it == channel_index_map_.end()) {
+      all_known = false;
+      break;
+    }
+    has_channel[it->second] = true;
+  }
+  for (uint32_t i = 0; all_known && i < has_channel.size(); ++i) {
+    if (has_channel[i]) {
+      chunk_header_cache->add_channel_index(i);
+    }
+  }
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
-  if (!WriteSection<ChunkBody>(chunk_body)) {
+  bool body_written =
+      compressed_body == nullptr
+          ? WriteSection<ChunkBody>(chunk_body)
+          : WriteSection(SectionType::SECTION_CHUNK_BODY, *compressed_body);
+  if (!body_written) {
     AERROR << "Write chunk body fail";
     return false;
   }
@@ -184,6 +240,7 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
 
 bool RecordFileWriter::WriteMessage(const SingleMessage& message) {
   chunk_active_->add(message);
+  active_raw_size_.store(chunk_active_->header_.raw_size());
   auto it = channel_message_number_map_.find(message.channel_name());
   if (it != channel_message_number_map_.end()) {
     it->second++;
@@ -204,31 +261,147 @@ bool RecordFileWriter::WriteMessage(const SingleMessage& message) {
   if (!need_flush) {
     return true;
   }
+  PushChunk(!options_.non_blocking);
+  return true;
+}
+
+bool RecordFileWriter::PushChunk(bool wait) {
+  if (chunk_active_->empty()) {
+    return true;
+  }
+  const size_t max_num = std::max<size_t>(options_.max_pending_chunk_num, 1);
   {
+    // the flush thread only takes chunks, so there is still room below
     std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    chunk_flush_.swap(chunk_active_);
-    flush_cv_.notify_one();
+    if (!wait && chunk_queue_.size() >= max_num) {
+      if (!is_chunk_deferred_) {
+        is_chunk_deferred_ = true;
+        ++stats_.deferred_chunk_num;
+      }
+      return false;
+    }
+    push_cv_.wait(flush_lock,
+                  [this, max_num] { return chunk_queue_.size() < max_num; });
+  }
+  is_chunk_deferred_ = false;
+  PendingChunk pending;
+  pending.chunk = std::move(chunk_active_);
+  chunk_active_.reset(new Chunk());
+  active_raw_size_.store(0);
+  if (compress_pool_ != nullptr) {
+    Chunk* chunk = pending.chunk.get();
+    CompressType type = header_.compress();
+    pending.body = compress_pool_->Enqueue([chunk, type]() {
+      std::string raw;
+      std::string compressed;
+      chunk->body_.SerializeToString(&raw);
+      if (!CompressChunkBody(type, raw, &compressed)) {
+        compressed.clear();
+      }
+      return compressed;
+    });
+  }
+  {
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    stats_.pending_raw_size += pending.chunk->header_.raw_size();
+    chunk_queue_.emplace_back(std::move(pending));
+    stats_.pending_chunk_num = chunk_queue_.size();
+    stats_.max_pending_chunk_num =
+        std::max(stats_.max_pending_chunk_num, stats_.pending_chunk_num);
   }
+  flush_cv_.notify_one();
   return true;
 }
 
 void RecordFileWriter::Flush() {
-  while (is_writing_) {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    flush_cv_.wait(flush_lock,
-                   [this] { return !chunk_flush_->empty() || !is_writing_; });
-    if (!is_writing_) {
-      break;
+  while (true) {
+    PendingChunk pending;
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      flush_cv_.wait(flush_lock,
+                     [this] { return !chunk_queue_.empty() || !is_writing_; });
+      if (chunk_queue_.empty()) {
+        break;
+      }
+      pending = std::move(chunk_queue_.front());
+      chunk_queue_.pop_front();
+      stats_.pending_chunk_num = chunk_queue_.size();
     }
-    if (chunk_flush_->empty()) {
-      continue;
+    push_cv_.notify_one();
+
+    // in file order, the pool may already be done with the next ones
+    std::string compressed;
+    bool is_compressed = pending.body.valid();
+    if (is_compressed) {
+      compressed = pending.body.get();
     }
-    if (!WriteChunk(chunk_flush_->header_, chunk_flush_->body_)) {
+    bool is_written = false;
+    uint64_t start_ns = Time::MonoTime().ToNanosecond();
+    if (is_compressed && compressed.empty()) {
+      AERROR << "Compress chunk fail, drop "
+             << pending.chunk->header_.message_number() << " messages.";
+    } else if (!WriteChunk(pending.chunk->header_, pending.chunk->body_,
+                           is_compressed ? &compressed : nullptr)) {
       AERROR << "Write chunk fail.";
+    } else {
+      int64_t end_position = 0;
+      {
+        // WriteChannel may have appended a section meanwhile
+        std::lock_guard<std::mutex> lock(mutex_);
+        end_position = CurrentPosition();
+      }
+      SyncChunk(end_position);
+      is_written = true;
+    }
+    uint64_t latency_ns = Time::MonoTime().ToNanosecond() - start_ns;
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    stats_.pending_raw_size -= pending.chunk->header_.raw_size();
+    if (is_written) {
+      ++stats_.written_chunk_num;
+      stats_.last_write_latency_ns = latency_ns;
+      stats_.max_write_latency_ns =
+          std::max(stats_.max_write_latency_ns, latency_ns);
     }
-    chunk_flush_->clear();
   }
-  return;
+}
+
+void RecordFileWriter::SyncChunk(int64_t end_position) {
+  if (options_.sync_policy == SyncPolicy::EVERY_CHUNK) {
+    if (fdatasync(fd_) < 0) {
+      AERROR << "Sync file failed, file: " << path_ << ", errno: " << errno;
+    }
+    return;
+  }
+  if (options_.sync_policy != SyncPolicy::WRITEBACK ||
+      end_position <= writeback_end_) {
+    return;
+  }
+  sync_file_range(fd_, writeback_end_, end_position - writeback_end_,
+                  SYNC_FILE_RANGE_WRITE);
+  // the previous chunk had a whole chunk of time to reach the disk
+  if (writeback_end_ > writeback_begin_) {
+    off_t size = writeback_end_ - writeback_begin_;
+    if (sync_file_range(fd_, writeback_begin_, size,
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                            SYNC_FILE_RANGE_WAIT_AFTER) < 0) {
+      AERROR << "Sync file range failed, file: " << path_
+             << ", errno: " << errno;
+    }
+    posix_fadvise(fd_, writeback_begin_, size, POSIX_FADV_DONTNEED);
+  }
+  writeback_begin_ = writeback_end_;
+  writeback_end_ = end_position;
+}
+
+void RecordFileWriter::SetOptions(const WriterOptions& options) {
+  options_ = options;
+}
+
+WriterStats RecordFileWriter::GetStats() const {
+  std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+  WriterStats stats = stats_;
+  stats.pending_raw_size += active_raw_size_.load();
+  return stats;
 }
 
 uint64_t RecordFileWriter::GetMessageNumber(
@@ -20,8 +20,11 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/text_format.h>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -29,6 +32,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "cyber/base/work_stealing_pool.h"
 #include "cyber/common/log.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
@@ -76,6 +80,42 @@ struct Chunk {
   ChunkBody body_;
 };
 
+// When the flush thread hands written chunks over to the disk.
+enum class SyncPolicy {
+  // leave it to the page cache
+  NONE,
+  // fsync once the file is complete
+  ON_CLOSE,
+  // start the writeback of every chunk right after writing it and drop the
+  // previous one from the page cache, so dirty pages never pile up into a
+  // long stall, fsync on close
+  WRITEBACK,
+  // fdatasync every chunk
+  EVERY_CHUNK,
+};
+
+struct WriterOptions {
+  // full chunks queued for the flush thread
+  size_t max_pending_chunk_num = 2;
+  // with a full queue the active chunk keeps growing instead of
+  // WriteMessage waiting for the disk
+  bool non_blocking = false;
+  SyncPolicy sync_policy = SyncPolicy::NONE;
+};
+
+struct WriterStats {
+  uint64_t pending_chunk_num = 0;
+  uint64_t max_pending_chunk_num = 0;
+  // full chunks that kept growing because the queue was full
+  uint64_t deferred_chunk_num = 0;
+  uint64_t written_chunk_num = 0;
+  // raw size of the messages not written yet
+  uint64_t pending_raw_size = 0;
+  // writing and syncing one chunk
+  uint64_t last_write_latency_ns = 0;
+  uint64_t max_write_latency_ns = 0;
+};
+
 class RecordFileWriter : public RecordFileBase {
  public:
   RecordFileWriter();
@@ -86,20 +126,48 @@ class RecordFileWriter : public RecordFileBase {
   bool WriteChannel(const Channel& channel);
   bool WriteMessage(const SingleMessage& message);
   uint64_t GetMessageNumber(const std::string& channel_name) const;
+  // call before Open
+  void SetOptions(const WriterOptions& options);
+  WriterStats GetStats() const;
 
  private:
-  bool WriteChunk(const ChunkHeader& chunk_header, const ChunkBody& chunk_body);
+  // a full chunk waiting for the flush thread, body is the compressed chunk
+  // body once the compress pool got to it and invalid without compression
+  struct PendingChunk {
+    std::unique_ptr<Chunk> chunk;
+    std::future<std::string> body;
+  };
+
+  bool WriteChunk(const ChunkHeader& chunk_header, const ChunkBody& chunk_body,
+                  const std::string* compressed_body);
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteSection(SectionType type, const std::string& data);
   bool WriteIndex();
+  bool PushChunk(bool wait);
   void Flush();
+  void SyncChunk(int64_t end_position);
   bool is_writing_ = false;
   std::unique_ptr<Chunk> chunk_active_ = nullptr;
-  std::unique_ptr<Chunk> chunk_flush_ = nullptr;
+  std::deque<PendingChunk> chunk_queue_;
+  // compresses chunk N while chunk N+1 fills, only with a compress type
+  std::unique_ptr<base::WorkStealingPool> compress_pool_ = nullptr;
   std::shared_ptr<std::thread> flush_thread_ = nullptr;
-  std::mutex flush_mutex_;
+  mutable std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
+  std::condition_variable push_cv_;
+  WriterOptions options_;
+  // guarded by flush_mutex_
+  WriterStats stats_;
+  bool is_chunk_deferred_ = false;
+  // raw size of chunk_active_, read by GetStats
+  std::atomic<uint64_t> active_raw_size_ = {0};
+  // the chunk written back last, flush thread only
+  int64_t writeback_begin_ = 0;
+  int64_t writeback_end_ = 0;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
+  // order of the channel sections, for the channel list of every chunk
+  std::unordered_map<std::string, uint32_t> channel_index_map_;
 };
 
 template <typename T>
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/record/record_catalog.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/record/file/record_file_reader.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using proto::RecordCatalogEntry;
+using proto::SectionType;
+
+bool RecordCatalog::AddFile(const std::string& path) {
+  RecordFileReader reader;
+  if (!reader.Open(path)) {
+    AERROR << "Open record file failed, file: " << path;
+    return false;
+  }
+  if (!reader.ReadIndex()) {
+    AERROR << "Read index failed, file: " << path;
+    reader.Close();
+    return false;
+  }
+  auto entry = catalog_.add_records();
+  entry->set_path(path);
+  entry->mutable_header()->CopyFrom(reader.GetHeader());
+  entry->mutable_index()->CopyFrom(reader.GetIndex());
+  reader.Close();
+  return true;
+}
+
+bool RecordCatalog::Load(const std::string& catalog_file) {
+  catalog_.Clear();
+  if (!common::GetProtoFromBinaryFile(catalog_file, &catalog_)) {
+    AERROR << "Load record catalog failed, file: " << catalog_file;
+    return false;
+  }
+  return true;
+}
+
+bool RecordCatalog::Save(const std::string& catalog_file) const {
+  if (!common::SetProtoToBinaryFile(catalog_, catalog_file)) {
+    AERROR << "Save record catalog failed, file: " << catalog_file;
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> RecordCatalog::Query(
+    uint64_t begin_time, uint64_t end_time,
+    const std::set<std::string>& channels) const {
+  std::vector<const RecordCatalogEntry*> entries;
+  for (const auto& entry : catalog_.records()) {
+    if (HasMessages(entry, begin_time, end_time, channels)) {
+      entries.push_back(&entry);
+    }
+  }
+  std::stable_sort(
+      entries.begin(), entries.end(),
+      [](const RecordCatalogEntry* lhs, const RecordCatalogEntry* rhs) {
+        return lhs->header().begin_time() < rhs->header().begin_time();
+      });
+  std::vector<std::string> paths;
+  for (const auto* entry : entries) {
+    paths.push_back(entry->path());
+  }
+  return paths;
+}
+
+bool RecordCatalog::HasMessages(const RecordCatalogEntry& entry,
+                                uint64_t begin_time, uint64_t end_time,
+                                const std::set<std::string>& channels) {
+  const auto& header = entry.header();
+  if (begin_time > header.end_time() || end_time < header.begin_time()) {
+    return false;
+  }
+  // channels by the order of their channel sections in the index
+  std::vector<bool> wanted_channels;
+  bool has_wanted_channel = channels.empty();
+  for (const auto& single_idx : entry.index().indexes()) {
+    if (single_idx.type() == SectionType::SECTION_CHANNEL) {
+      const bool wanted = channels.empty() ||
+                          channels.count(single_idx.channel_cache().name()) > 0;
+      wanted_channels.push_back(wanted);
+      has_wanted_channel = has_wanted_channel || wanted;
+    }
+  }
+  if (!has_wanted_channel) {
+    return false;
+  }
+  for (const auto& single_idx : entry.index().indexes()) {
+    if (single_idx.type() != SectionType::SECTION_CHUNK_HEADER) {
+      continue;
+    }
+    const auto& cache = single_idx.chunk_header_cache();
+    if (cache.end_time() < begin_time || cache.begin_time() > end_time) {
+      continue;
+    }
+    // older files do not list the channels of their chunks
+    if (channels.empty() || cache.channel_index_size() == 0) {
+      return true;
+    }
+    for (const uint32_t channel_index : cache.channel_index()) {
+      if (channel_index < wanted_channels.size() &&
+          wanted_channels[channel_index]) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
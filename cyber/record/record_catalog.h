@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_RECORD_RECORD_CATALOG_H_
+#define CYBER_RECORD_RECORD_CATALOG_H_
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+// Keeps the headers and indexes of many record files in one file, so that a
+// job over an archive finds the files with messages of some channels in a
+// time range without opening every record file. The index of each file
+// lists the time range, position and channels of its chunks and the message
+// types and proto descriptors of its channels.
+class RecordCatalog {
+ public:
+  RecordCatalog() = default;
+
+  // Adds a complete record file, false if its index cannot be read.
+  bool AddFile(const std::string& path);
+
+  bool Load(const std::string& catalog_file);
+  bool Save(const std::string& catalog_file) const;
+
+  // Paths of the files with a chunk in [begin_time, end_time] that holds
+  // any of the channels, by begin time. Empty channels match all of them.
+  std::vector<std::string> Query(
+      uint64_t begin_time, uint64_t end_time,
+      const std::set<std::string>& channels = std::set<std::string>()) const;
+
+  const proto::RecordCatalog& catalog() const { return catalog_; }
+
+ private:
+  static bool HasMessages(const proto::RecordCatalogEntry& entry,
+                          uint64_t begin_time, uint64_t end_time,
+                          const std::set<std::string>& channels);
+
+  proto::RecordCatalog catalog_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_RECORD_CATALOG_H_
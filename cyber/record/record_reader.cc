@@ -16,6 +16,7 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace apollo {
@@ -24,18 +25,34 @@ namespace record {
 
 using proto::SectionType;
 
+namespace {
+constexpr size_t kPrefetchThreadNum = 2;
+}  // namespace
+
 RecordReader::~RecordReader() {}
 
 RecordReader::RecordReader(const std::string& file) {
-  file_reader_.reset(new RecordFileReader());
-  if (!file_reader_->Open(file)) {
-    AERROR << "Open record file failed, file: " << file;
-    return;
+  mmap_reader_.reset(new RecordFileMmapReader());
+  bool has_index = mmap_reader_->Open(file);
+  if (has_index) {
+    header_ = mmap_reader_->GetHeader();
+    index_ = mmap_reader_->GetIndex();
+  } else {
+    mmap_reader_.reset();
+    file_reader_.reset(new RecordFileReader());
+    if (!file_reader_->Open(file)) {
+      AERROR << "Open record file failed, file: " << file;
+      return;
+    }
+    header_ = file_reader_->GetHeader();
+    has_index = file_reader_->ReadIndex();
+    if (has_index) {
+      index_ = file_reader_->GetIndex();
+    }
+    file_reader_->Reset();
   }
   is_valid_ = true;
-  header_ = file_reader_->GetHeader();
-  if (file_reader_->ReadIndex()) {
-    index_ = file_reader_->GetIndex();
+  if (has_index) {
     const int kIndexSize = index_.indexes_size();
     for (int i = 0; i < kIndexSize; ++i) {
       auto single_idx = index_.mutable_indexes(i);
@@ -51,16 +68,63 @@ RecordReader::RecordReader(const std::string& file) {
           std::make_pair(channel_cache->name(), *channel_cache));
     }
   }
-  file_reader_->Reset();
 }
 
 void RecordReader::Reset() {
-  file_reader_->Reset();
+  if (file_reader_ != nullptr) {
+    file_reader_->Reset();
+  }
+  chunk_index_ = 0;
+  prefetch_queue_.clear();
   reach_end_ = false;
   message_index_ = 0;
   chunk_ = ChunkBody();
 }
 
+void RecordReader::SetChannelFilter(const std::set<std::string>& channels) {
+  channel_filter_ = channels;
+  wanted_channels_.clear();
+  prefetch_queue_.clear();
+  if (mmap_reader_ == nullptr || channels.empty()) {
+    return;
+  }
+  for (const auto& name : mmap_reader_->ChannelNames()) {
+    wanted_channels_.push_back(channels.count(name) > 0);
+  }
+}
+
+void RecordReader::SetPrefetchChunkNum(uint32_t num) {
+  prefetch_queue_.clear();
+  prefetch_chunk_num_ = num;
+  if (mmap_reader_ == nullptr || num == 0) {
+    prefetch_pool_.reset();
+    return;
+  }
+  if (prefetch_pool_ == nullptr) {
+    prefetch_pool_.reset(new base::WorkStealingPool(kPrefetchThreadNum));
+  }
+}
+
+void RecordReader::Prefetch(uint64_t begin_time, uint64_t end_time) {
+  if (!is_valid_ || mmap_reader_ == nullptr) {
+    return;
+  }
+  size_t index = std::max(chunk_index_, mmap_reader_->FindChunk(begin_time));
+  while (index < mmap_reader_->ChunkNumber() &&
+         mmap_reader_->ChunkBeginTime(index) <= end_time) {
+    if (!IsChunkWanted(index, begin_time)) {
+      ++index;
+      continue;
+    }
+    if (prefetch_pool_ != nullptr) {
+      QueueChunks(index, begin_time, end_time);
+    } else {
+      mmap_reader_->WillNeedChunk(index);
+    }
+    return;
+  }
+}
+
 std::set<std::string> RecordReader::GetChannelList() const {
   std::set<std::string> channel_list;
   for (auto& item : channel_info_) {
@@ -80,8 +144,8 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   }
 
   while (message_index_ < chunk_.messages_size()) {
-    const auto& next_message = chunk_.messages(message_index_);
-    uint64_t time = next_message.time();
+    auto next_message = chunk_.mutable_messages(message_index_);
+    uint64_t time = next_message->time();
     if (time > end_time) {
       return false;
     }
@@ -89,9 +153,14 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     if (time < begin_time) {
       continue;
     }
+    if (!channel_filter_.empty() &&
+        channel_filter_.count(next_message->channel_name()) == 0) {
+      continue;
+    }
 
-    message->channel_name = next_message.channel_name();
-    message->content = next_message.content();
+    message->channel_name = next_message->channel_name();
+    // every message is returned once per chunk read
+    message->content = std::move(*next_message->mutable_content());
     message->time = time;
     return true;
   }
@@ -106,7 +175,91 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   return false;
 }
 
+bool RecordReader::ReadNextIndexedChunk(uint64_t begin_time,
+                                        uint64_t end_time) {
+  // every chunk before the one found ends before begin_time
+  chunk_index_ = std::max(chunk_index_, mmap_reader_->FindChunk(begin_time));
+  while (chunk_index_ < mmap_reader_->ChunkNumber()) {
+    size_t index = chunk_index_;
+    if (mmap_reader_->ChunkBeginTime(index) > end_time) {
+      return false;
+    }
+    ++chunk_index_;
+    if (IsChunkWanted(index, begin_time)) {
+      return LoadChunk(index, begin_time, end_time);
+    }
+  }
+  return false;
+}
+
+bool RecordReader::IsChunkWanted(size_t index, uint64_t begin_time) const {
+  if (mmap_reader_->ChunkEndTime(index) < begin_time) {
+    return false;
+  }
+  return wanted_channels_.empty() ||
+         mmap_reader_->ChunkHasChannel(index, wanted_channels_);
+}
+
+void RecordReader::QueueChunks(size_t index, uint64_t begin_time,
+                               uint64_t end_time) {
+  while (!prefetch_queue_.empty() && prefetch_queue_.front().index < index) {
+    prefetch_queue_.pop_front();
+  }
+  // queued for other times or channels
+  if (prefetch_queue_.empty() || prefetch_queue_.front().index != index) {
+    prefetch_queue_.clear();
+    prefetch_index_ = index;
+  }
+  RecordFileMmapReader* reader = mmap_reader_.get();
+  while (prefetch_queue_.size() <= prefetch_chunk_num_ &&
+         prefetch_index_ < reader->ChunkNumber() &&
+         reader->ChunkBeginTime(prefetch_index_) <= end_time) {
+    size_t next = prefetch_index_++;
+    if (!IsChunkWanted(next, begin_time)) {
+      continue;
+    }
+    PrefetchedChunk prefetched;
+    prefetched.index = next;
+    prefetched.body = prefetch_pool_->Enqueue([reader, next]() {
+      auto chunk = std::make_shared<ChunkBody>();
+      if (!reader->ReadChunk(next, chunk.get())) {
+        chunk.reset();
+      }
+      return chunk;
+    });
+    prefetch_queue_.emplace_back(std::move(prefetched));
+  }
+}
+
+bool RecordReader::LoadChunk(size_t index, uint64_t begin_time,
+                             uint64_t end_time) {
+  if (prefetch_pool_ != nullptr) {
+    QueueChunks(index, begin_time, end_time);
+    auto prefetched = std::move(prefetch_queue_.front());
+    prefetch_queue_.pop_front();
+    if (prefetched.body.valid()) {
+      auto body = prefetched.body.get();
+      if (body == nullptr) {
+        AERROR << "Failed to read chunk " << index
+               << ", file: " << mmap_reader_->GetPath();
+        return false;
+      }
+      chunk_.Swap(body.get());
+      return true;
+    }
+  }
+  if (!mmap_reader_->ReadChunk(index, &chunk_)) {
+    AERROR << "Failed to read chunk " << index
+           << ", file: " << mmap_reader_->GetPath();
+    return false;
+  }
+  return true;
+}
+
 bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
+  if (mmap_reader_ != nullptr) {
+    return ReadNextIndexedChunk(begin_time, end_time);
+  }
   bool skip_next_chunk_body = false;
   while (!reach_end_) {
     Section section;
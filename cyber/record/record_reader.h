@@ -17,12 +17,17 @@
 #ifndef CYBER_RECORD_RECORD_READER_H_
 #define CYBER_RECORD_RECORD_READER_H_
 
+#include <deque>
+#include <future>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "cyber/base/work_stealing_pool.h"
 #include "cyber/proto/record.pb.h"
+#include "cyber/record/file/record_file_mmap_reader.h"
 #include "cyber/record/file/record_file_reader.h"
 #include "cyber/record/record_base.h"
 #include "cyber/record/record_message.h"
@@ -45,6 +50,21 @@ class RecordReader : public RecordBase {
                    uint64_t end_time = UINT64_MAX);
   void Reset();
 
+  // Only returns messages of channels, chunks of other channels are not read
+  // at all when the file lists the channels of its chunks. Empty channels
+  // turn the filter off.
+  void SetChannelFilter(const std::set<std::string>& channels);
+
+  // Reads and decompresses up to num chunks after the current one on
+  // background threads, only for files read through the index. 0 turns
+  // prefetching off.
+  void SetPrefetchChunkNum(uint32_t num);
+
+  // Starts reading the first chunk in [begin_time, end_time] before
+  // ReadMessage needs it, on the prefetch threads or else by kernel
+  // readahead.
+  void Prefetch(uint64_t begin_time, uint64_t end_time);
+
   uint64_t GetMessageNumber(const std::string& channel_name) const override;
 
   const std::string& GetMessageType(
@@ -60,6 +80,16 @@ class RecordReader : public RecordBase {
 
  private:
   bool ReadNextChunk(uint64_t begin_time, uint64_t end_time);
+  bool ReadNextIndexedChunk(uint64_t begin_time, uint64_t end_time);
+  bool IsChunkWanted(size_t index, uint64_t begin_time) const;
+  bool LoadChunk(size_t index, uint64_t begin_time, uint64_t end_time);
+  // queues up to prefetch_chunk_num_ + 1 chunks from index on
+  void QueueChunks(size_t index, uint64_t begin_time, uint64_t end_time);
+
+  struct PrefetchedChunk {
+    size_t index = 0;
+    std::future<std::shared_ptr<proto::ChunkBody>> body;
+  };
 
   bool is_valid_ = false;
   bool reach_end_ = false;
@@ -67,6 +97,18 @@ class RecordReader : public RecordBase {
   proto::Index index_;
   int message_index_ = 0;
   ChannelInfoMap channel_info_;
+  // complete files are read through the index, others section by section
+  std::unique_ptr<RecordFileMmapReader> mmap_reader_;
+  size_t chunk_index_ = 0;
+  std::set<std::string> channel_filter_;
+  // channel_filter_ by the channel order of the mmap_reader_ index
+  std::vector<bool> wanted_channels_;
+  uint32_t prefetch_chunk_num_ = 0;
+  // chunks read ahead in index order and the next index to queue
+  std::deque<PrefetchedChunk> prefetch_queue_;
+  size_t prefetch_index_ = 0;
+  // destroyed before mmap_reader_, its tasks read from it
+  std::unique_ptr<base::WorkStealingPool> prefetch_pool_;
   FileReaderPtr file_reader_;
 };
 
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include "cyber/record/record_reader.h"
+#include "cyber/record/header_builder.h"
 #include "cyber/record/record_writer.h"
 
 #include <gtest/gtest.h>
@@ -90,6 +91,132 @@ TEST(RecordTest, TestSingleRecordFile) {
   ASSERT_FALSE(reader.ReadMessage(&message, 0, MESSAGE_NUM - 2));
 }
 
+TEST(RecordTest, TestSeekByIndex) {
+  for (auto type : {CompressType::COMPRESS_NONE, CompressType::COMPRESS_LZ4}) {
+    // a new chunk about every 4 messages
+    auto header = HeaderBuilder::GetHeaderWithChunkParams(250, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+    RecordWriter writer(header);
+    writer.Open(TEST_FILE);
+    writer.WriteChannel(CHANNEL_NAME_1, MESSAGE_TYPE_1, PROTO_DESC);
+    const uint32_t message_num = 100;
+    for (uint32_t i = 0; i < message_num; ++i) {
+      auto msg = std::make_shared<RawMessage>(std::to_string(i));
+      writer.WriteMessage(CHANNEL_NAME_1, msg, i * 100);
+    }
+    writer.Close();
+
+    RecordReader reader(TEST_FILE);
+    ASSERT_TRUE(reader.IsValid());
+    ASSERT_GT(reader.header().chunk_number(), 10);
+    ASSERT_EQ(message_num, reader.GetMessageNumber(CHANNEL_NAME_1));
+
+    RecordMessage message;
+    uint32_t i = 45;
+    while (reader.ReadMessage(&message, 45 * 100)) {
+      ASSERT_EQ(std::to_string(i), message.content);
+      ASSERT_EQ(i * 100, message.time);
+      ++i;
+    }
+    ASSERT_EQ(message_num, i);
+
+    // a window in the middle
+    reader.Reset();
+    ASSERT_TRUE(reader.ReadMessage(&message, 70 * 100, 71 * 100));
+    ASSERT_EQ(70 * 100, message.time);
+    ASSERT_TRUE(reader.ReadMessage(&message, 70 * 100, 71 * 100));
+    ASSERT_EQ(71 * 100, message.time);
+    ASSERT_FALSE(reader.ReadMessage(&message, 70 * 100, 71 * 100));
+  }
+}
+
+TEST(RecordTest, TestChannelFilter) {
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(250, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  RecordWriter writer(header);
+  writer.Open(TEST_FILE);
+  writer.WriteChannel(CHANNEL_NAME_1, MESSAGE_TYPE_1, PROTO_DESC);
+  writer.WriteChannel(CHANNEL_NAME_2, MESSAGE_TYPE_2, PROTO_DESC);
+  // channel 2 only shows up in the second half
+  for (uint32_t i = 0; i < 100; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    writer.WriteMessage(i < 50 ? CHANNEL_NAME_1 : CHANNEL_NAME_2, msg,
+                        i * 100);
+  }
+  writer.Close();
+
+  RecordFileMmapReader file_reader;
+  ASSERT_TRUE(file_reader.Open(TEST_FILE));
+  ASSERT_FALSE(file_reader.ChunkHasChannel(0, {false, true}));
+  ASSERT_TRUE(file_reader.ChunkHasChannel(0, {true, false}));
+
+  RecordReader reader(TEST_FILE);
+  reader.SetChannelFilter({CHANNEL_NAME_2});
+  RecordMessage message;
+  uint32_t i = 50;
+  while (reader.ReadMessage(&message)) {
+    ASSERT_EQ(CHANNEL_NAME_2, message.channel_name);
+    ASSERT_EQ(std::to_string(i), message.content);
+    ++i;
+  }
+  ASSERT_EQ(100, i);
+
+  reader.SetChannelFilter({});
+  reader.Reset();
+  for (i = 0; reader.ReadMessage(&message); ++i) {
+  }
+  ASSERT_EQ(100, i);
+}
+
+TEST(RecordTest, TestPrefetchChunks) {
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(250, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  header.set_compress(CompressType::COMPRESS_LZ4);
+  RecordWriter writer(header);
+  writer.Open(TEST_FILE);
+  writer.WriteChannel(CHANNEL_NAME_1, MESSAGE_TYPE_1, PROTO_DESC);
+  writer.WriteChannel(CHANNEL_NAME_2, MESSAGE_TYPE_2, PROTO_DESC);
+  for (uint32_t i = 0; i < 200; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    writer.WriteMessage(i / 20 % 2 == 0 ? CHANNEL_NAME_1 : CHANNEL_NAME_2, msg,
+                        i * 100);
+  }
+  writer.Close();
+
+  RecordReader reader(TEST_FILE);
+  ASSERT_TRUE(reader.IsValid());
+  reader.SetPrefetchChunkNum(3);
+  RecordMessage message;
+  uint32_t i = 0;
+  for (; reader.ReadMessage(&message); ++i) {
+    ASSERT_EQ(std::to_string(i), message.content);
+  }
+  ASSERT_EQ(200, i);
+
+  // prefetched chunks skip the filtered ones
+  reader.SetChannelFilter({CHANNEL_NAME_2});
+  reader.Reset();
+  i = 0;
+  while (reader.ReadMessage(&message, 50 * 100)) {
+    ASSERT_EQ(CHANNEL_NAME_2, message.channel_name);
+    ASSERT_GE(message.time, 50 * 100);
+    ++i;
+  }
+  ASSERT_EQ(80, i);
+
+  // a later begin time drops what was read ahead for the earlier one
+  reader.SetChannelFilter({});
+  reader.Reset();
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  ASSERT_EQ("0", message.content);
+  ASSERT_TRUE(reader.ReadMessage(&message, 150 * 100));
+  ASSERT_EQ("150", message.content);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -17,6 +17,7 @@
 #include "cyber/record/record_viewer.h"
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -47,6 +48,21 @@ RecordViewer::RecordViewer(const std::vector<RecordReaderPtr>& readers,
   UpdateTime();
 }
 
+RecordViewer::RecordViewer(const RecordCatalog& catalog, uint64_t begin_time,
+                           uint64_t end_time,
+                           const std::set<std::string>& channels)
+    : RecordViewer(OpenReaders(catalog.Query(begin_time, end_time, channels)),
+                   begin_time, end_time, channels) {}
+
+std::vector<RecordViewer::RecordReaderPtr> RecordViewer::OpenReaders(
+    const std::vector<std::string>& files) {
+  std::vector<RecordReaderPtr> readers;
+  for (const auto& file : files) {
+    readers.push_back(std::make_shared<RecordReader>(file));
+  }
+  return readers;
+}
+
 bool RecordViewer::IsValid() const {
   if (begin_time_ > end_time_) {
     AERROR << "Begin time must be earlier than end time"
@@ -57,19 +73,42 @@ bool RecordViewer::IsValid() const {
 }
 
 bool RecordViewer::Update(RecordMessage* message) {
-  bool find = false;
-  while (!find) {
-    if (msg_buffer_.empty() && !FillBuffer()) {
+  // every message of a reader that has not started comes at or after its
+  // begin time
+  while (started_reader_num_ < readers_.size()) {
+    uint64_t reader_begin_time =
+        readers_[started_reader_num_]->header().begin_time();
+    if (!heap_.empty() &&
+        reader_begin_time > next_messages_[heap_.front()].time) {
       break;
     }
-    auto& msg = msg_buffer_.begin()->second;
-    if (channels_.empty() || channels_.count(msg->channel_name) == 1) {
-      *message = *msg;
-      find = true;
-    }
-    msg_buffer_.erase(msg_buffer_.begin());
+    StartReader(started_reader_num_++);
+  }
+  if (heap_.empty()) {
+    return false;
   }
-  return find;
+
+  auto later = [this](size_t lhs, size_t rhs) { return IsLater(lhs, rhs); };
+  std::pop_heap(heap_.begin(), heap_.end(), later);
+  size_t index = heap_.back();
+  *message = std::move(next_messages_[index]);
+  if (readers_[index]->ReadMessage(&next_messages_[index], begin_time_,
+                                   end_time_)) {
+    std::push_heap(heap_.begin(), heap_.end(), later);
+  } else {
+    heap_.pop_back();
+    // drops the last chunk
+    readers_[index]->Reset();
+  }
+
+  prefetched_reader_num_ =
+      std::max(prefetched_reader_num_, started_reader_num_);
+  while (prefetched_reader_num_ < readers_.size() &&
+         readers_[prefetched_reader_num_]->header().begin_time() <=
+             message->time + kStepTimeNanoSec) {
+    readers_[prefetched_reader_num_++]->Prefetch(begin_time_, end_time_);
+  }
+  return true;
 }
 
 uint64_t RecordViewer::begin_time() const { return begin_time_; }
@@ -87,12 +126,14 @@ RecordViewer::Iterator RecordViewer::end() { return Iterator(this, true); }
 void RecordViewer::Init() {
   // Init the channel list
   for (auto& reader : readers_) {
+    // readers skip the chunks without wanted channels
+    reader->SetChannelFilter(channels_);
     auto all_channel = reader->GetChannelList();
     std::set_intersection(all_channel.begin(), all_channel.end(),
                           channels_.begin(), channels_.end(),
                           std::inserter(channel_list_, channel_list_.end()));
   }
-  readers_finished_.resize(readers_.size(), false);
+  next_messages_.resize(readers_.size());
 
   // Sort the readers
   std::sort(readers_.begin(), readers_.end(),
@@ -110,9 +151,28 @@ void RecordViewer::Reset() {
   for (auto& reader : readers_) {
     reader->Reset();
   }
-  std::fill(readers_finished_.begin(), readers_finished_.end(), false);
-  curr_begin_time_ = begin_time_;
-  msg_buffer_.clear();
+  heap_.clear();
+  started_reader_num_ = 0;
+  prefetched_reader_num_ = 0;
+}
+
+void RecordViewer::StartReader(size_t index) {
+  auto& reader = readers_[index];
+  if (!reader->IsValid() ||
+      !reader->ReadMessage(&next_messages_[index], begin_time_, end_time_)) {
+    return;
+  }
+  heap_.push_back(index);
+  std::push_heap(heap_.begin(), heap_.end(),
+                 [this](size_t lhs, size_t rhs) { return IsLater(lhs, rhs); });
+}
+
+bool RecordViewer::IsLater(size_t lhs, size_t rhs) const {
+  // earlier readers first on the same time
+  if (next_messages_[lhs].time == next_messages_[rhs].time) {
+    return lhs > rhs;
+  }
+  return next_messages_[lhs].time > next_messages_[rhs].time;
 }
 
 void RecordViewer::UpdateTime() {
@@ -139,46 +199,6 @@ void RecordViewer::UpdateTime() {
   if (end_time_ > max_end_time) {
     end_time_ = max_end_time;
   }
-
-  curr_begin_time_ = begin_time_;
-}
-
-bool RecordViewer::FillBuffer() {
-  while (curr_begin_time_ <= end_time_ && msg_buffer_.size() < kBufferMinSize) {
-    uint64_t this_begin_time = curr_begin_time_;
-    uint64_t this_end_time = this_begin_time + kStepTimeNanoSec;
-    if (this_end_time > end_time_) {
-      this_end_time = end_time_;
-    }
-
-    for (size_t i = 0; i < readers_.size(); ++i) {
-      if (!readers_finished_[i] &&
-          readers_[i]->header().end_time() < this_begin_time) {
-        readers_finished_[i] = true;
-        readers_[i]->Reset();
-      }
-    }
-
-    for (size_t i = 0; i < readers_.size(); ++i) {
-      if (readers_finished_[i]) {
-        continue;
-      }
-      auto& reader = readers_[i];
-      while (true) {
-        auto record_msg = std::make_shared<RecordMessage>();
-        if (!reader->ReadMessage(record_msg.get(), this_begin_time,
-                                 this_end_time)) {
-          break;
-        }
-        msg_buffer_.emplace(std::make_pair(record_msg->time, record_msg));
-      }
-    }
-
-    // because ReadMessage of RecordReader is closed interval, so we add 1 here
-    curr_begin_time_ = this_end_time + 1;
-  }
-
-  return !msg_buffer_.empty();
 }
 
 RecordViewer::Iterator::Iterator(RecordViewer* viewer, bool end)
@@ -18,12 +18,12 @@
 #define CYBER_RECORD_RECORD_VIEWER_H_
 
 #include <cstddef>
-#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "cyber/record/record_catalog.h"
 #include "cyber/record/record_message.h"
 #include "cyber/record/record_reader.h"
 
@@ -33,16 +33,27 @@ namespace record {
 
 class RecordMessage;
 
+// Merges the messages of all readers by time with a heap over the next
+// message of every reader, each file is expected in time order as written.
+// A reader joins the merge at its begin time and is asked to prefetch
+// kStepTimeNanoSec ahead of that, so consecutive segments play without a
+// stall at the file boundary.
 class RecordViewer {
  public:
   using RecordReaderPtr = std::shared_ptr<RecordReader>;
 
+  // the readers get the channel filter of the viewer
   RecordViewer(const RecordReaderPtr& reader, uint64_t begin_time = 0,
                uint64_t end_time = UINT64_MAX,
                const std::set<std::string>& channels = std::set<std::string>());
   RecordViewer(const std::vector<RecordReaderPtr>& readers,
                uint64_t begin_time = 0, uint64_t end_time = UINT64_MAX,
                const std::set<std::string>& channels = std::set<std::string>());
+  // opens only the files of the catalog with messages of the channels in
+  // [begin_time, end_time]
+  RecordViewer(const RecordCatalog& catalog, uint64_t begin_time = 0,
+               uint64_t end_time = UINT64_MAX,
+               const std::set<std::string>& channels = std::set<std::string>());
 
   bool IsValid() const;
   bool Update(RecordMessage* message);
@@ -81,10 +92,15 @@ class RecordViewer {
  private:
   friend class Iterator;
 
+  static std::vector<RecordReaderPtr> OpenReaders(
+      const std::vector<std::string>& files);
+
   void Init();
   void Reset();
   void UpdateTime();
-  bool FillBuffer();
+  void StartReader(size_t index);
+  // whether reader lhs has a later next message than reader rhs
+  bool IsLater(size_t lhs, size_t rhs) const;
 
   uint64_t begin_time_ = 0;
   uint64_t end_time_ = UINT64_MAX;
@@ -92,14 +108,18 @@ class RecordViewer {
   std::set<std::string> channels_;
   // All channel in user defined readers
   std::set<std::string> channel_list_;
+  // sorted by begin time
   std::vector<RecordReaderPtr> readers_;
-  std::vector<bool> readers_finished_;
 
-  uint64_t curr_begin_time_ = 0;
-  std::multimap<uint64_t, std::shared_ptr<RecordMessage>> msg_buffer_;
+  // next message of every reader in the merge
+  std::vector<RecordMessage> next_messages_;
+  // min heap of readers by their next message
+  std::vector<size_t> heap_;
+  // readers before it joined the merge or were asked to prefetch
+  size_t started_reader_num_ = 0;
+  size_t prefetched_reader_num_ = 0;
 
   const uint64_t kStepTimeNanoSec = 1000000000UL;  // 1 second
-  const std::size_t kBufferMinSize = 128;
 };
 
 }  // namespace record
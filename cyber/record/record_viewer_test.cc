@@ -22,8 +22,10 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/record/header_builder.h"
 #include "cyber/record/record_reader.h"
 #include "cyber/record/record_writer.h"
 
@@ -181,6 +183,110 @@ TEST(RecordTest, mult_iterator_test) {
   EXPECT_EQ(msg_num, i);
 }
 
+TEST(RecordTest, merge_files_test) {
+  // two consecutive segments of channel 1 and one file of channel 2
+  // overlapping both
+  const std::vector<std::string> files = {"viewer_test_0.record",
+                                          "viewer_test_1.record",
+                                          "viewer_test_2.record"};
+  for (size_t f = 0; f < files.size(); ++f) {
+    const char* channel = f < 2 ? CHANNEL_NAME_1 : CHANNEL_NAME_2;
+    RecordWriter writer(HeaderBuilder::GetHeaderWithChunkParams(0, 100));
+    writer.SetSizeOfFileSegmentation(0);
+    writer.SetIntervalOfFileSegmentation(0);
+    writer.Open(files[f]);
+    writer.WriteChannel(channel, MESSAGE_TYPE_1, PROTO_DESC);
+    for (uint64_t i = 0; i < 100; ++i) {
+      uint64_t time = f < 2 ? (f * 100 + i) * 10 + 10 : i * 20 + 15;
+      auto msg = std::make_shared<RawMessage>(std::to_string(time));
+      writer.WriteMessage(channel, msg, time);
+    }
+    writer.Close();
+  }
+
+  std::vector<std::shared_ptr<RecordReader>> readers;
+  for (auto it = files.rbegin(); it != files.rend(); ++it) {
+    readers.push_back(std::make_shared<RecordReader>(*it));
+  }
+  RecordViewer viewer(readers);
+  EXPECT_EQ(10, viewer.begin_time());
+  EXPECT_EQ(2000, viewer.end_time());
+
+  uint64_t count = 0;
+  uint64_t last_time = 0;
+  for (auto& msg : viewer) {
+    EXPECT_LE(last_time, msg.time);
+    EXPECT_EQ(std::to_string(msg.time), msg.content);
+    last_time = msg.time;
+    ++count;
+  }
+  EXPECT_EQ(300, count);
+
+  RecordViewer viewer_2(readers, 0, UINT64_MAX, {CHANNEL_NAME_2});
+  EXPECT_EQ(100, CheckCount(viewer_2));
+
+  RecordViewer viewer_3(readers, 995, 1005);
+  count = 0;
+  for (auto& msg : viewer_3) {
+    EXPECT_GE(msg.time, 995);
+    EXPECT_LE(msg.time, 1005);
+    ++count;
+  }
+  EXPECT_EQ(2, count);
+}
+
+TEST(RecordTest, catalog_test) {
+  // two consecutive segments of channel 1 and one file of channel 2 in the
+  // time of the first segment
+  const std::vector<std::string> files = {"catalog_test_0.record",
+                                          "catalog_test_1.record",
+                                          "catalog_test_2.record"};
+  for (size_t f = 0; f < files.size(); ++f) {
+    const char* channel = f < 2 ? CHANNEL_NAME_1 : CHANNEL_NAME_2;
+    RecordWriter writer(HeaderBuilder::GetHeaderWithChunkParams(0, 100));
+    writer.SetSizeOfFileSegmentation(0);
+    writer.SetIntervalOfFileSegmentation(0);
+    writer.Open(files[f]);
+    writer.WriteChannel(channel, MESSAGE_TYPE_1, PROTO_DESC);
+    for (uint64_t i = 0; i < 100; ++i) {
+      uint64_t time = f < 2 ? (f * 100 + i) * 10 + 10 : i * 5 + 15;
+      auto msg = std::make_shared<RawMessage>(std::to_string(time));
+      writer.WriteMessage(channel, msg, time);
+    }
+    writer.Close();
+  }
+
+  RecordCatalog catalog;
+  for (auto it = files.rbegin(); it != files.rend(); ++it) {
+    EXPECT_TRUE(catalog.AddFile(*it));
+  }
+  EXPECT_FALSE(catalog.AddFile("catalog_test_none.record"));
+  ASSERT_TRUE(catalog.Save("catalog_test.catalog"));
+  RecordCatalog loaded;
+  ASSERT_TRUE(loaded.Load("catalog_test.catalog"));
+  EXPECT_EQ(3, loaded.catalog().records_size());
+
+  // by begin time
+  EXPECT_EQ(std::vector<std::string>({files[0], files[2], files[1]}),
+            loaded.Query(0, UINT64_MAX));
+  EXPECT_EQ(std::vector<std::string>({files[0], files[2]}),
+            loaded.Query(0, 500));
+  EXPECT_EQ(std::vector<std::string>({files[1]}), loaded.Query(1500, 1600));
+  EXPECT_EQ(std::vector<std::string>({files[0], files[1]}),
+            loaded.Query(0, UINT64_MAX, {CHANNEL_NAME_1}));
+  EXPECT_EQ(std::vector<std::string>({files[2]}),
+            loaded.Query(0, 500, {CHANNEL_NAME_2}));
+  EXPECT_TRUE(loaded.Query(1500, 1600, {CHANNEL_NAME_2}).empty());
+  EXPECT_TRUE(loaded.Query(3000, 4000).empty());
+
+  RecordViewer viewer(loaded, 1500, 1600);
+  EXPECT_EQ(11, CheckCount(viewer));
+  RecordViewer viewer_2(loaded, 0, UINT64_MAX, {CHANNEL_NAME_2});
+  EXPECT_EQ(100, CheckCount(viewer_2));
+  RecordViewer viewer_3(loaded, 3000, 4000);
+  EXPECT_EQ(0, CheckCount(viewer_3));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
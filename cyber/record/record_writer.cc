@@ -46,6 +46,7 @@ bool RecordWriter::Open(const std::string& file) {
     path_ = file_;
   }
   file_writer_.reset(new RecordFileWriter());
+  file_writer_->SetOptions(writer_options_);
   if (!file_writer_->Open(path_)) {
     AERROR << "open outfile failed. file: " << path_;
     return false;
@@ -64,6 +65,7 @@ void RecordWriter::Close() {
 
 bool RecordWriter::SplitOutfile() {
   file_writer_.reset(new RecordFileWriter());
+  file_writer_->SetOptions(writer_options_);
   if (file_index_ > 99999) {
     AWARN << "More than 9999 record files had been recored, will restart"
           << " counting from 0.";
@@ -165,6 +167,23 @@ bool RecordWriter::SetIntervalOfFileSegmentation(uint64_t time_sec) {
   return true;
 }
 
+bool RecordWriter::SetWriterOptions(const WriterOptions& options) {
+  if (is_opened_) {
+    AWARN << "please call this interface before opening file.";
+    return false;
+  }
+  writer_options_ = options;
+  return true;
+}
+
+WriterStats RecordWriter::GetWriterStats() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  if (file_writer_ == nullptr) {
+    return WriterStats();
+  }
+  return file_writer_->GetStats();
+}
+
 bool RecordWriter::IsNewChannel(const std::string& channel_name) {
   auto search = channel_message_number_map_.find(channel_name);
   if (search == channel_message_number_map_.end()) {
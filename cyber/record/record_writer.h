@@ -64,6 +64,12 @@ class RecordWriter : public RecordBase {
 
   bool SetIntervalOfFileSegmentation(uint64_t time_sec);
 
+  // queueing and syncing of the chunks of every segment
+  bool SetWriterOptions(const WriterOptions& options);
+
+  // of the segment being written
+  WriterStats GetWriterStats();
+
   uint64_t GetMessageNumber(const std::string& channel_name) const override;
 
   const std::string& GetMessageType(
@@ -85,6 +91,7 @@ class RecordWriter : public RecordBase {
   uint64_t segment_raw_size_ = 0;
   uint64_t segment_begin_time_ = 0;
   uint32_t file_index_ = 0;
+  WriterOptions writer_options_;
   MessageNumberMap channel_message_number_map_;
   MessageTypeMap channel_message_type_map_;
   MessageProtoDescMap channel_proto_desc_map_;
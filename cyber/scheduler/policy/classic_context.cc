@@ -16,6 +16,8 @@
 
 #include "cyber/scheduler/policy/classic_context.h"
 
+#include <algorithm>
+
 #include "cyber/event/perf_event_cache.h"
 
 namespace apollo {
@@ -24,6 +26,7 @@ namespace scheduler {
 
 using apollo::cyber::base::AtomicRWLock;
 using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
 using apollo::cyber::croutine::CRoutine;
 using apollo::cyber::croutine::RoutineState;
 using apollo::cyber::event::PerfEventCache;
@@ -37,18 +40,37 @@ GRP_WQ_MUTEX ClassicContext::mtx_wq_;
 GRP_WQ_CV ClassicContext::cv_wq_;
 RQ_LOCK_GROUP ClassicContext::rq_locks_;
 CR_GROUP ClassicContext::cr_group_;
+AtomicRWLock ClassicContext::ctx_group_lock_;
+GRP_CONTEXTS ClassicContext::ctx_group_;
 
 ClassicContext::ClassicContext() { InitGroup(DEFAULT_GROUP_NAME); }
 
-ClassicContext::ClassicContext(const std::string& group_name) {
+ClassicContext::ClassicContext(const std::string& group_name,
+                               bool work_stealing)
+    : work_stealing_(work_stealing) {
   InitGroup(group_name);
 }
 
+ClassicContext::~ClassicContext() {
+  if (peers_ == nullptr) {
+    return;
+  }
+  WriteLockGuard<AtomicRWLock> lk(ctx_group_lock_);
+  peers_->erase(std::remove(peers_->begin(), peers_->end(), this),
+                peers_->end());
+}
+
 void ClassicContext::InitGroup(const std::string& group_name) {
   multi_pri_rq_ = &cr_group_[group_name];
   lq_ = &rq_locks_[group_name];
   mtx_wrapper_ = &mtx_wq_[group_name];
   cw_ = &cv_wq_[group_name];
+
+  if (work_stealing_) {
+    WriteLockGuard<AtomicRWLock> lk(ctx_group_lock_);
+    peers_ = &ctx_group_[group_name];
+    peers_->emplace_back(this);
+  }
 }
 
 std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
@@ -56,6 +78,15 @@ std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
     return nullptr;
   }
 
+  if (work_stealing_) {
+    auto cr = NextLocalRoutine();
+    if (cr) {
+      PerfEventCache::Instance()->AddSchedEvent(SchedPerf::NEXT_RT, cr->id(),
+                                                cr->processor_id());
+      return cr;
+    }
+  }
+
   for (int i = MAX_PRIO - 1; i >= 0; --i) {
     ReadLockGuard<AtomicRWLock> lk(lq_->at(i));
     for (auto& cr : multi_pri_rq_->at(i)) {
@@ -83,6 +114,63 @@ std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
   return nullptr;
 }
 
+std::shared_ptr<CRoutine> ClassicContext::NextLocalRoutine() {
+  ReadLockGuard<AtomicRWLock> lk(ctx_group_lock_);
+  auto self = std::find(peers_->begin(), peers_->end(), this);
+  if (self == peers_->end()) {
+    return nullptr;
+  }
+  auto self_idx = static_cast<size_t>(self - peers_->begin());
+  auto peer_num = peers_->size();
+
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    auto cr = PopReady(i, false);
+    if (cr) {
+      return cr;
+    }
+
+    // Steal from the tail of peers in the same group, nearest first.
+    for (size_t k = 1; k < peer_num; ++k) {
+      cr = peers_->at((self_idx + k) % peer_num)->PopReady(i, true);
+      if (cr) {
+        return cr;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> ClassicContext::PopReady(uint32_t prio, bool steal) {
+  while (true) {
+    std::shared_ptr<CRoutine> cr;
+    {
+      std::lock_guard<std::mutex> lg(local_mtx_);
+      auto& dq = local_rq_.at(prio);
+      if (dq.empty()) {
+        return nullptr;
+      }
+      if (steal) {
+        cr = std::move(dq.back());
+        dq.pop_back();
+      } else {
+        cr = std::move(dq.front());
+        dq.pop_front();
+      }
+    }
+
+    // Already running elsewhere, the owner rescans it after Release.
+    if (!cr->Acquire()) {
+      continue;
+    }
+
+    if (cr->UpdateState() == RoutineState::READY) {
+      return cr;
+    }
+    cr->Release();
+  }
+}
+
 void ClassicContext::Wait() {
   std::unique_lock<std::mutex> lk(mtx_wrapper_->Mutex());
   if (stop_) {
@@ -112,6 +200,19 @@ void ClassicContext::Notify(const std::string& group_name) {
   cv_wq_[group_name].Cv().notify_one();
 }
 
+bool ClassicContext::Enqueue(const std::shared_ptr<CRoutine>& cr) {
+  ReadLockGuard<AtomicRWLock> lk(ctx_group_lock_);
+  auto it = ctx_group_.find(cr->group_name());
+  if (it == ctx_group_.end() || it->second.empty()) {
+    return false;
+  }
+
+  auto home = it->second.at(cr->id() % it->second.size());
+  std::lock_guard<std::mutex> lg(home->local_mtx_);
+  home->local_rq_.at(cr->priority()).emplace_back(cr);
+  return true;
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
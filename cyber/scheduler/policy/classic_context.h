@@ -18,6 +18,7 @@
 #define CYBER_SCHEDULER_POLICY_CLASSIC_CONTEXT_H_
 
 #include <array>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -45,19 +46,30 @@ using CR_GROUP = std::unordered_map<std::string, MULTI_PRIO_QUEUE>;
 using LOCK_QUEUE = std::array<base::AtomicRWLock, MAX_PRIO>;
 using RQ_LOCK_GROUP = std::unordered_map<std::string, LOCK_QUEUE>;
 
+using CROUTINE_DEQUE = std::deque<std::shared_ptr<CRoutine>>;
+using MULTI_PRIO_DEQUE = std::array<CROUTINE_DEQUE, MAX_PRIO>;
+
+class ClassicContext;
+using GRP_CONTEXTS =
+    std::unordered_map<std::string, std::vector<ClassicContext *>>;
+
 using GRP_WQ_MUTEX = std::unordered_map<std::string, MutexWrapper>;
 using GRP_WQ_CV = std::unordered_map<std::string, CvWrapper>;
 
 class ClassicContext : public ProcessorContext {
  public:
   ClassicContext();
-  explicit ClassicContext(const std::string &group_name);
+  explicit ClassicContext(const std::string &group_name,
+                          bool work_stealing = false);
+  ~ClassicContext();
 
   std::shared_ptr<CRoutine> NextRoutine() override;
   void Wait() override;
   void Shutdown() override;
 
   static void Notify(const std::string &group_name);
+  // Queue a ready croutine on its home processor when the group steals work.
+  static bool Enqueue(const std::shared_ptr<CRoutine> &cr);
 
   alignas(CACHELINE_SIZE) static RQ_LOCK_GROUP rq_locks_;
   alignas(CACHELINE_SIZE) static CR_GROUP cr_group_;
@@ -65,8 +77,13 @@ class ClassicContext : public ProcessorContext {
   alignas(CACHELINE_SIZE) static GRP_WQ_MUTEX mtx_wq_;
   alignas(CACHELINE_SIZE) static GRP_WQ_CV cv_wq_;
 
+  alignas(CACHELINE_SIZE) static base::AtomicRWLock ctx_group_lock_;
+  alignas(CACHELINE_SIZE) static GRP_CONTEXTS ctx_group_;
+
  private:
   void InitGroup(const std::string &group_name);
+  std::shared_ptr<CRoutine> NextLocalRoutine();
+  std::shared_ptr<CRoutine> PopReady(uint32_t prio, bool steal);
 
   std::chrono::steady_clock::time_point wake_time_;
   bool need_sleep_ = false;
@@ -75,6 +92,11 @@ class ClassicContext : public ProcessorContext {
   LOCK_QUEUE *lq_ = nullptr;
   MutexWrapper *mtx_wrapper_ = nullptr;
   CvWrapper *cw_ = nullptr;
+
+  bool work_stealing_ = false;
+  std::vector<ClassicContext *> *peers_ = nullptr;
+  std::mutex local_mtx_;
+  MULTI_PRIO_DEQUE local_rq_;
 };
 
 }  // namespace scheduler
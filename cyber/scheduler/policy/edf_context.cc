@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/edf_context.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/event/perf_event_cache.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+using apollo::cyber::event::PerfEventCache;
+using apollo::cyber::event::SchedPerf;
+
+namespace {
+
+bool Later(const EdfJob& lhs, const EdfJob& rhs) {
+  if (lhs.deadline != rhs.deadline) {
+    return lhs.deadline > rhs.deadline;
+  }
+  return lhs.seq > rhs.seq;
+}
+
+void UpdateMax(std::atomic<uint64_t>* target, uint64_t value) {
+  auto old = target->load(std::memory_order_relaxed);
+  while (old < value && !target->compare_exchange_weak(old, value)) {
+  }
+}
+
+}  // namespace
+
+uint64_t EdfRunQueue::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void EdfRunQueue::Release(const std::shared_ptr<CRoutine>& cr,
+                          const std::shared_ptr<EdfTaskInfo>& info) {
+  EdfJob job;
+  job.cr = cr;
+  job.info = info;
+  auto period = info == nullptr ? 0 : info->period_ns.load();
+  job.deadline =
+      period ? NowNs() + period : std::numeric_limits<uint64_t>::max();
+  {
+    std::lock_guard<std::mutex> lg(mtx_);
+    if (stop_) {
+      return;
+    }
+    PushLocked(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+void EdfRunQueue::Requeue(EdfJob&& job) {
+  std::lock_guard<std::mutex> lg(mtx_);
+  if (!stop_) {
+    PushLocked(std::move(job));
+  }
+}
+
+void EdfRunQueue::Finish(uint64_t crid) {
+  bool unparked = false;
+  {
+    std::lock_guard<std::mutex> lg(mtx_);
+    auto range = parked_.equal_range(crid);
+    for (auto it = range.first; it != range.second; ++it) {
+      PushLocked(std::move(it->second));
+      unparked = true;
+    }
+    parked_.erase(range.first, range.second);
+  }
+  if (unparked) {
+    cv_.notify_one();
+  }
+}
+
+void EdfRunQueue::Remove(uint64_t crid) {
+  std::lock_guard<std::mutex> lg(mtx_);
+  auto match = [crid](const EdfJob& job) { return job.cr->id() == crid; };
+  heap_.erase(std::remove_if(heap_.begin(), heap_.end(), match), heap_.end());
+  std::make_heap(heap_.begin(), heap_.end(), Later);
+  sleepers_.erase(std::remove_if(sleepers_.begin(), sleepers_.end(), match),
+                  sleepers_.end());
+  parked_.erase(crid);
+}
+
+bool EdfRunQueue::Pop(EdfJob* job) {
+  std::lock_guard<std::mutex> lg(mtx_);
+  if (stop_) {
+    return false;
+  }
+
+  WakeSleepersLocked();
+  while (!heap_.empty()) {
+    std::pop_heap(heap_.begin(), heap_.end(), Later);
+    EdfJob top = std::move(heap_.back());
+    heap_.pop_back();
+
+    auto cr = top.cr;
+    if (!cr->Acquire()) {
+      // running on another processor, which unparks it in Finish
+      parked_.emplace(cr->id(), std::move(top));
+      continue;
+    }
+
+    auto state = cr->UpdateState();
+    if (state == RoutineState::READY) {
+      *job = std::move(top);
+      return true;
+    }
+
+    cr->Release();
+    if (state == RoutineState::SLEEP) {
+      sleepers_.emplace_back(std::move(top));
+    }
+    // Otherwise the data of this release was consumed by an earlier job.
+  }
+  return false;
+}
+
+void EdfRunQueue::Wait() {
+  std::unique_lock<std::mutex> lk(mtx_);
+  if (stop_ || !heap_.empty()) {
+    return;
+  }
+
+  if (sleepers_.empty()) {
+    cv_.wait(lk);
+    return;
+  }
+
+  auto wake_time = sleepers_.front().cr->wake_time();
+  for (auto& job : sleepers_) {
+    wake_time = std::min(wake_time, job.cr->wake_time());
+  }
+  cv_.wait_until(lk, wake_time);
+}
+
+void EdfRunQueue::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lg(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+}
+
+void EdfRunQueue::PushLocked(EdfJob&& job) {
+  job.seq = seq_++;
+  heap_.emplace_back(std::move(job));
+  std::push_heap(heap_.begin(), heap_.end(), Later);
+}
+
+void EdfRunQueue::WakeSleepersLocked() {
+  if (sleepers_.empty()) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  for (auto it = sleepers_.begin(); it != sleepers_.end();) {
+    if (it->cr->wake_time() <= now) {
+      PushLocked(std::move(*it));
+      it = sleepers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<CRoutine> EdfContext::NextRoutine() {
+  if (unlikely(stop_)) {
+    return nullptr;
+  }
+
+  FlushFinished();
+
+  EdfJob job;
+  if (!rq_->Pop(&job)) {
+    return nullptr;
+  }
+
+  current_ = std::move(job);
+  start_ns_ = EdfRunQueue::NowNs();
+  PerfEventCache::Instance()->AddSchedEvent(
+      SchedPerf::NEXT_RT, current_.cr->id(), current_.cr->processor_id());
+  return current_.cr;
+}
+
+void EdfContext::OnRoutineYield(const std::shared_ptr<CRoutine>& cr) {
+  if (current_.cr != cr) {
+    return;
+  }
+
+  auto now = EdfRunQueue::NowNs();
+  current_.exec_ns += now - start_ns_;
+  yielded_ = true;
+
+  auto state = cr->state();
+  requeue_ = state == RoutineState::READY || state == RoutineState::SLEEP;
+  if (requeue_ || current_.info == nullptr) {
+    return;
+  }
+
+  // The croutine went back to wait for data, its job is complete.
+  auto& info = current_.info;
+  info->jobs.fetch_add(1);
+  UpdateMax(&info->max_exec_ns, current_.exec_ns);
+
+  auto budget = info->budget_ns.load();
+  if (budget != 0 && current_.exec_ns > budget) {
+    info->budget_overruns.fetch_add(1);
+  }
+
+  if (now > current_.deadline) {
+    info->deadline_misses.fetch_add(1);
+    UpdateMax(&info->max_lateness_ns, now - current_.deadline);
+    AWARN_EVERY(100) << "Task " << info->name << " missed its deadline by "
+                     << (now - current_.deadline) / 1000 << "us, "
+                     << info->deadline_misses.load() << " misses in total.";
+  }
+}
+
+void EdfContext::Wait() { rq_->Wait(); }
+
+void EdfContext::Shutdown() {
+  ProcessorContext::Shutdown();
+  rq_->Shutdown();
+}
+
+void EdfContext::FlushFinished() {
+  if (!yielded_) {
+    return;
+  }
+
+  yielded_ = false;
+  auto crid = current_.cr->id();
+  if (requeue_) {
+    rq_->Requeue(std::move(current_));
+  }
+  current_ = EdfJob();
+  rq_->Finish(crid);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
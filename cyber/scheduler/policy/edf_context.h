@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using croutine::CRoutine;
+
+// Timing and deadline accounting of one edf task, shared by all of its jobs.
+struct EdfTaskInfo {
+  std::string name;
+  std::atomic<uint64_t> period_ns = {0};
+  std::atomic<uint64_t> budget_ns = {0};
+
+  std::atomic<uint64_t> jobs = {0};
+  std::atomic<uint64_t> deadline_misses = {0};
+  std::atomic<uint64_t> budget_overruns = {0};
+  std::atomic<uint64_t> max_lateness_ns = {0};
+  std::atomic<uint64_t> max_exec_ns = {0};
+};
+
+// One release of a croutine. Tasks without a period never expire and run
+// after every task with a deadline, in release order.
+struct EdfJob {
+  uint64_t deadline = 0;
+  uint64_t seq = 0;
+  uint64_t exec_ns = 0;
+  std::shared_ptr<CRoutine> cr;
+  std::shared_ptr<EdfTaskInfo> info;
+};
+
+// Global earliest deadline first run queue shared by all edf processors.
+class EdfRunQueue {
+ public:
+  static uint64_t NowNs();
+
+  // Starts a new job of cr with its deadline one period from now.
+  void Release(const std::shared_ptr<CRoutine>& cr,
+               const std::shared_ptr<EdfTaskInfo>& info);
+  // Requeues a job that yielded before completing, keeping its deadline.
+  void Requeue(EdfJob&& job);
+  // Called by the processor that ran crid once it released the croutine.
+  void Finish(uint64_t crid);
+  void Remove(uint64_t crid);
+
+  bool Pop(EdfJob* job);
+  void Wait();
+  void Shutdown();
+
+ private:
+  void PushLocked(EdfJob&& job);
+  void WakeSleepersLocked();
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  uint64_t seq_ = 0;
+
+  // min heap on (deadline, seq)
+  std::vector<EdfJob> heap_;
+  // jobs of croutines that were running when popped
+  std::unordered_multimap<uint64_t, EdfJob> parked_;
+  std::vector<EdfJob> sleepers_;
+};
+
+class EdfContext : public ProcessorContext {
+ public:
+  explicit EdfContext(const std::shared_ptr<EdfRunQueue>& rq) : rq_(rq) {}
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void OnRoutineYield(const std::shared_ptr<CRoutine>& cr) override;
+  void Wait() override;
+  void Shutdown() override;
+
+ private:
+  void FlushFinished();
+
+  std::shared_ptr<EdfRunQueue> rq_;
+
+  EdfJob current_;
+  uint64_t start_ns_ = 0;
+  bool yielded_ = false;
+  bool requeue_ = false;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
@@ -91,7 +91,8 @@ void SchedulerClassic::CreateProcessor() {
     ParseCpuset(group.cpuset(), &cpuset);
 
     for (uint32_t i = 0; i < proc_num; i++) {
-      auto ctx = std::make_shared<ClassicContext>(group_name);
+      auto ctx =
+          std::make_shared<ClassicContext>(group_name, group.work_stealing());
       pctxs_.emplace_back(ctx);
 
       auto proc = std::make_shared<Processor>();
@@ -153,6 +154,7 @@ bool SchedulerClassic::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
 
   PerfEventCache::Instance()->AddSchedEvent(SchedPerf::RT_CREATE, cr->id(),
                                             cr->processor_id());
+  ClassicContext::Enqueue(cr);
   ClassicContext::Notify(cr->group_name());
   return true;
 }
@@ -168,6 +170,7 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
       auto cr = id_cr_[crid];
       if (cr->state() == RoutineState::DATA_WAIT) {
         cr->SetUpdateFlag();
+        ClassicContext::Enqueue(cr);
       }
 
       ClassicContext::Notify(cr->group_name());
@@ -0,0 +1,232 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_edf.h"
+
+#include <utility>
+#include <vector>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/file.h"
+#include "cyber/event/perf_event_cache.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::common::GetAbsolutePath;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::common::PathExists;
+using apollo::cyber::common::WorkRoot;
+using apollo::cyber::croutine::RoutineState;
+using apollo::cyber::event::PerfEventCache;
+using apollo::cyber::event::SchedPerf;
+
+namespace {
+constexpr uint64_t kNsPerMs = 1000000;
+}
+
+SchedulerEdf::SchedulerEdf() {
+  std::string conf("conf/");
+  conf.append(GlobalData::Instance()->ProcessGroup()).append(".conf");
+  auto cfg_file = GetAbsolutePath(WorkRoot(), conf);
+
+  apollo::cyber::proto::CyberConfig cfg;
+  if (PathExists(cfg_file) && GetProtoFromFile(cfg_file, &cfg)) {
+    edf_conf_ = cfg.scheduler_conf().edf_conf();
+    for (auto& task : edf_conf_.tasks()) {
+      cr_confs_[task.name()] = task;
+    }
+  }
+
+  if (edf_conf_.processor_num() == 0) {
+    uint32_t proc_num = 2;
+    auto& global_conf = GlobalData::Instance()->Config();
+    if (global_conf.has_scheduler_conf() &&
+        global_conf.scheduler_conf().has_default_proc_num()) {
+      proc_num = global_conf.scheduler_conf().default_proc_num();
+    }
+    edf_conf_.set_processor_num(proc_num);
+  }
+  task_pool_size_ = edf_conf_.processor_num();
+
+  CreateProcessor();
+}
+
+void SchedulerEdf::CreateProcessor() {
+  rq_ = std::make_shared<EdfRunQueue>();
+
+  std::vector<int> cpuset;
+  ParseCpuset(edf_conf_.cpuset(), &cpuset);
+
+  for (uint32_t i = 0; i < edf_conf_.processor_num(); i++) {
+    auto ctx = std::make_shared<EdfContext>(rq_);
+    pctxs_.emplace_back(ctx);
+
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    proc->SetAffinity(cpuset, edf_conf_.affinity(), i);
+    proc->SetSchedPolicy(edf_conf_.processor_policy(),
+                         edf_conf_.processor_prio());
+    processors_.emplace_back(proc);
+  }
+}
+
+bool SchedulerEdf::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(cr->id(), wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  auto info = std::make_shared<EdfTaskInfo>();
+  info->name = cr->name();
+  {
+    std::lock_guard<std::mutex> conf_lg(cr_confs_mtx_);
+    auto it = cr_confs_.find(cr->name());
+    if (it != cr_confs_.end()) {
+      info->period_ns = it->second.period_ms() * kNsPerMs;
+      info->budget_ns = it->second.budget_ms() * kNsPerMs;
+    }
+  }
+
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(cr->id()) != id_cr_.end()) {
+      return false;
+    }
+    id_cr_[cr->id()] = cr;
+    id_info_[cr->id()] = info;
+  }
+
+  PerfEventCache::Instance()->AddSchedEvent(SchedPerf::RT_CREATE, cr->id(),
+                                            cr->processor_id());
+  rq_->Release(cr, info);
+  return true;
+}
+
+bool SchedulerEdf::NotifyProcessor(uint64_t crid) {
+  if (unlikely(stop_)) {
+    return true;
+  }
+
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  auto it = id_cr_.find(crid);
+  if (it == id_cr_.end()) {
+    return false;
+  }
+
+  auto& cr = it->second;
+  if (cr->state() == RoutineState::DATA_WAIT) {
+    cr->SetUpdateFlag();
+    rq_->Release(cr, id_info_[crid]);
+  }
+  return true;
+}
+
+bool SchedulerEdf::RemoveTask(const std::string& name) {
+  if (unlikely(stop_)) {
+    return true;
+  }
+
+  auto crid = GlobalData::GenerateHashId(name);
+  return RemoveCRoutine(crid);
+}
+
+bool SchedulerEdf::RemoveCRoutine(uint64_t crid) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(crid, &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(crid, &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(crid, wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    auto it = id_cr_.find(crid);
+    if (it == id_cr_.end()) {
+      return false;
+    }
+    it->second->Stop();
+    id_cr_.erase(it);
+    id_info_.erase(crid);
+  }
+
+  rq_->Remove(crid);
+  return true;
+}
+
+void SchedulerEdf::SetTaskDeadline(const std::string& name,
+                                   uint32_t period_ms, uint32_t budget_ms) {
+  if (period_ms == 0 && budget_ms == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lg(cr_confs_mtx_);
+    auto& task = cr_confs_[name];
+    task.set_name(name);
+    task.set_period_ms(period_ms);
+    task.set_budget_ms(budget_ms);
+  }
+
+  // apply to a task which is already running
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  auto it = id_info_.find(GlobalData::GenerateHashId(name));
+  if (it != id_info_.end()) {
+    it->second->period_ns = period_ms * kNsPerMs;
+    it->second->budget_ns = budget_ms * kNsPerMs;
+  }
+}
+
+void SchedulerEdf::GetStats(EdfStats* stats) {
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  for (auto& item : id_info_) {
+    auto& info = item.second;
+    auto task = stats->add_tasks();
+    task->set_name(info->name);
+    task->set_period_ns(info->period_ns.load());
+    task->set_budget_ns(info->budget_ns.load());
+    task->set_jobs(info->jobs.load());
+    task->set_deadline_misses(info->deadline_misses.load());
+    task->set_budget_overruns(info->budget_overruns.load());
+    task->set_max_lateness_ns(info->max_lateness_ns.load());
+    task->set_max_exec_ns(info->max_exec_ns.load());
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
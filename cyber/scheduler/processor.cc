@@ -84,6 +84,7 @@ void Processor::Run() {
       auto croutine = context_->NextRoutine();
       if (croutine) {
         croutine->Resume();
+        context_->OnRoutineYield(croutine);
         croutine->Release();
       } else {
         context_->Wait();
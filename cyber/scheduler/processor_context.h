@@ -37,6 +37,8 @@ class ProcessorContext {
   virtual void Shutdown();
   virtual std::shared_ptr<CRoutine> NextRoutine() = 0;
   virtual void Wait() = 0;
+  // Called after cr yields back to the processor and before it is released.
+  virtual void OnRoutineYield(const std::shared_ptr<CRoutine>& cr) {}
 
  protected:
   bool stop_ = false;
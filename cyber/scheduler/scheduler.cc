@@ -33,6 +33,30 @@ namespace scheduler {
 
 using apollo::cyber::common::GlobalData;
 
+namespace {
+size_t StackSizeOf(const std::string& name) {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (!global_conf.has_scheduler_conf()) {
+    return 0;
+  }
+  for (auto& stack : global_conf.scheduler_conf().routine_stacks()) {
+    if (stack.name() == name) {
+      return stack.stack_size_kb() * 1024;
+    }
+  }
+  return 0;
+}
+
+void FillTimeStat(const croutine::RoutineHistogram& hist,
+                  proto::RoutineTimeStat* stat) {
+  stat->set_count(hist.count());
+  stat->set_mean_ns(hist.mean());
+  stat->set_p50_ns(hist.Percentile(50));
+  stat->set_p99_ns(hist.Percentile(99));
+  stat->set_max_ns(hist.max());
+}
+}  // namespace
+
 bool Scheduler::CreateTask(const RoutineFactory& factory,
                            const std::string& name) {
   return CreateTask(factory.create_routine(), name, factory.GetDataVisitor());
@@ -48,7 +72,7 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
 
   auto task_id = GlobalData::RegisterTaskName(name);
 
-  auto cr = std::make_shared<CRoutine>(func);
+  auto cr = std::make_shared<CRoutine>(func, StackSizeOf(name));
   cr->set_id(task_id);
   cr->set_name(name);
 
@@ -106,6 +130,25 @@ void Scheduler::ParseCpuset(const std::string& str, std::vector<int>* cpuset) {
   }
 }
 
+void Scheduler::GetRoutineStats(proto::RoutineStats* stats) {
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  for (auto& item : id_cr_) {
+    auto& cr = item.second;
+    auto stat = stats->add_routines();
+    stat->set_name(cr->name());
+    stat->set_id(cr->id());
+    stat->set_stack_size(cr->stack_size());
+    stat->set_stack_high_water(cr->StackHighWater());
+
+    auto& cr_stats = cr->statistics();
+    FillTimeStat(cr_stats.wait_time, stat->mutable_wait_time());
+    FillTimeStat(cr_stats.run_time, stat->mutable_run_time());
+    stat->set_switch_count(cr_stats.switch_count.load());
+    stat->set_processor_id(cr->processor_id());
+    stat->set_cpu(cr_stats.cpu.load());
+  }
+}
+
 void Scheduler::Shutdown() {
   if (unlikely(stop_.exchange(true))) {
     return;
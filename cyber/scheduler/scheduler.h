@@ -34,6 +34,7 @@
 #include "cyber/common/types.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/croutine/routine_factory.h"
+#include "cyber/proto/routine_stats.pb.h"
 #include "cyber/scheduler/common/mutex_wrapper.h"
 
 namespace apollo {
@@ -62,9 +63,12 @@ class Scheduler {
 
   void Shutdown();
   uint32_t TaskPoolSize() { return task_pool_size_; }
+  void GetRoutineStats(proto::RoutineStats* stats);
 
   virtual bool RemoveTask(const std::string& name) = 0;
   virtual void SetInnerThreadAttr(const std::string& name, std::thread* thr) {}
+  virtual void SetTaskDeadline(const std::string& name, uint32_t period_ms,
+                               uint32_t budget_ms) {}
 
   virtual bool DispatchTask(const std::shared_ptr<CRoutine>&) = 0;
   virtual bool NotifyProcessor(uint64_t crid) = 0;
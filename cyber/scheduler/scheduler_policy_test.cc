@@ -21,6 +21,7 @@
 #include "cyber/cyber.h"
 #include "cyber/scheduler/policy/choreography_context.h"
 #include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/policy/edf_context.h"
 #include "cyber/scheduler/policy/scheduler_choreography.h"
 #include "cyber/scheduler/policy/scheduler_classic.h"
 #include "cyber/scheduler/processor.h"
@@ -73,6 +74,88 @@ TEST(SchedulerPolicyTest, classic) {
   processor->Stop();
 }
 
+TEST(SchedulerPolicyTest, classic_work_stealing) {
+  auto ctx0 = std::make_shared<ClassicContext>("steal_grp", true);
+  auto ctx1 = std::make_shared<ClassicContext>("steal_grp", true);
+
+  // even ids are homed on ctx0, the idle ctx1 has to steal them
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  FOR_EACH(i, 0, 3) {
+    auto cr = std::make_shared<CRoutine>(func);
+    cr->set_id(i * 2);
+    cr->set_priority(i);
+    cr->set_group_name("steal_grp");
+    EXPECT_TRUE(ClassicContext::Enqueue(cr));
+    crs.emplace_back(cr);
+  }
+
+  auto stolen = ctx1->NextRoutine();
+  ASSERT_NE(nullptr, stolen);
+  EXPECT_EQ(crs[2], stolen);
+  auto local = ctx0->NextRoutine();
+  ASSERT_NE(nullptr, local);
+  EXPECT_EQ(crs[1], local);
+  stolen->Release();
+  local->Release();
+
+  // a croutine held by another processor is not handed out twice
+  EXPECT_TRUE(crs[0]->Acquire());
+  EXPECT_EQ(nullptr, ctx1->NextRoutine());
+  crs[0]->Release();
+
+  auto plain = std::make_shared<CRoutine>(func);
+  plain->set_group_name(DEFAULT_GROUP_NAME);
+  EXPECT_FALSE(ClassicContext::Enqueue(plain));
+}
+
+TEST(SchedulerPolicyTest, edf) {
+  auto rq = std::make_shared<EdfRunQueue>();
+  auto ctx = std::make_shared<EdfContext>(rq);
+
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  std::vector<std::shared_ptr<EdfTaskInfo>> infos;
+  // planning, control and a best effort task
+  for (uint64_t period_ms : {100, 10, 0}) {
+    auto cr = std::make_shared<CRoutine>(func);
+    cr->set_id(crs.size());
+    auto info = std::make_shared<EdfTaskInfo>();
+    info->period_ns = period_ms * 1000000;
+    rq->Release(cr, info);
+    crs.emplace_back(cr);
+    infos.emplace_back(info);
+  }
+
+  for (auto idx : {1, 0, 2}) {
+    auto cr = ctx->NextRoutine();
+    ASSERT_EQ(crs[idx], cr);
+    cr->set_state(croutine::RoutineState::DATA_WAIT);
+    ctx->OnRoutineYield(cr);
+    cr->Release();
+    EXPECT_EQ(1, infos[idx]->jobs.load());
+    EXPECT_EQ(0, infos[idx]->deadline_misses.load());
+  }
+  EXPECT_EQ(nullptr, ctx->NextRoutine());
+
+  // a job that yields ready keeps its deadline and runs again
+  crs[0]->SetUpdateFlag();
+  rq->Release(crs[0], infos[0]);
+  auto cr = ctx->NextRoutine();
+  ASSERT_EQ(crs[0], cr);
+  ctx->OnRoutineYield(cr);
+  cr->Release();
+  EXPECT_EQ(crs[0], ctx->NextRoutine());
+  std::this_thread::sleep_for(std::chrono::milliseconds(110));
+  crs[0]->set_state(croutine::RoutineState::DATA_WAIT);
+  ctx->OnRoutineYield(crs[0]);
+  crs[0]->Release();
+  EXPECT_EQ(2, infos[0]->jobs.load());
+  EXPECT_EQ(1, infos[0]->deadline_misses.load());
+  EXPECT_LT(0, infos[0]->max_lateness_ns.load());
+
+  ctx->Shutdown();
+  EXPECT_EQ(nullptr, ctx->NextRoutine());
+}
+
 TEST(SchedulerPolicyTest, sched_classic) {
   // read example_sched_classic.conf
   GlobalData::Instance()->SetProcessGroup("example_sched_classic");
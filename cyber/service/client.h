@@ -17,12 +17,13 @@
 #ifndef CYBER_SERVICE_CLIENT_H_
 #define CYBER_SERVICE_CLIENT_H_
 
+#include <algorithm>
+#include <chrono>
 #include <future>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
-#include <tuple>
 #include <unordered_map>
 #include <utility>
 
@@ -72,6 +73,12 @@ class Client : public ClientBase {
   bool ServiceIsReady() const;
   void Destroy();
 
+  /**
+   * @brief Request counters and the latency from sending a request to
+   *        receiving its response.
+   */
+  ClientStats GetStats() const;
+
   template <typename RatioT = std::milli>
   bool WaitForService(std::chrono::duration<int64_t, RatioT> timeout =
                           std::chrono::duration<int64_t, RatioT>(-1)) {
@@ -84,16 +91,26 @@ class Client : public ClientBase {
                       const transport::MessageInfo& request_info);
   bool IsInit(void) const { return response_receiver_ != nullptr; }
 
+  SharedFuture AsyncSendRequest(SharedRequest request, CallbackType&& cb,
+                                uint64_t* sequence_number);
+  void CancelRequest(uint64_t sequence_number);
+
+  struct PendingRequest {
+    SharedPromise promise;
+    CallbackType callback;
+    SharedFuture future;
+    std::chrono::steady_clock::time_point send_time;
+  };
+
   std::string node_name_;
 
   std::function<void(const std::shared_ptr<Response>&,
                      const transport::MessageInfo&)>
       response_callback_;
 
-  std::unordered_map<uint64_t,
-                     std::tuple<SharedPromise, CallbackType, SharedFuture>>
-      pending_requests_;
-  std::mutex pending_requests_mutex_;
+  std::unordered_map<uint64_t, PendingRequest> pending_requests_;
+  mutable std::mutex pending_requests_mutex_;
+  ClientStats stats_;
 
   std::shared_ptr<transport::Transmitter<Request>> request_transmitter_;
   std::shared_ptr<transport::Receiver<Response>> response_receiver_;
@@ -157,7 +174,9 @@ Client<Request, Response>::SendRequest(SharedRequest request,
   if (!IsInit()) {
     return nullptr;
   }
-  auto future = AsyncSendRequest(request);
+  uint64_t sequence_number = 0;
+  auto future =
+      AsyncSendRequest(request, [](SharedFuture) {}, &sequence_number);
   if (!future.valid()) {
     return nullptr;
   }
@@ -165,6 +184,8 @@ Client<Request, Response>::SendRequest(SharedRequest request,
   if (status == std::future_status::ready) {
     return future.get();
   } else {
+    // a late response for this request has nobody waiting for it
+    CancelRequest(sequence_number);
     return nullptr;
   }
 }
@@ -197,19 +218,51 @@ template <typename Request, typename Response>
 typename Client<Request, Response>::SharedFuture
 Client<Request, Response>::AsyncSendRequest(SharedRequest request,
                                             CallbackType&& cb) {
-  if (IsInit()) {
-    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-    sequence_number_++;
-    transport::MessageInfo info(writer_id_, sequence_number_, writer_id_);
-    request_transmitter_->Transmit(request, info);
-    SharedPromise call_promise = std::make_shared<Promise>();
-    SharedFuture f(call_promise->get_future());
-    pending_requests_[info.seq_num()] =
-        std::make_tuple(call_promise, std::forward<CallbackType>(cb), f);
-    return f;
-  } else {
+  uint64_t sequence_number = 0;
+  return AsyncSendRequest(request, std::forward<CallbackType>(cb),
+                          &sequence_number);
+}
+
+template <typename Request, typename Response>
+typename Client<Request, Response>::SharedFuture
+Client<Request, Response>::AsyncSendRequest(SharedRequest request,
+                                            CallbackType&& cb,
+                                            uint64_t* sequence_number) {
+  if (!IsInit()) {
     return std::shared_future<std::shared_ptr<Response>>();
   }
+  SharedPromise call_promise = std::make_shared<Promise>();
+  SharedFuture f(call_promise->get_future());
+  {
+    // The request is pending before it is transmitted, so that a response
+    // arriving right away finds it. Requests are transmitted outside the
+    // lock and may be in flight concurrently.
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    *sequence_number = ++sequence_number_;
+    pending_requests_[*sequence_number] =
+        PendingRequest{call_promise, std::forward<CallbackType>(cb), f,
+                       std::chrono::steady_clock::now()};
+    ++stats_.sent_requests;
+    ++stats_.in_flight_requests;
+  }
+  transport::MessageInfo info(writer_id_, *sequence_number, writer_id_);
+  request_transmitter_->Transmit(request, info);
+  return f;
+}
+
+template <typename Request, typename Response>
+void Client<Request, Response>::CancelRequest(uint64_t sequence_number) {
+  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+  if (pending_requests_.erase(sequence_number) != 0) {
+    ++stats_.timed_out_requests;
+    --stats_.in_flight_requests;
+  }
+}
+
+template <typename Request, typename Response>
+ClientStats Client<Request, Response>::GetStats() const {
+  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+  return stats_;
 }
 
 template <typename Request, typename Response>
@@ -222,21 +275,31 @@ void Client<Request, Response>::HandleResponse(
     const std::shared_ptr<Response>& response,
     const transport::MessageInfo& request_header) {
   ADEBUG << "client recv response.";
-  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
   if (request_header.spare_id() != writer_id_) {
     return;
   }
-  uint64_t sequence_number = request_header.seq_num();
-  if (this->pending_requests_.count(sequence_number) == 0) {
-    return;
+  PendingRequest pending;
+  {
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    auto search = pending_requests_.find(request_header.seq_num());
+    if (search == pending_requests_.end()) {
+      return;
+    }
+    pending = std::move(search->second);
+    pending_requests_.erase(search);
+
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - pending.send_time)
+            .count();
+    ++stats_.received_responses;
+    --stats_.in_flight_requests;
+    stats_.total_latency_ms += latency_ms;
+    stats_.max_latency_ms = std::max(stats_.max_latency_ms, latency_ms);
   }
-  auto tuple = this->pending_requests_[sequence_number];
-  auto call_promise = std::get<0>(tuple);
-  auto callback = std::get<1>(tuple);
-  auto future = std::get<2>(tuple);
-  this->pending_requests_.erase(sequence_number);
-  call_promise->set_value(response);
-  callback(future);
+  // callbacks may send further requests, so they run without the lock
+  pending.promise->set_value(response);
+  pending.callback(pending.future);
 }
 
 }  // namespace cyber
@@ -17,6 +17,8 @@
 #ifndef CYBER_SERVICE_CLIENT_BASE_H_
 #define CYBER_SERVICE_CLIENT_BASE_H_
 
+#include <stdint.h>
+
 #include <chrono>
 #include <string>
 
@@ -25,6 +27,24 @@
 namespace apollo {
 namespace cyber {
 
+/**
+ * @brief Request counters and round trip latency of a client.
+ */
+struct ClientStats {
+  uint64_t sent_requests = 0;
+  uint64_t received_responses = 0;
+  uint64_t timed_out_requests = 0;
+  uint64_t in_flight_requests = 0;
+  double total_latency_ms = 0.0;
+  double max_latency_ms = 0.0;
+
+  double MeanLatencyMs() const {
+    return received_responses == 0
+               ? 0.0
+               : total_latency_ms / static_cast<double>(received_responses);
+  }
+};
+
 class ClientBase {
  public:
   explicit ClientBase(const std::string& service_name)
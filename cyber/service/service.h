@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/types.h"
 #include "cyber/node/node_channel_impl.h"
@@ -52,16 +53,17 @@ class Service : public ServiceBase {
         response_channel_(service_name + SRV_CHANNEL_RES_SUFFIX) {}
 
   Service() = delete;
-  ~Service() {
-    inited_ = false;
-    condition_.notify_all();
-    if (thread_.joinable()) {
-      thread_.join();
-    }
-  }
+  ~Service() { destroy(); }
   bool Init();
   void destroy();
 
+  /**
+   * @brief Handle up to max_concurrency requests at the same time. The
+   *        service callback must then be thread safe. Requests are handled
+   *        one after another by default.
+   */
+  void SetMaxConcurrency(size_t max_concurrency);
+
  private:
   void HandleRequest(const std::shared_ptr<Request>& request,
                      const transport::MessageInfo& message_info);
@@ -80,12 +82,11 @@ class Service : public ServiceBase {
   std::shared_ptr<transport::Receiver<Request>> request_receiver_;
   std::string request_channel_;
   std::string response_channel_;
-  std::mutex service_handle_request_mutex_;
 
-  volatile bool inited_;
+  volatile bool inited_ = false;
   void Enqueue(std::function<void()>&& task);
   void Process();
-  std::thread thread_;
+  std::vector<std::thread> threads_;
   std::mutex queue_mutex_;
   std::condition_variable condition_;
   std::list<std::function<void()>> tasks_;
@@ -93,10 +94,28 @@ class Service : public ServiceBase {
 
 template <typename Request, typename Response>
 void Service<Request, Response>::destroy() {
-  inited_ = false;
+  {
+    std::lock_guard<std::mutex> lg(queue_mutex_);
+    inited_ = false;
+  }
   condition_.notify_all();
-  if (thread_.joinable()) {
-    thread_.join();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+}
+
+template <typename Request, typename Response>
+void Service<Request, Response>::SetMaxConcurrency(size_t max_concurrency) {
+  std::lock_guard<std::mutex> lg(queue_mutex_);
+  if (!inited_) {
+    AERROR << "Service " << service_name_ << " is not initialized.";
+    return;
+  }
+  while (threads_.size() < max_concurrency) {
+    threads_.emplace_back(&Service<Request, Response>::Process, this);
   }
 }
 
@@ -165,7 +184,7 @@ bool Service<Request, Response>::Init() {
       },
       proto::OptionalMode::RTPS);
   inited_ = true;
-  thread_ = std::thread(&Service<Request, Response>::Process, this);
+  threads_.emplace_back(&Service<Request, Response>::Process, this);
   if (request_receiver_ == nullptr) {
     AERROR << " Create request sub failed." << request_channel_;
     response_transmitter_.reset();
@@ -183,7 +202,6 @@ void Service<Request, Response>::HandleRequest(
     return;
   }
   ADEBUG << "handling request:" << request_channel_;
-  std::lock_guard<std::mutex> lk(service_handle_request_mutex_);
   auto response = std::make_shared<Response>();
   service_callback_(request, response);
   transport::MessageInfo msg_info(message_info);
@@ -16,6 +16,8 @@
 
 #include "cyber/service_discovery/specific_manager/manager.h"
 
+#include <vector>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -54,6 +56,10 @@ bool Manager::StartDiscovery(RtpsParticipant* participant) {
   if (is_discovery_started_.exchange(true)) {
     return true;
   }
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    discovery_start_time_ns_ = cyber::Time::MonoTime().ToNanosecond();
+  }
   if (!CreatePublisher(participant) || !CreateSubscriber(participant)) {
     AERROR << "create publisher or subscriber failed.";
     StopDiscovery();
@@ -104,6 +110,7 @@ bool Manager::Join(const RoleAttributes& attr, RoleType role,
   Convert(attr, role, OperateType::OPT_JOIN, &msg);
   Dispose(msg);
   if (need_publish) {
+    RecordLocalChange(&msg);
     return Publish(msg);
   }
   return true;
@@ -120,6 +127,7 @@ bool Manager::Leave(const RoleAttributes& attr, RoleType role) {
   Convert(attr, role, OperateType::OPT_LEAVE, &msg);
   Dispose(msg);
   if (NeedPublish(msg)) {
+    RecordLocalChange(&msg);
     return Publish(msg);
   }
   return true;
@@ -193,7 +201,12 @@ void Manager::OnRemoteChange(const std::string& msg_str) {
   if (IsFromSameProcess(msg)) {
     return;
   }
+  if (msg.operate_type() == OperateType::OPT_SNAPSHOT) {
+    OnRemoteSnapshot(msg);
+    return;
+  }
   RETURN_IF(!Check(msg.role_attr()));
+  RETURN_IF(!AcceptRemoteChange(msg));
   Dispose(msg);
 }
 
@@ -221,6 +234,145 @@ bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
   return true;
 }
 
+void Manager::OnParticipantChange(const std::string& host_name,
+                                  int process_id, OperateType opt) {
+  if (host_name == host_name_ && process_id == process_id_) {
+    return;
+  }
+  if (opt == OperateType::OPT_JOIN) {
+    PublishSnapshot();
+    return;
+  }
+  RoleAttributes attr;
+  attr.set_host_name(host_name);
+  attr.set_process_id(process_id);
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  remote_tables_.erase(GetProcessKey(attr));
+}
+
+bool Manager::PublishSnapshot() {
+  if (is_shutdown_.load()) {
+    return false;
+  }
+  ChangeMsg msg;
+  msg.set_timestamp(cyber::Time::Now().ToNanosecond());
+  msg.set_change_type(change_type_);
+  msg.set_operate_type(OperateType::OPT_SNAPSHOT);
+  auto role_attr = msg.mutable_role_attr();
+  role_attr->set_host_name(host_name_);
+  role_attr->set_process_id(process_id_);
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    msg.set_version(version_);
+    for (const auto& item : local_roles_) {
+      *msg.add_snapshot() = item.second;
+    }
+    ++sync_stats_.snapshots_sent;
+  }
+  return Publish(msg);
+}
+
+Manager::SyncStats Manager::GetSyncStats() const {
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  return sync_stats_;
+}
+
+Manager::RoleKey Manager::GetRoleKey(const ChangeMsg& msg) {
+  const auto& attr = msg.role_attr();
+  return RoleKey(msg.role_type(), attr.id(), attr.node_id(), attr.channel_id(),
+                 attr.service_id());
+}
+
+std::string Manager::GetProcessKey(const RoleAttributes& attr) {
+  return attr.host_name() + '+' + std::to_string(attr.process_id());
+}
+
+void Manager::RecordLocalChange(ChangeMsg* msg) {
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  msg->set_version(++version_);
+  if (msg->operate_type() == OperateType::OPT_JOIN) {
+    local_roles_[GetRoleKey(*msg)] = *msg;
+  } else {
+    local_roles_.erase(GetRoleKey(*msg));
+  }
+}
+
+bool Manager::AcceptRemoteChange(const ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  ++sync_stats_.deltas_received;
+  // from a process without versions
+  if (!msg.has_version()) {
+    return true;
+  }
+  auto& table = remote_tables_[GetProcessKey(msg.role_attr())];
+  if (msg.version() <= table.version) {
+    ++sync_stats_.stale_ignored;
+    return false;
+  }
+  if (table.version > 0 && msg.version() > table.version + 1) {
+    ++sync_stats_.version_gaps;
+  }
+  table.version = msg.version();
+  if (msg.operate_type() == OperateType::OPT_JOIN) {
+    table.roles[GetRoleKey(msg)] = msg;
+  } else {
+    table.roles.erase(GetRoleKey(msg));
+  }
+  return true;
+}
+
+void Manager::OnRemoteSnapshot(const ChangeMsg& msg) {
+  std::vector<ChangeMsg> changes;
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    ++sync_stats_.snapshots_received;
+    auto& table = remote_tables_[GetProcessKey(msg.role_attr())];
+    if (msg.version() <= table.version && table.has_snapshot) {
+      ++sync_stats_.stale_ignored;
+      return;
+    }
+    // only the difference to what the deltas gave so far
+    std::map<RoleKey, ChangeMsg> roles;
+    for (const auto& role : msg.snapshot()) {
+      if (!Check(role.role_attr())) {
+        continue;
+      }
+      auto key = GetRoleKey(role);
+      if (table.roles.count(key) == 0) {
+        changes.push_back(role);
+      }
+      roles[key] = role;
+    }
+    if (msg.version() >= table.version) {
+      for (const auto& item : table.roles) {
+        if (roles.count(item.first) == 0) {
+          changes.push_back(item.second);
+          changes.back().set_operate_type(OperateType::OPT_LEAVE);
+        }
+      }
+      table.roles.swap(roles);
+      table.version = msg.version();
+    } else {
+      // deltas got further already, only fill in what they missed
+      for (auto& change : changes) {
+        table.roles[GetRoleKey(change)] = change;
+      }
+    }
+    if (!table.has_snapshot) {
+      table.has_snapshot = true;
+      ++sync_stats_.synced_process_num;
+      sync_stats_.convergence_time_ns =
+          cyber::Time::MonoTime().ToNanosecond() - discovery_start_time_ns_;
+      ADEBUG << "topology of " << GetProcessKey(msg.role_attr())
+             << " synced after " << sync_stats_.convergence_time_ns / 1000000
+             << "ms, change_type " << change_type_;
+    }
+  }
+  for (const auto& change : changes) {
+    Dispose(change);
+  }
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
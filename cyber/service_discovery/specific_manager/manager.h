@@ -19,8 +19,11 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -53,6 +56,19 @@ class Manager {
   using RtpsPublisherAttr = eprosima::fastrtps::PublisherAttributes;
   using RtpsSubscriberAttr = eprosima::fastrtps::SubscriberAttributes;
 
+  struct SyncStats {
+    uint64_t snapshots_sent = 0;
+    uint64_t snapshots_received = 0;
+    uint64_t deltas_received = 0;
+    // deltas and snapshots older than what we already have of a process
+    uint64_t stale_ignored = 0;
+    // missed deltas between two versions of a process
+    uint64_t version_gaps = 0;
+    uint64_t synced_process_num = 0;
+    // from StartDiscovery to the first snapshot of the latest process
+    uint64_t convergence_time_ns = 0;
+  };
+
   Manager();
   virtual ~Manager();
 
@@ -70,6 +86,14 @@ class Manager {
   virtual void OnTopoModuleLeave(const std::string& host_name,
                                  int process_id) = 0;
 
+  // Sends every role joined here to a process that just showed up, so it
+  // gets the whole table in one message instead of replaying each change,
+  // and forgets the table of a process that left.
+  void OnParticipantChange(const std::string& host_name, int process_id,
+                           OperateType opt);
+  bool PublishSnapshot();
+  SyncStats GetSyncStats() const;
+
  protected:
   bool CreatePublisher(RtpsParticipant* participant);
   bool CreateSubscriber(RtpsParticipant* participant);
@@ -86,6 +110,21 @@ class Manager {
   void OnRemoteChange(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
 
+  // role type and the ids of the role
+  using RoleKey = std::tuple<int, uint64_t, uint64_t, uint64_t, uint64_t>;
+  struct RemoteTable {
+    uint64_t version = 0;
+    bool has_snapshot = false;
+    std::map<RoleKey, ChangeMsg> roles;
+  };
+  static RoleKey GetRoleKey(const ChangeMsg& msg);
+  static std::string GetProcessKey(const RoleAttributes& attr);
+  // stamps a local change with the next version and keeps the local table
+  void RecordLocalChange(ChangeMsg* msg);
+  // false for a delta that is not newer than the table of its process
+  bool AcceptRemoteChange(const ChangeMsg& msg);
+  void OnRemoteSnapshot(const ChangeMsg& msg);
+
   std::atomic<bool> is_shutdown_;
   std::atomic<bool> is_discovery_started_;
   int allowed_role_;
@@ -98,6 +137,13 @@ class Manager {
   SubscriberListener* listener_;
 
   ChangeSignal signal_;
+
+  mutable std::mutex sync_mutex_;
+  uint64_t version_ = 0;
+  std::map<RoleKey, ChangeMsg> local_roles_;
+  std::unordered_map<std::string, RemoteTable> remote_tables_;
+  uint64_t discovery_start_time_ns_ = 0;
+  SyncStats sync_stats_;
 };
 
 }  // namespace service_discovery
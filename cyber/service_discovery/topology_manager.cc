@@ -125,13 +125,19 @@ void TopologyManager::OnParticipantChange(const PartInfo& info) {
     return;
   }
 
+  auto& host_name = msg.role_attr().host_name();
+  int process_id = msg.role_attr().process_id();
   if (msg.operate_type() == OperateType::OPT_LEAVE) {
-    auto& host_name = msg.role_attr().host_name();
-    int process_id = msg.role_attr().process_id();
     node_manager_->OnTopoModuleLeave(host_name, process_id);
     channel_manager_->OnTopoModuleLeave(host_name, process_id);
     service_manager_->OnTopoModuleLeave(host_name, process_id);
   }
+  node_manager_->OnParticipantChange(host_name, process_id,
+                                     msg.operate_type());
+  channel_manager_->OnParticipantChange(host_name, process_id,
+                                        msg.operate_type());
+  service_manager_->OnParticipantChange(host_name, process_id,
+                                        msg.operate_type());
   change_signal_(msg);
 }
 
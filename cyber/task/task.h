@@ -32,6 +32,18 @@ static auto Async(F&& f, Args&&... args)
                                           std::forward<Args>(args)...);
 }
 
+// Runs func(i) for every i in [begin, end) on the task pool and the caller,
+// |grain| consecutive indices per chunk, and returns when all have run.
+template <typename F>
+static void ParallelFor(size_t begin, size_t end, size_t grain, F&& func) {
+  TaskManager::Instance()->ParallelFor(
+      begin, end, grain, [&func](size_t chunk_begin, size_t chunk_end) {
+        for (auto i = chunk_begin; i < chunk_end; ++i) {
+          func(i);
+        }
+      });
+}
+
 static inline void Yield() {
   if (croutine::CRoutine::GetCurrentRoutine()) {
     croutine::CRoutine::Yield();
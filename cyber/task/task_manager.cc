@@ -16,6 +16,9 @@
 
 #include "cyber/task/task_manager.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "cyber/common/global_data.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/croutine/routine_factory.h"
@@ -27,6 +30,37 @@ namespace cyber {
 using apollo::cyber::common::GlobalData;
 static const char* const task_prefix = "/internal/task";
 
+namespace {
+
+// Shared by the caller and the pool helpers of one ParallelFor. Helpers
+// started after the range ran out only touch |next|, so the caller may
+// return, and |func| go away, as soon as |done| covers the range.
+struct ParallelForState {
+  ParallelForState(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)>* func)
+      : next(begin), end(end), grain(grain), func(func) {}
+
+  // false once every chunk has been claimed
+  bool RunChunk() {
+    auto begin = next.fetch_add(grain, std::memory_order_relaxed);
+    if (begin >= end) {
+      return false;
+    }
+    auto chunk_end = std::min(begin + grain, end);
+    (*func)(begin, chunk_end);
+    done.fetch_add(chunk_end - begin, std::memory_order_release);
+    return true;
+  }
+
+  std::atomic<size_t> next;
+  std::atomic<size_t> done = {0};
+  const size_t end;
+  const size_t grain;
+  const std::function<void(size_t, size_t)>* func;
+};
+
+}  // namespace
+
 TaskManager::TaskManager()
     : task_queue_size_(1000),
       task_queue_(new base::BoundedQueue<std::function<void()>>()) {
@@ -34,6 +68,17 @@ TaskManager::TaskManager()
     AERROR << "Task queue init failed";
     throw std::runtime_error("Task queue init failed");
   }
+  auto pool_size = scheduler::Instance()->TaskPoolSize();
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_scheduler_conf() &&
+      global_conf.scheduler_conf().thread_task_pool()) {
+    thread_pool_.reset(
+        new base::WorkStealingPool(pool_size, [](std::thread* thr) {
+          scheduler::Instance()->SetInnerThreadAttr("task_pool", thr);
+        }));
+    return;
+  }
+
   auto func = [this]() {
     while (!stop_) {
       std::function<void()> task;
@@ -46,7 +91,6 @@ TaskManager::TaskManager()
     }
   };
 
-  auto pool_size = scheduler::Instance()->TaskPoolSize();
   auto factory = croutine::CreateRoutineFactory(std::move(func));
   tasks_.reserve(pool_size);
   for (uint32_t i = 0; i < pool_size; i++) {
@@ -58,10 +102,73 @@ TaskManager::TaskManager()
 
 TaskManager::~TaskManager() { Shutdown(); }
 
+size_t TaskManager::EnqueueBatch(std::vector<std::function<void()>>* funcs) {
+  if (stop_.load()) {
+    return 0;
+  }
+  size_t num = 0;
+  if (thread_pool_) {
+    for (auto& func : *funcs) {
+      num += thread_pool_->Submit(std::move(func));
+    }
+    return num;
+  }
+  for (auto& func : *funcs) {
+    if (!task_queue_->Enqueue(std::move(func))) {
+      AWARN << "Task queue is full, " << funcs->size() - num
+            << " tasks dropped.";
+      break;
+    }
+    ++num;
+  }
+  // each pool routine drains the queue until it is empty
+  auto wake = std::min(num, tasks_.size());
+  for (size_t i = 0; i < wake; ++i) {
+    scheduler::Instance()->NotifyTask(tasks_[i]);
+  }
+  return num;
+}
+
+void TaskManager::ParallelFor(
+    size_t begin, size_t end, size_t grain,
+    const std::function<void(size_t, size_t)>& func) {
+  if (begin >= end) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1);
+  auto num = end - begin;
+  auto pool_num = thread_pool_ ? thread_pool_->size() : tasks_.size();
+  auto helper_num = std::min((num - 1) / grain, pool_num);
+  if (helper_num == 0 || stop_.load()) {
+    func(begin, end);
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>(begin, end, grain, &func);
+  std::vector<std::function<void()>> helpers(helper_num, [state]() {
+    while (state->RunChunk()) {
+    }
+  });
+  EnqueueBatch(&helpers);
+
+  while (state->RunChunk()) {
+  }
+  // only chunks already running on helpers are left
+  while (state->done.load(std::memory_order_acquire) < num) {
+    if (croutine::CRoutine::GetCurrentRoutine()) {
+      croutine::CRoutine::Yield();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
 void TaskManager::Shutdown() {
   if (stop_.exchange(true)) {
     return;
   }
+  // joins the pool threads after they ran what is still queued
+  thread_pool_.reset();
 
   for (uint32_t i = 0; i < num_threads_; i++) {
     scheduler::Instance()->RemoveTask(task_prefix + std::to_string(i));
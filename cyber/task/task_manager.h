@@ -18,6 +18,7 @@
 #define CYBER_TASK_TASK_MANAGER_H_
 
 #include <atomic>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -26,6 +27,7 @@
 #include <vector>
 
 #include "cyber/base/bounded_queue.h"
+#include "cyber/base/work_stealing_pool.h"
 #include "cyber/scheduler/scheduler_factory.h"
 
 namespace apollo {
@@ -43,7 +45,9 @@ class TaskManager {
     using return_type = typename std::result_of<F(Args...)>::type;
     auto task = std::make_shared<std::packaged_task<return_type()>>(
         std::bind(std::forward<F>(func), std::forward<Args>(args)...));
-    if (!stop_.load()) {
+    if (!stop_.load() && thread_pool_) {
+      thread_pool_->Submit([task]() { (*task)(); });
+    } else if (!stop_.load()) {
       task_queue_->Enqueue([task]() { (*task)(); });
       for (auto& task : tasks_) {
         scheduler::Instance()->NotifyTask(task);
@@ -53,12 +57,25 @@ class TaskManager {
     return res;
   }
 
+  // Enqueues every function of |funcs| and wakes the pool once for all of
+  // them. Returns the number enqueued; the rest are dropped on a full queue.
+  size_t EnqueueBatch(std::vector<std::function<void()>>* funcs);
+
+  // Splits [begin, end) into chunks of |grain| indices and runs
+  // func(chunk_begin, chunk_end) on the task pool and on the caller until
+  // every chunk is done. Whatever the range size it queues at most one entry
+  // per pool routine, and no future or task object per chunk.
+  void ParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)>& func);
+
  private:
   uint32_t num_threads_ = 0;
   uint32_t task_queue_size_ = 1000;
   std::atomic<bool> stop_ = {false};
   std::vector<uint64_t> tasks_;
   std::shared_ptr<base::BoundedQueue<std::function<void()>>> task_queue_;
+  // set by scheduler_conf.thread_task_pool, replaces the croutine pool
+  std::unique_ptr<base::WorkStealingPool> thread_pool_;
   DECLARE_SINGLETON(TaskManager);
 };
 
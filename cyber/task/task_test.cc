@@ -17,6 +17,8 @@
 #include "cyber/task/task.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -96,6 +98,34 @@ TEST(AsyncTest, run_member_function) {
   foo.RunOnce();
 }
 
+TEST(AsyncTest, parallel_for) {
+  std::vector<std::atomic<int>> visits(1000);
+  for (auto& visit : visits) {
+    visit.store(0);
+  }
+  ParallelFor(0, visits.size(), 16, [&visits](size_t i) { ++visits[i]; });
+  for (auto& visit : visits) {
+    EXPECT_EQ(1, visit.load());
+  }
+
+  // one chunk runs on the caller
+  int sum = 0;
+  ParallelFor(10, 20, 100, [&sum](size_t i) { sum += static_cast<int>(i); });
+  EXPECT_EQ(145, sum);
+
+  ParallelFor(5, 5, 1, [](size_t) { ADD_FAILURE(); });
+}
+
+TEST(AsyncTest, enqueue_batch) {
+  std::atomic<int> count = {0};
+  std::vector<std::function<void()>> funcs(10, [&count]() { ++count; });
+  EXPECT_EQ(10, TaskManager::Instance()->EnqueueBatch(&funcs));
+  while (count.load() < 10) {
+    usleep(1000);
+  }
+  EXPECT_EQ(10, count.load());
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
@@ -42,8 +42,8 @@ void Timer::Start() {
   }
 
   if (!started_.exchange(true)) {
-    timer_id_ =
-        tm_->Add(timer_opt_.period, timer_opt_.callback, timer_opt_.oneshot);
+    timer_id_ = tm_->Add(timer_opt_.period, timer_opt_.callback,
+                         timer_opt_.oneshot, stats_);
   }
 }
 
@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "cyber/timer/timer_manager.h"
+#include "cyber/timer/timer_statistics.h"
 
 namespace apollo {
 namespace cyber {
@@ -73,11 +74,18 @@ class Timer {
    */
   void Stop();
 
+  /**
+   * @brief Get the fire jitter of the timer, kept across restarts
+   */
+  const TimerStatistics& statistics() const { return *stats_; }
+
  private:
   TimerOption timer_opt_;
   TimerManager* tm_ = nullptr;
   uint64_t timer_id_ = 0;
   std::atomic<bool> started_ = {false};
+  std::shared_ptr<TimerStatistics> stats_ =
+      std::make_shared<TimerStatistics>();
 };
 
 }  // namespace cyber
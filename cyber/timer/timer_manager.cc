@@ -16,18 +16,21 @@
 
 #include "cyber/timer/timer_manager.h"
 
+#include <sys/prctl.h>
+
+#include <chrono>
+
 #include "cyber/common/log.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/time/duration.h"
-#include "cyber/time/rate.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
 TimerManager::TimerManager()
-    : timing_wheel_(Duration(0.01)),
-      time_gran_(Duration(0.01)),
-      running_(false) {}  // default time gran = 1ms
+    : timing_wheel_(Duration(0.0001)),
+      running_(false) {}  // default time gran = 100us
 
 TimerManager::~TimerManager() {
   if (running_) {
@@ -49,6 +52,10 @@ void TimerManager::Shutdown() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (running_) {
     running_ = false;
+    {
+      std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+      wake_cv_.notify_one();
+    }
     if (scheduler_thread_.joinable()) {
       scheduler_thread_.join();
     }
@@ -56,11 +63,17 @@ void TimerManager::Shutdown() {
 }
 
 uint64_t TimerManager::Add(uint64_t interval, std::function<void()> handler,
-                           bool oneshot) {
+                           bool oneshot,
+                           const std::shared_ptr<TimerStatistics>& stats) {
   if (!running_) {
     Start();
   }
-  uint64_t timer_id = timing_wheel_.StartTimer(interval, handler, oneshot);
+  uint64_t timer_id =
+      timing_wheel_.StartTimer(interval, handler, oneshot, stats);
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
   return timer_id;
 }
 
@@ -71,10 +84,15 @@ void TimerManager::Remove(uint64_t timer_id) {
 bool TimerManager::IsRunning() { return running_; }
 
 void TimerManager::ThreadFuncImpl() {
-  Rate rate(time_gran_);
+  // the default 50us slack would be most of a tick
+  prctl(PR_SET_TIMERSLACK, 1000UL);
+  std::unique_lock<std::mutex> lock(wake_mutex_);
   while (running_) {
-    timing_wheel_.Step();
-    rate.Sleep();
+    auto next = timing_wheel_.Advance(Time::MonoTime().ToNanosecond());
+    // steady_clock is Time::MonoTime's clock, waits on absolute deadlines
+    // do not drift with the time spent firing
+    wake_cv_.wait_until(lock, std::chrono::steady_clock::time_point(
+                                  std::chrono::nanoseconds(next)));
   }
 }
 
@@ -17,6 +17,7 @@
 #ifndef CYBER_TIMER_TIMER_MANAGER_H_
 #define CYBER_TIMER_TIMER_MANAGER_H_
 
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -38,15 +39,18 @@ class TimerManager {
   void Start();
   void Shutdown();
   bool IsRunning();
-  uint64_t Add(uint64_t interval, std::function<void()> handler, bool oneshot);
+  uint64_t Add(uint64_t interval, std::function<void()> handler, bool oneshot,
+               const std::shared_ptr<TimerStatistics>& stats = nullptr);
   void Remove(uint64_t timer_id);
 
  private:
   TimingWheel timing_wheel_;
-  Duration time_gran_;
   bool running_ = false;
   mutable std::mutex running_mutex_;
   std::thread scheduler_thread_;
+  // wakes the timer thread early when a timer is added or on shutdown
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
   void ThreadFuncImpl();
 
   DECLARE_SINGLETON(TimerManager)
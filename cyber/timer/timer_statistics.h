@@ -0,0 +1,40 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_TIMER_STATISTICS_H_
+#define CYBER_TIMER_TIMER_STATISTICS_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "cyber/croutine/detail/routine_statistics.h"
+
+namespace apollo {
+namespace cyber {
+
+// Handlers of one timer never overlap, so the histogram keeps its single
+// writer.
+struct TimerStatistics {
+  // from the ideal deadline, init time + n * period, to the handler start
+  croutine::RoutineHistogram jitter;
+  // fires whose handler started after the next deadline had already passed
+  std::atomic<uint64_t> overrun_count = {0};
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_TIMER_STATISTICS_H_
@@ -16,30 +16,23 @@
 
 #include "cyber/timer/timer_task.h"
 
-#include "cyber/task/task.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
-void TimerTask::Fire(bool async) {
-  if (status_ != INIT) {
-    return;
-  }
-  if (oneshot_)  // not repeat. so always on ready
-    status_ = EXPIRED;
-  if (async) {
-    cyber::Async(handler_);
-  } else {
-    handler_();
+void TimerTask::Run(uint64_t deadline) {
+  std::lock_guard<std::mutex> lock(run_mutex_);
+  if (stats_ != nullptr) {
+    auto now = Time::MonoTime().ToNanosecond();
+    auto jitter = now > deadline ? now - deadline : 0;
+    stats_->jitter.Add(jitter);
+    if (jitter >= interval_ * 1000 * 1000) {
+      stats_->overrun_count.fetch_add(1, std::memory_order_relaxed);
+    }
   }
+  handler_();
 }
 
-bool TimerTask::Cancel() {
-  if (State() != INIT) {
-    return false;
-  }
-  status_ = CANCELED;
-  return true;
-}
 }  // namespace cyber
 }  // namespace apollo
@@ -17,55 +17,60 @@
 #ifndef CYBER_TIMER_TIMER_TASK_H_
 #define CYBER_TIMER_TIMER_TASK_H_
 
-#include <algorithm>
-#include <iostream>
+#include <functional>
 #include <list>
-#include <map>
 #include <memory>
 #include <mutex>
-#include <thread>
-#include <unordered_map>
-#include <utility>
-#include <vector>
 
-#include "cyber/base/bounded_queue.h"
+#include "cyber/timer/timer_statistics.h"
 
 namespace apollo {
 namespace cyber {
 
 using CallHandler = std::function<void()>;
 
+class TimerTask;
+class TimingSlot;
+using TimerTaskList = std::list<std::shared_ptr<TimerTask>>;
+
 class TimerTask {
  public:
-  TimerTask(uint64_t id, uint64_t it, uint64_t ivl, CallHandler h, bool ons)
-      : tid_(id), init_time_(it), interval_(ivl), handler_(h), oneshot_(ons) {}
-  TimerTask() = default;
+  TimerTask(uint64_t id, uint64_t it, uint64_t ivl, CallHandler h, bool ons,
+            const std::shared_ptr<TimerStatistics>& stats = nullptr)
+      : tid_(id),
+        init_time_(it),
+        interval_(ivl),
+        handler_(h),
+        oneshot_(ons),
+        stats_(stats) {}
+
+  uint64_t Id() const { return tid_; }
+
+  // monotonic time of the next fire, in nanoseconds
+  uint64_t Deadline() const {
+    return init_time_ + (fire_count_ + 1) * interval_ * 1000 * 1000;
+  }
+
+  // runs the handler for the fire which was due at |deadline|
+  void Run(uint64_t deadline);
 
  private:
-  enum STATS { INIT = 0, CANCELED, EXPIRED };
-  STATS State() { return status_; }
-  volatile STATS status_ = INIT;
-  uint64_t tid_ = 0;
+  friend class TimingSlot;
+  friend class TimingWheel;
 
- public:
+  uint64_t tid_ = 0;
   uint64_t init_time_ = 0;
-  uint64_t deadline_ = 0;
-  uint64_t interval_ = 0;
+  uint64_t interval_ = 0;  // in milliseconds
   CallHandler handler_;
-  uint64_t rest_rounds_ = 0;
   bool oneshot_ = true;
   uint64_t fire_count_ = 0;
+  std::shared_ptr<TimerStatistics> stats_;
+  std::mutex run_mutex_;
 
- public:
-  uint64_t Id() { return tid_; }
-
-  void Fire(bool async);
-
-  bool Cancel();
-
-  bool IsCanceled() { return State() == CANCELED; }
-
-  bool IsExpired() { return State() == EXPIRED; }
+  // position in the wheel, owned by TimingWheel under its lock
+  uint64_t expire_tick_ = 0;
+  TimingSlot* slot_ = nullptr;
+  TimerTaskList::iterator slot_it_;
 };
 
 }  // namespace cyber
@@ -16,50 +16,28 @@
 
 #include "cyber/timer/timing_slot.h"
 
-#include "cyber/common/log.h"
-#include "cyber/timer/timer_task.h"
-
 namespace apollo {
 namespace cyber {
 
 void TimingSlot::AddTask(const std::shared_ptr<TimerTask>& task) {
-  tasks_.emplace(task->Id(), task);
+  task->slot_it_ = tasks_.insert(tasks_.end(), task);
+  task->slot_ = this;
 }
 
-void TimingSlot::EnumTaskList(
-    uint64_t deadline, bool async, BoundedQueue<HandlePackage>* hander_queue,
-    BoundedQueue<std::shared_ptr<TimerTask>>* rep_queue) {
-  for (auto it = tasks_.begin(); it != tasks_.end();) {
-    auto task = it->second;  // *it;
-    auto del_it = it;
-    it++;
-    // std::cout << "judge: task->" << task->deadline << " : " << deadline;
-    if (task->deadline_ <= deadline) {
-      if (task->rest_rounds_ == 0) {
-        if (async) {
-          HandlePackage hp;
-          hp.handle = task->handler_;
-          hp.id = task->Id();
-          if (!hander_queue->Enqueue(hp)) {
-            AERROR << "hander queue is full";
-          }
-        } else {
-          task->Fire(false);
-        }
-
-        if (!task->oneshot_) {  // repeat timer,push back
-          task->fire_count_++;
-          rep_queue->Enqueue(task);
-        }
-        tasks_.erase(del_it);
+void TimingSlot::RemoveTask(const std::shared_ptr<TimerTask>& task) {
+  if (task->slot_ != this) {
+    return;
+  }
+  tasks_.erase(task->slot_it_);
+  task->slot_ = nullptr;
+}
 
-      } else {
-        AERROR << "task deadline overflow...";
-      }
-    } else {  // no expired, -- rounds
-      task->rest_rounds_--;
-    }
+void TimingSlot::TakeTasks(TimerTaskList* tasks) {
+  for (auto& task : tasks_) {
+    task->slot_ = nullptr;
   }
+  tasks->splice(tasks->end(), tasks_);
 }
+
 }  // namespace cyber
 }  // namespace apollo
@@ -17,45 +17,28 @@
 #ifndef CYBER_TIMER_TIMING_SLOT_H_
 #define CYBER_TIMER_TIMING_SLOT_H_
 
-#include <algorithm>
-#include <iostream>
-#include <list>
-#include <map>
 #include <memory>
-#include <mutex>
-#include <thread>
-#include <unordered_map>
-#include <utility>
-#include <vector>
 
-#include "cyber/base/bounded_queue.h"
+#include "cyber/timer/timer_task.h"
 
 namespace apollo {
 namespace cyber {
 
-using apollo::cyber::base::BoundedQueue;
-using CallHandler = std::function<void()>;
-
-class TimerTask;
-
-struct HandlePackage {
-  uint64_t id;
-  CallHandler handle;
-};
-
+// Tasks remember their own position, so add and remove are O(1). Guarded by
+// the owning TimingWheel's lock.
 class TimingSlot {
- private:
-  //  no needs for multi-thread
-  std::unordered_map<uint64_t, std::shared_ptr<TimerTask>> tasks_;
-
  public:
   TimingSlot() = default;
+
+  bool Empty() const { return tasks_.empty(); }
   void AddTask(const std::shared_ptr<TimerTask>& task);
-  void RemoveTask(uint64_t id) { tasks_.erase(id); }
+  void RemoveTask(const std::shared_ptr<TimerTask>& task);
 
-  void EnumTaskList(uint64_t deadline, bool async,
-                    BoundedQueue<HandlePackage>* hander_queue,
-                    BoundedQueue<std::shared_ptr<TimerTask>>* rep_list);
+  // moves every task out of the slot
+  void TakeTasks(TimerTaskList* tasks);
+
+ private:
+  TimerTaskList tasks_;
 };  // TimeSlot end
 
 }  // namespace cyber
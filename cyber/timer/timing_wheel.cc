@@ -18,161 +18,157 @@
 
 #include <algorithm>
 
-#include "cyber/base/for_each.h"
 #include "cyber/common/log.h"
 #include "cyber/task/task.h"
 #include "cyber/time/time.h"
-#include "cyber/timer/timer_task.h"
 
 namespace apollo {
 namespace cyber {
 
-TimingWheel::TimingWheel() {
-  if (!add_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Add queue init failed.";
-    throw std::runtime_error("Add queue init failed.");
-  }
-  if (!repeat_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Repeated task queue init failed.";
-    throw std::runtime_error("Repeated queue init failed.");
-  }
-  if (!handler_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Handler queue init failed.";
-    throw std::runtime_error("Handler queue init failed.");
-  }
-}
+TimingWheel::TimingWheel() : TimingWheel(Duration(0.01)) {}
 
-TimingWheel::TimingWheel(const Duration& tick_duration) {
-  tick_duration_ = tick_duration.ToNanosecond();
-  resolution_ = tick_duration_ / 1000000UL;
-  if (!add_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Add queue init failed.";
-    throw std::runtime_error("Add queue init failed.");
-  }
-  if (!repeat_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Repeated task queue init failed.";
-    throw std::runtime_error("Repeated queue init failed.");
-  }
-  if (!handler_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Handler queue init failed.";
-    throw std::runtime_error("Handler queue init failed.");
+TimingWheel::TimingWheel(const Duration& tick_duration)
+    : start_time_(Time::MonoTime().ToNanosecond()) {
+  tick_duration_ = std::max<uint64_t>(tick_duration.ToNanosecond(), 1);
+  for (uint32_t level = 0; level < TIMING_WHEEL_LEVEL_NUM; ++level) {
+    levels_[level].resize(Mask(level) + 1);
   }
 }
 
-uint64_t TimingWheel::StartTimer(uint64_t interval, CallHandler handler,
-                                 bool oneshot) {
-  if (id_counter_ > UINT64_MAX) {
-    AERROR << "Timer ID pool is full.";
-    return -1;
-  } else if (interval > TIMER_TASK_MAX_INTERVAL) {
-    AERROR << "The interval of timer task MUST less than or equal "
-           << TIMER_TASK_MAX_INTERVAL << "ms.";
+uint64_t TimingWheel::StartTimer(
+    uint64_t interval, CallHandler handler, bool oneshot,
+    const std::shared_ptr<TimerStatistics>& stats) {
+  if (interval == 0) {
+    AERROR << "The interval of timer task MUST larger than 0ms.";
     return -1;
-  } else if (interval < resolution_) {
-    AERROR << "The interval of timer task MUST larger than or equal "
-           << resolution_ << "ms.";
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (id_counter_ == UINT64_MAX) {
+    AERROR << "Timer ID pool is full.";
     return -1;
   }
-  auto now = Time::Now().ToNanosecond();
   auto task = std::make_shared<TimerTask>(
-      ++id_counter_, now, interval,
-      [handler](void) {
-        static std::mutex task_mutex;
-        std::lock_guard<std::mutex> lock(task_mutex);
-        handler();
-      },
-      oneshot);
-  if (add_queue_.Enqueue(task)) {
-    ADEBUG << "start timer id: " << id_counter_;
-    return id_counter_;
-  } else {
-    --id_counter_;
-    AERROR << "add queue is full, Enqueue failed!";
-    return -1;
+      ++id_counter_, Time::MonoTime().ToNanosecond(), interval, handler,
+      oneshot, stats);
+  tasks_.emplace(task->Id(), task);
+  AddTask(task);
+  ADEBUG << "start timer id: " << task->Id();
+  return task->Id();
+}
+
+void TimingWheel::StopTimer(uint64_t timer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tasks_.find(timer_id);
+  if (it == tasks_.end()) {
+    return;
+  }
+  if (it->second->slot_ != nullptr) {
+    it->second->slot_->RemoveTask(it->second);
   }
+  tasks_.erase(it);
 }
 
 void TimingWheel::Step() {
-  if (start_time_ == 0) {
-    start_time_ = Time::Now().ToNanosecond();
-  }
-  uint64_t deadline = tick_duration_ * (tick_ + 1);
-  uint64_t idx = tick_ & mask_;
-  RemoveCancelledTasks(idx);
-  FillAddSlot();
-  time_slots_[idx].EnumTaskList(deadline, true, &handler_queue_,
-                                &repeat_queue_);
-
-  // timing wheel tick one time
-  tick_++;
-
-  FillRepeatSlot();
-
-  while (!handler_queue_.Empty()) {
-    HandlePackage hp;
-    if (handler_queue_.Dequeue(&hp)) {
-      cyber::Async(hp.handle);
-    }
+  ExpiredList expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StepLocked(&expired);
   }
+  Fire(expired);
 }
 
-void TimingWheel::StopTimer(uint64_t timer_id) {
+uint64_t TimingWheel::Advance(uint64_t now) {
+  ExpiredList expired;
+  uint64_t next = 0;
   {
-    std::lock_guard<std::mutex> lg(cancelled_mutex_);
-    cancelled_list_.push_back(timer_id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (start_time_ + tick_ * tick_duration_ <= now) {
+      StepLocked(&expired);
+    }
+    next = start_time_ + NextWakeTick() * tick_duration_;
   }
+  Fire(expired);
+  return next;
 }
 
-void TimingWheel::RemoveCancelledTasks(uint64_t slot_index) {
-  if (slot_index >= TIMING_WHEEL_SIZE) {
-    return;
+void TimingWheel::StepLocked(ExpiredList* expired) {
+  if (tick_ != 0 && (tick_ & Mask(0)) == 0) {
+    Cascade();
   }
-  {
-    std::lock_guard<std::mutex> lg(cancelled_mutex_);
-    for (auto id : cancelled_list_) {
-      FOR_EACH(i, 0, TIMING_WHEEL_SIZE) { time_slots_[i].RemoveTask(id); }
+  TimerTaskList tasks;
+  levels_[0][tick_ & Mask(0)].TakeTasks(&tasks);
+
+  // timing wheel tick one time, repeated tasks are re-added after it
+  uint64_t current = tick_++;
+  for (auto& task : tasks) {
+    if (task->expire_tick_ > current) {
+      AddTask(task);
+      continue;
+    }
+    expired->emplace_back(task, task->Deadline());
+    if (task->oneshot_) {
+      tasks_.erase(task->Id());
+    } else {
+      ++task->fire_count_;
+      AddTask(task);
     }
-    cancelled_list_.clear();
   }
 }
 
-void TimingWheel::FillAddSlot() {
-  std::shared_ptr<TimerTask> task;
-  while (!add_queue_.Empty()) {
-    if (!add_queue_.Dequeue(&task)) {
-      return;
+void TimingWheel::Cascade() {
+  for (uint32_t level = 1; level < TIMING_WHEEL_LEVEL_NUM; ++level) {
+    auto index = (tick_ >> Shift(level)) & Mask(level);
+    TimerTaskList tasks;
+    levels_[level][index].TakeTasks(&tasks);
+    for (auto& task : tasks) {
+      AddTask(task);
+    }
+    if (index != 0) {
+      break;
     }
-    FillSlot(task);
   }
 }
 
-void TimingWheel::FillRepeatSlot() {
-  std::shared_ptr<TimerTask> task;
-  while (!repeat_queue_.Empty()) {
-    if (!repeat_queue_.Dequeue(&task)) {
+void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
+  auto deadline = task->Deadline();
+  auto elapsed = deadline > start_time_ ? deadline - start_time_ : 0;
+  // the first tick at or after the deadline, overdue tasks run next tick
+  task->expire_tick_ =
+      std::max((elapsed + tick_duration_ - 1) / tick_duration_, tick_);
+
+  auto delta = task->expire_tick_ - tick_;
+  for (uint32_t level = 0; level < TIMING_WHEEL_LEVEL_NUM; ++level) {
+    auto span = 1ULL << Shift(level + 1);
+    if (delta < span || level + 1 == TIMING_WHEEL_LEVEL_NUM) {
+      auto tick = delta < span ? task->expire_tick_ : tick_ + span - 1;
+      levels_[level][(tick >> Shift(level)) & Mask(level)].AddTask(task);
+      ADEBUG << "task id " << task->Id() << " insert to level " << level;
       return;
     }
-    FillSlot(task);
   }
 }
 
-void TimingWheel::FillSlot(const std::shared_ptr<TimerTask>& task) {
-  task->deadline_ = task->init_time_ +
-                    (task->fire_count_ + 1) * (task->interval_) * 1000 * 1000 -
-                    start_time_;
-
-  // Calculate how many tickes have been run since the time wheel start
-  uint64_t t = task->deadline_ / tick_duration_;  // perTick = 1ms
-  if (t < tick_) {
-    task->rest_rounds_ = 0;
-  } else {
-    task->rest_rounds_ = (t - tick_) / TIMING_WHEEL_SIZE;
+uint64_t TimingWheel::NextWakeTick() const {
+  // a wrap cascades the outer levels, so it is never slept over
+  if (tick_ != 0 && (tick_ & Mask(0)) == 0) {
+    return tick_;
+  }
+  auto wrap = (tick_ | Mask(0)) + 1;
+  for (auto tick = tick_; tick < wrap; ++tick) {
+    if (!levels_[0][tick & Mask(0)].Empty()) {
+      return tick;
+    }
   }
-  uint64_t ticks = std::max(t, tick_);  // right now
-  uint64_t idx = ticks & mask_;
-  time_slots_[idx].AddTask(task);
+  return wrap;
+}
 
-  ADEBUG << "task id " << task->Id() << " insert to index " << idx;
+void TimingWheel::Fire(const ExpiredList& expired) {
+  for (auto& item : expired) {
+    auto task = item.first;
+    auto deadline = item.second;
+    cyber::Async([task, deadline]() { task->Run(deadline); });
+  }
 }
+
 }  // namespace cyber
 }  // namespace apollo
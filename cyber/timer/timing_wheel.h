@@ -17,74 +17,85 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
-#include <algorithm>
-#include <functional>
-#include <iostream>
-#include <list>
-#include <map>
 #include <memory>
 #include <mutex>
-#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "cyber/base/bounded_queue.h"
 #include "cyber/time/duration.h"
+#include "cyber/timer/timer_task.h"
 #include "cyber/timer/timing_slot.h"
 
 namespace apollo {
 namespace cyber {
 
-using apollo::cyber::base::BoundedQueue;
 using CallHandler = std::function<void()>;
 
-static const int TIMING_WHEEL_SIZE = 128;
-static const int THREAD_POOL_SIZE = 4;
-static const uint64_t BOUNDED_QUEUE_SIZE = 200;
-static const int TIMER_TASK_MAX_INTERVAL = 1000;
-
-class TimerTask;
+// 256 slots at the finest level, then 64 slots per level, so with the
+// 100us tick of TimerManager the wheel spans about 1.8 hours. Longer
+// intervals wait on the outermost level and are re-cascaded.
+static const uint32_t TIMING_WHEEL_LEVEL_NUM = 4;
+static const uint32_t TIMING_WHEEL_ROOT_BITS = 8;
+static const uint32_t TIMING_WHEEL_LEVEL_BITS = 6;
 
+// Hierarchical timing wheel. Insert and cancel are O(1) under one lock;
+// a task sitting on an outer level is cascaded inwards as the finer levels
+// wrap, so it is only touched once per level whatever its interval.
 class TimingWheel {
  public:
   TimingWheel();
   explicit TimingWheel(const Duration& tick_duration);
   ~TimingWheel() = default;
 
-  uint64_t StartTimer(uint64_t interval, CallHandler handler, bool oneshot);
+  uint64_t StartTimer(
+      uint64_t interval, CallHandler handler, bool oneshot,
+      const std::shared_ptr<TimerStatistics>& stats = nullptr);
 
   void StopTimer(uint64_t timer_id);
 
+  // processes exactly one tick whatever the time
   void Step();
 
- private:
-  void FillAddSlot();
-  void FillRepeatSlot();
-  void FillSlot(const std::shared_ptr<TimerTask>& task);
+  // processes every tick due by |now|, a Time::MonoTime in nanoseconds, and
+  // returns when the next call is needed
+  uint64_t Advance(uint64_t now);
 
-  void RemoveCancelledTasks(uint64_t slot_index);
+  uint64_t tick_duration() const { return tick_duration_; }
+
+ private:
+  // tasks to run with the deadline they were due at
+  using ExpiredList =
+      std::vector<std::pair<std::shared_ptr<TimerTask>, uint64_t>>;
+
+  void StepLocked(ExpiredList* expired);
+  void Cascade();
+  void AddTask(const std::shared_ptr<TimerTask>& task);
+  uint64_t NextWakeTick() const;
+  void Fire(const ExpiredList& expired);
+
+  static uint32_t Shift(uint32_t level) {
+    return level == 0 ? 0
+                      : TIMING_WHEEL_ROOT_BITS +
+                            (level - 1) * TIMING_WHEEL_LEVEL_BITS;
+  }
+  static uint64_t Mask(uint32_t level) {
+    return level == 0 ? (1ULL << TIMING_WHEEL_ROOT_BITS) - 1
+                      : (1ULL << TIMING_WHEEL_LEVEL_BITS) - 1;
+  }
 
   uint64_t id_counter_ = 0;
 
+  // next tick to process, tick n covers start_time_ + n * tick_duration_
   uint64_t tick_ = 0;
 
   uint64_t start_time_ = 0;
 
-  TimingSlot time_slots_[TIMING_WHEEL_SIZE];
-
-  uint64_t mask_ = TIMING_WHEEL_SIZE - 1;
-
   uint64_t tick_duration_ = 10 * 1000 * 1000;  // 10ms
-  uint64_t resolution_ = 10;                   // 10ms
-
-  // we need implement a lock-free high performance concurrent queue.
-  // Now, just a blocking-queue just for works.
-  std::list<uint64_t> cancelled_list_;
-  std::mutex cancelled_mutex_;
-  BoundedQueue<std::shared_ptr<TimerTask>> add_queue_;
-  BoundedQueue<std::shared_ptr<TimerTask>> repeat_queue_;
-  BoundedQueue<HandlePackage> handler_queue_;
+
+  std::vector<TimingSlot> levels_[TIMING_WHEEL_LEVEL_NUM];
+  std::unordered_map<uint64_t, std::shared_ptr<TimerTask>> tasks_;
+  std::mutex mutex_;
 };
 
 }  // namespace cyber
@@ -18,12 +18,14 @@
 
 #include <gtest/gtest.h>
 #include <unistd.h>
+#include <algorithm>
 #include <atomic>
 #include <memory>
 
 #include "cyber/common/log.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -71,6 +73,67 @@ TEST(TimingWheelTest, Period) {
   }
 }
 
+TEST(TimingWheelTest, Cancel) {
+  TimingWheel tw;
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  tw.Step();
+  auto id = tw.StartTimer(10, f, false);
+  for (int i = 0; i < 5; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  auto count = th->count();
+  EXPECT_LE(3, count);
+  tw.StopTimer(id);
+  for (int i = 0; i < 5; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  EXPECT_EQ(count, th->count());
+}
+
+TEST(TimingWheelTest, Cascade) {
+  // 2s at 100us ticks has to come down through two outer levels
+  TimingWheel tw(Duration(0.0001));
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  tw.StartTimer(2000, f, true);
+  for (int i = 0; i < 19990; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  EXPECT_EQ(0, th->count());
+  for (int i = 0; i < 100; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  EXPECT_EQ(1, th->count());
+}
+
+TEST(TimingWheelTest, Advance) {
+  TimingWheel tw(Duration(0.0001));
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  auto stats = std::make_shared<TimerStatistics>();
+  tw.StartTimer(5, f, false, stats);
+
+  auto end = Time::MonoTime().ToNanosecond() + 52 * 1000 * 1000;
+  auto now = Time::MonoTime().ToNanosecond();
+  while (now < end) {
+    auto next = tw.Advance(now);
+    ASSERT_GT(next, now);
+    usleep((std::min(next, end) - now) / 1000);
+    now = Time::MonoTime().ToNanosecond();
+  }
+  usleep(10 * 1000);
+  // fires at 5, 10, ... 50ms
+  EXPECT_LE(9, th->count());
+  EXPECT_GE(10, th->count());
+  EXPECT_EQ(th->count(), stats->jitter.count());
+  EXPECT_GT(5 * 1000 * 1000, stats->jitter.mean());
+}
+
 }  // namespace cyber
 }  // namespace apollo
 
@@ -21,6 +21,7 @@
 #include "cyber/message/message_traits.h"
 #include "cyber/proto/role_attributes.pb.h"
 #include "cyber/proto/topology_change.pb.h"
+#include "cyber/transport/shm/channel_stats.h"
 
 #include <ncurses.h>
 #include <iomanip>
@@ -58,9 +59,16 @@ RenderableMessage* CyberTopologyMessage::Child(int lineNo) const {
   RenderableMessage* ret = nullptr;
   auto iter = findChild(lineNo);
   if (iter != all_channels_map_.cend() &&
-      !GeneralChannelMessage::isErrorCode(iter->second) &&
-      iter->second->is_enabled()) {
-    ret = iter->second;
+      !GeneralChannelMessage::isErrorCode(iter->second)) {
+    // channels watched through the shm stats are opened once looked into
+    if (!iter->second->is_enabled() &&
+        !GeneralChannelMessage::isErrorCode(
+            iter->second->OpenChannel(iter->first))) {
+      iter->second->add_reader(iter->second->NodeName());
+    }
+    if (iter->second->is_enabled()) {
+      ret = iter->second;
+    }
   }
   return ret;
 }
@@ -145,9 +153,12 @@ void CyberTopologyMessage::AddReaderWriter(
     channelMsg = new GeneralChannelMessage(outStr.str(), this);
 
     if (channelMsg != nullptr) {
-      if (!GeneralChannelMessage::isErrorCode(
+      channelMsg->set_channel_id(role.channel_id());
+      channelMsg->set_message_type(msgTypeName);
+      // without the shm stats the frame ratio needs a reader
+      if (!apollo::cyber::transport::ChannelStats::Instance()->enabled() &&
+          !GeneralChannelMessage::isErrorCode(
               channelMsg->OpenChannel(channelName))) {
-        channelMsg->set_message_type(msgTypeName);
         channelMsg->add_reader(channelMsg->NodeName());
       }
     } else {
@@ -242,7 +253,8 @@ void CyberTopologyMessage::Render(const Screen* s, int key) {
     color = Screen::RED_BLACK;
 
     if (!GeneralChannelMessage::isErrorCode(iter->second)) {
-      if (iter->second->has_message_come()) {
+      if (iter->second->has_message_come() ||
+          iter->second->has_message_published()) {
         if (iter->second->is_enabled()) {
           color = Screen::GREEN_BLACK;
         } else {
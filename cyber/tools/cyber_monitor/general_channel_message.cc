@@ -78,7 +78,39 @@ bool GeneralChannelMessage::isErrorCode(void* ptr) {
   return false;
 }
 
+bool GeneralChannelMessage::has_message_published(void) const {
+  apollo::cyber::transport::ChannelStatsInfo info;
+  return apollo::cyber::transport::ChannelStats::Instance()->Get(channel_id_,
+                                                                 &info) &&
+         info.msg_num > 0;
+}
+
+bool GeneralChannelMessage::UpdateStatsRatio(void) {
+  apollo::cyber::transport::ChannelStatsInfo info;
+  if (!apollo::cyber::transport::ChannelStats::Instance()->Get(channel_id_,
+                                                              &info)) {
+    return false;
+  }
+  auto time_now = apollo::cyber::Time::MonoTime();
+  auto interval = time_now - time_last_calc_;
+  if (interval.ToNanosecond() > 1000000000) {
+    if (stats_.channel_id != 0) {
+      frame_ratio_ =
+          static_cast<double>(info.msg_num - stats_.msg_num) /
+          interval.ToSecond();
+      byte_ratio_ = static_cast<double>(info.msg_bytes - stats_.msg_bytes) /
+                    interval.ToSecond();
+    }
+    stats_ = info;
+    time_last_calc_ = time_now;
+  }
+  return true;
+}
+
 double GeneralChannelMessage::frame_ratio(void) {
+  if (UpdateStatsRatio()) {
+    return frame_ratio_;
+  }
   if (!is_enabled() || !has_message_come()) return 0.0;
   auto time_now = apollo::cyber::Time::MonoTime();
   auto interval = time_now - time_last_calc_;
@@ -154,6 +186,8 @@ void GeneralChannelMessage::Render(const Screen* s, int key) {
   s->AddStr(0, lineNo++, "MessageType: ");
   s->AddStr(message_type().c_str());
 
+  RenderStats(s, &lineNo);
+
   if (is_enabled()) {
     switch (current_state_) {
       case State::ShowDebugString:
@@ -169,6 +203,24 @@ void GeneralChannelMessage::Render(const Screen* s, int key) {
   s->ClearCurrentColor();
 }
 
+void GeneralChannelMessage::RenderStats(const Screen* s, unsigned* lineNo) {
+  if (!UpdateStatsRatio()) {
+    return;
+  }
+  std::ostringstream outStr;
+  outStr << std::fixed << std::setprecision(FrameRatio_Precision)
+         << byte_ratio_ / 1024.0 << " KB/s";
+  s->AddStr(0, (*lineNo)++, "Bandwidth: ");
+  s->AddStr(outStr.str().c_str());
+
+  outStr.str("");
+  outStr << std::fixed << std::setprecision(FrameRatio_Precision)
+         << static_cast<double>(stats_.last_lag) / 1e6 << " ms (max "
+         << static_cast<double>(stats_.max_lag) / 1e6 << " ms)";
+  s->AddStr(0, (*lineNo)++, "ReaderLag: ");
+  s->AddStr(outStr.str().c_str());
+}
+
 void GeneralChannelMessage::RenderInfo(const Screen* s, int key,
                                        unsigned lineNo) {
   page_item_count_ = s->Height() - lineNo;
@@ -20,6 +20,7 @@
 #include <atomic>
 
 #include "cyber/message/raw_message.h"
+#include "cyber/transport/shm/channel_stats.h"
 #include "general_message_base.h"
 
 class CyberTopologyMessage;
@@ -70,6 +71,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
   bool is_enabled(void) const { return channel_reader_ != nullptr; }
   bool has_message_come(void) const { return has_message_come_; }
 
+  void set_channel_id(uint64_t channelId) { channel_id_ = channelId; }
+  // true once writers counted a message, the channel need not be open
+  bool has_message_published(void) const;
+
   double frame_ratio(void) override;
 
   const std::string& NodeName(void) const { return node_name_; }
@@ -105,6 +110,9 @@ class GeneralChannelMessage : public GeneralMessageBase {
         has_message_come_(false),
         message_type_(),
         frame_counter_(0),
+        channel_id_(0),
+        byte_ratio_(0.0),
+        stats_(),
         last_time_(apollo::cyber::Time::MonoTime()),
         msg_time_(last_time_.ToNanosecond() + 1),
         channel_node_(nullptr),
@@ -159,6 +167,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
 
   GeneralChannelMessage* OpenChannel(const std::string& channelName);
 
+  // rates from the counters in shm, false if the channel has none
+  bool UpdateStatsRatio(void);
+
+  void RenderStats(const Screen* s, unsigned* lineNo);
   void RenderDebugString(const Screen* s, int key, unsigned lineNo);
   void RenderInfo(const Screen* s, int key, unsigned lineNo);
 
@@ -169,6 +181,9 @@ class GeneralChannelMessage : public GeneralMessageBase {
   bool has_message_come_;
   std::string message_type_;
   std::atomic<int> frame_counter_;
+  uint64_t channel_id_;
+  double byte_ratio_;
+  apollo::cyber::transport::ChannelStatsInfo stats_;
   apollo::cyber::Time last_time_;
   apollo::cyber::Time msg_time_;
   apollo::cyber::Time time_last_calc_ = apollo::cyber::Time::MonoTime();
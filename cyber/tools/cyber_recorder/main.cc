@@ -24,6 +24,7 @@
 #include "cyber/common/file.h"
 #include "cyber/common/time_conversion.h"
 #include "cyber/init.h"
+#include "cyber/record/record_catalog.h"
 #include "cyber/tools/cyber_recorder/info.h"
 #include "cyber/tools/cyber_recorder/player/player.h"
 #include "cyber/tools/cyber_recorder/recorder.h"
@@ -31,21 +32,26 @@
 #include "cyber/tools/cyber_recorder/spliter.h"
 
 using apollo::cyber::common::GetFileName;
+using apollo::cyber::common::GetProtoFromFile;
 using apollo::cyber::common::StringToUnixSeconds;
 using apollo::cyber::common::UnixSecondsToString;
+using apollo::cyber::proto::CompressType;
+using apollo::cyber::proto::RecorderConf;
 using apollo::cyber::record::HeaderBuilder;
 using apollo::cyber::record::Info;
 using apollo::cyber::record::Player;
 using apollo::cyber::record::PlayParam;
+using apollo::cyber::record::RecordCatalog;
 using apollo::cyber::record::Recorder;
 using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:i:m:h";
+const char RECORD_OPTIONS[] = "o:ac:i:m:z:q:h";
 const char PLAY_OPTIONS[] = "f:c:lr:b:e:s:d:p:h";
 const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
+const char CATALOG_OPTIONS[] = "f:o:h";
 
 void DisplayUsage(const std::string& binary);
 void DisplayUsage(const std::string& binary, const std::string& command);
@@ -60,6 +66,7 @@ void DisplayUsage(const std::string& binary) {
             << "\trecord\tRecord same topic.\n"
             << "\tsplit\tSplit an exist record.\n"
             << "\trecover\tRecover an exist record.\n"
+            << "\tcatalog\tCatalog the indexes of exist records.\n"
             << std::endl;
 }
 
@@ -82,6 +89,8 @@ void DisplayUsage(const std::string& binary, const std::string& command) {
     DisplayUsage(binary, command, SPLIT_OPTIONS);
   } else if (command == "recover") {
     DisplayUsage(binary, command, RECOVER_OPTIONS);
+  } else if (command == "catalog") {
+    DisplayUsage(binary, command, CATALOG_OPTIONS);
   } else {
     std::cout << "Unknown command: " << command << std::endl;
     DisplayUsage(binary);
@@ -145,6 +154,15 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress <lz4|zstd>\t\t" << command
+                  << " with compressed chunks" << std::endl;
+        break;
+      case 'q':
+        std::cout << "\t-q, --qos-conf <file>\t\t\t" << command
+                  << " with the channel priorities of a RecorderConf"
+                  << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -170,7 +188,7 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:h";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:z:q:h";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -186,6 +204,8 @@ int main(int argc, char** argv) {
       {"preload", required_argument, nullptr, 'p'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", required_argument, nullptr, 'z'},
+      {"qos-conf", required_argument, nullptr, 'q'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
@@ -201,6 +221,7 @@ int main(int argc, char** argv) {
   uint64_t opt_delay = 0;
   uint32_t opt_preload = 3;
   auto opt_header = HeaderBuilder::GetHeader();
+  RecorderConf opt_recorder_conf;
 
   do {
     int opt =
@@ -346,6 +367,24 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'z':
+        if (std::string(optarg) == "lz4") {
+          opt_header.set_compress(CompressType::COMPRESS_LZ4);
+        } else if (std::string(optarg) == "zstd") {
+          opt_header.set_compress(CompressType::COMPRESS_ZSTD);
+        } else {
+          std::cout << "Invalid argument: -z/--compress " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        }
+        break;
+      case 'q':
+        if (!GetProtoFromFile(std::string(optarg), &opt_recorder_conf)) {
+          std::cout << "Invalid argument: -q/--qos-conf " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        }
+        break;
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -424,8 +463,10 @@ int main(int argc, char** argv) {
     }
     bool record_result = true;
     ::apollo::cyber::Init(argv[0]);
-    auto recorder = std::make_shared<Recorder>(opt_output_vec[0], opt_all,
-                                               opt_white_channels, opt_header);
+    auto recorder =
+        std::make_shared<Recorder>(opt_output_vec[0], opt_all,
+                                   opt_white_channels, opt_header,
+                                   opt_recorder_conf);
     record_result = record_result && recorder->Start() ? true : false;
     if (record_result) {
       while (!::apollo::cyber::IsShutdown()) {
@@ -452,6 +493,31 @@ int main(int argc, char** argv) {
                     opt_black_channels, opt_begin, opt_end);
     bool split_result = spliter.Proc();
     return split_result ? 0 : -1;
+  } else if (command == "catalog") {
+    if (opt_file_vec.empty()) {
+      std::cout << "MUST specify file option (-f)." << std::endl;
+      return -1;
+    }
+    if (opt_output_vec.size() > 1) {
+      std::cout << "TOO many output file option (-o)." << std::endl;
+      return -1;
+    }
+    if (opt_output_vec.empty()) {
+      opt_output_vec.push_back("records.catalog");
+    }
+    ::apollo::cyber::Init(argv[0]);
+    RecordCatalog catalog;
+    size_t skipped = 0;
+    for (const auto& file : opt_file_vec) {
+      if (!catalog.AddFile(file)) {
+        std::cout << "Skip record without index: " << file << std::endl;
+        ++skipped;
+      }
+    }
+    bool catalog_result = catalog.Save(opt_output_vec[0]);
+    std::cout << "Cataloged " << opt_file_vec.size() - skipped
+              << " record(s) in " << opt_output_vec[0] << std::endl;
+    return catalog_result ? 0 : -1;
   }
 
   // unknown command
@@ -34,6 +34,8 @@ struct PlayParam {
   uint64_t start_time_s = 0;
   uint64_t delay_time_s = 0;
   uint32_t preload_time_s = 3;
+  // chunks each record reader decodes ahead of playback
+  uint32_t prefetch_chunk_num = 2;
   std::set<std::string> files_to_play;
   std::set<std::string> channels_to_play;
 };
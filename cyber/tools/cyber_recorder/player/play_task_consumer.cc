@@ -16,6 +16,8 @@
 
 #include "cyber/tools/cyber_recorder/player/play_task_consumer.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
 
@@ -26,6 +28,7 @@ namespace record {
 const uint64_t PlayTaskConsumer::kPauseSleepNanoSec = 100000000UL;
 const uint64_t PlayTaskConsumer::kWaitProduceSleepNanoSec = 5000000UL;
 const uint64_t PlayTaskConsumer::MIN_SLEEP_DURATION_NS = 200000000UL;
+const uint64_t PlayTaskConsumer::kSpinWaitNanoSec = 200000UL;
 
 PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
                                    double play_rate)
@@ -65,6 +68,23 @@ void PlayTaskConsumer::Stop() {
   }
 }
 
+void PlayTaskConsumer::WaitUntil(uint64_t real_time_ns) {
+  while (!is_stopped_.load()) {
+    uint64_t now_ns = Time::Now().ToNanosecond();
+    if (now_ns >= real_time_ns) {
+      return;
+    }
+    uint64_t left_ns = real_time_ns - now_ns;
+    if (left_ns > kSpinWaitNanoSec) {
+      // sleep_for wakes up late by the timer slack, spin the last part
+      std::this_thread::sleep_for(std::chrono::nanoseconds(
+          std::min(left_ns - kSpinWaitNanoSec, MIN_SLEEP_DURATION_NS)));
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
 void PlayTaskConsumer::ThreadFunc() {
   uint64_t base_real_time_ns = 0;
   uint64_t accumulated_pause_time_ns = 0;
@@ -106,14 +126,20 @@ void PlayTaskConsumer::ThreadFunc() {
     uint64_t task_interval_ns = static_cast<uint64_t>(
         static_cast<double>(task->msg_play_time_ns() - base_msg_play_time_ns_) /
         play_rate_);
-    uint64_t real_time_interval_ns = Time::Now().ToNanosecond() -
-                                     base_real_time_ns -
-                                     accumulated_pause_time_ns;
-    if (task_interval_ns > real_time_interval_ns) {
-      sleep_ns = task_interval_ns - real_time_interval_ns;
-      std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+    uint64_t play_real_time_ns =
+        base_real_time_ns + accumulated_pause_time_ns + task_interval_ns;
+    WaitUntil(play_real_time_ns);
+    if (is_stopped_.load()) {
+      break;
     }
 
+    uint64_t now_ns = Time::Now().ToNanosecond();
+    uint64_t lag_ns =
+        now_ns > play_real_time_ns ? now_ns - play_real_time_ns : 0;
+    last_lag_ns_.store(lag_ns);
+    if (lag_ns > max_lag_ns_.load()) {
+      max_lag_ns_.store(lag_ns);
+    }
     task->Play();
     is_playonce_.exchange(false);
 
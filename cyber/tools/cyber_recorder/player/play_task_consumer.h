@@ -48,9 +48,14 @@ class PlayTaskConsumer {
   uint64_t last_played_msg_real_time_ns() const {
     return last_played_msg_real_time_ns_;
   }
+  // how late the last task and the latest task so far were played
+  uint64_t last_lag_ns() const { return last_lag_ns_.load(); }
+  uint64_t max_lag_ns() const { return max_lag_ns_.load(); }
 
  private:
   void ThreadFunc();
+  // sleeps most of the way and spins the rest, returns at once when stopped
+  void WaitUntil(uint64_t real_time_ns);
 
   double play_rate_;
   ThreadPtr consume_th_;
@@ -62,9 +67,12 @@ class PlayTaskConsumer {
   uint64_t base_msg_play_time_ns_;
   uint64_t base_msg_real_time_ns_;
   uint64_t last_played_msg_real_time_ns_;
+  std::atomic<uint64_t> last_lag_ns_ = {0};
+  std::atomic<uint64_t> max_lag_ns_ = {0};
   static const uint64_t kPauseSleepNanoSec;
   static const uint64_t kWaitProduceSleepNanoSec;
   static const uint64_t MIN_SLEEP_DURATION_NS;
+  static const uint64_t kSpinWaitNanoSec;
 };
 
 }  // namespace record
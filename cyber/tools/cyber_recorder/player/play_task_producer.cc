@@ -17,6 +17,7 @@
 #include "cyber/tools/cyber_recorder/player/play_task_producer.h"
 
 #include <iostream>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "cyber/common/time_conversion.h"
@@ -113,6 +114,7 @@ bool PlayTaskProducer::ReadRecordInfo() {
       continue;
     }
 
+    record_reader->SetPrefetchChunkNum(play_param_.prefetch_chunk_num);
     record_readers_.emplace_back(record_reader);
 
     auto& channel_info = record_reader->channel_info();
@@ -261,7 +263,8 @@ void PlayTaskProducer::ThreadFunc() {
           continue;
         }
 
-        auto raw_msg = std::make_shared<message::RawMessage>(itr->content);
+        auto raw_msg = std::make_shared<message::RawMessage>();
+        raw_msg->message = std::move(itr->content);
         auto task = std::make_shared<PlayTask>(
             raw_msg, search->second, itr->time, itr->time + plus_time_ns);
         task_buffer_->Push(task);
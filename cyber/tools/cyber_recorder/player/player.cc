@@ -155,7 +155,9 @@ bool Player::Start() {
 
     std::cout << std::setprecision(3) << last_played_msg_real_time_s
               << "    Progress: " << progress_time_s << " / "
-              << total_progress_time_s;
+              << total_progress_time_s << "    Lag(ms): "
+              << static_cast<double>(consumer_->last_lag_ns()) / 1e6 << " / "
+              << static_cast<double>(consumer_->max_lag_ns()) / 1e6;
     std::cout.flush();
 
     if (producer_->is_stopped() && task_buffer_->Empty()) {
@@ -36,10 +36,26 @@ Recorder::Recorder(const std::string& output, bool all_channels,
       channel_vec_(channel_vec),
       header_(header) {}
 
+Recorder::Recorder(const std::string& output, bool all_channels,
+                   const std::vector<std::string>& channel_vec,
+                   const proto::Header& header,
+                   const proto::RecorderConf& conf)
+    : output_(output),
+      all_channels_(all_channels),
+      channel_vec_(channel_vec),
+      header_(header),
+      conf_(conf) {}
+
 Recorder::~Recorder() { Stop(); }
 
 bool Recorder::Start() {
   writer_.reset(new RecordWriter(header_));
+  // channel callbacks must not wait for the disk
+  WriterOptions options;
+  options.max_pending_chunk_num = 4;
+  options.non_blocking = true;
+  options.sync_policy = SyncPolicy::WRITEBACK;
+  writer_->SetWriterOptions(options);
   if (!writer_->Open(output_)) {
     AERROR << "Datafile open file error.";
     return false;
@@ -50,6 +66,11 @@ bool Recorder::Start() {
     AERROR << "create node failed, node: " << node_name;
     return false;
   }
+  if (!conf_.stats_channel().empty()) {
+    stats_writer_ =
+        node_->CreateWriter<proto::RecorderStats>(conf_.stats_channel());
+  }
+  pressure_ = PRESSURE_NONE;
   if (!InitReadersImpl()) {
     AERROR << " _init_readers error.";
     return false;
@@ -81,6 +102,7 @@ bool Recorder::Stop() {
     display_thread_->join();
     display_thread_ = nullptr;
   }
+  stats_writer_.reset();
   is_started_ = false;
   is_stopping_ = false;
   return true;
@@ -161,13 +183,14 @@ bool Recorder::InitReaderImpl(const std::string& channel_name,
   try {
     std::weak_ptr<Recorder> weak_this = shared_from_this();
     std::shared_ptr<ReaderBase> reader = nullptr;
-    auto callback = [weak_this, channel_name](
+    auto policy = CreateChannelPolicy(channel_name);
+    auto callback = [weak_this, channel_name, policy](
                         const std::shared_ptr<RawMessage>& raw_message) {
       auto share_this = weak_this.lock();
       if (!share_this) {
         return;
       }
-      share_this->ReaderCallback(raw_message, channel_name);
+      share_this->ReaderCallback(raw_message, channel_name, policy.get());
     };
     ReaderConfig config;
     config.channel_name = channel_name;
@@ -187,7 +210,8 @@ bool Recorder::InitReaderImpl(const std::string& channel_name,
 }
 
 void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
-                              const std::string& channel_name) {
+                              const std::string& channel_name,
+                              ChannelPolicy* policy) {
   if (!is_started_ || is_stopping_) {
     AERROR << "record procedure is not started or stopping.";
     return;
@@ -198,6 +222,10 @@ void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
     return;
   }
 
+  if (!ShouldRecord(policy)) {
+    return;
+  }
+
   message_time_ = Time::Now().ToNanosecond();
   if (!writer_->WriteMessage(channel_name, message, message_time_)) {
     AERROR << "write data fail, channel: " << channel_name;
@@ -207,12 +235,103 @@ void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
   message_count_++;
 }
 
+std::shared_ptr<Recorder::ChannelPolicy> Recorder::CreateChannelPolicy(
+    const std::string& channel_name) {
+  auto policy = std::make_shared<ChannelPolicy>();
+  policy->priority = conf_.default_priority();
+  // an exact name wins over the longest prefix
+  size_t prefix_size = 0;
+  for (const auto& item : conf_.channels()) {
+    const auto& name = item.channel_name();
+    bool is_prefix = !name.empty() && name.back() == '*';
+    if (!is_prefix && name == channel_name) {
+      policy->priority = item.priority();
+      policy->downsample = item.downsample();
+      break;
+    }
+    if (is_prefix && name.size() > prefix_size &&
+        channel_name.compare(0, name.size() - 1, name, 0, name.size() - 1) ==
+            0) {
+      prefix_size = name.size();
+      policy->priority = item.priority();
+      policy->downsample = item.downsample();
+    }
+  }
+  std::lock_guard<std::mutex> lock(policy_mutex_);
+  channel_policy_map_[channel_name] = policy;
+  return policy;
+}
+
+bool Recorder::ShouldRecord(ChannelPolicy* policy) {
+  uint64_t received = policy->received.fetch_add(1);
+  int pressure = pressure_.load();
+  bool record = true;
+  if (policy->priority == proto::PRIORITY_NORMAL) {
+    record = pressure < PRESSURE_FULL;
+  } else if (policy->priority == proto::PRIORITY_LOW) {
+    record = pressure == PRESSURE_NONE ||
+             (pressure == PRESSURE_HIGH && policy->downsample > 0 &&
+              received % policy->downsample == 0);
+  }
+  if (!record) {
+    policy->dropped.fetch_add(1);
+  }
+  return record;
+}
+
+void Recorder::UpdatePressure() {
+  uint64_t pending = writer_->GetWriterStats().pending_raw_size;
+  uint64_t limit = conf_.memory_limit_mb() * 1024 * 1024;
+  int pressure = PRESSURE_NONE;
+  if (pending >= limit) {
+    pressure = PRESSURE_FULL;
+  } else if (pending >= limit / 2) {
+    pressure = PRESSURE_HIGH;
+  }
+  int last_pressure = pressure_.exchange(pressure);
+  if (pressure > last_pressure) {
+    AWARN << "Writer is " << pending << " bytes behind, drop "
+          << (pressure == PRESSURE_FULL ? "all but high" : "low")
+          << " priority channels.";
+  }
+}
+
+void Recorder::PublishStats() {
+  if (stats_writer_ == nullptr) {
+    return;
+  }
+  auto stats = std::make_shared<proto::RecorderStats>();
+  stats->set_pending_bytes(writer_->GetWriterStats().pending_raw_size);
+  stats->set_memory_limit_bytes(conf_.memory_limit_mb() * 1024 * 1024);
+  {
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    for (const auto& item : channel_policy_map_) {
+      auto channel = stats->add_channels();
+      channel->set_channel_name(item.first);
+      channel->set_priority(item.second->priority);
+      channel->set_received(item.second->received.load());
+      channel->set_dropped(item.second->dropped.load());
+    }
+  }
+  stats_writer_->Write(stats);
+}
+
 void Recorder::ShowProgress() {
+  uint32_t loop_count = 0;
   while (is_started_ && !is_stopping_) {
+    UpdatePressure();
+    // every second
+    if (++loop_count % 10 == 0) {
+      PublishStats();
+    }
     std::cout << "\r[RUNNING]  Record Time: " << std::setprecision(3)
               << message_time_ / 1000000000
               << "    Progress: " << channel_reader_map_.size() << " channels, "
               << message_count_ << " messages";
+    auto stats = writer_->GetWriterStats();
+    std::cout << "    Queue: " << stats.pending_chunk_num << " / "
+              << stats.max_pending_chunk_num << " chunks, write "
+              << stats.max_write_latency_ns / 1000000 << " ms max";
     std::cout.flush();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
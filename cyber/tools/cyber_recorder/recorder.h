@@ -17,6 +17,7 @@
 #ifndef CYBER_TOOLS_CYBER_RECORDER_RECORDER_H_
 #define CYBER_TOOLS_CYBER_RECORDER_RECORDER_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -27,6 +28,7 @@
 #include "cyber/cyber.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/proto/record.pb.h"
+#include "cyber/proto/recorder_conf.pb.h"
 #include "cyber/proto/topology_change.pb.h"
 #include "cyber/record/record_writer.h"
 
@@ -51,11 +53,24 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
   Recorder(const std::string& output, bool all_channels,
            const std::vector<std::string>& channel_vec,
            const proto::Header& header);
+  Recorder(const std::string& output, bool all_channels,
+           const std::vector<std::string>& channel_vec,
+           const proto::Header& header, const proto::RecorderConf& conf);
   ~Recorder();
   bool Start();
   bool Stop();
 
  private:
+  struct ChannelPolicy {
+    proto::RecordPriority priority = proto::PRIORITY_NORMAL;
+    uint32_t downsample = 0;
+    std::atomic<uint64_t> received = {0};
+    std::atomic<uint64_t> dropped = {0};
+  };
+
+  // how far the writer is behind, by its pending bytes against the limit
+  enum Pressure { PRESSURE_NONE = 0, PRESSURE_HIGH, PRESSURE_FULL };
+
   bool is_started_ = false;
   bool is_stopping_ = false;
   std::shared_ptr<Node> node_ = nullptr;
@@ -70,6 +85,12 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
       channel_reader_map_;
   uint64_t message_count_;
   uint64_t message_time_;
+  proto::RecorderConf conf_;
+  std::atomic<int> pressure_ = {PRESSURE_NONE};
+  std::mutex policy_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<ChannelPolicy>>
+      channel_policy_map_;
+  std::shared_ptr<Writer<proto::RecorderStats>> stats_writer_ = nullptr;
 
   bool InitReadersImpl();
 
@@ -81,7 +102,16 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
   void TopologyCallback(const ChangeMsg& msg);
 
   void ReaderCallback(const std::shared_ptr<RawMessage>& message,
-                      const std::string& channel_name);
+                      const std::string& channel_name, ChannelPolicy* policy);
+
+  std::shared_ptr<ChannelPolicy> CreateChannelPolicy(
+      const std::string& channel_name);
+
+  bool ShouldRecord(ChannelPolicy* policy);
+
+  void UpdatePressure();
+
+  void PublishStats();
 
   void FindNewChannel(const RoleAttributes& role_attr);
 
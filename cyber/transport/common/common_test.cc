@@ -23,6 +23,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/common/identity.h"
+#include "cyber/transport/common/latency_statistics.h"
 
 namespace apollo {
 namespace cyber {
@@ -68,6 +69,37 @@ TEST(EndpointTest, endpoint_test) {
   EXPECT_NE(std::string("endpoint"), std::string(endpoint2.id().data()));
 }
 
+TEST(LatencyHistogramTest, buckets) {
+  for (uint64_t value = 0; value < 100000; value += 7) {
+    uint32_t index = LatencyHistogram::BucketIndex(value);
+    EXPECT_LE(value, LatencyHistogram::BucketUpperBound(index));
+    if (index > 0) {
+      EXPECT_GT(value, LatencyHistogram::BucketUpperBound(index - 1));
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::kBucketNum - 1,
+            LatencyHistogram::BucketIndex(UINT64_MAX));
+}
+
+TEST(LatencyHistogramTest, percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.min());
+  EXPECT_EQ(0, histogram.Percentile(50.0));
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Add(i * 1000);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(1000, histogram.min());
+  EXPECT_EQ(1000000, histogram.max());
+  EXPECT_EQ(500500, histogram.mean());
+  // buckets keep about 1/16 precision
+  EXPECT_NEAR(500000, histogram.Percentile(50.0), 500000 / 16);
+  EXPECT_NEAR(990000, histogram.Percentile(99.0), 990000 / 16);
+  EXPECT_EQ(1000000, histogram.Percentile(100.0));
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
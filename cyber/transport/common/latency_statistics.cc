@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/latency_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+const uint32_t LatencyHistogram::kSubBucketBits;
+const uint32_t LatencyHistogram::kSubBucketNum;
+const uint32_t LatencyHistogram::kMaxMagnitude;
+const uint32_t LatencyHistogram::kBucketNum;
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0),
+      sum_(0),
+      min_(std::numeric_limits<uint64_t>::max()),
+      max_(0) {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::~LatencyHistogram() {}
+
+void LatencyHistogram::Add(uint64_t latency) {
+  buckets_[BucketIndex(latency)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(latency, std::memory_order_relaxed);
+
+  uint64_t min = min_.load(std::memory_order_relaxed);
+  while (latency < min && !min_.compare_exchange_weak(
+                              min, latency, std::memory_order_relaxed)) {
+  }
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (latency > max && !max_.compare_exchange_weak(
+                              max, latency, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::min() const {
+  return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::mean() const {
+  uint64_t count = this->count();
+  return count == 0 ? 0 : sum_.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+  uint64_t counts[kBucketNum];
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < kBucketNum; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = static_cast<uint64_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(total)));
+  rank = std::max(rank, static_cast<uint64_t>(1));
+  uint64_t accumulated = 0;
+  for (uint32_t i = 0; i < kBucketNum; ++i) {
+    accumulated += counts[i];
+    if (accumulated >= rank) {
+      return std::min(BucketUpperBound(i), max());
+    }
+  }
+  return max();
+}
+
+uint32_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBucketNum) {
+    return static_cast<uint32_t>(value);
+  }
+  uint32_t magnitude = 63 - __builtin_clzll(value);
+  if (magnitude > kMaxMagnitude) {
+    return kBucketNum - 1;
+  }
+  uint32_t shift = magnitude - kSubBucketBits;
+  uint32_t sub_bucket =
+      static_cast<uint32_t>(value >> shift) & (kSubBucketNum - 1);
+  return kSubBucketNum + shift * kSubBucketNum + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(uint32_t index) {
+  if (index < kSubBucketNum) {
+    return index;
+  }
+  uint32_t shift = (index - kSubBucketNum) / kSubBucketNum;
+  uint64_t sub_bucket = (index - kSubBucketNum) % kSubBucketNum;
+  uint64_t lower = (kSubBucketNum + sub_bucket) << shift;
+  return lower + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+LatencyStatistics::LatencyStatistics() : enabled_(false) {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_transport_conf() &&
+      global_conf.transport_conf().has_latency_conf()) {
+    enabled_ = global_conf.transport_conf().latency_conf().enable();
+  }
+}
+
+LatencyStatistics::~LatencyStatistics() {}
+
+LatencyStatistics::HistogramPtr LatencyStatistics::GetHistogram(
+    uint64_t channel_id, OptionalMode mode) {
+  if (!enabled_) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& histogram = histograms_[std::make_pair(channel_id, mode)];
+  if (histogram == nullptr) {
+    histogram = std::make_shared<LatencyHistogram>();
+  }
+  return histogram;
+}
+
+void LatencyStatistics::Dump(proto::LatencyStats* stats) {
+  RETURN_IF_NULL(stats);
+  stats->set_host_name(GlobalData::Instance()->HostName());
+  stats->set_process_id(GlobalData::Instance()->ProcessId());
+  stats->set_timestamp(Time::Now().ToNanosecond());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& item : histograms_) {
+    auto& histogram = item.second;
+    if (histogram->count() == 0) {
+      continue;
+    }
+    auto result = stats->add_histograms();
+    result->set_channel_name(GlobalData::GetChannelById(item.first.first));
+    result->set_transport(static_cast<OptionalMode>(item.first.second));
+    result->set_count(histogram->count());
+    result->set_min_ns(histogram->min());
+    result->set_max_ns(histogram->max());
+    result->set_mean_ns(histogram->mean());
+    result->set_p50_ns(histogram->Percentile(50.0));
+    result->set_p90_ns(histogram->Percentile(90.0));
+    result->set_p99_ns(histogram->Percentile(99.0));
+    result->set_p999_ns(histogram->Percentile(99.9));
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
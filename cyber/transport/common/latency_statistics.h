@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_COMMON_LATENCY_STATISTICS_H_
+#define CYBER_TRANSPORT_COMMON_LATENCY_STATISTICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "cyber/common/macros.h"
+#include "cyber/proto/latency_stats.pb.h"
+#include "cyber/proto/transport_conf.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using apollo::cyber::proto::OptionalMode;
+
+// Log-linear histogram of latencies in nanoseconds. Every power of two is
+// split into kSubBucketNum buckets, so values are kept with about 6%
+// precision. Add is lock-free and safe to call from any thread.
+class LatencyHistogram {
+ public:
+  static const uint32_t kSubBucketBits = 4;
+  static const uint32_t kSubBucketNum = 1 << kSubBucketBits;
+  // values above 2^kMaxMagnitude ns (about 9 minutes) land in the last bucket
+  static const uint32_t kMaxMagnitude = 39;
+  static const uint32_t kBucketNum =
+      kSubBucketNum + (kMaxMagnitude - kSubBucketBits + 1) * kSubBucketNum;
+
+  LatencyHistogram();
+  virtual ~LatencyHistogram();
+
+  void Add(uint64_t latency);
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t min() const;
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t mean() const;
+  // |percentile| in [0, 100], returns the upper bound of the bucket holding it
+  uint64_t Percentile(double percentile) const;
+
+  static uint32_t BucketIndex(uint64_t value);
+  static uint64_t BucketUpperBound(uint32_t index);
+
+ private:
+  std::atomic<uint64_t> buckets_[kBucketNum];
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram)
+};
+
+class LatencyStatistics {
+ public:
+  using HistogramPtr = std::shared_ptr<LatencyHistogram>;
+
+  virtual ~LatencyStatistics();
+
+  bool enabled() const { return enabled_; }
+
+  // returns nullptr when latency statistics are disabled
+  HistogramPtr GetHistogram(uint64_t channel_id, OptionalMode mode);
+  void Dump(proto::LatencyStats* stats);
+
+ private:
+  bool enabled_;
+  std::map<std::pair<uint64_t, int>, HistogramPtr> histograms_;
+  std::mutex mutex_;
+
+  DECLARE_SINGLETON(LatencyStatistics)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_COMMON_LATENCY_STATISTICS_H_
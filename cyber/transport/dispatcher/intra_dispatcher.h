@@ -24,6 +24,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/lazy_message.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
@@ -68,6 +69,15 @@ void IntraDispatcher::OnMessage(uint64_t channel_id,
       auto handler =
           std::dynamic_pointer_cast<ListenerHandler<MessageT>>(*handler_base);
       if (handler == nullptr) {
+        // lazy readers get the message itself, nothing to serialize or parse
+        auto lazy_handler = std::dynamic_pointer_cast<
+            ListenerHandler<message::LazyMessage<MessageT>>>(*handler_base);
+        if (lazy_handler != nullptr) {
+          lazy_handler->Run(
+              std::make_shared<message::LazyMessage<MessageT>>(message),
+              message_info);
+          return;
+        }
         AERROR << "please ensure that readers with the same channel["
                << common::GlobalData::GetChannelById(channel_id)
                << "] in the same process have the same message type";
@@ -76,6 +76,24 @@ TEST(IntraDispatcherTest, on_message) {
   dispatcher->OnMessage(common::Hash("raw_channel"), send_raw_msg, msg_info);
 
   EXPECT_EQ(recv_raw_msg->message, send_raw_msg->message);
+
+  attr.set_channel_name("lazy_channel");
+  attr.set_channel_id(common::Hash("lazy_channel"));
+  Identity lazy_id;
+  attr.set_id(lazy_id.HashValue());
+  std::shared_ptr<proto::Chatter> recv_lazy_msg = nullptr;
+  dispatcher->AddListener<message::LazyMessage<proto::Chatter>>(
+      attr,
+      [&recv_lazy_msg](
+          const std::shared_ptr<message::LazyMessage<proto::Chatter>>& msg,
+          const MessageInfo& msg_info) {
+        (void)msg_info;
+        recv_lazy_msg = msg->Get();
+      });
+  dispatcher->OnMessage(common::Hash("lazy_channel"), send_pb_msg, msg_info);
+
+  // the written message is handed over as is
+  EXPECT_EQ(recv_lazy_msg, send_pb_msg);
 }
 
 }  // namespace transport
@@ -15,6 +15,9 @@
  *****************************************************************************/
 
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
+
+#include <algorithm>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/scheduler/scheduler_factory.h"
@@ -26,7 +29,7 @@ namespace transport {
 
 using common::GlobalData;
 
-ShmDispatcher::ShmDispatcher() : host_id_(0) { Init(); }
+ShmDispatcher::ShmDispatcher() : host_id_(0), batch_size_(1) { Init(); }
 
 ShmDispatcher::~ShmDispatcher() { Shutdown(); }
 
@@ -45,6 +48,19 @@ void ShmDispatcher::Shutdown() {
   }
 }
 
+void ShmDispatcher::set_batch_size(uint32_t batch_size) {
+  batch_size_.store(std::max(batch_size, 1u));
+}
+
+void ShmDispatcher::SetKeepLatest(uint64_t channel_id, bool keep_latest) {
+  WriteLockGuard<AtomicRWLock> lock(segments_lock_);
+  if (keep_latest) {
+    keep_latest_channels_.insert(channel_id);
+  } else {
+    keep_latest_channels_.erase(channel_id);
+  }
+}
+
 void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   uint64_t channel_id = self_attr.channel_id();
   WriteLockGuard<AtomicRWLock> lock(segments_lock_);
@@ -56,13 +72,15 @@ void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   previous_indexes_[channel_id] = UINT32_MAX;
 }
 
-void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
+void ShmDispatcher::ReadMessage(uint64_t channel_id, const SegmentPtr& segment,
+                                const ReadableBlockHandlerPtr& handler,
+                                uint32_t block_index) {
   ADEBUG << "Reading sharedmem message: "
          << GlobalData::GetChannelById(channel_id)
          << " from block: " << block_index;
-  auto rb = std::make_shared<ReadableBlock>();
-  rb->index = block_index;
-  if (!segments_[channel_id]->AcquireBlockToRead(rb.get())) {
+  auto rb = segment->IsSeqLock() ? CopyBlock(segment, block_index)
+                                 : LockBlock(segment, block_index);
+  if (rb == nullptr) {
     AWARN << "fail to acquire block, channel: "
           << GlobalData::GetChannelById(channel_id)
           << " index: " << block_index;
@@ -74,79 +92,161 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
       reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
 
   if (msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size())) {
-    OnMessage(channel_id, rb, msg_info);
+    handler->Run(rb, msg_info);
   } else {
     AERROR << "error msg info of channel:"
            << GlobalData::GetChannelById(channel_id);
   }
-  segments_[channel_id]->ReleaseReadBlock(*rb);
 }
 
-void ShmDispatcher::OnMessage(uint64_t channel_id,
-                              const std::shared_ptr<ReadableBlock>& rb,
-                              const MessageInfo& msg_info) {
-  if (is_shutdown_.load()) {
+void ShmDispatcher::ReadMessages(uint64_t channel_id,
+                                 const std::vector<uint32_t>& block_indexes) {
+  auto iter = segments_.find(channel_id);
+  if (iter == segments_.end()) {
     return;
   }
+
   ListenerHandlerBasePtr* handler_base = nullptr;
-  if (msg_listeners_.Get(channel_id, &handler_base)) {
-    auto handler = std::dynamic_pointer_cast<ListenerHandler<ReadableBlock>>(
-        *handler_base);
-    handler->Run(rb, msg_info);
-  } else {
+  if (!msg_listeners_.Get(channel_id, &handler_base)) {
     AERROR << "Cant find " << GlobalData::GetChannelById(channel_id)
            << "'s handler.";
+    return;
+  }
+  auto handler =
+      std::dynamic_pointer_cast<ListenerHandler<ReadableBlock>>(*handler_base);
+
+  auto begin = block_indexes.begin();
+  if (keep_latest_channels_.count(channel_id) > 0 &&
+      block_indexes.size() > 1) {
+    ADEBUG << "skip " << block_indexes.size() - 1
+           << " superseded messages of channel: "
+           << GlobalData::GetChannelById(channel_id);
+    begin = block_indexes.end() - 1;
+  }
+  for (auto it = begin; it != block_indexes.end(); ++it) {
+    if (is_shutdown_.load()) {
+      return;
+    }
+    CheckBlockIndex(channel_id, *it);
+    ReadMessage(channel_id, iter->second, handler, *it);
   }
 }
 
-void ShmDispatcher::ThreadFunc() {
+void ShmDispatcher::CheckBlockIndex(uint64_t channel_id,
+                                    uint32_t block_index) {
+  if (previous_indexes_.count(channel_id) == 0) {
+    previous_indexes_[channel_id] = UINT32_MAX;
+  }
+  uint32_t& previous_index = previous_indexes_[channel_id];
+  if (block_index != 0 && previous_index != UINT32_MAX) {
+    if (block_index == previous_index) {
+      ADEBUG << "Receive SAME index " << block_index << " of channel "
+             << channel_id;
+    } else if (block_index < previous_index) {
+      ADEBUG << "Receive PREVIOUS message. last: " << previous_index
+             << ", now: " << block_index;
+    } else if (block_index - previous_index > 1) {
+      ADEBUG << "Receive JUMP message. last: " << previous_index
+             << ", now: " << block_index;
+    }
+  }
+  previous_index = block_index;
+}
+
+std::shared_ptr<ReadableBlock> ShmDispatcher::LockBlock(
+    const SegmentPtr& segment, uint32_t block_index) {
+  ReadableBlock readable_block;
+  readable_block.index = block_index;
+  if (!segment->AcquireBlockToRead(&readable_block)) {
+    return nullptr;
+  }
+  // the read lock is released with the last reference to the block, which
+  // lets listeners keep zero-copy messages alive beyond this call
+  return std::shared_ptr<ReadableBlock>(new ReadableBlock(readable_block),
+                                        [segment](ReadableBlock* block) {
+                                          segment->ReleaseReadBlock(*block);
+                                          delete block;
+                                        });
+}
+
+std::shared_ptr<ReadableBlock> ShmDispatcher::CopyBlock(
+    const SegmentPtr& segment, uint32_t block_index) {
+  auto block_copy = std::make_shared<BlockCopy>();
+  if (!segment->CopyBlockToRead(block_index, block_copy.get())) {
+    return nullptr;
+  }
+  return std::shared_ptr<ReadableBlock>(block_copy, &block_copy->rb);
+}
+
+bool ShmDispatcher::Listen(std::vector<ReadableInfo>* infos) {
   ReadableInfo readable_info;
+  if (!notifier_->Listen(100, &readable_info)) {
+    return false;
+  }
+  infos->emplace_back(readable_info);
+
+  // drain whatever else is pending without waiting
+  uint32_t batch_size = batch_size_.load();
+  while (infos->size() < batch_size && notifier_->Listen(0, &readable_info)) {
+    infos->emplace_back(readable_info);
+  }
+  return true;
+}
+
+void ShmDispatcher::ThreadFunc() {
+  std::vector<ReadableInfo> infos;
+  // channel id with its block indexes, in order of first arrival
+  std::vector<std::pair<uint64_t, std::vector<uint32_t>>> batches;
   while (!is_shutdown_.load()) {
-    if (!notifier_->Listen(100, &readable_info)) {
+    infos.clear();
+    if (!Listen(&infos)) {
       ADEBUG << "listen failed.";
       continue;
     }
 
-    uint64_t host_id = readable_info.host_id();
-    if (host_id != host_id_) {
-      ADEBUG << "shm readable info from other host.";
-      continue;
+    for (auto& batch : batches) {
+      batch.second.clear();
     }
-
-    uint64_t channel_id = readable_info.channel_id();
-    uint32_t block_index = readable_info.block_index();
-
-    {
-      ReadLockGuard<AtomicRWLock> lock(segments_lock_);
-      if (segments_.count(channel_id) == 0) {
+    for (auto& readable_info : infos) {
+      if (readable_info.host_id() != host_id_) {
+        ADEBUG << "shm readable info from other host.";
         continue;
       }
-      // check block index
-      if (previous_indexes_.count(channel_id) == 0) {
-        previous_indexes_[channel_id] = UINT32_MAX;
+      uint64_t channel_id = readable_info.channel_id();
+      auto iter = std::find_if(
+          batches.begin(), batches.end(),
+          [channel_id](const std::pair<uint64_t, std::vector<uint32_t>>& b) {
+            return b.first == channel_id;
+          });
+      if (iter == batches.end()) {
+        batches.emplace_back(channel_id, std::vector<uint32_t>());
+        iter = batches.end() - 1;
       }
-      uint32_t& previous_index = previous_indexes_[channel_id];
-      if (block_index != 0 && previous_index != UINT32_MAX) {
-        if (block_index == previous_index) {
-          ADEBUG << "Receive SAME index " << block_index << " of channel "
-                 << channel_id;
-        } else if (block_index < previous_index) {
-          ADEBUG << "Receive PREVIOUS message. last: " << previous_index
-                 << ", now: " << block_index;
-        } else if (block_index - previous_index > 1) {
-          ADEBUG << "Receive JUMP message. last: " << previous_index
-                 << ", now: " << block_index;
+      iter->second.emplace_back(readable_info.block_index());
+    }
+
+    {
+      ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+      for (auto& batch : batches) {
+        if (!batch.second.empty()) {
+          ReadMessages(batch.first, batch.second);
         }
       }
-      previous_index = block_index;
+    }
 
-      ReadMessage(channel_id, block_index);
+    // forget channels gone quiet, keeps the lookup short
+    if (batches.size() > kMaxBatchChannelNum) {
+      batches.clear();
     }
   }
 }
 
 bool ShmDispatcher::Init() {
   host_id_ = common::Hash(GlobalData::Instance()->HostIp());
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf()) {
+    set_batch_size(g_conf.transport_conf().shm_conf().dispatch_batch_size());
+  }
   notifier_ = NotifierFactory::CreateNotifier();
   thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
   scheduler::Instance()->SetInnerThreadAttr("shm_disp", &thread_);
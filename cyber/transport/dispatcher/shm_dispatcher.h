@@ -17,11 +17,16 @@
 #ifndef CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 #define CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/global_data.h"
@@ -30,6 +35,7 @@
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
 #include "cyber/transport/shm/notifier_factory.h"
+#include "cyber/transport/shm/readable_info.h"
 #include "cyber/transport/shm/segment.h"
 
 namespace apollo {
@@ -51,6 +57,15 @@ class ShmDispatcher : public Dispatcher {
 
   void Shutdown() override;
 
+  // Max number of readable infos drained per wakeup, grouped by channel
+  // before the messages are read. 1 reads every message on its own.
+  void set_batch_size(uint32_t batch_size);
+  uint32_t batch_size() const { return batch_size_.load(); }
+
+  // Only the newest block of a batch is read for keep latest channels, the
+  // older ones are skipped without being deserialized.
+  void SetKeepLatest(uint64_t channel_id, bool keep_latest);
+
   template <typename MessageT>
   void AddListener(const RoleAttributes& self_attr,
                    const MessageListener<MessageT>& listener);
@@ -61,16 +76,41 @@ class ShmDispatcher : public Dispatcher {
                    const MessageListener<MessageT>& listener);
 
  private:
+  template <typename MessageT>
+  static typename std::enable_if<message::IsFixedLayout<MessageT>::value,
+                                 std::shared_ptr<MessageT>>::type
+  ToMessage(const std::shared_ptr<ReadableBlock>& rb);
+
+  template <typename MessageT>
+  static typename std::enable_if<!message::IsFixedLayout<MessageT>::value,
+                                 std::shared_ptr<MessageT>>::type
+  ToMessage(const std::shared_ptr<ReadableBlock>& rb);
+
   void AddSegment(const RoleAttributes& self_attr);
-  void ReadMessage(uint64_t channel_id, uint32_t block_index);
-  void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
-                 const MessageInfo& msg_info);
+  using ReadableBlockHandlerPtr =
+      std::shared_ptr<ListenerHandler<ReadableBlock>>;
+
+  void ReadMessages(uint64_t channel_id,
+                    const std::vector<uint32_t>& block_indexes);
+  void ReadMessage(uint64_t channel_id, const SegmentPtr& segment,
+                   const ReadableBlockHandlerPtr& handler,
+                   uint32_t block_index);
+  void CheckBlockIndex(uint64_t channel_id, uint32_t block_index);
+  std::shared_ptr<ReadableBlock> LockBlock(const SegmentPtr& segment,
+                                           uint32_t block_index);
+  std::shared_ptr<ReadableBlock> CopyBlock(const SegmentPtr& segment,
+                                           uint32_t block_index);
+  bool Listen(std::vector<ReadableInfo>* infos);
   void ThreadFunc();
   bool Init();
 
+  static const size_t kMaxBatchChannelNum = 64;
+
   uint64_t host_id_;
+  std::atomic<uint32_t> batch_size_;
   SegmentContainer segments_;
   std::unordered_map<uint64_t, uint32_t> previous_indexes_;
+  std::unordered_set<uint64_t> keep_latest_channels_;
   AtomicRWLock segments_lock_;
   std::thread thread_;
   NotifierPtr notifier_;
@@ -78,15 +118,40 @@ class ShmDispatcher : public Dispatcher {
   DECLARE_SINGLETON(ShmDispatcher)
 };
 
+template <typename MessageT>
+typename std::enable_if<message::IsFixedLayout<MessageT>::value,
+                        std::shared_ptr<MessageT>>::type
+ShmDispatcher::ToMessage(const std::shared_ptr<ReadableBlock>& rb) {
+  if (rb->block->msg_size() != sizeof(MessageT)) {
+    AERROR << "unexpected fixed-layout message size: "
+           << rb->block->msg_size();
+    return nullptr;
+  }
+  // share ownership with the block, it stays locked for read (and therefore
+  // untouched by writers) until the last reference to the message is gone
+  return std::shared_ptr<MessageT>(rb, reinterpret_cast<MessageT*>(rb->buf));
+}
+
+template <typename MessageT>
+typename std::enable_if<!message::IsFixedLayout<MessageT>::value,
+                        std::shared_ptr<MessageT>>::type
+ShmDispatcher::ToMessage(const std::shared_ptr<ReadableBlock>& rb) {
+  auto msg = std::make_shared<MessageT>();
+  if (!message::ParseFromArray(
+          rb->buf, static_cast<int>(rb->block->msg_size()), msg.get())) {
+    AWARN << "parse from array failed.";
+    return nullptr;
+  }
+  return msg;
+}
+
 template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const MessageListener<MessageT>& listener) {
-  // FIXME: make it more clean
   auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
                                      const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    auto msg = ToMessage<MessageT>(rb);
+    RETURN_IF_NULL(msg);
     listener(msg, msg_info);
   };
 
@@ -98,12 +163,10 @@ template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const RoleAttributes& opposite_attr,
                                 const MessageListener<MessageT>& listener) {
-  // FIXME: make it more clean
   auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
                                      const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    auto msg = ToMessage<MessageT>(rb);
+    RETURN_IF_NULL(msg);
     listener(msg, msg_info);
   };
 
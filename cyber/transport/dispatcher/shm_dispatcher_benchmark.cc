@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/init.h"
+#include "cyber/proto/unit_test.pb.h"
+#include "cyber/transport/dispatcher/shm_dispatcher.h"
+#include "cyber/transport/receiver/shm_receiver.h"
+#include "cyber/transport/transmitter/shm_transmitter.h"
+
+DEFINE_uint32(channel_num, 6, "channels publishing together in a burst");
+DEFINE_uint32(burst_num, 5000, "bursts to publish");
+DEFINE_uint32(batch_size, 32, "batch size compared against the 1-by-1 loop");
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::proto::Chatter;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::RoleAttributes;
+using apollo::cyber::transport::ShmDispatcher;
+using apollo::cyber::transport::ShmReceiver;
+using apollo::cyber::transport::ShmTransmitter;
+using apollo::cyber::transport::Transmitter;
+
+namespace {
+
+double CpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             1e6 +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+void Run(uint32_t batch_size) {
+  ShmDispatcher::Instance()->set_batch_size(batch_size);
+
+  std::atomic<uint64_t> received = {0};
+  std::vector<std::shared_ptr<Transmitter<Chatter>>> transmitters;
+  std::vector<std::shared_ptr<ShmReceiver<Chatter>>> receivers;
+  for (uint32_t i = 0; i < FLAGS_channel_num; ++i) {
+    std::string channel_name =
+        "/shm_dispatcher_benchmark/" + std::to_string(batch_size) + "/" +
+        std::to_string(i);
+    RoleAttributes attr;
+    attr.set_host_name(GlobalData::Instance()->HostName());
+    attr.set_host_ip(GlobalData::Instance()->HostIp());
+    attr.set_channel_name(channel_name);
+    attr.set_channel_id(GlobalData::RegisterChannel(channel_name));
+
+    auto transmitter = std::make_shared<ShmTransmitter<Chatter>>(attr);
+    transmitter->Enable();
+    transmitters.emplace_back(transmitter);
+
+    auto receiver = std::make_shared<ShmReceiver<Chatter>>(
+        attr, [&received](const std::shared_ptr<Chatter>&,
+                          const MessageInfo&, const RoleAttributes&) {
+          received.fetch_add(1);
+        });
+    receiver->Enable();
+    receivers.emplace_back(receiver);
+  }
+
+  auto msg = std::make_shared<Chatter>();
+  msg->set_content(std::string(1024, 'c'));
+  uint64_t expected = static_cast<uint64_t>(FLAGS_burst_num) *
+                      static_cast<uint64_t>(FLAGS_channel_num);
+
+  double cpu_begin = CpuTimeUs();
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t burst = 0; burst < FLAGS_burst_num; ++burst) {
+    msg->set_seq(burst);
+    for (auto& transmitter : transmitters) {
+      transmitter->Transmit(msg);
+    }
+  }
+  auto deadline = begin + std::chrono::seconds(30);
+  while (received.load() < expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto end = std::chrono::steady_clock::now();
+  double cpu_end = CpuTimeUs();
+
+  for (auto& receiver : receivers) {
+    receiver->Disable();
+  }
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  uint64_t count = received.load();
+  std::cout << "batch_size: " << batch_size << ", received: " << count << "/"
+            << expected
+            << ", msgs/sec: " << static_cast<double>(count) / seconds
+            << ", cpu us/msg: "
+            << (cpu_end - cpu_begin) / static_cast<double>(count ? count : 1)
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  Run(1);
+  Run(FLAGS_batch_size);
+  apollo::cyber::Clear();
+  return 0;
+}
@@ -48,6 +48,7 @@ class History {
 
   void Enable() { enabled_ = true; }
   void Disable() { enabled_ = false; }
+  bool enabled() const { return enabled_; }
 
   void Add(const MessagePtr& msg, const MessageInfo& msg_info);
   void Clear();
@@ -77,6 +78,9 @@ History<MessageT>::History(const HistoryAttributes& attr)
 
   if (attr.history_policy == proto::QosHistoryPolicy::HISTORY_KEEP_ALL) {
     depth_ = max_depth_;
+  } else if (attr.history_policy ==
+             proto::QosHistoryPolicy::HISTORY_KEEP_LATEST) {
+    depth_ = 1;
   } else {
     depth_ = attr.depth;
     if (depth_ > max_depth_) {
@@ -54,12 +54,20 @@ class MessageInfo {
   const Identity& spare_id() const { return spare_id_; }
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
+  // nanoseconds since epoch when the transmitter sent the message, 0 if the
+  // sender didn't stamp it
+  uint64_t send_time() const { return send_time_; }
+  void set_send_time(uint64_t send_time) { send_time_ = send_time; }
+
   static const std::size_t kSize;
+  // size written by senders that don't stamp send time
+  static const std::size_t kLegacySize;
 
  private:
   Identity sender_id_;
   uint64_t seq_num_;
   Identity spare_id_;
+  uint64_t send_time_;
 };
 
 }  // namespace transport
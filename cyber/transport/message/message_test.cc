@@ -73,6 +73,18 @@ TEST(MessageInfoTest, message_info_test) {
   EXPECT_TRUE(info2.DeserializeFrom(str));
   EXPECT_EQ(info1, info2);
   EXPECT_FALSE(info2.DeserializeFrom("error"));
+
+  info1.set_send_time(123456789);
+  EXPECT_FALSE(info1 == info2);
+  EXPECT_TRUE(info1.SerializeTo(&str));
+  EXPECT_EQ(MessageInfo::kSize, str.size());
+  EXPECT_TRUE(info2.DeserializeFrom(str));
+  EXPECT_EQ(123456789, info2.send_time());
+  EXPECT_EQ(info1, info2);
+
+  // senders without send time are still understood
+  EXPECT_TRUE(info2.DeserializeFrom(str.substr(0, MessageInfo::kLegacySize)));
+  EXPECT_EQ(0, info2.send_time());
 }
 
 TEST(HistoryTest, history_test) {
@@ -116,6 +128,19 @@ TEST(HistoryTest, history_test) {
   HistoryAttributes attr4(proto::QosHistoryPolicy::HISTORY_KEEP_LAST, 1024);
   History<RawMessage> history4(attr4);
   EXPECT_EQ(1000, history4.depth());
+  HistoryAttributes attr5(proto::QosHistoryPolicy::HISTORY_KEEP_LATEST,
+                          depth);
+  History<RawMessage> history5(attr5);
+  EXPECT_EQ(1, history5.depth());
+  history5.Enable();
+  for (int i = 0; i < depth; i++) {
+    message_info.set_seq_num(i);
+    history5.Add(message, message_info);
+  }
+  messages.clear();
+  history5.GetCachedMessage(&messages);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(depth - 1, messages[0].msg_info.seq_num());
 }
 
 TEST(ListenerHandlerTest, listener_handler_test) {
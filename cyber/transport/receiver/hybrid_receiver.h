@@ -71,6 +71,8 @@ class HybridReceiver : public Receiver<M> {
   void Enable(const RoleAttributes& opposite_attr) override;
   void Disable(const RoleAttributes& opposite_attr) override;
 
+  void SetKeepLatest(bool keep_latest) override;
+
  private:
   void InitMode();
   void ObtainConfig();
@@ -107,6 +109,7 @@ HybridReceiver<M>::HybridReceiver(
   InitHistory();
   InitReceivers();
   InitTransmitters();
+  this->stats_ = ChannelStats::Instance()->GetCounters(attr.channel_id());
 }
 
 template <typename M>
@@ -159,6 +162,15 @@ void HybridReceiver<M>::Disable(const RoleAttributes& opposite_attr) {
   }
 }
 
+template <typename M>
+void HybridReceiver<M>::SetKeepLatest(bool keep_latest) {
+  Receiver<M>::SetKeepLatest(keep_latest);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& item : receivers_) {
+    item.second->SetKeepLatest(keep_latest);
+  }
+}
+
 template <typename M>
 void HybridReceiver<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -20,9 +20,12 @@
 #include <functional>
 #include <memory>
 
+#include "cyber/time/time.h"
 #include "cyber/transport/common/endpoint.h"
+#include "cyber/transport/common/latency_statistics.h"
 #include "cyber/transport/message/history.h"
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/shm/channel_stats.h"
 
 namespace apollo {
 namespace cyber {
@@ -43,16 +46,30 @@ class Receiver : public Endpoint {
   virtual void Enable(const RoleAttributes& opposite_attr) = 0;
   virtual void Disable(const RoleAttributes& opposite_attr) = 0;
 
+  // With keep latest set, transports may drop a message that is superseded
+  // by a newer one of the same channel before it is delivered.
+  virtual void SetKeepLatest(bool keep_latest) { keep_latest_ = keep_latest; }
+  bool keep_latest() const { return keep_latest_; }
+
  protected:
   void OnNewMessage(const MessagePtr& msg, const MessageInfo& msg_info);
 
   MessageListener msg_listener_;
+  // set by receivers of a concrete transport when latency stats are enabled
+  LatencyStatistics::HistogramPtr latency_;
+  // set by the receiver readers listen through, counts every delivery
+  ChannelStats::Counters* stats_;
+  bool keep_latest_;
 };
 
 template <typename M>
 Receiver<M>::Receiver(const RoleAttributes& attr,
                       const MessageListener& msg_listener)
-    : Endpoint(attr), msg_listener_(msg_listener) {}
+    : Endpoint(attr),
+      msg_listener_(msg_listener),
+      latency_(nullptr),
+      stats_(nullptr),
+      keep_latest_(false) {}
 
 template <typename M>
 Receiver<M>::~Receiver() {}
@@ -60,6 +77,16 @@ Receiver<M>::~Receiver() {}
 template <typename M>
 void Receiver<M>::OnNewMessage(const MessagePtr& msg,
                                const MessageInfo& msg_info) {
+  if (latency_ != nullptr && msg_info.send_time() != 0) {
+    uint64_t now = Time::Now().ToNanosecond();
+    latency_->Add(now > msg_info.send_time() ? now - msg_info.send_time() : 0);
+  }
+  if (stats_ != nullptr) {
+    uint64_t now = Time::Now().ToNanosecond();
+    stats_->AddDelivery(now > msg_info.send_time() && msg_info.send_time() != 0
+                            ? now - msg_info.send_time()
+                            : 0);
+  }
   if (msg_listener_ != nullptr) {
     msg_listener_(msg, msg_info, attr_);
   }
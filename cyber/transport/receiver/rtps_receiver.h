@@ -47,6 +47,8 @@ RtpsReceiver<M>::RtpsReceiver(
     const RoleAttributes& attr,
     const typename Receiver<M>::MessageListener& msg_listener)
     : Receiver<M>(attr, msg_listener) {
+  this->latency_ = LatencyStatistics::Instance()->GetHistogram(
+      attr.channel_id(), OptionalMode::RTPS);
   dispatcher_ = RtpsDispatcher::Instance();
 }
 
@@ -40,6 +40,8 @@ class ShmReceiver : public Receiver<M> {
   void Enable(const RoleAttributes& opposite_attr) override;
   void Disable(const RoleAttributes& opposite_attr) override;
 
+  void SetKeepLatest(bool keep_latest) override;
+
  private:
   ShmDispatcherPtr dispatcher_;
 };
@@ -49,6 +51,8 @@ ShmReceiver<M>::ShmReceiver(
     const RoleAttributes& attr,
     const typename Receiver<M>::MessageListener& msg_listener)
     : Receiver<M>(attr, msg_listener) {
+  this->latency_ = LatencyStatistics::Instance()->GetHistogram(
+      attr.channel_id(), OptionalMode::SHM);
   dispatcher_ = ShmDispatcher::Instance();
 }
 
@@ -92,6 +96,12 @@ void ShmReceiver<M>::Disable(const RoleAttributes& opposite_attr) {
   dispatcher_->RemoveListener<M>(this->attr_, opposite_attr);
 }
 
+template <typename M>
+void ShmReceiver<M>::SetKeepLatest(bool keep_latest) {
+  Receiver<M>::SetKeepLatest(keep_latest);
+  dispatcher_->SetKeepLatest(this->attr_.channel_id(), keep_latest);
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -46,6 +46,10 @@ bool AttributesFiller::FillInPubAttr(
       pub_attr->topic.historyQos.kind =
           eprosima::fastrtps::KEEP_ALL_HISTORY_QOS;
       break;
+    case QosHistoryPolicy::HISTORY_KEEP_LATEST:
+      pub_attr->topic.historyQos.kind =
+          eprosima::fastrtps::KEEP_LAST_HISTORY_QOS;
+      break;
     default:
       break;
   }
@@ -79,6 +83,9 @@ bool AttributesFiller::FillInPubAttr(
   if (qos.depth() != QosProfileConf::QOS_HISTORY_DEPTH_SYSTEM_DEFAULT) {
     pub_attr->topic.historyQos.depth = static_cast<int32_t>(qos.depth());
   }
+  if (qos.history() == QosHistoryPolicy::HISTORY_KEEP_LATEST) {
+    pub_attr->topic.historyQos.depth = 1;
+  }
 
   // ensure the history depth is at least the requested queue size
   if (pub_attr->topic.historyQos.depth < 0) {
@@ -133,6 +140,10 @@ bool AttributesFiller::FillInSubAttr(
       sub_attr->topic.historyQos.kind =
           eprosima::fastrtps::KEEP_ALL_HISTORY_QOS;
       break;
+    case QosHistoryPolicy::HISTORY_KEEP_LATEST:
+      sub_attr->topic.historyQos.kind =
+          eprosima::fastrtps::KEEP_LAST_HISTORY_QOS;
+      break;
     default:
       break;
   }
@@ -166,6 +177,9 @@ bool AttributesFiller::FillInSubAttr(
   if (qos.depth() != QosProfileConf::QOS_HISTORY_DEPTH_SYSTEM_DEFAULT) {
     sub_attr->topic.historyQos.depth = static_cast<int32_t>(qos.depth());
   }
+  if (qos.history() == QosHistoryPolicy::HISTORY_KEEP_LATEST) {
+    sub_attr->topic.historyQos.depth = 1;
+  }
 
   // ensure the history depth is at least the requested queue size
   if (sub_attr->topic.historyQos.depth < 0) {
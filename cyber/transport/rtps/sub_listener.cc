@@ -57,6 +57,14 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
 
+  // rtps carries no cyber send time, use the source timestamp the publisher
+  // stamped instead, it is only comparable when host clocks are synced
+  const auto& source_time = m_info.sourceTimestamp;
+  uint64_t send_time =
+      static_cast<uint64_t>(source_time.seconds) * 1000000000UL +
+      ((static_cast<uint64_t>(source_time.fraction) * 1000000000UL) >> 32);
+  msg_info_.set_send_time(send_time);
+
   // fetch message string
   std::shared_ptr<std::string> msg_str =
       std::make_shared<std::string>(m.data());
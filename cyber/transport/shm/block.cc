@@ -38,6 +38,8 @@ bool Block::TryLockForWrite() {
     ADEBUG << "lock num: " << lock_num_.load();
     return false;
   }
+  seq_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
   return true;
 }
 
@@ -68,10 +70,23 @@ bool Block::TryLockForRead() {
   return true;
 }
 
-void Block::ReleaseWriteLock() { lock_num_.fetch_add(1); }
+void Block::ReleaseWriteLock() {
+  seq_.fetch_add(1, std::memory_order_release);
+  lock_num_.fetch_add(1);
+}
 
 void Block::ReleaseReadLock() { lock_num_.fetch_sub(1); }
 
+bool Block::TryBeginSeqRead(uint64_t* seq) const {
+  *seq = seq_.load(std::memory_order_acquire);
+  return (*seq & 1) == 0;
+}
+
+bool Block::ValidateSeqRead(uint64_t seq) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return seq_.load(std::memory_order_relaxed) == seq;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
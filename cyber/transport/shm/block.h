@@ -49,7 +49,14 @@ class Block {
   void ReleaseWriteLock();
   void ReleaseReadLock();
 
+  // Seqlock protocol: the sequence number is odd while a writer holds the
+  // block. Readers don't lock, they copy and then check that the sequence
+  // number didn't change.
+  bool TryBeginSeqRead(uint64_t* seq) const;
+  bool ValidateSeqRead(uint64_t seq) const;
+
   volatile std::atomic<int32_t> lock_num_ = {0};
+  std::atomic<uint64_t> seq_ = {0};
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/shm/channel_stats.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+using common::Hash;
+
+ChannelStats::ChannelStats() {
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf() &&
+      !g_conf.transport_conf().shm_conf().channel_stats()) {
+    ADEBUG << "channel stats disabled.";
+    return;
+  }
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/channel_stats"));
+  if (!OpenOrCreate()) {
+    AWARN << "channel stats are not available.";
+    Reset();
+  }
+}
+
+ChannelStats::~ChannelStats() { Reset(); }
+
+ChannelStats::Counters* ChannelStats::GetCounters(uint64_t channel_id) {
+  if (region_ == nullptr || channel_id == 0) {
+    return nullptr;
+  }
+  // open addressing, a claimed slot is never given back
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    auto& slot = region_->slots[(channel_id + i) % kSlotNum];
+    uint64_t id = slot.channel_id.load(std::memory_order_acquire);
+    if (id == 0 && slot.channel_id.compare_exchange_strong(
+                       id, channel_id, std::memory_order_acq_rel)) {
+      return &slot;
+    }
+    if (id == channel_id) {
+      return &slot;
+    }
+  }
+  AWARN << "no channel stats slot left for "
+        << GlobalData::GetChannelById(channel_id);
+  return nullptr;
+}
+
+bool ChannelStats::Get(uint64_t channel_id, ChannelStatsInfo* info) const {
+  RETURN_VAL_IF_NULL(info, false);
+  auto counters = Find(channel_id);
+  if (counters == nullptr) {
+    return false;
+  }
+  Copy(*counters, info);
+  return true;
+}
+
+void ChannelStats::GetAll(std::vector<ChannelStatsInfo>* infos) const {
+  RETURN_IF_NULL(infos);
+  infos->clear();
+  if (region_ == nullptr) {
+    return;
+  }
+  for (const auto& slot : region_->slots) {
+    if (slot.channel_id.load(std::memory_order_acquire) != 0) {
+      infos->emplace_back();
+      Copy(slot, &infos->back());
+    }
+  }
+}
+
+const ChannelStats::Counters* ChannelStats::Find(uint64_t channel_id) const {
+  if (region_ == nullptr || channel_id == 0) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    const auto& slot = region_->slots[(channel_id + i) % kSlotNum];
+    uint64_t id = slot.channel_id.load(std::memory_order_acquire);
+    if (id == channel_id) {
+      return &slot;
+    }
+    if (id == 0) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+void ChannelStats::Copy(const Counters& counters, ChannelStatsInfo* info) {
+  info->channel_id = counters.channel_id.load(std::memory_order_relaxed);
+  info->msg_num = counters.msg_num.load(std::memory_order_relaxed);
+  info->msg_bytes = counters.msg_bytes.load(std::memory_order_relaxed);
+  info->last_publish_time =
+      counters.last_publish_time.load(std::memory_order_relaxed);
+  info->deliver_num = counters.deliver_num.load(std::memory_order_relaxed);
+  info->last_lag = counters.last_lag.load(std::memory_order_relaxed);
+  info->max_lag = counters.max_lag.load(std::memory_order_relaxed);
+}
+
+bool ChannelStats::OpenOrCreate() {
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, sizeof(Region), 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+  region_ = new (managed_shm_) Region();
+  return true;
+}
+
+bool ChannelStats::OpenOnly() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed.";
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    managed_shm_ = nullptr;
+    return false;
+  }
+  region_ = reinterpret_cast<Region*>(managed_shm_);
+  return true;
+}
+
+bool ChannelStats::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+void ChannelStats::Reset() {
+  region_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TRANSPORT_SHM_CHANNEL_STATS_H_
+#define CYBER_TRANSPORT_SHM_CHANNEL_STATS_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+struct ChannelStatsInfo {
+  uint64_t channel_id = 0;
+  uint64_t msg_num = 0;
+  uint64_t msg_bytes = 0;
+  // wall time in ns
+  uint64_t last_publish_time = 0;
+  uint64_t deliver_num = 0;
+  // from the publish to the delivery to a reader, in ns
+  uint64_t last_lag = 0;
+  uint64_t max_lag = 0;
+};
+
+// Counters of every channel on this host, kept by the writers and readers of
+// all processes in one well-known shm region. Tools read the counters there
+// instead of subscribing to the channels they watch.
+class ChannelStats {
+ public:
+  static const uint32_t kSlotNum = 4096;
+
+  // one cache line per channel, updated with relaxed atomics only
+  struct alignas(64) Counters {
+    void AddPublish(uint64_t bytes, uint64_t time) {
+      msg_num.fetch_add(1, std::memory_order_relaxed);
+      msg_bytes.fetch_add(bytes, std::memory_order_relaxed);
+      last_publish_time.store(time, std::memory_order_relaxed);
+    }
+
+    void AddDelivery(uint64_t lag) {
+      deliver_num.fetch_add(1, std::memory_order_relaxed);
+      last_lag.store(lag, std::memory_order_relaxed);
+      uint64_t max = max_lag.load(std::memory_order_relaxed);
+      while (lag > max && !max_lag.compare_exchange_weak(
+                              max, lag, std::memory_order_relaxed)) {
+      }
+    }
+
+    std::atomic<uint64_t> channel_id = {0};
+    std::atomic<uint64_t> msg_num = {0};
+    std::atomic<uint64_t> msg_bytes = {0};
+    std::atomic<uint64_t> last_publish_time = {0};
+    std::atomic<uint64_t> deliver_num = {0};
+    std::atomic<uint64_t> last_lag = {0};
+    std::atomic<uint64_t> max_lag = {0};
+  };
+
+  virtual ~ChannelStats();
+
+  bool enabled() const { return region_ != nullptr; }
+
+  // Claims the slot of |channel_id| on first use. Returns nullptr when the
+  // stats are disabled or every slot is taken.
+  Counters* GetCounters(uint64_t channel_id);
+
+  // false if no writer or reader of |channel_id| counted anything yet
+  bool Get(uint64_t channel_id, ChannelStatsInfo* info) const;
+  void GetAll(std::vector<ChannelStatsInfo>* infos) const;
+
+ private:
+  struct Region {
+    Counters slots[kSlotNum];
+  };
+
+  bool OpenOrCreate();
+  bool OpenOnly();
+  bool Remove();
+  void Reset();
+  const Counters* Find(uint64_t channel_id) const;
+  static void Copy(const Counters& counters, ChannelStatsInfo* info);
+
+  key_t key_ = 0;
+  void* managed_shm_ = nullptr;
+  Region* region_ = nullptr;
+
+  DECLARE_SINGLETON(ChannelStats)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_CHANNEL_STATS_H_
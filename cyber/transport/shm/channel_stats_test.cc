@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/shm/channel_stats.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ChannelStatsTest, publish_and_deliver) {
+  auto stats = ChannelStats::Instance();
+  ASSERT_TRUE(stats->enabled());
+  EXPECT_EQ(stats->GetCounters(0), nullptr);
+
+  // the region outlives the process, compare against what is there already
+  const uint64_t channel_id = 0x5eed0001;
+  auto counters = stats->GetCounters(channel_id);
+  ASSERT_NE(counters, nullptr);
+  EXPECT_EQ(stats->GetCounters(channel_id), counters);
+  ChannelStatsInfo before;
+  EXPECT_TRUE(stats->Get(channel_id, &before));
+  EXPECT_FALSE(stats->Get(channel_id, nullptr));
+
+  counters->AddPublish(100, 12345);
+  counters->AddPublish(50, 23456);
+  counters->AddDelivery(before.max_lag + 1000);
+  counters->AddDelivery(10);
+
+  ChannelStatsInfo after;
+  EXPECT_TRUE(stats->Get(channel_id, &after));
+  EXPECT_EQ(after.channel_id, channel_id);
+  EXPECT_EQ(after.msg_num - before.msg_num, 2);
+  EXPECT_EQ(after.msg_bytes - before.msg_bytes, 150);
+  EXPECT_EQ(after.last_publish_time, 23456);
+  EXPECT_EQ(after.deliver_num - before.deliver_num, 2);
+  EXPECT_EQ(after.last_lag, 10);
+  EXPECT_EQ(after.max_lag, before.max_lag + 1000);
+
+  std::vector<ChannelStatsInfo> infos;
+  stats->GetAll(&infos);
+  bool found = false;
+  for (auto& info : infos) {
+    found = found || info.channel_id == channel_id;
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(ChannelStatsTest, colliding_channels) {
+  auto stats = ChannelStats::Instance();
+  // both hash to the same slot and end up in neighbouring ones
+  const uint64_t first_id = 0x5eed0002;
+  const uint64_t second_id = first_id + ChannelStats::kSlotNum;
+  std::vector<std::thread> threads;
+  std::vector<ChannelStats::Counters*> counters(8, nullptr);
+  for (size_t i = 0; i < counters.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      counters[i] = stats->GetCounters(i % 2 == 0 ? first_id : second_id);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < counters.size(); ++i) {
+    ASSERT_NE(counters[i], nullptr);
+    EXPECT_EQ(counters[i], counters[i % 2]);
+  }
+  EXPECT_NE(counters[0], counters[1]);
+  EXPECT_EQ(counters[0]->channel_id.load(), first_id);
+  EXPECT_EQ(counters[1]->channel_id.load(), second_id);
+
+  ChannelStatsInfo info;
+  EXPECT_FALSE(stats->Get(first_id + 1, &info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <linux/futex.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+namespace {
+
+int Futex(std::atomic<uint32_t>* addr, int op, uint32_t val,
+          const struct timespec* timeout) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                  op, val, timeout, nullptr, 0));
+}
+
+}  // namespace
+
+FutexNotifier::FutexNotifier() {
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/futex"));
+  ADEBUG << "futex notifier key: " << key_;
+  shm_size_ = sizeof(Indicator);
+
+  if (!Init()) {
+    AERROR << "fail to init futex notifier.";
+    is_shutdown_.exchange(true);
+    return;
+  }
+  // only infos published from now on are of interest
+  next_listen_num_ = indicator_->written_info_num.load();
+}
+
+FutexNotifier::~FutexNotifier() { Shutdown(); }
+
+void FutexNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  Wake();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Reset();
+}
+
+bool FutexNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  uint64_t num = indicator_->written_info_num.fetch_add(1);
+  Slot& slot = indicator_->slots[num % kSlotNum];
+  slot.seq.store(2 * num + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.host_id = info.host_id();
+  slot.channel_id = info.channel_id();
+  slot.block_index = info.block_index();
+  slot.seq.store(2 * num + 2, std::memory_order_release);
+
+  Wake();
+  return true;
+}
+
+bool FutexNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // announce ourselves before sampling, so a concurrent Notify either
+    // sees the waiter or bumps the wake sequence we wait on
+    indicator_->waiter_num.fetch_add(1);
+    uint32_t wake_seq = indicator_->wake_seq.load();
+    uint64_t written = indicator_->written_info_num.load();
+
+    if (next_listen_num_ + kSlotNum <= written) {
+      ADEBUG << "listener lagged behind, skip to the latest info.";
+      next_listen_num_ = written - 1;
+    }
+
+    if (next_listen_num_ < written) {
+      indicator_->waiter_num.fetch_sub(1);
+      int result = TryRead(next_listen_num_, info);
+      if (result > 0) {
+        ++next_listen_num_;
+        return true;
+      }
+      if (result < 0) {
+        ++next_listen_num_;
+      } else {
+        // reserved by a writer which hasn't finished yet
+        std::this_thread::yield();
+      }
+      continue;
+    }
+
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    bool woken = remaining.count() > 0 &&
+                 Wait(wake_seq, static_cast<int>(remaining.count()));
+    indicator_->waiter_num.fetch_sub(1);
+    if (!woken && std::chrono::steady_clock::now() >= deadline) {
+      ADEBUG << "timeout";
+      return false;
+    }
+  }
+
+  ADEBUG << "notifier is shutdown.";
+  return false;
+}
+
+int FutexNotifier::TryRead(uint64_t num, ReadableInfo* info) {
+  const Slot& slot = indicator_->slots[num % kSlotNum];
+  uint64_t seq = slot.seq.load(std::memory_order_acquire);
+  if (seq < 2 * num + 2) {
+    return 0;
+  }
+  if (seq > 2 * num + 2) {
+    return -1;
+  }
+
+  uint64_t host_id = slot.host_id;
+  uint64_t channel_id = slot.channel_id;
+  uint32_t block_index = slot.block_index;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.seq.load(std::memory_order_relaxed) != seq) {
+    return -1;
+  }
+
+  info->set_host_id(host_id);
+  info->set_channel_id(channel_id);
+  info->set_block_index(block_index);
+  return 1;
+}
+
+bool FutexNotifier::Wait(uint32_t wake_seq, int timeout_ms) {
+  struct timespec timeout;
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+  int ret = Futex(&indicator_->wake_seq, FUTEX_WAIT, wake_seq, &timeout);
+  // EAGAIN: the wake sequence moved on before we went to sleep
+  return ret == 0 || errno == EAGAIN || errno == EINTR;
+}
+
+void FutexNotifier::Wake() {
+  if (indicator_ == nullptr) {
+    return;
+  }
+  indicator_->wake_seq.fetch_add(1);
+  if (indicator_->waiter_num.load() > 0) {
+    Futex(&indicator_->wake_seq, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+}
+
+bool FutexNotifier::Init() { return OpenOrCreate(); }
+
+bool FutexNotifier::OpenOrCreate() {
+  // create managed_shm_
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, shm_size_, 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Reset();
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  // create indicator_
+  indicator_ = new (managed_shm_) Indicator();
+  if (indicator_ == nullptr) {
+    AERROR << "create indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  ADEBUG << "open or create true.";
+  return true;
+}
+
+bool FutexNotifier::OpenOnly() {
+  // get managed_shm_
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed.";
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    return false;
+  }
+
+  // get indicator_
+  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
+  if (indicator_ == nullptr) {
+    AERROR << "get indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  ADEBUG << "open true.";
+  return true;
+}
+
+bool FutexNotifier::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  ADEBUG << "remove success.";
+
+  return true;
+}
+
+void FutexNotifier::Reset() {
+  indicator_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
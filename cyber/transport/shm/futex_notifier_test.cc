@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(FutexNotifierTest, notify_and_listen) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo info;
+  EXPECT_FALSE(notifier->Listen(10, nullptr));
+  EXPECT_FALSE(notifier->Listen(10, &info));
+
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(1, 2, 3)));
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(1, 3, 3)));
+  EXPECT_TRUE(notifier->Listen(10, &info));
+  EXPECT_EQ(info.host_id(), 1);
+  EXPECT_EQ(info.block_index(), 2);
+  EXPECT_EQ(info.channel_id(), 3);
+  EXPECT_TRUE(notifier->Listen(10, &info));
+  EXPECT_EQ(info.block_index(), 3);
+  EXPECT_FALSE(notifier->Listen(10, &info));
+}
+
+TEST(FutexNotifierTest, wake_up_listener) {
+  auto notifier = FutexNotifier::Instance();
+  std::thread writer([notifier]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    notifier->Notify(ReadableInfo(4, 5, 6));
+  });
+  ReadableInfo info;
+  EXPECT_TRUE(notifier->Listen(1000, &info));
+  EXPECT_EQ(info.block_index(), 5);
+  writer.join();
+
+  notifier->Shutdown();
+  EXPECT_FALSE(notifier->Notify(ReadableInfo(4, 5, 6)));
+  EXPECT_FALSE(notifier->Listen(10, &info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -16,8 +16,15 @@
 
 #include "cyber/transport/shm/segment.h"
 
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <fstream>
+#include <string>
 
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -26,8 +33,98 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+namespace {
+
+bool IsChannelListed(
+    uint64_t channel_id,
+    const google::protobuf::RepeatedPtrField<std::string>& channels) {
+  const std::string channel_name =
+      common::GlobalData::GetChannelById(channel_id);
+  for (auto& name : channels) {
+    if (name == channel_name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsSeqLockChannel(uint64_t channel_id) {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (!g_conf.has_transport_conf() || !g_conf.transport_conf().has_shm_conf()) {
+    return false;
+  }
+  return IsChannelListed(
+      channel_id, g_conf.transport_conf().shm_conf().seqlock_channels());
+}
+
+bool IsMultiSizeClassChannel(uint64_t channel_id) {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (!g_conf.has_transport_conf() || !g_conf.transport_conf().has_shm_conf()) {
+    return false;
+  }
+  return IsChannelListed(
+      channel_id,
+      g_conf.transport_conf().shm_conf().multi_size_class_channels());
+}
+
+bool IsHugePageChannel(uint64_t channel_id) {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (!g_conf.has_transport_conf() || !g_conf.transport_conf().has_shm_conf()) {
+    return false;
+  }
+  return IsChannelListed(
+      channel_id, g_conf.transport_conf().shm_conf().hugepage_channels());
+}
+
+// returns -1 if the channel isn't bound to a numa node
+int GetNumaNode(uint64_t channel_id) {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (!g_conf.has_transport_conf() || !g_conf.transport_conf().has_shm_conf()) {
+    return -1;
+  }
+  const std::string channel_name =
+      common::GlobalData::GetChannelById(channel_id);
+  for (auto& binding : g_conf.transport_conf().shm_conf().numa_bindings()) {
+    if (binding.channel() == channel_name) {
+      return static_cast<int>(binding.node());
+    }
+  }
+  return -1;
+}
+
+uint64_t GetHugePageSize() {
+  const uint64_t kDefaultHugePageSize = 2 * 1024 * 1024;
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key;
+  while (meminfo >> key) {
+    if (key == "Hugepagesize:") {
+      uint64_t size_kb = 0;
+      if (meminfo >> size_kb && size_kb > 0) {
+        return size_kb * 1024;
+      }
+      break;
+    }
+  }
+  return kDefaultHugePageSize;
+}
+
+// Sets the memory policy of the whole shm object, pages faulted in later by
+// any process attaching it come from |node| while it has free memory.
+bool BindToNumaNode(void* addr, uint64_t size, int node) {
+  unsigned long nodemask = 0;  // NOLINT
+  if (node < 0 || node >= static_cast<int>(sizeof(nodemask) * 8)) {
+    return false;
+  }
+  nodemask = 1UL << node;
+  return syscall(SYS_mbind, addr, size, MPOL_PREFERRED, &nodemask,
+                 sizeof(nodemask) * 8, 0) == 0;
+}
+
+}  // namespace
+
 Segment::Segment(uint64_t channel_id, const ReadWriteMode& mode)
     : init_(false),
+      channel_id_(channel_id),
       mode_(mode),
       conf_(),
       state_(nullptr),
@@ -36,6 +133,9 @@ Segment::Segment(uint64_t channel_id, const ReadWriteMode& mode)
       block_buf_lock_(),
       block_buf_addrs_() {
   id_ = static_cast<key_t>(channel_id);
+  if (mode_ == WRITE_ONLY && IsMultiSizeClassChannel(channel_id_)) {
+    conf_.Update(conf_.ceiling_msg_size(), true);
+  }
 }
 
 Segment::~Segment() { Destroy(); }
@@ -54,7 +154,7 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
   }
 
   if (msg_size > conf_.ceiling_msg_size()) {
-    conf_.Update(msg_size);
+    conf_.Update(msg_size, conf_.multi_size_class());
     result = Recreate();
   }
 
@@ -63,7 +163,7 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  uint32_t index = GetNextWritableBlockIndex();
+  uint32_t index = GetNextWritableBlockIndex(msg_size);
   writable_block->index = index;
   writable_block->block = &blocks_[index];
   writable_block->buf = block_buf_addrs_[index];
@@ -81,11 +181,74 @@ void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
 bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
   RETURN_VAL_IF_NULL(readable_block, false);
 
+  auto index = readable_block->index;
+  if (!PrepareToRead(index)) {
+    return false;
+  }
+
+  if (!blocks_[index].TryLockForRead()) {
+    return false;
+  }
+  readable_block->block = blocks_ + index;
+  readable_block->buf = block_buf_addrs_[index];
+  return true;
+}
+
+void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
+  auto index = readable_block.index;
+  if (index >= conf_.block_num()) {
+    return;
+  }
+  blocks_[index].ReleaseReadLock();
+}
+
+bool Segment::IsSeqLock() {
+  if (!init_ && !Init()) {
+    return false;
+  }
+  return state_->seqlock();
+}
+
+bool Segment::CopyBlockToRead(uint32_t index, BlockCopy* block_copy) {
+  RETURN_VAL_IF_NULL(block_copy, false);
+  if (!PrepareToRead(index)) {
+    return false;
+  }
+
+  Block& block = blocks_[index];
+  uint64_t seq = 0;
+  if (!block.TryBeginSeqRead(&seq)) {
+    ADEBUG << "block is being written.";
+    return false;
+  }
+
+  // sizes may be torn as well, check them before copying
+  uint64_t msg_size = block.msg_size();
+  uint64_t msg_info_size = block.msg_info_size();
+  if (msg_size + msg_info_size > conf_.GetBlockBufSizeOf(index)) {
+    return false;
+  }
+  const uint8_t* addr = block_buf_addrs_[index];
+  block_copy->buf.assign(addr, addr + msg_size + msg_info_size);
+
+  if (!block.ValidateSeqRead(seq)) {
+    ADEBUG << "block was overwritten while copying.";
+    return false;
+  }
+
+  block_copy->block.set_msg_size(msg_size);
+  block_copy->block.set_msg_info_size(msg_info_size);
+  block_copy->rb.index = index;
+  block_copy->rb.block = &block_copy->block;
+  block_copy->rb.buf = block_copy->buf.data();
+  return true;
+}
+
+bool Segment::PrepareToRead(uint32_t index) {
   if (!init_ && !Init()) {
     AERROR << "init failed, can't read now.";
     return false;
   }
-  auto index = readable_block->index;
   if (index >= conf_.block_num()) {
     AERROR << "invalid block_index[" << index << "].";
     return false;
@@ -100,23 +263,9 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     AERROR << "segment update failed.";
     return false;
   }
-
-  if (!blocks_[index].TryLockForRead()) {
-    return false;
-  }
-  readable_block->block = blocks_ + index;
-  readable_block->buf = block_buf_addrs_[index];
   return true;
 }
 
-void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
-  auto index = readable_block.index;
-  if (index >= conf_.block_num()) {
-    return;
-  }
-  blocks_[index].ReleaseReadLock();
-}
-
 bool Segment::Init() {
   if (mode_ == READ_ONLY) {
     return OpenOnly();
@@ -131,15 +280,31 @@ bool Segment::OpenOrCreate() {
   }
 
   // create managed_shm_
+  bool hugepage = IsHugePageChannel(channel_id_);
+  uint64_t shm_size = conf_.managed_shm_size();
+  int shm_flags = 0644 | IPC_CREAT | IPC_EXCL;
+  if (hugepage) {
+    uint64_t page_size = GetHugePageSize();
+    shm_size = (shm_size + page_size - 1) / page_size * page_size;
+    shm_flags |= SHM_HUGETLB;
+  }
+
   int retry = 0;
   int shmid = 0;
   while (retry < 2) {
-    shmid = shmget(id_, conf_.managed_shm_size(), 0644 | IPC_CREAT | IPC_EXCL);
+    shmid = shmget(id_, shm_size, shm_flags);
     if (shmid != -1) {
       break;
     }
 
-    if (EINVAL == errno) {
+    if (hugepage && (ENOMEM == errno || EPERM == errno)) {
+      AWARN << "no hugepages for channel "
+            << common::GlobalData::GetChannelById(channel_id_)
+            << ", use normal pages.";
+      hugepage = false;
+      shm_size = conf_.managed_shm_size();
+      shm_flags &= ~SHM_HUGETLB;
+    } else if (EINVAL == errno) {
       AINFO << "need larger space, recreate.";
       Reset();
       Remove();
@@ -165,6 +330,13 @@ bool Segment::OpenOrCreate() {
     return false;
   }
 
+  // bind before any page is touched, placement below faults the first ones
+  int numa_node = GetNumaNode(channel_id_);
+  if (numa_node >= 0 && !BindToNumaNode(managed_shm_, shm_size, numa_node)) {
+    AWARN << "bind shm to numa node " << numa_node
+          << " failed, error code: " << strerror(errno);
+  }
+
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
   if (state_ == nullptr) {
@@ -175,7 +347,9 @@ bool Segment::OpenOrCreate() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  state_->set_seqlock(IsSeqLockChannel(channel_id_));
+  state_->set_multi_size_class(conf_.multi_size_class());
+  conf_.Update(state_->ceiling_msg_size(), state_->multi_size_class());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
@@ -195,8 +369,8 @@ bool Segment::OpenOrCreate() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr =
         new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
+             conf_.block_num() * sizeof(Block) + conf_.GetBlockBufOffset(i))
+            uint8_t[conf_.GetBlockBufSizeOf(i)];
     std::lock_guard<std::mutex> _g(block_buf_lock_);
     block_buf_addrs_[i] = addr;
   }
@@ -250,7 +424,7 @@ bool Segment::OpenOnly() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->multi_size_class());
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -268,7 +442,7 @@ bool Segment::OpenOnly() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr = reinterpret_cast<uint8_t*>(
         static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
+        conf_.block_num() * sizeof(Block) + conf_.GetBlockBufOffset(i));
 
     if (addr == nullptr) {
       break;
@@ -360,24 +534,43 @@ bool Segment::Recreate() {
   return OpenOrCreate();
 }
 
-uint32_t Segment::GetNextWritableBlockIndex() {
-  uint32_t try_idx = state_->wrote_num();
+uint32_t Segment::GetNextWritableBlockIndex(std::size_t msg_size) {
+  uint32_t class_index = conf_.GetSizeClassIndex(msg_size);
+  auto& size_class = conf_.size_classes()[class_index];
+  uint32_t begin = size_class.first_block_index;
+  uint32_t num = size_class.block_num;
+  uint32_t try_idx = state_->wrote_num() % num;
 
-  auto max_mod_num = conf_.block_num() - 1;
   while (1) {
-    if (try_idx >= conf_.block_num()) {
-      try_idx &= max_mod_num;
+    if (try_idx >= num) {
+      try_idx = 0;
     }
 
-    if (blocks_[try_idx].TryLockForWrite()) {
+    if (blocks_[begin + try_idx].TryLockForWrite()) {
       state_->IncreaseWroteNum();
-      return try_idx;
+      state_->IncreaseSizeClassCount(class_index);
+      return begin + try_idx;
     }
 
     ++try_idx;
   }
 }
 
+bool Segment::GetSizeClassCounts(
+    std::vector<std::pair<uint64_t, uint64_t>>* counts) {
+  RETURN_VAL_IF_NULL(counts, false);
+  if (!init_ && !Init()) {
+    return false;
+  }
+  counts->clear();
+  auto& size_classes = conf_.size_classes();
+  for (uint32_t i = 0; i < size_classes.size(); ++i) {
+    counts->emplace_back(size_classes[i].ceiling_msg_size,
+                         state_->size_class_count(i));
+  }
+  return true;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
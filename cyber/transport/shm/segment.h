@@ -26,6 +26,8 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -50,6 +52,13 @@ struct WritableBlock {
 };
 using ReadableBlock = WritableBlock;
 
+// Private copy of a block taken from a seqlock segment, |rb| points into it.
+struct BlockCopy {
+  ReadableBlock rb;
+  Block block;
+  std::vector<uint8_t> buf;
+};
+
 class Segment final {
  public:
   Segment(uint64_t channel_id, const ReadWriteMode& mode);
@@ -61,8 +70,18 @@ class Segment final {
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  // Seqlock segments are read without locking: the block is copied and the
+  // copy is rejected if a writer touched the block in the meantime.
+  bool IsSeqLock();
+  bool CopyBlockToRead(uint32_t index, BlockCopy* block_copy);
+
+  // how many blocks of each size class (keyed by ceiling message size)
+  // were written since the segment was created
+  bool GetSizeClassCounts(std::vector<std::pair<uint64_t, uint64_t>>* counts);
+
  private:
   bool Init();
+  bool PrepareToRead(uint32_t index);
   bool OpenOrCreate();
   bool OpenOnly();
   bool Remove();
@@ -71,9 +90,10 @@ class Segment final {
   bool Remap();
   bool Recreate();
 
-  uint32_t GetNextWritableBlockIndex();
+  uint32_t GetNextWritableBlockIndex(std::size_t msg_size);
 
   bool init_;
+  uint64_t channel_id_;
   key_t id_;
   ReadWriteMode mode_;
   ShmConf conf_;
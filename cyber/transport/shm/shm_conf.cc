@@ -28,11 +28,75 @@ ShmConf::ShmConf(const uint64_t& real_msg_size) { Update(real_msg_size); }
 ShmConf::~ShmConf() {}
 
 void ShmConf::Update(const uint64_t& real_msg_size) {
+  Update(real_msg_size, false);
+}
+
+void ShmConf::Update(const uint64_t& real_msg_size, bool multi_size_class) {
   ceiling_msg_size_ = GetCeilingMessageSize(real_msg_size);
   block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
-  block_num_ = GetBlockNum(ceiling_msg_size_);
+  multi_size_class_ = multi_size_class;
+
+  std::vector<uint64_t> ceilings;
+  if (multi_size_class_) {
+    for (auto size : {MESSAGE_SIZE_16K, MESSAGE_SIZE_128K, MESSAGE_SIZE_1M,
+                      MESSAGE_SIZE_8M, MESSAGE_SIZE_16M, MESSAGE_SIZE_MORE}) {
+      if (size <= ceiling_msg_size_) {
+        ceilings.push_back(size);
+      }
+    }
+  } else {
+    ceilings.push_back(ceiling_msg_size_);
+  }
+
+  size_classes_.clear();
+  block_num_ = 0;
+  uint64_t buf_offset = 0;
+  for (auto ceiling : ceilings) {
+    SizeClass size_class;
+    size_class.ceiling_msg_size = ceiling;
+    size_class.block_buf_size = GetBlockBufSize(ceiling);
+    size_class.block_num = multi_size_class_
+                               ? GetMultiSizeClassBlockNum(ceiling)
+                               : GetBlockNum(ceiling);
+    size_class.first_block_index = block_num_;
+    size_class.first_buf_offset = buf_offset;
+    size_classes_.push_back(size_class);
+
+    block_num_ += size_class.block_num;
+    buf_offset += size_class.block_buf_size * size_class.block_num;
+  }
   managed_shm_size_ =
-      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
+      EXTRA_SIZE + STATE_SIZE + BLOCK_SIZE * block_num_ + buf_offset;
+}
+
+uint32_t ShmConf::GetSizeClassIndex(const uint64_t& msg_size) {
+  uint32_t index = 0;
+  for (; index + 1 < size_classes_.size(); ++index) {
+    if (msg_size <= size_classes_[index].ceiling_msg_size) {
+      break;
+    }
+  }
+  return index;
+}
+
+uint64_t ShmConf::GetBlockBufOffset(uint32_t block_index) {
+  auto& size_class = GetSizeClassOf(block_index);
+  return size_class.first_buf_offset +
+         static_cast<uint64_t>(block_index - size_class.first_block_index) *
+             size_class.block_buf_size;
+}
+
+uint64_t ShmConf::GetBlockBufSizeOf(uint32_t block_index) {
+  return GetSizeClassOf(block_index).block_buf_size;
+}
+
+const ShmConf::SizeClass& ShmConf::GetSizeClassOf(uint32_t block_index) {
+  for (auto& size_class : size_classes_) {
+    if (block_index < size_class.first_block_index + size_class.block_num) {
+      return size_class;
+    }
+  }
+  return size_classes_.back();
 }
 
 const uint64_t ShmConf::EXTRA_SIZE = 1024 * 4;
@@ -76,6 +140,37 @@ uint64_t ShmConf::GetCeilingMessageSize(const uint64_t& real_msg_size) {
   return ceiling_msg_size;
 }
 
+uint32_t ShmConf::GetMultiSizeClassBlockNum(
+    const uint64_t& ceiling_msg_size) {
+  // fewer blocks per class than the single class layouts, as every class
+  // only serves part of the traffic
+  uint32_t num = 0;
+  switch (ceiling_msg_size) {
+    case MESSAGE_SIZE_16K:
+      num = BLOCK_NUM_16K / 4;
+      break;
+    case MESSAGE_SIZE_128K:
+      num = BLOCK_NUM_128K / 4;
+      break;
+    case MESSAGE_SIZE_1M:
+      num = BLOCK_NUM_1M / 4;
+      break;
+    case MESSAGE_SIZE_8M:
+      num = BLOCK_NUM_8M / 8;
+      break;
+    case MESSAGE_SIZE_16M:
+      num = BLOCK_NUM_16M / 8;
+      break;
+    case MESSAGE_SIZE_MORE:
+      num = BLOCK_NUM_MORE / 4;
+      break;
+    default:
+      AERROR << "unknown ceiling_msg_size[" << ceiling_msg_size << "]";
+      break;
+  }
+  return num;
+}
+
 uint64_t ShmConf::GetBlockBufSize(const uint64_t& ceiling_msg_size) {
   return ceiling_msg_size + MESSAGE_INFO_SIZE;
 }
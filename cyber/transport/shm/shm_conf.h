@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace cyber {
@@ -26,26 +27,51 @@ namespace transport {
 
 class ShmConf {
  public:
+  // Blocks of one size class are contiguous, classes are laid out by
+  // increasing ceiling message size.
+  struct SizeClass {
+    uint64_t ceiling_msg_size;
+    uint64_t block_buf_size;
+    uint32_t block_num;
+    uint32_t first_block_index;
+    uint64_t first_buf_offset;
+  };
+
   ShmConf();
   explicit ShmConf(const uint64_t& real_msg_size);
   virtual ~ShmConf();
 
   void Update(const uint64_t& real_msg_size);
+  // A multi size class layout holds blocks of every standard size up to the
+  // ceiling, so messages of any smaller size are written without remapping.
+  void Update(const uint64_t& real_msg_size, bool multi_size_class);
 
   const uint64_t& ceiling_msg_size() { return ceiling_msg_size_; }
   const uint64_t& block_buf_size() { return block_buf_size_; }
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
+  bool multi_size_class() const { return multi_size_class_; }
+  const std::vector<SizeClass>& size_classes() const { return size_classes_; }
+
+  // smallest size class which is able to hold |msg_size|
+  uint32_t GetSizeClassIndex(const uint64_t& msg_size);
+  // offset of the block's buffer from the first block buffer
+  uint64_t GetBlockBufOffset(uint32_t block_index);
+  uint64_t GetBlockBufSizeOf(uint32_t block_index);
 
  private:
   uint64_t GetCeilingMessageSize(const uint64_t& real_msg_size);
   uint64_t GetBlockBufSize(const uint64_t& ceiling_msg_size);
   uint32_t GetBlockNum(const uint64_t& ceiling_msg_size);
+  uint32_t GetMultiSizeClassBlockNum(const uint64_t& ceiling_msg_size);
+  const SizeClass& GetSizeClassOf(uint32_t block_index);
 
   uint64_t ceiling_msg_size_;
   uint64_t block_buf_size_;
   uint32_t block_num_;
   uint64_t managed_shm_size_;
+  bool multi_size_class_;
+  std::vector<SizeClass> size_classes_;
 
   // Extra size, Byte
   static const uint64_t EXTRA_SIZE;
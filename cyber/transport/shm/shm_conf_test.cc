@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_conf.h"
+
+#include <gtest/gtest.h>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ShmConfTest, single_size_class) {
+  ShmConf conf(1024 * 200);
+  EXPECT_EQ(conf.ceiling_msg_size(), 1024 * 1024);
+  EXPECT_FALSE(conf.multi_size_class());
+  ASSERT_EQ(conf.size_classes().size(), 1);
+  EXPECT_EQ(conf.block_num(), 64);
+  EXPECT_EQ(conf.GetSizeClassIndex(1), 0);
+  EXPECT_EQ(conf.GetBlockBufOffset(0), 0);
+  EXPECT_EQ(conf.GetBlockBufOffset(3), 3 * conf.block_buf_size());
+  EXPECT_EQ(conf.GetBlockBufSizeOf(63), conf.block_buf_size());
+}
+
+TEST(ShmConfTest, multi_size_class) {
+  ShmConf conf;
+  conf.Update(1024 * 1024 * 8, true);
+  EXPECT_TRUE(conf.multi_size_class());
+  auto& size_classes = conf.size_classes();
+  ASSERT_EQ(size_classes.size(), 4);
+
+  uint32_t block_num = 0;
+  uint64_t buf_size = 0;
+  for (auto& size_class : size_classes) {
+    EXPECT_EQ(size_class.first_block_index, block_num);
+    EXPECT_EQ(size_class.first_buf_offset, buf_size);
+    block_num += size_class.block_num;
+    buf_size += size_class.block_num * size_class.block_buf_size;
+  }
+  EXPECT_EQ(conf.block_num(), block_num);
+  EXPECT_GT(conf.managed_shm_size(), buf_size);
+
+  EXPECT_EQ(conf.GetSizeClassIndex(100), 0);
+  EXPECT_EQ(conf.GetSizeClassIndex(1024 * 16), 0);
+  EXPECT_EQ(conf.GetSizeClassIndex(1024 * 16 + 1), 1);
+  EXPECT_EQ(conf.GetSizeClassIndex(1024 * 1024 * 2), 3);
+
+  auto& large = size_classes[3];
+  EXPECT_EQ(conf.GetBlockBufOffset(large.first_block_index + 1),
+            large.first_buf_offset + large.block_buf_size);
+  EXPECT_EQ(conf.GetBlockBufSizeOf(large.first_block_index),
+            large.block_buf_size);
+  EXPECT_EQ(conf.GetBlockBufSizeOf(0), size_classes[0].block_buf_size);
+
+  // growing keeps the smaller classes
+  conf.Update(1024 * 1024 * 12, true);
+  EXPECT_EQ(conf.size_classes().size(), 5);
+  EXPECT_EQ(conf.ceiling_msg_size(), 1024 * 1024 * 16);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
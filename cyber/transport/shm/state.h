@@ -49,12 +49,34 @@ class State {
   void set_need_remap(bool need) { need_remap_.store(need); }
   bool need_remap() { return need_remap_; }
 
+  void set_seqlock(bool seqlock) { seqlock_.store(seqlock); }
+  bool seqlock() { return seqlock_.load(); }
+
+  void set_multi_size_class(bool multi) { multi_size_class_.store(multi); }
+  bool multi_size_class() { return multi_size_class_.load(); }
+
+  void IncreaseSizeClassCount(uint32_t class_index) {
+    if (class_index < kMaxSizeClassNum) {
+      size_class_counts_[class_index].fetch_add(1);
+    }
+  }
+  uint64_t size_class_count(uint32_t class_index) {
+    return class_index < kMaxSizeClassNum
+               ? size_class_counts_[class_index].load()
+               : 0;
+  }
+
+  static const uint32_t kMaxSizeClassNum = 8;
+
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
   uint32_t wrote_num() { return wrote_num_.load(); }
 
  private:
   std::atomic<bool> need_remap_ = {false};
+  std::atomic<bool> seqlock_ = {false};
+  std::atomic<bool> multi_size_class_ = {false};
+  std::atomic<uint64_t> size_class_counts_[kMaxSizeClassNum] = {};
   std::atomic<uint32_t> wrote_num_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
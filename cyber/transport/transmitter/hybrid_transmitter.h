@@ -28,6 +28,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/types.h"
+#include "cyber/message/message_traits.h"
 #include "cyber/proto/role_attributes.pb.h"
 #include "cyber/proto/transport_conf.pb.h"
 #include "cyber/task/task.h"
@@ -71,6 +72,11 @@ class HybridTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool AcquireLoanedBlock(std::size_t size, WritableBlock* wb) override;
+  void ReturnLoanedBlock(const WritableBlock& wb) override;
+  bool TransmitLoanedBlock(const WritableBlock& wb,
+                           const MessageInfo& msg_info) override;
+
  private:
   void InitMode();
   void ObtainConfig();
@@ -83,6 +89,7 @@ class HybridTransmitter : public Transmitter<M> {
   void ThreadFunc(const RoleAttributes& opposite_attr,
                   const std::vector<typename History<M>::CachedMessage>& msgs);
   Relation GetRelation(const RoleAttributes& opposite_attr);
+  bool HasReceivers(OptionalMode mode);
 
   HistoryPtr history_;
   TransmitterMap transmitters_;
@@ -107,6 +114,7 @@ HybridTransmitter<M>::HybridTransmitter(const RoleAttributes& attr,
   InitHistory();
   InitTransmitters();
   InitReceivers();
+  this->stats_ = ChannelStats::Instance()->GetCounters(attr.channel_id());
 }
 
 template <typename M>
@@ -165,12 +173,93 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
                                     const MessageInfo& msg_info) {
   std::lock_guard<std::mutex> lock(mutex_);
   history_->Add(msg, msg_info);
+
+  // both shm and rtps put bytes on the wire, serialize only once for them
+  std::string serialized;
+  bool serialize_once =
+      HasReceivers(OptionalMode::SHM) && HasReceivers(OptionalMode::RTPS);
+  if (serialize_once && !message::SerializeToString(*msg, &serialized)) {
+    AERROR << "serialize message failed.";
+    serialize_once = false;
+  }
+
   for (auto& item : transmitters_) {
-    item.second->Transmit(msg, msg_info);
+    if (serialize_once && item.first != OptionalMode::INTRA) {
+      item.second->TransmitSerialized(msg, serialized, msg_info);
+    } else {
+      item.second->Transmit(msg, msg_info);
+    }
   }
   return true;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::AcquireLoanedBlock(std::size_t size,
+                                              WritableBlock* wb) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter == transmitters_.end()) {
+    return false;
+  }
+  return iter->second->AcquireLoanedBlock(size, wb);
+}
+
+template <typename M>
+void HybridTransmitter<M>::ReturnLoanedBlock(const WritableBlock& wb) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter != transmitters_.end()) {
+    iter->second->ReturnLoanedBlock(wb);
+  }
+}
+
+template <typename M>
+bool HybridTransmitter<M>::TransmitLoanedBlock(const WritableBlock& wb,
+                                               const MessageInfo& msg_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter == transmitters_.end()) {
+    return false;
+  }
+
+  // rtps reuses the bytes of the block, history and intra still need a
+  // message object. Both are built before the block is handed to readers.
+  std::string serialized;
+  bool need_bytes = HasReceivers(OptionalMode::RTPS);
+  if (need_bytes) {
+    serialized.assign(reinterpret_cast<const char*>(wb.buf),
+                      wb.block->msg_size());
+  }
+  MessagePtr msg = nullptr;
+  if (history_->enabled() || HasReceivers(OptionalMode::INTRA)) {
+    msg = std::make_shared<M>();
+    if (!message::ParseFromArray(
+            wb.buf, static_cast<int>(wb.block->msg_size()), msg.get())) {
+      AERROR << "parse loaned block failed.";
+      msg = nullptr;
+    }
+  }
+
+  bool result = iter->second->TransmitLoanedBlock(wb, msg_info);
+
+  if (msg != nullptr) {
+    history_->Add(msg, msg_info);
+  }
+  for (auto& item : transmitters_) {
+    if (item.first == OptionalMode::SHM) {
+      continue;
+    }
+    if (item.first == OptionalMode::RTPS) {
+      if (need_bytes) {
+        item.second->TransmitSerialized(msg, serialized, msg_info);
+      }
+    } else if (msg != nullptr) {
+      item.second->Transmit(msg, msg_info);
+    }
+  }
+  return result;
+}
+
 template <typename M>
 void HybridTransmitter<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -310,6 +399,12 @@ Relation HybridTransmitter<M>::GetRelation(
   return SAME_PROC;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::HasReceivers(OptionalMode mode) {
+  auto iter = receivers_.find(mode);
+  return iter != receivers_.end() && !iter->second.empty();
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
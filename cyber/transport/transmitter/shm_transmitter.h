@@ -47,9 +47,17 @@ class ShmTransmitter : public Transmitter<M> {
   void Disable() override;
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool TransmitSerialized(const MessagePtr& msg, const std::string& serialized,
+                          const MessageInfo& msg_info) override;
+
+  bool AcquireLoanedBlock(std::size_t size, WritableBlock* wb) override;
+  void ReturnLoanedBlock(const WritableBlock& wb) override;
+  bool TransmitLoanedBlock(const WritableBlock& wb,
+                           const MessageInfo& msg_info) override;
 
  private:
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Publish(const WritableBlock& wb, const MessageInfo& msg_info);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -118,8 +126,70 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
     return false;
   }
   wb.block->set_msg_size(msg_size);
+  return Publish(wb, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::TransmitSerialized(const MessagePtr& msg,
+                                           const std::string& serialized,
+                                           const MessageInfo& msg_info) {
+  (void)msg;
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  WritableBlock wb;
+  if (!segment_->AcquireBlockToWrite(serialized.size(), &wb)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+
+  ADEBUG << "block index: " << wb.index;
+  std::memcpy(wb.buf, serialized.data(), serialized.size());
+  wb.block->set_msg_size(serialized.size());
+  return Publish(wb, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::AcquireLoanedBlock(std::size_t size,
+                                           WritableBlock* wb) {
+  RETURN_VAL_IF_NULL(wb, false);
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  if (!segment_->AcquireBlockToWrite(size, wb)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+  wb->block->set_msg_size(size);
+  return true;
+}
+
+template <typename M>
+void ShmTransmitter<M>::ReturnLoanedBlock(const WritableBlock& wb) {
+  if (segment_ != nullptr) {
+    segment_->ReleaseWrittenBlock(wb);
+  }
+}
+
+template <typename M>
+bool ShmTransmitter<M>::TransmitLoanedBlock(const WritableBlock& wb,
+                                            const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+  return Publish(wb, msg_info);
+}
 
-  char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
+template <typename M>
+bool ShmTransmitter<M>::Publish(const WritableBlock& wb,
+                                const MessageInfo& msg_info) {
+  char* msg_info_addr =
+      reinterpret_cast<char*>(wb.buf) + wb.block->msg_size();
   if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
     AERROR << "serialize message info failed.";
     segment_->ReleaseWrittenBlock(wb);
@@ -17,13 +17,18 @@
 #ifndef CYBER_TRANSPORT_TRANSMITTER_TRANSMITTER_H_
 #define CYBER_TRANSPORT_TRANSMITTER_TRANSMITTER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/time/time.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/shm/channel_stats.h"
+#include "cyber/transport/shm/segment.h"
 
 namespace apollo {
 namespace cyber {
@@ -49,6 +54,21 @@ class Transmitter : public Endpoint {
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
 
+  // |serialized| holds the bytes of |msg| already, transmitters that put
+  // bytes on the wire reuse them instead of serializing |msg| again.
+  virtual bool TransmitSerialized(const MessagePtr& msg,
+                                  const std::string& serialized,
+                                  const MessageInfo& msg_info);
+
+  // Loaned blocks let a writer build a message of |size| bytes directly in
+  // transport owned memory. Transmitters that can't loan return false and
+  // the caller falls back to Transmit.
+  virtual bool AcquireLoanedBlock(std::size_t size, WritableBlock* wb);
+  virtual void ReturnLoanedBlock(const WritableBlock& wb);
+  bool TransmitLoanedBlock(const WritableBlock& wb);
+  virtual bool TransmitLoanedBlock(const WritableBlock& wb,
+                                   const MessageInfo& msg_info);
+
   uint64_t NextSeqNum() { return ++seq_num_; }
 
   uint64_t seq_num() const { return seq_num_; }
@@ -56,11 +76,13 @@ class Transmitter : public Endpoint {
  protected:
   uint64_t seq_num_;
   MessageInfo msg_info_;
+  // set by the transmitter writers publish through, counts every publish
+  ChannelStats::Counters* stats_;
 };
 
 template <typename M>
 Transmitter<M>::Transmitter(const RoleAttributes& attr)
-    : Endpoint(attr), seq_num_(0) {
+    : Endpoint(attr), seq_num_(0), stats_(nullptr) {
   msg_info_.set_sender_id(this->id_);
   msg_info_.set_seq_num(this->seq_num_);
 }
@@ -71,9 +93,60 @@ Transmitter<M>::~Transmitter() {}
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
+  msg_info_.set_send_time(Time::Now().ToNanosecond());
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANS_FROM, attr_.channel_id(), msg_info_.seq_num());
-  return Transmit(msg, msg_info_);
+  if (!Transmit(msg, msg_info_)) {
+    return false;
+  }
+  if (stats_ != nullptr) {
+    int msg_size = message::ByteSize(*msg);
+    stats_->AddPublish(msg_size > 0 ? msg_size : 0, msg_info_.send_time());
+  }
+  return true;
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitSerialized(const MessagePtr& msg,
+                                        const std::string& serialized,
+                                        const MessageInfo& msg_info) {
+  (void)serialized;
+  return Transmit(msg, msg_info);
+}
+
+template <typename M>
+bool Transmitter<M>::AcquireLoanedBlock(std::size_t size, WritableBlock* wb) {
+  (void)size;
+  (void)wb;
+  return false;
+}
+
+template <typename M>
+void Transmitter<M>::ReturnLoanedBlock(const WritableBlock& wb) {
+  (void)wb;
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitLoanedBlock(const WritableBlock& wb) {
+  msg_info_.set_seq_num(NextSeqNum());
+  msg_info_.set_send_time(Time::Now().ToNanosecond());
+  PerfEventCache::Instance()->AddTransportEvent(
+      TransPerf::TRANS_FROM, attr_.channel_id(), msg_info_.seq_num());
+  if (!TransmitLoanedBlock(wb, msg_info_)) {
+    return false;
+  }
+  if (stats_ != nullptr) {
+    stats_->AddPublish(wb.block->msg_size(), msg_info_.send_time());
+  }
+  return true;
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitLoanedBlock(const WritableBlock& wb,
+                                         const MessageInfo& msg_info) {
+  (void)wb;
+  (void)msg_info;
+  return false;
 }
 
 template <typename M>
@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+
+###############################################################################
+# Copyright 2019 The Apollo Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+###############################################################################
+
+# Fail on first error.
+set -e
+
+cd "$(dirname "${BASH_SOURCE[0]}")"
+
+# Install lz4 and zstd for record chunk compression, the trusty packages are
+# too old.
+wget https://github.com/lz4/lz4/archive/v1.8.3.tar.gz
+tar xzf v1.8.3.tar.gz
+pushd lz4-1.8.3
+make -j8
+make install
+popd
+
+wget https://github.com/facebook/zstd/archive/v1.3.8.tar.gz
+tar xzf v1.3.8.tar.gz
+pushd zstd-1.3.8
+make -j8
+make install
+popd
+
+ldconfig
+
+# Clean up.
+rm -fr v1.8.3.tar.gz lz4-1.8.3 v1.3.8.tar.gz zstd-1.3.8
@@ -20,6 +20,7 @@
 #include "modules/canbus/vehicle/vehicle_factory.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/time/time.h"
+#include "modules/common/util/trace_util.h"
 #include "modules/common/util/util.h"
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 
@@ -169,6 +170,13 @@ bool CanbusComponent::Init() {
 void CanbusComponent::PublishChassis() {
   Chassis chassis = vehicle_controller_->chassis();
   common::util::FillHeader(node_->Name(), &chassis);
+  {
+    // The chassis reports the trace of the last command sent to the vehicle.
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    if (actuated_trace_.has_sensor_timestamp_sec()) {
+      chassis.mutable_header()->mutable_trace()->CopyFrom(actuated_trace_);
+    }
+  }
   chassis_writer_->Write(std::make_shared<Chassis>(chassis));
   ADEBUG << chassis.ShortDebugString();
 }
@@ -213,6 +221,13 @@ void CanbusComponent::OnControlCommand(const ControlCommand &control_command) {
     return;
   }
   can_sender_.Update();
+
+  common::TraceContext trace;
+  if (common::util::InitTrace(control_command.header(), &trace)) {
+    common::util::AddTraceHop(node_->Name(), Clock::NowInSeconds(), &trace);
+  }
+  std::lock_guard<std::mutex> lock(trace_mutex_);
+  actuated_trace_.Swap(&trace);
 }
 
 void CanbusComponent::OnGuardianCommand(
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -103,6 +104,9 @@ class CanbusComponent final : public apollo::cyber::TimerComponent {
   ::apollo::common::monitor::MonitorLogBuffer monitor_logger_buffer_;
   std::shared_ptr<Writer<Chassis>> chassis_writer_;
   std::shared_ptr<Writer<ChassisDetail>> chassis_detail_writer_;
+  // Trace of the last control command sent, with the sending as last hop.
+  ::apollo::common::TraceContext actuated_trace_;
+  std::mutex trace_mutex_;
 };
 
 CYBER_REGISTER_COMPONENT(CanbusComponent)
@@ -86,6 +86,8 @@ DEFINE_string(gnss_status_topic, "/apollo/sensor/gnss/gnss_status",
               "gnss status topic name");
 DEFINE_string(system_status_topic, "/apollo/monitor/system_status",
               "System status topic name");
+DEFINE_string(latency_report_topic, "/apollo/monitor/latency_report",
+              "Pipeline latency report topic name");
 DEFINE_string(static_info_topic, "/apollo/monitor/static_info",
               "Static info topic name");
 DEFINE_string(mobileye_topic, "/apollo/sensor/mobileye", "mobileye topic name");
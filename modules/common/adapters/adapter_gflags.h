@@ -51,6 +51,7 @@ DECLARE_string(ins_stat_topic);
 DECLARE_string(ins_status_topic);
 DECLARE_string(gnss_status_topic);
 DECLARE_string(system_status_topic);
+DECLARE_string(latency_report_topic);
 DECLARE_string(static_info_topic);
 DECLARE_string(mobileye_topic);
 DECLARE_string(delphi_esr_topic);
@@ -24,6 +24,27 @@ namespace {
 
 const double kDoubleEpsilon = 1.0e-6;
 
+// Resizes a history of the latest values stored twice in a row, keeping the
+// latest of them like std::deque::resize does.
+void ResizeHistory(const std::size_t size, std::vector<double> *values,
+                   std::size_t *head) {
+  const std::size_t old_size = values->size() / 2;
+  std::vector<double> resized(2 * size, 0.0);
+  for (std::size_t i = 0; i < size && i < old_size; ++i) {
+    resized[i] = resized[i + size] = (*values)[*head + i];
+  }
+  values->swap(resized);
+  *head = 0;
+}
+
+// Inserts the latest value at the front of a history, dropping the oldest.
+void PushFront(const double value, std::vector<double> *values,
+               std::size_t *head) {
+  const std::size_t size = values->size() / 2;
+  *head = (*head + size - 1) % size;
+  (*values)[*head] = (*values)[*head + size] = value;
+}
+
 }  // namespace
 
 namespace apollo {
@@ -36,12 +57,12 @@ DigitalFilter::DigitalFilter(const std::vector<double> &denominators,
 
 void DigitalFilter::set_denominators(const std::vector<double> &denominators) {
   denominators_ = denominators;
-  y_values_.resize(denominators_.size(), 0.0);
+  ResizeHistory(denominators_.size(), &y_values_, &y_head_);
 }
 
 void DigitalFilter::set_numerators(const std::vector<double> &numerators) {
   numerators_ = numerators;
-  x_values_.resize(numerators_.size(), 0.0);
+  ResizeHistory(numerators_.size(), &x_values_, &x_head_);
 }
 
 void DigitalFilter::set_coefficients(const std::vector<double> &denominators,
@@ -61,20 +82,19 @@ double DigitalFilter::Filter(const double x_insert) {
     return 0.0;
   }
 
-  x_values_.pop_back();
-  x_values_.push_front(x_insert);
-  const double xside =
-      Compute(x_values_, numerators_, 0, numerators_.size() - 1);
+  PushFront(x_insert, &x_values_, &x_head_);
+  const double xside = Compute(x_values_.data() + x_head_, numerators_, 0,
+                               numerators_.size() - 1);
 
-  y_values_.pop_back();
-  const double yside =
-      Compute(y_values_, denominators_, 1, denominators_.size() - 1);
+  // the oldest y value is left out
+  const double yside = Compute(y_values_.data() + y_head_, denominators_, 1,
+                               denominators_.size() - 1);
 
   double y_insert = 0.0;
   if (std::abs(denominators_.front()) > kDoubleEpsilon) {
     y_insert = (xside - yside) / denominators_.front();
   }
-  y_values_.push_front(y_insert);
+  PushFront(y_insert, &y_values_, &y_head_);
 
   return UpdateLast(y_insert);
 }
@@ -89,18 +109,17 @@ double DigitalFilter::UpdateLast(const double input) {
   }
 }
 
-double DigitalFilter::Compute(const std::deque<double> &values,
+double DigitalFilter::Compute(const double *values,
                               const std::vector<double> &coefficients,
                               const std::size_t coeff_start,
                               const std::size_t coeff_end) {
   CHECK(coeff_start <= coeff_end && coeff_end < coefficients.size());
-  CHECK((coeff_end - coeff_start + 1) == values.size());
 
+  const double *coefficient = coefficients.data() + coeff_start;
+  const std::size_t size = coeff_end - coeff_start + 1;
   double sum = 0.0;
-  auto i = coeff_start;
-  for (const auto value : values) {
-    sum += value * coefficients[i];
-    ++i;
+  for (std::size_t i = 0; i < size; ++i) {
+    sum += values[i] * coefficient[i];
   }
   return sum;
 }
@@ -21,7 +21,7 @@
 
 #pragma once
 
-#include <deque>
+#include <cstddef>
 #include <vector>
 
 /**
@@ -36,6 +36,9 @@ namespace common {
  * @brief The DigitalFilter class is used to pass signals with a frequency
  * lower than a certain cutoff frequency and attenuates signals with
  * frequencies higher than the cutoff frequency.
+ *
+ * The input and output histories are fixed size ring buffers, so filtering
+ * does not allocate and each side is a dot product over contiguous memory.
  */
 class DigitalFilter {
  public:
@@ -122,18 +125,20 @@ class DigitalFilter {
   double UpdateLast(const double input);
 
   /**
-   * @desc: Compute the inner product of values[coeff_start : coeff_end] and
-   *        coefficients[coeff_start : coeff_end]
+   * @desc: Compute the inner product of values[0 : coeff_end - coeff_start]
+   *        and coefficients[coeff_start : coeff_end]
    */
-  double Compute(const std::deque<double> &values,
-                 const std::vector<double> &coefficients,
+  double Compute(const double *values, const std::vector<double> &coefficients,
                  const std::size_t coeff_start, const std::size_t coeff_end);
 
-  // Front is latest, back is oldest.
-  std::deque<double> x_values_;
+  // Each history is stored twice in a row, so that starting at its head the
+  // latest values are contiguous. Front is latest, back is oldest.
+  std::vector<double> x_values_;
+  std::size_t x_head_ = 0;
 
-  // Front is latest, back is oldest.
-  std::deque<double> y_values_;
+  // Stored like x_values_.
+  std::vector<double> y_values_;
+  std::size_t y_head_ = 0;
 
   // Coefficients with y values
   std::vector<double> denominators_;
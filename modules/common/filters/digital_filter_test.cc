@@ -104,5 +104,23 @@ TEST_F(DigitalFilterTest, MovingAverage) {
   }
 }
 
+TEST_F(DigitalFilterTest, SecondOrder) {
+  const std::vector<double> numerators = {0.1, 0.2, 0.1};
+  const std::vector<double> denominators = {1.0, -0.8, 0.2};
+  DigitalFilter digital_filter(denominators, numerators);
+
+  // direct form of the difference equation
+  double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    const double x = (i % 7) * 0.5 - 1.0;
+    const double y = 0.1 * x + 0.2 * x1 + 0.1 * x2 + 0.8 * y1 - 0.2 * y2;
+    EXPECT_NEAR(digital_filter.Filter(x), y, 1e-12);
+    x2 = x1;
+    x1 = x;
+    y2 = y1;
+    y1 = y;
+  }
+}
+
 }  // namespace common
 }  // namespace apollo
@@ -17,107 +17,293 @@
 
 #include <sqlite3.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "gflags/gflags.h"
 
 #include "cyber/common/log.h"
-#include "modules/common/util/string_util.h"
-#include "modules/common/util/util.h"
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db.sqlite",
               "Path to Key-value DB file.");
+DEFINE_int32(kv_db_flush_interval_ms, 100,
+             "Writes are batched into one transaction flushed this often in "
+             "the background, 0 to write through synchronously.");
 
 namespace apollo {
 namespace common {
 namespace {
-using apollo::common::util::StrCat;
 
-// Self-maintained sqlite instance.
+// Self-maintained sqlite instance, shared by all calls of the process.
+// Read values are cached until another connection changes the DB, and
+// writes are batched into one transaction by a flush thread.
 class SqliteWraper {
  public:
-  static int Callback(void *data, int argc, char **argv, char **col_name) {
-    if (data != nullptr) {
-      std::string *data_str = static_cast<std::string *>(data);
-      *data_str = argc > 0 ? argv[0] : "";
+  static SqliteWraper *Instance() {
+    static SqliteWraper instance;
+    return &instance;
+  }
+
+  ~SqliteWraper() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    if (flush_thread_.joinable()) {
+      flush_thread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+    Release();
+  }
+
+  bool Write(const std::string &key, const std::string &value,
+             const bool deleted) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (db_ == nullptr) {
+      AERROR << "DB is not open properly.";
+      return false;
+    }
+    pending_[key] = {value, deleted};
+    if (FLAGS_kv_db_flush_interval_ms <= 0) {
+      if (!FlushLocked()) {
+        pending_.erase(key);
+        return false;
+      }
+      return true;
+    }
+    if (!flush_thread_.joinable()) {
+      flush_thread_ = std::thread(&SqliteWraper::FlushLoop, this);
+    }
+    cv_.notify_one();
+    return true;
+  }
+
+  // Empty values are taken as non-exist.
+  bool Read(const std::string &key, std::string *value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto pending = pending_.find(key);
+    if (pending != pending_.end()) {
+      *value = pending->second.deleted ? "" : pending->second.value;
+      return true;
+    }
+    if (!RefreshCache()) {
+      return false;
+    }
+    const auto cached = cache_.find(key);
+    if (cached != cache_.end()) {
+      *value = cached->second;
+      return true;
     }
-    return 0;
+    if (!Select(key, value)) {
+      return false;
+    }
+    cache_[key] = *value;
+    return true;
   }
 
+  bool Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FlushLocked();
+  }
+
+ private:
+  struct PendingWrite {
+    std::string value;
+    bool deleted;
+  };
+
   SqliteWraper() {
     // Open DB.
-    if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != 0) {
+    if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != SQLITE_OK) {
       AERROR << "Can't open Key-Value database: " << sqlite3_errmsg(db_);
       Release();
       return;
     }
+    sqlite3_busy_timeout(db_, kBusyTimeoutMs);
 
+    // The write-ahead log commits without syncing the DB file per write, and
+    // lets readers of other processes go on while a batch is written.
     // Create table if it doesn't exist.
-    static const char *kCreateTableSql =
+    static const char *kInitSql =
+        "PRAGMA journal_mode=WAL;"
+        "PRAGMA synchronous=NORMAL;"
         "CREATE TABLE IF NOT EXISTS key_value "
         "(key VARCHAR(128) PRIMARY KEY NOT NULL, value TEXT);";
-    if (!SQL(kCreateTableSql)) {
+    if (!Exec(kInitSql) ||
+        !Prepare("SELECT value FROM key_value WHERE key=?;", &select_) ||
+        !Prepare("INSERT OR REPLACE INTO key_value (key, value) "
+                 "VALUES (?, ?);",
+                 &replace_) ||
+        !Prepare("DELETE FROM key_value WHERE key=?;", &delete_) ||
+        !Prepare("PRAGMA data_version;", &data_version_)) {
       Release();
     }
   }
 
-  ~SqliteWraper() { Release(); }
+  void FlushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+      cv_.wait(lock, [this] { return stopped_ || !pending_.empty(); });
+      // Gather the writes of a whole interval into one transaction.
+      cv_.wait_for(lock,
+                   std::chrono::milliseconds(FLAGS_kv_db_flush_interval_ms),
+                   [this] { return stopped_; });
+      FlushLocked();
+    }
+  }
+
+  // Writes the pending writes in one transaction, they are kept for the next
+  // flush if it fails.
+  bool FlushLocked() {
+    if (pending_.empty() || db_ == nullptr) {
+      return pending_.empty();
+    }
+    if (!Exec("BEGIN TRANSACTION;")) {
+      return false;
+    }
+    for (const auto &write : pending_) {
+      sqlite3_stmt *statement = write.second.deleted ? delete_ : replace_;
+      sqlite3_bind_text(statement, 1, write.first.c_str(), -1,
+                        SQLITE_TRANSIENT);
+      if (!write.second.deleted) {
+        sqlite3_bind_text(statement, 2, write.second.value.c_str(), -1,
+                          SQLITE_TRANSIENT);
+      }
+      const int ret = sqlite3_step(statement);
+      sqlite3_reset(statement);
+      if (ret != SQLITE_DONE) {
+        AERROR << "Failed to write key " << write.first << ": "
+               << sqlite3_errmsg(db_);
+        Exec("ROLLBACK;");
+        return false;
+      }
+    }
+    if (!Exec("COMMIT;")) {
+      Exec("ROLLBACK;");
+      return false;
+    }
+    for (auto &write : pending_) {
+      cache_[write.first] =
+          write.second.deleted ? "" : std::move(write.second.value);
+    }
+    pending_.clear();
+    return true;
+  }
 
-  bool SQL(const std::string &sql, std::string *value = nullptr) {
-    AINFO << "Executing SQL: " << sql;
+  // Drops the cache if another connection has changed the DB since it was
+  // filled.
+  bool RefreshCache() {
     if (db_ == nullptr) {
       AERROR << "DB is not open properly.";
       return false;
     }
+    if (sqlite3_step(data_version_) != SQLITE_ROW) {
+      AERROR << "Failed to get data version: " << sqlite3_errmsg(db_);
+      sqlite3_reset(data_version_);
+      return false;
+    }
+    const int64_t data_version = sqlite3_column_int64(data_version_, 0);
+    sqlite3_reset(data_version_);
+    if (data_version != data_version_value_) {
+      cache_.clear();
+      data_version_value_ = data_version;
+    }
+    return true;
+  }
+
+  bool Select(const std::string &key, std::string *value) {
+    sqlite3_bind_text(select_, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+    const int ret = sqlite3_step(select_);
+    if (ret == SQLITE_ROW) {
+      const unsigned char *text = sqlite3_column_text(select_, 0);
+      *value = text != nullptr ? reinterpret_cast<const char *>(text) : "";
+    } else {
+      value->clear();
+    }
+    sqlite3_reset(select_);
+    if (ret != SQLITE_ROW && ret != SQLITE_DONE) {
+      AERROR << "Failed to read key " << key << ": " << sqlite3_errmsg(db_);
+      return false;
+    }
+    return true;
+  }
 
+  bool Exec(const char *sql) {
     char *error = nullptr;
-    if (sqlite3_exec(db_, sql.c_str(), Callback, value, &error) != SQLITE_OK) {
-      AERROR << "Failed to execute SQL: " << error;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+      AERROR << "Failed to execute SQL " << sql << ": " << error;
       sqlite3_free(error);
       return false;
     }
     return true;
   }
 
- private:
+  bool Prepare(const char *sql, sqlite3_stmt **statement) {
+    if (sqlite3_prepare_v2(db_, sql, -1, statement, nullptr) != SQLITE_OK) {
+      AERROR << "Failed to prepare SQL " << sql << ": " << sqlite3_errmsg(db_);
+      return false;
+    }
+    return true;
+  }
+
   void Release() {
+    for (sqlite3_stmt **statement :
+         {&select_, &replace_, &delete_, &data_version_}) {
+      sqlite3_finalize(*statement);
+      *statement = nullptr;
+    }
     if (db_ != nullptr) {
       sqlite3_close(db_);
       db_ = nullptr;
     }
   }
 
+  static constexpr int kBusyTimeoutMs = 1000;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread flush_thread_;
+  bool stopped_ = false;
+
   sqlite3 *db_ = nullptr;
+  sqlite3_stmt *select_ = nullptr;
+  sqlite3_stmt *replace_ = nullptr;
+  sqlite3_stmt *delete_ = nullptr;
+  sqlite3_stmt *data_version_ = nullptr;
+  int64_t data_version_value_ = -1;
+
+  std::unordered_map<std::string, std::string> cache_;
+  std::unordered_map<std::string, PendingWrite> pending_;
 };
 
 }  // namespace
 
 bool KVDB::Put(const std::string &key, const std::string &value) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(
-      StrCat("INSERT OR REPLACE INTO key_value (key, value) "
-             "VALUES ('",
-             key, "', '", value, "');"));
+  return SqliteWraper::Instance()->Write(key, value, false);
 }
 
 bool KVDB::Delete(const std::string &key) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(StrCat("DELETE FROM key_value WHERE key='", key, "';"));
+  return SqliteWraper::Instance()->Write(key, "", true);
 }
 
+bool KVDB::Flush() { return SqliteWraper::Instance()->Flush(); }
+
 bool KVDB::Has(const std::string &key) {
-  SqliteWraper sqlite;
   std::string value;
-  const bool ret = sqlite.SQL(
-      StrCat("SELECT value FROM key_value WHERE key='", key, "';"), &value);
+  const bool ret = SqliteWraper::Instance()->Read(key, &value);
   // Take empty field as non-exist.
   return ret && !value.empty();
 }
 
 std::string KVDB::Get(const std::string &key,
                       const std::string &default_value) {
-  SqliteWraper sqlite;
   std::string value;
-  const bool ret = sqlite.SQL(
-      StrCat("SELECT value FROM key_value WHERE key='", key, "';"), &value);
+  const bool ret = SqliteWraper::Instance()->Read(key, &value);
   return (ret && !value.empty()) ? value : default_value;
 }
 
@@ -30,6 +30,9 @@ namespace common {
  *
  * @brief Lightweight key-value database to store system-wide parameters.
  *        We prefer keys like "apollo:data:commit_id".
+ *        Reads are cached in memory, and writes are batched and flushed to
+ *        the DB file in the background every --kv_db_flush_interval_ms, so
+ *        other processes see them after the next flush.
  */
 class KVDB {
  public:
@@ -47,6 +50,12 @@ class KVDB {
    */
   static bool Delete(const std::string &key);
 
+  /**
+   * @brief Write all the batched writes to DB right now.
+   * @return Success or not.
+   */
+  static bool Flush();
+
   static bool Has(const std::string &key);
 
   static std::string Get(const std::string &key,
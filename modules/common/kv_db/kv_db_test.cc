@@ -15,10 +15,15 @@
  *****************************************************************************/
 #include "modules/common/kv_db/kv_db.h"
 
+#include <sqlite3.h>
+
 #include <thread>
 
+#include "gflags/gflags.h"
 #include "gtest/gtest.h"
 
+DECLARE_string(kv_db_path);
+
 namespace apollo {
 namespace common {
 
@@ -46,6 +51,37 @@ TEST(KVDBTest, GetDefault) {
   EXPECT_EQ("default", KVDB::Get("test_key", "default"));
 }
 
+TEST(KVDBTest, FlushAndExternalChange) {
+  EXPECT_TRUE(KVDB::Put("test_key", "val0"));
+  EXPECT_TRUE(KVDB::Flush());
+
+  // Another connection sees the flushed write and changes the value.
+  sqlite3 *db = nullptr;
+  ASSERT_EQ(SQLITE_OK, sqlite3_open(FLAGS_kv_db_path.c_str(), &db));
+  std::string value;
+  ASSERT_EQ(SQLITE_OK,
+            sqlite3_exec(db,
+                         "SELECT value FROM key_value WHERE key='test_key';",
+                         [](void *data, int, char **argv, char **) {
+                           *static_cast<std::string *>(data) = argv[0];
+                           return 0;
+                         },
+                         &value, nullptr));
+  EXPECT_EQ("val0", value);
+  ASSERT_EQ(SQLITE_OK,
+            sqlite3_exec(db,
+                         "UPDATE key_value SET value='val1' "
+                         "WHERE key='test_key';",
+                         nullptr, nullptr, nullptr));
+  sqlite3_close(db);
+
+  // The cached value is dropped.
+  EXPECT_EQ("val1", KVDB::Get("test_key"));
+  EXPECT_TRUE(KVDB::Delete("test_key"));
+  EXPECT_TRUE(KVDB::Flush());
+  EXPECT_FALSE(KVDB::Has("test_key"));
+}
+
 TEST(KVDBTest, MultiThreads) {
   static const int N_THREADS = 10;
 
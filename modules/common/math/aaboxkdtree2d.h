@@ -16,16 +16,19 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2d class.
  */
 
 #pragma once
 
 #include <algorithm>
 #include <limits>
-#include <memory>
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "cyber/common/log.h"
 
 #include "modules/common/math/aabox2d.h"
@@ -53,63 +56,54 @@ struct AABoxKDTreeParams {
 };
 
 /**
- * @class AABoxKDTree2dNode
- * @brief The class of KD-tree node of axis-aligned bounding box.
+ * @class AABoxKDTree2d
+ * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * The nodes are stored in one array in depth first order, and the objects of
+ * all nodes in shared arrays together with their boxes, so that the objects
+ * of a subtree are contiguous. Objects are tested against their boxes (two
+ * at a time with SSE2) before the exact distance is computed.
  */
 template <class ObjectType>
-class AABoxKDTree2dNode {
+class AABoxKDTree2d {
  public:
   using ObjectPtr = const ObjectType *;
+
   /**
-   * @brief Constructor which takes a vector of objects,
-   *        parameters and depth of the node.
-   * @param objects Objects to build the KD-tree node.
+   * @brief Contructor which takes a vector of objects and parameters.
    * @param params Parameters to build the KD-tree.
-   * @param depth Depth of the KD-tree node.
    */
-  AABoxKDTree2dNode(const std::vector<ObjectPtr> &objects,
-                    const AABoxKDTreeParams &params, int depth)
-      : depth_(depth) {
-    CHECK(!objects.empty());
-
-    ComputeBoundary(objects);
-    ComputePartition();
-
-    if (SplitToSubNodes(objects, params)) {
-      std::vector<ObjectPtr> left_subnode_objects;
-      std::vector<ObjectPtr> right_subnode_objects;
-      PartitionObjects(objects, &left_subnode_objects, &right_subnode_objects);
-
-      // Split to sub-nodes.
-      if (!left_subnode_objects.empty()) {
-        left_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            left_subnode_objects, params, depth + 1));
-      }
-      if (!right_subnode_objects.empty()) {
-        right_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            right_subnode_objects, params, depth + 1));
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
       }
-    } else {
-      InitObjects(objects);
+      by_min_.Reserve(objects.size());
+      by_max_.Reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
     }
   }
 
   /**
-   * @brief Get the nearest object to a target point by the KD-tree
-   *        rooted at this node.
+   * @brief Get the nearest object to a target point.
    * @param point The target point. Search it's nearest object.
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
+    if (nodes_.empty()) {
+      return nullptr;
+    }
     ObjectPtr nearest_object = nullptr;
     double min_distance_sqr = std::numeric_limits<double>::infinity();
-    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
+    GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
     return nearest_object;
   }
 
   /**
-   * @brief Get objects within a distance to a point by the KD-tree
-   *        rooted at this node.
+   * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
    * @param distance The radius of the range to search objects.
    * @return All objects within the specified distance to the specified point.
@@ -117,250 +111,379 @@ class AABoxKDTree2dNode {
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
     std::vector<ObjectPtr> result_objects;
-    GetObjectsInternal(point, distance, Square(distance), &result_objects);
+    GetObjects(point, distance, &result_objects);
     return result_objects;
   }
 
+  /**
+   * @brief Append objects within a distance to a point to a caller buffer,
+   *        without allocating a result vector per query.
+   * @param point The center point of the range to search objects.
+   * @param distance The radius of the range to search objects.
+   * @param result_objects The buffer to append the objects to.
+   */
+  void GetObjects(const Vec2d &point, const double distance,
+                  std::vector<ObjectPtr> *const result_objects) const {
+    if (!nodes_.empty()) {
+      GetObjectsInternal(0, point, distance, Square(distance),
+                         result_objects);
+    }
+  }
+
   /**
    * @brief Get the axis-aligned bounding box of the objects.
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Node &root = nodes_.front();
+    return AABox2d({root.min_x, root.min_y}, {root.max_x, root.max_y});
   }
 
  private:
-  void InitObjects(const std::vector<ObjectPtr> &objects) {
-    num_objects_ = static_cast<int>(objects.size());
-    objects_sorted_by_min_ = objects;
-    objects_sorted_by_max_ = objects;
-    std::sort(objects_sorted_by_min_.begin(), objects_sorted_by_min_.end(),
+  enum Partition {
+    PARTITION_X = 1,
+    PARTITION_Y = 2,
+  };
+
+  struct Node {
+    // Boundary
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    double mid_x = 0.0;
+    double mid_y = 0.0;
+    Partition partition = PARTITION_X;
+    double partition_position = 0.0;
+    int depth = 0;
+    int left = -1;
+    int right = -1;
+    // objects of this node are [objects_begin, objects_end) and objects of
+    // the subtree are [objects_begin, subtree_end) in by_min_ and by_max_
+    int objects_begin = 0;
+    int objects_end = 0;
+    int subtree_end = 0;
+  };
+
+  // Objects of every node sorted by the min (or max) bound on the partition
+  // axis, with their boxes in the same order.
+  struct SortedObjects {
+    std::vector<ObjectPtr> objects;
+    std::vector<double> bounds;
+    std::vector<double> min_x;
+    std::vector<double> min_y;
+    std::vector<double> max_x;
+    std::vector<double> max_y;
+
+    void Reserve(size_t size) {
+      objects.reserve(size);
+      bounds.reserve(size);
+      min_x.reserve(size);
+      min_y.reserve(size);
+      max_x.reserve(size);
+      max_y.reserve(size);
+    }
+    void Append(ObjectPtr object, double bound) {
+      objects.push_back(object);
+      bounds.push_back(bound);
+      min_x.push_back(object->aabox().min_x());
+      min_y.push_back(object->aabox().min_y());
+      max_x.push_back(object->aabox().max_x());
+      max_y.push_back(object->aabox().max_y());
+    }
+    double BoxDistanceSquare(int i, const Vec2d &point) const {
+      const double dx =
+          std::max(std::max(min_x[i] - point.x(), point.x() - max_x[i]), 0.0);
+      const double dy =
+          std::max(std::max(min_y[i] - point.y(), point.y() - max_y[i]), 0.0);
+      return dx * dx + dy * dy;
+    }
+  };
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, int depth) {
+    CHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_[index].depth = depth;
+    ComputeBoundary(objects, &nodes_[index]);
+    ComputePartition(&nodes_[index]);
+
+    if (SplitToSubNodes(objects, params, nodes_[index])) {
+      std::vector<ObjectPtr> left_subnode_objects;
+      std::vector<ObjectPtr> right_subnode_objects;
+      PartitionObjects(index, objects, &left_subnode_objects,
+                       &right_subnode_objects);
+
+      // Split to sub-nodes, the left subtree right after this node.
+      if (!left_subnode_objects.empty()) {
+        const int left = BuildNode(left_subnode_objects, params, depth + 1);
+        nodes_[index].left = left;
+      }
+      if (!right_subnode_objects.empty()) {
+        const int right = BuildNode(right_subnode_objects, params, depth + 1);
+        nodes_[index].right = right;
+      }
+    } else {
+      InitObjects(index, objects);
+    }
+    nodes_[index].subtree_end = static_cast<int>(by_min_.objects.size());
+    return index;
+  }
+
+  void InitObjects(int index, const std::vector<ObjectPtr> &objects) {
+    Node &node = nodes_[index];
+    const bool partition_x = (node.partition == PARTITION_X);
+    std::vector<ObjectPtr> objects_sorted_by_min = objects;
+    std::vector<ObjectPtr> objects_sorted_by_max = objects;
+    std::sort(objects_sorted_by_min.begin(), objects_sorted_by_min.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().min_x() < obj2->aabox().min_x()
                            : obj1->aabox().min_y() < obj2->aabox().min_y();
               });
-    std::sort(objects_sorted_by_max_.begin(), objects_sorted_by_max_.end(),
+    std::sort(objects_sorted_by_max.begin(), objects_sorted_by_max.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().max_x() > obj2->aabox().max_x()
                            : obj1->aabox().max_y() > obj2->aabox().max_y();
               });
-    objects_sorted_by_min_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_min_) {
-      objects_sorted_by_min_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().min_x()
-                                                 : object->aabox().min_y());
+    node.objects_begin = static_cast<int>(by_min_.objects.size());
+    for (ObjectPtr object : objects_sorted_by_min) {
+      by_min_.Append(object, partition_x ? object->aabox().min_x()
+                                         : object->aabox().min_y());
     }
-    objects_sorted_by_max_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_max_) {
-      objects_sorted_by_max_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().max_x()
-                                                 : object->aabox().max_y());
+    for (ObjectPtr object : objects_sorted_by_max) {
+      by_max_.Append(object, partition_x ? object->aabox().max_x()
+                                         : object->aabox().max_y());
     }
+    node.objects_end = static_cast<int>(by_min_.objects.size());
   }
 
   bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
-                       const AABoxKDTreeParams &params) {
-    if (params.max_depth >= 0 && depth_ >= params.max_depth) {
+                       const AABoxKDTreeParams &params,
+                       const Node &node) const {
+    if (params.max_depth >= 0 && node.depth >= params.max_depth) {
       return false;
     }
     if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
       return false;
     }
     if (params.max_leaf_dimension >= 0.0 &&
-        std::max(max_x_ - min_x_, max_y_ - min_y_) <=
+        std::max(node.max_x - node.min_x, node.max_y - node.min_y) <=
             params.max_leaf_dimension) {
       return false;
     }
     return true;
   }
 
-  double LowerDistanceSquareToPoint(const Vec2d &point) const {
+  static double LowerDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
     double dx = 0.0;
-    if (point.x() < min_x_) {
-      dx = min_x_ - point.x();
-    } else if (point.x() > max_x_) {
-      dx = point.x() - max_x_;
+    if (point.x() < node.min_x) {
+      dx = node.min_x - point.x();
+    } else if (point.x() > node.max_x) {
+      dx = point.x() - node.max_x;
     }
     double dy = 0.0;
-    if (point.y() < min_y_) {
-      dy = min_y_ - point.y();
-    } else if (point.y() > max_y_) {
-      dy = point.y() - max_y_;
+    if (point.y() < node.min_y) {
+      dy = node.min_y - point.y();
+    } else if (point.y() > node.max_y) {
+      dy = point.y() - node.max_y;
     }
     return dx * dx + dy * dy;
   }
 
-  double UpperDistanceSquareToPoint(const Vec2d &point) const {
-    const double dx =
-        (point.x() > mid_x_ ? (point.x() - min_x_) : (point.x() - max_x_));
-    const double dy =
-        (point.y() > mid_y_ ? (point.y() - min_y_) : (point.y() - max_y_));
+  static double UpperDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    const double dx = (point.x() > node.mid_x ? (point.x() - node.min_x)
+                                              : (point.x() - node.max_x));
+    const double dy = (point.y() > node.mid_y ? (point.y() - node.min_y)
+                                              : (point.y() - node.max_y));
     return dx * dx + dy * dy;
   }
 
-  void GetAllObjects(std::vector<ObjectPtr> *const result_objects) const {
-    result_objects->insert(result_objects->end(),
-                           objects_sorted_by_min_.begin(),
-                           objects_sorted_by_min_.end());
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetAllObjects(result_objects);
+  // Append the objects in [begin, end) of the sorted objects within the
+  // distance, the box test rejects most of them cheaply.
+  static void CollectObjects(const SortedObjects &sorted, int begin, int end,
+                             const Vec2d &point, const double distance_sqr,
+                             std::vector<ObjectPtr> *const result_objects) {
+    // an object is inside its box, so it can't be closer than the box
+    const double box_distance_sqr = distance_sqr + kMathEpsilon;
+    int i = begin;
+#ifdef __SSE2__
+    const __m128d px = _mm_set1_pd(point.x());
+    const __m128d py = _mm_set1_pd(point.y());
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d threshold = _mm_set1_pd(box_distance_sqr);
+    for (; i + 2 <= end; i += 2) {
+      const __m128d dx = _mm_max_pd(
+          _mm_max_pd(_mm_sub_pd(_mm_loadu_pd(&sorted.min_x[i]), px),
+                     _mm_sub_pd(px, _mm_loadu_pd(&sorted.max_x[i]))),
+          zero);
+      const __m128d dy = _mm_max_pd(
+          _mm_max_pd(_mm_sub_pd(_mm_loadu_pd(&sorted.min_y[i]), py),
+                     _mm_sub_pd(py, _mm_loadu_pd(&sorted.max_y[i]))),
+          zero);
+      const __m128d box_sqr =
+          _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      const int mask = _mm_movemask_pd(_mm_cmple_pd(box_sqr, threshold));
+      for (int k = 0; k < 2; ++k) {
+        if ((mask >> k) & 1) {
+          ObjectPtr object = sorted.objects[i + k];
+          if (object->DistanceSquareTo(point) <= distance_sqr) {
+            result_objects->push_back(object);
+          }
+        }
+      }
     }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetAllObjects(result_objects);
+#endif
+    for (; i < end; ++i) {
+      if (sorted.BoxDistanceSquare(i, point) > box_distance_sqr) {
+        continue;
+      }
+      ObjectPtr object = sorted.objects[i];
+      if (object->DistanceSquareTo(point) <= distance_sqr) {
+        result_objects->push_back(object);
+      }
     }
   }
 
-  void GetObjectsInternal(const Vec2d &point, const double distance,
+  void GetObjectsInternal(int index, const Vec2d &point, const double distance,
                           const double distance_sqr,
                           std::vector<ObjectPtr> *const result_objects) const {
-    if (LowerDistanceSquareToPoint(point) > distance_sqr) {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
       return;
     }
-    if (UpperDistanceSquareToPoint(point) <= distance_sqr) {
-      GetAllObjects(result_objects);
+    if (UpperDistanceSquareToPoint(node, point) <= distance_sqr) {
+      // all objects of the subtree, contiguous in the array
+      result_objects->insert(
+          result_objects->end(),
+          by_min_.objects.begin() + node.objects_begin,
+          by_min_.objects.begin() + node.subtree_end);
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    if (pvalue < partition_position_) {
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    if (pvalue < node.partition_position) {
       const double limit = pvalue + distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_min_bound_[i] > limit) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_min_[i];
-        if (object->DistanceSquareTo(point) <= distance_sqr) {
-          result_objects->push_back(object);
-        }
+      int end = node.objects_begin;
+      while (end < node.objects_end && by_min_.bounds[end] <= limit) {
+        ++end;
       }
+      CollectObjects(by_min_, node.objects_begin, end, point, distance_sqr,
+                     result_objects);
     } else {
       const double limit = pvalue - distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_max_bound_[i] < limit) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_max_[i];
-        if (object->DistanceSquareTo(point) <= distance_sqr) {
-          result_objects->push_back(object);
-        }
+      int end = node.objects_begin;
+      while (end < node.objects_end && by_max_.bounds[end] >= limit) {
+        ++end;
       }
+      CollectObjects(by_max_, node.objects_begin, end, point, distance_sqr,
+                     result_objects);
     }
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                        result_objects);
+    if (node.left >= 0) {
+      GetObjectsInternal(node.left, point, distance, distance_sqr,
+                         result_objects);
     }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                         result_objects);
+    if (node.right >= 0) {
+      GetObjectsInternal(node.right, point, distance, distance_sqr,
+                         result_objects);
     }
   }
 
-  void GetNearestObjectInternal(const Vec2d &point,
+  void GetNearestObjectInternal(int index, const Vec2d &point,
                                 double *const min_distance_sqr,
                                 ObjectPtr *const nearest_object) const {
-    if (LowerDistanceSquareToPoint(point) >= *min_distance_sqr - kMathEpsilon) {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) >=
+        *min_distance_sqr - kMathEpsilon) {
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    const bool search_left_first = (pvalue < partition_position_);
-    if (search_left_first) {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
-    } else {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
-      }
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    const bool search_left_first = (pvalue < node.partition_position);
+    const int first = search_left_first ? node.left : node.right;
+    const int second = search_left_first ? node.right : node.left;
+    if (first >= 0) {
+      GetNearestObjectInternal(first, point, min_distance_sqr, nearest_object);
     }
     if (*min_distance_sqr <= kMathEpsilon) {
       return;
     }
 
-    if (search_left_first) {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_min_bound_[i];
-        if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_min_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
+    const SortedObjects &sorted = search_left_first ? by_min_ : by_max_;
+    for (int i = node.objects_begin; i < node.objects_end; ++i) {
+      const double bound = sorted.bounds[i];
+      const bool beyond = search_left_first ? bound > pvalue : bound < pvalue;
+      if (beyond && Square(bound - pvalue) > *min_distance_sqr) {
+        break;
       }
-    } else {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_max_bound_[i];
-        if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_max_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
+      if (sorted.BoxDistanceSquare(i, point) >
+          *min_distance_sqr + kMathEpsilon) {
+        continue;
+      }
+      ObjectPtr object = sorted.objects[i];
+      const double distance_sqr = object->DistanceSquareTo(point);
+      if (distance_sqr < *min_distance_sqr) {
+        *min_distance_sqr = distance_sqr;
+        *nearest_object = object;
       }
     }
     if (*min_distance_sqr <= kMathEpsilon) {
       return;
     }
-    if (search_left_first) {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
-      }
-    } else {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
+    if (second >= 0) {
+      GetNearestObjectInternal(second, point, min_distance_sqr,
+                               nearest_object);
     }
   }
 
-  void ComputeBoundary(const std::vector<ObjectPtr> &objects) {
-    min_x_ = std::numeric_limits<double>::infinity();
-    min_y_ = std::numeric_limits<double>::infinity();
-    max_x_ = -std::numeric_limits<double>::infinity();
-    max_y_ = -std::numeric_limits<double>::infinity();
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    node->min_x = std::numeric_limits<double>::infinity();
+    node->min_y = std::numeric_limits<double>::infinity();
+    node->max_x = -std::numeric_limits<double>::infinity();
+    node->max_y = -std::numeric_limits<double>::infinity();
     for (ObjectPtr object : objects) {
-      min_x_ = std::fmin(min_x_, object->aabox().min_x());
-      max_x_ = std::fmax(max_x_, object->aabox().max_x());
-      min_y_ = std::fmin(min_y_, object->aabox().min_y());
-      max_y_ = std::fmax(max_y_, object->aabox().max_y());
+      node->min_x = std::fmin(node->min_x, object->aabox().min_x());
+      node->max_x = std::fmax(node->max_x, object->aabox().max_x());
+      node->min_y = std::fmin(node->min_y, object->aabox().min_y());
+      node->max_y = std::fmax(node->max_y, object->aabox().max_y());
     }
-    mid_x_ = (min_x_ + max_x_) / 2.0;
-    mid_y_ = (min_y_ + max_y_) / 2.0;
-    CHECK(!std::isinf(max_x_) && !std::isinf(max_y_) && !std::isinf(min_x_) &&
-          !std::isinf(min_y_))
+    node->mid_x = (node->min_x + node->max_x) / 2.0;
+    node->mid_y = (node->min_y + node->max_y) / 2.0;
+    CHECK(!std::isinf(node->max_x) && !std::isinf(node->max_y) &&
+          !std::isinf(node->min_x) && !std::isinf(node->min_y))
         << "the provided object box size is infinity";
   }
 
-  void ComputePartition() {
-    if (max_x_ - min_x_ >= max_y_ - min_y_) {
-      partition_ = PARTITION_X;
-      partition_position_ = (min_x_ + max_x_) / 2.0;
+  static void ComputePartition(Node *const node) {
+    if (node->max_x - node->min_x >= node->max_y - node->min_y) {
+      node->partition = PARTITION_X;
+      node->partition_position = (node->min_x + node->max_x) / 2.0;
     } else {
-      partition_ = PARTITION_Y;
-      partition_position_ = (min_y_ + max_y_) / 2.0;
+      node->partition = PARTITION_Y;
+      node->partition_position = (node->min_y + node->max_y) / 2.0;
     }
   }
 
-  void PartitionObjects(const std::vector<ObjectPtr> &objects,
+  void PartitionObjects(int index, const std::vector<ObjectPtr> &objects,
                         std::vector<ObjectPtr> *const left_subnode_objects,
                         std::vector<ObjectPtr> *const right_subnode_objects) {
+    const Node &node = nodes_[index];
     left_subnode_objects->clear();
     right_subnode_objects->clear();
     std::vector<ObjectPtr> other_objects;
-    if (partition_ == PARTITION_X) {
+    if (node.partition == PARTITION_X) {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_x() <= partition_position_) {
+        if (object->aabox().max_x() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_x() >= partition_position_) {
+        } else if (object->aabox().min_x() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
           other_objects.push_back(object);
@@ -368,102 +491,21 @@ class AABoxKDTree2dNode {
       }
     } else {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_y() <= partition_position_) {
+        if (object->aabox().max_y() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_y() >= partition_position_) {
+        } else if (object->aabox().min_y() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
           other_objects.push_back(object);
         }
       }
     }
-    InitObjects(other_objects);
+    InitObjects(index, other_objects);
   }
 
- private:
-  int num_objects_ = 0;
-  std::vector<ObjectPtr> objects_sorted_by_min_;
-  std::vector<ObjectPtr> objects_sorted_by_max_;
-  std::vector<double> objects_sorted_by_min_bound_;
-  std::vector<double> objects_sorted_by_max_bound_;
-  int depth_ = 0;
-
-  // Boundary
-  double min_x_ = 0.0;
-  double max_x_ = 0.0;
-  double min_y_ = 0.0;
-  double max_y_ = 0.0;
-  double mid_x_ = 0.0;
-  double mid_y_ = 0.0;
-
-  enum Partition {
-    PARTITION_X = 1,
-    PARTITION_Y = 2,
-  };
-  Partition partition_ = PARTITION_X;
-  double partition_position_ = 0.0;
-
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> left_subnode_ = nullptr;
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> right_subnode_ = nullptr;
-};
-
-/**
- * @class AABoxKDTree2d
- * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
- */
-template <class ObjectType>
-class AABoxKDTree2d {
- public:
-  using ObjectPtr = const ObjectType *;
-
-  /**
-   * @brief Contructor which takes a vector of objects and parameters.
-   * @param params Parameters to build the KD-tree.
-   */
-  AABoxKDTree2d(const std::vector<ObjectType> &objects,
-                const AABoxKDTreeParams &params) {
-    if (!objects.empty()) {
-      std::vector<ObjectPtr> object_ptrs;
-      for (const auto &object : objects) {
-        object_ptrs.push_back(&object);
-      }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
-    }
-  }
-
-  /**
-   * @brief Get the nearest object to a target point.
-   * @param point The target point. Search it's nearest object.
-   * @return The nearest object to the target point.
-   */
-  ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
-  }
-
-  /**
-   * @brief Get objects within a distance to a point.
-   * @param point The center point of the range to search objects.
-   * @param distance The radius of the range to search objects.
-   * @return All objects within the specified distance to the specified point.
-   */
-  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
-                                    const double distance) const {
-    if (root_ == nullptr) {
-      return {};
-    }
-    return root_->GetObjects(point, distance);
-  }
-
-  /**
-   * @brief Get the axis-aligned bounding box of the objects.
-   * @return The axis-aligned bounding box of the objects.
-   */
-  AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
-  }
-
- private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
+  std::vector<Node> nodes_;
+  SortedObjects by_min_;
+  SortedObjects by_max_;
 };
 
 }  // namespace math
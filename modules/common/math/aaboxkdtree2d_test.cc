@@ -118,6 +118,32 @@ TEST(AABoxKDTree2dNode, OverallTests) {
   }
 }
 
+TEST(AABoxKDTree2d, EmptyAndBoundingBox) {
+  AABoxKDTreeParams params;
+  const std::vector<Object> no_objects;
+  AABoxKDTree2d<Object> empty_tree(no_objects, params);
+  EXPECT_EQ(empty_tree.GetNearestObject({0.0, 0.0}), nullptr);
+  EXPECT_TRUE(empty_tree.GetObjects({0.0, 0.0}, 10.0).empty());
+
+  std::vector<Object> objects;
+  objects.emplace_back(0.0, 0.0, 1.0, 1.0, 0);
+  objects.emplace_back(-3.0, 2.0, -2.0, 4.0, 1);
+  objects.emplace_back(5.0, -1.0, 6.0, 0.0, 2);
+  params.max_leaf_size = 1;
+  AABoxKDTree2d<Object> kdtree(objects, params);
+  const AABox2d box = kdtree.GetBoundingBox();
+  EXPECT_DOUBLE_EQ(box.min_x(), -3.0);
+  EXPECT_DOUBLE_EQ(box.max_x(), 6.0);
+  EXPECT_DOUBLE_EQ(box.min_y(), -1.0);
+  EXPECT_DOUBLE_EQ(box.max_y(), 4.0);
+
+  std::vector<const Object *> result_objects;
+  kdtree.GetObjects({0.0, 0.0}, 100.0, &result_objects);
+  kdtree.GetObjects({5.5, -0.5}, 0.1, &result_objects);
+  ASSERT_EQ(result_objects.size(), 4);
+  EXPECT_EQ(result_objects.back()->id(), 2);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
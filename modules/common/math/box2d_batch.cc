@@ -0,0 +1,249 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// boxes handled by one pass of the vectorized loops
+constexpr size_t kBlockSize = 16;
+
+}  // namespace
+
+Box2dBatch::Box2dBatch(const std::vector<Box2d> &boxes) {
+  for (const auto &box : boxes) {
+    Add(box);
+  }
+}
+
+void Box2dBatch::Add(const Box2d &box) {
+  if (empty()) {
+    bounds_min_x_ = box.min_x();
+    bounds_max_x_ = box.max_x();
+    bounds_min_y_ = box.min_y();
+    bounds_max_y_ = box.max_y();
+  } else {
+    bounds_min_x_ = std::min(bounds_min_x_, box.min_x());
+    bounds_max_x_ = std::max(bounds_max_x_, box.max_x());
+    bounds_min_y_ = std::min(bounds_min_y_, box.min_y());
+    bounds_max_y_ = std::max(bounds_max_y_, box.max_y());
+  }
+  if (size_ % kBlockSize == 0) {
+    const size_t padded_size = size_ + kBlockSize;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (auto *field :
+         {&center_x_, &center_y_, &cos_heading_, &sin_heading_, &half_length_,
+          &half_width_, &heading_, &extent_x_, &extent_y_}) {
+      field->resize(padded_size, nan);
+    }
+  }
+  center_x_[size_] = box.center_x();
+  center_y_[size_] = box.center_y();
+  cos_heading_[size_] = box.cos_heading();
+  sin_heading_[size_] = box.sin_heading();
+  half_length_[size_] = box.half_length();
+  half_width_[size_] = box.half_width();
+  heading_[size_] = box.heading();
+  extent_x_[size_] = box.max_x() - box.center_x();
+  extent_y_[size_] = box.max_y() - box.center_y();
+  ++size_;
+}
+
+void Box2dBatch::Clear() {
+  size_ = 0;
+  for (auto *field :
+       {&center_x_, &center_y_, &cos_heading_, &sin_heading_, &half_length_,
+        &half_width_, &heading_, &extent_x_, &extent_y_}) {
+    field->clear();
+  }
+}
+
+Box2d Box2dBatch::box(const size_t index) const {
+  return Box2d({center_x_[index], center_y_[index]}, heading_[index],
+               2.0 * half_length_[index], 2.0 * half_width_[index]);
+}
+
+Box2dBatch::Query Box2dBatch::GetQuery(const Box2d &box) {
+  return {box.center_x(),
+          box.center_y(),
+          box.cos_heading(),
+          box.sin_heading(),
+          box.half_length(),
+          box.half_width(),
+          box.max_x() - box.center_x(),
+          box.max_y() - box.center_y()};
+}
+
+Box2dBatch::Query Box2dBatch::GetQuery(const size_t index) const {
+  return {center_x_[index],    center_y_[index],   cos_heading_[index],
+          sin_heading_[index], half_length_[index], half_width_[index],
+          extent_x_[index],    extent_y_[index]};
+}
+
+bool Box2dBatch::BoundingBoxMargins(const size_t begin, const Query &query,
+                                    double *__restrict__ margins) const {
+  const double x = query.x;
+  const double y = query.y;
+  const double extent_x_a = query.extent_x;
+  const double extent_y_a = query.extent_y;
+  const double *__restrict__ center_x = center_x_.data() + begin;
+  const double *__restrict__ center_y = center_y_.data() + begin;
+  const double *__restrict__ extent_x = extent_x_.data() + begin;
+  const double *__restrict__ extent_y = extent_y_.data() + begin;
+
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    margins[i] =
+        std::max(std::abs(center_x[i] - x) - (extent_x[i] + extent_x_a),
+                 std::abs(center_y[i] - y) - (extent_y[i] + extent_y_a));
+  }
+  // std::min skips the NaN margins of the padding
+  double min_margin = margins[0];
+  for (size_t i = 1; i < kBlockSize; ++i) {
+    min_margin = std::min(min_margin, margins[i]);
+  }
+  return min_margin <= 0.0;
+}
+
+void Box2dBatch::SeparationMargins(const size_t begin, const Query &query,
+                                   double *__restrict__ margins) const {
+  const double x = query.x;
+  const double y = query.y;
+  const double cos_a = query.cos_heading;
+  const double sin_a = query.sin_heading;
+  const double half_length_a = query.half_length;
+  const double half_width_a = query.half_width;
+  const double *__restrict__ center_x = center_x_.data() + begin;
+  const double *__restrict__ center_y = center_y_.data() + begin;
+  const double *__restrict__ cos_heading = cos_heading_.data() + begin;
+  const double *__restrict__ sin_heading = sin_heading_.data() + begin;
+  const double *__restrict__ half_length = half_length_.data() + begin;
+  const double *__restrict__ half_width = half_width_.data() + begin;
+
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    const double shift_x = center_x[i] - x;
+    const double shift_y = center_y[i] - y;
+    const double cos_b = cos_heading[i];
+    const double sin_b = sin_heading[i];
+    // cosine and sine of the heading of box i relative to the query
+    const double cos_ab = std::abs(cos_a * cos_b + sin_a * sin_b);
+    const double sin_ab = std::abs(sin_b * cos_a - cos_b * sin_a);
+    // the four separating axes are the two heading-axes and their normals
+    const double margin_1 =
+        std::abs(shift_x * cos_a + shift_y * sin_a) -
+        (half_length[i] * cos_ab + half_width[i] * sin_ab + half_length_a);
+    const double margin_2 =
+        std::abs(shift_x * sin_a - shift_y * cos_a) -
+        (half_length[i] * sin_ab + half_width[i] * cos_ab + half_width_a);
+    const double margin_3 =
+        std::abs(shift_x * cos_b + shift_y * sin_b) -
+        (half_length_a * cos_ab + half_width_a * sin_ab + half_length[i]);
+    const double margin_4 =
+        std::abs(shift_x * sin_b - shift_y * cos_b) -
+        (half_length_a * sin_ab + half_width_a * cos_ab + half_width[i]);
+    margins[i] = std::max(std::max(margin_1, margin_2),
+                          std::max(margin_3, margin_4));
+  }
+}
+
+void Box2dBatch::HasOverlap(const Box2d &box,
+                            std::vector<uint8_t> *overlaps) const {
+  overlaps->resize(size());
+  const Query query = GetQuery(box);
+  double margins[kBlockSize];
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, size());
+    if (!BoundingBoxMargins(begin, query, margins)) {
+      std::fill(overlaps->begin() + begin, overlaps->begin() + end, 0);
+      continue;
+    }
+    SeparationMargins(begin, query, margins);
+    for (size_t i = begin; i < end; ++i) {
+      (*overlaps)[i] = static_cast<uint8_t>(margins[i - begin] <= 0.0);
+    }
+  }
+}
+
+bool Box2dBatch::HasOverlapAny(const Box2d &box) const {
+  return HasOverlapAny(GetQuery(box));
+}
+
+bool Box2dBatch::HasOverlapAny(const Box2dBatch &boxes) const {
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (HasOverlapAny(boxes.GetQuery(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Box2dBatch::HasOverlapAny(const Query &query) const {
+  if (empty()) {
+    return false;
+  }
+  if (query.x + query.extent_x < bounds_min_x_ ||
+      query.x - query.extent_x > bounds_max_x_ ||
+      query.y + query.extent_y < bounds_min_y_ ||
+      query.y - query.extent_y > bounds_max_y_) {
+    return false;
+  }
+  double margins[kBlockSize];
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    if (!BoundingBoxMargins(begin, query, margins)) {
+      continue;
+    }
+    SeparationMargins(begin, query, margins);
+    // the NaN margins of the padding compare false
+    for (const double margin : margins) {
+      if (margin <= 0.0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void Box2dBatch::DistanceTo(const Vec2d &point,
+                            std::vector<double> *distances) const {
+  distances->resize(size());
+  const double x = point.x();
+  const double y = point.y();
+  double *distance = distances->data();
+  for (size_t i = 0; i < size(); ++i) {
+    const double x0 = x - center_x_[i];
+    const double y0 = y - center_y_[i];
+    // the distance outside of the box along each of its axes
+    const double dx = std::max(
+        std::abs(x0 * cos_heading_[i] + y0 * sin_heading_[i]) - half_length_[i],
+        0.0);
+    const double dy = std::max(
+        std::abs(x0 * sin_heading_[i] - y0 * cos_heading_[i]) - half_width_[i],
+        0.0);
+    distance[i] = std::sqrt(dx * dx + dy * dy);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
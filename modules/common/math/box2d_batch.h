@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Overlap and distance queries of one box against many boxes.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Box2dBatch
+ * @brief A set of boxes stored field by field in contiguous arrays, so that
+ *        the separating axis test against all of them runs as branch-free
+ *        loops over fixed size blocks, which the compiler vectorizes. The
+ *        results match Box2d::HasOverlap and Box2d::DistanceTo pair by pair.
+ */
+class Box2dBatch {
+ public:
+  Box2dBatch() = default;
+
+  explicit Box2dBatch(const std::vector<Box2d> &boxes);
+
+  void Add(const Box2d &box);
+
+  void Clear();
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Test the box against every box of the batch.
+   * @param box The box to test.
+   * @param overlaps Set to 1 at the index of every overlapping box, else 0.
+   */
+  void HasOverlap(const Box2d &box, std::vector<uint8_t> *overlaps) const;
+
+  /**
+   * @brief Whether the box overlaps any box of the batch. Stops at the
+   *        first block of boxes with an overlap.
+   */
+  bool HasOverlapAny(const Box2d &box) const;
+
+  /**
+   * @brief Whether any box of the other batch overlaps any box of this one.
+   *        Boxes outside the bounding box of this batch are skipped.
+   */
+  bool HasOverlapAny(const Box2dBatch &boxes) const;
+
+  /**
+   * @brief Distance from the point to every box of the batch.
+   * @param point The point to measure from.
+   * @param distances Set to the distance to each box, 0 inside of it.
+   */
+  void DistanceTo(const Vec2d &point, std::vector<double> *distances) const;
+
+  /**
+   * @brief Get the box at an index of the batch.
+   */
+  Box2d box(const size_t index) const;
+
+ private:
+  struct Query {
+    double x;
+    double y;
+    double cos_heading;
+    double sin_heading;
+    double half_length;
+    double half_width;
+    // half extents of the axis aligned bounding box
+    double extent_x;
+    double extent_y;
+  };
+
+  static Query GetQuery(const Box2d &box);
+
+  Query GetQuery(size_t index) const;
+
+  bool HasOverlapAny(const Query &query) const;
+
+  // Sets the margins of the block of boxes starting at begin by which their
+  // axis aligned bounding boxes are apart from the one of the query, returns
+  // whether any of them is not positive, i.e. whether any box of the block
+  // may overlap the query.
+  bool BoundingBoxMargins(size_t begin, const Query &query,
+                          double *__restrict__ margins) const;
+
+  // Sets the margins of the block of boxes starting at begin, the most the
+  // query is apart from each box along any of the four separating axes. A
+  // box overlaps the query when its margin is not positive.
+  void SeparationMargins(size_t begin, const Query &query,
+                         double *__restrict__ margins) const;
+
+  size_t size_ = 0;
+  // padded to whole blocks with NaN boxes, whose margins are NaN and so
+  // never overlap
+  std::vector<double> center_x_;
+  std::vector<double> center_y_;
+  std::vector<double> cos_heading_;
+  std::vector<double> sin_heading_;
+  std::vector<double> half_length_;
+  std::vector<double> half_width_;
+  std::vector<double> heading_;
+  std::vector<double> extent_x_;
+  std::vector<double> extent_y_;
+
+  // bounding box of all the boxes
+  double bounds_min_x_ = 0.0;
+  double bounds_max_x_ = 0.0;
+  double bounds_min_y_ = 0.0;
+  double bounds_max_y_ = 0.0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Times overlap and distance queries of one box against many, pair by pair
+ * with Box2d and in one pass with Box2dBatch.
+ **/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/box2d_batch.h"
+
+DEFINE_int32(benchmark_queries, 2000, "query boxes per configuration");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+std::vector<Box2d> RandomBoxes(const int num, const double range,
+                               std::mt19937 *generator) {
+  std::uniform_real_distribution<double> position(-range, range);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(1.0, 5.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num; ++i) {
+    boxes.emplace_back(Vec2d(position(*generator), position(*generator)),
+                       heading(*generator), size(*generator),
+                       size(*generator));
+  }
+  return boxes;
+}
+
+template <typename Func>
+double TimeUs(const Func &func) {
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         FLAGS_benchmark_queries;
+}
+
+void Run(const int num_boxes) {
+  std::mt19937 generator(0);
+  // obstacles spread so that about one in ten queries hits any of them
+  const auto boxes = RandomBoxes(num_boxes, 60.0 * std::sqrt(num_boxes),
+                                 &generator);
+  const auto queries = RandomBoxes(FLAGS_benchmark_queries,
+                                   60.0 * std::sqrt(num_boxes), &generator);
+  const Box2dBatch batch(boxes);
+
+  int pairwise_hits = 0;
+  const double pairwise_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      for (const auto &box : boxes) {
+        pairwise_hits += query.HasOverlap(box);
+      }
+    }
+  });
+  int batch_hits = 0;
+  std::vector<uint8_t> overlaps;
+  const double batch_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      batch.HasOverlap(query, &overlaps);
+      for (const uint8_t overlap : overlaps) {
+        batch_hits += overlap;
+      }
+    }
+  });
+  int pairwise_any = 0;
+  const double pairwise_any_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      for (const auto &box : boxes) {
+        if (query.HasOverlap(box)) {
+          ++pairwise_any;
+          break;
+        }
+      }
+    }
+  });
+  int batch_any = 0;
+  const double batch_any_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      batch_any += batch.HasOverlapAny(query);
+    }
+  });
+  double pairwise_sum = 0.0;
+  const double pairwise_distance_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      for (const auto &box : boxes) {
+        pairwise_sum += box.DistanceTo(query.center());
+      }
+    }
+  });
+  double batch_sum = 0.0;
+  std::vector<double> distances;
+  const double batch_distance_us = TimeUs([&]() {
+    for (const auto &query : queries) {
+      batch.DistanceTo(query.center(), &distances);
+      for (const double distance : distances) {
+        batch_sum += distance;
+      }
+    }
+  });
+
+  std::cout << num_boxes << " boxes, us per query, pairwise / batch:"
+            << std::endl
+            << "  overlap each: " << pairwise_us << " / " << batch_us << " ("
+            << pairwise_hits << " / " << batch_hits << " overlaps)"
+            << std::endl
+            << "  overlap any: " << pairwise_any_us << " / " << batch_any_us
+            << " (" << pairwise_any << " / " << batch_any << " hits)"
+            << std::endl
+            << "  distance to center: " << pairwise_distance_us << " / "
+            << batch_distance_us << " (sums " << pairwise_sum << " / "
+            << batch_sum << ")" << std::endl;
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  for (const int num_boxes : {16, 128, 1024}) {
+    apollo::common::math::Run(num_boxes);
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::vector<Box2d> RandomBoxes(const int num, std::mt19937 *generator) {
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 6.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num; ++i) {
+    boxes.emplace_back(Vec2d(position(*generator), position(*generator)),
+                       heading(*generator), size(*generator),
+                       size(*generator));
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST(Box2dBatchTest, HasOverlap) {
+  std::mt19937 generator(0);
+  const auto boxes = RandomBoxes(200, &generator);
+  const Box2dBatch batch(boxes);
+  ASSERT_EQ(batch.size(), boxes.size());
+
+  std::vector<uint8_t> overlaps;
+  int overlap_num = 0;
+  for (const auto &box : RandomBoxes(50, &generator)) {
+    batch.HasOverlap(box, &overlaps);
+    ASSERT_EQ(overlaps.size(), boxes.size());
+    bool any = false;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      EXPECT_EQ(overlaps[i] != 0, box.HasOverlap(boxes[i]));
+      any = any || overlaps[i] != 0;
+      overlap_num += overlaps[i];
+    }
+    EXPECT_EQ(batch.HasOverlapAny(box), any);
+  }
+  EXPECT_GT(overlap_num, 0);
+}
+
+TEST(Box2dBatchTest, HasOverlapAnyBatch) {
+  const Box2dBatch batch({Box2d({0.0, 0.0}, 0.0, 4.0, 2.0),
+                          Box2d({10.0, 0.0}, M_PI_4, 4.0, 2.0)});
+  EXPECT_FALSE(batch.HasOverlapAny(Box2dBatch()));
+  EXPECT_FALSE(Box2dBatch().HasOverlapAny(batch));
+  EXPECT_FALSE(batch.HasOverlapAny(
+      Box2dBatch({Box2d({5.0, 0.0}, 0.0, 2.0, 2.0),
+                  Box2d({0.0, 5.0}, M_PI_2, 2.0, 2.0)})));
+  EXPECT_TRUE(batch.HasOverlapAny(
+      Box2dBatch({Box2d({5.0, 0.0}, 0.0, 2.0, 2.0),
+                  Box2d({8.5, 1.0}, 0.0, 2.0, 2.0)})));
+}
+
+TEST(Box2dBatchTest, DistanceTo) {
+  std::mt19937 generator(1);
+  const auto boxes = RandomBoxes(100, &generator);
+  const Box2dBatch batch(boxes);
+  std::uniform_real_distribution<double> position(-30.0, 30.0);
+  std::vector<double> distances;
+  for (int k = 0; k < 20; ++k) {
+    const Vec2d point(position(generator), position(generator));
+    batch.DistanceTo(point, &distances);
+    ASSERT_EQ(distances.size(), boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      EXPECT_NEAR(distances[i], boxes[i].DistanceTo(point), 1e-9);
+    }
+  }
+}
+
+TEST(Box2dBatchTest, Box) {
+  Box2dBatch batch;
+  batch.Add(Box2d({1.0, 2.0}, 0.5, 4.0, 2.0));
+  const Box2d box = batch.box(0);
+  EXPECT_NEAR(box.center_x(), 1.0, 1e-9);
+  EXPECT_NEAR(box.center_y(), 2.0, 1e-9);
+  EXPECT_NEAR(box.heading(), 0.5, 1e-9);
+  EXPECT_NEAR(box.length(), 4.0, 1e-9);
+  EXPECT_NEAR(box.width(), 2.0, 1e-9);
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -158,6 +158,43 @@ void DenseToCSCMatrix(const Eigen::Matrix<T, M, N> &dense_matrix,
   indptr->emplace_back(data_count);
 }
 
+/**
+ * @brief Converts the vertical stack of two dense matrices with the same
+ *        number of columns to CSC without building the stacked matrix.
+ */
+template <typename T, int M, int N, typename D>
+void StackedDenseToCSCMatrix(const Eigen::Matrix<T, M, N> &upper_matrix,
+                             const Eigen::Matrix<T, M, N> &lower_matrix,
+                             std::vector<T> *data, std::vector<D> *indices,
+                             std::vector<D> *indptr) {
+  constexpr double epsilon = 1e-9;
+  const int upper_rows = static_cast<int>(upper_matrix.rows());
+  const int cols = static_cast<int>(
+      upper_rows > 0 ? upper_matrix.cols() : lower_matrix.cols());
+  int data_count = 0;
+  const auto append_column = [&](const Eigen::Matrix<T, M, N> &matrix,
+                                 const int c, const int row_offset) {
+    for (int r = 0; r < matrix.rows(); ++r) {
+      if (std::fabs(matrix(r, c)) < epsilon) {
+        continue;
+      }
+      data->emplace_back(matrix(r, c));
+      ++data_count;
+      indices->emplace_back(r + row_offset);
+    }
+  };
+  for (int c = 0; c < cols; ++c) {
+    indptr->emplace_back(data_count);
+    if (upper_rows > 0) {
+      append_column(upper_matrix, c, 0);
+    }
+    if (lower_matrix.rows() > 0) {
+      append_column(lower_matrix, c, upper_rows);
+    }
+  }
+  indptr->emplace_back(data_count);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
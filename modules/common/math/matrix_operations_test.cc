@@ -380,6 +380,39 @@ TEST(DENSE_TO_CSC_MATRIX, patterned_dense_to_csc_matrix_test) {
   std::cout << std::endl;
 }
 
+TEST(DENSE_TO_CSC_MATRIX, stacked_dense_to_csc_matrix_test) {
+  Eigen::MatrixXd upper_matrix(2, 3);
+  upper_matrix << 1.2, 0, 2.2, 0, 0, 3.1;
+  Eigen::MatrixXd lower_matrix(1, 3);
+  lower_matrix << 4.8, 5.4, 6.01;
+
+  std::vector<double> data;
+  std::vector<int> indices;
+  std::vector<int> indptr;
+  StackedDenseToCSCMatrix(upper_matrix, lower_matrix, &data, &indices,
+                          &indptr);
+
+  Eigen::MatrixXd stacked_matrix(3, 3);
+  stacked_matrix << upper_matrix, lower_matrix;
+  std::vector<double> data_golden;
+  std::vector<int> indices_golden;
+  std::vector<int> indptr_golden;
+  DenseToCSCMatrix(stacked_matrix, &data_golden, &indices_golden,
+                   &indptr_golden);
+
+  EXPECT_EQ(data_golden, data);
+  EXPECT_EQ(indices_golden, indices);
+  EXPECT_EQ(indptr_golden, indptr);
+
+  data.clear();
+  indices.clear();
+  indptr.clear();
+  StackedDenseToCSCMatrix(Eigen::MatrixXd(0, 0), lower_matrix, &data,
+                          &indices, &indptr);
+  EXPECT_EQ(3, data.size());
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), indptr);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
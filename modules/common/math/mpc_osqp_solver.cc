@@ -0,0 +1,386 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/mpc_osqp_solver.h"
+
+#include <algorithm>
+
+#include "Eigen/LU"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Matrix = Eigen::MatrixXd;
+
+namespace {
+
+// a solve capped by max_iter still starts from the shifted last solution and
+// is close to it, the controls are clamped to their bounds afterwards anyway
+bool IsSolved(const OSQPWorkspace *work) {
+  if (work->solution == nullptr || work->info == nullptr) {
+    return false;
+  }
+  const c_int status = work->info->status_val;
+  return status == OSQP_SOLVED || status == OSQP_SOLVED_INACCURATE ||
+         status == OSQP_MAX_ITER_REACHED;
+}
+
+void SetValue(const double value, const size_t index,
+              std::vector<c_float> *data, bool *changed) {
+  if ((*data)[index] != value) {
+    (*data)[index] = value;
+    *changed = true;
+  }
+}
+
+}  // namespace
+
+MpcOsqpSolver::~MpcOsqpSolver() { CleanUp(); }
+
+void MpcOsqpSolver::CleanUp() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+}
+
+bool MpcOsqpSolver::Solve(const Matrix &matrix_a, const Matrix &matrix_b,
+                          const Matrix &matrix_c, const Matrix &matrix_q,
+                          const Matrix &matrix_r, const Matrix &matrix_lower,
+                          const Matrix &matrix_upper,
+                          const Matrix &matrix_initial_state,
+                          const std::vector<Matrix> &reference,
+                          const double eps, const int max_iter,
+                          std::vector<Matrix> *control,
+                          std::vector<Matrix> *control_gain,
+                          std::vector<Matrix> *addition_gain) {
+  reused_ = false;
+  const int state_size = static_cast<int>(matrix_a.rows());
+  const int control_size = static_cast<int>(matrix_b.cols());
+  const int horizon = static_cast<int>(reference.size());
+  if (matrix_a.cols() != state_size || matrix_b.rows() != state_size ||
+      matrix_c.rows() != state_size || matrix_q.rows() != state_size ||
+      matrix_r.rows() != control_size || matrix_lower.rows() != control_size ||
+      matrix_upper.rows() != control_size ||
+      matrix_initial_state.rows() != state_size) {
+    AERROR << "One or more matrices have incompatible dimensions. Aborting.";
+    return false;
+  }
+  if (horizon == 0 || control->size() != reference.size() ||
+      control_gain->size() != reference.size() ||
+      addition_gain->size() != reference.size()) {
+    AERROR << "The control horizon does not match the reference. Aborting.";
+    return false;
+  }
+
+  const bool reusable = work_ != nullptr && state_size == state_size_ &&
+                        control_size == control_size_ &&
+                        horizon == horizon_ && eps == eps_ &&
+                        max_iter == max_iter_;
+  if (!reusable) {
+    CleanUp();
+    BuildStructure(state_size, control_size, horizon);
+  }
+  bool p_changed = false;
+  bool a_changed = false;
+  FillMatrices(matrix_a, matrix_b, matrix_q, matrix_r, &p_changed, &a_changed);
+  FillVectors(matrix_a, matrix_c, matrix_q, matrix_lower, matrix_upper,
+              matrix_initial_state, reference);
+
+  if (reusable) {
+    // the sparsity is fixed by the sizes, only the values are updated; the
+    // kkt system is factorized again only if the dynamics or weights changed
+    const c_int P_nnz = static_cast<c_int>(P_data_.size());
+    const c_int A_nnz = static_cast<c_int>(A_data_.size());
+    if (p_changed && a_changed) {
+      osqp_update_P_A(work_, P_data_.data(), OSQP_NULL, P_nnz, A_data_.data(),
+                      OSQP_NULL, A_nnz);
+    } else if (p_changed) {
+      osqp_update_P(work_, P_data_.data(), OSQP_NULL, P_nnz);
+    } else if (a_changed) {
+      osqp_update_A(work_, A_data_.data(), OSQP_NULL, A_nnz);
+    }
+    osqp_update_lin_cost(work_, q_.data());
+    osqp_update_bounds(work_, l_.data(), u_.data());
+    osqp_warm_start(work_, primal_.data(), dual_.data());
+    reused_ = true;
+  } else if (!SetUp(eps, max_iter)) {
+    return false;
+  }
+  osqp_solve(work_);
+
+  if (!IsSolved(work_)) {
+    AERROR << "Linear MPC OSQP solver failed";
+    CleanUp();
+    return false;
+  }
+
+  const c_float *solution = work_->solution->x;
+  const int control_offset = horizon * state_size;
+  for (int i = 0; i < horizon; ++i) {
+    Matrix &control_i = (*control)[i];
+    control_i.resize(control_size, 1);
+    for (int j = 0; j < control_size; ++j) {
+      control_i(j, 0) =
+          std::min(std::max(solution[control_offset + i * control_size + j],
+                            matrix_lower(j, 0)),
+                   matrix_upper(j, 0));
+    }
+  }
+  ShiftSolution();
+
+  ComputeMPCControlGain(matrix_a, matrix_b, matrix_c, matrix_q, matrix_r,
+                        control_gain, addition_gain);
+  return true;
+}
+
+void MpcOsqpSolver::BuildStructure(const int state_size,
+                                   const int control_size, const int horizon) {
+  state_size_ = state_size;
+  control_size_ = control_size;
+  horizon_ = horizon;
+  const int control_offset = horizon * state_size;
+  const int variable_num = horizon * (state_size + control_size);
+
+  // upper triangles of the diagonal blocks Q and R
+  P_indices_.clear();
+  P_indptr_.clear();
+  P_indptr_.push_back(0);
+  for (int i = 0; i < horizon; ++i) {
+    for (int c = 0; c < state_size; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        P_indices_.push_back(i * state_size + r);
+      }
+      P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+    }
+  }
+  for (int i = 0; i < horizon; ++i) {
+    for (int c = 0; c < control_size; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        P_indices_.push_back(control_offset + i * control_size + r);
+      }
+      P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+    }
+  }
+
+  // the row block i holds x(i + 1) - A * x(i) - B * u(i) = C, the rows after
+  // the dynamics the bounds of the controls. A and B are kept dense so that
+  // zeros in them do not change the sparsity.
+  A_indices_.clear();
+  A_indptr_.clear();
+  A_indptr_.push_back(0);
+  for (int i = 0; i < horizon; ++i) {
+    for (int c = 0; c < state_size; ++c) {
+      A_indices_.push_back(i * state_size + c);
+      if (i + 1 < horizon) {
+        for (int r = 0; r < state_size; ++r) {
+          A_indices_.push_back((i + 1) * state_size + r);
+        }
+      }
+      A_indptr_.push_back(static_cast<c_int>(A_indices_.size()));
+    }
+  }
+  for (int i = 0; i < horizon; ++i) {
+    for (int c = 0; c < control_size; ++c) {
+      for (int r = 0; r < state_size; ++r) {
+        A_indices_.push_back(i * state_size + r);
+      }
+      A_indices_.push_back(control_offset + i * control_size + c);
+      A_indptr_.push_back(static_cast<c_int>(A_indices_.size()));
+    }
+  }
+
+  P_data_.assign(P_indices_.size(), 0.0);
+  A_data_.assign(A_indices_.size(), 0.0);
+  q_.assign(variable_num, 0.0);
+  l_.assign(variable_num, 0.0);
+  u_.assign(variable_num, 0.0);
+  primal_.assign(variable_num, 0.0);
+  dual_.assign(variable_num, 0.0);
+}
+
+void MpcOsqpSolver::FillMatrices(const Matrix &matrix_a,
+                                 const Matrix &matrix_b,
+                                 const Matrix &matrix_q,
+                                 const Matrix &matrix_r, bool *p_changed,
+                                 bool *a_changed) {
+  // same order as BuildStructure
+  size_t index = 0;
+  for (int i = 0; i < horizon_; ++i) {
+    for (int c = 0; c < state_size_; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        SetValue(matrix_q(r, c), index++, &P_data_, p_changed);
+      }
+    }
+  }
+  for (int i = 0; i < horizon_; ++i) {
+    for (int c = 0; c < control_size_; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        SetValue(matrix_r(r, c), index++, &P_data_, p_changed);
+      }
+    }
+  }
+
+  index = 0;
+  for (int i = 0; i < horizon_; ++i) {
+    for (int c = 0; c < state_size_; ++c) {
+      SetValue(1.0, index++, &A_data_, a_changed);
+      if (i + 1 < horizon_) {
+        for (int r = 0; r < state_size_; ++r) {
+          SetValue(-matrix_a(r, c), index++, &A_data_, a_changed);
+        }
+      }
+    }
+  }
+  for (int i = 0; i < horizon_; ++i) {
+    for (int c = 0; c < control_size_; ++c) {
+      for (int r = 0; r < state_size_; ++r) {
+        SetValue(-matrix_b(r, c), index++, &A_data_, a_changed);
+      }
+      SetValue(1.0, index++, &A_data_, a_changed);
+    }
+  }
+}
+
+void MpcOsqpSolver::FillVectors(const Matrix &matrix_a, const Matrix &matrix_c,
+                                const Matrix &matrix_q,
+                                const Matrix &matrix_lower,
+                                const Matrix &matrix_upper,
+                                const Matrix &matrix_initial_state,
+                                const std::vector<Matrix> &reference) {
+  const int control_offset = horizon_ * state_size_;
+  std::fill(q_.begin(), q_.end(), 0.0);
+  for (int i = 0; i < horizon_; ++i) {
+    const Matrix q_i = -matrix_q * reference[i];
+    for (int r = 0; r < state_size_; ++r) {
+      q_[i * state_size_ + r] = q_i(r, 0);
+    }
+  }
+
+  // x(0) is known, it moves into the bound of the first dynamics block
+  const Matrix first_state = matrix_a * matrix_initial_state + matrix_c;
+  for (int i = 0; i < horizon_; ++i) {
+    for (int r = 0; r < state_size_; ++r) {
+      const int row = i * state_size_ + r;
+      l_[row] = i == 0 ? first_state(r, 0) : matrix_c(r, 0);
+      u_[row] = l_[row];
+    }
+    for (int r = 0; r < control_size_; ++r) {
+      const int row = control_offset + i * control_size_ + r;
+      l_[row] = matrix_lower(r, 0);
+      u_[row] = matrix_upper(r, 0);
+    }
+  }
+}
+
+bool MpcOsqpSolver::SetUp(const double eps, const int max_iter) {
+  OSQPSettings *settings =
+      reinterpret_cast<OSQPSettings *>(c_malloc(sizeof(OSQPSettings)));
+  osqp_set_default_settings(settings);
+  settings->eps_abs = eps;
+  settings->eps_rel = eps;
+  settings->max_iter = max_iter;
+  settings->polish = false;
+  settings->verbose = false;
+  settings->warm_start = true;
+
+  OSQPData *data = reinterpret_cast<OSQPData *>(c_malloc(sizeof(OSQPData)));
+  data->n = static_cast<c_int>(q_.size());
+  data->m = static_cast<c_int>(l_.size());
+  data->P = csc_matrix(data->n, data->n, static_cast<c_int>(P_data_.size()),
+                       P_data_.data(), P_indices_.data(), P_indptr_.data());
+  data->q = q_.data();
+  data->A = csc_matrix(data->m, data->n, static_cast<c_int>(A_data_.size()),
+                       A_data_.data(), A_indices_.data(), A_indptr_.data());
+  data->l = l_.data();
+  data->u = u_.data();
+
+  work_ = osqp_setup(data, settings);
+  // the workspace holds its own copy of the problem and the settings
+  c_free(data->A);
+  c_free(data->P);
+  c_free(data);
+  c_free(settings);
+  if (work_ == nullptr) {
+    AERROR << "Failed to set up the linear MPC QP.";
+    return false;
+  }
+  eps_ = eps;
+  max_iter_ = max_iter;
+  return true;
+}
+
+void MpcOsqpSolver::ShiftSolution() {
+  // x(i + 1), u(i) and their dual values move one step ahead, the last step
+  // is repeated
+  const c_float *x = work_->solution->x;
+  const c_float *y = work_->solution->y;
+  const int control_offset = horizon_ * state_size_;
+  for (int i = 0; i < horizon_; ++i) {
+    const int next = std::min(i + 1, horizon_ - 1);
+    for (int r = 0; r < state_size_; ++r) {
+      primal_[i * state_size_ + r] = x[next * state_size_ + r];
+      dual_[i * state_size_ + r] = y[next * state_size_ + r];
+    }
+    for (int r = 0; r < control_size_; ++r) {
+      const int from = control_offset + next * control_size_ + r;
+      primal_[control_offset + i * control_size_ + r] = x[from];
+      dual_[control_offset + i * control_size_ + r] = y[from];
+    }
+  }
+}
+
+void ComputeMPCControlGain(const Matrix &matrix_a, const Matrix &matrix_b,
+                           const Matrix &matrix_c, const Matrix &matrix_q,
+                           const Matrix &matrix_r,
+                           std::vector<Matrix> *control_gain,
+                           std::vector<Matrix> *addition_gain) {
+  // backward: u(i) = -K(i) * x(i) - f(i) minimizes the cost to go
+  // x'(i + 1) * S * x(i + 1) + 2 * s' * x(i + 1) + u'(i) * R * u(i)
+  const size_t horizon = control_gain->size();
+  std::vector<Matrix> matrix_k(horizon);
+  std::vector<Matrix> matrix_f(horizon);
+  Matrix matrix_s = matrix_q;
+  Matrix matrix_s_linear = Matrix::Zero(matrix_a.rows(), 1);
+  for (size_t i = horizon; i-- > 0;) {
+    const Matrix matrix_bts = matrix_b.transpose() * matrix_s;
+    const Matrix matrix_h_inv = (matrix_r + matrix_bts * matrix_b).inverse();
+    const Matrix matrix_sc = matrix_s * matrix_c + matrix_s_linear;
+    matrix_k[i] = matrix_h_inv * matrix_bts * matrix_a;
+    matrix_f[i] = matrix_h_inv * matrix_b.transpose() * matrix_sc;
+    const Matrix matrix_closed = matrix_a - matrix_b * matrix_k[i];
+    matrix_s_linear = matrix_closed.transpose() * matrix_sc;
+    matrix_s = matrix_q + matrix_a.transpose() * matrix_s * matrix_closed;
+  }
+
+  // forward: the closed loop from x(0) and from C alone
+  Matrix matrix_phi = Matrix::Identity(matrix_a.rows(), matrix_a.cols());
+  Matrix matrix_disturbance = Matrix::Zero(matrix_a.rows(), 1);
+  for (size_t i = 0; i < horizon; ++i) {
+    (*control_gain)[i] = -matrix_k[i] * matrix_phi;
+    (*addition_gain)[i] = -matrix_k[i] * matrix_disturbance - matrix_f[i];
+    const Matrix matrix_closed = matrix_a - matrix_b * matrix_k[i];
+    matrix_phi = matrix_closed * matrix_phi;
+    matrix_disturbance = matrix_closed * matrix_disturbance -
+                         matrix_b * matrix_f[i] + matrix_c;
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file mpc_osqp_solver.h
+ * @brief Solve the mpc problem in its sparse form with a persistent OSQP
+ * workspace.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "osqp/include/osqp.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class MpcOsqpSolver
+ * @brief Solver for the discrete-time model predictive control problem of
+ * SolveLinearMPC, x(i + 1) = A * x(i) + B * u(i) + C.
+ *
+ * The predicted states stay decision variables next to the controls and the
+ * dynamics become equality constraints, so the QP is block sparse and its
+ * sparsity only depends on the state size, the control size and the horizon.
+ * The OSQP workspace is kept across solves: while those sizes do not change,
+ * only the values of the dynamics, the weights and the bounds are updated,
+ * and the previous solution shifted by one step warm starts the next solve.
+ */
+class MpcOsqpSolver {
+ public:
+  MpcOsqpSolver() = default;
+  ~MpcOsqpSolver();
+
+  MpcOsqpSolver(const MpcOsqpSolver &) = delete;
+  MpcOsqpSolver &operator=(const MpcOsqpSolver &) = delete;
+
+  /**
+   * @brief Solve the mpc problem, with the arguments of SolveLinearMPC.
+   * @param matrix_a The system dynamic matrix
+   * @param matrix_b The control matrix
+   * @param matrix_c The disturbance matrix
+   * @param matrix_q The cost matrix for control state
+   * @param matrix_r The cost matrix for control
+   * @param matrix_lower The lower bound control constrain matrix
+   * @param matrix_upper The upper bound control constrain matrix
+   * @param matrix_initial_state The initial state matrix
+   * @param reference The control reference vector with respect to time
+   * @param eps The absolute and relative tolerance of OSQP
+   * @param max_iter The maximum iterations of OSQP
+   * @param control The control vector with respect to time (pointer)
+   * @param control_gain The unconstrained feedback gain with respect to the
+   * initial state (pointer)
+   * @param addition_gain The unconstrained feedback gain with respect to the
+   * disturbance (pointer)
+   * @return True if a solution has been found
+   */
+  bool Solve(const Eigen::MatrixXd &matrix_a, const Eigen::MatrixXd &matrix_b,
+             const Eigen::MatrixXd &matrix_c, const Eigen::MatrixXd &matrix_q,
+             const Eigen::MatrixXd &matrix_r,
+             const Eigen::MatrixXd &matrix_lower,
+             const Eigen::MatrixXd &matrix_upper,
+             const Eigen::MatrixXd &matrix_initial_state,
+             const std::vector<Eigen::MatrixXd> &reference, const double eps,
+             const int max_iter, std::vector<Eigen::MatrixXd> *control,
+             std::vector<Eigen::MatrixXd> *control_gain,
+             std::vector<Eigen::MatrixXd> *addition_gain);
+
+  /**
+   * @brief Release the workspace, the next solve sets it up again.
+   */
+  void CleanUp();
+
+  /**
+   * @brief Whether the last solve reused the workspace of the one before.
+   */
+  bool reused() const { return reused_; }
+
+ private:
+  void BuildStructure(const int state_size, const int control_size,
+                      const int horizon);
+
+  void FillMatrices(const Eigen::MatrixXd &matrix_a,
+                    const Eigen::MatrixXd &matrix_b,
+                    const Eigen::MatrixXd &matrix_q,
+                    const Eigen::MatrixXd &matrix_r, bool *p_changed,
+                    bool *a_changed);
+
+  void FillVectors(const Eigen::MatrixXd &matrix_a,
+                   const Eigen::MatrixXd &matrix_c,
+                   const Eigen::MatrixXd &matrix_q,
+                   const Eigen::MatrixXd &matrix_lower,
+                   const Eigen::MatrixXd &matrix_upper,
+                   const Eigen::MatrixXd &matrix_initial_state,
+                   const std::vector<Eigen::MatrixXd> &reference);
+
+  bool SetUp(const double eps, const int max_iter);
+
+  void ShiftSolution();
+
+  OSQPWorkspace *work_ = nullptr;
+  bool reused_ = false;
+
+  // sizes and settings work_ has been set up with
+  int state_size_ = 0;
+  int control_size_ = 0;
+  int horizon_ = 0;
+  double eps_ = 0.0;
+  int max_iter_ = 0;
+
+  // min 0.5 x'Px + q'x s.t. l <= Ax <= u, x = [x(1) .. x(N), u(0) .. u(N-1)]
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> q_;
+  std::vector<c_float> l_;
+  std::vector<c_float> u_;
+
+  // last solution shifted by one step, to warm start the next solve
+  std::vector<c_float> primal_;
+  std::vector<c_float> dual_;
+};
+
+/**
+ * @brief Unconstrained feedback gains of the mpc problem with zero reference,
+ * the gains SolveLinearMPC derives from the condensed problem, from the
+ * Riccati recursion instead of the inverse of the condensed hessian.
+ * @param matrix_a The system dynamic matrix
+ * @param matrix_b The control matrix
+ * @param matrix_c The disturbance matrix
+ * @param matrix_q The cost matrix for control state
+ * @param matrix_r The cost matrix for control
+ * @param control_gain The gain of u(i) with respect to x(0) (pointer)
+ * @param addition_gain The part of u(i) caused by C (pointer)
+ */
+void ComputeMPCControlGain(const Eigen::MatrixXd &matrix_a,
+                           const Eigen::MatrixXd &matrix_b,
+                           const Eigen::MatrixXd &matrix_c,
+                           const Eigen::MatrixXd &matrix_q,
+                           const Eigen::MatrixXd &matrix_r,
+                           std::vector<Eigen::MatrixXd> *control_gain,
+                           std::vector<Eigen::MatrixXd> *addition_gain);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/mpc_osqp_solver.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/mpc_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Eigen::MatrixXd;
+
+class MpcOsqpSolverTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    A_ = MatrixXd(kStates, kStates);
+    A_ << 1, 0, 0.1, 0, 0, 1, 0, 0.1, 0, 0, 1, 0, 0, 0, 0, 1;
+    B_ = MatrixXd(kStates, kControls);
+    B_ << 0.005, 0, 0, 0.005, 0.1, 0, 0, 0.1;
+    C_ = MatrixXd(kStates, 1);
+    C_ << 0, 0, 0, 0.1;
+    Q_ = MatrixXd::Identity(kStates, kStates);
+    R_ = MatrixXd::Identity(kControls, kControls) * 0.1;
+    lower_ = MatrixXd(kControls, 1);
+    lower_ << -2, -2;
+    upper_ = MatrixXd(kControls, 1);
+    upper_ << 2, 2;
+    initial_state_ = MatrixXd(kStates, 1);
+    initial_state_ << 2, -4, 0, 0.5;
+    reference_.assign(kHorizon, MatrixXd::Zero(kStates, 1));
+  }
+
+ protected:
+  void ResetOutputs(std::vector<MatrixXd> *control,
+                    std::vector<MatrixXd> *control_gain,
+                    std::vector<MatrixXd> *addition_gain) const {
+    control->assign(kHorizon, MatrixXd::Zero(kControls, 1));
+    control_gain->assign(kHorizon, MatrixXd::Zero(kControls, kStates));
+    addition_gain->assign(kHorizon, MatrixXd::Zero(kControls, 1));
+  }
+
+  static constexpr int kStates = 4;
+  static constexpr int kControls = 2;
+  static constexpr int kHorizon = 10;
+  static constexpr double kEps = 1e-7;
+  static constexpr int kMaxIter = 20000;
+
+  MatrixXd A_;
+  MatrixXd B_;
+  MatrixXd C_;
+  MatrixXd Q_;
+  MatrixXd R_;
+  MatrixXd lower_;
+  MatrixXd upper_;
+  MatrixXd initial_state_;
+  std::vector<MatrixXd> reference_;
+};
+
+TEST_F(MpcOsqpSolverTest, MatchesCondensedSolution) {
+  std::vector<MatrixXd> control;
+  std::vector<MatrixXd> control_gain;
+  std::vector<MatrixXd> addition_gain;
+  ResetOutputs(&control, &control_gain, &addition_gain);
+  EXPECT_TRUE(SolveLinearMPC(A_, B_, C_, Q_, R_, lower_, upper_,
+                             initial_state_, reference_, kEps, kMaxIter,
+                             &control, &control_gain, &addition_gain));
+
+  std::vector<MatrixXd> osqp_control;
+  std::vector<MatrixXd> osqp_control_gain;
+  std::vector<MatrixXd> osqp_addition_gain;
+  ResetOutputs(&osqp_control, &osqp_control_gain, &osqp_addition_gain);
+  MpcOsqpSolver solver;
+  EXPECT_TRUE(solver.Solve(A_, B_, C_, Q_, R_, lower_, upper_, initial_state_,
+                           reference_, kEps, kMaxIter, &osqp_control,
+                           &osqp_control_gain, &osqp_addition_gain));
+  EXPECT_FALSE(solver.reused());
+
+  // the first control saturates
+  EXPECT_NEAR(lower_(0, 0), osqp_control[0](0, 0), 1e-4);
+  for (int i = 0; i < kHorizon; ++i) {
+    for (int r = 0; r < kControls; ++r) {
+      EXPECT_NEAR(control[i](r, 0), osqp_control[i](r, 0), 1e-3);
+      EXPECT_NEAR(addition_gain[i](r, 0), osqp_addition_gain[i](r, 0), 1e-6);
+      for (int c = 0; c < kStates; ++c) {
+        EXPECT_NEAR(control_gain[i](r, c), osqp_control_gain[i](r, c), 1e-6);
+      }
+    }
+  }
+}
+
+TEST_F(MpcOsqpSolverTest, ReusesWorkspace) {
+  std::vector<MatrixXd> control;
+  std::vector<MatrixXd> control_gain;
+  std::vector<MatrixXd> addition_gain;
+  ResetOutputs(&control, &control_gain, &addition_gain);
+  MpcOsqpSolver solver;
+  EXPECT_TRUE(solver.Solve(A_, B_, C_, Q_, R_, lower_, upper_, initial_state_,
+                           reference_, kEps, kMaxIter, &control,
+                           &control_gain, &addition_gain));
+
+  // new dynamics and a new state keep the sparsity
+  A_(0, 2) = 0.2;
+  A_(1, 3) = 0.0;
+  initial_state_(0, 0) = 0.5;
+  EXPECT_TRUE(solver.Solve(A_, B_, C_, Q_, R_, lower_, upper_, initial_state_,
+                           reference_, kEps, kMaxIter, &control,
+                           &control_gain, &addition_gain));
+  EXPECT_TRUE(solver.reused());
+
+  std::vector<MatrixXd> expected_control;
+  std::vector<MatrixXd> expected_control_gain;
+  std::vector<MatrixXd> expected_addition_gain;
+  ResetOutputs(&expected_control, &expected_control_gain,
+               &expected_addition_gain);
+  MpcOsqpSolver new_solver;
+  EXPECT_TRUE(new_solver.Solve(A_, B_, C_, Q_, R_, lower_, upper_,
+                               initial_state_, reference_, kEps, kMaxIter,
+                               &expected_control, &expected_control_gain,
+                               &expected_addition_gain));
+  for (int i = 0; i < kHorizon; ++i) {
+    for (int r = 0; r < kControls; ++r) {
+      EXPECT_NEAR(expected_control[i](r, 0), control[i](r, 0), 1e-3);
+    }
+  }
+
+  // a longer horizon sets the workspace up again
+  reference_.push_back(reference_.back());
+  control.push_back(control.back());
+  control_gain.push_back(control_gain.back());
+  addition_gain.push_back(addition_gain.back());
+  EXPECT_TRUE(solver.Solve(A_, B_, C_, Q_, R_, lower_, upper_, initial_state_,
+                           reference_, kEps, kMaxIter, &control,
+                           &control_gain, &addition_gain));
+  EXPECT_FALSE(solver.reused());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -53,16 +53,7 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
     }
   }
 
-  std::size_t index_start = (index_min == 0) ? index_min : index_min - 1;
-  std::size_t index_end =
-      (index_min + 1 == reference_line.size()) ? index_min : index_min + 1;
-
-  if (index_start == index_end) {
-    return reference_line[index_start];
-  }
-
-  return FindProjectionPoint(reference_line[index_start],
-                             reference_line[index_end], x, y);
+  return MatchAroundIndex(reference_line, index_min, x, y);
 }
 
 std::pair<double, double> PathMatcher::GetPathFrenetCoordinate(
@@ -101,6 +92,110 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
   return InterpolateUsingLinearApproximation(*(it_lower - 1), *it_lower, s);
 }
 
+std::vector<PathPoint> PathMatcher::MatchToPath(
+    const std::vector<PathPoint>& reference_line,
+    const std::vector<double>& s_values) {
+  auto comp = [](const PathPoint& point, const double s) {
+    return point.s() < s;
+  };
+
+  std::vector<PathPoint> matched_points;
+  matched_points.reserve(s_values.size());
+  auto it_lower = reference_line.begin();
+  for (std::size_t i = 0; i < s_values.size(); ++i) {
+    const double s = s_values[i];
+    if (i > 0 && s < s_values[i - 1]) {
+      it_lower = std::lower_bound(reference_line.begin(), reference_line.end(),
+                                  s, comp);
+    } else {
+      while (it_lower != reference_line.end() && comp(*it_lower, s)) {
+        ++it_lower;
+      }
+    }
+
+    if (it_lower == reference_line.begin()) {
+      matched_points.push_back(reference_line.front());
+    } else if (it_lower == reference_line.end()) {
+      matched_points.push_back(reference_line.back());
+    } else {
+      matched_points.push_back(
+          InterpolateUsingLinearApproximation(*(it_lower - 1), *it_lower, s));
+    }
+  }
+  return matched_points;
+}
+
+std::vector<PathPoint> PathMatcher::MatchToPath(
+    const std::vector<PathPoint>& reference_line,
+    const std::vector<Vec2d>& points) {
+  CHECK_GT(reference_line.size(), 0);
+
+  std::vector<PathPoint> matched_points;
+  matched_points.reserve(points.size());
+  if (points.empty()) {
+    return matched_points;
+  }
+
+  auto func_distance_square = [](const PathPoint& point, const Vec2d& xy) {
+    double dx = point.x() - xy.x();
+    double dy = point.y() - xy.y();
+    return dx * dx + dy * dy;
+  };
+
+  std::size_t index_min = 0;
+  double distance_min = func_distance_square(reference_line.front(), points[0]);
+  for (std::size_t i = 1; i < reference_line.size(); ++i) {
+    double distance_temp = func_distance_square(reference_line[i], points[0]);
+    if (distance_temp < distance_min) {
+      distance_min = distance_temp;
+      index_min = i;
+    }
+  }
+  matched_points.push_back(MatchAroundIndex(reference_line, index_min,
+                                            points[0].x(), points[0].y()));
+
+  for (std::size_t j = 1; j < points.size(); ++j) {
+    const Vec2d& point = points[j];
+    distance_min = func_distance_square(reference_line[index_min], point);
+    while (index_min + 1 < reference_line.size()) {
+      double distance_temp =
+          func_distance_square(reference_line[index_min + 1], point);
+      if (distance_temp >= distance_min) {
+        break;
+      }
+      distance_min = distance_temp;
+      ++index_min;
+    }
+    while (index_min > 0) {
+      double distance_temp =
+          func_distance_square(reference_line[index_min - 1], point);
+      if (distance_temp >= distance_min) {
+        break;
+      }
+      distance_min = distance_temp;
+      --index_min;
+    }
+    matched_points.push_back(
+        MatchAroundIndex(reference_line, index_min, point.x(), point.y()));
+  }
+  return matched_points;
+}
+
+PathPoint PathMatcher::MatchAroundIndex(
+    const std::vector<PathPoint>& reference_line, const std::size_t index_min,
+    const double x, const double y) {
+  std::size_t index_start = (index_min == 0) ? index_min : index_min - 1;
+  std::size_t index_end =
+      (index_min + 1 == reference_line.size()) ? index_min : index_min + 1;
+
+  if (index_start == index_end) {
+    return reference_line[index_start];
+  }
+
+  return FindProjectionPoint(reference_line[index_start],
+                             reference_line[index_end], x, y);
+}
+
 PathPoint PathMatcher::FindProjectionPoint(const PathPoint& p0,
                                            const PathPoint& p1, const double x,
                                            const double y) {
@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
@@ -43,7 +44,30 @@ class PathMatcher {
   static PathPoint MatchToPath(const std::vector<PathPoint>& reference_line,
                                const double s);
 
+  /**
+   * @brief Batched MatchToPath by s. The search resumes from the previous
+   * match while s_values is non-decreasing, so a sorted sequence takes one
+   * linear pass over the reference line.
+   */
+  static std::vector<PathPoint> MatchToPath(
+      const std::vector<PathPoint>& reference_line,
+      const std::vector<double>& s_values);
+
+  /**
+   * @brief Batched MatchToPath by (x, y) for a sequence of points moving
+   * along the reference line, such as a trajectory. Only the first point is
+   * matched against the whole line; every following point descends to the
+   * nearest reference point starting from the previous one.
+   */
+  static std::vector<PathPoint> MatchToPath(
+      const std::vector<PathPoint>& reference_line,
+      const std::vector<Vec2d>& points);
+
  private:
+  static PathPoint MatchAroundIndex(
+      const std::vector<PathPoint>& reference_line, const std::size_t index_min,
+      const double x, const double y);
+
   static PathPoint FindProjectionPoint(const PathPoint& p0, const PathPoint& p1,
                                        const double x, const double y);
 };
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/path_matcher.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// Quarter circle of radius 10 sampled every 1 meter of arc length.
+std::vector<PathPoint> MakeArc() {
+  std::vector<PathPoint> points;
+  for (int i = 0; i <= 15; ++i) {
+    const double s = static_cast<double>(i);
+    const double theta = s / 10.0;
+    PathPoint point;
+    point.set_x(10.0 * std::sin(theta));
+    point.set_y(10.0 - 10.0 * std::cos(theta));
+    point.set_theta(theta);
+    point.set_kappa(0.1);
+    point.set_s(s);
+    points.push_back(point);
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(PathMatcherTest, BatchMatchToPathByS) {
+  const auto reference_line = MakeArc();
+  const std::vector<double> s_values = {-1.0, 0.0, 0.3, 2.5, 2.5, 7.9,
+                                        15.0, 20.0, 4.2, 1.1};
+  const auto matched_points =
+      PathMatcher::MatchToPath(reference_line, s_values);
+  ASSERT_EQ(s_values.size(), matched_points.size());
+  for (std::size_t i = 0; i < s_values.size(); ++i) {
+    const auto expected = PathMatcher::MatchToPath(reference_line, s_values[i]);
+    EXPECT_DOUBLE_EQ(expected.s(), matched_points[i].s());
+    EXPECT_DOUBLE_EQ(expected.x(), matched_points[i].x());
+    EXPECT_DOUBLE_EQ(expected.y(), matched_points[i].y());
+  }
+}
+
+TEST(PathMatcherTest, BatchMatchToPathByXY) {
+  const auto reference_line = MakeArc();
+  std::vector<Vec2d> points;
+  for (double s = 0.2; s < 15.0; s += 0.7) {
+    const double theta = s / 10.0;
+    // Half a meter off the arc on alternating sides.
+    const double l = (points.size() % 2 == 0) ? 0.5 : -0.5;
+    points.emplace_back(10.0 * std::sin(theta) - l * std::sin(theta),
+                        10.0 - 10.0 * std::cos(theta) + l * std::cos(theta));
+  }
+  const auto matched_points = PathMatcher::MatchToPath(reference_line, points);
+  ASSERT_EQ(points.size(), matched_points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto expected = PathMatcher::MatchToPath(
+        reference_line, points[i].x(), points[i].y());
+    EXPECT_DOUBLE_EQ(expected.s(), matched_points[i].s());
+    EXPECT_DOUBLE_EQ(expected.x(), matched_points[i].x());
+    EXPECT_DOUBLE_EQ(expected.y(), matched_points[i].y());
+  }
+
+  EXPECT_TRUE(
+      PathMatcher::MatchToPath(reference_line, std::vector<Vec2d>()).empty());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -28,6 +28,7 @@
 #include "google/protobuf/message.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/string_util.h"
+#include "modules/common/util/trace_util.h"
 
 /**
  * @namespace apollo::common::util
@@ -50,6 +51,7 @@ static void FillHeader(const std::string& module_name, T* msg) {
   header->set_timestamp_sec(timestamp);
   header->set_sequence_num(
       static_cast<unsigned int>(sequence_num.fetch_add(1)));
+  FillTrace(header);
 }
 
 template <typename T, typename std::enable_if<
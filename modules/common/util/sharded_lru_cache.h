@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A thread safe LRU cache sharded over independently locked LRUCache.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/common/util/lru_cache.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+struct LRUCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+};
+
+/**
+ * @class ShardedLRUCache
+ * @brief Keys are spread over shards by hash, each an LRUCache with its own
+ *        lock, so threads touching different shards do not contend.
+ *        Eviction is least recently used within a shard. Values are copied
+ *        in and out, as a pointer into a shard is not safe once its lock
+ *        has been released.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+ public:
+  /**
+   * @param capacity Entries kept at most over all the shards.
+   * @param num_shards Number of independently locked shards.
+   */
+  explicit ShardedLRUCache(const size_t capacity,
+                           const size_t num_shards = kDefaultNumShards) {
+    const size_t shard_num = std::max<size_t>(num_shards, 1);
+    const size_t shard_capacity =
+        std::max<size_t>((capacity + shard_num - 1) / shard_num, 1);
+    for (size_t i = 0; i < shard_num; ++i) {
+      shards_.emplace_back(new Shard(shard_capacity));
+    }
+  }
+
+  bool Get(const K& key, V* const val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.Get(key, val);
+  }
+
+  template <typename VV>
+  void Put(const K& key, VV&& val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.Put(key, std::forward<VV>(val));
+  }
+
+  /*
+   * Get the cached ones of keys into found, locking each shard once.
+   * Returns the number found.
+   */
+  size_t GetBatch(const std::vector<K>& keys,
+                  std::unordered_map<K, V>* const found) {
+    size_t found_num = 0;
+    ForEachShard(keys, [&](Shard* shard, const std::vector<const K*>& batch) {
+      V val;
+      for (const K* key : batch) {
+        if (shard->Get(*key, &val)) {
+          (*found)[*key] = val;
+          ++found_num;
+        }
+      }
+    });
+    return found_num;
+  }
+
+  /*
+   * Put all of entries, locking each shard once.
+   */
+  void PutBatch(const std::vector<std::pair<K, V>>& entries) {
+    std::vector<K> keys;
+    keys.reserve(entries.size());
+    for (const auto& entry : entries) {
+      keys.push_back(entry.first);
+    }
+    const std::pair<K, V>* first = entries.data();
+    ForEachShard(keys, [&](Shard* shard, const std::vector<const K*>& batch) {
+      for (const K* key : batch) {
+        shard->Put(*key, first[key - keys.data()].second);
+      }
+    });
+  }
+
+  size_t size() {
+    size_t size = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->cache.size();
+    }
+    return size;
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->cache.Clear();
+    }
+  }
+
+  LRUCacheStats GetStats() {
+    LRUCacheStats stats;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      stats.hits += shard->stats.hits;
+      stats.misses += shard->stats.misses;
+      stats.evictions += shard->stats.evictions;
+    }
+    return stats;
+  }
+
+ private:
+  static constexpr size_t kDefaultNumShards = 16;
+
+  struct Shard {
+    explicit Shard(const size_t capacity) : cache(capacity) {}
+
+    bool Get(const K& key, V* const val) {
+      if (cache.GetCopy(key, val)) {
+        ++stats.hits;
+        return true;
+      }
+      ++stats.misses;
+      return false;
+    }
+
+    template <typename VV>
+    void Put(const K& key, VV&& val) {
+      if (cache.Full() && !cache.Contains(key)) {
+        ++stats.evictions;
+      }
+      cache.Put(key, std::forward<VV>(val));
+    }
+
+    std::mutex mutex;
+    LRUCache<K, V> cache;
+    LRUCacheStats stats;
+  };
+
+  Shard& GetShard(const K& key) { return *shards_[ShardIndex(key)]; }
+
+  size_t ShardIndex(const K& key) const {
+    // std::hash of integers is the identity, so mix the bits before taking
+    // the shard
+    const uint64_t hash =
+        static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((hash >> 32) % shards_.size());
+  }
+
+  template <typename Func>
+  void ForEachShard(const std::vector<K>& keys, const Func& func) {
+    std::vector<std::vector<const K*>> batches(shards_.size());
+    for (const K& key : keys) {
+      batches[ShardIndex(key)].push_back(&key);
+    }
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      if (batches[i].empty()) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(shards_[i]->mutex);
+      func(shards_[i].get(), batches[i]);
+    }
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  Hash hash_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
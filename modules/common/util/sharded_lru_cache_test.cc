@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/sharded_lru_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ShardedLRUCache, GetPut) {
+  ShardedLRUCache<int, std::string> cache(100, 4);
+  std::string val;
+  EXPECT_FALSE(cache.Get(1, &val));
+  cache.Put(1, "one");
+  cache.Put(2, "two");
+  EXPECT_TRUE(cache.Get(1, &val));
+  EXPECT_EQ(val, "one");
+  cache.Put(1, "uno");
+  EXPECT_TRUE(cache.Get(1, &val));
+  EXPECT_EQ(val, "uno");
+  EXPECT_EQ(cache.size(), 2);
+
+  const LRUCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.evictions, 0);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_FALSE(cache.Get(1, &val));
+}
+
+TEST(ShardedLRUCache, EvictsLeastRecentlyUsed) {
+  // a single shard evicts exactly like LRUCache
+  ShardedLRUCache<int, int> cache(3, 1);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  int val = 0;
+  EXPECT_TRUE(cache.Get(1, &val));
+  cache.Put(4, 4);
+  EXPECT_FALSE(cache.Get(2, &val));
+  EXPECT_TRUE(cache.Get(1, &val));
+  EXPECT_TRUE(cache.Get(3, &val));
+  EXPECT_TRUE(cache.Get(4, &val));
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.GetStats().evictions, 1);
+}
+
+TEST(ShardedLRUCache, Batch) {
+  ShardedLRUCache<int, int> cache(1000, 8);
+  std::vector<std::pair<int, int>> entries;
+  for (int i = 0; i < 100; ++i) {
+    entries.emplace_back(i, i * i);
+  }
+  cache.PutBatch(entries);
+  EXPECT_EQ(cache.size(), 100);
+
+  std::unordered_map<int, int> found;
+  EXPECT_EQ(cache.GetBatch({3, 50, 99, 100, 200}, &found), 3);
+  ASSERT_EQ(found.size(), 3);
+  EXPECT_EQ(found[3], 9);
+  EXPECT_EQ(found[50], 2500);
+  EXPECT_EQ(found[99], 9801);
+  EXPECT_EQ(cache.GetStats().misses, 2);
+}
+
+TEST(ShardedLRUCache, Concurrent) {
+  const int kThreadNum = 8;
+  const int kKeyNum = 1000;
+  ShardedLRUCache<int, int> cache(kKeyNum * kThreadNum);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < kKeyNum; ++i) {
+        const int key = t * kKeyNum + i;
+        cache.Put(key, key + 1);
+        int val = 0;
+        EXPECT_TRUE(cache.Get(key, &val));
+        EXPECT_EQ(val, key + 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cache.size(), kKeyNum * kThreadNum);
+  EXPECT_EQ(cache.GetStats().hits, kKeyNum * kThreadNum);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
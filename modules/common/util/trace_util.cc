@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/trace_util.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+namespace {
+
+thread_local const TraceContext* current_trace = nullptr;
+
+}  // namespace
+
+bool InitTrace(const Header& input, TraceContext* trace) {
+  trace->Clear();
+  if (input.has_trace()) {
+    trace->CopyFrom(input.trace());
+    return true;
+  }
+  uint64_t sensor_timestamp = 0;
+  if (input.lidar_timestamp() > 0) {
+    sensor_timestamp = input.lidar_timestamp();
+    trace->set_sensor("lidar");
+  } else if (input.camera_timestamp() > 0) {
+    sensor_timestamp = input.camera_timestamp();
+    trace->set_sensor("camera");
+  } else if (input.radar_timestamp() > 0) {
+    sensor_timestamp = input.radar_timestamp();
+    trace->set_sensor("radar");
+  } else {
+    return false;
+  }
+  trace->set_sensor_timestamp_sec(static_cast<double>(sensor_timestamp) *
+                                  1e-9);
+  AddTraceHop(input.module_name(), input.timestamp_sec(), trace);
+  return true;
+}
+
+void AddTraceHop(const std::string& module_name, const double timestamp_sec,
+                 TraceContext* trace) {
+  auto* hop = trace->add_hop();
+  hop->set_module_name(module_name);
+  hop->set_timestamp_sec(timestamp_sec);
+}
+
+const TraceContext* CurrentTrace() { return current_trace; }
+
+void FillTrace(Header* header) {
+  if (current_trace == nullptr) {
+    header->clear_trace();
+    return;
+  }
+  auto* trace = header->mutable_trace();
+  trace->CopyFrom(*current_trace);
+  AddTraceHop(header->module_name(), header->timestamp_sec(), trace);
+}
+
+TraceScope::TraceScope(const Header& input) : previous_(current_trace) {
+  current_trace = InitTrace(input, &trace_) ? &trace_ : nullptr;
+}
+
+TraceScope::~TraceScope() { current_trace = previous_; }
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Propagation of the sensor frame trace carried in message headers.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "modules/common/proto/header.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @brief Starts the trace of a message derived from input. The trace is the
+ * one of input, or begins at the lidar, camera or radar timestamp of input
+ * with input itself as the first hop.
+ * @return false if input can not be traced to a sensor frame.
+ */
+bool InitTrace(const Header& input, TraceContext* trace);
+
+/**
+ * @brief Appends a module handling the traced frame at timestamp_sec.
+ */
+void AddTraceHop(const std::string& module_name, const double timestamp_sec,
+                 TraceContext* trace);
+
+/**
+ * @brief The trace of the input processed on this thread, nullptr if there is
+ * none.
+ */
+const TraceContext* CurrentTrace();
+
+/**
+ * @brief Sets the trace of header to the current one, with the module and
+ * time of header as the last hop. FillHeader() calls it, so modules
+ * processing inside a TraceScope propagate the trace automatically.
+ */
+void FillTrace(Header* header);
+
+/**
+ * @class TraceScope
+ * @brief Makes the trace of input current on this thread until destruction.
+ * Place it where a module starts processing its triggering input.
+ */
+class TraceScope {
+ public:
+  explicit TraceScope(const Header& input);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  TraceContext trace_;
+  const TraceContext* previous_ = nullptr;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
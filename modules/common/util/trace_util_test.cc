@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/trace_util.h"
+
+#include "gtest/gtest.h"
+#include "modules/common/util/message_util.h"
+#include "modules/common/util/testdata/simple.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(TraceUtilTest, InitTrace) {
+  Header header;
+  TraceContext trace;
+  header.set_module_name("perception");
+  header.set_timestamp_sec(100.2);
+  EXPECT_FALSE(InitTrace(header, &trace));
+
+  header.set_camera_timestamp(100100000000);
+  header.set_lidar_timestamp(100000000000);
+  EXPECT_TRUE(InitTrace(header, &trace));
+  EXPECT_EQ("lidar", trace.sensor());
+  EXPECT_DOUBLE_EQ(100.0, trace.sensor_timestamp_sec());
+  ASSERT_EQ(1, trace.hop_size());
+  EXPECT_EQ("perception", trace.hop(0).module_name());
+  EXPECT_DOUBLE_EQ(100.2, trace.hop(0).timestamp_sec());
+
+  // A trace already in the header takes precedence over sensor timestamps.
+  AddTraceHop("prediction", 100.3, &trace);
+  header.mutable_trace()->CopyFrom(trace);
+  TraceContext copied;
+  EXPECT_TRUE(InitTrace(header, &copied));
+  EXPECT_EQ(trace.DebugString(), copied.DebugString());
+}
+
+TEST(TraceUtilTest, FillHeaderInScope) {
+  test::SimpleMessage input;
+  input.mutable_header()->set_module_name("perception");
+  input.mutable_header()->set_timestamp_sec(100.2);
+  input.mutable_header()->set_lidar_timestamp(100000000000);
+
+  test::SimpleMessage output;
+  {
+    TraceScope scope(input.header());
+    ASSERT_NE(nullptr, CurrentTrace());
+    FillHeader("prediction", &output);
+    {
+      // An untraced input hides the outer trace.
+      const Header untraced;
+      TraceScope inner(untraced);
+      EXPECT_EQ(nullptr, CurrentTrace());
+    }
+    EXPECT_NE(nullptr, CurrentTrace());
+  }
+  EXPECT_EQ(nullptr, CurrentTrace());
+
+  const auto& trace = output.header().trace();
+  EXPECT_DOUBLE_EQ(100.0, trace.sensor_timestamp_sec());
+  ASSERT_EQ(2, trace.hop_size());
+  EXPECT_EQ("perception", trace.hop(0).module_name());
+  EXPECT_EQ("prediction", trace.hop(1).module_name());
+  EXPECT_DOUBLE_EQ(output.header().timestamp_sec(),
+                   trace.hop(1).timestamp_sec());
+
+  // Out of any scope, a refilled header drops its stale trace.
+  FillHeader("prediction", &output);
+  EXPECT_FALSE(output.header().has_trace());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
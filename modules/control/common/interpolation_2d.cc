@@ -16,7 +16,9 @@
 
 #include "modules/control/common/interpolation_2d.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 
 #include "cyber/common/log.h"
 
@@ -34,32 +36,59 @@ bool Interpolation2D::Init(const DataType &xyz) {
     AERROR << "empty input.";
     return false;
   }
+  std::map<double, std::map<double, double>> xyz_table;
   for (const auto &t : xyz) {
-    xyz_[std::get<0>(t)][std::get<1>(t)] = std::get<2>(t);
+    xyz_table[std::get<0>(t)][std::get<1>(t)] = std::get<2>(t);
+  }
+
+  xs_.clear();
+  row_begin_.clear();
+  ys_.clear();
+  zs_.clear();
+  for (const auto &row : xyz_table) {
+    xs_.push_back(row.first);
+    row_begin_.push_back(ys_.size());
+    for (const auto &yz : row.second) {
+      ys_.push_back(yz.first);
+      zs_.push_back(yz.second);
+    }
+  }
+  row_begin_.push_back(ys_.size());
+
+  // Calibration tables sample speed evenly, then the row of a speed is found
+  // by index arithmetic; LowerBoundX() corrects a rounded index either way.
+  x_step_ = 0.0;
+  if (xs_.size() > 1) {
+    const double step = (xs_.back() - xs_.front()) /
+                        static_cast<double>(xs_.size() - 1);
+    bool even = true;
+    for (size_t i = 1; i < xs_.size() && even; ++i) {
+      even = std::fabs(xs_[i] - xs_[i - 1] - step) < 0.01 * step;
+    }
+    if (even) {
+      x_step_ = step;
+    }
   }
   return true;
 }
 
 double Interpolation2D::Interpolate(const KeyType &xy) const {
-  double max_x = xyz_.rbegin()->first;
-  double min_x = xyz_.begin()->first;
+  double max_x = xs_.back();
+  double min_x = xs_.front();
   if (xy.first >= max_x - kDoubleEpsilon) {
-    return InterpolateYz(xyz_.rbegin()->second, xy.second);
+    return InterpolateYz(xs_.size() - 1, xy.second);
   }
   if (xy.first <= min_x + kDoubleEpsilon) {
-    return InterpolateYz(xyz_.begin()->second, xy.second);
+    return InterpolateYz(0, xy.second);
   }
 
-  auto itr_after = xyz_.lower_bound(xy.first);
-  auto itr_before = itr_after;
-  if (itr_before != xyz_.begin()) {
-    --itr_before;
-  }
+  const size_t after = LowerBoundX(xy.first);
+  const size_t before = after > 0 ? after - 1 : after;
 
-  double x_before = itr_before->first;
-  double z_before = InterpolateYz(itr_before->second, xy.second);
-  double x_after = itr_after->first;
-  double z_after = InterpolateYz(itr_after->second, xy.second);
+  double x_before = xs_[before];
+  double z_before = InterpolateYz(before, xy.second);
+  double x_after = xs_[after];
+  double z_after = InterpolateYz(after, xy.second);
 
   double x_diff_before = std::fabs(xy.first - x_before);
   double x_diff_after = std::fabs(xy.first - x_after);
@@ -67,32 +96,52 @@ double Interpolation2D::Interpolate(const KeyType &xy) const {
   return InterpolateValue(z_before, x_diff_before, z_after, x_diff_after);
 }
 
-double Interpolation2D::InterpolateYz(const std::map<double, double> &yz_table,
-                                      double y) const {
-  if (yz_table.empty()) {
-    AERROR << "Unable to interpolateYz because yz_table is empty.";
-    return y;
+void Interpolation2D::Interpolate(const std::vector<KeyType> &xy,
+                                  std::vector<double> *z) const {
+  z->resize(xy.size());
+  for (size_t i = 0; i < xy.size(); ++i) {
+    (*z)[i] = Interpolate(xy[i]);
+  }
+}
+
+size_t Interpolation2D::LowerBoundX(const double x) const {
+  if (x_step_ <= 0.0) {
+    return static_cast<size_t>(std::lower_bound(xs_.begin(), xs_.end(), x) -
+                               xs_.begin());
   }
-  double max_y = yz_table.rbegin()->first;
-  double min_y = yz_table.begin()->first;
+  const double index = std::ceil((x - xs_.front()) / x_step_);
+  size_t i = std::min(static_cast<size_t>(std::max(index, 0.0)),
+                      xs_.size() - 1);
+  while (i > 0 && xs_[i - 1] >= x) {
+    --i;
+  }
+  while (i < xs_.size() && xs_[i] < x) {
+    ++i;
+  }
+  return i;
+}
+
+double Interpolation2D::InterpolateYz(const size_t row, const double y) const {
+  const auto begin = ys_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row]);
+  const auto end =
+      ys_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row + 1]);
+  double max_y = *(end - 1);
+  double min_y = *begin;
   if (y >= max_y - kDoubleEpsilon) {
-    return yz_table.rbegin()->second;
+    return zs_[row_begin_[row + 1] - 1];
   }
   if (y <= min_y + kDoubleEpsilon) {
-    return yz_table.begin()->second;
+    return zs_[row_begin_[row]];
   }
 
-  auto itr_after = yz_table.lower_bound(y);
-  auto itr_before = itr_after;
-
-  if (itr_before != yz_table.begin()) {
-    --itr_before;
-  }
+  const auto itr_after = std::lower_bound(begin, end, y);
+  const auto itr_before = itr_after - 1;
+  const auto after = static_cast<size_t>(itr_after - ys_.begin());
 
-  double y_before = itr_before->first;
-  double z_before = itr_before->second;
-  double y_after = itr_after->first;
-  double z_after = itr_after->second;
+  double y_before = *itr_before;
+  double z_before = zs_[after - 1];
+  double y_after = *itr_after;
+  double z_after = zs_[after];
 
   double y_diff_before = std::fabs(y - y_before);
   double y_diff_after = std::fabs(y - y_after);
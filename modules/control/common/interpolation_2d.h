@@ -20,7 +20,7 @@
 
 #pragma once
 
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -36,6 +36,8 @@ namespace control {
  * @class Interpolation2D
  *
  * @brief linear interpolation from key (double, double) to one double value.
+ * The table is kept in flat arrays, rows of x indexed by arithmetic when their
+ * keys are evenly spaced, so a lookup walks no tree.
  */
 class Interpolation2D {
  public:
@@ -58,15 +60,32 @@ class Interpolation2D {
    */
   double Interpolate(const KeyType &xy) const;
 
+  /**
+   * @brief linear interpolate a batch of keys, e.g. along a horizon.
+   * @param xy keys to interpolate
+   * @param z output values, one per key
+   */
+  void Interpolate(const std::vector<KeyType> &xy,
+                   std::vector<double> *z) const;
+
  private:
-  double InterpolateYz(const std::map<double, double> &yz_table,
-                       double y) const;
+  // Index of the first x key not less than x.
+  size_t LowerBoundX(const double x) const;
+
+  double InterpolateYz(const size_t row, const double y) const;
 
   double InterpolateValue(const double value_before, const double dist_before,
                           const double value_after,
                           const double dist_after) const;
 
-  std::map<double, std::map<double, double>> xyz_;
+  // Sorted distinct x keys, and for row i the sorted y keys and their values
+  // in [row_begin_[i], row_begin_[i + 1]) of ys_ and zs_.
+  std::vector<double> xs_;
+  std::vector<size_t> row_begin_;
+  std::vector<double> ys_;
+  std::vector<double> zs_;
+  // Spacing of xs_ if it is even, 0 otherwise.
+  double x_step_ = 0.0;
 };
 
 }  // namespace control
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
@@ -70,6 +71,30 @@ TEST_F(Interpolation2DTest, normal) {
   EXPECT_DOUBLE_EQ(30.5, estimator.Interpolate(std::make_pair(40, 40)));
 }
 
+TEST_F(Interpolation2DTest, batch) {
+  // Evenly spaced x, with rows of different y keys.
+  Interpolation2D::DataType xyz{
+      std::make_tuple(0.0, -1.0, -10.0), std::make_tuple(0.0, 1.0, 10.0),
+      std::make_tuple(1.0, -2.0, -30.0), std::make_tuple(1.0, 0.0, 0.0),
+      std::make_tuple(1.0, 2.0, 30.0),   std::make_tuple(2.0, 0.5, 5.0)};
+  Interpolation2D estimator;
+  EXPECT_TRUE(estimator.Init(xyz));
+
+  const std::vector<Interpolation2D::KeyType> xy{
+      {0.5, 0.5}, {1.0, -1.0}, {1.5, 1.0}, {2.0, -3.0}, {-1.0, 0.0}};
+  std::vector<double> z;
+  estimator.Interpolate(xy, &z);
+  ASSERT_EQ(xy.size(), z.size());
+  EXPECT_DOUBLE_EQ(6.25, z[0]);
+  EXPECT_DOUBLE_EQ(-15.0, z[1]);
+  EXPECT_DOUBLE_EQ(10.0, z[2]);
+  EXPECT_DOUBLE_EQ(5.0, z[3]);
+  EXPECT_DOUBLE_EQ(0.0, z[4]);
+  for (size_t i = 0; i < xy.size(); ++i) {
+    EXPECT_DOUBLE_EQ(estimator.Interpolate(xy[i]), z[i]);
+  }
+}
+
 TEST_F(Interpolation2DTest, calibration_table) {
   const auto &calibration_table =
       control_conf_.lon_controller_conf().calibration_table();
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/control/common/lqr_gain_schedule.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace control {
+
+bool LqrGainSchedule::Init(const LqrGainTableConf &conf,
+                           const GainFunction &compute_gain) {
+  gains_.clear();
+  grid_size_ = 0;
+  if (!(conf.speed_resolution() > 0.0) ||
+      !(conf.max_speed() >= conf.min_speed() + conf.speed_resolution())) {
+    AERROR << "Invalid lqr gain table speeds: " << conf.ShortDebugString();
+    return false;
+  }
+  min_speed_ = conf.min_speed();
+  speed_resolution_ = conf.speed_resolution();
+  // the small offset keeps max_speed in the grid despite rounding
+  const int grid_size =
+      static_cast<int>(std::floor(
+          (conf.max_speed() - conf.min_speed()) / speed_resolution_ + 1e-6)) +
+      1;
+
+  Eigen::MatrixXd gain;
+  for (int i = 0; i < grid_size; ++i) {
+    compute_gain(speed(i), &gain);
+    if (i == 0) {
+      gain_rows_ = static_cast<int>(gain.rows());
+      gain_cols_ = static_cast<int>(gain.cols());
+      gains_.reserve(static_cast<size_t>(grid_size) * gain.size());
+    }
+    gains_.insert(gains_.end(), gain.data(), gain.data() + gain.size());
+  }
+  grid_size_ = grid_size;
+  return true;
+}
+
+bool LqrGainSchedule::Init(const LqrGainTable &table) {
+  gains_.clear();
+  grid_size_ = 0;
+  const int gain_size = table.gain_rows() * table.gain_cols();
+  if (!(table.speed_resolution() > 0.0) || gain_size <= 0 ||
+      table.gain_size() % gain_size != 0 ||
+      table.gain_size() / gain_size < 2) {
+    AERROR << "Incomplete lqr gain table with " << table.gain_size()
+           << " values of " << table.gain_rows() << "x" << table.gain_cols()
+           << " gains";
+    return false;
+  }
+  min_speed_ = table.min_speed();
+  speed_resolution_ = table.speed_resolution();
+  gain_rows_ = table.gain_rows();
+  gain_cols_ = table.gain_cols();
+  gains_.assign(table.gain().begin(), table.gain().end());
+  grid_size_ = table.gain_size() / gain_size;
+  return true;
+}
+
+void LqrGainSchedule::ToProto(LqrGainTable *table) const {
+  table->Clear();
+  table->set_min_speed(min_speed_);
+  table->set_speed_resolution(speed_resolution_);
+  table->set_gain_rows(gain_rows_);
+  table->set_gain_cols(gain_cols_);
+  table->mutable_gain()->Reserve(static_cast<int>(gains_.size()));
+  for (const double value : gains_) {
+    table->add_gain(value);
+  }
+}
+
+bool LqrGainSchedule::Interpolate(const double speed,
+                                  Eigen::MatrixXd *gain) const {
+  if (grid_size_ < 2) {
+    return false;
+  }
+  const double position = (speed - min_speed_) / speed_resolution_;
+  // also false for nan
+  if (!(position >= 0.0 && position <= grid_size_ - 1)) {
+    return false;
+  }
+  const int index = std::min(static_cast<int>(position), grid_size_ - 2);
+  const double ratio = position - index;
+  const int gain_size = gain_rows_ * gain_cols_;
+  const double *lower = gains_.data() + index * gain_size;
+  const double *upper = lower + gain_size;
+  gain->resize(gain_rows_, gain_cols_);
+  double *data = gain->data();
+  for (int i = 0; i < gain_size; ++i) {
+    data[i] = lower[i] + ratio * (upper[i] - lower[i]);
+  }
+  return true;
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file lqr_gain_schedule.h
+ * @brief Defines the LqrGainSchedule class.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/control/proto/lqr_gain_table.pb.h"
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class LqrGainSchedule
+ * @brief Lqr gains precomputed on an evenly spaced grid of speeds. A gain
+ * between two grid speeds is interpolated linearly, which makes the lookup
+ * constant time, unlike an iterative solve of the riccati equation.
+ */
+class LqrGainSchedule {
+ public:
+  using GainFunction = std::function<void(const double, Eigen::MatrixXd *)>;
+
+  /**
+   * @brief compute the gains of the grid
+   * @param conf range and resolution of the grid
+   * @param compute_gain computes the gain for a speed
+   * @return true if the grid has at least two speeds
+   */
+  bool Init(const LqrGainTableConf &conf, const GainFunction &compute_gain);
+
+  /**
+   * @brief load the gains computed before
+   * @param table gain table of ToProto()
+   * @return true if the table is complete
+   */
+  bool Init(const LqrGainTable &table);
+
+  /**
+   * @brief write the gains to a table that Init() can load
+   * @param table gain table (pointer)
+   */
+  void ToProto(LqrGainTable *table) const;
+
+  /**
+   * @brief interpolate the gain of a speed
+   * @param speed the speed to look up
+   * @param gain the interpolated gain (pointer)
+   * @return false if the speed is out of the grid or there is no grid
+   */
+  bool Interpolate(const double speed, Eigen::MatrixXd *gain) const;
+
+  /**
+   * @brief number of speeds in the grid
+   */
+  int size() const { return grid_size_; }
+
+  /**
+   * @brief the speed of the gain at an index of the grid
+   */
+  double speed(const int index) const {
+    return min_speed_ + index * speed_resolution_;
+  }
+
+ private:
+  double min_speed_ = 0.0;
+  double speed_resolution_ = 0.0;
+  int grid_size_ = 0;
+  int gain_rows_ = 0;
+  int gain_cols_ = 0;
+  // column major gains, one after the other
+  std::vector<double> gains_;
+};
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/control/common/lqr_gain_schedule.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+namespace {
+
+void ComputeGain(const double speed, Eigen::MatrixXd *gain) {
+  gain->resize(1, 3);
+  (*gain)(0, 0) = speed;
+  (*gain)(0, 1) = -2.0 * speed;
+  (*gain)(0, 2) = 1.0;
+}
+
+LqrGainTableConf GridConf() {
+  LqrGainTableConf conf;
+  conf.set_min_speed(1.0);
+  conf.set_max_speed(3.0);
+  conf.set_speed_resolution(0.5);
+  return conf;
+}
+
+}  // namespace
+
+TEST(LqrGainScheduleTest, Interpolate) {
+  LqrGainSchedule schedule;
+  Eigen::MatrixXd gain;
+  EXPECT_FALSE(schedule.Interpolate(1.0, &gain));
+
+  EXPECT_TRUE(schedule.Init(GridConf(), ComputeGain));
+  EXPECT_EQ(5, schedule.size());
+  EXPECT_DOUBLE_EQ(3.0, schedule.speed(4));
+
+  EXPECT_TRUE(schedule.Interpolate(1.0, &gain));
+  EXPECT_EQ(1, gain.rows());
+  EXPECT_EQ(3, gain.cols());
+  EXPECT_DOUBLE_EQ(1.0, gain(0, 0));
+  EXPECT_TRUE(schedule.Interpolate(2.2, &gain));
+  EXPECT_DOUBLE_EQ(2.2, gain(0, 0));
+  EXPECT_DOUBLE_EQ(-4.4, gain(0, 1));
+  EXPECT_DOUBLE_EQ(1.0, gain(0, 2));
+  EXPECT_TRUE(schedule.Interpolate(3.0, &gain));
+  EXPECT_DOUBLE_EQ(3.0, gain(0, 0));
+
+  // out of the grid
+  EXPECT_FALSE(schedule.Interpolate(0.9, &gain));
+  EXPECT_FALSE(schedule.Interpolate(3.1, &gain));
+  EXPECT_FALSE(schedule.Interpolate(std::nan(""), &gain));
+}
+
+TEST(LqrGainScheduleTest, Proto) {
+  LqrGainSchedule schedule;
+  EXPECT_TRUE(schedule.Init(GridConf(), ComputeGain));
+  LqrGainTable table;
+  schedule.ToProto(&table);
+  EXPECT_EQ(15, table.gain_size());
+
+  LqrGainSchedule loaded;
+  EXPECT_TRUE(loaded.Init(table));
+  EXPECT_EQ(schedule.size(), loaded.size());
+  Eigen::MatrixXd gain;
+  EXPECT_TRUE(loaded.Interpolate(1.75, &gain));
+  EXPECT_DOUBLE_EQ(-3.5, gain(0, 1));
+
+  table.mutable_gain()->RemoveLast();
+  EXPECT_FALSE(loaded.Init(table));
+  EXPECT_FALSE(loaded.Interpolate(1.75, &gain));
+
+  LqrGainTableConf conf = GridConf();
+  conf.set_speed_resolution(0.0);
+  EXPECT_FALSE(schedule.Init(conf, ComputeGain));
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -41,6 +41,9 @@ double PointDistanceSquare(const TrajectoryPoint &point, const double x,
   return dx * dx + dy * dy;
 }
 
+// Points in a leaf of the matching tree, compared one by one.
+constexpr size_t kMatchingLeafSize = 8;
+
 PathPoint TrajectoryPointToPathPoint(const TrajectoryPoint &point) {
   if (point.has_path_point()) {
     return point.path_point();
@@ -56,28 +59,118 @@ TrajectoryAnalyzer::TrajectoryAnalyzer(
   header_time_ = planning_published_trajectory->header().timestamp_sec();
   seq_num_ = planning_published_trajectory->header().sequence_num();
 
-  for (int i = 0; i < planning_published_trajectory->trajectory_point_size();
-       ++i) {
-    trajectory_points_.push_back(
-        planning_published_trajectory->trajectory_point(i));
+  trajectory_points_.assign(
+      planning_published_trajectory->trajectory_point().begin(),
+      planning_published_trajectory->trajectory_point().end());
+
+  if (!trajectory_points_.empty()) {
+    // leaves hold more than kMatchingLeafSize / 2 points
+    matching_nodes_.reserve(
+        4 * trajectory_points_.size() / kMatchingLeafSize + 1);
+    BuildMatchingTree(0, trajectory_points_.size());
   }
 }
 
-PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
-                                                    const double y) const {
+bool TrajectoryAnalyzer::IsBuiltFrom(
+    const planning::ADCTrajectory &planning_published_trajectory) const {
+  const auto &header = planning_published_trajectory.header();
+  return !trajectory_points_.empty() &&
+         seq_num_ == header.sequence_num() &&
+         header_time_ == header.timestamp_sec() &&
+         static_cast<int>(trajectory_points_.size()) ==
+             planning_published_trajectory.trajectory_point_size();
+}
+
+size_t TrajectoryAnalyzer::BuildMatchingTree(const size_t begin,
+                                             const size_t end) {
+  const size_t node = matching_nodes_.size();
+  matching_nodes_.emplace_back();
+  if (end - begin <= kMatchingLeafSize) {
+    MatchingNode &leaf = matching_nodes_[node];
+    leaf.begin = begin;
+    leaf.end = end;
+    leaf.min_x = leaf.max_x = trajectory_points_[begin].path_point().x();
+    leaf.min_y = leaf.max_y = trajectory_points_[begin].path_point().y();
+    for (size_t i = begin + 1; i < end; ++i) {
+      const auto &path_point = trajectory_points_[i].path_point();
+      leaf.min_x = std::min(leaf.min_x, path_point.x());
+      leaf.max_x = std::max(leaf.max_x, path_point.x());
+      leaf.min_y = std::min(leaf.min_y, path_point.y());
+      leaf.max_y = std::max(leaf.max_y, path_point.y());
+    }
+    return node;
+  }
+
+  const size_t middle = begin + (end - begin) / 2;
+  const size_t left = BuildMatchingTree(begin, middle);
+  const size_t right = BuildMatchingTree(middle, end);
+  MatchingNode &parent = matching_nodes_[node];
+  const MatchingNode &first = matching_nodes_[left];
+  const MatchingNode &second = matching_nodes_[right];
+  parent.begin = begin;
+  parent.end = end;
+  parent.right = right;
+  parent.min_x = std::min(first.min_x, second.min_x);
+  parent.max_x = std::max(first.max_x, second.max_x);
+  parent.min_y = std::min(first.min_y, second.min_y);
+  parent.max_y = std::max(first.max_y, second.max_y);
+  return node;
+}
+
+size_t TrajectoryAnalyzer::QueryNearestIndexByPosition(const double x,
+                                                       const double y) const {
   CHECK_GT(trajectory_points_.size(), 0);
 
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
+  size_t index_min = std::min(last_matched_index_,
+                              trajectory_points_.size() - 1);
+  double d_min = PointDistanceSquare(trajectory_points_[index_min], x, y);
+  SearchNearestIndex(0, x, y, &index_min, &d_min);
+  last_matched_index_ = index_min;
+  return index_min;
+}
 
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
+void TrajectoryAnalyzer::SearchNearestIndex(const size_t node, const double x,
+                                            const double y, size_t *index_min,
+                                            double *d_min) const {
+  const MatchingNode &matching_node = matching_nodes_[node];
+  if (matching_node.end - matching_node.begin <= kMatchingLeafSize) {
+    for (size_t i = matching_node.begin; i < matching_node.end; ++i) {
+      const double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
+      // the first of equally close points, as a scan from the front finds
+      if (d_temp < *d_min || (d_temp == *d_min && i < *index_min)) {
+        *d_min = d_temp;
+        *index_min = i;
+      }
     }
+    return;
   }
 
+  const auto box_distance_square = [x, y](const MatchingNode &box) {
+    const double dx = std::max({box.min_x - x, 0.0, x - box.max_x});
+    const double dy = std::max({box.min_y - y, 0.0, y - box.max_y});
+    return dx * dx + dy * dy;
+  };
+  size_t first = node + 1;
+  size_t second = matching_node.right;
+  double d_first = box_distance_square(matching_nodes_[first]);
+  double d_second = box_distance_square(matching_nodes_[second]);
+  if (d_second < d_first) {
+    std::swap(first, second);
+    std::swap(d_first, d_second);
+  }
+  // boxes as close as the best point may still hold an earlier equal point
+  if (d_first <= *d_min) {
+    SearchNearestIndex(first, x, y, index_min, d_min);
+  }
+  if (d_second <= *d_min) {
+    SearchNearestIndex(second, x, y, index_min, d_min);
+  }
+}
+
+PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
+                                                    const double y) const {
+  const size_t index_min = QueryNearestIndexByPosition(x, y);
+
   size_t index_start = index_min == 0 ? index_min : index_min - 1;
   size_t index_end =
       index_min + 1 == trajectory_points_.size() ? index_min : index_min + 1;
@@ -177,19 +270,7 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
 
 TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
-  CHECK_GT(trajectory_points_.size(), 0);
-
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
-  return trajectory_points_[index_min];
+  return trajectory_points_[QueryNearestIndexByPosition(x, y)];
 }
 
 const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
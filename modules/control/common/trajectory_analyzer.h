@@ -65,6 +65,16 @@ class TrajectoryAnalyzer {
    */
   unsigned int seq_num() { return seq_num_; }
 
+  /**
+   * @brief whether the analyzer holds the given trajectory, so that it and
+   * its matching tree can be kept for the next control cycle
+   * @param planning_published_trajectory trajectory data generated by
+   * planning module
+   * @return true if sequence number and header time are the same
+   */
+  bool IsBuiltFrom(
+      const planning::ADCTrajectory &planning_published_trajectory) const;
+
   /**
    * @brief query a point of trajectery that its absolute time is closest
    * to the give time.
@@ -83,7 +93,8 @@ class TrajectoryAnalyzer {
 
   /**
    * @brief query a point of trajectery that its position is closest
-   * to the given position.
+   * to the given position. Of points at the same distance the first one is
+   * returned.
    * @param x value of x-coordination in the given position
    * @param y value of y-coordination in the given position
    * @return a point of trajectory
@@ -91,6 +102,15 @@ class TrajectoryAnalyzer {
   common::TrajectoryPoint QueryNearestPointByPosition(const double x,
                                                       const double y) const;
 
+  /**
+   * @brief query the index of the trajectory point that its position is
+   * closest to the given position, the point of QueryNearestPointByPosition.
+   * @param x value of x-coordination in the given position
+   * @param y value of y-coordination in the given position
+   * @return index of a point of trajectory
+   */
+  size_t QueryNearestIndexByPosition(const double x, const double y) const;
+
   /**
    * @brief query a point on trajectery that its position is closest
    * to the given position.
@@ -130,8 +150,31 @@ class TrajectoryAnalyzer {
                                          const common::TrajectoryPoint &p1,
                                          const double x, const double y) const;
 
+  // bounding box of the points [begin, end) in a node of the matching tree;
+  // the first child of a node follows it, the second one is at right
+  struct MatchingNode {
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    size_t begin = 0;
+    size_t end = 0;
+    size_t right = 0;
+  };
+
+  size_t BuildMatchingTree(const size_t begin, const size_t end);
+
+  void SearchNearestIndex(const size_t node, const double x, const double y,
+                          size_t *index_min, double *d_min) const;
+
   std::vector<common::TrajectoryPoint> trajectory_points_;
 
+  std::vector<MatchingNode> matching_nodes_;
+
+  // the vehicle moves along the trajectory, so the point matched last bounds
+  // the distance of the next match tightly from the start
+  mutable size_t last_matched_index_ = 0;
+
   double header_time_ = 0.0;
   unsigned int seq_num_ = 0;
 };
@@ -16,6 +16,10 @@
 
 #include "modules/control/common/trajectory_analyzer.h"
 
+#include <cmath>
+#include <limits>
+#include <random>
+
 #include "cyber/common/log.h"
 #include "gtest/gtest.h"
 #include "modules/common/time/time.h"
@@ -168,5 +172,54 @@ TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByAbsoluteTimeInterpolation) {
   EXPECT_NEAR(point_6.path_point().x(), 1.0, 1e-6);
 }
 
+TEST_F(TrajectoryAnalyzerTest, QueryNearestIndexByPosition) {
+  // a loop that comes back to its start, then stops there for a while
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 400; ++i) {
+    const double angle = i * 2.0 * M_PI / 300.0;
+    xs.push_back(20.0 * std::sin(angle));
+    ys.push_back(20.0 - 20.0 * std::cos(angle));
+  }
+  for (int i = 0; i < 50; ++i) {
+    xs.push_back(xs.back());
+    ys.push_back(ys.back());
+  }
+  SetTrajectory(xs, ys, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+  EXPECT_TRUE(trajectory_analyzer.IsBuiltFrom(adc_trajectory));
+
+  // the first of the closest points, as a scan from the front
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> coordinate(-30.0, 50.0);
+  for (int i = 0; i < 1000; ++i) {
+    const double x = coordinate(generator);
+    const double y = coordinate(generator);
+    size_t expected_index = 0;
+    double d_min = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < xs.size(); ++j) {
+      const double d = (xs[j] - x) * (xs[j] - x) + (ys[j] - y) * (ys[j] - y);
+      if (d < d_min) {
+        d_min = d;
+        expected_index = j;
+      }
+    }
+    EXPECT_EQ(expected_index,
+              trajectory_analyzer.QueryNearestIndexByPosition(x, y));
+  }
+
+  // the stop, matched after the last query was near the loop start
+  trajectory_analyzer.QueryNearestIndexByPosition(0.0, 0.0);
+  EXPECT_EQ(399, trajectory_analyzer.QueryNearestIndexByPosition(
+                     xs.back(), ys.back()));
+  TrajectoryPoint point =
+      trajectory_analyzer.QueryNearestPointByPosition(xs[10], ys[10] + 0.01);
+  EXPECT_DOUBLE_EQ(xs[10], point.path_point().x());
+
+  adc_trajectory.mutable_header()->set_sequence_num(124);
+  EXPECT_FALSE(trajectory_analyzer.IsBuiltFrom(adc_trajectory));
+}
+
 }  // namespace control
 }  // namespace apollo
@@ -19,6 +19,7 @@
 #include "cyber/common/log.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/time/time.h"
+#include "modules/common/util/trace_util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/control/common/control_gflags.h"
 
@@ -322,7 +323,8 @@ bool ControlComponent::Proc() {
     control_command.mutable_header()->mutable_status()->set_msg(estop_reason_);
   }
 
-  // set header
+  // set header, tracing the command back to the sensor frame of the trajectory
+  common::util::TraceScope trace_scope(local_view_.trajectory.header());
   control_command.mutable_header()->set_lidar_timestamp(
       local_view_.trajectory.header().lidar_timestamp());
   control_command.mutable_header()->set_camera_timestamp(
@@ -23,6 +23,7 @@
 
 #include "Eigen/LU"
 
+#include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/linear_quadratic_regulator.h"
@@ -241,9 +242,66 @@ Status LatController::Init(const ControlConf *control_conf) {
     leadlag_controller_.Init(lat_controller_conf.reverse_leadlag_conf(), ts_);
   }
 
+  if (lat_controller_conf.has_gain_table_conf()) {
+    LoadGainTables(lat_controller_conf.gain_table_conf());
+  }
+
   return Status::OK();
 }
 
+void LatController::LoadGainTables(const LqrGainTableConf &gain_table_conf) {
+  const std::string &file = gain_table_conf.file();
+  LatGainTables tables;
+  if (!file.empty() && cyber::common::PathExists(file) &&
+      cyber::common::GetProtoFromFile(file, &tables) &&
+      forward_gain_schedule_.Init(tables.forward()) &&
+      reverse_gain_schedule_.Init(tables.reverse())) {
+    // a table of another conf gives other gains on its grid
+    const auto matches = [this](const bool reverse,
+                                const LqrGainSchedule &gain_schedule) {
+      const double speed = gain_schedule.speed(gain_schedule.size() / 2);
+      Matrix gain;
+      Matrix table_gain;
+      ComputeGain(reverse, speed, &gain);
+      return gain_schedule.Interpolate(speed, &table_gain) &&
+             table_gain.rows() == gain.rows() &&
+             table_gain.cols() == gain.cols() &&
+             table_gain.isApprox(gain, 1e-6);
+    };
+    if (matches(false, forward_gain_schedule_) &&
+        matches(true, reverse_gain_schedule_)) {
+      AINFO << "Lateral control gain tables loaded from " << file;
+      return;
+    }
+    AWARN << "Lateral control gain tables in " << file
+          << " do not match the conf, compute them again";
+  }
+
+  const double start_timestamp = Clock::NowInSeconds();
+  if (!forward_gain_schedule_.Init(
+          gain_table_conf, [this](const double speed, Matrix *gain) {
+            ComputeGain(false, speed, gain);
+          }) ||
+      !reverse_gain_schedule_.Init(
+          gain_table_conf, [this](const double speed, Matrix *gain) {
+            ComputeGain(true, speed, gain);
+          })) {
+    AERROR << "Failed to compute the lateral control gain tables";
+    return;
+  }
+  AINFO << "Lateral control gain tables of " << forward_gain_schedule_.size()
+        << " speeds computed in "
+        << (Clock::NowInSeconds() - start_timestamp) * 1000 << " ms";
+
+  if (!file.empty()) {
+    forward_gain_schedule_.ToProto(tables.mutable_forward());
+    reverse_gain_schedule_.ToProto(tables.mutable_reverse());
+    if (!cyber::common::SetProtoToBinaryFile(tables, file)) {
+      AWARN << "Failed to write the lateral control gain tables to " << file;
+    }
+  }
+}
+
 void LatController::CloseLogFile() {
   if (FLAGS_enable_csv_debug && steer_log_file_.is_open()) {
     steer_log_file_.close();
@@ -285,10 +343,10 @@ Status LatController::ComputeControlCommand(
     ControlCommand *cmd) {
   auto vehicle_state = VehicleStateProvider::Instance();
 
-  auto target_tracking_trajectory = *planning_published_trajectory;
-
   if (FLAGS_use_navigation_mode &&
       FLAGS_enable_navigation_mode_position_update) {
+    auto target_tracking_trajectory = *planning_published_trajectory;
+
     auto time_stamp_diff =
         planning_published_trajectory->header().timestamp_sec() -
         current_trajectory_timestamp_;
@@ -350,11 +408,15 @@ Status LatController::ComputeControlCommand(
             p.mutable_path_point()->set_theta(theta_new);
           });
     }
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+  } else if (!trajectory_analyzer_.IsBuiltFrom(
+                 *planning_published_trajectory)) {
+    // the matching tree is built once per trajectory
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(planning_published_trajectory));
   }
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
-
   UpdateDrivingOrientation();
 
   SimpleLateralDebug *debug = cmd->mutable_debug()->mutable_simple_lat_debug();
@@ -364,42 +426,12 @@ Status LatController::ComputeControlCommand(
   // Error Rate, preview lateral error1 , preview lateral error2, ...]
   UpdateState(debug);
 
-  UpdateMatrix();
-
-  // Compound discrete matrix with road preview model
-  UpdateMatrixCompound();
-
-  // Adjust matrix_q_updated when in reverse gear
-  int q_param_size = control_conf_->lat_controller_conf().matrix_q_size();
-  int reverse_q_param_size =
-      control_conf_->lat_controller_conf().reverse_matrix_q_size();
-  if (VehicleStateProvider::Instance()->gear() ==
-      canbus::Chassis::GEAR_REVERSE) {
-    for (int i = 0; i < reverse_q_param_size; ++i) {
-      matrix_q_(i, i) =
-          control_conf_->lat_controller_conf().reverse_matrix_q(i);
-    }
-  } else {
-    for (int i = 0; i < q_param_size; ++i) {
-      matrix_q_(i, i) = control_conf_->lat_controller_conf().matrix_q(i);
-    }
-  }
-
-  // Add gain scheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) *
-        lat_err_interpolation_->Interpolate(vehicle_state->linear_velocity());
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(
-                              vehicle_state->linear_velocity());
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
-  } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+  const bool reverse = vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE;
+  const LqrGainSchedule &gain_schedule =
+      reverse ? reverse_gain_schedule_ : forward_gain_schedule_;
+  if (!gain_schedule.Interpolate(vehicle_state->linear_velocity(),
+                                 &matrix_k_)) {
+    ComputeGain(reverse, vehicle_state->linear_velocity(), &matrix_k_);
   }
 
   // feedback = - K * state
@@ -534,9 +566,8 @@ void LatController::UpdateState(SimpleLateralDebug *debug) {
   }
 }
 
-void LatController::UpdateMatrix() {
-  const double v = std::max(VehicleStateProvider::Instance()->linear_velocity(),
-                            minimum_speed_protection_);
+void LatController::UpdateMatrix(const double linear_velocity) {
+  const double v = std::max(linear_velocity, minimum_speed_protection_);
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
   matrix_a_(1, 3) = matrix_a_coeff_(1, 3) / v;
   matrix_a_(3, 1) = matrix_a_coeff_(3, 1) / v;
@@ -559,6 +590,49 @@ void LatController::UpdateMatrixCompound() {
   }
 }
 
+void LatController::UpdateMatrixQ(const bool reverse,
+                                  const double linear_velocity) {
+  // Adjust matrix_q_updated when in reverse gear
+  const auto &lat_controller_conf = control_conf_->lat_controller_conf();
+  if (reverse) {
+    for (int i = 0; i < lat_controller_conf.reverse_matrix_q_size(); ++i) {
+      matrix_q_(i, i) = lat_controller_conf.reverse_matrix_q(i);
+    }
+  } else {
+    for (int i = 0; i < lat_controller_conf.matrix_q_size(); ++i) {
+      matrix_q_(i, i) = lat_controller_conf.matrix_q(i);
+    }
+  }
+
+  // Add gain scheduler for higher speed steering
+  if (FLAGS_enable_gain_scheduler) {
+    matrix_q_updated_(0, 0) =
+        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(linear_velocity);
+    matrix_q_updated_(2, 2) =
+        matrix_q_(2, 2) *
+        heading_err_interpolation_->Interpolate(linear_velocity);
+  }
+}
+
+void LatController::ComputeGain(const bool reverse,
+                                const double linear_velocity, Matrix *gain) {
+  // same as UpdateDrivingOrientation
+  matrix_bd_ = matrix_b_ * ts_;
+  if (reverse && FLAGS_reverse_heading_control) {
+    matrix_bd_ = -matrix_b_ * ts_;
+  }
+  UpdateMatrix(linear_velocity);
+
+  // Compound discrete matrix with road preview model
+  UpdateMatrixCompound();
+
+  UpdateMatrixQ(reverse, linear_velocity);
+  common::math::SolveLQRProblem(
+      matrix_adc_, matrix_bdc_,
+      FLAGS_enable_gain_scheduler ? matrix_q_updated_ : matrix_q_, matrix_r_,
+      lqr_eps_, lqr_max_iteration_, gain);
+}
+
 double LatController::ComputeFeedForward(double ref_curvature) const {
   const double kv =
       lr_ * mass_ / 2 / cf_ / wheelbase_ - lf_ * mass_ / 2 / cr_ / wheelbase_;
@@ -34,6 +34,7 @@
 #include "modules/common/filters/mean_filter.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/leadlag_controller.h"
+#include "modules/control/common/lqr_gain_schedule.h"
 #include "modules/control/common/trajectory_analyzer.h"
 #include "modules/control/controller/controller.h"
 
@@ -107,10 +108,20 @@ class LatController : public Controller {
   // logic for reverse driving mode
   void UpdateDrivingOrientation();
 
-  void UpdateMatrix();
+  void UpdateMatrix(const double linear_velocity);
 
   void UpdateMatrixCompound();
 
+  // state weighting of the driving direction, scheduled over the speed
+  void UpdateMatrixQ(const bool reverse, const double linear_velocity);
+
+  // lqr gain of the driving direction and the speed, with the model and the
+  // weighting of a control cycle at that speed
+  void ComputeGain(const bool reverse, const double linear_velocity,
+                   Eigen::MatrixXd *gain);
+
+  void LoadGainTables(const LqrGainTableConf &gain_table_conf);
+
   double ComputeFeedForward(double ref_curvature) const;
 
   void ComputeLateralErrors(const double x, const double y, const double theta,
@@ -208,6 +219,10 @@ class LatController : public Controller {
   // Lead/Lag controller
   LeadlagController leadlag_controller_;
 
+  // precomputed lqr gains over the speed, per driving direction
+  LqrGainSchedule forward_gain_schedule_;
+  LqrGainSchedule reverse_gain_schedule_;
+
   // for logging purpose
   std::ofstream steer_log_file_;
 
@@ -166,8 +166,7 @@ Status LonController::ComputeControlCommand(
   }
 
   if (trajectory_analyzer_ == nullptr ||
-      trajectory_analyzer_->seq_num() !=
-          trajectory_message_->header().sequence_num()) {
+      !trajectory_analyzer_->IsBuiltFrom(*trajectory_message_)) {
     trajectory_analyzer_.reset(new TrajectoryAnalyzer(trajectory_message_));
   }
   const LonControllerConf &lon_controller_conf =
@@ -106,6 +106,8 @@ bool MPCController::LoadControlConf(const ControlConf *control_conf) {
 
   mpc_eps_ = control_conf->mpc_controller_conf().eps();
   mpc_max_iteration_ = control_conf->mpc_controller_conf().max_iteration();
+  horizon_ = control_conf->mpc_controller_conf().prediction_horizon();
+  use_osqp_solver_ = control_conf->mpc_controller_conf().use_osqp_solver();
   throttle_deadzone_ = control_conf->mpc_controller_conf().throttle_deadzone();
   brake_deadzone_ = control_conf->mpc_controller_conf().brake_deadzone();
 
@@ -284,8 +286,11 @@ Status MPCController::ComputeControlCommand(
     const canbus::Chassis *chassis,
     const planning::ADCTrajectory *planning_published_trajectory,
     ControlCommand *cmd) {
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  if (!trajectory_analyzer_.IsBuiltFrom(*planning_published_trajectory)) {
+    // the matching tree is built once per trajectory
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  }
 
   SimpleMPCDebug *debug = cmd->mutable_debug()->mutable_simple_mpc_debug();
   debug->Clear();
@@ -357,11 +362,19 @@ Status MPCController::ComputeControlCommand(
   double control_gain_truncation_ratio = 0.0;
   double unconstraint_control = 0.0;
   const double v = VehicleStateProvider::Instance()->linear_velocity();
-  if (common::math::SolveLinearMPC(
-          matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
-          matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
-          mpc_eps_, mpc_max_iteration_, &control, &control_gain, &addition_gain)
-           != true) {
+  const bool solved =
+      use_osqp_solver_
+          ? mpc_osqp_solver_.Solve(matrix_ad_, matrix_bd_, matrix_cd_,
+                                   matrix_q_updated_, matrix_r_updated_,
+                                   lower_bound, upper_bound, matrix_state_,
+                                   reference, mpc_eps_, mpc_max_iteration_,
+                                   &control, &control_gain, &addition_gain)
+          : common::math::SolveLinearMPC(
+                matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
+                matrix_r_updated_, lower_bound, upper_bound, matrix_state_,
+                reference, mpc_eps_, mpc_max_iteration_, &control,
+                &control_gain, &addition_gain);
+  if (!solved) {
     AERROR << "MPC solver failed";
   } else {
     ADEBUG << "MPC problem solved! ";
@@ -494,6 +507,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  mpc_osqp_solver_.CleanUp();
   return Status::OK();
 }
 
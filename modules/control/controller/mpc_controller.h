@@ -32,6 +32,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/mpc_osqp_solver.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/interpolation_2d.h"
 #include "modules/control/common/trajectory_analyzer.h"
@@ -173,7 +174,7 @@ class MPCController : public Controller {
 
   const int controls_ = 2;
 
-  const int horizon_ = 10;
+  int horizon_ = 10;
   // vehicle state matrix
   Eigen::MatrixXd matrix_a_;
   // vehicle state matrix (discrete-time)
@@ -213,6 +214,9 @@ class MPCController : public Controller {
   int mpc_max_iteration_ = 0;
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
+  // solve with mpc_osqp_solver_ instead of the condensed active set solver
+  bool use_osqp_solver_ = false;
+  common::math::MpcOsqpSolver mpc_osqp_solver_;
 
   common::DigitalFilter digital_filter_;
 
@@ -33,7 +33,7 @@ bool DataComponent::Init() {
     return true;
   }
 
-  if (!RecordService::Init(node_)) {
+  if (!RecordService::Init(node_, data_conf_.flight_recorder())) {
     AERROR << "Unable to initialize data recorder service";
     return false;
   }
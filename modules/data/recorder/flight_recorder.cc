@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/flight_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/record/record_writer.h"
+#include "cyber/service_discovery/topology_manager.h"
+
+namespace apollo {
+namespace data {
+
+namespace {
+
+using apollo::cyber::Time;
+using apollo::cyber::message::RawMessage;
+
+// how often the writer thread looks for events whose window has passed
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(100);
+
+uint64_t SecondsToNanoseconds(const double seconds) {
+  return static_cast<uint64_t>(std::max(seconds, 0.0) * 1e9);
+}
+
+}  // namespace
+
+FlightRecorder::FlightRecorder(const FlightRecorderConf &conf)
+    : conf_(conf),
+      pre_event_ns_(SecondsToNanoseconds(conf.pre_event_sec())),
+      post_event_ns_(SecondsToNanoseconds(conf.post_event_sec())) {
+  for (const auto &channel : conf_.channel()) {
+    channels_.emplace_back();
+    channels_.back().name = channel.name();
+    channels_.back().memory_limit =
+        static_cast<uint64_t>(channel.memory_limit_mb()) << 20;
+  }
+}
+
+FlightRecorder::~FlightRecorder() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  event_cv_.notify_all();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+}
+
+bool FlightRecorder::Init(const std::shared_ptr<cyber::Node> &node) {
+  if (!cyber::common::EnsureDirectory(conf_.record_dir())) {
+    AERROR << "Unable to create flight recorder dir " << conf_.record_dir();
+    return false;
+  }
+  for (size_t i = 0; i < channels_.size(); ++i) {
+    auto reader = node->CreateReader<RawMessage>(
+        channels_[i].name,
+        [this, i](const std::shared_ptr<RawMessage> &message) {
+          OnMessage(i, message);
+        });
+    if (reader == nullptr) {
+      AERROR << "Unable to create flight recorder reader of "
+             << channels_[i].name;
+      return false;
+    }
+    readers_.push_back(reader);
+  }
+
+  running_ = true;
+  writer_thread_ = std::thread(&FlightRecorder::WriteEvents, this);
+  AINFO << "Flight recorder buffers " << channels_.size() << " channels, "
+        << conf_.pre_event_sec() << "s before and " << conf_.post_event_sec()
+        << "s after an event";
+  return true;
+}
+
+void FlightRecorder::OnMessage(size_t channel_index,
+                               const std::shared_ptr<RawMessage> &message) {
+  const uint64_t now_ns = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &channel = channels_[channel_index];
+  channel.messages.push_back({now_ns, message});
+  channel.bytes += message->message.size();
+  while (!channel.messages.empty() &&
+         (channel.bytes > channel.memory_limit ||
+          channel.messages.front().time_ns + pre_event_ns_ < now_ns)) {
+    channel.bytes -= channel.messages.front().message->message.size();
+    channel.messages.pop_front();
+  }
+
+  if (!events_.empty() && now_ns <= events_.back().end_ns) {
+    events_.back().messages[channel_index].push_back({now_ns, message});
+  }
+}
+
+void FlightRecorder::Trigger() {
+  const uint64_t now_ns = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!events_.empty() && now_ns <= events_.back().end_ns) {
+    events_.back().end_ns = now_ns + post_event_ns_;
+    AINFO << "Flight recorder event extended";
+    return;
+  }
+
+  // the buffered messages are shared, not copied
+  Event event;
+  event.end_ns = now_ns + post_event_ns_;
+  for (const auto &channel : channels_) {
+    event.messages.emplace_back(channel.messages.begin(),
+                                channel.messages.end());
+  }
+  events_.push_back(std::move(event));
+  AINFO << "Flight recorder event triggered";
+}
+
+uint64_t FlightRecorder::BufferedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t bytes = 0;
+  for (const auto &channel : channels_) {
+    bytes += channel.bytes;
+  }
+  return bytes;
+}
+
+void FlightRecorder::WriteEvents() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // on shutdown, the events still open are written with what they have
+  while (running_ || !events_.empty()) {
+    const uint64_t now_ns = Time::Now().ToNanosecond();
+    if (events_.empty() ||
+        (running_ && now_ns <= events_.front().end_ns)) {
+      event_cv_.wait_for(lock, kWriterPollInterval);
+      continue;
+    }
+    Event event = std::move(events_.front());
+    events_.pop_front();
+    lock.unlock();
+    WriteEvent(event);
+    lock.lock();
+  }
+}
+
+void FlightRecorder::WriteEvent(const Event &event) const {
+  const uint64_t event_ns = event.end_ns - post_event_ns_;
+  const std::string file = conf_.record_dir() + "/" +
+                           std::to_string(event_ns / 1000000000) + ".record";
+  cyber::record::RecordWriter writer;
+  if (!writer.Open(file)) {
+    AERROR << "Unable to open flight recorder file " << file;
+    return;
+  }
+
+  // the buffers of each channel are in time order, write them all merged
+  struct Entry {
+    uint64_t time_ns;
+    size_t channel_index;
+    const RawMessage *message;
+  };
+  std::vector<Entry> entries;
+  auto channel_manager =
+      cyber::service_discovery::TopologyManager::Instance()->channel_manager();
+  for (size_t i = 0; i < event.messages.size(); ++i) {
+    if (event.messages[i].empty()) {
+      continue;
+    }
+    std::vector<cyber::proto::RoleAttributes> writers;
+    channel_manager->GetWritersOfChannel(channels_[i].name, &writers);
+    if (writers.empty()) {
+      AWARN << "No writer of " << channels_[i].name << " to take its type from";
+    } else {
+      writer.WriteChannel(channels_[i].name, writers.front().message_type(),
+                          writers.front().proto_desc());
+    }
+    for (const auto &stamped : event.messages[i]) {
+      entries.push_back({stamped.time_ns, i, stamped.message.get()});
+    }
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry &lhs, const Entry &rhs) {
+                     return lhs.time_ns < rhs.time_ns;
+                   });
+
+  uint64_t bytes = 0;
+  for (const auto &entry : entries) {
+    writer.WriteMessage(channels_[entry.channel_index].name,
+                        entry.message->message, entry.time_ns);
+    bytes += entry.message->message.size();
+  }
+  writer.Close();
+  AINFO << "Flight recorder wrote " << entries.size() << " messages, "
+        << bytes << " bytes to " << file;
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Defines the FlightRecorder class.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "modules/data/proto/data_conf.pb.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class FlightRecorder
+ * @brief Buffers the latest messages of the configured channels in memory.
+ *        A trigger writes the buffered pre-event window together with the
+ *        messages of the post-event window to a record file, on a
+ *        background thread.
+ */
+class FlightRecorder {
+ public:
+  explicit FlightRecorder(const FlightRecorderConf &conf);
+  ~FlightRecorder();
+
+  /**
+   * @brief Subscribe to the configured channels and start the writer thread.
+   * @param node The node to create the channel readers on.
+   * @return If all the channel readers are created.
+   */
+  bool Init(const std::shared_ptr<cyber::Node> &node);
+
+  /**
+   * @brief Save the window around now. A trigger within the post-event
+   *        window of a previous one extends that window instead.
+   */
+  void Trigger();
+
+  /**
+   * @brief Serialized bytes currently buffered over all the channels.
+   */
+  uint64_t BufferedBytes() const;
+
+ private:
+  struct StampedMessage {
+    uint64_t time_ns;
+    std::shared_ptr<cyber::message::RawMessage> message;
+  };
+
+  struct ChannelBuffer {
+    std::string name;
+    uint64_t memory_limit = 0;
+    uint64_t bytes = 0;
+    std::deque<StampedMessage> messages;
+  };
+
+  struct Event {
+    uint64_t end_ns = 0;
+    // messages to write, per channel in the order of channels_
+    std::vector<std::vector<StampedMessage>> messages;
+  };
+
+  void OnMessage(size_t channel_index,
+                 const std::shared_ptr<cyber::message::RawMessage> &message);
+  void WriteEvents();
+  void WriteEvent(const Event &event) const;
+
+  const FlightRecorderConf conf_;
+  const uint64_t pre_event_ns_;
+  const uint64_t post_event_ns_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable event_cv_;
+  std::vector<ChannelBuffer> channels_;
+  std::deque<Event> events_;
+  bool running_ = false;
+
+  std::vector<std::shared_ptr<cyber::Reader<cyber::message::RawMessage>>>
+      readers_;
+  std::thread writer_thread_;
+};
+
+}  // namespace data
+}  // namespace apollo
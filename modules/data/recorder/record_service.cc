@@ -25,9 +25,20 @@ namespace data {
 
 RecordService::RecordService() = default;
 
-bool RecordService::Init(const std::shared_ptr<apollo::cyber::Node> &node) {
+bool RecordService::Init(const std::shared_ptr<apollo::cyber::Node> &node,
+                         const FlightRecorderConf &flight_recorder_conf) {
   AINFO << "RecordService::Init(), starting...";
 
+  if (flight_recorder_conf.enabled()) {
+    Instance()->flight_recorder_.reset(
+        new FlightRecorder(flight_recorder_conf));
+    if (!Instance()->flight_recorder_->Init(node)) {
+      AERROR << "Unable to initialize flight recorder";
+      Instance()->flight_recorder_.reset();
+      return false;
+    }
+  }
+
   Instance()->server_ = node->CreateService<RecordRequest, RecordResponse>(
       FLAGS_data_record_service_name, RecordService::OnRecordRequest);
 
@@ -42,6 +53,17 @@ void RecordService::OnRecordRequest(
     const std::shared_ptr<RecordRequest> &request,
     const std::shared_ptr<RecordResponse> &response) {
   ADEBUG << "Received data record request: " << request->DebugString();
+  if (request->record_switch() == RecordRequest::TRIGGER) {
+    auto &flight_recorder = Instance()->flight_recorder_;
+    if (flight_recorder == nullptr) {
+      AERROR << "Flight recorder is not enabled";
+      response->set_record_result(RecordResponse::FAIL);
+      return;
+    }
+    flight_recorder->Trigger();
+    response->set_record_result(RecordResponse::PASS);
+    return;
+  }
   // TODO(michael): do recording
   response->set_record_result(RecordResponse::PASS);
 }
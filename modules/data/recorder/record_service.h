@@ -21,8 +21,10 @@
 #include "cyber/common/macros.h"
 #include "cyber/cyber.h"
 #include "cyber/service/service.h"
+#include "modules/data/proto/data_conf.pb.h"
 #include "modules/data/proto/record_request.pb.h"
 #include "modules/data/proto/record_response.pb.h"
+#include "modules/data/recorder/flight_recorder.h"
 
 /**
  * @namespace apollo::data
@@ -33,7 +35,8 @@ namespace data {
 
 class RecordService {
  public:
-  static bool Init(const std::shared_ptr<apollo::cyber::Node> &node);
+  static bool Init(const std::shared_ptr<apollo::cyber::Node> &node,
+                   const FlightRecorderConf &flight_recorder_conf);
 
  private:
   static void OnRecordRequest(const std::shared_ptr<RecordRequest> &request,
@@ -42,6 +45,7 @@ class RecordService {
  private:
   std::shared_ptr<apollo::cyber::Service<RecordRequest, RecordResponse>>
       server_;
+  std::unique_ptr<FlightRecorder> flight_recorder_;
   DECLARE_SINGLETON(RecordService)
 };
 
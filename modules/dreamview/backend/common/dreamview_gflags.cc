@@ -58,12 +58,21 @@ DEFINE_double(sim_map_radius, 200.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(sim_map_tile_size, 20.0,
+              "Size in meters of the map tiles whose surrounding elements are "
+              "cached. The elements are then found around the tile the car is "
+              "in, rather than the car itself. Non-positive to disable.");
+
 DEFINE_bool(enable_update_size_check, true,
             "True to check if the update byte number is less than threshold");
 
 DEFINE_uint32(max_update_size, 1000000,
               "Number of max update bytes allowed to push to dreamview FE");
 
+DEFINE_int32(sim_world_keyframe_interval, 10,
+             "Every how many SimulationWorld updates a keyframe is taken, "
+             "which clients asking for deltas receive the changes against.");
+
 DEFINE_bool(sim_world_with_routing_path, false,
             "Whether the routing_path is included in sim_world proto.");
 
@@ -76,6 +85,10 @@ DEFINE_double(voxel_filter_size, 0.3, "VoxelGrid pointcloud filter leaf size");
 DEFINE_double(voxel_filter_height, 0.2,
               "VoxelGrid pointcloud filter leaf height");
 
+DEFINE_double(point_cloud_resolution, 0.02,
+              "Resolution in meters of the int16 point coordinates sent to "
+              "the frontend, which reach +/-655 m at the default.");
+
 DEFINE_double(system_status_lifetime_seconds, 30,
               "Lifetime of a valid SystemStatus message. It's more like a "
               "replay message if the timestamp is old, where we should ignore "
@@ -38,12 +38,16 @@ DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(sim_map_tile_size);
+
 DECLARE_int32(dreamview_worker_num);
 
 DECLARE_bool(enable_update_size_check);
 
 DECLARE_uint32(max_update_size);
 
+DECLARE_int32(sim_world_keyframe_interval);
+
 DECLARE_bool(sim_world_with_routing_path);
 
 DECLARE_string(request_timeout_ms);
@@ -52,6 +56,8 @@ DECLARE_double(voxel_filter_size);
 
 DECLARE_double(voxel_filter_height);
 
+DECLARE_double(point_cloud_resolution);
+
 DECLARE_double(system_status_lifetime_seconds);
 
 DECLARE_string(lidar_height_yaml);
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/map_util.h"
@@ -23,13 +26,32 @@ limitations under the License.
 namespace apollo {
 namespace dreamview {
 
+using apollo::common::time::Clock;
 using apollo::common::util::ContainsKey;
 using apollo::common::util::StrCat;
 
+constexpr size_t WebSocketHandler::kMaxQueuedMessages;
+
+WebSocketHandler::~WebSocketHandler() {
+  std::unordered_map<Connection *, std::shared_ptr<ConnectionState>>
+      connections;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    connections.swap(connections_);
+  }
+  for (auto &kv : connections) {
+    CloseConnection(kv.second.get());
+  }
+}
+
 void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
+  auto state = std::make_shared<ConnectionState>();
+  state->ready_time = Clock::NowInSeconds();
+  state->sender =
+      std::thread(&WebSocketHandler::SendQueuedData, this, conn, state.get());
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connections_.emplace(conn, std::make_shared<std::mutex>());
+    connections_.emplace(conn, state);
   }
   AINFO << name_
         << ": Accepted connection. Total connections: " << connections_.size();
@@ -42,25 +64,42 @@ void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
 
 void WebSocketHandler::handleClose(CivetServer *server,
                                    const Connection *conn) {
-  // Remove from the store of currently open connections. Copy the mutex out
+  // Remove from the store of currently open connections. Copy the state out
   // so that it won't be reclaimed during map.erase().
   Connection *connection = const_cast<Connection *>(conn);
 
-  std::shared_ptr<std::mutex> connection_lock;
+  std::shared_ptr<ConnectionState> state;
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connection_lock = connections_[connection];
+    auto iter = connections_.find(connection);
+    if (iter == connections_.end()) {
+      return;
+    }
+    state = iter->second;
+    connections_.erase(iter);
   }
+  // Make sure there's no data being sent via the connection.
+  CloseConnection(state.get());
+
+  const ConnectionStats &stats = state->stats;
+  AINFO << name_ << ": Connection closed after sending " << stats.sent_messages
+        << " messages (" << stats.sent_bytes << " bytes, " << stats.bandwidth
+        << " bytes/s), dropping " << stats.dropped_messages
+        << " and coalescing " << stats.coalesced_messages
+        << ", with a max lag of " << stats.max_lag_sec
+        << " s. Total connections: " << connections_.size();
+}
 
+void WebSocketHandler::CloseConnection(ConnectionState *state) {
   {
-    // Make sure there's no data being sent via the connection
-    std::unique_lock<std::mutex> lock_connection(*connection_lock);
-    std::unique_lock<std::mutex> lock(mutex_);
-    connections_.erase(connection);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+  }
+  state->data_ready.notify_all();
+  state->space_ready.notify_all();
+  if (state->sender.joinable()) {
+    state->sender.join();
   }
-
-  AINFO << name_
-        << ": Connection closed. Total connections: " << connections_.size();
 }
 
 bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
@@ -93,7 +132,7 @@ bool WebSocketHandler::SendBinaryData(Connection *conn, const std::string &data,
 
 bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
                                 bool skippable, int op_code) {
-  std::shared_ptr<std::mutex> connection_lock;
+  std::shared_ptr<ConnectionState> state;
   {
     std::unique_lock<std::mutex> lock(mutex_);
     if (!ContainsKey(connections_, conn)) {
@@ -101,38 +140,95 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
              << ": Trying to send to an uncached connection, skipping.";
       return false;
     }
-    // Copy the lock so that it still exists if the connection is closed after
-    // this block.
-    connection_lock = connections_[conn];
+    // Copy the state so that it still exists if the connection is closed
+    // after this block.
+    state = connections_[conn];
   }
 
-  // Lock the connection while sending.
-  if (!connection_lock->try_lock()) {
-    // Skip sending data if:
-    // 1. Data is skippable according to sender and there's higher priority data
-    // being sent.
-    // 2. The connection has been closed.
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    auto &queue = state->queue;
+    if (!skippable) {
+      state->space_ready.wait(lock, [state, &queue] {
+        return state->closed || queue.size() < kMaxQueuedMessages;
+      });
+    }
+    if (state->closed) {
+      return false;
+    }
     if (skippable) {
-      AWARN << "Skip sending a droppable message!";
+      // Newer skippable data supersedes the queued one of the same op_code.
+      for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+        if (iter->skippable && iter->op_code == op_code) {
+          queue.erase(iter);
+          ++state->stats.coalesced_messages;
+          break;
+        }
+      }
+    }
+    if (queue.size() >= kMaxQueuedMessages) {
+      ++state->stats.dropped_messages;
+      AWARN_EVERY(100) << name_ << ": Dropping a message as "
+                       << queue.size() << " are queued for a slow client.";
       return false;
-    } else {
-      connection_lock->lock();  // Block to acquire the lock.
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (!ContainsKey(connections_, conn)) {
-        return false;
+    }
+    Message message;
+    message.data = data;
+    message.op_code = op_code;
+    message.skippable = skippable;
+    message.queue_time = Clock::NowInSeconds();
+    queue.push_back(std::move(message));
+  }
+  state->data_ready.notify_one();
+  return true;
+}
+
+void WebSocketHandler::SendQueuedData(Connection *conn,
+                                      ConnectionState *state) {
+  while (true) {
+    Message message;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->data_ready.wait(
+          lock, [state] { return state->closed || !state->queue.empty(); });
+      if (state->closed) {
+        return;
       }
+      message = std::move(state->queue.front());
+      state->queue.pop_front();
+    }
+    state->space_ready.notify_one();
+
+    // Only this thread writes to the connection, and the connection won't be
+    // closed and removed until it exits.
+    const bool sent = WriteData(conn, message);
+
+    const double now = Clock::NowInSeconds();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    ConnectionStats &stats = state->stats;
+    if (!sent) {
+      ++stats.dropped_messages;
+      continue;
+    }
+    ++stats.sent_messages;
+    stats.sent_bytes += message.data.size();
+    stats.last_lag_sec = now - message.queue_time;
+    stats.max_lag_sec = std::max(stats.max_lag_sec, stats.last_lag_sec);
+    if (now > state->ready_time) {
+      stats.bandwidth =
+          static_cast<double>(stats.sent_bytes) / (now - state->ready_time);
     }
   }
+}
 
-  // Note that while we are holding the connection lock, the connection won't be
-  // closed and removed.
+bool WebSocketHandler::WriteData(Connection *conn, const Message &message) {
+  const std::string &data = message.data;
   int ret;
   PERF_BLOCK(
       StrCat(name_, ": Writing ", data.size(), " bytes via websocket took"),
       0.1) {
-    ret = mg_websocket_write(conn, op_code, data.c_str(), data.size());
+    ret = mg_websocket_write(conn, message.op_code, data.c_str(), data.size());
   }
-  connection_lock->unlock();
 
   if (ret != static_cast<int>(data.size())) {
     // When data is empty, the header length (2) is returned.
@@ -158,6 +254,23 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
   return true;
 }
 
+std::vector<WebSocketHandler::ConnectionStats>
+WebSocketHandler::GetConnectionStats() const {
+  std::vector<std::shared_ptr<ConnectionState>> states;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &kv : connections_) {
+      states.push_back(kv.second);
+    }
+  }
+  std::vector<ConnectionStats> stats;
+  for (const auto &state : states) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    stats.push_back(state->stats);
+  }
+  return stats;
+}
+
 thread_local unsigned char WebSocketHandler::current_opcode_ = 0x00;
 thread_local std::stringstream WebSocketHandler::data_;
 
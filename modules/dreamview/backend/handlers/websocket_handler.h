@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -42,6 +45,8 @@ namespace dreamview {
  *
  * @brief The WebSocketHandler, built on top of CivetWebSocketHandler, is a
  * websocket handler that handles different types of websocket related events.
+ * Data is queued per connection and written by a thread of that connection,
+ * so that a slow client never holds up the others.
  */
 class WebSocketHandler : public CivetWebSocketHandler {
   // In case of receiving fragmented message,
@@ -55,7 +60,28 @@ class WebSocketHandler : public CivetWebSocketHandler {
   using MessageHandler = std::function<void(const Json &, Connection *)>;
   using ConnectionReadyHandler = std::function<void(Connection *)>;
 
+  // The most messages queued for a connection. Beyond it skippable data is
+  // dropped, and other data waits for the queue to drain.
+  static constexpr size_t kMaxQueuedMessages = 16;
+
+  // What has been sent to a connection so far.
+  struct ConnectionStats {
+    uint64_t sent_messages = 0;
+    uint64_t sent_bytes = 0;
+    // Skippable messages dropped as the queue was full, or messages failed
+    // to write.
+    uint64_t dropped_messages = 0;
+    // Skippable messages replaced in the queue by newer ones.
+    uint64_t coalesced_messages = 0;
+    // Seconds from queuing a message to having written it.
+    double last_lag_sec = 0.0;
+    double max_lag_sec = 0.0;
+    // Sent bytes per second since the connection was ready.
+    double bandwidth = 0.0;
+  };
+
   explicit WebSocketHandler(const std::string &name) : name_(name) {}
+  ~WebSocketHandler();
 
   /**
    * @brief Callback method for when the client intends to establish a websocket
@@ -119,12 +145,14 @@ class WebSocketHandler : public CivetWebSocketHandler {
   bool BroadcastData(const std::string &data, bool skippable = false);
 
   /**
-   * @brief Sends the provided data to a specific connected client.
+   * @brief Queues the provided data to be sent to a specific connected client.
    *
    * @param conn The connection to send to.
    * @param data The message string to be sent.
-   * @param skippable whether the data is allowed to be skipped if some other is
-   * being sent to this connection.
+   * @param skippable whether the data supersedes, and is superseded by, other
+   * skippable data of the same op_code not yet sent to this connection. It is
+   * dropped rather than waiting if the queue of the connection is full.
+   * @returns false if the data is dropped.
    */
   bool SendData(Connection *conn, const std::string &data,
                 bool skippable = false, int op_code = MG_WEBSOCKET_OPCODE_TEXT);
@@ -149,7 +177,36 @@ class WebSocketHandler : public CivetWebSocketHandler {
     connection_ready_handlers_.emplace_back(handler);
   }
 
+  /**
+   * @brief The statistics of all open connections.
+   */
+  std::vector<ConnectionStats> GetConnectionStats() const;
+
  private:
+  struct Message {
+    std::string data;
+    int op_code = MG_WEBSOCKET_OPCODE_TEXT;
+    bool skippable = false;
+    double queue_time = 0.0;
+  };
+
+  // The messages waiting to be sent to a connection, and the thread sending
+  // them one by one.
+  struct ConnectionState {
+    std::mutex mutex;
+    std::condition_variable data_ready;
+    std::condition_variable space_ready;
+    std::deque<Message> queue;
+    bool closed = false;
+    double ready_time = 0.0;
+    ConnectionStats stats;
+    std::thread sender;
+  };
+
+  void SendQueuedData(Connection *conn, ConnectionState *state);
+  bool WriteData(Connection *conn, const Message &message);
+  void CloseConnection(ConnectionState *state);
+
   const std::string name_;
 
   // Message handlers keyed by message type.
@@ -164,9 +221,9 @@ class WebSocketHandler : public CivetWebSocketHandler {
   // brief as possible.
   mutable std::mutex mutex_;
 
-  // The pool of all maintained connections. Each connection has a lock to
-  // guard against simultaneous write.
-  std::unordered_map<Connection *, std::shared_ptr<std::mutex>> connections_;
+  // The pool of all maintained connections.
+  std::unordered_map<Connection *, std::shared_ptr<ConnectionState>>
+      connections_;
 };
 
 }  // namespace dreamview
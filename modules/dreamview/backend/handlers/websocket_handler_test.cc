@@ -78,6 +78,27 @@ TEST(WebSocketTest, IntegrationTest) {
 
   // Check that the 3 messages are successfully received and processed.
   EXPECT_THAT(client.GetReceivedMessages(), ElementsAre("0", "1", "2"));
+  auto stats = handler.GetConnectionStats();
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ(3, stats[0].sent_messages);
+  EXPECT_EQ(3, stats[0].sent_bytes);
+
+  // Queued skippable data is superseded by newer data, and the latest always
+  // gets through.
+  const int kSkippableMessages = 100;
+  for (int i = 0; i < kSkippableMessages; ++i) {
+    handler.BroadcastData(std::to_string(i), true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  EXPECT_EQ(std::to_string(kSkippableMessages - 1),
+            client.GetReceivedMessages().back());
+  stats = handler.GetConnectionStats();
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ(0, stats[0].dropped_messages);
+  EXPECT_EQ(3 + kSkippableMessages,
+            stats[0].sent_messages + stats[0].coalesced_messages);
+  EXPECT_EQ(client.GetReceivedMessages().size(), stats[0].sent_messages);
 }
 
 TEST(WebSocketTest, handleData) {
@@ -17,17 +17,20 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <utility>
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
 namespace dreamview {
 
 using apollo::common::PointENU;
+using apollo::common::util::StrCat;
 using apollo::hdmap::ClearAreaInfoConstPtr;
 using apollo::hdmap::CrosswalkInfoConstPtr;
 using apollo::hdmap::HDMapUtil;
@@ -45,6 +48,7 @@ using apollo::hdmap::SpeedBumpInfoConstPtr;
 using apollo::hdmap::StopSignInfoConstPtr;
 using apollo::hdmap::YieldSignInfoConstPtr;
 using apollo::routing::RoutingResponse;
+using google::protobuf::FieldDescriptor;
 using google::protobuf::RepeatedPtrField;
 
 namespace {
@@ -82,20 +86,28 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
 }  // namespace
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
+constexpr size_t MapService::kMaxCachedTiles;
 
 MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
   ReloadMap(false);
 }
 
 bool MapService::ReloadMap(bool force_reload) {
-  boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
   bool ret = true;
-  if (force_reload) {
-    ret = HDMapUtil::ReloadMaps();
+  {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    if (force_reload) {
+      ret = HDMapUtil::ReloadMaps();
+    }
+
+    // Update the x,y-offsets if present.
+    UpdateOffsets();
   }
 
-  // Update the x,y-offsets if present.
-  UpdateOffsets();
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  ++cache_generation_;
+  tile_cache_.clear();
+  element_cache_.clear();
   return ret;
 }
 
@@ -160,6 +172,46 @@ void MapService::CollectMapElementIds(const PointENU &point, double radius,
   if (!MapReady()) {
     return;
   }
+  const double tile_size = FLAGS_sim_map_tile_size;
+  if (tile_size <= 0.0) {
+    QueryMapElementIds(point, radius, ids);
+    return;
+  }
+
+  const double tile_x = std::floor(point.x() / tile_size);
+  const double tile_y = std::floor(point.y() / tile_size);
+  const std::string key = StrCat(tile_x, ",", tile_y, ",", radius);
+  uint64_t generation;
+  {
+    std::unique_lock<std::mutex> lock(cache_mutex_);
+    auto iter = tile_cache_.find(key);
+    if (iter != tile_cache_.end()) {
+      ids->MergeFrom(iter->second);
+      return;
+    }
+    generation = cache_generation_;
+  }
+
+  // Everything within the radius of any point of the tile is within this
+  // radius of its center.
+  PointENU center;
+  center.set_x((tile_x + 0.5) * tile_size);
+  center.set_y((tile_y + 0.5) * tile_size);
+  MapElementIds tile_ids;
+  QueryMapElementIds(center, radius + tile_size * M_SQRT1_2, &tile_ids);
+  ids->MergeFrom(tile_ids);
+
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  if (generation == cache_generation_) {
+    if (tile_cache_.size() >= kMaxCachedTiles) {
+      tile_cache_.clear();
+    }
+    tile_cache_.emplace(key, std::move(tile_ids));
+  }
+}
+
+void MapService::QueryMapElementIds(const PointENU &point, double radius,
+                                    MapElementIds *ids) const {
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
   std::vector<LaneInfoConstPtr> lanes;
@@ -329,6 +381,58 @@ Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   return result;
 }
 
+std::string MapService::RetrieveSerializedMapElements(
+    const MapElementIds &ids) const {
+  // The serialized Maps of single elements concatenate into the serialized
+  // Map of all of them.
+  std::string result;
+  if (!MapReady()) {
+    return result;
+  }
+  const auto *descriptor = ids.GetDescriptor();
+  const auto *reflection = ids.GetReflection();
+  std::vector<std::pair<const FieldDescriptor *, std::string>> missed_ids;
+  uint64_t generation;
+  {
+    std::unique_lock<std::mutex> lock(cache_mutex_);
+    generation = cache_generation_;
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const FieldDescriptor *field = descriptor->field(i);
+      for (int j = 0; j < reflection->FieldSize(ids, field); ++j) {
+        const std::string id = reflection->GetRepeatedString(ids, field, j);
+        auto iter = element_cache_.find(StrCat(field->name(), "/", id));
+        if (iter != element_cache_.end()) {
+          result += iter->second;
+        } else {
+          missed_ids.emplace_back(field, id);
+        }
+      }
+    }
+  }
+  if (missed_ids.empty()) {
+    return result;
+  }
+
+  std::vector<std::string> missed_elements(missed_ids.size());
+  for (size_t i = 0; i < missed_ids.size(); ++i) {
+    MapElementIds element_ids;
+    reflection->AddString(&element_ids, missed_ids[i].first,
+                          missed_ids[i].second);
+    RetrieveMapElements(element_ids).SerializeToString(&missed_elements[i]);
+    result += missed_elements[i];
+  }
+
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  if (generation == cache_generation_) {
+    for (size_t i = 0; i < missed_ids.size(); ++i) {
+      element_cache_.emplace(
+          StrCat(missed_ids[i].first->name(), "/", missed_ids[i].second),
+          std::move(missed_elements[i]));
+    }
+  }
+  return result;
+}
+
 bool MapService::GetNearestLane(const double x, const double y,
                                 LaneInfoConstPtr *nearest_lane,
                                 double *nearest_s, double *nearest_l) const {
@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "boost/thread/locks.hpp"
@@ -44,6 +46,12 @@ class MapService {
   inline double GetXOffset() const { return x_offset_; }
   inline double GetYOffset() const { return y_offset_; }
 
+  /**
+   * @brief Collects the ids of the map elements within the radius of the
+   * point. With a positive FLAGS_sim_map_tile_size they are cached per tile,
+   * so the elements are those within the radius of any point of the tile the
+   * point is in.
+   */
   void CollectMapElementIds(const apollo::common::PointENU &point,
                             double raidus, MapElementIds *ids) const;
 
@@ -55,6 +63,12 @@ class MapService {
   // javascript clients.
   hdmap::Map RetrieveMapElements(const MapElementIds &ids) const;
 
+  /**
+   * @brief The serialized hdmap::Map of RetrieveMapElements(). Each element
+   * is serialized once and cached until the map is reloaded.
+   */
+  std::string RetrieveSerializedMapElements(const MapElementIds &ids) const;
+
   bool GetPoseWithRegardToLane(const double x, const double y, double *theta,
                                double *s) const;
 
@@ -87,6 +101,8 @@ class MapService {
 
  private:
   void UpdateOffsets();
+  void QueryMapElementIds(const apollo::common::PointENU &point,
+                          double radius, MapElementIds *ids) const;
   bool GetNearestLane(const double x, const double y,
                       apollo::hdmap::LaneInfoConstPtr *nearest_lane,
                       double *nearest_s, double *nearest_l) const;
@@ -115,6 +131,18 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  // The most tiles whose elements are cached.
+  static constexpr size_t kMaxCachedTiles = 64;
+
+  // Caches of elements found and serialized, cleared on map reload. Stores
+  // are skipped if the generation changed since the lookup.
+  mutable std::mutex cache_mutex_;
+  uint64_t cache_generation_ = 0;
+  // Element ids keyed by tile and radius.
+  mutable std::unordered_map<std::string, MapElementIds> tile_cache_;
+  // Serialized single element hdmap::Maps keyed by element kind and id.
+  mutable std::unordered_map<std::string, std::string> element_cache_;
 };
 
 }  // namespace dreamview
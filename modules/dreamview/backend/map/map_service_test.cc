@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "modules/common/configs/config_gflags.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 using apollo::common::PointENU;
 using apollo::hdmap::Map;
@@ -54,6 +55,31 @@ TEST_F(MapServiceTest, CollectMapElementIds) {
   EXPECT_TRUE(map_element_ids.yield().empty());
 }
 
+TEST_F(MapServiceTest, CollectMapElementIdsOfTile) {
+  // Points of the same tile share the elements around the tile.
+  PointENU p;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  MapElementIds ids;
+  map_service->CollectMapElementIds(p, 1.0, &ids);
+  EXPECT_EQ(1, ids.lane_size());
+
+  p.set_x(-1839.0);
+  p.set_y(-3039.0);
+  MapElementIds cached_ids;
+  map_service->CollectMapElementIds(p, 1.0, &cached_ids);
+  EXPECT_EQ(ids.SerializeAsString(), cached_ids.SerializeAsString());
+
+  // Without tiles the elements are found around the point itself.
+  FLAGS_sim_map_tile_size = 0.0;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  MapElementIds exact_ids;
+  map_service->CollectMapElementIds(p, 1.0, &exact_ids);
+  EXPECT_EQ(1, exact_ids.lane_size());
+  FLAGS_sim_map_tile_size = 20.0;
+}
+
 TEST_F(MapServiceTest, RetrieveMapElements) {
   MapElementIds map_element_ids;
   map_element_ids.add_lane("l1");
@@ -62,6 +88,21 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, RetrieveSerializedMapElements) {
+  MapElementIds map_element_ids;
+  map_element_ids.add_lane("l1");
+  map_element_ids.add_crosswalk("unknown");
+  const std::string expected =
+      map_service->RetrieveMapElements(map_element_ids).SerializeAsString();
+  // The second one is served from the cache.
+  for (int i = 0; i < 2; ++i) {
+    Map map;
+    ASSERT_TRUE(map.ParseFromString(
+        map_service->RetrieveSerializedMapElements(map_element_ids)));
+    EXPECT_EQ(expected, map.SerializeAsString());
+  }
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
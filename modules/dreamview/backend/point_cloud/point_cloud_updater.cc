@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
 
+#include <cmath>
+#include <limits>
 #include <utility>
 
 #include "cyber/common/file.h"
@@ -23,6 +25,7 @@
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/time/time.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/dreamview/proto/point_cloud.pb.h"
 #include "pcl/filters/voxel_grid.h"
 #include "third_party/json/json.hpp"
@@ -148,36 +151,42 @@ void PointCloudUpdater::UpdatePointCloud(
   // Check if last filter process has finished before processing new data.
   if (future_ready_) {
     future_ready_ = false;
-    // transform from drivers::PointCloud to pcl::PointCloud
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-    pcl_ptr->width = point_cloud->width();
-    pcl_ptr->height = point_cloud->height();
-    pcl_ptr->is_dense = false;
-    pcl_ptr->points.resize(pcl_ptr->width * pcl_ptr->height);
-
-    if (pcl_ptr->width == 0 || pcl_ptr->height == 0) {
-      pcl_ptr->width = 1;
-      pcl_ptr->height = point_cloud->point_size();
-      pcl_ptr->points.resize(point_cloud->point_size());
-    }
-
-    for (size_t i = 0; i < pcl_ptr->points.size(); ++i) {
-      const auto &point = point_cloud->point(static_cast<int>(i));
-      pcl_ptr->points[i].x = point.x();
-      pcl_ptr->points[i].y = point.y();
-      pcl_ptr->points[i].z = point.z();
-    }
     std::future<void> f =
-        cyber::Async(&PointCloudUpdater::FilterPointCloud, this, pcl_ptr);
+        cyber::Async(&PointCloudUpdater::FilterPointCloud, this, point_cloud);
     async_future_ = std::move(f);
   }
 }
 
+pcl::PointCloud<pcl::PointXYZ>::Ptr PointCloudUpdater::ConvertPointCloud(
+    const drivers::PointCloud &point_cloud) {
+  // transform from drivers::PointCloud to pcl::PointCloud
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
+      new pcl::PointCloud<pcl::PointXYZ>);
+  pcl_ptr->width = point_cloud.width();
+  pcl_ptr->height = point_cloud.height();
+  pcl_ptr->is_dense = false;
+  pcl_ptr->points.resize(pcl_ptr->width * pcl_ptr->height);
+
+  if (pcl_ptr->width == 0 || pcl_ptr->height == 0) {
+    pcl_ptr->width = 1;
+    pcl_ptr->height = drivers::PointNum(point_cloud);
+    pcl_ptr->points.resize(pcl_ptr->height);
+  }
+
+  for (size_t i = 0; i < pcl_ptr->points.size(); ++i) {
+    const drivers::PackedPoint point =
+        drivers::GetPoint(point_cloud, static_cast<int>(i));
+    pcl_ptr->points[i].x = point.x;
+    pcl_ptr->points[i].y = point.y;
+    pcl_ptr->points[i].z = point.z;
+  }
+  return pcl_ptr;
+}
+
 void PointCloudUpdater::FilterPointCloud(
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr) {
+    std::shared_ptr<drivers::PointCloud> point_cloud) {
   pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
-  voxel_grid.setInputCloud(pcl_ptr);
+  voxel_grid.setInputCloud(ConvertPointCloud(*point_cloud));
   voxel_grid.setLeafSize(static_cast<float>(FLAGS_voxel_filter_size),
                          static_cast<float>(FLAGS_voxel_filter_size),
                          static_cast<float>(FLAGS_voxel_filter_height));
@@ -191,13 +200,28 @@ void PointCloudUpdater::FilterPointCloud(
     boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
     z_offset = lidar_height_;
   }
+  // Points are sent as int16 triples, which takes half the bytes of floats.
+  const double resolution = FLAGS_point_cloud_resolution;
   apollo::dreamview::PointCloud point_cloud_pb;
-  for (size_t idx = 0; idx < pcl_filtered_ptr->size(); ++idx) {
-    pcl::PointXYZ &pt = pcl_filtered_ptr->points[idx];
-    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
-      point_cloud_pb.add_num(pt.x);
-      point_cloud_pb.add_num(pt.y);
-      point_cloud_pb.add_num(pt.z + z_offset);
+  point_cloud_pb.set_resolution(static_cast<float>(resolution));
+  std::string *quantized = point_cloud_pb.mutable_quantized_num();
+  quantized->reserve(pcl_filtered_ptr->size() * 3 * sizeof(int16_t));
+  for (const pcl::PointXYZ &pt : pcl_filtered_ptr->points) {
+    const double coordinates[] = {pt.x, pt.y, pt.z + z_offset};
+    int16_t values[3];
+    bool valid = true;
+    for (int i = 0; i < 3 && valid; ++i) {
+      const double value = std::round(coordinates[i] / resolution);
+      // Also rejects NaN.
+      valid = std::fabs(value) <= std::numeric_limits<int16_t>::max();
+      values[i] = valid ? static_cast<int16_t>(value) : 0;
+    }
+    if (!valid) {
+      continue;
+    }
+    for (const int16_t value : values) {
+      quantized->push_back(static_cast<char>(value & 0xFF));
+      quantized->push_back(static_cast<char>((value >> 8) & 0xFF));
     }
   }
   {
@@ -78,7 +78,12 @@ class PointCloudUpdater {
   void UpdatePointCloud(
       const std::shared_ptr<drivers::PointCloud> &point_cloud);
 
-  void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
+  // Downsamples and quantizes a point cloud into point_cloud_str_. It runs
+  // asynchronously so as not to hold up the reader.
+  void FilterPointCloud(std::shared_ptr<drivers::PointCloud> point_cloud);
+
+  static pcl::PointCloud<pcl::PointXYZ>::Ptr ConvertPointCloud(
+      const drivers::PointCloud &point_cloud);
 
   void UpdateLocalizationTime(
       const std::shared_ptr<apollo::localization::LocalizationEstimate>
@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+// The serialized value of a message field, with the sizes of repeated
+// elements in between so that different splits never compare equal.
+std::string SerializeField(const Message &message,
+                           const FieldDescriptor *field) {
+  const Reflection *reflection = message.GetReflection();
+  if (!field->is_repeated()) {
+    return reflection->GetMessage(message, field).SerializeAsString();
+  }
+  std::string bytes;
+  for (int i = 0; i < reflection->FieldSize(message, field); ++i) {
+    const std::string element =
+        reflection->GetRepeatedMessage(message, field, i).SerializeAsString();
+    bytes += std::to_string(element.size());
+    bytes += ':';
+    bytes += element;
+  }
+  return bytes;
+}
+
+// Copies a message field or a singular scalar field, returns false for any
+// other field.
+bool CopyField(const Message &from, const FieldDescriptor *field,
+               Message *to) {
+  const Reflection *from_reflection = from.GetReflection();
+  const Reflection *to_reflection = to->GetReflection();
+  if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    if (!field->is_repeated()) {
+      to_reflection->MutableMessage(to, field)->CopyFrom(
+          from_reflection->GetMessage(from, field));
+      return true;
+    }
+    for (int i = 0; i < from_reflection->FieldSize(from, field); ++i) {
+      to_reflection->AddMessage(to, field)->CopyFrom(
+          from_reflection->GetRepeatedMessage(from, field, i));
+    }
+    return true;
+  }
+  if (field->is_repeated()) {
+    return false;
+  }
+  switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      to_reflection->SetInt32(to, field,
+                              from_reflection->GetInt32(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_INT64:
+      to_reflection->SetInt64(to, field,
+                              from_reflection->GetInt64(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      to_reflection->SetUInt32(to, field,
+                               from_reflection->GetUInt32(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      to_reflection->SetUInt64(to, field,
+                               from_reflection->GetUInt64(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      to_reflection->SetDouble(to, field,
+                               from_reflection->GetDouble(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      to_reflection->SetFloat(to, field,
+                              from_reflection->GetFloat(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      to_reflection->SetBool(to, field, from_reflection->GetBool(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      to_reflection->SetEnum(to, field, from_reflection->GetEnum(from, field));
+      return true;
+    case FieldDescriptor::CPPTYPE_STRING:
+      to_reflection->SetString(to, field,
+                               from_reflection->GetString(from, field));
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+SimulationWorldDeltaEncoder::SimulationWorldDeltaEncoder(
+    const int keyframe_interval)
+    : keyframe_interval_(std::max(keyframe_interval, 1)),
+      frames_since_keyframe_(keyframe_interval_) {}
+
+void SimulationWorldDeltaEncoder::Update(const SimulationWorld &world) {
+  if (++frames_since_keyframe_ < keyframe_interval_ && EncodeDelta(world)) {
+    return;
+  }
+  SetKeyframe(world);
+}
+
+void SimulationWorldDeltaEncoder::SetKeyframe(const SimulationWorld &world) {
+  is_keyframe_ = true;
+  frames_since_keyframe_ = 0;
+  keyframe_sequence_num_ = world.sequence_num();
+  delta_.clear();
+
+  keyframe_fields_.clear();
+  std::vector<const FieldDescriptor *> fields;
+  world.GetReflection()->ListFields(world, &fields);
+  for (const auto *field : fields) {
+    if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+        field->number() != SimulationWorld::kObjectFieldNumber) {
+      keyframe_fields_[field->number()] = SerializeField(world, field);
+    }
+  }
+
+  // Objects sharing an id are always sent.
+  keyframe_objects_.clear();
+  std::vector<std::string> duplicated_ids;
+  for (const auto &object : world.object()) {
+    if (!keyframe_objects_.emplace(object.id(), object.SerializeAsString())
+             .second) {
+      duplicated_ids.push_back(object.id());
+    }
+  }
+  for (const auto &id : duplicated_ids) {
+    keyframe_objects_.erase(id);
+  }
+}
+
+bool SimulationWorldDeltaEncoder::EncodeDelta(const SimulationWorld &world) {
+  SimulationWorld delta;
+  delta.set_keyframe_sequence_num(keyframe_sequence_num_);
+  std::vector<const FieldDescriptor *> fields;
+  world.GetReflection()->ListFields(world, &fields);
+  for (const auto *field : fields) {
+    if (field->number() == SimulationWorld::kObjectFieldNumber) {
+      for (const auto &object : world.object()) {
+        const auto iter = keyframe_objects_.find(object.id());
+        if (iter != keyframe_objects_.end() &&
+            iter->second == object.SerializeAsString()) {
+          delta.add_unchanged_object_id(object.id());
+        } else {
+          delta.add_object()->CopyFrom(object);
+        }
+      }
+      continue;
+    }
+    if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+      const auto iter = keyframe_fields_.find(field->number());
+      if (iter != keyframe_fields_.end() &&
+          iter->second == SerializeField(world, field)) {
+        delta.add_unchanged_field(field->number());
+        continue;
+      }
+    }
+    if (!CopyField(world, field, &delta)) {
+      AWARN << "Taking a keyframe as field " << field->name()
+            << " can not be delta encoded.";
+      return false;
+    }
+  }
+  is_keyframe_ = false;
+  delta.SerializeToString(&delta_);
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
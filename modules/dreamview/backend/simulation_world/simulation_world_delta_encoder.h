@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldDeltaEncoder
+ * @brief Encodes each SimulationWorld as the changes against a keyframe taken
+ * at intervals, so that clients holding the keyframe get far less data. A
+ * delta keeps all scalar fields, and drops the objects and message fields
+ * that serialize the same as in the keyframe, see keyframe_sequence_num in
+ * simulation_world.proto.
+ * NOTE: This class is not thread-safe.
+ */
+class SimulationWorldDeltaEncoder {
+ public:
+  /**
+   * @param keyframe_interval every how many updates a keyframe is taken.
+   */
+  explicit SimulationWorldDeltaEncoder(const int keyframe_interval);
+
+  /**
+   * @brief Takes world as the newest frame, which becomes the keyframe or is
+   * encoded as the delta against the keyframe.
+   */
+  void Update(const SimulationWorld &world);
+
+  /**
+   * @brief Whether the newest frame is a keyframe, which has no delta.
+   */
+  bool IsKeyframe() const { return is_keyframe_; }
+
+  uint32_t keyframe_sequence_num() const { return keyframe_sequence_num_; }
+
+  /**
+   * @brief The binary delta of the newest frame, empty for a keyframe.
+   */
+  const std::string &delta() const { return delta_; }
+
+ private:
+  void SetKeyframe(const SimulationWorld &world);
+  bool EncodeDelta(const SimulationWorld &world);
+
+  const int keyframe_interval_;
+  int frames_since_keyframe_;
+  bool is_keyframe_ = false;
+  uint32_t keyframe_sequence_num_ = 0;
+
+  // Serialized message fields of the keyframe by field number, and its
+  // serialized objects by id.
+  std::unordered_map<int, std::string> keyframe_fields_;
+  std::unordered_map<std::string, std::string> keyframe_objects_;
+
+  std::string delta_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
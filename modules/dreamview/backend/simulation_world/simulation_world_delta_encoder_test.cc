@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+SimulationWorld MakeWorld(const uint32_t sequence_num) {
+  SimulationWorld world;
+  world.set_sequence_num(sequence_num);
+  world.set_timestamp(100.0 * sequence_num);
+  world.mutable_auto_driving_car()->set_position_x(1.0 * sequence_num);
+  world.mutable_traffic_signal()->set_current_signal("GREEN");
+  for (const char *id : {"parked", "moving"}) {
+    auto *object = world.add_object();
+    object->set_id(id);
+    object->set_position_x(10.0);
+  }
+  world.mutable_object(1)->set_position_x(10.0 + sequence_num);
+  return world;
+}
+
+// What a client does with a delta and the keyframe it holds.
+SimulationWorld Decode(const SimulationWorld &keyframe,
+                       const std::string &delta_bytes) {
+  SimulationWorld delta;
+  EXPECT_TRUE(delta.ParseFromString(delta_bytes));
+  EXPECT_EQ(keyframe.sequence_num(), delta.keyframe_sequence_num());
+  SimulationWorld world;
+  const auto *descriptor = SimulationWorld::descriptor();
+  for (const uint32_t number : delta.unchanged_field()) {
+    const auto *field = descriptor->FindFieldByNumber(static_cast<int>(number));
+    SimulationWorld unchanged = keyframe;
+    const auto *reflection = unchanged.GetReflection();
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      if (descriptor->field(i) != field) {
+        reflection->ClearField(&unchanged, descriptor->field(i));
+      }
+    }
+    world.MergeFrom(unchanged);
+  }
+  for (const auto &id : delta.unchanged_object_id()) {
+    for (const auto &object : keyframe.object()) {
+      if (object.id() == id) {
+        world.add_object()->CopyFrom(object);
+      }
+    }
+  }
+  world.MergeFrom(delta);
+  world.clear_keyframe_sequence_num();
+  world.clear_unchanged_field();
+  world.clear_unchanged_object_id();
+  return world;
+}
+
+}  // namespace
+
+TEST(SimulationWorldDeltaEncoderTest, Delta) {
+  SimulationWorldDeltaEncoder encoder(3);
+  const SimulationWorld keyframe = MakeWorld(1);
+  encoder.Update(keyframe);
+  EXPECT_TRUE(encoder.IsKeyframe());
+  EXPECT_EQ(1, encoder.keyframe_sequence_num());
+  EXPECT_TRUE(encoder.delta().empty());
+
+  const SimulationWorld world = MakeWorld(2);
+  encoder.Update(world);
+  ASSERT_FALSE(encoder.IsKeyframe());
+  SimulationWorld delta;
+  ASSERT_TRUE(delta.ParseFromString(encoder.delta()));
+  EXPECT_EQ(2, delta.sequence_num());
+  ASSERT_EQ(1, delta.unchanged_field_size());
+  EXPECT_EQ(SimulationWorld::kTrafficSignalFieldNumber,
+            delta.unchanged_field(0));
+  ASSERT_EQ(1, delta.unchanged_object_id_size());
+  EXPECT_EQ("parked", delta.unchanged_object_id(0));
+  ASSERT_EQ(1, delta.object_size());
+  EXPECT_EQ("moving", delta.object(0).id());
+  EXPECT_LT(encoder.delta().size(), world.ByteSizeLong());
+
+  // Objects keep their order after the unchanged ones.
+  SimulationWorld decoded = Decode(keyframe, encoder.delta());
+  EXPECT_EQ(world.DebugString(), decoded.DebugString());
+
+  // Removed fields and objects stay removed.
+  SimulationWorld smaller = MakeWorld(3);
+  smaller.clear_traffic_signal();
+  smaller.mutable_object()->RemoveLast();
+  encoder.Update(smaller);
+  ASSERT_FALSE(encoder.IsKeyframe());
+  decoded = Decode(keyframe, encoder.delta());
+  EXPECT_EQ(smaller.DebugString(), decoded.DebugString());
+
+  encoder.Update(MakeWorld(4));
+  EXPECT_TRUE(encoder.IsKeyframe());
+  EXPECT_EQ(4, encoder.keyframe_sequence_num());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -381,14 +381,21 @@ void SimulationWorldService::UpdateLatencies() {
   UpdateLatency("control", control_command_reader_.get());
 }
 
-void SimulationWorldService::GetWireFormatString(
-    double radius, std::string *sim_world,
-    std::string *sim_world_with_planning_data) {
+void SimulationWorldService::GetWireFormatString(double radius,
+                                                 std::string *sim_world,
+                                                 std::string *planning_data) {
   PopulateMapInfo(radius);
 
-  world_.SerializeToString(sim_world_with_planning_data);
-
-  world_.clear_planning_data();
+  // Serialize the planning data alone, which saves serializing the rest of
+  // the world twice.
+  planning_data->clear();
+  if (world_.has_planning_data()) {
+    SimulationWorld planning_world;
+    planning_world.mutable_planning_data()->Swap(
+        world_.mutable_planning_data());
+    world_.clear_planning_data();
+    planning_world.SerializeToString(planning_data);
+  }
   world_.SerializeToString(sim_world);
 }
 
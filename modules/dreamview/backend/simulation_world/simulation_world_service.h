@@ -94,12 +94,13 @@ class SimulationWorldService {
   /**
    * @brief Returns the binary representation of the SimulationWorld object.
    * @param radius the search distance from the current car location.
-   * @param sim_world output of binary format sim_world string.
-   * @param sim_world_with_planning_data output of binary format sim_world
-   * string with planning_data.
+   * @param sim_world output of binary format sim_world string, without
+   * planning_data.
+   * @param planning_data output of binary format planning_data, which appended
+   * to sim_world, or to a delta of it, gives the one with planning_data.
    */
   void GetWireFormatString(double radius, std::string *sim_world,
-                           std::string *sim_world_with_planning_data);
+                           std::string *planning_data);
 
   /**
    * @brief Returns the json representation of the map element Ids and hash
@@ -46,7 +46,8 @@ SimulationWorldUpdater::SimulationWorldUpdater(
       websocket_(websocket),
       map_ws_(map_ws),
       sim_control_(sim_control),
-      data_collection_monitor_(data_collection_monitor) {
+      data_collection_monitor_(data_collection_monitor),
+      delta_encoder_(FLAGS_sim_world_keyframe_interval) {
   RegisterMessageHandlers();
 }
 
@@ -67,12 +68,10 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (iter != json.end()) {
           MapElementIds map_element_ids;
           if (JsonStringToMessage(iter->dump(), &map_element_ids).ok()) {
-            auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
-
-            std::string retrieved_map_string;
-            retrieved.SerializeToString(&retrieved_map_string);
-
-            map_ws_->SendBinaryData(conn, retrieved_map_string, true);
+            map_ws_->SendBinaryData(
+                conn,
+                map_service_->RetrieveSerializedMapElements(map_element_ids),
+                true);
           } else {
             AERROR << "Failed to parse MapElementIds from json";
           }
@@ -169,13 +168,22 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
+        // A client telling the keyframe it holds gets the delta against it,
+        // as long as that is the current keyframe.
+        auto keyframe = json.find("keyframe");
         std::string to_send;
         {
           // Pay the price to copy the data instead of sending data over the
           // wire while holding the lock.
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = enable_pnc_monitor ? simulation_world_with_planning_data_
-                                       : simulation_world_;
+          const bool send_delta =
+              keyframe != json.end() && keyframe->is_number_unsigned() &&
+              !delta_encoder_.IsKeyframe() &&
+              *keyframe == delta_encoder_.keyframe_sequence_num();
+          to_send = send_delta ? delta_encoder_.delta() : simulation_world_;
+          if (enable_pnc_monitor) {
+            to_send += planning_data_;
+          }
         }
         if (FLAGS_enable_update_size_check && !enable_pnc_monitor &&
             to_send.size() > FLAGS_max_update_size) {
@@ -389,8 +397,8 @@ void SimulationWorldUpdater::OnTimer() {
   {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     sim_world_service_.GetWireFormatString(
-        FLAGS_sim_map_radius, &simulation_world_,
-        &simulation_world_with_planning_data_);
+        FLAGS_sim_map_radius, &simulation_world_, &planning_data_);
+    delta_encoder_.Update(sim_world_service_.world());
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
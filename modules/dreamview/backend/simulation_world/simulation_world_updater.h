@@ -34,6 +34,7 @@
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 #include "modules/routing/proto/poi.pb.h"
 
@@ -144,9 +145,12 @@ class SimulationWorldUpdater {
   apollo::routing::POI poi_;
 
   // The simulation_world in wire format to be pushed to frontend, which is
-  // updated by timer.
+  // updated by timer, and its planning_data to append on request.
   std::string simulation_world_;
-  std::string simulation_world_with_planning_data_;
+  std::string planning_data_;
+
+  // Deltas of simulation_world_ for the clients holding its keyframe.
+  SimulationWorldDeltaEncoder delta_encoder_;
 
   // Received relative map data in wire format.
   std::string relative_map_string_;
@@ -2,11 +2,16 @@ import STORE from "store";
 import RENDERER from "renderer";
 import Worker from 'utils/webworker.js';
 
+// A request with no reply by then is taken as lost.
+const REQUEST_TIMEOUT_MS = 2000;
+
 export default class PointCloudWebSocketEndpoint {
     constructor(serverAddr) {
         this.serverAddr = serverAddr;
         this.websocket = null;
         this.worker = new Worker();
+        // When the outstanding point cloud request was sent, or 0 if none.
+        this.requestTime = 0;
     }
 
     initialize() {
@@ -36,15 +41,24 @@ export default class PointCloudWebSocketEndpoint {
               if (STORE.options.showPointCloud === false) {
                 RENDERER.updatePointCloud({num:[]});
               }
-            } else if (STORE.options.showPointCloud === true && event.data.num !== undefined) {
-                RENDERER.updatePointCloud(event.data);
+            } else if (event.data.num !== undefined) {
+                this.requestTime = 0;
+                if (STORE.options.showPointCloud === true) {
+                    RENDERER.updatePointCloud(event.data);
+                }
             }
         };
-        // Request point cloud every 100ms.
+        // Request point cloud every 200ms. Only one request is outstanding at a
+        // time, so a slow connection gets fewer frames instead of falling behind.
         clearInterval(this.timer);
+        this.requestTime = 0;
         this.timer = setInterval(() => {
+            const now = Date.now();
             if (this.websocket.readyState === this.websocket.OPEN
-                && STORE.options.showPointCloud === true) {
+                && STORE.options.showPointCloud === true
+                && (this.requestTime === 0
+                    || now - this.requestTime > REQUEST_TIMEOUT_MS)) {
+                this.requestTime = now;
                 this.websocket.send(JSON.stringify({
                     type : "RequestPointCloud"
                 }));
@@ -15,6 +15,7 @@ export default class RealtimeWebSocketEndpoint {
         this.updatePOI = true;
         this.routingTime = undefined;
         this.currentMode = null;
+        this.simWorldKeyframe = undefined;
         this.worker = new Worker();
     }
 
@@ -50,6 +51,7 @@ export default class RealtimeWebSocketEndpoint {
                     break;
                 case "SimWorldUpdate":
                     this.checkMessage(message);
+                    this.simWorldKeyframe = message.keyframe;
 
                     const isNewMode = (this.currentMode !== STORE.hmi.currentMode);
                     this.currentMode = STORE.hmi.currentMode;
@@ -108,6 +110,7 @@ export default class RealtimeWebSocketEndpoint {
         };
         this.websocket.onclose = event => {
             console.log("WebSocket connection closed, close_code: " + event.code);
+            this.simWorldKeyframe = undefined;
 
             // If connection has been lost for more than 10 sec, send the error message every 2 sec
             const now = new Date().getTime();
@@ -169,9 +172,11 @@ export default class RealtimeWebSocketEndpoint {
     }
 
     requestSimulationWorld(requestPlanningData) {
+        // Holding a keyframe, only the changes against it are needed.
         this.websocket.send(JSON.stringify({
             type : "RequestSimulationWorld",
             planning : requestPlanningData,
+            keyframe : this.simWorldKeyframe,
         }));
     }
 
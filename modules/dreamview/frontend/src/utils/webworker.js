@@ -9,6 +9,50 @@ const pointCloudRoot = protobuf.Root.fromJSON(
 );
 const pointCloudMessage = pointCloudRoot.lookupType("apollo.dreamview.PointCloud");
 
+// The last full simulation world received, which deltas are based on.
+let simWorldKeyframe = null;
+
+function applySimWorldDelta(world) {
+    if (!world.keyframeSequenceNum) {
+        simWorldKeyframe = world;
+    } else if (simWorldKeyframe &&
+               simWorldKeyframe.sequenceNum === world.keyframeSequenceNum) {
+        // A delta omits the fields and objects unchanged since the keyframe.
+        (world.unchangedField || []).forEach(id => {
+            const name = SimWorldMessage.fieldsById[id].name;
+            world[name] = simWorldKeyframe[name];
+        });
+        const unchangedObjectIds = new Set(world.unchangedObjectId || []);
+        world.object = (simWorldKeyframe.object || [])
+            .filter(object => unchangedObjectIds.has(object.id))
+            .concat(world.object || []);
+        delete world.keyframeSequenceNum;
+        delete world.unchangedField;
+        delete world.unchangedObjectId;
+    } else {
+        return null;
+    }
+    // Tells the keyframe to ask deltas against.
+    world.keyframe = simWorldKeyframe.sequenceNum;
+    return world;
+}
+
+function dequantizePointCloud(pointCloud) {
+    // The coordinates come as int16 triples in units of resolution.
+    const bytes = pointCloud.quantizedNum;
+    if (bytes && bytes.length > 0) {
+        const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+        const num = new Array(bytes.length / 2);
+        for (let i = 0; i < num.length; ++i) {
+            num[i] = view.getInt16(i * 2, true) * pointCloud.resolution;
+        }
+        pointCloud.num = num;
+    }
+    delete pointCloud.quantizedNum;
+    delete pointCloud.resolution;
+    return pointCloud;
+}
+
 self.addEventListener("message", event => {
     let message = null;
     const data = event.data.data;
@@ -17,10 +61,12 @@ self.addEventListener("message", event => {
             if (typeof data === "string") {
                 message = JSON.parse(data);
             } else {
-                message = SimWorldMessage.toObject(
+                message = applySimWorldDelta(SimWorldMessage.toObject(
                     SimWorldMessage.decode(new Uint8Array(data)),
-                    { enums: String });
-                message.type = "SimWorldUpdate";
+                    { enums: String }));
+                if (message) {
+                    message.type = "SimWorldUpdate";
+                }
             }
             break;
         case "map":
@@ -33,8 +79,8 @@ self.addEventListener("message", event => {
             if (typeof data === "string") {
                 message = JSON.parse(data);
             } else {
-                message = pointCloudMessage.toObject(
-                    pointCloudMessage.decode(new Uint8Array(data)), {arrays: true});
+                message = dequantizePointCloud(pointCloudMessage.toObject(
+                    pointCloudMessage.decode(new Uint8Array(data)), {arrays: true}));
             }
             break;
     }
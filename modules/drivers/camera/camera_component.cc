@@ -16,6 +16,8 @@
 
 #include "modules/drivers/camera/camera_component.h"
 
+#include <cstring>
+
 namespace apollo {
 namespace drivers {
 namespace camera {
@@ -50,6 +52,20 @@ bool CameraComponent::Init() {
     return false;
   }
   raw_image_->is_new = 0;
+  if (camera_config_->use_loaned_image()) {
+    // frames are written into the loaned blocks, nothing to allocate here
+    raw_image_->image = nullptr;
+    if (static_cast<uint32_t>(raw_image_->image_size) >
+        LoanedImage::kMaxDataSize) {
+      AERROR << "image size is too big for a loaned image, must less than "
+             << LoanedImage::kMaxDataSize << " bytes.";
+      return false;
+    }
+    loaned_writer_ =
+        node_->CreateWriter<LoanedImage>(camera_config_->channel_name());
+    async_result_ = cyber::Async(&CameraComponent::run, this);
+    return true;
+  }
   // free memory in this struct desturctor
   raw_image_->image =
       reinterpret_cast<char*>(calloc(raw_image_->image_size, sizeof(char)));
@@ -90,6 +106,13 @@ void CameraComponent::run() {
       continue;
     }
 
+    if (loaned_writer_ != nullptr) {
+      if (WriteLoanedImage()) {
+        cyber::SleepFor(std::chrono::microseconds(spin_rate_));
+      }
+      continue;
+    }
+
     if (!camera_device_->poll(raw_image_)) {
       AERROR << "camera device poll failed";
       continue;
@@ -110,6 +133,36 @@ void CameraComponent::run() {
   }
 }
 
+bool CameraComponent::WriteLoanedImage() {
+  auto loaned_image = loaned_writer_->Loan();
+  if (!camera_device_->poll(raw_image_,
+                            reinterpret_cast<char*>(loaned_image->data))) {
+    AERROR << "camera device poll failed";
+    return false;
+  }
+
+  cyber::Time image_time(raw_image_->tv_sec, 1000 * raw_image_->tv_usec);
+  loaned_image->timestamp_sec = cyber::Time::Now().ToSecond();
+  loaned_image->measurement_time = image_time.ToSecond();
+  loaned_image->sequence_num = loaned_seq_++;
+  loaned_image->width = raw_image_->width;
+  loaned_image->height = raw_image_->height;
+  loaned_image->data_size = raw_image_->image_size;
+  if (camera_config_->output_type() == YUYV) {
+    strncpy(loaned_image->encoding, "yuyv",
+            sizeof(loaned_image->encoding) - 1);
+    loaned_image->step = 2 * raw_image_->width;
+  } else if (camera_config_->output_type() == RGB) {
+    strncpy(loaned_image->encoding, "rgb8",
+            sizeof(loaned_image->encoding) - 1);
+    loaned_image->step = 3 * raw_image_->width;
+  }
+  strncpy(loaned_image->frame_id, camera_config_->frame_id().c_str(),
+          sizeof(loaned_image->frame_id) - 1);
+  loaned_writer_->Write(&loaned_image);
+  return true;
+}
+
 CameraComponent::~CameraComponent() {
   if (running_.load()) {
     running_.exchange(false);
@@ -25,6 +25,7 @@
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 
+#include "modules/drivers/camera/loaned_image.h"
 #include "modules/drivers/camera/usb_cam.h"
 
 namespace apollo {
@@ -44,8 +45,10 @@ class CameraComponent : public Component<> {
 
  private:
   void run();
+  bool WriteLoanedImage();
 
   std::shared_ptr<Writer<Image>> writer_ = nullptr;
+  std::shared_ptr<Writer<LoanedImage>> loaned_writer_ = nullptr;
   std::unique_ptr<UsbCam> camera_device_;
   std::shared_ptr<Config> camera_config_;
   CameraImagePtr raw_image_ = nullptr;
@@ -53,6 +56,7 @@ class CameraComponent : public Component<> {
   uint32_t spin_rate_ = 200;
   uint32_t device_wait_ = 2000;
   int index_ = 0;
+  uint32_t loaned_seq_ = 0;
   int buffer_size_ = 16;
   const int32_t MAX_IMAGE_SIZE = 20 * 1024 * 1024;
   std::future<void> async_result_;
@@ -16,6 +16,8 @@
 
 #include "modules/drivers/camera/compress_component.h"
 
+#include <algorithm>
+#include <chrono>
 #include <exception>
 #include <vector>
 
@@ -27,6 +29,20 @@ namespace apollo {
 namespace drivers {
 namespace camera {
 
+namespace {
+
+// weight of the newest frame in the moving averages
+constexpr double kAverageWeight = 0.1;
+
+double MovingAverage(double average, double value) {
+  if (average <= 0.0) {
+    return value;
+  }
+  return (1.0 - kAverageWeight) * average + kAverageWeight * value;
+}
+
+}  // namespace
+
 bool CompressComponent::Init() {
   if (!GetProtoConfig(&config_)) {
     AERROR << "Parse config file failed: " << ConfigFilePath();
@@ -42,13 +58,40 @@ bool CompressComponent::Init() {
     return false;
   }
 
+  jpeg_quality_ = config_.compress_conf().jpeg_quality();
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
+  if (!config_.compress_conf().stats_channel().empty()) {
+    stats_writer_ = node_->CreateWriter<CompressStats>(
+        config_.compress_conf().stats_channel());
+  }
   return true;
 }
 
 bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   ADEBUG << "procing compressed";
+  const uint32_t encode_thread_num =
+      config_.compress_conf().encode_thread_num();
+  if (encode_thread_num <= 1) {
+    UpdateFrameInterval(image->measurement_time());
+    return Encode(image);
+  }
+
+  // skip the frame rather than queue it behind busy encoders
+  if (pending_encodes_.fetch_add(1) >= encode_thread_num) {
+    pending_encodes_.fetch_sub(1);
+    UpdateStats(true, 0.0, 0);
+    return true;
+  }
+  UpdateFrameInterval(image->measurement_time());
+  cyber::Async([this, image]() {
+    Encode(image);
+    pending_encodes_.fetch_sub(1);
+  });
+  return true;
+}
+
+bool CompressComponent::Encode(const std::shared_ptr<Image>& image) {
   auto compressed_image = image_pool_->GetObject();
   compressed_image->mutable_header()->CopyFrom(image->header());
   compressed_image->set_frame_id(image->frame_id());
@@ -58,8 +101,9 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   std::vector<int> params;
   params.resize(3, 0);
   params[0] = CV_IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
+  params[1] = jpeg_quality_.load();
 
+  const auto start = std::chrono::steady_clock::now();
   try {
     cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
                       const_cast<char*>(image->data().data()), image->step());
@@ -70,8 +114,12 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
       AERROR << "cv::imencode (jpeg) failed on input image";
       return false;
     }
+    const double latency_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
     compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
     writer_->Write(compressed_image);
+    UpdateStats(false, latency_ms, compress_buffer.size());
   } catch (std::exception& e) {
     AERROR << "cv::imencode (jpeg) exception :" << e.what();
     return false;
@@ -79,6 +127,69 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   return true;
 }
 
+void CompressComponent::UpdateFrameInterval(double measurement_time) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  const double interval = measurement_time - last_measurement_time_;
+  if (last_measurement_time_ > 0.0 && interval > 0.0) {
+    frame_interval_s_ = MovingAverage(frame_interval_s_, interval);
+  }
+  last_measurement_time_ = measurement_time;
+}
+
+void CompressComponent::UpdateStats(bool dropped, double latency_ms,
+                                    size_t compressed_size) {
+  const auto& compress_conf = config_.compress_conf();
+  CompressStats report;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    if (dropped) {
+      stats_.set_dropped_frames(stats_.dropped_frames() + 1);
+      return;
+    }
+    stats_.set_encoded_frames(stats_.encoded_frames() + 1);
+    stats_.set_max_encode_latency_ms(
+        std::max(stats_.max_encode_latency_ms(), latency_ms));
+    total_latency_ms_ += latency_ms;
+
+    frame_bytes_ =
+        MovingAverage(frame_bytes_, static_cast<double>(compressed_size));
+    double bitrate_kbps = 0.0;
+    if (frame_interval_s_ > 0.0) {
+      bitrate_kbps = frame_bytes_ * 8.0 / frame_interval_s_ / 1000.0;
+    }
+    const double max_bitrate_kbps = compress_conf.max_bitrate_kbps();
+    if (max_bitrate_kbps > 0.0 && bitrate_kbps > 0.0) {
+      int quality = jpeg_quality_.load();
+      if (bitrate_kbps > max_bitrate_kbps) {
+        quality = std::max(quality - 1, compress_conf.min_jpeg_quality());
+      } else if (bitrate_kbps < 0.9 * max_bitrate_kbps) {
+        quality = std::min(quality + 1, compress_conf.jpeg_quality());
+      }
+      jpeg_quality_ = quality;
+    }
+
+    if (stats_writer_ == nullptr ||
+        stats_.encoded_frames() < compress_conf.stats_interval_frames()) {
+      return;
+    }
+    report.Swap(&stats_);
+    report.set_mean_encode_latency_ms(total_latency_ms_ /
+                                      report.encoded_frames());
+    report.set_jpeg_quality(jpeg_quality_.load());
+    report.set_bitrate_kbps(bitrate_kbps);
+    total_latency_ms_ = 0.0;
+  }
+  report.mutable_header()->set_timestamp_sec(cyber::Time::Now().ToSecond());
+  stats_writer_->Write(report);
+}
+
+CompressComponent::~CompressComponent() {
+  // encodes in flight still use this component
+  while (pending_encodes_.load() > 0) {
+    cyber::SleepFor(std::chrono::milliseconds(1));
+  }
+}
+
 }  // namespace camera
 }  // namespace drivers
 }  // namespace apollo
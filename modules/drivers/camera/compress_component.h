@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/drivers/camera/proto/compress_stats.pb.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 
@@ -37,11 +40,29 @@ class CompressComponent : public Component<Image> {
  public:
   bool Init() override;
   bool Proc(const std::shared_ptr<Image>& image) override;
+  ~CompressComponent();
 
  private:
+  bool Encode(const std::shared_ptr<Image>& image);
+  void UpdateFrameInterval(double measurement_time);
+  // records one encoded or dropped frame, adapts the jpeg quality to the
+  // bitrate limit and publishes the stats when a report is due
+  void UpdateStats(bool dropped, double latency_ms, size_t compressed_size);
+
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
+  std::shared_ptr<Writer<CompressStats>> stats_writer_ = nullptr;
   Config config_;
+
+  std::atomic<uint32_t> pending_encodes_ = {0};
+  std::atomic<int> jpeg_quality_ = {95};
+  std::mutex stats_mutex_;
+  CompressStats stats_;
+  double total_latency_ms_ = 0.0;
+  double last_measurement_time_ = 0.0;
+  // moving averages of the frame interval and of the compressed frame size
+  double frame_interval_s_ = 0.0;
+  double frame_bytes_ = 0.0;
 };
 
 CYBER_REGISTER_COMPONENT(CompressComponent)
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @brief A camera frame with a fixed layout, so that it can be built in a
+ * loaned shared memory block and published without serialization. The frame
+ * is written straight from the v4l2 buffer into data, which makes it the only
+ * copy of the image on its way to the shm readers.
+ */
+struct LoanedImage {
+  // large enough for a 1920x1080 rgb8 frame
+  static const uint32_t kMaxDataSize = 1920 * 1080 * 3;
+
+  // data is left uninitialized, a loan must not clear megabytes per frame
+  LoanedImage()
+      : timestamp_sec(0.0),
+        measurement_time(0.0),
+        sequence_num(0),
+        width(0),
+        height(0),
+        step(0),
+        data_size(0),
+        frame_id{},
+        encoding{} {}
+
+  double timestamp_sec;
+  double measurement_time;
+  uint32_t sequence_num;
+  uint32_t width;
+  uint32_t height;
+  uint32_t step;
+  uint32_t data_size;
+  char frame_id[64];
+  char encoding[16];
+  uint8_t data[kMaxDataSize];
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -192,9 +192,13 @@ void UsbCam::mjpeg2rgb(char* mjpeg_buffer, int len, char* rgb_buffer,
 }
 
 bool UsbCam::poll(const CameraImagePtr& raw_image) {
-  raw_image->is_new = 0;
   // free memory in this struct desturctor
   memset(raw_image->image, 0, raw_image->image_size * sizeof(char));
+  return poll(raw_image, raw_image->image);
+}
+
+bool UsbCam::poll(const CameraImagePtr& raw_image, char* image) {
+  raw_image->is_new = 0;
 
   fd_set fds;
   struct timeval tv;
@@ -223,7 +227,7 @@ bool UsbCam::poll(const CameraImagePtr& raw_image) {
     reconnect();
   }
 
-  int get_new_image = read_frame(raw_image);
+  int get_new_image = read_frame(raw_image, image);
 
   if (!get_new_image) {
     return false;
@@ -731,7 +735,7 @@ bool UsbCam::stop_capturing(void) {
   return true;
 }
 
-bool UsbCam::read_frame(CameraImagePtr raw_image) {
+bool UsbCam::read_frame(CameraImagePtr raw_image, char* image) {
   struct v4l2_buffer buf;
   unsigned int i = 0;
   int len = 0;
@@ -758,7 +762,7 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
         }
       }
 
-      process_image(buffers_[0].start, len, raw_image);
+      process_image(buffers_[0].start, len, raw_image, image);
 
       break;
 
@@ -830,7 +834,7 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
         AERROR << "Wrong Buffer Len: " << len
                << ", dev: " << config_->camera_dev();
       } else {
-        process_image(buffers_[buf.index].start, len, raw_image);
+        process_image(buffers_[buf.index].start, len, raw_image, image);
       }
 
       if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) {
@@ -872,7 +876,8 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
 
       assert(i < n_buffers_);
       len = buf.bytesused;
-      process_image(reinterpret_cast<void*>(buf.m.userptr), len, raw_image);
+      process_image(reinterpret_cast<void*>(buf.m.userptr), len, raw_image,
+                    image);
 
       if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) {
         AERROR << "VIDIOC_QBUF";
@@ -890,17 +895,18 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
   return true;
 }
 
-bool UsbCam::process_image(const void* src, int len, CameraImagePtr dest) {
-  if (src == nullptr || dest == nullptr) {
+bool UsbCam::process_image(const void* src, int len, CameraImagePtr dest,
+                           char* image) {
+  if (src == nullptr || dest == nullptr || image == nullptr) {
     AERROR << "process image error. src or dest is null";
     return false;
   }
   if (pixel_format_ == V4L2_PIX_FMT_YUYV ||
       pixel_format_ == V4L2_PIX_FMT_UYVY) {
     if (config_->output_type() == YUYV) {
-      memcpy(dest->image, src, dest->width * dest->height * 2);
+      memcpy(image, src, dest->width * dest->height * 2);
     } else if (config_->output_type() == RGB) {
-      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)dest->image,
+      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)image,
                    dest->width * dest->height);
     } else {
       AERROR << "unsupported output format:" << config_->output_type();
@@ -110,6 +110,9 @@ class UsbCam {
   virtual bool init(const std::shared_ptr<Config>& camera_config);
   // user use this function to get camera frame data
   virtual bool poll(const CameraImagePtr& raw_image);
+  // same as above, but writes the frame data into image, which must hold
+  // raw_image->image_size bytes, instead of raw_image->image
+  virtual bool poll(const CameraImagePtr& raw_image, char* image);
 
   bool is_capturing();
   bool wait_for_device(void);
@@ -135,8 +138,9 @@ class UsbCam {
   bool set_adv_trigger(void);
   bool close_device(void);
   bool open_device(void);
-  bool read_frame(CameraImagePtr raw_image);
-  bool process_image(const void* src, int len, CameraImagePtr dest);
+  bool read_frame(CameraImagePtr raw_image, char* image);
+  bool process_image(const void* src, int len, CameraImagePtr dest,
+                     char* image);
   bool start_capturing(void);
   bool stop_capturing(void);
   void reconnect();
@@ -22,6 +22,8 @@
 
 #include "modules/drivers/canbus/can_client/socket/socket_can_client_raw.h"
 
+#include <algorithm>
+
 namespace apollo {
 namespace drivers {
 namespace canbus {
@@ -29,6 +31,23 @@ namespace can {
 
 using apollo::common::ErrorCode;
 
+namespace {
+
+// The kernel receive time of a message, or fallback if it carries none.
+timeval ReceiveTime(msghdr *msg, const timeval &fallback) {
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval receive_time;
+      std::memcpy(&receive_time, CMSG_DATA(cmsg), sizeof(receive_time));
+      return receive_time;
+    }
+  }
+  return fallback;
+}
+
+}  // namespace
+
 bool SocketCanClientRaw::Init(const CANCardParameter &parameter) {
   if (!parameter.has_channel_id()) {
     AERROR << "Init CAN failed: parameter does not have channel id. The "
@@ -95,6 +114,14 @@ ErrorCode SocketCanClientRaw::Start() {
     return ErrorCode::CAN_CLIENT_ERROR_BASE;
   }
 
+  // 3. stamp received frames in the kernel.
+  kernel_timestamp_ = ::setsockopt(dev_handler_, SOL_SOCKET, SO_TIMESTAMP,
+                                   &enable, sizeof(enable)) == 0;
+  if (!kernel_timestamp_) {
+    AWARN << "kernel receive timestamps are not available, frames are "
+             "stamped when read.";
+  }
+
   std::string can_name("can" + std::to_string(port_));
   std::strncpy(ifr.ifr_name, can_name.c_str(), IFNAMSIZ);
   if (ioctl(dev_handler_, SIOCGIFINDEX, &ifr) < 0) {
@@ -141,7 +168,9 @@ ErrorCode SocketCanClientRaw::Send(const std::vector<CanFrame> &frames,
     AERROR << "Nvidia can client has not been initiated! Please init first!";
     return ErrorCode::CAN_CLIENT_ERROR_SEND_FAILED;
   }
-  for (size_t i = 0; i < frames.size() && i < MAX_CAN_SEND_FRAME_LEN; ++i) {
+  const size_t frame_count =
+      std::min(frames.size(), static_cast<size_t>(MAX_CAN_SEND_FRAME_LEN));
+  for (size_t i = 0; i < frame_count; ++i) {
     if (frames[i].len != CANBUS_MESSAGE_LENGTH) {
       AERROR << "frames[" << i << "].len = " << frames[i].len
              << ", which is not equal to can message data length ("
@@ -152,19 +181,25 @@ ErrorCode SocketCanClientRaw::Send(const std::vector<CanFrame> &frames,
     send_frames_[i].can_dlc = frames[i].len;
     std::memcpy(send_frames_[i].data, frames[i].data, frames[i].len);
 
-    // Synchronous transmission of CAN messages
-    int ret = static_cast<int>(
-        write(dev_handler_, &send_frames_[i], sizeof(send_frames_[i])));
-    if (ret <= 0) {
-      AERROR << "send message failed, error code: " << ret;
-      return ErrorCode::CAN_CLIENT_ERROR_BASE;
-    }
+    send_iovecs_[i].iov_base = &send_frames_[i];
+    send_iovecs_[i].iov_len = sizeof(send_frames_[i]);
+    send_msgs_[i].msg_hdr = msghdr{};
+    send_msgs_[i].msg_hdr.msg_iov = &send_iovecs_[i];
+    send_msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // Synchronous transmission of CAN messages, all in one system call
+  int ret = sendmmsg(dev_handler_, send_msgs_,
+                     static_cast<unsigned int>(frame_count), 0);
+  if (ret < 0 || static_cast<size_t>(ret) < frame_count) {
+    AERROR << "send message failed, error code: " << ret;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
   }
 
   return ErrorCode::OK;
 }
 
-// buf size must be 8 bytes, every time, we receive only one frame
+// buf size must be 8 bytes, every time, we receive the frames already queued
 ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
                                       int32_t *const frame_num) {
   if (!is_started_) {
@@ -179,14 +214,37 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
   }
 
-  for (int32_t i = 0; i < *frame_num && i < MAX_CAN_RECV_FRAME_LEN; ++i) {
-    CanFrame cf;
-    auto ret = read(dev_handler_, &recv_frames_[i], sizeof(recv_frames_[i]));
+  if (*frame_num == 0) {
+    return ErrorCode::OK;
+  }
 
-    if (ret < 0) {
-      AERROR << "receive message failed, error code: " << ret;
-      return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  for (int32_t i = 0; i < *frame_num; ++i) {
+    recv_iovecs_[i].iov_base = &recv_frames_[i];
+    recv_iovecs_[i].iov_len = sizeof(recv_frames_[i]);
+    msghdr &msg = recv_msgs_[i].msg_hdr;
+    msg = msghdr{};
+    msg.msg_iov = &recv_iovecs_[i];
+    msg.msg_iovlen = 1;
+    if (kernel_timestamp_) {
+      msg.msg_control = recv_controls_[i];
+      msg.msg_controllen = sizeof(recv_controls_[i]);
     }
+  }
+
+  // wait for the first frame, then take the ones already queued behind it
+  int ret = recvmmsg(dev_handler_, recv_msgs_,
+                     static_cast<unsigned int>(*frame_num), MSG_WAITFORONE,
+                     nullptr);
+  if (ret < 0) {
+    AERROR << "receive message failed, error code: " << ret;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
+  *frame_num = ret;
+
+  timeval now;
+  gettimeofday(&now, nullptr);
+  for (int32_t i = 0; i < ret; ++i) {
+    CanFrame cf;
     if (recv_frames_[i].can_dlc != CANBUS_MESSAGE_LENGTH) {
       AERROR << "recv_frames_[" << i
              << "].can_dlc = " << recv_frames_[i].can_dlc
@@ -197,6 +255,7 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     cf.id = recv_frames_[i].can_id;
     cf.len = recv_frames_[i].can_dlc;
     std::memcpy(cf.data, recv_frames_[i].data, recv_frames_[i].can_dlc);
+    cf.timestamp = ReceiveTime(&recv_msgs_[i].msg_hdr, now);
     frames->push_back(cf);
   }
   return ErrorCode::OK;
@@ -29,6 +29,7 @@
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <sys/types.h>
 
 #include <linux/can.h>
@@ -84,7 +85,7 @@ class SocketCanClientRaw : public CanClient {
   void Stop() override;
 
   /**
-   * @brief Send messages
+   * @brief Send messages with a single system call.
    * @param frames The messages to send.
    * @param frame_num The amount of messages to send.
    * @return The status of the sending action which is defined by
@@ -94,9 +95,12 @@ class SocketCanClientRaw : public CanClient {
                                  int32_t *const frame_num) override;
 
   /**
-   * @brief Receive messages
+   * @brief Receive messages. Waits for the first message, then takes up to
+   *        frame_num messages already queued in the socket with a single
+   *        system call. Each message is stamped with its kernel receive time.
    * @param frames The messages to receive.
-   * @param frame_num The amount of messages to receive.
+   * @param frame_num The amount of messages to receive, set to the amount of
+   *        messages received.
    * @return The status of the receiving action which is defined by
    *         apollo::common::ErrorCode.
    */
@@ -113,7 +117,13 @@ class SocketCanClientRaw : public CanClient {
   int dev_handler_ = 0;
   CANCardParameter::CANChannelId port_;
   can_frame send_frames_[MAX_CAN_SEND_FRAME_LEN];
+  iovec send_iovecs_[MAX_CAN_SEND_FRAME_LEN];
+  mmsghdr send_msgs_[MAX_CAN_SEND_FRAME_LEN];
   can_frame recv_frames_[MAX_CAN_RECV_FRAME_LEN];
+  char recv_controls_[MAX_CAN_RECV_FRAME_LEN][CMSG_SPACE(sizeof(timeval))];
+  iovec recv_iovecs_[MAX_CAN_RECV_FRAME_LEN];
+  mmsghdr recv_msgs_[MAX_CAN_RECV_FRAME_LEN];
+  bool kernel_timestamp_ = false;
 };
 
 }  // namespace can
@@ -21,8 +21,12 @@
 
 #pragma once
 
+#include <time.h>
+
 #include <algorithm>
 #include <array>
+#include <cerrno>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -111,6 +115,12 @@ class SenderMessage {
    */
   int32_t curr_period() const;
 
+  /**
+   * @brief Get the period from protocol data to send messages.
+   * @return The period in microseconds.
+   */
+  int32_t period() const;
+
  private:
   uint32_t message_id_ = 0;
   ProtocolData<SensorType> *protocol_data_ = nullptr;
@@ -131,6 +141,16 @@ class SenderMessage {
 template <typename SensorType>
 class CanSender {
  public:
+  /**
+   * @brief Transmit timing statistics of one CAN id.
+   */
+  struct SendStats {
+    uint64_t sent_frames = 0;
+    uint64_t missed_deadlines = 0;
+    int64_t total_jitter_us = 0;
+    int64_t max_jitter_us = 0;
+  };
+
   /**
    * @brief Constructor.
    */
@@ -184,10 +204,17 @@ class CanSender {
   bool IsRunning() const;
   bool enable_log() const;
 
+  /**
+   * @brief Get the transmit timing statistics keyed by CAN id.
+   *        The jitter of a frame is how far it was sent from its deadline.
+   */
+  std::unordered_map<uint32_t, SendStats> GetSendStats() const;
+
   FRIEND_TEST(CanSenderTest, OneRunCase);
 
  private:
   void PowerSendThreadFunc();
+  void SendFrames(const std::vector<CanFrame> &can_frames);
 
   bool NeedSend(const SenderMessage<SensorType> &msg,
                 const int32_t delta_period);
@@ -199,11 +226,23 @@ class CanSender {
   std::unique_ptr<std::thread> thread_;
   bool enable_log_ = false;
 
+  mutable std::mutex stats_mutex_;
+  std::unordered_map<uint32_t, SendStats> send_stats_;
+
   DISALLOW_COPY_AND_ASSIGN(CanSender);
 };
 
 const uint32_t kSenderInterval = 6000;
 
+// Frames due within this window of the earliest deadline are sent together.
+const int64_t kSenderCoalesceWindowNs = 200 * 1000;
+
+inline int64_t MonotonicNowNs() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
 template <typename SensorType>
 std::mutex SenderMessage<SensorType>::mutex_;
 
@@ -269,6 +308,11 @@ int32_t SenderMessage<SensorType>::curr_period() const {
   return curr_period_;
 }
 
+template <typename SensorType>
+int32_t SenderMessage<SensorType>::period() const {
+  return period_;
+}
+
 template <typename SensorType>
 void CanSender<SensorType>::PowerSendThreadFunc() {
   CHECK_NOTNULL(can_client_);
@@ -276,53 +320,82 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
   sch.sched_priority = 99;
   pthread_setschedparam(pthread_self(), SCHED_FIFO, &sch);
 
-  const int32_t INIT_PERIOD = 5000;  // 5ms
-  int32_t delta_period = INIT_PERIOD;
-  int32_t new_delta_period = INIT_PERIOD;
-
-  int64_t tm_start = 0;
-  int64_t tm_end = 0;
-  int64_t sleep_interval = 0;
+  // Every message keeps an absolute deadline on the monotonic clock, so
+  // the time spent sending never accumulates into the period.
+  const int64_t start_ns = MonotonicNowNs();
+  std::vector<int64_t> deadlines(send_messages_.size(), start_ns);
+  std::vector<CanFrame> can_frames;
+  can_frames.reserve(send_messages_.size());
 
   AINFO << "Can client sender thread starts.";
 
-  while (is_running_) {
-    tm_start =
-        common::time::AsInt64<common::time::micros>(common::time::Clock::Now());
-    new_delta_period = INIT_PERIOD;
-
-    for (auto &message : send_messages_) {
-      bool need_send = NeedSend(message, delta_period);
-      message.UpdateCurrPeriod(delta_period);
-      new_delta_period = std::min(new_delta_period, message.curr_period());
+  while (is_running_ && !deadlines.empty()) {
+    const int64_t next_deadline =
+        *std::min_element(deadlines.begin(), deadlines.end());
+    const timespec wakeup = {
+        static_cast<time_t>(next_deadline / 1000000000),
+        static_cast<long>(next_deadline % 1000000000)};  // NOLINT
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup,
+                           nullptr) == EINTR) {
+    }
+    if (!is_running_) {
+      break;
+    }
 
-      if (!need_send) {
+    const int64_t now_ns = MonotonicNowNs();
+    can_frames.clear();
+    std::unique_lock<std::mutex> lock(stats_mutex_);
+    for (size_t i = 0; i < send_messages_.size(); ++i) {
+      if (deadlines[i] > now_ns + kSenderCoalesceWindowNs) {
         continue;
       }
-      std::vector<CanFrame> can_frames;
-      CanFrame can_frame = message.CanFrame();
-      can_frames.push_back(can_frame);
-      if (can_client_->SendSingleFrame(can_frames) != common::ErrorCode::OK) {
+      auto &message = send_messages_[i];
+      can_frames.push_back(message.CanFrame());
+
+      auto &stats = send_stats_[message.message_id()];
+      const int64_t jitter_us = std::abs(now_ns - deadlines[i]) / 1000;
+      ++stats.sent_frames;
+      stats.total_jitter_us += jitter_us;
+      stats.max_jitter_us = std::max(stats.max_jitter_us, jitter_us);
+
+      const int64_t period_ns =
+          static_cast<int64_t>(std::max(message.period(), 1)) * 1000;
+      deadlines[i] += period_ns;
+      if (deadlines[i] <= now_ns) {
+        // Skip the periods already missed instead of sending in a burst.
+        const int64_t missed = (now_ns - deadlines[i]) / period_ns + 1;
+        stats.missed_deadlines += static_cast<uint64_t>(missed);
+        deadlines[i] += missed * period_ns;
+      }
+    }
+    lock.unlock();
+    SendFrames(can_frames);
+  }
+  AINFO << "Can client sender thread stopped!";
+}
+
+template <typename SensorType>
+void CanSender<SensorType>::SendFrames(
+    const std::vector<CanFrame> &can_frames) {
+  // CAN clients take at most MAX_CAN_SEND_FRAME_LEN frames per call.
+  std::vector<CanFrame> batch;
+  for (size_t begin = 0; begin < can_frames.size();
+       begin += MAX_CAN_SEND_FRAME_LEN) {
+    const size_t end = std::min(can_frames.size(),
+                                begin + MAX_CAN_SEND_FRAME_LEN);
+    batch.assign(can_frames.begin() + begin, can_frames.begin() + end);
+    int32_t frame_num = static_cast<int32_t>(batch.size());
+    if (can_client_->Send(batch, &frame_num) != common::ErrorCode::OK) {
+      for (const auto &can_frame : batch) {
         AERROR << "Send msg failed:" << can_frame.CanFrameString();
       }
-      if (enable_log()) {
+    }
+    if (enable_log()) {
+      for (const auto &can_frame : batch) {
         ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
       }
     }
-    delta_period = new_delta_period;
-    tm_end =
-        common::time::AsInt64<common::time::micros>(common::time::Clock::Now());
-    sleep_interval = delta_period - (tm_end - tm_start);
-
-    if (sleep_interval > 0) {
-      std::this_thread::sleep_for(std::chrono::microseconds(sleep_interval));
-    } else {
-      // do not sleep
-      AWARN << "Too much time for calculation: " << tm_end - tm_start
-            << "us is more than minimum period: " << delta_period << "us";
-    }
   }
-  AINFO << "Can client sender thread stopped!";
 }
 
 template <typename SensorType>
@@ -383,6 +456,17 @@ void CanSender<SensorType>::Stop() {
       thread_->join();
     }
     thread_.reset();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (const auto &entry : send_stats_) {
+      const SendStats &stats = entry.second;
+      AINFO << "Can id " << std::hex << entry.first << std::dec << " sent "
+            << stats.sent_frames << " frames, missed "
+            << stats.missed_deadlines << " deadlines, mean jitter "
+            << stats.total_jitter_us /
+                   static_cast<int64_t>(std::max<uint64_t>(stats.sent_frames,
+                                                           1))
+            << "us, max jitter " << stats.max_jitter_us << "us";
+    }
   } else {
     AERROR << "CanSender is not running.";
   }
@@ -400,6 +484,13 @@ bool CanSender<SensorType>::enable_log() const {
   return enable_log_;
 }
 
+template <typename SensorType>
+std::unordered_map<uint32_t, typename CanSender<SensorType>::SendStats>
+CanSender<SensorType>::GetSendStats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return send_stats_;
+}
+
 template <typename SensorType>
 bool CanSender<SensorType>::NeedSend(const SenderMessage<SensorType> &msg,
                                      const int32_t delta_period) {
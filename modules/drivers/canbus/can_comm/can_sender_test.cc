@@ -51,6 +51,29 @@ TEST(CanSenderTest, OneRunCase) {
   EXPECT_FALSE(sender.IsRunning());
 }
 
+TEST(CanSenderTest, SendsOnDeadlines) {
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  can::FakeCanClient can_client;
+  sender.Init(&can_client, false);
+
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd);
+  sender.AddMessage(2, &mpd);
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  // The default period is 100ms, so both messages go out at 0, 100, 200ms.
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  sender.Stop();
+
+  const auto stats = sender.GetSendStats();
+  ASSERT_EQ(stats.size(), 2);
+  for (const uint32_t id : {1, 2}) {
+    EXPECT_GE(stats.at(id).sent_frames, 2);
+    EXPECT_LE(stats.at(id).sent_frames, 3);
+    EXPECT_EQ(stats.at(id).missed_deadlines, 0);
+    EXPECT_LE(stats.at(id).max_jitter_us, stats.at(id).total_jitter_us);
+  }
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
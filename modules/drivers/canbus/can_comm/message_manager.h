@@ -70,7 +70,7 @@ class MessageManager {
   /*
    * @brief constructor function
    */
-  MessageManager() {}
+  MessageManager() : dispatch_table_(DISPATCH_TABLE_SIZE) {}
   /*
    * @brief destructor function
    */
@@ -110,18 +110,38 @@ class MessageManager {
   void ResetSendMessages();
 
  protected:
+  /**
+   * @brief what Parse needs to know about one message id
+   */
+  struct DispatchEntry {
+    ProtocolData<SensorType> *protocol_data = nullptr;
+    CheckIdArg *check_id = nullptr;
+    bool received = false;
+  };
+
+  // every standard (11 bit) id has a slot, extended ids go to a hash map
+  static const uint32_t DISPATCH_TABLE_SIZE = 0x800;
+
   template <class T, bool need_check>
   void AddRecvProtocolData();
 
   template <class T, bool need_check>
   void AddSendProtocolData();
 
+  void AddDispatchEntry(const uint32_t message_id,
+                        ProtocolData<SensorType> *protocol_data,
+                        bool need_check);
+
+  DispatchEntry *FindDispatchEntry(const uint32_t message_id);
+
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> send_protocol_data_;
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> recv_protocol_data_;
 
   std::unordered_map<uint32_t, ProtocolData<SensorType> *> protocol_data_map_;
   std::unordered_map<uint32_t, CheckIdArg> check_ids_;
   std::set<uint32_t> received_ids_;
+  std::vector<DispatchEntry> dispatch_table_;
+  std::unordered_map<uint32_t, DispatchEntry> extended_dispatch_table_;
 
   std::mutex sensor_data_mutex_;
   SensorType sensor_data_;
@@ -145,6 +165,7 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
     check_ids_[T::ID].last_time = 0;
     check_ids_[T::ID].error_count = 0;
   }
+  AddDispatchEntry(T::ID, dt, need_check);
 }
 
 template <typename SensorType>
@@ -162,46 +183,76 @@ void MessageManager<SensorType>::AddSendProtocolData() {
     check_ids_[T::ID].last_time = 0;
     check_ids_[T::ID].error_count = 0;
   }
+  AddDispatchEntry(T::ID, dt, need_check);
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::AddDispatchEntry(
+    const uint32_t message_id, ProtocolData<SensorType> *protocol_data,
+    bool need_check) {
+  DispatchEntry &entry = message_id < DISPATCH_TABLE_SIZE
+                             ? dispatch_table_[message_id]
+                             : extended_dispatch_table_[message_id];
+  entry.protocol_data = protocol_data;
+  if (need_check) {
+    // check_ids_ never erases, so the pointer stays valid through rehashes
+    entry.check_id = &check_ids_[message_id];
+  }
+}
+
+template <typename SensorType>
+typename MessageManager<SensorType>::DispatchEntry *
+MessageManager<SensorType>::FindDispatchEntry(const uint32_t message_id) {
+  if (message_id < DISPATCH_TABLE_SIZE) {
+    return &dispatch_table_[message_id];
+  }
+  auto it = extended_dispatch_table_.find(message_id);
+  return it == extended_dispatch_table_.end() ? nullptr : &it->second;
 }
 
 template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
-  if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
+  DispatchEntry *entry = FindDispatchEntry(message_id);
+  if (entry == nullptr || entry->protocol_data == nullptr) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
     return nullptr;
   }
-  return protocol_data_map_[message_id];
+  return entry->protocol_data;
 }
 
 template <typename SensorType>
 void MessageManager<SensorType>::Parse(const uint32_t message_id,
                                        const uint8_t *data, int32_t length) {
-  ProtocolData<SensorType> *protocol_data =
-      GetMutableProtocolDataById(message_id);
-  if (protocol_data == nullptr) {
+  DispatchEntry *entry = FindDispatchEntry(message_id);
+  if (entry == nullptr || entry->protocol_data == nullptr) {
+    ADEBUG << "Unable to get protocol data because of invalid message_id:"
+           << Byte::byte_to_hex(message_id);
     return;
   }
   {
     std::lock_guard<std::mutex> lock(sensor_data_mutex_);
-    protocol_data->Parse(data, length, &sensor_data_);
+    entry->protocol_data->Parse(data, length, &sensor_data_);
+  }
+  if (!entry->received) {
+    received_ids_.insert(message_id);
+    entry->received = true;
   }
-  received_ids_.insert(message_id);
   // check if need to check period
-  const auto it = check_ids_.find(message_id);
-  if (it != check_ids_.end()) {
+  CheckIdArg *check_id = entry->check_id;
+  if (check_id != nullptr) {
     const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
-    it->second.real_period = time - it->second.last_time;
+    check_id->real_period = time - check_id->last_time;
     // if period 1.5 large than base period, inc error_count
     const double period_multiplier = 1.5;
-    if (it->second.real_period > (it->second.period * period_multiplier)) {
-      it->second.error_count += 1;
+    if (check_id->real_period > (check_id->period * period_multiplier)) {
+      check_id->error_count += 1;
     } else {
-      it->second.error_count = 0;
+      check_id->error_count = 0;
     }
-    it->second.last_time = time;
+    check_id->last_time = time;
   }
 }
 
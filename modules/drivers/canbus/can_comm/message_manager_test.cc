@@ -36,12 +36,25 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockExtendedProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x18FEF100;
+  MockExtendedProtocolData() {}
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    ++parse_count;
+  }
+  mutable int parse_count = 0;
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockExtendedProtocolData, false>();
   }
 };
 
@@ -59,6 +72,22 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, DispatchById) {
+  uint8_t mock_data[8] = {0};
+  MockMessageManager manager;
+  EXPECT_TRUE(manager.GetMutableProtocolDataById(0x112) == nullptr);
+  EXPECT_TRUE(manager.GetMutableProtocolDataById(0x18FEF101) == nullptr);
+
+  auto *extended = dynamic_cast<MockExtendedProtocolData *>(
+      manager.GetMutableProtocolDataById(MockExtendedProtocolData::ID));
+  ASSERT_TRUE(extended != nullptr);
+  manager.Parse(MockExtendedProtocolData::ID, mock_data, 8);
+  manager.Parse(MockExtendedProtocolData::ID, mock_data, 8);
+  manager.Parse(0x18FEF101, mock_data, 8);
+  manager.Parse(0x112, mock_data, 8);
+  EXPECT_EQ(extended->parse_count, 2);
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/drivers/common/packed_point_cloud.h"
+
+#include <cstring>
+#include <string>
+
+namespace apollo {
+namespace drivers {
+
+bool HasPackedPoints(const PointCloud& cloud) {
+  return !cloud.packed_point().empty();
+}
+
+int PointNum(const PointCloud& cloud) {
+  if (HasPackedPoints(cloud)) {
+    return static_cast<int>(cloud.packed_point().size() / sizeof(PackedPoint));
+  }
+  return cloud.point_size();
+}
+
+PackedPoint GetPoint(const PointCloud& cloud, int index) {
+  PackedPoint point;
+  if (HasPackedPoints(cloud)) {
+    std::memcpy(&point, cloud.packed_point().data() + index * sizeof(point),
+                sizeof(point));
+    return point;
+  }
+  const PointXYZIT& source = cloud.point(index);
+  point.x = source.x();
+  point.y = source.y();
+  point.z = source.z();
+  point.intensity = source.intensity();
+  point.timestamp = source.timestamp();
+  return point;
+}
+
+PackedPoint* ResizePackedPoints(int num, PointCloud* cloud) {
+  cloud->clear_point();
+  std::string* packed_point = cloud->mutable_packed_point();
+  packed_point->resize(num * sizeof(PackedPoint));
+  return reinterpret_cast<PackedPoint*>(&(*packed_point)[0]);
+}
+
+void ReservePackedPoints(int num, PointCloud* cloud) {
+  cloud->mutable_packed_point()->reserve(num * sizeof(PackedPoint));
+}
+
+void AddPackedPoint(const PackedPoint& point, PointCloud* cloud) {
+  cloud->mutable_packed_point()->append(
+      reinterpret_cast<const char*>(&point), sizeof(point));
+}
+
+void AddPoint(const PackedPoint& point, bool as_packed, PointCloud* cloud) {
+  if (as_packed) {
+    AddPackedPoint(point, cloud);
+    return;
+  }
+  PointXYZIT* point_new = cloud->add_point();
+  point_new->set_x(point.x);
+  point_new->set_y(point.y);
+  point_new->set_z(point.z);
+  point_new->set_intensity(point.intensity);
+  point_new->set_timestamp(point.timestamp);
+}
+
+void PackPoints(PointCloud* cloud) {
+  if (HasPackedPoints(*cloud)) {
+    return;
+  }
+  const int num = cloud->point_size();
+  std::string packed_point(num * sizeof(PackedPoint), '\0');
+  PackedPoint* points = reinterpret_cast<PackedPoint*>(&packed_point[0]);
+  for (int i = 0; i < num; ++i) {
+    points[i] = GetPoint(*cloud, i);
+  }
+  cloud->clear_point();
+  cloud->mutable_packed_point()->swap(packed_point);
+}
+
+void UnpackPoints(PointCloud* cloud) {
+  if (!HasPackedPoints(*cloud)) {
+    return;
+  }
+  const int num = PointNum(*cloud);
+  cloud->mutable_point()->Reserve(num);
+  for (int i = 0; i < num; ++i) {
+    AddPoint(GetPoint(*cloud, i), false, cloud);
+  }
+  cloud->clear_packed_point();
+}
+
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Accessors of the points of a drivers::PointCloud that work the same on
+ * the repeated PointXYZIT points and on the packed_point records.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "modules/drivers/proto/pointcloud.pb.h"
+
+namespace apollo {
+namespace drivers {
+
+/**
+ * @brief One record of PointCloud::packed_point.
+ */
+struct PackedPoint {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  uint32_t intensity = 0;
+  uint64_t timestamp = 0;
+};
+
+static_assert(sizeof(PackedPoint) == 24,
+              "PackedPoint must match the packed_point record layout");
+
+/**
+ * @brief Whether the points of the cloud are in packed_point.
+ */
+bool HasPackedPoints(const PointCloud& cloud);
+
+/**
+ * @brief Number of points in either representation.
+ */
+int PointNum(const PointCloud& cloud);
+
+/**
+ * @brief The index-th point in either representation.
+ */
+PackedPoint GetPoint(const PointCloud& cloud, int index);
+
+/**
+ * @brief Drop the points of the cloud and make room for num packed points
+ * @return the records to fill in, valid until the cloud changes
+ */
+PackedPoint* ResizePackedPoints(int num, PointCloud* cloud);
+
+/**
+ * @brief Reserve room for num packed points, keeping the current ones.
+ */
+void ReservePackedPoints(int num, PointCloud* cloud);
+
+/**
+ * @brief Append a point to packed_point.
+ */
+void AddPackedPoint(const PackedPoint& point, PointCloud* cloud);
+
+/**
+ * @brief Append a point to packed_point if as_packed is set, to the repeated
+ * points otherwise.
+ */
+void AddPoint(const PackedPoint& point, bool as_packed, PointCloud* cloud);
+
+/**
+ * @brief Move the repeated points of the cloud into packed_point.
+ */
+void PackPoints(PointCloud* cloud);
+
+/**
+ * @brief Move the packed_point records of the cloud into repeated points.
+ */
+void UnpackPoints(PointCloud* cloud);
+
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/drivers/common/packed_point_cloud.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+
+namespace {
+
+PackedPoint MakePoint(int i) {
+  PackedPoint point;
+  point.x = 0.5f * static_cast<float>(i);
+  point.y = -0.25f * static_cast<float>(i);
+  point.z = i % 7 == 0 ? std::numeric_limits<float>::quiet_NaN() : 1.0f;
+  point.intensity = static_cast<uint32_t>(i % 256);
+  point.timestamp = 1500000000000000000ULL + static_cast<uint64_t>(i) * 1000;
+  return point;
+}
+
+void ExpectPointEq(const PackedPoint& expected, const PackedPoint& actual) {
+  EXPECT_EQ(expected.x, actual.x);
+  EXPECT_EQ(expected.y, actual.y);
+  if (std::isnan(expected.z)) {
+    EXPECT_TRUE(std::isnan(actual.z));
+  } else {
+    EXPECT_EQ(expected.z, actual.z);
+  }
+  EXPECT_EQ(expected.intensity, actual.intensity);
+  EXPECT_EQ(expected.timestamp, actual.timestamp);
+}
+
+}  // namespace
+
+TEST(PackedPointCloudTest, AddPoint) {
+  PointCloud repeated;
+  PointCloud packed;
+  for (int i = 0; i < 100; ++i) {
+    AddPoint(MakePoint(i), false, &repeated);
+    AddPoint(MakePoint(i), true, &packed);
+  }
+  EXPECT_FALSE(HasPackedPoints(repeated));
+  EXPECT_TRUE(HasPackedPoints(packed));
+  EXPECT_EQ(100, PointNum(repeated));
+  EXPECT_EQ(100, PointNum(packed));
+  EXPECT_EQ(0, packed.point_size());
+  EXPECT_EQ(100 * 24, static_cast<int>(packed.packed_point().size()));
+  for (int i = 0; i < 100; ++i) {
+    ExpectPointEq(MakePoint(i), GetPoint(repeated, i));
+    ExpectPointEq(MakePoint(i), GetPoint(packed, i));
+  }
+}
+
+TEST(PackedPointCloudTest, PackAndUnpack) {
+  PointCloud cloud;
+  for (int i = 0; i < 50; ++i) {
+    AddPoint(MakePoint(i), false, &cloud);
+  }
+  PackPoints(&cloud);
+  EXPECT_TRUE(HasPackedPoints(cloud));
+  EXPECT_EQ(0, cloud.point_size());
+  EXPECT_EQ(50, PointNum(cloud));
+
+  // the records survive serialization
+  PointCloud parsed;
+  ASSERT_TRUE(parsed.ParseFromString(cloud.SerializeAsString()));
+  for (int i = 0; i < 50; ++i) {
+    ExpectPointEq(MakePoint(i), GetPoint(parsed, i));
+  }
+
+  UnpackPoints(&parsed);
+  EXPECT_FALSE(HasPackedPoints(parsed));
+  EXPECT_EQ(50, parsed.point_size());
+  for (int i = 0; i < 50; ++i) {
+    ExpectPointEq(MakePoint(i), GetPoint(parsed, i));
+  }
+}
+
+TEST(PackedPointCloudTest, ResizePackedPoints) {
+  PointCloud cloud;
+  AddPoint(MakePoint(0), false, &cloud);
+  PackedPoint* points = ResizePackedPoints(10, &cloud);
+  for (int i = 0; i < 10; ++i) {
+    points[i] = MakePoint(i + 1);
+  }
+  EXPECT_EQ(0, cloud.point_size());
+  EXPECT_EQ(10, PointNum(cloud));
+  ExpectPointEq(MakePoint(10), GetPoint(cloud, 9));
+}
+
+}  // namespace drivers
+}  // namespace apollo
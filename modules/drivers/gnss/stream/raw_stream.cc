@@ -485,6 +485,8 @@ void RawStream::DataSpin() {
         AERROR << "New data sting msg failed.";
         continue;
       }
+      // stamp the bytes as close to their arrival as possible
+      common::util::FillHeader("gnss", msg_pub.get());
       msg_pub->set_data(reinterpret_cast<const char *>(buffer_), length);
       raw_writer_->Write(msg_pub);
       data_parser_ptr_->ParseRawData(msg_pub->data());
@@ -523,6 +525,7 @@ void RawStream::RtkSpin() {
 void RawStream::PublishRtkData(const size_t length) {
   std::shared_ptr<RawData> rtk_msg = std::make_shared<RawData>();
   CHECK_NOTNULL(rtk_msg);
+  common::util::FillHeader("gnss", rtk_msg.get());
   rtk_msg->set_data(reinterpret_cast<const char *>(buffer_rtk_), length);
   rtcm_writer_->Write(rtk_msg);
   rtcm_parser_ptr_->ParseRtcmData(rtk_msg->data());
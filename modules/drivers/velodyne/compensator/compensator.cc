@@ -16,13 +16,32 @@
 
 #include "modules/drivers/velodyne/compensator/compensator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "cyber/task/task.h"
+#include "modules/drivers/common/packed_point_cloud.h"
 
 namespace apollo {
 namespace drivers {
 namespace velodyne {
+namespace {
+
+// Points compensated by one task of the parallel loop.
+constexpr int kPointsPerBlock = 4096;
+
+// The rotation of a point is interpolated linearly between the two nearest
+// of kRotationStepNum + 1 rotations evenly spread over the scan. Even for a
+// rotation of 0.5 rad during a scan, this is less than 1 mm away from the
+// slerp at 100 m.
+constexpr int kRotationStepNum = 64;
+
+}  // namespace
 
 bool Compensator::QueryPoseAffineFromTF2(const uint64_t& timestamp, void* pose,
                                          const std::string& child_frame_id) {
@@ -86,7 +105,11 @@ bool Compensator::MotionCompensation(
   uint64_t new_time = cyber::Time().Now().ToNanosecond();
   AINFO << "compenstator new msg diff:" << new_time - start
         << ";meta:" << msg->header().lidar_timestamp();
-  msg_compensated->mutable_point()->Reserve(240000);
+  if (HasPackedPoints(*msg)) {
+    ReservePackedPoints(PointNum(*msg), msg_compensated.get());
+  } else {
+    msg_compensated->mutable_point()->Reserve(240000);
+  }
 
   // compensate point cloud, remove nan point
   if (QueryPoseAffineFromTF2(timestamp_min, &pose_min_time, frame_id) &&
@@ -97,7 +120,7 @@ bool Compensator::MotionCompensation(
     MotionCompensation(msg, msg_compensated, timestamp_min, timestamp_max,
                        pose_min_time, pose_max_time);
     uint64_t com_time = cyber::Time().Now().ToNanosecond();
-    msg_compensated->set_width(msg_compensated->point_size() / msg->height());
+    msg_compensated->set_width(PointNum(*msg_compensated) / msg->height());
     AINFO << "compenstator com msg diff:" << com_time - tf_time
           << ";meta:" << msg->header().lidar_timestamp();
     return true;
@@ -111,8 +134,9 @@ inline void Compensator::GetTimestampInterval(
   *timestamp_max = 0;
   *timestamp_min = std::numeric_limits<uint64_t>::max();
 
-  for (const auto& point : msg->point()) {
-    uint64_t timestamp = point.timestamp();
+  const int point_num = PointNum(*msg);
+  for (int i = 0; i < point_num; ++i) {
+    uint64_t timestamp = GetPoint(*msg, i).timestamp;
     if (timestamp < *timestamp_min) {
       *timestamp_min = timestamp;
     }
@@ -142,10 +166,14 @@ void Compensator::MotionCompensation(
   translation = q_max.conjugate() * translation;
 
   // int total = msg->width * msg->height;
+  const bool as_packed = HasPackedPoints(*msg);
+  const int point_num = PointNum(*msg);
 
   double d = q0.dot(q1);
   double abs_d = abs(d);
-  double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
+  double f = timestamp_max > timestamp_min
+                 ? 1.0 / static_cast<double>(timestamp_max - timestamp_min)
+                 : 0.0;
 
   // Threshold for a "significant" rotation from min_time to max_time:
   // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an angle
@@ -153,69 +181,92 @@ void Compensator::MotionCompensation(
   // 0.0003 rad. So, we consider a rotation "significant" only if the scalar
   // part of quaternion is
   // less than cos(0.0003 / 2) = 1 - 1e-8.
-  if (abs_d < 1.0 - 1.0e-8) {
+  const bool rotate = abs_d < 1.0 - 1.0e-8;
+  // rotations[i] and the step to rotations[i + 1]
+  std::vector<std::pair<Eigen::Matrix3d, Eigen::Matrix3d>> rotations;
+  if (rotate) {
     double theta = acos(abs_d);
     double sin_theta = sin(theta);
     double c1_sign = (d > 0) ? 1 : -1;
-    for (const auto& point : msg->point()) {
-      float x_scalar = point.x();
-      if (std::isnan(x_scalar)) {
-        // if (config_.organized()) {
-        auto* point_new = msg_compensated->add_point();
-        point_new->CopyFrom(point);
-        // } else {
-        //   AERROR << "nan point do not need motion compensation";
-        // }
-        continue;
-      }
-      float y_scalar = point.y();
-      float z_scalar = point.z();
-      Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-      uint64_t tp = point.timestamp();
-      double t = static_cast<double>(timestamp_max - tp) * f;
-
-      Eigen::Translation3d ti(t * translation);
-
+    rotations.resize(kRotationStepNum + 1);
+    for (int i = 0; i <= kRotationStepNum; ++i) {
+      double t = static_cast<double>(i) / kRotationStepNum;
       double c0 = sin((1 - t) * theta) / sin_theta;
       double c1 = sin(t * theta) / sin_theta * c1_sign;
       Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
+      rotations[i].first = qi.toRotationMatrix();
+      if (i > 0) {
+        rotations[i - 1].second = rotations[i].first - rotations[i - 1].first;
+      }
+    }
+    rotations[kRotationStepNum].second.setZero();
+  }
+
+  // compensate the points in place, in the packed records of the output or
+  // in a copy of the repeated points
+  PackedPoint* points = nullptr;
+  std::vector<PackedPoint> unpacked_points;
+  if (as_packed) {
+    points = ResizePackedPoints(point_num, msg_compensated.get());
+    std::memcpy(points, msg->packed_point().data(),
+                point_num * sizeof(PackedPoint));
+  } else {
+    unpacked_points.resize(point_num);
+    points = unpacked_points.data();
+  }
+
+  const size_t block_num =
+      static_cast<size_t>((point_num + kPointsPerBlock - 1) / kPointsPerBlock);
+  cyber::ParallelFor(0, block_num, 1, [&](size_t block) {
+    const int begin = static_cast<int>(block) * kPointsPerBlock;
+    const int end = std::min(point_num, begin + kPointsPerBlock);
+    for (int i = begin; i < end; ++i) {
+      if (!as_packed) {
+        points[i] = GetPoint(*msg, i);
+      }
+      PackedPoint& point = points[i];
+      if (std::isnan(point.x)) {
+        continue;
+      }
+      Eigen::Vector3d p(point.x, point.y, point.z);
 
-      Eigen::Affine3d trans = ti * qi;
-      p = trans * p;
+      uint64_t tp = point.timestamp;
+      double t = static_cast<double>(timestamp_max - tp) * f;
+      if (rotate) {
+        const double step = t * kRotationStepNum;
+        const size_t index = static_cast<size_t>(step);
+        const auto& rotation = rotations[index];
+        p = rotation.first * p +
+            (step - static_cast<double>(index)) * (rotation.second * p);
+      }
+      p += t * translation;
 
-      auto* point_new = msg_compensated->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
-      point_new->set_x(static_cast<float>(p.x()));
-      point_new->set_y(static_cast<float>(p.y()));
-      point_new->set_z(static_cast<float>(p.z()));
+      point.x = static_cast<float>(p.x());
+      point.y = static_cast<float>(p.y());
+      point.z = static_cast<float>(p.z());
     }
+  });
+
+  if (rotate && as_packed) {
     return;
   }
-  // Not a "significant" rotation. Do translation only.
-  for (auto& point : msg->point()) {
-    float x_scalar = point.x();
-    if (std::isnan(x_scalar)) {
+  // Not a "significant" rotation. The translation only drops the nan points.
+  int kept_num = 0;
+  for (int i = 0; i < point_num; ++i) {
+    if (!rotate && std::isnan(points[i].x)) {
       AERROR << "nan point do not need motion compensation";
       continue;
     }
-    float y_scalar = point.y();
-    float z_scalar = point.z();
-    Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-    uint64_t tp = point.timestamp();
-    double t = static_cast<double>(timestamp_max - tp) * f;
-    Eigen::Translation3d ti(t * translation);
-
-    p = ti * p;
-
-    auto* point_new = msg_compensated->add_point();
-    point_new->set_intensity(point.intensity());
-    point_new->set_timestamp(point.timestamp());
-    point_new->set_x(static_cast<float>(p.x()));
-    point_new->set_y(static_cast<float>(p.y()));
-    point_new->set_z(static_cast<float>(p.z()));
+    if (as_packed) {
+      points[kept_num] = points[i];
+    } else {
+      AddPoint(points[i], false, msg_compensated.get());
+    }
+    ++kept_num;
+  }
+  if (as_packed) {
+    msg_compensated->mutable_packed_point()->resize(kept_num *
+                                                    sizeof(PackedPoint));
   }
 }
 
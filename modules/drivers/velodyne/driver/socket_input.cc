@@ -48,7 +48,22 @@ namespace velodyne {
  *  @param private_nh private node handle for driver
  *  @param udp_port UDP port number to connect
  */
-SocketInput::SocketInput() : sockfd_(-1), port_(0) {}
+SocketInput::SocketInput()
+    : sockfd_(-1),
+      port_(0),
+      kernel_timestamp_(false),
+      batch_stamp_(0),
+      batch_size_(0),
+      batch_index_(0) {
+  memset(batch_msgs_, 0, sizeof(batch_msgs_));
+  for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+    batch_iovecs_[i].iov_base = batch_bytes_[i];
+    batch_iovecs_[i].iov_len = FIRING_DATA_PACKET_SIZE;
+    batch_msgs_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+    batch_msgs_[i].msg_hdr.msg_iovlen = 1;
+    batch_msgs_[i].msg_hdr.msg_control = batch_controls_[i];
+  }
+}
 
 /** @brief destructor */
 SocketInput::~SocketInput(void) { (void)close(sockfd_); }
@@ -86,42 +101,89 @@ void SocketInput::init(const int &port) {
     return;
   }
 
+  // stamp the packets when the kernel receives them, the packets of a batch
+  // are handed out after they all arrived
+  int enable = 1;
+  kernel_timestamp_ = setsockopt(sockfd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                                 sizeof(enable)) == 0;
+  if (!kernel_timestamp_) {
+    AWARN << "No kernel timestamp on port " << port_
+          << ", packets are stamped at reception by the driver";
+  }
+  batch_size_ = 0;
+  batch_index_ = 0;
+
   AINFO << "Velodyne socket fd is " << sockfd_ << ", port " << port_;
 }
 
 /** @brief Get one velodyne packet. */
 int SocketInput::get_firing_data_packet(VelodynePacket *pkt) {
-  // double time1 = ros::Time::now().toSec();
-  double time1 = apollo::cyber::Time().Now().ToSecond();
   while (true) {
-    if (!input_available(POLL_TIMEOUT)) {
-      return SOCKET_TIMEOUT;
-    }
-    // Receive packets that should now be available from the
-    // socket using a blocking read.
-    uint8_t bytes[FIRING_DATA_PACKET_SIZE];
-    ssize_t nbytes =
-        recvfrom(sockfd_, bytes, FIRING_DATA_PACKET_SIZE, 0, nullptr, nullptr);
-
-    if (nbytes < 0) {
-      if (errno != EWOULDBLOCK) {
-        AERROR << "recvfail from port " << port_;
-        return RECIEVE_FAIL;
+    if (batch_index_ == batch_size_) {
+      int rc = receive_firing_data_packets();
+      if (rc != 0) {
+        return rc;
       }
+      continue;
     }
 
-    if ((size_t)nbytes == FIRING_DATA_PACKET_SIZE) {
+    msghdr *msg = &batch_msgs_[batch_index_].msg_hdr;
+    const unsigned int nbytes = batch_msgs_[batch_index_].msg_len;
+    const uint8_t *bytes = batch_bytes_[batch_index_];
+    ++batch_index_;
+
+    if (nbytes == FIRING_DATA_PACKET_SIZE) {
       // read successful, done now
       pkt->set_data(bytes, FIRING_DATA_PACKET_SIZE);
-      break;
+      uint64_t stamp = batch_stamp_;
+      for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+           cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET &&
+            cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+          timespec receive_time;
+          memcpy(&receive_time, CMSG_DATA(cmsg), sizeof(receive_time));
+          stamp = static_cast<uint64_t>(receive_time.tv_sec) * 1000000000ULL +
+                  static_cast<uint64_t>(receive_time.tv_nsec);
+          break;
+        }
+      }
+      pkt->set_stamp(stamp);
+      return 0;
     }
 
     AERROR << "Incomplete Velodyne rising data packet read: " << nbytes
            << " bytes from port " << port_;
   }
+}
+
+int SocketInput::receive_firing_data_packets() {
+  double time1 = apollo::cyber::Time().Now().ToSecond();
+  if (!input_available(POLL_TIMEOUT)) {
+    return SOCKET_TIMEOUT;
+  }
+
+  for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+    batch_msgs_[i].msg_hdr.msg_controllen =
+        kernel_timestamp_ ? sizeof(batch_controls_[i]) : 0;
+    batch_msgs_[i].msg_hdr.msg_flags = 0;
+  }
+  // Receive all the packets that are now available from the socket with a
+  // single non-blocking call.
+  int npackets =
+      recvmmsg(sockfd_, batch_msgs_, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
   double time2 = apollo::cyber::Time().Now().ToSecond();
-  pkt->set_stamp(apollo::cyber::Time((time2 + time1) / 2.0).ToNanosecond());
 
+  batch_index_ = 0;
+  batch_size_ = 0;
+  if (npackets < 0) {
+    if (errno != EWOULDBLOCK && errno != EAGAIN) {
+      AERROR << "recvfail from port " << port_;
+      return RECIEVE_FAIL;
+    }
+    return 0;
+  }
+  batch_size_ = npackets;
+  batch_stamp_ = apollo::cyber::Time((time2 + time1) / 2.0).ToNanosecond();
   return 0;
 }
 
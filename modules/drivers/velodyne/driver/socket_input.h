@@ -17,6 +17,8 @@
 #pragma once
 
 #include <stdio.h>
+#include <sys/socket.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "modules/drivers/velodyne/driver/input.h"
@@ -30,6 +32,8 @@ using apollo::drivers::velodyne::VelodynePacket;
 // static int FIRING_DATA_PORT = 2368;
 // static int POSITIONING_DATA_PORT = 8308;
 static const int POLL_TIMEOUT = 1000;  // one second (in msec)
+// firing data packets received by one recvmmsg() call at most
+static const int RECEIVE_BATCH_SIZE = 32;
 
 /** @brief Live Velodyne input from socket. */
 class SocketInput : public Input {
@@ -43,7 +47,26 @@ class SocketInput : public Input {
  private:
   int sockfd_;
   int port_;
+  // whether the kernel stamps the packets at reception (SO_TIMESTAMPNS)
+  bool kernel_timestamp_;
   bool input_available(int timeout);
+
+  /** @brief Receive the firing data packets waiting in the socket, with one
+   * recvmmsg() call.
+   *
+   * @returns 0 if successful, SOCKET_TIMEOUT or RECIEVE_FAIL otherwise
+   */
+  int receive_firing_data_packets();
+
+  // firing data packets of the last recvmmsg(), returned one by one by
+  // get_firing_data_packet()
+  uint8_t batch_bytes_[RECEIVE_BATCH_SIZE][FIRING_DATA_PACKET_SIZE];
+  char batch_controls_[RECEIVE_BATCH_SIZE][CMSG_SPACE(sizeof(timespec))];
+  iovec batch_iovecs_[RECEIVE_BATCH_SIZE];
+  mmsghdr batch_msgs_[RECEIVE_BATCH_SIZE];
+  uint64_t batch_stamp_;  // receive time of the batch (in nsec)
+  int batch_size_;
+  int batch_index_;
 };
 
 }  // namespace velodyne
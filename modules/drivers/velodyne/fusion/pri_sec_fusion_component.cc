@@ -14,10 +14,16 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <cstring>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "modules/drivers/velodyne/fusion/pri_sec_fusion_component.h"
 
+#include "cyber/task/task.h"
+#include "modules/drivers/common/packed_point_cloud.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -44,6 +50,8 @@ bool PriSecFusionComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
   auto target = point_cloud;
   auto fusion_readers = readers_;
+  // transformed points of the sources of the parallel fusion
+  std::vector<std::future<std::string>> transformed_sources;
   auto start_time = Time::Now().ToSecond();
   while ((Time::Now().ToSecond() - start_time) < conf_.wait_time_s() &&
          fusion_readers.size() > 0) {
@@ -53,6 +61,11 @@ bool PriSecFusionComponent::Proc(
         auto source = (*itr)->GetLatestObserved();
         if (conf_.drop_expired_data() && IsExpired(target, source)) {
           ++itr;
+        } else if (conf_.use_parallel_fusion()) {
+          transformed_sources.emplace_back(
+              cyber::Async(&PriSecFusionComponent::TransformPointCloud, this,
+                           target->header().frame_id(), source));
+          itr = fusion_readers.erase(itr);
         } else {
           Fusion(target, source);
           itr = fusion_readers.erase(itr);
@@ -63,6 +76,9 @@ bool PriSecFusionComponent::Proc(
     }
     usleep(USLEEP_INTERVAL);
   }
+  if (conf_.use_parallel_fusion()) {
+    MergePointClouds(target, &transformed_sources);
+  }
   fusion_writer_->Write(target);
 
   return true;
@@ -108,44 +124,86 @@ bool PriSecFusionComponent::QueryPoseAffine(const std::string& target_frame_id,
 void PriSecFusionComponent::AppendPointCloud(
     std::shared_ptr<PointCloud> point_cloud,
     std::shared_ptr<PointCloud> point_cloud_add, const Eigen::Affine3d& pose) {
-  if (std::isnan(pose(0, 0))) {
-    for (auto& point : point_cloud_add->point()) {
-      PointXYZIT* point_new = point_cloud->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
-      point_new->set_x(point.x());
-      point_new->set_y(point.y());
-      point_new->set_z(point.z());
+  // keep the representation of the target, a packed target may receive an
+  // unpacked source and the other way round
+  const bool as_packed = HasPackedPoints(*point_cloud) ||
+                         (PointNum(*point_cloud) == 0 &&
+                          HasPackedPoints(*point_cloud_add));
+  const int point_num = PointNum(*point_cloud_add);
+  if (as_packed) {
+    ReservePackedPoints(PointNum(*point_cloud) + point_num,
+                        point_cloud.get());
+  }
+  for (int i = 0; i < point_num; ++i) {
+    PackedPoint point = GetPoint(*point_cloud_add, i);
+    if (!std::isnan(pose(0, 0)) && !std::isnan(point.x)) {
+      Eigen::Matrix<float, 3, 1> pt(point.x, point.y, point.z);
+      point.x = static_cast<float>(
+          pose(0, 0) * pt.coeffRef(0) + pose(0, 1) * pt.coeffRef(1) +
+          pose(0, 2) * pt.coeffRef(2) + pose(0, 3));
+      point.y = static_cast<float>(
+          pose(1, 0) * pt.coeffRef(0) + pose(1, 1) * pt.coeffRef(1) +
+          pose(1, 2) * pt.coeffRef(2) + pose(1, 3));
+      point.z = static_cast<float>(
+          pose(2, 0) * pt.coeffRef(0) + pose(2, 1) * pt.coeffRef(1) +
+          pose(2, 2) * pt.coeffRef(2) + pose(2, 3));
     }
+    AddPoint(point, as_packed, point_cloud.get());
+  }
+
+  int new_width = PointNum(*point_cloud) / point_cloud->height();
+  point_cloud->set_width(new_width);
+}
+
+std::string PriSecFusionComponent::TransformPointCloud(
+    const std::string& target_frame_id, std::shared_ptr<PointCloud> source) {
+  Eigen::Affine3d pose;
+  if (!QueryPoseAffine(target_frame_id, source->header().frame_id(), &pose)) {
+    return std::string();
+  }
+  const int point_num = PointNum(*source);
+  std::string packed_point;
+  if (HasPackedPoints(*source)) {
+    packed_point = source->packed_point();
   } else {
-    for (auto& point : point_cloud_add->point()) {
-      if (std::isnan(point.x())) {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(point.timestamp());
-        point_new->set_x(point.x());
-        point_new->set_y(point.y());
-        point_new->set_z(point.z());
-      } else {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(point.timestamp());
-        Eigen::Matrix<float, 3, 1> pt(point.x(), point.y(), point.z());
-        point_new->set_x(static_cast<float>(
-            pose(0, 0) * pt.coeffRef(0) + pose(0, 1) * pt.coeffRef(1) +
-            pose(0, 2) * pt.coeffRef(2) + pose(0, 3)));
-        point_new->set_y(static_cast<float>(
-            pose(1, 0) * pt.coeffRef(0) + pose(1, 1) * pt.coeffRef(1) +
-            pose(1, 2) * pt.coeffRef(2) + pose(1, 3)));
-        point_new->set_z(static_cast<float>(
-            pose(2, 0) * pt.coeffRef(0) + pose(2, 1) * pt.coeffRef(1) +
-            pose(2, 2) * pt.coeffRef(2) + pose(2, 3)));
-      }
+    packed_point.resize(point_num * sizeof(PackedPoint));
+  }
+  PackedPoint* points = reinterpret_cast<PackedPoint*>(&packed_point[0]);
+  const Eigen::Matrix<double, 3, 4> transform = pose.matrix().topRows<3>();
+  const bool transform_valid = !std::isnan(transform(0, 0));
+  for (int i = 0; i < point_num; ++i) {
+    PackedPoint& point = points[i];
+    if (!HasPackedPoints(*source)) {
+      point = GetPoint(*source, i);
+    }
+    if (transform_valid && !std::isnan(point.x)) {
+      const Eigen::Vector3d p = transform.leftCols<3>() *
+                                    Eigen::Vector3d(point.x, point.y, point.z) +
+                                transform.col(3);
+      point.x = static_cast<float>(p.x());
+      point.y = static_cast<float>(p.y());
+      point.z = static_cast<float>(p.z());
     }
   }
+  return packed_point;
+}
 
-  int new_width = point_cloud->point_size() / point_cloud->height();
-  point_cloud->set_width(new_width);
+void PriSecFusionComponent::MergePointClouds(
+    std::shared_ptr<PointCloud> target,
+    std::vector<std::future<std::string>>* sources) {
+  std::vector<std::string> packed_points;
+  size_t size = PointNum(*target) * sizeof(PackedPoint);
+  for (auto& source : *sources) {
+    packed_points.emplace_back(source.get());
+    size += packed_points.back().size();
+  }
+  PackPoints(target.get());
+  std::string* target_points = target->mutable_packed_point();
+  target_points->reserve(size);
+  for (const auto& points : packed_points) {
+    target_points->append(points);
+  }
+  target->set_width(PointNum(*target) / target->height());
 }
 
 bool PriSecFusionComponent::Fusion(std::shared_ptr<PointCloud> target,
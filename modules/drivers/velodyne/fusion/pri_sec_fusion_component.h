@@ -17,6 +17,7 @@
 #pragma once
 
 #include <Eigen/Eigen>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -54,6 +55,20 @@ class PriSecFusionComponent : public Component<PointCloud> {
                         std::shared_ptr<PointCloud> point_cloud_add,
                         const Eigen::Affine3d& pose);
 
+  /**
+   * @brief Packed points of the source transformed into target_frame_id,
+   * empty if the transform is unknown. Runs on a task of the parallel fusion.
+   */
+  std::string TransformPointCloud(const std::string& target_frame_id,
+                                  std::shared_ptr<PointCloud> source);
+
+  /**
+   * @brief Append the packed points of the transformed sources to the target
+   * with one copy per source, turning the target into a packed cloud.
+   */
+  void MergePointClouds(std::shared_ptr<PointCloud> target,
+                        std::vector<std::future<std::string>>* sources);
+
   FusionConfig conf_;
   apollo::transform::Buffer* buffer_ptr_ = nullptr;
   std::shared_ptr<Writer<PointCloud>> fusion_writer_;
@@ -16,6 +16,8 @@
 
 #include "modules/drivers/velodyne/parser/convert.h"
 
+#include "modules/drivers/common/packed_point_cloud.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -43,7 +45,7 @@ void Convert::ConvertPacketsToPointcloud(
 
   parser_->GeneratePointcloud(scan_msg, point_cloud);
 
-  if (point_cloud == nullptr || point_cloud->point_size() == 0) {
+  if (point_cloud == nullptr || PointNum(*point_cloud) == 0) {
     AERROR << "point cloud has no point";
     return;
   }
@@ -54,6 +56,10 @@ void Convert::ConvertPacketsToPointcloud(
   } else {
     point_cloud->set_is_dense(true);
   }
+
+  if (config_.use_packed_point()) {
+    PackPoints(point_cloud.get());
+  }
 }
 
 }  // namespace velodyne
@@ -36,24 +36,24 @@ void Velodyne128Parser::GeneratePointcloud(
 
   // us
   gps_base_usec_ = scan_msg->basetime();
+  ReserveScanPoints(scan_msg->firing_pkts_size(), out_msg.get());
 
   for (int i = 0; i < scan_msg->firing_pkts_size(); ++i) {
     Unpack(scan_msg->firing_pkts(i), out_msg);
     last_time_stamp_ = out_msg->measurement_time();
   }
 
-  size_t size = out_msg->point_size();
+  const int size = PointNum(*out_msg);
   if (size == 0) {
     // we discard this pointcloud if empty
     AERROR << "All points is NAN!Please check velodyne:" << config_.model();
     return;
   } else {
-    const auto timestamp =
-        out_msg->point(static_cast<int>(size) - 1).timestamp();
+    const auto timestamp = GetPoint(*out_msg, size - 1).timestamp;
     out_msg->set_measurement_time(static_cast<double>(timestamp) / 1e9);
     out_msg->mutable_header()->set_lidar_timestamp(timestamp);
   }
-  out_msg->set_width(out_msg->point_size());
+  out_msg->set_width(size);
 }
 
 uint64_t Velodyne128Parser::GetTimestamp(double base_time, float time_offset,
@@ -70,95 +70,63 @@ void Velodyne128Parser::Order(std::shared_ptr<PointCloud> cloud) {
 
 void Velodyne128Parser::Unpack(const VelodynePacket& pkt,
                                std::shared_ptr<PointCloud> pc) {
-  float azimuth_diff, azimuth_corrected_f;
-  float last_azimuth_diff = 0.0f;
-  uint16_t azimuth = 0;
-  uint16_t azimuth_next = 0;
-  uint16_t azimuth_corrected = 0;
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;
+  uint16_t raw_distance[SCANS_PER_BLOCK];
+  float real_distance[SCANS_PER_BLOCK];
+  PackedPoint points[SCANS_PER_BLOCK];
 
   for (int block = 0; block < BLOCKS_PER_PACKET; block++) {
-    // Calculate difference between current and next block's azimuth angle.
-    if (block == 0) {
-      azimuth = raw->blocks[block].rotation;
-    } else {
-      azimuth = azimuth_next;
-    }
-    if (block < (BLOCKS_PER_PACKET - 1)) {
-      azimuth_next = raw->blocks[block + 1].rotation;
-      azimuth_diff =
-          static_cast<float>((36000 + azimuth_next - azimuth) % 36000);
-      last_azimuth_diff = azimuth_diff;
-    } else {
-      azimuth_diff = last_azimuth_diff;
-    }
+    const RawBlock& raw_block = raw->blocks[block];
+    // the lasers of the block are the group block % 4 of the 128 lasers
+    const int laser_origin = (block % 4) * SCANS_PER_BLOCK;
+    // the firing order is taken as 0, so the azimuth correction of the
+    // lasers is 0 and they all fire at the rotation of the block
+    const uint16_t azimuth = static_cast<uint16_t>(raw_block.rotation % 36000);
 
-    /*condition added to avoid calculating points which are not
-      in the interesting defined area (min_angle < area < max_angle)*/
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK; j++, k += RAW_SCAN_SIZE) {
-      uint8_t group = static_cast<uint8_t>(block % 4);
-      uint8_t chan_id = static_cast<uint8_t>(j + group * 32);
-      uint8_t firing_order = chan_id / 8;
-      firing_order = 0;
-      LaserCorrection& corrections = calibration_.laser_corrections_[chan_id];
       // distance extraction
-      // union two_bytes tmp;
-      union RawDistance raw_distance;
-      raw_distance.bytes[0] = raw->blocks[block].data[k];
-      raw_distance.bytes[1] = raw->blocks[block].data[k + 1];
+      union RawDistance distance_bytes;
+      distance_bytes.bytes[0] = raw_block.data[k];
+      distance_bytes.bytes[1] = raw_block.data[k + 1];
+      raw_distance[j] = distance_bytes.raw_distance;
+      real_distance[j] =
+          distance_bytes.raw_distance * VSL128_DISTANCE_RESOLUTION;
+    }
+    ComputeBlockCoords(real_distance, laser_origin, azimuth, points);
 
-      float real_distance =
-          raw_distance.raw_distance * VSL128_DISTANCE_RESOLUTION;
-      float distance = real_distance + corrections.dist_correction;
+    for (int j = 0, k = 0; j < SCANS_PER_BLOCK; j++, k += RAW_SCAN_SIZE) {
+      const int laser = laser_origin + j;
+      PackedPoint& point = points[j];
+      point.timestamp = GetTimestamp(basetime, (*inner_time_)[block][j],
+                                     static_cast<uint16_t>(block));
 
-      uint64_t timestamp = static_cast<uint64_t>(GetTimestamp(
-          basetime, (*inner_time_)[block][j], static_cast<uint16_t>(block)));
+      float distance = real_distance[j] + laser_table_.dist_correction[laser];
       if (!is_scan_valid(azimuth, distance)) {
         // todo orgnized
         if (config_.organized()) {
-          apollo::drivers::PointXYZIT* point_new = pc->add_point();
-          point_new->set_x(nan);
-          point_new->set_y(nan);
-          point_new->set_z(nan);
-          point_new->set_timestamp(timestamp);
-          point_new->set_intensity(0);
+          point.x = nan;
+          point.y = nan;
+          point.z = nan;
+          point.intensity = 0;
+          AddBlockPoint(point, pc.get());
         }
         continue;
       }
 
-      // if (pointInRange(distance)) {
-      int intensity = static_cast<int>(raw->blocks[block].data[k + 2]);
-
-      /** correct for the laser rotation as a function of timing during the
-       * firings **/
-      azimuth_corrected_f =
-          azimuth +
-          (azimuth_diff * (firing_order * CHANNEL_TDURATION) / SEQ_TDURATION);
-      azimuth_corrected =
-          (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
-
-      // add new point
-      PointXYZIT* point_new = pc->add_point();
-
-      // compute time , time offset is zero
-      point_new->set_timestamp(timestamp);
-      ComputeCoords(real_distance, corrections, azimuth_corrected, point_new);
-
-      intensity = IntensityCompensate(corrections, raw_distance.raw_distance,
-                                      intensity);
-      point_new->set_intensity(intensity);
+      point.intensity = IntensityCompensate(
+          laser, raw_distance[j], static_cast<int>(raw_block.data[k + 2]));
+      AddBlockPoint(point, pc.get());
     }
-    // }
   }
 }
 
-int Velodyne128Parser::IntensityCompensate(const LaserCorrection& corrections,
+int Velodyne128Parser::IntensityCompensate(int laser,
                                            const uint16_t raw_distance,
-                                           int intensity) {
-  float focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
-                       (1 - corrections.focal_distance / 13100);
-  float focal_slope = corrections.focal_slope;
+                                           int intensity) const {
+  float focal_offset = 256 * (1 - laser_table_.focal_distance[laser] / 13100) *
+                       (1 - laser_table_.focal_distance[laser] / 13100);
+  float focal_slope = laser_table_.focal_slope[laser];
 
   intensity += static_cast<int>(
       focal_slope *
@@ -167,12 +135,12 @@ int Velodyne128Parser::IntensityCompensate(const LaserCorrection& corrections,
           256.0f * (1.0f - static_cast<float>(raw_distance) / 65535.0f) *
               (1.0f - static_cast<float>(raw_distance) / 65535.0f))));
 
-  if (intensity < corrections.min_intensity) {
-    intensity = corrections.min_intensity;
+  if (intensity < laser_table_.min_intensity[laser]) {
+    intensity = laser_table_.min_intensity[laser];
   }
 
-  if (intensity > corrections.max_intensity) {
-    intensity = corrections.max_intensity;
+  if (intensity > laser_table_.max_intensity[laser]) {
+    intensity = laser_table_.max_intensity[laser];
   }
   return intensity;
 }
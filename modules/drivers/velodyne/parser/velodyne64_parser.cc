@@ -154,6 +154,7 @@ void Velodyne64Parser::GeneratePointcloud(
       return;
     }
     calibration_ = online_calibration_.calibration();
+    InitLaserTable();
     if (config_.organized()) {
       InitOffsets();
     }
@@ -167,6 +168,7 @@ void Velodyne64Parser::GeneratePointcloud(
 
   bool skip = false;
   size_t packets_size = scan_msg->firing_pkts_size();
+  ReserveScanPoints(scan_msg->firing_pkts_size(), pointcloud.get());
   for (size_t i = 0; i < packets_size; ++i) {
     if (gps_base_usec_[0] == 0) {
       // only set one time type when call this function, so cannot break
@@ -184,16 +186,16 @@ void Velodyne64Parser::GeneratePointcloud(
   if (skip) {
     pointcloud->Clear();
   } else {
-    int size = pointcloud->point_size();
+    int size = PointNum(*pointcloud);
     if (size == 0) {
       // we discard this pointcloud if empty
       AERROR << "All points is NAN! Please check velodyne:" << config_.model();
     } else {
-      uint64_t timestamp = pointcloud->point(size - 1).timestamp();
+      uint64_t timestamp = GetPoint(*pointcloud, size - 1).timestamp;
       pointcloud->set_measurement_time(static_cast<double>(timestamp) / 1e9);
       pointcloud->mutable_header()->set_lidar_timestamp(timestamp);
     }
-    pointcloud->set_width(pointcloud->point_size());
+    pointcloud->set_width(size);
   }
 }
 
@@ -219,20 +221,20 @@ uint64_t Velodyne64Parser::GetTimestamp(double base_time, float time_offset,
   return static_cast<uint64_t>(timestamp);
 }
 
-int Velodyne64Parser::IntensityCompensate(const LaserCorrection& corrections,
+int Velodyne64Parser::IntensityCompensate(int laser,
                                           const uint16_t raw_distance,
-                                          int intensity) {
+                                          int intensity) const {
   float tmp = 1.0f - static_cast<float>(raw_distance) / 65535.0f;
-  intensity +=
-      static_cast<int>(corrections.focal_slope *
-                       (fabs(corrections.focal_offset - 256 * tmp * tmp)));
+  intensity += static_cast<int>(
+      laser_table_.focal_slope[laser] *
+      (fabs(laser_table_.focal_offset[laser] - 256 * tmp * tmp)));
 
-  if (intensity < corrections.min_intensity) {
-    intensity = corrections.min_intensity;
+  if (intensity < laser_table_.min_intensity[laser]) {
+    intensity = laser_table_.min_intensity[laser];
   }
 
-  if (intensity > corrections.max_intensity) {
-    intensity = corrections.max_intensity;
+  if (intensity > laser_table_.max_intensity[laser]) {
+    intensity = laser_table_.max_intensity[laser];
   }
   return intensity;
 }
@@ -245,6 +247,10 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
 
+  uint16_t raw_distance[SCANS_PER_BLOCK];
+  float real_distance[SCANS_PER_BLOCK];
+  PackedPoint points[SCANS_PER_BLOCK];
+
   for (int i = 0; i < BLOCKS_PER_PACKET; ++i) {  // 12
     if (mode_ != DUAL && !is_s2_ && ((i & 3) >> 1) > 0) {
       // i%4/2  even-numbered block contain duplicate data
@@ -257,49 +263,51 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
 
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK;
          ++j, k += RAW_SCAN_SIZE) {  // 32, 3
-      // One point
-      uint8_t laser_number =
-          static_cast<uint8_t>(j + bank_origin);  // hardware laser number
-      LaserCorrection& corrections =
-          calibration_.laser_corrections_[laser_number];
+      union RawDistance distance_bytes;
+      distance_bytes.bytes[0] = raw->blocks[i].data[k];
+      distance_bytes.bytes[1] = raw->blocks[i].data[k + 1];
+      raw_distance[j] = distance_bytes.raw_distance;
+      real_distance[j] = distance_bytes.raw_distance * DISTANCE_RESOLUTION;
+    }
+    // Position Calculation of the whole block
+    ComputeBlockCoords(real_distance, bank_origin, raw->blocks[i].rotation,
+                       points);
 
-      union RawDistance raw_distance;
-      raw_distance.bytes[0] = raw->blocks[i].data[k];
-      raw_distance.bytes[1] = raw->blocks[i].data[k + 1];
+    for (int j = 0, k = 0; j < SCANS_PER_BLOCK;
+         ++j, k += RAW_SCAN_SIZE) {  // 32, 3
+      // One point
+      const int laser_number = j + bank_origin;  // hardware laser number
+      PackedPoint& point = points[j];
 
       // compute time
-      uint64_t timestamp = GetTimestamp(basetime, (*inner_time_)[i][j],
-                                        static_cast<uint16_t>(i));
+      point.timestamp = GetTimestamp(basetime, (*inner_time_)[i][j],
+                                     static_cast<uint16_t>(i));
 
       if (j == SCANS_PER_BLOCK - 1) {
         // set header stamp before organize the point cloud
-        pc->set_measurement_time(static_cast<double>(timestamp) / 1e9);
+        pc->set_measurement_time(static_cast<double>(point.timestamp) / 1e9);
       }
 
-      float real_distance = raw_distance.raw_distance * DISTANCE_RESOLUTION;
-      float distance = real_distance + corrections.dist_correction;
+      float distance =
+          real_distance[j] + laser_table_.dist_correction[laser_number];
 
-      if (raw_distance.raw_distance == 0 ||
+      if (raw_distance[j] == 0 ||
           !is_scan_valid(raw->blocks[i].rotation, distance)) {
         // if organized append a nan point to the cloud
         if (config_.organized()) {
-          apollo::drivers::PointXYZIT* point_new = pc->add_point();
-          point_new->set_x(nan);
-          point_new->set_y(nan);
-          point_new->set_z(nan);
-          point_new->set_timestamp(timestamp);
-          point_new->set_intensity(0);
+          point.x = nan;
+          point.y = nan;
+          point.z = nan;
+          point.intensity = 0;
+          AddBlockPoint(point, pc.get());
         }
         continue;
       }
 
-      apollo::drivers::PointXYZIT* point = pc->add_point();
-      point->set_timestamp(timestamp);
-      // Position Calculation, append this point to the cloud
-      ComputeCoords(real_distance, corrections, raw->blocks[i].rotation, point);
-      point->set_intensity(IntensityCompensate(
-          corrections, raw_distance.raw_distance, raw->blocks[i].data[k + 2]));
+      point.intensity = IntensityCompensate(laser_number, raw_distance[j],
+                                            raw->blocks[i].data[k + 2]);
       // append this point to the cloud
+      AddBlockPoint(point, pc.get());
     }
   }
 }
@@ -20,6 +20,7 @@
 
 #include "cyber/cyber.h"
 
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/drivers/velodyne/parser/velodyne_convert_component.h"
 
 namespace apollo {
@@ -66,7 +67,7 @@ bool VelodyneConvertComponent::Proc(
   point_cloud_out->Clear();
   conv_->ConvertPacketsToPointcloud(scan_msg, point_cloud_out);
 
-  if (point_cloud_out == nullptr || point_cloud_out->point_size() == 0) {
+  if (point_cloud_out == nullptr || PointNum(*point_cloud_out) == 0) {
     AWARN << "point_cloud_out convert is empty.";
     return false;
   }
@@ -14,6 +14,12 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <cmath>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 #include "cyber/cyber.h"
 
 #include "modules/drivers/velodyne/parser/util.h"
@@ -22,6 +28,150 @@
 namespace apollo {
 namespace drivers {
 namespace velodyne {
+namespace {
+
+// One laser of ComputeBlockCoords, in the operation order of ComputeCoords so
+// that both give the same points.
+void ComputeLaserCoords(const LaserTable& table, int laser, float raw_distance,
+                        float cos_rot, float sin_rot,
+                        bool need_two_pt_correction, PackedPoint* point) {
+  const double distance = raw_distance + table.dist_correction[laser];
+  const double cos_rot_angle = cos_rot * table.cos_rot_correction[laser] +
+                               sin_rot * table.sin_rot_correction[laser];
+  const double sin_rot_angle = sin_rot * table.cos_rot_correction[laser] -
+                               cos_rot * table.sin_rot_correction[laser];
+  const double cos_vert = table.cos_vert_correction[laser];
+  const double horiz_offset = table.horiz_offset_correction[laser];
+
+  double distance_corr_x = table.dist_correction[laser];
+  double distance_corr_y = table.dist_correction[laser];
+  if (need_two_pt_correction && raw_distance <= 2500) {
+    const double xy_distance = distance * cos_vert;
+    const double xx = std::fabs(xy_distance * sin_rot_angle -
+                                horiz_offset * cos_rot_angle);
+    const double yy = std::fabs(xy_distance * cos_rot_angle +
+                                horiz_offset * sin_rot_angle);
+    distance_corr_x =
+        (table.dist_correction[laser] - table.dist_correction_x[laser]) *
+            (xx - 2.4) / 22.64 +
+        table.dist_correction_x[laser];
+    distance_corr_y =
+        (table.dist_correction[laser] - table.dist_correction_y[laser]) *
+            (yy - 1.93) / 23.11 +
+        table.dist_correction_y[laser];
+  }
+
+  const double x = (raw_distance + distance_corr_x) * cos_vert * sin_rot_angle -
+                   horiz_offset * cos_rot_angle;
+  const double y = (raw_distance + distance_corr_y) * cos_vert * cos_rot_angle +
+                   horiz_offset * sin_rot_angle;
+  const double z = distance * table.sin_vert_correction[laser] +
+                   table.vert_offset_correction[laser];
+
+  /** Use standard ROS coordinate system (right-hand rule) */
+  point->x = static_cast<float>(y);
+  point->y = static_cast<float>(-x);
+  point->z = static_cast<float>(z);
+}
+
+#if defined(__x86_64__)
+// ComputeLaserCoords on 4 lasers at a time. The float and double operations
+// and their order are those of the scalar code, without fused multiply-add,
+// so the points are the same bit for bit.
+__attribute__((target("avx2"))) void ComputeBlockCoordsSimd(
+    const LaserTable& table, const float* raw_distance, int laser_origin,
+    float cos_rot, float sin_rot, bool need_two_pt_correction,
+    PackedPoint* points) {
+  const __m128 cos_rot_f = _mm_set1_ps(cos_rot);
+  const __m128 sin_rot_f = _mm_set1_ps(sin_rot);
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+  const __m256d two_pt_mask =
+      _mm256_castsi256_pd(_mm256_set1_epi64x(need_two_pt_correction ? -1 : 0));
+  float x[4];
+  float y[4];
+  float z[4];
+  for (int j = 0; j < SCANS_PER_BLOCK; j += 4) {
+    const int laser = laser_origin + j;
+    const __m128 raw_f = _mm_loadu_ps(raw_distance + j);
+    const __m128 dist_f = _mm_loadu_ps(table.dist_correction + laser);
+    const __m128 cos_rot_corr = _mm_loadu_ps(table.cos_rot_correction + laser);
+    const __m128 sin_rot_corr = _mm_loadu_ps(table.sin_rot_correction + laser);
+
+    const __m256d raw = _mm256_cvtps_pd(raw_f);
+    const __m256d dist = _mm256_cvtps_pd(dist_f);
+    const __m256d distance = _mm256_cvtps_pd(_mm_add_ps(raw_f, dist_f));
+    const __m256d cos_rot_angle =
+        _mm256_cvtps_pd(_mm_add_ps(_mm_mul_ps(cos_rot_f, cos_rot_corr),
+                                   _mm_mul_ps(sin_rot_f, sin_rot_corr)));
+    const __m256d sin_rot_angle =
+        _mm256_cvtps_pd(_mm_sub_ps(_mm_mul_ps(sin_rot_f, cos_rot_corr),
+                                   _mm_mul_ps(cos_rot_f, sin_rot_corr)));
+    const __m256d cos_vert =
+        _mm256_cvtps_pd(_mm_loadu_ps(table.cos_vert_correction + laser));
+    const __m256d horiz_offset =
+        _mm256_cvtps_pd(_mm_loadu_ps(table.horiz_offset_correction + laser));
+
+    __m256d distance_corr_x = dist;
+    __m256d distance_corr_y = dist;
+    if (need_two_pt_correction) {
+      const __m256d xy_distance = _mm256_mul_pd(distance, cos_vert);
+      const __m256d xx = _mm256_andnot_pd(
+          sign_mask, _mm256_sub_pd(_mm256_mul_pd(xy_distance, sin_rot_angle),
+                                   _mm256_mul_pd(horiz_offset, cos_rot_angle)));
+      const __m256d yy = _mm256_andnot_pd(
+          sign_mask, _mm256_add_pd(_mm256_mul_pd(xy_distance, cos_rot_angle),
+                                   _mm256_mul_pd(horiz_offset, sin_rot_angle)));
+      const __m128 dist_x_f = _mm_loadu_ps(table.dist_correction_x + laser);
+      const __m128 dist_y_f = _mm_loadu_ps(table.dist_correction_y + laser);
+      const __m256d two_pt_x = _mm256_add_pd(
+          _mm256_div_pd(
+              _mm256_mul_pd(_mm256_cvtps_pd(_mm_sub_ps(dist_f, dist_x_f)),
+                            _mm256_sub_pd(xx, _mm256_set1_pd(2.4))),
+              _mm256_set1_pd(22.64)),
+          _mm256_cvtps_pd(dist_x_f));
+      const __m256d two_pt_y = _mm256_add_pd(
+          _mm256_div_pd(
+              _mm256_mul_pd(_mm256_cvtps_pd(_mm_sub_ps(dist_f, dist_y_f)),
+                            _mm256_sub_pd(yy, _mm256_set1_pd(1.93))),
+              _mm256_set1_pd(23.11)),
+          _mm256_cvtps_pd(dist_y_f));
+      const __m256d two_pt = _mm256_and_pd(
+          two_pt_mask,
+          _mm256_cmp_pd(raw, _mm256_set1_pd(2500.0), _CMP_LE_OQ));
+      distance_corr_x = _mm256_blendv_pd(dist, two_pt_x, two_pt);
+      distance_corr_y = _mm256_blendv_pd(dist, two_pt_y, two_pt);
+    }
+
+    const __m256d point_x = _mm256_sub_pd(
+        _mm256_mul_pd(
+            _mm256_mul_pd(_mm256_add_pd(raw, distance_corr_x), cos_vert),
+            sin_rot_angle),
+        _mm256_mul_pd(horiz_offset, cos_rot_angle));
+    const __m256d point_y = _mm256_add_pd(
+        _mm256_mul_pd(
+            _mm256_mul_pd(_mm256_add_pd(raw, distance_corr_y), cos_vert),
+            cos_rot_angle),
+        _mm256_mul_pd(horiz_offset, sin_rot_angle));
+    const __m256d point_z = _mm256_add_pd(
+        _mm256_mul_pd(
+            distance,
+            _mm256_cvtps_pd(_mm_loadu_ps(table.sin_vert_correction + laser))),
+        _mm256_cvtps_pd(_mm_loadu_ps(table.vert_offset_correction + laser)));
+
+    /** Use standard ROS coordinate system (right-hand rule) */
+    _mm_storeu_ps(x, _mm256_cvtpd_ps(point_y));
+    _mm_storeu_ps(y, _mm256_cvtpd_ps(_mm256_xor_pd(point_x, sign_mask)));
+    _mm_storeu_ps(z, _mm256_cvtpd_ps(point_z));
+    for (int i = 0; i < 4; ++i) {
+      points[j + i].x = x[i];
+      points[j + i].y = y[i];
+      points[j + i].z = z[i];
+    }
+  }
+}
+#endif
+
+}  // namespace
 
 uint64_t VelodyneParser::GetGpsStamp(double current_packet_stamp,
                                      double *previous_packet_stamp,
@@ -103,6 +253,36 @@ void VelodyneParser::setup() {
   init_angle_params(config_.view_direction(), config_.view_width());
   init_sin_cos_rot_table(sin_rot_table_, cos_rot_table_, ROTATION_MAX_UNITS,
                          ROTATION_RESOLUTION);
+  InitLaserTable();
+}
+
+void VelodyneParser::InitLaserTable() {
+  laser_table_ = LaserTable();
+  for (const auto& laser_correction : calibration_.laser_corrections_) {
+    const int laser = laser_correction.first;
+    if (laser < 0 || laser >= MAX_LASER_NUM) {
+      AERROR << "Laser " << laser << " out of the " << MAX_LASER_NUM
+             << " lasers of the laser table.";
+      continue;
+    }
+    const LaserCorrection& corrections = laser_correction.second;
+    laser_table_.dist_correction[laser] = corrections.dist_correction;
+    laser_table_.dist_correction_x[laser] = corrections.dist_correction_x;
+    laser_table_.dist_correction_y[laser] = corrections.dist_correction_y;
+    laser_table_.vert_offset_correction[laser] =
+        corrections.vert_offset_correction;
+    laser_table_.horiz_offset_correction[laser] =
+        corrections.horiz_offset_correction;
+    laser_table_.cos_rot_correction[laser] = corrections.cos_rot_correction;
+    laser_table_.sin_rot_correction[laser] = corrections.sin_rot_correction;
+    laser_table_.cos_vert_correction[laser] = corrections.cos_vert_correction;
+    laser_table_.sin_vert_correction[laser] = corrections.sin_vert_correction;
+    laser_table_.focal_distance[laser] = corrections.focal_distance;
+    laser_table_.focal_slope[laser] = corrections.focal_slope;
+    laser_table_.focal_offset[laser] = corrections.focal_offset;
+    laser_table_.max_intensity[laser] = corrections.max_intensity;
+    laser_table_.min_intensity[laser] = corrections.min_intensity;
+  }
 }
 
 bool VelodyneParser::is_scan_valid(int rotation, float range) {
@@ -200,6 +380,42 @@ void VelodyneParser::ComputeCoords(const float &raw_distance,
   point->set_z(static_cast<float>(z));
 }
 
+void VelodyneParser::ComputeBlockCoords(const float *raw_distance,
+                                        int laser_origin, uint16_t rotation,
+                                        PackedPoint *points) const {
+  assert(rotation <= 36000);
+  assert(laser_origin + SCANS_PER_BLOCK <= MAX_LASER_NUM);
+  const float cos_rot = cos_rot_table_[rotation];
+  const float sin_rot = sin_rot_table_[rotation];
+#if defined(__x86_64__)
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2) {
+    ComputeBlockCoordsSimd(laser_table_, raw_distance, laser_origin, cos_rot,
+                           sin_rot, need_two_pt_correction_, points);
+    return;
+  }
+#endif
+  for (int j = 0; j < SCANS_PER_BLOCK; ++j) {
+    ComputeLaserCoords(laser_table_, laser_origin + j, raw_distance[j],
+                       cos_rot, sin_rot, need_two_pt_correction_, &points[j]);
+  }
+}
+
+void VelodyneParser::AddBlockPoint(const PackedPoint &point,
+                                   PointCloud *pc) const {
+  // Order() reorganizes the repeated points, the cloud is packed after it.
+  AddPoint(point, config_.use_packed_point() && !config_.organized(), pc);
+}
+
+void VelodyneParser::ReserveScanPoints(int packet_num, PointCloud *pc) const {
+  const int point_num = PointNum(*pc) + packet_num * SCANS_PER_PACKET;
+  if (config_.use_packed_point() && !config_.organized()) {
+    ReservePackedPoints(point_num, pc);
+  } else {
+    pc->mutable_point()->Reserve(point_num);
+  }
+}
+
 VelodyneParser *VelodyneParserFactory::CreateParser(Config source_config) {
   Config config = source_config;
   if (config.model() == VLP16) {
@@ -58,6 +58,7 @@
 #include <memory>
 #include <string>
 
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/drivers/velodyne/parser/calibration.h"
 #include "modules/drivers/velodyne/parser/const_variables.h"
 #include "modules/drivers/velodyne/parser/online_calibration.h"
@@ -70,6 +71,7 @@ namespace apollo {
 namespace drivers {
 namespace velodyne {
 
+using apollo::drivers::PackedPoint;
 using apollo::drivers::PointCloud;
 using apollo::drivers::PointXYZIT;
 using apollo::drivers::velodyne::DUAL;
@@ -124,6 +126,7 @@ static const float VLS128_SEQ_TDURATION = 55.296f;
 
 static const float VLP32_DISTANCE_RESOLUTION = 0.004f;
 static const float VSL128_DISTANCE_RESOLUTION = 0.004f;
+static const int MAX_LASER_NUM = 128;
 static const float CHANNEL_TDURATION = 2.304f;
 static const float SEQ_TDURATION = 55.296f;
 
@@ -219,6 +222,28 @@ struct RawPacket {
 
 static const float nan = std::numeric_limits<float>::signaling_NaN();
 
+/**
+ * \brief Calibration of every laser, one array per constant and indexed
+ * by the hardware laser number, so that the lasers of a firing block are
+ * corrected in one pass over contiguous memory.
+ */
+struct LaserTable {
+  float dist_correction[MAX_LASER_NUM];
+  float dist_correction_x[MAX_LASER_NUM];
+  float dist_correction_y[MAX_LASER_NUM];
+  float vert_offset_correction[MAX_LASER_NUM];
+  float horiz_offset_correction[MAX_LASER_NUM];
+  float cos_rot_correction[MAX_LASER_NUM];
+  float sin_rot_correction[MAX_LASER_NUM];
+  float cos_vert_correction[MAX_LASER_NUM];
+  float sin_vert_correction[MAX_LASER_NUM];
+  float focal_distance[MAX_LASER_NUM];
+  float focal_slope[MAX_LASER_NUM];
+  float focal_offset[MAX_LASER_NUM];
+  int max_intensity[MAX_LASER_NUM];
+  int min_intensity[MAX_LASER_NUM];
+};
+
 /** \brief Velodyne data conversion class */
 class VelodyneParser {
  public:
@@ -257,6 +282,7 @@ class VelodyneParser {
   // Last Velodyne packet time stamp. (Full time)
   bool need_two_pt_correction_;
   Mode mode_;
+  LaserTable laser_table_;
 
   PointXYZIT get_nan_point(uint64_t timestamp);
   void init_angle_params(double view_direction, double view_width);
@@ -270,6 +296,34 @@ class VelodyneParser {
                      const LaserCorrection& corrections,
                      const uint16_t rotation, PointXYZIT* point);
 
+  /**
+   * \brief Fill laser_table_ from calibration_
+   */
+  void InitLaserTable();
+
+  /**
+   * \brief Compute coords of the lasers of a block, which all fire at the
+   * same rotation, with the same math as ComputeCoords
+   *
+   * @param raw_distance Distances of the SCANS_PER_BLOCK lasers
+   * @param laser_origin Hardware laser number of the first laser
+   * @param rotation The rotation of the block
+   * @param points The SCANS_PER_BLOCK points to set x, y and z of
+   */
+  void ComputeBlockCoords(const float* raw_distance, int laser_origin,
+                          uint16_t rotation, PackedPoint* points) const;
+
+  /**
+   * \brief Append a point computed by ComputeBlockCoords to the cloud, as a
+   * packed record when packed points are used
+   */
+  void AddBlockPoint(const PackedPoint& point, PointCloud* pc) const;
+
+  /**
+   * \brief Make room for the points of a scan in the cloud
+   */
+  void ReserveScanPoints(int packet_num, PointCloud* pc) const;
+
   bool is_scan_valid(int rotation, float distance);
 
   /**
@@ -303,8 +357,8 @@ class Velodyne64Parser : public VelodyneParser {
                         uint16_t laser_block_id);
   void Unpack(const VelodynePacket& pkt, std::shared_ptr<PointCloud> pc);
   void InitOffsets();
-  int IntensityCompensate(const LaserCorrection& corrections,
-                          const uint16_t raw_distance, int intensity);
+  int IntensityCompensate(int laser, const uint16_t raw_distance,
+                          int intensity) const;
   // Previous Velodyne packet time stamp. (offset to the top hour)
   double previous_packet_stamp_[4];
   uint64_t gps_base_usec_[4];  // full time
@@ -363,8 +417,8 @@ class Velodyne128Parser : public VelodyneParser {
   uint64_t GetTimestamp(double base_time, float time_offset,
                         uint16_t laser_block_id);
   void Unpack(const VelodynePacket& pkt, std::shared_ptr<PointCloud> pc);
-  int IntensityCompensate(const LaserCorrection& corrections,
-                          const uint16_t raw_distance, int intensity);
+  int IntensityCompensate(int laser, const uint16_t raw_distance,
+                          int intensity) const;
   // Previous Velodyne packet time stamp. (offset to the top hour)
   double previous_packet_stamp_;
   uint64_t gps_base_usec_;  // full time
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/guardian/guardian_component.h"
 
+#include <atomic>
+
 #include "cyber/common/log.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/util/message_util.h"
@@ -32,76 +34,123 @@ bool GuardianComponent::Init() {
     return false;
   }
 
+  // The writer comes first, as in event driven mode the reader callbacks
+  // publish.
+  guardian_writer_ = node_->CreateWriter<GuardianCommand>(FLAGS_guardian_topic);
+
   chassis_reader_ = node_->CreateReader<Chassis>(
       FLAGS_chassis_topic, [this](const std::shared_ptr<Chassis>& chassis) {
         ADEBUG << "Received chassis data: run chassis callback.";
-        std::lock_guard<std::mutex> lock(mutex_);
-        chassis_.CopyFrom(*chassis);
+        std::atomic_store(&chassis_, std::shared_ptr<const Chassis>(chassis));
+        if (guardian_conf_.event_driven()) {
+          Publish(&chassis->header());
+        }
       });
 
   control_cmd_reader_ = node_->CreateReader<ControlCommand>(
       FLAGS_control_command_topic,
       [this](const std::shared_ptr<ControlCommand>& cmd) {
         ADEBUG << "Received control data: run control callback.";
-        std::lock_guard<std::mutex> lock(mutex_);
-        control_cmd_.CopyFrom(*cmd);
+        std::atomic_store(&control_cmd_,
+                          std::shared_ptr<const ControlCommand>(cmd));
       });
 
   system_status_reader_ = node_->CreateReader<SystemStatus>(
       FLAGS_system_status_topic,
       [this](const std::shared_ptr<SystemStatus>& status) {
         ADEBUG << "Received system status data: run system status callback.";
-        std::lock_guard<std::mutex> lock(mutex_);
-        system_status_.CopyFrom(*status);
+        std::atomic_store(&system_status_,
+                          std::shared_ptr<const SystemStatus>(status));
+        if (guardian_conf_.event_driven()) {
+          Publish(&status->header());
+        }
       });
 
-  guardian_writer_ = node_->CreateWriter<GuardianCommand>(FLAGS_guardian_topic);
-
   return true;
 }
 
 bool GuardianComponent::Proc() {
   ADEBUG << "Timer is triggered: publish GuardianComponent result";
-  bool safety_mode_triggered = false;
-  if (guardian_conf_.guardian_enable()) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    safety_mode_triggered = system_status_.has_safety_mode_trigger_time();
+  Publish(nullptr);
+  return true;
+}
+
+GuardianComponent::SafetyState GuardianComponent::GetSafetyState(
+    const SystemStatus& system_status, const Chassis& chassis) const {
+  SafetyState state;
+  if (!guardian_conf_.guardian_enable() ||
+      !system_status.has_safety_mode_trigger_time()) {
+    return state;
+  }
+  state.safety_mode_triggered = true;
+  state.require_emergency_stop = system_status.require_emergency_stop();
+  state.sonar_malfunction = !chassis.surround().sonar_enabled() ||
+                            chassis.surround().sonar_fault();
+  return state;
+}
+
+void GuardianComponent::Publish(const common::Header* trigger_header) {
+  const auto chassis_ptr = std::atomic_load(&chassis_);
+  const auto system_status_ptr = std::atomic_load(&system_status_);
+  const auto control_cmd_ptr = std::atomic_load(&control_cmd_);
+  const Chassis& chassis =
+      chassis_ptr ? *chassis_ptr : Chassis::default_instance();
+  const SystemStatus& system_status =
+      system_status_ptr ? *system_status_ptr : SystemStatus::default_instance();
+  const ControlCommand& control_cmd =
+      control_cmd_ptr ? *control_cmd_ptr : ControlCommand::default_instance();
+
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  const SafetyState state = GetSafetyState(system_status, chassis);
+  if (trigger_header != nullptr && state == published_state_) {
+    // the command of the next timer round would be the same
+    return;
   }
 
-  if (safety_mode_triggered) {
+  if (state.safety_mode_triggered) {
     ADEBUG << "Safety mode triggered, enable safty mode";
-    TriggerSafetyMode();
+    TriggerSafetyMode(system_status, chassis);
   } else {
     ADEBUG << "Safety mode not triggered, bypass control command";
-    PassThroughControlCommand();
+    PassThroughControlCommand(control_cmd);
   }
 
   common::util::FillHeader(node_->Name(), &guardian_cmd_);
+  if (trigger_header != nullptr && trigger_header->has_timestamp_sec()) {
+    const double latency_ms = (guardian_cmd_.header().timestamp_sec() -
+                               trigger_header->timestamp_sec()) *
+                              1000.0;
+    guardian_cmd_.set_trigger_latency_ms(latency_ms);
+    AINFO << "Guardian command triggered by " << trigger_header->module_name()
+          << " published " << latency_ms << " ms after it.";
+  } else {
+    guardian_cmd_.clear_trigger_latency_ms();
+  }
   guardian_writer_->Write(std::make_shared<GuardianCommand>(guardian_cmd_));
-  return true;
+  published_state_ = state;
 }
 
-void GuardianComponent::PassThroughControlCommand() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  guardian_cmd_.mutable_control_command()->CopyFrom(control_cmd_);
+void GuardianComponent::PassThroughControlCommand(
+    const ControlCommand& control_cmd) {
+  guardian_cmd_.mutable_control_command()->CopyFrom(control_cmd);
 }
 
-void GuardianComponent::TriggerSafetyMode() {
+void GuardianComponent::TriggerSafetyMode(const SystemStatus& system_status,
+                                          const Chassis& chassis) {
   AINFO << "Safety state triggered, with system safety mode trigger time : "
-        << system_status_.safety_mode_trigger_time();
-  std::lock_guard<std::mutex> lock(mutex_);
+        << system_status.safety_mode_trigger_time();
   bool sensor_malfunction = false, obstacle_detected = false;
-  if (!chassis_.surround().sonar_enabled() ||
-      chassis_.surround().sonar_fault()) {
+  if (!chassis.surround().sonar_enabled() ||
+      chassis.surround().sonar_fault()) {
     AINFO << "Ultrasonic sensor not enabled for faulted, will do emergency "
              "stop!";
     sensor_malfunction = true;
   } else {
     // TODO(QiL) : Load for config
-    for (int i = 0; i < chassis_.surround().sonar_range_size(); ++i) {
-      if ((chassis_.surround().sonar_range(i) > 0.0 &&
-           chassis_.surround().sonar_range(i) < 2.5) ||
-          chassis_.surround().sonar_range(i) > 30) {
+    for (int i = 0; i < chassis.surround().sonar_range_size(); ++i) {
+      if ((chassis.surround().sonar_range(i) > 0.0 &&
+           chassis.surround().sonar_range(i) < 2.5) ||
+          chassis.surround().sonar_range(i) > 30) {
         AINFO << "Object detected or ultrasonic sensor fault output, will do "
                  "emergency stop!";
         obstacle_detected = true;
@@ -120,15 +169,15 @@ void GuardianComponent::TriggerSafetyMode() {
   AINFO << "Temporarily ignore the ultrasonic sensor output during hardware "
            "re-alignment!";
 
-  if (system_status_.require_emergency_stop() || sensor_malfunction ||
+  if (system_status.require_emergency_stop() || sensor_malfunction ||
       obstacle_detected) {
     AINFO << "Emergency stop triggered! with system status from monitor as : "
-          << system_status_.require_emergency_stop();
+          << system_status.require_emergency_stop();
     guardian_cmd_.mutable_control_command()->set_brake(
         guardian_conf_.guardian_cmd_emergency_stop_percentage());
   } else {
     AINFO << "Soft stop triggered! with system status from monitor as : "
-          << system_status_.require_emergency_stop();
+          << system_status.require_emergency_stop();
     guardian_cmd_.mutable_control_command()->set_brake(
         guardian_conf_.guardian_cmd_soft_stop_percentage());
   }
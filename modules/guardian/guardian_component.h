@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "cyber/common/macros.h"
 #include "cyber/component/timer_component.h"
@@ -45,14 +46,46 @@ class GuardianComponent : public apollo::cyber::TimerComponent {
   bool Proc() override;
 
  private:
-  void PassThroughControlCommand();
-  void TriggerSafetyMode();
+  // What the command depends on besides the control command. In event driven
+  // mode, a message which changes it publishes a command right away.
+  struct SafetyState {
+    bool safety_mode_triggered = false;
+    bool require_emergency_stop = false;
+    bool sonar_malfunction = false;
+
+    bool operator==(const SafetyState& other) const {
+      return safety_mode_triggered == other.safety_mode_triggered &&
+             require_emergency_stop == other.require_emergency_stop &&
+             sonar_malfunction == other.sonar_malfunction;
+    }
+  };
+
+  SafetyState GetSafetyState(
+      const apollo::monitor::SystemStatus& system_status,
+      const apollo::canbus::Chassis& chassis) const;
+
+  // Publishes the command of the latest inputs. With the header of the
+  // message which triggered it, only if the safety state has changed since
+  // the last command, and with the latency from that message.
+  void Publish(const apollo::common::Header* trigger_header);
+
+  void PassThroughControlCommand(
+      const apollo::control::ControlCommand& control_cmd);
+  void TriggerSafetyMode(const apollo::monitor::SystemStatus& system_status,
+                         const apollo::canbus::Chassis& chassis);
 
   apollo::guardian::GuardianConf guardian_conf_;
-  apollo::canbus::Chassis chassis_;
-  apollo::monitor::SystemStatus system_status_;
-  apollo::control::ControlCommand control_cmd_;
+
+  // latest messages of the readers, accessed with std::atomic_load and
+  // std::atomic_store instead of being copied under a lock
+  std::shared_ptr<const apollo::canbus::Chassis> chassis_;
+  std::shared_ptr<const apollo::monitor::SystemStatus> system_status_;
+  std::shared_ptr<const apollo::control::ControlCommand> control_cmd_;
+
+  // serializes the commands of the timer and of the events
+  std::mutex publish_mutex_;
   apollo::guardian::GuardianCommand guardian_cmd_;
+  SafetyState published_state_;
 
   std::shared_ptr<apollo::cyber::Reader<apollo::canbus::Chassis>>
       chassis_reader_;
@@ -62,8 +95,6 @@ class GuardianComponent : public apollo::cyber::TimerComponent {
       system_status_reader_;
   std::shared_ptr<apollo::cyber::Writer<apollo::guardian::GuardianCommand>>
       guardian_writer_;
-
-  std::mutex mutex_;
 };
 
 CYBER_REGISTER_COMPONENT(GuardianComponent)
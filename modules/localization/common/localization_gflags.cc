@@ -99,6 +99,9 @@ DEFINE_bool(integ_sins_align_with_vel, true, "");
 DEFINE_bool(integ_sins_state_check, false, "");
 DEFINE_double(integ_sins_state_span_time, 60.0, "");
 DEFINE_double(integ_sins_state_pos_std, 1.0, "");
+DEFINE_double(integ_measure_reorder_window, 0.0,
+              "seconds a measure waits for later ones to be applied in time "
+              "order, 0 applies them as they come");
 DEFINE_double(vel_threshold_get_yaw, 5.0, "");
 
 // gnss module
@@ -69,6 +69,7 @@ DECLARE_bool(integ_sins_align_with_vel);
 DECLARE_bool(integ_sins_state_check);
 DECLARE_double(integ_sins_state_span_time);
 DECLARE_double(integ_sins_state_pos_std);
+DECLARE_double(integ_measure_reorder_window);
 
 DECLARE_double(vel_threshold_get_yaw);
 
@@ -18,12 +18,68 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 
 namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+
+unsigned int ReadWord(const unsigned char* buf) {
+  unsigned int word = 0;
+  memcpy(&word, buf, sizeof(word));
+  return word;
+}
+
+void WriteWord(unsigned int word, unsigned char* buf) {
+  memcpy(buf, &word, sizeof(word));
+}
+
+// Byte b of word i goes to dst[b * word_num + i], for the words in
+// [begin, end).
+void ShuffleBytes(const unsigned char* src, size_t word_num,
+                  unsigned int word_size, size_t begin, size_t end,
+                  unsigned char* dst) {
+  for (unsigned int b = 0; b < word_size; ++b) {
+    unsigned char* plane = dst + b * word_num;
+    for (size_t i = begin; i < end; ++i) {
+      plane[i] = src[i * word_size + b];
+    }
+  }
+}
+
+void UnshuffleBytes(const unsigned char* src, size_t word_num,
+                    unsigned int word_size, size_t begin, size_t end,
+                    unsigned char* dst) {
+  if (word_size == 4) {
+    // the common case of float and int cells, vectorized by the compiler
+    const unsigned char* p0 = src;
+    const unsigned char* p1 = src + word_num;
+    const unsigned char* p2 = src + 2 * word_num;
+    const unsigned char* p3 = src + 3 * word_num;
+    for (size_t i = begin; i < end; ++i) {
+      dst[i * 4] = p0[i];
+      dst[i * 4 + 1] = p1[i];
+      dst[i * 4 + 2] = p2[i];
+      dst[i * 4 + 3] = p3[i];
+    }
+    return;
+  }
+  for (unsigned int b = 0; b < word_size; ++b) {
+    const unsigned char* plane = src + b * word_num;
+    for (size_t i = begin; i < end; ++i) {
+      dst[i * word_size + b] = plane[i];
+    }
+  }
+}
+
+}  // namespace
+
 const unsigned int ZlibStrategy::zlib_chunk = 16384;
 
 unsigned int ZlibStrategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
@@ -152,6 +208,147 @@ unsigned int ZlibStrategy::ZlibUncompress(BufferStr* src, BufferStr* dst) {
   return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
 }
 
+// The header is the magic number, the uncompressed size, the chunk size, the
+// shuffle size, the number of chunks and the compressed size of each chunk.
+const unsigned int ChunkedZlibStrategy::magic_number = 0x314c5a43;  // "CZL1"
+const unsigned int ChunkedZlibStrategy::header_size =
+    5 * sizeof(unsigned int);
+
+ChunkedZlibStrategy::ChunkedZlibStrategy(unsigned int shuffle_size,
+                                         unsigned int chunk_size)
+    : shuffle_size_(std::max(shuffle_size, 1u)),
+      chunk_size_(std::max(chunk_size, 1u)) {}
+
+unsigned int ChunkedZlibStrategy::Encode(BufferStr* buf,
+                                         BufferStr* buf_compressed) {
+  const unsigned int raw_size = static_cast<unsigned int>(buf->size());
+  const unsigned char* src = buf->data();
+  BufferStr buf_shuffled;
+  if (shuffle_size_ > 1) {
+    const size_t word_num = raw_size / shuffle_size_;
+    const size_t word_grain = std::max<size_t>(chunk_size_ / shuffle_size_, 1);
+    buf_shuffled.resize(raw_size);
+    cyber::ParallelFor(
+        0, (word_num + word_grain - 1) / word_grain, 1, [&](size_t i) {
+          ShuffleBytes(src, word_num, shuffle_size_, i * word_grain,
+                       std::min(word_num, (i + 1) * word_grain),
+                       buf_shuffled.data());
+        });
+    // the bytes of the last incomplete word are kept as they are
+    std::copy(src + word_num * shuffle_size_, src + raw_size,
+              buf_shuffled.data() + word_num * shuffle_size_);
+    src = buf_shuffled.data();
+  }
+
+  const unsigned int chunk_num = (raw_size + chunk_size_ - 1) / chunk_size_;
+  std::vector<BufferStr> chunks(chunk_num);
+  std::vector<int> rets(chunk_num, Z_OK);
+  cyber::ParallelFor(0, chunk_num, 1, [&](size_t i) {
+    const unsigned int begin = static_cast<unsigned int>(i) * chunk_size_;
+    const unsigned int size = std::min(chunk_size_, raw_size - begin);
+    uLongf compressed_size = compressBound(size);
+    chunks[i].resize(compressed_size);
+    rets[i] = compress2(chunks[i].data(), &compressed_size, src + begin, size,
+                        Z_BEST_SPEED);
+    chunks[i].resize(compressed_size);
+  });
+  for (const int ret : rets) {
+    if (ret != Z_OK) {
+      AERROR << "Failed to compress a map chunk, zlib error: " << ret;
+      return ret;
+    }
+  }
+
+  size_t total_size = header_size + chunk_num * sizeof(unsigned int);
+  for (const auto& chunk : chunks) {
+    total_size += chunk.size();
+  }
+  buf_compressed->resize(total_size);
+  unsigned char* dst = buf_compressed->data();
+  WriteWord(magic_number, dst);
+  WriteWord(raw_size, dst + 4);
+  WriteWord(chunk_size_, dst + 8);
+  WriteWord(shuffle_size_, dst + 12);
+  WriteWord(chunk_num, dst + 16);
+  dst += header_size;
+  for (const auto& chunk : chunks) {
+    WriteWord(static_cast<unsigned int>(chunk.size()), dst);
+    dst += sizeof(unsigned int);
+  }
+  for (const auto& chunk : chunks) {
+    dst = std::copy(chunk.begin(), chunk.end(), dst);
+  }
+  return Z_OK;
+}
+
+unsigned int ChunkedZlibStrategy::Decode(BufferStr* buf,
+                                         BufferStr* buf_uncompressed) {
+  if (buf->size() < header_size || ReadWord(buf->data()) != magic_number) {
+    ZlibStrategy zlib;
+    return zlib.Decode(buf, buf_uncompressed);
+  }
+  const unsigned char* src = buf->data();
+  const unsigned int raw_size = ReadWord(src + 4);
+  const unsigned int chunk_size = ReadWord(src + 8);
+  const unsigned int shuffle_size = ReadWord(src + 12);
+  const unsigned int chunk_num = ReadWord(src + 16);
+  if (chunk_size == 0 || shuffle_size == 0 ||
+      chunk_num != (raw_size + chunk_size - 1) / chunk_size ||
+      buf->size() < header_size + chunk_num * sizeof(unsigned int)) {
+    AERROR << "Corrupted chunked map data header.";
+    return Z_DATA_ERROR;
+  }
+  std::vector<size_t> chunk_offsets(chunk_num + 1);
+  chunk_offsets[0] = header_size + chunk_num * sizeof(unsigned int);
+  for (unsigned int i = 0; i < chunk_num; ++i) {
+    chunk_offsets[i + 1] =
+        chunk_offsets[i] + ReadWord(src + header_size + i * sizeof(unsigned int));
+  }
+  if (chunk_offsets[chunk_num] > buf->size()) {
+    AERROR << "Truncated chunked map data.";
+    return Z_DATA_ERROR;
+  }
+
+  BufferStr buf_shuffled;
+  BufferStr* inflated = shuffle_size > 1 ? &buf_shuffled : buf_uncompressed;
+  inflated->resize(raw_size);
+  std::vector<int> rets(chunk_num, Z_OK);
+  cyber::ParallelFor(0, chunk_num, 1, [&](size_t i) {
+    const unsigned int begin = static_cast<unsigned int>(i) * chunk_size;
+    const unsigned int size = std::min(chunk_size, raw_size - begin);
+    uLongf uncompressed_size = size;
+    rets[i] = uncompress(inflated->data() + begin, &uncompressed_size,
+                         src + chunk_offsets[i],
+                         chunk_offsets[i + 1] - chunk_offsets[i]);
+    if (rets[i] == Z_OK && uncompressed_size != size) {
+      rets[i] = Z_DATA_ERROR;
+    }
+  });
+  for (const int ret : rets) {
+    if (ret != Z_OK) {
+      AERROR << "Failed to uncompress a map chunk, zlib error: " << ret;
+      return Z_DATA_ERROR;
+    }
+  }
+
+  if (shuffle_size > 1) {
+    const size_t word_num = raw_size / shuffle_size;
+    const size_t word_grain = std::max<size_t>(chunk_size / shuffle_size, 1);
+    buf_uncompressed->resize(raw_size);
+    cyber::ParallelFor(
+        0, (word_num + word_grain - 1) / word_grain, 1, [&](size_t i) {
+          UnshuffleBytes(buf_shuffled.data(), word_num, shuffle_size,
+                         i * word_grain,
+                         std::min(word_num, (i + 1) * word_grain),
+                         buf_uncompressed->data());
+        });
+    std::copy(buf_shuffled.begin() + word_num * shuffle_size,
+              buf_shuffled.end(),
+              buf_uncompressed->begin() + word_num * shuffle_size);
+  }
+  return Z_OK;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
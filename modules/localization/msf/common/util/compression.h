@@ -43,6 +43,26 @@ class ZlibStrategy : public CompressionStrategy {
   unsigned int ZlibUncompress(BufferStr* src, BufferStr* dst);
 };
 
+/**@brief Compress the buffer in chunks of chunk_size bytes, each a zlib
+ * stream of its own, so that a map node is encoded and decoded by all the
+ * task threads at once. When shuffle_size is above 1, the buffer is taken as
+ * words of shuffle_size bytes and stored byte by byte of the words, e.g. all
+ * the exponent bytes of the floats together, which zlib compresses far
+ * better. The buffers encoded by ZlibStrategy are decoded as well. */
+class ChunkedZlibStrategy : public CompressionStrategy {
+ public:
+  explicit ChunkedZlibStrategy(unsigned int shuffle_size = 1,
+                               unsigned int chunk_size = 1 << 20);
+  virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
+  virtual unsigned int Decode(BufferStr* buf, BufferStr* buf_uncompressed);
+
+ protected:
+  static const unsigned int magic_number;
+  static const unsigned int header_size;
+  unsigned int shuffle_size_;
+  unsigned int chunk_size_;
+};
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -48,6 +48,45 @@ TEST_F(CompressionTestSuite, ZlibStrategyTest) {
   }
 }
 
+/**@brief ChunkedZlibStrategyTest. */
+TEST_F(CompressionTestSuite, ChunkedZlibStrategyTest) {
+  // several chunks and an incomplete last word
+  std::vector<unsigned char> buf_uncompressed;
+  for (int i = 0; i < 1000003; i++) {
+    buf_uncompressed.push_back((unsigned char)(i * 7 / 3));
+  }
+
+  for (unsigned int shuffle_size : {1, 4, 5}) {
+    ChunkedZlibStrategy chunked_zlib(shuffle_size, 65536);
+    std::vector<unsigned char> buf_compressed;
+    std::vector<unsigned char> buf_uncompressed2;
+    ASSERT_EQ(chunked_zlib.Encode(&buf_uncompressed, &buf_compressed), 0);
+    ASSERT_LT(buf_compressed.size(), buf_uncompressed.size());
+    ASSERT_EQ(chunked_zlib.Decode(&buf_compressed, &buf_uncompressed2), 0);
+    ASSERT_EQ(buf_uncompressed2, buf_uncompressed);
+
+    // a corrupted chunk fails instead of giving wrong data
+    buf_compressed[buf_compressed.size() / 2] ^= 0xff;
+    ASSERT_NE(chunked_zlib.Decode(&buf_compressed, &buf_uncompressed2), 0);
+  }
+}
+
+/**@brief ChunkedZlibStrategyDecodesZlibTest. */
+TEST_F(CompressionTestSuite, ChunkedZlibStrategyDecodesZlibTest) {
+  ZlibStrategy zlib;
+  ChunkedZlibStrategy chunked_zlib(4);
+  std::vector<unsigned char> buf_uncompressed;
+  std::vector<unsigned char> buf_compressed;
+  for (int i = 0; i < 255; i++) {
+    buf_uncompressed.push_back((unsigned char)i);
+  }
+
+  std::vector<unsigned char> buf_uncompressed2;
+  zlib.Encode(&buf_uncompressed, &buf_compressed);
+  ASSERT_EQ(chunked_zlib.Decode(&buf_compressed, &buf_uncompressed2), 0);
+  ASSERT_EQ(buf_uncompressed2, buf_uncompressed);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
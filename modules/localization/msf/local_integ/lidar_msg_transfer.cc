@@ -21,6 +21,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/localization/common/localization_gflags.h"
 
 namespace apollo {
@@ -34,18 +35,20 @@ void LidarMsgTransfer::Transfer(const drivers::PointCloud &msg,
   if (msg.height() > 1 && msg.width() > 1) {
     for (unsigned int i = 0; i < msg.height(); ++i) {
       for (unsigned int j = 0; j < msg.width(); ++j) {
+        const drivers::PackedPoint point =
+            drivers::GetPoint(msg, i * msg.width() + j);
         Eigen::Vector3d pt3d;
-        pt3d[0] = static_cast<double>(msg.point(i * msg.width() + j).x());
-        pt3d[1] = static_cast<double>(msg.point(i * msg.width() + j).y());
-        pt3d[2] = static_cast<double>(msg.point(i * msg.width() + j).z());
+        pt3d[0] = static_cast<double>(point.x);
+        pt3d[1] = static_cast<double>(point.y);
+        pt3d[2] = static_cast<double>(point.z);
         if (!std::isnan(pt3d[0])) {
           Eigen::Vector3d pt3d_tem = pt3d;
 
           if (pt3d_tem[2] > max_height_) {
             continue;
           }
-          unsigned char intensity = static_cast<unsigned char>(
-              msg.point(i * msg.width() + j).intensity());
+          unsigned char intensity =
+              static_cast<unsigned char>(point.intensity);
           lidar_frame->pt_xs.push_back(pt3d[0]);
           lidar_frame->pt_ys.push_back(pt3d[1]);
           lidar_frame->pt_zs.push_back(pt3d[2]);
@@ -55,20 +58,21 @@ void LidarMsgTransfer::Transfer(const drivers::PointCloud &msg,
     }
   } else {
     AINFO << "Receiving un-origanized-point-cloud, width " << msg.width()
-          << " height " << msg.height() << "size " << msg.point_size();
-    for (int i = 0; i < msg.point_size(); ++i) {
+          << " height " << msg.height() << "size " << drivers::PointNum(msg);
+    const int point_num = drivers::PointNum(msg);
+    for (int i = 0; i < point_num; ++i) {
+      const drivers::PackedPoint point = drivers::GetPoint(msg, i);
       Eigen::Vector3d pt3d;
-      pt3d[0] = static_cast<double>(msg.point(i).x());
-      pt3d[1] = static_cast<double>(msg.point(i).y());
-      pt3d[2] = static_cast<double>(msg.point(i).z());
+      pt3d[0] = static_cast<double>(point.x);
+      pt3d[1] = static_cast<double>(point.y);
+      pt3d[2] = static_cast<double>(point.z);
       if (!std::isnan(pt3d[0])) {
         Eigen::Vector3d pt3d_tem = pt3d;
 
         if (pt3d_tem[2] > max_height_) {
           continue;
         }
-        unsigned char intensity =
-            static_cast<unsigned char>(msg.point(i).intensity());
+        unsigned char intensity = static_cast<unsigned char>(point.intensity);
         lidar_frame->pt_xs.push_back(pt3d[0]);
         lidar_frame->pt_ys.push_back(pt3d[1]);
         lidar_frame->pt_zs.push_back(pt3d[2]);
@@ -83,7 +87,7 @@ void LidarMsgTransfer::Transfer(const drivers::PointCloud &msg,
     AINFO << std::setprecision(15) << "LocalLidar Debug Log: velodyne msg. "
           << "[time:" << lidar_frame->measurement_time
           << "][height:" << msg.height() << "][width:" << msg.width()
-          << "][point_cnt:" << msg.point_size() << "]";
+          << "][point_cnt:" << drivers::PointNum(msg) << "]";
   }
   return;
 }
@@ -0,0 +1,376 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_integ/lidar_ssd_matcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+namespace {
+
+// online cells summed between two checks of the early termination
+constexpr int kTerminationCheckCells = 32;
+
+struct CellArrays {
+  const int* indices;
+  const float* intensities;
+  const float* intensities_var;
+  const float* altitudes;
+  int num;
+};
+
+struct MapArrays {
+  const float* intensities;
+  const float* intensities_var;
+  const float* altitudes;
+  const unsigned int* counts;
+};
+
+struct ScoreParams {
+  float altitude_weight;
+  float missing_cell_score;
+  // the lanes stop once all of them exceed it
+  float bound;
+};
+
+// Sum the cell scores of the lanes at map offset, return the cells summed.
+int ScoreLanesScalar(const CellArrays& cells, const MapArrays& map,
+                     int offset, const ScoreParams& params, float* ssd) {
+  constexpr int kLaneNum = LidarSsdMatcher::kLaneNum;
+  float acc[kLaneNum] = {0.0f};
+  for (int i = 0; i < cells.num; ++i) {
+    const int idx = cells.indices[i] + offset;
+    for (int lane = 0; lane < kLaneNum; ++lane) {
+      const float diff_intensity =
+          map.intensities[idx + lane] - cells.intensities[i];
+      const float denominator =
+          map.intensities_var[idx + lane] + cells.intensities_var[i] + 1.0f;
+      float score = diff_intensity * diff_intensity / denominator;
+      const float diff_altitude =
+          map.altitudes[idx + lane] - cells.altitudes[i];
+      score += params.altitude_weight * (diff_altitude * diff_altitude);
+      acc[lane] += map.counts[idx + lane] == 0 ? params.missing_cell_score
+                                               : score;
+    }
+    if ((i + 1) % kTerminationCheckCells == 0 &&
+        *std::min_element(acc, acc + kLaneNum) > params.bound) {
+      std::copy(acc, acc + kLaneNum, ssd);
+      return i + 1;
+    }
+  }
+  std::copy(acc, acc + kLaneNum, ssd);
+  return cells.num;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) int ScoreLanesSimd(const CellArrays& cells,
+                                                   const MapArrays& map,
+                                                   int offset,
+                                                   const ScoreParams& params,
+                                                   float* ssd) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 altitude_weight = _mm256_set1_ps(params.altitude_weight);
+  const __m256 missing_cell_score = _mm256_set1_ps(params.missing_cell_score);
+  const __m256 bound = _mm256_set1_ps(params.bound);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256 acc = _mm256_setzero_ps();
+  for (int i = 0; i < cells.num; ++i) {
+    const int idx = cells.indices[i] + offset;
+    const __m256 diff_intensity =
+        _mm256_sub_ps(_mm256_loadu_ps(map.intensities + idx),
+                      _mm256_set1_ps(cells.intensities[i]));
+    const __m256 denominator = _mm256_add_ps(
+        _mm256_add_ps(_mm256_loadu_ps(map.intensities_var + idx),
+                      _mm256_set1_ps(cells.intensities_var[i])),
+        one);
+    __m256 score = _mm256_div_ps(_mm256_mul_ps(diff_intensity, diff_intensity),
+                                 denominator);
+    const __m256 diff_altitude =
+        _mm256_sub_ps(_mm256_loadu_ps(map.altitudes + idx),
+                      _mm256_set1_ps(cells.altitudes[i]));
+    score = _mm256_add_ps(
+        score, _mm256_mul_ps(altitude_weight,
+                             _mm256_mul_ps(diff_altitude, diff_altitude)));
+    const __m256i counts = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(map.counts + idx));
+    const __m256 empty =
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(counts, zero));
+    acc = _mm256_add_ps(acc, _mm256_blendv_ps(score, missing_cell_score,
+                                              empty));
+    if ((i + 1) % kTerminationCheckCells == 0 &&
+        _mm256_movemask_ps(_mm256_cmp_ps(acc, bound, _CMP_GT_OQ)) == 0xff) {
+      _mm256_storeu_ps(ssd, acc);
+      return i + 1;
+    }
+  }
+  _mm256_storeu_ps(ssd, acc);
+  return cells.num;
+}
+#elif defined(__aarch64__)
+int ScoreLanesSimd(const CellArrays& cells, const MapArrays& map, int offset,
+                   const ScoreParams& params, float* ssd) {
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t altitude_weight = vdupq_n_f32(params.altitude_weight);
+  const float32x4_t missing_cell_score =
+      vdupq_n_f32(params.missing_cell_score);
+  float32x4_t acc[2] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+  for (int i = 0; i < cells.num; ++i) {
+    const int idx = cells.indices[i] + offset;
+    const float32x4_t intensity = vdupq_n_f32(cells.intensities[i]);
+    const float32x4_t intensity_var = vdupq_n_f32(cells.intensities_var[i]);
+    const float32x4_t altitude = vdupq_n_f32(cells.altitudes[i]);
+    for (int half = 0; half < 2; ++half) {
+      const int lane_idx = idx + 4 * half;
+      const float32x4_t diff_intensity =
+          vsubq_f32(vld1q_f32(map.intensities + lane_idx), intensity);
+      const float32x4_t denominator = vaddq_f32(
+          vaddq_f32(vld1q_f32(map.intensities_var + lane_idx), intensity_var),
+          one);
+      float32x4_t score =
+          vdivq_f32(vmulq_f32(diff_intensity, diff_intensity), denominator);
+      const float32x4_t diff_altitude =
+          vsubq_f32(vld1q_f32(map.altitudes + lane_idx), altitude);
+      score = vaddq_f32(score, vmulq_f32(altitude_weight,
+                                         vmulq_f32(diff_altitude,
+                                                   diff_altitude)));
+      const uint32x4_t empty =
+          vceqq_u32(vld1q_u32(map.counts + lane_idx), vdupq_n_u32(0));
+      acc[half] =
+          vaddq_f32(acc[half], vbslq_f32(empty, missing_cell_score, score));
+    }
+    if ((i + 1) % kTerminationCheckCells == 0 &&
+        std::min(vminvq_f32(acc[0]), vminvq_f32(acc[1])) > params.bound) {
+      vst1q_f32(ssd, acc[0]);
+      vst1q_f32(ssd + 4, acc[1]);
+      return i + 1;
+    }
+  }
+  vst1q_f32(ssd, acc[0]);
+  vst1q_f32(ssd + 4, acc[1]);
+  return cells.num;
+}
+#else
+int ScoreLanesSimd(const CellArrays& cells, const MapArrays& map, int offset,
+                   const ScoreParams& params, float* ssd) {
+  return ScoreLanesScalar(cells, map, offset, params, ssd);
+}
+#endif
+
+// 0, -1, 1, -2, 2, ... within [begin, end), starting from center
+std::vector<int> CenterOutOrder(int begin, int end, int center) {
+  std::vector<int> order;
+  order.reserve(end - begin);
+  for (int step = 0; static_cast<int>(order.size()) < end - begin; ++step) {
+    if (center - step >= begin && center - step < end) {
+      order.push_back(center - step);
+    }
+    if (step > 0 && center + step >= begin && center + step < end) {
+      order.push_back(center + step);
+    }
+  }
+  return order;
+}
+
+}  // namespace
+
+LidarSsdMatcher::LidarSsdMatcher(int search_range_x, int search_range_y)
+    : search_range_x_(search_range_x), search_range_y_(search_range_y) {
+  padded_offset_num_x_ =
+      (GetSsdWidth() + kLaneNum - 1) / kLaneNum * kLaneNum;
+}
+
+void LidarSsdMatcher::SetMapNodeData(int width, int height,
+                                     const float* intensities,
+                                     const float* intensities_var,
+                                     const float* altitudes,
+                                     const unsigned int* counts) {
+  map_width_ = width;
+  map_height_ = height;
+  map_intensities_ = intensities;
+  map_intensities_var_ = intensities_var;
+  map_altitudes_ = altitudes;
+  map_counts_ = counts;
+}
+
+void LidarSsdMatcher::SetMapNodeLeftTopCorner(double x, double y,
+                                              double resolution) {
+  map_left_top_corner_ = Eigen::Vector2d(x, y);
+  map_resolution_ = resolution;
+}
+
+void LidarSsdMatcher::SetPointCloud(const Eigen::Affine3d& lidar_pose,
+                                    int size, const double* pt_xs,
+                                    const double* pt_ys, const double* pt_zs,
+                                    const unsigned char* intensities) {
+  cell_indices_.clear();
+  cell_intensities_.clear();
+  cell_intensities_var_.clear();
+  cell_altitudes_.clear();
+  if (map_counts_ == nullptr) {
+    AERROR << "The map node data is not set.";
+    return;
+  }
+
+  const size_t grid_size = static_cast<size_t>(map_width_) * map_height_;
+  if (grid_counts_.size() != grid_size) {
+    grid_counts_.assign(grid_size, 0);
+    grid_intensity_sums_.assign(grid_size, 0.0f);
+    grid_intensity_sqr_sums_.assign(grid_size, 0.0f);
+    grid_altitude_sums_.assign(grid_size, 0.0f);
+  }
+
+  // Accumulate the points in the map cells they fall into
+  for (int i = 0; i < size; ++i) {
+    const Eigen::Vector3d point =
+        lidar_pose * Eigen::Vector3d(pt_xs[i], pt_ys[i], pt_zs[i]);
+    const int x = static_cast<int>(
+        std::floor((point[0] - map_left_top_corner_[0]) / map_resolution_));
+    const int y = static_cast<int>(
+        std::floor((point[1] - map_left_top_corner_[1]) / map_resolution_));
+    if (x < 0 || x >= map_width_ || y < 0 || y >= map_height_) {
+      continue;
+    }
+    const int idx = y * map_width_ + x;
+    if (grid_counts_[idx]++ == 0) {
+      grid_touched_.push_back(idx);
+    }
+    const float intensity = static_cast<float>(intensities[i]);
+    grid_intensity_sums_[idx] += intensity;
+    grid_intensity_sqr_sums_[idx] += intensity * intensity;
+    grid_altitude_sums_[idx] += static_cast<float>(point[2]);
+  }
+
+  // Keep the cells whose offsets all stay on the map, padded to whole lanes
+  for (const int idx : grid_touched_) {
+    const int x = idx % map_width_ - search_range_x_;
+    const int y = idx / map_width_ - search_range_y_;
+    if (x >= 0 && x + padded_offset_num_x_ <= map_width_ && y >= 0 &&
+        y + GetSsdHeight() <= map_height_) {
+      const float count = static_cast<float>(grid_counts_[idx]);
+      const float intensity = grid_intensity_sums_[idx] / count;
+      cell_indices_.push_back(y * map_width_ + x);
+      cell_intensities_.push_back(intensity);
+      cell_intensities_var_.push_back(std::max(
+          grid_intensity_sqr_sums_[idx] / count - intensity * intensity,
+          0.0f));
+      cell_altitudes_.push_back(grid_altitude_sums_[idx] / count);
+    }
+    grid_counts_[idx] = 0;
+    grid_intensity_sums_[idx] = 0.0f;
+    grid_intensity_sqr_sums_[idx] = 0.0f;
+    grid_altitude_sums_[idx] = 0.0f;
+  }
+  grid_touched_.clear();
+}
+
+bool LidarSsdMatcher::Match(bool use_simd) {
+  stats_ = MatchStats();
+  stats_.cell_num = static_cast<int>(cell_indices_.size());
+  const int ssd_width = GetSsdWidth();
+  const int ssd_height = GetSsdHeight();
+  ssd_.assign(static_cast<size_t>(ssd_width) * ssd_height, 0.0f);
+  best_dx_ = 0;
+  best_dy_ = 0;
+  if (cell_indices_.empty()) {
+    AERROR << "No online cell on the map.";
+    return false;
+  }
+
+  const CellArrays cells = {cell_indices_.data(), cell_intensities_.data(),
+                            cell_intensities_var_.data(),
+                            cell_altitudes_.data(), stats_.cell_num};
+  const MapArrays map = {map_intensities_, map_intensities_var_,
+                         map_altitudes_, map_counts_};
+  ScoreParams params = {altitude_weight_, missing_cell_score_,
+                        std::numeric_limits<float>::max()};
+  const bool simd = use_simd && HasSimdKernel();
+
+  // The offsets near the prediction first, so that the best SSD found so
+  // far stops the far offsets early
+  const int block_num = padded_offset_num_x_ / kLaneNum;
+  const std::vector<int> rows =
+      CenterOutOrder(0, ssd_height, search_range_y_);
+  const std::vector<int> blocks =
+      CenterOutOrder(0, block_num, search_range_x_ / kLaneNum);
+  float best_ssd = std::numeric_limits<float>::max();
+  float lanes[kLaneNum];
+  for (const int row : rows) {
+    for (const int block : blocks) {
+      const int col = block * kLaneNum;
+      if (termination_margin_ >= 0.0f &&
+          best_ssd < std::numeric_limits<float>::max()) {
+        params.bound = best_ssd + termination_margin_;
+      }
+      const int offset = row * map_width_ + col;
+      const int scored = simd
+                             ? ScoreLanesSimd(cells, map, offset, params, lanes)
+                             : ScoreLanesScalar(cells, map, offset, params,
+                                                lanes);
+      const int lane_num = std::min(kLaneNum, ssd_width - col);
+      stats_.cell_score_num += static_cast<int64_t>(scored) * lane_num;
+      if (scored < stats_.cell_num) {
+        stats_.terminated_offset_num += lane_num;
+      }
+      for (int lane = 0; lane < lane_num; ++lane) {
+        ssd_[row * ssd_width + col + lane] = lanes[lane];
+        if (scored == stats_.cell_num && lanes[lane] < best_ssd) {
+          best_ssd = lanes[lane];
+          best_dx_ = col + lane - search_range_x_;
+          best_dy_ = row - search_range_y_;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void LidarSsdMatcher::GetBestOffset(int* dx, int* dy) const {
+  *dx = best_dx_;
+  *dy = best_dy_;
+}
+
+Eigen::Vector2d LidarSsdMatcher::GetBestTranslation() const {
+  return Eigen::Vector2d(best_dx_ * map_resolution_,
+                         best_dy_ * map_resolution_);
+}
+
+bool LidarSsdMatcher::HasSimdKernel() {
+#if defined(__x86_64__)
+  return __builtin_cpu_supports("avx2");
+#elif defined(__aarch64__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Eigen/Geometry"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**@brief Grid search of the planar offset of an online lidar frame against
+ * the composed reflectance map. Each candidate offset is scored by the sum
+ * of squared intensity and altitude differences (SSD) over the occupied
+ * online cells. The cells are kept as structure of arrays so that AVX2 or
+ * NEON lanes score neighbouring x offsets at once. */
+class LidarSsdMatcher {
+ public:
+  /**@brief Counters of the last Match(). */
+  struct MatchStats {
+    /**@brief Occupied online cells that were scored. */
+    int cell_num = 0;
+    /**@brief Cell scores summed over all the offsets. */
+    int64_t cell_score_num = 0;
+    /**@brief Offsets whose sum was stopped early. */
+    int terminated_offset_num = 0;
+  };
+
+  /**@brief The search covers [-range_x, range_x] x [-range_y, range_y]
+   * cells. */
+  LidarSsdMatcher(int search_range_x, int search_range_y);
+
+  /**@brief Set the composed map around the pose, the arrays are row major
+   * width x height and are not copied. */
+  void SetMapNodeData(int width, int height, const float* intensities,
+                      const float* intensities_var, const float* altitudes,
+                      const unsigned int* counts);
+
+  /**@brief Set the map coordinate of the left top cell of the map. */
+  void SetMapNodeLeftTopCorner(double x, double y, double resolution);
+
+  /**@brief Project the lidar points, given in the lidar frame, into the
+   * online grid at the lidar pose. */
+  void SetPointCloud(const Eigen::Affine3d& lidar_pose, int size,
+                     const double* pt_xs, const double* pt_ys,
+                     const double* pt_zs, const unsigned char* intensities);
+
+  /**@brief Weight of the squared altitude differences, in 1/m^2. */
+  void SetAltitudeWeight(float weight) { altitude_weight_ = weight; }
+
+  /**@brief Score of an online cell above a map cell without data. */
+  void SetMissingCellScore(float score) { missing_cell_score_ = score; }
+
+  /**@brief Stop summing the cells of an offset once its SSD exceeds the
+   * best one by the margin, a negative margin scores all the cells. */
+  void SetTerminationMargin(float margin) { termination_margin_ = margin; }
+
+  /**@brief Score all the offsets, with the AVX2 or NEON kernel when
+   * use_simd is set and the platform has one. Return false when no online
+   * cell lies on the map. */
+  bool Match(bool use_simd);
+
+  /**@brief Get the best offset in cells, and in map coordinates. */
+  void GetBestOffset(int* dx, int* dy) const;
+  Eigen::Vector2d GetBestTranslation() const;
+
+  /**@brief Get the SSD of the offsets, (2 * range_y + 1) rows of
+   * (2 * range_x + 1). The SSD of a terminated offset is a lower bound. */
+  const std::vector<float>& GetSsd() const { return ssd_; }
+  int GetSsdWidth() const { return 2 * search_range_x_ + 1; }
+  int GetSsdHeight() const { return 2 * search_range_y_ + 1; }
+
+  const MatchStats& GetMatchStats() const { return stats_; }
+
+  /**@brief Get the occupied online cells of the last SetPointCloud(). */
+  int GetCellNum() const { return static_cast<int>(cell_indices_.size()); }
+
+  /**@brief Whether Match() can use a SIMD kernel on this platform. */
+  static bool HasSimdKernel();
+
+  /**@brief The x offsets scored at once. */
+  static constexpr int kLaneNum = 8;
+
+ private:
+  int search_range_x_ = 0;
+  int search_range_y_ = 0;
+  /**@brief The x offsets rounded up to whole lanes. */
+  int padded_offset_num_x_ = 0;
+
+  int map_width_ = 0;
+  int map_height_ = 0;
+  const float* map_intensities_ = nullptr;
+  const float* map_intensities_var_ = nullptr;
+  const float* map_altitudes_ = nullptr;
+  const unsigned int* map_counts_ = nullptr;
+  Eigen::Vector2d map_left_top_corner_ = Eigen::Vector2d::Zero();
+  double map_resolution_ = 0.125;
+
+  /**@brief The occupied online cells, at the map index of offset
+   * (-range_x, -range_y). */
+  std::vector<int> cell_indices_;
+  std::vector<float> cell_intensities_;
+  std::vector<float> cell_intensities_var_;
+  std::vector<float> cell_altitudes_;
+
+  /**@brief Per map cell sums of the online points, reset after use. */
+  std::vector<int> grid_counts_;
+  std::vector<float> grid_intensity_sums_;
+  std::vector<float> grid_intensity_sqr_sums_;
+  std::vector<float> grid_altitude_sums_;
+  std::vector<int> grid_touched_;
+
+  float altitude_weight_ = 1.0f;
+  float missing_cell_score_ = 4.0f;
+  float termination_margin_ = -1.0f;
+
+  std::vector<float> ssd_;
+  int best_dx_ = 0;
+  int best_dy_ = 0;
+  MatchStats stats_;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Times the SSD grid search of LidarSsdMatcher on a synthetic reflectance
+ * map, with the scalar and the SIMD kernel, with and without the early
+ * termination, and checks that they find the same offset.
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/localization/msf/local_integ/lidar_ssd_matcher.h"
+
+DEFINE_int32(benchmark_map_size, 1024, "map cells along x and y");
+DEFINE_int32(benchmark_search_range, 21, "search range in cells");
+DEFINE_int32(benchmark_points, 100000, "lidar points per frame");
+DEFINE_int32(benchmark_cycles, 10, "matches per configuration");
+DEFINE_double(benchmark_termination_margin, 2000.0,
+              "termination margin of the early terminated runs");
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace {
+
+constexpr double kResolution = 0.125;
+
+void Run() {
+  const int size = FLAGS_benchmark_map_size;
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+
+  // Asphalt with lane markings every 3.75 m and patches, on a gentle slope
+  std::vector<float> intensities(size * size);
+  std::vector<float> intensities_var(size * size);
+  std::vector<float> altitudes(size * size);
+  std::vector<unsigned int> counts(size * size);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      const int idx = y * size + x;
+      const double px = x * kResolution;
+      const double py = y * kResolution;
+      float intensity = 20.0f + 10.0f * uniform(generator);
+      if (std::fmod(py, 3.75) < 0.15) {
+        intensity = 180.0f;
+      }
+      if (std::sin(px * 0.7) * std::cos(py * 0.3) > 0.8) {
+        intensity += 60.0f;
+      }
+      intensities[idx] = intensity;
+      intensities_var[idx] = 10.0f + 20.0f * uniform(generator);
+      altitudes[idx] = static_cast<float>(0.01 * px + 0.3 * std::sin(py));
+      counts[idx] = uniform(generator) < 0.05f ? 0 : 5;
+    }
+  }
+
+  // A frame sampled from the map around the center, off by a known offset
+  const int true_dx = 5;
+  const int true_dy = -3;
+  std::vector<double> xs, ys, zs;
+  std::vector<unsigned char> frame_intensities;
+  const double center = size * kResolution / 2.0;
+  for (int i = 0; i < FLAGS_benchmark_points; ++i) {
+    const double radius = 40.0 * std::sqrt(uniform(generator));
+    const double angle = 2.0 * M_PI * uniform(generator);
+    const double px = center + radius * std::cos(angle);
+    const double py = center + radius * std::sin(angle);
+    const int idx = static_cast<int>(py / kResolution) * size +
+                    static_cast<int>(px / kResolution);
+    xs.push_back(px - true_dx * kResolution);
+    ys.push_back(py - true_dy * kResolution);
+    zs.push_back(altitudes[idx] + 0.02 * noise(generator));
+    frame_intensities.push_back(static_cast<unsigned char>(std::min(
+        255.0f, std::max(0.0f, intensities[idx] + 3.0f * noise(generator)))));
+  }
+
+  LidarSsdMatcher matcher(FLAGS_benchmark_search_range,
+                          FLAGS_benchmark_search_range);
+  matcher.SetMapNodeData(size, size, intensities.data(),
+                         intensities_var.data(), altitudes.data(),
+                         counts.data());
+  matcher.SetMapNodeLeftTopCorner(0.0, 0.0, kResolution);
+  auto start = std::chrono::steady_clock::now();
+  matcher.SetPointCloud(Eigen::Affine3d::Identity(), FLAGS_benchmark_points,
+                        xs.data(), ys.data(), zs.data(),
+                        frame_intensities.data());
+  const double grid_ms = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  std::cout << "online grid: " << grid_ms << " ms, "
+            << matcher.GetCellNum() << " cells, simd kernel "
+            << (LidarSsdMatcher::HasSimdKernel() ? "available" : "missing")
+            << std::endl;
+
+  std::vector<float> reference;
+  for (const bool early_termination : {false, true}) {
+    for (const bool use_simd : {false, true}) {
+      matcher.SetTerminationMargin(
+          early_termination
+              ? static_cast<float>(FLAGS_benchmark_termination_margin)
+              : -1.0f);
+      start = std::chrono::steady_clock::now();
+      for (int cycle = 0; cycle < FLAGS_benchmark_cycles; ++cycle) {
+        matcher.Match(use_simd);
+      }
+      const double match_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count() /
+                              FLAGS_benchmark_cycles;
+      int dx = 0;
+      int dy = 0;
+      matcher.GetBestOffset(&dx, &dy);
+      const auto& ssd = matcher.GetSsd();
+      if (reference.empty()) {
+        reference = ssd;
+      }
+      // The terminated offsets only have a lower bound of their SSD
+      double max_relative_diff = 0.0;
+      for (size_t i = 0; i < ssd.size(); ++i) {
+        if (!early_termination ||
+            i == static_cast<size_t>((dy + FLAGS_benchmark_search_range) *
+                                         matcher.GetSsdWidth() +
+                                     dx + FLAGS_benchmark_search_range)) {
+          max_relative_diff =
+              std::max(max_relative_diff,
+                       std::fabs(static_cast<double>(ssd[i] - reference[i])) /
+                           reference[i]);
+        }
+      }
+      const auto& stats = matcher.GetMatchStats();
+      std::cout << (use_simd ? "simd  " : "scalar")
+                << (early_termination ? ", early termination: " : ": ")
+                << match_ms << " ms, offset " << dx << ", " << dy
+                << " (true " << true_dx << ", " << true_dy << "), ssd "
+                << ssd[(dy + FLAGS_benchmark_search_range) *
+                           matcher.GetSsdWidth() +
+                       dx + FLAGS_benchmark_search_range]
+                << ", "
+                << stats.terminated_offset_num << "/" << ssd.size()
+                << " offsets terminated, "
+                << static_cast<double>(stats.cell_score_num) /
+                       (static_cast<double>(stats.cell_num) * ssd.size())
+                << " of the cell scores, max ssd diff "
+                << (early_termination ? "(best offset) " : "")
+                << max_relative_diff << std::endl;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::localization::msf::Run();
+  return 0;
+}
@@ -29,6 +29,13 @@ namespace msf {
 
 using apollo::common::Status;
 
+namespace {
+
+// measures between two reports of the measure latency
+constexpr int kLatencyReportCount = 500;
+
+}  // namespace
+
 LocalizationIntegProcess::LocalizationIntegProcess()
     : sins_(new Sins()),
       gnss_antenna_extrinsic_(TransformD::Identity()),
@@ -72,6 +79,12 @@ Status LocalizationIntegProcess::Init(const LocalizationIntegParam &param) {
 
   sins_->SetVelThresholdGetYaw(param.vel_threshold_get_yaw);
 
+  measure_reorder_window_ = param.measure_reorder_window;
+  if (!measure_data_queue_.Init(measure_data_queue_size_)) {
+    return Status(common::LOCALIZATION_ERROR_INTEG,
+                  "failed to init the measure data queue");
+  }
+
   StartThreadLoop();
 
   return Status::OK();
@@ -243,14 +256,24 @@ void LocalizationIntegProcess::GetResult(IntegState *state, InsPva *sins_pva,
 
 void LocalizationIntegProcess::MeasureDataProcess(
     const MeasureData &measure_msg) {
-  measure_data_queue_mutex_.lock();
-  measure_data_queue_.push(measure_msg);
-  measure_data_queue_mutex_.unlock();
+  QueuedMeasure queued;
+  queued.measure = measure_msg;
+  queued.enqueue_time = cyber::Time::MonoTime().ToSecond();
+  if (measure_data_queue_.Enqueue(queued)) {
+    return;
+  }
+  // full, drop the oldest measure to keep the latest ones
+  QueuedMeasure dropped;
+  if (measure_data_queue_.Dequeue(&dropped)) {
+    ++dropped_measure_count_;
+  }
+  if (!measure_data_queue_.Enqueue(queued)) {
+    ++dropped_measure_count_;
+  }
 }
 
 void LocalizationIntegProcess::StartThreadLoop() {
   keep_running_ = true;
-  measure_data_queue_size_ = 150;
   cyber::Async(&LocalizationIntegProcess::MeasureDataThreadLoop, this);
 }
 
@@ -262,39 +285,76 @@ void LocalizationIntegProcess::StopThreadLoop() {
 
 void LocalizationIntegProcess::MeasureDataThreadLoop() {
   AINFO << "Started measure data process thread";
+  QueuedMeasure queued;
   while (keep_running_.load()) {
-    {
-      std::unique_lock<std::mutex> lock(measure_data_queue_mutex_);
-      int size = static_cast<int>(measure_data_queue_.size());
-      while (size > measure_data_queue_size_) {
-        measure_data_queue_.pop();
-        --size;
-      }
-      if (measure_data_queue_.size() == 0) {
-        lock.unlock();
-        cyber::Yield();
-        continue;
-      }
-    }
-
-    MeasureData measure;
-    int waiting_num = 0;
-    {
-      std::unique_lock<std::mutex> lock(measure_data_queue_mutex_);
-      measure = measure_data_queue_.front();
-      measure_data_queue_.pop();
-      waiting_num = static_cast<int>(measure_data_queue_.size());
+    while (measure_data_queue_.Dequeue(&queued)) {
+      queued.dequeue_time = cyber::Time::MonoTime().ToSecond();
+      latest_measure_time_ =
+          std::max(latest_measure_time_, queued.measure.time);
+      reorder_buffer_.push(queued);
     }
 
+    const int waiting_num = static_cast<int>(reorder_buffer_.size());
     if (waiting_num > measure_data_queue_size_ / 4) {
       AWARN << waiting_num << " measure are waiting to process.";
     }
 
-    MeasureDataProcessImpl(measure);
+    bool is_processed = false;
+    double now = cyber::Time::MonoTime().ToSecond();
+    while (!reorder_buffer_.empty() &&
+           IsMeasureReleasable(reorder_buffer_.top(), now)) {
+      queued = reorder_buffer_.top();
+      reorder_buffer_.pop();
+      if (queued.measure.time < applied_measure_time_) {
+        ++out_of_order_measure_count_;
+      }
+      applied_measure_time_ = queued.measure.time;
+
+      MeasureDataProcessImpl(queued.measure);
+
+      const double processed_time = cyber::Time::MonoTime().ToSecond();
+      queue_latency_.Add(queued.dequeue_time - queued.enqueue_time);
+      reorder_latency_.Add(now - queued.dequeue_time);
+      update_latency_.Add(processed_time - now);
+      now = processed_time;
+      if (++latency_measure_count_ >= kLatencyReportCount) {
+        ReportMeasureLatency();
+      }
+      is_processed = true;
+    }
+
+    if (!is_processed) {
+      cyber::Yield();
+    }
   }
   AINFO << "Exited measure data process thread";
 }
 
+bool LocalizationIntegProcess::IsMeasureReleasable(const QueuedMeasure &queued,
+                                                   const double now) const {
+  return latest_measure_time_ - queued.measure.time >=
+             measure_reorder_window_ ||
+         now - queued.dequeue_time >= measure_reorder_window_;
+}
+
+void LocalizationIntegProcess::ReportMeasureLatency() {
+  const double count = static_cast<double>(latency_measure_count_);
+  AINFO << std::setprecision(3) << "Measure latency of " << count
+        << " measures in ms (mean/max): queue "
+        << queue_latency_.sum / count * 1e3 << "/" << queue_latency_.max * 1e3
+        << ", reorder " << reorder_latency_.sum / count * 1e3 << "/"
+        << reorder_latency_.max * 1e3 << ", update "
+        << update_latency_.sum / count * 1e3 << "/"
+        << update_latency_.max * 1e3 << ", out of order "
+        << out_of_order_measure_count_ << ", dropped "
+        << dropped_measure_count_.exchange(0);
+  queue_latency_ = StageLatency();
+  reorder_latency_ = StageLatency();
+  update_latency_ = StageLatency();
+  latency_measure_count_ = 0;
+  out_of_order_measure_count_ = 0;
+}
+
 void LocalizationIntegProcess::MeasureDataProcessImpl(
     const MeasureData &measure_msg) {
   common::time::Timer timer;
@@ -16,11 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 #include "Eigen/Geometry"
+#include "cyber/base/bounded_queue.h"
 #include "cyber/cyber.h"
 
 #include "include/sins.h"
@@ -77,6 +81,31 @@ class LocalizationIntegProcess {
 
   void GetValidFromOK();
 
+ private:
+  struct QueuedMeasure {
+    MeasureData measure;
+    double enqueue_time = 0.0;
+    double dequeue_time = 0.0;
+  };
+  // orders the reorder buffer by measure time, the earliest on top
+  struct LaterMeasure {
+    bool operator()(const QueuedMeasure &lhs, const QueuedMeasure &rhs) const {
+      return lhs.measure.time > rhs.measure.time;
+    }
+  };
+  // latency of one stage of the measure processing, in seconds
+  struct StageLatency {
+    void Add(const double latency) {
+      sum += latency;
+      max = std::max(max, latency);
+    }
+    double sum = 0.0;
+    double max = 0.0;
+  };
+
+  bool IsMeasureReleasable(const QueuedMeasure &queued, double now) const;
+  void ReportMeasureLatency();
+
  private:
   Sins *sins_;
 
@@ -90,9 +119,24 @@ class LocalizationIntegProcess {
   double pva_covariance_[9][9];
 
   std::atomic<bool> keep_running_;
-  std::queue<MeasureData> measure_data_queue_;
+  // lidar and gnss threads push, the measure data thread pops
+  cyber::base::BoundedQueue<QueuedMeasure> measure_data_queue_;
   int measure_data_queue_size_ = 150;
-  std::mutex measure_data_queue_mutex_;
+  std::atomic<int> dropped_measure_count_ = {0};
+
+  // measures are held until they are measure_reorder_window_ older than the
+  // latest one, or waited that long, so they are applied in time order
+  std::priority_queue<QueuedMeasure, std::vector<QueuedMeasure>, LaterMeasure>
+      reorder_buffer_;
+  double measure_reorder_window_ = 0.0;
+  double latest_measure_time_ = 0.0;
+  double applied_measure_time_ = 0.0;
+
+  StageLatency queue_latency_;
+  StageLatency reorder_latency_;
+  StageLatency update_latency_;
+  int latency_measure_count_ = 0;
+  int out_of_order_measure_count_ = 0;
 
   int delay_output_counter_ = 0;
 };
@@ -16,10 +16,21 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+// lidar frames to look ahead, 10s at 10hz
+constexpr int kPrefetchHorizonFrames = 100;
+// the map nodes prefetched beyond PreloadMapArea, kept small so that they do
+// not push the nodes around the car out of the cache
+constexpr int kMaxPrefetchNodes = 4;
+}  // namespace
+
 LocalizationLidar::LocalizationLidar()
     : lidar_locator_(new LidarLocator()),
       search_range_x_(21),
@@ -120,6 +131,28 @@ void LocalizationLidar::SetDeltaPitchRollLimit(double limit) {
   lidar_locator_->SetDeltaPitchRollLimit(limit);
 }
 
+void LocalizationLidar::PrefetchMapAhead(const Eigen::Vector3d& trans,
+                                         const Eigen::Vector3d& velocity) {
+  const double frame_dist = velocity.head<2>().norm();
+  if (frame_dist < 1e-3) {
+    return;
+  }
+  // sample a few points per node so that none is skipped
+  const double node_length =
+      std::min(node_size_x_, node_size_y_) * resolution_;
+  const int frame_step =
+      std::max(1, static_cast<int>(node_length / 4.0 / frame_dist));
+  std::vector<Eigen::Vector3d> path_points;
+  for (int frame = frame_step; frame <= kPrefetchHorizonFrames;
+       frame += frame_step) {
+    Eigen::Vector3d pt = trans + velocity * frame;
+    pt[2] = 0;
+    path_points.push_back(pt);
+  }
+  map_.PrefetchMapNodes(path_points, resolution_id_, zone_id_,
+                        kMaxPrefetchNodes);
+}
+
 int LocalizationLidar::Update(const unsigned int frame_idx,
                               const Eigen::Affine3d& pose,
                               const Eigen::Vector3d velocity,
@@ -143,6 +176,7 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
 
   // preload map for next locate
   map_.PreloadMapArea(pose_trans, velocity, resolution_id_, zone_id_);
+  PrefetchMapAhead(pose_trans, velocity);
 
   // generate composed map for compare
   ComposeMapNode(pose_trans);
@@ -115,6 +115,11 @@ class LocalizationLidar {
 
   void RefineAltitudeFromMap(Eigen::Affine3d* pose);
 
+  // Queue the map nodes the car will reach within the prefetch horizon if it
+  // keeps moving by velocity per frame.
+  void PrefetchMapAhead(const Eigen::Vector3d& trans,
+                        const Eigen::Vector3d& velocity);
+
  protected:
   LidarLocator* lidar_locator_;
   int search_range_x_ = 0;
@@ -69,6 +69,7 @@ struct LocalizationIntegParam {
   double sins_state_span_time = 60.0;
   double sins_state_pos_std = 1.0;
   double vel_threshold_get_yaw = 5.0;
+  double measure_reorder_window = 0.0;
   bool is_trans_gpstime_to_utctime = true;
   bool is_using_raw_gnsspos = true;
 
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_map/base_map/base_map.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -62,6 +64,7 @@ BaseMapNode* BaseMap::GetMapNodeSafe(const MapNodeIndex& index) {
   BaseMapNode* node = nullptr;
   // try get from cacheL1
   if (map_node_cache_lvl1_->Get(index, &node)) {
+    ++load_stats_.hit_count;
     return node;
   }
 
@@ -71,6 +74,7 @@ BaseMapNode* BaseMap::GetMapNodeSafe(const MapNodeIndex& index) {
     node->SetIsReserved(true);
 
     map_node_cache_lvl1_->Put(index, node);
+    ++load_stats_.hit_count;
     return node;
   }
   lock.unlock();
@@ -78,10 +82,14 @@ BaseMapNode* BaseMap::GetMapNodeSafe(const MapNodeIndex& index) {
   // load from disk
   AERROR << "GetMapNodeSafe: This node don't exist in cache! ";
   AERROR << "load this node from disk now! index = " << index;
+  const auto start_time = std::chrono::steady_clock::now();
   LoadMapNodeThreadSafety(index, true);
   boost::unique_lock<boost::recursive_mutex> lock2(map_load_mutex_);
   map_node_cache_lvl2_->Get(index, &node);
   lock2.unlock();
+  RecordMapNodeMiss(1, std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - start_time)
+                           .count());
 
   map_node_cache_lvl1_->Put(index, node);
   return node;
@@ -113,6 +121,7 @@ void BaseMap::AddDataset(const std::string dataset_path) {
 
 void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   CHECK_LE(static_cast<int>(map_ids->size()), map_node_cache_lvl1_->Capacity());
+  const unsigned int request_num = static_cast<unsigned int>(map_ids->size());
   // check in cacheL1
   typename std::set<MapNodeIndex>::iterator itr = map_ids->begin();
   while (itr != map_ids->end()) {
@@ -142,8 +151,11 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
     }
   }
   lock.unlock();
+  load_stats_.hit_count +=
+      request_num - static_cast<unsigned int>(map_ids->size());
 
   // load from disk sync
+  const auto start_time = std::chrono::steady_clock::now();
   std::vector<std::future<void>> load_futures;
   itr = map_ids->begin();
   while (itr != map_ids->end()) {
@@ -158,6 +170,12 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
       future.get();
     }
   }
+  if (!map_ids->empty()) {
+    RecordMapNodeMiss(static_cast<unsigned int>(map_ids->size()),
+                      std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start_time)
+                          .count());
+  }
   // check in cacheL2 again
   itr = map_ids->begin();
   node = nullptr;
@@ -226,6 +244,71 @@ void BaseMap::PreloadMapNodes(std::set<MapNodeIndex>* map_ids) {
   return;
 }
 
+void BaseMap::PrefetchMapNodes(const std::vector<Eigen::Vector3d>& path_points,
+                               unsigned int resolution_id,
+                               unsigned int zone_id, int max_node_num) {
+  CHECK_NOTNULL(map_node_pool_);
+  // The nodes only start loading once they leave the queue, so a new path
+  // simply replaces what has not been started yet.
+  std::vector<MapNodeIndex> map_ids;
+  for (const auto& pt : path_points) {
+    MapNodeIndex map_id = MapNodeIndex::GetMapNodeIndex(
+        *(this->map_config_), pt, resolution_id, zone_id);
+    if (std::find(map_ids.begin(), map_ids.end(), map_id) == map_ids.end()) {
+      map_ids.push_back(map_id);
+    }
+  }
+
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  map_prefetch_queue_.clear();
+  for (const auto& map_id : map_ids) {
+    if (static_cast<int>(map_prefetch_queue_.size()) >= max_node_num) {
+      break;
+    }
+    if (!map_node_cache_lvl2_->IsExist(map_id) &&
+        map_preloading_task_index_.find(map_id) ==
+            map_preloading_task_index_.end()) {
+      map_prefetch_queue_.push_back(map_id);
+    }
+  }
+  DispatchPrefetchTasks();
+}
+
+void BaseMap::DispatchPrefetchTasks() {
+  while (map_prefetch_task_num_ < kMaxPrefetchTasks &&
+         !map_prefetch_queue_.empty()) {
+    MapNodeIndex map_id = map_prefetch_queue_.front();
+    map_prefetch_queue_.pop_front();
+    // PreloadMapArea may have requested it since it was queued
+    if (map_node_cache_lvl2_->IsExist(map_id) ||
+        map_preloading_task_index_.find(map_id) !=
+            map_preloading_task_index_.end()) {
+      continue;
+    }
+    AINFO << "Prefetch map node: " << map_id;
+    map_preloading_task_index_.insert(map_id);
+    ++map_prefetch_task_num_;
+    cyber::Async(&BaseMap::PrefetchMapNodeThreadSafety, this, map_id);
+  }
+}
+
+void BaseMap::PrefetchMapNodeThreadSafety(MapNodeIndex index) {
+  LoadMapNodeThreadSafety(index, false);
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  --map_prefetch_task_num_;
+  DispatchPrefetchTasks();
+}
+
+void BaseMap::RecordMapNodeMiss(unsigned int node_num, double stall_ms) {
+  load_stats_.miss_count += node_num;
+  load_stats_.total_stall_ms += stall_ms;
+  load_stats_.max_stall_ms = std::max(load_stats_.max_stall_ms, stall_ms);
+  AWARN << "Waited " << stall_ms << " ms for " << node_num
+        << " map nodes from disk, misses: " << load_stats_.miss_count
+        << ", hits: " << load_stats_.hit_count
+        << ", max wait: " << load_stats_.max_stall_ms << " ms";
+}
+
 void BaseMap::AttachMapNodePool(BaseMapNodePool* map_node_pool) {
   map_node_pool_ = map_node_pool;
 }
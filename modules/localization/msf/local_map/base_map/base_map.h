@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <deque>
 #include <list>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "modules/localization/msf/local_map/base_map/base_map_cache.h"
 #include "modules/localization/msf/local_map/base_map/base_map_config.h"
@@ -31,6 +33,16 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
+/**@brief The statistics of the map nodes requested by the location
+ * calculation. A miss means the node was in neither cache and the caller
+ * waited for it to be loaded from disk. */
+struct MapNodeLoadStats {
+  unsigned int hit_count = 0;
+  unsigned int miss_count = 0;
+  double total_stall_ms = 0.0;
+  double max_stall_ms = 0.0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -63,6 +75,16 @@ class BaseMap {
   virtual void PreloadMapArea(const Eigen::Vector3d& location,
                               const Eigen::Vector3d& trans_diff,
                               unsigned int resolution_id, unsigned int zone_id);
+  /**@brief Prefetch the map nodes along the path ahead of the car.
+   * The points are ordered by the time the car is expected to reach them.
+   * The nodes under them replace the pending prefetch queue, nearest first,
+   * and are loaded by at most kMaxPrefetchTasks tasks at a time, so they
+   * leave most of the task pool to the nodes requested by PreloadMapArea.
+   * @param <max_node_num> The maximum number of nodes to queue, the cached
+   * and loading ones excluded. */
+  void PrefetchMapNodes(const std::vector<Eigen::Vector3d>& path_points,
+                        unsigned int resolution_id, unsigned int zone_id,
+                        int max_node_num);
   /**@brief Load map nodes for the location calculate of this frame.
    * If the forecasts are correct in last frame, these nodes will be all in
    * cache, if not, then need to create loading tasks, and wait for the loading
@@ -92,6 +114,8 @@ class BaseMap {
   inline const BaseMapConfig& GetConfig() const { return *map_config_; }
   /**@brief Get the map config. */
   inline BaseMapConfig& GetConfig() { return *map_config_; }
+  /**@brief Get the statistics of the map nodes loaded so far. */
+  inline const MapNodeLoadStats& GetLoadStats() const { return load_stats_; }
 
  protected:
   /**@brief Load map node by index.*/
@@ -100,6 +124,16 @@ class BaseMap {
   void PreloadMapNodes(std::set<MapNodeIndex>* map_ids);
   /**@brief Load map node by index, thread_safety. */
   void LoadMapNodeThreadSafety(MapNodeIndex index, bool is_reserved = false);
+  /**@brief Load a prefetched map node and start the next queued one. */
+  void PrefetchMapNodeThreadSafety(MapNodeIndex index);
+  /**@brief Start prefetch tasks until the queue is empty or the limit is
+   * reached. The map_load_mutex_ must be held. */
+  void DispatchPrefetchTasks();
+  /**@brief Record a location calculation waiting for nodes from disk. */
+  void RecordMapNodeMiss(unsigned int node_num, double stall_ms);
+
+  /**@brief The maximum number of concurrent prefetch tasks. */
+  static constexpr int kMaxPrefetchTasks = 2;
 
   /**@brief The map settings. */
   BaseMapConfig* map_config_;
@@ -116,6 +150,12 @@ class BaseMap {
   std::set<MapNodeIndex> map_preloading_task_index_;
   /**@brief The mutex for preload map node. **/
   boost::recursive_mutex map_load_mutex_;
+  /**@brief The pending prefetch nodes, the nearest ahead first. */
+  std::deque<MapNodeIndex> map_prefetch_queue_;
+  /**@brief The number of running prefetch tasks. */
+  int map_prefetch_task_num_ = 0;
+  /**@brief The statistics of the map nodes requested by the caller. */
+  MapNodeLoadStats load_stats_;
 };
 
 }  // namespace msf
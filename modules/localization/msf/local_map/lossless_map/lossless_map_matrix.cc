@@ -32,6 +32,7 @@ void LosslessMapSingleCell::Reset() {
   intensity = 0.0;
   intensity_var = 0.0;
   altitude = 0.0;
+  altitude_var = 0.0;
   count = 0;
 }
 
@@ -23,7 +23,8 @@ namespace apollo {
 namespace localization {
 namespace msf {
 LosslessMapNode::LosslessMapNode()
-    : BaseMapNode(new LosslessMapMatrix(), new ZlibStrategy()) {}
+    : BaseMapNode(new LosslessMapMatrix(),
+                  new ChunkedZlibStrategy(sizeof(float))) {}
 
 LosslessMapNode::~LosslessMapNode() {}
 
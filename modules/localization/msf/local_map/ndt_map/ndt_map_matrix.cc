@@ -434,11 +434,12 @@ void NdtMapMatrix::GetIntensityImg(cv::Mat* intensity_img) const {
   for (unsigned int y = 0; y < rows_; ++y) {
     for (unsigned int x = 0; x < cols_; ++x) {
       unsigned int id = y * cols_ + x;
-      int min_altitude_index = map3d_cells_[id].min_altitude_index_;
+      // Look the cell up without inserting one into the empty cells, which
+      // would then be saved with the node.
+      const auto& cells = map3d_cells_[id].cells_;
+      const auto it = cells.find(map3d_cells_[id].min_altitude_index_);
       intensity_img->at<unsigned char>(y, x) =
-          (unsigned char)(map3d_cells_[id]
-                              .cells_[min_altitude_index]
-                              .intensity_);
+          it == cells.end() ? 0 : (unsigned char)(it->second.intensity_);
     }
   }
 }
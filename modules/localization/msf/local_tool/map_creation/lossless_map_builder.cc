@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_tool/map_creation/lossless_map_builder.h"
+
+#include "modules/localization/msf/common/io/velodyne_utility.h"
+#include "modules/localization/msf/common/util/extract_ground_plane.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+LosslessMapBuilder::LosslessMapBuilder(const LosslessMapConfig* map_config,
+                                       const int zone_id,
+                                       const bool use_plane_inliers_only,
+                                       const unsigned int load_thread_num,
+                                       const unsigned int shard_num,
+                                       const unsigned int shard_node_num)
+    : MapBuilder(map_config, zone_id, load_thread_num, shard_num,
+                 shard_node_num),
+      use_plane_inliers_only_(use_plane_inliers_only) {}
+
+void LosslessMapBuilder::GetFrameSamples(
+    const velodyne::VelodyneFrame& velodyne_frame,
+    std::map<MapNodeIndex, NodeSamples>* nodes) {
+  MapBuilder::GetFrameSamples(velodyne_frame, nodes);
+  if (!use_plane_inliers_only_) {
+    return;
+  }
+
+  FeatureXYPlane::PointCloudPtrT pcl_pc(new FeatureXYPlane::PointCloudT);
+  pcl_pc->resize(velodyne_frame.pt3ds.size());
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    FeatureXYPlane::PointT& pt = pcl_pc->at(i);
+    pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
+    pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
+    pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
+    pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
+  }
+  FeatureXYPlane plane_extractor;
+  plane_extractor.ExtractXYPlane(pcl_pc);
+  const FeatureXYPlane::PointCloudPtrT& plane_pc =
+      plane_extractor.GetXYPlaneCloud();
+  for (const auto& plane_pt : plane_pc->points) {
+    const Eigen::Vector3d pt3d_local(plane_pt.x, plane_pt.y, plane_pt.z);
+    AddSample({velodyne_frame.pose * pt3d_local,
+               static_cast<unsigned char>(plane_pt.intensity)},
+              true, nodes);
+  }
+}
+
+BaseMapNode* LosslessMapBuilder::CreateNode() const {
+  LosslessMapNode* node = new LosslessMapNode();
+  node->InitMapMatrix(map_config_);
+  return node;
+}
+
+void LosslessMapBuilder::AddNodeSamples(const NodeSamples& node_samples,
+                                        BaseMapNode* node) const {
+  LosslessMapNode* lossless_node = static_cast<LosslessMapNode*>(node);
+  for (const auto& sample : node_samples.samples) {
+    lossless_node->SetValue(sample.coordinate, sample.intensity);
+  }
+  for (const auto& sample : node_samples.layer_samples) {
+    lossless_node->SetValueLayer(sample.coordinate, sample.intensity);
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
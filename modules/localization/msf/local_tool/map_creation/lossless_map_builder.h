@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <map>
+
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
+#include "modules/localization/msf/local_tool/map_creation/map_builder.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**@brief Build the nodes of a lossless map from point cloud frames in
+ * parallel, see MapBuilder. The ground plane points of each frame are added
+ * to the layers of the cells too, if only plane inliers are used.
+ */
+class LosslessMapBuilder : public MapBuilder {
+ public:
+  /**@brief The constructor.
+   * @param <map_config> The config of the map, with its folder path set.
+   * @param <load_thread_num> The threads to load and transform frames.
+   * @param <shard_num> The threads to add points to the map nodes.
+   * @param <shard_node_num> The map nodes each shard keeps in memory.
+   */
+  LosslessMapBuilder(const LosslessMapConfig* map_config, int zone_id,
+                     bool use_plane_inliers_only, unsigned int load_thread_num,
+                     unsigned int shard_num, unsigned int shard_node_num);
+
+ protected:
+  void GetFrameSamples(const velodyne::VelodyneFrame& velodyne_frame,
+                       std::map<MapNodeIndex, NodeSamples>* nodes) override;
+
+  BaseMapNode* CreateNode() const override;
+
+  void AddNodeSamples(const NodeSamples& node_samples,
+                      BaseMapNode* node) const override;
+
+ private:
+  const bool use_plane_inliers_only_;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
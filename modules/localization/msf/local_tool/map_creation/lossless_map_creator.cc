@@ -14,26 +14,26 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <thread>
+
 #include "boost/filesystem.hpp"
 #include "boost/program_options.hpp"
 
 #include "modules/localization/msf/common/io/velodyne_utility.h"
-#include "modules/localization/msf/common/util/extract_ground_plane.h"
 #include "modules/localization/msf/common/util/system_utility.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_pool.h"
+#include "modules/localization/msf/local_tool/map_creation/lossless_map_builder.h"
 
 const unsigned int CAR_SENSOR_LASER_NUMBER = 64;
 
-using apollo::localization::msf::FeatureXYPlane;
 using apollo::localization::msf::LosslessMap;
+using apollo::localization::msf::LosslessMapBuilder;
 using apollo::localization::msf::LosslessMapConfig;
 using apollo::localization::msf::LosslessMapNodePool;
+using apollo::localization::msf::MapBuildFrame;
 using apollo::localization::msf::MapNodeIndex;
-typedef apollo::localization::msf::FeatureXYPlane::PointT PclPointT;
-typedef apollo::localization::msf::FeatureXYPlane::PointCloudT PclPointCloudT;
-typedef apollo::localization::msf::FeatureXYPlane::PointCloudPtrT
-    PclPointCloudPtrT;
 
 bool ParseCommandLine(int argc, char* argv[],
                       boost::program_options::variables_map* vm) {
@@ -70,7 +70,14 @@ bool ParseCommandLine(int argc, char* argv[],
           "resolution",
           boost::program_options::value<float>()->default_value(0.125),
           "optional: resolution for single resolution generation, default: "
-          "0.125");
+          "0.125")(
+          "thread_num",
+          boost::program_options::value<unsigned int>()->default_value(0),
+          "optional: threads to load frames and to build map nodes, default: "
+          "0 for the hardware threads")(
+          "node_cache_size",
+          boost::program_options::value<unsigned int>()->default_value(24),
+          "optional: map nodes kept in memory while building, default: 24");
   try {
     boost::program_options::store(
         boost::program_options::parse_command_line(argc, argv, desc), *vm);
@@ -100,8 +107,6 @@ void VarianceOnline(double* mean, double* var, unsigned int* N, double x) {
 }
 
 int main(int argc, char** argv) {
-  FeatureXYPlane plane_extractor;
-
   boost::program_options::variables_map boost_args;
   if (!ParseCommandLine(argc, argv, &boost_args)) {
     std::cerr << "Parse input command line failed." << std::endl;
@@ -250,64 +255,36 @@ int main(int argc, char** argv) {
               << "./lossless_map/config.txt" << std::endl;
   }
 
-  LosslessMapNodePool lossless_map_node_pool(25, 8);
-  lossless_map_node_pool.Initial(&loss_less_config);
-  map.InitMapNodeCaches(12, 24);
-  map.AttachMapNodePool(&lossless_map_node_pool);
-
+  std::vector<MapBuildFrame> frames;
   for (unsigned int trial = 0; trial < num_trials; ++trial) {
     for (unsigned int frame_idx = 0; frame_idx < ieout_poses[trial].size();
          ++frame_idx) {
-      unsigned int trial_frame_idx = frame_idx;
-      const std::vector<Eigen::Affine3d>& poses = ieout_poses[trial];
-      apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
-      std::string pcd_file_path;
+      MapBuildFrame frame;
       std::ostringstream ss;
       ss << pcd_indices[trial][frame_idx];
-      pcd_file_path = pcd_folder_pathes[trial] + "/" + ss.str() + ".pcd";
-      const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
-      AERROR << "Loaded " << velodyne_frame.pt3ds.size()
-             << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
-             << ".";
-
-      for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[i];
-        unsigned char intensity = velodyne_frame.intensities[i];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-        map.SetValue(pt3d_global, zone_id, intensity);
-      }
-
-      if (use_plane_inliers_only) {
-        PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
-        pcl_pc->resize(velodyne_frame.pt3ds.size());
-        for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-          PclPointT& pt = pcl_pc->at(i);
-          pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
-          pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
-          pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
-          pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
-        }
-
-        plane_extractor.ExtractXYPlane(pcl_pc);
-        PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
-
-        for (unsigned int k = 0; k < plane_pc->size(); ++k) {
-          const PclPointT& plane_pt = plane_pc->at(k);
-          Eigen::Vector3d pt3d_local_double;
-          pt3d_local_double[0] = plane_pt.x;
-          pt3d_local_double[1] = plane_pt.y;
-          pt3d_local_double[2] = plane_pt.z;
-          unsigned char intensity =
-              static_cast<unsigned char>(plane_pt.intensity);
-          Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
-          map.SetValueLayer(pt3d_global, zone_id, intensity);
-        }
-      }
+      frame.pcd_file_path = pcd_folder_pathes[trial] + "/" + ss.str() + ".pcd";
+      frame.frame_index = frame_idx;
+      frame.pose = ieout_poses[trial][frame_idx];
+      frames.push_back(frame);
     }
   }
 
+  unsigned int thread_num = boost_args["thread_num"].as<unsigned int>();
+  if (thread_num == 0) {
+    thread_num = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  const unsigned int node_cache_size =
+      boost_args["node_cache_size"].as<unsigned int>();
+  LosslessMapBuilder builder(&loss_less_config, zone_id,
+                             use_plane_inliers_only, thread_num, thread_num,
+                             std::max(node_cache_size / thread_num, 1u));
+  builder.Build(frames);
+
+  LosslessMapNodePool lossless_map_node_pool(25, 8);
+  lossless_map_node_pool.Initial(&loss_less_config);
+  map.InitMapNodeCaches(12, 24);
+  map.AttachMapNodePool(&lossless_map_node_pool);
+
   // Compute the ground height offset
   double mean_height_diff = 0;
   double var_height_diff = 0;
@@ -0,0 +1,336 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_tool/map_creation/map_builder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "modules/localization/msf/common/io/velodyne_utility.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+MapBuilder::MapBuilder(const BaseMapConfig* map_config, const int zone_id,
+                       const unsigned int load_thread_num,
+                       const unsigned int shard_num,
+                       const unsigned int shard_node_num)
+    : map_config_(map_config),
+      zone_id_(zone_id),
+      load_thread_num_(std::max(load_thread_num, 1u)),
+      shard_num_(std::max(shard_num, 1u)),
+      shard_node_num_(std::max(shard_node_num, 1u)),
+      max_pending_frame_num_(2 * std::max(load_thread_num, 1u)) {}
+
+void MapBuilder::SetRebuildArea(const Eigen::Vector2d& min_corner,
+                                const Eigen::Vector2d& max_corner,
+                                const double frame_range) {
+  is_rebuild_ = true;
+  rebuild_min_corner_ = min_corner;
+  rebuild_max_corner_ = max_corner;
+  rebuild_frame_range_ = frame_range;
+}
+
+void MapBuilder::Build(const std::vector<MapBuildFrame>& frames,
+                       const double progress_interval_s) {
+  const unsigned int frame_num = static_cast<unsigned int>(frames.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame_samples_.clear();
+    frame_samples_.resize(frame_num);
+    next_load_frame_ = 0;
+    pending_frame_num_ = 0;
+    done_shard_num_ = 0;
+    stats_ = MapBuildStats();
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < load_thread_num_; ++i) {
+    threads.emplace_back(&MapBuilder::LoadFrames, this, std::cref(frames));
+  }
+  for (unsigned int i = 0; i < shard_num_; ++i) {
+    threads.emplace_back(&MapBuilder::AccumulateShard, this, i, frame_num);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!frame_done_cv_.wait_for(
+      lock, std::chrono::duration<double>(progress_interval_s),
+      [this] { return done_shard_num_ == shard_num_; })) {
+    lock.unlock();
+    ReportProgress(frame_num, std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start_time)
+                                  .count());
+    lock.lock();
+  }
+  lock.unlock();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ReportProgress(frame_num, std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start_time)
+                                .count());
+}
+
+MapBuildStats MapBuilder::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void MapBuilder::GetFrameSamples(const velodyne::VelodyneFrame& velodyne_frame,
+                                 std::map<MapNodeIndex, NodeSamples>* nodes) {
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    AddSample({velodyne_frame.pose * velodyne_frame.pt3ds[i],
+               velodyne_frame.intensities[i]},
+              false, nodes);
+  }
+}
+
+void MapBuilder::AddSample(const Sample& sample, const bool is_layer_sample,
+                           std::map<MapNodeIndex, NodeSamples>* nodes) const {
+  const unsigned int resolution_num =
+      static_cast<unsigned int>(map_config_->map_resolutions_.size());
+  for (unsigned int r = 0; r < resolution_num; ++r) {
+    const MapNodeIndex index = MapNodeIndex::GetMapNodeIndex(
+        *map_config_, sample.coordinate, r, zone_id_);
+    NodeSamples& node = (*nodes)[index];
+    node.index = index;
+    if (is_layer_sample) {
+      node.layer_samples.push_back(sample);
+    } else {
+      node.samples.push_back(sample);
+    }
+  }
+}
+
+void MapBuilder::LoadFrames(const std::vector<MapBuildFrame>& frames) {
+  while (true) {
+    unsigned int frame_id = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // Bound the memory of the frames loaded ahead of the slowest shard.
+      frame_done_cv_.wait(lock, [this, &frames] {
+        return pending_frame_num_ < max_pending_frame_num_ ||
+               next_load_frame_ >= frames.size();
+      });
+      if (next_load_frame_ >= frames.size()) {
+        return;
+      }
+      frame_id = next_load_frame_++;
+      ++pending_frame_num_;
+    }
+    std::unique_ptr<FrameSamples> frame_samples = LoadFrame(frames[frame_id]);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      frame_samples_[frame_id] = std::move(frame_samples);
+    }
+    frame_loaded_cv_.notify_all();
+  }
+}
+
+std::unique_ptr<MapBuilder::FrameSamples> MapBuilder::LoadFrame(
+    const MapBuildFrame& frame) {
+  std::unique_ptr<FrameSamples> frame_samples(new FrameSamples);
+  frame_samples->shards.resize(shard_num_);
+  frame_samples->pending_shard_num = shard_num_;
+  if (!IsFrameInRebuildArea(frame)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.skipped_frame_num;
+    return frame_samples;
+  }
+
+  velodyne::VelodyneFrame velodyne_frame;
+  velodyne::LoadPcds(frame.pcd_file_path, frame.frame_index, frame.pose,
+                     &velodyne_frame, false);
+  AINFO << "Loaded " << velodyne_frame.pt3ds.size()
+        << " 3D Points at Frame: " << frame.frame_index << ".";
+
+  std::map<MapNodeIndex, NodeSamples> nodes;
+  GetFrameSamples(velodyne_frame, &nodes);
+  for (auto& node : nodes) {
+    if (IsNodeInRebuildArea(node.first)) {
+      frame_samples->shards[GetShardId(node.first)].push_back(
+          std::move(node.second));
+    }
+  }
+  return frame_samples;
+}
+
+void MapBuilder::AccumulateShard(const unsigned int shard_id,
+                                 const unsigned int frame_num) {
+  Shard shard;
+  for (unsigned int frame_id = 0; frame_id < frame_num; ++frame_id) {
+    std::vector<NodeSamples> nodes;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      frame_loaded_cv_.wait(lock, [this, frame_id] {
+        return frame_samples_[frame_id] != nullptr;
+      });
+      nodes = std::move(frame_samples_[frame_id]->shards[shard_id]);
+    }
+
+    uint64_t point_num = 0;
+    for (const auto& node_samples : nodes) {
+      AddNodeSamples(node_samples, GetNode(&shard, node_samples.index));
+      point_num += node_samples.samples.size();
+    }
+
+    bool is_frame_done = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.point_num += point_num;
+      if (--frame_samples_[frame_id]->pending_shard_num == 0) {
+        frame_samples_[frame_id].reset();
+        --pending_frame_num_;
+        ++stats_.frame_num;
+        is_frame_done = true;
+      }
+    }
+    if (is_frame_done) {
+      frame_done_cv_.notify_all();
+    }
+  }
+
+  for (BaseMapNode* node : shard.lru_nodes) {
+    SaveNode(node);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++done_shard_num_;
+  }
+  frame_done_cv_.notify_all();
+}
+
+BaseMapNode* MapBuilder::GetNode(Shard* shard, const MapNodeIndex& index) {
+  auto itr = shard->node_map.find(index);
+  if (itr != shard->node_map.end()) {
+    shard->lru_nodes.splice(shard->lru_nodes.begin(), shard->lru_nodes,
+                            itr->second);
+    return *itr->second;
+  }
+
+  BaseMapNode* node = nullptr;
+  if (shard->nodes.size() < shard_node_num_) {
+    shard->nodes.emplace_back(CreateNode());
+    node = shard->nodes.back().get();
+  } else {
+    // Drop the least recently used node, it is loaded again from disk if a
+    // later frame reaches it.
+    node = shard->lru_nodes.back();
+    shard->lru_nodes.pop_back();
+    shard->node_map.erase(node->GetMapNodeIndex());
+    if (node->GetIsChanged()) {
+      shard->dropped_nodes.insert(node->GetMapNodeIndex());
+    }
+    SaveNode(node);
+    node->ResetMapNode();
+  }
+  node->Init(map_config_, index, false);
+  // A rebuilt node starts from scratch, until this build saved it.
+  bool is_loaded = false;
+  if (!is_rebuild_ || shard->dropped_nodes.count(index) != 0) {
+    is_loaded = node->Load();
+  }
+  AINFO << (is_loaded ? "Loaded" : "Created") << " map node: " << index;
+  shard->lru_nodes.push_front(node);
+  shard->node_map[index] = shard->lru_nodes.begin();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.node_load_num;
+  return node;
+}
+
+void MapBuilder::SaveNode(BaseMapNode* node) {
+  if (!node->GetIsChanged()) {
+    return;
+  }
+  if (!node->Save()) {
+    AERROR << "Failed to save map node: " << node->GetMapNodeIndex();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.node_save_num;
+}
+
+unsigned int MapBuilder::GetShardId(const MapNodeIndex& index) const {
+  // Spread the neighboring nodes of a frame over the shards.
+  const uint64_t hash = index.m_ * 73856093ULL ^ index.n_ * 19349663ULL ^
+                        index.resolution_id_ * 83492791ULL;
+  return static_cast<unsigned int>(hash % shard_num_);
+}
+
+bool MapBuilder::IsFrameInRebuildArea(const MapBuildFrame& frame) const {
+  if (!is_rebuild_ || rebuild_frame_range_ <= 0.0) {
+    return true;
+  }
+  // The nodes overlapping the area reach out of it by up to a node.
+  const double node_size = static_cast<double>(
+      std::max(map_config_->map_node_size_x_, map_config_->map_node_size_y_));
+  double range = rebuild_frame_range_;
+  for (const float resolution : map_config_->map_resolutions_) {
+    range = std::max(range, rebuild_frame_range_ + node_size * resolution);
+  }
+  const Eigen::Vector3d& position = frame.pose.translation();
+  return position[0] >= rebuild_min_corner_[0] - range &&
+         position[0] <= rebuild_max_corner_[0] + range &&
+         position[1] >= rebuild_min_corner_[1] - range &&
+         position[1] <= rebuild_max_corner_[1] + range;
+}
+
+bool MapBuilder::IsNodeInRebuildArea(const MapNodeIndex& index) const {
+  if (!is_rebuild_) {
+    return true;
+  }
+  const Eigen::Vector2d left_top_corner =
+      BaseMapNode::GetLeftTopCorner(*map_config_, index);
+  const double resolution = map_config_->map_resolutions_[index.resolution_id_];
+  const double node_size_x =
+      static_cast<double>(map_config_->map_node_size_x_) * resolution;
+  const double node_size_y =
+      static_cast<double>(map_config_->map_node_size_y_) * resolution;
+  return left_top_corner[0] <= rebuild_max_corner_[0] &&
+         left_top_corner[0] + node_size_x >= rebuild_min_corner_[0] &&
+         left_top_corner[1] <= rebuild_max_corner_[1] &&
+         left_top_corner[1] + node_size_y >= rebuild_min_corner_[1];
+}
+
+void MapBuilder::ReportProgress(const unsigned int total_frame_num,
+                                const double elapsed_s) const {
+  const MapBuildStats stats = GetStats();
+  const double frame_rate =
+      elapsed_s > 0.0 ? static_cast<double>(stats.frame_num) / elapsed_s : 0.0;
+  std::cerr << "Built " << stats.frame_num << "/" << total_frame_num
+            << " frames, " << stats.skipped_frame_num << " skipped, "
+            << stats.point_num << " points, " << stats.node_load_num
+            << " nodes loaded, " << stats.node_save_num << " nodes saved, "
+            << frame_rate << " frames/s";
+  if (frame_rate > 0.0 && stats.frame_num < total_frame_num) {
+    std::cerr << ", "
+              << static_cast<double>(total_frame_num - stats.frame_num) /
+                     frame_rate
+              << "s left";
+  }
+  std::cerr << "." << std::endl;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
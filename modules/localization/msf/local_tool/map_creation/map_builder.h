@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Eigen/Geometry"
+
+#include "modules/localization/msf/local_map/base_map/base_map_config.h"
+#include "modules/localization/msf/local_map/base_map/base_map_node.h"
+#include "modules/localization/msf/local_map/base_map/base_map_node_index.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+namespace velodyne {
+struct VelodyneFrame;
+}  // namespace velodyne
+
+/**@brief A point cloud frame to build the map from. */
+struct MapBuildFrame {
+  /**@brief The path of the PCD file. */
+  std::string pcd_file_path;
+  /**@brief The frame index. */
+  unsigned int frame_index = 0;
+  /**@brief The pose of the frame. */
+  Eigen::Affine3d pose;
+};
+
+/**@brief The progress of building a map. */
+struct MapBuildStats {
+  /**@brief The frames whose points are all added to the map nodes. */
+  unsigned int frame_num = 0;
+  /**@brief The frames skipped as too far from the rebuild area. */
+  unsigned int skipped_frame_num = 0;
+  /**@brief The points added to the map nodes. */
+  uint64_t point_num = 0;
+  /**@brief The map nodes loaded from disk or created. */
+  unsigned int node_load_num = 0;
+  /**@brief The map nodes saved to disk. */
+  unsigned int node_save_num = 0;
+};
+
+/**@brief Build the nodes of a map from point cloud frames in parallel. The
+ * frames are loaded and transformed by the load threads. Their points are
+ * added to the map nodes by the shard threads, each of which owns the nodes
+ * of its shard, so no cell is written by two threads. The points of a node
+ * are added in the frame order, and the map is the same as the one built
+ * frame by frame. A shard keeps its least recently used nodes in memory,
+ * saves the one it drops to disk and loads it again if a later frame reaches
+ * it. The map type is given by the node creation and the sample accumulation
+ * of the derived class.
+ */
+class MapBuilder {
+ public:
+  /**@brief The constructor.
+   * @param <map_config> The config of the map, with its folder path set.
+   * @param <load_thread_num> The threads to load and transform frames.
+   * @param <shard_num> The threads to add points to the map nodes.
+   * @param <shard_node_num> The map nodes each shard keeps in memory.
+   */
+  MapBuilder(const BaseMapConfig* map_config, int zone_id,
+             unsigned int load_thread_num, unsigned int shard_num,
+             unsigned int shard_node_num);
+
+  virtual ~MapBuilder() = default;
+
+  /**@brief Only rebuild the map nodes overlapping the area, from scratch.
+   * The other nodes on disk, and the ones in the area no frame reaches, are
+   * left as they are. The frames whose pose is farther than frame_range from
+   * these nodes are not loaded, a frame_range not above 0 loads all of them.
+   * @param <min_corner> The corner of the area with the smallest coordinates.
+   * @param <max_corner> The corner of the area with the largest coordinates.
+   * @param <frame_range> The farthest a point of a frame is from its pose.
+   */
+  void SetRebuildArea(const Eigen::Vector2d& min_corner,
+                      const Eigen::Vector2d& max_corner, double frame_range);
+
+  /**@brief Add the points of the frames to the map nodes and save all the
+   * nodes to disk. The progress is reported every progress_interval_s. */
+  void Build(const std::vector<MapBuildFrame>& frames,
+             double progress_interval_s = 10.0);
+
+  /**@brief Get the progress of the current or last build. */
+  MapBuildStats GetStats() const;
+
+ protected:
+  struct Sample {
+    Eigen::Vector3d coordinate;
+    unsigned char intensity;
+  };
+
+  /**@brief The samples of a frame in a map node. */
+  struct NodeSamples {
+    MapNodeIndex index;
+    std::vector<Sample> samples;
+    /**@brief The samples of the ground plane, for the maps keeping them. */
+    std::vector<Sample> layer_samples;
+  };
+
+  /**@brief Group the points of a loaded frame by their map nodes, in the
+   * global frame. Called by the load threads. */
+  virtual void GetFrameSamples(const velodyne::VelodyneFrame& velodyne_frame,
+                               std::map<MapNodeIndex, NodeSamples>* nodes);
+
+  /**@brief Create a map node with its map matrix. */
+  virtual BaseMapNode* CreateNode() const = 0;
+
+  /**@brief Add the samples of a frame to their map node. Called by the shard
+   * thread owning the node. */
+  virtual void AddNodeSamples(const NodeSamples& node_samples,
+                              BaseMapNode* node) const = 0;
+
+  /**@brief Add a sample to the nodes of every resolution. */
+  void AddSample(const Sample& sample, bool is_layer_sample,
+                 std::map<MapNodeIndex, NodeSamples>* nodes) const;
+
+  const BaseMapConfig* map_config_;
+  const int zone_id_;
+
+ private:
+  /**@brief The samples of a frame, grouped by the shards of their nodes. */
+  struct FrameSamples {
+    std::vector<std::vector<NodeSamples>> shards;
+    unsigned int pending_shard_num = 0;
+  };
+
+  /**@brief The map nodes owned by a shard thread. */
+  struct Shard {
+    std::vector<std::unique_ptr<BaseMapNode>> nodes;
+    /**@brief The nodes in memory, the most recently used first. */
+    std::list<BaseMapNode*> lru_nodes;
+    std::map<MapNodeIndex, std::list<BaseMapNode*>::iterator> node_map;
+    /**@brief The nodes dropped from memory after they were changed. */
+    std::set<MapNodeIndex> dropped_nodes;
+  };
+
+  void LoadFrames(const std::vector<MapBuildFrame>& frames);
+  std::unique_ptr<FrameSamples> LoadFrame(const MapBuildFrame& frame);
+  void AccumulateShard(unsigned int shard_id, unsigned int frame_num);
+  BaseMapNode* GetNode(Shard* shard, const MapNodeIndex& index);
+  void SaveNode(BaseMapNode* node);
+  unsigned int GetShardId(const MapNodeIndex& index) const;
+  bool IsFrameInRebuildArea(const MapBuildFrame& frame) const;
+  bool IsNodeInRebuildArea(const MapNodeIndex& index) const;
+  void ReportProgress(unsigned int total_frame_num, double elapsed_s) const;
+
+  const unsigned int load_thread_num_;
+  const unsigned int shard_num_;
+  const unsigned int shard_node_num_;
+  /**@brief The frames that may be loaded before they are all accumulated. */
+  const unsigned int max_pending_frame_num_;
+
+  bool is_rebuild_ = false;
+  Eigen::Vector2d rebuild_min_corner_;
+  Eigen::Vector2d rebuild_max_corner_;
+  double rebuild_frame_range_ = 0.0;
+
+  mutable std::mutex mutex_;
+  std::condition_variable frame_loaded_cv_;
+  std::condition_variable frame_done_cv_;
+  /**@brief The loaded frames not yet accumulated by every shard. */
+  std::vector<std::unique_ptr<FrameSamples>> frame_samples_;
+  unsigned int next_load_frame_ = 0;
+  unsigned int pending_frame_num_ = 0;
+  unsigned int done_shard_num_ = 0;
+  MapBuildStats stats_;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -52,6 +52,8 @@ void MSFLocalization::InitParams() {
   localization_param_.is_sins_state_check = FLAGS_integ_sins_state_check;
   localization_param_.sins_state_span_time = FLAGS_integ_sins_state_span_time;
   localization_param_.sins_state_pos_std = FLAGS_integ_sins_state_pos_std;
+  localization_param_.measure_reorder_window =
+      FLAGS_integ_measure_reorder_window;
   localization_param_.vel_threshold_get_yaw = FLAGS_vel_threshold_get_yaw;
   localization_param_.is_trans_gpstime_to_utctime =
       FLAGS_trans_gpstime_to_utctime;
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/ndt/map_creation/ndt_map_builder.h"
+
+#include "modules/localization/msf/local_map/ndt_map/ndt_map_matrix.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+NdtMapBuilder::NdtMapBuilder(const NdtMapConfig* map_config, const int zone_id,
+                             const unsigned int load_thread_num,
+                             const unsigned int shard_num,
+                             const unsigned int shard_node_num)
+    : MapBuilder(map_config, zone_id, load_thread_num, shard_num,
+                 shard_node_num) {}
+
+BaseMapNode* NdtMapBuilder::CreateNode() const {
+  NdtMapNode* node = new NdtMapNode();
+  node->InitMapMatrix(map_config_);
+  return node;
+}
+
+void NdtMapBuilder::AddNodeSamples(const NodeSamples& node_samples,
+                                   BaseMapNode* node) const {
+  NdtMapNode* ndt_map_node = static_cast<NdtMapNode*>(node);
+  NdtMapMatrix& ndt_map_matrix =
+      static_cast<NdtMapMatrix&>(ndt_map_node->GetMapCellMatrix());
+  const Eigen::Vector2d& left_top_corner = ndt_map_node->GetLeftTopCorner();
+  const float resolution = ndt_map_node->GetMapResolution();
+  const float resolution_z = ndt_map_node->GetMapResolutionZ();
+  for (const auto& sample : node_samples.samples) {
+    const Eigen::Vector3d& pt3d_global = sample.coordinate;
+    const Eigen::Vector2d coord2d(pt3d_global[0], pt3d_global[1]);
+    unsigned int x = 0;
+    unsigned int y = 0;
+    ndt_map_node->GetCoordinate(coord2d, &x, &y);
+
+    // get the centroid
+    Eigen::Vector3f centroid;
+    centroid[0] = static_cast<float>(coord2d[0]) -
+                  static_cast<float>(left_top_corner[0]) -
+                  resolution * static_cast<float>(x);
+    centroid[1] = static_cast<float>(coord2d[1]) -
+                  static_cast<float>(left_top_corner[1]) -
+                  resolution * static_cast<float>(y);
+    NdtMapCells& ndt_map_cell = ndt_map_matrix.GetMapCell(y, x);
+    const int altitude_index = ndt_map_cell.CalAltitudeIndex(
+        resolution_z, static_cast<float>(pt3d_global[2]));
+    centroid[2] = static_cast<float>(pt3d_global[2]) -
+                  static_cast<float>(altitude_index) * resolution_z;
+
+    ndt_map_cell.AddSample(sample.intensity, static_cast<float>(pt3d_global[2]),
+                           resolution_z, centroid, false);
+  }
+  ndt_map_node->SetIsChanged(true);
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include "modules/localization/msf/local_map/ndt_map/ndt_map_config.h"
+#include "modules/localization/msf/local_map/ndt_map/ndt_map_node.h"
+#include "modules/localization/msf/local_tool/map_creation/map_builder.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**@brief Build the nodes of a NDT map from point cloud frames in parallel,
+ * see MapBuilder. Each point is added to the voxel of its cell at its
+ * altitude.
+ */
+class NdtMapBuilder : public MapBuilder {
+ public:
+  /**@brief The constructor.
+   * @param <map_config> The config of the map, with its folder path set.
+   * @param <load_thread_num> The threads to load and transform frames.
+   * @param <shard_num> The threads to add points to the map nodes.
+   * @param <shard_node_num> The map nodes each shard keeps in memory.
+   */
+  NdtMapBuilder(const NdtMapConfig* map_config, int zone_id,
+                unsigned int load_thread_num, unsigned int shard_num,
+                unsigned int shard_node_num);
+
+ protected:
+  BaseMapNode* CreateNode() const override;
+
+  void AddNodeSamples(const NodeSamples& node_samples,
+                      BaseMapNode* node) const override;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
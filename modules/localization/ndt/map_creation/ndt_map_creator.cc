@@ -17,13 +17,14 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <boost/random.hpp>
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 #include "modules/localization/msf/common/io/velodyne_utility.h"
-#include "modules/localization/msf/common/util/extract_ground_plane.h"
 #include "modules/localization/msf/common/util/system_utility.h"
 #include "modules/localization/msf/local_map/ndt_map/ndt_map.h"
-#include "modules/localization/msf/local_map/ndt_map/ndt_map_pool.h"
+#include "modules/localization/ndt/map_creation/ndt_map_builder.h"
 
 int main(int argc, char** argv) {
   boost::program_options::options_description boost_desc("Allowed options");
@@ -47,7 +48,19 @@ int main(int argc, char** argv) {
       "whether enable setting road cells, default true")(
       "pool_size",
       boost::program_options::value<unsigned int>()->default_value(20),
-      "set pool size");
+      "set pool size")(
+      "thread_num",
+      boost::program_options::value<unsigned int>()->default_value(0),
+      "threads to load frames and to build map nodes, default 0 for the "
+      "hardware threads")(
+      "rebuild_area",
+      boost::program_options::value<std::vector<double>>()->multitoken(),
+      "only rebuild the map nodes in the area min_x min_y max_x max_y, "
+      "the other nodes of the map folder are kept")(
+      "rebuild_frame_range",
+      boost::program_options::value<double>()->default_value(150.0),
+      "the frames farther than this from the rebuild area are skipped, "
+      "0 to load all frames");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -140,92 +153,46 @@ int main(int argc, char** argv) {
            map_base_folder.c_str());
   ndt_map_config.Save(file_buf);
 
-  // Initialize map and pool
-  apollo::localization::msf::NdtMap ndt_map(&ndt_map_config);
-  unsigned int thread_size = 4;
-  apollo::localization::msf::NdtMapNodePool ndt_map_node_pool(pool_size,
-                                                              thread_size);
-  ndt_map_node_pool.Initial(&ndt_map_config);
-  ndt_map.InitMapNodeCaches(pool_size / 2, pool_size);
-  ndt_map.AttachMapNodePool(&ndt_map_node_pool);
-  ndt_map.SetMapFolderPath(map_base_folder);
-
-  // Plane extractor
-  apollo::localization::msf::FeatureXYPlane plane_extractor;
-
+  std::vector<apollo::localization::msf::MapBuildFrame> frames;
   for (unsigned int i = 0; i < pcd_folder_pathes.size(); ++i) {
     const std::vector<Eigen::Affine3d>& pcd_poses_i = pcd_poses[i];
     for (unsigned int frame_idx = 0; frame_idx < pcd_poses_i.size();
          ++frame_idx) {
-      apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
-      std::string pcd_file_path;
+      apollo::localization::msf::MapBuildFrame frame;
       std::ostringstream ss;
       ss << pcd_indices[i][frame_idx];
-      pcd_file_path = pcd_folder_pathes[i] + "/" + ss.str() + ".pcd";
-      Eigen::Affine3d pcd_pose = pcd_poses_i[frame_idx];
-      // Load pcd
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, pcd_indices[i][frame_idx], pcd_pose, &velodyne_frame,
-          false);
-
-      std::cout << "Loaded " << velodyne_frame.pt3ds.size()
-                << "3D Points at Trial: " << i
-                << " Frame: " << pcd_indices[i][frame_idx] << "." << std::endl;
-
-      // Process the point cloud
-      for (size_t k = 0; k < velodyne_frame.pt3ds.size(); ++k) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[k];
-        unsigned char intensity = velodyne_frame.intensities[k];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-
-        for (size_t res = 0; res < ndt_map_config.map_resolutions_.size();
-             ++res) {
-          apollo::localization::msf::MapNodeIndex index =
-              apollo::localization::msf::MapNodeIndex::GetMapNodeIndex(
-                  ndt_map_config, pt3d_global, static_cast<unsigned int>(res),
-                  zone_id);
-
-          apollo::localization::msf::NdtMapNode* ndt_map_node =
-              static_cast<apollo::localization::msf::NdtMapNode*>(
-                  ndt_map.GetMapNodeSafe(index));
-          apollo::localization::msf::NdtMapMatrix& ndt_map_matrix =
-              static_cast<apollo::localization::msf::NdtMapMatrix&>(
-                  ndt_map_node->GetMapCellMatrix());
-
-          Eigen::Vector2d coord2d;
-          coord2d[0] = pt3d_global[0];
-          coord2d[1] = pt3d_global[1];
-          unsigned int x = 0;
-          unsigned int y = 0;
-          ndt_map_node->GetCoordinate(coord2d, &x, &y);
-
-          // get the centroid
-          Eigen::Vector2d left_top_corner = ndt_map_node->GetLeftTopCorner();
-          float resolution = ndt_map_node->GetMapResolution();
-          Eigen::Vector3f centroid;
-          centroid[0] = static_cast<float>(coord2d[0]) -
-                        static_cast<float>(left_top_corner[0]) -
-                        resolution * static_cast<float>(x);
-          centroid[1] = static_cast<float>(coord2d[1]) -
-                        static_cast<float>(left_top_corner[1]) -
-                        resolution * static_cast<float>(y);
-          apollo::localization::msf::NdtMapCells& ndt_map_cell =
-              ndt_map_matrix.GetMapCell(y, x);
-          int altitude_index = ndt_map_cell.CalAltitudeIndex(
-              ndt_map_config.map_resolutions_z_[res],
-              static_cast<float>(pt3d_global[2]));
-          centroid[2] = static_cast<float>(pt3d_global[2]) -
-                        static_cast<float>(altitude_index) *
-                            ndt_map_config.map_resolutions_z_[res];
+      frame.pcd_file_path = pcd_folder_pathes[i] + "/" + ss.str() + ".pcd";
+      frame.frame_index = pcd_indices[i][frame_idx];
+      frame.pose = pcd_poses_i[frame_idx];
+      frames.push_back(frame);
+    }
+  }
 
-          ndt_map_cell.AddSample(intensity, static_cast<float>(pt3d_global[2]),
-                                 ndt_map_config.map_resolutions_z_[res],
-                                 centroid, false);
-          ndt_map_node->SetIsChanged(true);
-        }
-      }
+  // Load the config back as the map does, and build the map nodes in
+  // parallel into the map folder
+  apollo::localization::msf::NdtMap ndt_map(&ndt_map_config);
+  ndt_map.SetMapFolderPath(map_base_folder);
+  unsigned int thread_num = boost_args["thread_num"].as<unsigned int>();
+  if (thread_num == 0) {
+    thread_num = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  apollo::localization::msf::NdtMapBuilder ndt_map_builder(
+      &ndt_map_config, zone_id, thread_num, thread_num,
+      std::max(pool_size / thread_num, 1u));
+  if (boost_args.count("rebuild_area")) {
+    const std::vector<double> rebuild_area =
+        boost_args["rebuild_area"].as<std::vector<double>>();
+    if (rebuild_area.size() != 4) {
+      std::cerr << "rebuild area should be: min_x min_y max_x max_y"
+                << std::endl;
+      return -1;
     }
+    ndt_map_builder.SetRebuildArea(
+        Eigen::Vector2d(rebuild_area[0], rebuild_area[1]),
+        Eigen::Vector2d(rebuild_area[2], rebuild_area[3]),
+        boost_args["rebuild_frame_range"].as<double>());
   }
+  ndt_map_builder.Build(frames);
 
   return 0;
 }
@@ -23,6 +23,7 @@
 #include "cyber/common/log.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/drivers/gnss/proto/gnss_best_pose.pb.h"
 #include "modules/localization/common/localization_gflags.h"
 
@@ -86,8 +87,7 @@ void NDTLocalization::Init() {
   lidar_locator_.SetOnlineCloudResolution(
       static_cast<float>(online_resolution_));
 
-  odometry_buffer_.clear();
-  odometry_buffer_size_ = 0;
+  odometry_buffer_.Clear();
 
   is_service_started_ = false;
 }
@@ -126,18 +126,9 @@ void NDTLocalization::OdometryCallback(
     return;
   }
 
-  TimeStampPose timestamp_pose;
-  timestamp_pose.timestamp = odometry_time;
-  timestamp_pose.pose = odometry_pose;
-  {
-    std::lock_guard<std::mutex> lock(odometry_buffer_mutex_);
-    if (odometry_buffer_size_ < max_odometry_buffer_size_) {
-      odometry_buffer_.push_back(timestamp_pose);
-      odometry_buffer_size_++;
-    } else {
-      odometry_buffer_.pop_front();
-      odometry_buffer_.push_back(timestamp_pose);
-    }
+  if (!odometry_buffer_.Push(odometry_time, OdometryPose(odometry_pose))) {
+    AWARN << "odometry time " << std::setprecision(15) << odometry_time
+          << " is not newer than the buffered odometry, skip buffering it";
   }
 
   if (ndt_debug_log_flag_) {
@@ -405,30 +396,22 @@ void NDTLocalization::ComposeLocalizationStatus(
 bool NDTLocalization::QueryPoseFromBuffer(double time, Eigen::Affine3d* pose) {
   CHECK_NOTNULL(pose);
 
-  TimeStampPose pre_pose;
-  TimeStampPose next_pose;
-  {
-    std::lock_guard<std::mutex> lock(odometry_buffer_mutex_);
-    TimeStampPose timestamp_pose = odometry_buffer_.back();
-    // check abnormal timestamp
-    if (time > timestamp_pose.timestamp) {
-      AERROR << "query time is newer than latest odometry time, it doesn't "
-                "make sense!";
-      return false;
-    }
-    // search from reverse direction
-    auto iter = odometry_buffer_.crbegin();
-    for (; iter != odometry_buffer_.crend(); ++iter) {
-      if (iter->timestamp < time) {
-        break;
-      }
-    }
-    if (iter == odometry_buffer_.crend()) {
-      AINFO << "Cannot find matching pose from odometry buffer";
-      return false;
-    }
-    pre_pose = *iter;
-    next_pose = *(--iter);
+  OdometryPoseBuffer::Entry latest_pose;
+  if (!odometry_buffer_.GetLatest(&latest_pose)) {
+    AINFO << "Cannot find matching pose from empty odometry buffer";
+    return false;
+  }
+  // check abnormal timestamp
+  if (time > latest_pose.timestamp) {
+    AERROR << "query time is newer than latest odometry time, it doesn't "
+              "make sense!";
+    return false;
+  }
+  OdometryPoseBuffer::Entry pre_pose;
+  OdometryPoseBuffer::Entry next_pose;
+  if (!odometry_buffer_.GetBracket(time, &pre_pose, &next_pose)) {
+    AINFO << "Cannot find matching pose from odometry buffer";
+    return false;
   }
   // interpolation
   double v1 =
@@ -436,14 +419,14 @@ bool NDTLocalization::QueryPoseFromBuffer(double time, Eigen::Affine3d* pose) {
   double v2 =
       (time - pre_pose.timestamp) / (next_pose.timestamp - pre_pose.timestamp);
   pose->translation() =
-      pre_pose.pose.translation() * v1 + next_pose.pose.translation() * v2;
+      pre_pose.value.translation() * v1 + next_pose.value.translation() * v2;
 
-  Eigen::Quaterniond pre_quat(pre_pose.pose.linear());
+  Eigen::Quaterniond pre_quat(pre_pose.value.linear());
 
   common::math::EulerAnglesZXYd pre_euler(pre_quat.w(), pre_quat.x(),
                                           pre_quat.y(), pre_quat.z());
 
-  Eigen::Quaterniond next_quat(next_pose.pose.linear());
+  Eigen::Quaterniond next_quat(next_pose.value.linear());
   common::math::EulerAnglesZXYd next_euler(next_quat.w(), next_quat.x(),
                                            next_quat.y(), next_quat.z());
 
@@ -476,18 +459,20 @@ void NDTLocalization::LidarMsgTransfer(
   if (msg->height() > 1 && msg->width() > 1) {
     for (unsigned int i = 0; i < msg->height(); ++i) {
       for (unsigned int j = 0; j < msg->width(); ++j) {
+        const drivers::PackedPoint point =
+            drivers::GetPoint(*msg, i * msg->width() + j);
         Eigen::Vector3f pt3d;
-        pt3d[0] = msg->point(i * msg->width() + j).x();
-        pt3d[1] = msg->point(i * msg->width() + j).y();
-        pt3d[2] = msg->point(i * msg->width() + j).z();
+        pt3d[0] = point.x;
+        pt3d[1] = point.y;
+        pt3d[2] = point.z;
         if (!std::isnan(pt3d[0])) {
           Eigen::Vector3f pt3d_tem = pt3d;
 
           if (pt3d_tem[2] > max_height_) {
             continue;
           }
-          unsigned char intensity = static_cast<unsigned char>(
-              msg->point(i * msg->width() + j).intensity());
+          unsigned char intensity =
+              static_cast<unsigned char>(point.intensity);
           lidar_frame->pt_xs.push_back(pt3d[0]);
           lidar_frame->pt_ys.push_back(pt3d[1]);
           lidar_frame->pt_zs.push_back(pt3d[2]);
@@ -497,20 +482,21 @@ void NDTLocalization::LidarMsgTransfer(
     }
   } else {
     AINFO << "Receiving un-origanized-point-cloud, width " << msg->width()
-          << " height " << msg->height() << "size " << msg->point_size();
-    for (int i = 0; i < msg->point_size(); ++i) {
+          << " height " << msg->height() << "size " << drivers::PointNum(*msg);
+    const int point_num = drivers::PointNum(*msg);
+    for (int i = 0; i < point_num; ++i) {
+      const drivers::PackedPoint point = drivers::GetPoint(*msg, i);
       Eigen::Vector3f pt3d;
-      pt3d[0] = msg->point(i).x();
-      pt3d[1] = msg->point(i).y();
-      pt3d[2] = msg->point(i).z();
+      pt3d[0] = point.x;
+      pt3d[1] = point.y;
+      pt3d[2] = point.z;
       if (!std::isnan(pt3d[0])) {
         Eigen::Vector3f pt3d_tem = pt3d;
 
         if (pt3d_tem[2] > max_height_) {
           continue;
         }
-        unsigned char intensity =
-            static_cast<unsigned char>(msg->point(i).intensity());
+        unsigned char intensity = static_cast<unsigned char>(point.intensity);
         lidar_frame->pt_xs.push_back(pt3d[0]);
         lidar_frame->pt_ys.push_back(pt3d[1]);
         lidar_frame->pt_zs.push_back(pt3d[2]);
@@ -526,7 +512,7 @@ void NDTLocalization::LidarMsgTransfer(
           << "NDTLocalization Debug Log: velodyne msg. "
           << "[time:" << lidar_frame->measurement_time
           << "][height:" << msg->height() << "][width:" << msg->width()
-          << "][point_cnt:" << msg->point_size() << "]";
+          << "][point_cnt:" << drivers::PointNum(*msg) << "]";
   }
   return;
 }
@@ -19,6 +19,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include "cyber/base/time_indexed_ring_buffer.h"
 #include "modules/drivers/gnss/proto/ins.pb.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/localization/ndt/localization_pose_buffer.h"
@@ -37,10 +38,11 @@ struct LidarHeight {
   double height_var;
 };
 
-struct TimeStampPose {
-  double timestamp = 0.0;
-  Eigen::Affine3d pose;
-};
+// odometry pose without the alignment requirement of Eigen::Affine3d, so
+// that it can be kept in a TimeIndexedRingBuffer
+typedef Eigen::Transform<double, 3, Eigen::Affine, Eigen::DontAlign>
+    OdometryPose;
+typedef cyber::base::TimeIndexedRingBuffer<OdometryPose> OdometryPoseBuffer;
 
 class NDTLocalization {
  public:
@@ -128,10 +130,9 @@ class NDTLocalization {
   double error_ndt_score_ = 2.0;
   bool is_service_started_ = false;
 
-  std::list<TimeStampPose> odometry_buffer_;
-  std::mutex odometry_buffer_mutex_;
-  unsigned int odometry_buffer_size_ = 0;
+  // written by the odometry callback only, read without locks
   const unsigned int max_odometry_buffer_size_ = 100;
+  OdometryPoseBuffer odometry_buffer_{max_odometry_buffer_size_};
 
   LocalizationEstimate localization_result_;
   LocalizationStatus localization_status_;
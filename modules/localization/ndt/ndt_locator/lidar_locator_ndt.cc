@@ -19,6 +19,7 @@
 #include <pcl/common/transforms.h>
 #include <pcl/io/pcd_io.h>
 #include <algorithm>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -85,6 +86,14 @@ void LidarLocatorNdt::Init(const Eigen::Affine3d& init_location,
   reg_.SetStepSize(ndt_line_search_step_size_);
   reg_.SetTransformationEpsilon(ndt_transformation_epsilon_);
 
+  // Drop the map tiles of a former initialization
+  std::vector<TileIndex> target_tiles;
+  reg_.GetTargetTileIndices(&target_tiles);
+  for (const TileIndex& index : target_tiles) {
+    reg_.RemoveTargetTile(index);
+  }
+  is_target_origin_set_ = false;
+
   is_initialized_ = true;
 }
 
@@ -183,26 +192,22 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   //  Obtain map pointcloud
   apollo::common::time::Timer map_timer;
   map_timer.Start();
-  Eigen::Vector2d left_top_coord2d(lt_x, lt_y);
-  ComposeMapCells(left_top_coord2d, zone_id_, resolution_id_,
-                  map_.GetConfig().map_resolutions_[resolution_id_],
-                  transform.inverse());
-
-  // Convert map pointcloud to local corrdinate
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_map_point_cloud(
-      new pcl::PointCloud<pcl::PointXYZ>());
-  for (unsigned int i = 0; i < cell_map_.size(); ++i) {
-    Leaf& le = cell_map_[i];
-    float mean_0 = static_cast<float>(le.mean_(0));
-    float mean_1 = static_cast<float>(le.mean_(1));
-    float mean_2 = static_cast<float>(le.mean_(2));
-    pcl_map_point_cloud->push_back(pcl::PointXYZ(mean_0, mean_1, mean_2));
+  // The ndt target frame stays near the lidar for the float precision of the
+  // solver, and moves rarely so that the map tiles of the target are kept
+  if (!is_target_origin_set_ ||
+      (transform.translation() - target_origin_).head<2>().norm() >
+          kTargetRebaseDistance) {
+    if (is_target_origin_set_) {
+      reg_.ShiftTarget(target_origin_ - transform.translation());
+    }
+    target_origin_ = transform.translation();
+    is_target_origin_set_ = true;
   }
+  Eigen::Vector2d left_top_coord2d(lt_x, lt_y);
+  UpdateMapTiles(left_top_coord2d, zone_id_, resolution_id_,
+                 map_.GetConfig().map_resolutions_[resolution_id_]);
   map_timer.End("Map create end.");
-  // Set left top corner for reg
-  reg_.SetLeftTopCorner(map_left_top_corner_);
   // Ndt calculation
-  reg_.SetInputTarget(cell_map_, pcl_map_point_cloud);
   reg_.SetInputSource(online_points_filtered);
 
   apollo::common::time::Timer ndt_timer;
@@ -210,6 +215,7 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   Eigen::Matrix3d inv_R = transform.inverse().linear();
   Eigen::Matrix4d init_matrix = Eigen::Matrix4d::Identity();
   init_matrix.block<3, 3>(0, 0) = inv_R.inverse();
+  init_matrix.block<3, 1>(0, 3) = transform.translation() - target_origin_;
 
   pcl::PointCloud<pcl::PointXYZ>::Ptr output_cloud(
       new pcl::PointCloud<pcl::PointXYZ>);
@@ -255,247 +261,150 @@ Eigen::Matrix3d LidarLocatorNdt::GetLocationCovariance() const {
   return location_covariance_;
 }
 
-void LidarLocatorNdt::ComposeMapCells(
-    const Eigen::Vector2d& left_top_coord2d, int zone_id,
-    unsigned int resolution_id, float map_pixel_resolution,
-    const Eigen::Affine3d& inverse_transform) {
+void LidarLocatorNdt::UpdateMapTiles(const Eigen::Vector2d& left_top_coord2d,
+                                     int zone_id, unsigned int resolution_id,
+                                     float map_pixel_resolution) {
   apollo::common::time::Timer timer;
   timer.Start();
 
-  unsigned int map_node_size_x = map_.GetConfig().map_node_size_x_;
-  unsigned int map_node_size_y = map_.GetConfig().map_node_size_y_;
-  unsigned int filter_size_x = filter_x_;
-  unsigned int filter_size_y = filter_y_;
+  const msf::BaseMapConfig& config = map_.GetConfig();
+  int map_node_size_x = static_cast<int>(config.map_node_size_x_);
+  int map_node_size_y = static_cast<int>(config.map_node_size_y_);
 
   // get the left top coordinate of input online pointcloud
   Eigen::Vector2d coord2d = left_top_coord2d;
-  coord2d[0] -= map_pixel_resolution * static_cast<float>(filter_size_x / 2);
-  coord2d[1] -= map_pixel_resolution * static_cast<float>(filter_size_y / 2);
-
-  // get the node index of left top corner and global coordinate
-  msf::MapNodeIndex map_id = msf::MapNodeIndex::GetMapNodeIndex(
-      map_.GetConfig(), coord2d, resolution_id, zone_id);
-  NdtMapNode* map_node_lt =
-      dynamic_cast<NdtMapNode*>(map_.GetMapNodeSafe(map_id));
-  assert(map_.IsMapNodeExist(map_id));
-  unsigned int map_coord_x = 0;
-  unsigned int map_coord_y = 0;
-  map_node_lt->GetCoordinate(coord2d, &map_coord_x, &map_coord_y);
-
-  std::vector<std::vector<int>> map_nodes_zones;
-
-  int top_left_start_x = static_cast<int>(map_coord_x);
-  int top_left_start_y = static_cast<int>(map_coord_y);
-  int top_left_end_x = static_cast<int>(map_node_size_x) - 1;
-  int top_left_end_y = static_cast<int>(map_node_size_y) - 1;
-  std::vector<int> node_zone;
-  node_zone.push_back(top_left_start_x);
-  node_zone.push_back(top_left_start_y);
-  node_zone.push_back(top_left_end_x);
-  node_zone.push_back(top_left_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int top_center_start_x = 0;
-  int top_center_start_y = top_left_start_y;
-  int top_center_end_x = static_cast<int>(map_coord_x) - 1 +
-                         2 * static_cast<int>(filter_size_x / 2);
-  top_center_end_x = top_center_end_x > static_cast<int>(map_node_size_x) - 1
-                         ? static_cast<int>(map_node_size_x) - 1
-                         : top_center_end_x;
-  int top_center_end_y = static_cast<int>(map_node_size_y) - 1;
-  node_zone.clear();
-  node_zone.push_back(top_center_start_x);
-  node_zone.push_back(top_center_start_y);
-  node_zone.push_back(top_center_end_x);
-  node_zone.push_back(top_center_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int top_right_start_x = 0;
-  int top_right_start_y = top_left_start_y;
-  int top_right_end_x = 2 * static_cast<int>(filter_size_x / 2) -
-                        (top_left_end_x - top_left_start_x + 1) - 1;
-  int top_right_end_y = static_cast<int>(map_node_size_y) - 1;
-  node_zone.clear();
-  node_zone.push_back(top_right_start_x);
-  node_zone.push_back(top_right_start_y);
-  node_zone.push_back(top_right_end_x);
-  node_zone.push_back(top_right_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int middle_left_start_x = top_left_start_x;
-  int middle_left_start_y = 0;
-  int middle_left_end_x = top_left_end_x;
-  int middle_left_end_y = static_cast<int>(map_coord_y) - 1 +
-                          2 * static_cast<int>(filter_size_y / 2);
-  middle_left_end_y = middle_left_end_y > static_cast<int>(map_node_size_y) - 1
-                          ? static_cast<int>(map_node_size_y) - 1
-                          : middle_left_end_y;
-  node_zone.clear();
-  node_zone.push_back(middle_left_start_x);
-  node_zone.push_back(middle_left_start_y);
-  node_zone.push_back(middle_left_end_x);
-  node_zone.push_back(middle_left_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int middle_center_start_x = 0;
-  int middle_center_start_y = 0;
-  int middle_center_end_x = top_center_end_x;
-  int middle_center_end_y = middle_left_end_y;
-  node_zone.clear();
-  node_zone.push_back(middle_center_start_x);
-  node_zone.push_back(middle_center_start_y);
-  node_zone.push_back(middle_center_end_x);
-  node_zone.push_back(middle_center_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int middle_right_start_x = 0;
-  int middle_right_start_y = 0;
-  int middle_right_end_x = top_right_end_x;
-  int middle_right_end_y = middle_center_end_y;
-  node_zone.clear();
-  node_zone.push_back(middle_right_start_x);
-  node_zone.push_back(middle_right_start_y);
-  node_zone.push_back(middle_right_end_x);
-  node_zone.push_back(middle_right_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int bottom_left_start_x = top_left_start_x;
-  int bottom_left_start_y = 0;
-  int bottom_left_end_x = top_left_end_x;
-  int bottom_left_end_y = 2 * static_cast<int>(filter_size_y / 2) -
-                          (top_left_end_y - top_left_start_y + 1) - 1;
-  node_zone.clear();
-  node_zone.push_back(bottom_left_start_x);
-  node_zone.push_back(bottom_left_start_y);
-  node_zone.push_back(bottom_left_end_x);
-  node_zone.push_back(bottom_left_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int bottom_center_start_x = middle_center_start_x;
-  int bottom_center_start_y = bottom_left_start_y;
-  int bottom_center_end_x = middle_center_end_x;
-  int bottom_center_end_y = bottom_left_end_y;
-  node_zone.clear();
-  node_zone.push_back(bottom_center_start_x);
-  node_zone.push_back(bottom_center_start_y);
-  node_zone.push_back(bottom_center_end_x);
-  node_zone.push_back(bottom_center_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  int bottom_right_start_x = middle_right_start_x;
-  int bottom_right_start_y = bottom_left_start_y;
-  int bottom_right_end_x = middle_right_end_x;
-  int bottom_right_end_y = bottom_left_end_y;
-  node_zone.clear();
-  node_zone.push_back(bottom_right_start_x);
-  node_zone.push_back(bottom_right_start_y);
-  node_zone.push_back(bottom_right_end_x);
-  node_zone.push_back(bottom_right_end_y);
-  map_nodes_zones.push_back(node_zone);
-
-  std::vector<int> start_x_indices(3, 0);
-  std::vector<int> start_y_indices(3, 0);
-  start_x_indices[0] = 0;
-  start_x_indices[1] = top_left_end_x - top_left_start_x + 1;
-  start_x_indices[2] =
-      start_x_indices[1] + top_center_end_x - top_center_start_x + 1;
-  start_y_indices[0] = 0;
-  start_y_indices[1] = top_left_end_y - top_left_start_y + 1;
-  start_y_indices[2] =
-      start_y_indices[1] + middle_center_end_y - middle_center_start_y + 1;
-
-  std::vector<std::pair<int, int>> composed_map_indices;
-  for (int y = 0; y < 3; ++y) {
-    for (int x = 0; x < 3; ++x) {
-      composed_map_indices.push_back(
-          std::make_pair(start_x_indices[x], start_y_indices[y]));
+  coord2d[0] -= map_pixel_resolution * static_cast<float>(filter_x_ / 2);
+  coord2d[1] -= map_pixel_resolution * static_cast<float>(filter_y_ / 2);
+
+  // The area spans a map node and the filter size, in cells of the map
+  int start_x = static_cast<int>((coord2d[0] - config.map_range_.GetMinX()) /
+                                 map_pixel_resolution);
+  int start_y = static_cast<int>((coord2d[1] - config.map_range_.GetMinY()) /
+                                 map_pixel_resolution);
+  int end_x = start_x + map_node_size_x + 2 * (filter_x_ / 2) - 1;
+  int end_y = start_y + map_node_size_y + 2 * (filter_y_ / 2) - 1;
+  std::set<TileIndex> area_tiles;
+  for (int tile_y = start_y / kMapTileSize; tile_y <= end_y / kMapTileSize;
+       ++tile_y) {
+    for (int tile_x = start_x / kMapTileSize; tile_x <= end_x / kMapTileSize;
+         ++tile_x) {
+      area_tiles.insert(TileIndex(tile_x, tile_y));
     }
   }
 
-  Eigen::Vector2d coord2d_center =
-      map_node_lt->GetCoordinate(map_node_size_x / 2, map_node_size_y / 2);
-
-  cell_map_.clear();
-  Eigen::Affine3d transform = inverse_transform.inverse();
-  Eigen::Vector3d R_inv_t = -transform.translation();
-  // Calculate left top corner
-  map_left_top_corner_ = Eigen::Vector3d::Zero();
-  map_left_top_corner_.block<2, 1>(0, 0) = map_node_lt->GetLeftTopCorner();
-  map_left_top_corner_ += R_inv_t;
-
-  for (int y = 0; y < 3; ++y) {
-    for (int x = 0; x < 3; ++x) {
-      if (map_nodes_zones[y * 3 + x][2] - map_nodes_zones[y * 3 + x][0] >= 0 &&
-          map_nodes_zones[y * 3 + x][3] - map_nodes_zones[y * 3 + x][1] >= 0) {
-        // get map node
-        NdtMapNode* map_node_ptr = NULL;
-        if (x == 0 && y == 0) {
-          map_node_ptr = map_node_lt;
-        } else {
-          Eigen::Vector2d coord2d_xy;
-          coord2d_xy[0] =
-              coord2d_center[0] + static_cast<double>(x * map_node_size_x) *
-                                      static_cast<double>(map_pixel_resolution);
-          coord2d_xy[1] =
-              coord2d_center[1] + static_cast<double>(y * map_node_size_y) *
-                                      static_cast<double>(map_pixel_resolution);
-
-          msf::MapNodeIndex map_id = msf::MapNodeIndex::GetMapNodeIndex(
-              map_.GetConfig(), coord2d_xy, resolution_id, zone_id);
-          NdtMapNode* map_node_xy =
-              dynamic_cast<NdtMapNode*>(map_.GetMapNodeSafe(map_id));
-          assert(map_.IsMapNodeExist(map_id));
-          map_node_ptr = map_node_xy;
-        }
+  // Drop the tiles that left the area
+  std::vector<TileIndex> target_tiles;
+  reg_.GetTargetTileIndices(&target_tiles);
+  for (const TileIndex& index : target_tiles) {
+    if (area_tiles.count(index) == 0) {
+      reg_.RemoveTargetTile(index);
+    }
+  }
 
-        // get map matrix
-        NdtMapMatrix& map_cells =
-            dynamic_cast<NdtMapMatrix&>(map_node_ptr->GetMapCellMatrix());
-
-        // start obtain cells in MapNdtMatrix
-        const Eigen::Vector2d& left_top_corner =
-            map_node_ptr->GetLeftTopCorner();
-        double resolution = map_node_ptr->GetMapResolution();
-        double resolution_z = map_node_ptr->GetMapResolutionZ();
-        for (int map_y = map_nodes_zones[y * 3 + x][1];
-             map_y <= map_nodes_zones[y * 3 + x][3]; ++map_y) {
-          for (int map_x = map_nodes_zones[y * 3 + x][0];
-               map_x <= map_nodes_zones[y * 3 + x][2]; ++map_x) {
-            const msf::NdtMapCells& cell_ndt =
-                map_cells.GetMapCell(map_y, map_x);
-            if (cell_ndt.cells_.size() > 0) {
-              for (auto it = cell_ndt.cells_.begin();
-                   it != cell_ndt.cells_.end(); ++it) {
-                unsigned int cell_count = it->second.count_;
-                if (cell_count >= 6) {
-                  Leaf leaf;
-                  leaf.nr_points_ = static_cast<int>(cell_count);
-
-                  Eigen::Vector3d eigen_point(Eigen::Vector3d::Zero());
-                  eigen_point(0) = left_top_corner[0] + map_x * resolution +
-                                   it->second.centroid_[0];
-                  eigen_point(1) = left_top_corner[1] + map_y * resolution +
-                                   it->second.centroid_[1];
-                  eigen_point(2) =
-                      resolution_z * it->first + it->second.centroid_[2];
-                  leaf.mean_ = (eigen_point + R_inv_t);
-                  if (it->second.is_icov_available_ == 1) {
-                    leaf.icov_ = it->second.centroid_icov_.cast<double>();
-                  } else {
-                    leaf.nr_points_ = -1;
-                  }
-
-                  cell_map_.push_back(leaf);
-                }
+  // Compose the tiles that entered the area
+  int composed_tile_num = 0;
+  std::vector<Leaf> leaves;
+  for (const TileIndex& index : area_tiles) {
+    if (reg_.HasTargetTile(index)) {
+      continue;
+    }
+    if (ComposeMapTile(index, zone_id, resolution_id, &leaves)) {
+      reg_.AddTargetTile(index, &leaves);
+      ++composed_tile_num;
+    }
+  }
+  AINFO << "Map tiles: " << area_tiles.size() << ", composed "
+        << composed_tile_num;
+
+  timer.End("Update map tiles.");
+}
+
+bool LidarLocatorNdt::ComposeMapTile(const TileIndex& index, int zone_id,
+                                     unsigned int resolution_id,
+                                     std::vector<Leaf>* leaves) {
+  const msf::BaseMapConfig& config = map_.GetConfig();
+  int map_node_size_x = static_cast<int>(config.map_node_size_x_);
+  int map_node_size_y = static_cast<int>(config.map_node_size_y_);
+  double map_pixel_resolution = config.map_resolutions_[resolution_id];
+
+  int start_x = index.first * kMapTileSize;
+  int start_y = index.second * kMapTileSize;
+  int end_x = start_x + kMapTileSize - 1;
+  int end_y = start_y + kMapTileSize - 1;
+
+  leaves->clear();
+  // A tile lies in several map nodes when the node size is not a multiple of
+  // the tile size
+  for (int node_y = start_y / map_node_size_y;
+       node_y <= end_y / map_node_size_y; ++node_y) {
+    for (int node_x = start_x / map_node_size_x;
+         node_x <= end_x / map_node_size_x; ++node_x) {
+      // get map node
+      Eigen::Vector2d coord2d_xy;
+      coord2d_xy[0] = config.map_range_.GetMinX() +
+                      (node_x + 0.5) * map_node_size_x * map_pixel_resolution;
+      coord2d_xy[1] = config.map_range_.GetMinY() +
+                      (node_y + 0.5) * map_node_size_y * map_pixel_resolution;
+      msf::MapNodeIndex map_id = msf::MapNodeIndex::GetMapNodeIndex(
+          config, coord2d_xy, resolution_id, zone_id);
+      NdtMapNode* map_node_ptr =
+          dynamic_cast<NdtMapNode*>(map_.GetMapNodeSafe(map_id));
+      if (map_node_ptr == nullptr) {
+        AWARN << "Map node " << map_id << " of tile " << index.first << ", "
+              << index.second << " is not available.";
+        return false;
+      }
+
+      // get map matrix
+      NdtMapMatrix& map_cells =
+          dynamic_cast<NdtMapMatrix&>(map_node_ptr->GetMapCellMatrix());
+
+      // start obtain cells in MapNdtMatrix
+      const Eigen::Vector2d& left_top_corner =
+          map_node_ptr->GetLeftTopCorner();
+      double resolution = map_node_ptr->GetMapResolution();
+      double resolution_z = map_node_ptr->GetMapResolutionZ();
+      int node_start_x = node_x * map_node_size_x;
+      int node_start_y = node_y * map_node_size_y;
+      int min_x = std::max(start_x, node_start_x) - node_start_x;
+      int max_x = std::min(end_x, node_start_x + map_node_size_x - 1) -
+                  node_start_x;
+      int min_y = std::max(start_y, node_start_y) - node_start_y;
+      int max_y = std::min(end_y, node_start_y + map_node_size_y - 1) -
+                  node_start_y;
+      for (int map_y = min_y; map_y <= max_y; ++map_y) {
+        for (int map_x = min_x; map_x <= max_x; ++map_x) {
+          const msf::NdtMapCells& cell_ndt = map_cells.GetMapCell(map_y, map_x);
+          for (auto it = cell_ndt.cells_.begin(); it != cell_ndt.cells_.end();
+               ++it) {
+            unsigned int cell_count = it->second.count_;
+            if (cell_count >= 6) {
+              Leaf leaf;
+              leaf.nr_points_ = static_cast<int>(cell_count);
+
+              Eigen::Vector3d eigen_point(Eigen::Vector3d::Zero());
+              eigen_point(0) = left_top_corner[0] + map_x * resolution +
+                               it->second.centroid_[0];
+              eigen_point(1) = left_top_corner[1] + map_y * resolution +
+                               it->second.centroid_[1];
+              eigen_point(2) =
+                  resolution_z * it->first + it->second.centroid_[2];
+              leaf.mean_ = eigen_point - target_origin_;
+              // The inverse covariances are precomputed in the map
+              if (it->second.is_icov_available_ == 1) {
+                leaf.icov_ = it->second.centroid_icov_.cast<double>();
+              } else {
+                leaf.nr_points_ = -1;
               }
+
+              leaves->push_back(leaf);
             }
           }
         }
       }
     }
   }
-
-  timer.End("Compose map cells.");
+  return true;
 }
 
 }  // namespace ndt
@@ -95,10 +95,10 @@ class LidarLocatorNdt {
   /**@brief Set the lidar height. */
   void SetLidarHeight(double height);
 
-  /**@brief Compose candidate map area. */
-  void ComposeMapCells(const Eigen::Vector2d& left_top_coord2d, int zone_id,
-                       unsigned int resolution_id, float map_pixel_resolution,
-                       const Eigen::Affine3d& inverse_transform);
+  /**@brief Update the map tiles of the ndt target to the candidate map
+   * area, composing the tiles that entered it and dropping those that left. */
+  void UpdateMapTiles(const Eigen::Vector2d& left_top_coord2d, int zone_id,
+                      unsigned int resolution_id, float map_pixel_resolution);
 
   /**@brief Set online cloud resolution. */
   void SetOnlineCloudResolution(const float& online_resolution);
@@ -124,6 +124,16 @@ class LidarLocatorNdt {
   inline double GetFitnessScore() const { return fitness_score_; }
 
  private:
+  /**@brief Compose the leaves of a map tile in the ndt target frame, return
+   * false when a map node of the tile is not available. */
+  bool ComposeMapTile(const TileIndex& index, int zone_id,
+                      unsigned int resolution_id, std::vector<Leaf>* leaves);
+
+  /**@brief Side length of the map tiles of the ndt target, in map cells. */
+  static constexpr int kMapTileSize = 16;
+  /**@brief How far the lidar moves before the ndt target frame follows. */
+  static constexpr double kTargetRebaseDistance = 500.0;
+
   /**@brief Whether initialized. */
   bool is_initialized_ = false;
   /**@brief Whether map is loaded. */
@@ -164,10 +174,10 @@ class LidarLocatorNdt {
   NdtMap map_;
   /**@brief ndt mapnode pool. */
   NdtMapNodePool map_preload_node_pool_;
-  /**@brief Map point cloud. */
-  std::vector<Leaf> cell_map_;
-  /**brief Map Left top corner.*/
-  Eigen::Vector3d map_left_top_corner_;
+  /**@brief Origin of the ndt target frame, the map tiles of the target are
+   * relative to it. */
+  Eigen::Vector3d target_origin_ = Eigen::Vector3d::Zero();
+  bool is_target_origin_set_ = false;
   /**@brief NDT transform class. */
   NormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ> reg_;
 
@@ -62,6 +62,7 @@
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/time/timer.h"
 #include "modules/localization/ndt/ndt_locator/ndt_voxel_grid_covariance.h"
 
@@ -122,11 +123,45 @@ class NormalDistributionsTransform {
     }
 
     target_ = cloud;
+    target_changed_ = true;
+    target_from_tiles_ = false;
     target_cells_.SetVoxelGridResolution(resolution_, resolution_, resolution_);
     target_cells_.SetInputCloud(cloud);
     target_cells_.filter(cell_leaf, true);
   }
 
+  /**@brief Whether the input target holds the leaves of a map tile. */
+  inline bool HasTargetTile(const TileIndex &index) const {
+    return target_cells_.HasTile(index);
+  }
+
+  /**@brief Get the indices of the map tiles in the input target. */
+  inline void GetTargetTileIndices(std::vector<TileIndex> *indices) const {
+    target_cells_.GetTileIndices(indices);
+  }
+
+  /**@brief Add the leaves of a map tile to the input target, the leaves are
+   * moved. The target is then made of tiles, so that moving over the map
+   * only adds and drops the tiles at its border. */
+  inline void AddTargetTile(const TileIndex &index, std::vector<Leaf> *leaves) {
+    target_cells_.SetVoxelGridResolution(resolution_, resolution_, resolution_);
+    target_cells_.AddTile(index, leaves);
+    target_changed_ = true;
+    target_from_tiles_ = true;
+  }
+
+  /**@brief Drop the leaves of a map tile from the input target. */
+  inline void RemoveTargetTile(const TileIndex &index) {
+    target_cells_.RemoveTile(index);
+    target_changed_ = true;
+  }
+
+  /**@brief Move the map tiles of the input target by the offset. */
+  inline void ShiftTarget(const Eigen::Vector3d &offset) {
+    target_cells_.ShiftTiles(offset);
+    target_changed_ = true;
+  }
+
   /**@brief Provide a pointer to the input target. */
   inline void SetInputSource(const PointCloudTargetConstPtr &cloud) {
     if (cloud->points.empty()) {
@@ -158,6 +193,14 @@ class NormalDistributionsTransform {
    */
   inline void SetStepSize(double step_size) { step_size_ = step_size; }
 
+  /**@brief Set/change how far the source points may have moved since the
+   * last neighbor voxel search for its result to be reused.
+   * \param[in] distance reuse distance, 0 to search on every evaluation
+   */
+  inline void SetNeighborReuseDistance(double distance) {
+    neighbor_reuse_distance_ = distance;
+  }
+
   /**@brief Get the point cloud outlier ratio. */
   inline double GetOulierRatio() const { return outlier_ratio_; }
 
@@ -260,7 +303,9 @@ class NormalDistributionsTransform {
                            Eigen::Matrix<double, 6, 6> *hessian,
                            const Eigen::Vector3d &x_trans,
                            const Eigen::Matrix3d &c_inv,
-                           bool ComputeHessian = true);
+                           const Eigen::Matrix<double, 3, 6> &point_gradient,
+                           const Eigen::Matrix<double, 18, 6> &point_hessian,
+                           bool ComputeHessian = true) const;
 
   /**@brief Precompute anglular components of derivatives. */
   void ComputeAngleDerivatives(const Eigen::Matrix<double, 6, 1> &p,
@@ -268,7 +313,14 @@ class NormalDistributionsTransform {
 
   /**@brief Compute point derivatives. */
   void ComputePointDerivatives(const Eigen::Vector3d &x,
-                               bool ComputeHessian = true);
+                               Eigen::Matrix<double, 3, 6> *point_gradient,
+                               Eigen::Matrix<double, 18, 6> *point_hessian,
+                               bool ComputeHessian = true) const;
+
+  /**@brief Find the neighbor voxels of every transformed source point, unless
+   * the points moved less than the reuse distance since the last search. */
+  void SearchNeighborhoods(const PointCloudSource &trans_cloud,
+                           const Eigen::Matrix<double, 6, 1> &p);
 
   /**@brief Compute hessian of probability function w.r.t. the transformation
    * vector. */
@@ -280,7 +332,9 @@ class NormalDistributionsTransform {
    * function. */
   void UpdateHessian(Eigen::Matrix<double, 6, 6> *hessian,
                      const Eigen::Vector3d &x_trans,
-                     const Eigen::Matrix3d &c_inv);
+                     const Eigen::Matrix3d &c_inv,
+                     const Eigen::Matrix<double, 3, 6> &point_gradient,
+                     const Eigen::Matrix<double, 18, 6> &point_hessian) const;
 
   /**@brief Compute line search step length and update transform and probability
    * derivatives. */
@@ -321,6 +375,10 @@ class NormalDistributionsTransform {
   PointCloudTargetConstPtr target_;
   /**@brief A pointer to the spatial search object. */
   KdTreePtr target_tree_;
+  /**@brief Whether target_tree_ is out of date. */
+  bool target_changed_;
+  /**@brief Whether the target is made of map tiles. */
+  bool target_from_tiles_;
   /**@brief The voxel grid generated from target cloud containing point
    * means and covariances. */
   TargetGrid target_cells_;
@@ -363,12 +421,16 @@ class NormalDistributionsTransform {
   Eigen::Vector3d h_ang_a2_, h_ang_a3_, h_ang_b2_, h_ang_b3_, h_ang_c2_,
       h_ang_c3_, h_ang_d1_, h_ang_d2_, h_ang_d3_, h_ang_e1_, h_ang_e2_,
       h_ang_e3_, h_ang_f1_, h_ang_f2_, h_ang_f3_;
-  /**@brief The first order derivative of the transformation of a point
-   * w.r.t. the transform vector, Equation 6.18 [Magnusson 2009]. */
-  Eigen::Matrix<double, 3, 6> point_gradient_;
-  /**@brief The second order derivative of the transformation of a point
-   * w.r.t. the transform vector, Equation 6.20 [Magnusson 2009]. */
-  Eigen::Matrix<double, 18, 6> point_hessian_;
+  /**@brief The neighbor voxels of each source point found by the last
+   * search, and the transform vector they were found at. */
+  std::vector<std::vector<TargetGridLeafConstPtr>> neighborhoods_;
+  Eigen::Matrix<double, 6, 1> neighborhoods_p_;
+  bool neighborhoods_valid_;
+  /**@brief The distance of the farthest source point from its origin. */
+  double source_max_range_;
+  /**@brief How far the source points may move before the neighbor voxels
+   * are searched again. */
+  double neighbor_reuse_distance_;
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
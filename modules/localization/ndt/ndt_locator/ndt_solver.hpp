@@ -103,8 +103,21 @@ void NormalDistributionsTransform<PointSource, PointTarget>::Align(
 template <typename PointSource, typename PointTarget>
 double NormalDistributionsTransform<PointSource, PointTarget>::GetFitnessScore(
     double max_range) {
-  // Set the target tree
-  target_tree_->setInputCloud(target_);
+  // Set the target tree, only when the target changed
+  if (target_changed_) {
+    if (target_from_tiles_) {
+      boost::shared_ptr<PointCloudTarget> centroids(new PointCloudTarget);
+      target_cells_.GetTileCentroids(centroids.get());
+      target_ = centroids;
+    }
+    if (target_ && !target_->points.empty()) {
+      target_tree_->setInputCloud(target_);
+    }
+    target_changed_ = false;
+  }
+  if (!target_ || target_->points.empty()) {
+    return (std::numeric_limits<double>::max());
+  }
   double fitness_score = 0.0;
   // Transform the input dataset using the final transformation
   PointCloudSource input_transformed;
@@ -162,6 +175,8 @@ template <typename PointSource, typename PointTarget>
 NormalDistributionsTransform<PointSource,
                              PointTarget>::NormalDistributionsTransform()
     : target_tree_(new KdTree),
+      target_changed_(false),
+      target_from_tiles_(false),
       target_cells_(),
       resolution_(1.0f),
       step_size_(0.1),
@@ -192,8 +207,9 @@ NormalDistributionsTransform<PointSource,
       h_ang_f1_(),
       h_ang_f2_(),
       h_ang_f3_(),
-      point_gradient_(),
-      point_hessian_() {
+      neighborhoods_valid_(false),
+      source_max_range_(0.0),
+      neighbor_reuse_distance_(0.05) {
   double gauss_c1, gauss_c2, gauss_d3;
 
   // Initializes the guassian fitting parameters (eq. 6.8) [Magnusson 2009]
@@ -234,10 +250,14 @@ void NormalDistributionsTransform<PointSource, PointTarget>::
     transformPointCloud(*output, *output, guess);
   }
 
-  // Initialize Point Gradient and Hessian
-  point_gradient_.setZero();
-  point_gradient_.block<3, 3>(0, 0).setIdentity();
-  point_hessian_.setZero();
+  // The neighbor voxels found for the last source or target are stale
+  neighborhoods_valid_ = false;
+  source_max_range_ = 0.0;
+  for (const PointSource &pt : input_->points) {
+    source_max_range_ =
+        std::max(source_max_range_,
+                 static_cast<double>(pt.getVector3fMap().norm()));
+  }
 
   Eigen::Transform<float, 3, Eigen::Affine, Eigen::ColMajor> eig_transformation;
   eig_transformation.matrix() = final_transformation_;
@@ -324,61 +344,104 @@ NormalDistributionsTransform<PointSource, PointTarget>::ComputeDerivatives(
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, PointCloudSourcePtr trans_cloud,
     Eigen::Matrix<double, 6, 1> *p, bool compute_hessian) {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
-  // Original Point and Transformed Point (for math)
-  Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
+  // Points per block of the parallel reduction. The blocks are summed in
+  // order, so the result does not depend on the number of threads.
+  constexpr size_t kPointsPerBlock = 256;
 
   score_gradient->setZero();
   hessian->setZero();
-  double score = 0;
 
   // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
   ComputeAngleDerivatives(*p);
 
-  // Update gradient and hessian for each point, line 17 in Algorithm 2
-  // [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size(); idx++) {
-    x_trans_pt = trans_cloud->points[idx];
-
-    // Find nieghbors (Radius search has been experimentally faster than
-    // direct neighbor checking.
-    std::vector<TargetGridLeafConstPtr> neighborhood;
-    std::vector<float> distances;
-    target_cells_.RadiusSearch(x_trans_pt, resolution_, &neighborhood,
-                               &distances);
-
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator
-             neighborhood_it = neighborhood.begin();
-         neighborhood_it != neighborhood.end(); neighborhood_it++) {
-      cell = *neighborhood_it;
-      x_pt = input_->points[idx];
-      x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
+  // Find nieghbors (Radius search has been experimentally faster than
+  // direct neighbor checking.
+  SearchNeighborhoods(*trans_cloud, *p);
 
-      x_trans = Eigen::Vector3d(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
+  const size_t point_num = input_->points.size();
+  const size_t block_num = (point_num + kPointsPerBlock - 1) / kPointsPerBlock;
+  std::vector<double> block_scores(block_num, 0.0);
+  std::vector<Eigen::Matrix<double, 6, 1>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 1>>>
+      block_gradients(block_num, Eigen::Matrix<double, 6, 1>::Zero());
+  std::vector<Eigen::Matrix<double, 6, 6>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6>>>
+      block_hessians(block_num, Eigen::Matrix<double, 6, 6>::Zero());
 
-      // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson 2009]
-      x_trans -= cell->GetMean();
-      // Uses precomputed covariance for speed.
-      c_inv = cell->GetInverseCov();
+  // Update gradient and hessian for each point, line 17 in Algorithm 2
+  // [Magnusson 2009]
+  apollo::cyber::ParallelFor(0, block_num, 1, [&](size_t block) {
+    Eigen::Matrix<double, 3, 6> point_gradient;
+    point_gradient.setZero();
+    point_gradient.block<3, 3>(0, 0).setIdentity();
+    Eigen::Matrix<double, 18, 6> point_hessian;
+    point_hessian.setZero();
+
+    const size_t end = std::min(point_num, (block + 1) * kPointsPerBlock);
+    for (size_t idx = block * kPointsPerBlock; idx < end; idx++) {
+      const std::vector<TargetGridLeafConstPtr> &neighborhood =
+          neighborhoods_[idx];
+      if (neighborhood.empty()) {
+        continue;
+      }
+      const PointSource &x_pt = input_->points[idx];
+      const PointSource &x_trans_pt = trans_cloud->points[idx];
+      // Original Point and Transformed Point (for math)
+      const Eigen::Vector3d x(x_pt.x, x_pt.y, x_pt.z);
+      const Eigen::Vector3d x_trans(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
 
       // Compute derivative of transform function w.r.t. transform vector,
       // J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
-      ComputePointDerivatives(x);
-      // Update score, gradient and hessian, lines 19-21 in Algorithm 2,
-      // according to Equations 6.10, 6.12 and 6.13, respectively [Magnusson
-      // 2009]
-      score += UpdateDerivatives(score_gradient, hessian, x_trans, c_inv,
-                                 compute_hessian);
+      ComputePointDerivatives(x, &point_gradient, &point_hessian,
+                              compute_hessian);
+      for (const TargetGridLeafConstPtr cell : neighborhood) {
+        // Update score, gradient and hessian, lines 19-21 in Algorithm 2,
+        // according to Equations 6.10, 6.12 and 6.13, respectively
+        // [Magnusson 2009]. Denorm point, x_k' in Equations 6.12 and 6.13,
+        // and uses precomputed covariance for speed.
+        block_scores[block] += UpdateDerivatives(
+            &block_gradients[block], &block_hessians[block],
+            x_trans - cell->GetMean(), cell->GetInverseCov(), point_gradient,
+            point_hessian, compute_hessian);
+      }
     }
+  });
+
+  double score = 0;
+  for (size_t block = 0; block < block_num; ++block) {
+    score += block_scores[block];
+    *score_gradient += block_gradients[block];
+    *hessian += block_hessians[block];
   }
   return (score);
 }
 
+template <typename PointSource, typename PointTarget>
+void NormalDistributionsTransform<PointSource, PointTarget>::
+    SearchNeighborhoods(const PointCloudSource &trans_cloud,
+                        const Eigen::Matrix<double, 6, 1> &p) {
+  const size_t point_num = input_->points.size();
+  if (neighborhoods_valid_ && neighborhoods_.size() == point_num) {
+    // Bound of how far any source point moved since the last search, for
+    // the small angles between two evaluations
+    const Eigen::Matrix<double, 6, 1> delta_p = p - neighborhoods_p_;
+    const double shift =
+        delta_p.head<3>().norm() + delta_p.tail<3>().norm() * source_max_range_;
+    if (shift < neighbor_reuse_distance_) {
+      return;
+    }
+  }
+
+  neighborhoods_.resize(point_num);
+  apollo::cyber::ParallelFor(0, point_num, 64, [&](size_t idx) {
+    std::vector<float> distances;
+    target_cells_.RadiusSearch(trans_cloud.points[idx], resolution_,
+                               &neighborhoods_[idx], &distances);
+  });
+  neighborhoods_p_ = p;
+  neighborhoods_valid_ = true;
+}
+
 template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::
     ComputeAngleDerivatives(const Eigen::Matrix<double, 6, 1> &p,
@@ -450,20 +513,22 @@ void NormalDistributionsTransform<PointSource, PointTarget>::
 }
 
 template <typename PointSource, typename PointTarget>
-void NormalDistributionsTransform<
-    PointSource, PointTarget>::ComputePointDerivatives(const Eigen::Vector3d &x,
-                                                       bool compute_hessian) {
+void NormalDistributionsTransform<PointSource, PointTarget>::
+    ComputePointDerivatives(const Eigen::Vector3d &x,
+                            Eigen::Matrix<double, 3, 6> *point_gradient,
+                            Eigen::Matrix<double, 18, 6> *point_hessian,
+                            bool compute_hessian) const {
   // Calculate first derivative of Transformation Equation 6.17 w.r.t. transform
   // vector p. Derivative w.r.t. ith element of transform vector corresponds to
   // column i, Equation 6.18 and 6.19 [Magnusson 2009]
-  point_gradient_(1, 3) = x.dot(j_ang_a_);
-  point_gradient_(2, 3) = x.dot(j_ang_b_);
-  point_gradient_(0, 4) = x.dot(j_ang_c_);
-  point_gradient_(1, 4) = x.dot(j_ang_d_);
-  point_gradient_(2, 4) = x.dot(j_ang_e_);
-  point_gradient_(0, 5) = x.dot(j_ang_f_);
-  point_gradient_(1, 5) = x.dot(j_ang_g_);
-  point_gradient_(2, 5) = x.dot(j_ang_h_);
+  (*point_gradient)(1, 3) = x.dot(j_ang_a_);
+  (*point_gradient)(2, 3) = x.dot(j_ang_b_);
+  (*point_gradient)(0, 4) = x.dot(j_ang_c_);
+  (*point_gradient)(1, 4) = x.dot(j_ang_d_);
+  (*point_gradient)(2, 4) = x.dot(j_ang_e_);
+  (*point_gradient)(0, 5) = x.dot(j_ang_f_);
+  (*point_gradient)(1, 5) = x.dot(j_ang_g_);
+  (*point_gradient)(2, 5) = x.dot(j_ang_h_);
 
   if (compute_hessian) {
     // Vectors from Equation 6.21 [Magnusson 2009]
@@ -480,15 +545,15 @@ void NormalDistributionsTransform<
     // transform vector p. Derivative w.r.t. ith and jth elements of transform
     // vector corresponds to the 3x1 block matrix starting at (3i,j),
     // Equation 6.20 and 6.21 [Magnusson 2009]
-    point_hessian_.block<3, 1>(9, 3) = a;
-    point_hessian_.block<3, 1>(12, 3) = b;
-    point_hessian_.block<3, 1>(15, 3) = c;
-    point_hessian_.block<3, 1>(9, 4) = b;
-    point_hessian_.block<3, 1>(12, 4) = d;
-    point_hessian_.block<3, 1>(15, 4) = e;
-    point_hessian_.block<3, 1>(9, 5) = c;
-    point_hessian_.block<3, 1>(12, 5) = e;
-    point_hessian_.block<3, 1>(15, 5) = f;
+    point_hessian->block<3, 1>(9, 3) = a;
+    point_hessian->block<3, 1>(12, 3) = b;
+    point_hessian->block<3, 1>(15, 3) = c;
+    point_hessian->block<3, 1>(9, 4) = b;
+    point_hessian->block<3, 1>(12, 4) = d;
+    point_hessian->block<3, 1>(15, 4) = e;
+    point_hessian->block<3, 1>(9, 5) = c;
+    point_hessian->block<3, 1>(12, 5) = e;
+    point_hessian->block<3, 1>(15, 5) = f;
   }
 }
 
@@ -497,11 +562,14 @@ double
 NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
-    const Eigen::Matrix3d &c_inv, bool compute_hessian) {
-  Eigen::Vector3d cov_dxd_pi;
+    const Eigen::Matrix3d &c_inv,
+    const Eigen::Matrix<double, 3, 6> &point_gradient,
+    const Eigen::Matrix<double, 18, 6> &point_hessian,
+    bool compute_hessian) const {
   // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson
   // 2009]
-  double e_x_cov_x = exp(-gauss_d2_ * x_trans.dot(c_inv * x_trans) / 2);
+  const Eigen::Vector3d cov_x = c_inv * x_trans;
+  double e_x_cov_x = exp(-gauss_d2_ * x_trans.dot(cov_x) / 2);
   // Calculate probability of transtormed points existance, Equation 6.9
   // [Magnusson 2009]
   double score_inc = -gauss_d1_ * e_x_cov_x;
@@ -516,25 +584,26 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
   // Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
   e_x_cov_x *= gauss_d1_;
 
-  for (int i = 0; i < 6; i++) {
-    // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13
-    // [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col(i);
-
-    // Update gradient, Equation 6.12 [Magnusson 2009]
-    (*score_gradient)(i) += x_trans.dot(cov_dxd_pi) * e_x_cov_x;
-
-    if (compute_hessian) {
-      for (int j = 0; j < hessian->cols(); j++) {
-        // Update hessian, Equation 6.13 [Magnusson 2009]
-        (*hessian)(i, j) +=
-            e_x_cov_x *
-            (-gauss_d2_ * x_trans.dot(cov_dxd_pi) *
-                 x_trans.dot(c_inv * point_gradient_.col(j)) +
-             x_trans.dot(c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-             point_gradient_.col(j).dot(cov_dxd_pi));
-      }
+  // Sigma_k^-1 d(T(x,p))/dpi for all i at once, Reusable portion of Equation
+  // 6.12 and 6.13 [Magnusson 2009]
+  const Eigen::Matrix<double, 3, 6> cov_dxd_p = c_inv * point_gradient;
+  const Eigen::Matrix<double, 1, 6> x_cov_dxd_p =
+      x_trans.transpose() * cov_dxd_p;
+
+  // Update gradient, Equation 6.12 [Magnusson 2009]
+  *score_gradient += e_x_cov_x * x_cov_dxd_p.transpose();
+
+  if (compute_hessian) {
+    // Update hessian, Equation 6.13 [Magnusson 2009], Sigma_k^-1 being
+    // symmetric
+    Eigen::Matrix<double, 6, 6> hessian_inc =
+        point_gradient.transpose() * cov_dxd_p -
+        gauss_d2_ * x_cov_dxd_p.transpose() * x_cov_dxd_p;
+    for (int i = 0; i < 6; i++) {
+      hessian_inc.row(i) +=
+          cov_x.transpose() * point_hessian.block<3, 6>(3 * i, 0);
     }
+    *hessian += e_x_cov_x * hessian_inc;
   }
 
   return score_inc;
@@ -544,68 +613,73 @@ template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::ComputeHessian(
     Eigen::Matrix<double, 6, 6> *hessian, const PointCloudSource &trans_cloud,
     Eigen::Matrix<double, 6, 1> *p) {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
-  // Original Point and Transformed Point (for math)
-  Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
+  // Points per block of the parallel reduction, as in ComputeDerivatives.
+  constexpr size_t kPointsPerBlock = 256;
 
   hessian->setZero();
 
   // Precompute Angular Derivatives unessisary because only used after regular
   // derivative calculation
 
-  // Update hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size(); idx++) {
-    x_trans_pt = trans_cloud.points[idx];
+  // Find nieghbors (Radius search has been experimentally faster than
+  // direct neighbor checking.
+  SearchNeighborhoods(trans_cloud, *p);
 
-    // Find nieghbors (Radius search has been experimentally faster than
-    // direct neighbor checking.
-    std::vector<TargetGridLeafConstPtr> neighborhood;
-    std::vector<float> distances;
-    target_cells_.RadiusSearch(x_trans_pt, resolution_, &neighborhood,
-                               &distances);
-
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator
-             neighborhood_it = neighborhood.begin();
-         neighborhood_it != neighborhood.end(); neighborhood_it++) {
-      cell = *neighborhood_it;
-      {
-        x_pt = input_->points[idx];
-        x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
-
-        x_trans = Eigen::Vector3d(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
-
-        // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson
-        // 2009]
-        x_trans -= cell->GetMean();
-        // Uses precomputed covariance for speed.
-        c_inv = cell->GetInverseCov();
-
-        // Compute derivative of transform function w.r.t. transform
-        // vector, J_E and H_E in Equations 6.18 and 6.20 [Magnusson
-        // 2009]
-        ComputePointDerivatives(x);
+  const size_t point_num = input_->points.size();
+  const size_t block_num = (point_num + kPointsPerBlock - 1) / kPointsPerBlock;
+  std::vector<Eigen::Matrix<double, 6, 6>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6>>>
+      block_hessians(block_num, Eigen::Matrix<double, 6, 6>::Zero());
+
+  // Update hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
+  apollo::cyber::ParallelFor(0, block_num, 1, [&](size_t block) {
+    Eigen::Matrix<double, 3, 6> point_gradient;
+    point_gradient.setZero();
+    point_gradient.block<3, 3>(0, 0).setIdentity();
+    Eigen::Matrix<double, 18, 6> point_hessian;
+    point_hessian.setZero();
+
+    const size_t end = std::min(point_num, (block + 1) * kPointsPerBlock);
+    for (size_t idx = block * kPointsPerBlock; idx < end; idx++) {
+      const std::vector<TargetGridLeafConstPtr> &neighborhood =
+          neighborhoods_[idx];
+      if (neighborhood.empty()) {
+        continue;
+      }
+      const PointSource &x_pt = input_->points[idx];
+      const PointSource &x_trans_pt = trans_cloud.points[idx];
+      // Original Point and Transformed Point (for math)
+      const Eigen::Vector3d x(x_pt.x, x_pt.y, x_pt.z);
+      const Eigen::Vector3d x_trans(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
+
+      // Compute derivative of transform function w.r.t. transform
+      // vector, J_E and H_E in Equations 6.18 and 6.20 [Magnusson
+      // 2009]
+      ComputePointDerivatives(x, &point_gradient, &point_hessian);
+      for (const TargetGridLeafConstPtr cell : neighborhood) {
         // Update hessian, lines 21 in Algorithm 2, according to
         // Equations 6.10, 6.12 and 6.13, respectively [Magnusson 2009]
-        UpdateHessian(hessian, x_trans, c_inv);
+        UpdateHessian(&block_hessians[block], x_trans - cell->GetMean(),
+                      cell->GetInverseCov(), point_gradient, point_hessian);
       }
     }
+  });
+
+  for (const auto &block_hessian : block_hessians) {
+    *hessian += block_hessian;
   }
 }
 
 template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::UpdateHessian(
     Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
-    const Eigen::Matrix3d &c_inv) {
-  Eigen::Vector3d cov_dxd_pi;
+    const Eigen::Matrix3d &c_inv,
+    const Eigen::Matrix<double, 3, 6> &point_gradient,
+    const Eigen::Matrix<double, 18, 6> &point_hessian) const {
   // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9
   // [Magnusson 2009]
-  double e_x_cov_x =
-      gauss_d2_ * exp(-gauss_d2_ * x_trans.dot(c_inv * x_trans) / 2);
+  const Eigen::Vector3d cov_x = c_inv * x_trans;
+  double e_x_cov_x = gauss_d2_ * exp(-gauss_d2_ * x_trans.dot(cov_x) / 2);
 
   // Error checking for invalid values.
   if (e_x_cov_x > 1 || e_x_cov_x < 0 || e_x_cov_x != e_x_cov_x) {
@@ -615,21 +689,21 @@ void NormalDistributionsTransform<PointSource, PointTarget>::UpdateHessian(
   // Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
   e_x_cov_x *= gauss_d1_;
 
+  // Sigma_k^-1 d(T(x,p))/dpi for all i at once, Reusable portion of Equation
+  // 6.12 and 6.13 [Magnusson 2009]
+  const Eigen::Matrix<double, 3, 6> cov_dxd_p = c_inv * point_gradient;
+  const Eigen::Matrix<double, 1, 6> x_cov_dxd_p =
+      x_trans.transpose() * cov_dxd_p;
+
+  // Update hessian, Equation 6.13 [Magnusson 2009]
+  Eigen::Matrix<double, 6, 6> hessian_inc =
+      point_gradient.transpose() * cov_dxd_p -
+      gauss_d2_ * x_cov_dxd_p.transpose() * x_cov_dxd_p;
   for (int i = 0; i < 6; i++) {
-    // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13
-    // [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col(i);
-
-    for (int j = 0; j < hessian->cols(); j++) {
-      // Update hessian, Equation 6.13 [Magnusson 2009]
-      (*hessian)(i, j) +=
-          e_x_cov_x *
-          (-gauss_d2_ * x_trans.dot(cov_dxd_pi) *
-               x_trans.dot(c_inv * point_gradient_.col(j)) +
-           x_trans.dot(c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-           point_gradient_.col(j).dot(cov_dxd_pi));
-    }
+    hessian_inc.row(i) +=
+        cov_x.transpose() * point_hessian.block<3, 6>(3 * i, 0);
   }
+  *hessian += e_x_cov_x * hessian_inc;
 }
 
 template <typename PointSource, typename PointTarget>
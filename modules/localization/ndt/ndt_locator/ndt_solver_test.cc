@@ -209,6 +209,53 @@ TEST_F(NdtSolverTestSuite, NdtSolver) {
   ASSERT_LE(iteration, 7);
 }
 
+TEST_F(NdtSolverTestSuite, VoxelGridTiles) {
+  // Leaves on a lattice, two per voxel, in tiles of 4 m
+  std::vector<Leaf> leaves;
+  for (int x = 0; x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      for (int i = 0; i < 2; ++i) {
+        Leaf leaf;
+        leaf.nr_points_ = 10;
+        leaf.mean_ = Eigen::Vector3d(x + 0.25 + 0.5 * i, y + 0.5, 0.5);
+        leaves.push_back(leaf);
+      }
+    }
+  }
+  VoxelGridCovariance<pcl::PointXYZ> grid;
+  grid.SetVoxelGridResolution(1.0, 1.0, 1.0);
+  std::map<TileIndex, std::vector<Leaf>> tiles;
+  for (const Leaf& leaf : leaves) {
+    tiles[TileIndex(static_cast<int>(leaf.mean_(0)) / 4,
+                    static_cast<int>(leaf.mean_(1)) / 4)]
+        .push_back(leaf);
+  }
+  for (auto& tile : tiles) {
+    grid.AddTile(tile.first, &tile.second);
+  }
+  EXPECT_TRUE(grid.HasTile(TileIndex(1, 2)));
+
+  std::vector<LeafConstPtr> neighbors;
+  std::vector<float> distances;
+  pcl::PointXYZ query(6.0f, 6.5f, 0.5f);
+  EXPECT_EQ(grid.RadiusSearch(query, 0.8, &neighbors, &distances), 4);
+  EXPECT_EQ(grid.RadiusSearch(query, 0.8, &neighbors, &distances, 2), 2);
+  EXPECT_NEAR(distances[0], 0.0625, 1e-6);
+
+  // Leaves of dropped tiles are not found any more
+  grid.RemoveTile(TileIndex(1, 1));
+  EXPECT_FALSE(grid.HasTile(TileIndex(1, 1)));
+  EXPECT_EQ(grid.RadiusSearch(query, 0.8, &neighbors, &distances), 0);
+
+  // Shifted tiles are found at their new place
+  grid.ShiftTiles(Eigen::Vector3d(100.0, -50.0, 1.0));
+  query = pcl::PointXYZ(110.0f, -43.5f, 1.5f);
+  EXPECT_EQ(grid.RadiusSearch(query, 0.8, &neighbors, &distances), 4);
+  std::vector<TileIndex> indices;
+  grid.GetTileIndices(&indices);
+  EXPECT_EQ(indices.size(), 15);
+}
+
 }  // namespace ndt
 }  // namespace localization
 }  // namespace apollo
@@ -56,7 +56,10 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_types.h>
+#include <cmath>
 #include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -94,6 +97,8 @@ struct Leaf {
 typedef Leaf *LeafPtr;
 /**@brief Const pointer to VoxelGridCovariance leaf structure */
 typedef const Leaf *LeafConstPtr;
+/**@brief Index of a map tile, the column and row of the tile in the map. */
+typedef std::pair<int, int> TileIndex;
 
 /**@brief A searchable voxel strucure containing the mean and covariance of the
  * data. */
@@ -121,7 +126,10 @@ class VoxelGridCovariance {
         leaves_(),
         voxel_centroids_(),
         voxel_centroids_leaf_indices_(),
-        kdtree_() {
+        kdtree_(),
+        tiles_(),
+        tile_voxels_(),
+        tile_voxel_origin_(Eigen::Vector3d::Zero()) {
     leaf_size_.setZero();
     min_b_.setZero();
     max_b_.setZero();
@@ -145,9 +153,10 @@ class VoxelGridCovariance {
   /**@brief Get the minimum number of points required for a cell to be used.*/
   inline int GetMinPointPerVoxel() { return min_points_per_voxel_; }
 
-  /**@brief Initializes voxel structure. */
+  /**@brief Initializes voxel structure, the map tiles are dropped. */
   inline void filter(const std::vector<Leaf> &cell_leaf,
                      bool searchable = true) {
+    ClearTiles();
     voxel_centroids_ = PointCloudPtr(new PointCloud);
     SetMap(cell_leaf, voxel_centroids_);
     if (voxel_centroids_->size() > 0) {
@@ -243,6 +252,9 @@ class VoxelGridCovariance {
   }
 
   inline void SetVoxelGridResolution(float lx, float ly, float lz) {
+    if (leaf_size_[0] == lx && leaf_size_[1] == ly && leaf_size_[2] == lz) {
+      return;
+    }
     leaf_size_[0] = lx;
     leaf_size_[1] = ly;
     leaf_size_[2] = lz;
@@ -250,8 +262,35 @@ class VoxelGridCovariance {
     if (leaf_size_[3] == 0) leaf_size_[3] = 1;
     // Use multiplications instead of divisions
     inverse_leaf_size_ = Eigen::Array4f::Ones() / leaf_size_.array();
+    RebuildTileVoxels();
+  }
+
+  /**@brief Whether the leaves of a map tile are in the grid. */
+  inline bool HasTile(const TileIndex &index) const {
+    return tiles_.find(index) != tiles_.end();
   }
 
+  /**@brief Get the indices of the map tiles in the grid. */
+  void GetTileIndices(std::vector<TileIndex> *indices) const;
+
+  /**@brief Add the leaves of a map tile, they are moved into the grid. Once
+   * tiles are added, searches go through them instead of the leaves given to
+   * filter(). */
+  void AddTile(const TileIndex &index, std::vector<Leaf> *leaves);
+
+  /**@brief Drop the leaves of a map tile. */
+  void RemoveTile(const TileIndex &index);
+
+  /**@brief Drop all the map tiles. */
+  void ClearTiles();
+
+  /**@brief Move the leaves of all the map tiles by the offset, for a new
+   * origin of the target frame. */
+  void ShiftTiles(const Eigen::Vector3d &offset);
+
+  /**@brief Get the means of all the leaves of the map tiles. */
+  void GetTileCentroids(PointCloud *centroids) const;
+
  protected:
   /**@brief Minimum points contained with in a voxel to allow it to be useable.
    */
@@ -273,6 +312,44 @@ class VoxelGridCovariance {
 
   /**@brief Left top corner. */
   Eigen::Vector3d map_left_top_corner_;
+
+  /**@brief Leaves of a map tile, and the voxels they are hashed in. */
+  struct Tile {
+    std::vector<Leaf> leaves;
+    std::vector<std::pair<int64_t, LeafConstPtr>> voxels;
+  };
+
+  /**@brief The map tiles, in the frame of the target. */
+  std::map<TileIndex, Tile> tiles_;
+
+  /**@brief Leaves of the map tiles with sufficient points, hashed by the
+   * voxel containing their mean (used for searching). */
+  std::unordered_map<int64_t, std::vector<LeafConstPtr>> tile_voxels_;
+
+  /**@brief Origin of the voxels of tile_voxels_, follows ShiftTiles(). */
+  Eigen::Vector3d tile_voxel_origin_;
+
+  /**@brief Voxel coordinates of a point in tile_voxels_. */
+  inline Eigen::Vector3i GetTileVoxel(const Eigen::Vector3d &point) const {
+    const Eigen::Vector3d local = point - tile_voxel_origin_;
+    return Eigen::Vector3i(
+        static_cast<int>(std::floor(local(0) * inverse_leaf_size_[0])),
+        static_cast<int>(std::floor(local(1) * inverse_leaf_size_[1])),
+        static_cast<int>(std::floor(local(2) * inverse_leaf_size_[2])));
+  }
+
+  /**@brief Key of voxel coordinates in tile_voxels_, 21 bits per axis. */
+  static inline int64_t GetTileVoxelKey(const Eigen::Vector3i &voxel) {
+    const int64_t mask = (1 << 21) - 1;
+    return ((voxel(0) & mask) << 42) | ((voxel(1) & mask) << 21) |
+           (voxel(2) & mask);
+  }
+
+  /**@brief Hash the leaves of a map tile into tile_voxels_. */
+  void InsertTileVoxels(Tile *tile);
+
+  /**@brief Hash all the map tiles again, after the voxel size changed. */
+  void RebuildTileVoxels();
 };
 
 }  // namespace ndt
@@ -54,7 +54,9 @@
 #include <pcl/filters/boost.h>
 #include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "modules/localization/ndt/ndt_locator/ndt_voxel_grid_covariance.h"
@@ -143,17 +145,62 @@ int VoxelGridCovariance<PointT>::RadiusSearch(
     const PointT& point, double radius, std::vector<LeafConstPtr>* k_leaves,
     std::vector<float>* k_sqr_distances, unsigned int max_nn) {
   k_leaves->clear();
+  k_sqr_distances->clear();
+
+  if (!tiles_.empty()) {
+    // Check the leaves hashed in the voxels overlapping the search sphere
+    const Eigen::Vector3d query(point.x, point.y, point.z);
+    const Eigen::Vector3d extent = Eigen::Vector3d::Constant(radius);
+    const Eigen::Vector3i min_voxel = GetTileVoxel(query - extent);
+    const Eigen::Vector3i max_voxel = GetTileVoxel(query + extent);
+    const double sqr_radius = radius * radius;
+    std::vector<std::pair<float, LeafConstPtr>> neighbors;
+    Eigen::Vector3i voxel;
+    for (voxel(2) = min_voxel(2); voxel(2) <= max_voxel(2); ++voxel(2)) {
+      for (voxel(1) = min_voxel(1); voxel(1) <= max_voxel(1); ++voxel(1)) {
+        for (voxel(0) = min_voxel(0); voxel(0) <= max_voxel(0); ++voxel(0)) {
+          auto voxel_iter = tile_voxels_.find(GetTileVoxelKey(voxel));
+          if (voxel_iter == tile_voxels_.end()) {
+            continue;
+          }
+          for (LeafConstPtr leaf : voxel_iter->second) {
+            const double sqr_distance = (leaf->mean_ - query).squaredNorm();
+            if (sqr_distance <= sqr_radius) {
+              neighbors.emplace_back(static_cast<float>(sqr_distance), leaf);
+            }
+          }
+        }
+      }
+    }
+    if (max_nn > 0 && neighbors.size() > max_nn) {
+      std::partial_sort(neighbors.begin(), neighbors.begin() + max_nn,
+                        neighbors.end());
+      neighbors.resize(max_nn);
+    }
+    k_leaves->reserve(neighbors.size());
+    k_sqr_distances->reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+      k_sqr_distances->push_back(neighbor.first);
+      k_leaves->push_back(neighbor.second);
+    }
+    return static_cast<int>(neighbors.size());
+  }
+
+  if (!voxel_centroids_ || voxel_centroids_->empty()) {
+    return 0;
+  }
 
   // Find neighbors within radius in the occupied voxel centroid cloud
   std::vector<int> k_indices;
   int k =
       kdtree_.radiusSearch(point, radius, k_indices, *k_sqr_distances, max_nn);
 
-  // Find leaves corresponding to neighbors
+  // Find leaves corresponding to neighbors, without operator[] so that it can
+  // be called from several threads at once
   k_leaves->reserve(k);
   for (std::vector<int>::iterator iter = k_indices.begin();
        iter != k_indices.end(); iter++) {
-    k_leaves->push_back(&leaves_[voxel_centroids_leaf_indices_[*iter]]);
+    k_leaves->push_back(&leaves_.at(voxel_centroids_leaf_indices_[*iter]));
   }
   return k;
 }
@@ -176,13 +223,20 @@ void VoxelGridCovariance<PointT>::GetDisplayCloud(
   Eigen::Vector3d dist_point;
 
   // Generate points for each occupied voxel with sufficient points.
+  std::vector<LeafConstPtr> display_leaves;
   for (typename std::map<size_t, Leaf>::iterator it = leaves_.begin();
        it != leaves_.end(); ++it) {
-    Leaf& leaf = it->second;
-
-    if (leaf.nr_points_ >= min_points_per_voxel_) {
-      cell_mean = leaf.mean_;
-      Eigen::Matrix3d cov = leaf.icov_.inverse();
+    display_leaves.push_back(&it->second);
+  }
+  for (const auto& tile : tiles_) {
+    for (const Leaf& leaf : tile.second.leaves) {
+      display_leaves.push_back(&leaf);
+    }
+  }
+  for (LeafConstPtr leaf : display_leaves) {
+    if (leaf->nr_points_ >= min_points_per_voxel_) {
+      cell_mean = leaf->mean_;
+      Eigen::Matrix3d cov = leaf->icov_.inverse();
       llt_of_cov.compute(cov);
       cholesky_decomp = llt_of_cov.matrixL();
 
@@ -199,6 +253,98 @@ void VoxelGridCovariance<PointT>::GetDisplayCloud(
   }
 }
 
+template <typename PointT>
+void VoxelGridCovariance<PointT>::GetTileIndices(
+    std::vector<TileIndex>* indices) const {
+  indices->clear();
+  indices->reserve(tiles_.size());
+  for (const auto& tile : tiles_) {
+    indices->push_back(tile.first);
+  }
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::AddTile(const TileIndex& index,
+                                          std::vector<Leaf>* leaves) {
+  RemoveTile(index);
+  // Node based map, the leaves keep their address while other tiles change
+  Tile& tile = tiles_[index];
+  tile.leaves.swap(*leaves);
+  InsertTileVoxels(&tile);
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::RemoveTile(const TileIndex& index) {
+  auto tile_iter = tiles_.find(index);
+  if (tile_iter == tiles_.end()) {
+    return;
+  }
+  for (const auto& voxel : tile_iter->second.voxels) {
+    auto voxel_iter = tile_voxels_.find(voxel.first);
+    if (voxel_iter == tile_voxels_.end()) {
+      continue;
+    }
+    std::vector<LeafConstPtr>& voxel_leaves = voxel_iter->second;
+    voxel_leaves.erase(
+        std::remove(voxel_leaves.begin(), voxel_leaves.end(), voxel.second),
+        voxel_leaves.end());
+    if (voxel_leaves.empty()) {
+      tile_voxels_.erase(voxel_iter);
+    }
+  }
+  tiles_.erase(tile_iter);
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::ClearTiles() {
+  tiles_.clear();
+  tile_voxels_.clear();
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::ShiftTiles(const Eigen::Vector3d& offset) {
+  for (auto& tile : tiles_) {
+    for (Leaf& leaf : tile.second.leaves) {
+      leaf.mean_ += offset;
+    }
+  }
+  tile_voxel_origin_ += offset;
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::GetTileCentroids(
+    PointCloud* centroids) const {
+  centroids->clear();
+  for (const auto& tile : tiles_) {
+    for (const Leaf& leaf : tile.second.leaves) {
+      centroids->push_back(PointT());
+      centroids->points.back().x = static_cast<float>(leaf.mean_[0]);
+      centroids->points.back().y = static_cast<float>(leaf.mean_[1]);
+      centroids->points.back().z = static_cast<float>(leaf.mean_[2]);
+    }
+  }
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::InsertTileVoxels(Tile* tile) {
+  tile->voxels.clear();
+  for (const Leaf& leaf : tile->leaves) {
+    if (leaf.nr_points_ >= min_points_per_voxel_) {
+      const int64_t key = GetTileVoxelKey(GetTileVoxel(leaf.mean_));
+      tile_voxels_[key].push_back(&leaf);
+      tile->voxels.emplace_back(key, &leaf);
+    }
+  }
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::RebuildTileVoxels() {
+  tile_voxels_.clear();
+  for (auto& tile : tiles_) {
+    InsertTileVoxels(&tile.second);
+  }
+}
+
 }  // namespace ndt
 }  // namespace localization
 }  // namespace apollo
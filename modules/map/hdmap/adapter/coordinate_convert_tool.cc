@@ -20,8 +20,39 @@ namespace apollo {
 namespace hdmap {
 namespace adapter {
 
+namespace {
+
+// proj.4 projections are not to be used by several threads at once, every
+// thread converts with its own copies in its own context.
+struct ThreadProjections {
+  int version = -1;
+  projCtx ctx = nullptr;
+  projPJ pj_from = nullptr;
+  projPJ pj_to = nullptr;
+
+  ~ThreadProjections() { Free(); }
+
+  void Free() {
+    if (pj_from) {
+      pj_free(pj_from);
+      pj_from = nullptr;
+    }
+    if (pj_to) {
+      pj_free(pj_to);
+      pj_to = nullptr;
+    }
+    if (ctx) {
+      pj_ctx_free(ctx);
+      ctx = nullptr;
+    }
+    version = -1;
+  }
+};
+
+}  // namespace
+
 CoordinateConvertTool::CoordinateConvertTool()
-    : pj_from_(nullptr), pj_to_(nullptr) {}
+    : convert_param_version_(0), pj_from_(nullptr), pj_to_(nullptr) {}
 
 CoordinateConvertTool::~CoordinateConvertTool() {
   if (pj_from_) {
@@ -44,6 +75,7 @@ Status CoordinateConvertTool::SetConvertParam(const std::string& source_param,
                                               const std::string& dst_param) {
   source_convert_param_ = source_param;
   dst_convert_param_ = dst_param;
+  ++convert_param_version_;
   if (pj_from_) {
     pj_free(pj_from_);
     pj_from_ = nullptr;
@@ -82,23 +114,41 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
+  thread_local ThreadProjections projections;
+  const int version = convert_param_version_.load();
+  if (projections.version != version) {
+    projections.Free();
+    projections.ctx = pj_ctx_alloc();
+    projections.pj_from =
+        pj_init_plus_ctx(projections.ctx, source_convert_param_.c_str());
+    projections.pj_to =
+        pj_init_plus_ctx(projections.ctx, dst_convert_param_.c_str());
+    if (!projections.pj_from || !projections.pj_to) {
+      projections.Free();
+      std::string err_msg = "Fail to pj_init_plus " + source_convert_param_ +
+                            " or " + dst_convert_param_;
+      return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
+    }
+    projections.version = version;
+  }
+
   double gps_longitude = longitude;
   double gps_latitude = latitude;
   double gps_alt = height_ellipsoid;
 
-  if (pj_is_latlong(pj_from_)) {
+  if (pj_is_latlong(projections.pj_from)) {
     gps_longitude *= DEG_TO_RAD;
     gps_latitude *= DEG_TO_RAD;
     gps_alt = height_ellipsoid;
   }
 
-  if (0 != pj_transform(pj_from_, pj_to_, 1, 1, &gps_longitude, &gps_latitude,
-                        &gps_alt)) {
+  if (0 != pj_transform(projections.pj_from, projections.pj_to, 1, 1,
+                        &gps_longitude, &gps_latitude, &gps_alt)) {
     std::string err_msg = "fail to transform coordinate";
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
-  if (pj_is_latlong(pj_to_)) {
+  if (pj_is_latlong(projections.pj_to)) {
     gps_longitude *= RAD_TO_DEG;
     gps_latitude *= RAD_TO_DEG;
   }
@@ -15,6 +15,7 @@ limitations under the License.
 #pragma once
 
 #include <proj_api.h>
+#include <atomic>
 #include <string>
 
 #include "modules/map/hdmap/adapter/xml_parser/status.h"
@@ -41,6 +42,9 @@ class CoordinateConvertTool {
  private:
   std::string source_convert_param_;
   std::string dst_convert_param_;
+  // increased by every SetConvertParam, for the threads to renew their own
+  // projections
+  std::atomic<int> convert_param_version_;
 
   projPJ pj_from_;
   projPJ pj_to_;
@@ -32,6 +32,9 @@ class RoadsXmlParser {
                       std::vector<RoadInternal>* roads);
 
  private:
+  static Status ParseRoad(const tinyxml2::XMLElement& road_node,
+                          RoadInternal* road_internal);
+
   static void Parse_road_objects(const tinyxml2::XMLElement& xml_node,
                                  RoadInternal* road_info);
   static void Parse_road_signals(const tinyxml2::XMLElement& xml_node,
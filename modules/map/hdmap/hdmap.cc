@@ -166,6 +166,24 @@ int HDMap::GetLanesWithHeading(const apollo::common::PointENU& point,
                                    max_heading_difference, lanes);
 }
 
+int HDMap::BatchGetLanes(
+    const std::vector<apollo::common::math::Vec2d>& points,
+    const std::vector<double>& distances,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.BatchGetLanes(points, distances, lanes);
+}
+
+int HDMap::BatchGetNearestLanesWithHeading(
+    const std::vector<apollo::common::math::Vec2d>& points,
+    const double distance, const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  return impl_.BatchGetNearestLanesWithHeading(
+      points, distance, central_headings, max_heading_difference,
+      nearest_lanes, nearest_s, nearest_l);
+}
+
 int HDMap::GetRoadBoundaries(
     const apollo::common::PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
@@ -221,6 +221,34 @@ class HDMap {
                           const double distance, const double central_heading,
                           const double max_heading_difference,
                           std::vector<LaneInfoConstPtr>* lanes) const;
+  /**
+   * @brief get all lanes in range of a batch of points. Nearby queries share
+   * one KD-tree traversal and the result buffers are reused.
+   * @param points the central points
+   * @param distances the search radius of every point
+   * @param lanes lanes of every point, resized to the number of points
+   * @return 0:success, otherwise failed
+   */
+  int BatchGetLanes(const std::vector<apollo::common::math::Vec2d>& points,
+                    const std::vector<double>& distances,
+                    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief GetNearestLaneWithHeading for a batch of points
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of every point
+   * @param max_heading_difference the heading range
+   * @param nearest_lanes the nearest lane of every point, nullptr if none
+   * @param nearest_s the offset from lane start point along lane center line
+   * @param nearest_l the lateral offset from lane center line
+   * @return 0:success, otherwise, failed.
+   */
+  int BatchGetNearestLanesWithHeading(
+      const std::vector<apollo::common::math::Vec2d>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<LaneInfoConstPtr>* nearest_lanes,
+      std::vector<double>* nearest_s, std::vector<double>* nearest_l) const;
   /**
    * @brief get all road and junctions boundaries within certain range
    * @param point the target position
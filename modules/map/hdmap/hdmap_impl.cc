@@ -15,11 +15,21 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap_impl.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <limits>
 #include <set>
+#include <tuple>
 #include <unordered_set>
 
+#include "google/protobuf/io/coded_stream.h"
+
 #include "cyber/common/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
@@ -42,6 +52,45 @@ Id CreateHDMapId(const std::string& string_id) {
 constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
 constexpr int kBackwardDistance = 4;
+// grid cell size grouping the queries of a batch search
+constexpr double kBatchCellSize = 20.0;
+// max number of queries sharing one KD-tree traversal
+constexpr size_t kMaxBatchGroupSize = 64;
+
+// Parse a binary map straight from an mmap'ed file. The pages come from the
+// page cache shared by every process loading the same map, and no stream
+// buffer copy of the file is made.
+bool GetMapFromMappedFile(const std::string& map_filename, Map* map) {
+  const int fd = open(map_filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Open file failed, file: " << map_filename
+           << ", errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0 || file_stat.st_size <= 0 ||
+      file_stat.st_size > INT_MAX) {
+    AERROR << "Stat file failed or bad file size, file: " << map_filename;
+    close(fd);
+    return false;
+  }
+  const int size = static_cast<int>(file_stat.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    AERROR << "Mmap file failed, file: " << map_filename
+           << ", errno: " << errno;
+    return false;
+  }
+  madvise(addr, size, MADV_SEQUENTIAL);
+  google::protobuf::io::CodedInputStream coded_input(
+      static_cast<const uint8_t*>(addr), size);
+  // maps are often larger than the default 64MB limit
+  coded_input.SetTotalBytesLimit(INT_MAX, INT_MAX);
+  const bool ret = map->ParseFromCodedStream(&coded_input);
+  munmap(addr, size);
+  return ret;
+}
 
 }  // namespace
 
@@ -53,6 +102,9 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
     if (!adapter::OpendriveAdapter::LoadData(map_filename, &map_)) {
       return -1;
     }
+  } else if (apollo::common::util::EndWith(map_filename, ".bin") &&
+             GetMapFromMappedFile(map_filename, &map_)) {
+    AINFO << "Load binary map from mmap'ed file: " << map_filename;
   } else if (!cyber::common::GetProtoFromFile(map_filename, &map_)) {
     return -1;
   }
@@ -607,6 +659,151 @@ int HDMapImpl::GetLanesWithHeading(const Vec2d& point, const double distance,
   return 0;
 }
 
+int HDMapImpl::BatchGetLanes(
+    const std::vector<Vec2d>& points, const std::vector<double>& distances,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  if (lanes == nullptr || lane_segment_kdtree_ == nullptr ||
+      points.size() != distances.size()) {
+    return -1;
+  }
+  lanes->resize(points.size());
+  BatchSearchLanes(points, distances,
+                   [this, lanes](size_t index,
+                                 const std::vector<const LaneInfo*>& infos) {
+                     auto& result = (*lanes)[index];
+                     result.clear();
+                     for (const auto* info : infos) {
+                       result.push_back(lane_table_.at(info->id().id()));
+                     }
+                   });
+  return 0;
+}
+
+int HDMapImpl::BatchGetNearestLanesWithHeading(
+    const std::vector<Vec2d>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  if (lane_segment_kdtree_ == nullptr ||
+      points.size() != central_headings.size()) {
+    return -1;
+  }
+  nearest_lanes->assign(points.size(), nullptr);
+  nearest_s->assign(points.size(), 0.0);
+  nearest_l->assign(points.size(), 0.0);
+  const std::vector<double> distances(points.size(), distance);
+  // same selection as GetNearestLaneWithHeading, with one DistanceTo per lane
+  BatchSearchLanes(
+      points, distances,
+      [&](size_t index, const std::vector<const LaneInfo*>& infos) {
+        const Vec2d& point = points[index];
+        const LaneInfo* nearest = nullptr;
+        double min_distance = distance;
+        double s = 0.0;
+        int s_index = 0;
+        for (const auto* lane : infos) {
+          Vec2d map_point;
+          double s_offset = 0.0;
+          int s_offset_index = 0;
+          const double lane_distance =
+              lane->DistanceTo(point, &map_point, &s_offset, &s_offset_index);
+          if (lane_distance >= min_distance) {
+            continue;
+          }
+          const double heading_diff =
+              fabs(lane->headings()[s_offset_index] - central_headings[index]);
+          if (fabs(apollo::common::math::NormalizeAngle(heading_diff)) >
+              max_heading_difference) {
+            continue;
+          }
+          min_distance = lane_distance;
+          nearest = lane;
+          s = s_offset;
+          s_index = s_offset_index;
+        }
+        if (nearest == nullptr) {
+          return;
+        }
+        (*nearest_lanes)[index] = lane_table_.at(nearest->id().id());
+        (*nearest_s)[index] = s;
+        const int segment_index = static_cast<int>(std::min(
+            static_cast<size_t>(s_index), nearest->segments().size() - 1));
+        const auto& segment_2d = nearest->segments()[segment_index];
+        (*nearest_l)[index] =
+            segment_2d.unit_direction().CrossProd(point - segment_2d.start());
+      });
+  return 0;
+}
+
+template <class Visitor>
+void HDMapImpl::BatchSearchLanes(const std::vector<Vec2d>& points,
+                                 const std::vector<double>& distances,
+                                 const Visitor& visit) const {
+  // sort the queries by grid cell so that neighbors are adjacent
+  std::vector<std::tuple<int, int, size_t>> order;
+  order.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    order.emplace_back(static_cast<int>(std::floor(points[i].x() /
+                                                   kBatchCellSize)),
+                       static_cast<int>(std::floor(points[i].y() /
+                                                   kBatchCellSize)),
+                       i);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<const LaneSegmentBox*> candidates;
+  std::vector<const LaneInfo*> infos;
+  size_t begin = 0;
+  while (begin < order.size()) {
+    size_t end = begin + 1;
+    while (end < order.size() && end - begin < kMaxBatchGroupSize &&
+           std::get<0>(order[end]) == std::get<0>(order[begin]) &&
+           std::get<1>(order[end]) == std::get<1>(order[begin])) {
+      ++end;
+    }
+    // one traversal with a circle covering the circles of the group
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+    for (size_t k = begin; k < end; ++k) {
+      const Vec2d& point = points[std::get<2>(order[k])];
+      min_x = std::min(min_x, point.x());
+      min_y = std::min(min_y, point.y());
+      max_x = std::max(max_x, point.x());
+      max_y = std::max(max_y, point.y());
+    }
+    const Vec2d center((min_x + max_x) / 2.0, (min_y + max_y) / 2.0);
+    double radius = 0.0;
+    for (size_t k = begin; k < end; ++k) {
+      const size_t index = std::get<2>(order[k]);
+      radius = std::max(radius,
+                        center.DistanceTo(points[index]) + distances[index]);
+    }
+    candidates.clear();
+    lane_segment_kdtree_->GetObjects(center, radius, &candidates);
+
+    for (size_t k = begin; k < end; ++k) {
+      const size_t index = std::get<2>(order[k]);
+      const double distance_sqr = distances[index] * distances[index];
+      infos.clear();
+      for (const auto* candidate : candidates) {
+        if (candidate->DistanceSquareTo(points[index]) <= distance_sqr) {
+          infos.push_back(candidate->object());
+        }
+      }
+      std::sort(infos.begin(), infos.end());
+      infos.erase(std::unique(infos.begin(), infos.end()), infos.end());
+      visit(index, infos);
+    }
+    begin = end;
+  }
+}
+
 int HDMapImpl::GetRoadBoundaries(
     const PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
@@ -14,6 +14,9 @@ limitations under the License.
 =========================================================================*/
 
 #include "modules/map/hdmap/hdmap_impl.h"
+
+#include <set>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 
@@ -177,6 +180,58 @@ TEST_F(HDMapImplTestSuite, GetNearestLaneWithHeading) {
   EXPECT_NEAR(nearest_s, 25.891, 1E-3);
 }
 
+TEST_F(HDMapImplTestSuite, BatchQueries) {
+  std::vector<apollo::common::math::Vec2d> points;
+  std::vector<double> distances;
+  std::vector<double> headings;
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      points.emplace_back(586424.09 + 5.0 * (i - 10), 4140727.02 + 5.0 * j);
+      distances.push_back(1.0 + (i + j) % 5);
+      headings.push_back(-2.35 + 0.1 * (i % 3));
+    }
+  }
+
+  std::vector<std::vector<LaneInfoConstPtr>> batch_lanes;
+  ASSERT_EQ(0, hdmap_impl_.BatchGetLanes(points, distances, &batch_lanes));
+  ASSERT_EQ(points.size(), batch_lanes.size());
+  std::vector<LaneInfoConstPtr> nearest_lanes;
+  std::vector<double> nearest_s;
+  std::vector<double> nearest_l;
+  ASSERT_EQ(0, hdmap_impl_.BatchGetNearestLanesWithHeading(
+                   points, 5.0, headings, 1.0, &nearest_lanes, &nearest_s,
+                   &nearest_l));
+  for (size_t i = 0; i < points.size(); ++i) {
+    apollo::common::PointENU point;
+    point.set_x(points[i].x());
+    point.set_y(points[i].y());
+    std::vector<LaneInfoConstPtr> lanes;
+    ASSERT_EQ(0, hdmap_impl_.GetLanes(point, distances[i], &lanes));
+    std::set<std::string> ids;
+    std::set<std::string> batch_ids;
+    for (const auto& lane : lanes) {
+      ids.insert(lane->id().id());
+    }
+    for (const auto& lane : batch_lanes[i]) {
+      batch_ids.insert(lane->id().id());
+    }
+    EXPECT_EQ(ids, batch_ids);
+
+    LaneInfoConstPtr nearest_lane;
+    double s = 0.0;
+    double l = 0.0;
+    if (hdmap_impl_.GetNearestLaneWithHeading(point, 5.0, headings[i], 1.0,
+                                              &nearest_lane, &s, &l) == 0) {
+      ASSERT_TRUE(nearest_lanes[i] != nullptr);
+      EXPECT_EQ(nearest_lane->id().id(), nearest_lanes[i]->id().id());
+      EXPECT_DOUBLE_EQ(s, nearest_s[i]);
+      EXPECT_DOUBLE_EQ(l, nearest_l[i]);
+    } else {
+      EXPECT_TRUE(nearest_lanes[i] == nullptr);
+    }
+  }
+}
+
 TEST_F(HDMapImplTestSuite, GetLanesWithHeading) {
   apollo::common::PointENU point;
   point.set_x(586424.09);
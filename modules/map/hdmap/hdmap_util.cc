@@ -15,6 +15,7 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_util.h"
 
 #include "cyber/common/file.h"
+#include "cyber/task/task.h"
 #include "modules/common/util/string_tokenizer.h"
 #include "modules/map/relative_map/proto/navigation.pb.h"
 
@@ -88,27 +89,40 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
   return hdmap;
 }
 
-std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::base_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::retired_base_map_ = nullptr;
+std::atomic<uint64_t> HDMapUtil::base_map_version_ = {0};
 uint64_t HDMapUtil::base_map_seq_ = 0;
 std::mutex HDMapUtil::base_map_mutex_;
 
-std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::sim_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::retired_sim_map_ = nullptr;
 std::mutex HDMapUtil::sim_map_mutex_;
 
+void HDMapUtil::PublishBaseMap(std::shared_ptr<const HDMap> base_map) {
+  // the caller holds base_map_mutex_
+  retired_base_map_ = std::atomic_load(&base_map_);
+  std::atomic_store(&base_map_, std::move(base_map));
+  base_map_version_.fetch_add(1, std::memory_order_release);
+}
+
 const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
   std::lock_guard<std::mutex> lock(base_map_mutex_);
-  if (base_map_ != nullptr &&
+  auto base_map = std::atomic_load(&base_map_);
+  if (base_map != nullptr &&
       base_map_seq_ == map_msg.header().sequence_num()) {
     // avoid re-create map in the same cycle.
-    return base_map_.get();
-  } else {
-    base_map_ = CreateMap(map_msg);
-    base_map_seq_ = map_msg.header().sequence_num();
+    return base_map.get();
   }
-  return base_map_.get();
+  base_map = CreateMap(map_msg);
+  base_map_seq_ = map_msg.header().sequence_num();
+  PublishBaseMap(base_map);
+  return base_map.get();
 }
 
-const HDMap* HDMapUtil::BaseMapPtr() {
+const HDMap* HDMapUtil::BaseMapPtr() { return BaseMapSnapshot().get(); }
+
+std::shared_ptr<const HDMap> HDMapUtil::BaseMapSnapshot() {
   // TODO(all) Those logics should be removed to planning
   /*if (FLAGS_use_navigation_mode) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
@@ -131,13 +145,22 @@ const HDMap* HDMapUtil::BaseMapPtr() {
       base_map_seq_ = latest.header().sequence_num();
     }
   } else*/
-  if (base_map_ == nullptr) {
+  auto base_map = std::atomic_load(&base_map_);
+  if (base_map == nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    if (base_map_ == nullptr) {  // Double check.
-      base_map_ = CreateMap(BaseMapFile());
+    base_map = std::atomic_load(&base_map_);
+    if (base_map == nullptr) {  // Double check.
+      base_map = CreateMap(BaseMapFile());
+      if (base_map != nullptr) {
+        PublishBaseMap(base_map);
+      }
     }
   }
-  return base_map_.get();
+  return base_map;
+}
+
+uint64_t HDMapUtil::BaseMapVersion() {
+  return base_map_version_.load(std::memory_order_acquire);
 }
 
 const HDMap& HDMapUtil::BaseMap() { return *CHECK_NOTNULL(BaseMapPtr()); }
@@ -145,27 +168,48 @@ const HDMap& HDMapUtil::BaseMap() { return *CHECK_NOTNULL(BaseMapPtr()); }
 const HDMap* HDMapUtil::SimMapPtr() {
   if (FLAGS_use_navigation_mode) {
     return BaseMapPtr();
-  } else if (sim_map_ == nullptr) {
+  }
+  auto sim_map = std::atomic_load(&sim_map_);
+  if (sim_map == nullptr) {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
-    if (sim_map_ == nullptr) {  // Double check.
-      sim_map_ = CreateMap(SimMapFile());
+    sim_map = std::atomic_load(&sim_map_);
+    if (sim_map == nullptr) {  // Double check.
+      sim_map = CreateMap(SimMapFile());
+      std::atomic_store(&sim_map_, sim_map);
     }
   }
-  return sim_map_.get();
+  return sim_map.get();
 }
 
 const HDMap& HDMapUtil::SimMap() { return *CHECK_NOTNULL(SimMapPtr()); }
 
 bool HDMapUtil::ReloadMaps() {
+  bool success = true;
   {
+    // loaded and indexed before the swap, readers keep the old map
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    base_map_ = CreateMap(BaseMapFile());
+    std::shared_ptr<const HDMap> base_map = CreateMap(BaseMapFile());
+    if (base_map != nullptr) {
+      PublishBaseMap(std::move(base_map));
+    } else {
+      success = false;
+    }
   }
   {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
-    sim_map_ = CreateMap(SimMapFile());
+    std::shared_ptr<const HDMap> sim_map = CreateMap(SimMapFile());
+    if (sim_map != nullptr) {
+      retired_sim_map_ = std::atomic_load(&sim_map_);
+      std::atomic_store(&sim_map_, std::move(sim_map));
+    } else {
+      success = false;
+    }
   }
-  return base_map_ != nullptr && sim_map_ != nullptr;
+  return success;
+}
+
+std::future<bool> HDMapUtil::ReloadMapsAsync() {
+  return cyber::Async(&HDMapUtil::ReloadMaps);
 }
 
 }  // namespace hdmap
@@ -15,7 +15,10 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "modules/common/configs/config_gflags.h"
@@ -76,11 +79,19 @@ inline apollo::hdmap::Id MakeMapId(const std::string& id) {
 
 std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path);
 
+// Maps are immutable snapshots published by an atomic shared_ptr swap, so
+// readers never wait for a reload. A raw pointer from BaseMapPtr() stays
+// valid across one reload; pin a snapshot to hold a map for longer.
 class HDMapUtil {
  public:
   // Get default base map from the file specified by global flags.
   // Return nullptr if failed to load.
   static const HDMap* BaseMapPtr();
+  // Pin the current base map, e.g. for a planning cycle.
+  // Return nullptr if failed to load.
+  static std::shared_ptr<const HDMap> BaseMapSnapshot();
+  // Increased every time a new base map is published.
+  static uint64_t BaseMapVersion();
   static const HDMap* BaseMapPtr(const relative_map::MapMsg& map_msg);
   // Guarantee to return a valid base_map, or else raise fatal error.
   static const HDMap& BaseMap();
@@ -92,17 +103,28 @@ class HDMapUtil {
   // Guarantee to return a valid sim_map, or else raise fatal error.
   static const HDMap& SimMap();
 
-  // Reload maps from the file specified by global flags.
+  // Reload maps from the file specified by global flags. The current maps
+  // keep serving queries until the new ones are loaded, and are kept if
+  // loading fails.
   static bool ReloadMaps();
+  // ReloadMaps() in a background task.
+  static std::future<bool> ReloadMapsAsync();
 
  private:
   HDMapUtil() = delete;
 
-  static std::unique_ptr<HDMap> base_map_;
+  static void PublishBaseMap(std::shared_ptr<const HDMap> base_map);
+
+  // accessed with std::atomic_load/atomic_store, the mutexes only serialize
+  // the loaders
+  static std::shared_ptr<const HDMap> base_map_;
+  static std::shared_ptr<const HDMap> retired_base_map_;
+  static std::atomic<uint64_t> base_map_version_;
   static uint64_t base_map_seq_;
   static std::mutex base_map_mutex_;
 
-  static std::unique_ptr<HDMap> sim_map_;
+  static std::shared_ptr<const HDMap> sim_map_;
+  static std::shared_ptr<const HDMap> retired_sim_map_;
   static std::mutex sim_map_mutex_;
 };
 
@@ -80,5 +80,29 @@ void HDMapUtilTestSuite::InitMapProto(Map* map_proto) {
 //  EXPECT_NE(hdmap2, hdmap1);  // hdmap should be updated.
 //}
 
+TEST_F(HDMapUtilTestSuite, SnapshotSurvivesNewMap) {
+  relative_map::MapMsg map_msg;
+  InitMapProto(map_msg.mutable_hdmap());
+  map_msg.mutable_header()->set_sequence_num(1);
+  const auto* hdmap1 = HDMapUtil::BaseMapPtr(map_msg);
+  ASSERT_TRUE(hdmap1 != nullptr);
+  auto snapshot = HDMapUtil::BaseMapSnapshot();
+  EXPECT_EQ(hdmap1, snapshot.get());
+  const uint64_t version = HDMapUtil::BaseMapVersion();
+
+  // same cycle, no new map
+  EXPECT_EQ(hdmap1, HDMapUtil::BaseMapPtr(map_msg));
+  EXPECT_EQ(version, HDMapUtil::BaseMapVersion());
+
+  map_msg.mutable_header()->set_sequence_num(2);
+  const auto* hdmap2 = HDMapUtil::BaseMapPtr(map_msg);
+  ASSERT_TRUE(hdmap2 != nullptr);
+  EXPECT_NE(hdmap1, hdmap2);
+  EXPECT_EQ(version + 1, HDMapUtil::BaseMapVersion());
+  EXPECT_EQ(hdmap2, HDMapUtil::BaseMapSnapshot().get());
+  // the pinned snapshot is still usable
+  EXPECT_TRUE(snapshot->GetLaneById(MakeMapId("lane_1")) != nullptr);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
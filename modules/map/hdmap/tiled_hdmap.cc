@@ -0,0 +1,412 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_hdmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "cyber/common/file.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+
+std::string TileFilename(int x, int y) {
+  return "tile_" + std::to_string(x) + "_" + std::to_string(y) + ".bin";
+}
+
+// keep only the lanes of the tile in the road sections, a road section
+// referring to a missing lane fails the map loading
+void PruneRoadLanes(const std::unordered_set<std::string>& lane_ids,
+                    Map* tile_map) {
+  for (auto& road : *tile_map->mutable_road()) {
+    for (auto& section : *road.mutable_section()) {
+      auto* section_lanes = section.mutable_lane_id();
+      auto end = std::remove_if(section_lanes->begin(), section_lanes->end(),
+                                [&lane_ids](const Id& id) {
+                                  return lane_ids.count(id.id()) == 0;
+                                });
+      section_lanes->DeleteSubrange(
+          static_cast<int>(end - section_lanes->begin()),
+          static_cast<int>(section_lanes->end() - end));
+    }
+  }
+}
+
+}  // namespace
+
+constexpr char TiledHDMap::kIndexFilename[];
+
+int TiledHDMap::BuildTiles(const Map& map, double tile_size, double margin,
+                           const std::string& output_dir) {
+  if (tile_size <= 0.0 || margin < 0.0) {
+    AERROR << "Invalid tile size " << tile_size << " or margin " << margin;
+    return -1;
+  }
+  HDMapImpl full_map;
+  if (full_map.LoadMapFromProto(map) != 0) {
+    return -1;
+  }
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto& lane : map.lane()) {
+    for (const auto& segment : lane.central_curve().segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        min_x = std::min(min_x, point.x());
+        min_y = std::min(min_y, point.y());
+        max_x = std::max(max_x, point.x());
+        max_y = std::max(max_y, point.y());
+      }
+    }
+  }
+  if (min_x > max_x) {
+    AERROR << "No lane in map.";
+    return -1;
+  }
+
+  MapTileIndex index;
+  index.set_grid_size(tile_size);
+  index.set_margin(margin);
+  // a circle of this radius around the tile center covers tile and margin
+  const double radius = tile_size * std::sqrt(0.5) + margin;
+  const int min_tx = static_cast<int>(std::floor((min_x - margin) / tile_size));
+  const int min_ty = static_cast<int>(std::floor((min_y - margin) / tile_size));
+  const int max_tx = static_cast<int>(std::floor((max_x + margin) / tile_size));
+  const int max_ty = static_cast<int>(std::floor((max_y + margin) / tile_size));
+  for (int tx = min_tx; tx <= max_tx; ++tx) {
+    for (int ty = min_ty; ty <= max_ty; ++ty) {
+      PointENU center;
+      center.set_x((tx + 0.5) * tile_size);
+      center.set_y((ty + 0.5) * tile_size);
+      Map tile_map;
+      if (full_map.GetLocalMap(center, {radius, radius}, &tile_map) != 0) {
+        return -1;
+      }
+      if (tile_map.lane_size() == 0 && tile_map.junction_size() == 0) {
+        continue;
+      }
+      *tile_map.mutable_header() = map.header();
+      auto* tile = index.add_tile();
+      tile->set_x(tx);
+      tile->set_y(ty);
+      tile->set_filename(TileFilename(tx, ty));
+      std::unordered_set<std::string> lane_ids;
+      for (const auto& lane : tile_map.lane()) {
+        lane_ids.insert(lane.id().id());
+        tile->add_lane_id(lane.id().id());
+      }
+      for (const auto& junction : tile_map.junction()) {
+        tile->add_junction_id(junction.id().id());
+      }
+      PruneRoadLanes(lane_ids, &tile_map);
+      const std::string tile_file =
+          cyber::common::GetAbsolutePath(output_dir, tile->filename());
+      if (!cyber::common::SetProtoToBinaryFile(tile_map, tile_file)) {
+        AERROR << "Failed to write tile " << tile_file;
+        return -1;
+      }
+    }
+  }
+  const std::string index_file =
+      cyber::common::GetAbsolutePath(output_dir, kIndexFilename);
+  if (!cyber::common::SetProtoToBinaryFile(index, index_file)) {
+    AERROR << "Failed to write tile index " << index_file;
+    return -1;
+  }
+  AINFO << "Split map into " << index.tile_size() << " tiles of " << tile_size
+        << "m.";
+  return 0;
+}
+
+TiledHDMap::TiledHDMap(size_t max_tiles)
+    : max_tiles_(std::max<size_t>(max_tiles, 1)) {}
+
+TiledHDMap::~TiledHDMap() {
+  for (auto& prefetch : prefetches_) {
+    prefetch.wait();
+  }
+}
+
+int TiledHDMap::LoadIndex(const std::string& tile_dir) {
+  const std::string index_file =
+      cyber::common::GetAbsolutePath(tile_dir, kIndexFilename);
+  if (!cyber::common::GetProtoFromFile(index_file, &index_)) {
+    AERROR << "Failed to load tile index " << index_file;
+    return -1;
+  }
+  if (index_.grid_size() <= 0.0) {
+    AERROR << "Invalid tile size " << index_.grid_size();
+    return -1;
+  }
+  tile_dir_ = tile_dir;
+  tile_files_.clear();
+  lane_tiles_.clear();
+  junction_tiles_.clear();
+  for (const auto& tile : index_.tile()) {
+    const TileKey key = MakeTileKey(tile.x(), tile.y());
+    tile_files_[key] =
+        cyber::common::GetAbsolutePath(tile_dir_, tile.filename());
+    for (const auto& lane_id : tile.lane_id()) {
+      lane_tiles_[lane_id].push_back(key);
+    }
+    for (const auto& junction_id : tile.junction_id()) {
+      junction_tiles_[junction_id].push_back(key);
+    }
+  }
+  return 0;
+}
+
+void TiledHDMap::Prefetch(const std::vector<PointENU>& points) {
+  prefetches_.erase(
+      std::remove_if(prefetches_.begin(), prefetches_.end(),
+                     [](const std::future<void>& prefetch) {
+                       return prefetch.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+                     }),
+      prefetches_.end());
+  std::vector<TileKey> keys;
+  for (const auto& point : points) {
+    for (const TileKey key : TileKeysAround(point, index_.margin())) {
+      if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+        keys.push_back(key);
+      }
+    }
+    if (keys.size() >= max_tiles_) {
+      break;
+    }
+  }
+  if (keys.size() > max_tiles_) {
+    keys.resize(max_tiles_);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    keys.erase(std::remove_if(keys.begin(), keys.end(),
+                              [this](TileKey key) {
+                                return tiles_.count(key) > 0 ||
+                                       loading_.count(key) > 0;
+                              }),
+               keys.end());
+  }
+  if (keys.empty()) {
+    return;
+  }
+  // load the farthest first, so the nearest tiles end up most recently used
+  std::reverse(keys.begin(), keys.end());
+  prefetches_.push_back(std::async(std::launch::async, [this, keys]() {
+    for (const TileKey key : keys) {
+      GetTile(key);
+    }
+  }));
+}
+
+LaneInfoConstPtr TiledHDMap::GetLaneById(const Id& id) const {
+  return GetById<LaneInfo>(lane_tiles_, id, &HDMapImpl::GetLaneById);
+}
+
+JunctionInfoConstPtr TiledHDMap::GetJunctionById(const Id& id) const {
+  return GetById<JunctionInfo>(junction_tiles_, id,
+                               &HDMapImpl::GetJunctionById);
+}
+
+template <class Info>
+std::shared_ptr<const Info> TiledHDMap::GetById(
+    const std::unordered_map<std::string, std::vector<TileKey>>& id_tiles,
+    const Id& id,
+    std::shared_ptr<const Info> (HDMapImpl::*get)(const Id&) const) const {
+  auto iter = id_tiles.find(id.id());
+  if (iter == id_tiles.end()) {
+    return nullptr;
+  }
+  // prefer a tile already in the cache
+  TilePtr tile = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const TileKey key : iter->second) {
+      auto tile_iter = tiles_.find(key);
+      if (tile_iter != tiles_.end()) {
+        tile = tile_iter->second.first;
+        break;
+      }
+    }
+  }
+  if (tile == nullptr) {
+    tile = GetTile(iter->second.front());
+  }
+  if (tile == nullptr) {
+    return nullptr;
+  }
+  auto info = ((*tile).*get)(id);
+  if (info == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<const Info>(tile, info.get());
+}
+
+int TiledHDMap::GetLanes(const PointENU& point, double distance,
+                         std::vector<LaneInfoConstPtr>* lanes) const {
+  if (lanes == nullptr) {
+    return -1;
+  }
+  lanes->clear();
+  std::unordered_set<std::string> lane_ids;
+  for (const TileKey key : TileKeysAround(point, distance)) {
+    TilePtr tile = GetTile(key);
+    if (tile == nullptr) {
+      continue;
+    }
+    std::vector<LaneInfoConstPtr> tile_lanes;
+    tile->GetLanes(point, distance, &tile_lanes);
+    for (const auto& lane : tile_lanes) {
+      if (lane_ids.insert(lane->id().id()).second) {
+        lanes->emplace_back(tile, lane.get());
+      }
+    }
+  }
+  return 0;
+}
+
+int TiledHDMap::GetJunctions(
+    const PointENU& point, double distance,
+    std::vector<JunctionInfoConstPtr>* junctions) const {
+  if (junctions == nullptr) {
+    return -1;
+  }
+  junctions->clear();
+  std::unordered_set<std::string> junction_ids;
+  for (const TileKey key : TileKeysAround(point, distance)) {
+    TilePtr tile = GetTile(key);
+    if (tile == nullptr) {
+      continue;
+    }
+    std::vector<JunctionInfoConstPtr> tile_junctions;
+    tile->GetJunctions(point, distance, &tile_junctions);
+    for (const auto& junction : tile_junctions) {
+      if (junction_ids.insert(junction->id().id()).second) {
+        junctions->emplace_back(tile, junction.get());
+      }
+    }
+  }
+  return 0;
+}
+
+int TiledHDMap::GetNearestLane(const PointENU& point,
+                               LaneInfoConstPtr* nearest_lane,
+                               double* nearest_s, double* nearest_l) const {
+  CHECK_NOTNULL(nearest_lane);
+  TilePtr tile = GetTile(TileKeyOf(point.x(), point.y()));
+  if (tile == nullptr) {
+    return -1;
+  }
+  LaneInfoConstPtr lane = nullptr;
+  if (tile->GetNearestLane(point, &lane, nearest_s, nearest_l) != 0) {
+    return -1;
+  }
+  *nearest_lane = LaneInfoConstPtr(tile, lane.get());
+  return 0;
+}
+
+size_t TiledHDMap::NumLoadedTiles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tiles_.size();
+}
+
+TiledHDMap::TileKey TiledHDMap::MakeTileKey(int x, int y) {
+  return (static_cast<TileKey>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint32_t>(y);
+}
+
+TiledHDMap::TileKey TiledHDMap::TileKeyOf(double x, double y) const {
+  const double tile_size = index_.grid_size();
+  return MakeTileKey(static_cast<int>(std::floor(x / tile_size)),
+                     static_cast<int>(std::floor(y / tile_size)));
+}
+
+std::vector<TiledHDMap::TileKey> TiledHDMap::TileKeysAround(
+    const PointENU& point, double distance) const {
+  std::vector<TileKey> keys;
+  // the tile of the point holds everything within its margin
+  if (distance <= index_.margin()) {
+    const TileKey key = TileKeyOf(point.x(), point.y());
+    if (tile_files_.count(key) > 0) {
+      keys.push_back(key);
+    }
+    return keys;
+  }
+  const double tile_size = index_.grid_size();
+  const int min_x = static_cast<int>(std::floor((point.x() - distance) /
+                                                tile_size));
+  const int max_x = static_cast<int>(std::floor((point.x() + distance) /
+                                                tile_size));
+  const int min_y = static_cast<int>(std::floor((point.y() - distance) /
+                                                tile_size));
+  const int max_y = static_cast<int>(std::floor((point.y() + distance) /
+                                                tile_size));
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      const TileKey key = MakeTileKey(x, y);
+      if (tile_files_.count(key) > 0) {
+        keys.push_back(key);
+      }
+    }
+  }
+  return keys;
+}
+
+TiledHDMap::TilePtr TiledHDMap::GetTile(TileKey key) const {
+  auto file_iter = tile_files_.find(key);
+  if (file_iter == tile_files_.end()) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  // another thread (e.g. prefetch) is loading it
+  loaded_cv_.wait(lock, [this, key]() { return loading_.count(key) == 0; });
+  auto iter = tiles_.find(key);
+  if (iter != tiles_.end()) {
+    lru_.splice(lru_.begin(), lru_, iter->second.second);
+    return iter->second.first;
+  }
+  loading_.insert(key);
+  lock.unlock();
+
+  std::shared_ptr<HDMapImpl> tile(new HDMapImpl());
+  if (tile->LoadMapFromFile(file_iter->second) != 0) {
+    AERROR << "Failed to load map tile " << file_iter->second;
+    tile = nullptr;
+  }
+
+  lock.lock();
+  loading_.erase(key);
+  if (tile != nullptr) {
+    lru_.push_front(key);
+    tiles_[key] = std::make_pair(tile, lru_.begin());
+    while (tiles_.size() > max_tiles_) {
+      tiles_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+  lock.unlock();
+  loaded_cv_.notify_all();
+  return tile;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/proto/map.pb.h"
+#include "modules/map/proto/map_tile.pb.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class TiledHDMap
+ *
+ * @brief High-precision map split into square tiles which are loaded on
+ * demand and evicted by LRU, so memory follows the working area instead of
+ * the whole map. Every tile keeps the elements within margin of its square,
+ * queries with a radius up to the margin are answered by a single tile.
+ * Returned pointers keep their tile alive after it is evicted.
+ */
+class TiledHDMap {
+ public:
+  static constexpr char kIndexFilename[] = "tile_index.bin";
+
+  /**
+   * @brief split a map into tiles and write them with the index to a dir
+   * @param map the whole map
+   * @param tile_size side length of a tile in meters
+   * @param margin extra border of every tile in meters
+   * @param output_dir directory of the tiles, must exist
+   * @return 0:success, otherwise failed
+   */
+  static int BuildTiles(const Map& map, double tile_size, double margin,
+                        const std::string& output_dir);
+
+  explicit TiledHDMap(size_t max_tiles = 16);
+  ~TiledHDMap();
+
+  /**
+   * @brief load the tile index written by BuildTiles, no tile is loaded
+   * @param tile_dir directory of the tiles
+   * @return 0:success, otherwise failed
+   */
+  int LoadIndex(const std::string& tile_dir);
+
+  /**
+   * @brief load the tiles around the points in background, e.g. the ego
+   * position and the route ahead. At most max_tiles tiles are prefetched.
+   */
+  void Prefetch(const std::vector<apollo::common::PointENU>& points);
+
+  LaneInfoConstPtr GetLaneById(const Id& id) const;
+  JunctionInfoConstPtr GetJunctionById(const Id& id) const;
+
+  int GetLanes(const apollo::common::PointENU& point, double distance,
+               std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetJunctions(const apollo::common::PointENU& point, double distance,
+                   std::vector<JunctionInfoConstPtr>* junctions) const;
+  /**
+   * @brief get the nearest lane within the tile of the target point
+   */
+  int GetNearestLane(const apollo::common::PointENU& point,
+                     LaneInfoConstPtr* nearest_lane, double* nearest_s,
+                     double* nearest_l) const;
+
+  size_t NumLoadedTiles() const;
+
+ private:
+  using TileKey = uint64_t;
+  using TilePtr = std::shared_ptr<const HDMapImpl>;
+
+  static TileKey MakeTileKey(int x, int y);
+  TileKey TileKeyOf(double x, double y) const;
+  // keys of the existing tiles overlapping the square around the point
+  std::vector<TileKey> TileKeysAround(const apollo::common::PointENU& point,
+                                      double distance) const;
+  // get a tile, load it if it is not in the cache
+  TilePtr GetTile(TileKey key) const;
+  template <class Info>
+  std::shared_ptr<const Info> GetById(
+      const std::unordered_map<std::string, std::vector<TileKey>>& id_tiles,
+      const Id& id,
+      std::shared_ptr<const Info> (HDMapImpl::*get)(const Id&) const) const;
+
+  const size_t max_tiles_;
+  std::string tile_dir_;
+  MapTileIndex index_;
+  std::unordered_map<TileKey, std::string> tile_files_;
+  std::unordered_map<std::string, std::vector<TileKey>> lane_tiles_;
+  std::unordered_map<std::string, std::vector<TileKey>> junction_tiles_;
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable loaded_cv_;
+  // most recently used first
+  mutable std::list<TileKey> lru_;
+  mutable std::unordered_map<TileKey,
+                             std::pair<TilePtr, std::list<TileKey>::iterator>>
+      tiles_;
+  mutable std::unordered_set<TileKey> loading_;
+  std::vector<std::future<void>> prefetches_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
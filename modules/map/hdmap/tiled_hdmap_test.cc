@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_hdmap.h"
+
+#include "cyber/common/file.h"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+constexpr char kTileDir[] = "/tmp/tiled_hdmap_test";
+constexpr int kNumLanes = 20;
+constexpr double kLaneLength = 100.0;
+
+// kNumLanes straight lanes along the x axis, all in one road section
+Map CreateMap() {
+  Map map;
+  auto* section = map.add_road()->add_section();
+  map.mutable_road(0)->mutable_id()->set_id("road_0");
+  section->mutable_id()->set_id("section_0");
+  for (int i = 0; i < kNumLanes; ++i) {
+    auto* lane = map.add_lane();
+    lane->mutable_id()->set_id("lane_" + std::to_string(i));
+    auto* line_segment =
+        lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int j = 0; j <= 10; ++j) {
+      auto* point = line_segment->add_point();
+      point->set_x(i * kLaneLength + j * kLaneLength / 10.0);
+      point->set_y(1.0);
+    }
+    lane->set_length(kLaneLength);
+    *section->add_lane_id() = lane->id();
+  }
+  return map;
+}
+
+apollo::common::PointENU MakePoint(double x, double y) {
+  apollo::common::PointENU point;
+  point.set_x(x);
+  point.set_y(y);
+  return point;
+}
+
+}  // namespace
+
+class TiledHDMapTestSuite : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ASSERT_TRUE(cyber::common::EnsureDirectory(kTileDir));
+    ASSERT_EQ(0, TiledHDMap::BuildTiles(CreateMap(), 500.0, 100.0, kTileDir));
+  }
+};
+
+TEST_F(TiledHDMapTestSuite, GetLanes) {
+  TiledHDMap tiled_map(4);
+  ASSERT_EQ(0, tiled_map.LoadIndex(kTileDir));
+  EXPECT_EQ(0, tiled_map.NumLoadedTiles());
+
+  std::vector<LaneInfoConstPtr> lanes;
+  EXPECT_EQ(0, tiled_map.GetLanes(MakePoint(1250.0, 1.0), 10.0, &lanes));
+  ASSERT_EQ(1, lanes.size());
+  EXPECT_EQ("lane_12", lanes[0]->id().id());
+  EXPECT_EQ(1, tiled_map.NumLoadedTiles());
+
+  // across tiles and beyond the margin
+  HDMapImpl full_map;
+  ASSERT_EQ(0, full_map.LoadMapFromProto(CreateMap()));
+  std::vector<LaneInfoConstPtr> full_lanes;
+  EXPECT_EQ(0, full_map.GetLanes(MakePoint(1000.0, 1.0), 450.0, &full_lanes));
+  EXPECT_EQ(0, tiled_map.GetLanes(MakePoint(1000.0, 1.0), 450.0, &lanes));
+  EXPECT_EQ(full_lanes.size(), lanes.size());
+
+  LaneInfoConstPtr nearest_lane;
+  double s = 0.0;
+  double l = 0.0;
+  EXPECT_EQ(0, tiled_map.GetNearestLane(MakePoint(530.0, 3.0), &nearest_lane,
+                                        &s, &l));
+  ASSERT_TRUE(nearest_lane != nullptr);
+  EXPECT_EQ("lane_5", nearest_lane->id().id());
+  EXPECT_NEAR(30.0, s, 1e-6);
+  EXPECT_NEAR(2.0, l, 1e-6);
+
+  EXPECT_EQ(-1, tiled_map.GetNearestLane(MakePoint(1000.0, 5000.0),
+                                         &nearest_lane, &s, &l));
+}
+
+TEST_F(TiledHDMapTestSuite, GetLaneByIdAndEviction) {
+  TiledHDMap tiled_map(1);
+  ASSERT_EQ(0, tiled_map.LoadIndex(kTileDir));
+
+  Id lane_id;
+  lane_id.set_id("lane_0");
+  LaneInfoConstPtr first_lane = tiled_map.GetLaneById(lane_id);
+  ASSERT_TRUE(first_lane != nullptr);
+  lane_id.set_id("lane_19");
+  LaneInfoConstPtr last_lane = tiled_map.GetLaneById(lane_id);
+  ASSERT_TRUE(last_lane != nullptr);
+  EXPECT_EQ(1, tiled_map.NumLoadedTiles());
+  // the evicted tile stays alive with the lane
+  EXPECT_EQ("lane_0", first_lane->id().id());
+  EXPECT_NEAR(kLaneLength, first_lane->total_length(), 1e-6);
+
+  lane_id.set_id("lane_x");
+  EXPECT_TRUE(tiled_map.GetLaneById(lane_id) == nullptr);
+}
+
+TEST_F(TiledHDMapTestSuite, Prefetch) {
+  TiledHDMap tiled_map(8);
+  ASSERT_EQ(0, tiled_map.LoadIndex(kTileDir));
+  tiled_map.Prefetch({MakePoint(100.0, 1.0), MakePoint(600.0, 1.0)});
+  std::vector<LaneInfoConstPtr> lanes;
+  EXPECT_EQ(0, tiled_map.GetLanes(MakePoint(650.0, 1.0), 10.0, &lanes));
+  ASSERT_EQ(1, lanes.size());
+  EXPECT_EQ("lane_6", lanes[0]->id().id());
+  EXPECT_GE(tiled_map.NumLoadedTiles(), 1);
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -25,22 +25,64 @@ namespace apollo {
 namespace pnc_map {
 
 constexpr std::size_t kDeviceVecSize = 2000;
+constexpr int kThreadsPerBlock = 512;
 
 CudaNearestSegment::CudaNearestSegment() {
-  host_seg_ = new CudaLineSegment2d[kDeviceVecSize];
-  cudaError_t cudaStatus;
-  cudaStatus = cudaMalloc((void**)&dev_dist_, sizeof(double) * kDeviceVecSize);
-  CHECK_EQ(cudaStatus, cudaSuccess);
-  cudaStatus =
-      cudaMalloc((void**)&dev_seg_, sizeof(CudaLineSegment2d) * kDeviceVecSize);
-  CHECK_EQ(cudaStatus, cudaSuccess);
+  CHECK(Reserve(kDeviceVecSize));
   cublasCreate(&handle_);
 }
 
 CudaNearestSegment::~CudaNearestSegment() {
-  delete[] host_seg_;
   cudaFree(dev_dist_);
   cudaFree(dev_seg_);
+  cudaFree(dev_points_);
+  cudaFree(dev_indices_);
+  cudaFree(dev_min_dist_);
+  cublasDestroy(handle_);
+}
+
+bool CudaNearestSegment::Reserve(std::size_t num_segments) {
+  if (num_segments <= capacity_) {
+    return true;
+  }
+  cudaFree(dev_dist_);
+  cudaFree(dev_seg_);
+  dev_dist_ = nullptr;
+  dev_seg_ = nullptr;
+  capacity_ = 0;
+  if (cudaMalloc((void**)&dev_dist_, sizeof(double) * num_segments) !=
+          cudaSuccess ||
+      cudaMalloc((void**)&dev_seg_, sizeof(CudaLineSegment2d) * num_segments) !=
+          cudaSuccess) {
+    AERROR << "Failed to allocate " << num_segments << " segments on device";
+    return false;
+  }
+  capacity_ = num_segments;
+  return true;
+}
+
+bool CudaNearestSegment::ReservePoints(std::size_t num_points) {
+  if (num_points <= point_capacity_) {
+    return true;
+  }
+  cudaFree(dev_points_);
+  cudaFree(dev_indices_);
+  cudaFree(dev_min_dist_);
+  dev_points_ = nullptr;
+  dev_indices_ = nullptr;
+  dev_min_dist_ = nullptr;
+  point_capacity_ = 0;
+  if (cudaMalloc((void**)&dev_points_, sizeof(double) * 2 * num_points) !=
+          cudaSuccess ||
+      cudaMalloc((void**)&dev_indices_, sizeof(int) * num_points) !=
+          cudaSuccess ||
+      cudaMalloc((void**)&dev_min_dist_, sizeof(double) * num_points) !=
+          cudaSuccess) {
+    AERROR << "Failed to allocate " << num_points << " points on device";
+    return false;
+  }
+  point_capacity_ = num_points;
+  return true;
 }
 
 __device__ double distance_square(const CudaLineSegment2d seg, double x,
@@ -50,22 +92,27 @@ __device__ double distance_square(const CudaLineSegment2d seg, double x,
   double x1x2 = seg.x2 - seg.x1;
   double y1y2 = seg.y2 - seg.y1;
   double dot = x1x * x1x2 + y1y * y1y2;
-  if (dot < 0) {
+  double length_sqr = x1x2 * x1x2 + y1y2 * y1y2;
+  if (dot <= 0 || length_sqr <= 0) {
     return x1x * x1x + y1y * y1y;
-  } else if (dot > x1x2 * x1x2 + y1y2 * y1y2) {
+  } else if (dot >= length_sqr) {
     double x2x = x - seg.x2;
     double y2y = y - seg.y2;
     return x2x * x2x + y2y * y2y;
   } else {
     double prod = x1x * y1y2 - y1y * x1x2;
-    return prod * prod;
+    return prod * prod / length_sqr;
   }
 }
 
 __host__ bool CudaNearestSegment::UpdateLineSegment(
     const std::vector<apollo::common::math::LineSegment2d>& segments) {
-  size_ = std::min(kDeviceVecSize, segments.size());
-  for (std::size_t i = 0; i < size_; ++i) {
+  size_ = 0;
+  if (!Reserve(segments.size())) {
+    return false;
+  }
+  host_seg_.resize(segments.size());
+  for (std::size_t i = 0; i < segments.size(); ++i) {
     host_seg_[i].x1 = segments[i].start().x();
     host_seg_[i].y1 = segments[i].start().y();
     host_seg_[i].x2 = segments[i].end().x();
@@ -73,12 +120,14 @@ __host__ bool CudaNearestSegment::UpdateLineSegment(
   }
   cudaError_t cudaStatus;
   cudaStatus =
-      cudaMemcpy(dev_seg_, host_seg_, size_ * sizeof(CudaLineSegment2d),
+      cudaMemcpy(dev_seg_, host_seg_.data(),
+                 segments.size() * sizeof(CudaLineSegment2d),
                  cudaMemcpyHostToDevice);
   if (cudaStatus != cudaSuccess) {
     AERROR << "Failed to copy to cuda device";
     return false;
   }
+  size_ = segments.size();
   return true;
 }
 
@@ -88,27 +137,40 @@ __global__ void DistanceSquare(double x, double y, CudaLineSegment2d* dev_seg,
   if (index >= size) {
     return;
   }
-  const auto& seg = dev_seg[index];
-  double x1x = x - seg.x1;
-  double y1y = y - seg.y1;
-  double x1x2 = seg.x2 - seg.x1;
-  double y1y2 = seg.y2 - seg.y1;
-  double dot = x1x * x1x2 + y1y * y1y2;
-  if (dot < 0) {
-    dev_dist[index] = x1x * x1x + y1y * y1y;
-  } else if (dot > x1x2 * x1x2 + y1y2 * y1y2) {
-    double x2x = x - seg.x2;
-    double y2y = y - seg.y2;
-    dev_dist[index] = x2x * x2x + y2y * y2y;
-  } else {
-    double prod = x1x * y1y2 - y1y * x1x2;
-    dev_dist[index] = prod * prod;
+  dev_dist[index] = distance_square(dev_seg[index], x, y);
+}
+
+// one thread per point, the segments are read in the same order by all
+// threads of a block
+__global__ void NearestSegments(const double* dev_points, int32_t num_points,
+                                const CudaLineSegment2d* dev_seg,
+                                int32_t size, int* dev_indices,
+                                double* dev_min_dist) {
+  int32_t index = blockDim.x * blockIdx.x + threadIdx.x;
+  if (index >= num_points) {
+    return;
+  }
+  const double x = dev_points[2 * index];
+  const double y = dev_points[2 * index + 1];
+  int min_index = -1;
+  double min_dist = 0.0;
+  for (int32_t i = 0; i < size; ++i) {
+    const double dist = distance_square(dev_seg[i], x, y);
+    if (min_index < 0 || dist < min_dist) {
+      min_index = i;
+      min_dist = dist;
+    }
   }
+  dev_indices[index] = min_index;
+  dev_min_dist[index] = min_dist;
 }
 
 int CudaNearestSegment::FindNearestSegment(double x, double y) {
-  DistanceSquare<<<(kDeviceVecSize + 511) / 512, 512>>>(x, y, dev_seg_,
-                                                        dev_dist_, size_);
+  if (size_ == 0) {
+    return -1;
+  }
+  DistanceSquare<<<(size_ + kThreadsPerBlock - 1) / kThreadsPerBlock,
+                   kThreadsPerBlock>>>(x, y, dev_seg_, dev_dist_, size_);
   cublasStatus_t stat;
   int min_index = 0;
   stat = cublasIdamin(handle_, size_, dev_dist_, 1, &min_index);
@@ -118,5 +180,46 @@ int CudaNearestSegment::FindNearestSegment(double x, double y) {
   }
   return min_index - 1;
 }
+
+bool CudaNearestSegment::FindNearestSegments(
+    const std::vector<apollo::common::math::Vec2d>& points,
+    std::vector<int>* indices, std::vector<double>* distance_sqrs) {
+  CHECK_NOTNULL(indices);
+  CHECK_NOTNULL(distance_sqrs);
+  indices->assign(points.size(), -1);
+  distance_sqrs->assign(points.size(), 0.0);
+  if (points.empty() || size_ == 0) {
+    return true;
+  }
+  if (!ReservePoints(points.size())) {
+    return false;
+  }
+  host_points_.resize(2 * points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    host_points_[2 * i] = points[i].x();
+    host_points_[2 * i + 1] = points[i].y();
+  }
+  if (cudaMemcpy(dev_points_, host_points_.data(),
+                 host_points_.size() * sizeof(double),
+                 cudaMemcpyHostToDevice) != cudaSuccess) {
+    AERROR << "Failed to copy points to cuda device";
+    return false;
+  }
+  const int32_t num_points = static_cast<int32_t>(points.size());
+  NearestSegments<<<(num_points + kThreadsPerBlock - 1) / kThreadsPerBlock,
+                    kThreadsPerBlock>>>(dev_points_, num_points, dev_seg_,
+                                        size_, dev_indices_, dev_min_dist_);
+  if (cudaGetLastError() != cudaSuccess ||
+      cudaMemcpy(indices->data(), dev_indices_, num_points * sizeof(int),
+                 cudaMemcpyDeviceToHost) != cudaSuccess ||
+      cudaMemcpy(distance_sqrs->data(), dev_min_dist_,
+                 num_points * sizeof(double),
+                 cudaMemcpyDeviceToHost) != cudaSuccess) {
+    AERROR << "Failed to find nearest segments on cuda device";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace pnc_map
 }  // namespace apollo
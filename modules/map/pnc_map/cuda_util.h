@@ -39,14 +39,35 @@ class CudaNearestSegment {
 
   int FindNearestSegment(double x, double y);
 
+  /**
+   * @brief Find the nearest segment of every point with one kernel launch.
+   * @param indices The index of the nearest segment of each point, -1 if
+   * there is no segment.
+   * @param distance_sqrs The squared distance to that segment.
+   */
+  bool FindNearestSegments(
+      const std::vector<apollo::common::math::Vec2d>& points,
+      std::vector<int>* indices, std::vector<double>* distance_sqrs);
+
   ~CudaNearestSegment();
 
  private:
+  bool Reserve(std::size_t num_segments);
+  bool ReservePoints(std::size_t num_points);
+
   std::size_t size_ = 0;
-  CudaLineSegment2d* host_seg_;
-  double* dev_dist_;
-  CudaLineSegment2d* dev_seg_;
+  std::size_t capacity_ = 0;
+  std::vector<CudaLineSegment2d> host_seg_;
+  double* dev_dist_ = nullptr;
+  CudaLineSegment2d* dev_seg_ = nullptr;
   cublasHandle_t handle_;
+
+  // batched queries
+  std::size_t point_capacity_ = 0;
+  std::vector<double> host_points_;
+  double* dev_points_ = nullptr;
+  int* dev_indices_ = nullptr;
+  double* dev_min_dist_ = nullptr;
 };
 
 }  // namespace pnc_map
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Times nearest lane projection of a batch of points around the first lane
+ * of the base map, with LaneProjectionService and with one
+ * HDMap::GetNearestLane call per point.
+ **/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/pnc_map/lane_projection_service.h"
+
+DEFINE_int32(benchmark_points, 2000, "points per batch");
+DEFINE_int32(benchmark_cycles, 50, "batches per configuration");
+DEFINE_double(benchmark_radius, 200.0, "radius of the resident region");
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::math::Vec2d;
+
+void Run() {
+  const HDMap *hdmap = HDMapUtil::BaseMapPtr();
+  CHECK_NOTNULL(hdmap);
+  LaneInfoConstPtr lane;
+  double s = 0.0;
+  double l = 0.0;
+  CHECK_EQ(0, hdmap->GetNearestLane(common::util::MakePointENU(0, 0, 0),
+                                    &lane, &s, &l));
+  const Vec2d center = lane->points().front();
+
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> offset(-FLAGS_benchmark_radius / 2.0,
+                                                FLAGS_benchmark_radius / 2.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < FLAGS_benchmark_points; ++i) {
+    points.emplace_back(center.x() + offset(generator),
+                        center.y() + offset(generator));
+  }
+
+  LaneProjectionService service(hdmap);
+  auto start = std::chrono::steady_clock::now();
+  service.UpdateRegion(center, FLAGS_benchmark_radius);
+  const double upload_ms = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+  std::vector<LaneProjection> projections;
+  start = std::chrono::steady_clock::now();
+  for (int cycle = 0; cycle < FLAGS_benchmark_cycles; ++cycle) {
+    service.BatchProject(points, &projections);
+  }
+  const double service_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count() /
+                            FLAGS_benchmark_cycles;
+
+  start = std::chrono::steady_clock::now();
+  for (int cycle = 0; cycle < FLAGS_benchmark_cycles; ++cycle) {
+    for (const auto &point : points) {
+      hdmap->GetNearestLane(
+          common::util::MakePointENU(point.x(), point.y(), 0.0), &lane, &s,
+          &l);
+    }
+  }
+  const double kdtree_ms = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count() /
+                           FLAGS_benchmark_cycles;
+
+  std::cout << "resident segments: " << service.NumResidentSegments()
+            << (service.UsesGpu() ? " on gpu" : " (cpu only)")
+            << ", upload " << upload_ms << " ms" << std::endl;
+  std::cout << "service: " << service_ms << " ms, kd-tree: " << kdtree_ms
+            << " ms per batch of " << points.size() << " points"
+            << std::endl;
+}
+
+}  // namespace
+}  // namespace hdmap
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::hdmap::Run();
+  return 0;
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/map/pnc_map/lane_projection_service.h"
+
+#include <cmath>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/util/util.h"
+
+#ifdef USE_GPU
+#include "modules/map/pnc_map/cuda_util.h"
+#endif
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+LaneProjectionService::LaneProjectionService(const HDMap *hdmap)
+    : hdmap_(hdmap) {
+  CHECK_NOTNULL(hdmap_);
+}
+
+LaneProjectionService::~LaneProjectionService() = default;
+
+bool LaneProjectionService::UpdateRegion(const Vec2d &center,
+                                         const double radius) {
+  center_ = center;
+  radius_ = 0.0;
+  lanes_.clear();
+  segment_refs_.clear();
+  if (hdmap_->GetLanes(common::util::MakePointENU(center.x(), center.y(), 0.0),
+                       radius, &lanes_) != 0) {
+    AERROR << "Failed to get lanes around " << center.DebugString();
+    return false;
+  }
+#ifdef USE_GPU
+  std::vector<LineSegment2d> segments;
+  for (std::size_t i = 0; i < lanes_.size(); ++i) {
+    const auto &lane_segments = lanes_[i]->segments();
+    for (std::size_t j = 0; j < lane_segments.size(); ++j) {
+      segments.push_back(lane_segments[j]);
+      segment_refs_.push_back(
+          {static_cast<int>(i), static_cast<int>(j)});
+    }
+  }
+  if (!cuda_segments_) {
+    cuda_segments_.reset(new pnc_map::CudaNearestSegment());
+  }
+  if (!cuda_segments_->UpdateLineSegment(segments)) {
+    AERROR << "Failed to upload lane segments, use the cpu instead";
+    segment_refs_.clear();
+    return false;
+  }
+#endif
+  radius_ = radius;
+  return true;
+}
+
+bool LaneProjectionService::UsesGpu() const {
+#ifdef USE_GPU
+  return cuda_segments_ != nullptr && !segment_refs_.empty();
+#else
+  return false;
+#endif
+}
+
+bool LaneProjectionService::BatchProject(
+    const std::vector<Vec2d> &points,
+    std::vector<LaneProjection> *const projections) {
+  CHECK_NOTNULL(projections);
+  projections->assign(points.size(), LaneProjection());
+  std::vector<int> indices;
+  std::vector<double> distance_sqrs;
+#ifdef USE_GPU
+  if (UsesGpu() &&
+      !cuda_segments_->FindNearestSegments(points, &indices, &distance_sqrs)) {
+    AERROR << "Failed to find nearest segments on gpu, use the cpu instead";
+    indices.clear();
+  }
+#endif
+  bool success = true;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    auto *projection = &(*projections)[i];
+    if (i < indices.size() && indices[i] >= 0) {
+      // every lane outside of the region is further than radius_ minus the
+      // distance to the center, a nearer resident lane is the nearest one
+      const double bound = radius_ - points[i].DistanceTo(center_);
+      if (bound > 0.0 && distance_sqrs[i] <= bound * bound) {
+        ProjectOntoSegment(segment_refs_[indices[i]], points[i], projection);
+        continue;
+      }
+    }
+    success = ProjectOnCpu(points[i], projection) && success;
+  }
+  return success;
+}
+
+void LaneProjectionService::ProjectOntoSegment(
+    const SegmentRef &ref, const Vec2d &point,
+    LaneProjection *const projection) const {
+  const auto &lane = lanes_[ref.lane_index];
+  const LineSegment2d &segment = lane->segments()[ref.segment_index];
+  Vec2d nearest_pt;
+  projection->lane = lane;
+  projection->distance = segment.DistanceTo(point, &nearest_pt);
+  projection->s = lane->accumulate_s()[ref.segment_index] +
+                  nearest_pt.DistanceTo(segment.start());
+  projection->l = segment.unit_direction().CrossProd(point - segment.start());
+}
+
+bool LaneProjectionService::ProjectOnCpu(
+    const Vec2d &point, LaneProjection *const projection) const {
+  if (hdmap_->GetNearestLane(
+          common::util::MakePointENU(point.x(), point.y(), 0.0),
+          &projection->lane, &projection->s, &projection->l) != 0) {
+    projection->lane = nullptr;
+    return false;
+  }
+  projection->distance = projection->lane->DistanceTo(point);
+  return true;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
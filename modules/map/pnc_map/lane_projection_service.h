@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Batched nearest lane projection, on the GPU when it is available.
+ **/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/hdmap.h"
+
+namespace apollo {
+#ifdef USE_GPU
+namespace pnc_map {
+class CudaNearestSegment;
+}  // namespace pnc_map
+#endif
+
+namespace hdmap {
+
+struct LaneProjection {
+  // nullptr if no lane was found
+  LaneInfoConstPtr lane;
+  double s = 0.0;
+  double l = 0.0;
+  double distance = 0.0;
+};
+
+/**
+ * @class LaneProjectionService
+ * @brief Answers nearest lane queries for many points at once. The segments
+ * of the lanes around a region center are kept resident on the GPU and all
+ * points of a batch are searched by one kernel launch. Points whose nearest
+ * lane may lie outside of the region, and all points when there is no GPU,
+ * are answered by the map KD-tree as HDMap::GetNearestLane does.
+ */
+class LaneProjectionService {
+ public:
+  explicit LaneProjectionService(const HDMap *hdmap);
+  ~LaneProjectionService();
+
+  /**
+   * @brief Make the lanes within radius of center resident, usually called
+   * when the ego vehicle has moved a fraction of the radius.
+   */
+  bool UpdateRegion(const common::math::Vec2d &center, const double radius);
+
+  /**
+   * @brief Project every point onto its nearest lane.
+   * @return false if the map has no lane.
+   */
+  bool BatchProject(const std::vector<common::math::Vec2d> &points,
+                    std::vector<LaneProjection> *const projections);
+
+  /**
+   * @brief Whether queries in the region are answered on the GPU.
+   */
+  bool UsesGpu() const;
+
+  std::size_t NumResidentSegments() const { return segment_refs_.size(); }
+
+ private:
+  struct SegmentRef {
+    int lane_index;
+    int segment_index;
+  };
+
+  bool ProjectOnCpu(const common::math::Vec2d &point,
+                    LaneProjection *const projection) const;
+
+  void ProjectOntoSegment(const SegmentRef &ref,
+                          const common::math::Vec2d &point,
+                          LaneProjection *const projection) const;
+
+  const HDMap *hdmap_ = nullptr;
+  common::math::Vec2d center_;
+  double radius_ = 0.0;
+  std::vector<LaneInfoConstPtr> lanes_;
+  std::vector<SegmentRef> segment_refs_;
+#ifdef USE_GPU
+  std::unique_ptr<pnc_map::CudaNearestSegment> cuda_segments_;
+#endif
+};
+
+}  // namespace hdmap
+}  // namespace apollo
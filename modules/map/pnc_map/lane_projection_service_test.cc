@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/map/pnc_map/lane_projection_service.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::Vec2d;
+
+class LaneProjectionServiceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // parallel straight lanes along x, 4 meters apart
+    Map map;
+    for (int i = 0; i < 5; ++i) {
+      auto *lane = map.add_lane();
+      lane->mutable_id()->set_id("lane_" + std::to_string(i));
+      auto *line_segment = lane->mutable_central_curve()
+                               ->add_segment()
+                               ->mutable_line_segment();
+      for (int j = 0; j <= 10; ++j) {
+        auto *point = line_segment->add_point();
+        point->set_x(10.0 * j);
+        point->set_y(4.0 * i);
+      }
+    }
+    ASSERT_EQ(0, hdmap_.LoadMapFromProto(map));
+  }
+
+ protected:
+  HDMap hdmap_;
+};
+
+TEST_F(LaneProjectionServiceTest, MatchesNearestLane) {
+  LaneProjectionService service(&hdmap_);
+  ASSERT_TRUE(service.UpdateRegion({50.0, 8.0}, 20.0));
+  const std::vector<Vec2d> points = {
+      {50.0, 8.5}, {21.0, 1.0}, {75.0, 17.5}, {-30.0, 40.0}};
+  std::vector<LaneProjection> projections;
+  ASSERT_TRUE(service.BatchProject(points, &projections));
+  ASSERT_EQ(points.size(), projections.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    LaneInfoConstPtr lane;
+    double s = 0.0;
+    double l = 0.0;
+    ASSERT_EQ(0, hdmap_.GetNearestLane(
+                     common::util::MakePointENU(points[i].x(), points[i].y(),
+                                                0.0),
+                     &lane, &s, &l));
+    ASSERT_TRUE(projections[i].lane != nullptr);
+    EXPECT_EQ(lane->id().id(), projections[i].lane->id().id());
+    EXPECT_NEAR(s, projections[i].s, 1e-6);
+    EXPECT_NEAR(l, projections[i].l, 1e-6);
+    EXPECT_NEAR(lane->DistanceTo(points[i]), projections[i].distance, 1e-6);
+  }
+  EXPECT_EQ("lane_2", projections[0].lane->id().id());
+  EXPECT_NEAR(0.5, projections[0].l, 1e-6);
+}
+
+TEST_F(LaneProjectionServiceTest, EmptyBatch) {
+  LaneProjectionService service(&hdmap_);
+  std::vector<LaneProjection> projections(3);
+  EXPECT_TRUE(service.BatchProject({}, &projections));
+  EXPECT_TRUE(projections.empty());
+}
+
+}  // namespace hdmap
+}  // namespace apollo
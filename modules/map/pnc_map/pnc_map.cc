@@ -21,6 +21,7 @@
 #include "modules/map/pnc_map/pnc_map.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 #include "google/protobuf/text_format.h"
@@ -28,6 +29,7 @@
 #include "modules/map/proto/map_id.pb.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/math/math_utils.h"
 #include "modules/common/util/string_util.h"
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -173,8 +175,14 @@ bool PncMap::UpdateVehicleState(const VehicleState &vehicle_state) {
     stop_for_destination_ = false;
   }
 
+  const LaneWaypoint previous_waypoint = adc_waypoint_;
   adc_state_ = vehicle_state;
-  if (!GetNearestPointFromRouting(vehicle_state, &adc_waypoint_)) {
+  // the adc usually stays on its lane or moves to the next one on the route,
+  // only search the map when it doesn't
+  if ((adc_route_index_ < 0 ||
+       !ProjectFromPreviousWaypoint(vehicle_state, previous_waypoint,
+                                    &adc_waypoint_)) &&
+      !GetNearestPointFromRouting(vehicle_state, &adc_waypoint_)) {
     AERROR << "Failed to get waypoint from routing with point: "
            << "(" << vehicle_state.x() << ", " << vehicle_state.y() << ", "
            << vehicle_state.z() << ")";
@@ -223,8 +231,22 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
   range_lane_ids_.clear();
   route_indices_.clear();
   all_lane_ids_.clear();
+  passage_segments_.assign(routing.road_size(), {});
+  neighbor_passages_.clear();
+  neighbor_passages_road_ = -1;
+  neighbor_passages_passage_ = -1;
   for (int road_index = 0; road_index < routing.road_size(); ++road_index) {
     const auto &road_segment = routing.road(road_index);
+    auto &road_passage_segments = passage_segments_[road_index];
+    road_passage_segments.resize(road_segment.passage_size());
+    for (int passage_index = 0; passage_index < road_segment.passage_size();
+         ++passage_index) {
+      if (!PassageToSegments(road_segment.passage(passage_index),
+                             &road_passage_segments[passage_index])) {
+        ADEBUG << "Failed to convert passage to lane segments.";
+        road_passage_segments[passage_index].clear();
+      }
+    }
     for (int passage_index = 0; passage_index < road_segment.passage_size();
          ++passage_index) {
       const auto &passage = road_segment.passage(passage_index);
@@ -451,11 +473,18 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
   const int passage_index = route_index[1];
   const auto &road = routing_.road(road_index);
   // raw filter to find all neighboring passages
-  auto drive_passages = GetNeighborPassages(road, passage_index);
-  for (const int index : drive_passages) {
+  if (neighbor_passages_road_ != road_index ||
+      neighbor_passages_passage_ != passage_index ||
+      neighbor_passages_waypoint_ != next_routing_waypoint_index_) {
+    neighbor_passages_ = GetNeighborPassages(road, passage_index);
+    neighbor_passages_road_ = road_index;
+    neighbor_passages_passage_ = passage_index;
+    neighbor_passages_waypoint_ = next_routing_waypoint_index_;
+  }
+  for (const int index : neighbor_passages_) {
     const auto &passage = road.passage(index);
-    RouteSegments segments;
-    if (!PassageToSegments(passage, &segments)) {
+    const RouteSegments &segments = passage_segments_[road_index][index];
+    if (segments.empty()) {
       ADEBUG << "Failed to convert passage to lane segments.";
       continue;
     }
@@ -577,6 +606,34 @@ bool PncMap::GetNearestPointFromRouting(const VehicleState &state,
   return waypoint->lane != nullptr;
 }
 
+bool PncMap::ProjectFromPreviousWaypoint(const VehicleState &state,
+                                         const LaneWaypoint &previous_waypoint,
+                                         LaneWaypoint *waypoint) const {
+  if (previous_waypoint.lane == nullptr) {
+    return false;
+  }
+  const common::math::Vec2d point(state.x(), state.y());
+  LaneInfoConstPtr lane = previous_waypoint.lane;
+  for (int i = 0; i < 2 && lane != nullptr; ++i) {
+    if (range_lane_ids_.count(lane->id().id()) == 0) {
+      break;
+    }
+    double s = 0.0;
+    double l = 0.0;
+    if (lane->GetProjection(point, &s, &l) && s >= 0.0 &&
+        s <= lane->total_length() &&
+        std::fabs(l) <= lane->GetWidth(s) / 2.0 &&
+        std::fabs(common::math::AngleDiff(lane->Heading(s),
+                                          state.heading())) < M_PI / 2.0) {
+      waypoint->lane = lane;
+      waypoint->s = s;
+      return true;
+    }
+    lane = GetRouteSuccessor(lane);
+  }
+  return false;
+}
+
 LaneInfoConstPtr PncMap::GetRouteSuccessor(LaneInfoConstPtr lane) const {
   if (lane->lane().successor_id_size() == 0) {
     return nullptr;
@@ -95,6 +95,15 @@ class PncMap {
   bool GetNearestPointFromRouting(const common::VehicleState &point,
                                   LaneWaypoint *waypoint) const;
 
+  /**
+   * @brief Project the vehicle onto the lane of the previous waypoint or its
+   * route successor, without a spatial query on the map.
+   * @return false if the vehicle is not within one of these lanes.
+   */
+  bool ProjectFromPreviousWaypoint(const common::VehicleState &state,
+                                   const LaneWaypoint &previous_waypoint,
+                                   LaneWaypoint *waypoint) const;
+
   bool PassageToSegments(routing::Passage passage,
                          RouteSegments *segments) const;
 
@@ -169,6 +178,15 @@ class PncMap {
   // routing ids in range
   std::unordered_set<std::string> range_lane_ids_;
   std::unordered_set<std::string> all_lane_ids_;
+  // segments of every passage, indexed by road and passage index
+  std::vector<std::vector<RouteSegments>> passage_segments_;
+
+  // neighbor passages of the adc passage, reused until the adc moves to
+  // another passage or passes the next routing waypoint
+  std::vector<int> neighbor_passages_;
+  int neighbor_passages_road_ = -1;
+  int neighbor_passages_passage_ = -1;
+  std::size_t neighbor_passages_waypoint_ = 0;
 
   /**
    * The routing request waypoints
@@ -222,6 +240,7 @@ class PncMap {
   FRIEND_TEST(PncMapTest, GetNeighborPassages);
   FRIEND_TEST(PncMapTest, NextWaypointIndex);
   FRIEND_TEST(PncMapTest, SearchForwardIndex_SearchBackwardIndex);
+  FRIEND_TEST(PncMapTest, ProjectFromPreviousWaypoint);
 };
 
 }  // namespace hdmap
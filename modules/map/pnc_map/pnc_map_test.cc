@@ -231,5 +231,26 @@ TEST_F(PncMapTest, GetNeighborPassages) {
   }
 }
 
+TEST_F(PncMapTest, ProjectFromPreviousWaypoint) {
+  auto lane = hdmap_.GetLaneById(hdmap::MakeMapId("9_1_-1"));
+  ASSERT_TRUE(lane);
+  const LaneWaypoint previous_waypoint(lane, 50.0);
+  auto point = lane->GetSmoothPoint(60.0);
+  common::VehicleState state;
+  state.set_x(point.x());
+  state.set_y(point.y());
+  state.set_heading(lane->Heading(60.0));
+  LaneWaypoint waypoint;
+  EXPECT_TRUE(pnc_map_->ProjectFromPreviousWaypoint(state, previous_waypoint,
+                                                    &waypoint));
+  ASSERT_TRUE(waypoint.lane != nullptr);
+  EXPECT_EQ("9_1_-1", waypoint.lane->id().id());
+  EXPECT_NEAR(60.0, waypoint.s, 1e-3);
+
+  state.set_heading(lane->Heading(60.0) + M_PI);
+  EXPECT_FALSE(pnc_map_->ProjectFromPreviousWaypoint(state, previous_waypoint,
+                                                     &waypoint));
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #include "modules/map/relative_map/navigation_lane.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -148,6 +149,7 @@ void NavigationLane::UpdateNavigationInfo(
     const NavigationInfo &navigation_path) {
   navigation_info_ = navigation_path;
   last_project_index_map_.clear();
+  navigation_path_cache_.clear();
   navigation_path_list_.clear();
   current_navi_path_tuple_ = std::make_tuple(-1, -1.0, -1.0, nullptr);
   if (FLAGS_enable_cyclic_rerouting) {
@@ -188,7 +190,14 @@ bool NavigationLane::GeneratePath() {
     // Don't worry about efficiency because the total number of navigation lines
     // will not exceed 10 at most.
     for (int i = 0; i < navigation_line_num; ++i) {
-      auto current_navi_path = std::make_shared<NavigationPath>();
+      // The navigation paths of the last cycle are no longer referenced after
+      // the list is cleared, so they are cleared and reused.
+      auto &current_navi_path = navigation_path_cache_[i];
+      if (current_navi_path == nullptr || current_navi_path.use_count() > 1) {
+        current_navi_path = std::make_shared<NavigationPath>();
+      } else {
+        current_navi_path->Clear();
+      }
       auto *path = current_navi_path->mutable_path();
       if (ConvertNavigationLineToPath(i, path)) {
         current_navi_path->set_path_priority(
@@ -465,15 +474,18 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
   // offset between the current vehicle state and navigation line
   const double dx = -original_pose_.position().x();
   const double dy = -original_pose_.position().y();
-  auto enu_to_flu_func = [this, dx, dy](const double enu_x, const double enu_y,
-                                        const double enu_theta, double *flu_x,
-                                        double *flu_y, double *flu_theta) {
+  // the rotation is the same for every point, so it is computed once
+  const double cos_heading = std::cos(-original_pose_.heading());
+  const double sin_heading = std::sin(-original_pose_.heading());
+  auto enu_to_flu_func = [this, dx, dy, cos_heading, sin_heading](
+                             const double enu_x, const double enu_y,
+                             const double enu_theta, double *flu_x,
+                             double *flu_y, double *flu_theta) {
     if (flu_x != nullptr && flu_y != nullptr) {
-      Eigen::Vector2d flu_coordinate = common::math::RotateVector2d(
-          {enu_x + dx, enu_y + dy}, -original_pose_.heading());
-
-      *flu_x = flu_coordinate.x();
-      *flu_y = flu_coordinate.y();
+      const double x = enu_x + dx;
+      const double y = enu_y + dy;
+      *flu_x = cos_heading * x - sin_heading * y;
+      *flu_y = sin_heading * x + cos_heading * y;
     }
 
     if (flu_theta != nullptr) {
@@ -568,7 +580,9 @@ ProjIndexPair NavigationLane::UpdateProjectionIndex(const common::Path &path,
   const int path_size = path.path_point_size();
   int current_project_index = 0;
   auto item_iter = last_project_index_map_.find(line_index);
-  if (item_iter != last_project_index_map_.end()) {
+  const bool has_last_project_index =
+      item_iter != last_project_index_map_.end();
+  if (has_last_project_index) {
     current_project_index = std::max(0, item_iter->second.first);
   }
 
@@ -618,8 +632,10 @@ ProjIndexPair NavigationLane::UpdateProjectionIndex(const common::Path &path,
       min_d = d;
       index = i;
     }
+    // Starting from the last projection, the search ends once the line is
+    // far from the vehicle, rather than going through the rest of the line.
     const double kMaxDistance = 50.0;
-    if (current_project_index != 0 && d > kMaxDistance) {
+    if (has_last_project_index && d > kMaxDistance) {
       break;
     }
   }
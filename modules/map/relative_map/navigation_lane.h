@@ -278,6 +278,12 @@ class NavigationLane {
   // the navigation path which the vehicle is currently on.
   NaviPathTuple current_navi_path_tuple_;
 
+  // key: line index,
+  // value: the navigation path generated from the "key" line, kept across
+  // cycles so that its path points are reused instead of allocated again.
+  std::unordered_map<int, std::shared_ptr<NavigationPath>>
+      navigation_path_cache_;
+
   // when invalid, left_width_ < 0
   double perceived_left_width_ = -1.0;
 
@@ -178,6 +178,27 @@ TEST_F(NavigationLaneTest, GenerateTwoLaneMap) {
   }
 }
 
+TEST_F(NavigationLaneTest, RegenerateTwoLaneMap) {
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "left.smoothed");
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "right.smoothed");
+  EXPECT_TRUE(
+      GenerateNavigationInfo(navigation_line_filenames_, &navigation_info_));
+  navigation_lane_.UpdateNavigationInfo(navigation_info_);
+  EXPECT_TRUE(navigation_lane_.GeneratePath());
+  MapMsg map_msg;
+  EXPECT_TRUE(navigation_lane_.CreateMap(map_param_, &map_msg));
+
+  // The second cycle starts from the last projections and reuses the
+  // navigation paths, which must not change the map.
+  EXPECT_TRUE(navigation_lane_.GeneratePath());
+  MapMsg regenerated_map_msg;
+  EXPECT_TRUE(navigation_lane_.CreateMap(map_param_, &regenerated_map_msg));
+  EXPECT_EQ(map_msg.hdmap().SerializeAsString(),
+            regenerated_map_msg.hdmap().SerializeAsString());
+  EXPECT_EQ(map_msg.navigation_path_size(),
+            regenerated_map_msg.navigation_path_size());
+}
+
 TEST_F(NavigationLaneTest, GenerateThreeLaneMap) {
   navigation_line_filenames_.emplace_back(data_file_dir_ + "left.smoothed");
   navigation_line_filenames_.emplace_back(data_file_dir_ + "middle.smoothed");
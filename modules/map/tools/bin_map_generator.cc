@@ -17,15 +17,29 @@ limitations under the License.
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/proto/map.pb.h"
+#include "modules/map/tools/sim_map_util.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/topo_creator/graph_creator.h"
 
 /**
- * A map tool to transform .txt map to .bin map
+ * A map tool to transform .txt or .xml map to .bin map, so that the processes
+ * loading the map skip the text/xml parsing and read it through mmap. It may
+ * write the routing map and the sim map from the same parse too.
  */
 
 DEFINE_string(output_dir, "/tmp", "output map directory");
+DEFINE_string(input_map, "",
+              "input .txt or .xml map, default base_map.txt in map_dir");
+DEFINE_bool(output_routing_map, false,
+            "also write routing_map.bin and routing_map.txt, with the "
+            "routing config of --routing_conf_file");
+DEFINE_bool(output_sim_map, false,
+            "also write sim_map.bin and sim_map.txt, downsampled as the "
+            "sim_map_generator does");
 
 int main(int argc, char **argv) {
   google::InitGoogleLogging(argv[0]);
@@ -33,10 +47,18 @@ int main(int argc, char **argv) {
 
   google::ParseCommandLineFlags(&argc, &argv, true);
 
-  const auto map_filename = FLAGS_map_dir + "/base_map.txt";
+  const auto map_filename = FLAGS_input_map.empty()
+                                ? FLAGS_map_dir + "/base_map.txt"
+                                : FLAGS_input_map;
   apollo::hdmap::Map pb_map;
-  CHECK(apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map))
-      << "fail to load data from : " << map_filename;
+  if (apollo::common::util::EndWith(map_filename, ".xml")) {
+    CHECK(apollo::hdmap::adapter::OpendriveAdapter::LoadData(map_filename,
+                                                             &pb_map))
+        << "fail to load data from : " << map_filename;
+  } else {
+    CHECK(apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map))
+        << "fail to load data from : " << map_filename;
+  }
 
   const std::string output_bin_file = FLAGS_output_dir + "/base_map.bin";
   CHECK(apollo::cyber::common::SetProtoToBinaryFile(pb_map, output_bin_file))
@@ -48,5 +70,22 @@ int main(int argc, char **argv) {
 
   AINFO << "transform map into .bin map success";
 
+  if (FLAGS_output_routing_map) {
+    apollo::routing::RoutingConfig routing_conf;
+    CHECK(apollo::cyber::common::GetProtoFromFile(FLAGS_routing_conf_file,
+                                                  &routing_conf))
+        << "Unable to load routing conf file: " << FLAGS_routing_conf_file;
+    apollo::routing::GraphCreator creator(
+        pb_map, FLAGS_output_dir + "/routing_map.bin", routing_conf);
+    CHECK(creator.Create()) << "Create routing topo failed!";
+    AINFO << "routing map generated at: " << FLAGS_output_dir;
+  }
+
+  if (FLAGS_output_sim_map) {
+    apollo::hdmap::DownsampleMap(&pb_map);
+    apollo::hdmap::OutputSimMap(pb_map, FLAGS_output_dir);
+    AINFO << "sim_map generated at: " << FLAGS_output_dir;
+  }
+
   return 0;
 }
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/map/tools/sim_map_util.h"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+#include "modules/common/util/points_downsampler.h"
+
+DEFINE_double(angle_threshold, 1. / 180 * M_PI, /* 1 degree */
+              "Points are sampled when the accumulated direction change "
+              "exceeds the threshold");
+DEFINE_int32(downsample_distance, 5, "downsample rate for a normal path");
+DEFINE_int32(steep_turn_downsample_distance, 1,
+             "downsample rate for a steep turn path");
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::PointENU;
+using apollo::common::util::DownsampleByAngle;
+using apollo::common::util::DownsampleByDistance;
+
+namespace {
+
+void DownsampleCurve(Curve* curve) {
+  auto* line_segment = curve->mutable_segment(0)->mutable_line_segment();
+  std::vector<PointENU> points(line_segment->point().begin(),
+                               line_segment->point().end());
+  line_segment->clear_point();
+
+  // Downsample points by angle then by distance.
+  auto sampled_indices = DownsampleByAngle(points, FLAGS_angle_threshold);
+  std::vector<PointENU> downsampled_points;
+  for (const size_t index : sampled_indices) {
+    downsampled_points.push_back(points[index]);
+  }
+
+  sampled_indices =
+      DownsampleByDistance(downsampled_points, FLAGS_downsample_distance,
+                           FLAGS_steep_turn_downsample_distance);
+
+  for (const size_t index : sampled_indices) {
+    *line_segment->add_point() = downsampled_points[index];
+  }
+  size_t new_size = line_segment->point_size();
+  CHECK_GT(new_size, 1);
+
+  AINFO << "Lane curve downsampled from " << points.size() << " points to "
+        << new_size << " points.";
+}
+
+}  // namespace
+
+void DownsampleMap(Map* map_pb) {
+  // the lanes are independent of each other
+  cyber::ParallelFor(0, map_pb->lane_size(), 1, [map_pb](size_t i) {
+    auto* lane = map_pb->mutable_lane(static_cast<int>(i));
+    lane->clear_left_sample();
+    lane->clear_right_sample();
+    lane->clear_left_road_sample();
+    lane->clear_right_road_sample();
+
+    AINFO << "Downsampling lane " << lane->id().id();
+    DownsampleCurve(lane->mutable_central_curve());
+    DownsampleCurve(lane->mutable_left_boundary()->mutable_curve());
+    DownsampleCurve(lane->mutable_right_boundary()->mutable_curve());
+  });
+}
+
+void OutputSimMap(const Map& map_pb, const std::string& output_dir) {
+  std::ofstream map_txt_file(output_dir + "/sim_map.txt");
+  map_txt_file << map_pb.DebugString();
+  map_txt_file.close();
+
+  std::ofstream map_bin_file(output_dir + "/sim_map.bin");
+  std::string map_str;
+  map_pb.SerializeToString(&map_str);
+  map_bin_file << map_str;
+  map_bin_file.close();
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Downsampling of maps to be displayed by dreamview frontend.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "gflags/gflags.h"
+
+#include "modules/map/proto/map.pb.h"
+
+DECLARE_double(angle_threshold);
+DECLARE_int32(downsample_distance);
+DECLARE_int32(steep_turn_downsample_distance);
+
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @brief Downsample the curves of all the lanes of a map, in parallel, and
+ *        drop their width samples.
+ */
+void DownsampleMap(Map* map_pb);
+
+/**
+ * @brief Write a downsampled map to sim_map.txt and sim_map.bin.
+ */
+void OutputSimMap(const Map& map_pb, const std::string& output_dir);
+
+}  // namespace hdmap
+}  // namespace apollo
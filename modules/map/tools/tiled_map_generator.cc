@@ -0,0 +1,52 @@
+/* Copyright 2019 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/hdmap/tiled_hdmap.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * A map tool to split the base map into tiles for TiledHDMap
+ */
+
+DEFINE_string(output_dir, "/tmp/map_tiles", "output tile directory");
+DEFINE_double(tile_size, 500.0, "tile side length in meters");
+DEFINE_double(tile_margin, 100.0, "extra border of every tile in meters");
+
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const auto map_filename = apollo::hdmap::BaseMapFile();
+  apollo::hdmap::Map pb_map;
+  CHECK(apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map))
+      << "fail to load data from : " << map_filename;
+
+  CHECK(apollo::cyber::common::EnsureDirectory(FLAGS_output_dir))
+      << "fail to create directory : " << FLAGS_output_dir;
+  CHECK_EQ(0, apollo::hdmap::TiledHDMap::BuildTiles(
+                  pb_map, FLAGS_tile_size, FLAGS_tile_margin, FLAGS_output_dir))
+      << "fail to split map into tiles";
+
+  AINFO << "split map into tiles success";
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/latency_collector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace monitor {
+
+LatencyCollector::Histogram::Histogram(const std::string& name,
+                                       const int num_buckets)
+    : name_(name), bucket_count_(num_buckets, 0) {}
+
+void LatencyCollector::Histogram::Add(const double latency_ms,
+                                      const double bucket_width_ms) {
+  const double bucket = std::floor(std::max(latency_ms, 0.0) / bucket_width_ms);
+  const size_t last = bucket_count_.size() - 1;
+  ++bucket_count_[bucket < static_cast<double>(last)
+                      ? static_cast<size_t>(bucket)
+                      : last];
+  max_ms_ = count_ == 0 ? latency_ms : std::max(max_ms_, latency_ms);
+  ++count_;
+  sum_ms_ += latency_ms;
+}
+
+// The upper edge of the bucket holding the ratio-th latency, bounded by the
+// max, which also stands for the edge of the last bucket.
+double LatencyCollector::Histogram::Percentile(
+    const double ratio, const double bucket_width_ms) const {
+  const double rank = std::ceil(ratio * static_cast<double>(count_));
+  unsigned int seen = 0;
+  for (size_t i = 0; i < bucket_count_.size(); ++i) {
+    seen += bucket_count_[i];
+    if (static_cast<double>(seen) >= rank && i + 1 < bucket_count_.size()) {
+      return std::min(static_cast<double>(i + 1) * bucket_width_ms, max_ms_);
+    }
+  }
+  return max_ms_;
+}
+
+void LatencyCollector::Histogram::ToProto(const double bucket_width_ms,
+                                          LatencyHistogram* proto) const {
+  proto->set_name(name_);
+  proto->set_count(count_);
+  proto->set_bucket_width_ms(bucket_width_ms);
+  proto->clear_bucket_count();
+  for (const unsigned int bucket_count : bucket_count_) {
+    proto->add_bucket_count(bucket_count);
+  }
+  if (count_ == 0) {
+    return;
+  }
+  proto->set_mean_ms(sum_ms_ / static_cast<double>(count_));
+  proto->set_max_ms(max_ms_);
+  proto->set_p50_ms(Percentile(0.5, bucket_width_ms));
+  proto->set_p95_ms(Percentile(0.95, bucket_width_ms));
+  proto->set_p99_ms(Percentile(0.99, bucket_width_ms));
+}
+
+LatencyCollector::LatencyCollector(const double bucket_width_ms,
+                                   const int num_buckets)
+    : bucket_width_ms_(bucket_width_ms),
+      num_buckets_(std::max(num_buckets, 1)),
+      total_("total", num_buckets_) {}
+
+bool LatencyCollector::AddTrace(const apollo::common::TraceContext& trace) {
+  if (trace.hop_size() == 0 ||
+      (trace.sensor() == last_sensor_ &&
+       trace.sensor_timestamp_sec() == last_sensor_timestamp_sec_)) {
+    return false;
+  }
+  last_sensor_ = trace.sensor();
+  last_sensor_timestamp_sec_ = trace.sensor_timestamp_sec();
+
+  std::string from = trace.sensor();
+  double from_time = trace.sensor_timestamp_sec();
+  for (const auto& hop : trace.hop()) {
+    MutableHop(from + "->" + hop.module_name())
+        ->Add((hop.timestamp_sec() - from_time) * 1e3, bucket_width_ms_);
+    from = hop.module_name();
+    from_time = hop.timestamp_sec();
+  }
+  total_.Add((from_time - trace.sensor_timestamp_sec()) * 1e3,
+             bucket_width_ms_);
+  return true;
+}
+
+void LatencyCollector::GetReport(LatencyReport* report) const {
+  total_.ToProto(bucket_width_ms_, report->mutable_total());
+  report->clear_hop();
+  for (const auto& hop : hops_) {
+    hop.ToProto(bucket_width_ms_, report->add_hop());
+  }
+}
+
+void LatencyCollector::Reset() {
+  total_ = Histogram(total_.name(), num_buckets_);
+  hops_.clear();
+}
+
+LatencyCollector::Histogram* LatencyCollector::MutableHop(
+    const std::string& name) {
+  for (auto& hop : hops_) {
+    if (hop.name() == name) {
+      return &hop;
+    }
+  }
+  hops_.emplace_back(name, num_buckets_);
+  return &hops_.back();
+}
+
+}  // namespace monitor
+}  // namespace apollo
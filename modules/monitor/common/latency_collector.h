@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "modules/common/proto/header.pb.h"
+#include "modules/monitor/proto/latency_report.pb.h"
+
+namespace apollo {
+namespace monitor {
+
+// Histograms of the total and per hop latencies of traced sensor frames.
+class LatencyCollector {
+ public:
+  LatencyCollector(const double bucket_width_ms, const int num_buckets);
+
+  // Adds the latencies of trace the first time its sensor frame shows up,
+  // returns false for the frame added last time or a trace without hops.
+  bool AddTrace(const apollo::common::TraceContext& trace);
+
+  // Fills the histograms of the traces added since the last Reset().
+  void GetReport(LatencyReport* report) const;
+  void Reset();
+
+ private:
+  class Histogram {
+   public:
+    Histogram(const std::string& name, const int num_buckets);
+    void Add(const double latency_ms, const double bucket_width_ms);
+    void ToProto(const double bucket_width_ms, LatencyHistogram* proto) const;
+    const std::string& name() const { return name_; }
+
+   private:
+    double Percentile(const double ratio, const double bucket_width_ms) const;
+
+    std::string name_;
+    std::vector<unsigned int> bucket_count_;
+    unsigned int count_ = 0;
+    double sum_ms_ = 0.0;
+    double max_ms_ = 0.0;
+  };
+
+  Histogram* MutableHop(const std::string& name);
+
+  const double bucket_width_ms_;
+  const int num_buckets_;
+  Histogram total_;
+  std::vector<Histogram> hops_;
+  std::string last_sensor_;
+  double last_sensor_timestamp_sec_ = 0.0;
+};
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/latency_collector.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+using apollo::common::TraceContext;
+
+// A lidar frame at t published by perception, prediction, planning and
+// control and sent by canbus, each hop_ms after the previous one.
+TraceContext MakeTrace(const double t, const double hop_ms) {
+  TraceContext trace;
+  trace.set_sensor("lidar");
+  trace.set_sensor_timestamp_sec(t);
+  double hop_time = t;
+  for (const char* module :
+       {"perception_obstacle", "prediction", "planning", "control", "canbus"}) {
+    hop_time += hop_ms * 1e-3;
+    auto* hop = trace.add_hop();
+    hop->set_module_name(module);
+    hop->set_timestamp_sec(hop_time);
+  }
+  return trace;
+}
+
+}  // namespace
+
+TEST(LatencyCollectorTest, Histograms) {
+  LatencyCollector collector(10.0, 20);
+  EXPECT_TRUE(collector.AddTrace(MakeTrace(100.0, 15.0)));
+  // The vehicle acts on a frame many times, only the first one counts.
+  EXPECT_FALSE(collector.AddTrace(MakeTrace(100.0, 20.0)));
+  EXPECT_FALSE(collector.AddTrace(TraceContext()));
+  EXPECT_TRUE(collector.AddTrace(MakeTrace(100.1, 25.0)));
+  EXPECT_TRUE(collector.AddTrace(MakeTrace(100.2, 50.0)));
+
+  LatencyReport report;
+  collector.GetReport(&report);
+  const auto& total = report.total();
+  EXPECT_EQ("total", total.name());
+  EXPECT_EQ(3, total.count());
+  EXPECT_NEAR((75.0 + 125.0 + 250.0) / 3.0, total.mean_ms(), 1e-6);
+  EXPECT_NEAR(250.0, total.max_ms(), 1e-6);
+  EXPECT_NEAR(130.0, total.p50_ms(), 1e-6);
+  // 250 ms is beyond the last bucket, whose percentiles are the max.
+  EXPECT_NEAR(250.0, total.p99_ms(), 1e-6);
+  ASSERT_EQ(20, total.bucket_count_size());
+  EXPECT_EQ(1, total.bucket_count(7));
+  EXPECT_EQ(1, total.bucket_count(12));
+  EXPECT_EQ(1, total.bucket_count(19));
+
+  ASSERT_EQ(5, report.hop_size());
+  EXPECT_EQ("lidar->perception_obstacle", report.hop(0).name());
+  EXPECT_EQ("control->canbus", report.hop(4).name());
+  EXPECT_EQ(3, report.hop(2).count());
+  EXPECT_NEAR(30.0, report.hop(2).mean_ms(), 1e-6);
+  EXPECT_NEAR(30.0, report.hop(2).p50_ms(), 1e-6);
+
+  collector.Reset();
+  collector.GetReport(&report);
+  EXPECT_EQ(0, report.total().count());
+  EXPECT_EQ(0, report.hop_size());
+  // The last frame is still known after a reset.
+  EXPECT_FALSE(collector.AddTrace(MakeTrace(100.2, 50.0)));
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -58,6 +59,20 @@ class MonitorManager {
     return std::dynamic_pointer_cast<cyber::Reader<T>>(readers_[channel]);
   }
 
+  // A reader calling back on every message. A node has one reader per
+  // channel, so it has to be created before any other reader of the channel,
+  // which then shares it.
+  template <class T>
+  std::shared_ptr<cyber::Reader<T>> CreateReader(
+      const std::string& channel,
+      const std::function<void(const std::shared_ptr<T>&)>& callback) {
+    auto reader = node_->CreateReader<T>(channel, callback);
+    if (reader != nullptr) {
+      readers_.emplace(channel, reader);
+    }
+    return reader;
+  }
+
   template <class T>
   std::shared_ptr<cyber::Writer<T>> CreateWriter(const std::string& channel) {
     return node_->CreateWriter<T>(channel);
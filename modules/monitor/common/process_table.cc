@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/process_table.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+// enough for a batch of process event messages
+constexpr size_t kEventBufferSize = 4096;
+
+constexpr size_t kReadSize = 4096;
+
+}  // namespace
+
+ProcessTable::ProcessTable(const bool listen_events)
+    : listen_events_(listen_events) {}
+
+ProcessTable::~ProcessTable() {
+  if (event_socket_ >= 0) {
+    close(event_socket_);
+  }
+}
+
+void ProcessTable::Update() {
+  if (!initialized_) {
+    initialized_ = true;
+    // Listen before the scan, so that no process started in between is
+    // missed.
+    if (listen_events_ && !Listen()) {
+      AINFO << "Process events are not available, scan /proc instead.";
+    }
+    Scan();
+    return;
+  }
+  if (event_socket_ < 0 || !ReadEvents()) {
+    Scan();
+    return;
+  }
+  std::string command;
+  for (const int pid : updated_pids_) {
+    if (ReadCommand(pid, &command)) {
+      commands_[pid] = command;
+    } else {
+      commands_.erase(pid);
+    }
+  }
+  updated_pids_.clear();
+}
+
+bool ProcessTable::Listen() {
+  event_socket_ = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                         NETLINK_CONNECTOR);
+  if (event_socket_ < 0) {
+    return false;
+  }
+  sockaddr_nl address = {};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = CN_IDX_PROC;
+  address.nl_pid = 0;
+  if (bind(event_socket_, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) != 0) {
+    close(event_socket_);
+    event_socket_ = -1;
+    return false;
+  }
+
+  // subscribe to the process events
+  alignas(nlmsghdr) char request[NLMSG_SPACE(sizeof(cn_msg) +
+                                             sizeof(proc_cn_mcast_op))] = {};
+  auto* header = reinterpret_cast<nlmsghdr*>(request);
+  header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+  header->nlmsg_type = NLMSG_DONE;
+  header->nlmsg_pid = static_cast<__u32>(getpid());
+  auto* message = reinterpret_cast<cn_msg*>(NLMSG_DATA(header));
+  message->id.idx = CN_IDX_PROC;
+  message->id.val = CN_VAL_PROC;
+  message->len = sizeof(proc_cn_mcast_op);
+  const proc_cn_mcast_op operation = PROC_CN_MCAST_LISTEN;
+  std::memcpy(message->data, &operation, sizeof(operation));
+  if (send(event_socket_, request, header->nlmsg_len, 0) < 0) {
+    close(event_socket_);
+    event_socket_ = -1;
+    return false;
+  }
+  return true;
+}
+
+bool ProcessTable::ReadEvents() {
+  alignas(nlmsghdr) char buffer[kEventBufferSize];
+  while (true) {
+    const ssize_t size = recv(event_socket_, buffer, sizeof(buffer), 0);
+    if (size < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      // ENOBUFS: the socket overflowed and events were dropped
+      ADEBUG << "Lost process events: " << std::strerror(errno);
+      return false;
+    }
+    int remaining = static_cast<int>(size);
+    for (auto* header = reinterpret_cast<nlmsghdr*>(buffer);
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      if (header->nlmsg_type == NLMSG_ERROR ||
+          header->nlmsg_type == NLMSG_NOOP) {
+        continue;
+      }
+      const auto* message = reinterpret_cast<const cn_msg*>(NLMSG_DATA(header));
+      if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC) {
+        continue;
+      }
+      const auto* event = reinterpret_cast<const proc_event*>(message->data);
+      switch (event->what) {
+        case proc_event::PROC_EVENT_FORK: {
+          // threads are forks within the same thread group
+          const auto& fork_event = event->event_data.fork;
+          if (fork_event.child_pid == fork_event.child_tgid) {
+            updated_pids_.insert(fork_event.child_tgid);
+          }
+          break;
+        }
+        case proc_event::PROC_EVENT_EXEC:
+          updated_pids_.insert(event->event_data.exec.process_tgid);
+          break;
+        case proc_event::PROC_EVENT_EXIT: {
+          const auto& exit_event = event->event_data.exit;
+          if (exit_event.process_pid == exit_event.process_tgid) {
+            updated_pids_.erase(exit_event.process_tgid);
+            commands_.erase(exit_event.process_tgid);
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+}
+
+void ProcessTable::Scan() {
+  updated_pids_.clear();
+  std::unordered_map<int, std::string> commands;
+  DIR* proc_dir = opendir("/proc");
+  if (proc_dir == nullptr) {
+    AERROR << "Failed to open /proc: " << std::strerror(errno);
+    commands_.clear();
+    return;
+  }
+  std::string command;
+  while (const dirent* entry = readdir(proc_dir)) {
+    char* end = nullptr;
+    const long pid = std::strtol(entry->d_name, &end, 10);  // NOLINT
+    if (end == entry->d_name || *end != '\0' || pid <= 0) {
+      continue;
+    }
+    // the command line of a known process is read again, as it may have
+    // exec'ed since
+    if (ReadCommand(static_cast<int>(pid), &command)) {
+      commands.emplace(static_cast<int>(pid), command);
+    }
+  }
+  closedir(proc_dir);
+  commands_ = std::move(commands);
+}
+
+bool ProcessTable::ReadCommand(const int pid, std::string* command) {
+  const std::string file = "/proc/" + std::to_string(pid) + "/cmdline";
+  const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  size_t size = 0;
+  while (true) {
+    if (buffer_.size() < size + kReadSize) {
+      buffer_.resize(size + kReadSize);
+    }
+    const ssize_t count = read(fd, buffer_.data() + size, kReadSize);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    size += static_cast<size_t>(count);
+  }
+  close(fd);
+  if (size == 0) {
+    return false;
+  }
+  // In /proc/<PID>/cmdline, the parts are seperated with \0, which will be
+  // converted back to whitespaces here.
+  command->assign(buffer_.data(), size);
+  std::replace(command->begin(), command->end(), '\0', ' ');
+  return true;
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace apollo {
+namespace monitor {
+
+// Command lines of the running processes by pid. The table is filled by one
+// scan of /proc, after which it follows the process events of the kernel
+// connector, so that only processes which were started or exec'ed since the
+// last update have their command line read. Listening to the events needs
+// CAP_NET_ADMIN, without it every update scans /proc again.
+class ProcessTable {
+ public:
+  explicit ProcessTable(const bool listen_events);
+  ~ProcessTable();
+
+  ProcessTable(const ProcessTable&) = delete;
+  ProcessTable& operator=(const ProcessTable&) = delete;
+
+  // Bring the table up to date with the running processes.
+  void Update();
+
+  // Command line of each running process, with the parts separated by
+  // whitespaces. Kernel threads have no command line and are left out.
+  const std::unordered_map<int, std::string>& commands() const {
+    return commands_;
+  }
+
+  // Whether the table follows process events rather than scanning /proc.
+  bool listening() const { return event_socket_ >= 0; }
+
+ private:
+  bool Listen();
+
+  // Apply the pending process events, returns false if some were lost.
+  bool ReadEvents();
+
+  void Scan();
+
+  bool ReadCommand(const int pid, std::string* command);
+
+  const bool listen_events_;
+  bool initialized_ = false;
+  int event_socket_ = -1;
+
+  std::unordered_map<int, std::string> commands_;
+  // processes started or exec'ed since the last update
+  std::unordered_set<int> updated_pids_;
+  // read buffer reused by the reads of all the command lines
+  std::vector<char> buffer_;
+};
+
+}  // namespace monitor
+}  // namespace apollo
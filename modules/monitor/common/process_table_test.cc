@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/process_table.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+void ExpectChildTracked(const bool listen_events) {
+  ProcessTable table(listen_events);
+  table.Update();
+  const int self = static_cast<int>(getpid());
+  ASSERT_EQ(1, table.commands().count(self));
+  EXPECT_NE(std::string::npos,
+            table.commands().at(self).find("process_table_test"));
+
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    execlp("sleep", "sleep", "30", nullptr);
+    _exit(1);
+  }
+  // let the child exec
+  usleep(200000);
+  table.Update();
+  ASSERT_EQ(1, table.commands().count(child));
+  EXPECT_EQ("sleep 30 ", table.commands().at(child));
+
+  kill(child, SIGKILL);
+  waitpid(child, nullptr, 0);
+  table.Update();
+  EXPECT_EQ(0, table.commands().count(child));
+}
+
+TEST(ProcessTableTest, ScanProcesses) { ExpectChildTracked(false); }
+
+TEST(ProcessTableTest, FollowProcessEvents) {
+  // falls back to scanning without the privilege to listen to the events
+  ExpectChildTracked(true);
+}
+
+}  // namespace monitor
+}  // namespace apollo
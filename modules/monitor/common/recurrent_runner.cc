@@ -25,6 +25,10 @@ RecurrentRunner::RecurrentRunner(const std::string &name, const double interval)
     : name_(name), interval_(interval) {}
 
 void RecurrentRunner::Tick(const double current_time) {
+  if (!started_) {
+    started_ = true;
+    next_round_ = current_time + first_round_delay_;
+  }
   if (next_round_ <= current_time) {
     ++round_count_;
     AINFO_EVERY(100) << name_ << " is running round #" << round_count_;
@@ -37,12 +37,20 @@ class RecurrentRunner {
   // Do the actual work.
   virtual void RunOnce(const double current_time) = 0;
 
+  // Delay the first round by the fraction of the interval, so that runners of
+  // the same interval take turns rather than running in the same frame.
+  void DelayFirstRound(const double fraction) {
+    first_round_delay_ = fraction * interval_;
+  }
+
  protected:
   std::string name_;
   unsigned int round_count_ = 0;
 
  private:
   double interval_;
+  double first_round_delay_ = 0;
+  bool started_ = false;
   double next_round_ = 0;
 };
 
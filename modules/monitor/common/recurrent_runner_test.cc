@@ -48,5 +48,20 @@ TEST(RecurrentRunnerTest, Tick) {
   EXPECT_EQ(3, runner.GetRoundCount());
 }
 
+TEST(RecurrentRunnerTest, DelayFirstRound) {
+  DummyRecurrentRunner runner(2);
+  runner.DelayFirstRound(0.5);
+
+  runner.Tick(0.1);  // Skipped. Next trigger time: 1.1
+  EXPECT_EQ(0, runner.GetRoundCount());
+
+  runner.Tick(1.1);  // Triggered. Next trigger time: 3.1
+  runner.Tick(3.0);  // Skipped. Next trigger time: 3.1
+  EXPECT_EQ(1, runner.GetRoundCount());
+
+  runner.Tick(3.1);  // Triggered. Next trigger time: 5.1
+  EXPECT_EQ(2, runner.GetRoundCount());
+}
+
 }  // namespace monitor
 }  // namespace apollo
@@ -23,6 +23,7 @@
 #include "modules/monitor/hardware/socket_can_monitor.h"
 #include "modules/monitor/software/channel_monitor.h"
 #include "modules/monitor/software/functional_safety_monitor.h"
+#include "modules/monitor/software/latency_monitor.h"
 #include "modules/monitor/software/localization_monitor.h"
 #include "modules/monitor/software/process_monitor.h"
 #include "modules/monitor/software/summary_monitor.h"
@@ -49,9 +50,18 @@ bool Monitor::Init() {
   runners_.emplace_back(new ProcessMonitor());
   // Monitor if channel messages are updated in time.
   runners_.emplace_back(new ChannelMonitor());
+  // Monitor the latency from sensor frames to the commands acting on them.
+  runners_.emplace_back(new LatencyMonitor());
   // Monitor if resources are sufficient.
   runners_.emplace_back(new ResourceMonitor());
 
+  // Spread the sub-monitors' rounds over their intervals, so that each frame
+  // runs few of them.
+  for (size_t i = 0; i < runners_.size(); ++i) {
+    runners_[i]->DelayFirstRound(static_cast<double>(i) /
+                                 static_cast<double>(runners_.size()));
+  }
+
   // Monitor all changes made by each sub-monitor, and summarize to a final
   // overall status.
   runners_.emplace_back(new SummaryMonitor());
@@ -19,21 +19,14 @@
 #include <memory>
 #include <string>
 
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/cyber.h"
-#include "modules/common/adapters/adapter_gflags.h"
-#include "modules/common/util/map_util.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/transport/shm/channel_stats.h"
 #include "modules/common/util/string_util.h"
-#include "modules/control/proto/control_cmd.pb.h"
-#include "modules/drivers/proto/conti_radar.pb.h"
-#include "modules/drivers/proto/pointcloud.pb.h"
-#include "modules/localization/proto/pose.pb.h"
-#include "modules/map/relative_map/proto/navigation.pb.h"
 #include "modules/monitor/common/monitor_manager.h"
 #include "modules/monitor/software/summary_monitor.h"
-#include "modules/perception/proto/perception_obstacle.pb.h"
-#include "modules/planning/proto/planning.pb.h"
-#include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 DEFINE_string(channel_monitor_name, "ChannelMonitor",
               "Name of the channel monitor.");
@@ -46,32 +39,21 @@ namespace monitor {
 namespace {
 using apollo::common::util::StrCat;
 
-// We have to specify exact type of each channel. This function is a wrapper for
-// those only need a ReaderBase.
-std::shared_ptr<cyber::ReaderBase> GetReader(const std::string& channel) {
-  auto manager = MonitorManager::Instance();
-  if (channel == FLAGS_control_command_topic) {
-    return manager->CreateReader<control::ControlCommand>(channel);
-  } else if (channel == FLAGS_localization_topic) {
-    return manager->CreateReader<localization::LocalizationEstimate>(channel);
-  } else if (channel == FLAGS_perception_obstacle_topic) {
-    return manager->CreateReader<perception::PerceptionObstacles>(channel);
-  } else if (channel == FLAGS_prediction_topic) {
-    return manager->CreateReader<prediction::PredictionObstacles>(channel);
-  } else if (channel == FLAGS_planning_trajectory_topic) {
-    return manager->CreateReader<planning::ADCTrajectory>(channel);
-  } else if (channel == FLAGS_conti_radar_topic) {
-    return manager->CreateReader<drivers::ContiRadar>(channel);
-  } else if (channel == FLAGS_relative_map_topic) {
-    return manager->CreateReader<relative_map::MapMsg>(channel);
-  } else if (channel == FLAGS_pointcloud_topic ||
-             channel == FLAGS_pointcloud_128_topic ||
-             channel == FLAGS_pointcloud_16_front_up_topic) {
-    return manager->CreateReader<drivers::PointCloud>(channel);
+// Seconds since the last publish counted by the writers of |channel| in shm,
+// which needs no reader. Returns false if nothing was counted on this host.
+bool GetPublishDelaySec(const std::string& channel, double* delay) {
+  const uint64_t channel_id =
+      cyber::common::GlobalData::RegisterChannel(channel);
+  cyber::transport::ChannelStatsInfo info;
+  if (!cyber::transport::ChannelStats::Instance()->Get(channel_id, &info) ||
+      info.msg_num == 0) {
+    return false;
   }
-  // Add more channels here if you want to monitor.
-  AERROR << "Channel is not handled by ChannelMonitor: " << channel;
-  return nullptr;
+  const uint64_t now = cyber::Time::Now().ToNanosecond();
+  *delay = now > info.last_publish_time
+               ? static_cast<double>(now - info.last_publish_time) * 1e-9
+               : 0.0;
+  return true;
 }
 
 }  // namespace
@@ -94,19 +76,39 @@ void ChannelMonitor::RunOnce(const double current_time) {
   }
 }
 
+std::shared_ptr<cyber::ReaderBase> ChannelMonitor::GetReader(
+    const std::string& channel) {
+  auto iter = readers_.find(channel);
+  if (iter != readers_.end()) {
+    return iter->second;
+  }
+  if (node_ == nullptr) {
+    node_ = cyber::CreateNode(FLAGS_channel_monitor_name);
+  }
+  std::shared_ptr<cyber::ReaderBase> reader =
+      node_->CreateReader<cyber::message::RawMessage>(channel);
+  if (reader != nullptr) {
+    readers_.emplace(channel, reader);
+  }
+  return reader;
+}
+
 void ChannelMonitor::UpdateStatus(
     const apollo::dreamview::ChannelMonitorConfig& config,
     ComponentStatus* status) {
   status->clear_status();
-  auto reader = GetReader(config.name());
-  if (reader == nullptr) {
-    SummaryMonitor::EscalateStatus(
-        ComponentStatus::UNKNOWN,
-        StrCat(config.name(), " is not registered in ChannelMonitor."), status);
-    return;
+  double delay = 0.0;
+  if (!GetPublishDelaySec(config.name(), &delay)) {
+    auto reader = GetReader(config.name());
+    if (reader == nullptr) {
+      SummaryMonitor::EscalateStatus(
+          ComponentStatus::UNKNOWN,
+          StrCat("Failed to read ", config.name(), " in ChannelMonitor."),
+          status);
+      return;
+    }
+    delay = reader->GetDelaySec();
   }
-
-  const double delay = reader->GetDelaySec();
   if (delay < 0 || delay > config.delay_fatal()) {
     SummaryMonitor::EscalateStatus(
         ComponentStatus::FATAL,
@@ -15,6 +15,11 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/cyber.h"
 #include "modules/dreamview/proto/hmi_mode.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/system_status.pb.h"
@@ -28,9 +33,16 @@ class ChannelMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
-  static void UpdateStatus(
-      const apollo::dreamview::ChannelMonitorConfig& config,
-      ComponentStatus* status);
+  void UpdateStatus(const apollo::dreamview::ChannelMonitorConfig& config,
+                    ComponentStatus* status);
+
+  // Reads the channel as raw bytes, which are never parsed.
+  std::shared_ptr<cyber::ReaderBase> GetReader(const std::string& channel);
+
+  // The readers have a node of their own, which can read the channels other
+  // monitors read with their own types.
+  std::unique_ptr<cyber::Node> node_;
+  std::unordered_map<std::string, std::shared_ptr<cyber::ReaderBase>> readers_;
 };
 
 }  // namespace monitor
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/latency_monitor.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/util/message_util.h"
+#include "modules/monitor/common/monitor_manager.h"
+
+DEFINE_string(latency_monitor_name, "LatencyMonitor",
+              "Name of the latency monitor.");
+
+DEFINE_double(latency_monitor_interval, 5,
+              "Latency report publishing interval in seconds.");
+
+DEFINE_double(latency_histogram_bucket_ms, 10,
+              "Width of the latency histogram buckets in milliseconds.");
+
+DEFINE_int32(latency_histogram_buckets, 50,
+             "Number of latency histogram buckets, the last one counting all "
+             "larger latencies.");
+
+namespace apollo {
+namespace monitor {
+
+using apollo::canbus::Chassis;
+
+LatencyMonitor::LatencyMonitor()
+    : RecurrentRunner(FLAGS_latency_monitor_name,
+                      FLAGS_latency_monitor_interval),
+      collector_(FLAGS_latency_histogram_bucket_ms,
+                 FLAGS_latency_histogram_buckets) {
+  auto manager = MonitorManager::Instance();
+  // Every chassis message is needed, which the polled readers drop. It is
+  // created before the first frame, which polls the chassis from it too.
+  reader_ = manager->CreateReader<Chassis>(
+      FLAGS_chassis_topic,
+      [this](const std::shared_ptr<Chassis>& chassis) { OnChassis(chassis); });
+  if (reader_ == nullptr) {
+    AERROR << "Failed to create the chassis reader of " << name_;
+  }
+  writer_ = manager->CreateWriter<LatencyReport>(FLAGS_latency_report_topic);
+}
+
+void LatencyMonitor::RunOnce(const double current_time) {
+  if (window_start_ <= 0.0) {
+    window_start_ = current_time;
+    return;
+  }
+
+  LatencyReport report;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collector_.GetReport(&report);
+    collector_.Reset();
+  }
+  report.set_window_start_sec(window_start_);
+  report.set_window_end_sec(current_time);
+  window_start_ = current_time;
+  apollo::common::util::FillHeader(FLAGS_latency_monitor_name, &report);
+  ADEBUG << report.ShortDebugString();
+  writer_->Write(report);
+}
+
+void LatencyMonitor::OnChassis(const std::shared_ptr<Chassis>& chassis) {
+  if (chassis->header().has_trace()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collector_.AddTrace(chassis->header().trace());
+  }
+}
+
+}  // namespace monitor
+}  // namespace apollo
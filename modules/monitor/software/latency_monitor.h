@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "cyber/cyber.h"
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/monitor/common/latency_collector.h"
+#include "modules/monitor/common/recurrent_runner.h"
+
+namespace apollo {
+namespace monitor {
+
+// Publishes the latency histograms of the sensor frames traced to the chassis
+// within each interval.
+class LatencyMonitor : public RecurrentRunner {
+ public:
+  LatencyMonitor();
+  void RunOnce(const double current_time) override;
+
+ private:
+  void OnChassis(const std::shared_ptr<apollo::canbus::Chassis>& chassis);
+
+  std::mutex mutex_;
+  LatencyCollector collector_;
+  std::shared_ptr<cyber::Reader<apollo::canbus::Chassis>> reader_;
+  std::shared_ptr<cyber::Writer<LatencyReport>> writer_;
+  double window_start_ = 0.0;
+};
+
+}  // namespace monitor
+}  // namespace apollo
@@ -16,7 +16,6 @@
 
 #include "modules/monitor/software/process_monitor.h"
 
-#include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "gflags/gflags.h"
 #include "modules/common/util/map_util.h"
@@ -29,27 +28,22 @@ DEFINE_string(process_monitor_name, "ProcessMonitor",
 DEFINE_double(process_monitor_interval, 1.5,
               "Process status checking interval in seconds.");
 
+DEFINE_bool(process_monitor_listen_events, true,
+            "Whether to follow the process events of the kernel instead of "
+            "scanning all the processes each round.");
+
 namespace apollo {
 namespace monitor {
 
 ProcessMonitor::ProcessMonitor()
     : RecurrentRunner(FLAGS_process_monitor_name,
-                      FLAGS_process_monitor_interval) {}
+                      FLAGS_process_monitor_interval),
+      process_table_(FLAGS_process_monitor_listen_events) {}
 
 void ProcessMonitor::RunOnce(const double current_time) {
   // Get running processes.
-  std::vector<std::string> running_processes;
-  for (const auto& cmd_file : cyber::common::Glob("/proc/*/cmdline")) {
-    // Get process command string.
-    std::string cmd_string;
-    if (cyber::common::GetContent(cmd_file, &cmd_string) &&
-        !cmd_string.empty()) {
-      // In /proc/<PID>/cmdline, the parts are seperated with \0, which will be
-      // converted back to whitespaces here.
-      std::replace(cmd_string.begin(), cmd_string.end(), '\0', ' ');
-      running_processes.push_back(cmd_string);
-    }
-  }
+  process_table_.Update();
+  const auto& running_processes = process_table_.commands();
 
   auto manager = MonitorManager::Instance();
   const auto& mode = manager->GetHMIMode();
@@ -76,11 +70,12 @@ void ProcessMonitor::RunOnce(const double current_time) {
 }
 
 void ProcessMonitor::UpdateStatus(
-    const std::vector<std::string>& running_processes,
+    const std::unordered_map<int, std::string>& running_processes,
     const apollo::dreamview::ProcessMonitorConfig& config,
     ComponentStatus* status) {
   status->clear_status();
-  for (const std::string& command : running_processes) {
+  for (const auto& process : running_processes) {
+    const std::string& command = process.second;
     bool all_keywords_matched = true;
     for (const std::string& keyword : config.command_keywords()) {
       if (command.find(keyword) == std::string::npos) {
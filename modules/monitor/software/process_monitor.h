@@ -16,9 +16,10 @@
 #pragma once
 
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 #include "modules/dreamview/proto/hmi_mode.pb.h"
+#include "modules/monitor/common/process_table.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/system_status.pb.h"
 
@@ -32,9 +33,11 @@ class ProcessMonitor : public RecurrentRunner {
 
  private:
   static void UpdateStatus(
-      const std::vector<std::string>& running_processes,
+      const std::unordered_map<int, std::string>& running_processes,
       const apollo::dreamview::ProcessMonitorConfig& config,
       ComponentStatus* status);
+
+  ProcessTable process_table_;
 };
 
 }  // namespace monitor
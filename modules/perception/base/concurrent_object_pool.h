@@ -15,6 +15,8 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <memory>
@@ -31,6 +33,10 @@ namespace base {
 
 static const size_t kPoolDefaultExtendNum = 10;
 static const size_t kPoolDefaultSize = 100;
+// @brief number of per-thread caches of a concurrent object pool
+static const size_t kPoolMagazineNum = 16;
+// @brief objects a per-thread cache holds before it gives half of them back
+static const size_t kPoolMagazineSize = 32;
 
 // @brief default initializer used in concurrent object pool
 template <class T>
@@ -38,6 +44,11 @@ struct ObjectPoolDefaultInitializer {
   void operator()(T* t) const {}
 };
 // @brief concurrent object pool with dynamic size
+//        Every thread gets and releases objects through a small cache of its
+//        own (magazine), refilled from and flushed to the shared free list a
+//        batch at a time, so the shared mutex is only taken once per batch.
+//        The pool grows in bulk, by at least half of its capacity, up to an
+//        optional high water mark.
 template <class ObjectType, size_t N = kPoolDefaultSize,
           class Initializer = ObjectPoolDefaultInitializer<ObjectType>>
 class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
@@ -55,20 +66,19 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
     ObjectType* ptr = nullptr;
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        Add(1 + kPoolDefaultExtendNum);
+      Magazine& magazine = magazines_[MagazineIndex()];
+      std::lock_guard<std::mutex> lock(magazine.mutex);
+      if (magazine.objects.empty()) {
+        Refill(1, &magazine.objects);
+      }
+      if (!magazine.objects.empty()) {
+        ptr = magazine.objects.back();
+        magazine.objects.pop_back();
       }
-      ptr = queue_.front();
-      queue_.pop();
     }
     // For efficiency consideration, intialization should be invoked
     // after releasing the mutex
-    kInitializer(ptr);
-    return std::shared_ptr<ObjectType>(ptr, [&](ObjectType* obj_ptr) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(obj_ptr);
-    });
+    return Wrap(ptr);
 #else
     return std::shared_ptr<ObjectType>(new ObjectType);
 #endif
@@ -79,26 +89,12 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num,
                 std::vector<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
+    std::vector<ObjectType*> buffer;
+    Acquire(num, &buffer);
     // For efficiency consideration, intialization should be invoked
     // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      data->emplace_back(
-          std::shared_ptr<ObjectType>(buffer[i], [&](ObjectType* obj_ptr) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(obj_ptr);
-          }));
+      data->emplace_back(Wrap(i < buffer.size() ? buffer[i] : nullptr));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -113,32 +109,14 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::list<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
+    std::vector<ObjectType*> buffer;
+    Acquire(num, &buffer);
     // For efficiency consideration, intialization should be invoked
     // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      auto ptr = Wrap(i < buffer.size() ? buffer[i] : nullptr);
+      is_front ? data->emplace_front(std::move(ptr))
+               : data->emplace_back(std::move(ptr));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -155,30 +133,12 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::deque<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
+    std::vector<ObjectType*> buffer;
+    Acquire(num, &buffer);
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      auto ptr = Wrap(i < buffer.size() ? buffer[i] : nullptr);
+      is_front ? data->emplace_front(std::move(ptr))
+               : data->emplace_back(std::move(ptr));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -197,8 +157,21 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
     }
   }
   // @brief get remained object number
-  size_t RemainedNum() override { return queue_.size(); }
+  size_t RemainedNum() override {
+    size_t num = 0;
+    for (auto& magazine : magazines_) {
+      std::lock_guard<std::mutex> lock(magazine.mutex);
+      num += magazine.objects.size();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num + queue_.size();
+  }
 #endif
+  // @brief limit of the automatic growth, 0 for unlimited. Objects asked for
+  //        beyond it are allocated one by one and not pooled.
+  void set_high_water_mark(size_t high_water_mark) {
+    high_water_mark_ = high_water_mark;
+  }
   // @brief destructor to release the cached memory
   ~ConcurrentObjectPool() override {
     if (cache_) {
@@ -206,21 +179,93 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
       cache_ = nullptr;
     }
     for (auto& ptr : extended_cache_) {
-      delete ptr;
+      delete[] ptr;
     }
     extended_cache_.clear();
   }
 
  protected:
-// @brief add num objects, should add lock before invoke this function
+  struct alignas(64) Magazine {
+    std::mutex mutex;
+    std::vector<ObjectType*> objects;
+  };
+
 #ifndef PERCEPTION_BASE_DISABLE_POOL
+  static size_t MagazineIndex() {
+    static std::atomic<size_t> next_index(0);
+    static thread_local size_t index = next_index.fetch_add(1);
+    return index % kPoolMagazineNum;
+  }
+  // @brief add num objects in one allocation, should add lock before invoke
+  //        this function
   void Add(size_t num) {
+    ObjectType* ptr = new ObjectType[num];
+    extended_cache_.push_back(ptr);
     for (size_t i = 0; i < num; ++i) {
-      ObjectType* ptr = new ObjectType;
-      extended_cache_.push_back(ptr);
-      queue_.push(ptr);
+      queue_.push_back(&ptr[i]);
+    }
+    capacity_ += num;
+  }
+  // @brief grow for at least num more objects, as far as the high water mark
+  //        allows, should add lock before invoke this function
+  void Grow(size_t num) {
+    num = std::max(num, std::max(kPoolDefaultExtendNum, capacity_ / 2));
+    size_t limit = high_water_mark_.load();
+    if (limit > 0) {
+      num = capacity_ < limit ? std::min(num, limit - capacity_) : 0;
+    }
+    if (num > 0) {
+      Add(num);
+    }
+  }
+  // @brief move at least num objects, and up to half a magazine, from the
+  //        shared list into objects
+  void Refill(size_t num, std::vector<ObjectType*>* objects) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() < num) {
+      Grow(num - queue_.size());
     }
-    capacity_ = kDefaultCacheSize + extended_cache_.size();
+    num = std::min(queue_.size(), std::max(num, kPoolMagazineSize / 2));
+    objects->insert(objects->end(), queue_.end() - num, queue_.end());
+    queue_.resize(queue_.size() - num);
+  }
+  // @brief take num objects, from the magazine of this thread first,
+  //        buffer may get less when the high water mark is reached
+  void Acquire(size_t num, std::vector<ObjectType*>* buffer) {
+    buffer->reserve(num);
+    Magazine& magazine = magazines_[MagazineIndex()];
+    std::lock_guard<std::mutex> lock(magazine.mutex);
+    auto& objects = magazine.objects;
+    if (objects.size() < num) {
+      Refill(num - objects.size(), &objects);
+    }
+    num = std::min(num, objects.size());
+    buffer->insert(buffer->end(), objects.end() - num, objects.end());
+    objects.resize(objects.size() - num);
+  }
+  // @brief give ptr back through the magazine of this thread
+  void Release(ObjectType* ptr) {
+    Magazine& magazine = magazines_[MagazineIndex()];
+    std::lock_guard<std::mutex> lock(magazine.mutex);
+    auto& objects = magazine.objects;
+    if (objects.size() >= kPoolMagazineSize) {
+      std::lock_guard<std::mutex> global_lock(mutex_);
+      size_t num = kPoolMagazineSize / 2;
+      queue_.insert(queue_.end(), objects.end() - num, objects.end());
+      objects.resize(objects.size() - num);
+    }
+    objects.push_back(ptr);
+  }
+  // @brief nullptr means the pool is exhausted, the object is not pooled then
+  std::shared_ptr<ObjectType> Wrap(ObjectType* ptr) {
+    if (ptr == nullptr) {
+      ptr = new ObjectType;
+      kInitializer(ptr);
+      return std::shared_ptr<ObjectType>(ptr);
+    }
+    kInitializer(ptr);
+    return std::shared_ptr<ObjectType>(
+        ptr, [this](ObjectType* obj_ptr) { Release(obj_ptr); });
   }
 #endif
   // @brief default constructor
@@ -228,22 +273,31 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
       : kDefaultCacheSize(default_size) {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
     cache_ = new ObjectType[kDefaultCacheSize];
+    queue_.reserve(kDefaultCacheSize);
     for (size_t i = 0; i < kDefaultCacheSize; ++i) {
-      queue_.push(&cache_[i]);
+      queue_.push_back(&cache_[i]);
     }
     capacity_ = kDefaultCacheSize;
 #endif
   }
   std::mutex mutex_;
-  std::queue<ObjectType*> queue_;
+  // @brief shared free list, used as a stack to keep recent objects warm
+  std::vector<ObjectType*> queue_;
+  Magazine magazines_[kPoolMagazineNum];
   // @brief point to a continuous memory of default pool size
   ObjectType* cache_ = nullptr;
   const size_t kDefaultCacheSize;
-  // @brief list to store extended memory, not as efficient
+  // @brief list to store extended memory, one array per growth
   std::list<ObjectType*> extended_cache_;
+  std::atomic<size_t> high_water_mark_{0};
   static const Initializer kInitializer;
 };
 
+template <class ObjectType, size_t N, class Initializer>
+const Initializer
+    ConcurrentObjectPool<ObjectType, N, Initializer>::kInitializer =
+        Initializer();
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/memory_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include "cyber/common/log.h"
+#include "modules/perception/base/common.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+constexpr size_t kMinBlockSize = 512;
+constexpr size_t kLargeBlockSize = 1 << 20;
+
+#ifndef PERCEPTION_CPU_ONLY
+void* RawMallocHost(size_t size) {
+  void* ptr = nullptr;
+  if (cudaMallocHost(&ptr, size) != cudaSuccess) {
+    cudaGetLastError();
+    return nullptr;
+  }
+  return ptr;
+}
+
+void RawFreeHost(void* ptr) { BASE_CUDA_CHECK(cudaFreeHost(ptr)); }
+
+void* RawMallocDevice(int device, size_t size) {
+  int current = 0;
+  BASE_CUDA_CHECK(cudaGetDevice(&current));
+  if (current != device) {
+    BASE_CUDA_CHECK(cudaSetDevice(device));
+  }
+  void* ptr = nullptr;
+  if (cudaMalloc(&ptr, size) != cudaSuccess) {
+    cudaGetLastError();
+    ptr = nullptr;
+  }
+  if (current != device) {
+    BASE_CUDA_CHECK(cudaSetDevice(current));
+  }
+  return ptr;
+}
+
+void RawFreeDevice(void* ptr) { BASE_CUDA_CHECK(cudaFree(ptr)); }
+#else
+void* RawMallocHost(size_t size) { return malloc(size); }
+
+void RawFreeHost(void* ptr) { free(ptr); }
+#endif
+
+}  // namespace
+
+size_t CachingAllocator::RoundSize(size_t size) {
+  if (size <= kMinBlockSize) {
+    return kMinBlockSize;
+  }
+  size_t power = kMinBlockSize;
+  while (power < size) {
+    power <<= 1;
+  }
+  if (power <= kLargeBlockSize) {
+    return power;
+  }
+  const size_t step = power / 8;
+  return (size + step - 1) / step * step;
+}
+
+void* CachingAllocator::Allocate(size_t size) {
+  const size_t class_size = RoundSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  void* ptr = nullptr;
+  auto iter = free_blocks_.find(class_size);
+  if (iter != free_blocks_.end() && !iter->second.empty()) {
+    ptr = iter->second.back();
+    iter->second.pop_back();
+    stats_.bytes_cached -= class_size;
+    ++stats_.num_cache_hits;
+  } else {
+    ptr = raw_alloc_(class_size);
+    if (ptr == nullptr && stats_.bytes_cached > 0) {
+      AINFO << "Memory pool releases " << stats_.bytes_cached
+            << " cached bytes to allocate " << class_size;
+      ReleaseLocked();
+      ptr = raw_alloc_(class_size);
+    }
+    if (ptr == nullptr) {
+      AERROR << "Memory pool failed to allocate " << class_size << " bytes";
+      return nullptr;
+    }
+    ++stats_.num_raw_allocs;
+  }
+  used_blocks_[ptr] = Block{class_size, size};
+  ++stats_.num_allocs;
+  stats_.bytes_requested += size;
+  stats_.bytes_in_use += class_size;
+  stats_.peak_bytes_in_use =
+      std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+  stats_.peak_bytes_reserved =
+      std::max(stats_.peak_bytes_reserved, stats_.bytes_reserved());
+  return ptr;
+}
+
+bool CachingAllocator::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = used_blocks_.find(ptr);
+  if (iter == used_blocks_.end()) {
+    return false;
+  }
+  const Block block = iter->second;
+  used_blocks_.erase(iter);
+  free_blocks_[block.class_size].push_back(ptr);
+  stats_.bytes_requested -= block.requested;
+  stats_.bytes_in_use -= block.class_size;
+  stats_.bytes_cached += block.class_size;
+  return true;
+}
+
+bool CachingAllocator::Reserve(size_t size, size_t count) {
+  const size_t class_size = RoundSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& blocks = free_blocks_[class_size];
+  for (size_t i = 0; i < count; ++i) {
+    void* ptr = raw_alloc_(class_size);
+    if (ptr == nullptr) {
+      AERROR << "Memory pool failed to reserve " << class_size << " bytes";
+      return false;
+    }
+    blocks.push_back(ptr);
+    ++stats_.num_raw_allocs;
+    stats_.bytes_cached += class_size;
+  }
+  stats_.peak_bytes_reserved =
+      std::max(stats_.peak_bytes_reserved, stats_.bytes_reserved());
+  return true;
+}
+
+void CachingAllocator::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ReleaseLocked();
+}
+
+void CachingAllocator::ReleaseLocked() {
+  for (auto& blocks : free_blocks_) {
+    for (void* ptr : blocks.second) {
+      raw_free_(ptr);
+      ++stats_.num_raw_frees;
+    }
+  }
+  free_blocks_.clear();
+  stats_.bytes_cached = 0;
+}
+
+MemoryPoolStats CachingAllocator::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+MemoryPool::MemoryPool() : host_allocator_(RawMallocHost, RawFreeHost) {}
+
+void* MemoryPool::MallocHost(size_t size) {
+  return enabled_ ? host_allocator_.Allocate(size) : RawMallocHost(size);
+}
+
+void MemoryPool::FreeHost(void* ptr) {
+  if (!host_allocator_.Free(ptr)) {
+    RawFreeHost(ptr);
+  }
+}
+
+void* MemoryPool::MallocDevice(size_t size) {
+#ifndef PERCEPTION_CPU_ONLY
+  int device = 0;
+  BASE_CUDA_CHECK(cudaGetDevice(&device));
+  return enabled_ ? DeviceAllocator(device)->Allocate(size)
+                  : RawMallocDevice(device, size);
+#else
+  NO_GPU;
+  return nullptr;
+#endif
+}
+
+void MemoryPool::FreeDevice(void* ptr) {
+#ifndef PERCEPTION_CPU_ONLY
+  if (ptr == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(device_mutex_);
+    for (auto& allocator : device_allocators_) {
+      if (allocator.second->Free(ptr)) {
+        return;
+      }
+    }
+  }
+  RawFreeDevice(ptr);
+#else
+  NO_GPU;
+#endif
+}
+
+bool MemoryPool::PreallocateHost(size_t bytes, size_t block_size) {
+  block_size = std::max<size_t>(block_size, 1);
+  return host_allocator_.Reserve(block_size,
+                                 (bytes + block_size - 1) / block_size);
+}
+
+bool MemoryPool::PreallocateDevice(size_t bytes, size_t block_size) {
+#ifndef PERCEPTION_CPU_ONLY
+  int device = 0;
+  BASE_CUDA_CHECK(cudaGetDevice(&device));
+  block_size = std::max<size_t>(block_size, 1);
+  return DeviceAllocator(device)->Reserve(
+      block_size, (bytes + block_size - 1) / block_size);
+#else
+  NO_GPU;
+  return false;
+#endif
+}
+
+void MemoryPool::Release() {
+  host_allocator_.Release();
+  std::lock_guard<std::mutex> lock(device_mutex_);
+  for (auto& allocator : device_allocators_) {
+    allocator.second->Release();
+  }
+}
+
+MemoryPoolStats MemoryPool::HostStats() const {
+  return host_allocator_.stats();
+}
+
+MemoryPoolStats MemoryPool::DeviceStats(int device) const {
+  std::lock_guard<std::mutex> lock(device_mutex_);
+  auto iter = device_allocators_.find(device);
+  return iter == device_allocators_.end() ? MemoryPoolStats()
+                                          : iter->second->stats();
+}
+
+CachingAllocator* MemoryPool::DeviceAllocator(int device) {
+  std::lock_guard<std::mutex> lock(device_mutex_);
+  auto& allocator = device_allocators_[device];
+  if (allocator == nullptr) {
+#ifndef PERCEPTION_CPU_ONLY
+    allocator.reset(new CachingAllocator(
+        [device](size_t size) { return RawMallocDevice(device, size); },
+        RawFreeDevice));
+#else
+    allocator.reset(new CachingAllocator(RawMallocHost, RawFreeHost));
+#endif
+  }
+  return allocator.get();
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+struct MemoryPoolStats {
+  // requests served, and how many of them came from the cache
+  size_t num_allocs = 0;
+  size_t num_cache_hits = 0;
+  // calls into the backing allocator
+  size_t num_raw_allocs = 0;
+  size_t num_raw_frees = 0;
+  // bytes asked for by the blocks in use
+  size_t bytes_requested = 0;
+  // size class bytes of the blocks in use, and of the cached free blocks
+  size_t bytes_in_use = 0;
+  size_t bytes_cached = 0;
+  size_t peak_bytes_in_use = 0;
+  size_t peak_bytes_reserved = 0;
+
+  size_t bytes_reserved() const { return bytes_in_use + bytes_cached; }
+  // share of the reserved bytes not holding requested data
+  double fragmentation() const {
+    return bytes_reserved() == 0
+               ? 0.0
+               : 1.0 - static_cast<double>(bytes_requested) /
+                           static_cast<double>(bytes_reserved());
+  }
+};
+
+// Keeps freed blocks on per size class free lists instead of returning them
+// to the backing allocator, so that reshaping blobs back and forth does not
+// end up in cudaMalloc/cudaFree once the pool is warm.
+class CachingAllocator {
+ public:
+  using RawAlloc = std::function<void*(size_t)>;
+  using RawFree = std::function<void(void*)>;
+
+  CachingAllocator(RawAlloc raw_alloc, RawFree raw_free)
+      : raw_alloc_(raw_alloc), raw_free_(raw_free) {}
+  CachingAllocator(const CachingAllocator&) = delete;
+  CachingAllocator& operator=(const CachingAllocator&) = delete;
+  // blocks still in use are left to their owners
+  ~CachingAllocator() { Release(); }
+
+  // returns nullptr when the backing allocator fails even after the cache
+  // has been released
+  void* Allocate(size_t size);
+  // returns false if ptr was not allocated here
+  bool Free(void* ptr);
+  // fills the free list of the size class of size with count blocks
+  bool Reserve(size_t size, size_t count);
+  // returns all cached blocks to the backing allocator
+  void Release();
+  MemoryPoolStats stats() const;
+
+  // power of two classes up to 1MB, four classes per power of two above,
+  // which bounds the rounding waste of large blobs to 25%
+  static size_t RoundSize(size_t size);
+
+ private:
+  struct Block {
+    size_t class_size = 0;
+    size_t requested = 0;
+  };
+
+  void ReleaseLocked();
+
+  RawAlloc raw_alloc_;
+  RawFree raw_free_;
+  mutable std::mutex mutex_;
+  std::map<size_t, std::vector<void*>> free_blocks_;
+  std::unordered_map<void*, Block> used_blocks_;
+  MemoryPoolStats stats_;
+};
+
+// Process wide pinned host and per device memory pools behind SyncedMemory
+// and PerceptionMallocHost.
+class MemoryPool {
+ public:
+  // never destroyed, blocks may be freed during static destruction
+  static MemoryPool& Instance() {
+    static MemoryPool* pool = new MemoryPool;
+    return *pool;
+  }
+
+  // blocks allocated while enabled are still returned to the pool when
+  // freed after disabling it
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+
+  void* MallocHost(size_t size);
+  void FreeHost(void* ptr);
+  // on the current device
+  void* MallocDevice(size_t size);
+  void FreeDevice(void* ptr);
+
+  // allocates about bytes in blocks of block_size up front, the device
+  // memory on the current device
+  bool PreallocateHost(size_t bytes, size_t block_size);
+  bool PreallocateDevice(size_t bytes, size_t block_size);
+  void Release();
+
+  MemoryPoolStats HostStats() const;
+  MemoryPoolStats DeviceStats(int device) const;
+
+ private:
+  MemoryPool();
+  MemoryPool(const MemoryPool&) = delete;
+  MemoryPool& operator=(const MemoryPool&) = delete;
+
+  CachingAllocator* DeviceAllocator(int device);
+
+  bool enabled_ = true;
+  CachingAllocator host_allocator_;
+  mutable std::mutex device_mutex_;
+  std::map<int, std::unique_ptr<CachingAllocator>> device_allocators_;
+};
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
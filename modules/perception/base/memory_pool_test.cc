@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/memory_pool.h"
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+TEST(CachingAllocatorTest, round_size) {
+  EXPECT_EQ(CachingAllocator::RoundSize(0), 512);
+  EXPECT_EQ(CachingAllocator::RoundSize(513), 1024);
+  EXPECT_EQ(CachingAllocator::RoundSize(1 << 20), 1 << 20);
+  EXPECT_EQ(CachingAllocator::RoundSize((1 << 20) + 1), 5 << 18);
+  EXPECT_EQ(CachingAllocator::RoundSize(7 << 20), 7 << 20);
+}
+
+TEST(CachingAllocatorTest, reuse_and_stats) {
+  int num_raw_allocs = 0;
+  int num_raw_frees = 0;
+  {
+    CachingAllocator allocator(
+        [&](size_t size) {
+          ++num_raw_allocs;
+          return malloc(size);
+        },
+        [&](void* ptr) {
+          ++num_raw_frees;
+          free(ptr);
+        });
+    void* ptr = allocator.Allocate(1000);
+    ASSERT_NE(ptr, nullptr);
+    MemoryPoolStats stats = allocator.stats();
+    EXPECT_EQ(stats.bytes_requested, 1000);
+    EXPECT_EQ(stats.bytes_in_use, 1024);
+    EXPECT_NEAR(stats.fragmentation(), 24.0 / 1024.0, 1e-9);
+
+    EXPECT_TRUE(allocator.Free(ptr));
+    int dummy = 0;
+    EXPECT_FALSE(allocator.Free(&dummy));
+    EXPECT_EQ(allocator.stats().bytes_cached, 1024);
+
+    // same size class is served from the cache
+    void* reused = allocator.Allocate(900);
+    EXPECT_EQ(reused, ptr);
+    EXPECT_EQ(num_raw_allocs, 1);
+    void* other = allocator.Allocate(4000);
+    EXPECT_EQ(num_raw_allocs, 2);
+
+    stats = allocator.stats();
+    EXPECT_EQ(stats.num_allocs, 3);
+    EXPECT_EQ(stats.num_cache_hits, 1);
+    EXPECT_EQ(stats.peak_bytes_in_use, 1024 + 4096);
+    EXPECT_TRUE(allocator.Free(reused));
+    EXPECT_TRUE(allocator.Free(other));
+    EXPECT_EQ(allocator.stats().bytes_in_use, 0);
+
+    allocator.Release();
+    EXPECT_EQ(num_raw_frees, 2);
+    EXPECT_EQ(allocator.stats().bytes_cached, 0);
+  }
+  EXPECT_EQ(num_raw_frees, 2);
+}
+
+TEST(CachingAllocatorTest, reserve) {
+  CachingAllocator allocator([](size_t size) { return malloc(size); },
+                             [](void* ptr) { free(ptr); });
+  EXPECT_TRUE(allocator.Reserve(3000, 2));
+  EXPECT_EQ(allocator.stats().bytes_cached, 8192);
+  void* first = allocator.Allocate(4096);
+  void* second = allocator.Allocate(2049);
+  void* third = allocator.Allocate(4000);
+  MemoryPoolStats stats = allocator.stats();
+  EXPECT_EQ(stats.num_cache_hits, 2);
+  EXPECT_EQ(stats.num_raw_allocs, 3);
+  EXPECT_TRUE(allocator.Free(first));
+  EXPECT_TRUE(allocator.Free(second));
+  EXPECT_TRUE(allocator.Free(third));
+
+  // a failing backing allocator gets the cache released and retried once
+  int num_attempts = 0;
+  CachingAllocator failing(
+      [&](size_t size) -> void* {
+        ++num_attempts;
+        return nullptr;
+      },
+      [](void* ptr) {});
+  EXPECT_EQ(failing.Allocate(100), nullptr);
+  EXPECT_EQ(num_attempts, 1);
+}
+
+TEST(MemoryPoolTest, host) {
+  MemoryPool& pool = MemoryPool::Instance();
+  void* ptr = pool.MallocHost(100);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(pool.HostStats().bytes_requested, 100);
+  pool.FreeHost(ptr);
+  EXPECT_EQ(pool.HostStats().bytes_cached, 512);
+
+  pool.set_enabled(false);
+  ptr = pool.MallocHost(100);
+  EXPECT_EQ(pool.HostStats().num_allocs, 1);
+  pool.FreeHost(ptr);
+  pool.set_enabled(true);
+
+  EXPECT_TRUE(pool.PreallocateHost(4096, 1024));
+  EXPECT_EQ(pool.HostStats().bytes_cached, 512 + 4096);
+  pool.Release();
+  EXPECT_EQ(pool.HostStats().bytes_cached, 0);
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
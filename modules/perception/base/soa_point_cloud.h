@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "Eigen/StdVector"
+
+#include "modules/perception/base/point.h"
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+template <typename T>
+using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+// @brief read-only view of a range of a SoAPointCloud, does not copy points
+template <typename T>
+struct SoAPointCloudView {
+  const T* x = nullptr;
+  const T* y = nullptr;
+  const T* z = nullptr;
+  const T* intensity = nullptr;
+  size_t size = 0;
+
+  // @brief view of the points in [begin, end) of this view
+  SoAPointCloudView Slice(size_t begin, size_t end) const {
+    end = std::min(end, size);
+    begin = std::min(begin, end);
+    SoAPointCloudView view;
+    view.x = x + begin;
+    view.y = y + begin;
+    view.z = z + begin;
+    view.intensity = intensity + begin;
+    view.size = end - begin;
+    return view;
+  }
+};
+
+// @brief point cloud with one aligned array per coordinate, so that passes
+// reading only some of the coordinates touch only their arrays, and loops
+// over the arrays can be vectorized
+template <typename T>
+class SoAPointCloud {
+ public:
+  using Type = T;
+  // @brief default constructor
+  SoAPointCloud() = default;
+  // @brief construct from an array of structs point cloud
+  template <typename PointT>
+  explicit SoAPointCloud(const PointCloud<PointT>& pc) {
+    FromPointCloud(pc);
+  }
+
+  // @brief accessor of point size
+  inline size_t size() const { return x_.size(); }
+  inline bool empty() const { return x_.empty(); }
+  inline void reserve(size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+  }
+  inline void resize(size_t size) {
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+    intensity_.resize(size);
+  }
+  inline void clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+  }
+  inline void push_back(const Point<T>& point) {
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+    z_.push_back(point.z);
+    intensity_.push_back(point.intensity);
+  }
+
+  // @brief accessor of coordinates via 1d index
+  inline T x(size_t i) const { return x_[i]; }
+  inline T y(size_t i) const { return y_[i]; }
+  inline T z(size_t i) const { return z_[i]; }
+  inline T intensity(size_t i) const { return intensity_[i]; }
+  inline T& x(size_t i) { return x_[i]; }
+  inline T& y(size_t i) { return y_[i]; }
+  inline T& z(size_t i) { return z_[i]; }
+  inline T& intensity(size_t i) { return intensity_[i]; }
+  inline Point<T> point(size_t i) const {
+    Point<T> point;
+    point.x = x_[i];
+    point.y = y_[i];
+    point.z = z_[i];
+    point.intensity = intensity_[i];
+    return point;
+  }
+
+  // @brief accessor of the coordinate arrays
+  inline const T* x_data() const { return x_.data(); }
+  inline const T* y_data() const { return y_.data(); }
+  inline const T* z_data() const { return z_.data(); }
+  inline const T* intensity_data() const { return intensity_.data(); }
+  inline T* mutable_x_data() { return x_.data(); }
+  inline T* mutable_y_data() { return y_.data(); }
+  inline T* mutable_z_data() { return z_.data(); }
+  inline T* mutable_intensity_data() { return intensity_.data(); }
+
+  // @brief view of all points, valid until the cloud is resized
+  inline SoAPointCloudView<T> View() const {
+    SoAPointCloudView<T> view;
+    view.x = x_.data();
+    view.y = y_.data();
+    view.z = z_.data();
+    view.intensity = intensity_.data();
+    view.size = size();
+    return view;
+  }
+  inline SoAPointCloudView<T> View(size_t begin, size_t end) const {
+    return View().Slice(begin, end);
+  }
+
+  // @brief copy points from an array of structs point cloud
+  template <typename PointT>
+  void FromPointCloud(const PointCloud<PointT>& pc) {
+    resize(pc.size());
+    for (size_t i = 0; i < pc.size(); ++i) {
+      const auto& pt = pc[i];
+      x_[i] = static_cast<T>(pt.x);
+      y_[i] = static_cast<T>(pt.y);
+      z_[i] = static_cast<T>(pt.z);
+      intensity_[i] = static_cast<T>(pt.intensity);
+    }
+  }
+  template <typename PointT, typename IndexType>
+  void FromPointCloud(const PointCloud<PointT>& pc,
+                      const std::vector<IndexType>& indices) {
+    resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const auto& pt = pc[indices[i]];
+      x_[i] = static_cast<T>(pt.x);
+      y_[i] = static_cast<T>(pt.y);
+      z_[i] = static_cast<T>(pt.z);
+      intensity_[i] = static_cast<T>(pt.intensity);
+    }
+  }
+  // @brief write points into an array of structs point cloud, only the
+  // coordinates and intensity of its points are set
+  template <typename PointT>
+  void ToPointCloud(PointCloud<PointT>* pc) const {
+    pc->resize(size());
+    for (size_t i = 0; i < size(); ++i) {
+      auto& pt = pc->at(i);
+      pt.x = static_cast<typename PointT::Type>(x_[i]);
+      pt.y = static_cast<typename PointT::Type>(y_[i]);
+      pt.z = static_cast<typename PointT::Type>(z_[i]);
+      pt.intensity = static_cast<typename PointT::Type>(intensity_[i]);
+    }
+  }
+
+  // @brief transform all points in place by an affine pose
+  void TransformPointCloud(const Eigen::Affine3d& pose) {
+    const Eigen::Matrix3d& r = pose.linear();
+    const Eigen::Vector3d& t = pose.translation();
+    T* __restrict__ xs = x_.data();
+    T* __restrict__ ys = y_.data();
+    T* __restrict__ zs = z_.data();
+    const size_t n = size();
+    for (size_t i = 0; i < n; ++i) {
+      const double px = xs[i];
+      const double py = ys[i];
+      const double pz = zs[i];
+      xs[i] = static_cast<T>(r(0, 0) * px + r(0, 1) * py + r(0, 2) * pz + t(0));
+      ys[i] = static_cast<T>(r(1, 0) * px + r(1, 1) * py + r(1, 2) * pz + t(1));
+      zs[i] = static_cast<T>(r(2, 0) * px + r(2, 1) * py + r(2, 2) * pz + t(2));
+    }
+  }
+
+ private:
+  AlignedVector<T> x_;
+  AlignedVector<T> y_;
+  AlignedVector<T> z_;
+  AlignedVector<T> intensity_;
+};
+
+typedef SoAPointCloud<float> SoAPointFCloud;
+typedef SoAPointCloud<double> SoAPointDCloud;
+typedef SoAPointCloudView<float> SoAPointFCloudView;
+typedef SoAPointCloudView<double> SoAPointDCloudView;
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
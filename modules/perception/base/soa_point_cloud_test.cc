@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/soa_point_cloud.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+TEST(SoAPointCloudTest, conversion_test) {
+  PointFCloud cloud;
+  for (int i = 0; i < 10; ++i) {
+    PointF pt;
+    pt.x = static_cast<float>(i);
+    pt.y = static_cast<float>(2 * i);
+    pt.z = static_cast<float>(3 * i);
+    pt.intensity = static_cast<float>(4 * i);
+    cloud.push_back(pt);
+  }
+
+  SoAPointFCloud soa_cloud(cloud);
+  EXPECT_EQ(10, soa_cloud.size());
+  EXPECT_FLOAT_EQ(3.f, soa_cloud.x(3));
+  EXPECT_FLOAT_EQ(6.f, soa_cloud.y(3));
+  EXPECT_FLOAT_EQ(9.f, soa_cloud.z(3));
+  EXPECT_FLOAT_EQ(12.f, soa_cloud.intensity(3));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(soa_cloud.x_data()) % 16);
+
+  SoAPointDCloud indexed_cloud;
+  indexed_cloud.FromPointCloud(cloud, std::vector<int>({9, 1}));
+  EXPECT_EQ(2, indexed_cloud.size());
+  EXPECT_DOUBLE_EQ(9.0, indexed_cloud.x(0));
+  EXPECT_DOUBLE_EQ(4.0, indexed_cloud.intensity(1));
+
+  PointDCloud out_cloud;
+  indexed_cloud.ToPointCloud(&out_cloud);
+  EXPECT_EQ(2, out_cloud.size());
+  EXPECT_TRUE(out_cloud.CheckConsistency());
+  EXPECT_DOUBLE_EQ(18.0, out_cloud[0].y);
+  EXPECT_DOUBLE_EQ(3.0, out_cloud[1].z);
+}
+
+TEST(SoAPointCloudTest, view_test) {
+  SoAPointFCloud cloud;
+  for (int i = 0; i < 5; ++i) {
+    PointF pt;
+    pt.x = static_cast<float>(i);
+    cloud.push_back(pt);
+  }
+  SoAPointFCloudView view = cloud.View(1, 4);
+  EXPECT_EQ(3, view.size);
+  EXPECT_EQ(cloud.x_data() + 1, view.x);
+  EXPECT_FLOAT_EQ(2.f, view.x[1]);
+  SoAPointFCloudView slice = view.Slice(2, 10);
+  EXPECT_EQ(1, slice.size);
+  EXPECT_FLOAT_EQ(3.f, slice.x[0]);
+  EXPECT_EQ(0, view.Slice(5, 6).size);
+}
+
+TEST(SoAPointCloudTest, transform_test) {
+  SoAPointDCloud cloud;
+  PointD pt;
+  pt.x = 1.0;
+  pt.y = 2.0;
+  pt.z = 3.0;
+  cloud.push_back(pt);
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.linear() =
+      Eigen::AngleAxisd(M_PI / 2.0, Eigen::Vector3d::UnitZ()).matrix();
+  pose.translation() = Eigen::Vector3d(10.0, 20.0, 30.0);
+  cloud.TransformPointCloud(pose);
+  EXPECT_NEAR(8.0, cloud.x(0), 1e-9);
+  EXPECT_NEAR(21.0, cloud.y(0), 1e-9);
+  EXPECT_NEAR(33.0, cloud.z(0), 1e-9);
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -106,7 +106,7 @@ SyncedMemory::~SyncedMemory() {
 
 #ifndef PERCEPTION_CPU_ONLY
   if (gpu_ptr_ && own_gpu_data_) {
-    BASE_CUDA_CHECK(cudaFree(gpu_ptr_));
+    MemoryPool::Instance().FreeDevice(gpu_ptr_);
   }
 #endif  // PERCEPTION_CPU_ONLY
 }
@@ -147,14 +147,14 @@ inline void SyncedMemory::to_gpu() {
 #ifndef PERCEPTION_CPU_ONLY
   switch (head_) {
     case UNINITIALIZED:
-      BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
+      malloc_gpu();
       BASE_CUDA_CHECK(cudaMemset(gpu_ptr_, 0, size_));
       head_ = HEAD_AT_GPU;
       own_gpu_data_ = true;
       break;
     case HEAD_AT_CPU:
       if (gpu_ptr_ == nullptr) {
-        BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
+        malloc_gpu();
         own_gpu_data_ = true;
       }
       BASE_CUDA_CHECK(cudaMemcpy(gpu_ptr_, cpu_ptr_, size_, cudaMemcpyDefault));
@@ -202,7 +202,7 @@ void SyncedMemory::set_gpu_data(void* data) {
 #ifndef PERCEPTION_CPU_ONLY
   CHECK(data);
   if (own_gpu_data_) {
-    BASE_CUDA_CHECK(cudaFree(gpu_ptr_));
+    MemoryPool::Instance().FreeDevice(gpu_ptr_);
   }
   gpu_ptr_ = data;
   head_ = HEAD_AT_GPU;
@@ -236,7 +236,7 @@ void SyncedMemory::async_gpu_push(const cudaStream_t& stream) {
   check_device();
   CHECK_EQ(head_, HEAD_AT_CPU);
   if (gpu_ptr_ == nullptr) {
-    BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
+    malloc_gpu();
     own_gpu_data_ = true;
   }
   const cudaMemcpyKind put = cudaMemcpyHostToDevice;
@@ -246,6 +246,15 @@ void SyncedMemory::async_gpu_push(const cudaStream_t& stream) {
 }
 #endif
 
+void SyncedMemory::malloc_gpu() {
+#ifndef PERCEPTION_CPU_ONLY
+  gpu_ptr_ = MemoryPool::Instance().MallocDevice(size_);
+  CHECK(gpu_ptr_) << "device allocation of size " << size_ << " failed";
+#else
+  NO_GPU;
+#endif
+}
+
 void SyncedMemory::check_device() {
 #ifndef PERCEPTION_CPU_ONLY
 #ifdef PERCEPTION_DEBUG
@@ -64,6 +64,7 @@ license and copyright terms herein.
 
 #include "cyber/common/log.h"
 #include "modules/perception/base/common.h"
+#include "modules/perception/base/memory_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -72,7 +73,8 @@ namespace base {
 inline void PerceptionMallocHost(void** ptr, size_t size, bool use_cuda) {
 #ifndef PERCEPTION_CPU_ONLY
   if (use_cuda) {
-    BASE_CUDA_CHECK(cudaMallocHost(ptr, size));
+    *ptr = MemoryPool::Instance().MallocHost(size);
+    CHECK(*ptr) << "pinned allocation of size " << size << " failed";
     return;
   }
 #endif
@@ -83,7 +85,7 @@ inline void PerceptionMallocHost(void** ptr, size_t size, bool use_cuda) {
 inline void PerceptionFreeHost(void* ptr, bool use_cuda) {
 #ifndef PERCEPTION_CPU_ONLY
   if (use_cuda) {
-    BASE_CUDA_CHECK(cudaFreeHost(ptr));
+    MemoryPool::Instance().FreeHost(ptr);
     return;
   }
 #endif
@@ -125,6 +127,7 @@ class SyncedMemory {
 
  private:
   void check_device();
+  void malloc_gpu();
   void to_cpu();
   void to_gpu();
 
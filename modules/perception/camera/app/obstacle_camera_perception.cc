@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/camera/app/obstacle_camera_perception.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/common/file.h"
@@ -66,6 +67,20 @@ bool ObstacleCameraPerception::Init(
     name_intrinsic_map_.insert(std::pair<std::string, Eigen::Matrix3f>(
         detector_param.camera_name(), pinhole->get_intrinsic_params()));
     detector_init_options.base_camera_model = model;
+    if (i == 0) {
+      detector_init_options.max_batch_size =
+          perception_param_.max_detection_batch_size();
+      batch_detector_name_ = detector_param.camera_name();
+      batch_image_width_ = static_cast<int>(model->get_width());
+      batch_image_height_ = static_cast<int>(model->get_height());
+    }
+    const auto &batch_plugin_param =
+        perception_param_.detector_param(0).plugin_param();
+    if (plugin_param.name() == batch_plugin_param.name() &&
+        plugin_param.root_dir() == batch_plugin_param.root_dir() &&
+        plugin_param.config_file() == batch_plugin_param.config_file()) {
+      batch_camera_names_.insert(detector_param.camera_name());
+    }
     std::shared_ptr<BaseObstacleDetector> detector_ptr(
         BaseObstacleDetectorRegisterer::GetInstanceByName(plugin_param.name()));
     name_detector_map_.insert(
@@ -300,7 +315,61 @@ bool ObstacleCameraPerception::GetCalibrationService(
 
 bool ObstacleCameraPerception::Perception(
     const CameraPerceptionOptions &options, CameraFrame *frame) {
+  return Process(options, frame, true);
+}
+
+bool ObstacleCameraPerception::Perception(
+    const CameraPerceptionOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  if (frames.size() == 1) {
+    return Process(options, frames[0], true);
+  }
+  inference::CudaUtil::set_device_id(perception_param_.gpu_id());
+  std::shared_ptr<BaseObstacleDetector> batch_detector =
+      name_detector_map_.at(batch_detector_name_);
+  const size_t max_batch_size =
+      static_cast<size_t>(std::max(batch_detector->max_batch_size(), 1));
+  std::vector<CameraFrame *> batch;
+  std::vector<bool> detected(frames.size(), false);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    auto data_provider = frames[i]->data_provider;
+    if (max_batch_size > 1 &&
+        batch_camera_names_.count(data_provider->sensor_name()) > 0 &&
+        data_provider->src_width() == batch_image_width_ &&
+        data_provider->src_height() == batch_image_height_) {
+      batch.push_back(frames[i]);
+      detected[i] = true;
+    }
+  }
+  if (batch.size() > 1) {
+    PERCEPTION_PERF_BLOCK_START();
+    ObstacleDetectorOptions detector_options;
+    for (size_t begin = 0; begin < batch.size(); begin += max_batch_size) {
+      const size_t end = std::min(begin + max_batch_size, batch.size());
+      const std::vector<CameraFrame *> chunk(batch.begin() + begin,
+                                             batch.begin() + end);
+      if (!batch_detector->Detect(detector_options, chunk)) {
+        AERROR << "Failed to detect.";
+        return false;
+      }
+    }
+    PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(batch_detector_name_,
+                                             "batch_detect");
+  } else {
+    std::fill(detected.begin(), detected.end(), false);
+  }
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (!Process(options, frames[i], !detected[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ObstacleCameraPerception::Process(const CameraPerceptionOptions &options,
+                                       CameraFrame *frame, bool run_detector) {
   PERCEPTION_PERF_FUNCTION();
+  PERCEPTION_PROFILE_SCOPE("camera_obstacle");
   inference::CudaUtil::set_device_id(perception_param_.gpu_id());
   ObstacleDetectorOptions detector_options;
   ObstacleTransformerOptions transformer_options;
@@ -371,15 +440,18 @@ bool ObstacleCameraPerception::Perception(
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(),
                                            "Predict");
 
-  std::shared_ptr<BaseObstacleDetector> detector =
-      name_detector_map_.at(frame->data_provider->sensor_name());
+  // detected already when the frame was part of a batch
+  if (run_detector) {
+    std::shared_ptr<BaseObstacleDetector> detector =
+        name_detector_map_.at(frame->data_provider->sensor_name());
 
-  if (!detector->Detect(detector_options, frame)) {
-    AERROR << "Failed to detect.";
-    return false;
+    if (!detector->Detect(detector_options, frame)) {
+      AERROR << "Failed to detect.";
+      return false;
+    }
+    PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(
+        frame->data_provider->sensor_name(), "detect");
   }
-  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(),
-                                           "detect");
 
   // save all detections results as kitti format
   WriteDetections(perception_param_.debug_param().has_detection_out_dir(),
@@ -18,7 +18,9 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "modules/perception/camera/app/perception.pb.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -68,12 +70,24 @@ class ObstacleCameraPerception : public BaseCameraPerception {
   bool GetCalibrationService(BaseCalibrationService **calibration_service);
   bool Perception(const CameraPerceptionOptions &options,
                   CameraFrame *frame) override;
+  // frames are processed in order, their obstacle detection is batched
+  bool Perception(const CameraPerceptionOptions &options,
+                  const std::vector<CameraFrame *> &frames);
   std::string Name() const override { return "ObstacleCameraPerception"; }
 
+ private:
+  bool Process(const CameraPerceptionOptions &options, CameraFrame *frame,
+               bool run_detector);
+
  private:
   std::map<std::string, Eigen::Matrix3f> name_intrinsic_map_;
   std::map<std::string, std::shared_ptr<BaseObstacleDetector>>
       name_detector_map_;
+  // cameras whose frames the detector of batch_detector_name_ can batch
+  std::string batch_detector_name_;
+  std::set<std::string> batch_camera_names_;
+  int batch_image_width_ = 0;
+  int batch_image_height_ = 0;
   std::shared_ptr<BaseObstacleTransformer> transformer_;
   std::shared_ptr<BaseObstaclePostprocessor> obstacle_postprocessor_;
   std::shared_ptr<BaseObstacleTracker> tracker_;
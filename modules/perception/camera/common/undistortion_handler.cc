@@ -18,6 +18,8 @@
 #include <npp.h>
 
 #include <Eigen/Dense>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -66,16 +68,7 @@ bool UndistortionHandler::Init(const std::string &sensor_name, int device) {
 
   height_ = static_cast<int>(distort_model->get_height());
   width_ = static_cast<int>(distort_model->get_width());
-  d_mapx_.Reshape({height_, width_});
-  d_mapy_.Reshape({height_, width_});
-
-  Eigen::Matrix3f I;
-  I << 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f;
-
-  InitUndistortRectifyMap(distort_model->get_intrinsic_params(),
-                          distort_model->get_distort_params(), I,
-                          distort_model->get_intrinsic_params(), width_,
-                          height_, &d_mapx_, &d_mapy_);
+  map_ = GetRectifyMap(*distort_model);
 
   inited_ = true;
   return true;
@@ -98,19 +91,21 @@ bool UndistortionHandler::Handle(const base::Image8U &src_img,
   NppiRect remap_roi = {0, 0, width_, height_};
 
   NppStatus status;
-  int d_map_step = static_cast<int>(d_mapx_.shape(1) * sizeof(float));
+  const base::Blob<float> &d_mapx = map_->mapx;
+  const base::Blob<float> &d_mapy = map_->mapy;
+  int d_map_step = static_cast<int>(d_mapx.shape(1) * sizeof(float));
   switch (src_img.channels()) {
     case 1:
       status = nppiRemap_8u_C1R(
           src_img.gpu_data(), image_size, src_img.width_step(), remap_roi,
-          d_mapx_.gpu_data(), d_map_step, d_mapy_.gpu_data(), d_map_step,
+          d_mapx.gpu_data(), d_map_step, d_mapy.gpu_data(), d_map_step,
           dst_img->mutable_gpu_data(), dst_img->width_step(), image_size,
           remap_mode);
       break;
     case 3:
       status = nppiRemap_8u_C3R(
           src_img.gpu_data(), image_size, src_img.width_step(), remap_roi,
-          d_mapx_.gpu_data(), d_map_step, d_mapy_.gpu_data(), d_map_step,
+          d_mapx.gpu_data(), d_map_step, d_mapy.gpu_data(), d_map_step,
           dst_img->mutable_gpu_data(), dst_img->width_step(), image_size,
           remap_mode);
       break;
@@ -128,10 +123,46 @@ bool UndistortionHandler::Handle(const base::Image8U &src_img,
 }
 
 bool UndistortionHandler::Release(void) {
+  map_.reset();
   inited_ = false;
   return true;
 }
 
+// The remap tables only depend on the intrinsics, image size and device, so
+// they are built and uploaded once and shared by every handler (obstacle,
+// lane and traffic light pipelines of the same camera) while one is alive.
+std::shared_ptr<UndistortionHandler::RectifyMap>
+UndistortionHandler::GetRectifyMap(
+    const base::BrownCameraDistortionModel &distort_model) {
+  static std::mutex mutex;
+  static std::map<std::vector<float>, std::weak_ptr<RectifyMap>> cache;
+
+  const Eigen::Matrix3f K = distort_model.get_intrinsic_params();
+  const Eigen::Matrix<float, 5, 1> D = distort_model.get_distort_params();
+  std::vector<float> key = {static_cast<float>(device_),
+                            static_cast<float>(width_),
+                            static_cast<float>(height_)};
+  key.insert(key.end(), K.data(), K.data() + K.size());
+  key.insert(key.end(), D.data(), D.data() + D.size());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<RectifyMap> map = cache[key].lock();
+  if (map != nullptr) {
+    return map;
+  }
+
+  map = std::make_shared<RectifyMap>();
+  map->mapx.Reshape({height_, width_});
+  map->mapy.Reshape({height_, width_});
+  InitUndistortRectifyMap(K, D, Eigen::Matrix3f::Identity(), K, width_,
+                          height_, &map->mapx, &map->mapy);
+  // upload now, Handle() must only read device memory
+  map->mapx.gpu_data();
+  map->mapy.gpu_data();
+  cache[key] = map;
+  return map;
+}
+
 void UndistortionHandler::InitUndistortRectifyMap(
     const Eigen::Matrix3f &camera_model,
     const Eigen::Matrix<float, 5, 1> distortion, const Eigen::Matrix3f &R,
@@ -152,10 +183,12 @@ void UndistortionHandler::InitUndistortRectifyMap(
   float k3 = distortion(4, 0);
   Eigen::Matrix3f Rinv = R.inverse();
 
-  for (int v = 0; v < height_; ++v) {
-    float *x_ptr = d_mapx->mutable_cpu_data() + d_mapx->offset(v);
-    float *y_ptr = d_mapy->mutable_cpu_data() + d_mapy->offset(v);
-    for (int u = 0; u < width_; ++u) {
+  float *mapx_data = d_mapx->mutable_cpu_data();
+  float *mapy_data = d_mapy->mutable_cpu_data();
+  for (int v = 0; v < height; ++v) {
+    float *x_ptr = mapx_data + d_mapx->offset(v);
+    float *y_ptr = mapy_data + d_mapy->offset(v);
+    for (int u = 0; u < width; ++u) {
       Eigen::Matrix<float, 3, 1> xy1;
       xy1 << (static_cast<float>(u) - ncx) / nfx,
           (static_cast<float>(v) - ncy) / nfy, 1;
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "modules/perception/base/blob.h"
@@ -48,9 +49,24 @@ class UndistortionHandler {
   // @brief: Release the resources
   bool Release(void);
 
+  // @brief: remap tables, shared by all handlers with the same intrinsics
+  const base::Blob<float> *mapx() const {
+    return map_ == nullptr ? nullptr : &map_->mapx;
+  }
+  const base::Blob<float> *mapy() const {
+    return map_ == nullptr ? nullptr : &map_->mapy;
+  }
+
  private:
-  base::Blob<float> d_mapx_;
-  base::Blob<float> d_mapy_;
+  struct RectifyMap {
+    base::Blob<float> mapx;
+    base::Blob<float> mapy;
+  };
+
+  std::shared_ptr<RectifyMap> GetRectifyMap(
+      const base::BrownCameraDistortionModel &distort_model);
+
+  std::shared_ptr<RectifyMap> map_ = nullptr;
 
   int width_ = 0;     // image cols
   int height_ = 0;    // image rows
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/base/camera.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -30,6 +31,8 @@ namespace camera {
 struct ObstacleDetectorInitOptions : public BaseInitOptions {
   std::shared_ptr<base::BaseCameraModel> base_camera_model = nullptr;
   Eigen::Matrix3f intrinsics;
+  // frames Detect(options, frames) can run in one inference
+  int max_batch_size = 1;
 };
 
 struct ObstacleDetectorOptions {};
@@ -51,6 +54,22 @@ class BaseObstacleDetector {
   virtual bool Detect(const ObstacleDetectorOptions &options,
                       CameraFrame *frame) = 0;
 
+  // @brief: detect obstacles from the images of several frames.
+  // @param [in]: options
+  // @param [in/out]: frames, of the image size of the detector camera
+  // detectors without batch support detect the frames one by one.
+  virtual bool Detect(const ObstacleDetectorOptions &options,
+                      const std::vector<CameraFrame *> &frames) {
+    for (auto frame : frames) {
+      if (!Detect(options, frame)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  virtual int max_batch_size() const { return 1; }
+
   virtual std::string Name() const = 0;
 
   BaseObstacleDetector(const BaseObstacleDetector &) = delete;
@@ -109,7 +109,8 @@ bool PolyEval(const Dtype& x, int order,
 template <typename Dtype>
 bool RansacFitting(std::vector<Eigen::Matrix<Dtype, 2, 1>>* pos_vec,
                    Eigen::Matrix<Dtype, 4, 1>* coeff, const int max_iters = 100,
-                   const int N = 5, Dtype inlier_thres = 0.1) {
+                   const int N = 5, Dtype inlier_thres = 0.1,
+                   const Eigen::Matrix<Dtype, 4, 1>* init_coeff = nullptr) {
   if (coeff == NULL) {
     AERROR << "The coefficient pointer is NULL.";
     return false;
@@ -130,24 +131,9 @@ bool RansacFitting(std::vector<Eigen::Matrix<Dtype, 2, 1>>* pos_vec,
   Dtype min_residual = FLT_MAX;
   Dtype early_stop_ratio = 0.95f;
   Dtype good_lane_ratio = 0.666f;
-  for (int j = 0; j < max_iters; ++j) {
-    index[0] = std::rand() % q2;
-    index[1] = q2 + std::rand() % q1;
-    index[2] = q3 + std::rand() % q1;
-
-    Eigen::Matrix<Dtype, 3, 3> matA;
-    matA << (*pos_vec)[index[0]](0) * (*pos_vec)[index[0]](0),
-        (*pos_vec)[index[0]](0), 1,
-        (*pos_vec)[index[1]](0) * (*pos_vec)[index[1]](0),
-        (*pos_vec)[index[1]](0), 1,
-        (*pos_vec)[index[2]](0) * (*pos_vec)[index[2]](0),
-        (*pos_vec)[index[2]](0), 1;
-
-    Eigen::Matrix<Dtype, 3, 1> matB;
-    matB << (*pos_vec)[index[0]](1), (*pos_vec)[index[1]](1),
-        (*pos_vec)[index[2]](1);
-    Eigen::Matrix<Dtype, 3, 1> c = matA.colPivHouseholderQr().solve(matB);
-
+  // count the inliers of y = c(0) * x^2 + c(1) * x + c(2), keep it in coeff
+  // if it beats the best one so far
+  auto evaluate = [&](const Eigen::Matrix<Dtype, 3, 1>& c) {
     int num_inliers = 0;
     Dtype residual = 0;
     Dtype y = 0;
@@ -167,8 +153,34 @@ bool RansacFitting(std::vector<Eigen::Matrix<Dtype, 2, 1>>* pos_vec,
       max_inliers = num_inliers;
       min_residual = residual;
     }
-
+  };
+
+  // the initial guess is tried first, the sampling stops right away when
+  // it already fits well enough
+  if (init_coeff != nullptr) {
+    Eigen::Matrix<Dtype, 3, 1> c;
+    c << (*init_coeff)(2), (*init_coeff)(1), (*init_coeff)(0);
+    evaluate(c);
+  }
+  for (int j = 0; j < max_iters; ++j) {
     if (max_inliers > early_stop_ratio * n) break;
+    index[0] = std::rand() % q2;
+    index[1] = q2 + std::rand() % q1;
+    index[2] = q3 + std::rand() % q1;
+
+    Eigen::Matrix<Dtype, 3, 3> matA;
+    matA << (*pos_vec)[index[0]](0) * (*pos_vec)[index[0]](0),
+        (*pos_vec)[index[0]](0), 1,
+        (*pos_vec)[index[1]](0) * (*pos_vec)[index[1]](0),
+        (*pos_vec)[index[1]](0), 1,
+        (*pos_vec)[index[2]](0) * (*pos_vec)[index[2]](0),
+        (*pos_vec)[index[2]](0), 1;
+
+    Eigen::Matrix<Dtype, 3, 1> matB;
+    matB << (*pos_vec)[index[0]](1), (*pos_vec)[index[1]](1),
+        (*pos_vec)[index[2]](1);
+    Eigen::Matrix<Dtype, 3, 1> c = matA.colPivHouseholderQr().solve(matB);
+    evaluate(c);
   }
 
   if (static_cast<Dtype>(max_inliers) / n < good_lane_ratio) return false;
@@ -114,6 +114,8 @@ bool DarkSCNNLanePostprocessor::Init(
 
   lane_type_num_ = static_cast<int>(spatialLUTind.size());
   AINFO << "lane_type_num_: " << lane_type_num_;
+  previous_coeffs_.assign(lane_type_num_, Eigen::Matrix<float, 4, 1>::Zero());
+  has_previous_coeff_.assign(lane_type_num_, false);
   return true;
 }
 
@@ -123,9 +125,9 @@ bool DarkSCNNLanePostprocessor::Process2D(
   frame->lane_objects.clear();
   auto start = std::chrono::high_resolution_clock::now();
 
-  cv::Mat lane_map(lane_map_height_, lane_map_width_, CV_32FC1);
-  memcpy(lane_map.data, frame->lane_detected_blob->cpu_data(),
-         lane_map_width_ * lane_map_height_ * sizeof(float));
+  // the lane map has lane_map_height_ rows of lane_map_width_ labels, only
+  // the sampled rows of it are read
+  const float* lane_map = frame->lane_detected_blob->cpu_data();
 
   // if (options.use_lane_history &&
   //     (!use_history_ || time_stamp_ > options.timestamp)) {
@@ -135,7 +137,7 @@ bool DarkSCNNLanePostprocessor::Process2D(
   // 1. Sample points on lane_map and project them onto world coordinate
 
   // TODO(techoe): Should be fixed
-  int y = static_cast<int>(lane_map.rows * 0.9 - 1);
+  int y = static_cast<int>(lane_map_height_ * 0.9 - 1);
   // TODO(techoe): Should be fixed
   int step_y = (y - 40) * (y - 40) / 6400 + 1;
 
@@ -143,19 +145,25 @@ bool DarkSCNNLanePostprocessor::Process2D(
   xy_points.resize(lane_type_num_);
   uv_points.clear();
   uv_points.resize(lane_type_num_);
+  row_labels_.resize(lane_map_width_);
 
   while (y > 0) {
-    for (int x = 1; x < lane_map.cols - 1; x++) {
-      int value = static_cast<int>(round(lane_map.at<float>(y, x)));
+    const float* lane_row = lane_map + y * lane_map_width_;
+    const float image_y =
+        static_cast<float>(y * roi_height_ / lane_map_height_ + roi_start_);
+    for (int x = 0; x < lane_map_width_; x++) {
+      row_labels_[x] = static_cast<int>(round(lane_row[x]));
+    }
+    for (int x = 1; x < lane_map_width_ - 1; x++) {
+      int value = row_labels_[x];
       // lane on left
 
       if ((value > 0 && value < 5) || value == 11) {
         // right edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x + 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
+        if (value != row_labels_[x + 1]) {
+          const float image_x =
+              static_cast<float>(x * roi_width_ / lane_map_width_);
+          Eigen::Matrix<float, 3, 1> img_point(image_x, image_y, 1.0);
           Eigen::Matrix<float, 3, 1> xy_p;
           xy_p = trans_mat_ * img_point;
           Eigen::Matrix<float, 2, 1> xy_point;
@@ -169,8 +177,7 @@ bool DarkSCNNLanePostprocessor::Process2D(
               std::abs(xy_point(1)) > 30.0) {
             continue;
           }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
+          uv_point << image_x, image_y;
           if (xy_points[value].size() < minNumPoints_ ||
               xy_point(0) < 50.0f ||
               std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
@@ -180,11 +187,10 @@ bool DarkSCNNLanePostprocessor::Process2D(
         }
       } else if (value >= 5 && value < lane_type_num_) {
         // left edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x - 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
+        if (value != row_labels_[x - 1]) {
+          const float image_x =
+              static_cast<float>(x * roi_width_ / lane_map_width_);
+          Eigen::Matrix<float, 3, 1> img_point(image_x, image_y, 1.0);
           Eigen::Matrix<float, 3, 1> xy_p;
           xy_p = trans_mat_ * img_point;
           Eigen::Matrix<float, 2, 1> xy_point;
@@ -196,8 +202,7 @@ bool DarkSCNNLanePostprocessor::Process2D(
               std::abs(xy_point(1)) > 25.0) {
             continue;
           }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
+          uv_point << image_x, image_y;
           if (xy_points[value].size() < minNumPoints_ ||
               xy_point(0) < 50.0f ||
               std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
@@ -224,16 +229,26 @@ bool DarkSCNNLanePostprocessor::Process2D(
   std::vector<Eigen::Matrix<float, 4, 1>> img_coeffs;
   coeffs.resize(lane_type_num_);
   img_coeffs.resize(lane_type_num_);
+  const bool use_previous_fit = lane_postprocessor_param_.use_previous_fit();
   for (int i = 1; i < lane_type_num_; ++i) {
-    if (xy_points[i].size() < minNumPoints_) continue;
+    if (xy_points[i].size() < minNumPoints_) {
+      has_previous_coeff_[i] = false;
+      continue;
+    }
     Eigen::Matrix<float, 4, 1> coeff;
+    const Eigen::Matrix<float, 4, 1>* init_coeff =
+        use_previous_fit && has_previous_coeff_[i] ? &previous_coeffs_[i]
+                                                   : nullptr;
     // solve linear system to estimate polynomial coefficients
     if (RansacFitting(&xy_points[i], &coeff,
-         200, static_cast<int> (minNumPoints_), 0.1f)) {
+         200, static_cast<int> (minNumPoints_), 0.1f, init_coeff)) {
 //    if (PolyFit(xy_points[i], max_poly_order, &coeff, true)) {
        coeffs[i] = coeff;
+       previous_coeffs_[i] = coeff;
+       has_previous_coeff_[i] = true;
     } else {
        xy_points[i].clear();
+       has_previous_coeff_[i] = false;
     }
   }
 
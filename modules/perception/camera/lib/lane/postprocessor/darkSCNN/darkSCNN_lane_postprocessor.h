@@ -101,6 +101,12 @@ class DarkSCNNLanePostprocessor : public BaseLanePostprocessor {
   // xy points for the ground plane, uv points for image plane
   std::vector<std::vector<Eigen::Matrix<float, 2, 1>>> xy_points;
   std::vector<std::vector<Eigen::Matrix<float, 2, 1>>> uv_points;
+  // lane labels of the lane map row being sampled
+  std::vector<int> row_labels_;
+  // fits of the last frame by lane label, the initial guesses of the RANSAC
+  // when use_previous_fit is set
+  std::vector<Eigen::Matrix<float, 4, 1>> previous_coeffs_;
+  std::vector<bool> has_previous_coeff_;
 };
 
 }  // namespace camera
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/obstacle/detector/yolo/yolo_obstacle_detector.h"
 
+#include <algorithm>
+
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 
@@ -120,7 +122,7 @@ bool YoloObstacleDetector::InitNet(const yolo::YoloParam &yolo_param,
     return false;
   }
   inference_->set_gpu_id(gpu_id_);
-  std::vector<int> shape = {1, height_, width_, 3};
+  std::vector<int> shape = {max_batch_size_, height_, width_, 3};
   std::map<std::string, std::vector<int>> shape_map{
       {net_param.input_blob(), shape}};
 
@@ -157,7 +159,10 @@ void YoloObstacleDetector::InitYoloBlob(const yolo::NetworkParam &net_param) {
   memcpy(anchor_cpu_data, anchors_.data(), anchors_.size() * sizeof(float));
   yolo_blobs_.anchor_blob->gpu_data();
 
-  image_.reset(new base::Image8U(height_, width_, base::Color::RGB));
+  images_.resize(max_batch_size_);
+  for (auto &image : images_) {
+    image.reset(new base::Image8U(height_, width_, base::Color::RGB));
+  }
 
   yolo_blobs_.loc_blob =
       inference_->get_blob(yolo_param_.net_param().loc_blob());
@@ -197,6 +202,7 @@ void YoloObstacleDetector::InitYoloBlob(const yolo::NetworkParam &net_param) {
 
 bool YoloObstacleDetector::Init(const ObstacleDetectorInitOptions &options) {
   gpu_id_ = options.gpu_id;
+  max_batch_size_ = std::max(options.max_batch_size, 1);
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   BASE_CUDA_CHECK(cudaStreamCreate(&stream_));
 
@@ -258,12 +264,55 @@ bool YoloObstacleDetector::InitFeatureExtractor(const std::string &root_dir) {
   return true;
 }
 
+std::shared_ptr<base::Blob<float>> YoloObstacleDetector::BatchSlice(
+    const std::shared_ptr<base::Blob<float>> &blob, int index) const {
+  if (blob == nullptr || max_batch_size_ == 1) {
+    return blob;
+  }
+  // batch-1 view sharing the GPU memory of the batched blob
+  std::vector<int> shape = blob->shape();
+  shape[0] = 1;
+  std::shared_ptr<base::Blob<float>> slice(new base::Blob<float>(shape));
+  slice->set_gpu_data(blob->mutable_gpu_data() + index * blob->count(1));
+  return slice;
+}
+
+YoloBlobs YoloObstacleDetector::BatchBlobs(int index) const {
+  YoloBlobs blobs = yolo_blobs_;
+  for (auto blob :
+       {&blobs.loc_blob, &blobs.obj_blob, &blobs.cls_blob, &blobs.ori_blob,
+        &blobs.dim_blob, &blobs.lof_blob, &blobs.lor_blob, &blobs.brvis_blob,
+        &blobs.brswt_blob, &blobs.ltvis_blob, &blobs.ltswt_blob,
+        &blobs.rtvis_blob, &blobs.rtswt_blob, &blobs.area_id_blob,
+        &blobs.visible_ratio_blob, &blobs.cut_off_ratio_blob}) {
+    *blob = BatchSlice(*blob, index);
+  }
+  return blobs;
+}
+
 bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
                                   CameraFrame *frame) {
   if (frame == nullptr) {
     return false;
   }
+  return DetectBatch({frame});
+}
 
+bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
+                                  const std::vector<CameraFrame *> &frames) {
+  if (static_cast<int>(frames.size()) > max_batch_size_) {
+    return BaseObstacleDetector::Detect(options, frames);
+  }
+  for (auto frame : frames) {
+    if (frame == nullptr) {
+      return false;
+    }
+  }
+  return frames.empty() || DetectBatch(frames);
+}
+
+bool YoloObstacleDetector::DetectBatch(
+    const std::vector<CameraFrame *> &frames) {
   Timer timer;
   if (cudaSetDevice(gpu_id_) != cudaSuccess) {
     AERROR << "Failed to set device to " << gpu_id_;
@@ -278,53 +327,63 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
       0, offset_y_, static_cast<int>(base_camera_model_->get_width()),
       static_cast<int>(base_camera_model_->get_height()) - offset_y_);
   image_options.do_crop = true;
-  frame->data_provider->GetImage(image_options, image_.get());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    frames[i]->data_provider->GetImage(image_options, images_[i].get());
+  }
   AINFO << "GetImageBlob: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  inference::ResizeGPU(*image_, input_blob, frame->data_provider->src_width(),
-                       0);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    inference::ResizeGPU(*images_[i],
+                         BatchSlice(input_blob, static_cast<int>(i)),
+                         frames[i]->data_provider->src_width(), 0);
+  }
   AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
 
   /////////////////////////// detection part ///////////////////////////
   inference_->Infer();
 
-  get_objects_gpu(yolo_blobs_, stream_, types_, nms_, yolo_param_.model_param(),
-                  light_vis_conf_threshold_, light_swt_conf_threshold_,
-                  overlapped_.get(), idx_sm_.get(), &(frame->detected_objects));
-
-  AINFO << "GetObj: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  filter_bbox(min_dims_, &(frame->detected_objects));
-  FeatureExtractorOptions feat_options;
-  feat_options.normalized = true;
-  AINFO << "Post1: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  feature_extractor_->Extract(feat_options, frame);
-  AINFO << "Extract: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  recover_bbox(frame->data_provider->src_width(),
-               frame->data_provider->src_height() - offset_y_, offset_y_,
-               &frame->detected_objects);
-
-  // post processing
-  int left_boundary =
-      static_cast<int>(border_ratio_ * static_cast<float>(image_->cols()));
-  int right_boundary = static_cast<int>((1.0f - border_ratio_) *
-                                        static_cast<float>(image_->cols()));
-  for (auto &obj : frame->detected_objects) {
-    // recover alpha
-    obj->camera_supplement.alpha /= ori_cycle_;
-    // get area_id from visible_ratios
-    if (yolo_param_.model_param().num_areas() == 0) {
-      obj->camera_supplement.area_id =
-          get_area_id(obj->camera_supplement.visible_ratios);
-    }
-    // clear cut off ratios
-    auto &box = obj->camera_supplement.box;
-    if (box.xmin >= left_boundary) {
-      obj->camera_supplement.cut_off_ratios[2] = 0;
-    }
-    if (box.xmax <= right_boundary) {
-      obj->camera_supplement.cut_off_ratios[3] = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    CameraFrame *frame = frames[i];
+    get_objects_gpu(BatchBlobs(static_cast<int>(i)), stream_, types_, nms_,
+                    yolo_param_.model_param(), light_vis_conf_threshold_,
+                    light_swt_conf_threshold_, overlapped_.get(), idx_sm_.get(),
+                    &(frame->detected_objects));
+
+    AINFO << "GetObj: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+    filter_bbox(min_dims_, &(frame->detected_objects));
+    FeatureExtractorOptions feat_options;
+    feat_options.normalized = true;
+    feat_options.batch_index = static_cast<int>(i);
+    AINFO << "Post1: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+    feature_extractor_->Extract(feat_options, frame);
+    AINFO << "Extract: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+    recover_bbox(frame->data_provider->src_width(),
+                 frame->data_provider->src_height() - offset_y_, offset_y_,
+                 &frame->detected_objects);
+
+    // post processing
+    int left_boundary = static_cast<int>(
+        border_ratio_ * static_cast<float>(images_[i]->cols()));
+    int right_boundary = static_cast<int>(
+        (1.0f - border_ratio_) * static_cast<float>(images_[i]->cols()));
+    for (auto &obj : frame->detected_objects) {
+      // recover alpha
+      obj->camera_supplement.alpha /= ori_cycle_;
+      // get area_id from visible_ratios
+      if (yolo_param_.model_param().num_areas() == 0) {
+        obj->camera_supplement.area_id =
+            get_area_id(obj->camera_supplement.visible_ratios);
+      }
+      // clear cut off ratios
+      auto &box = obj->camera_supplement.box;
+      if (box.xmin >= left_boundary) {
+        obj->camera_supplement.cut_off_ratios[2] = 0;
+      }
+      if (box.xmax <= right_boundary) {
+        obj->camera_supplement.cut_off_ratios[3] = 0;
+      }
     }
+    AINFO << "Post2: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
   }
-  AINFO << "Post2: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
 
   return true;
 }
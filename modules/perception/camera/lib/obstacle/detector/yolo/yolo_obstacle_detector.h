@@ -50,6 +50,9 @@ class YoloObstacleDetector : public BaseObstacleDetector {
 
   bool Detect(const ObstacleDetectorOptions &options,
               CameraFrame *frame) override;
+  bool Detect(const ObstacleDetectorOptions &options,
+              const std::vector<CameraFrame *> &frames) override;
+  int max_batch_size() const override { return max_batch_size_; }
   std::string Name() const override { return "YoloObstacleDetector"; }
 
  protected:
@@ -59,6 +62,10 @@ class YoloObstacleDetector : public BaseObstacleDetector {
                const std::string &model_root);
   void InitYoloBlob(const yolo::NetworkParam &net_param);
   bool InitFeatureExtractor(const std::string &root_dir);
+  bool DetectBatch(const std::vector<CameraFrame *> &frames);
+  std::shared_ptr<base::Blob<float>> BatchSlice(
+      const std::shared_ptr<base::Blob<float>> &blob, int index) const;
+  YoloBlobs BatchBlobs(int index) const;
 
  private:
   std::shared_ptr<BaseFeatureExtractor> feature_extractor_;
@@ -76,6 +83,7 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   int offset_y_ = 0;
   int gpu_id_ = 0;
   int obj_k_ = kMaxObjSize;
+  int max_batch_size_ = 1;
 
   int ori_cycle_ = 1;
   float confidence_threshold_ = 0.f;
@@ -84,7 +92,7 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   MinDims min_dims_;
   YoloBlobs yolo_blobs_;
 
-  std::shared_ptr<base::Image8U> image_ = nullptr;
+  std::vector<std::shared_ptr<base::Image8U>> images_;
   std::shared_ptr<base::Blob<bool>> overlapped_ = nullptr;
   std::shared_ptr<base::Blob<int>> idx_sm_ = nullptr;
 
@@ -24,6 +24,7 @@
 #include "modules/perception/camera/common/math_functions.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/common/geometry/common.h"
+#include "modules/perception/inference/utils/gemm.h"
 
 namespace apollo {
 namespace perception {
@@ -50,8 +51,6 @@ bool OMTObstacleTracker::Init(const ObstacleTrackerInitOptions &options) {
   frame_num_ = 0;
   frame_list_.Init(omt_param_.img_capability());
   gpu_id_ = options.gpu_id;
-  similar_map_.Init(omt_param_.img_capability(), gpu_id_);
-  similar_.reset(new GPUSimilar);
   width_ = options.image_width;
   height_ = options.image_height;
   reference_.Init(omt_param_.reference(), width_, height_);
@@ -170,8 +169,13 @@ void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
     for (size_t j = 0; j < objects.size(); ++j) {
       hypo.target = static_cast<int>(i);
       hypo.object = static_cast<int>(j);
-      float sa = ScoreAppearance(targets_[i], objects[j]);
       float sm = ScoreMotion(targets_[i], objects[j]);
+      // 95.44% area is range [mu - sigma*2, mu + sigma*2]
+      // don't match if motion is beyond the range
+      if (sm < 0.045) {
+        continue;
+      }
+      float sa = ScoreAppearance(hypo.target, hypo.object);
       float ss = ScoreShape(targets_[i], objects[j]);
       float so = ScoreOverlap(targets_[i], objects[j]);
       if (sa == 0) {
@@ -191,9 +195,7 @@ void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
              << ") sa:" << sa << " sm: " << sm << " ss: " << ss << " so: " << so
              << " score: " << hypo.score;
 
-      // 95.44% area is range [mu - sigma*2, mu + sigma*2]
-      // don't match if motion is beyond the range
-      if (sm < 0.045 || hypo.score < omt_param_.target_thresh()) {
+      if (hypo.score < omt_param_.target_thresh()) {
         continue;
       }
       score_list.push_back(hypo);
@@ -238,22 +240,47 @@ float OMTObstacleTracker::ScoreShape(const Target &target,
   return -std::abs(s);
 }
 
-float OMTObstacleTracker::ScoreAppearance(const Target &target,
-                                          TrackObjectPtr track_obj) {
-  float energy = 0.0f;
-  int count = 0;
-  auto sensor_name = track_obj->indicator.sensor_name;
-  for (int i = target.Size() - 1; i >= 0; --i) {
-    if (target[i]->indicator.sensor_name != sensor_name) {
+void OMTObstacleTracker::CalcAppearance(const CameraFrame &frame) {
+  has_appearance_ = false;
+  int n = static_cast<int>(targets_.size());
+  int m = static_cast<int>(frame.detected_objects.size());
+  if (n == 0 || m == 0 || frame.track_feature_blob == nullptr ||
+      frame.track_feature_blob->num() != m) {
+    return;
+  }
+  int dim = frame.track_feature_blob->count(1);
+  const std::string &sensor_name = frame.data_provider->sensor_name();
+  target_features_.Reshape({n, dim});
+  float *features = target_features_.mutable_cpu_data();
+  std::fill(features, features + target_features_.count(), 0.0f);
+  appearance_counts_.assign(n, 0);
+  for (int i = 0; i < n; ++i) {
+    auto iter = targets_[i].feature_sums.find(sensor_name);
+    if (iter == targets_[i].feature_sums.end()) {
       continue;
     }
-    PatchIndicator p1 = target[i]->indicator;
-    PatchIndicator p2 = track_obj->indicator;
-
-    energy += similar_map_.sim(p1, p2);
-    count += 1;
+    // the sum of the inner products with the tracked objects of the sensor
+    // is the inner product with the sum of their features
+    appearance_counts_[i] = iter->second.count;
+    const std::vector<double> &sum = iter->second.sum;
+    for (size_t k = 0; k < sum.size() && k < static_cast<size_t>(dim); ++k) {
+      features[i * dim + k] = static_cast<float>(sum[k]);
+    }
   }
+  appearance_.Reshape({n, m});
+  inference::GPUGemmFloat(CblasNoTrans, CblasTrans, n, m, dim, 1.0,
+                          target_features_.gpu_data(),
+                          frame.track_feature_blob->gpu_data(), 0.0,
+                          appearance_.mutable_gpu_data());
+  has_appearance_ = true;
+}
 
+float OMTObstacleTracker::ScoreAppearance(int target, int object) const {
+  if (!has_appearance_) {
+    return 0.0f;
+  }
+  float energy = appearance_.cpu_data()[appearance_.offset(target, object)];
+  int count = appearance_counts_[target];
   return energy / (0.1f + static_cast<float>(count) * 0.9f);
 }
 
@@ -349,18 +376,21 @@ bool OMTObstacleTracker::Associate2D(const ObstacleTrackerOptions &options,
                                      CameraFrame *frame) {
   inference::CudaUtil::set_device_id(gpu_id_);
   frame_list_.Add(frame);
-  for (int t = 0; t < frame_list_.Size(); t++) {
-    int frame1 = frame_list_[t]->frame_id;
-    int frame2 = frame_list_[-1]->frame_id;
-    similar_->Calc(frame_list_[frame1], frame_list_[frame2],
-                   similar_map_.get(frame1, frame2).get());
-  }
 
   for (auto &target : targets_) {
     target.RemoveOld(frame_list_.OldestFrameId());
     ++target.lost_age;
   }
-
+  CalcAppearance(*frame);
+
+  const float *frame_features = nullptr;
+  int feature_dim = 0;
+  if (frame->track_feature_blob != nullptr &&
+      frame->track_feature_blob->num() ==
+          static_cast<int>(frame->detected_objects.size())) {
+    frame_features = frame->track_feature_blob->cpu_data();
+    feature_dim = frame->track_feature_blob->count(1);
+  }
   TrackObjectPtrs track_objects;
   for (size_t i = 0; i < frame->detected_objects.size(); ++i) {
     // TODO(gaohan): use pool
@@ -374,6 +404,10 @@ bool OMTObstacleTracker::Associate2D(const ObstacleTrackerOptions &options,
         frame->data_provider->sensor_name();
     ProjectBox(frame->detected_objects[i]->camera_supplement.box,
                frame->project_matrix, &(track_ptr->projected_box));
+    if (frame_features != nullptr) {
+      const float *feature = frame_features + i * feature_dim;
+      track_ptr->feature.assign(feature, feature + feature_dim);
+    }
     track_objects.push_back(track_ptr);
   }
   reference_.CorrectSize(frame);
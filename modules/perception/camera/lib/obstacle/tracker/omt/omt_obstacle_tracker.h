@@ -19,9 +19,9 @@
 #include <string>
 #include <vector>
 
+#include "modules/perception/base/blob.h"
 #include "modules/perception/camera/common/object_template_manager.h"
 #include "modules/perception/camera/lib/interface/base_obstacle_tracker.h"
-#include "modules/perception/camera/lib/obstacle/tracker/common/similar.h"
 #include "modules/perception/camera/lib/obstacle/tracker/omt/frame_list.h"
 #include "modules/perception/camera/lib/obstacle/tracker/omt/obstacle_reference.h"
 #include "modules/perception/camera/lib/obstacle/tracker/omt/omt.pb.h"
@@ -98,7 +98,10 @@ class OMTObstacleTracker : public BaseObstacleTracker {
   std::string Name() const override;
 
  private:
-  float ScoreAppearance(const Target &target, TrackObjectPtr object);
+  // @brief: compute the appearance similarity of every target to every
+  // detection of the frame with one matrix product on the GPU.
+  void CalcAppearance(const CameraFrame &frame);
+  float ScoreAppearance(int target, int object) const;
 
   float ScoreMotion(const Target &target, TrackObjectPtr object);
   float ScoreShape(const Target &target, TrackObjectPtr object);
@@ -111,9 +114,13 @@ class OMTObstacleTracker : public BaseObstacleTracker {
  private:
   omt::OmtParam omt_param_;
   FrameList frame_list_;
-  SimilarMap similar_map_;
-  std::shared_ptr<BaseSimilar> similar_ = nullptr;
   std::vector<Target> targets_;
+  // feature sums of the targets, targets x feature dim
+  base::Blob<float> target_features_;
+  // inner products of the feature sums and features, targets x detections
+  base::Blob<float> appearance_;
+  std::vector<int> appearance_counts_;
+  bool has_appearance_ = false;
   std::vector<bool> used_;
   ObstacleReference reference_;
   std::vector<std::vector<float> > kTypeAssociatedCost_;
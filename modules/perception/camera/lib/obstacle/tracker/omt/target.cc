@@ -30,7 +30,10 @@ namespace camera {
 int Target::global_track_id = 0;
 int Target::Size() const { return static_cast<int>(tracked_objects.size()); }
 
-void Target::Clear() { tracked_objects.clear(); }
+void Target::Clear() {
+  tracked_objects.clear();
+  feature_sums.clear();
+}
 
 TrackObjectPtr Target::operator[](int index) const { return get_object(index); }
 TrackObjectPtr Target::get_object(int index) const {
@@ -52,16 +55,45 @@ void Target::Add(TrackObjectPtr object) {
   latest_object = object;
   lost_age = 0;
   tracked_objects.push_back(object);
+  AddFeature(object);
 }
 void Target::RemoveOld(int frame_id) {
   size_t index = 0;
   while (index < tracked_objects.size() &&
          tracked_objects[index]->indicator.frame_id < frame_id) {
+    RemoveFeature(tracked_objects[index]);
     ++index;
   }
   tracked_objects.erase(tracked_objects.begin(),
                         tracked_objects.begin() + index);
 }
+void Target::AddFeature(const TrackObjectPtr &object) {
+  FeatureSum &feature_sum = feature_sums[object->indicator.sensor_name];
+  ++feature_sum.count;
+  const std::vector<float> &feature = object->feature;
+  if (feature_sum.sum.size() < feature.size()) {
+    feature_sum.sum.resize(feature.size(), 0.0);
+  }
+  for (size_t i = 0; i < feature.size(); ++i) {
+    feature_sum.sum[i] += feature[i];
+  }
+}
+void Target::RemoveFeature(const TrackObjectPtr &object) {
+  auto iter = feature_sums.find(object->indicator.sensor_name);
+  if (iter == feature_sums.end()) {
+    return;
+  }
+  FeatureSum &feature_sum = iter->second;
+  if (--feature_sum.count <= 0) {
+    // drop the rounding errors along with the emptied sum
+    feature_sums.erase(iter);
+    return;
+  }
+  const std::vector<float> &feature = object->feature;
+  for (size_t i = 0; i < feature.size() && i < feature_sum.sum.size(); ++i) {
+    feature_sum.sum[i] -= feature[i];
+  }
+}
 void Target::Init(const omt::TargetParam &param) {
   target_param_ = param;
   id = -1;
@@ -17,6 +17,8 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <map>
+#include <string>
 #include <vector>
 
 #include "modules/perception/base/object.h"
@@ -30,6 +32,12 @@ namespace apollo {
 namespace perception {
 namespace camera {
 
+// sum of the appearance features of the tracked objects from one sensor
+struct FeatureSum {
+  std::vector<double> sum;
+  int count = 0;
+};
+
 struct Target {
  public:
   explicit Target(const omt::TargetParam &param);
@@ -81,9 +89,15 @@ struct Target {
   KalmanFilterConstVelocity image_center;
 
   TrackObjectPtrs tracked_objects;
+  // kept up to date as objects are added and removed, by sensor name, so
+  // the appearance similarity to all the tracked objects of a sensor is one
+  // inner product with the sum
+  std::map<std::string, FeatureSum> feature_sums;
 
  private:
   static int global_track_id;
+  void AddFeature(const TrackObjectPtr &object);
+  void RemoveFeature(const TrackObjectPtr &object);
   // clapping unreasonable velocities by strategy
   void ClappingTrackVelocity(const base::ObjectPtr &obj);
   bool CheckStatic();
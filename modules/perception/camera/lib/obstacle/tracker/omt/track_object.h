@@ -29,6 +29,8 @@ struct TrackObject {
   double timestamp;
   base::BBox2DF projected_box;
   base::ObjectPtr object;
+  // appearance feature of the object, empty if its frame has none
+  std::vector<float> feature;
 };
 typedef std::shared_ptr<TrackObject> TrackObjectPtr;
 typedef std::vector<TrackObjectPtr> TrackObjectPtrs;
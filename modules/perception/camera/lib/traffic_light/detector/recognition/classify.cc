@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/traffic_light/detector/recognition/classify.h"
 
+#include <algorithm>
 #include <map>
 
 #include "cyber/common/file.h"
@@ -30,7 +31,8 @@ using cyber::common::GetAbsolutePath;
 
 void ClassifyBySimple::Init(
     const traffic_light::recognition::ClassifyParam& model_config,
-    const int gpu_id, const std::string work_root) {
+    const int gpu_id, const std::string work_root,
+    const std::shared_ptr<inference::GpuWorkspace>& workspace) {
   AINFO << "Enter Classify init";
   net_inputs_.clear();
   net_outputs_.clear();
@@ -66,6 +68,7 @@ void ClassifyBySimple::Init(
   AINFO << "create success";
 
   rt_net_->set_gpu_id(gpu_id);
+  rt_net_->set_workspace(workspace);
   gpu_id_ = gpu_id;
 
   resize_height_ = model_config.classify_resize_height();
@@ -85,9 +88,11 @@ void ClassifyBySimple::Init(
     p[2] = model_config.mean_b();
   }
   scale_ = model_config.scale();
+  max_batch_size_ = std::max(model_config.max_batch_size(), 1);
 
   std::vector<int> shape = {1, resize_height_, resize_width_, 3};
   mean_buffer_.reset(new base::Blob<float>(shape));
+  shape[0] = max_batch_size_;
 
   std::map<std::string, std::vector<int>> input_reshape{
       {net_inputs_[0], shape}};
@@ -111,35 +116,47 @@ void ClassifyBySimple::Perform(const CameraFrame* frame,
     AERROR << "Failed to set device to " << gpu_id_;
     return;
   }
-  std::shared_ptr<base::Blob<uint8_t>> rectified_blob;
   auto input_blob_recog = rt_net_->get_blob(net_inputs_[0]);
   auto output_blob_recog = rt_net_->get_blob(net_outputs_[0]);
 
+  std::vector<base::TrafficLightPtr> batch;
+  batch.reserve(lights->size());
   for (base::TrafficLightPtr light : *lights) {
-    if (!light->region.is_detected) {
-      continue;
+    if (light->region.is_detected) {
+      batch.push_back(light);
     }
+  }
 
-    data_provider_image_option_.crop_roi = light->region.detection_roi;
-    data_provider_image_option_.do_crop = true;
-    data_provider_image_option_.target_color = base::Color::BGR;
-    frame->data_provider->GetImage(data_provider_image_option_, image_.get());
-
-    AINFO << "get img done";
-
-    const float* mean = mean_.get()->cpu_data();
-    inference::ResizeGPU(*image_, input_blob_recog,
-                         frame->data_provider->src_width(), 0, mean[0], mean[1],
-                         mean[2], true, scale_);
+  const float* mean = mean_.get()->cpu_data();
+  for (size_t begin = 0; begin < batch.size(); begin += max_batch_size_) {
+    const int batch_num = static_cast<int>(std::min(
+        batch.size() - begin, static_cast<size_t>(max_batch_size_)));
+    input_blob_recog->Reshape(batch_num, resize_height_, resize_width_, 3);
+    // the crops are views into the uploaded frame, each one is resized
+    // straight into its slot of the input blob
+    for (int i = 0; i < batch_num; ++i) {
+      data_provider_image_option_.crop_roi =
+          batch[begin + i]->region.detection_roi;
+      data_provider_image_option_.do_crop = true;
+      data_provider_image_option_.target_color = base::Color::BGR;
+      frame->data_provider->GetImage(data_provider_image_option_,
+                                     image_.get());
+      inference::ResizeGPU(*image_, input_blob_recog,
+                           frame->data_provider->src_width(), i, mean[0],
+                           mean[1], mean[2], true, scale_);
+    }
 
-    AINFO << "resize gpu finish.";
+    AINFO << "resize gpu finish, batch " << batch_num;
     cudaDeviceSynchronize();
     rt_net_->Infer();
     cudaDeviceSynchronize();
     AINFO << "infer finish.";
 
-    float* out_put_data = output_blob_recog->mutable_cpu_data();
-    Prob2Color(out_put_data, unknown_threshold_, light);
+    const float* out_put_data = output_blob_recog->cpu_data();
+    for (int i = 0; i < batch_num; ++i) {
+      Prob2Color(out_put_data + output_blob_recog->offset(i),
+                 unknown_threshold_, batch[begin + i]);
+    }
   }
 }
 
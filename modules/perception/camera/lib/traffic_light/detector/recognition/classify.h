@@ -36,7 +36,9 @@ class ClassifyBySimple {
   ~ClassifyBySimple() = default;
 
   void Init(const traffic_light::recognition::ClassifyParam& model_config,
-            const int gpu_id, const std::string work_root);
+            const int gpu_id, const std::string work_root,
+            const std::shared_ptr<inference::GpuWorkspace>& workspace =
+                nullptr);
 
   void Perform(const CameraFrame* frame,
                std::vector<base::TrafficLightPtr>* lights);
@@ -53,6 +55,7 @@ class ClassifyBySimple {
   std::vector<std::string> net_outputs_;
   int resize_width_;
   int resize_height_;
+  int max_batch_size_ = 1;
   float unknown_threshold_;
   float scale_;
   int gpu_id_ = 0;
@@ -36,37 +36,39 @@ bool TrafficLightRecognition::Init(
   classify_vertical_.reset(new ClassifyBySimple);
   classify_horizontal_.reset(new ClassifyBySimple);
 
+  workspace_.reset(new inference::GpuWorkspace);
+
   classify_quadrate_->Init(recognize_param_.quadrate_model(), options.gpu_id,
-                           options.root_dir);
+                           options.root_dir, workspace_);
   classify_vertical_->Init(recognize_param_.vertical_model(), options.gpu_id,
-                           options.root_dir);
+                           options.root_dir, workspace_);
   classify_horizontal_->Init(recognize_param_.horizontal_model(),
-                             options.gpu_id, options.root_dir);
+                             options.gpu_id, options.root_dir, workspace_);
 
   return true;
 }
 
 bool TrafficLightRecognition::Detect(const TrafficLightDetectorOptions& options,
                                      CameraFrame* frame) {
-  std::vector<base::TrafficLightPtr> candidate(1);
+  // lights are grouped by shape so each model runs batched inferences
+  std::vector<base::TrafficLightPtr> quadrate;
+  std::vector<base::TrafficLightPtr> vertical;
+  std::vector<base::TrafficLightPtr> horizontal;
+  bool valid_class = true;
 
   for (base::TrafficLightPtr light : frame->traffic_lights) {
     if (light->region.is_detected) {
-      candidate[0] = light;
       if (light->region.detect_class_id ==
           base::TLDetectionClass::TL_QUADRATE_CLASS) {
-        AINFO << "Recognize Use Quadrate Model!";
-        classify_quadrate_->Perform(frame, &candidate);
+        quadrate.push_back(light);
       } else if (light->region.detect_class_id ==
                  base::TLDetectionClass::TL_VERTICAL_CLASS) {
-        AINFO << "Recognize Use Vertical Model!";
-        classify_vertical_->Perform(frame, &candidate);
+        vertical.push_back(light);
       } else if (light->region.detect_class_id ==
                  base::TLDetectionClass::TL_HORIZONTAL_CLASS) {
-        AINFO << "Recognize Use Horizonal Model!";
-        classify_horizontal_->Perform(frame, &candidate);
+        horizontal.push_back(light);
       } else {
-        return false;
+        valid_class = false;
       }
     } else {
       light->status.color = base::TLColor::TL_UNKNOWN_COLOR;
@@ -74,7 +76,20 @@ bool TrafficLightRecognition::Detect(const TrafficLightDetectorOptions& options,
     }
   }
 
-  return true;
+  if (!quadrate.empty()) {
+    AINFO << "Recognize Use Quadrate Model! lights: " << quadrate.size();
+    classify_quadrate_->Perform(frame, &quadrate);
+  }
+  if (!vertical.empty()) {
+    AINFO << "Recognize Use Vertical Model! lights: " << vertical.size();
+    classify_vertical_->Perform(frame, &vertical);
+  }
+  if (!horizontal.empty()) {
+    AINFO << "Recognize Use Horizonal Model! lights: " << horizontal.size();
+    classify_horizontal_->Perform(frame, &horizontal);
+  }
+
+  return valid_class;
 }
 
 std::string TrafficLightRecognition::Name() const {
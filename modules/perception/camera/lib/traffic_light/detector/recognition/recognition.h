@@ -52,6 +52,8 @@ class TrafficLightRecognition : public BaseTrafficLightDetector {
   std::shared_ptr<ClassifyBySimple> classify_vertical_;
   std::shared_ptr<ClassifyBySimple> classify_quadrate_;
   std::shared_ptr<ClassifyBySimple> classify_horizontal_;
+  // the classifiers run one after another
+  std::shared_ptr<inference::GpuWorkspace> workspace_;
   traffic_light::recognition::RecognizeBoxParam recognize_param_;
 };
 
@@ -65,6 +65,34 @@ TEST(UndistortionHandlerTest, test_init) {
   }
 }
 
+TEST(UndistortionHandlerTest, test_shared_map) {
+  unsetenv("MODULE_PATH");
+  unsetenv("CYBER_PATH");
+  FLAGS_obs_sensor_meta_path =
+      "/apollo/modules/perception/testdata/"
+      "camera/common/conf/sensor_meta.config";
+  FLAGS_obs_sensor_intrinsic_path =
+      "/apollo/modules/perception/testdata/"
+      "camera/common/params";
+
+  UndistortionHandler handler1;
+  EXPECT_EQ(handler1.mapx(), nullptr);
+  EXPECT_TRUE(handler1.Init("onsemi_obstacle", 0));
+  UndistortionHandler handler2;
+  EXPECT_TRUE(handler2.Init("onsemi_obstacle", 0));
+
+  // same intrinsics on the same device, the remap is computed once
+  EXPECT_NE(handler1.mapx(), nullptr);
+  EXPECT_EQ(handler1.mapx(), handler2.mapx());
+  EXPECT_EQ(handler1.mapy(), handler2.mapy());
+
+  // the map outlives a released handler while others still use it
+  const base::Blob<float> *mapx = handler1.mapx();
+  EXPECT_TRUE(handler1.Release());
+  EXPECT_EQ(handler1.mapx(), nullptr);
+  EXPECT_EQ(handler2.mapx(), mapx);
+}
+
 TEST(UndistortionHandlerTest, test_undistortion) {
   unsetenv("MODULE_PATH");
   unsetenv("CYBER_PATH");
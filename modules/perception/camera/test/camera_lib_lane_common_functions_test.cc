@@ -341,6 +341,37 @@ TEST(CommonFunctions, FindKLargeValueTest) {
     AINFO << msg;
   }
 }
+
+TEST(CommonFunctions, ransac_fitting_init_coeff_test) {
+  // points on y = 0.01 * x^2 + 0.5 * x + 2 with one outlier
+  std::vector<Eigen::Matrix<float, 2, 1> > pos_vec;
+  for (int i = 0; i < 40; i++) {
+    float x = static_cast<float>(i);
+    Eigen::Matrix<float, 2, 1> pos;
+    pos << x, 0.01f * x * x + 0.5f * x + 2.0f;
+    pos_vec.push_back(pos);
+  }
+  pos_vec[20](1) += 5.0f;
+  Eigen::Matrix<float, 4, 1> init_coeff;
+  init_coeff << 2.0f, 0.5f, 0.01f, 0.0f;
+
+  // the initial guess fits well enough to stop without sampling
+  Eigen::Matrix<float, 4, 1> coeff;
+  std::vector<Eigen::Matrix<float, 2, 1> > inliers = pos_vec;
+  EXPECT_TRUE(RansacFitting(&inliers, &coeff, 200, 8, 0.1f, &init_coeff));
+  EXPECT_FLOAT_EQ(coeff(0), init_coeff(0));
+  EXPECT_FLOAT_EQ(coeff(1), init_coeff(1));
+  EXPECT_FLOAT_EQ(coeff(2), init_coeff(2));
+  EXPECT_EQ(inliers.size(), pos_vec.size() - 1);
+
+  // a bad initial guess is replaced by the sampled fits
+  init_coeff << 10.0f, 0.0f, 0.0f, 0.0f;
+  inliers = pos_vec;
+  EXPECT_TRUE(RansacFitting(&inliers, &coeff, 200, 8, 0.1f, &init_coeff));
+  EXPECT_NEAR(coeff(0), 2.0f, 0.1f);
+  EXPECT_NEAR(coeff(1), 0.5f, 0.01f);
+  EXPECT_EQ(inliers.size(), pos_vec.size() - 1);
+}
 }  // namespace camera
 }  // namespace perception
 }  // namespace apollo
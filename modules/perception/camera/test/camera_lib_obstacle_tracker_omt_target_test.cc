@@ -527,6 +527,42 @@ TEST(TargetTest, clapping_velocity_test) {
   }
 }
 
+TEST(TargetTest, feature_sum_test) {
+  omt::TargetParam target_param;
+  Target target(target_param);
+  auto make_track_obj = [](int frame_id, const std::string &sensor_name,
+                           const std::vector<float> &feature) {
+    TrackObjectPtr track_obj(new TrackObject);
+    track_obj->indicator = PatchIndicator(frame_id, 0, sensor_name);
+    track_obj->object.reset(new base::Object);
+    track_obj->timestamp = frame_id;
+    track_obj->feature = feature;
+    return track_obj;
+  };
+  target.Add(make_track_obj(0, "narrow", {1.0f, 2.0f}));
+  target.Add(make_track_obj(1, "wide", {0.5f, 0.5f}));
+  target.Add(make_track_obj(2, "narrow", {3.0f, -1.0f}));
+  ASSERT_EQ(target.feature_sums.size(), 2);
+  const FeatureSum &narrow = target.feature_sums.at("narrow");
+  EXPECT_EQ(narrow.count, 2);
+  ASSERT_EQ(narrow.sum.size(), 2);
+  EXPECT_DOUBLE_EQ(narrow.sum[0], 4.0);
+  EXPECT_DOUBLE_EQ(narrow.sum[1], 1.0);
+
+  // objects before frame 1 are removed along with their features
+  target.RemoveOld(1);
+  EXPECT_EQ(target.Size(), 2);
+  EXPECT_EQ(target.feature_sums.at("narrow").count, 1);
+  EXPECT_DOUBLE_EQ(target.feature_sums.at("narrow").sum[0], 3.0);
+  EXPECT_DOUBLE_EQ(target.feature_sums.at("narrow").sum[1], -1.0);
+  target.RemoveOld(2);
+  EXPECT_EQ(target.feature_sums.count("wide"), 0);
+  EXPECT_EQ(target.feature_sums.size(), 1);
+
+  target.Clear();
+  EXPECT_TRUE(target.feature_sums.empty());
+}
+
 }  // namespace camera
 }  // namespace perception
 }  // namespace apollo
@@ -551,6 +551,71 @@ TEST(RecognizeTest, rgb_config) {
   }
 }
 
+TEST(RecognizeTest, batch) {
+  std::shared_ptr<TrafficLightRecognition> recognition(
+      new TrafficLightRecognition);
+
+  TrafficLightDetectorInitOptions init_options;
+  TrafficLightDetectorOptions recognition_options;
+  CameraFrame frame;
+  cv::Mat origin_image = cv::imread(
+      "/apollo/modules/perception/testdata/"
+      "camera/lib/traffic_light/detector/recognition/img/yellow.jpg");
+  ASSERT_FALSE(origin_image.data == NULL);
+
+  std::shared_ptr<base::SyncedMemory> img_gpu_data;
+  int size = origin_image.cols * origin_image.rows * origin_image.channels();
+  img_gpu_data.reset(new base::SyncedMemory(size, true));
+
+  memcpy(img_gpu_data->mutable_cpu_data(), origin_image.data,
+         size * sizeof(uint8_t));
+
+  DataProvider data_provider;
+  frame.data_provider = &data_provider;
+  DataProvider::InitOptions dp_init_options;
+  dp_init_options.image_height = origin_image.rows;
+  dp_init_options.image_width = origin_image.cols;
+  dp_init_options.do_undistortion = false;
+  dp_init_options.sensor_name = "onsemi_narrow";
+  dp_init_options.device_id = 0;
+  frame.data_provider->Init(dp_init_options);
+  frame.data_provider->FillImageData(
+      origin_image.rows, origin_image.cols,
+      (const uint8_t *)(img_gpu_data->mutable_gpu_data()), "bgr8");
+
+  // max_batch_size 4, so six lights take a full and a partial batch
+  init_options.conf_file = "batch_config.pt";
+  init_options.root_dir =
+      "/apollo/modules/perception/testdata/"
+      "camera/lib/traffic_light/detector/recognition/data/";
+  init_options.gpu_id = 0;
+  EXPECT_TRUE(recognition->Init(init_options));
+
+  std::vector<base::TrafficLightPtr> lights;
+  base::RectI region(918, 241, 18, 54);
+  for (int i = 0; i < 6; ++i) {
+    lights.emplace_back(new base::TrafficLight);
+    lights[i]->region.is_detected = true;
+    lights[i]->region.detect_class_id =
+        base::TLDetectionClass::TL_VERTICAL_CLASS;
+    lights[i]->region.detection_roi = region;
+  }
+  lights[3]->region.is_detected = false;
+
+  frame.traffic_lights = lights;
+
+#ifndef CPU_ONLY
+  ASSERT_TRUE(recognition->Detect(recognition_options, &frame));
+  for (int i = 0; i < 6; ++i) {
+    if (i == 3) {
+      EXPECT_TRUE(base::TLColor::TL_UNKNOWN_COLOR == lights[i]->status.color);
+    } else {
+      EXPECT_TRUE(base::TLColor::TL_YELLOW == lights[i]->status.color);
+    }
+  }
+#endif
+}
+
 }  // namespace camera
 }  // namespace perception
 }  // namespace apollo
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <numeric>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -31,6 +32,7 @@ class ConvexHull2D {
   ConvexHull2D() : in_cloud_(nullptr) {
     points_.reserve(1000.0);
     polygon_indices_.reserve(1000.0);
+    sorted_indices_.reserve(1000.0);
   }
   ~ConvexHull2D() { in_cloud_ = nullptr; }
   // main interface to get polygon from input point cloud
@@ -108,6 +110,8 @@ class ConvexHull2D {
  private:
   std::vector<Eigen::Vector2d> points_;
   std::vector<std::size_t> polygon_indices_;
+  // kept across calls, so a reused hull does not allocate per cloud
+  std::vector<std::size_t> sorted_indices_;
   const CLOUD_IN_TYPE* in_cloud_;
 };
 
@@ -175,7 +179,8 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     return false;
   }
 
-  std::vector<std::size_t> sorted_indices(points_.size());
+  std::vector<std::size_t>& sorted_indices = sorted_indices_;
+  sorted_indices.resize(points_.size());
   std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
 
   static const double eps = 1e-9;
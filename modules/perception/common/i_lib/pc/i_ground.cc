@@ -17,6 +17,11 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace apollo {
 namespace perception {
@@ -44,6 +49,8 @@ void PlaneFitGroundDetectorParam::SetDefault() {
   nr_ransac_iter_threshold = 32;
   candidate_filter_threshold = 1.0f;  // 1 meter
   nr_smooth_iter = 1;
+  use_temporal_prior = false;
+  nr_threads = 1;
 }
 
 bool PlaneFitGroundDetectorParam::Validate() const {
@@ -215,6 +222,11 @@ bool PlaneFitGroundDetector::Init() {
   }
   memset(reinterpret_cast<void *>(pf_threeds_), 0,
          param_.nr_samples_max_threshold * dim_point_ * sizeof(float));
+  soa_stride_ = (param_.nr_samples_max_threshold + 3) & ~3u;
+  pf_soa_ = IAllocAligned<float>(soa_stride_ * dim_point_, 4);
+  if (!pf_soa_) {
+    return false;
+  }
   // labels:
   labels_ = IAllocAligned<char>(param_.nr_points_max, 4);
   if (!labels_) {
@@ -273,6 +285,7 @@ void PlaneFitGroundDetector::CleanUp() {
   IFree2<std::pair<float, bool> >(&ground_z_);
   IFree2<PlaneFitPointCandIndices>(&local_candis_);
   IFreeAligned<float>(&pf_threeds_);
+  IFreeAligned<float>(&pf_soa_);
   IFreeAligned<char>(&labels_);
   IFreeAligned<unsigned int>(&map_fine_to_coarse_);
   IFreeAligned<float>(&sampled_z_values_);
@@ -392,19 +405,29 @@ void PlaneFitGroundDetector::ComputeSignedGroundHeight(
   for (r = 0; r < nr_points; ++r) {
     height_above_ground[r] = FLT_MAX;
   }
-  ComputeSignedGroundHeightLine(
-      point_cloud, ground_planes_[0], ground_planes_[0], ground_planes_[1],
-      height_above_ground, 0, nr_points, nr_point_elements);
-  for (r = 1; r < nm1; ++r) {
-    ComputeSignedGroundHeightLine(point_cloud, ground_planes_[r - 1],
-                                  ground_planes_[r], ground_planes_[r + 1],
-                                  height_above_ground, r, nr_points,
-                                  nr_point_elements);
-  }
-  ComputeSignedGroundHeightLine(point_cloud, ground_planes_[nm1 - 1],
-                                ground_planes_[nm1], ground_planes_[nm1],
-                                height_above_ground, nm1, nr_points,
-                                nr_point_elements);
+  // every point lies in one coarse cell, so rows write disjoint heights
+  auto compute_lines = [&](unsigned int begin, unsigned int end) {
+    for (unsigned int l = begin; l < end; ++l) {
+      ComputeSignedGroundHeightLine(
+          point_cloud, ground_planes_[l > 0 ? l - 1 : 0], ground_planes_[l],
+          ground_planes_[l < nm1 ? l + 1 : nm1], height_above_ground, l,
+          nr_points, nr_point_elements);
+    }
+  };
+  unsigned int nr_threads =
+      IMax(1u, IMin(param_.nr_threads, param_.nr_grids_coarse));
+  unsigned int lines_per_thread =
+      (param_.nr_grids_coarse + nr_threads - 1) / nr_threads;
+  std::vector<std::thread> workers;
+  for (r = lines_per_thread; r < param_.nr_grids_coarse;
+       r += lines_per_thread) {
+    workers.emplace_back(compute_lines, r,
+                         IMin(r + lines_per_thread, param_.nr_grids_coarse));
+  }
+  compute_lines(0, IMin(lines_per_thread, param_.nr_grids_coarse));
+  for (auto &worker : workers) {
+    worker.join();
+  }
 }
 
 void PlaneFitGroundDetector::ComputeSignedGroundHeightLine(
@@ -630,7 +653,6 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   int nr_inliers = 0;
   int nr_inliers_best = -1;
   int i = 0;
-  int j = 0;
   int rseed = I_DEFAULT_SEED;
   int indices_trial[] = {0, 0, 0};
   int nr_samples = candi->Prune(param_.nr_samples_min_threshold,
@@ -642,11 +664,7 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   // copy 3D points
   float *psrc = nullptr;
   float *pdst = pf_threeds_;
-  for (i = 0; i < nr_samples; ++i) {
-    assert((*candi)[i] < static_cast<int>(nr_points));
-    ICopy3(point_cloud + (nr_point_element * (*candi)[i]), pdst);
-    pdst += dim_point_;
-  }
+  LoadSamples(point_cloud, *candi, nr_samples, nr_points, nr_point_element);
   // generate plane hypothesis and vote
   for (i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
@@ -661,17 +679,7 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
-    nr_inliers = 0;
-    fit_cost = 0;
-    for (j = 0; j < nr_samples; ++j) {
-      ptp_dist = IPlaneToPointDistanceWUnitNorm(plane.params, psrc);
-      if (ptp_dist < dist_thre) {
-        nr_inliers++;
-        fit_cost += ptp_dist;
-      }
-      psrc += dim_point_;
-    }
+    nr_inliers = CountInliers(plane.params, nr_samples, dist_thre, &fit_cost);
     // Assign number of supports
     plane.SetNrSupport(nr_inliers);
 
@@ -815,6 +823,11 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   groundplane->ForceInvalid();
   // not enough samples, failed and return
 
+  // not refitted yet, so this still holds the plane of the last frame
+  GroundPlaneLiDAR prior;
+  if (param_.use_temporal_prior) {
+    prior = ground_planes_[r][c];
+  }
   PlaneFitPointCandIndices &candi = local_candis_[r][c];
   std::vector<std::pair<int, int> > neighbors;
   GetNeighbors(r, c, param_.nr_grids_coarse, param_.nr_grids_coarse,
@@ -826,8 +839,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   }
 
   GroundPlaneLiDAR plane;
+  // random hypotheses, neighbor planes and the temporal prior
   int kNr_iter =
-      param_.nr_ransac_iter_threshold + static_cast<int>(neighbors.size());
+      param_.nr_ransac_iter_threshold + static_cast<int>(neighbors.size()) + 1;
   GroundPlaneLiDAR hypothesis[kNr_iter];
   float ptp_dist = 0.0f;
   int best = -1;
@@ -849,13 +863,19 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   int r_n = 0;
   int c_n = 0;
   float angle = -1.f;
-  for (int i = 0; i < nr_samples; ++i) {
-    assert(candi[i] < static_cast<int>(nr_points));
-    ICopy3(point_cloud + (nr_point_element * candi[i]), pdst);
-    pdst += dim_point_;
+  LoadSamples(point_cloud, candi, nr_samples, nr_points, nr_point_element);
+  // a prior explaining enough samples on its own makes ransac unnecessary
+  bool prior_termi = false;
+  if (prior.IsValid()) {
+    nr_inliers = CountInliers(prior.params, nr_samples, dist_thre, nullptr);
+    if (nr_inliers >= static_cast<int>(param_.nr_inliers_min_threshold)) {
+      hypothesis[kNr_iter - 1] = prior;
+      hypothesis[kNr_iter - 1].SetNrSupport(nr_inliers);
+      prior_termi = nr_inliers > nr_inliers_termi;
+    }
   }
   // generate plane hypothesis and vote
-  for (int i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
+  for (int i = 0; !prior_termi && i < param_.nr_ransac_iter_threshold; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
     ICopy3(pf_threeds_ + indices_trial[0], samples);
@@ -868,15 +888,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
-    nr_inliers = 0;
-    for (int j = 0; j < nr_samples; ++j) {
-      ptp_dist = IPlaneToPointDistanceWUnitNorm(hypothesis[i].params, psrc);
-      if (ptp_dist < dist_thre) {
-        nr_inliers++;
-      }
-      psrc += dim_point_;
-    }
+    nr_inliers =
+        CountInliers(hypothesis[i].params, nr_samples, dist_thre, nullptr);
     // Assign number of supports
     hypothesis[i].SetNrSupport(nr_inliers);
 
@@ -891,16 +904,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     if (ground_planes_[r_n][c_n].IsValid()) {
       hypothesis[i + param_.nr_ransac_iter_threshold] =
           ground_planes_[r_n][c_n];
-      psrc = pf_threeds_;
-      nr_inliers = 0;
-      for (int j = 0; j < nr_samples; ++j) {
-        ptp_dist = IPlaneToPointDistanceWUnitNorm(
-            hypothesis[i + param_.nr_ransac_iter_threshold].params, psrc);
-        if (ptp_dist < dist_thre) {
-          nr_inliers++;
-        }
-        psrc += dim_point_;
-      }
+      nr_inliers = CountInliers(
+          hypothesis[i + param_.nr_ransac_iter_threshold].params, nr_samples,
+          dist_thre, nullptr);
       if (nr_inliers < static_cast<int>(param_.nr_inliers_min_threshold)) {
         hypothesis[i + param_.nr_ransac_iter_threshold].ForceInvalid();
         continue;
@@ -930,6 +936,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
   }
 
+  if (best < 0) {
+    return (0);
+  }
   *groundplane = hypothesis[best];
 
   // check if meet the inlier number requirement
@@ -1035,6 +1044,72 @@ int PlaneFitGroundDetector::FitInOrder() {
   return nr_grids;
 }
 
+void PlaneFitGroundDetector::LoadSamples(const float *point_cloud,
+                                         const PlaneFitPointCandIndices &candi,
+                                         int nr_samples,
+                                         unsigned int nr_points,
+                                         unsigned int nr_point_element) {
+  float *pdst = pf_threeds_;
+  float *xs = pf_soa_;
+  float *ys = pf_soa_ + soa_stride_;
+  float *zs = pf_soa_ + 2 * soa_stride_;
+  for (int i = 0; i < nr_samples; ++i) {
+    assert(candi[i] < static_cast<int>(nr_points));
+    const float *psrc = point_cloud + (nr_point_element * candi[i]);
+    ICopy3(psrc, pdst);
+    xs[i] = psrc[0];
+    ys[i] = psrc[1];
+    zs[i] = psrc[2];
+    pdst += dim_point_;
+  }
+}
+
+int PlaneFitGroundDetector::CountInliers(const float *plane, int nr_samples,
+                                         float dist_thre,
+                                         float *fit_cost) const {
+  const float *xs = pf_soa_;
+  const float *ys = pf_soa_ + soa_stride_;
+  const float *zs = pf_soa_ + 2 * soa_stride_;
+  int nr_inliers = 0;
+  float cost = 0.0f;
+  int i = 0;
+#ifdef __SSE2__
+  const __m128 a = _mm_set1_ps(plane[0]);
+  const __m128 b = _mm_set1_ps(plane[1]);
+  const __m128 c = _mm_set1_ps(plane[2]);
+  const __m128 d = _mm_set1_ps(plane[3]);
+  const __m128 thre = _mm_set1_ps(dist_thre);
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 cost4 = _mm_setzero_ps();
+  for (; i + 4 <= nr_samples; i += 4) {
+    __m128 dist = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, _mm_load_ps(xs + i)),
+                              _mm_mul_ps(b, _mm_load_ps(ys + i))),
+                   _mm_mul_ps(c, _mm_load_ps(zs + i))),
+        d);
+    dist = _mm_andnot_ps(sign_mask, dist);
+    __m128 inlier = _mm_cmplt_ps(dist, thre);
+    nr_inliers += __builtin_popcount(_mm_movemask_ps(inlier));
+    cost4 = _mm_add_ps(cost4, _mm_and_ps(inlier, dist));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, cost4);
+  cost = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+  for (; i < nr_samples; ++i) {
+    float dist =
+        IAbs(plane[0] * xs[i] + plane[1] * ys[i] + plane[2] * zs[i] + plane[3]);
+    if (dist < dist_thre) {
+      nr_inliers++;
+      cost += dist;
+    }
+  }
+  if (fit_cost != nullptr) {
+    *fit_cost = cost;
+  }
+  return nr_inliers;
+}
+
 void PlaneFitGroundDetector::GetNeighbors(
     int r, int c, int rows, int cols,
     std::vector<std::pair<int, int> > *neighbors) {
@@ -1249,10 +1324,12 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
   unsigned int c = 0;
   // Filter to generate plane fitting candidates
   // int nr_candis = Filter();
+  Filter();
   // std::cout << "# of plane candidates: " << nr_candis << std::endl;
   //  Fit local plane using ransac
   // nr_valid_grid = Fit();
   // int nr_valid_grid = FitInOrder();
+  FitInOrder();
   // std::cout << "# of valid plane geometry (fitting): " << nr_valid_grid <<
   // std::endl;
   // Smooth plane using neighborhood information:
@@ -1299,6 +1376,18 @@ const unsigned int PlaneFitGroundDetector::GetGridDimY() const {
 
 float PlaneFitGroundDetector::GetUnknownHeight() { return (FLT_MAX); }
 
+void PlaneFitGroundDetector::TranslateGroundPlanes(const float *shift) {
+  // n * (p' + shift) + d = 0 with p' in the new frame
+  for (unsigned int r = 0; r < param_.nr_grids_coarse; ++r) {
+    for (unsigned int c = 0; c < param_.nr_grids_coarse; ++c) {
+      GroundPlaneLiDAR &plane = ground_planes_[r][c];
+      if (plane.IsValid()) {
+        plane.params[3] += IDot3(plane.params, shift);
+      }
+    }
+  }
+}
+
 PlaneFitPointCandIndices **PlaneFitGroundDetector::GetCandis() const {
   return local_candis_;
 }
@@ -190,6 +190,10 @@ struct PlaneFitGroundDetectorParam {
   float candidate_filter_threshold;
   int nr_ransac_iter_threshold;
   int nr_smooth_iter;
+  // seed each cell with its plane of the previous frame
+  bool use_temporal_prior;
+  // threads computing the point to ground heights
+  unsigned int nr_threads;
 };
 
 struct PlaneFitPointCandIndices {
@@ -254,6 +258,10 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   const unsigned int GetGridDimY() const;
   float GetUnknownHeight();
   PlaneFitPointCandIndices **GetCandis() const;
+  // @brief: re-express the planes of the last frame in a frame whose origin
+  //         lies at shift in the old one, used as priors when
+  //         use_temporal_prior is set
+  void TranslateGroundPlanes(const float *shift);
 
  protected:
   void CleanUp();
@@ -264,6 +272,11 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
               GroundPlaneLiDAR *groundplane, unsigned int nr_points,
               unsigned int nr_point_element, float dist_thre);
   int FitInOrder();
+  void LoadSamples(const float *point_cloud,
+                   const PlaneFitPointCandIndices &candi, int nr_samples,
+                   unsigned int nr_points, unsigned int nr_point_element);
+  int CountInliers(const float *plane, int nr_samples, float dist_thre,
+                   float *fit_cost) const;
   int FilterCandidates(int r, int c, const float *point_cloud,
                        PlaneFitPointCandIndices *candi,
                        std::vector<std::pair<int, int> > *neighbors,
@@ -319,6 +332,9 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   char *labels_;
   float *sampled_z_values_;
   float *pf_threeds_;
+  // pf_threeds_ as x, y and z planes of soa_stride_ floats
+  float *pf_soa_;
+  unsigned int soa_stride_;
   int *sampled_indices_;
   std::pair<int, int> *order_table_;
 };
@@ -35,5 +35,14 @@ DEFINE_bool(enable_base_object_pool, false, "Enable base object pool.");
 DEFINE_string(config_manager_path, "./conf", "The ModelConfig config paths.");
 DEFINE_string(work_root, "", "Project work root direcotry.");
 
+// inference
+DEFINE_bool(enable_rt_engine_cache, true,
+            "Serialize built TensorRT engines and load them on restart.");
+DEFINE_string(rt_engine_cache_dir, "",
+              "The TensorRT engine cache dir, next to the weights if empty.");
+DEFINE_bool(enable_inference_memory_plan, false,
+            "Place the caffe blobs that are not live at the same time in "
+            "one shared GPU arena.");
+
 }  // namespace perception
 }  // namespace apollo
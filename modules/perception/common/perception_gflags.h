@@ -31,5 +31,10 @@ DECLARE_bool(enable_base_object_pool);
 DECLARE_string(config_manager_path);
 DECLARE_string(work_root);
 
+// inference
+DECLARE_bool(enable_rt_engine_cache);
+DECLARE_string(rt_engine_cache_dir);
+DECLARE_bool(enable_inference_memory_plan);
+
 }  // namespace perception
 }  // namespace apollo
@@ -15,10 +15,14 @@
  *****************************************************************************/
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
 
+#include <cmath>
 #include <map>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 
 #include "modules/perception/common/graph/secure_matrix.h"
+#include "modules/perception/lib/utils/perf.h"
 
 namespace apollo {
 namespace perception {
@@ -60,7 +64,9 @@ bool HMTrackersObjectsAssociation::Associate(
               association_result->unassigned_measurements.end(), 0);
     return true;
   }
+  PERCEPTION_PERF_BLOCK_START();
   std::string measurement_sensor_id = sensor_objects[0]->GetSensorId();
+  std::string indicator = "association_" + measurement_sensor_id;
   double measurement_timestamp = sensor_objects[0]->GetTimestamp();
   track_object_distance_.ResetProjectionCache(measurement_sensor_id,
                                               measurement_timestamp);
@@ -68,6 +74,7 @@ bool HMTrackersObjectsAssociation::Associate(
   IdAssign(fusion_tracks, sensor_objects, &association_result->assignments,
            &association_result->unassigned_tracks,
            &association_result->unassigned_measurements, do_nothing, false);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "id_assign");
 
   Eigen::Affine3d pose;
   sensor_measurements->GetPose(&pose);
@@ -78,6 +85,7 @@ bool HMTrackersObjectsAssociation::Associate(
                                 association_result->unassigned_tracks,
                                 association_result->unassigned_measurements,
                                 &association_mat);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "distance_mat");
 
   int num_track = static_cast<int>(fusion_tracks.size());
   int num_measurement = static_cast<int>(sensor_objects.size());
@@ -109,6 +117,7 @@ bool HMTrackersObjectsAssociation::Associate(
       association_mat, track_ind_l2g, measurement_ind_l2g,
       &association_result->assignments, &association_result->unassigned_tracks,
       &association_result->unassigned_measurements);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "minimize_assignment");
 
   // start do post assign
   std::vector<TrackMeasurmentPair> post_assignments;
@@ -128,6 +137,7 @@ bool HMTrackersObjectsAssociation::Associate(
                   association_result->unassigned_tracks, track_ind_g2l,
                   measurement_ind_g2l, measurement_ind_l2g, association_mat,
                   association_result);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "post_assign");
 
   AINFO << "association: measurement_num = " << sensor_objects.size()
         << ", track_num = " << fusion_tracks.size()
@@ -305,32 +315,60 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
   Eigen::Vector3d tmp = Eigen::Vector3d::Zero();
   opt.ref_point = &tmp;
   association_mat->resize(unassigned_tracks.size());
+
+  // hash measurements into cells as large as the center gate, then a track
+  // only has to check measurements in the 3x3 cells around its center
+  const double cell_size = s_association_center_dist_threshold_;
+  auto cell_index = [cell_size](double v) {
+    return static_cast<int64_t>(std::floor(v / cell_size));
+  };
+  auto cell_key = [](int64_t x, int64_t y) {
+    return (x << 32) ^ (y & 0xffffffff);
+  };
+  std::unordered_map<int64_t, std::vector<size_t>> measurement_grid;
+  for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
+    const Eigen::Vector3d& center =
+        sensor_objects[unassigned_measurements[j]]->GetBaseObject()->center;
+    measurement_grid[cell_key(cell_index(center(0)), cell_index(center(1)))]
+        .push_back(j);
+  }
+
   for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
     int fusion_idx = static_cast<int>(unassigned_tracks[i]);
-    (*association_mat)[i].resize(unassigned_measurements.size());
+    (*association_mat)[i].assign(unassigned_measurements.size(),
+                                 s_match_distance_thresh_);
     const TrackPtr& fusion_track = fusion_tracks[fusion_idx];
-    for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
-      int sensor_idx = static_cast<int>(unassigned_measurements[j]);
-      const SensorObjectPtr& sensor_object = sensor_objects[sensor_idx];
-      double distance = s_match_distance_thresh_;
-      double center_dist =
-          (sensor_object->GetBaseObject()->center -
-           fusion_track->GetFusedObject()->GetBaseObject()->center)
-              .norm();
-      if (center_dist < s_association_center_dist_threshold_) {
-        distance =
-            track_object_distance_.Compute(fusion_track, sensor_object, opt);
-      } else {
-        ADEBUG << "center_distance " << center_dist
-               << " exceeds slack threshold "
-               << s_association_center_dist_threshold_
-               << ", track_id: " << fusion_track->GetTrackId()
-               << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
+    const Eigen::Vector3d& track_center =
+        fusion_track->GetFusedObject()->GetBaseObject()->center;
+    int64_t track_x = cell_index(track_center(0));
+    int64_t track_y = cell_index(track_center(1));
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        auto iter = measurement_grid.find(cell_key(track_x + dx, track_y + dy));
+        if (iter == measurement_grid.end()) {
+          continue;
+        }
+        for (size_t j : iter->second) {
+          int sensor_idx = static_cast<int>(unassigned_measurements[j]);
+          const SensorObjectPtr& sensor_object = sensor_objects[sensor_idx];
+          double center_dist =
+              (sensor_object->GetBaseObject()->center - track_center).norm();
+          if (center_dist >= s_association_center_dist_threshold_) {
+            ADEBUG << "center_distance " << center_dist
+                   << " exceeds slack threshold "
+                   << s_association_center_dist_threshold_
+                   << ", track_id: " << fusion_track->GetTrackId()
+                   << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
+            continue;
+          }
+          double distance =
+              track_object_distance_.Compute(fusion_track, sensor_object, opt);
+          (*association_mat)[i][j] = distance;
+          ADEBUG << "track_id: " << fusion_track->GetTrackId()
+                 << ", obs_id: " << sensor_object->GetBaseObject()->track_id
+                 << ", distance: " << distance;
+        }
       }
-      (*association_mat)[i][j] = distance;
-      ADEBUG << "track_id: " << fusion_track->GetTrackId()
-             << ", obs_id: " << sensor_object->GetBaseObject()->track_id
-             << ", distance: " << distance;
     }
   }
 }
@@ -151,12 +151,15 @@ bool ProbabilisticFusion::Fuse(const FusionOptions& options,
   AINFO << "Get " << frames.size() << " related frames for fusion";
 
   // 3. peform fusion on related frames
+  PERCEPTION_PERF_BLOCK_START();
   for (size_t i = 0; i < frames.size(); ++i) {
     this->FuseFrame(frames[i]);
   }
+  PERCEPTION_PERF_BLOCK_END("fusion_fuse_frames");
 
   // 4. collect fused objects
   this->CollectFusedObjects(fusion_time, fused_objects);
+  PERCEPTION_PERF_BLOCK_END("fusion_collect_objects");
 
   fuse_mutex_.unlock();
   return true;
@@ -186,9 +189,14 @@ void ProbabilisticFusion::FuseFrame(const SensorFramePtr& frame) {
         << ", background_object_number: "
         << frame->GetBackgroundObjects().size()
         << ", timestamp: " << GLOG_TIMESTAMP(frame->GetTimestamp());
+  PERCEPTION_PERF_BLOCK_START();
+  std::string indicator = "fusion_" + frame->GetSensorId();
   this->FuseForegroundTrack(frame);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "fuse_foreground");
   this->FusebackgroundTrack(frame);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "fuse_background");
   this->RemoveLostTrack();
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "remove_lost_track");
 }
 
 void ProbabilisticFusion::FuseForegroundTrack(const SensorFramePtr& frame) {
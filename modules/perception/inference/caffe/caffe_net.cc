@@ -17,6 +17,8 @@
 #include "modules/perception/inference/caffe/caffe_net.h"
 
 #include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/inference/utils/memory_planner.h"
 
 namespace apollo {
 namespace perception {
@@ -66,6 +68,9 @@ bool CaffeNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
     blob.reset(new apollo::perception::base::Blob<float>(caffe_blob->shape()));
     blobs_.insert(std::make_pair(name, blob));
   }
+  if (FLAGS_enable_inference_memory_plan && gpu_id_ >= 0) {
+    PlanMemory();
+  }
   return true;
 }
 
@@ -92,15 +97,111 @@ bool CaffeNet::reshape() {
     auto caffe_blob = net_->blob_by_name(name);
     if (caffe_blob != nullptr && blob != nullptr) {
       caffe_blob->Reshape(blob->shape());
+    }
+  }
+  net_->Reshape();
+  // the inputs are copied once their memory is placed
+  if (!planned_memory_.empty()) {
+    ApplyMemoryPlan();
+  }
+  for (auto name : input_names_) {
+    auto blob = this->get_blob(name);
+    auto caffe_blob = net_->blob_by_name(name);
+    if (caffe_blob != nullptr && blob != nullptr) {
       cudaMemcpy(caffe_blob->mutable_gpu_data(), blob->gpu_data(),
                  caffe_blob->count() * sizeof(float), cudaMemcpyDeviceToDevice);
     }
   }
-  net_->Reshape();
 
   return true;
 }
 
+void CaffeNet::PlanMemory() {
+  planned_memory_.clear();
+  planned_offsets_.clear();
+  planned_blobs_.clear();
+  applied_arena_data_ = nullptr;
+
+  // the first and the last layer using each memory, blobs share the memory
+  // of the blob they are split, reshaped or flattened from
+  const auto &bottom_vecs = net_->bottom_vecs();
+  const auto &top_vecs = net_->top_vecs();
+  const int num_layers = static_cast<int>(top_vecs.size());
+  std::map<caffe::SyncedMemory *, size_t> memory_index;
+  std::vector<std::pair<int, int>> lifetimes;
+  auto use = [&](caffe::Blob<float> *blob, int layer) {
+    const auto &memory = blob->data();
+    if (memory == nullptr || memory->size() == 0) {
+      return;
+    }
+    auto iter = memory_index.find(memory.get());
+    if (iter == memory_index.end()) {
+      memory_index[memory.get()] = planned_memory_.size();
+      planned_memory_.push_back(memory);
+      lifetimes.emplace_back(layer, layer);
+    } else {
+      lifetimes[iter->second].second = layer;
+    }
+    planned_blobs_.emplace_back(blob, memory.get());
+  };
+  for (int i = 0; i < num_layers; ++i) {
+    for (auto *blob : bottom_vecs[i]) {
+      use(blob, i);
+    }
+    for (auto *blob : top_vecs[i]) {
+      use(blob, i);
+    }
+  }
+  // the outputs are copied out after the last layer
+  for (auto name : output_names_) {
+    auto caffe_blob = net_->blob_by_name(name);
+    if (caffe_blob != nullptr) {
+      use(caffe_blob.get(), num_layers);
+    }
+  }
+
+  MemoryPlanner planner;
+  for (size_t i = 0; i < planned_memory_.size(); ++i) {
+    planner.AddBuffer(planned_memory_[i]->size(), lifetimes[i].first,
+                      lifetimes[i].second);
+  }
+  planner.Plan();
+  for (int i = 0; i < planner.buffer_num(); ++i) {
+    planned_offsets_.push_back(planner.offset(i));
+  }
+
+  if (workspace_ == nullptr && arena_ == nullptr) {
+    arena_.reset(new GpuWorkspace);
+  }
+  auto arena = workspace_ != nullptr ? workspace_ : arena_;
+  // blobs of the earlier plan may still point to the arena, caffe aborts on
+  // failed allocations as well
+  CHECK(arena->Reserve(planner.planned_size()));
+  AINFO << "Planned " << planner.planned_size() << " bytes of blob memory for "
+        << planner.naive_size() << " bytes of " << planner.buffer_num()
+        << " blobs of " << net_file_;
+}
+
+void CaffeNet::ApplyMemoryPlan() {
+  for (const auto &planned_blob : planned_blobs_) {
+    if (planned_blob.first->data().get() != planned_blob.second) {
+      AINFO << "Blob memory of " << net_file_ << " grew, plan it again";
+      PlanMemory();
+      break;
+    }
+  }
+  // another network may have grown the shared workspace
+  auto arena = workspace_ != nullptr ? workspace_ : arena_;
+  if (arena->data() == applied_arena_data_) {
+    return;
+  }
+  char *data = static_cast<char *>(arena->data());
+  for (size_t i = 0; i < planned_memory_.size(); ++i) {
+    planned_memory_[i]->set_gpu_data(data + planned_offsets_[i]);
+  }
+  applied_arena_data_ = arena->data();
+}
+
 void CaffeNet::Infer() {
   if (gpu_id_ >= 0) {
     caffe::Caffe::SetDevice(gpu_id_);
@@ -54,11 +54,27 @@ class CaffeNet : public Inference {
   std::shared_ptr<caffe::Net<float>> net_ = nullptr;
 
  private:
+  // Places the memory of the blobs in one arena, blobs that are not live at
+  // the same time during Forward() share it.
+  void PlanMemory();
+  // Points the blobs to their place in the arena, plans again if a reshape
+  // replaced the memory of a blob.
+  void ApplyMemoryPlan();
+
   std::string net_file_;
   std::string model_file_;
   std::vector<std::string> output_names_;
   std::vector<std::string> input_names_;
   BlobMap blobs_;
+
+  std::vector<boost::shared_ptr<caffe::SyncedMemory>> planned_memory_;
+  std::vector<size_t> planned_offsets_;
+  // the memory each blob had when planned
+  std::vector<std::pair<caffe::Blob<float> *, caffe::SyncedMemory *>>
+      planned_blobs_;
+  // the arena when no workspace is shared
+  std::shared_ptr<GpuWorkspace> arena_ = nullptr;
+  void *applied_arena_data_ = nullptr;
 };
 
 }  // namespace inference
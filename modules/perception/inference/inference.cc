@@ -26,6 +26,10 @@ void Inference::set_max_batch_size(const int &batch_size) {
 
 void Inference::set_gpu_id(const int &gpu_id) { gpu_id_ = gpu_id; }
 
+void Inference::set_workspace(const std::shared_ptr<GpuWorkspace> &workspace) {
+  workspace_ = workspace;
+}
+
 }  // namespace inference
 }  // namespace perception
 }  // namespace apollo
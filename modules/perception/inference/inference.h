@@ -24,6 +24,7 @@
 #include "boost/shared_ptr.hpp"
 
 #include "modules/perception/base/blob.h"
+#include "modules/perception/inference/utils/gpu_workspace.h"
 
 namespace apollo {
 namespace perception {
@@ -46,12 +47,17 @@ class Inference {
 
   void set_gpu_id(const int &gpu_id);
 
+  // share GPU memory with the other networks that run on the same thread,
+  // set before Init()
+  void set_workspace(const std::shared_ptr<GpuWorkspace> &workspace);
+
   virtual std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
       const std::string &name) = 0;
 
  protected:
   int max_batch_size_ = 1;
   int gpu_id_ = 0;
+  std::shared_ptr<GpuWorkspace> workspace_ = nullptr;
 };
 
 }  // namespace inference
@@ -33,6 +33,10 @@ Inference *CreateInferenceByName(const std::string &name,
     return new CaffeNet(proto_file, weight_file, outputs, inputs);
   } else if (name == "RTNet") {
     return new RTNet(proto_file, weight_file, outputs, inputs);
+  } else if (name == "RTNetFP16") {
+    RTNet *net = new RTNet(proto_file, weight_file, outputs, inputs);
+    net->set_fp16_mode(true);
+    return net;
   } else if (name == "RTNetInt8") {
     return new RTNet(proto_file, weight_file, outputs, inputs, model_root);
   }
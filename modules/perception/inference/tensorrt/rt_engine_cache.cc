@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/tensorrt/rt_engine_cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+void HashBytes(const char *data, size_t size, uint64_t *hash) {
+  for (size_t i = 0; i < size; ++i) {
+    *hash ^= static_cast<unsigned char>(data[i]);
+    *hash *= kFnvPrime;
+  }
+}
+
+std::string ToHex(uint64_t hash) {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+}  // namespace
+
+std::string HashFiles(const std::vector<std::string> &files) {
+  uint64_t hash = kFnvOffset;
+  std::vector<char> buffer(1 << 20);
+  for (const auto &file : files) {
+    std::ifstream input(file, std::ios::binary);
+    if (!input.good()) {
+      AWARN << "Failed to read " << file << " for the engine cache key.";
+      return "";
+    }
+    while (input) {
+      input.read(buffer.data(), buffer.size());
+      HashBytes(buffer.data(), static_cast<size_t>(input.gcount()), &hash);
+    }
+  }
+  return ToHex(hash);
+}
+
+std::string EngineCacheFile(const std::string &dir, const RTEngineKey &key) {
+  uint64_t hash = kFnvOffset;
+  for (const std::string *field :
+       {&key.model_hash, &key.gpu_arch, &key.precision, &key.input_shapes,
+        &key.tensorrt_version}) {
+    // the separator keeps ("ab", "c") and ("a", "bc") apart
+    HashBytes(field->c_str(), field->size() + 1, &hash);
+  }
+  std::string file = dir;
+  if (!file.empty() && file.back() != '/') {
+    file += '/';
+  }
+  return file + ToHex(hash) + "_" + key.precision + ".engine";
+}
+
+bool LoadEngineCache(const std::string &file, std::string *data) {
+  std::ifstream input(file, std::ios::binary);
+  if (!input.good()) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << input.rdbuf();
+  *data = oss.str();
+  return !data->empty();
+}
+
+bool SaveEngineCache(const std::string &file, const void *data, size_t size) {
+  const std::string tmp_file = file + ".tmp";
+  {
+    std::ofstream output(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!output.good()) {
+      AWARN << "Failed to open " << tmp_file;
+      return false;
+    }
+    output.write(reinterpret_cast<const char *>(data), size);
+    if (!output.good()) {
+      AWARN << "Failed to write " << tmp_file;
+      std::remove(tmp_file.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_file.c_str(), file.c_str()) != 0) {
+    AWARN << "Failed to rename " << tmp_file << " to " << file;
+    std::remove(tmp_file.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
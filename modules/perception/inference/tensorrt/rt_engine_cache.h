@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Everything a serialized engine depends on, the file name is a hash of all
+// fields so that a stale engine is never picked up.
+struct RTEngineKey {
+  // hash of the prototxt and the weights
+  std::string model_hash;
+  // device name and compute capability
+  std::string gpu_arch;
+  // fp32, fp16 or int8
+  std::string precision;
+  // max batch size and input dimensions
+  std::string input_shapes;
+  std::string tensorrt_version;
+};
+
+// 64 bit FNV-1a of the contents of the files in hex, empty if one of them
+// can not be read
+std::string HashFiles(const std::vector<std::string> &files);
+
+std::string EngineCacheFile(const std::string &dir, const RTEngineKey &key);
+
+bool LoadEngineCache(const std::string &file, std::string *data);
+
+// writes a temporary file renamed into place, so that a crash while writing
+// does not leave a truncated engine behind
+bool SaveEngineCache(const std::string &file, const void *data, size_t size);
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
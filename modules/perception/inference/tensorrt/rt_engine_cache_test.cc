@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/tensorrt/rt_engine_cache.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+TEST(RTEngineCacheTest, key) {
+  RTEngineKey key;
+  key.model_hash = "0123";
+  key.gpu_arch = "Tesla V100 7.0";
+  key.precision = "fp16";
+  key.input_shapes = "1 3x8x8";
+  key.tensorrt_version = "5.1.5";
+  const std::string file = EngineCacheFile("/tmp", key);
+  EXPECT_EQ(file.find("/tmp/"), 0);
+  EXPECT_EQ(file, EngineCacheFile("/tmp/", key));
+
+  RTEngineKey other = key;
+  other.input_shapes = "2 3x8x8";
+  EXPECT_NE(file, EngineCacheFile("/tmp", other));
+  other = key;
+  other.precision = "int8";
+  EXPECT_NE(file, EngineCacheFile("/tmp", other));
+}
+
+TEST(RTEngineCacheTest, hash_files) {
+  const std::string first = "/tmp/rt_engine_cache_test_first";
+  const std::string second = "/tmp/rt_engine_cache_test_second";
+  std::ofstream(first) << "prototxt";
+  std::ofstream(second) << "weights";
+  const std::string hash = HashFiles({first, second});
+  EXPECT_EQ(hash.size(), 16);
+  EXPECT_EQ(hash, HashFiles({first, second}));
+  EXPECT_NE(hash, HashFiles({second, first}));
+  EXPECT_EQ(HashFiles({first, "/tmp/rt_engine_cache_test_missing"}), "");
+}
+
+TEST(RTEngineCacheTest, save_and_load) {
+  const std::string file = "/tmp/rt_engine_cache_test.engine";
+  const std::string engine("serialized\0engine", 17);
+  ASSERT_TRUE(SaveEngineCache(file, engine.data(), engine.size()));
+  std::string data;
+  ASSERT_TRUE(LoadEngineCache(file, &data));
+  EXPECT_EQ(data, engine);
+  EXPECT_FALSE(LoadEngineCache("/tmp/rt_engine_cache_test_missing", &data));
+  EXPECT_FALSE(SaveEngineCache("/not_exist/engine", engine.data(), 1));
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -17,9 +17,12 @@
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 #include <algorithm>
+#include <sstream>
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/inference/tensorrt/rt_engine_cache.h"
 #include "modules/perception/inference/tensorrt/plugins/argmax_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/slice_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/softmax_plugin.h"
@@ -224,6 +227,7 @@ void RTNet::addSliceLayer(const LayerParameter &layer_param,
   nvinfer1::IPluginLayer *sliceLayer =
       net->addPlugin(inputs, nbInputs, *slice_plugin);
   slice_plugins_.push_back(slice_plugin);
+  plugin_factory_.AddPlugin(layer_param.name(), slice_plugin.get());
   sliceLayer->setName(layer_param.name().c_str());
   ConstructMap(layer_param, sliceLayer, tensor_map, tensor_modify_map);
 }
@@ -303,6 +307,7 @@ void RTNet::addSoftmaxLayer(const LayerParameter &layer_param,
     softmax_plugin.reset(new SoftmaxPlugin(layer_param.softmax_param(),
                                            inputs[0]->getDimensions()));
     softmax_plugins_.push_back(softmax_plugin);
+    plugin_factory_.AddPlugin(layer_param.name(), softmax_plugin.get());
     nvinfer1::IPluginLayer *softmaxLayer =
         net->addPlugin(inputs, nbInputs, *softmax_plugin);
     softmaxLayer->setName(layer_param.name().c_str());
@@ -341,6 +346,7 @@ void RTNet::addArgmaxLayer(const LayerParameter &layer_param,
   argmax_plugin.reset(new ArgMax1Plugin(layer_param.argmax_param(),
                                         inputs[0]->getDimensions()));
   argmax_plugins_.push_back(argmax_plugin);
+  plugin_factory_.AddPlugin(layer_param.name(), argmax_plugin.get());
   nvinfer1::IPluginLayer *argmaxLayer =
       net->addPlugin(inputs, nbInputs, *argmax_plugin);
 
@@ -532,7 +538,10 @@ nvinfer1::Weights RTNet::loadLayerWeights(float data, int size) {
 RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs)
-    : output_names_(outputs), input_names_(inputs) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      net_file_(net_file),
+      model_file_(model_file) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -541,7 +550,10 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs,
              nvinfer1::Int8EntropyCalibrator *calibrator)
-    : output_names_(outputs), input_names_(inputs) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      net_file_(net_file),
+      model_file_(model_file) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -552,7 +564,11 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs,
              const std::string &model_root)
-    : output_names_(outputs), input_names_(inputs), is_own_calibrator_(true) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      is_own_calibrator_(true),
+      net_file_(net_file),
+      model_file_(model_file) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -624,14 +640,40 @@ bool RTNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
   cudaDeviceProp prop;
   cudaGetDeviceProperties(&prop, gpu_id_);
   bool int8_mode = checkInt8(prop.name, calibrator_);
+  bool fp16_mode = !int8_mode && checkFp16();
 
   builder_->setInt8Mode(int8_mode);
   builder_->setInt8Calibrator(calibrator_);
+  builder_->setFp16Mode(fp16_mode);
 
   builder_->setDebugSync(true);
 
-  nvinfer1::ICudaEngine *engine = builder_->buildCudaEngine(*network_);
-  context_ = engine->createExecutionContext();
+  std::string cache_file;
+  nvinfer1::ICudaEngine *engine = nullptr;
+  if (FLAGS_enable_rt_engine_cache) {
+    cache_file = engineCacheFile(
+        prop, int8_mode ? "int8" : (fp16_mode ? "fp16" : "fp32"), shapes);
+    engine = loadEngine(cache_file);
+  }
+  if (engine == nullptr) {
+    engine = builder_->buildCudaEngine(*network_);
+    CHECK_NOTNULL(engine);
+    saveEngine(cache_file, engine);
+  }
+  // TensorRT plans the activations of the engine itself, they take the
+  // shared workspace between runs when the version allows it
+#if NV_TENSORRT_MAJOR >= 5
+  if (workspace_ != nullptr &&
+      workspace_->Reserve(engine->getDeviceMemorySize())) {
+    context_ = engine->createExecutionContextWithoutDeviceMemory();
+    shares_workspace_ = true;
+  }
+  AINFO << "Activations take " << engine->getDeviceMemorySize() << " bytes"
+        << (shares_workspace_ ? " of the shared workspace" : "");
+#endif
+  if (context_ == nullptr) {
+    context_ = engine->createExecutionContext();
+  }
   buffers_.resize(input_names_.size() + output_names_.size());
   init_blob(&input_names_);
   init_blob(&output_names_);
@@ -653,6 +695,84 @@ bool RTNet::checkInt8(const std::string &gpu_name,
   calibrator_ = nullptr;
   return false;
 }
+bool RTNet::checkFp16() {
+  if (!fp16_mode_) {
+    return false;
+  }
+  if (builder_->platformHasFastFp16()) {
+    AINFO << "Device Works on FP16 Mode.";
+    return true;
+  }
+  AWARN << "Device Not Supports FP16 Mode. Use FP32 Mode.";
+  return false;
+}
+std::string RTNet::engineCacheFile(
+    const cudaDeviceProp &prop, const std::string &precision,
+    const std::map<std::string, std::vector<int>> &shapes) {
+  RTEngineKey key;
+  key.model_hash = HashFiles({net_file_, model_file_});
+  if (key.model_hash.empty()) {
+    return "";
+  }
+  key.gpu_arch = std::string(prop.name) + " " + std::to_string(prop.major) +
+                 "." + std::to_string(prop.minor);
+  key.precision = precision;
+  std::ostringstream oss;
+  oss << max_batch_size_;
+  for (const auto &shape : shapes) {
+    oss << " " << shape.first;
+    for (int dim : shape.second) {
+      oss << "x" << dim;
+    }
+  }
+  for (const auto &name : output_names_) {
+    oss << " " << name;
+  }
+  key.input_shapes = oss.str();
+  key.tensorrt_version = std::to_string(NV_TENSORRT_MAJOR) + "." +
+                         std::to_string(NV_TENSORRT_MINOR) + "." +
+                         std::to_string(NV_TENSORRT_PATCH);
+
+  std::string dir = FLAGS_rt_engine_cache_dir;
+  if (dir.empty()) {
+    auto pos = model_file_.find_last_of('/');
+    dir = pos == std::string::npos ? "." : model_file_.substr(0, pos);
+  }
+  return EngineCacheFile(dir, key);
+}
+nvinfer1::ICudaEngine *RTNet::loadEngine(const std::string &cache_file) {
+  std::string data;
+  if (cache_file.empty() || !LoadEngineCache(cache_file, &data)) {
+    return nullptr;
+  }
+  if (runtime_ == nullptr) {
+    runtime_ = nvinfer1::createInferRuntime(rt_gLogger);
+  }
+  nvinfer1::ICudaEngine *engine =
+      runtime_->deserializeCudaEngine(data.data(), data.size(),
+                                      &plugin_factory_);
+  if (engine == nullptr) {
+    AWARN << "Failed to deserialize " << cache_file << ", rebuild the engine.";
+    return nullptr;
+  }
+  AINFO << "Load engine from " << cache_file;
+  return engine;
+}
+void RTNet::saveEngine(const std::string &cache_file,
+                       nvinfer1::ICudaEngine *engine) {
+  if (cache_file.empty()) {
+    return;
+  }
+  nvinfer1::IHostMemory *serialized = engine->serialize();
+  if (serialized == nullptr) {
+    AWARN << "Failed to serialize the engine.";
+    return;
+  }
+  if (SaveEngineCache(cache_file, serialized->data(), serialized->size())) {
+    AINFO << "Save engine to " << cache_file;
+  }
+  serialized->destroy();
+}
 bool RTNet::addInput(const TensorDimsMap &tensor_dims_map,
                      const std::map<std::string, std::vector<int>> &shapes,
                      TensorMap *tensor_map) {
@@ -720,6 +840,9 @@ RTNet::~RTNet() {
     network_->destroy();
     builder_->destroy();
     context_->destroy();
+    if (runtime_ != nullptr) {
+      runtime_->destroy();
+    }
     for (auto buf : buffers_) {
       cudaFree(buf);
     }
@@ -747,6 +870,12 @@ void RTNet::Infer() {
       blob->gpu_data();
     }
   }
+#if NV_TENSORRT_MAJOR >= 5
+  // another network may have grown the shared workspace
+  if (shares_workspace_) {
+    context_->setDeviceMemory(workspace_->data());
+  }
+#endif
   context_->enqueue(max_batch_size_, &buffers_[0], stream_, nullptr);
   BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
 
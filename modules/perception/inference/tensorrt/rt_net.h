@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "cyber/common/log.h"
 #include "modules/perception/inference/inference.h"
 #include "modules/perception/inference/tensorrt/entropy_calibrator.h"
 #include "modules/perception/proto/rt.pb.h"
@@ -52,6 +53,26 @@ const std::vector<std::string> _gpu_checklist{
     "Tesla P40",           "GeForce GTX 1070",    "GeForce GTX 1060",
     "Tesla V100-SXM2-16GB"};
 
+// Hands the plugins of the parsed network to a deserialized engine, none of
+// them serializes its parameters.
+class RTPluginFactory : public nvinfer1::IPluginFactory {
+ public:
+  void AddPlugin(const std::string &layer_name, nvinfer1::IPlugin *plugin) {
+    plugins_[layer_name] = plugin;
+  }
+
+  nvinfer1::IPlugin *createPlugin(const char *layer_name,
+                                  const void *serial_data,
+                                  size_t serial_length) override {
+    auto iter = plugins_.find(layer_name);
+    CHECK(iter != plugins_.end()) << "unknown plugin layer " << layer_name;
+    return iter->second;
+  }
+
+ private:
+  std::map<std::string, nvinfer1::IPlugin *> plugins_;
+};
+
 class RTNet : public Inference {
  public:
   RTNet(const std::string &net_file, const std::string &model_file,
@@ -74,6 +95,10 @@ class RTNet : public Inference {
   std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
       const std::string &name) override;
 
+  // builds FP16 kernels where the device supports them, INT8 takes
+  // precedence when a calibrator is given
+  void set_fp16_mode(bool fp16_mode) { fp16_mode_ = fp16_mode; }
+
  protected:
   bool addInput(const TensorDimsMap &tensor_dims_map,
                 const std::map<std::string, std::vector<int>> &shapes,
@@ -167,6 +192,14 @@ class RTNet : public Inference {
                        TensorModifyMap *tensor_modify_map);
   bool checkInt8(const std::string &gpu_name,
                  nvinfer1::IInt8Calibrator *calibrator);
+  bool checkFp16();
+  std::string engineCacheFile(const cudaDeviceProp &prop,
+                              const std::string &precision,
+                              const std::map<std::string, std::vector<int>>
+                                  &shapes);
+  nvinfer1::ICudaEngine *loadEngine(const std::string &cache_file);
+  void saveEngine(const std::string &cache_file,
+                  nvinfer1::ICudaEngine *engine);
   void mergeBN(int index, LayerParameter *layer_param);
   nvinfer1::Weights loadLayerWeights(const float *data, int size);
   nvinfer1::Weights loadLayerWeights(float data, int size);
@@ -176,6 +209,9 @@ class RTNet : public Inference {
 
  private:
   nvinfer1::IExecutionContext *context_ = nullptr;
+  bool shares_workspace_ = false;
+  nvinfer1::IRuntime *runtime_ = nullptr;
+  RTPluginFactory plugin_factory_;
   cudaStream_t stream_ = 0;
   std::vector<std::shared_ptr<ArgMax1Plugin>> argmax_plugins_;
   std::vector<std::shared_ptr<SoftmaxPlugin>> softmax_plugins_;
@@ -191,6 +227,9 @@ class RTNet : public Inference {
   nvinfer1::Int8EntropyCalibrator *calibrator_ = nullptr;
   bool is_own_calibrator_ = true;
   std::string model_root_;
+  std::string net_file_;
+  std::string model_file_;
+  bool fp16_mode_ = false;
   nvinfer1::IBuilder *builder_ = nullptr;
   nvinfer1::INetworkDefinition *network_ = nullptr;
   std::vector<std::shared_ptr<float>> weights_mem_;
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/gpu_stage_timer.h"
+
+#include "cyber/common/log.h"
+#include "modules/perception/lib/utils/profiler.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+GpuStageTimer::GpuStageTimer(const std::string &name) : name_("gpu/" + name) {
+  if (cudaEventCreate(&start_) != cudaSuccess ||
+      cudaEventCreate(&stop_) != cudaSuccess) {
+    AERROR << "Failed to create cuda events for " << name_;
+    start_ = nullptr;
+    stop_ = nullptr;
+  }
+}
+
+GpuStageTimer::~GpuStageTimer() {
+  Collect();
+  if (start_ != nullptr) {
+    cudaEventDestroy(start_);
+  }
+  if (stop_ != nullptr) {
+    cudaEventDestroy(stop_);
+  }
+}
+
+void GpuStageTimer::Start(cudaStream_t stream) {
+  if (start_ == nullptr) {
+    return;
+  }
+  Collect();
+  cudaEventRecord(start_, stream);
+}
+
+void GpuStageTimer::Stop(cudaStream_t stream) {
+  if (stop_ == nullptr) {
+    return;
+  }
+  cudaEventRecord(stop_, stream);
+  pending_ = true;
+}
+
+void GpuStageTimer::Collect() {
+  if (!pending_) {
+    return;
+  }
+  pending_ = false;
+  if (cudaEventSynchronize(stop_) != cudaSuccess) {
+    return;
+  }
+  float elapsed_ms = 0.f;
+  if (cudaEventElapsedTime(&elapsed_ms, start_, stop_) == cudaSuccess) {
+    lib::Profiler::Instance()->Record(
+        name_, static_cast<uint64_t>(elapsed_ms * 1000.f));
+  }
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
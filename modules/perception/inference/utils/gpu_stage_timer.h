@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <string>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Times a GPU stage with CUDA events into lib::Profiler as "gpu/<name>".
+// Stop() never synchronizes, the elapsed time of a stage is collected on the
+// next Start() or on destruction, when the events have normally completed.
+class GpuStageTimer {
+ public:
+  explicit GpuStageTimer(const std::string &name);
+  ~GpuStageTimer();
+
+  void Start(cudaStream_t stream = 0);
+  void Stop(cudaStream_t stream = 0);
+
+  GpuStageTimer(const GpuStageTimer &) = delete;
+  GpuStageTimer &operator=(const GpuStageTimer &) = delete;
+
+ private:
+  void Collect();
+
+  std::string name_;
+  cudaEvent_t start_ = nullptr;
+  cudaEvent_t stop_ = nullptr;
+  bool pending_ = false;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
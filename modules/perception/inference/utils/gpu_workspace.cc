@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/gpu_workspace.h"
+
+#include <cuda_runtime_api.h>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+GpuWorkspace::~GpuWorkspace() {
+  if (data_ != nullptr) {
+    cudaFree(data_);
+  }
+}
+
+bool GpuWorkspace::Reserve(size_t size) {
+  if (size <= size_) {
+    return true;
+  }
+  // the old memory stays valid when the allocation fails
+  void *data = nullptr;
+  if (cudaMalloc(&data, size) != cudaSuccess) {
+    AERROR << "Failed to allocate a gpu workspace of " << size << " bytes";
+    return false;
+  }
+  if (data_ != nullptr) {
+    cudaFree(data_);
+  }
+  data_ = data;
+  size_ = size;
+  return true;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// GPU memory shared by the networks of a component that run one after
+// another, for what a network only needs during its own Infer(), e.g. its
+// planned activations. Each network reserves what it needs at Init() and
+// takes data() again before each run, since a larger reservation of another
+// network moves the memory. Not thread safe.
+class GpuWorkspace {
+ public:
+  GpuWorkspace() = default;
+  ~GpuWorkspace();
+
+  // @brief: grow to at least size bytes, the contents are not kept.
+  bool Reserve(size_t size);
+
+  void *data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  GpuWorkspace(const GpuWorkspace &) = delete;
+  GpuWorkspace &operator=(const GpuWorkspace &) = delete;
+
+ private:
+  void *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
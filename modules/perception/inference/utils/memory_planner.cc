@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/memory_planner.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+MemoryPlanner::MemoryPlanner(size_t alignment)
+    : alignment_(std::max<size_t>(alignment, 1)) {}
+
+int MemoryPlanner::AddBuffer(size_t size, int first_step, int last_step) {
+  Buffer buffer;
+  buffer.size = size;
+  buffer.first_step = std::min(first_step, last_step);
+  buffer.last_step = std::max(first_step, last_step);
+  buffers_.push_back(buffer);
+  naive_size_ += size;
+  return static_cast<int>(buffers_.size()) - 1;
+}
+
+void MemoryPlanner::Plan() {
+  std::vector<size_t> order(buffers_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return buffers_[a].size > buffers_[b].size;
+  });
+
+  planned_size_ = 0;
+  std::vector<const Buffer *> placed;
+  std::vector<const Buffer *> conflicts;
+  for (const size_t index : order) {
+    Buffer &buffer = buffers_[index];
+    const size_t size = Align(buffer.size);
+    conflicts.clear();
+    for (const Buffer *other : placed) {
+      if (other->first_step <= buffer.last_step &&
+          buffer.first_step <= other->last_step) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](const Buffer *a, const Buffer *b) {
+                return a->offset < b->offset;
+              });
+    // the lowest gap between the buffers live at the same time that fits
+    size_t offset = 0;
+    for (const Buffer *other : conflicts) {
+      if (offset + size <= other->offset) {
+        break;
+      }
+      offset = std::max(offset, other->offset + Align(other->size));
+    }
+    buffer.offset = offset;
+    planned_size_ = std::max(planned_size_, offset + size);
+    placed.push_back(&buffer);
+  }
+}
+
+void MemoryPlanner::Clear() {
+  buffers_.clear();
+  planned_size_ = 0;
+  naive_size_ = 0;
+}
+
+size_t MemoryPlanner::Align(size_t size) const {
+  return (size + alignment_ - 1) / alignment_ * alignment_;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
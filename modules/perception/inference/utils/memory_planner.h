@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Places buffers that are used over ranges of steps, e.g. the activations of
+// a network over its layers, in one arena. Buffers whose ranges overlap never
+// overlap in the arena, the others share it. Buffers are placed from the
+// largest down, each at the lowest aligned offset that fits.
+class MemoryPlanner {
+ public:
+  explicit MemoryPlanner(size_t alignment = 256);
+
+  // @brief: add a buffer of size bytes that is used from first_step to
+  // last_step, both included, returns its index.
+  int AddBuffer(size_t size, int first_step, int last_step);
+
+  void Plan();
+
+  void Clear();
+
+  int buffer_num() const { return static_cast<int>(buffers_.size()); }
+
+  // @brief: offset of a buffer in the arena, valid after Plan().
+  size_t offset(int index) const { return buffers_[index].offset; }
+
+  // @brief: bytes of the arena, valid after Plan().
+  size_t planned_size() const { return planned_size_; }
+
+  // @brief: bytes of the buffers if each had its own memory.
+  size_t naive_size() const { return naive_size_; }
+
+ private:
+  struct Buffer {
+    size_t size = 0;
+    int first_step = 0;
+    int last_step = 0;
+    size_t offset = 0;
+  };
+
+  size_t Align(size_t size) const;
+
+  size_t alignment_;
+  std::vector<Buffer> buffers_;
+  size_t planned_size_ = 0;
+  size_t naive_size_ = 0;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
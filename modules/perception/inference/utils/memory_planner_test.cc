@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/memory_planner.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+TEST(MemoryPlannerTest, test_reuse) {
+  MemoryPlanner planner(256);
+  // a chain of layers, each buffer is only live with its neighbours
+  planner.AddBuffer(1000, 0, 1);
+  planner.AddBuffer(2000, 1, 2);
+  planner.AddBuffer(1000, 2, 3);
+  planner.AddBuffer(500, 3, 4);
+  planner.Plan();
+  EXPECT_EQ(planner.naive_size(), 4500);
+  EXPECT_EQ(planner.planned_size(), 3072);
+  EXPECT_EQ(planner.offset(1), 0);
+  EXPECT_EQ(planner.offset(0), 2048);
+  EXPECT_EQ(planner.offset(2), 2048);
+  EXPECT_EQ(planner.offset(3), 0);
+}
+
+TEST(MemoryPlannerTest, test_no_overlap) {
+  MemoryPlanner planner(64);
+  const int first_steps[] = {0, 0, 1, 2, 2, 3, 5, 0};
+  const int last_steps[] = {5, 2, 3, 4, 6, 6, 6, 0};
+  const size_t sizes[] = {100, 700, 64, 300, 1, 4096, 128, 50};
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(planner.AddBuffer(sizes[i], first_steps[i], last_steps[i]), i);
+  }
+  planner.Plan();
+  EXPECT_LE(planner.planned_size(), planner.naive_size() + 8 * 64);
+  for (int i = 0; i < planner.buffer_num(); ++i) {
+    EXPECT_EQ(planner.offset(i) % 64, 0);
+    EXPECT_LE(planner.offset(i) + sizes[i], planner.planned_size());
+    for (int j = 0; j < i; ++j) {
+      if (first_steps[i] > last_steps[j] || first_steps[j] > last_steps[i]) {
+        continue;
+      }
+      EXPECT_TRUE(planner.offset(i) + sizes[i] <= planner.offset(j) ||
+                  planner.offset(j) + sizes[j] <= planner.offset(i));
+    }
+  }
+}
+
+TEST(MemoryPlannerTest, test_clear) {
+  MemoryPlanner planner;
+  planner.AddBuffer(10, 0, 0);
+  planner.Plan();
+  EXPECT_EQ(planner.planned_size(), 256);
+  planner.Clear();
+  planner.Plan();
+  EXPECT_EQ(planner.buffer_num(), 0);
+  EXPECT_EQ(planner.planned_size(), 0);
+  EXPECT_EQ(planner.naive_size(), 0);
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -25,67 +25,44 @@ using google::protobuf::Closure;
 using std::vector;
 
 ThreadPool::ThreadPool(int num_workers)
-    : num_workers_(num_workers),
-      num_available_workers_(num_workers),
-      task_queue_(num_workers),
-      started_(false) {
-  workers_.reserve(num_workers_);
-  for (int idx = 0; idx < num_workers_; ++idx) {
-    ThreadPoolWorker *worker = new ThreadPoolWorker(this);
-    workers_.push_back(worker);
-  }
-}
+    : num_workers_(num_workers), num_available_workers_(num_workers) {}
 
-ThreadPool::~ThreadPool() {
-  if (!started_) {
-    return;
-  }
+// The pool runs every closure still queued before joining its workers.
+ThreadPool::~ThreadPool() { pool_.reset(); }
 
-  for (int idx = 0; idx < num_workers_; ++idx) {
-    Add(NULL);
+void ThreadPool::Start() {
+  MutexLock lock(&mutex_);
+  if (pool_ != nullptr) {
+    return;
   }
-
-  for (int idx = 0; idx < num_workers_; ++idx) {
-    workers_[idx]->Join();
-    delete workers_[idx];
+  pool_.reset(new cyber::base::WorkStealingPool(num_workers_));
+  for (Closure *closure : pending_closures_) {
+    Submit(closure);
   }
+  pending_closures_.clear();
 }
 
-void ThreadPool::Start() {
-  for (int idx = 0; idx < num_workers_; ++idx) {
-    workers_[idx]->Start();
+void ThreadPool::Add(Closure *closure) {
+  MutexLock lock(&mutex_);
+  if (pool_ == nullptr) {
+    pending_closures_.push_back(closure);
+    return;
   }
-  started_ = true;
+  Submit(closure);
 }
 
-void ThreadPool::Add(Closure *closure) { task_queue_.Push(closure); }
-
 void ThreadPool::Add(const vector<Closure *> &closures) {
   for (size_t idx = 0; idx < closures.size(); ++idx) {
     Add(closures[idx]);
   }
 }
 
-void ThreadPoolWorker::Run() {
-  while (true) {
-    Closure *closure = nullptr;
-    thread_pool_->task_queue_.Pop(&closure);
-    if (closure == nullptr) {
-      break;
-    }
-
-    {
-      MutexLock lock(&(thread_pool_->mutex_));
-      --(thread_pool_->num_available_workers_);
-    }
-
+void ThreadPool::Submit(Closure *closure) {
+  pool_->Submit([this, closure]() {
+    --num_available_workers_;
     closure->Run();
-
-    {
-      MutexLock lock(&(thread_pool_->mutex_));
-      ++(thread_pool_->num_available_workers_);
-    }
-  }
+    ++num_available_workers_;
+  });
 }
 
 }  // namespace lib
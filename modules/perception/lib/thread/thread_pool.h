@@ -17,18 +17,19 @@
 
 #include <google/protobuf/stubs/common.h>
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
-#include "modules/perception/lib/thread/concurrent_queue.h"
+#include "cyber/base/work_stealing_pool.h"
 #include "modules/perception/lib/thread/mutex.h"
-#include "modules/perception/lib/thread/thread.h"
 
 namespace apollo {
 namespace perception {
 namespace lib {
 
-class ThreadPoolWorker;
-
+// Runs closures on a cyber::base::WorkStealingPool. Closures added before
+// Start() are held back until the workers exist.
 class ThreadPool {
  public:
   explicit ThreadPool(int num_workers);
@@ -42,38 +43,20 @@ class ThreadPool {
 
   int num_workers() const { return num_workers_; }
 
-  int num_available_workers() const { return num_available_workers_; }
+  int num_available_workers() const { return num_available_workers_.load(); }
 
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
 
  private:
-  friend class ThreadPoolWorker;
+  void Submit(google::protobuf::Closure *closure);
 
-  std::vector<ThreadPoolWorker *> workers_;
   int num_workers_;
-  int num_available_workers_;
+  std::atomic<int> num_available_workers_;
   Mutex mutex_;
 
-  FixedSizeConQueue<google::protobuf::Closure *> task_queue_;
-  bool started_;
-};
-
-class ThreadPoolWorker : public Thread {
- public:
-  explicit ThreadPoolWorker(ThreadPool *thread_pool)
-      : Thread(true, "ThreadPoolWorker"), thread_pool_(thread_pool) {}
-
-  virtual ~ThreadPoolWorker() {}
-
-  ThreadPoolWorker(const ThreadPoolWorker &) = delete;
-  ThreadPoolWorker &operator=(const ThreadPoolWorker &) = delete;
-
- protected:
-  void Run() override;
-
- private:
-  ThreadPool *thread_pool_;
+  std::vector<google::protobuf::Closure *> pending_closures_;
+  std::unique_ptr<cyber::base::WorkStealingPool> pool_;
 };
 
 }  // namespace lib
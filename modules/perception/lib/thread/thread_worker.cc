@@ -15,6 +15,12 @@
  *****************************************************************************/
 #include "modules/perception/lib/thread/thread_worker.h"
 
+#include "cyber/task/task.h"
+
+DEFINE_bool(thread_worker_use_task_pool, false,
+            "run ThreadWorker jobs on the cyber task pool instead of a "
+            "dedicated thread");
+
 namespace apollo {
 namespace perception {
 namespace lib {
@@ -24,7 +30,8 @@ void ThreadWorker::Bind(const std::function<bool()> &func) {
 }
 
 void ThreadWorker::Start() {
-  if (thread_ptr_ == nullptr) {
+  use_task_pool_ = FLAGS_thread_worker_use_task_pool;
+  if (thread_ptr_ == nullptr && !use_task_pool_) {
     thread_ptr_.reset(new std::thread(&ThreadWorker::Core, this));
   }
   std::lock_guard<std::mutex> lock(mutex_);
@@ -33,6 +40,11 @@ void ThreadWorker::Start() {
 }
 
 void ThreadWorker::WakeUp() {
+  if (use_task_pool_) {
+    Join();
+    task_future_ = cyber::Async(work_func_);
+    return;
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
     work_flag_ = true;
@@ -41,11 +53,30 @@ void ThreadWorker::WakeUp() {
 }
 
 void ThreadWorker::Join() {
+  if (use_task_pool_) {
+    if (!task_future_.valid()) {
+      return;
+    }
+    // a croutine caller may share its processor with the task, so yield
+    // instead of blocking it
+    if (cyber::croutine::CRoutine::GetCurrentRoutine() == nullptr) {
+      task_future_.wait();
+    }
+    while (task_future_.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      cyber::Yield();
+    }
+    task_future_.get();
+    return;
+  }
   std::unique_lock<std::mutex> lock(mutex_);
   condition_.wait(lock, [&]() { return !work_flag_; });
 }
 
 void ThreadWorker::Release() {
+  if (use_task_pool_) {
+    Join();
+  }
   if (thread_ptr_ == nullptr) {
     return;
   }
@@ -16,13 +16,22 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
+#include <future>
 #include <memory>
 #include <thread>
 
+#include "gflags/gflags.h"
+
+DECLARE_bool(thread_worker_use_task_pool);
+
 namespace apollo {
 namespace perception {
 namespace lib {
 
+// Runs a bound function once per WakeUp(). By default on its own thread,
+// with --thread_worker_use_task_pool on the cyber task pool instead, so the
+// work is placed by the scheduler configuration like any other task.
 class ThreadWorker {
  public:
   ThreadWorker() = default;
@@ -48,6 +57,9 @@ class ThreadWorker {
   void Core();
 
  private:
+  bool use_task_pool_ = false;
+  std::future<bool> task_future_;
+
   std::unique_ptr<std::thread> thread_ptr_;
   std::mutex mutex_;
   std::condition_variable condition_;
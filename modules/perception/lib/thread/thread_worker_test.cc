@@ -17,6 +17,8 @@
 
 #include "modules/perception/lib/thread/thread_worker.h"
 
+#include "cyber/init.h"
+
 namespace apollo {
 namespace perception {
 namespace lib {
@@ -55,6 +57,36 @@ TEST(ThreadWorkerTest, ThreadWorkerTest2) {
   EXPECT_EQ(count, 5);
 }
 
+TEST(ThreadWorkerTest, ThreadWorkerTaskPoolTest) {
+  FLAGS_thread_worker_use_task_pool = true;
+  int count = 0;
+  ThreadWorker worker;
+  worker.Bind([&]() {
+    usleep(10000);
+    ++count;
+    return true;
+  });
+  worker.Start();
+  // join before any wake up returns at once
+  worker.Join();
+  for (int i = 0; i < 5; ++i) {
+    worker.WakeUp();
+    worker.Join();
+    EXPECT_EQ(count, i + 1);
+  }
+  // a pending job is finished by release
+  worker.WakeUp();
+  worker.Release();
+  EXPECT_EQ(count, 6);
+  FLAGS_thread_worker_use_task_pool = false;
+}
+
 }  // namespace lib
 }  // namespace perception
 }  // namespace apollo
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  return RUN_ALL_TESTS();
+}
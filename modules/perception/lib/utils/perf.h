@@ -17,6 +17,7 @@
 
 #include <string>
 
+#include "modules/perception/lib/utils/profiler.h"
 #include "modules/perception/lib/utils/timer.h"
 
 // Usage:
@@ -54,6 +55,17 @@
 //  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx2 elapsed time: 100 ms
 //  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx3 elapsed time: 200 ms
 //  >>>>>>>>>>>>>>>
+//
+//  Every timing above is also recorded into lib::Profiler, which keeps a
+//  latency histogram per stage and can publish a periodic summary.
+//  PERCEPTION_PROFILE_SCOPE times the enclosing scope as a named stage,
+//  stages timed inside it are recorded as "scope/stage":
+//      void Tracking() {
+//          PERCEPTION_PROFILE_SCOPE("tracking");
+//          PERCEPTION_PERF_BLOCK_START();
+//          // do xx
+//          PERCEPTION_PERF_BLOCK_END("xx");  // recorded as "tracking/xx"
+//      }
 
 namespace apollo {
 namespace perception {
@@ -98,6 +110,8 @@ inline std::string get_full_name(const std::string& full_name,
 
 #define PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, msg)
 
+#define PERCEPTION_PROFILE_SCOPE(name)
+
 #else
 
 #define PERCEPTION_PERF_FUNCTION()                       \
@@ -117,4 +131,7 @@ inline std::string get_full_name(const std::string& full_name,
 #define PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, msg) \
   _timer_.End(indicator + "_" + msg)
 
+#define PERCEPTION_PROFILE_SCOPE(name) \
+  apollo::perception::lib::ScopedProfile _profile_scope_(name)
+
 #endif  // PERCEPTION_DISABLE_PERF
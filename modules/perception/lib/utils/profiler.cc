@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/utils/profiler.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/time/time.h"
+#include "cyber/timer/timer.h"
+
+namespace apollo {
+namespace perception {
+namespace lib {
+
+namespace {
+
+// the nested scope path of the current thread, "outer/inner"
+thread_local std::string profile_path;
+
+}  // namespace
+
+uint64_t NowMicroseconds() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+int StageHistogram::BucketIndex(uint64_t elapsed_us) {
+  if (elapsed_us < 4) {
+    return static_cast<int>(elapsed_us);
+  }
+  int msb = 63 - __builtin_clzll(elapsed_us);
+  int sub = static_cast<int>((elapsed_us >> (msb - 2)) & 3);
+  return std::min((msb - 1) * 4 + sub, kNumBuckets - 1);
+}
+
+uint64_t StageHistogram::BucketUpperBound(int index) {
+  if (index < 4) {
+    return static_cast<uint64_t>(index);
+  }
+  int msb = index / 4 + 1;
+  uint64_t sub = static_cast<uint64_t>(index % 4);
+  return ((4 + sub + 1) << (msb - 2)) - 1;
+}
+
+void StageHistogram::Add(uint64_t elapsed_us) {
+  ++count_;
+  total_us_ += elapsed_us;
+  min_us_ = std::min(min_us_, elapsed_us);
+  max_us_ = std::max(max_us_, elapsed_us);
+  ++buckets_[BucketIndex(elapsed_us)];
+}
+
+double StageHistogram::Percentile(double q) const {
+  if (count_ == 0) {
+    return 0.0;
+  }
+  uint64_t target = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+  uint64_t accumulated = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    accumulated += buckets_[i];
+    if (accumulated >= target) {
+      return static_cast<double>(std::min(BucketUpperBound(i), max_us_));
+    }
+  }
+  return static_cast<double>(max_us_);
+}
+
+Profiler::Profiler() { period_start_us_ = NowMicroseconds(); }
+
+void Profiler::Record(const std::string &stage, uint64_t elapsed_us) {
+  if (!enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  stages_[stage].Add(elapsed_us);
+}
+
+void Profiler::Summarize(PerceptionProfile *profile, bool reset) {
+  profile->Clear();
+  uint64_t now = NowMicroseconds();
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile->set_period(static_cast<double>(now - period_start_us_) * 1e-6);
+  for (auto &pair : stages_) {
+    StageHistogram &histogram = pair.second;
+    if (histogram.count() == 0) {
+      continue;
+    }
+    StageProfile *stage = profile->add_stage();
+    stage->set_name(pair.first);
+    stage->set_count(histogram.count());
+    stage->set_mean_ms(histogram.mean_us() * 1e-3);
+    stage->set_min_ms(static_cast<double>(histogram.min_us()) * 1e-3);
+    stage->set_max_ms(static_cast<double>(histogram.max_us()) * 1e-3);
+    stage->set_p50_ms(histogram.Percentile(0.5) * 1e-3);
+    stage->set_p90_ms(histogram.Percentile(0.9) * 1e-3);
+    stage->set_p99_ms(histogram.Percentile(0.99) * 1e-3);
+    if (reset) {
+      // keep the entry, stage names are a small fixed set
+      histogram.Reset();
+    }
+  }
+  if (reset) {
+    period_start_us_ = now;
+  }
+}
+
+bool Profiler::StartPublishing(const std::string &channel,
+                               uint32_t period_ms) {
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  if (writer_ != nullptr) {
+    return true;
+  }
+  node_ = cyber::CreateNode("perception_profiler_" +
+                            std::to_string(static_cast<int>(getpid())));
+  if (node_ == nullptr) {
+    AERROR << "Failed to create the profiler node.";
+    return false;
+  }
+  writer_ = node_->CreateWriter<PerceptionProfile>(channel);
+  if (writer_ == nullptr) {
+    AERROR << "Failed to create the profiler writer on " << channel;
+    node_.reset();
+    return false;
+  }
+  timer_.reset(new cyber::Timer(period_ms, [this]() { Publish(); }, false));
+  timer_->Start();
+  AINFO << "Publishing perception profile on " << channel << " every "
+        << period_ms << " ms";
+  return true;
+}
+
+void Profiler::StopPublishing() {
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  if (timer_ != nullptr) {
+    timer_->Stop();
+    timer_.reset();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void Profiler::Publish() {
+  auto profile = std::make_shared<PerceptionProfile>();
+  Summarize(profile.get(), true);
+  auto *header = profile->mutable_header();
+  header->set_timestamp_sec(cyber::Time::Now().ToSecond());
+  header->set_module_name("perception_profiler");
+  header->set_sequence_num(++sequence_num_);
+  writer_->Write(profile);
+}
+
+ScopedProfile::ScopedProfile(const std::string &name) {
+  parent_length_ = profile_path.size();
+  if (parent_length_ > 0) {
+    profile_path += '/';
+  }
+  profile_path += name;
+  start_us_ = NowMicroseconds();
+}
+
+ScopedProfile::~ScopedProfile() {
+  uint64_t elapsed_us = NowMicroseconds() - start_us_;
+  Profiler::Instance()->Record(profile_path, elapsed_us);
+  profile_path.resize(parent_length_);
+}
+
+std::string ScopedProfile::FullName(const std::string &name) {
+  return profile_path.empty() ? name : profile_path + '/' + name;
+}
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cyber/common/macros.h"
+#include "modules/perception/proto/perception_profile.pb.h"
+
+namespace apollo {
+namespace cyber {
+class Node;
+class Timer;
+template <typename MessageT>
+class Writer;
+}  // namespace cyber
+
+namespace perception {
+namespace lib {
+
+// Latency histogram with four log-spaced buckets per power of two of
+// microseconds, so percentiles are within about 25% at any scale.
+class StageHistogram {
+ public:
+  static constexpr int kNumBuckets = 4 * 40;
+
+  void Add(uint64_t elapsed_us);
+  void Reset() { *this = StageHistogram(); }
+
+  uint64_t count() const { return count_; }
+  uint64_t min_us() const { return count_ == 0 ? 0 : min_us_; }
+  uint64_t max_us() const { return max_us_; }
+  double mean_us() const {
+    return count_ == 0 ? 0.0 : static_cast<double>(total_us_) / count_;
+  }
+  // upper bound of the bucket holding the q-th quantile, q in [0, 1]
+  double Percentile(double q) const;
+
+  static int BucketIndex(uint64_t elapsed_us);
+  static uint64_t BucketUpperBound(int index);
+
+ private:
+  uint64_t count_ = 0;
+  uint64_t total_us_ = 0;
+  uint64_t min_us_ = UINT64_MAX;
+  uint64_t max_us_ = 0;
+  uint64_t buckets_[kNumBuckets] = {0};
+};
+
+// Process wide stage latency collector. Record() takes one short lock, so
+// it is cheap enough to stay enabled on every frame.
+class Profiler {
+ public:
+  void Record(const std::string &stage, uint64_t elapsed_us);
+
+  // @brief: fill the statistics since the last reset, optionally reset
+  void Summarize(PerceptionProfile *profile, bool reset);
+
+  // @brief: publish a summary every period ms on channel, once per process
+  bool StartPublishing(const std::string &channel, uint32_t period_ms);
+  void StopPublishing();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool enabled) { enabled_.store(enabled); }
+
+ private:
+  void Publish();
+
+  std::mutex mutex_;
+  std::map<std::string, StageHistogram> stages_;
+  uint64_t period_start_us_ = 0;
+  std::atomic<bool> enabled_ = {true};
+
+  std::mutex publish_mutex_;
+  std::shared_ptr<cyber::Node> node_;
+  std::shared_ptr<cyber::Writer<PerceptionProfile>> writer_;
+  std::unique_ptr<cyber::Timer> timer_;
+  uint32_t sequence_num_ = 0;
+
+  DECLARE_SINGLETON(Profiler)
+};
+
+// Times its scope into the profiler. Scopes nest per thread, the stage of
+// an inner scope is "outer/inner".
+class ScopedProfile {
+ public:
+  explicit ScopedProfile(const std::string &name);
+  ~ScopedProfile();
+
+  // @brief: name prefixed by the nested scopes open on this thread
+  static std::string FullName(const std::string &name);
+
+  ScopedProfile(const ScopedProfile &) = delete;
+  ScopedProfile &operator=(const ScopedProfile &) = delete;
+
+ private:
+  size_t parent_length_ = 0;
+  uint64_t start_us_ = 0;
+};
+
+uint64_t NowMicroseconds();
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/utils/profiler.h"
+
+#include <gtest/gtest.h>
+
+namespace apollo {
+namespace perception {
+namespace lib {
+
+namespace {
+
+const StageProfile *FindStage(const PerceptionProfile &profile,
+                              const std::string &name) {
+  for (const auto &stage : profile.stage()) {
+    if (stage.name() == name) {
+      return &stage;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(StageHistogramTest, Buckets) {
+  for (uint64_t us : {0, 1, 3, 4, 7, 100, 12345, 1000000}) {
+    int index = StageHistogram::BucketIndex(us);
+    EXPECT_LE(us, StageHistogram::BucketUpperBound(index));
+    if (index > 0) {
+      EXPECT_GT(us, StageHistogram::BucketUpperBound(index - 1));
+    }
+  }
+  EXPECT_EQ(StageHistogram::kNumBuckets - 1,
+            StageHistogram::BucketIndex(UINT64_MAX));
+}
+
+TEST(StageHistogramTest, Percentile) {
+  StageHistogram histogram;
+  EXPECT_DOUBLE_EQ(0.0, histogram.Percentile(0.5));
+  for (uint64_t us = 1; us <= 1000; ++us) {
+    histogram.Add(us);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(1, histogram.min_us());
+  EXPECT_EQ(1000, histogram.max_us());
+  EXPECT_DOUBLE_EQ(500.5, histogram.mean_us());
+  EXPECT_NEAR(500.0, histogram.Percentile(0.5), 500.0 * 0.25);
+  EXPECT_NEAR(990.0, histogram.Percentile(0.99), 990.0 * 0.25);
+  EXPECT_DOUBLE_EQ(1000.0, histogram.Percentile(1.0));
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.count());
+}
+
+TEST(ProfilerTest, SummarizeAndReset) {
+  Profiler *profiler = Profiler::Instance();
+  PerceptionProfile profile;
+  profiler->Summarize(&profile, true);
+
+  profiler->Record("stage_a", 1000);
+  profiler->Record("stage_a", 3000);
+  profiler->set_enabled(false);
+  profiler->Record("stage_a", 100000);
+  profiler->set_enabled(true);
+  profiler->Summarize(&profile, true);
+
+  const StageProfile *stage = FindStage(profile, "stage_a");
+  ASSERT_NE(stage, nullptr);
+  EXPECT_EQ(2, stage->count());
+  EXPECT_DOUBLE_EQ(2.0, stage->mean_ms());
+  EXPECT_DOUBLE_EQ(1.0, stage->min_ms());
+  EXPECT_DOUBLE_EQ(3.0, stage->max_ms());
+
+  profiler->Summarize(&profile, false);
+  EXPECT_EQ(FindStage(profile, "stage_a"), nullptr);
+}
+
+TEST(ProfilerTest, NestedScopes) {
+  Profiler *profiler = Profiler::Instance();
+  PerceptionProfile profile;
+  profiler->Summarize(&profile, true);
+  {
+    ScopedProfile outer("outer");
+    EXPECT_EQ("outer/block", ScopedProfile::FullName("block"));
+    { ScopedProfile inner("inner"); }
+  }
+  EXPECT_EQ("block", ScopedProfile::FullName("block"));
+  profiler->Summarize(&profile, true);
+  EXPECT_NE(FindStage(profile, "outer"), nullptr);
+  EXPECT_NE(FindStage(profile, "outer/inner"), nullptr);
+  EXPECT_EQ(FindStage(profile, "inner"), nullptr);
+}
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
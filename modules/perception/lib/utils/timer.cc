@@ -17,6 +17,7 @@
 #include <sys/time.h>
 
 #include "cyber/common/log.h"
+#include "modules/perception/lib/utils/profiler.h"
 #include "modules/perception/lib/utils/timer.h"
 
 namespace apollo {
@@ -29,14 +30,16 @@ void Timer::Start() {
   struct timeval tv;
   gettimeofday(&tv, nullptr);
 
-  start_time_ = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+  start_time_ = tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
 uint64_t Timer::End(const string &msg) {
   struct timeval tv;
   gettimeofday(&tv, nullptr);
-  end_time_ = tv.tv_sec * 1000 + tv.tv_usec / 1000;
-  uint64_t elapsed_time = end_time_ - start_time_;
+  end_time_ = tv.tv_sec * 1000000 + tv.tv_usec;
+  uint64_t elapsed_us = end_time_ - start_time_;
+  uint64_t elapsed_time = elapsed_us / 1000;
+  Profiler::Instance()->Record(ScopedProfile::FullName(msg), elapsed_us);
 
   ADEBUG << "TIMER " << msg << " elapsed_time: " << elapsed_time << " ms";
 
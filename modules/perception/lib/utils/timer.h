@@ -29,8 +29,8 @@ class Timer {
   // no-thread safe.
   void Start();
 
-  // return the elapsed time,
-  // also output msg and time in glog.
+  // return the elapsed time in ms,
+  // also output msg and time in glog and record it in the Profiler.
   // automatically start a new timer.
   // no-thread safe.
   uint64_t End(const std::string &msg);
@@ -39,7 +39,7 @@ class Timer {
   Timer &operator=(const Timer &) = delete;
 
  private:
-  // in ms.
+  // in us.
   uint64_t start_time_;
   uint64_t end_time_;
 };
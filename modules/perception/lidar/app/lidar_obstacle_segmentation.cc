@@ -73,6 +73,9 @@ bool LidarObstacleSegmentation::Init(
   CHECK(segmentor_->Init(segmentation_init_options));
 
   ObjectBuilderInitOptions builder_init_options;
+  builder_init_options.min_points_for_hull =
+      config.builder_min_points_for_hull();
+  builder_init_options.num_threads = config.builder_num_threads();
   CHECK(builder_.Init(builder_init_options));
 
   if (use_object_filter_bank_) {
@@ -86,6 +89,7 @@ bool LidarObstacleSegmentation::Init(
 
 LidarProcessResult LidarObstacleSegmentation::Process(
     const LidarObstacleSegmentationOptions& options, LidarFrame* frame) {
+  PERCEPTION_PROFILE_SCOPE("lidar_segmentation");
   PointCloudPreprocessorOptions preprocessor_options;
   preprocessor_options.sensor2novatel_extrinsics =
       options.sensor2novatel_extrinsics;
@@ -104,6 +108,7 @@ LidarProcessResult LidarObstacleSegmentation::Process(
   const auto& sensor_name = options.sensor_name;
 
   PERCEPTION_PERF_FUNCTION_WITH_INDICATOR(options.sensor_name);
+  PERCEPTION_PROFILE_SCOPE("lidar_segmentation");
 
   PERCEPTION_PERF_BLOCK_START();
   PointCloudPreprocessorOptions preprocessor_options;
@@ -66,6 +66,7 @@ LidarProcessResult LidarObstacleTracking::Process(
   const auto& sensor_name = options.sensor_name;
 
   PERCEPTION_PERF_FUNCTION_WITH_INDICATOR(sensor_name);
+  PERCEPTION_PROFILE_SCOPE("lidar_tracking");
 
   PERCEPTION_PERF_BLOCK_START();
   MultiTargetTrackerOptions tracker_options;
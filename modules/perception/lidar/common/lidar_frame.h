@@ -63,12 +63,8 @@ struct LidarFrame {
     }
     timestamp = 0.0;
     lidar2world_pose = Eigen::Affine3d::Identity();
-    if (hdmap_struct) {
-      hdmap_struct->road_boundary.clear();
-      hdmap_struct->road_polygons.clear();
-      hdmap_struct->junction_polygons.clear();
-      hdmap_struct->hole_polygons.clear();
-    }
+    // released rather than cleared, it may be shared with other frames
+    hdmap_struct = nullptr;
     segmented_objects.clear();
     tracked_objects.clear();
     roi_indices.indices.clear();
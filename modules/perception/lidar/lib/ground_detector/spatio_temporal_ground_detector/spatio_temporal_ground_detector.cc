@@ -60,6 +60,8 @@ bool SpatioTemporalGroundDetector::Init(
   param_->roi_region_rad_z = config_params.roi_rad_z();
   param_->nr_grids_coarse = config_params.grid_size();
   param_->nr_smooth_iter = config_params.nr_smooth_iter();
+  param_->use_temporal_prior = config_params.use_temporal_prior();
+  param_->nr_threads = config_params.nr_threads();
 
   pfdetector_ = new common::PlaneFitGroundDetector(*param_);
   pfdetector_->Init();
@@ -152,6 +154,15 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
   base::PointIndices& non_ground_indices = frame->non_ground_indices;
   AINFO << "input of ground detector:" << valid_point_num;
 
+  if (param_->use_temporal_prior) {
+    const float shift[] = {
+        static_cast<float>(cloud_center_(0) - prev_cloud_center_(0)),
+        static_cast<float>(cloud_center_(1) - prev_cloud_center_(1)),
+        static_cast<float>(cloud_center_(2) - prev_cloud_center_(2))};
+    pfdetector_->TranslateGroundPlanes(shift);
+  }
+  prev_cloud_center_ = cloud_center_;
+
   if (!pfdetector_->Detect(data_.data(), ground_height_signed_.data(),
                            valid_point_num, nr_points_element)) {
     AINFO << "failed to call ground detector!";
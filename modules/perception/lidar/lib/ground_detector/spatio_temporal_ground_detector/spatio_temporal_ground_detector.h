@@ -59,6 +59,7 @@ class SpatioTemporalGroundDetector : public BaseGroundDetector {
   float ground_thres_ = 0.25f;
   size_t default_point_size_ = 320000;
   Eigen::Vector3d cloud_center_ = Eigen::Vector3d(0.0, 0.0, 0.0);
+  Eigen::Vector3d prev_cloud_center_ = Eigen::Vector3d(0.0, 0.0, 0.0);
   GroundServiceContent ground_service_content_;
 };  // class SpatioTemporalGroundDetector
 
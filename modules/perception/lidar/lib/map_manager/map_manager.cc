@@ -54,9 +54,6 @@ bool MapManager::Update(const MapManagerOptions& options, LidarFrame* frame) {
     AINFO << "Frame is nullptr.";
     return false;
   }
-  if (!(frame->hdmap_struct)) {
-    frame->hdmap_struct.reset(new base::HdmapStruct);
-  }
   if (!hdmap_input_) {
     AINFO << "Hdmap input is nullptr";
     return false;
@@ -70,6 +67,16 @@ bool MapManager::Update(const MapManagerOptions& options, LidarFrame* frame) {
   point.x = frame->lidar2world_pose.translation()(0);
   point.y = frame->lidar2world_pose.translation()(1);
   point.z = frame->lidar2world_pose.translation()(2);
+  if (map::FLAGS_obs_share_hdmap_roi) {
+    if (!hdmap_input_->GetSharedRoiHDMapStruct(point, roi_search_distance_,
+                                               &frame->hdmap_struct)) {
+      AINFO << "Failed to get roi from hdmap.";
+    }
+    return true;
+  }
+  if (!(frame->hdmap_struct)) {
+    frame->hdmap_struct.reset(new base::HdmapStruct);
+  }
   if (!hdmap_input_->GetRoiHDMapStruct(point, roi_search_distance_,
                                        frame->hdmap_struct)) {
     frame->hdmap_struct->road_polygons.clear();
@@ -16,6 +16,8 @@
 #include "modules/perception/lidar/lib/object_builder/object_builder.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "modules/perception/common/geometry/common.h"
 #include "modules/perception/common/geometry/convex_hull_2d.h"
@@ -33,9 +35,15 @@ using apollo::perception::base::PointD;
 using apollo::perception::base::PointF;
 using ObjectPtr = std::shared_ptr<apollo::perception::base::Object>;
 using PointFCloud = apollo::perception::base::PointCloud<PointF>;
-using PolygonDType = apollo::perception::base::PointCloud<PointD>;
+
+// objects taken by a worker at a time, cluster sizes vary a lot
+static const size_t kObjectChunkSize = 8;
+// below this many objects threads cost more than they save
+static const size_t kMinObjectsPerThread = 32;
 
 bool ObjectBuilder::Init(const ObjectBuilderInitOptions& options) {
+  min_points_for_hull_ = std::max<size_t>(options.min_points_for_hull, 4);
+  num_threads_ = std::max(options.num_threads, 1u);
   return true;
 }
 
@@ -45,20 +53,48 @@ bool ObjectBuilder::Build(const ObjectBuilderOptions& options,
     return false;
   }
   std::vector<ObjectPtr>* objects = &(frame->segmented_objects);
-  for (size_t i = 0; i < objects->size(); ++i) {
+  const size_t num_objects = objects->size();
+  const unsigned int num_threads = static_cast<unsigned int>(std::min<size_t>(
+      num_threads_, std::max<size_t>(num_objects / kMinObjectsPerThread, 1)));
+  if (num_threads <= 1) {
+    BuildRange(objects, 0, num_objects, &hull_);
+    return true;
+  }
+  // every object is built independently of the others
+  std::atomic<size_t> next_chunk(0);
+  auto worker = [&](Hull* hull) {
+    size_t begin = 0;
+    while ((begin = next_chunk.fetch_add(kObjectChunkSize)) < num_objects) {
+      BuildRange(objects, begin,
+                 std::min(begin + kObjectChunkSize, num_objects), hull);
+    }
+  };
+  std::vector<Hull> hulls(num_threads - 1);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (auto& hull : hulls) {
+    threads.emplace_back(worker, &hull);
+  }
+  worker(&hull_);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return true;
+}
+
+void ObjectBuilder::BuildRange(std::vector<ObjectPtr>* objects, size_t begin,
+                               size_t end, Hull* hull) {
+  for (size_t i = begin; i < end; ++i) {
     if (objects->at(i)) {
       objects->at(i)->id = static_cast<int>(i);
-      ComputePolygon2D(objects->at(i));
+      ComputePolygon2D(objects->at(i), hull);
     }
-  }
-  for (size_t i = 0; i < objects->size(); ++i) {
     ComputePolygonSizeCenter(objects->at(i));
     ComputeOtherObjectInformation(objects->at(i));
   }
-  return true;
 }
 
-void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
+void ObjectBuilder::ComputePolygon2D(ObjectPtr object, Hull* hull) {
   Eigen::Vector3f min_pt;
   Eigen::Vector3f max_pt;
   PointFCloud& cloud = object->lidar_supplement.cloud;
@@ -67,9 +103,12 @@ void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
     SetDefaultValue(min_pt, max_pt, object);
     return;
   }
+  if (cloud.size() < min_points_for_hull_) {
+    SetBoxPolygon(min_pt, max_pt, object);
+    return;
+  }
   LinePerturbation(&cloud);
-  common::ConvexHull2D<PointFCloud, PolygonDType> hull;
-  hull.GetConvexHull(cloud, &(object->polygon));
+  hull->GetConvexHull(cloud, &(object->polygon));
 }
 
 void ObjectBuilder::ComputeOtherObjectInformation(ObjectPtr object) {
@@ -142,25 +181,31 @@ void ObjectBuilder::SetDefaultValue(const Eigen::Vector3f& min_pt_in,
   }
   // polygon
   if (object->lidar_supplement.cloud.size() < 4) {
-    object->polygon.resize(4);
-    object->polygon[0].x = static_cast<double>(min_pt[0]);
-    object->polygon[0].y = static_cast<double>(min_pt[1]);
-    object->polygon[0].z = static_cast<double>(min_pt[2]);
-
-    object->polygon[1].x = static_cast<double>(max_pt[0]);
-    object->polygon[1].y = static_cast<double>(min_pt[1]);
-    object->polygon[1].z = static_cast<double>(min_pt[2]);
-
-    object->polygon[2].x = static_cast<double>(max_pt[0]);
-    object->polygon[2].y = static_cast<double>(max_pt[1]);
-    object->polygon[2].z = static_cast<double>(min_pt[2]);
-
-    object->polygon[3].x = static_cast<double>(min_pt[0]);
-    object->polygon[3].y = static_cast<double>(max_pt[1]);
-    object->polygon[3].z = static_cast<double>(min_pt[2]);
+    SetBoxPolygon(min_pt, max_pt, object);
   }
 }
 
+void ObjectBuilder::SetBoxPolygon(const Eigen::Vector3f& min_pt,
+                                  const Eigen::Vector3f& max_pt,
+                                  ObjectPtr object) {
+  object->polygon.resize(4);
+  object->polygon[0].x = static_cast<double>(min_pt[0]);
+  object->polygon[0].y = static_cast<double>(min_pt[1]);
+  object->polygon[0].z = static_cast<double>(min_pt[2]);
+
+  object->polygon[1].x = static_cast<double>(max_pt[0]);
+  object->polygon[1].y = static_cast<double>(min_pt[1]);
+  object->polygon[1].z = static_cast<double>(min_pt[2]);
+
+  object->polygon[2].x = static_cast<double>(max_pt[0]);
+  object->polygon[2].y = static_cast<double>(max_pt[1]);
+  object->polygon[2].z = static_cast<double>(min_pt[2]);
+
+  object->polygon[3].x = static_cast<double>(min_pt[0]);
+  object->polygon[3].y = static_cast<double>(max_pt[1]);
+  object->polygon[3].z = static_cast<double>(min_pt[2]);
+}
+
 bool ObjectBuilder::LinePerturbation(PointFCloud* cloud) {
   if (cloud->size() >= 3) {
     int start_point = 0;
@@ -22,6 +22,7 @@
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/geometry/convex_hull_2d.h"
 #include "modules/perception/lib/registerer/registerer.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 
@@ -29,7 +30,12 @@ namespace apollo {
 namespace perception {
 namespace lidar {
 
-struct ObjectBuilderInitOptions {};
+struct ObjectBuilderInitOptions {
+  // clusters with fewer points get their bounding box as polygon
+  size_t min_points_for_hull = 4;
+  // objects are built in parallel when this is above one
+  unsigned int num_threads = 1;
+};
 
 struct ObjectBuilderOptions {
   Eigen::Vector3d ref_center = Eigen::Vector3d(0, 0, 0);
@@ -53,11 +59,22 @@ class ObjectBuilder {
   std::string Name() const { return "ObjectBuilder"; }
 
  private:
+  typedef common::ConvexHull2D<
+      apollo::perception::base::PointCloud<apollo::perception::base::PointF>,
+      apollo::perception::base::PointCloud<apollo::perception::base::PointD>>
+      Hull;
+
+  // @brief: build objects [begin, end), with one hull reused for all.
+  // @param [in/out]: objects.
+  void BuildRange(
+      std::vector<std::shared_ptr<apollo::perception::base::Object>>* objects,
+      size_t begin, size_t end, Hull* hull);
+
   // @brief: calculate 2d polygon.
   //         and fill the convex hull vertices in object->polygon.
   // @param [in/out]: ObjectPtr.
   void ComputePolygon2D(
-      std::shared_ptr<apollo::perception::base::Object> object);
+      std::shared_ptr<apollo::perception::base::Object> object, Hull* hull);
 
   // @brief: calculate the size, center of polygon.
   // @param [in/out]: ObjectPtr.
@@ -90,6 +107,17 @@ class ObjectBuilder {
   void GetMinMax3D(const apollo::perception::base::PointCloud<
                        apollo::perception::base::PointF>& cloud,
                    Eigen::Vector3f* min_pt, Eigen::Vector3f* max_pt);
+
+  // @brief: fill object->polygon with the xy box at the bottom.
+  // @param [in]: min and max point.
+  // @param [in/out]: ObjectPtr.
+  void SetBoxPolygon(
+      const Eigen::Vector3f& min_pt, const Eigen::Vector3f& max_pt,
+      std::shared_ptr<apollo::perception::base::Object> object);
+
+  size_t min_points_for_hull_ = 4;
+  unsigned int num_threads_ = 1;
+  Hull hull_;
 };  // class ObjectBuilder
 
 }  // namespace lidar
@@ -15,8 +15,16 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor.h"
 
+#include <cfloat>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "cyber/common/file.h"
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/drivers/common/packed_point_cloud.h"
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_log.h"
@@ -75,41 +83,51 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
   frame->cloud->set_timestamp(message->measurement_time());
-  if (message->point_size() > 0) {
-    frame->cloud->reserve(message->point_size());
+  const int point_num = apollo::drivers::PointNum(*message);
+  if (point_num > 0) {
+    const size_t size = static_cast<size_t>(point_num);
+    xs_.resize(size);
+    ys_.resize(size);
+    zs_.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      const apollo::drivers::PackedPoint pt =
+          apollo::drivers::GetPoint(*message, static_cast<int>(i));
+      xs_[i] = pt.x;
+      ys_[i] = pt.y;
+      zs_[i] = pt.z;
+    }
+    const size_t kept = FilterPoints(size, options.sensor2novatel_extrinsics);
+
+    // compact the kept points into both clouds in the same pass
+    const Eigen::Matrix3d rotation = frame->lidar2world_pose.linear();
+    const Eigen::Vector3d translation = frame->lidar2world_pose.translation();
+    frame->cloud->reserve(frame->cloud->size() + kept);
+    frame->world_cloud->clear();
+    frame->world_cloud->reserve(kept);
     base::PointF point;
-    for (int i = 0; i < message->point_size(); ++i) {
-      const apollo::drivers::PointXYZIT& pt = message->point(i);
-      if (filter_naninf_points_) {
-        if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
-          continue;
-        }
-        if (fabs(pt.x()) > kPointInfThreshold ||
-            fabs(pt.y()) > kPointInfThreshold ||
-            fabs(pt.z()) > kPointInfThreshold) {
-          continue;
-        }
-      }
-      Eigen::Vector3d vec3d_lidar(pt.x(), pt.y(), pt.z());
-      Eigen::Vector3d vec3d_novatel =
-          options.sensor2novatel_extrinsics * vec3d_lidar;
-      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-          vec3d_novatel[0] > box_backward_x_ &&
-          vec3d_novatel[1] < box_forward_y_ &&
-          vec3d_novatel[1] > box_backward_y_) {
-        continue;
-      }
-      if (filter_high_z_points_ && pt.z() > z_threshold_) {
+    base::PointD world_point;
+    for (size_t i = 0; i < size; ++i) {
+      if (!keep_[i]) {
         continue;
       }
-      point.x = pt.x();
-      point.y = pt.y();
-      point.z = pt.z();
-      point.intensity = static_cast<float>(pt.intensity());
-      frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
-                              FLT_MAX, i, 0);
+      const apollo::drivers::PackedPoint pt =
+          apollo::drivers::GetPoint(*message, static_cast<int>(i));
+      const double timestamp = static_cast<double>(pt.timestamp) * 1e-9;
+      const int32_t beam_id = static_cast<int32_t>(i);
+      point.x = xs_[i];
+      point.y = ys_[i];
+      point.z = zs_[i];
+      point.intensity = static_cast<float>(pt.intensity);
+      frame->cloud->push_back(point, timestamp, FLT_MAX, beam_id, 0);
+      const Eigen::Vector3d world =
+          rotation * Eigen::Vector3d(point.x, point.y, point.z) + translation;
+      world_point.x = world(0);
+      world_point.y = world(1);
+      world_point.z = world(2);
+      world_point.intensity = point.intensity;
+      frame->world_cloud->push_back(world_point, timestamp, FLT_MAX, beam_id,
+                                    0);
     }
-    TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
   }
   return true;
 }
@@ -123,66 +141,139 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
   if (frame->cloud->size() > 0) {
-    size_t size = frame->cloud->size();
-    size_t i = 0;
-    while (i < size) {
-      auto& pt = frame->cloud->at(i);
-      if (filter_naninf_points_) {
-        if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z)) {
-          frame->cloud->SwapPoint(i, size--);
-          continue;
-        }
-        if (fabs(pt.x) > kPointInfThreshold ||
-            fabs(pt.y) > kPointInfThreshold ||
-            fabs(pt.z) > kPointInfThreshold) {
-          frame->cloud->SwapPoint(i, size--);
-          continue;
-        }
-      }
-      Eigen::Vector3d vec3d_lidar(pt.x, pt.y, pt.z);
-      Eigen::Vector3d vec3d_novatel =
-          options.sensor2novatel_extrinsics * vec3d_lidar;
-      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-          vec3d_novatel[0] > box_backward_x_ &&
-          vec3d_novatel[1] < box_forward_y_ &&
-          vec3d_novatel[1] > box_backward_y_) {
-        frame->cloud->SwapPoint(i, size--);
+    base::PointFCloud* cloud = frame->cloud.get();
+    const size_t size = cloud->size();
+    xs_.resize(size);
+    ys_.resize(size);
+    zs_.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      const auto& pt = cloud->at(i);
+      xs_[i] = pt.x;
+      ys_[i] = pt.y;
+      zs_[i] = pt.z;
+    }
+    const size_t kept = FilterPoints(size, options.sensor2novatel_extrinsics);
+
+    // stable in-place compaction, transforming to world on the way
+    const Eigen::Matrix3d rotation = frame->lidar2world_pose.linear();
+    const Eigen::Vector3d translation = frame->lidar2world_pose.translation();
+    frame->world_cloud->clear();
+    frame->world_cloud->reserve(kept);
+    base::PointD world_point;
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (!keep_[i]) {
         continue;
       }
-      if (filter_high_z_points_ && pt.z > z_threshold_) {
-        frame->cloud->SwapPoint(i, size--);
-        continue;
+      if (count != i) {
+        cloud->CopyPoint(count, i, *cloud);
       }
-      ++i;
+      const auto& pt = cloud->at(count);
+      const Eigen::Vector3d world =
+          rotation * Eigen::Vector3d(pt.x, pt.y, pt.z) + translation;
+      world_point.x = world(0);
+      world_point.y = world(1);
+      world_point.z = world(2);
+      world_point.intensity = pt.intensity;
+      frame->world_cloud->push_back(world_point, cloud->points_timestamp(count),
+                                    FLT_MAX, cloud->points_beam_id()[count],
+                                    0);
+      ++count;
     }
-    frame->cloud->resize(i);
-    TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
-    AINFO << "Preprocessor filter points: " << size << " to " << i;
+    cloud->resize(count);
+    AINFO << "Preprocessor filter points: " << size << " to " << count;
   }
   return true;
 }
 
-bool PointCloudPreprocessor::TransformCloud(
-    const base::PointFCloudPtr& local_cloud, const Eigen::Affine3d& pose,
-    base::PointDCloudPtr world_cloud) const {
-  if (local_cloud == nullptr) {
-    return false;
+size_t PointCloudPreprocessor::FilterPoints(
+    size_t size, const Eigen::Affine3d& sensor2novatel) const {
+  keep_.resize(size);
+  const float* xs = xs_.data();
+  const float* ys = ys_.data();
+  const float* zs = zs_.data();
+  const Eigen::Matrix3f rot = sensor2novatel.linear().cast<float>();
+  const Eigen::Vector3f trans = sensor2novatel.translation().cast<float>();
+  size_t kept = 0;
+  size_t i = 0;
+#ifdef __SSE2__
+  // one mask per 4 points; ordered compares drop NaN in the range check
+  // and keep it in the box/z checks, matching the scalar path below
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 inf_thre = _mm_set1_ps(kPointInfThreshold);
+  const __m128 r00 = _mm_set1_ps(rot(0, 0));
+  const __m128 r01 = _mm_set1_ps(rot(0, 1));
+  const __m128 r02 = _mm_set1_ps(rot(0, 2));
+  const __m128 r10 = _mm_set1_ps(rot(1, 0));
+  const __m128 r11 = _mm_set1_ps(rot(1, 1));
+  const __m128 r12 = _mm_set1_ps(rot(1, 2));
+  const __m128 t0 = _mm_set1_ps(trans(0));
+  const __m128 t1 = _mm_set1_ps(trans(1));
+  const __m128 fx = _mm_set1_ps(box_forward_x_);
+  const __m128 bx = _mm_set1_ps(box_backward_x_);
+  const __m128 fy = _mm_set1_ps(box_forward_y_);
+  const __m128 by = _mm_set1_ps(box_backward_y_);
+  const __m128 z_thre = _mm_set1_ps(z_threshold_);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 x = _mm_loadu_ps(xs + i);
+    const __m128 y = _mm_loadu_ps(ys + i);
+    const __m128 z = _mm_loadu_ps(zs + i);
+    __m128 keep = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    if (filter_naninf_points_) {
+      keep = _mm_and_ps(keep,
+                        _mm_cmple_ps(_mm_andnot_ps(sign_mask, x), inf_thre));
+      keep = _mm_and_ps(keep,
+                        _mm_cmple_ps(_mm_andnot_ps(sign_mask, y), inf_thre));
+      keep = _mm_and_ps(keep,
+                        _mm_cmple_ps(_mm_andnot_ps(sign_mask, z), inf_thre));
+    }
+    if (filter_nearby_box_points_) {
+      const __m128 nx = _mm_add_ps(
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, x), _mm_mul_ps(r01, y)),
+                     _mm_mul_ps(r02, z)),
+          t0);
+      const __m128 ny = _mm_add_ps(
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(r10, x), _mm_mul_ps(r11, y)),
+                     _mm_mul_ps(r12, z)),
+          t1);
+      const __m128 in_box =
+          _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(nx, fx), _mm_cmpgt_ps(nx, bx)),
+                     _mm_and_ps(_mm_cmplt_ps(ny, fy), _mm_cmpgt_ps(ny, by)));
+      keep = _mm_andnot_ps(in_box, keep);
+    }
+    if (filter_high_z_points_) {
+      keep = _mm_andnot_ps(_mm_cmpgt_ps(z, z_thre), keep);
+    }
+    const int bits = _mm_movemask_ps(keep);
+    keep_[i] = static_cast<uint8_t>(bits & 1);
+    keep_[i + 1] = static_cast<uint8_t>((bits >> 1) & 1);
+    keep_[i + 2] = static_cast<uint8_t>((bits >> 2) & 1);
+    keep_[i + 3] = static_cast<uint8_t>((bits >> 3) & 1);
+    kept += __builtin_popcount(bits);
   }
-  world_cloud->clear();
-  world_cloud->reserve(local_cloud->size());
-  for (size_t i = 0; i < local_cloud->size(); ++i) {
-    auto& pt = local_cloud->at(i);
-    Eigen::Vector3d trans_point(pt.x, pt.y, pt.z);
-    trans_point = pose * trans_point;
-    base::PointD world_point;
-    world_point.x = trans_point(0);
-    world_point.y = trans_point(1);
-    world_point.z = trans_point(2);
-    world_point.intensity = pt.intensity;
-    world_cloud->push_back(world_point, local_cloud->points_timestamp(i),
-                           FLT_MAX, local_cloud->points_beam_id()[i], 0);
+#endif
+  for (; i < size; ++i) {
+    const float x = xs[i];
+    const float y = ys[i];
+    const float z = zs[i];
+    bool keep = true;
+    if (filter_naninf_points_) {
+      keep = fabsf(x) <= kPointInfThreshold && fabsf(y) <= kPointInfThreshold &&
+             fabsf(z) <= kPointInfThreshold;
+    }
+    if (keep && filter_nearby_box_points_) {
+      const float nx = rot(0, 0) * x + rot(0, 1) * y + rot(0, 2) * z + trans(0);
+      const float ny = rot(1, 0) * x + rot(1, 1) * y + rot(1, 2) * z + trans(1);
+      keep = !(nx < box_forward_x_ && nx > box_backward_x_ &&
+               ny < box_forward_y_ && ny > box_backward_y_);
+    }
+    if (keep && filter_high_z_points_) {
+      keep = !(z > z_threshold_);
+    }
+    keep_[i] = static_cast<uint8_t>(keep);
+    kept += keep;
   }
-  return true;
+  return kept;
 }
 
 }  // namespace lidar
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
@@ -61,9 +62,15 @@ class PointCloudPreprocessor {
   std::string Name() const { return "PointCloudPreprocessor"; }
 
  private:
-  bool TransformCloud(const base::PointFCloudPtr& local_cloud,
-                      const Eigen::Affine3d& pose,
-                      base::PointDCloudPtr world_cloud) const;
+  // @brief: evaluate all filters on the soa buffers, fill keep_ with 0/1
+  // @return: number of kept points
+  size_t FilterPoints(size_t size,
+                      const Eigen::Affine3d& sensor2novatel) const;
+  // soa copy of the input coordinates and the filter mask, reused per frame
+  mutable std::vector<float> xs_;
+  mutable std::vector<float> ys_;
+  mutable std::vector<float> zs_;
+  mutable std::vector<uint8_t> keep_;
   // params
   bool filter_naninf_points_ = true;
   bool filter_nearby_box_points_ = true;
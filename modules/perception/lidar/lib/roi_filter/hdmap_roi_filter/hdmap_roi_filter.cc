@@ -54,6 +54,9 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   extend_dist_ = config.extend_dist();
   no_edge_table_ = config.no_edge_table();
   set_roi_service_ = config.set_roi_service();
+  bitmap_reuse_margin_ = std::max(config.bitmap_reuse_margin(), 0.0);
+  bitmap_range_ = range_ + bitmap_reuse_margin_;
+  has_bitmap_ = false;
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
@@ -61,8 +64,8 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   polygons_local_.reserve(KPolygonMaxNum);
 
   // init bitmap
-  Eigen::Vector2d min_range(-range_, -range_);
-  Eigen::Vector2d max_range(range_, range_);
+  Eigen::Vector2d min_range(-bitmap_range_, -bitmap_range_);
+  Eigen::Vector2d max_range(bitmap_range_, bitmap_range_);
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
 
@@ -71,7 +74,8 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " bitmap_reuse_margin: " << bitmap_reuse_margin_;
   return true;
 }
 
@@ -102,12 +106,27 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   }
 
   // transform to local
-  base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
-  TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
+  // reuse the bitmap while the vehicle stays within the margin, the points
+  // are then looked up relative to where the bitmap was rasterized
+  const Eigen::Vector3d vel_location = frame->lidar2world_pose.translation();
+  const bool reuse_bitmap =
+      has_bitmap_ && bitmap_reuse_margin_ > 0.0 &&
+      (vel_location - bitmap_origin_).head<2>().norm() <= bitmap_reuse_margin_;
+  if (!reuse_bitmap) {
+    bitmap_origin_ = vel_location;
+  }
+  TransformFrame(frame->cloud, frame->lidar2world_pose, bitmap_origin_,
+                 polygons_world_, &polygons_local_, &cloud_local_);
 
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+  bool ret = false;
+  if (reuse_bitmap) {
+    const Eigen::Vector2d car = (vel_location - bitmap_origin_).head<2>();
+    ret = Bitmap2dFilter(cloud_local_, bitmap_, car, &(frame->roi_indices));
+  } else {
+    ret = FilterWithPolygonMask(cloud_local_, polygons_local_,
+                                &(frame->roi_indices));
+    has_bitmap_ = true;
+  }
 
   // set roi points label
   if (ret) {
@@ -124,13 +143,13 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   if (set_roi_service_) {
     auto roi_service = SceneManager::Instance().Service("ROIService");
     if (roi_service != nullptr) {
-      roi_service_content_.range_ = range_;
+      roi_service_content_.range_ = bitmap_range_;
       roi_service_content_.cell_size_ = cell_size_;
       roi_service_content_.map_size_ = bitmap_.map_size();
       roi_service_content_.bitmap_ = bitmap_.bitmap();
       roi_service_content_.major_dir_ =
           static_cast<ROIServiceContent::DirectionMajor>(bitmap_.dir_major());
-      roi_service_content_.transform_ = frame->lidar2world_pose.translation();
+      roi_service_content_.transform_ = bitmap_origin_;
       roi_service->UpdateServiceContent(roi_service_content_);
     } else {
       AINFO << "Failed to find roi service and cannot update.";
@@ -140,13 +159,13 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
 }
 
 bool HdmapROIFilter::FilterWithPolygonMask(
-    const base::PointFCloudPtr& cloud,
+    const base::SoAPointFCloud& cloud,
     const std::vector<PolygonDType>& map_polygons,
     base::PointIndices* roi_indices) {
   std::vector<Polygon<double>> raw_polygons;
   // convert and obtain the major direction
   raw_polygons.resize(map_polygons.size());
-  double min_x = range_;
+  double min_x = bitmap_range_;
   double max_x = -min_x;
   double min_y = min_x;
   double max_y = max_x;
@@ -164,10 +183,10 @@ bool HdmapROIFilter::FilterWithPolygonMask(
       max_y = std::max(raw_polygon[j].y(), max_y);
     }
   }
-  min_x = std::max(min_x, -range_);
-  max_x = std::min(max_x, range_);
-  min_y = std::max(min_y, -range_);
-  max_y = std::min(max_y, range_);
+  min_x = std::max(min_x, -bitmap_range_);
+  max_x = std::min(max_x, bitmap_range_);
+  min_y = std::max(min_y, -bitmap_range_);
+  max_y = std::min(max_y, bitmap_range_);
 
   DirectionMajor major_dir = DirectionMajor::XMAJOR;
   if ((max_y - min_y) < (max_x - min_x)) {
@@ -177,14 +196,16 @@ bool HdmapROIFilter::FilterWithPolygonMask(
 
   DrawPolygonsMask<double>(raw_polygons, &bitmap_, extend_dist_,
                            no_edge_table_);
-  return Bitmap2dFilter(cloud, bitmap_, roi_indices);
+  return Bitmap2dFilter(cloud, bitmap_, Eigen::Vector2d(0.0, 0.0),
+                        roi_indices);
 }
 
 void HdmapROIFilter::TransformFrame(
     const base::PointFCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
+    const Eigen::Vector3d& origin,
     const std::vector<PolygonDType*>& polygons_world,
     std::vector<PolygonDType>* polygons_local,
-    base::PointFCloudPtr* cloud_local) {
+    base::SoAPointFCloud* cloud_local) {
   Eigen::Vector3d vel_location = vel_pose.translation();
   Eigen::Matrix3d vel_rot = vel_pose.linear();
   Eigen::Vector3d x_axis = vel_rot.row(0);
@@ -198,35 +219,38 @@ void HdmapROIFilter::TransformFrame(
     auto& polygon_local = (*polygons_local)[i];
     polygon_local.resize(polygon_world.size());
     for (size_t j = 0; j < polygon_local.size(); ++j) {
-      polygon_local[j].x = polygon_world[j].x - vel_location.x();
-      polygon_local[j].y = polygon_world[j].y - vel_location.y();
+      polygon_local[j].x = polygon_world[j].x - origin.x();
+      polygon_local[j].y = polygon_world[j].y - origin.y();
     }
   }
 
   // transform cloud
-  (*cloud_local)->clear();
-  (*cloud_local)->resize(cloud->size());
-  for (size_t i = 0; i < (*cloud_local)->size(); ++i) {
+  const Eigen::Vector3d offset = vel_location - origin;
+  cloud_local->resize(cloud->size());
+  float* local_x = cloud_local->mutable_x_data();
+  float* local_y = cloud_local->mutable_y_data();
+  for (size_t i = 0; i < cloud->size(); ++i) {
     const auto& pt = cloud->at(i);
-    auto& local_pt = (*cloud_local)->at(i);
     Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
-    local_pt.x = static_cast<float>(x_axis.dot(e_pt));
-    local_pt.y = static_cast<float>(y_axis.dot(e_pt));
+    local_x[i] = static_cast<float>(x_axis.dot(e_pt) + offset.x());
+    local_y[i] = static_cast<float>(y_axis.dot(e_pt) + offset.y());
   }
 }
 
-bool HdmapROIFilter::Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
+bool HdmapROIFilter::Bitmap2dFilter(const base::SoAPointFCloud& in_cloud,
                                     const Bitmap2D& bitmap,
+                                    const Eigen::Vector2d& car,
                                     base::PointIndices* roi_indices) {
-  if (!bitmap.Check(Eigen::Vector2d(0.0, 0.0))) {
+  if (!bitmap.Check(car)) {
     AWARN << " Car is not in roi!!.";
     return false;
   }
   roi_indices->indices.clear();
-  roi_indices->indices.reserve(in_cloud->size());
-  for (size_t i = 0; i < in_cloud->size(); ++i) {
-    const auto& pt = in_cloud->at(i);
-    Eigen::Vector2d e_pt(pt.x, pt.y);
+  roi_indices->indices.reserve(in_cloud.size());
+  const float* xs = in_cloud.x_data();
+  const float* ys = in_cloud.y_data();
+  for (size_t i = 0; i < in_cloud.size(); ++i) {
+    Eigen::Vector2d e_pt(xs[i], ys[i]);
     if (!bitmap.IsExists(e_pt)) {
       continue;
     }
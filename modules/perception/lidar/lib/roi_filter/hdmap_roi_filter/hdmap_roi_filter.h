@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/base/soa_point_cloud.h"
 #include "modules/perception/lidar/lib/interface/base_roi_filter.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
 #include "modules/perception/lidar/lib/scene_manager/roi_service/roi_service.h"
@@ -45,19 +46,22 @@ class HdmapROIFilter : public BaseROIFilter {
   bool Filter(const ROIFilterOptions& options, LidarFrame* frame) override;
 
  private:
+  // transform polygons and cloud to the world axes centered at origin
   void TransformFrame(const base::PointFCloudPtr& cloud,
                       const Eigen::Affine3d& vel_pose,
+                      const Eigen::Vector3d& origin,
                       const std::vector<base::PolygonDType*>& polygons_world,
                       std::vector<base::PolygonDType>* polygons_local,
-                      base::PointFCloudPtr* cloud_local);
+                      base::SoAPointFCloud* cloud_local);
 
   bool FilterWithPolygonMask(
-      const base::PointFCloudPtr& cloud,
+      const base::SoAPointFCloud& cloud,
       const std::vector<base::PolygonDType>& map_polygons,
       base::PointIndices* roi_indices);
 
-  bool Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
-                      const Bitmap2D& bitmap, base::PointIndices* roi_indices);
+  bool Bitmap2dFilter(const base::SoAPointFCloud& in_cloud,
+                      const Bitmap2D& bitmap, const Eigen::Vector2d& car,
+                      base::PointIndices* roi_indices);
 
   // parameters for polygons scans convert
   double range_ = 120.0;
@@ -65,8 +69,16 @@ class HdmapROIFilter : public BaseROIFilter {
   double extend_dist_ = 0.0;
   bool no_edge_table_ = false;
   bool set_roi_service_ = false;
+  // the bitmap covers bitmap_range_ = range_ + bitmap_reuse_margin_ around
+  // bitmap_origin_, so it is valid as long as the vehicle stays in margin
+  double bitmap_reuse_margin_ = 0.0;
+  double bitmap_range_ = 120.0;
+  bool has_bitmap_ = false;
+  Eigen::Vector3d bitmap_origin_ = Eigen::Vector3d::Zero();
   std::vector<base::PolygonDType*> polygons_world_;
   std::vector<base::PolygonDType> polygons_local_;
+  // only x and y of the local cloud are used
+  base::SoAPointFCloud cloud_local_;
   Bitmap2D bitmap_;
   ROIServiceContent roi_service_content_;
 
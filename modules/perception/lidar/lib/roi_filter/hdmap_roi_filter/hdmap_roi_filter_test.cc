@@ -263,6 +263,52 @@ class HdmapROIFilterTest : public ::testing::Test {
     }
   }
 
+  void ReuseBitmap() {
+    hdmap_roi_filter_ptr_->Init(opts_);
+    hdmap_roi_filter_ptr_->bitmap_reuse_margin_ = 5.0;
+    hdmap_roi_filter_ptr_->bitmap_range_ =
+        hdmap_roi_filter_ptr_->range_ + 5.0;
+    const double range = hdmap_roi_filter_ptr_->bitmap_range_;
+    hdmap_roi_filter_ptr_->bitmap_.Init(Eigen::Vector2d(-range, -range),
+                                        Eigen::Vector2d(range, range),
+                                        Eigen::Vector2d(0.25, 0.25));
+
+    frame_.cloud = base::PointFCloudPool::Instance().Get();
+    frame_.hdmap_struct.reset(new base::HdmapStruct);
+    frame_.hdmap_struct->road_polygons.resize(1);
+    auto& polygon = frame_.hdmap_struct->road_polygons[0];
+    polygon.resize(4);
+    polygon.at(0).x = 5.0;
+    polygon.at(0).y = 10.0;
+    polygon.at(1).x = 10.0;
+    polygon.at(1).y = 15.0;
+    polygon.at(2).x = 15.0;
+    polygon.at(2).y = 10.0;
+    polygon.at(3).x = 10.0;
+    polygon.at(3).y = 5.0;
+    frame_.cloud->resize(2);
+    frame_.cloud->at(0).x = 0.0;
+    frame_.cloud->at(0).y = 0.0;
+    frame_.cloud->at(1).x = 0.0;
+    frame_.cloud->at(1).y = -10.0;
+
+    frame_.lidar2world_pose = Eigen::Translation3d(10.0, 10.0, 0);
+    EXPECT_TRUE(hdmap_roi_filter_ptr_->Filter(options_, &frame_));
+    EXPECT_EQ(frame_.roi_indices.indices.size(), 1);
+
+    // within the margin, the bitmap rasterized at (10, 10) is reused
+    frame_.lidar2world_pose = Eigen::Translation3d(12.0, 10.0, 0);
+    EXPECT_TRUE(hdmap_roi_filter_ptr_->Filter(options_, &frame_));
+    EXPECT_DOUBLE_EQ(hdmap_roi_filter_ptr_->bitmap_origin_.x(), 10.0);
+    EXPECT_EQ(frame_.roi_indices.indices.size(), 1);
+    EXPECT_EQ(frame_.roi_indices.indices[0], 0);
+
+    // out of the margin, the bitmap is rasterized again
+    frame_.lidar2world_pose = Eigen::Translation3d(20.0, 10.0, 0);
+    EXPECT_FALSE(hdmap_roi_filter_ptr_->Filter(options_, &frame_));
+    EXPECT_DOUBLE_EQ(hdmap_roi_filter_ptr_->bitmap_origin_.x(), 20.0);
+  }
+
   void FilterWithEdgeTable() {
     hdmap_roi_filter_ptr_->set_roi_service_ = false;
     hdmap_roi_filter_ptr_->no_edge_table_ = false;
@@ -296,6 +342,10 @@ TEST_F(HdmapROIFilterTest, filter_with_parallel) {
   HdmapROIFilterTest::FilterWithParallel();
 }
 
+TEST_F(HdmapROIFilterTest, reuse_bitmap) {
+  HdmapROIFilterTest::ReuseBitmap();
+}
+
 TEST_F(HdmapROIFilterTest, filter_with_simple_case) {
   // TODO(perception): fix the test.
   // HdmapROIFilterTest::SimpleCaseFilter();
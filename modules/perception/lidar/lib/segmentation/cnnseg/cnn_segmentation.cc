@@ -83,6 +83,9 @@ bool CNNSegmentation::Init(const SegmentationInitOptions& options) {
   gpu_id_ = cnnseg_param_.has_gpu_id() ? cnnseg_param_.gpu_id() : -1;
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   inference_->set_gpu_id(gpu_id_);  // inference sets CPU mode when -1
+  if (gpu_id_ >= 0) {
+    infer_timer_.reset(new inference::GpuStageTimer("cnnseg_infer"));
+  }
 
   std::map<std::string, std::vector<int>> input_shapes;
   auto& input_shape = input_shapes[network_param.feature_blob()];
@@ -223,12 +226,18 @@ bool CNNSegmentation::InitClusterAndBackgroundSegmentation() {
 
 void CNNSegmentation::MapPointToGrid(
     const std::shared_ptr<AttributePointCloud<PointF>>& pc_ptr) {
+  point2grid_.assign(pc_ptr->size(), -1);
+  MapPointToGrid(pc_ptr, 0, pc_ptr->size());
+}
+
+void CNNSegmentation::MapPointToGrid(
+    const std::shared_ptr<AttributePointCloud<PointF>>& pc_ptr, size_t begin,
+    size_t end) {
   float inv_res_x = 0.5f * static_cast<float>(width_) / range_;
   // float inv_res_y = 0.5 * static_cast<float>(height_) / range_;
-  point2grid_.assign(pc_ptr->size(), -1);
   int pos_x = -1;
   int pos_y = -1;
-  for (size_t i = 0; i < pc_ptr->size(); ++i) {
+  for (size_t i = begin; i < end; ++i) {
     const auto& pt = pc_ptr->at(i);
     if (pt.z <= min_height_ || pt.z >= max_height_) {
       continue;
@@ -280,21 +289,54 @@ bool CNNSegmentation::Segment(const SegmentationOptions& options,
 
   // note we should use origninal cloud here, frame->cloud may be exchanged
   Timer timer;
-  // map 3d points to 2d image grids
-  MapPointToGrid(original_cloud_);
-  mapping_time_ = timer.toc(true);
+  if (cnnseg_param_.enable_pipeline()) {
+    if (cudaSetDevice(gpu_id_) != cudaSuccess) {
+      AERROR << "Failed to set device to " << gpu_id_;
+      return false;
+    }
+    // map 3d points to 2d image grids chunk by chunk, overlapped with the
+    // upload and feature generation of the mapped chunks
+    point2grid_.assign(original_cloud_->size(), -1);
+    feature_generator_->GeneratePipelined(
+        original_cloud_,
+        [&](size_t begin, size_t end) {
+          MapPointToGrid(original_cloud_, begin, end);
+        },
+        point2grid_, cnnseg_param_.pipeline_chunk_size());
+    mapping_time_ = 0.0;
+    feature_time_ = timer.toc(true);
+  } else if (cnnseg_param_.enable_gpu_mapping()) {
+    if (cudaSetDevice(gpu_id_) != cudaSuccess) {
+      AERROR << "Failed to set device to " << gpu_id_;
+      return false;
+    }
+    // map 3d points to 2d image grids on gpu along with the features
+    feature_generator_->GenerateWithMapping(original_cloud_, &point2grid_);
+    mapping_time_ = 0.0;
+    feature_time_ = timer.toc(true);
+  } else {
+    // map 3d points to 2d image grids
+    MapPointToGrid(original_cloud_);
+    mapping_time_ = timer.toc(true);
+
+    if (cudaSetDevice(gpu_id_) != cudaSuccess) {
+      AERROR << "Failed to set device to " << gpu_id_;
+      return false;
+    }
 
-  if (cudaSetDevice(gpu_id_) != cudaSuccess) {
-    AERROR << "Failed to set device to " << gpu_id_;
-    return false;
+    // generate features
+    feature_generator_->Generate(original_cloud_, point2grid_);
+    feature_time_ = timer.toc(true);
   }
 
-  // generate features
-  feature_generator_->Generate(original_cloud_, point2grid_);
-  feature_time_ = timer.toc(true);
-
   // model inference
+  if (infer_timer_ != nullptr) {
+    infer_timer_->Start();
+  }
   inference_->Infer();
+  if (infer_timer_ != nullptr) {
+    infer_timer_->Stop();
+  }
   infer_time_ = timer.toc(true);
 
   // processing clustering
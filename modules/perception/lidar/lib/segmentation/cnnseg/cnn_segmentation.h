@@ -27,6 +27,7 @@
 #include "modules/perception/base/blob.h"
 #include "modules/perception/inference/inference.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/utils/gpu_stage_timer.h"
 #include "modules/perception/lib/thread/thread_worker.h"
 #include "modules/perception/lidar/lib/interface/base_ground_detector.h"
 #include "modules/perception/lidar/lib/interface/base_roi_filter.h"
@@ -62,8 +63,14 @@ class CNNSegmentation : public BaseSegmentation {
   void MapPointToGrid(
       const std::shared_ptr<base::AttributePointCloud<base::PointF>>& pc_ptr);
 
+  // map the points in [begin, end) to grids, point2grid_ is already sized
+  void MapPointToGrid(
+      const std::shared_ptr<base::AttributePointCloud<base::PointF>>& pc_ptr,
+      size_t begin, size_t end);
+
   CNNSegParam cnnseg_param_;
   std::shared_ptr<inference::Inference> inference_;
+  std::unique_ptr<inference::GpuStageTimer> infer_timer_;
   std::shared_ptr<FeatureGenerator> feature_generator_;
 
   // output blobs
@@ -15,7 +15,10 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/segmentation/cnnseg/feature_generator.h"
 
+#include <algorithm>
+
 #include "modules/perception/base/common.h"
+#include "modules/perception/base/syncedmem.h"
 
 namespace apollo {
 namespace perception {
@@ -150,6 +153,33 @@ __global__ void TopIntensityKernel(const int n, Dtype* top_intensity,
   }
 }
 
+// same as GroupPc2Pixel of the axis rotated projection, the products and
+// sums are not contracted to fma, which would move points across grid edges
+__global__ void PointToGridKernel(const int n, const base::PointF* pc,
+                                  const float min_height,
+                                  const float max_height, const float scale,
+                                  const float range, const int width,
+                                  const int height, int* point2grid) {
+  CUDA_KERNEL_LOOP(i, n) {
+    const float px = pc[i].x;
+    const float py = pc[i].y;
+    const float pz = pc[i].z;
+    int idx = -1;
+    if (pz > min_height && pz < max_height) {
+      float fx = __fmul_rn(
+          __fsub_rn(range, __fmul_rn(0.707107f, __fadd_rn(px, py))), scale);
+      float fy = __fmul_rn(
+          __fsub_rn(range, __fmul_rn(0.707107f, __fsub_rn(px, py))), scale);
+      int pos_x = fx < 0 ? -1 : static_cast<int>(fx);
+      int pos_y = fy < 0 ? -1 : static_cast<int>(fy);
+      if (pos_y >= 0 && pos_y < height && pos_x >= 0 && pos_x < width) {
+        idx = pos_y * width + pos_x;
+      }
+    }
+    point2grid[i] = idx;
+  }
+}
+
 template <typename Dtype>
 __global__ void SetKernel(const int n, const Dtype alpha, Dtype* y) {
   CUDA_KERNEL_LOOP(i, n) {
@@ -157,28 +187,27 @@ __global__ void SetKernel(const int n, const Dtype alpha, Dtype* y) {
   }
 }
 
-void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
-                       const std::vector<int>& point2grid) {
+void FeatureGenerator::ResetFeatureGPU(cudaStream_t stream) {
   // fill initial value for feature blob
   int map_size = width_ * height_;
   int block_size = (map_size + kGPUThreadSize - 1) / kGPUThreadSize;
-  SetKernel<float><<<block_size, kGPUThreadSize>>>(map_size, -5.f,
+  SetKernel<float><<<block_size, kGPUThreadSize, 0, stream>>>(map_size, -5.f,
                                                 max_height_data_);
-  BASE_CUDA_CHECK(cudaMemset(mean_height_data_, 0.f,
-                             sizeof(float) * map_size));
-  BASE_CUDA_CHECK(cudaMemset(count_data_, 0.f,
-                             sizeof(float) * map_size));
-  BASE_CUDA_CHECK(cudaMemset(nonempty_data_, 0.f,
-                             sizeof(float) * map_size));
+  BASE_CUDA_CHECK(cudaMemsetAsync(mean_height_data_, 0.f,
+                                  sizeof(float) * map_size, stream));
+  BASE_CUDA_CHECK(cudaMemsetAsync(count_data_, 0.f,
+                                  sizeof(float) * map_size, stream));
+  BASE_CUDA_CHECK(cudaMemsetAsync(nonempty_data_, 0.f,
+                                  sizeof(float) * map_size, stream));
   if (use_intensity_feature_) {
-    BASE_CUDA_CHECK(cudaMemset(top_intensity_data_, 0.f,
-                               sizeof(float) * map_size));
-    BASE_CUDA_CHECK(cudaMemset(mean_intensity_data_, 0.f,
-                               sizeof(float) * map_size));
+    BASE_CUDA_CHECK(cudaMemsetAsync(top_intensity_data_, 0.f,
+                                    sizeof(float) * map_size, stream));
+    BASE_CUDA_CHECK(cudaMemsetAsync(mean_intensity_data_, 0.f,
+                                    sizeof(float) * map_size, stream));
   }
+}
 
-  // copy cloud data and point2grid from CPU to GPU memory
-  size_t cloud_size = pc_ptr->size();
+void FeatureGenerator::ReserveGPUMemory(size_t cloud_size) {
   if (cloud_size > pc_gpu_size_) {
     // cloud data
     BASE_CUDA_CHECK(cudaFree(pc_gpu_));
@@ -190,6 +219,27 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
     BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void **>(&point2grid_gpu_),
                     cloud_size * sizeof(int)));
   }
+}
+
+void FeatureGenerator::ReserveHostMemory(size_t cloud_size) {
+  if (cloud_size > pc_host_size_) {
+    base::PerceptionFreeHost(pc_host_, true);
+    base::PerceptionFreeHost(point2grid_host_, true);
+    base::PerceptionMallocHost(reinterpret_cast<void **>(&pc_host_),
+                               cloud_size * sizeof(base::PointF), true);
+    base::PerceptionMallocHost(reinterpret_cast<void **>(&point2grid_host_),
+                               cloud_size * sizeof(int), true);
+    pc_host_size_ = cloud_size;
+  }
+}
+
+void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
+                       const std::vector<int>& point2grid) {
+  ResetFeatureGPU(0);
+
+  // copy cloud data and point2grid from CPU to GPU memory
+  size_t cloud_size = pc_ptr->size();
+  ReserveGPUMemory(cloud_size);
   BASE_CUDA_CHECK(cudaMemcpy(pc_gpu_, &(pc_ptr->front()),
                  sizeof(base::PointF) * cloud_size,
                  cudaMemcpyHostToDevice));
@@ -209,6 +259,7 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
           point2grid_gpu_);
   }
   {
+    int map_size = width_ * height_;
     int block_size = (map_size + kGPUThreadSize - 1) / kGPUThreadSize;
     float* log_table = log_blob_->mutable_gpu_data() + log_blob_->offset(0, 0);
     AverageKernel<float><<<block_size, kGPUThreadSize>>>(map_size, count_data_,
@@ -217,6 +268,98 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
   }
 }
 
+void FeatureGenerator::GenerateGPUPipelined(
+    const base::PointFCloudPtr& pc_ptr,
+    const std::function<void(size_t, size_t)>& map_func,
+    const std::vector<int>& point2grid, size_t chunk_size) {
+  size_t cloud_size = pc_ptr->size();
+  chunk_size = std::max(chunk_size, static_cast<size_t>(kGPUThreadSize));
+  ReserveGPUMemory(cloud_size);
+  ReserveHostMemory(cloud_size);
+  ResetFeatureGPU(stream_);
+
+  // every chunk has its own range of the pinned buffers, so the host can
+  // map chunk k + 1 while chunk k is being uploaded and scattered
+  for (size_t begin = 0; begin < cloud_size; begin += chunk_size) {
+    size_t end = std::min(cloud_size, begin + chunk_size);
+    size_t count = end - begin;
+    map_func(begin, end);
+    memcpy(pc_host_ + begin, &(pc_ptr->at(begin)),
+           sizeof(base::PointF) * count);
+    memcpy(point2grid_host_ + begin, point2grid.data() + begin,
+           sizeof(int) * count);
+    BASE_CUDA_CHECK(cudaMemcpyAsync(pc_gpu_ + begin, pc_host_ + begin,
+                    sizeof(base::PointF) * count, cudaMemcpyHostToDevice,
+                    stream_));
+    BASE_CUDA_CHECK(cudaMemcpyAsync(point2grid_gpu_ + begin,
+                    point2grid_host_ + begin, sizeof(int) * count,
+                    cudaMemcpyHostToDevice, stream_));
+    int block_size = (count + kGPUThreadSize - 1) / kGPUThreadSize;
+    MapKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(count,
+          pc_gpu_ + begin, max_height_data_, mean_height_data_,
+          mean_intensity_data_, count_data_, point2grid_gpu_ + begin);
+  }
+
+  // top intensity needs the max height of all points
+  if (cloud_size > 0) {
+    int block_size = (cloud_size + kGPUThreadSize - 1) / kGPUThreadSize;
+    TopIntensityKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(
+          cloud_size, top_intensity_data_, pc_gpu_, max_height_data_,
+          point2grid_gpu_);
+  }
+  {
+    int map_size = width_ * height_;
+    int block_size = (map_size + kGPUThreadSize - 1) / kGPUThreadSize;
+    float* log_table = log_blob_->mutable_gpu_data() + log_blob_->offset(0, 0);
+    AverageKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(map_size,
+          count_data_, max_height_data_, mean_height_data_,
+          mean_intensity_data_, nonempty_data_, log_table, kMaxLogNum);
+  }
+  // inference runs on another stream and reads the features
+  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+}
+
+void FeatureGenerator::GenerateGPUWithMapping(
+    const base::PointFCloudPtr& pc_ptr, std::vector<int>* point2grid) {
+  size_t cloud_size = pc_ptr->size();
+  ReserveGPUMemory(cloud_size);
+  ReserveHostMemory(cloud_size);
+  ResetFeatureGPU(stream_);
+
+  if (cloud_size > 0) {
+    memcpy(pc_host_, &(pc_ptr->front()), sizeof(base::PointF) * cloud_size);
+    BASE_CUDA_CHECK(cudaMemcpyAsync(pc_gpu_, pc_host_,
+                    sizeof(base::PointF) * cloud_size, cudaMemcpyHostToDevice,
+                    stream_));
+    int block_size = (cloud_size + kGPUThreadSize - 1) / kGPUThreadSize;
+    float scale = 0.5f * static_cast<float>(width_) / range_;
+    PointToGridKernel<<<block_size, kGPUThreadSize, 0, stream_>>>(cloud_size,
+          pc_gpu_, min_height_, max_height_, scale, range_, width_, height_,
+          point2grid_gpu_);
+    MapKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(cloud_size,
+          pc_gpu_, max_height_data_, mean_height_data_, mean_intensity_data_,
+          count_data_, point2grid_gpu_);
+    TopIntensityKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(
+          cloud_size, top_intensity_data_, pc_gpu_, max_height_data_,
+          point2grid_gpu_);
+    // clustering on the host needs the mapping
+    BASE_CUDA_CHECK(cudaMemcpyAsync(point2grid_host_, point2grid_gpu_,
+                    sizeof(int) * cloud_size, cudaMemcpyDeviceToHost,
+                    stream_));
+  }
+  {
+    int map_size = width_ * height_;
+    int block_size = (map_size + kGPUThreadSize - 1) / kGPUThreadSize;
+    float* log_table = log_blob_->mutable_gpu_data() + log_blob_->offset(0, 0);
+    AverageKernel<float><<<block_size, kGPUThreadSize, 0, stream_>>>(map_size,
+          count_data_, max_height_data_, mean_height_data_,
+          mean_intensity_data_, nonempty_data_, log_table, kMaxLogNum);
+  }
+  // inference runs on another stream and reads the features
+  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+  point2grid->assign(point2grid_host_, point2grid_host_ + cloud_size);
+}
+
 void FeatureGenerator::ReleaseGPUMemory() {
   if (pc_gpu_ != nullptr) {
     BASE_CUDA_CHECK(cudaFree(pc_gpu_));
@@ -224,6 +367,15 @@ void FeatureGenerator::ReleaseGPUMemory() {
   if (point2grid_gpu_ != nullptr) {
     BASE_CUDA_CHECK(cudaFree(point2grid_gpu_));
   }
+  if (pc_host_ != nullptr) {
+    base::PerceptionFreeHost(pc_host_, true);
+  }
+  if (point2grid_host_ != nullptr) {
+    base::PerceptionFreeHost(point2grid_host_, true);
+  }
+  if (stream_ != nullptr) {
+    BASE_CUDA_CHECK(cudaStreamDestroy(stream_));
+  }
 }
 
 }  // namespace lidar
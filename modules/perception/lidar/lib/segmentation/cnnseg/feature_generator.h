@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,7 @@ class FeatureGenerator {
                                pc_gpu_size_ * sizeof(base::PointF)));
     BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&point2grid_gpu_),
                                pc_gpu_size_ * sizeof(int)));
+    BASE_CUDA_CHECK(cudaStreamCreate(&stream_));
 #endif
   }
 
@@ -59,16 +61,54 @@ class FeatureGenerator {
 #endif
   }
 
+  // map_func(begin, end) fills point2grid of the points in [begin, end),
+  // features of a mapped chunk are computed while the next one is mapped
+  void GeneratePipelined(const base::PointFCloudPtr& pc_ptr,
+                         const std::function<void(size_t, size_t)>& map_func,
+                         const std::vector<int>& point2grid,
+                         size_t chunk_size) {
+#ifndef PERCEPTION_CPU_ONLY
+    GenerateGPUPipelined(pc_ptr, map_func, point2grid, chunk_size);
+#else
+    map_func(0, pc_ptr->size());
+    GenerateCPU(pc_ptr, point2grid);
+#endif
+  }
+
+  // maps the points to grids like CNNSegmentation::MapPointToGrid and
+  // generates the features from the mapping, all on gpu from one upload of
+  // the cloud, point2grid gets the mapping back for clustering
+  void GenerateWithMapping(const base::PointFCloudPtr& pc_ptr,
+                           std::vector<int>* point2grid) {
+#ifndef PERCEPTION_CPU_ONLY
+    GenerateGPUWithMapping(pc_ptr, point2grid);
+#else
+    MapPointToGridCPU(pc_ptr, point2grid);
+    GenerateCPU(pc_ptr, *point2grid);
+#endif
+  }
+
   inline std::string Name() const { return "FeatureGenerator"; }
 
  private:
 #ifndef PERCEPTION_CPU_ONLY
   void GenerateGPU(const base::PointFCloudPtr& pc_ptr,
                    const std::vector<int>& point2grid);
+  void GenerateGPUPipelined(
+      const base::PointFCloudPtr& pc_ptr,
+      const std::function<void(size_t, size_t)>& map_func,
+      const std::vector<int>& point2grid, size_t chunk_size);
+  void GenerateGPUWithMapping(const base::PointFCloudPtr& pc_ptr,
+                              std::vector<int>* point2grid);
+  void ResetFeatureGPU(cudaStream_t stream);
+  void ReserveGPUMemory(size_t cloud_size);
+  void ReserveHostMemory(size_t cloud_size);
   void ReleaseGPUMemory();
 #endif
   void GenerateCPU(const base::PointFCloudPtr& pc_ptr,
                    const std::vector<int>& point2grid);
+  void MapPointToGridCPU(const base::PointFCloudPtr& pc_ptr,
+                         std::vector<int>* point2grid) const;
 
   float LogCount(int count) {
     if (count < static_cast<int>(log_table_.size())) {
@@ -112,6 +152,14 @@ class FeatureGenerator {
   base::PointF* pc_gpu_ = nullptr;
   int* point2grid_gpu_ = nullptr;
   int pc_gpu_size_ = 0;
+  // pinned host buffers and stream for pipelined generation and generation
+  // with mapping
+  base::PointF* pc_host_ = nullptr;
+  int* point2grid_host_ = nullptr;
+  size_t pc_host_size_ = 0;
+#ifndef PERCEPTION_CPU_ONLY
+  cudaStream_t stream_ = nullptr;
+#endif
   const int kMaxPointCloudGPUSize = 120000;
   const int kGPUThreadSize = 512;
 
@@ -16,6 +16,9 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_matcher.h"
 
+#include <cmath>
+#include <numeric>
+
 #include "cyber/common/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/proto/multi_lidar_fusion_config.pb.h"
@@ -58,6 +61,7 @@ bool MlfTrackObjectMatcher::Init(
 
   bound_value_ = config.bound_value();
   max_match_distance_ = config.max_match_distance();
+  foreground_gate_radius_ = config.foreground_gate_radius();
   return true;
 }
 
@@ -90,7 +94,11 @@ void MlfTrackObjectMatcher::Match(
   common::SecureMat<float> *association_mat = matcher->cost_matrix();
 
   association_mat->Resize(tracks.size(), objects.size());
-  ComputeAssociateMatrix(tracks, objects, association_mat);
+  if (!objects[0]->is_background && foreground_gate_radius_ > 0.f) {
+    ComputeGatedAssociateMatrix(tracks, objects, association_mat);
+  } else {
+    ComputeAssociateMatrix(tracks, objects, association_mat);
+  }
   matcher->Match(matcher_options, assignments, unassigned_tracks,
                  unassigned_objects);
   for (size_t i = 0; i < assignments->size(); ++i) {
@@ -113,6 +121,60 @@ void MlfTrackObjectMatcher::ComputeAssociateMatrix(
   }
 }
 
+namespace {
+
+int64_t GridKey(int64_t x, int64_t y) { return (x << 32) ^ (y & 0xffffffff); }
+
+}  // namespace
+
+void MlfTrackObjectMatcher::ComputeGatedAssociateMatrix(
+    const std::vector<MlfTrackDataPtr> &tracks,
+    const std::vector<TrackedObjectPtr> &new_objects,
+    common::SecureMat<float> *association_mat) {
+  const double radius = foreground_gate_radius_;
+  const double sqr_radius = radius * radius;
+  object_grid_.clear();
+  for (size_t j = 0; j < new_objects.size(); ++j) {
+    const Eigen::Vector3d &anchor = new_objects[j]->anchor_point;
+    int64_t x = static_cast<int64_t>(std::floor(anchor(0) / radius));
+    int64_t y = static_cast<int64_t>(std::floor(anchor(1) / radius));
+    object_grid_[GridKey(x, y)].push_back(j);
+  }
+
+  // the gate radius is chosen so that the location distance alone of a pair
+  // out of the gate exceeds the max match distance, skip the full distance
+  const double current_time = new_objects[0]->object_ptr->latest_tracked_time;
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    for (size_t j = 0; j < new_objects.size(); ++j) {
+      (*association_mat)(i, j) = bound_value_;
+    }
+    tracks[i]->PredictState(current_time);
+    const Eigen::VectorXf &predict = tracks[i]->predict_.state;
+    if (predict.size() < 2) {
+      continue;
+    }
+    int64_t x = static_cast<int64_t>(std::floor(predict(0) / radius));
+    int64_t y = static_cast<int64_t>(std::floor(predict(1) / radius));
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        auto iter = object_grid_.find(GridKey(x + dx, y + dy));
+        if (iter == object_grid_.end()) {
+          continue;
+        }
+        for (size_t j : iter->second) {
+          const Eigen::Vector3d &anchor = new_objects[j]->anchor_point;
+          double diff_x = anchor(0) - predict(0);
+          double diff_y = anchor(1) - predict(1);
+          if (diff_x * diff_x + diff_y * diff_y <= sqr_radius) {
+            (*association_mat)(i, j) = track_object_distance_->ComputeDistance(
+                new_objects[j], tracks[i]);
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -65,6 +66,16 @@ class MlfTrackObjectMatcher {
                               const std::vector<TrackedObjectPtr> &new_objects,
                               common::SecureMat<float> *association_mat);
 
+  // @brief: compute association matrix for pairs within the gate radius only,
+  //         the others are left at bound value
+  // @params [in]: maintained tracks for matching
+  // @params [in]: new detected objects for matching
+  // @params [out]: matrix of association distance
+  void ComputeGatedAssociateMatrix(
+      const std::vector<MlfTrackDataPtr> &tracks,
+      const std::vector<TrackedObjectPtr> &new_objects,
+      common::SecureMat<float> *association_mat);
+
  protected:
   std::unique_ptr<MlfTrackObjectDistance> track_object_distance_;
   std::unique_ptr<BaseBipartiteGraphMatcher> foreground_matcher_;
@@ -72,6 +83,10 @@ class MlfTrackObjectMatcher {
 
   float bound_value_ = 100.f;
   float max_match_distance_ = 4.0f;
+  float foreground_gate_radius_ = 0.f;
+
+  // grid hash of new objects, cell size is the gate radius
+  std::unordered_map<int64_t, std::vector<size_t> > object_grid_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(MlfTrackObjectMatcher);
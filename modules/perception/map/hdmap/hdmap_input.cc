@@ -17,6 +17,7 @@
 #include "modules/perception/map/hdmap/hdmap_input.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
@@ -40,6 +41,14 @@ using base::PointD;
 using base::PointDCloud;
 using base::PointDCloudPtr;
 using base::RoadBoundary;
+
+DEFINE_bool(obs_share_hdmap_roi, false,
+            "share hdmap roi lookups between perception components");
+DEFINE_double(obs_hdmap_roi_margin, 10.0,
+              "margin in meters added to shared hdmap roi lookups");
+
+constexpr size_t HDMapInput::kMaxSharedRois;
+
 // HDMapInput
 
 HDMapInput::HDMapInput() {}
@@ -61,11 +70,19 @@ bool HDMapInput::InitInternal() {
 }
 
 bool HDMapInput::Reset() {
+  ClearSharedRois();
   lib::MutexLock lock(&mutex_);
   inited_ = false;
   return InitInternal();
 }
 
+void HDMapInput::ClearSharedRois() {
+  std::lock_guard<std::mutex> lock(shared_roi_mutex_);
+  for (auto& shared_roi : shared_rois_) {
+    std::atomic_store(&shared_roi, std::shared_ptr<const SharedRoi>());
+  }
+}
+
 bool HDMapInput::InitHDMap() {
   hdmap_.reset(new apollo::hdmap::HDMap());
   const std::string model_name = "HDMapInput";
@@ -140,6 +157,57 @@ bool HDMapInput::GetRoiHDMapStruct(
   return true;
 }
 
+bool HDMapInput::GetSharedRoiHDMapStruct(
+    const base::PointD& pointd, const double distance,
+    base::HdmapStructPtr* hdmap_struct_ptr) {
+  CHECK_NOTNULL(hdmap_struct_ptr);
+  auto covers = [&pointd, distance](const SharedRoi& shared_roi) {
+    const double dx = pointd.x - shared_roi.center.x;
+    const double dy = pointd.y - shared_roi.center.y;
+    return shared_roi.distance == distance &&
+           std::sqrt(dx * dx + dy * dy) + distance <=
+               shared_roi.query_distance;
+  };
+  for (const auto& slot : shared_rois_) {
+    auto shared_roi = std::atomic_load(&slot);
+    if (shared_roi != nullptr && covers(*shared_roi)) {
+      *hdmap_struct_ptr = shared_roi->roi;
+      return true;
+    }
+  }
+
+  // one caller queries, the others of the same distance wait for its roi
+  std::lock_guard<std::mutex> lock(shared_roi_mutex_);
+  size_t index = kMaxSharedRois;
+  for (size_t i = 0; i < kMaxSharedRois; ++i) {
+    auto shared_roi = std::atomic_load(&shared_rois_[i]);
+    if (shared_roi != nullptr && shared_roi->distance == distance) {
+      if (covers(*shared_roi)) {
+        *hdmap_struct_ptr = shared_roi->roi;
+        return true;
+      }
+      index = i;
+      break;
+    }
+  }
+  if (index == kMaxSharedRois) {
+    index = next_shared_roi_;
+    next_shared_roi_ = (next_shared_roi_ + 1) % kMaxSharedRois;
+  }
+  auto new_roi = std::make_shared<SharedRoi>();
+  new_roi->distance = distance;
+  new_roi->query_distance = distance + FLAGS_obs_hdmap_roi_margin;
+  new_roi->center = pointd;
+  new_roi->roi.reset(new base::HdmapStruct());
+  *hdmap_struct_ptr = new_roi->roi;
+  if (!GetRoiHDMapStruct(pointd, new_roi->query_distance, new_roi->roi)) {
+    return false;
+  }
+  std::atomic_store(&shared_rois_[index],
+                    std::shared_ptr<const SharedRoi>(std::move(new_roi)));
+  return true;
+}
+
 void HDMapInput::MergeBoundaryJunction(
     const std::vector<apollo::hdmap::RoadRoiPtr>& boundary,
     const std::vector<apollo::hdmap::JunctionInfoConstPtr>& junctions,
@@ -17,9 +17,12 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "gflags/gflags.h"
+
 #include "cyber/common/macros.h"
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/map/hdmap/hdmap_common.h"
@@ -30,6 +33,9 @@ namespace apollo {
 namespace perception {
 namespace map {
 
+DECLARE_bool(obs_share_hdmap_roi);
+DECLARE_double(obs_hdmap_roi_margin);
+
 class HDMapInput {
  public:
   // thread safe
@@ -37,6 +43,12 @@ class HDMapInput {
   bool Reset();
   bool GetRoiHDMapStruct(const base::PointD& pointd, const double distance,
                          std::shared_ptr<base::HdmapStruct> hdmap_struct_prt);
+  // @brief: roi of at least distance around pointd, shared by all callers
+  //         of the process and only to be read. A cached roi of the same
+  //         distance is reused while the circle fits in it, without a lock,
+  //         else one obs_hdmap_roi_margin larger is queried and cached.
+  bool GetSharedRoiHDMapStruct(const base::PointD& pointd, double distance,
+                               base::HdmapStructPtr* hdmap_struct_ptr);
   bool GetNearestLaneDirection(const base::PointD& pointd,
                                Eigen::Vector3d* lane_direction);
   bool GetSignals(const Eigen::Vector3d& pointd, double forward_distance,
@@ -71,8 +83,23 @@ class HDMapInput {
                            double forward_distance,
                            std::vector<apollo::hdmap::Signal>* signals);
 
+  struct SharedRoi {
+    // requested distance
+    double distance = 0.0;
+    double query_distance = 0.0;
+    base::PointD center;
+    base::HdmapStructPtr roi = nullptr;
+  };
+  // one slot for each distance callers ask for
+  static constexpr size_t kMaxSharedRois = 4;
+
+  void ClearSharedRois();
+
   bool inited_ = false;
   lib::Mutex mutex_;
+  std::shared_ptr<const SharedRoi> shared_rois_[kMaxSharedRois];
+  size_t next_shared_roi_ = 0;
+  std::mutex shared_roi_mutex_;
   std::unique_ptr<apollo::hdmap::HDMap> hdmap_;
   int hdmap_sample_step_ = 5;
   std::string hdmap_file_;
@@ -29,6 +29,18 @@ DEFINE_bool(obs_benchmark_mode, false,
 DEFINE_bool(obs_save_fusion_supplement, false,
             "whether save fusion supplement data, default false");
 DEFINE_bool(start_visualizer, false, "Whether to start visualizer");
+DEFINE_bool(obs_enable_memory_pool, true,
+            "whether to cache pinned and device blob memory for reuse");
+DEFINE_int32(obs_memory_pool_preallocate_mb, 0,
+             "device memory preallocated into the pool at startup");
+DEFINE_int32(obs_memory_pool_preallocate_block_mb, 4,
+             "block size of the preallocated device memory");
+DEFINE_bool(obs_enable_profiler, true,
+            "whether to collect and publish perception stage latencies");
+DEFINE_string(obs_profiler_channel, "/apollo/perception/profile",
+              "channel of the periodic perception profile summary");
+DEFINE_int32(obs_profiler_period_ms, 5000,
+             "period of the perception profile summary");
 
 }  // namespace onboard
 }  // namespace perception
@@ -27,6 +27,12 @@ DECLARE_string(obs_screen_output_dir);
 DECLARE_bool(obs_benchmark_mode);
 DECLARE_bool(obs_save_fusion_supplement);
 DECLARE_bool(start_visualizer);
+DECLARE_bool(obs_enable_memory_pool);
+DECLARE_int32(obs_memory_pool_preallocate_mb);
+DECLARE_int32(obs_memory_pool_preallocate_block_mb);
+DECLARE_bool(obs_enable_profiler);
+DECLARE_string(obs_profiler_channel);
+DECLARE_int32(obs_profiler_period_ms);
 
 }  // namespace onboard
 }  // namespace perception
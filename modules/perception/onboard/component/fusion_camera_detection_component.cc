@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/onboard/component/fusion_camera_detection_component.h"
 
+#include <cmath>
+
 #include <yaml-cpp/yaml.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -25,6 +27,7 @@
 #include "modules/common/time/time_util.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
+#include "modules/perception/lib/utils/profiler.h"
 #include "modules/perception/lib/utils/time_util.h"
 #include "modules/perception/onboard/common_flags/common_flags.h"
 #include "modules/perception/onboard/component/camera_perception_viz_message.h"
@@ -181,6 +184,12 @@ bool FusionCameraDetectionComponent::Init() {
   camera_debug_writer_ =
       node_->CreateWriter<apollo::perception::camera::CameraDebug>(
           camera_debug_channel_name_);
+
+  lib::Profiler::Instance()->set_enabled(FLAGS_obs_enable_profiler);
+  if (FLAGS_obs_enable_profiler) {
+    lib::Profiler::Instance()->StartPublishing(FLAGS_obs_profiler_channel,
+                                               FLAGS_obs_profiler_period_ms);
+  }
   if (InitSensorInfo() != cyber::SUCC) {
     AERROR << "InitSensorInfo() failed.";
     return false;
@@ -253,58 +262,128 @@ void FusionCameraDetectionComponent::OnReceiveImage(
     return;
   }
   last_timestamp_ = msg_timestamp;
-  ++seq_num_;
-
-  // for e2e lantency statistics
-  {
-    const double cur_time = lib::TimeUtil::GetCurrentTime();
-    const double start_latency = (cur_time - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:Start:msg_time[" << camera_name << "-"
-          << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << GLOG_TIMESTAMP(cur_time) << "]:cur_latency[" << start_latency
-          << "]";
-  }
-
-  // protobuf msg
-  std::shared_ptr<apollo::perception::PerceptionObstacles> out_message(
-      new (std::nothrow) apollo::perception::PerceptionObstacles);
-  apollo::common::ErrorCode error_code = apollo::common::OK;
-
-  // prefused msg
-  std::shared_ptr<SensorFrameMessage> prefused_message(new (std::nothrow)
-                                                           SensorFrameMessage);
-
-  if (InternalProc(message, camera_name, &error_code, prefused_message.get(),
-                   out_message.get()) != cyber::SUCC) {
-    AERROR << "InternalProc failed, error_code: " << error_code;
-    if (MakeProtobufMsg(msg_timestamp, seq_num_, std::vector<base::ObjectPtr>(),
-                        error_code, out_message.get()) != cyber::SUCC) {
-      AERROR << "MakeProtobufMsg failed";
-      return;
+
+  if (!enable_batch_detection_) {
+    ProcessImages({CameraImage(camera_name, message)});
+    return;
+  }
+  // a second image of a waiting camera, or one out of the time window of the
+  // waiting images, closes the batch before it is added
+  for (const auto &pending : pending_images_) {
+    const double pending_timestamp =
+        pending.second->measurement_time() + timestamp_offset_;
+    if (pending.first == camera_name ||
+        std::fabs(pending_timestamp - msg_timestamp) > batch_time_window_) {
+      ProcessImages(pending_images_);
+      pending_images_.clear();
+      break;
     }
-    if (output_final_obstacles_) {
-      writer_->Write(out_message);
+  }
+  pending_images_.emplace_back(camera_name, message);
+  if (pending_images_.size() == camera_names_.size()) {
+    ProcessImages(pending_images_);
+    pending_images_.clear();
+  }
+}
+
+void FusionCameraDetectionComponent::ProcessImages(
+    const std::vector<CameraImage> &images) {
+  const size_t num_images = images.size();
+  std::vector<std::shared_ptr<apollo::perception::PerceptionObstacles>>
+      out_messages(num_images);
+  std::vector<std::shared_ptr<SensorFrameMessage>> prefused_messages(
+      num_images);
+  std::vector<apollo::common::ErrorCode> error_codes(num_images,
+                                                     apollo::common::OK);
+  std::vector<camera::CameraFrame *> camera_frames(num_images, nullptr);
+  std::vector<camera::CameraFrame *> prepared_frames;
+  for (size_t i = 0; i < num_images; ++i) {
+    const auto &message = images[i].second;
+    const std::string &camera_name = images[i].first;
+    ++seq_num_;
+
+    // for e2e lantency statistics
+    {
+      const double cur_time = lib::TimeUtil::GetCurrentTime();
+      const double start_latency =
+          (cur_time - message->measurement_time()) * 1e3;
+      AINFO << "FRAME_STATISTICS:Camera:Start:msg_time[" << camera_name << "-"
+            << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
+            << GLOG_TIMESTAMP(cur_time) << "]:cur_latency[" << start_latency
+            << "]";
+    }
+
+    // protobuf msg
+    out_messages[i].reset(new (std::nothrow)
+                              apollo::perception::PerceptionObstacles);
+    // prefused msg
+    prefused_messages[i].reset(new (std::nothrow) SensorFrameMessage);
+    if (PrepareFrame(message, camera_name, &error_codes[i],
+                     prefused_messages[i].get(),
+                     &camera_frames[i]) == cyber::SUCC) {
+      prepared_frames.push_back(camera_frames[i]);
+    } else {
+      camera_frames[i] = nullptr;
     }
-    return;
   }
 
-  bool send_sensorframe_ret = sensorframe_writer_->Write(prefused_message);
-  AINFO << "send out prefused msg, ts: " << std::to_string(msg_timestamp)
-        << "ret: " << send_sensorframe_ret;
-  // Send output msg
-  if (output_final_obstacles_) {
-    writer_->Write(out_message);
-  }
-  // for e2e lantency statistics
-  {
-    const double end_timestamp =
-        apollo::perception::lib::TimeUtil::GetCurrentTime();
-    const double end_latency =
-        (end_timestamp - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:End:msg_time[" << camera_name << "-"
-          << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << GLOG_TIMESTAMP(end_timestamp) << "]:cur_latency[" << end_latency
-          << "]";
+  // Run camera perception pipeline, in one detection batch for several frames
+  if (!prepared_frames.empty() &&
+      !camera_obstacle_pipeline_->Perception(camera_perception_options_,
+                                             prepared_frames)) {
+    AERROR << "camera_obstacle_pipeline_->Perception() failed"
+           << " msg_timestamp: "
+           << std::to_string(prepared_frames.front()->timestamp);
+    for (size_t i = 0; i < num_images; ++i) {
+      if (camera_frames[i] != nullptr) {
+        camera_frames[i] = nullptr;
+        error_codes[i] = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+        prefused_messages[i]->error_code_ = error_codes[i];
+      }
+    }
+  }
+
+  for (size_t i = 0; i < num_images; ++i) {
+    const auto &message = images[i].second;
+    const std::string &camera_name = images[i].first;
+    const double msg_timestamp =
+        message->measurement_time() + timestamp_offset_;
+    if (camera_frames[i] == nullptr ||
+        PublishFrame(camera_name, *camera_frames[i], &error_codes[i],
+                     prefused_messages[i].get(),
+                     out_messages[i].get()) != cyber::SUCC) {
+      AERROR << "InternalProc failed, error_code: " << error_codes[i];
+      if (MakeProtobufMsg(msg_timestamp, prefused_messages[i]->seq_num_,
+                          std::vector<base::ObjectPtr>(), error_codes[i],
+                          out_messages[i].get()) != cyber::SUCC) {
+        AERROR << "MakeProtobufMsg failed";
+        continue;
+      }
+      if (output_final_obstacles_) {
+        writer_->Write(out_messages[i]);
+      }
+      continue;
+    }
+
+    bool send_sensorframe_ret =
+        sensorframe_writer_->Write(prefused_messages[i]);
+    AINFO << "send out prefused msg, ts: " << std::to_string(msg_timestamp)
+          << "ret: " << send_sensorframe_ret;
+    // Send output msg
+    if (output_final_obstacles_) {
+      writer_->Write(out_messages[i]);
+    }
+    // for e2e lantency statistics
+    {
+      const double end_timestamp =
+          apollo::perception::lib::TimeUtil::GetCurrentTime();
+      const double end_latency =
+          (end_timestamp - message->measurement_time()) * 1e3;
+      AINFO << "FRAME_STATISTICS:Camera:End:msg_time[" << camera_name << "-"
+            << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
+            << GLOG_TIMESTAMP(end_timestamp) << "]:cur_latency[" << end_latency
+            << "]";
+    }
   }
 }
 
@@ -367,6 +446,9 @@ int FusionCameraDetectionComponent::InitConfig() {
   camera_debug_channel_name_ =
       fusion_camera_detection_param.camera_debug_channel_name();
   ts_diff_ = fusion_camera_detection_param.ts_diff();
+  enable_batch_detection_ =
+      fusion_camera_detection_param.enable_batch_detection();
+  batch_time_window_ = fusion_camera_detection_param.batch_time_window();
   write_visual_img_ = fusion_camera_detection_param.write_visual_img();
 
   std::string format_str = R"(
@@ -565,11 +647,10 @@ void FusionCameraDetectionComponent::SetCameraHeightAndPitch() {
       default_camera_pitch_);
 }
 
-int FusionCameraDetectionComponent::InternalProc(
+int FusionCameraDetectionComponent::PrepareFrame(
     const std::shared_ptr<apollo::drivers::Image const> &in_message,
     const std::string &camera_name, apollo::common::ErrorCode *error_code,
-    SensorFrameMessage *prefused_message,
-    apollo::perception::PerceptionObstacles *out_message) {
+    SensorFrameMessage *prefused_message, camera::CameraFrame **frame) {
   const double msg_timestamp =
       in_message->measurement_time() + timestamp_offset_;
   const int frame_size = static_cast<int>(camera_frames_.size());
@@ -616,18 +697,17 @@ int FusionCameraDetectionComponent::InternalProc(
   }
 
   ++frame_id_;
-  // Run camera perception pipeline
   camera_obstacle_pipeline_->GetCalibrationService(
       &camera_frame.calibration_service);
+  *frame = &camera_frame;
+  return cyber::SUCC;
+}
 
-  if (!camera_obstacle_pipeline_->Perception(camera_perception_options_,
-                                             &camera_frame)) {
-    AERROR << "camera_obstacle_pipeline_->Perception() failed"
-           << " msg_timestamp: " << std::to_string(msg_timestamp);
-    *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
-    prefused_message->error_code_ = *error_code;
-    return cyber::FAIL;
-  }
+int FusionCameraDetectionComponent::PublishFrame(
+    const std::string &camera_name, const camera::CameraFrame &camera_frame,
+    apollo::common::ErrorCode *error_code, SensorFrameMessage *prefused_message,
+    apollo::perception::PerceptionObstacles *out_message) {
+  const double msg_timestamp = camera_frame.timestamp;
   AINFO << "##" << camera_name << ": pitch "
         << camera_frame.calibration_service->QueryPitchAngle()
         << " | camera_grond_height "
@@ -644,8 +724,9 @@ int FusionCameraDetectionComponent::InternalProc(
 
   // process success, make pb msg
   if (output_final_obstacles_ &&
-      MakeProtobufMsg(msg_timestamp, seq_num_, camera_frame.tracked_objects,
-                      *error_code, out_message) != cyber::SUCC) {
+      MakeProtobufMsg(msg_timestamp, prefused_message->seq_num_,
+                      camera_frame.tracked_objects, *error_code,
+                      out_message) != cyber::SUCC) {
     AERROR << "MakeProtobufMsg failed"
            << " ts: " << std::to_string(msg_timestamp);
     *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_UNKNOWN;
@@ -675,8 +756,8 @@ int FusionCameraDetectionComponent::InternalProc(
     camera_frame.data_provider->GetImageBlob(image_options, image_blob.get());
     std::shared_ptr<CameraPerceptionVizMessage> viz_msg(
         new (std::nothrow) CameraPerceptionVizMessage(
-            camera_name, msg_timestamp, camera2world_trans.matrix(), image_blob,
-            camera_frame.tracked_objects, camera_frame.lane_objects,
+            camera_name, msg_timestamp, camera_frame.camera2world_pose.matrix(),
+            image_blob, camera_frame.tracked_objects, camera_frame.lane_objects,
             *error_code));
     bool send_viz_ret = camera_viz_writer_->Write(viz_msg);
     AINFO << "send out camera visualization msg, ts: "
@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/component/component.h"
@@ -64,11 +65,19 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
   int InitCameraListeners();
   void SetCameraHeightAndPitch();
 
-  int InternalProc(
+  typedef std::pair<std::string, std::shared_ptr<apollo::drivers::Image>>
+      CameraImage;
+
+  void ProcessImages(const std::vector<CameraImage>& images);
+  int PrepareFrame(
       const std::shared_ptr<apollo::drivers::Image const>& in_message,
       const std::string& camera_name, apollo::common::ErrorCode* error_code,
-      SensorFrameMessage* prefused_message,
-      apollo::perception::PerceptionObstacles* out_message);
+      SensorFrameMessage* prefused_message, camera::CameraFrame** frame);
+  int PublishFrame(const std::string& camera_name,
+                   const camera::CameraFrame& camera_frame,
+                   apollo::common::ErrorCode* error_code,
+                   SensorFrameMessage* prefused_message,
+                   apollo::perception::PerceptionObstacles* out_message);
 
   int MakeProtobufMsg(double msg_timestamp, int seq_num,
                       const std::vector<base::ObjectPtr>& objects,
@@ -168,6 +177,11 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
   double last_timestamp_ = 0.0;
   double ts_diff_ = 1.0;
 
+  // images waiting for the other cameras of their batch
+  bool enable_batch_detection_ = false;
+  double batch_time_window_ = 0.02;
+  std::vector<CameraImage> pending_images_;
+
   std::shared_ptr<
       apollo::cyber::Writer<apollo::perception::PerceptionObstacles>>
       writer_;
@@ -40,6 +40,8 @@ bool FusionComponent::Init() {
   fusion_main_sensor_ = comp_config.fusion_main_sensor();
   object_in_roi_check_ = comp_config.object_in_roi_check();
   radius_for_roi_object_check_ = comp_config.radius_for_roi_object_check();
+  serializer_options_.output_polygon = comp_config.output_polygon();
+  serializer_options_.output_measurements = comp_config.output_measurements();
 
   // init algorithm plugin
   CHECK(InitAlgorithmPlugin() == true) << "Failed to init algorithm plugin.";
@@ -47,6 +49,12 @@ bool FusionComponent::Init() {
       comp_config.output_obstacles_channel_name());
   inner_writer_ = node_->CreateWriter<SensorFrameMessage>(
       comp_config.output_viz_fused_content_channel_name());
+
+  lib::Profiler::Instance()->set_enabled(FLAGS_obs_enable_profiler);
+  if (FLAGS_obs_enable_profiler) {
+    lib::Profiler::Instance()->StartPublishing(FLAGS_obs_profiler_channel,
+                                               FLAGS_obs_profiler_period_ms);
+  }
   return true;
 }
 
@@ -56,8 +64,7 @@ bool FusionComponent::Proc(const std::shared_ptr<SensorFrameMessage>& message) {
   if (message->process_stage_ == ProcessStage::SENSOR_FUSION) {
     return true;
   }
-  std::shared_ptr<PerceptionObstacles> out_message(new (std::nothrow)
-                                                       PerceptionObstacles);
+  std::shared_ptr<PerceptionObstacles> out_message = out_message_pool_.Get();
   std::shared_ptr<SensorFrameMessage> viz_message(new (std::nothrow)
                                                       SensorFrameMessage);
   bool status = InternalProc(message, out_message, viz_message);
@@ -104,13 +111,14 @@ bool FusionComponent::InternalProc(
     s_seq_num_++;
   }
 
+  PERCEPTION_PROFILE_SCOPE("fusion");
   PERCEPTION_PERF_BLOCK_START();
   const double timestamp = in_message->timestamp_;
   std::vector<base::ObjectPtr> valid_objects;
   if (in_message->error_code_ != apollo::common::ErrorCode::OK) {
     if (!MsgSerializer::SerializeMsg(timestamp, in_message->seq_num_,
                                      valid_objects, in_message->error_code_,
-                                     out_message.get())) {
+                                     serializer_options_, out_message.get())) {
       AERROR << "Failed to gen PerceptionObstacles object.";
       return false;
     }
@@ -140,14 +148,20 @@ bool FusionComponent::InternalProc(
       in_message->frame_->sensor2world_pose.matrix();
   if (object_in_roi_check_ && FLAGS_obs_enable_hdmap_input) {
     // get hdmap
-    base::HdmapStructPtr hdmap(new base::HdmapStruct());
+    base::HdmapStructPtr hdmap = nullptr;
     if (hdmap_input_) {
       base::PointD position;
       position.x = sensor2world_pose(0, 3);
       position.y = sensor2world_pose(1, 3);
       position.z = sensor2world_pose(2, 3);
-      hdmap_input_->GetRoiHDMapStruct(position, radius_for_roi_object_check_,
-                                      hdmap);
+      if (map::FLAGS_obs_share_hdmap_roi) {
+        hdmap_input_->GetSharedRoiHDMapStruct(
+            position, radius_for_roi_object_check_, &hdmap);
+      } else {
+        hdmap.reset(new base::HdmapStruct());
+        hdmap_input_->GetRoiHDMapStruct(position,
+                                        radius_for_roi_object_check_, hdmap);
+      }
       // TODO(use check)
       // ObjectInRoiSlackCheck(hdmap, fused_objects, &valid_objects);
       valid_objects.assign(fused_objects.begin(), fused_objects.end());
@@ -177,7 +191,7 @@ bool FusionComponent::InternalProc(
   apollo::common::ErrorCode error_code = apollo::common::ErrorCode::OK;
   if (!MsgSerializer::SerializeMsg(timestamp, in_message->seq_num_,
                                    valid_objects, error_code,
-                                   out_message.get())) {
+                                   serializer_options_, out_message.get())) {
     AERROR << "Failed to gen PerceptionObstacles object.";
     return false;
   }
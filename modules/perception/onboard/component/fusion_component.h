@@ -25,6 +25,7 @@
 #include "modules/perception/fusion/lib/interface/base_fusion_system.h"
 #include "modules/perception/map/hdmap/hdmap_input.h"
 #include "modules/perception/onboard/inner_component_messages/inner_component_messages.h"
+#include "modules/perception/onboard/msg_serializer/msg_serializer.h"
 #include "modules/perception/onboard/proto/fusion_component_config.pb.h"
 
 namespace apollo {
@@ -52,6 +53,8 @@ class FusionComponent : public cyber::Component<SensorFrameMessage> {
   std::string fusion_main_sensor_;
   bool object_in_roi_check_ = false;
   double radius_for_roi_object_check_ = 0;
+  MsgSerializerOptions serializer_options_;
+  MsgBufferPool<PerceptionObstacles> out_message_pool_;
 
   std::unique_ptr<fusion::ObstacleMultiSensorFusion> fusion_;
   map::HDMapInput* hdmap_input_ = nullptr;
@@ -28,7 +28,7 @@ bool LidarOutputComponent::Init() {
 
 bool LidarOutputComponent::Proc(
     const std::shared_ptr<SensorFrameMessage>& message) {
-  std::shared_ptr<PerceptionObstacles> out_message(new PerceptionObstacles);
+  std::shared_ptr<PerceptionObstacles> out_message = out_message_pool_.Get();
 
   if (message->frame_ == nullptr) {
     AERROR << "Failed to get frame in message.";
@@ -19,6 +19,7 @@
 
 #include "cyber/component/component.h"
 #include "modules/perception/onboard/inner_component_messages/inner_component_messages.h"
+#include "modules/perception/onboard/msg_serializer/msg_serializer.h"
 
 namespace apollo {
 namespace perception {
@@ -34,6 +35,7 @@ class LidarOutputComponent : public cyber::Component<SensorFrameMessage> {
 
  private:
   std::shared_ptr<apollo::cyber::Writer<PerceptionObstacles>> writer_;
+  MsgBufferPool<PerceptionObstacles> out_message_pool_;
 };  // class LidarOutputComponent
 
 CYBER_REGISTER_COMPONENT(LidarOutputComponent);
@@ -50,9 +50,13 @@ bool RadarDetectionComponent::Init() {
   CHECK(InitAlgorithmPlugin() == true) << "Failed to init algorithm plugin.";
   radar2world_trans_.Init(tf_child_frame_id_);
   radar2novatel_trans_.Init(tf_child_frame_id_);
-  localization_subscriber_.Init(
-      odometry_channel_name_,
-      odometry_channel_name_ + '_' + comp_config.radar_name());
+  if (FLAGS_obs_radar_share_context) {
+    RadarSharedContext::Instance()->Init(odometry_channel_name_);
+  } else {
+    localization_subscriber_.Init(
+        odometry_channel_name_,
+        odometry_channel_name_ + '_' + comp_config.radar_name());
+  }
   return true;
 }
 
@@ -160,10 +164,16 @@ bool RadarDetectionComponent::InternalProc(
   position.x = radar_trans(0, 3);
   position.y = radar_trans(1, 3);
   position.z = radar_trans(2, 3);
-  options.roi_filter_options.roi.reset(new base::HdmapStruct());
-  if (FLAGS_obs_enable_hdmap_input) {
-    hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
-                                    options.roi_filter_options.roi);
+  if (FLAGS_obs_enable_hdmap_input &&
+      (FLAGS_obs_radar_share_context || map::FLAGS_obs_share_hdmap_roi)) {
+    hdmap_input_->GetSharedRoiHDMapStruct(position, radar_forward_distance_,
+                                          &options.roi_filter_options.roi);
+  } else {
+    options.roi_filter_options.roi.reset(new base::HdmapStruct());
+    if (FLAGS_obs_enable_hdmap_input) {
+      hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
+                                      options.roi_filter_options.roi);
+    }
   }
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(radar_info_.name,
                                            "GetRoiHDMapStruct");
@@ -204,6 +214,10 @@ bool RadarDetectionComponent::GetCarLocalizationSpeed(
   (*car_linear_speed) = Eigen::Vector3f::Zero();
   CHECK_NOTNULL(car_angular_speed);
   (*car_angular_speed) = Eigen::Vector3f::Zero();
+  if (FLAGS_obs_radar_share_context) {
+    return RadarSharedContext::Instance()->GetCarSpeed(
+        timestamp, car_linear_speed, car_angular_speed);
+  }
   std::shared_ptr<LocalizationEstimate const> loct_ptr;
   if (!localization_subscriber_.LookupNearest(timestamp, &loct_ptr)) {
     AERROR << "Cannot get car speed.";
@@ -28,6 +28,7 @@
 #include "modules/perception/onboard/inner_component_messages/inner_component_messages.h"
 #include "modules/perception/onboard/msg_buffer/msg_buffer.h"
 #include "modules/perception/onboard/proto/radar_component_config.pb.h"
+#include "modules/perception/onboard/radar_shared_context/radar_shared_context.h"
 #include "modules/perception/onboard/transform_wrapper/transform_wrapper.h"
 #include "modules/perception/radar/app/radar_obstacle_perception.h"
 
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/onboard/component/segmentation_component.h"
 
+#include "modules/perception/base/memory_pool.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 #include "modules/perception/lib/utils/perf.h"
 #include "modules/perception/lib/utils/time_util.h"
@@ -45,6 +46,12 @@ bool SegmentationComponent::Init() {
   enable_hdmap_ = comp_config.enable_hdmap();
   writer_ = node_->CreateWriter<LidarFrameMessage>(output_channel_name_);
 
+  lib::Profiler::Instance()->set_enabled(FLAGS_obs_enable_profiler);
+  if (FLAGS_obs_enable_profiler) {
+    lib::Profiler::Instance()->StartPublishing(FLAGS_obs_profiler_channel,
+                                               FLAGS_obs_profiler_period_ms);
+  }
+
   if (!InitAlgorithmPlugin()) {
     AERROR << "Failed to init segmentation component algorithm plugin.";
     return false;
@@ -73,6 +80,7 @@ bool SegmentationComponent::InitAlgorithmPlugin() {
   CHECK(common::SensorManager::Instance()->GetSensorInfo(sensor_name_,
                                                          &sensor_info_));
 
+  base::MemoryPool::Instance().set_enabled(FLAGS_obs_enable_memory_pool);
   segmentor_.reset(new lidar::LidarObstacleSegmentation);
   if (segmentor_ == nullptr) {
     AERROR << "sensor_name_ "
@@ -88,6 +96,15 @@ bool SegmentationComponent::InitAlgorithmPlugin() {
           << "Failed to init segmentation.";
     return false;
   }
+  if (FLAGS_obs_enable_memory_pool &&
+      FLAGS_obs_memory_pool_preallocate_mb > 0) {
+    const size_t mb = 1 << 20;
+    if (!base::MemoryPool::Instance().PreallocateDevice(
+            FLAGS_obs_memory_pool_preallocate_mb * mb,
+            FLAGS_obs_memory_pool_preallocate_block_mb * mb)) {
+      AWARN << "Failed to preallocate the device memory pool.";
+    }
+  }
 
   lidar2world_trans_.Init(lidar2novatel_tf2_child_frame_id_);
   return true;
@@ -30,6 +30,17 @@ bool MsgSerializer::SerializeMsg(double timestamp, int seq_num,
                                  const std::vector<base::ObjectPtr> &objects,
                                  const apollo::common::ErrorCode &error_code,
                                  PerceptionObstacles *obstacles) {
+  return SerializeMsg(timestamp, seq_num, objects, error_code,
+                      MsgSerializerOptions(), obstacles);
+}
+
+bool MsgSerializer::SerializeMsg(double timestamp, int seq_num,
+                                 const std::vector<base::ObjectPtr> &objects,
+                                 const apollo::common::ErrorCode &error_code,
+                                 const MsgSerializerOptions &options,
+                                 PerceptionObstacles *obstacles) {
+  // cleared elements stay allocated and are handed out again by add_*()
+  obstacles->Clear();
   // double publish_time = lib::TimeUtil::GetCurrentTime();
   double publish_time = cyber::Time::Now().ToSecond();
   ::apollo::common::Header *header = obstacles->mutable_header();
@@ -44,7 +55,7 @@ bool MsgSerializer::SerializeMsg(double timestamp, int seq_num,
   obstacles->set_error_code(error_code);
   for (const auto &obj : objects) {
     PerceptionObstacle *obstacle = obstacles->add_perception_obstacle();
-    if (!ConvertObjectToPb(obj, obstacle)) {
+    if (!ConvertObjectToPb(obj, options, obstacle)) {
       AERROR << "ConvertObjectToPb failed, Object:" << obj->ToString();
       return false;
     }
@@ -53,6 +64,7 @@ bool MsgSerializer::SerializeMsg(double timestamp, int seq_num,
 }
 
 bool MsgSerializer::ConvertObjectToPb(const base::ObjectPtr &object_ptr,
+                                      const MsgSerializerOptions &options,
                                       PerceptionObstacle *pb_msg) {
   if (object_ptr == nullptr || pb_msg == nullptr) {
     return false;
@@ -80,15 +92,21 @@ bool MsgSerializer::ConvertObjectToPb(const base::ObjectPtr &object_ptr,
   pb_msg->set_width(object_ptr->size(1));
   pb_msg->set_height(object_ptr->size(2));
 
-  for (size_t i = 0; i < object_ptr->polygon.size(); ++i) {
-    auto &pt = object_ptr->polygon.at(i);
-    apollo::common::Point3D *p = pb_msg->add_polygon_point();
-    p->set_x(pt.x);
-    p->set_y(pt.y);
-    p->set_z(pt.z);
+  if (options.output_polygon) {
+    pb_msg->mutable_polygon_point()->Reserve(
+        static_cast<int>(object_ptr->polygon.size()));
+    for (size_t i = 0; i < object_ptr->polygon.size(); ++i) {
+      auto &pt = object_ptr->polygon.at(i);
+      apollo::common::Point3D *p = pb_msg->add_polygon_point();
+      p->set_x(pt.x);
+      p->set_y(pt.y);
+      p->set_z(pt.z);
+    }
   }
 
   if (FLAGS_obs_benchmark_mode) {
+    pb_msg->mutable_point_cloud()->Reserve(
+        static_cast<int>(object_ptr->lidar_supplement.cloud.size() * 3));
     for (auto &point : object_ptr->lidar_supplement.cloud.points()) {
       pb_msg->add_point_cloud(point.x);
       pb_msg->add_point_cloud(point.y);
@@ -108,6 +126,9 @@ bool MsgSerializer::ConvertObjectToPb(const base::ObjectPtr &object_ptr,
   obj_bbox2d->set_xmax(box.xmax);
   obj_bbox2d->set_ymax(box.ymax);
 
+  pb_msg->mutable_position_covariance()->Reserve(9);
+  pb_msg->mutable_velocity_covariance()->Reserve(9);
+  pb_msg->mutable_acceleration_covariance()->Reserve(9);
   for (size_t i = 0; i < 3; i++) {
     for (size_t j = 0; j < 3; j++) {
       pb_msg->add_position_covariance(object_ptr->center_uncertainty(i, j));
@@ -143,7 +164,7 @@ bool MsgSerializer::ConvertObjectToPb(const base::ObjectPtr &object_ptr,
     light_status->set_right_turn_switch_on(car_light.right_turn_switch_on);
   }
 
-  if (FLAGS_obs_save_fusion_supplement &&
+  if (options.output_measurements && FLAGS_obs_save_fusion_supplement &&
       object_ptr->fusion_supplement.on_use) {
     for (const auto &measurement : object_ptr->fusion_supplement.measurements) {
       SensorMeasurement *pb_measurement = pb_msg->add_measurements();
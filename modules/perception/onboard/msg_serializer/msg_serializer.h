@@ -15,6 +15,8 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "cyber/time/time.h"
@@ -25,21 +27,65 @@ namespace apollo {
 namespace perception {
 namespace onboard {
 
+// optional heavy fields, dropped for subscribers that do not use them
+struct MsgSerializerOptions {
+  bool output_polygon = true;
+  // also requires FLAGS_obs_save_fusion_supplement
+  bool output_measurements = true;
+};
+
 class MsgSerializer {
  public:
   MsgSerializer() = default;
   ~MsgSerializer() = default;
 
+  // @brief: clear obstacles and fill it with objects, the repeated field
+  //         storage of a reused message is kept
+  static bool SerializeMsg(double timestamp, int seq_num,
+                           const std::vector<base::ObjectPtr>& objects,
+                           const apollo::common::ErrorCode& error_code,
+                           PerceptionObstacles* obstacles);
+
   static bool SerializeMsg(double timestamp, int seq_num,
                            const std::vector<base::ObjectPtr>& objects,
                            const apollo::common::ErrorCode& error_code,
+                           const MsgSerializerOptions& options,
                            PerceptionObstacles* obstacles);
 
  private:
   static bool ConvertObjectToPb(const base::ObjectPtr& object_ptr,
+                                const MsgSerializerOptions& options,
                                 PerceptionObstacle* pb_msg);
 };
 
+// Recycles published messages once every reader has released them, so the
+// per-object sub-messages and repeated fields are allocated only once.
+template <typename MessageT>
+class MsgBufferPool {
+ public:
+  explicit MsgBufferPool(size_t capacity = 4) : capacity_(capacity) {}
+
+  // @brief: a message nobody else holds, or a new one when all are in use
+  std::shared_ptr<MessageT> Get() {
+    for (auto& message : messages_) {
+      if (message.use_count() == 1) {
+        // pairs with the release of the reader's last reference
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return message;
+      }
+    }
+    std::shared_ptr<MessageT> message(new (std::nothrow) MessageT);
+    if (message != nullptr && messages_.size() < capacity_) {
+      messages_.push_back(message);
+    }
+    return message;
+  }
+
+ private:
+  size_t capacity_;
+  std::vector<std::shared_ptr<MessageT>> messages_;
+};
+
 }  // namespace onboard
 }  // namespace perception
 }  // namespace apollo
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/onboard/radar_shared_context/radar_shared_context.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace perception {
+namespace onboard {
+
+DEFINE_bool(obs_radar_share_context, false,
+            "share car speed and hdmap roi lookups between radar components");
+DEFINE_double(obs_radar_share_window, 0.05,
+              "max time apart in seconds of radar frames sharing lookups");
+
+RadarSharedContext::RadarSharedContext() {}
+
+void RadarSharedContext::Init(const std::string& odometry_channel_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (inited_) {
+    return;
+  }
+  localization_subscriber_.Init(odometry_channel_name,
+                                odometry_channel_name + "_radar_shared");
+  inited_ = true;
+}
+
+bool RadarSharedContext::GetCarSpeed(double timestamp,
+                                     Eigen::Vector3f* car_linear_speed,
+                                     Eigen::Vector3f* car_angular_speed) {
+  CHECK_NOTNULL(car_linear_speed);
+  CHECK_NOTNULL(car_angular_speed);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (speed_timestamp_ < 0.0 ||
+      std::fabs(timestamp - speed_timestamp_) > FLAGS_obs_radar_share_window) {
+    std::shared_ptr<localization::LocalizationEstimate const> loct_ptr;
+    if (!inited_ ||
+        !localization_subscriber_.LookupNearest(timestamp, &loct_ptr)) {
+      AERROR << "Cannot get car speed.";
+      return false;
+    }
+    const auto& pose = loct_ptr->pose();
+    car_linear_speed_ << static_cast<float>(pose.linear_velocity().x()),
+        static_cast<float>(pose.linear_velocity().y()),
+        static_cast<float>(pose.linear_velocity().z());
+    car_angular_speed_ << static_cast<float>(pose.angular_velocity().x()),
+        static_cast<float>(pose.angular_velocity().y()),
+        static_cast<float>(pose.angular_velocity().z());
+    speed_timestamp_ = timestamp;
+  }
+  *car_linear_speed = car_linear_speed_;
+  *car_angular_speed = car_angular_speed_;
+  return true;
+}
+
+}  // namespace onboard
+}  // namespace perception
+}  // namespace apollo
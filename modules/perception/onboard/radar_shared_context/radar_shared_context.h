@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Eigen/Core"
+
+#include "cyber/common/macros.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/perception/onboard/msg_buffer/msg_buffer.h"
+
+namespace apollo {
+namespace perception {
+namespace onboard {
+
+DECLARE_bool(obs_radar_share_context);
+DECLARE_double(obs_radar_share_window);
+
+// Lookups shared by the radar components of one process. Frames of all
+// radars within obs_radar_share_window of each other reuse one car speed
+// lookup, instead of querying it once per radar. The hdmap roi is shared
+// by map::HDMapInput::GetSharedRoiHDMapStruct.
+class RadarSharedContext {
+ public:
+  // @brief: subscribe the odometry channel, later calls are ignored
+  void Init(const std::string& odometry_channel_name);
+
+  bool GetCarSpeed(double timestamp, Eigen::Vector3f* car_linear_speed,
+                   Eigen::Vector3f* car_angular_speed);
+
+ private:
+  std::mutex mutex_;
+  bool inited_ = false;
+  MsgBuffer<localization::LocalizationEstimate> localization_subscriber_;
+
+  double speed_timestamp_ = -1.0;
+  Eigen::Vector3f car_linear_speed_ = Eigen::Vector3f::Zero();
+  Eigen::Vector3f car_angular_speed_ = Eigen::Vector3f::Zero();
+
+  DECLARE_SINGLETON(RadarSharedContext)
+};
+
+}  // namespace onboard
+}  // namespace perception
+}  // namespace apollo
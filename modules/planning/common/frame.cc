@@ -314,6 +314,7 @@ const Obstacle *Frame::CreateStaticObstacle(
 
 const Obstacle *Frame::CreateStaticVirtualObstacle(const std::string &id,
                                                    const Box2d &box) {
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
   const auto *object = obstacles_.Find(id);
   if (object) {
     AWARN << "obstacle " << id << " already exist.";
@@ -351,7 +352,8 @@ Status Frame::Init(
 Status Frame::InitForOpenSpace() { return InitFrameData(); }
 
 Status Frame::InitFrameData() {
-  hdmap_ = hdmap::HDMapUtil::BaseMapPtr();
+  hdmap_snapshot_ = hdmap::HDMapUtil::BaseMapSnapshot();
+  hdmap_ = hdmap_snapshot_.get();
   CHECK_NOTNULL(hdmap_);
   vehicle_state_ = common::VehicleStateProvider::Instance()->vehicle_state();
   const auto &point = common::util::MakePointENU(
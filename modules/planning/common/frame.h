@@ -23,6 +23,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,6 +42,7 @@
 #include "modules/common/status/status.h"
 #include "modules/planning/common/change_lane_decider.h"
 #include "modules/planning/common/indexed_queue.h"
+#include "modules/planning/common/latency_budget.h"
 #include "modules/planning/common/local_view.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/open_space_info.h"
@@ -131,6 +133,10 @@ class Frame {
     return current_frame_planned_trajectory_;
   }
 
+  LatencyBudget *mutable_latency_budget() { return &latency_budget_; }
+
+  const LatencyBudget &latency_budget() const { return latency_budget_; }
+
   // TODO(Qi, Jinyun): check the usage in open space planner
   //                   and remove it from frame
   planning_internal::OpenSpaceDebug *mutable_open_space_debug() {
@@ -194,6 +200,8 @@ class Frame {
   uint32_t sequence_num_ = 0;
   LocalView local_view_;
   const hdmap::HDMap *hdmap_ = nullptr;
+  // keeps hdmap_ alive for the whole cycle across map reloads
+  std::shared_ptr<const hdmap::HDMap> hdmap_snapshot_;
   common::TrajectoryPoint planning_start_point_;
   common::VehicleState vehicle_state_;
   std::list<ReferenceLineInfo> reference_line_info_;
@@ -206,8 +214,11 @@ class Frame {
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
+  // reference lines planned in parallel may create the same virtual obstacle
+  std::mutex virtual_obstacle_mutex_;
   ChangeLaneDecider change_lane_decider_;
   ADCTrajectory current_frame_planned_trajectory_;  // last published trajectory
+  LatencyBudget latency_budget_;
 
   // debug info for open space planner
   planning_internal::OpenSpaceDebug open_space_debug_;
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file latency_budget.cc
+ **/
+
+#include "modules/planning/common/latency_budget.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/time/time.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::time::Clock;
+
+void LatencyBudget::Reset(const double start_timestamp,
+                          const double budget_ms) {
+  start_timestamp_ = start_timestamp;
+  budget_ms_ = budget_ms;
+  required_task_overrun_ = false;
+}
+
+double LatencyBudget::ElapsedMs() const {
+  return (Clock::NowInSeconds() - start_timestamp_) * 1000.0;
+}
+
+bool LatencyBudget::IsOverBudget() const {
+  return budget_ms_ > 0.0 && ElapsedMs() > budget_ms_;
+}
+
+bool LatencyBudget::SkipTask(const TaskConfig& config) const {
+  if (!config.is_optional() || !IsOverBudget()) {
+    return false;
+  }
+  AWARN << "Skip optional task "
+        << TaskConfig::TaskType_Name(config.task_type()) << ", "
+        << ElapsedMs() << " ms spent of " << budget_ms_ << " ms budget";
+  return true;
+}
+
+void LatencyBudget::CheckTask(const TaskConfig& config) {
+  if (config.is_optional() || !IsOverBudget()) {
+    return;
+  }
+  if (!required_task_overrun_.exchange(true)) {
+    AWARN << "Required task " << TaskConfig::TaskType_Name(config.task_type())
+          << " finished at " << ElapsedMs() << " ms, over " << budget_ms_
+          << " ms budget";
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
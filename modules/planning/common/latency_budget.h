@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file latency_budget.h
+ **/
+
+#pragma once
+
+#include <atomic>
+
+#include "modules/planning/proto/planning_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LatencyBudget
+ * @brief Time budget of one planning cycle. Optional tasks are skipped once
+ * the budget is spent; a required task finishing late marks the cycle as
+ * overrun so that the planner can fall back to the previous trajectory.
+ */
+class LatencyBudget {
+ public:
+  LatencyBudget() = default;
+
+  /**
+   * @brief start a cycle at start_timestamp (seconds), a non positive
+   * budget_ms disables the budget.
+   */
+  void Reset(const double start_timestamp, const double budget_ms);
+
+  double ElapsedMs() const;
+
+  bool IsOverBudget() const;
+
+  /**
+   * @brief true if the task is optional and the budget is already spent.
+   */
+  bool SkipTask(const TaskConfig& config) const;
+
+  /**
+   * @brief called after a task finished, records a required task overrun.
+   */
+  void CheckTask(const TaskConfig& config);
+
+  bool required_task_overrun() const { return required_task_overrun_; }
+
+ private:
+  double start_timestamp_ = 0.0;
+  double budget_ms_ = 0.0;
+  std::atomic<bool> required_task_overrun_{false};
+};
+
+}  // namespace planning
+}  // namespace apollo
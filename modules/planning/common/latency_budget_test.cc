@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/latency_budget.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/time/time.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::time::Clock;
+
+class LatencyBudgetTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    clock_mode_ = Clock::mode();
+    Clock::SetMode(Clock::MOCK);
+    Clock::SetNowInSeconds(100.0);
+    optional_task_.set_task_type(TaskConfig::SPEED_DECIDER);
+    optional_task_.set_is_optional(true);
+    required_task_.set_task_type(TaskConfig::PATH_BOUND_DECIDER);
+  }
+
+  virtual void TearDown() { Clock::SetMode(clock_mode_); }
+
+ protected:
+  Clock::ClockMode clock_mode_;
+  TaskConfig optional_task_;
+  TaskConfig required_task_;
+};
+
+TEST_F(LatencyBudgetTest, Disabled) {
+  LatencyBudget budget;
+  budget.Reset(100.0, 0.0);
+  Clock::SetNowInSeconds(101.0);
+  EXPECT_FALSE(budget.IsOverBudget());
+  EXPECT_FALSE(budget.SkipTask(optional_task_));
+  budget.CheckTask(required_task_);
+  EXPECT_FALSE(budget.required_task_overrun());
+}
+
+TEST_F(LatencyBudgetTest, WithinBudget) {
+  LatencyBudget budget;
+  budget.Reset(100.0, 80.0);
+  Clock::SetNowInSeconds(100.05);
+  EXPECT_NEAR(budget.ElapsedMs(), 50.0, 1e-6);
+  EXPECT_FALSE(budget.IsOverBudget());
+  EXPECT_FALSE(budget.SkipTask(optional_task_));
+  budget.CheckTask(required_task_);
+  EXPECT_FALSE(budget.required_task_overrun());
+}
+
+TEST_F(LatencyBudgetTest, OverBudget) {
+  LatencyBudget budget;
+  budget.Reset(100.0, 80.0);
+  Clock::SetNowInSeconds(100.09);
+  EXPECT_TRUE(budget.IsOverBudget());
+  EXPECT_TRUE(budget.SkipTask(optional_task_));
+  EXPECT_FALSE(budget.SkipTask(required_task_));
+
+  budget.CheckTask(optional_task_);
+  EXPECT_FALSE(budget.required_task_overrun());
+  budget.CheckTask(required_task_);
+  EXPECT_TRUE(budget.required_task_overrun());
+
+  budget.Reset(100.09, 80.0);
+  EXPECT_FALSE(budget.required_task_overrun());
+  EXPECT_FALSE(budget.SkipTask(optional_task_));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -52,6 +52,31 @@ PathPoint DiscretizedPath::Evaluate(const double path_s) const {
                                                            *it_lower, path_s);
 }
 
+std::vector<PathPoint> DiscretizedPath::Evaluate(
+    const std::vector<double> &path_s) const {
+  CHECK(!empty());
+  std::vector<PathPoint> path_points;
+  path_points.reserve(path_s.size());
+  auto it_lower = begin();
+  for (const double s : path_s) {
+    if (it_lower != begin() && (it_lower - 1)->s() >= s) {
+      it_lower = QueryLowerBound(s);
+    }
+    while (it_lower != end() && it_lower->s() < s) {
+      ++it_lower;
+    }
+    if (it_lower == begin()) {
+      path_points.push_back(front());
+    } else if (it_lower == end()) {
+      path_points.push_back(back());
+    } else {
+      path_points.push_back(common::math::InterpolateUsingLinearApproximation(
+          *(it_lower - 1), *it_lower, s));
+    }
+  }
+  return path_points;
+}
+
 std::vector<PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
     const double path_s) const {
   auto func = [](const PathPoint &tp, const double path_s) {
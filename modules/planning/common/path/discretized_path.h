@@ -37,6 +37,13 @@ class DiscretizedPath : public std::vector<common::PathPoint> {
 
   common::PathPoint Evaluate(const double path_s) const;
 
+  /**
+   * @brief same as Evaluate() for every s. Increasing s are evaluated in one
+   * linear pass over the path, other orders fall back to binary search.
+   */
+  std::vector<common::PathPoint> Evaluate(
+      const std::vector<double>& path_s) const;
+
  protected:
   std::vector<common::PathPoint>::const_iterator QueryLowerBound(
       const double path_s) const;
@@ -68,5 +68,27 @@ TEST(DiscretizedPathTest, basic_test) {
   EXPECT_EQ(discretized_path.size(), 0);
 }
 
+TEST(DiscretizedPathTest, batch_evaluate) {
+  std::vector<PathPoint> path_points;
+  for (int i = 0; i < 10; ++i) {
+    PathPoint p = MakePathPoint(i * 1.0, i * 0.5, 0.0, 0.0, 0.0, 0.0, 0.0);
+    p.set_s(i * 1.0);
+    path_points.push_back(p);
+  }
+  DiscretizedPath discretized_path(path_points);
+
+  // increasing, repeated, decreasing and out of range queries
+  const std::vector<double> path_s{-1.0, 0.0, 0.3, 0.3, 2.5, 4.0,
+                                   1.2,  8.9, 9.0, 12.0, 3.7};
+  const auto batch_points = discretized_path.Evaluate(path_s);
+  ASSERT_EQ(batch_points.size(), path_s.size());
+  for (size_t i = 0; i < path_s.size(); ++i) {
+    const auto point = discretized_path.Evaluate(path_s[i]);
+    EXPECT_DOUBLE_EQ(batch_points[i].s(), point.s());
+    EXPECT_DOUBLE_EQ(batch_points[i].x(), point.x());
+    EXPECT_DOUBLE_EQ(batch_points[i].y(), point.y());
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
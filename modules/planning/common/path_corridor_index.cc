@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/path_corridor_index.h"
+
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::math::AABoxKDTree2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::Box2d;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+PathCorridorIndex::PathCorridorIndex(const std::vector<PathPoint>& path_points,
+                                     const double start_s, const double end_s,
+                                     const double half_width) {
+  constexpr double kMinSegmentLength = 1e-3;
+  for (size_t i = 0; i + 1 < path_points.size(); ++i) {
+    const auto& p0 = path_points[i];
+    const auto& p1 = path_points[i + 1];
+    if (p1.s() < start_s || p0.s() > end_s) {
+      continue;
+    }
+    const LineSegment2d segment({p0.x(), p0.y()}, {p1.x(), p1.y()});
+    if (segment.length() < kMinSegmentLength) {
+      continue;
+    }
+    // extend each segment by half_width at both ends as well, so that the
+    // boxes still cover the outer side of a bend.
+    const Vec2d extension = segment.unit_direction() * half_width;
+    segment_boxes_.emplace_back(
+        LineSegment2d(segment.start() - extension, segment.end() + extension),
+        2.0 * half_width);
+  }
+  if (segment_boxes_.empty()) {
+    return;
+  }
+
+  segment_aaboxes_.reserve(segment_boxes_.size());
+  for (size_t i = 0; i < segment_boxes_.size(); ++i) {
+    segment_aaboxes_.emplace_back(i, segment_boxes_[i]);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 4;
+  segment_tree_.reset(
+      new AABoxKDTree2d<SegmentBox>(segment_aaboxes_, params));
+}
+
+bool PathCorridorIndex::MayOverlap(const Box2d& box) const {
+  if (segment_tree_ == nullptr) {
+    // nothing to filter with.
+    return true;
+  }
+  // any point shared by the two boxes is within half the box diagonal of
+  // its center, so segments farther away than that can not overlap.
+  constexpr double kRadiusBuffer = 1e-6;
+  const auto candidates = segment_tree_->GetObjects(
+      box.center(), box.diagonal() / 2.0 + kRadiusBuffer);
+  for (const auto* candidate : candidates) {
+    if (box.HasOverlap(segment_boxes_[candidate->index()])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace planning
+}  // namespace apollo
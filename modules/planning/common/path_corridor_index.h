@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/proto/pnc_point.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PathCorridorIndex
+ * @brief Kd-tree over the boxes of a path corridor. It is meant to be built
+ * once per cycle and used to drop (predicted) obstacle boxes that can not
+ * reach the corridor before any exact projection or overlap test is done.
+ */
+class PathCorridorIndex {
+ public:
+  /**
+   * @brief Indexes the path segments overlapping [start_s, end_s], each one
+   * widened by half_width on both sides.
+   */
+  PathCorridorIndex(const std::vector<common::PathPoint>& path_points,
+                    const double start_s, const double end_s,
+                    const double half_width);
+
+  /**
+   * @brief Returns false only if box is guaranteed to be out of the corridor.
+   */
+  bool MayOverlap(const common::math::Box2d& box) const;
+
+  size_t num_segments() const { return segment_boxes_.size(); }
+
+ private:
+  class SegmentBox {
+   public:
+    SegmentBox(const size_t index, const common::math::Box2d& box)
+        : index_(index), aabox_(box.GetAABox()) {}
+    const common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return aabox_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = aabox_.DistanceTo(point);
+      return distance * distance;
+    }
+    size_t index() const { return index_; }
+
+   private:
+    size_t index_ = 0;
+    common::math::AABox2d aabox_;
+  };
+
+  std::vector<common::math::Box2d> segment_boxes_;
+  std::vector<SegmentBox> segment_aaboxes_;
+  std::unique_ptr<common::math::AABoxKDTree2d<SegmentBox>> segment_tree_;
+};
+
+}  // namespace planning
+}  // namespace apollo
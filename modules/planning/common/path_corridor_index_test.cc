@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/path_corridor_index.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::math::Box2d;
+
+namespace {
+
+// Straight path along x from 0 to 50 meters.
+std::vector<PathPoint> MakeStraightPath() {
+  std::vector<PathPoint> path_points;
+  for (int i = 0; i <= 50; ++i) {
+    PathPoint point;
+    point.set_x(static_cast<double>(i));
+    point.set_y(0.0);
+    point.set_s(static_cast<double>(i));
+    path_points.push_back(point);
+  }
+  return path_points;
+}
+
+}  // namespace
+
+TEST(PathCorridorIndexTest, MayOverlap) {
+  const PathCorridorIndex index(MakeStraightPath(), 10.0, 30.0, 2.0);
+  // the segments ending at s = 10 and starting at s = 30 are included.
+  EXPECT_EQ(22, index.num_segments());
+
+  // on the path, inside the s range.
+  EXPECT_TRUE(index.MayOverlap(Box2d({20.0, 0.0}, 0.0, 4.0, 2.0)));
+  // touches the corridor edge from the side.
+  EXPECT_TRUE(index.MayOverlap(Box2d({20.0, 2.5}, 0.0, 4.0, 1.2)));
+  // beside the corridor.
+  EXPECT_FALSE(index.MayOverlap(Box2d({20.0, 4.0}, 0.0, 4.0, 2.0)));
+  // on the path, but out of the s range.
+  EXPECT_FALSE(index.MayOverlap(Box2d({40.0, 0.0}, 0.0, 4.0, 2.0)));
+  EXPECT_FALSE(index.MayOverlap(Box2d({3.0, 0.0}, 0.0, 4.0, 2.0)));
+  // a long box crossing the corridor diagonally.
+  EXPECT_TRUE(index.MayOverlap(Box2d({20.0, 10.0}, 1.2, 30.0, 1.0)));
+}
+
+TEST(PathCorridorIndexTest, EmptyPath) {
+  const PathCorridorIndex index(std::vector<PathPoint>(), 0.0, 10.0, 2.0);
+  EXPECT_EQ(0, index.num_segments());
+  EXPECT_TRUE(index.MayOverlap(Box2d({100.0, 100.0}, 0.0, 1.0, 1.0)));
+}
+
+}  // namespace planning
+}  // namespace apollo
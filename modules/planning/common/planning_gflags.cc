@@ -23,6 +23,10 @@ DEFINE_double(test_duration, -1.0,
               "the value is not positive");
 
 DEFINE_int32(planning_loop_rate, 10, "Loop rate for planning node");
+DEFINE_double(planning_time_budget_ms, 0.0,
+              "Time budget of one planning cycle. Optional tasks are skipped "
+              "after it is spent and a required task overrun reuses the "
+              "previous trajectory. Not positive to disable");
 
 // TODO(all) enable this when perception issue is fixed.
 DEFINE_bool(enable_collision_detection, false,
@@ -114,6 +118,9 @@ DEFINE_double(reference_line_lateral_buffer, 0.5,
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
+DEFINE_int32(reference_line_smoothing_cache_size, 4,
+             "Number of smoothed route segments kept for reuse when the same "
+             "segments are smoothed again, 0 to disable the cache");
 
 DEFINE_bool(prioritize_change_lane, false,
             "change lane strategy has higher priority, always use a valid "
@@ -304,11 +311,15 @@ DEFINE_uint32(max_planning_thread_pool_size, 15,
               "num of thread used in planning thread pool.");
 DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
+DEFINE_bool(enable_parallel_traffic_rules, false,
+            "Run the prepare steps of the traffic rules in parallel.");
 DEFINE_bool(
     enable_multi_thread_in_dp_poly_path, false,
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Run the lane follow tasks of all reference lines in parallel.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -369,6 +380,15 @@ DEFINE_double(polynomial_minimal_param, 0.01,
               "Minimal time parameter in polynomials.");
 DEFINE_double(lattice_stop_buffer, 0.02,
               "The buffer before the stop s to check trajectories.");
+DEFINE_bool(enable_lattice_lazy_evaluation, true,
+            "Rank lattice trajectory pairs by their longitudinal cost and "
+            "evaluate the lateral cost only for pairs reaching the top.");
+DEFINE_int32(lattice_evaluation_batch_size, 1,
+             "Number of lattice trajectory pairs lazily evaluated together, "
+             "in parallel if larger than 1.");
+DEFINE_int32(lattice_validation_batch_size, 1,
+             "Number of lattice trajectory pairs checked for constraints and "
+             "collisions together, in parallel if larger than 1.");
 
 DEFINE_bool(lateral_optimization, true,
             "whether using optimization for lateral trajectory generation");
@@ -452,10 +472,18 @@ DEFINE_bool(use_osqp_optimizer_for_reference_line, true,
             "Use OSQP optimizer for reference line optimization.");
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
+DEFINE_bool(enable_fem_qp_warm_start, true,
+            "Keep the OSQP workspace of Fem1dQpProblem across cycles.");
+DEFINE_bool(enable_osqp_spline_workspace_reuse, true,
+            "Keep the OSQP workspace of the spline solvers across cycles "
+            "while the problem sparsity does not change.");
 
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
             "True to enable record debug info in chart format");
+DEFINE_int32(record_debug_cycle_interval, 1,
+             "With enable_record_debug, record the debug info of one planning "
+             "cycle out of every this many cycles.");
 
 DEFINE_double(
     default_front_clear_distance, 300.0,
@@ -497,4 +525,7 @@ DEFINE_bool(enable_parallel_hybrid_a, false,
             "True to enable hybrid a* parallel implementation.");
 DEFINE_bool(enable_parallel_open_space_smoother, false,
             "True to enable open space smoother parallel implementation.");
+DEFINE_bool(enable_parallel_trajectory_smoothing, false,
+            "True to smooth each gear partition of the open space warm start "
+            "trajectory as a separate problem.");
 DEFINE_bool(enable_cuda, false, "True to enable cuda parallel implementation.");
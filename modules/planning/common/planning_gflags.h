@@ -43,6 +43,7 @@ DECLARE_string(traffic_rule_config_filename);
 DECLARE_string(smoother_config_filename);
 DECLARE_string(reopt_smoother_config_filename);
 DECLARE_int32(planning_loop_rate);
+DECLARE_double(planning_time_budget_ms);
 DECLARE_bool(enable_collision_detection);
 DECLARE_string(rtk_trajectory_filename);
 DECLARE_uint64(rtk_trajectory_forward);
@@ -53,6 +54,7 @@ DECLARE_double(reference_line_stitch_overlap_distance);
 DECLARE_double(reference_line_lateral_buffer);
 
 DECLARE_bool(enable_smooth_reference_line);
+DECLARE_int32(reference_line_smoothing_cache_size);
 
 DECLARE_bool(prioritize_change_lane);
 DECLARE_bool(reckless_change_lane);
@@ -152,8 +154,10 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_uint32(max_planning_thread_pool_size);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
+DECLARE_bool(enable_parallel_traffic_rules);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_parallel_reference_line_planning);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
@@ -202,6 +206,9 @@ DECLARE_double(time_min_density);
 DECLARE_double(comfort_acceleration_factor);
 DECLARE_double(polynomial_minimal_param);
 DECLARE_double(lattice_stop_buffer);
+DECLARE_bool(enable_lattice_lazy_evaluation);
+DECLARE_int32(lattice_evaluation_batch_size);
+DECLARE_int32(lattice_validation_batch_size);
 DECLARE_double(max_s_lateral_optimization);
 DECLARE_double(default_delta_s_lateral_optimization);
 DECLARE_double(bound_buffer);
@@ -232,8 +239,11 @@ DECLARE_bool(use_gear_shift_trajectory);
 DECLARE_bool(use_osqp_optimizer_for_qp_st);
 DECLARE_bool(use_osqp_optimizer_for_reference_line);
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_fem_qp_warm_start);
+DECLARE_bool(enable_osqp_spline_workspace_reuse);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
+DECLARE_int32(record_debug_cycle_interval);
 
 DECLARE_double(default_front_clear_distance);
 
@@ -256,4 +266,5 @@ DECLARE_double(side_pass_driving_width_l_buffer);
 
 DECLARE_bool(enable_parallel_hybrid_a);
 DECLARE_bool(enable_parallel_open_space_smoother);
+DECLARE_bool(enable_parallel_trajectory_smoothing);
 DECLARE_bool(enable_cuda);
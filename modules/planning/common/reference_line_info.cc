@@ -21,6 +21,7 @@
 #include "modules/planning/common/reference_line_info.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "cyber/task/task.h"
 #include "modules/planning/proto/sl_boundary.pb.h"
@@ -363,16 +364,15 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
   if (FLAGS_use_multi_thread_to_add_obstacles) {
-    std::vector<std::future<Obstacle*>> results;
-    for (const auto* obstacle : obstacles) {
-      results.push_back(
-          cyber::Async(&ReferenceLineInfo::AddObstacle, this, obstacle));
-    }
-    for (auto& result : results) {
-      if (!result.get()) {
-        AERROR << "Fail to add obstacles.";
-        return false;
+    std::atomic<bool> succeeded(true);
+    cyber::ParallelFor(0, obstacles.size(), 4, [&](size_t i) {
+      if (!AddObstacle(obstacles[i])) {
+        succeeded = false;
       }
+    });
+    if (!succeeded) {
+      AERROR << "Fail to add obstacles.";
+      return false;
     }
   } else {
     for (const auto* obstacle : obstacles) {
@@ -457,31 +457,38 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     AWARN << "path data is empty";
     return false;
   }
+  std::vector<double> relative_times;
   for (double cur_rel_time = 0.0; cur_rel_time < speed_data_.TotalTime();
        cur_rel_time += (cur_rel_time < kDenseTimeSec ? kDenseTimeResoltuion
                                                      : kSparseTimeResolution)) {
-    common::SpeedPoint speed_point;
-    if (!speed_data_.EvaluateByTime(cur_rel_time, &speed_point)) {
-      AERROR << "Fail to get speed point with relative time " << cur_rel_time;
-      return false;
-    }
+    relative_times.push_back(cur_rel_time);
+  }
+  std::vector<common::SpeedPoint> speed_points;
+  if (!speed_data_.EvaluateByTime(relative_times, &speed_points)) {
+    AERROR << "Fail to get speed points with relative time up to "
+           << speed_data_.TotalTime();
+    return false;
+  }
 
-    if (speed_point.s() > path_data_.discretized_path().Length()) {
+  const double path_length = path_data_.discretized_path().Length();
+  std::vector<double> path_s;
+  path_s.reserve(speed_points.size());
+  for (const auto& speed_point : speed_points) {
+    if (speed_point.s() > path_length) {
       break;
     }
-    common::PathPoint path_point;
-    if (!path_data_.GetPathPointWithPathS(speed_point.s(), &path_point)) {
-      AERROR << "Fail to get path data with s " << speed_point.s()
-             << "path total length " << path_data_.discretized_path().Length();
-      return false;
-    }
-    path_point.set_s(path_point.s() + start_s);
+    path_s.push_back(speed_point.s());
+  }
+  const auto path_points = path_data_.discretized_path().Evaluate(path_s);
 
+  for (size_t i = 0; i < path_points.size(); ++i) {
     common::TrajectoryPoint trajectory_point;
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(speed_point.v());
-    trajectory_point.set_a(speed_point.a());
-    trajectory_point.set_relative_time(speed_point.t() + relative_time);
+    auto* path_point = trajectory_point.mutable_path_point();
+    path_point->CopyFrom(path_points[i]);
+    path_point->set_s(path_point->s() + start_s);
+    trajectory_point.set_v(speed_points[i].v());
+    trajectory_point.set_a(speed_points[i].a());
+    trajectory_point.set_relative_time(speed_points[i].t() + relative_time);
     ptr_discretized_trajectory->AppendTrajectoryPoint(trajectory_point);
   }
   return true;
@@ -49,6 +49,38 @@ void SpeedData::AppendSpeedPoint(const double s, const double time,
   push_back(common::util::MakeSpeedPoint(s, time, v, a, da));
 }
 
+namespace {
+
+SpeedPoint InterpolateByTime(const SpeedPoint& p0, const SpeedPoint& p1,
+                             const double t) {
+  double t0 = p0.t();
+  double t1 = p1.t();
+
+  common::SpeedPoint res;
+  res.set_t(t);
+
+  double s = common::math::lerp(p0.s(), t0, p1.s(), t1, t);
+  res.set_s(s);
+
+  if (p0.has_v() && p1.has_v()) {
+    double v = common::math::lerp(p0.v(), t0, p1.v(), t1, t);
+    res.set_v(v);
+  }
+
+  if (p0.has_a() && p1.has_a()) {
+    double a = common::math::lerp(p0.a(), t0, p1.a(), t1, t);
+    res.set_a(a);
+  }
+
+  if (p0.has_da() && p1.has_da()) {
+    double da = common::math::lerp(p0.da(), t0, p1.da(), t1, t);
+    res.set_da(da);
+  }
+  return res;
+}
+
+}  // namespace
+
 bool SpeedData::EvaluateByTime(const double t,
                                common::SpeedPoint* const speed_point) const {
   if (size() < 2) {
@@ -68,33 +100,41 @@ bool SpeedData::EvaluateByTime(const double t,
   } else if (it_lower == begin()) {
     *speed_point = front();
   } else {
-    const auto& p0 = *(it_lower - 1);
-    const auto& p1 = *it_lower;
-    double t0 = p0.t();
-    double t1 = p1.t();
-
-    common::SpeedPoint res;
-    res.set_t(t);
-
-    double s = common::math::lerp(p0.s(), t0, p1.s(), t1, t);
-    res.set_s(s);
+    *speed_point = InterpolateByTime(*(it_lower - 1), *it_lower, t);
+  }
+  return true;
+}
 
-    if (p0.has_v() && p1.has_v()) {
-      double v = common::math::lerp(p0.v(), t0, p1.v(), t1, t);
-      res.set_v(v);
+bool SpeedData::EvaluateByTime(
+    const std::vector<double>& times,
+    std::vector<common::SpeedPoint>* const speed_points) const {
+  CHECK_NOTNULL(speed_points);
+  speed_points->clear();
+  if (size() < 2) {
+    return false;
+  }
+  speed_points->reserve(times.size());
+  auto comp = [](const common::SpeedPoint& sp, const double t) {
+    return sp.t() < t;
+  };
+  auto it_lower = begin();
+  for (const double t : times) {
+    if (!(front().t() < t + 1.0e-6 && t - 1.0e-6 < back().t())) {
+      return false;
     }
-
-    if (p0.has_a() && p1.has_a()) {
-      double a = common::math::lerp(p0.a(), t0, p1.a(), t1, t);
-      res.set_a(a);
+    if (it_lower != begin() && (it_lower - 1)->t() >= t) {
+      it_lower = std::lower_bound(begin(), end(), t, comp);
     }
-
-    if (p0.has_da() && p1.has_da()) {
-      double da = common::math::lerp(p0.da(), t0, p1.da(), t1, t);
-      res.set_da(da);
+    while (it_lower != end() && it_lower->t() < t) {
+      ++it_lower;
+    }
+    if (it_lower == end()) {
+      speed_points->push_back(back());
+    } else if (it_lower == begin()) {
+      speed_points->push_back(front());
+    } else {
+      speed_points->push_back(InterpolateByTime(*(it_lower - 1), *it_lower, t));
     }
-
-    *speed_point = res;
   }
   return true;
 }
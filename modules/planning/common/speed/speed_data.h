@@ -39,6 +39,14 @@ class SpeedData : public std::vector<common::SpeedPoint> {
   bool EvaluateByTime(const double time,
                       common::SpeedPoint* const speed_point) const;
 
+  /**
+   * @brief same as EvaluateByTime() for every time, fails if any time is out
+   * of range. Increasing times are evaluated in one linear pass.
+   */
+  bool EvaluateByTime(
+      const std::vector<double>& times,
+      std::vector<common::SpeedPoint>* const speed_points) const;
+
   double TotalTime() const;
 
   virtual std::string DebugString() const;
@@ -62,6 +62,35 @@ TrajectoryPoint DiscretizedTrajectory::Evaluate(
       *(it_lower - 1), *it_lower, relative_time);
 }
 
+std::vector<TrajectoryPoint> DiscretizedTrajectory::Evaluate(
+    const std::vector<double>& relative_times) const {
+  CHECK(!empty());
+  std::vector<TrajectoryPoint> trajectory_points;
+  trajectory_points.reserve(relative_times.size());
+  auto it_lower = begin();
+  for (const double relative_time : relative_times) {
+    if (it_lower != begin() &&
+        (it_lower - 1)->relative_time() >= relative_time) {
+      it_lower = begin() + QueryLowerBoundPoint(relative_time);
+    }
+    while (it_lower != end() && it_lower->relative_time() < relative_time) {
+      ++it_lower;
+    }
+    if (it_lower == begin()) {
+      trajectory_points.push_back(front());
+    } else if (it_lower == end()) {
+      AWARN << "When evaluate trajectory, relative_time(" << relative_time
+            << ") is too large";
+      trajectory_points.push_back(back());
+    } else {
+      trajectory_points.push_back(
+          common::math::InterpolateUsingLinearApproximation(
+              *(it_lower - 1), *it_lower, relative_time));
+    }
+  }
+  return trajectory_points;
+}
+
 size_t DiscretizedTrajectory::QueryLowerBoundPoint(
     const double relative_time) const {
   CHECK(!empty());
@@ -55,6 +55,13 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
 
   virtual common::TrajectoryPoint Evaluate(const double relative_time) const;
 
+  /**
+   * @brief same as Evaluate() for every relative time. Increasing times are
+   * evaluated in one linear pass, other orders fall back to binary search.
+   */
+  std::vector<common::TrajectoryPoint> Evaluate(
+      const std::vector<double>& relative_times) const;
+
   virtual size_t QueryLowerBoundPoint(const double relative_time) const;
 
   virtual size_t QueryNearestPoint(const common::math::Vec2d& position) const;
@@ -52,5 +52,30 @@ TEST(basic_test, DiscretizedTrajectory) {
   EXPECT_EQ(discretized_trajectory.NumOfPoints(), 121);
 }
 
+TEST(basic_test, BatchEvaluate) {
+  const std::string path_of_standard_trajectory =
+      "modules/planning/testdata/trajectory_data/standard_trajectory.pb.txt";
+  ADCTrajectory trajectory;
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(path_of_standard_trajectory,
+                                              &trajectory));
+  DiscretizedTrajectory discretized_trajectory(trajectory);
+
+  std::vector<double> relative_times;
+  for (double t = -1.0; t < 9.0; t += 0.05) {
+    relative_times.push_back(t);
+  }
+  relative_times.push_back(2.12);
+  relative_times.push_back(4.0);
+  const auto points = discretized_trajectory.Evaluate(relative_times);
+  ASSERT_EQ(points.size(), relative_times.size());
+  for (size_t i = 0; i < relative_times.size(); ++i) {
+    const auto p = discretized_trajectory.Evaluate(relative_times[i]);
+    EXPECT_DOUBLE_EQ(points[i].relative_time(), p.relative_time());
+    EXPECT_DOUBLE_EQ(points[i].path_point().x(), p.path_point().x());
+    EXPECT_DOUBLE_EQ(points[i].path_point().y(), p.path_point().y());
+    EXPECT_DOUBLE_EQ(points[i].v(), p.v());
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
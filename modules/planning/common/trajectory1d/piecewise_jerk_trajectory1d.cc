@@ -70,6 +70,46 @@ double PiecewiseJerkTrajectory1d::Evaluate(const std::uint32_t order,
   return segments_[index - 1].Evaluate(order, param - param_[index - 1]);
 }
 
+void PiecewiseJerkTrajectory1d::EvaluateBatch(
+    const std::uint32_t order_mask, const std::vector<double>& params,
+    std::array<std::vector<double>, 4>* const values) const {
+  for (size_t order = 0; order < values->size(); ++order) {
+    if ((order_mask & (1u << order)) != 0) {
+      (*values)[order].resize(params.size());
+    }
+  }
+
+  // Sampled params are usually increasing, so the segment is found by
+  // walking forward from the previous one instead of a search per point.
+  auto it_lower = param_.begin();
+  const int last_segment = static_cast<int>(segments_.size()) - 1;
+  for (size_t i = 0; i < params.size(); ++i) {
+    const double param = params[i];
+    CHECK_GE(param, -FLAGS_lattice_epsilon);
+    if (i > 0 && param < params[i - 1]) {
+      it_lower = std::lower_bound(param_.begin(), param_.end(), param);
+    } else {
+      while (it_lower != param_.end() && *it_lower < param) {
+        ++it_lower;
+      }
+    }
+
+    // Same segment choice as Evaluate.
+    const int index = std::max(
+        0, std::min(last_segment,
+                    static_cast<int>(std::distance(param_.begin(), it_lower)) -
+                        1));
+    const auto& segment = segments_[index];
+    const double relative_param = param - param_[index];
+    for (size_t order = 0; order < values->size(); ++order) {
+      if ((order_mask & (1u << order)) != 0) {
+        (*values)[order][i] = segment.Evaluate(
+            static_cast<std::uint32_t>(order), relative_param);
+      }
+    }
+  }
+}
+
 double PiecewiseJerkTrajectory1d::ParamLength() const { return param_.back(); }
 
 std::string PiecewiseJerkTrajectory1d::ToString() const { return ""; }
@@ -37,6 +37,10 @@ class PiecewiseJerkTrajectory1d : public Curve1d {
 
   double Evaluate(const std::uint32_t order, const double param) const;
 
+  void EvaluateBatch(
+      const std::uint32_t order_mask, const std::vector<double>& params,
+      std::array<std::vector<double>, 4>* const values) const override;
+
   double ParamLength() const;
 
   std::string ToString() const;
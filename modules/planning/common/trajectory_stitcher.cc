@@ -216,6 +216,32 @@ std::vector<TrajectoryPoint> TrajectoryStitcher::ComputeStitchingTrajectory(
   return stitching_trajectory;
 }
 
+std::vector<TrajectoryPoint> TrajectoryStitcher::ComputeReusedTrajectory(
+    const double current_timestamp,
+    const std::vector<TrajectoryPoint>& stitching_trajectory,
+    const PublishableTrajectory& prev_trajectory) {
+  if (stitching_trajectory.size() < 2 || prev_trajectory.empty()) {
+    return std::vector<TrajectoryPoint>();
+  }
+  // stitching points are copies of previous points shifted by dt
+  constexpr double kTimeEpsilon = 1e-6;
+  const double dt = prev_trajectory.header_time() - current_timestamp;
+  const size_t start_index = prev_trajectory.QueryLowerBoundPoint(
+      stitching_trajectory.front().relative_time() - dt - kTimeEpsilon);
+  const size_t zero_index = prev_trajectory.QueryLowerBoundPoint(
+      stitching_trajectory.back().relative_time() - dt - kTimeEpsilon);
+  const double zero_s =
+      prev_trajectory.TrajectoryPointAt(zero_index).path_point().s();
+
+  std::vector<TrajectoryPoint> reused_trajectory(
+      prev_trajectory.begin() + start_index, prev_trajectory.end());
+  for (auto& tp : reused_trajectory) {
+    tp.set_relative_time(tp.relative_time() + dt);
+    tp.mutable_path_point()->set_s(tp.path_point().s() - zero_s);
+  }
+  return reused_trajectory;
+}
+
 std::pair<double, double> TrajectoryStitcher::ComputePositionProjection(
     const double x, const double y, const TrajectoryPoint& p) {
   Vec2d v(x - p.path_point().x(), y - p.path_point().y());
@@ -46,6 +46,16 @@ class TrajectoryStitcher {
       const double planning_cycle_time,
       const PublishableTrajectory* prev_trajectory, std::string* replan_reason);
 
+  /**
+   * @brief the previous trajectory from the first stitching point on, in the
+   * time and s frame of the current stitching trajectory. Used to keep the
+   * previous plan when the current cycle runs over its time budget.
+   */
+  static std::vector<common::TrajectoryPoint> ComputeReusedTrajectory(
+      const double current_timestamp,
+      const std::vector<common::TrajectoryPoint>& stitching_trajectory,
+      const PublishableTrajectory& prev_trajectory);
+
  private:
   static std::pair<double, double> ComputePositionProjection(
       const double x, const double y,
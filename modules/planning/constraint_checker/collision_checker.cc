@@ -35,6 +35,7 @@ namespace planning {
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
 using apollo::common::math::Box2d;
+using apollo::common::math::Box2dBatch;
 using apollo::common::math::PathMatcher;
 using apollo::common::math::Vec2d;
 
@@ -83,7 +84,7 @@ bool CollisionChecker::InCollision(
 }
 
 bool CollisionChecker::InCollision(
-    const DiscretizedTrajectory& discretized_trajectory) {
+    const DiscretizedTrajectory& discretized_trajectory) const {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
            predicted_bounding_rectangles_.size());
   const auto& vehicle_config =
@@ -104,10 +105,8 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (predicted_bounding_rectangles_[i].HasOverlapAny(ego_box)) {
+      return true;
     }
   }
   return false;
@@ -139,7 +138,7 @@ void CollisionChecker::BuildPredictedEnvironment(
 
   double relative_time = 0.0;
   while (relative_time < FLAGS_trajectory_time_length) {
-    std::vector<Box2d> predicted_env;
+    Box2dBatch predicted_env;
     for (const Obstacle* obstacle : obstacles_considered) {
       // If an obstacle has no trajectory, it is considered as static.
       // Obstacle::GetPointAtTime has handled this case.
@@ -147,7 +146,7 @@ void CollisionChecker::BuildPredictedEnvironment(
       Box2d box = obstacle->GetBoundingBox(point);
       box.LongitudinalExtend(2.0 * FLAGS_lon_collision_buffer);
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
-      predicted_env.push_back(std::move(box));
+      predicted_env.Add(box);
     }
     predicted_bounding_rectangles_.push_back(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/common/math/box2d.h"
+#include "modules/common/math/box2d_batch.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
@@ -41,7 +42,8 @@ class CollisionChecker {
       const ReferenceLineInfo* ptr_reference_line_info,
       const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph);
 
-  bool InCollision(const DiscretizedTrajectory& discretized_trajectory);
+  // thread safe, candidate trajectories may be checked concurrently
+  bool InCollision(const DiscretizedTrajectory& discretized_trajectory) const;
 
   static bool InCollision(const std::vector<const Obstacle*>& obstacles,
                           const DiscretizedTrajectory& ego_trajectory,
@@ -64,7 +66,9 @@ class CollisionChecker {
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  // the predicted obstacle boxes at each time step, each step is culled by
+  // the bounding box of all of its boxes first
+  std::vector<common::math::Box2dBatch> predicted_bounding_rectangles_;
 };
 
 }  // namespace planning
@@ -0,0 +1,273 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Replays recorded planning inputs into OnLanePlanning::RunOnce without the
+ * component and timer layer, and reports cycle and task latency, heap
+ * allocations and peak memory.
+ **/
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/init.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/record/record_viewer.h"
+#include "gflags/gflags.h"
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/string_util.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/map/pnc_map/pnc_map.h"
+#include "modules/perception/proto/traffic_light_detection.pb.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/on_lane_planning.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+DEFINE_string(benchmark_records, "",
+              "comma separated cyber records to replay, in time order");
+DEFINE_string(benchmark_output_file, "",
+              "csv file for the results, printed only if empty");
+DEFINE_int32(benchmark_warmup_cycles, 5,
+             "leading cycles that are run but not measured");
+
+namespace {
+
+// heap allocations of the whole process, read around every cycle
+std::atomic<uint64_t> allocation_count = {0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+using apollo::canbus::Chassis;
+using apollo::common::time::Clock;
+using apollo::cyber::record::RecordMessage;
+using apollo::cyber::record::RecordReader;
+using apollo::cyber::record::RecordViewer;
+using apollo::localization::LocalizationEstimate;
+using apollo::perception::TrafficLightDetection;
+using apollo::prediction::PredictionObstacles;
+using apollo::routing::RoutingResponse;
+
+namespace {
+
+struct Samples {
+  std::vector<double> values;
+
+  // nearest rank on the sorted values
+  double Percentile(double p) const {
+    if (values.empty()) {
+      return 0.0;
+    }
+    std::vector<double> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size()));
+    return sorted[std::min(rank, sorted.size() - 1)];
+  }
+  double Max() const {
+    return values.empty() ? 0.0
+                          : *std::max_element(values.begin(), values.end());
+  }
+};
+
+class PlanningBenchmark {
+ public:
+  bool Init() {
+    PlanningConfig config;
+    if (!cyber::common::GetProtoFromFile(FLAGS_planning_config_file,
+                                         &config)) {
+      AERROR << "failed to load planning config file "
+             << FLAGS_planning_config_file;
+      return false;
+    }
+    Clock::SetMode(Clock::MOCK);
+    planning_.reset(new OnLanePlanning());
+    return planning_->Init(config).ok();
+  }
+
+  bool Replay(const std::vector<std::string>& files) {
+    std::vector<RecordViewer::RecordReaderPtr> readers;
+    for (const auto& file : files) {
+      auto reader = std::make_shared<RecordReader>(file);
+      if (!reader->IsValid()) {
+        AERROR << "failed to open record " << file;
+        return false;
+      }
+      readers.push_back(reader);
+    }
+    const std::set<std::string> channels = {
+        FLAGS_prediction_topic, FLAGS_chassis_topic, FLAGS_localization_topic,
+        FLAGS_routing_response_topic, FLAGS_traffic_light_detection_topic};
+    RecordViewer viewer(readers, 0, UINT64_MAX, channels);
+    for (const RecordMessage& message : viewer) {
+      if (message.channel_name == FLAGS_prediction_topic) {
+        auto prediction = std::make_shared<PredictionObstacles>();
+        if (prediction->ParseFromString(message.content)) {
+          RunCycle(prediction);
+        }
+      } else if (message.channel_name == FLAGS_chassis_topic) {
+        Parse(message, &local_view_.chassis);
+      } else if (message.channel_name == FLAGS_localization_topic) {
+        Parse(message, &local_view_.localization_estimate);
+      } else if (message.channel_name == FLAGS_routing_response_topic) {
+        Parse(message, &routing_);
+      } else if (message.channel_name ==
+                 FLAGS_traffic_light_detection_topic) {
+        Parse(message, &local_view_.traffic_light);
+      }
+    }
+    AINFO << "replayed " << cycles_ << " planning cycles";
+    return cycles_ > FLAGS_benchmark_warmup_cycles;
+  }
+
+  // name,count,p50_ms,p99_ms,max_ms rows for the cycle, every task and the
+  // allocations per cycle, then the peak resident memory
+  void Report() const {
+    std::ostringstream out;
+    out << "name,count,p50,p99,max\n";
+    WriteRow("cycle_ms", cycle_ms_, &out);
+    for (const auto& task : task_ms_) {
+      WriteRow("task_ms:" + task.first, task.second, &out);
+    }
+    WriteRow("allocations", allocations_, &out);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    out << "peak_rss_kb,1," << usage.ru_maxrss << "," << usage.ru_maxrss
+        << "," << usage.ru_maxrss << "\n";
+
+    AINFO << "planning benchmark\n" << out.str();
+    if (!FLAGS_benchmark_output_file.empty()) {
+      std::ofstream file(FLAGS_benchmark_output_file);
+      file << out.str();
+    }
+  }
+
+ private:
+  template <typename T>
+  static void Parse(const RecordMessage& message, std::shared_ptr<T>* msg) {
+    auto parsed = std::make_shared<T>();
+    if (parsed->ParseFromString(message.content)) {
+      *msg = parsed;
+    } else {
+      AERROR << "failed to parse message on " << message.channel_name;
+    }
+  }
+
+  static void WriteRow(const std::string& name, const Samples& samples,
+                       std::ostringstream* out) {
+    *out << name << "," << samples.values.size() << ","
+         << samples.Percentile(0.5) << "," << samples.Percentile(0.99) << ","
+         << samples.Max() << "\n";
+  }
+
+  void RunCycle(const std::shared_ptr<PredictionObstacles>& prediction) {
+    if (local_view_.chassis == nullptr ||
+        local_view_.localization_estimate == nullptr || routing_ == nullptr) {
+      return;
+    }
+    local_view_.prediction_obstacles = prediction;
+    local_view_.is_new_routing =
+        local_view_.routing == nullptr ||
+        hdmap::PncMap::IsNewRouting(*local_view_.routing, *routing_);
+    local_view_.routing = routing_;
+    Clock::SetNowInSeconds(
+        local_view_.localization_estimate->header().timestamp_sec());
+
+    ADCTrajectory trajectory;
+    const uint64_t allocations_before = allocation_count.load();
+    const auto start = std::chrono::steady_clock::now();
+    planning_->RunOnce(local_view_, &trajectory);
+    const auto end = std::chrono::steady_clock::now();
+    const uint64_t allocations = allocation_count.load() - allocations_before;
+
+    if (++cycles_ <= FLAGS_benchmark_warmup_cycles) {
+      return;
+    }
+    cycle_ms_.values.push_back(
+        std::chrono::duration<double, std::milli>(end - start).count());
+    allocations_.values.push_back(static_cast<double>(allocations));
+    for (const auto& task : trajectory.latency_stats().task_stats()) {
+      task_ms_[task.name()].values.push_back(task.time_ms());
+    }
+  }
+
+  std::unique_ptr<OnLanePlanning> planning_;
+  LocalView local_view_;
+  std::shared_ptr<RoutingResponse> routing_;
+  int cycles_ = 0;
+  Samples cycle_ms_;
+  Samples allocations_;
+  std::map<std::string, Samples> task_ms_;
+};
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  std::vector<std::string> files;
+  apollo::common::util::Split(FLAGS_benchmark_records, ',', &files);
+  if (files.empty()) {
+    AERROR << "requires --benchmark_records";
+    return EXIT_FAILURE;
+  }
+  apollo::planning::PlanningBenchmark benchmark;
+  if (!benchmark.Init() || !benchmark.Replay(files)) {
+    return EXIT_FAILURE;
+  }
+  benchmark.Report();
+  return EXIT_SUCCESS;
+}
@@ -55,6 +55,25 @@ PathTimeGraph::PathTimeGraph(
   ptr_reference_line_info_ = ptr_reference_line_info;
   init_d_ = init_d;
 
+  // Widest lane in the path range, plus a buffer for the projection error of
+  // box corners near bends.
+  constexpr double kCorridorBuffer = 1.0;
+  double half_width = FLAGS_default_reference_line_width * 0.5;
+  for (const auto& ref_point : discretized_ref_points) {
+    if (ref_point.s() < s_start || ref_point.s() > s_end) {
+      continue;
+    }
+    double left_width = 0.0;
+    double right_width = 0.0;
+    if (ptr_reference_line_info_->reference_line().GetLaneWidth(
+            ref_point.s(), &left_width, &right_width)) {
+      half_width = std::max({half_width, left_width, right_width});
+    }
+  }
+  corridor_index_.reset(new PathCorridorIndex(discretized_ref_points, s_start,
+                                              s_end,
+                                              half_width + kCorridorBuffer));
+
   SetupObstacles(obstacles, discretized_ref_points);
 }
 
@@ -114,6 +133,10 @@ void PathTimeGraph::SetStaticObstacle(
   const Polygon2d& polygon = obstacle->PerceptionPolygon();
 
   std::string obstacle_id = obstacle->Id();
+  if (!corridor_index_->MayOverlap(Box2d(polygon.AABoundingBox()))) {
+    ADEBUG << "Obstacle [" << obstacle_id << "] is out of range.";
+    return;
+  }
   SLBoundary sl_boundary =
       ComputeObstacleBoundary(polygon.GetAllVertices(), discretized_ref_points);
 
@@ -153,19 +176,24 @@ void PathTimeGraph::SetDynamicObstacle(
   while (relative_time < time_range_.second) {
     TrajectoryPoint point = obstacle->GetPointAtTime(relative_time);
     Box2d box = obstacle->GetBoundingBox(point);
-    SLBoundary sl_boundary =
-        ComputeObstacleBoundary(box.GetAllCorners(), discretized_ref_points);
-
-    double left_width = FLAGS_default_reference_line_width * 0.5;
-    double right_width = FLAGS_default_reference_line_width * 0.5;
-    ptr_reference_line_info_->reference_line().GetLaneWidth(
-        sl_boundary.start_s(), &left_width, &right_width);
+    SLBoundary sl_boundary;
+    bool out_of_range = !corridor_index_->MayOverlap(box);
+    if (!out_of_range) {
+      sl_boundary =
+          ComputeObstacleBoundary(box.GetAllCorners(), discretized_ref_points);
+
+      double left_width = FLAGS_default_reference_line_width * 0.5;
+      double right_width = FLAGS_default_reference_line_width * 0.5;
+      ptr_reference_line_info_->reference_line().GetLaneWidth(
+          sl_boundary.start_s(), &left_width, &right_width);
+      out_of_range = sl_boundary.start_s() > path_range_.second ||
+                     sl_boundary.end_s() < path_range_.first ||
+                     sl_boundary.start_l() > left_width ||
+                     sl_boundary.end_l() < -right_width;
+    }
 
     // the obstacle is not shown on the region to be considered.
-    if (sl_boundary.start_s() > path_range_.second ||
-        sl_boundary.end_s() < path_range_.first ||
-        sl_boundary.start_l() > left_width ||
-        sl_boundary.end_l() < -right_width) {
+    if (out_of_range) {
       if (path_time_obstacle_map_.find(obstacle->Id()) !=
           path_time_obstacle_map_.end()) {
         break;
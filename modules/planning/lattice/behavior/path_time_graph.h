@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -30,6 +31,7 @@
 #include "modules/common/math/polygon2d.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path_corridor_index.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/reference_line/reference_line.h"
 
@@ -102,6 +104,9 @@ class PathTimeGraph {
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::array<double, 3> init_d_;
 
+  // Boxes out of this corridor are out of range without being projected.
+  std::unique_ptr<PathCorridorIndex> corridor_index_;
+
   std::unordered_map<std::string, STBoundary> path_time_obstacle_map_;
   std::vector<STBoundary> path_time_obstacles_;
   std::vector<SLBoundary> static_obs_sl_boundaries_;
@@ -20,6 +20,8 @@
 
 #include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -57,6 +59,39 @@ double LatticeTrajectory1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void LatticeTrajectory1d::EvaluateBatch(
+    const std::uint32_t order_mask, const std::vector<double>& params,
+    std::array<std::vector<double>, 4>* const values) const {
+  ptr_trajectory1d_->EvaluateBatch(order_mask, params, values);
+
+  double param_length = ptr_trajectory1d_->ParamLength();
+  if (std::all_of(params.begin(), params.end(),
+                  [param_length](const double param) {
+                    return param < param_length;
+                  })) {
+    return;
+  }
+
+  // do constant acceleration extrapolation past the param length,
+  // the same as Evaluate.
+  double p = ptr_trajectory1d_->Evaluate(0, param_length);
+  double v = ptr_trajectory1d_->Evaluate(1, param_length);
+  double a = ptr_trajectory1d_->Evaluate(2, param_length);
+  for (size_t i = 0; i < params.size(); ++i) {
+    if (params[i] < param_length) {
+      continue;
+    }
+    double t = params[i] - param_length;
+    std::array<double, 4> extrapolated = {
+        {p + v * t + 0.5 * a * t * t, v + a * t, a, 0.0}};
+    for (size_t order = 0; order < values->size(); ++order) {
+      if ((order_mask & (1u << order)) != 0) {
+        (*values)[order][i] = extrapolated[order];
+      }
+    }
+  }
+}
+
 double LatticeTrajectory1d::ParamLength() const {
   return ptr_trajectory1d_->ParamLength();
 }
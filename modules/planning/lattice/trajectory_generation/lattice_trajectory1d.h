@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/curve1d.h"
 
@@ -36,6 +38,10 @@ class LatticeTrajectory1d : public Curve1d {
 
   virtual double Evaluate(const std::uint32_t order, const double param) const;
 
+  void EvaluateBatch(
+      const std::uint32_t order_mask, const std::vector<double>& params,
+      std::array<std::vector<double>, 4>* const values) const override;
+
   virtual double ParamLength() const;
 
   virtual std::string ToString() const;
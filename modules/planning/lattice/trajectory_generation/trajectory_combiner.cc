@@ -17,6 +17,8 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 
 #include <algorithm>
+#include <array>
+#include <vector>
 
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
@@ -40,32 +42,53 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
   double accumulated_trajectory_s = 0.0;
   PathPoint prev_trajectory_point;
 
+  std::vector<double> t_params;
+  for (double t_param = 0.0; t_param < FLAGS_trajectory_time_length;
+       t_param += FLAGS_trajectory_time_resolution) {
+    t_params.push_back(t_param);
+  }
+
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about t_param > lon_trajectory.ParamLength() situation
+  std::array<std::vector<double>, 4> lon_values;
+  lon_trajectory.EvaluateBatch(0b111, t_params, &lon_values);
+
+  // Keep s non-decreasing and stop at the end of the reference line.
   double last_s = -FLAGS_lattice_epsilon;
-  double t_param = 0.0;
-  while (t_param < FLAGS_trajectory_time_length) {
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about t_param > lon_trajectory.ParamLength() situation
-    double s = lon_trajectory.Evaluate(0, t_param);
+  std::vector<double> s_params;
+  std::vector<double> relative_s_params;
+  for (size_t i = 0; i < t_params.size(); ++i) {
+    double s = lon_values[0][i];
     if (last_s > 0.0) {
       s = std::max(last_s, s);
     }
     last_s = s;
-
-    double s_dot =
-        std::max(FLAGS_lattice_epsilon, lon_trajectory.Evaluate(1, t_param));
-    double s_ddot = lon_trajectory.Evaluate(2, t_param);
     if (s > s_ref_max) {
       break;
     }
+    s_params.push_back(s);
+    relative_s_params.push_back(s - s0);
+  }
 
-    double relative_s = s - s0;
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about s_param > lat_trajectory.ParamLength() situation
-    double d = lat_trajectory.Evaluate(0, relative_s);
-    double d_prime = lat_trajectory.Evaluate(1, relative_s);
-    double d_pprime = lat_trajectory.Evaluate(2, relative_s);
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about s_param > lat_trajectory.ParamLength() situation
+  std::array<std::vector<double>, 4> lat_values;
+  lat_trajectory.EvaluateBatch(0b111, relative_s_params, &lat_values);
 
-    PathPoint matched_ref_point = PathMatcher::MatchToPath(reference_line, s);
+  // s is non-decreasing, so the reference points are matched in one pass.
+  std::vector<PathPoint> matched_ref_points =
+      PathMatcher::MatchToPath(reference_line, s_params);
+
+  for (size_t i = 0; i < relative_s_params.size(); ++i) {
+    double t_param = t_params[i];
+    double s_dot = std::max(FLAGS_lattice_epsilon, lon_values[1][i]);
+    double s_ddot = lon_values[2][i];
+
+    double d = lat_values[0][i];
+    double d_prime = lat_values[1][i];
+    double d_pprime = lat_values[2][i];
+
+    const PathPoint& matched_ref_point = matched_ref_points[i];
 
     double x = 0.0;
     double y = 0.0;
@@ -106,8 +129,6 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
 
     combined_trajectory.AppendTrajectoryPoint(trajectory_point);
 
-    t_param = t_param + FLAGS_trajectory_time_resolution;
-
     prev_trajectory_point = trajectory_point.path_point();
   }
   return combined_trajectory;
@@ -21,9 +21,12 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
+#include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -64,16 +67,30 @@ TrajectoryEvaluator::TrajectoryEvaluator(
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
-  for (const auto& lon_trajectory : lon_trajectories) {
+  // the lon. trajectories are checked and evaluated in parallel, the pairs
+  // are queued in their order
+  std::vector<uint8_t> lon_valid(lon_trajectories.size(), 0);
+  std::vector<double> lon_costs(lon_trajectories.size(), 0.0);
+  cyber::ParallelFor(0, lon_trajectories.size(), 4, [&](size_t i) {
+    const auto& lon_trajectory = lon_trajectories[i];
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
         lon_end_s + FLAGS_lattice_stop_buffer > stop_point) {
-      continue;
+      return;
     }
 
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
+      return;
+    }
+    lon_costs[i] = EvaluateLon(planning_target, lon_trajectory);
+    lon_valid[i] = 1;
+  });
+  for (size_t i = 0; i < lon_trajectories.size(); ++i) {
+    if (!lon_valid[i]) {
       continue;
     }
+    const auto& lon_trajectory = lon_trajectories[i];
+    const double lon_cost = lon_costs[i];
     for (const auto& lat_trajectory : lat_trajectories) {
       /**
        * The validity of the code needs to be verified.
@@ -82,12 +99,43 @@ TrajectoryEvaluator::TrajectoryEvaluator(
         continue;
       }
       */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+      PairCandidate candidate;
+      candidate.pair = Trajectory1dPair(lon_trajectory, lat_trajectory);
+      candidate.cost = lon_cost;
+      if (!FLAGS_enable_lattice_lazy_evaluation) {
+        candidate.cost += EvaluateLat(lon_trajectory, lat_trajectory);
+        candidate.evaluated = true;
+      }
+      cost_queue_.push(std::move(candidate));
     }
   }
   ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
+  EvaluateTopPairs();
+}
+
+void TrajectoryEvaluator::EvaluateTopPairs() {
+  const size_t batch_size =
+      static_cast<size_t>(std::max(FLAGS_lattice_evaluation_batch_size, 1));
+  std::vector<PairCandidate> batch;
+  while (!cost_queue_.empty() && !cost_queue_.top().evaluated) {
+    batch.clear();
+    while (batch.size() < batch_size && !cost_queue_.empty() &&
+           !cost_queue_.top().evaluated) {
+      batch.push_back(cost_queue_.top());
+      cost_queue_.pop();
+    }
+    if (batch.size() > 1) {
+      cyber::ParallelFor(0, batch.size(), 1, [&](size_t i) {
+        batch[i].cost += EvaluateLat(batch[i].pair.first, batch[i].pair.second);
+      });
+    } else {
+      batch[0].cost += EvaluateLat(batch[0].pair.first, batch[0].pair.second);
+    }
+    for (auto& candidate : batch) {
+      candidate.evaluated = true;
+      cost_queue_.push(std::move(candidate));
+    }
+  }
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
@@ -103,11 +151,12 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   CHECK(has_more_trajectory_pairs() == true);
   auto top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  EvaluateTopPairs();
+  return top.pair;
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().cost;
 }
 
 double TrajectoryEvaluator::Evaluate(
@@ -121,8 +170,14 @@ double TrajectoryEvaluator::Evaluate(
   // 3. Cost of logitudinal collision
   // 4. Cost of lateral offsets
   // 5. Cost of lateral comfort
+  return EvaluateLon(planning_target, lon_trajectory, cost_components) +
+         EvaluateLat(lon_trajectory, lat_trajectory, cost_components);
+}
 
-  // Longitudinal costs
+double TrajectoryEvaluator::EvaluateLon(
+    const PlanningTarget& planning_target,
+    const PtrTrajectory1d& lon_trajectory,
+    std::vector<double>* cost_components) const {
   double lon_objective_cost =
       LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
 
@@ -132,6 +187,22 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
+  if (cost_components != nullptr) {
+    cost_components->emplace_back(lon_objective_cost);
+    cost_components->emplace_back(lon_jerk_cost);
+    cost_components->emplace_back(lon_collision_cost);
+  }
+
+  return lon_objective_cost * FLAGS_weight_lon_objective +
+         lon_jerk_cost * FLAGS_weight_lon_jerk +
+         lon_collision_cost * FLAGS_weight_lon_collision +
+         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+}
+
+double TrajectoryEvaluator::EvaluateLat(
+    const PtrTrajectory1d& lon_trajectory,
+    const PtrTrajectory1d& lat_trajectory,
+    std::vector<double>* cost_components) const {
   // decides the longitudinal evaluation horizon for lateral trajectories.
   double evaluation_horizon =
       std::min(FLAGS_decision_horizon,
@@ -142,23 +213,15 @@ double TrajectoryEvaluator::Evaluate(
     s_values.emplace_back(s);
   }
 
-  // Lateral costs
   double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
 
   double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
 
   if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
     cost_components->emplace_back(lat_offset_cost);
   }
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
+  return lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
@@ -185,16 +248,27 @@ double TrajectoryEvaluator::LatOffsetCost(
 double TrajectoryEvaluator::LatComfortCost(
     const PtrTrajectory1d& lon_trajectory,
     const PtrTrajectory1d& lat_trajectory) const {
-  double max_cost = 0.0;
+  std::vector<double> t_params;
   for (double t = 0.0; t < FLAGS_trajectory_time_length;
        t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
+    t_params.push_back(t);
+  }
+  std::array<std::vector<double>, 4> lon_values;
+  lon_trajectory->EvaluateBatch(0b111, t_params, &lon_values);
 
-    double relative_s = s - init_s_[0];
-    double l_prime = lat_trajectory->Evaluate(1, relative_s);
-    double l_primeprime = lat_trajectory->Evaluate(2, relative_s);
+  std::vector<double> relative_s_params(t_params.size());
+  for (size_t i = 0; i < t_params.size(); ++i) {
+    relative_s_params[i] = lon_values[0][i] - init_s_[0];
+  }
+  std::array<std::vector<double>, 4> lat_values;
+  lat_trajectory->EvaluateBatch(0b110, relative_s_params, &lat_values);
+
+  double max_cost = 0.0;
+  for (size_t i = 0; i < t_params.size(); ++i) {
+    double s_dot = lon_values[1][i];
+    double s_dotdot = lon_values[2][i];
+    double l_prime = lat_values[1][i];
+    double l_primeprime = lat_values[2][i];
     double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
     max_cost = std::max(max_cost, std::fabs(cost));
   }
@@ -205,9 +279,14 @@ double TrajectoryEvaluator::LonComfortCost(
     const PtrTrajectory1d& lon_trajectory) const {
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
+  std::vector<double> t_params;
   for (double t = 0.0; t < FLAGS_trajectory_time_length;
        t += FLAGS_trajectory_time_resolution) {
-    double jerk = lon_trajectory->Evaluate(3, t);
+    t_params.push_back(t);
+  }
+  std::array<std::vector<double>, 4> lon_values;
+  lon_trajectory->EvaluateBatch(0b1000, t_params, &lon_values);
+  for (const double jerk : lon_values[3]) {
     double cost = jerk / FLAGS_longitudinal_jerk_upper_bound;
     cost_sqr_sum += cost * cost;
     cost_abs_sum += std::fabs(cost);
@@ -274,11 +353,18 @@ double TrajectoryEvaluator::CentripetalAccelerationCost(
   // Assumes the vehicle is not obviously deviate from the reference line.
   double centripetal_acc_sum = 0.0;
   double centripetal_acc_sqr_sum = 0.0;
+  std::vector<double> t_params;
   for (double t = 0.0; t < FLAGS_trajectory_time_length;
        t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double v = lon_trajectory->Evaluate(1, t);
-    PathPoint ref_point = PathMatcher::MatchToPath(*reference_line_, s);
+    t_params.push_back(t);
+  }
+  std::array<std::vector<double>, 4> lon_values;
+  lon_trajectory->EvaluateBatch(0b11, t_params, &lon_values);
+  std::vector<PathPoint> ref_points =
+      PathMatcher::MatchToPath(*reference_line_, lon_values[0]);
+  for (size_t i = 0; i < t_params.size(); ++i) {
+    double v = lon_values[1][i];
+    const PathPoint& ref_point = ref_points[i];
     CHECK(ref_point.has_kappa());
     double centripetal_acc = v * v * ref_point.kappa();
     centripetal_acc_sum += std::fabs(centripetal_acc);
@@ -74,6 +74,21 @@ class TrajectoryEvaluator {
                   const std::shared_ptr<Curve1d>& lat_trajectory,
                   std::vector<double>* cost_components = nullptr) const;
 
+  // weighted costs that only depend on the longitudinal trajectory
+  double EvaluateLon(const PlanningTarget& planning_target,
+                     const std::shared_ptr<Curve1d>& lon_trajectory,
+                     std::vector<double>* cost_components = nullptr) const;
+
+  // weighted costs that depend on the lateral trajectory
+  double EvaluateLat(const std::shared_ptr<Curve1d>& lon_trajectory,
+                     const std::shared_ptr<Curve1d>& lat_trajectory,
+                     std::vector<double>* cost_components = nullptr) const;
+
+  // Completes the lateral cost of the top pairs until the top pair is fully
+  // evaluated. Since all lateral costs are non-negative, a partially
+  // evaluated pair ranks no later than it would with its full cost.
+  void EvaluateTopPairs();
+
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
                        const std::vector<double>& s_values) const;
 
@@ -98,14 +113,24 @@ class TrajectoryEvaluator {
       const std::vector<apollo::common::SpeedPoint>& st_points, double t,
       double* traj_s) const;
 
-  struct CostComparator
-      : public std::binary_function<const PairCost&, const PairCost&, bool> {
-    bool operator()(const PairCost& left, const PairCost& right) const {
-      return left.second > right.second;
+  struct PairCandidate {
+    std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>> pair;
+    // full cost, or the longitudinal cost if not evaluated yet
+    double cost = 0.0;
+    bool evaluated = false;
+  };
+
+  struct CostComparator : public std::binary_function<const PairCandidate&,
+                                                      const PairCandidate&,
+                                                      bool> {
+    bool operator()(const PairCandidate& left,
+                    const PairCandidate& right) const {
+      return left.cost > right.cost;
     }
   };
 
-  std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
+  std::priority_queue<PairCandidate, std::vector<PairCandidate>,
+                      CostComparator>
       cost_queue_;
 
   std::shared_ptr<PathTimeGraph> path_time_graph_;
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -49,6 +50,12 @@ class CubicPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  void EvaluateBatch(
+      const std::uint32_t order_mask, const std::vector<double>& params,
+      std::array<std::vector<double>, 4>* const values) const override {
+    HornerEvaluateBatch(coef_, order_mask, params, values);
+  }
+
   double ParamLength() const override { return param_; }
   std::string ToString() const override;
 
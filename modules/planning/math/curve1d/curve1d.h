@@ -20,7 +20,10 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace planning {
@@ -36,6 +39,26 @@ class Curve1d {
   virtual double Evaluate(const std::uint32_t order,
                           const double param) const = 0;
 
+  /**
+   * @brief Evaluates the curve at every param for each order k (k <= 3)
+   * whose bit (1 << k) is set in order_mask, and stores the results in
+   * (*values)[k]. Override it to avoid a virtual call per point.
+   */
+  virtual void EvaluateBatch(
+      const std::uint32_t order_mask, const std::vector<double>& params,
+      std::array<std::vector<double>, 4>* const values) const {
+    for (std::uint32_t order = 0; order < values->size(); ++order) {
+      if ((order_mask & (1u << order)) == 0) {
+        continue;
+      }
+      auto& order_values = (*values)[order];
+      order_values.resize(params.size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        order_values[i] = Evaluate(order, params[i]);
+      }
+    }
+  }
+
   virtual double ParamLength() const = 0;
 
   virtual std::string ToString() const = 0;
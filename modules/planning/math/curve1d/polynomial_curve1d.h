@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -34,6 +37,43 @@ class PolynomialCurve1d : public Curve1d {
   virtual size_t Order() const = 0;
 
  protected:
+  /**
+   * @brief Batched evaluation of f = sum(coef[i] * x^i) with Horner's scheme.
+   * Every order has a fixed degree loop over contiguous params, so the
+   * compiler vectorizes it across points.
+   */
+  template <size_t N>
+  static void HornerEvaluateBatch(
+      const std::array<double, N>& coef, const std::uint32_t order_mask,
+      const std::vector<double>& params,
+      std::array<std::vector<double>, 4>* const values) {
+    std::array<double, N> derivative_coef = coef;
+    for (size_t order = 0; order < values->size(); ++order) {
+      if (order > 0) {
+        // Differentiate: d_k[i] = (i + 1) * d_{k-1}[i + 1].
+        for (size_t i = 0; i + 1 < N; ++i) {
+          derivative_coef[i] =
+              static_cast<double>(i + 1) * derivative_coef[i + 1];
+        }
+        derivative_coef[N - 1] = 0.0;
+      }
+      if ((order_mask & (1u << order)) == 0) {
+        continue;
+      }
+      auto& order_values = (*values)[order];
+      order_values.resize(params.size());
+      const double* const p = params.data();
+      double* const f = order_values.data();
+      for (size_t j = 0; j < params.size(); ++j) {
+        double value = derivative_coef[N - 1];
+        for (size_t i = N - 1; i > 0; --i) {
+          value = value * p[j] + derivative_coef[i - 1];
+        }
+        f[j] = value;
+      }
+    }
+  }
+
   double param_ = 0.0;
 };
 
@@ -16,6 +16,8 @@
 
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
@@ -70,5 +72,32 @@ TEST(QuinticPolynomialCurve1dTest, IntegratedFromQuarticCurve) {
                 quintic_curve.Evaluate(4, value), 1e-8);
   }
 }
+
+TEST(QuinticPolynomialCurve1dTest, EvaluateBatch) {
+  QuinticPolynomialCurve1d quintic_curve(0.0, 1.0, 0.8, 10.0, 5.0, 0.0, 8.0);
+  QuarticPolynomialCurve1d quartic_curve(2, 1, 4, 3, 2, 4);
+  std::vector<double> params;
+  for (double value = 0.0; value < 8.1; value += 0.1) {
+    params.push_back(value);
+  }
+
+  std::array<std::vector<double>, 4> quintic_values;
+  quintic_curve.EvaluateBatch(0b1111, params, &quintic_values);
+  std::array<std::vector<double>, 4> quartic_values;
+  quartic_curve.EvaluateBatch(0b1010, params, &quartic_values);
+  EXPECT_TRUE(quartic_values[0].empty());
+  EXPECT_TRUE(quartic_values[2].empty());
+  for (size_t i = 0; i < params.size(); ++i) {
+    for (std::uint32_t order = 0; order < 4; ++order) {
+      EXPECT_NEAR(quintic_curve.Evaluate(order, params[i]),
+                  quintic_values[order][i], 1e-8);
+    }
+    EXPECT_NEAR(quartic_curve.Evaluate(1, params[i]), quartic_values[1][i],
+                1e-8);
+    EXPECT_NEAR(quartic_curve.Evaluate(3, params[i]), quartic_values[3][i],
+                1e-8);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -61,6 +61,20 @@ Fem1dQpProblem::Fem1dQpProblem(const size_t num_of_knots,
                      std::make_pair(-kMaxVariableRange, kMaxVariableRange));
 }
 
+Fem1dQpProblem::~Fem1dQpProblem() { CleanUpWorkspace(); }
+
+void Fem1dQpProblem::CleanUpWorkspace() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+}
+
+void Fem1dQpProblem::SetWarmStartOffset(const double offset) {
+  warm_start_shift_ =
+      offset > 0.0 ? static_cast<size_t>(offset / delta_s_ + 0.5) : 0;
+}
+
 bool Fem1dQpProblem::OptimizeWithOsqp(
     const size_t kernel_dim, const size_t num_affine_constraint,
     std::vector<c_float>& P_data, std::vector<c_int>& P_indices,    // NOLINT
@@ -255,16 +269,31 @@ bool Fem1dQpProblem::Optimize() {
   diff = end_time3 - end_time2;
   ADEBUG << "CalculateOffset used time: " << diff.count() * 1000 << " ms.";
 
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  OSQPWorkspace* work = nullptr;
-
-  OptimizeWithOsqp(3 * num_of_knots_, lower_bounds.size(), P_data, P_indices,
-                   P_indptr, A_data, A_indices, A_indptr, lower_bounds,
-                   upper_bounds, q, data, &work, settings);
-  if (work == nullptr || work->solution == nullptr) {
+  if (!UpdateWorkspace(P_data, P_indices, P_indptr, A_data, A_indices,
+                       A_indptr, lower_bounds, upper_bounds, q)) {
+    CleanUpWorkspace();
+    OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+    OSQPSettings* settings =
+        reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
+    OptimizeWithOsqp(3 * num_of_knots_, lower_bounds.size(), P_data,
+                     P_indices, P_indptr, A_data, A_indices, A_indptr,
+                     lower_bounds, upper_bounds, q, data, &work_, settings);
+    // the workspace holds its own copy of the problem
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    c_free(settings);
+    P_data_ = P_data;
+    P_indices_ = P_indices;
+    P_indptr_ = P_indptr;
+    A_data_ = A_data;
+    A_indices_ = A_indices;
+    A_indptr_ = A_indptr;
+  }
+  warm_start_shift_ = 0;
+  if (work_ == nullptr || work_->solution == nullptr) {
     AERROR << "Failed to find QP solution.";
+    CleanUpWorkspace();
     return false;
   }
 
@@ -273,19 +302,13 @@ bool Fem1dQpProblem::Optimize() {
   dx_.resize(num_of_knots_);
   ddx_.resize(num_of_knots_);
   for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = work->solution->x[i];
-    dx_.at(i) = work->solution->x[i + num_of_knots_];
-    ddx_.at(i) = work->solution->x[i + 2 * num_of_knots_];
+    x_.at(i) = work_->solution->x[i];
+    dx_.at(i) = work_->solution->x[i + num_of_knots_];
+    ddx_.at(i) = work_->solution->x[i + 2 * num_of_knots_];
   }
   dx_.back() = 0.0;
   ddx_.back() = 0.0;
 
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
   auto end_time4 = std::chrono::system_clock::now();
   diff = end_time4 - end_time3;
   ADEBUG << "Run OptimizeWithOsqp used time: " << diff.count() * 1000 << " ms.";
@@ -293,6 +316,71 @@ bool Fem1dQpProblem::Optimize() {
   return true;
 }
 
+bool Fem1dQpProblem::UpdateWorkspace(const std::vector<c_float>& P_data,
+                                     const std::vector<c_int>& P_indices,
+                                     const std::vector<c_int>& P_indptr,
+                                     const std::vector<c_float>& A_data,
+                                     const std::vector<c_int>& A_indices,
+                                     const std::vector<c_int>& A_indptr,
+                                     const std::vector<c_float>& lower_bounds,
+                                     const std::vector<c_float>& upper_bounds,
+                                     const std::vector<c_float>& q) {
+  if (work_ == nullptr || !FLAGS_enable_fem_qp_warm_start ||
+      P_indices != P_indices_ || P_indptr != P_indptr_ ||
+      A_indices != A_indices_ || A_indptr != A_indptr_) {
+    return false;
+  }
+  // same sparsity, the factorization only has to be redone if values change
+  if (P_data != P_data_ || A_data != A_data_) {
+    osqp_update_P_A(work_, P_data.data(), OSQP_NULL,
+                    static_cast<c_int>(P_data.size()), A_data.data(),
+                    OSQP_NULL, static_cast<c_int>(A_data.size()));
+    P_data_ = P_data;
+    A_data_ = A_data;
+  }
+  osqp_update_lin_cost(work_, q.data());
+  osqp_update_bounds(work_, lower_bounds.data(), upper_bounds.data());
+  WarmStart();
+  osqp_solve(work_);
+  return true;
+}
+
+void Fem1dQpProblem::WarmStart() {
+  const size_t N = num_of_knots_;
+  if (warm_start_shift_ == 0 || warm_start_shift_ >= N) {
+    // OSQP starts from the unshifted previous solution
+    return;
+  }
+  // every block holds one quantity per knot, moving forward by k knots drops
+  // the first k values and repeats the last one
+  const auto shift_block = [this](const c_float* src, const size_t size,
+                                  c_float* dst) {
+    for (size_t i = 0; i < size; ++i) {
+      dst[i] = src[std::min(i + warm_start_shift_, size - 1)];
+    }
+  };
+
+  const c_float* x = work_->solution->x;
+  std::vector<c_float> x_shifted(3 * N);
+  for (size_t block = 0; block < 3; ++block) {
+    shift_block(x + block * N, N, x_shifted.data() + block * N);
+  }
+
+  // duals follow the layout of CalculateAffineConstraint
+  const c_float* y = work_->solution->y;
+  std::vector<c_float> y_shifted(3 * N + 3 * (N - 1) + 3);
+  size_t offset = 0;
+  for (size_t block = 0; block < 3; ++block, offset += N) {
+    shift_block(y + offset, N, y_shifted.data() + offset);
+  }
+  for (size_t block = 0; block < 3; ++block, offset += N - 1) {
+    shift_block(y + offset, N - 1, y_shifted.data() + offset);
+  }
+  std::copy(y + offset, y + offset + 3, y_shifted.data() + offset);
+
+  osqp_warm_start(work_, x_shifted.data(), y_shifted.data());
+}
+
 void Fem1dQpProblem::CalculateKernel(std::vector<c_float>* P_data,
                                      std::vector<c_int>* P_indices,
                                      std::vector<c_int>* P_indptr) {
@@ -66,7 +66,7 @@ class Fem1dQpProblem {
                  const double delta_s, const std::array<double, 5>& w,
                  const double max_x_third_order_derivative);
 
-  virtual ~Fem1dQpProblem() = default;
+  virtual ~Fem1dQpProblem();
 
   virtual void AddReferenceLineKernel(const std::vector<double>& ref_line,
                                       const double wweight) {}
@@ -104,8 +104,17 @@ class Fem1dQpProblem {
 
   virtual void PreSetKernel() {}
 
+  /*
+   * The OSQP workspace is kept between calls. When the kernel and the affine
+   * constraint matrices are unchanged only the offset and the bounds are
+   * updated, and the previous solution warm starts the solver.
+   */
   virtual bool Optimize();
 
+  // distance along s the first knot moved since the last Optimize(), the
+  // previous solution is shifted by it before it warm starts the next one
+  void SetWarmStartOffset(const double offset);
+
   virtual std::vector<double> x() const { return x_; }
 
   virtual std::vector<double> x_derivative() const { return dx_; }
@@ -146,6 +155,21 @@ class Fem1dQpProblem {
       const std::vector<std::tuple<double, double, double>>& src,
       std::vector<std::pair<double, double>>* dst);
 
+  // false if the workspace has to be set up again for these matrices
+  bool UpdateWorkspace(const std::vector<c_float>& P_data,
+                       const std::vector<c_int>& P_indices,
+                       const std::vector<c_int>& P_indptr,
+                       const std::vector<c_float>& A_data,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr,
+                       const std::vector<c_float>& lower_bounds,
+                       const std::vector<c_float>& upper_bounds,
+                       const std::vector<c_float>& q);
+
+  void WarmStart();
+
+  void CleanUpWorkspace();
+
  protected:
   size_t num_of_knots_ = 0;
 
@@ -172,6 +196,16 @@ class Fem1dQpProblem {
 
   double delta_s_ = 1.0;
   double delta_s_sq_ = 1.0;
+
+  // kept across Optimize() calls
+  OSQPWorkspace* work_ = nullptr;
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  size_t warm_start_shift_ = 0;
 };
 
 }  // namespace planning
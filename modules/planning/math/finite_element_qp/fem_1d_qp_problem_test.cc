@@ -152,5 +152,50 @@ TEST(Fem1dJerkQpProblemTest, derivative_constraint_test) {
   delete fem_qp;
 }
 
+TEST(Fem1dQPProblemTest, warm_start_test) {
+  FLAGS_enable_osqp_debug = false;
+  FLAGS_enable_fem_qp_warm_start = true;
+  std::array<double, 3> x_init = {1.5, 0.01, 0.001};
+  double delta_s = 0.5;
+  size_t n = 200;
+  std::array<double, 5> w = {1.0, 2.0, 3.0, 4.0, 1.45};
+  double max_x_third_order_derivative = 1.25;
+
+  Fem1dQpProblem warm_qp(n, x_init, delta_s, w, max_x_third_order_derivative);
+  warm_qp.SetZeroOrderBounds(2.0);
+  warm_qp.SetFirstOrderBounds(FLAGS_lateral_derivative_bound_default);
+  warm_qp.SetSecondOrderBounds(FLAGS_lateral_derivative_bound_default);
+  EXPECT_TRUE(warm_qp.Optimize());
+  const auto* work = warm_qp.work_;
+  EXPECT_NE(nullptr, work);
+
+  // next cycle, one knot further with narrower bounds
+  std::array<double, 3> next_x_init = {1.4, 0.0, 0.0};
+  std::vector<std::tuple<double, double, double>> x_bounds;
+  for (size_t i = 0; i < n; ++i) {
+    x_bounds.emplace_back(std::make_tuple(delta_s * i, -1.5, 1.8));
+  }
+  warm_qp.ResetInitConditions(next_x_init);
+  warm_qp.SetVariableBounds(x_bounds);
+  warm_qp.SetWarmStartOffset(delta_s);
+  EXPECT_TRUE(warm_qp.Optimize());
+  // the workspace was updated, not set up again
+  EXPECT_EQ(work, warm_qp.work_);
+
+  Fem1dQpProblem cold_qp(n, next_x_init, delta_s, w,
+                         max_x_third_order_derivative);
+  cold_qp.SetVariableBounds(x_bounds);
+  cold_qp.SetFirstOrderBounds(FLAGS_lateral_derivative_bound_default);
+  cold_qp.SetSecondOrderBounds(FLAGS_lateral_derivative_bound_default);
+  EXPECT_TRUE(cold_qp.Optimize());
+
+  const auto& warm_x = warm_qp.x();
+  const auto& cold_x = cold_qp.x();
+  ASSERT_EQ(cold_x.size(), warm_x.size());
+  for (size_t i = 0; i < warm_x.size(); ++i) {
+    EXPECT_NEAR(cold_x[i], warm_x[i], 1e-2);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,6 +20,8 @@
 
 #include "modules/planning/math/smoothing_spline/affine_constraint.h"
 
+#include <utility>
+
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -33,6 +35,7 @@ AffineConstraint::AffineConstraint(const Eigen::MatrixXd& constraint_matrix,
                                    const bool is_equality)
     : constraint_matrix_(constraint_matrix),
       constraint_boundary_(constraint_boundary),
+      num_rows_(static_cast<int>(constraint_matrix.rows())),
       is_equality_(is_equality) {
   CHECK_EQ(constraint_boundary.rows(), constraint_matrix.rows());
 }
@@ -42,13 +45,40 @@ void AffineConstraint::SetIsEquality(const double is_equality) {
 }
 
 const Eigen::MatrixXd& AffineConstraint::constraint_matrix() const {
+  Merge();
   return constraint_matrix_;
 }
 
 const Eigen::MatrixXd& AffineConstraint::constraint_boundary() const {
+  Merge();
   return constraint_boundary_;
 }
 
+void AffineConstraint::Merge() const {
+  if (pending_matrices_.empty()) {
+    return;
+  }
+  const int cols = static_cast<int>(pending_matrices_.front().cols());
+  const int merged_rows = static_cast<int>(constraint_matrix_.rows());
+  Eigen::MatrixXd n_matrix(num_rows_, cols);
+  Eigen::MatrixXd n_boundary(num_rows_, 1);
+  if (merged_rows > 0) {
+    n_matrix.topRows(merged_rows) = constraint_matrix_;
+    n_boundary.topRows(merged_rows) = constraint_boundary_;
+  }
+  int row = merged_rows;
+  for (size_t i = 0; i < pending_matrices_.size(); ++i) {
+    const int rows = static_cast<int>(pending_matrices_[i].rows());
+    n_matrix.middleRows(row, rows) = pending_matrices_[i];
+    n_boundary.middleRows(row, rows) = pending_boundaries_[i];
+    row += rows;
+  }
+  constraint_matrix_ = std::move(n_matrix);
+  constraint_boundary_ = std::move(n_boundary);
+  pending_matrices_.clear();
+  pending_boundaries_.clear();
+}
+
 bool AffineConstraint::AddConstraint(
     const Eigen::MatrixXd& constraint_matrix,
     const Eigen::MatrixXd& constraint_boundary) {
@@ -60,15 +90,19 @@ bool AffineConstraint::AddConstraint(
     return false;
   }
 
-  if (constraint_matrix_.rows() == 0) {
+  if (num_rows_ == 0) {
     constraint_matrix_ = constraint_matrix;
     constraint_boundary_ = constraint_boundary;
+    num_rows_ = static_cast<int>(constraint_matrix.rows());
     return true;
   }
-  if (constraint_matrix_.cols() != constraint_matrix.cols()) {
+  const auto cols = pending_matrices_.empty()
+                        ? constraint_matrix_.cols()
+                        : pending_matrices_.front().cols();
+  if (cols != constraint_matrix.cols()) {
     AERROR
         << "constraint_matrix_ cols and constraint_matrix cols do not match.";
-    AERROR << "constraint_matrix_.cols() = " << constraint_matrix_.cols();
+    AERROR << "constraint_matrix_.cols() = " << cols;
     AERROR << "constraint_matrix.cols() = " << constraint_matrix.cols();
     return false;
   }
@@ -77,15 +111,9 @@ bool AffineConstraint::AddConstraint(
     return false;
   }
 
-  Eigen::MatrixXd n_matrix(constraint_matrix_.rows() + constraint_matrix.rows(),
-                           constraint_matrix_.cols());
-  Eigen::MatrixXd n_boundary(
-      constraint_boundary_.rows() + constraint_boundary.rows(), 1);
-
-  n_matrix << constraint_matrix_, constraint_matrix;
-  n_boundary << constraint_boundary_, constraint_boundary;
-  constraint_matrix_ = n_matrix;
-  constraint_boundary_ = n_boundary;
+  pending_matrices_.push_back(constraint_matrix);
+  pending_boundaries_.push_back(constraint_boundary);
+  num_rows_ += static_cast<int>(constraint_matrix.rows());
   return true;
 }
 
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Eigen/Core"
 #include "modules/planning/math/polynomial_xd.h"
 
@@ -42,8 +44,15 @@ class AffineConstraint {
                      const Eigen::MatrixXd& constraint_boundary);
 
  private:
-  Eigen::MatrixXd constraint_matrix_;
-  Eigen::MatrixXd constraint_boundary_;
+  // stacks the added blocks once when the matrices are read, instead of
+  // copying all previous rows on every AddConstraint
+  void Merge() const;
+
+  mutable Eigen::MatrixXd constraint_matrix_;
+  mutable Eigen::MatrixXd constraint_boundary_;
+  mutable std::vector<Eigen::MatrixXd> pending_matrices_;
+  mutable std::vector<Eigen::MatrixXd> pending_boundaries_;
+  int num_rows_ = 0;
   bool is_equality_ = true;
 };
 
@@ -25,6 +25,7 @@
 #include "osqp/include/osqp.h"
 
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_solver.h"
 
 namespace apollo {
@@ -39,12 +40,12 @@ class OsqpSpline1dSolver : public Spline1dSolver {
 
   void CleanUp();
 
-  void ResetOsqp();
+  // whether the last Solve() updated the OSQP workspace of the one before
+  bool workspace_reused() const { return workspace_.reused(); }
 
  private:
   OSQPSettings* settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  OsqpSplineWorkspace workspace_;
 };
 
 }  // namespace planning
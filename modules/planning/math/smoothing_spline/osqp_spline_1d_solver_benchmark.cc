@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Times repeated solves of a speed profile sized spline QP, with the OSQP
+ * workspace set up on every solve and with it kept while the layout stays.
+ **/
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/smoothing_spline/osqp_spline_1d_solver.h"
+
+DEFINE_int32(benchmark_cycles, 200, "solves per configuration");
+
+namespace apollo {
+namespace planning {
+namespace {
+
+constexpr uint32_t kSplineOrder = 5;
+
+struct Timing {
+  double setup_ms = 0.0;
+  double solve_ms = 0.0;
+};
+
+// knots and layout of a QP spline st graph over 8 s, the guide and the
+// bounds change with the cycle as they would while driving
+Timing RunCycles(const bool reuse_workspace) {
+  FLAGS_enable_osqp_spline_workspace_reuse = reuse_workspace;
+  std::vector<double> t_knots;
+  for (int i = 0; i <= 8; ++i) {
+    t_knots.push_back(i);
+  }
+  std::vector<double> t_coord;
+  for (int i = 0; i <= 40; ++i) {
+    t_coord.push_back(0.2 * i);
+  }
+
+  OsqpSpline1dSolver solver(t_knots, kSplineOrder);
+  Timing timing;
+  for (int cycle = 0; cycle < FLAGS_benchmark_cycles; ++cycle) {
+    const auto start = std::chrono::steady_clock::now();
+    solver.Reset(t_knots, kSplineOrder);
+    auto* constraint = solver.mutable_spline_constraint();
+    auto* kernel = solver.mutable_spline_kernel();
+
+    const double v = 5.0 + 0.01 * (cycle % 100);
+    std::vector<double> s_guide;
+    for (const double t : t_coord) {
+      s_guide.push_back(v * t);
+    }
+    constraint->AddBoundary(t_coord, std::vector<double>(t_coord.size(), 0.0),
+                            std::vector<double>(t_coord.size(), 10.0 * v));
+    constraint->AddDerivativeBoundary(
+        t_coord, std::vector<double>(t_coord.size(), 0.0),
+        std::vector<double>(t_coord.size(), 2.0 * v));
+    constraint->AddThirdDerivativeSmoothConstraint();
+    constraint->AddMonotoneInequalityConstraintAtKnots();
+    constraint->AddPointConstraint(0.0, 0.0);
+    constraint->AddPointDerivativeConstraint(0.0, v);
+    constraint->AddPointSecondDerivativeConstraint(0.0, 0.0);
+    kernel->AddThirdOrderDerivativeMatrix(1000.0);
+    kernel->AddReferenceLineKernelMatrix(t_coord, s_guide, 0.4);
+    kernel->AddRegularization(1.0);
+    const auto built = std::chrono::steady_clock::now();
+
+    solver.Solve();
+    const auto end = std::chrono::steady_clock::now();
+    timing.setup_ms +=
+        std::chrono::duration<double, std::milli>(built - start).count();
+    timing.solve_ms +=
+        std::chrono::duration<double, std::milli>(end - built).count();
+  }
+  timing.setup_ms /= FLAGS_benchmark_cycles;
+  timing.solve_ms /= FLAGS_benchmark_cycles;
+  return timing;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  for (const bool reuse : {false, true}) {
+    const auto timing = apollo::planning::RunCycles(reuse);
+    std::cout << (reuse ? "reused workspace" : "setup every solve")
+              << ": build " << timing.setup_ms << " ms, solve "
+              << timing.solve_ms << " ms per cycle" << std::endl;
+  }
+  return 0;
+}
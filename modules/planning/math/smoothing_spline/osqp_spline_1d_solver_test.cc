@@ -159,5 +159,34 @@ TEST(OsqpSpline1dSolver, three) {
   EXPECT_EQ(qp_proto.inequality_matrix().row_size(), 6);
 }
 
+TEST(OsqpSpline1dSolver, reuse_workspace) {
+  std::vector<double> x_knots{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  OsqpSpline1dSolver pg(x_knots, 6);
+  std::vector<double> x_coord{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  // same layout every cycle, only the guide line moves
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    pg.Reset(x_knots, 6);
+    auto* spline_constraint = pg.mutable_spline_constraint();
+    auto* spline_kernel = pg.mutable_spline_kernel();
+    std::vector<double> fx_guide;
+    for (const double x : x_coord) {
+      fx_guide.push_back(4.0 * x + cycle);
+    }
+    std::vector<double> lower_bound(x_coord.size(), 0.0);
+    std::vector<double> upper_bound(x_coord.size(), 100.0);
+    spline_constraint->AddBoundary(x_coord, lower_bound, upper_bound);
+    spline_constraint->AddThirdDerivativeSmoothConstraint();
+    spline_constraint->AddPointConstraint(0.0, cycle);
+    spline_kernel->AddThirdOrderDerivativeMatrix(1000.0);
+    spline_kernel->AddReferenceLineKernelMatrix(x_coord, fx_guide, 0.4);
+    spline_kernel->AddRegularization(1.0);
+
+    EXPECT_TRUE(pg.Solve());
+    EXPECT_EQ(cycle > 0, pg.workspace_reused());
+    EXPECT_NEAR(cycle, pg.spline()(0.0), 1e-2);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
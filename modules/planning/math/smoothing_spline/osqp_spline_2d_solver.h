@@ -25,6 +25,7 @@
 #include "gtest/gtest_prod.h"
 #include "osqp/include/osqp.h"
 
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
 
@@ -34,6 +35,7 @@ namespace planning {
 class OsqpSpline2dSolver final : public Spline2dSolver {
  public:
   OsqpSpline2dSolver(const std::vector<double>& t_knots, const uint32_t order);
+  virtual ~OsqpSpline2dSolver();
 
   void Reset(const std::vector<double>& t_knots, const uint32_t order) override;
 
@@ -53,8 +55,7 @@ class OsqpSpline2dSolver final : public Spline2dSolver {
 
  private:
   OSQPSettings* osqp_settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  OsqpSplineWorkspace workspace_;
 
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
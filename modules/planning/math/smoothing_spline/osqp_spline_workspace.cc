@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
+
+#include <utility>
+
+#include "cyber/common/log.h"
+
+#include "modules/common/math/matrix_operations.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::DenseToCSCMatrix;
+using apollo::common::math::StackedDenseToCSCMatrix;
+using Eigen::MatrixXd;
+
+OsqpSplineWorkspace::~OsqpSplineWorkspace() { CleanUp(); }
+
+void OsqpSplineWorkspace::CleanUp() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+}
+
+bool OsqpSplineWorkspace::Solve(const MatrixXd& P, const MatrixXd& q,
+                                const AffineConstraint& inequality_constraint,
+                                const AffineConstraint& equality_constraint,
+                                OSQPSettings* settings,
+                                MatrixXd* solution) {
+  // Namings here are following osqp convention.
+  // For details, visit: https://osqp.org/docs/examples/demo.html
+  reused_ = false;
+  ADEBUG << "P: " << P.rows() << ", " << P.cols();
+  if (P.rows() == 0) {
+    return false;
+  }
+
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  DenseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
+
+  // A is the inequality rows on top of the equality rows
+  const MatrixXd& inequality_constraint_matrix =
+      inequality_constraint.constraint_matrix();
+  const MatrixXd& equality_constraint_matrix =
+      equality_constraint.constraint_matrix();
+  const int constraint_num =
+      static_cast<int>(inequality_constraint_matrix.rows() +
+                       equality_constraint_matrix.rows());
+  ADEBUG << "A: " << constraint_num << ", " << P.cols();
+  if (constraint_num == 0) {
+    return false;
+  }
+
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  StackedDenseToCSCMatrix(inequality_constraint_matrix,
+                          equality_constraint_matrix, &A_data, &A_indices,
+                          &A_indptr);
+
+  // set q, l, u: l < A < u
+  std::vector<c_float> q_data(q.data(), q.data() + q.size());
+
+  const MatrixXd& inequality_constraint_boundary =
+      inequality_constraint.constraint_boundary();
+  const MatrixXd& equality_constraint_boundary =
+      equality_constraint.constraint_boundary();
+
+  constexpr double kEpsilon = 1e-9;
+  constexpr double kUpperLimit = 1e9;
+  std::vector<c_float> l(constraint_num);
+  std::vector<c_float> u(constraint_num);
+  for (int i = 0; i < constraint_num; ++i) {
+    if (i < inequality_constraint_boundary.rows()) {
+      l[i] = inequality_constraint_boundary(i, 0);
+      u[i] = kUpperLimit;
+    } else {
+      const int idx =
+          i - static_cast<int>(inequality_constraint_boundary.rows());
+      l[i] = equality_constraint_boundary(idx, 0) - kEpsilon;
+      u[i] = equality_constraint_boundary(idx, 0) + kEpsilon;
+    }
+  }
+
+  reused_ = UpdateWorkspace(P_data, P_indices, P_indptr, A_data, A_indices,
+                            A_indptr, &q_data, &l, &u);
+  if (!reused_) {
+    CleanUp();
+    OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+    data->n = P.rows();
+    data->m = constraint_num;
+    data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
+                         P_indices.data(), P_indptr.data());
+    data->q = q_data.data();
+    data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
+                         A_indices.data(), A_indptr.data());
+    data->l = l.data();
+    data->u = u.data();
+
+    work_ = osqp_setup(data, settings);
+    // the workspace holds its own copy of the problem
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    if (work_ == nullptr) {
+      AERROR << "Failed to set up the spline QP.";
+      return false;
+    }
+    osqp_solve(work_);
+
+    P_data_ = std::move(P_data);
+    P_indices_ = std::move(P_indices);
+    P_indptr_ = std::move(P_indptr);
+    A_data_ = std::move(A_data);
+    A_indices_ = std::move(A_indices);
+    A_indptr_ = std::move(A_indptr);
+  }
+
+  if (work_->solution == nullptr) {
+    AERROR << "Failed to find the spline QP solution.";
+    CleanUp();
+    return false;
+  }
+
+  *solution = MatrixXd::Zero(P.rows(), 1);
+  for (int i = 0; i < P.rows(); ++i) {
+    (*solution)(i, 0) = work_->solution->x[i];
+  }
+  return true;
+}
+
+bool OsqpSplineWorkspace::UpdateWorkspace(
+    const std::vector<c_float>& P_data, const std::vector<c_int>& P_indices,
+    const std::vector<c_int>& P_indptr, const std::vector<c_float>& A_data,
+    const std::vector<c_int>& A_indices, const std::vector<c_int>& A_indptr,
+    std::vector<c_float>* q, std::vector<c_float>* l,
+    std::vector<c_float>* u) {
+  if (work_ == nullptr || !FLAGS_enable_osqp_spline_workspace_reuse ||
+      work_->data->m != static_cast<c_int>(l->size()) ||
+      P_indices != P_indices_ || P_indptr != P_indptr_ ||
+      A_indices != A_indices_ || A_indptr != A_indptr_) {
+    return false;
+  }
+  // same sparsity, the factorization only has to be redone if values change
+  if (P_data != P_data_ || A_data != A_data_) {
+    if (osqp_update_P_A(work_, P_data.data(), OSQP_NULL,
+                        static_cast<c_int>(P_data.size()), A_data.data(),
+                        OSQP_NULL, static_cast<c_int>(A_data.size())) != 0) {
+      ADEBUG << "Failed to update the spline QP matrices, set up again.";
+      return false;
+    }
+    P_data_ = P_data;
+    A_data_ = A_data;
+  }
+  osqp_update_lin_cost(work_, q->data());
+  osqp_update_bounds(work_, l->data(), u->data());
+  osqp_solve(work_);
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "osqp/include/osqp.h"
+
+#include "modules/planning/math/smoothing_spline/affine_constraint.h"
+
+namespace apollo {
+namespace planning {
+
+// OSQP workspace of a spline QP that is kept across solves. The sparsity of
+// the kernel and the constraints follows from the knots and the constraint
+// layout, so while it does not change only the values are updated and the
+// previous solution warm starts the next solve.
+class OsqpSplineWorkspace {
+ public:
+  OsqpSplineWorkspace() = default;
+  ~OsqpSplineWorkspace();
+
+  OsqpSplineWorkspace(const OsqpSplineWorkspace&) = delete;
+  OsqpSplineWorkspace& operator=(const OsqpSplineWorkspace&) = delete;
+
+  // min 0.5 x'Px + q'x s.t. inequality x >= b and equality x = b
+  bool Solve(const Eigen::MatrixXd& P, const Eigen::MatrixXd& q,
+             const AffineConstraint& inequality_constraint,
+             const AffineConstraint& equality_constraint,
+             OSQPSettings* settings, Eigen::MatrixXd* solution);
+
+  void CleanUp();
+
+  // whether the last solve reused the workspace of the one before
+  bool reused() const { return reused_; }
+
+ private:
+  bool UpdateWorkspace(const std::vector<c_float>& P_data,
+                       const std::vector<c_int>& P_indices,
+                       const std::vector<c_int>& P_indptr,
+                       const std::vector<c_float>& A_data,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr,
+                       std::vector<c_float>* q, std::vector<c_float>* l,
+                       std::vector<c_float>* u);
+
+  OSQPWorkspace* work_ = nullptr;
+  bool reused_ = false;
+
+  // problem of work_, to check the sparsity of the next one against
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -283,6 +283,9 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
     return;
   }
 
+  frame_->mutable_latency_budget()->Reset(start_timestamp,
+                                          FLAGS_planning_time_budget_ms);
+
   for (auto& ref_line_info : *frame_->mutable_reference_line_info()) {
     TrafficDecider traffic_decider;
     traffic_decider.Init(traffic_rule_configs_);
@@ -456,14 +459,27 @@ Status OnLanePlanning::Plan(
       }
     }
 
-    last_publishable_trajectory_.reset(new PublishableTrajectory(
-        current_time_stamp, best_ref_info->trajectory()));
+    std::vector<TrajectoryPoint> reused_trajectory;
+    if (frame_->latency_budget().required_task_overrun() &&
+        last_publishable_trajectory_ != nullptr) {
+      reused_trajectory = TrajectoryStitcher::ComputeReusedTrajectory(
+          current_time_stamp, stitching_trajectory,
+          *last_publishable_trajectory_);
+    }
 
     ADEBUG << "current_time_stamp: " << std::to_string(current_time_stamp);
 
-    last_publishable_trajectory_->PrependTrajectoryPoints(
-        std::vector<TrajectoryPoint>(stitching_trajectory.begin(),
-                                     stitching_trajectory.end() - 1));
+    if (reused_trajectory.size() > stitching_trajectory.size()) {
+      AWARN << "Planning over time budget, keep the previous trajectory";
+      last_publishable_trajectory_.reset(new PublishableTrajectory(
+          current_time_stamp, DiscretizedTrajectory(reused_trajectory)));
+    } else {
+      last_publishable_trajectory_.reset(new PublishableTrajectory(
+          current_time_stamp, best_ref_info->trajectory()));
+      last_publishable_trajectory_->PrependTrajectoryPoints(
+          std::vector<TrajectoryPoint>(stitching_trajectory.begin(),
+                                       stitching_trajectory.end() - 1));
+    }
 
     last_publishable_trajectory_->PopulateTrajectoryProtobuf(trajectory_pb);
 
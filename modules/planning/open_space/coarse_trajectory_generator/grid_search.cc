@@ -166,11 +166,22 @@ bool GridSearch::GenerateDpMap(
     const double& ex, const double& ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
+  const double end_index =
+      Node2d::CalcIndex(ex, ey, xy_grid_resolution_, XYbounds);
+  if (IsDpMapReusable(end_index, XYbounds, obstacles_linesegments_vec)) {
+    ADEBUG << "reuse dp map of the last plan";
+    XYbounds_ = XYbounds;
+    return true;
+  }
+
   std::priority_queue<std::pair<double, double>,
                       std::vector<std::pair<double, double>>, cmp>
       open_pq;
   std::unordered_map<double, std::shared_ptr<Node2d>> open_set;
   dp_map_ = decltype(dp_map_)();
+  dp_map_end_index_ = end_index;
+  dp_map_XYbounds_ = XYbounds;
+  dp_map_obstacles_ = obstacles_linesegments_vec;
   XYbounds_ = XYbounds;
   // XYbounds with xmin, xmax, ymin, ymax
   max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
@@ -215,6 +226,31 @@ bool GridSearch::GenerateDpMap(
   return true;
 }
 
+bool GridSearch::IsDpMapReusable(
+    const double end_index, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) const {
+  if (dp_map_.empty() || end_index != dp_map_end_index_ ||
+      XYbounds != dp_map_XYbounds_ ||
+      obstacles_linesegments_vec.size() != dp_map_obstacles_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < obstacles_linesegments_vec.size(); ++i) {
+    const auto& linesegments = obstacles_linesegments_vec[i];
+    const auto& last_linesegments = dp_map_obstacles_[i];
+    if (linesegments.size() != last_linesegments.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < linesegments.size(); ++j) {
+      if (!(linesegments[j].start() == last_linesegments[j].start()) ||
+          !(linesegments[j].end() == last_linesegments[j].end())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 double GridSearch::CheckDpMap(const double& sx, const double& sy) {
   double index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
   if (dp_map_.find(index) != dp_map_.end()) {
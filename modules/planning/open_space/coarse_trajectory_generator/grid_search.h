@@ -117,6 +117,11 @@ class GridSearch {
   std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
       std::shared_ptr<Node2d> node);
   bool CheckConstraints(std::shared_ptr<Node2d> node);
+  // true if dp_map_ was built for the same goal grid, bounds and obstacles
+  bool IsDpMapReusable(
+      const double end_index, const std::vector<double>& XYbounds,
+      const std::vector<std::vector<common::math::LineSegment2d>>&
+          obstacles_linesegments_vec) const;
   void LoadGridAStarResult(GridAStartResult* result);
 
  private:
@@ -138,6 +143,10 @@ class GridSearch {
     }
   };
   std::unordered_map<double, std::shared_ptr<Node2d>> dp_map_;
+  // inputs dp_map_ was built from, to reuse it across replans
+  double dp_map_end_index_ = -1.0;
+  std::vector<double> dp_map_XYbounds_;
+  std::vector<std::vector<common::math::LineSegment2d>> dp_map_obstacles_;
 };
 }  // namespace planning
 }  // namespace apollo
@@ -35,6 +35,7 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().next_node_num();
   max_steer_angle_ =
       vehicle_param_.max_steer_angle() / vehicle_param_.steer_ratio();
+  max_kappa_ = std::tan(max_steer_angle_) / vehicle_param_.wheel_base();
   step_size_ = planner_open_space_config_.warm_start_config().step_size();
   xy_grid_resolution_ =
       planner_open_space_config_.warm_start_config().xy_grid_resolution();
@@ -49,6 +50,15 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().traj_steer_penalty();
   traj_steer_change_penalty_ = planner_open_space_config_.warm_start_config()
                                    .traj_steer_change_penalty();
+  const auto& table_file = planner_open_space_config_.warm_start_config()
+                               .reeds_shepp_heuristic_table_file();
+  if (!table_file.empty()) {
+    reeds_shepp_heuristic_table_.reset(new ReedSheppHeuristicTable());
+    if (!reeds_shepp_heuristic_table_->Load(table_file)) {
+      AERROR << "Failed to load Reed Shepp heuristic table " << table_file;
+      reeds_shepp_heuristic_table_.reset();
+    }
+  }
 }
 
 bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
@@ -72,9 +82,9 @@ bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
+  std::shared_ptr<Node3d> node = std::make_shared<Node3d>(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+      XYbounds_, planner_open_space_config_);
   if (!ValidityCheck(node)) {
     return false;
   }
@@ -87,15 +97,11 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   }
   size_t node_step_size = node->GetStepSize();
   size_t last_check_index = 0;
-  std::vector<double> traversed_x;
-  std::vector<double> traversed_y;
-  std::vector<double> traversed_phi;
-  traversed_x = node->GetXs();
-  traversed_y = node->GetYs();
-  traversed_phi = node->GetPhis();
-  std::reverse(traversed_x.begin(), traversed_x.end());
-  std::reverse(traversed_y.begin(), traversed_y.end());
-  std::reverse(traversed_phi.begin(), traversed_phi.end());
+  // traversed points are checked from the last one backwards
+  const auto& traversed_x = node->GetXs();
+  const auto& traversed_y = node->GetYs();
+  const auto& traversed_phi = node->GetPhis();
+  const size_t last = traversed_x.size() - 1;
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
   if (node_step_size == 1) {
@@ -103,7 +109,8 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   } else {
     last_check_index = node_step_size - 1;
   }
-  for (size_t i = 0; i < last_check_index; ++i) {
+  for (size_t k = 0; k < last_check_index; ++k) {
+    const size_t i = last - k;
     if (traversed_x[i] > XYbounds_[1] || traversed_x[i] < XYbounds_[0] ||
         traversed_y[i] > XYbounds_[3] || traversed_y[i] < XYbounds_[2]) {
       return false;
@@ -125,11 +132,11 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
+  std::shared_ptr<Node3d> end_node = std::make_shared<Node3d>(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+      XYbounds_, planner_open_space_config_);
   end_node->SetPre(current_node);
-  close_set_.insert(std::make_pair(end_node->GetIndex(), end_node));
+  StateOf(end_node->GetIndex()) = NodeState::CLOSED;
   return end_node;
 }
 
@@ -155,9 +162,13 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   // take above motion primitive to generate a curve driving the car to a
   // different grid
   double arc = std::sqrt(2) * xy_grid_resolution_;
+  const size_t num_steps = static_cast<size_t>(std::ceil(arc / step_size_));
   std::vector<double> intermediate_x;
   std::vector<double> intermediate_y;
   std::vector<double> intermediate_phi;
+  intermediate_x.reserve(num_steps + 1);
+  intermediate_y.reserve(num_steps + 1);
+  intermediate_phi.reserve(num_steps + 1);
   double last_x = current_node->GetX();
   double last_y = current_node->GetY();
   double last_phi = current_node->GetPhi();
@@ -184,9 +195,9 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_y.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node = std::make_shared<Node3d>(
+      std::move(intermediate_x), std::move(intermediate_y),
+      std::move(intermediate_phi), XYbounds_, planner_open_space_config_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0);
   next_node->SetSteer(steering);
@@ -200,6 +211,10 @@ void HybridAStar::CalculateNodeCost(std::shared_ptr<Node3d> current_node,
   // evaluate heuristic cost
   double optimal_path_cost = 0.0;
   optimal_path_cost += HoloObstacleHeuristic(next_node);
+  if (reeds_shepp_heuristic_table_ != nullptr) {
+    optimal_path_cost =
+        std::max(optimal_path_cost, NonHoloNoObstacleHeuristic(next_node));
+  }
   next_node->SetHeuCost(optimal_path_cost);
 }
 
@@ -228,6 +243,13 @@ double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
                                                       next_node->GetY());
 }
 
+double HybridAStar::NonHoloNoObstacleHeuristic(
+    std::shared_ptr<Node3d> next_node) {
+  return reeds_shepp_heuristic_table_->Lookup(
+      max_kappa_, next_node->GetX(), next_node->GetY(), next_node->GetPhi(),
+      end_node_->GetX(), end_node_->GetY(), end_node_->GetPhi());
+}
+
 bool HybridAStar::GetResult(HybridAStartResult* result) {
   std::shared_ptr<Node3d> current_node = final_node_;
   std::vector<double> hybrid_a_x;
@@ -316,14 +338,44 @@ bool HybridAStar::GenerateSpeedAcceleration(HybridAStartResult* result) {
   return true;
 }
 
+void HybridAStar::ResetNodeStates() {
+  // largest Node3d::GetIndex() within XYbounds_
+  const auto& warm_start_config =
+      planner_open_space_config_.warm_start_config();
+  const double x_span = XYbounds_[1] - XYbounds_[0];
+  const double y_span = XYbounds_[3] - XYbounds_[2];
+  const double max_x_grid =
+      std::floor(x_span / warm_start_config.xy_grid_resolution());
+  const double max_y_grid =
+      std::floor(y_span / warm_start_config.xy_grid_resolution());
+  const double max_phi_grid =
+      std::floor(2.0 * M_PI / warm_start_config.phi_grid_resolution());
+  const double max_index =
+      max_phi_grid * x_span * y_span + max_y_grid * x_span + max_x_grid;
+  node_states_.assign(static_cast<size_t>(std::fmax(max_index, 0.0)) + 1,
+                      NodeState::UNVISITED);
+}
+
+HybridAStar::NodeState& HybridAStar::StateOf(const size_t node_index) {
+  if (node_index >= node_states_.size()) {
+    node_states_.resize(node_index + 1, NodeState::UNVISITED);
+  }
+  return node_states_[node_index];
+}
+
+void HybridAStar::AddOpenNode(std::shared_ptr<Node3d> node) {
+  StateOf(node->GetIndex()) = NodeState::OPEN;
+  open_pq_.push(std::make_pair(nodes_.size(), node->GetCost()));
+  nodes_.push_back(std::move(node));
+}
+
 bool HybridAStar::Plan(
     double sx, double sy, double sphi, double ex, double ey, double ephi,
     const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
   // clear containers
-  open_set_.clear();
-  close_set_.clear();
+  nodes_.clear();
   open_pq_ = decltype(open_pq_)();
   final_node_ = nullptr;
 
@@ -343,6 +395,7 @@ bool HybridAStar::Plan(
 
   // load XYbounds
   XYbounds_ = XYbounds;
+  ResetNodeStates();
   // load nodes and obstacles
   start_node_.reset(
       new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
@@ -361,9 +414,7 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   AINFO << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.insert(std::make_pair(start_node_->GetIndex(), start_node_));
-  open_pq_.push(
-      std::make_pair(start_node_->GetIndex(), start_node_->GetCost()));
+  AddOpenNode(start_node_);
 
   // Hybrid A* begins
   size_t explored_node_num = 0;
@@ -373,9 +424,9 @@ bool HybridAStar::Plan(
   double end_time = 0.0;
   while (!open_pq_.empty()) {
     // take out the lowest cost neighboring node
-    size_t current_id = open_pq_.top().first;
+    size_t current_slot = open_pq_.top().first;
     open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
+    std::shared_ptr<Node3d> current_node = nodes_[current_slot];
     // check if a analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
@@ -385,7 +436,7 @@ bool HybridAStar::Plan(
     }
     end_time = Clock::NowInSeconds();
     rs_time += end_time - start_time;
-    close_set_.insert(std::make_pair(current_node->GetIndex(), current_node));
+    StateOf(current_node->GetIndex()) = NodeState::CLOSED;
     for (size_t i = 0; i < next_node_num_; ++i) {
       std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
       // boundary check failure handle
@@ -393,22 +444,20 @@ bool HybridAStar::Plan(
         continue;
       }
       // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      if (StateOf(next_node->GetIndex()) == NodeState::CLOSED) {
         continue;
       }
       // collision check
       if (!ValidityCheck(next_node)) {
         continue;
       }
-      if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
+      if (StateOf(next_node->GetIndex()) == NodeState::UNVISITED) {
         explored_node_num++;
         start_time = Clock::NowInSeconds();
         CalculateNodeCost(current_node, next_node);
         end_time = Clock::NowInSeconds();
         heuristic_time += end_time - start_time;
-        open_set_.insert(std::make_pair(next_node->GetIndex(), next_node));
-        open_pq_.push(
-            std::make_pair(next_node->GetIndex(), next_node->GetCost()));
+        AddOpenNode(std::move(next_node));
       }
     }
   }
@@ -20,14 +20,15 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <queue>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_heuristic_table.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
 #include "cyber/common/log.h"
@@ -82,8 +83,18 @@ class HybridAStar {
   double TrajCost(std::shared_ptr<Node3d> current_node,
                   std::shared_ptr<Node3d> next_node);
   double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
+  // Reed Shepp length to the end node from the offline table, ignoring
+  // obstacles. Negative if unavailable.
+  double NonHoloNoObstacleHeuristic(std::shared_ptr<Node3d> next_node);
   bool GetResult(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
+  // sizes the per grid index search state for the current XYbounds_
+  void ResetNodeStates();
+  // adds a node to the open set and pushes its slot in nodes_ to open_pq_
+  void AddOpenNode(std::shared_ptr<Node3d> node);
+
+  enum class NodeState : uint8_t { UNVISITED, OPEN, CLOSED };
+  NodeState& StateOf(const size_t node_index);
 
  private:
   PlannerOpenSpaceConfig planner_open_space_config_;
@@ -91,6 +102,7 @@ class HybridAStar {
       common::VehicleConfigHelper::GetConfig().vehicle_param();
   size_t next_node_num_ = 0;
   double max_steer_angle_ = 0.0;
+  double max_kappa_ = 0.0;
   double step_size_ = 0.0;
   double xy_grid_resolution_ = 0.0;
   double delta_t_ = 0.0;
@@ -120,10 +132,13 @@ class HybridAStar {
   std::priority_queue<std::pair<size_t, double>,
                       std::vector<std::pair<size_t, double>>, cmp>
       open_pq_;
-  std::unordered_map<size_t, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<size_t, std::shared_ptr<Node3d>> close_set_;
+  // nodes opened in the current plan, open_pq_ refers to them by slot
+  std::vector<std::shared_ptr<Node3d>> nodes_;
+  // open and close sets as a flat table over Node3d::GetIndex()
+  std::vector<NodeState> node_states_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
+  std::unique_ptr<ReedSheppHeuristicTable> reeds_shepp_heuristic_table_;
 };
 
 }  // namespace planning
@@ -20,6 +20,8 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 
+#include <utility>
+
 namespace apollo {
 namespace planning {
 
@@ -88,10 +90,10 @@ Node3d::Node3d(std::vector<double> traversed_x, std::vector<double> traversed_y,
           (XYbounds[3] - XYbounds[2]) +
       static_cast<double>(y_grid_) * (XYbounds[1] - XYbounds[0]) +
       static_cast<double>(x_grid_));
-  traversed_x_ = traversed_x;
-  traversed_y_ = traversed_y;
-  traversed_phi_ = traversed_phi;
   step_size_ = traversed_x.size();
+  traversed_x_ = std::move(traversed_x);
+  traversed_y_ = std::move(traversed_y);
+  traversed_phi_ = std::move(traversed_phi);
 }
 
 Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_,
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_heuristic_table.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/math_utils.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
+#include "modules/planning/proto/planner_open_space_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+constexpr char kMagic[8] = "RSHEU01";
+}  // namespace
+
+ReedSheppHeuristicTable::~ReedSheppHeuristicTable() { Unload(); }
+
+bool ReedSheppHeuristicTable::Generate(const double max_xy,
+                                       const double xy_resolution,
+                                       const double phi_resolution,
+                                       const std::string& file) {
+  if (max_xy <= 0.0 || xy_resolution <= 0.0 || phi_resolution <= 0.0) {
+    AERROR << "Invalid table dimension";
+    return false;
+  }
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.num_xy =
+      static_cast<uint32_t>(std::round(2.0 * max_xy / xy_resolution)) + 1;
+  header.num_phi =
+      static_cast<uint32_t>(std::round(2.0 * M_PI / phi_resolution));
+  header.max_xy = max_xy;
+  header.xy_resolution = xy_resolution;
+  header.phi_resolution = 2.0 * M_PI / header.num_phi;
+
+  // unit turning radius
+  common::VehicleParam vehicle_param;
+  vehicle_param.set_wheel_base(1.0);
+  vehicle_param.set_steer_ratio(1.0);
+  vehicle_param.set_max_steer_angle(M_PI_4);
+  ReedShepp reed_shepp(vehicle_param, PlannerOpenSpaceConfig());
+
+  const auto start_node = std::make_shared<Node3d>(0.0, 0.0, 0.0);
+  std::vector<float> lengths(static_cast<size_t>(header.num_xy) *
+                             header.num_xy * header.num_phi);
+  size_t index = 0;
+  for (uint32_t i = 0; i < header.num_xy; ++i) {
+    const double x = -max_xy + i * xy_resolution;
+    for (uint32_t j = 0; j < header.num_xy; ++j) {
+      const double y = -max_xy + j * xy_resolution;
+      for (uint32_t k = 0; k < header.num_phi; ++k) {
+        const double phi = -M_PI + k * header.phi_resolution;
+        double length = 0.0;
+        if (std::abs(x) > 1e-9 || std::abs(y) > 1e-9 || std::abs(phi) > 1e-9) {
+          const auto end_node = std::make_shared<Node3d>(x, y, phi);
+          if (!reed_shepp.ShortestRSPLength(start_node, end_node, &length)) {
+            length = -1.0;
+          }
+        }
+        lengths[index++] = static_cast<float>(length);
+      }
+    }
+  }
+
+  std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  ofs.write(reinterpret_cast<const char*>(lengths.data()),
+            lengths.size() * sizeof(float));
+  if (!ofs) {
+    AERROR << "Failed to write Reed Shepp heuristic table " << file;
+    return false;
+  }
+  AINFO << "Wrote Reed Shepp heuristic table " << file << " with "
+        << lengths.size() << " entries";
+  return true;
+}
+
+bool ReedSheppHeuristicTable::Load(const std::string& file) {
+  Unload();
+  const int fd = open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Open file failed, file: " << file << ", errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(Header)) {
+    AERROR << "Stat file failed or file too small, file: " << file;
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    AERROR << "Mmap file failed, file: " << file << ", errno: " << errno;
+    return false;
+  }
+  data_ = static_cast<const char*>(addr);
+  size_ = size;
+
+  std::memcpy(&header_, data_, sizeof(Header));
+  const size_t num_entries =
+      static_cast<size_t>(header_.num_xy) * header_.num_xy * header_.num_phi;
+  if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header_.num_xy == 0 || header_.num_phi == 0 ||
+      size_ != sizeof(Header) + num_entries * sizeof(float)) {
+    AERROR << "Invalid Reed Shepp heuristic table " << file;
+    Unload();
+    return false;
+  }
+  lengths_ = reinterpret_cast<const float*>(data_ + sizeof(Header));
+  return true;
+}
+
+void ReedSheppHeuristicTable::Unload() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  lengths_ = nullptr;
+}
+
+double ReedSheppHeuristicTable::Lookup(const double max_kappa, const double sx,
+                                       const double sy, const double sphi,
+                                       const double ex, const double ey,
+                                       const double ephi) const {
+  if (lengths_ == nullptr || max_kappa <= 0.0) {
+    return -1.0;
+  }
+  // end pose in the start frame, scaled to unit turning radius
+  const double dx = ex - sx;
+  const double dy = ey - sy;
+  const double c = std::cos(sphi);
+  const double s = std::sin(sphi);
+  const double x = (c * dx + s * dy) * max_kappa;
+  const double y = (-s * dx + c * dy) * max_kappa;
+  const double phi = common::math::NormalizeAngle(ephi - sphi);
+
+  const double i = std::round((x + header_.max_xy) / header_.xy_resolution);
+  const double j = std::round((y + header_.max_xy) / header_.xy_resolution);
+  if (i < 0.0 || j < 0.0 || i >= header_.num_xy || j >= header_.num_xy) {
+    return -1.0;
+  }
+  const size_t k = static_cast<size_t>(
+                       std::round((phi + M_PI) / header_.phi_resolution)) %
+                   header_.num_phi;
+  const size_t index = (static_cast<size_t>(i) * header_.num_xy +
+                        static_cast<size_t>(j)) *
+                           header_.num_phi +
+                       k;
+  const double length = lengths_[index];
+  return length < 0.0 ? -1.0 : length / max_kappa;
+}
+
+}  // namespace planning
+}  // namespace apollo
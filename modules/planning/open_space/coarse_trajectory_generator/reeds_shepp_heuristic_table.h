@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * Offline table of shortest Reed Shepp path lengths, used as the
+ * non-holonomic heuristic of hybrid a star. The table is computed for a unit
+ * turning radius over end poses relative to the start pose, so one file
+ * serves any vehicle, and it is memory mapped on load.
+ */
+class ReedSheppHeuristicTable {
+ public:
+  ReedSheppHeuristicTable() = default;
+  ~ReedSheppHeuristicTable();
+
+  ReedSheppHeuristicTable(const ReedSheppHeuristicTable&) = delete;
+  ReedSheppHeuristicTable& operator=(const ReedSheppHeuristicTable&) = delete;
+
+  /**
+   * Generates the table for relative x, y in [-max_xy, max_xy] (in turning
+   * radius units) and relative heading in [-pi, pi), and writes it to file.
+   */
+  static bool Generate(const double max_xy, const double xy_resolution,
+                       const double phi_resolution, const std::string& file);
+
+  bool Load(const std::string& file);
+  bool IsLoaded() const { return data_ != nullptr; }
+
+  /**
+   * Returns the shortest Reed Shepp path length from start to end pose for a
+   * vehicle with max curvature max_kappa, or a negative value if the relative
+   * pose is outside of the table.
+   */
+  double Lookup(const double max_kappa, const double sx, const double sy,
+                const double sphi, const double ex, const double ey,
+                const double ephi) const;
+
+ private:
+  struct Header {
+    char magic[8];
+    uint32_t num_xy;
+    uint32_t num_phi;
+    double max_xy;
+    double xy_resolution;
+    double phi_resolution;
+  };
+
+  void Unload();
+
+  Header header_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  const float* lengths_ = nullptr;
+};
+
+}  // namespace planning
+}  // namespace apollo
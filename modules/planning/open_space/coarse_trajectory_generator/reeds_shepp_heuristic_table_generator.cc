@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/*
+ * @file
+ */
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_heuristic_table.h"
+
+DEFINE_string(output_file, "", "Reed Shepp heuristic table file to write");
+DEFINE_double(max_xy, 10.0,
+              "Table range of relative x and y, in turning radius units");
+DEFINE_double(xy_resolution, 0.1,
+              "Table resolution of relative x and y, in turning radius units");
+DEFINE_double(phi_resolution, 0.1, "Table resolution of relative heading");
+
+int main(int argc, char* argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_output_file.empty()) {
+    AERROR << "need to provide --output_file";
+    return -1;
+  }
+  if (!apollo::planning::ReedSheppHeuristicTable::Generate(
+          FLAGS_max_xy, FLAGS_xy_resolution, FLAGS_phi_resolution,
+          FLAGS_output_file)) {
+    return -1;
+  }
+  return 0;
+}
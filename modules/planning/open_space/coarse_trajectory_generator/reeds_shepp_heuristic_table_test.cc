@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_heuristic_table.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/math_utils.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
+#include "modules/planning/proto/planner_open_space_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(ReedSheppHeuristicTableTest, lookup) {
+  const std::string file = "reeds_shepp_heuristic_table_test.bin";
+  ASSERT_TRUE(ReedSheppHeuristicTable::Generate(2.0, 0.5, M_PI / 4.0, file));
+  ReedSheppHeuristicTable table;
+  EXPECT_FALSE(table.IsLoaded());
+  ASSERT_TRUE(table.Load(file));
+  EXPECT_TRUE(table.IsLoaded());
+
+  // turning radius of 5 meters
+  common::VehicleParam vehicle_param;
+  vehicle_param.set_wheel_base(5.0);
+  vehicle_param.set_steer_ratio(1.0);
+  vehicle_param.set_max_steer_angle(M_PI_4);
+  const double max_kappa = 0.2;
+  ReedShepp reed_shepp(vehicle_param, PlannerOpenSpaceConfig());
+
+  // table cells in a rotated and shifted start frame
+  const double sx = 3.0;
+  const double sy = -1.0;
+  const double sphi = 0.5;
+  const auto start_node = std::make_shared<Node3d>(sx, sy, sphi);
+  for (const double x : {-5.0, 2.5, 7.5}) {
+    for (const double y : {-10.0, 0.0, 5.0}) {
+      for (const double phi : {-M_PI_2, 0.0, 3.0 * M_PI_4}) {
+        const double ex = sx + x * std::cos(sphi) - y * std::sin(sphi);
+        const double ey = sy + x * std::sin(sphi) + y * std::cos(sphi);
+        const double ephi = common::math::NormalizeAngle(sphi + phi);
+        double expected = 0.0;
+        ASSERT_TRUE(reed_shepp.ShortestRSPLength(
+            start_node, std::make_shared<Node3d>(ex, ey, ephi), &expected));
+        EXPECT_NEAR(expected,
+                    table.Lookup(max_kappa, sx, sy, sphi, ex, ey, ephi), 1e-3);
+      }
+    }
+  }
+
+  // out of the table range
+  EXPECT_LT(table.Lookup(max_kappa, 0.0, 0.0, 0.0, 20.0, 0.0, 0.0), 0.0);
+  std::remove(file.c_str());
+
+  ReedSheppHeuristicTable missing;
+  EXPECT_FALSE(missing.Load(file));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -116,6 +116,26 @@ bool ReedShepp::ShortestRSP(const std::shared_ptr<Node3d> start_node,
   return true;
 }
 
+bool ReedShepp::ShortestRSPLength(const std::shared_ptr<Node3d> start_node,
+                                  const std::shared_ptr<Node3d> end_node,
+                                  double* length) {
+  std::vector<ReedSheppPath> all_possible_paths;
+  if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
+    return false;
+  }
+  double optimal_path_length = std::numeric_limits<double>::infinity();
+  for (const auto& path : all_possible_paths) {
+    if (path.total_length > 0 && path.total_length < optimal_path_length) {
+      optimal_path_length = path.total_length;
+    }
+  }
+  if (std::isinf(optimal_path_length)) {
+    return false;
+  }
+  *length = optimal_path_length / max_kappa_;
+  return true;
+}
+
 bool ReedShepp::GenerateRSPs(const std::shared_ptr<Node3d> start_node,
                              const std::shared_ptr<Node3d> end_node,
                              std::vector<ReedSheppPath>* all_possible_paths) {
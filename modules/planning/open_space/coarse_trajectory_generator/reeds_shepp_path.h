@@ -67,6 +67,10 @@ class ReedShepp {
   bool ShortestRSP(const std::shared_ptr<Node3d> start_node,
                    const std::shared_ptr<Node3d> end_node,
                    std::shared_ptr<ReedSheppPath> optimal_path);
+  // Length of the shortest Reed Shepp path without interpolating the path
+  bool ShortestRSPLength(const std::shared_ptr<Node3d> start_node,
+                         const std::shared_ptr<Node3d> end_node,
+                         double* length);
 
  protected:
   // Generate all possible combination of movement primitives by Reed Shepp and
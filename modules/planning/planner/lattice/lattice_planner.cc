@@ -20,6 +20,8 @@
 
 #include "modules/planning/planner/lattice/lattice_planner.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -27,6 +29,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
@@ -54,6 +57,14 @@ using apollo::common::time::Clock;
 
 namespace {
 
+struct ValidationCandidate {
+  double cost = 0.0;
+  std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>> pair;
+  DiscretizedTrajectory trajectory;
+  ConstraintChecker::Result result = ConstraintChecker::Result::VALID;
+  bool in_collision = false;
+};
+
 std::vector<PathPoint> ToDiscretizedReferenceLine(
     const std::vector<ReferencePoint>& ref_points) {
   double s = 0.0;
@@ -232,104 +243,144 @@ Status LatticePlanner::PlanOnReferenceLine(
 
   size_t num_lattice_traj = 0;
 
-  while (trajectory_evaluator.has_more_trajectory_pairs()) {
-    double trajectory_pair_cost =
-        trajectory_evaluator.top_trajectory_pair_cost();
-    auto trajectory_pair = trajectory_evaluator.next_top_trajectory_pair();
-
-    // combine two 1d trajectories to one 2d trajectory
-    auto combined_trajectory = TrajectoryCombiner::Combine(
-        *ptr_reference_line, *trajectory_pair.first, *trajectory_pair.second,
-        planning_init_point.relative_time());
-
-    // check longitudinal and lateral acceleration
-    // considering trajectory curvatures
-    auto result = ConstraintChecker::ValidTrajectory(combined_trajectory);
-    if (result != ConstraintChecker::Result::VALID) {
-      ++combined_constraint_failure_count;
-
-      switch (result) {
-        case ConstraintChecker::Result::LON_VELOCITY_OUT_OF_BOUND:
-          lon_vel_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_ACCELERATION_OUT_OF_BOUND:
-          lon_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_JERK_OUT_OF_BOUND:
-          lon_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::CURVATURE_OUT_OF_BOUND:
-          curvature_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_ACCELERATION_OUT_OF_BOUND:
-          lat_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_JERK_OUT_OF_BOUND:
-          lat_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::VALID:
-        default:
-          // Intentional empty
-          break;
-      }
-      continue;
+  // take the next pairs in cost order and validate them concurrently, pairs
+  // after a valid one are skipped, so the cheapest valid pair is chosen as
+  // when validating them one by one.
+  const size_t batch_size =
+      static_cast<size_t>(std::max(FLAGS_lattice_validation_batch_size, 1));
+  std::vector<ValidationCandidate> batch;
+  while (num_lattice_traj == 0 &&
+         trajectory_evaluator.has_more_trajectory_pairs()) {
+    batch.clear();
+    while (batch.size() < batch_size &&
+           trajectory_evaluator.has_more_trajectory_pairs()) {
+      ValidationCandidate candidate;
+      candidate.cost = trajectory_evaluator.top_trajectory_pair_cost();
+      candidate.pair = trajectory_evaluator.next_top_trajectory_pair();
+      batch.push_back(std::move(candidate));
     }
+    std::atomic<size_t> first_valid(batch.size());
+    cyber::ParallelFor(0, batch.size(), 1, [&](size_t i) {
+      if (i > first_valid.load()) {
+        return;
+      }
+      auto& candidate = batch[i];
+      // combine two 1d trajectories to one 2d trajectory
+      candidate.trajectory = TrajectoryCombiner::Combine(
+          *ptr_reference_line, *candidate.pair.first, *candidate.pair.second,
+          planning_init_point.relative_time());
+      // check longitudinal and lateral acceleration
+      // considering trajectory curvatures
+      candidate.result =
+          ConstraintChecker::ValidTrajectory(candidate.trajectory);
+      if (candidate.result != ConstraintChecker::Result::VALID) {
+        return;
+      }
+      // check collision with other obstacles
+      candidate.in_collision =
+          collision_checker.InCollision(candidate.trajectory);
+      if (candidate.in_collision) {
+        return;
+      }
+      size_t index = first_valid.load();
+      while (i < index && !first_valid.compare_exchange_weak(index, i)) {
+      }
+    });
+
+    // the pairs are counted in order up to the first valid one, the skipped
+    // pairs after it are never reached
+    for (const auto& candidate : batch) {
+      const double trajectory_pair_cost = candidate.cost;
+      const auto& trajectory_pair = candidate.pair;
+      const auto& combined_trajectory = candidate.trajectory;
+      const auto result = candidate.result;
+      if (result != ConstraintChecker::Result::VALID) {
+        ++combined_constraint_failure_count;
+
+        switch (result) {
+          case ConstraintChecker::Result::LON_VELOCITY_OUT_OF_BOUND:
+            lon_vel_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LON_ACCELERATION_OUT_OF_BOUND:
+            lon_acc_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LON_JERK_OUT_OF_BOUND:
+            lon_jerk_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::CURVATURE_OUT_OF_BOUND:
+            curvature_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LAT_ACCELERATION_OUT_OF_BOUND:
+            lat_acc_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LAT_JERK_OUT_OF_BOUND:
+            lat_jerk_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::VALID:
+          default:
+            // Intentional empty
+            break;
+        }
+        continue;
+      }
 
-    // check collision with other obstacles
-    if (collision_checker.InCollision(combined_trajectory)) {
-      ++collision_failure_count;
-      continue;
-    }
+      if (candidate.in_collision) {
+        ++collision_failure_count;
+        continue;
+      }
 
-    // put combine trajectory into debug data
-    const auto& combined_trajectory_points = combined_trajectory;
-    num_lattice_traj += 1;
-    reference_line_info->SetTrajectory(combined_trajectory);
-    reference_line_info->SetCost(reference_line_info->PriorityCost() +
-                                 trajectory_pair_cost);
-    reference_line_info->SetDrivable(true);
+      // put combine trajectory into debug data
+      const auto& combined_trajectory_points = combined_trajectory;
+      num_lattice_traj += 1;
+      reference_line_info->SetTrajectory(combined_trajectory);
+      reference_line_info->SetCost(reference_line_info->PriorityCost() +
+                                   trajectory_pair_cost);
+      reference_line_info->SetDrivable(true);
 
-    // Print the chosen end condition and start condition
-    ADEBUG << "Starting Lon. State: s = " << init_s[0] << " ds = " << init_s[1]
-           << " dds = " << init_s[2];
-    // cast
-    auto lattice_traj_ptr =
-        std::dynamic_pointer_cast<LatticeTrajectory1d>(trajectory_pair.first);
-    if (!lattice_traj_ptr) {
-      ADEBUG << "Dynamically casting trajectory1d ptr. failed.";
-    }
+      // Print the chosen end condition and start condition
+      ADEBUG << "Starting Lon. State: s = " << init_s[0]
+             << " ds = " << init_s[1] << " dds = " << init_s[2];
+      // cast
+      auto lattice_traj_ptr =
+          std::dynamic_pointer_cast<LatticeTrajectory1d>(trajectory_pair.first);
+      if (!lattice_traj_ptr) {
+        ADEBUG << "Dynamically casting trajectory1d ptr. failed.";
+      }
 
-    if (lattice_traj_ptr->has_target_position()) {
-      ADEBUG << "Ending Lon. State s = " << lattice_traj_ptr->target_position()
-             << " ds = " << lattice_traj_ptr->target_velocity()
-             << " t = " << lattice_traj_ptr->target_time();
-    }
+      if (lattice_traj_ptr->has_target_position()) {
+        ADEBUG << "Ending Lon. State s = "
+               << lattice_traj_ptr->target_position()
+               << " ds = " << lattice_traj_ptr->target_velocity()
+               << " t = " << lattice_traj_ptr->target_time();
+      }
 
-    ADEBUG << "InputPose";
-    ADEBUG << "XY: " << planning_init_point.ShortDebugString();
-    ADEBUG << "S: (" << init_s[0] << ", " << init_s[1] << "," << init_s[2]
-           << ")";
-    ADEBUG << "L: (" << init_d[0] << ", " << init_d[1] << "," << init_d[2]
-           << ")";
-
-    ADEBUG << "Reference_line_priority_cost = "
-           << reference_line_info->PriorityCost();
-    ADEBUG << "Total_Trajectory_Cost = " << trajectory_pair_cost;
-    ADEBUG << "OutputTrajectory";
-    for (uint i = 0; i < 10; ++i) {
-      ADEBUG << combined_trajectory_points[i].ShortDebugString();
-    }
+      ADEBUG << "InputPose";
+      ADEBUG << "XY: " << planning_init_point.ShortDebugString();
+      ADEBUG << "S: (" << init_s[0] << ", " << init_s[1] << "," << init_s[2]
+             << ")";
+      ADEBUG << "L: (" << init_d[0] << ", " << init_d[1] << "," << init_d[2]
+             << ")";
+
+      ADEBUG << "Reference_line_priority_cost = "
+             << reference_line_info->PriorityCost();
+      ADEBUG << "Total_Trajectory_Cost = " << trajectory_pair_cost;
+      ADEBUG << "OutputTrajectory";
+      for (uint i = 0; i < 10; ++i) {
+        ADEBUG << combined_trajectory_points[i].ShortDebugString();
+      }
 
-    break;
-    /*
-    auto combined_trajectory_path =
-        ptr_debug->mutable_planning_data()->add_trajectory_path();
-    for (uint i = 0; i < combined_trajectory_points.size(); ++i) {
-      combined_trajectory_path->add_trajectory_point()->CopyFrom(
-          combined_trajectory_points[i]);
+      break;
+      /*
+      auto combined_trajectory_path =
+          ptr_debug->mutable_planning_data()->add_trajectory_path();
+      for (uint i = 0; i < combined_trajectory_points.size(); ++i) {
+        combined_trajectory_path->add_trajectory_point()->CopyFrom(
+            combined_trajectory_points[i]);
+      }
+      combined_trajectory_path->set_lattice_trajectory_cost(
+          trajectory_pair_cost);
+      */
     }
-    combined_trajectory_path->set_lattice_trajectory_cost(trajectory_pair_cost);
-    */
   }
 
   ADEBUG << "Trajectory_Evaluation_Time = "
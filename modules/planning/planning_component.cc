@@ -15,14 +15,18 @@
  *****************************************************************************/
 #include "modules/planning/planning_component.h"
 
+#include <algorithm>
+
 #include "cyber/common/file.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/message_util.h"
+#include "modules/common/util/trace_util.h"
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/navi_planning.h"
 #include "modules/planning/on_lane_planning.h"
 #include "modules/planning/open_space_planning.h"
@@ -51,6 +55,7 @@ bool PlanningComponent::Init() {
                                                 &config_))
       << "failed to load planning config file " << FLAGS_planning_config_file;
   planning_base_->Init(config_);
+  record_debug_ = FLAGS_enable_record_debug;
 
   if (FLAGS_use_sim_time) {
     Clock::SetMode(Clock::MOCK);
@@ -103,6 +108,8 @@ bool PlanningComponent::Proc(
     const std::shared_ptr<localization::LocalizationEstimate>&
         localization_estimate) {
   CHECK(prediction_obstacles != nullptr);
+  // Traces the published trajectory back to the perception sensor frame.
+  common::util::TraceScope trace_scope(prediction_obstacles->header());
 
   if (FLAGS_use_sim_time) {
     Clock::SetNowInSeconds(localization_estimate->header().timestamp_sec());
@@ -137,20 +144,40 @@ bool PlanningComponent::Proc(
     return false;
   }
 
-  ADCTrajectory adc_trajectory_pb;
-  planning_base_->RunOnce(local_view_, &adc_trajectory_pb);
-  auto start_time = adc_trajectory_pb.header().timestamp_sec();
-  common::util::FillHeader(node_->Name(), &adc_trajectory_pb);
+  SampleRecordDebug();
+  auto adc_trajectory_pb = MutableTrajectory();
+  planning_base_->RunOnce(local_view_, adc_trajectory_pb.get());
+  auto start_time = adc_trajectory_pb->header().timestamp_sec();
+  common::util::FillHeader(node_->Name(), adc_trajectory_pb.get());
 
   // modify trajectory relative time due to the timestamp change in header
-  const double dt = start_time - adc_trajectory_pb.header().timestamp_sec();
-  for (auto& p : *adc_trajectory_pb.mutable_trajectory_point()) {
+  const double dt = start_time - adc_trajectory_pb->header().timestamp_sec();
+  for (auto& p : *adc_trajectory_pb->mutable_trajectory_point()) {
     p.set_relative_time(p.relative_time() + dt);
   }
-  planning_writer_->Write(std::make_shared<ADCTrajectory>(adc_trajectory_pb));
+  planning_writer_->Write(adc_trajectory_pb);
   return true;
 }
 
+std::shared_ptr<ADCTrajectory> PlanningComponent::MutableTrajectory() {
+  // only reuse the last message once no reader holds it any more, Clear()
+  // keeps the allocated repeated fields for this cycle
+  if (trajectory_pb_ == nullptr || trajectory_pb_.use_count() > 1) {
+    trajectory_pb_ = std::make_shared<ADCTrajectory>();
+  } else {
+    trajectory_pb_->Clear();
+  }
+  return trajectory_pb_;
+}
+
+void PlanningComponent::SampleRecordDebug() {
+  // the debug payload is the bulk of the message to fill and serialize
+  const uint64_t interval =
+      static_cast<uint64_t>(std::max(FLAGS_record_debug_cycle_interval, 1));
+  FLAGS_enable_record_debug = record_debug_ && num_cycles_ % interval == 0;
+  ++num_cycles_;
+}
+
 void PlanningComponent::CheckRerouting() {
   auto* rerouting =
       PlanningContext::MutablePlanningStatus()->mutable_rerouting();
@@ -164,8 +191,8 @@ void PlanningComponent::CheckRerouting() {
 }
 
 bool PlanningComponent::CheckInput() {
-  ADCTrajectory trajectory_pb;
-  auto* not_ready = trajectory_pb.mutable_decision()
+  auto trajectory_pb = std::make_shared<ADCTrajectory>();
+  auto* not_ready = trajectory_pb->mutable_decision()
                         ->mutable_main_decision()
                         ->mutable_not_ready();
 
@@ -191,8 +218,8 @@ bool PlanningComponent::CheckInput() {
 
   if (not_ready->has_reason()) {
     AERROR << not_ready->reason() << "; skip the planning cycle.";
-    common::util::FillHeader(node_->Name(), &trajectory_pb);
-    planning_writer_->Write(std::make_shared<ADCTrajectory>(trajectory_pb));
+    common::util::FillHeader(node_->Name(), trajectory_pb.get());
+    planning_writer_->Write(trajectory_pb);
     return false;
   }
   return true;
@@ -57,6 +57,18 @@ class PlanningComponent final
   void CheckRerouting();
   bool CheckInput();
 
+  /**
+   * @brief the trajectory message to fill in this cycle, the previous one is
+   * recycled when it has been released by all readers.
+   */
+  std::shared_ptr<ADCTrajectory> MutableTrajectory();
+
+  /**
+   * @brief turns FLAGS_enable_record_debug on for the sampled cycles only,
+   * see FLAGS_record_debug_cycle_interval.
+   */
+  void SampleRecordDebug();
+
   std::shared_ptr<cyber::Reader<perception::TrafficLightDetection>>
       traffic_light_reader_;
   std::shared_ptr<cyber::Reader<routing::RoutingResponse>> routing_reader_;
@@ -75,6 +87,11 @@ class PlanningComponent final
   LocalView local_view_;
 
   std::unique_ptr<PlanningBase> planning_base_;
+  std::shared_ptr<ADCTrajectory> trajectory_pb_;
+
+  // FLAGS_enable_record_debug as configured at Init.
+  bool record_debug_ = false;
+  uint64_t num_cycles_ = 0;
 
   PlanningConfig config_;
 };
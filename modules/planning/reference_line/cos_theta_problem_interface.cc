@@ -17,6 +17,7 @@
 #include "modules/planning/reference_line/cos_theta_problem_interface.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "cyber/common/log.h"
 
@@ -56,9 +57,6 @@ bool CosThetaProbleminterface::get_nlp_info(int& n, int& m, int& nnz_jac_g,
   nnz_h_lag = static_cast<int>(num_of_points_ * 11 - 12);
   nnz_h_lag_ = nnz_h_lag;
 
-  // load hessian structure
-  hessian_strcuture();
-
   index_style = IndexStyleEnum::C_STYLE;
   return true;
 }
@@ -149,6 +147,14 @@ bool CosThetaProbleminterface::get_starting_point(int n, bool init_x, double* x,
                                                   bool init_lambda,
                                                   double* lambda) {
   CHECK_EQ(static_cast<size_t>(n), num_of_variables_);
+  if (warm_start_points_.size() == num_of_points_) {
+    for (size_t i = 0; i < num_of_points_; ++i) {
+      size_t index = i << 1;
+      x[index] = warm_start_points_[i].x();
+      x[index + 1] = warm_start_points_[i].y();
+    }
+    return true;
+  }
   std::random_device rd;
   std::default_random_engine gen = std::default_random_engine(rd());
   std::normal_distribution<> dis{0, 0.05};
@@ -346,73 +352,73 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
       const double q1_sqrt_q1q2 = q1 * sqrt_q1q2;
       const double sqrt_q1_q2_sqrt_q2 = sqrt_q1 * q2_sqrt_q2;
       const double q1_sqrt_q1_q2_sqrt_q2 = q1_sqrt_q1 * q2_sqrt_q2;
-      values[idx_map_[std::make_pair(topleft, topleft)]] +=
+      values[hessian_index(topleft, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           (q3 / (4 * square_q1 * sqrt_q1q2) - q4 / q1_sqrt_q1q2 -
            (q5 * q13) / q1_sqrt_q1q2);
-      values[idx_map_[std::make_pair(topleft + 1, topleft)]] +=
+      values[hessian_index(topleft + 1, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((3 * q5 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) -
            (q6 * q13) / (2 * q1_sqrt_q1q2) - (q5 * q11) / (2 * q1_sqrt_q1q2));
-      values[idx_map_[std::make_pair(topleft + 2, topleft)]] +=
+      values[hessian_index(topleft + 2, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           (1 / sqrt_q1q2 + q4 / q1_sqrt_q1q2 - (q5 * q7) / (2 * q1_sqrt_q1q2) -
            q3 / (4 * square_q1 * sqrt_q1q2) + (q5 * q13) / (2 * q1_sqrt_q1q2) -
            (q8 * q13) / (2 * sqrt_q1_q2_sqrt_q2) +
            (q5 * q8 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 3, topleft)]] +=
+      values[hessian_index(topleft + 3, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q6 * q13) / (2 * q1_sqrt_q1q2) - (q5 * q10) / (2 * q1_sqrt_q1q2) -
            (q9 * q13) / (2 * sqrt_q1_q2_sqrt_q2) -
            (3 * q5 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) +
            (q5 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 4, topleft)]] +=
+      values[hessian_index(topleft + 4, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q5 * q12) / (2 * q1_sqrt_q1q2) - 1 / sqrt_q1q2 +
            (q8 * q13) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q5 * q8 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 5, topleft)]] +=
+      values[hessian_index(topleft + 5, topleft)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q5 * q14) / (2 * q1_sqrt_q1q2) +
            (q9 * q13) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q5 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
 
-      values[idx_map_[std::make_pair(topleft + 1, topleft + 1)]] +=
+      values[hessian_index(topleft + 1, topleft + 1)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((3 * q6 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) -
            q4 / q1_sqrt_q1q2 - (q6 * q11) / q1_sqrt_q1q2);
-      values[idx_map_[std::make_pair(topleft + 2, topleft + 1)]] +=
+      values[hessian_index(topleft + 2, topleft + 1)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q5 * q11) / (2 * q1_sqrt_q1q2) - (q6 * q7) / (2 * q1_sqrt_q1q2) -
            (q8 * q11) / (2 * sqrt_q1_q2_sqrt_q2) -
            (3 * q5 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) +
            (q8 * q6 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 3, topleft + 1)]] +=
+      values[hessian_index(topleft + 3, topleft + 1)] +=
           obj_factor * (-weight_cos_included_angle_) *
           (1 / sqrt_q1q2 + q4 / q1_sqrt_q1q2 - (q6 * q10) / (2 * q1_sqrt_q1q2) -
            (3 * q6 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) +
            (q6 * q11) / (2 * q1_sqrt_q1q2) -
            (q9 * q11) / (2 * sqrt_q1_q2_sqrt_q2) +
            (q6 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 4, topleft + 1)]] +=
+      values[hessian_index(topleft + 4, topleft + 1)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q6 * q12) / (2 * q1_sqrt_q1q2) +
            (q8 * q11) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q8 * q6 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 5, topleft + 1)]] +=
+      values[hessian_index(topleft + 5, topleft + 1)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q6 * q14) / (2 * q1_sqrt_q1q2) - 1 / sqrt_q1q2 +
            (q9 * q11) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q6 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
 
-      values[idx_map_[std::make_pair(topleft + 2, topleft + 2)]] +=
+      values[hessian_index(topleft + 2, topleft + 2)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q5 * q7) / q1_sqrt_q1q2 -
            q4 / (sqrt_q1_q2_sqrt_q2)-q4 / q1_sqrt_q1q2 - 2 / sqrt_q1q2 -
            (q8 * q7) / (sqrt_q1_q2_sqrt_q2) + q3 / (4 * square_q1 * sqrt_q1q2) +
            (3 * q8 * q8 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2) -
            (q5 * q8 * q4) / (2 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 3, topleft + 2)]] +=
+      values[hessian_index(topleft + 3, topleft + 2)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q6 * q7) / (2 * q1_sqrt_q1q2) -
            (q9 * q7) / (2 * sqrt_q1_q2_sqrt_q2) +
@@ -422,7 +428,7 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
            (q5 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2) -
            (q8 * q6 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2) +
            (3 * q8 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 4, topleft + 2)]] +=
+      values[hessian_index(topleft + 4, topleft + 2)] +=
           obj_factor * (-weight_cos_included_angle_) *
           (1 / sqrt_q1q2 + q4 / (sqrt_q1_q2_sqrt_q2) +
            (q8 * q7) / (2 * sqrt_q1_q2_sqrt_q2) -
@@ -430,7 +436,7 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
            (q5 * q12) / (2 * q1_sqrt_q1q2) +
            (q8 * q12) / (2 * sqrt_q1_q2_sqrt_q2) +
            (q5 * q8 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 5, topleft + 2)]] +=
+      values[hessian_index(topleft + 5, topleft + 2)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q9 * q7) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q5 * q14) / (2 * q1_sqrt_q1q2) +
@@ -438,7 +444,7 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
            (q5 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2) -
            (3 * q8 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2));
 
-      values[idx_map_[std::make_pair(topleft + 3, topleft + 3)]] +=
+      values[hessian_index(topleft + 3, topleft + 3)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q6 * q10) / q1_sqrt_q1q2 -
            q4 / (sqrt_q1_q2_sqrt_q2)-q4 / q1_sqrt_q1q2 - 2 / sqrt_q1q2 -
@@ -446,14 +452,14 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
            (3 * q6 * q6 * q4) / (4 * square_q1 * sqrt_q1q2) +
            (3 * q9 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2) -
            (q6 * q9 * q4) / (2 * q1_sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 4, topleft + 3)]] +=
+      values[hessian_index(topleft + 4, topleft + 3)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((q8 * q10) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q6 * q12) / (2 * q1_sqrt_q1q2) +
            (q9 * q12) / (2 * sqrt_q1_q2_sqrt_q2) +
            (q8 * q6 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2) -
            (3 * q8 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 5, topleft + 3)]] +=
+      values[hessian_index(topleft + 5, topleft + 3)] +=
           obj_factor * (-weight_cos_included_angle_) *
           (1 / sqrt_q1q2 + q4 / (sqrt_q1_q2_sqrt_q2) +
            (q9 * q10) / (2 * sqrt_q1_q2_sqrt_q2) -
@@ -462,17 +468,17 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
            (q9 * q14) / (2 * sqrt_q1_q2_sqrt_q2) +
            (q6 * q9 * q4) / (4 * q1_sqrt_q1_q2_sqrt_q2));
 
-      values[idx_map_[std::make_pair(topleft + 4, topleft + 4)]] +=
+      values[hessian_index(topleft + 4, topleft + 4)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((3 * q8 * q8 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2) -
            q4 / (sqrt_q1_q2_sqrt_q2) - (q8 * q12) / (sqrt_q1_q2_sqrt_q2));
-      values[idx_map_[std::make_pair(topleft + 5, topleft + 4)]] +=
+      values[hessian_index(topleft + 5, topleft + 4)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((3 * q8 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2) -
            (q9 * q12) / (2 * sqrt_q1_q2_sqrt_q2) -
            (q8 * q14) / (2 * sqrt_q1_q2_sqrt_q2));
 
-      values[idx_map_[std::make_pair(topleft + 5, topleft + 5)]] +=
+      values[hessian_index(topleft + 5, topleft + 5)] +=
           obj_factor * (-weight_cos_included_angle_) *
           ((3 * q9 * q9 * q4) / (4 * sqrt_q1 * square_q2 * sqrt_q2) -
            q4 / (sqrt_q1_q2_sqrt_q2) - (q9 * q14) / (sqrt_q1_q2_sqrt_q2));
@@ -480,7 +486,7 @@ bool CosThetaProbleminterface::eval_h(int n, const double* x, bool new_x,
 
     // fill the deviation part of obj
     for (size_t i = 0; i < num_of_variables_; ++i) {
-      values[idx_map_[std::make_pair(i, i)]] += obj_factor * 2;
+      values[hessian_index(i, i)] += obj_factor * 2;
     }
   }
   return true;
@@ -526,34 +532,22 @@ void CosThetaProbleminterface::set_weight_cos_included_angle(
   weight_cos_included_angle_ = weight_cos_included_angle;
 }
 
-void CosThetaProbleminterface::hessian_strcuture() {
-  size_t index = 0;
-  for (size_t i = 0; i < 6; ++i) {
-    for (size_t j = 0; j <= i; ++j) {
-      idx_map_.insert(std::pair<std::pair<size_t, size_t>, size_t>(
-          std::pair<size_t, size_t>(i, j), index));
-      index++;
-    }
-  }
-
-  size_t shift = 0;
-  for (size_t i = 6; i < num_of_variables_; ++i) {
-    if (i % 2 == 0) {
-      for (size_t j = 2 + shift; j <= 6 + shift; ++j) {
-        idx_map_.insert(std::pair<std::pair<size_t, size_t>, size_t>(
-            std::pair<size_t, size_t>(i, j), index));
-        index++;
-      }
+void CosThetaProbleminterface::set_warm_start_points(
+    std::vector<Eigen::Vector2d> points) {
+  warm_start_points_ = std::move(points);
+}
 
-    } else {
-      for (size_t j = 2 + shift; j <= 7 + shift; ++j) {
-        idx_map_.insert(std::pair<std::pair<size_t, size_t>, size_t>(
-            std::pair<size_t, size_t>(i, j), index));
-        index++;
-      }
-      shift += 2;
-    }
+size_t CosThetaProbleminterface::hessian_index(const size_t row,
+                                               const size_t col) const {
+  // the first three points have the full lower triangle
+  if (row < 6) {
+    return row * (row + 1) / 2 + col;
   }
+  // every later point adds a row of 5 and a row of 6 entries, both starting
+  // at the column of the x of the point two before
+  const size_t point = (row - 6) >> 1;
+  const size_t row_start = 21 + point * 11 + (row % 2 == 0 ? 0 : 5);
+  return row_start + col - (2 + (point << 1));
 }
 }  // namespace planning
 }  // namespace apollo
@@ -16,8 +16,6 @@
 
 #pragma once
 
-#include <map>
-#include <utility>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -49,6 +47,9 @@ class CosThetaProbleminterface : public Ipopt::TNLP {
 
   void set_relax_end_constraint(const double relax);
 
+  // start the optimization from these points instead of the perturbed input
+  void set_warm_start_points(std::vector<Eigen::Vector2d> points);
+
   void get_optimization_results(std::vector<double>* ptr_x,
                                 std::vector<double>* ptr_y) const;
 
@@ -118,9 +119,11 @@ class CosThetaProbleminterface : public Ipopt::TNLP {
 
   size_t num_of_points_ = 0;
 
-  std::map<std::pair<size_t, size_t>, size_t> idx_map_;
+  std::vector<Eigen::Vector2d> warm_start_points_;
 
-  void hessian_strcuture();
+  // index of the lower triangle entry (row, col) in the hessian values, the
+  // rows of the structure are laid out one after another
+  size_t hessian_index(const size_t row, const size_t col) const;
 
   double default_max_point_deviation_ = 0.0;
 
@@ -16,13 +16,17 @@
 
 #include "modules/planning/reference_line/cos_theta_reference_line_smoother.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "IpIpoptApplication.hpp"
 #include "IpSolveStatistics.hpp"
+#include "osqp/include/osqp.h"
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/common/math/line_segment2d.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -33,8 +37,26 @@
 namespace apollo {
 namespace planning {
 
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
 using apollo::common::time::Clock;
 
+namespace {
+
+// smallest eigenvalue the diagonal shift leaves the QP hessians with
+constexpr double kMinCurvature = 1e-3;
+
+// sufficient decrease of the objective along a QP step
+constexpr double kArmijoRatio = 1e-4;
+
+// the shortest step tried by the line search, relative to the QP step
+constexpr double kMinStepRatio = 1e-3;
+
+// the sequential QP has converged once no position moves farther
+constexpr double kSqpTolerance = 1e-3;
+
+}  // namespace
+
 CosThetaReferenceLineSmoother::CosThetaReferenceLineSmoother(
     const ReferenceLineSmootherConfig& config)
     : ReferenceLineSmoother(config) {
@@ -57,6 +79,13 @@ CosThetaReferenceLineSmoother::CosThetaReferenceLineSmoother(
   relax_ = config.cos_theta().relax();
 
   reopt_qp_bound_ = config.cos_theta().reopt_qp_bound();
+
+  warm_start_ = config.cos_theta().warm_start();
+
+  use_sqp_ = config.cos_theta().use_sqp();
+
+  sqp_max_iteration_ =
+      static_cast<size_t>(std::max(0, config.cos_theta().sqp_max_iteration()));
 }
 
 bool CosThetaReferenceLineSmoother::Smooth(
@@ -146,33 +175,52 @@ bool CosThetaReferenceLineSmoother::Smooth(
     ptop->set_end_point(scaled_point2d.back().x(), scaled_point2d.back().y());
   }
 
-  Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
+  std::vector<Eigen::Vector2d> warm_start_points;
+  const bool has_warm_start =
+      warm_start_ &&
+      WarmStartPoints(scaled_point2d, lateral_bounds, &warm_start_points);
+  if (has_warm_start) {
+    ptop->set_warm_start_points(std::move(warm_start_points));
+  }
 
-  // Create an instance of the IpoptApplication
-  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
-  app->Options()->SetIntegerValue("print_level", 1);
-  app->Options()->SetIntegerValue("max_iter",
-                                  static_cast<int>(num_of_iterations_));
-  app->Options()->SetNumericValue("acceptable_tol", acceptable_tol_);
+  Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
 
-  Ipopt::ApplicationReturnStatus status = app->Initialize();
-  if (status != Ipopt::Solve_Succeeded) {
-    AINFO << "*** Error during initialization!";
-    return false;
+  bool solved = false;
+  if (has_warm_start && use_sqp_) {
+    solved = SqpSmooth(ptop, &x, &y);
+    if (!solved) {
+      ADEBUG << "Sequential QP did not converge, solve by IPOPT.";
+    }
   }
 
-  status = app->OptimizeTNLP(problem);
+  if (!solved) {
+    // Create an instance of the IpoptApplication
+    Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
+    app->Options()->SetIntegerValue("print_level", 1);
+    app->Options()->SetIntegerValue("max_iter",
+                                    static_cast<int>(num_of_iterations_));
+    app->Options()->SetNumericValue("acceptable_tol", acceptable_tol_);
+
+    Ipopt::ApplicationReturnStatus status = app->Initialize();
+    if (status != Ipopt::Solve_Succeeded) {
+      AINFO << "*** Error during initialization!";
+      return false;
+    }
 
-  if (status == Ipopt::Solve_Succeeded ||
-      status == Ipopt::Solved_To_Acceptable_Level) {
-    // Retrieve some statistics about the solve
-    Ipopt::Index iter_count = app->Statistics()->IterationCount();
-    ADEBUG << "*** The problem solved in " << iter_count << " iterations!";
-  } else {
-    AINFO << "Return status: " << int(status);
-  }
+    status = app->OptimizeTNLP(problem);
 
-  ptop->get_optimization_results(&x, &y);
+    if (status == Ipopt::Solve_Succeeded ||
+        status == Ipopt::Solved_To_Acceptable_Level) {
+      // Retrieve some statistics about the solve
+      Ipopt::Index iter_count = app->Statistics()->IterationCount();
+      ADEBUG << "*** The problem solved in " << iter_count << " iterations!";
+      solved = true;
+    } else {
+      AINFO << "Return status: " << int(status);
+    }
+
+    ptop->get_optimization_results(&x, &y);
+  }
   // load the point position and estimated derivatives at each point
   if (x.size() < 2 || y.size() < 2) {
     AINFO << "Return by IPOPT is wrong. Size smaller than 2 ";
@@ -218,8 +266,253 @@ bool CosThetaReferenceLineSmoother::Smooth(
     Fx = Nx;
     Fy = Ny;
   }
-  return status == Ipopt::Solve_Succeeded ||
-         status == Ipopt::Solved_To_Acceptable_Level;
+  if (solved) {
+    last_smoothed_points_.clear();
+    for (const auto& point : *ptr_smoothed_point2d) {
+      last_smoothed_points_.emplace_back(point.x(), point.y());
+    }
+  }
+  return solved;
+}
+
+bool CosThetaReferenceLineSmoother::WarmStartPoints(
+    const std::vector<Eigen::Vector2d>& scaled_point2d,
+    const std::vector<double>& lateral_bounds,
+    std::vector<Eigen::Vector2d>* warm_start_points) const {
+  warm_start_points->clear();
+  if (last_smoothed_points_.size() < 2) {
+    return false;
+  }
+  const size_t num_of_points = scaled_point2d.size();
+  bool any_in_reach = false;
+  size_t segment = 0;
+  for (size_t i = 0; i < num_of_points; ++i) {
+    const Vec2d point(scaled_point2d[i].x() + zero_x_,
+                      scaled_point2d[i].y() + zero_y_);
+    // both the anchor points and the last smoothed points go along the
+    // reference line, so the nearest segment is searched for onwards from
+    // the one of the anchor point before
+    Vec2d nearest;
+    double distance = LineSegment2d(last_smoothed_points_[segment],
+                                    last_smoothed_points_[segment + 1])
+                          .DistanceTo(point, &nearest);
+    while (segment + 2 < last_smoothed_points_.size()) {
+      Vec2d next_nearest;
+      const double next_distance =
+          LineSegment2d(last_smoothed_points_[segment + 1],
+                        last_smoothed_points_[segment + 2])
+              .DistanceTo(point, &next_nearest);
+      if (next_distance > distance) {
+        break;
+      }
+      ++segment;
+      distance = next_distance;
+      nearest = next_nearest;
+    }
+
+    double bound = std::min(lateral_bounds[i], max_point_deviation_);
+    if ((i == 0 && has_start_point_constraint_) ||
+        (i + 1 == num_of_points && has_end_point_constraint_)) {
+      bound = relax_;
+    }
+    // within the box of the positional deviation constraints
+    if (distance <= bound / std::sqrt(2.0)) {
+      any_in_reach = true;
+      warm_start_points->emplace_back(nearest.x() - zero_x_,
+                                      nearest.y() - zero_y_);
+    } else {
+      warm_start_points->push_back(scaled_point2d[i]);
+    }
+  }
+  return any_in_reach;
+}
+
+bool CosThetaReferenceLineSmoother::SqpSmooth(
+    CosThetaProbleminterface* problem, std::vector<double>* ptr_x,
+    std::vector<double>* ptr_y) const {
+  int n = 0;
+  int m = 0;
+  int nnz_jac_g = 0;
+  int nnz_h_lag = 0;
+  Ipopt::TNLP::IndexStyleEnum index_style;
+  problem->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+  const size_t num_of_variables = static_cast<size_t>(n);
+  const size_t num_of_hessian = static_cast<size_t>(nnz_h_lag);
+
+  // the constraints are the positions themselves, so together with the
+  // variable bounds they make one box
+  std::vector<double> x_l(num_of_variables);
+  std::vector<double> x_u(num_of_variables);
+  std::vector<double> g_l(static_cast<size_t>(m));
+  std::vector<double> g_u(static_cast<size_t>(m));
+  problem->get_bounds_info(n, x_l.data(), x_u.data(), m, g_l.data(),
+                           g_u.data());
+  std::vector<double> x(num_of_variables);
+  problem->get_starting_point(n, true, x.data(), false, nullptr, nullptr, m,
+                              false, nullptr);
+  for (size_t i = 0; i < num_of_variables; ++i) {
+    x_l[i] = std::max(x_l[i], g_l[i]);
+    x_u[i] = std::min(x_u[i], g_u[i]);
+    x[i] = std::min(std::max(x[i], x_l[i]), x_u[i]);
+  }
+
+  // the lower triangle of the hessian row by row is the upper triangle
+  // column by column, which is the form OSQP takes, with the diagonal entry
+  // last in each column
+  std::vector<int> rows(num_of_hessian);
+  std::vector<int> cols(num_of_hessian);
+  problem->eval_h(n, x.data(), true, 1.0, m, nullptr, true, nnz_h_lag,
+                  rows.data(), cols.data(), nullptr);
+  std::vector<c_int> P_indices(cols.begin(), cols.end());
+  std::vector<c_int> P_indptr(num_of_variables + 1, 0);
+  for (const int row : rows) {
+    ++P_indptr[static_cast<size_t>(row) + 1];
+  }
+  for (size_t i = 0; i < num_of_variables; ++i) {
+    P_indptr[i + 1] += P_indptr[i];
+  }
+  // the constraint matrix is the identity
+  std::vector<c_float> A_data(num_of_variables, 1.0);
+  std::vector<c_int> A_indices(num_of_variables);
+  std::vector<c_int> A_indptr(num_of_variables + 1);
+  for (size_t i = 0; i <= num_of_variables; ++i) {
+    if (i < num_of_variables) {
+      A_indices[i] = static_cast<c_int>(i);
+    }
+    A_indptr[i] = static_cast<c_int>(i);
+  }
+
+  OSQPSettings* settings =
+      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
+  osqp_set_default_settings(settings);
+  settings->eps_abs = 1.0e-05;
+  settings->eps_rel = 1.0e-05;
+  settings->polish = true;
+  settings->verbose = FLAGS_enable_osqp_debug;
+  OSQPWorkspace* work = nullptr;
+
+  std::vector<double> hessian(num_of_hessian);
+  std::vector<double> gradient(num_of_variables);
+  std::vector<double> radius(num_of_variables);
+  std::vector<double> x_new(num_of_variables);
+  std::vector<c_float> P_data(num_of_hessian);
+  std::vector<c_float> q(num_of_variables);
+  std::vector<c_float> l(num_of_variables);
+  std::vector<c_float> u(num_of_variables);
+  bool converged = false;
+  for (size_t iter = 0; iter < sqp_max_iteration_ && !converged; ++iter) {
+    double obj_value = 0.0;
+    problem->eval_f(n, x.data(), true, obj_value);
+    problem->eval_grad_f(n, x.data(), false, gradient.data());
+    problem->eval_h(n, x.data(), false, 1.0, m, nullptr, false, nnz_h_lag,
+                    nullptr, nullptr, hessian.data());
+
+    // shift the diagonal until every Gershgorin disc is positive, so that
+    // the QP is convex where the included angle terms are not
+    std::fill(radius.begin(), radius.end(), 0.0);
+    for (size_t k = 0; k < num_of_hessian; ++k) {
+      if (rows[k] != cols[k]) {
+        radius[static_cast<size_t>(rows[k])] += std::abs(hessian[k]);
+        radius[static_cast<size_t>(cols[k])] += std::abs(hessian[k]);
+      }
+    }
+    double shift = 0.0;
+    for (size_t i = 0; i < num_of_variables; ++i) {
+      const double diagonal =
+          hessian[static_cast<size_t>(P_indptr[i + 1] - 1)];
+      shift = std::max(shift, radius[i] + kMinCurvature - diagonal);
+    }
+    std::copy(hessian.begin(), hessian.end(), P_data.begin());
+    for (size_t i = 0; i < num_of_variables; ++i) {
+      P_data[static_cast<size_t>(P_indptr[i + 1] - 1)] += shift;
+      q[i] = gradient[i];
+      l[i] = x_l[i] - x[i];
+      u[i] = x_u[i] - x[i];
+    }
+
+    // the sparsity stays, so later iterations only update the values
+    if (work == nullptr) {
+      OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+      data->n = n;
+      data->m = n;
+      data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
+                           P_indices.data(), P_indptr.data());
+      data->q = q.data();
+      data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
+                           A_indices.data(), A_indptr.data());
+      data->l = l.data();
+      data->u = u.data();
+      work = osqp_setup(data, settings);
+      c_free(data->A);
+      c_free(data->P);
+      c_free(data);
+      if (work == nullptr) {
+        AERROR << "Failed to set up the sequential QP.";
+        break;
+      }
+    } else {
+      osqp_update_P(work, P_data.data(), OSQP_NULL,
+                    static_cast<c_int>(P_data.size()));
+      osqp_update_lin_cost(work, q.data());
+      osqp_update_bounds(work, l.data(), u.data());
+    }
+    osqp_solve(work);
+    if (work->info->status_val != OSQP_SOLVED) {
+      ADEBUG << "Sequential QP failed at iteration " << iter;
+      break;
+    }
+
+    // backtrack along the QP step until the objective decreases enough
+    const c_float* step = work->solution->x;
+    double directional_derivative = 0.0;
+    for (size_t i = 0; i < num_of_variables; ++i) {
+      directional_derivative += gradient[i] * step[i];
+    }
+    double step_ratio = 1.0;
+    bool accepted = false;
+    while (step_ratio >= kMinStepRatio) {
+      for (size_t i = 0; i < num_of_variables; ++i) {
+        x_new[i] = std::min(std::max(x[i] + step_ratio * step[i], x_l[i]),
+                            x_u[i]);
+      }
+      double new_obj_value = 0.0;
+      problem->eval_f(n, x_new.data(), true, new_obj_value);
+      if (new_obj_value <=
+          obj_value + kArmijoRatio * step_ratio * directional_derivative) {
+        accepted = true;
+        break;
+      }
+      step_ratio *= 0.5;
+    }
+    if (!accepted) {
+      ADEBUG << "Sequential QP line search failed at iteration " << iter;
+      break;
+    }
+
+    double max_move = 0.0;
+    for (size_t i = 0; i < num_of_variables; ++i) {
+      max_move = std::max(max_move, std::abs(x_new[i] - x[i]));
+    }
+    x.swap(x_new);
+    converged = max_move < kSqpTolerance;
+  }
+
+  if (work != nullptr) {
+    osqp_cleanup(work);
+  }
+  c_free(settings);
+  if (!converged) {
+    return false;
+  }
+
+  const size_t num_of_points = num_of_variables >> 1;
+  ptr_x->resize(num_of_points);
+  ptr_y->resize(num_of_points);
+  for (size_t i = 0; i < num_of_points; ++i) {
+    (*ptr_x)[i] = x[i << 1];
+    (*ptr_y)[i] = x[(i << 1) + 1];
+  }
+  return true;
 }
 
 common::PathPoint CosThetaReferenceLineSmoother::to_path_point(
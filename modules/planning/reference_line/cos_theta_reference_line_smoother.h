@@ -21,6 +21,7 @@
 
 #include "Eigen/Dense"
 
+#include "modules/common/math/vec2d.h"
 #include "modules/planning/math/curve_math.h"
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/reference_line/reference_line.h"
@@ -30,6 +31,8 @@
 namespace apollo {
 namespace planning {
 
+class CosThetaProbleminterface;
+
 class CosThetaReferenceLineSmoother : public ReferenceLineSmoother {
  public:
   explicit CosThetaReferenceLineSmoother(
@@ -47,6 +50,20 @@ class CosThetaReferenceLineSmoother : public ReferenceLineSmoother {
               const std::vector<double>& lateral_bounds,
               std::vector<common::PathPoint>* ptr_smoothed_point2d);
 
+  // Projects the scaled anchor points on the smoothed points of the last
+  // cycle, anchor points out of their reach are kept as they are. Returns
+  // whether any anchor point is within reach.
+  bool WarmStartPoints(const std::vector<Eigen::Vector2d>& scaled_point2d,
+                       const std::vector<double>& lateral_bounds,
+                       std::vector<Eigen::Vector2d>* warm_start_points) const;
+
+  // Sequential QP from the starting point of the problem. Its constraints
+  // only bound the point positions, so each QP on the convexified hessian is
+  // box constrained and solved by OSQP. Returns false when it does not
+  // converge within sqp_max_iteration_.
+  bool SqpSmooth(CosThetaProbleminterface* problem, std::vector<double>* ptr_x,
+                 std::vector<double>* ptr_y) const;
+
   common::PathPoint to_path_point(const double x, const double y,
                                   const double x_derivative,
                                   const double y_derivative) const;
@@ -82,6 +99,15 @@ class CosThetaReferenceLineSmoother : public ReferenceLineSmoother {
   double zero_y_ = 0.0;
 
   double reopt_qp_bound_ = 0.0;
+
+  bool warm_start_ = false;
+
+  bool use_sqp_ = false;
+
+  size_t sqp_max_iteration_ = 10;
+
+  // unscaled smoothed points of the last successful smoothing
+  std::vector<common::math::Vec2d> last_smoothed_points_;
 };
 
 }  // namespace planning
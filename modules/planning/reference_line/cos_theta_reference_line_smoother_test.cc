@@ -96,5 +96,33 @@ TEST_F(CosThetaReferenceLineSmootherTest, smooth) {
   EXPECT_NEAR(153.0, smoothed_reference_line.Length(), 1.0);
 }
 
+TEST_F(CosThetaReferenceLineSmootherTest, smooth_warm_started) {
+  config_.mutable_cos_theta()->set_warm_start(true);
+  config_.mutable_cos_theta()->set_use_sqp(true);
+  smoother_.reset(new CosThetaReferenceLineSmoother(config_));
+  std::vector<AnchorPoint> anchor_points;
+  const double interval = 10.0;
+  int num_of_anchors =
+      std::max(2, static_cast<int>(reference_line_->Length() / interval + 0.5));
+  std::vector<double> anchor_s;
+  common::util::uniform_slice(0.0, reference_line_->Length(),
+                              num_of_anchors - 1, &anchor_s);
+  for (const double s : anchor_s) {
+    anchor_points.emplace_back();
+    auto& last_anchor = anchor_points.back();
+    auto ref_point = reference_line_->GetReferencePoint(s);
+    last_anchor.path_point = ref_point.ToPathPoint(s);
+    last_anchor.lateral_bound = 0.25;
+    last_anchor.longitudinal_bound = 2.0;
+  }
+  // the second smoothing starts from the result of the first one
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    ReferenceLine smoothed_reference_line;
+    smoother_->SetAnchorPoints(anchor_points);
+    EXPECT_TRUE(smoother_->Smooth(*reference_line_, &smoothed_reference_line));
+    EXPECT_NEAR(153.0, smoothed_reference_line.Length(), 1.0);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -697,10 +697,14 @@ std::string ReferenceLine::DebugString() const {
 }
 
 double ReferenceLine::GetSpeedLimitFromS(const double s) const {
-  for (const auto& speed_limit : speed_limit_) {
-    if (s >= speed_limit.start_s && s <= speed_limit.end_s) {
-      return speed_limit.speed_limit;
-    }
+  // speed_limit_ is sorted and its ranges do not overlap, so the first range
+  // ending at or after s is the only one that may contain s
+  auto iter = std::lower_bound(speed_limit_.begin(), speed_limit_.end(), s,
+                               [](const SpeedLimit& limit, const double s) {
+                                 return limit.end_s < s;
+                               });
+  if (iter != speed_limit_.end() && s >= iter->start_s) {
+    return iter->speed_limit;
   }
   const auto& map_path_point = GetReferencePoint(s);
   double speed_limit = FLAGS_planning_upper_speed_limit;
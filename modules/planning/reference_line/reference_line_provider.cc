@@ -22,6 +22,7 @@
 #include "modules/planning/reference_line/reference_line_provider.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <utility>
 
@@ -30,6 +31,7 @@
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
+#include "modules/common/util/string_util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/pnc_map/path.h"
@@ -49,6 +51,7 @@ using apollo::common::VehicleState;
 using apollo::common::math::AngleDiff;
 using apollo::common::math::Vec2d;
 using apollo::common::time::Clock;
+using apollo::common::util::StrCat;
 using apollo::hdmap::HDMapUtil;
 using apollo::hdmap::LaneWaypoint;
 using apollo::hdmap::MapPathPoint;
@@ -843,8 +846,68 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
+  if (FLAGS_reference_line_smoothing_cache_size <= 0) {
+    hdmap::Path path(segments);
+    return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  }
+  const std::string key = SmoothingCacheKey(segments);
+  if (GetCachedReferenceLine(key, reference_line)) {
+    ADEBUG << "Reuse smoothed reference line, cache hit rate: "
+           << SmoothingCacheHitRate();
+    return true;
+  }
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  if (!SmoothReferenceLine(ReferenceLine(path), reference_line)) {
+    return false;
+  }
+  CacheReferenceLine(key, *reference_line);
+  return true;
+}
+
+std::string ReferenceLineProvider::SmoothingCacheKey(
+    const RouteSegments &segments) {
+  std::string key;
+  for (const auto &segment : segments) {
+    key += StrCat(segment.lane->id().id(), ":",
+                  std::lround(segment.start_s * 100.0), ":",
+                  std::lround(segment.end_s * 100.0), ";");
+  }
+  return key;
+}
+
+bool ReferenceLineProvider::GetCachedReferenceLine(
+    const std::string &key, ReferenceLine *reference_line) {
+  ++smoothing_cache_lookups_;
+  std::lock_guard<std::mutex> lock(smoothing_cache_mutex_);
+  for (auto iter = smoothing_cache_.begin(); iter != smoothing_cache_.end();
+       ++iter) {
+    if (iter->first == key) {
+      smoothing_cache_.splice(smoothing_cache_.begin(), smoothing_cache_, iter);
+      *reference_line = smoothing_cache_.front().second;
+      ++smoothing_cache_hits_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReferenceLineProvider::CacheReferenceLine(
+    const std::string &key, const ReferenceLine &reference_line) {
+  std::lock_guard<std::mutex> lock(smoothing_cache_mutex_);
+  smoothing_cache_.emplace_front(key, reference_line);
+  while (smoothing_cache_.size() >
+         static_cast<size_t>(FLAGS_reference_line_smoothing_cache_size)) {
+    smoothing_cache_.pop_back();
+  }
+}
+
+double ReferenceLineProvider::SmoothingCacheHitRate() const {
+  const uint64_t lookups = smoothing_cache_lookups_.load();
+  if (lookups == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(smoothing_cache_hits_.load()) /
+         static_cast<double>(lookups);
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
@@ -27,6 +27,7 @@
 #include <queue>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "cyber/cyber.h"
@@ -84,6 +85,11 @@ class ReferenceLineProvider {
 
   std::vector<routing::LaneWaypoint> FutureRouteWaypoints();
 
+  /**
+   * @brief fraction of full route segment smoothing served from the cache.
+   */
+  double SmoothingCacheHitRate() const;
+
  private:
   /**
    * @brief Use PncMap to create reference line and the corresponding segments
@@ -125,6 +131,18 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief key of the smoothing cache: lane ids with their start_s and end_s
+   * rounded to centimeters.
+   */
+  static std::string SmoothingCacheKey(const hdmap::RouteSegments& segments);
+
+  bool GetCachedReferenceLine(const std::string& key,
+                              ReferenceLine* reference_line);
+
+  void CacheReferenceLine(const std::string& key,
+                          const ReferenceLine& reference_line);
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -181,6 +199,12 @@ class ReferenceLineProvider {
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
 
   std::future<void> task_future_;
+
+  // most recently used smoothed route segments first
+  std::mutex smoothing_cache_mutex_;
+  std::list<std::pair<std::string, ReferenceLine>> smoothing_cache_;
+  std::atomic<uint64_t> smoothing_cache_lookups_{0};
+  std::atomic<uint64_t> smoothing_cache_hits_{0};
 };
 
 }  // namespace planning
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/string_tokenizer.h"
@@ -111,6 +112,12 @@ void LaneFollowStage::RecordDebugInfo(ReferenceLineInfo* reference_line_info,
 
 Stage::StageStatus LaneFollowStage::Process(
     const TrajectoryPoint& planning_start_point, Frame* frame) {
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      frame->mutable_reference_line_info()->size() > 1) {
+    return PlanInParallel(planning_start_point, frame) ? StageStatus::RUNNING
+                                                       : StageStatus::ERROR;
+  }
+
   bool has_drivable_reference_line = false;
   bool disable_low_priority_path = false;
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -137,9 +144,77 @@ Stage::StageStatus LaneFollowStage::Process(
                                      : StageStatus::ERROR;
 }
 
+bool LaneFollowStage::PlanInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    if (reference_line_info.IsDrivable()) {
+      reference_line_infos.push_back(&reference_line_info);
+    }
+  }
+  if (reference_line_infos.empty()) {
+    return false;
+  }
+  // create all task instances first, growing the lists moves them
+  LineTaskList(reference_line_infos.size() - 1);
+  std::vector<const std::vector<Task*>*> task_lists;
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    task_lists.push_back(&LineTaskList(i));
+  }
+
+  std::vector<Status> statuses(reference_line_infos.size());
+  cyber::ParallelFor(0, reference_line_infos.size(), 1, [&](size_t i) {
+    statuses[i] = PlanOnReferenceLine(planning_start_point, frame,
+                                      reference_line_infos[i], *task_lists[i]);
+  });
+
+  // same selection as the sequential loop, lines after a preferred lane
+  // change are dropped even though they were planned
+  bool has_drivable_reference_line = false;
+  bool disable_low_priority_path = false;
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    auto* reference_line_info = reference_line_infos[i];
+    if (disable_low_priority_path) {
+      reference_line_info->SetDrivable(false);
+      continue;
+    }
+    if (statuses[i].ok() && reference_line_info->IsDrivable()) {
+      has_drivable_reference_line = true;
+      if (FLAGS_prioritize_change_lane &&
+          reference_line_info->IsChangeLanePath() &&
+          reference_line_info->Cost() < kStraightForwardLineCost) {
+        disable_low_priority_path = true;
+      }
+    } else {
+      reference_line_info->SetDrivable(false);
+    }
+  }
+  return has_drivable_reference_line;
+}
+
+const std::vector<Task*>& LaneFollowStage::LineTaskList(size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  while (line_task_lists_.size() < index) {
+    line_tasks_.emplace_back();
+    line_task_lists_.emplace_back();
+    CreateTasks(&line_tasks_.back(), &line_task_lists_.back());
+  }
+  return line_task_lists_[index - 1];
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             task_list_);
+}
+
+Status LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    const std::vector<Task*>& task_list) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -156,7 +231,10 @@ Status LaneFollowStage::PlanOnReferenceLine(
 
   auto ret = Status::OK();
 
-  for (auto* optimizer : task_list_) {
+  for (auto* optimizer : task_list) {
+    if (frame->latency_budget().SkipTask(optimizer->Config())) {
+      continue;
+    }
     const double start_timestamp = Clock::NowInSeconds();
     ret = optimizer->Execute(frame, reference_line_info);
     if (!ret.ok()) {
@@ -164,6 +242,7 @@ Status LaneFollowStage::PlanOnReferenceLine(
              << "], Error message: " << ret.error_message();
       break;
     }
+    frame->mutable_latency_budget()->CheckTask(optimizer->Config());
     const double end_timestamp = Clock::NowInSeconds();
     const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
 
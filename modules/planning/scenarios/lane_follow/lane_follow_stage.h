@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -65,8 +66,25 @@ class LaneFollowStage : public Stage {
                        const std::string& name, const double time_diff_ms);
 
  private:
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>& task_list);
+
+  // plans all drivable reference lines at once, the priority of the lines
+  // is applied after all of them are done
+  bool PlanInParallel(const common::TrajectoryPoint& planning_start_point,
+                      Frame* frame);
+
+  // tasks keep state while they run, so every reference line planned in
+  // parallel beyond the first needs its own instances
+  const std::vector<Task*>& LineTaskList(size_t index);
+
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      line_tasks_;
+  std::vector<std::vector<Task*>> line_task_lists_;
 };
 
 }  // namespace lane_follow
@@ -189,35 +189,27 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectTrafficLightScenario(
   const bool left_turn =
       (reference_line_info.GetPathTurnType() == hdmap::Lane::LEFT_TURN);
 
-  bool traffic_light_scenario = false;
   bool red_light = false;
-  const std::vector<PathOverlap>& traffic_light_overlaps =
-      reference_line_info.reference_line().map_path().signal_overlaps();
+  const auto traffic_light_overlaps = overlap_index_.OverlapsInRange(
+      ScenarioOverlapIndex::SIGNAL, adc_front_edge_s,
+      adc_front_edge_s + config_map_[ScenarioConfig::TRAFFIC_LIGHT_PROTECTED]
+                             .traffic_light_protected_config()
+                             .start_traffic_light_scenario_distance());
+  const bool traffic_light_scenario = !traffic_light_overlaps.empty();
+  ADEBUG << "traffic_lights_ahead[" << traffic_light_overlaps.size()
+         << "] right_turn[" << right_turn << "] left_turn[" << left_turn
+         << "]";
 
   // note: need iterate all lights to check no RED
-  for (const auto& traffic_light_overlap : traffic_light_overlaps) {
-    const double adc_distance_to_traffic_light =
-        traffic_light_overlap.start_s - adc_front_edge_s;
-    ADEBUG << "adc_distance_to_traffic_light[" << adc_distance_to_traffic_light
-           << "] right_turn[" << right_turn << "] left_turn[" << left_turn
-           << "]";
-
-    // check distance
-    if (adc_distance_to_traffic_light > 0 &&
-        adc_distance_to_traffic_light <=
-            config_map_[ScenarioConfig::TRAFFIC_LIGHT_PROTECTED]
-                .traffic_light_protected_config()
-                .start_traffic_light_scenario_distance()) {
-      traffic_light_scenario = true;
-      auto signal_color =
-          scenario::GetSignal(traffic_light_overlap.object_id).color();
-      ADEBUG << "traffic_light_id[" << traffic_light_overlap.object_id
-          << "] start_s[" << traffic_light_overlap.start_s
-          << "] color[" << signal_color << "]";
-      if (signal_color != TrafficLight::GREEN) {
-        red_light = true;
-        break;
-      }
+  for (const auto* traffic_light_overlap : traffic_light_overlaps) {
+    auto signal_color =
+        scenario::GetSignal(traffic_light_overlap->object_id).color();
+    ADEBUG << "traffic_light_id[" << traffic_light_overlap->object_id
+        << "] start_s[" << traffic_light_overlap->start_s
+        << "] color[" << signal_color << "]";
+    if (signal_color != TrafficLight::GREEN) {
+      red_light = true;
+      break;
     }
   }
 
@@ -273,6 +265,27 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectSidePassScenario(
   return ScenarioConfig::LANE_FOLLOW;
 }
 
+bool ScenarioManager::HasIntersectionTriggerAhead(const Frame& frame) {
+  const double adc_front_edge_s =
+      frame.reference_line_info().front().AdcSlBoundary().end_s();
+  const double stop_sign_distance =
+      config_map_[ScenarioConfig::STOP_SIGN_UNPROTECTED]
+          .stop_sign_unprotected_config()
+          .start_stop_sign_scenario_distance();
+  const double traffic_light_distance =
+      config_map_[ScenarioConfig::TRAFFIC_LIGHT_PROTECTED]
+          .traffic_light_protected_config()
+          .start_traffic_light_scenario_distance();
+  return overlap_index_.HasOverlapInRange(ScenarioOverlapIndex::STOP_SIGN,
+                                          adc_front_edge_s,
+                                          adc_front_edge_s +
+                                              stop_sign_distance) ||
+         overlap_index_.HasOverlapInRange(ScenarioOverlapIndex::SIGNAL,
+                                          adc_front_edge_s,
+                                          adc_front_edge_s +
+                                              traffic_light_distance);
+}
+
 /*
  * @brief: function called by ScenarioSelfVote(),
  *         which selects scenario based on vote from each individual scenario.
@@ -316,6 +329,7 @@ void ScenarioManager::Observe(const Frame& frame) {
   // init first_encountered_overlap_map_
   first_encountered_overlap_map_.clear();
   const auto& reference_line_info = frame.reference_line_info().front();
+  overlap_index_.Build(reference_line_info.reference_line().map_path());
   const auto& first_encountered_overlaps =
       reference_line_info.FirstEncounteredOverlaps();
   for (const auto& overlap : first_encountered_overlaps) {
@@ -404,7 +418,12 @@ void ScenarioManager::ScenarioDispatch(const common::TrajectoryPoint& ego_point,
 
   ////////////////////////////////////////
   // intersection scenarios
-  if (scenario_type == default_scenario_type_) {
+  // from the default scenario they only start with a stop sign or signal
+  // ahead, which saves evaluating them on most cycles
+  const bool check_intersection =
+      current_scenario_->scenario_type() != default_scenario_type_ ||
+      HasIntersectionTriggerAhead(frame);
+  if (scenario_type == default_scenario_type_ && check_intersection) {
     hdmap::PathOverlap* stop_sign_overlap = nullptr;
     auto map_itr =
         first_encountered_overlap_map_.find(ReferenceLineInfo::STOP_SIGN);
@@ -619,8 +638,6 @@ void ScenarioManager::UpdatePlanningContext(
 // update: PlanningContext::GetScenarioInfo()->current_stop_sign_overlap
 void ScenarioManager::UpdatePlanningContextStopSignScenario(
     const Frame& frame, const ScenarioConfig::ScenarioType& scenario_type) {
-  const auto& reference_line_info = frame.reference_line_info().front();
-
   if (scenario_type != current_scenario_->scenario_type()) {
     PlanningContext::GetScenarioInfo()->current_stop_sign_overlap =
         PathOverlap();
@@ -642,15 +659,9 @@ void ScenarioManager::UpdatePlanningContextStopSignScenario(
 
     PlanningContext::GetScenarioInfo()->current_stop_sign_overlap =
         PathOverlap();
-    const std::vector<PathOverlap>& stop_sign_overlaps =
-        reference_line_info.reference_line().map_path().stop_sign_overlaps();
-    auto stop_sign_overlap_itr =
-        std::find_if(stop_sign_overlaps.begin(), stop_sign_overlaps.end(),
-            [&current_stop_sign_overlap_id](
-                  const hdmap::PathOverlap& overlap) {
-                return overlap.object_id == current_stop_sign_overlap_id;
-              });
-    if (stop_sign_overlap_itr != stop_sign_overlaps.end()) {
+    const PathOverlap* stop_sign_overlap_itr = overlap_index_.Find(
+        ScenarioOverlapIndex::STOP_SIGN, current_stop_sign_overlap_id);
+    if (stop_sign_overlap_itr != nullptr) {
       PlanningContext::GetScenarioInfo()->current_stop_sign_overlap =
           *stop_sign_overlap_itr;
       ADEBUG << "refresh PlanningContext with current stop sign["
@@ -693,13 +704,10 @@ void ScenarioManager::UpdatePlanningContextTrafficLightScenario(
 
   const std::vector<PathOverlap>& traffic_light_overlaps =
       reference_line_info.reference_line().map_path().signal_overlaps();
-  auto traffic_light_overlap_itr = std::find_if(
-      traffic_light_overlaps.begin(), traffic_light_overlaps.end(),
-      [&current_traffic_light_overlap_id](const hdmap::PathOverlap& overlap) {
-        return overlap.object_id == current_traffic_light_overlap_id;
-      });
+  const PathOverlap* traffic_light_overlap_itr = overlap_index_.Find(
+      ScenarioOverlapIndex::SIGNAL, current_traffic_light_overlap_id);
   double current_traffic_light_overlap_start_s;
-  if (traffic_light_overlap_itr != traffic_light_overlaps.end()) {
+  if (traffic_light_overlap_itr != nullptr) {
     current_traffic_light_overlap_start_s = traffic_light_overlap_itr->start_s;
   }
 
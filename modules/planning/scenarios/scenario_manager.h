@@ -24,6 +24,7 @@
 
 #include "modules/common/status/status.h"
 #include "modules/planning/scenarios/scenario.h"
+#include "modules/planning/scenarios/scenario_overlap_index.h"
 
 namespace apollo {
 namespace planning {
@@ -56,6 +57,10 @@ class ScenarioManager final {
       const hdmap::PathOverlap& first_encountered_traffic_Light_overlap);
   ScenarioConfig::ScenarioType SelectSidePassScenario(const Frame& frame);
 
+  // whether a stop sign or signal starts within the distance the
+  // intersection scenarios start at
+  bool HasIntersectionTriggerAhead(const Frame& frame);
+
   // functions for scenario voter implementation
   // do NOT delete the code yet
   // void ScenarioSelfVote(const common::TrajectoryPoint& ego_point,
@@ -94,6 +99,7 @@ class ScenarioManager final {
   std::unordered_map<ReferenceLineInfo::OverlapType,
                      hdmap::PathOverlap,
                      std::hash<int>> first_encountered_overlap_map_;
+  ScenarioOverlapIndex overlap_index_;
 
   // TODO(all): move to scenario conf later
   const double signal_expire_time_sec_ = 5.0;  // sec
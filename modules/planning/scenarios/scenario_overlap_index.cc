@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/scenarios/scenario_overlap_index.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace planning {
+namespace scenario {
+
+using apollo::hdmap::PathOverlap;
+
+void ScenarioOverlapIndex::Build(const hdmap::Path& path) {
+  SetOverlaps(STOP_SIGN, path.stop_sign_overlaps());
+  SetOverlaps(SIGNAL, path.signal_overlaps());
+  SetOverlaps(PNC_JUNCTION, path.pnc_junction_overlaps());
+  SetOverlaps(PARKING_SPACE, path.parking_space_overlaps());
+}
+
+void ScenarioOverlapIndex::Clear() {
+  for (auto& overlaps : overlaps_) {
+    overlaps.sorted.clear();
+    overlaps.index_by_id.clear();
+  }
+}
+
+void ScenarioOverlapIndex::SetOverlaps(
+    OverlapType type, const std::vector<PathOverlap>& overlaps) {
+  auto& indexed = overlaps_[type];
+  indexed.sorted = overlaps;
+  std::stable_sort(indexed.sorted.begin(), indexed.sorted.end(),
+                   [](const PathOverlap& lhs, const PathOverlap& rhs) {
+                     return lhs.start_s < rhs.start_s;
+                   });
+  indexed.index_by_id.clear();
+  for (size_t i = 0; i < indexed.sorted.size(); ++i) {
+    // keep the nearest one of a duplicated id
+    indexed.index_by_id.emplace(indexed.sorted[i].object_id, i);
+  }
+}
+
+std::vector<PathOverlap>::const_iterator ScenarioOverlapIndex::UpperBound(
+    const Overlaps& overlaps, double start_s) const {
+  return std::upper_bound(overlaps.sorted.begin(), overlaps.sorted.end(),
+                          start_s, [](double s, const PathOverlap& overlap) {
+                            return s < overlap.start_s;
+                          });
+}
+
+std::vector<const PathOverlap*> ScenarioOverlapIndex::OverlapsInRange(
+    OverlapType type, double start_s, double end_s) const {
+  std::vector<const PathOverlap*> result;
+  const auto& overlaps = overlaps_[type];
+  for (auto it = UpperBound(overlaps, start_s);
+       it != overlaps.sorted.end() && it->start_s <= end_s; ++it) {
+    result.push_back(&(*it));
+  }
+  return result;
+}
+
+bool ScenarioOverlapIndex::HasOverlapInRange(OverlapType type, double start_s,
+                                             double end_s) const {
+  const auto& overlaps = overlaps_[type];
+  auto it = UpperBound(overlaps, start_s);
+  return it != overlaps.sorted.end() && it->start_s <= end_s;
+}
+
+const PathOverlap* ScenarioOverlapIndex::Find(
+    OverlapType type, const std::string& object_id) const {
+  const auto& overlaps = overlaps_[type];
+  auto it = overlaps.index_by_id.find(object_id);
+  if (it == overlaps.index_by_id.end()) {
+    return nullptr;
+  }
+  return &overlaps.sorted[it->second];
+}
+
+}  // namespace scenario
+}  // namespace planning
+}  // namespace apollo
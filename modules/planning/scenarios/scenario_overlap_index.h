@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/map/pnc_map/path.h"
+
+namespace apollo {
+namespace planning {
+namespace scenario {
+
+// Overlaps of the scenario triggers on a reference line sorted by start_s,
+// so that scenario selection only looks at the triggers inside its lookahead
+// window. Built from the overlaps the map path already resolved, no further
+// map queries are made.
+class ScenarioOverlapIndex {
+ public:
+  enum OverlapType {
+    STOP_SIGN = 0,
+    SIGNAL,
+    PNC_JUNCTION,
+    PARKING_SPACE,
+    NUM_OVERLAP_TYPES,
+  };
+
+  void Build(const hdmap::Path& path);
+
+  void SetOverlaps(OverlapType type,
+                   const std::vector<hdmap::PathOverlap>& overlaps);
+
+  void Clear();
+
+  // overlaps of the type with start_s in (start_s, end_s], by start_s
+  std::vector<const hdmap::PathOverlap*> OverlapsInRange(OverlapType type,
+                                                         double start_s,
+                                                         double end_s) const;
+
+  bool HasOverlapInRange(OverlapType type, double start_s,
+                         double end_s) const;
+
+  // nullptr if the path has no overlap of the type with the object id
+  const hdmap::PathOverlap* Find(OverlapType type,
+                                 const std::string& object_id) const;
+
+ private:
+  struct Overlaps {
+    std::vector<hdmap::PathOverlap> sorted;
+    std::unordered_map<std::string, size_t> index_by_id;
+  };
+
+  // first overlap of the sorted ones with start_s > start_s
+  std::vector<hdmap::PathOverlap>::const_iterator UpperBound(
+      const Overlaps& overlaps, double start_s) const;
+
+  Overlaps overlaps_[NUM_OVERLAP_TYPES];
+};
+
+}  // namespace scenario
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/scenarios/scenario_overlap_index.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+namespace scenario {
+
+using apollo::hdmap::PathOverlap;
+
+TEST(ScenarioOverlapIndexTest, OverlapsInRange) {
+  ScenarioOverlapIndex index;
+  index.SetOverlaps(
+      ScenarioOverlapIndex::SIGNAL,
+      {PathOverlap("s3", 30.0, 31.0), PathOverlap("s1", 10.0, 11.0),
+       PathOverlap("s2", 20.0, 21.0)});
+
+  auto overlaps =
+      index.OverlapsInRange(ScenarioOverlapIndex::SIGNAL, 10.0, 30.0);
+  ASSERT_EQ(2, overlaps.size());
+  EXPECT_EQ("s2", overlaps[0]->object_id);
+  EXPECT_EQ("s3", overlaps[1]->object_id);
+
+  EXPECT_TRUE(index.HasOverlapInRange(ScenarioOverlapIndex::SIGNAL, 0.0, 10.0));
+  EXPECT_FALSE(
+      index.HasOverlapInRange(ScenarioOverlapIndex::SIGNAL, 30.0, 100.0));
+  EXPECT_FALSE(
+      index.HasOverlapInRange(ScenarioOverlapIndex::STOP_SIGN, 0.0, 100.0));
+}
+
+TEST(ScenarioOverlapIndexTest, Find) {
+  ScenarioOverlapIndex index;
+  index.SetOverlaps(ScenarioOverlapIndex::STOP_SIGN,
+                    {PathOverlap("a", 5.0, 6.0), PathOverlap("b", 1.0, 2.0)});
+
+  const auto* overlap = index.Find(ScenarioOverlapIndex::STOP_SIGN, "a");
+  ASSERT_NE(nullptr, overlap);
+  EXPECT_DOUBLE_EQ(5.0, overlap->start_s);
+  EXPECT_EQ(nullptr, index.Find(ScenarioOverlapIndex::STOP_SIGN, "c"));
+  EXPECT_EQ(nullptr, index.Find(ScenarioOverlapIndex::SIGNAL, "a"));
+
+  index.Clear();
+  EXPECT_EQ(nullptr, index.Find(ScenarioOverlapIndex::STOP_SIGN, "a"));
+}
+
+}  // namespace scenario
+}  // namespace planning
+}  // namespace apollo
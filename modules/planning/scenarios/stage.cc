@@ -44,6 +44,12 @@ constexpr double kSpeedOptimizationFallbackCost = 2e4;
 Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
   name_ = ScenarioConfig::StageType_Name(config_.stage_type());
   next_stage_ = config_.stage_type();
+  CreateTasks(&tasks_, &task_list_);
+}
+
+void Stage::CreateTasks(
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+    std::vector<Task*>* task_list) const {
   std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
       config_map;
   for (const auto& task_config : config_.task_config()) {
@@ -54,13 +60,13 @@ Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
     CHECK(config_map.find(task_type) != config_map.end())
         << "Task: " << TaskConfig::TaskType_Name(task_type)
         << " used but not configured";
-    auto iter = tasks_.find(task_type);
-    if (iter == tasks_.end()) {
+    auto iter = tasks->find(task_type);
+    if (iter == tasks->end()) {
       auto ptr = TaskFactory::CreateTask(*config_map[task_type]);
-      task_list_.push_back(ptr.get());
-      tasks_[task_type] = std::move(ptr);
+      task_list->push_back(ptr.get());
+      (*tasks)[task_type] = std::move(ptr);
     } else {
-      task_list_.push_back(iter->second.get());
+      task_list->push_back(iter->second.get());
     }
   }
 }
@@ -86,12 +92,22 @@ bool Stage::ExecuteTaskOnReferenceLine(
 
     auto ret = common::Status::OK();
     for (auto* task : task_list_) {
+      if (frame->latency_budget().SkipTask(task->Config())) {
+        continue;
+      }
+      const double start_timestamp = Clock::NowInSeconds();
       ret = task->Execute(frame, &reference_line_info);
       if (!ret.ok()) {
         AERROR << "Failed to run tasks[" << task->Name()
                << "], Error message: " << ret.error_message();
         break;
       }
+      frame->mutable_latency_budget()->CheckTask(task->Config());
+      auto* task_stats =
+          reference_line_info.mutable_latency_stats()->add_task_stats();
+      task_stats->set_name(task->Name());
+      task_stats->set_time_ms((Clock::NowInSeconds() - start_timestamp) *
+                              1000.0);
     }
 
     if (reference_line_info.speed_data().empty()) {
@@ -119,12 +135,16 @@ bool Stage::ExecuteTaskOnReferenceLine(
 bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   auto ret = common::Status::OK();
   for (auto* task : task_list_) {
+    if (frame->latency_budget().SkipTask(task->Config())) {
+      continue;
+    }
     ret = task->Execute(frame);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << task->Name()
              << "], Error message: " << ret.error_message();
       return false;
     }
+    frame->mutable_latency_budget()->CheckTask(task->Config());
   }
 
   if (frame->open_space_info().fallback_flag()) {
@@ -84,6 +84,13 @@ class Stage {
 
   bool ExecuteTaskOnOpenSpace(Frame* frame);
 
+  /**
+   * @brief Create the configured tasks, |task_list| gets them in the order
+   * they run. Each call creates a new set of task instances.
+   */
+  void CreateTasks(std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+                   std::vector<Task*>* task_list) const;
+
   virtual Stage::StageStatus FinishScenario();
 
  protected:
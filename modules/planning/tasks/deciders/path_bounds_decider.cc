@@ -18,11 +18,13 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <set>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -43,6 +45,20 @@ constexpr double kRoadEdgeBuffer = 0.2;
 constexpr double kObstacleSBuffer = 0.5;
 constexpr double kObstacleLBuffer = 0.5;
 
+namespace {
+
+using SweepLineEvent = std::tuple<int, double, double, double, std::string>;
+
+// Orders events by s, and an exit before an entry at the same s.
+bool SweepLineEventLess(const SweepLineEvent& lhs, const SweepLineEvent& rhs) {
+  if (std::get<1>(lhs) != std::get<1>(rhs)) {
+    return std::get<1>(lhs) < std::get<1>(rhs);
+  }
+  return std::get<0>(lhs) < std::get<0>(rhs);
+}
+
+}  // namespace
+
 PathBoundsDecider::PathBoundsDecider(const TaskConfig& config)
     : Decider(config) {}
 
@@ -133,53 +149,66 @@ bool PathBoundsDecider::GetBoundariesFromRoadsAndADC(
   CHECK_NOTNULL(path_boundaries);
   CHECK(!path_boundaries->empty());
 
-  // Go through every point, update the boundary based on road info and
-  // ADC's position.
+  // Query the lane and road widths of every point first, so that the bound
+  // computation below runs over contiguous arrays.
+  const size_t num_points = path_boundaries->size();
+  lane_left_widths_.resize(num_points);
+  lane_right_widths_.resize(num_points);
+  road_left_widths_.resize(num_points);
+  road_right_widths_.resize(num_points);
   double past_lane_left_width = kDefaultLaneWidth / 2.0;
   double past_lane_right_width = kDefaultLaneWidth / 2.0;
   double past_road_left_width = kDefaultRoadWidth / 2.0;
   double past_road_right_width = kDefaultRoadWidth / 2.0;
-  for (size_t i = 0; i < path_boundaries->size(); ++i) {
+  for (size_t i = 0; i < num_points; ++i) {
     double curr_s = std::get<0>((*path_boundaries)[i]);
     // Get the lane width at current point.
-    double curr_lane_left_width = 0.0;
-    double curr_lane_right_width = 0.0;
-    if (!reference_line.GetLaneWidth(curr_s, &curr_lane_left_width,
-                                     &curr_lane_right_width)) {
+    if (!reference_line.GetLaneWidth(curr_s, &lane_left_widths_[i],
+                                     &lane_right_widths_[i])) {
       AWARN << "Failed to get lane width at s = " << curr_s;
-      curr_lane_left_width = past_lane_left_width;
-      curr_lane_right_width = past_lane_right_width;
+      lane_left_widths_[i] = past_lane_left_width;
+      lane_right_widths_[i] = past_lane_right_width;
     } else {
-      past_lane_left_width = curr_lane_left_width;
-      past_lane_right_width = curr_lane_right_width;
+      past_lane_left_width = lane_left_widths_[i];
+      past_lane_right_width = lane_right_widths_[i];
     }
     // Get the road width at current point.
-    double curr_road_left_width = 0.0;
-    double curr_road_right_width = 0.0;
-    if (!reference_line.GetRoadWidth(curr_s, &curr_road_left_width,
-                                     &curr_road_right_width)) {
+    if (!reference_line.GetRoadWidth(curr_s, &road_left_widths_[i],
+                                     &road_right_widths_[i])) {
       AWARN << "Failed to get road width at s = " << curr_s;
-      curr_road_left_width = past_road_left_width;
-      curr_road_right_width = past_road_right_width;
+      road_left_widths_[i] = past_road_left_width;
+      road_right_widths_[i] = past_road_right_width;
     } else {
-      past_road_left_width = curr_road_left_width;
-      past_road_right_width = curr_road_right_width;
+      past_road_left_width = road_left_widths_[i];
+      past_road_right_width = road_right_widths_[i];
     }
-    // Calculate the proper boundary based on lane-width, road-width, and
-    // ADC's position.
-    double curr_left_bound =
-        std::fmax(-curr_road_left_width,
-                  std::fmin(-curr_lane_left_width, adc_sl_boundary.start_l()));
-    double curr_right_bound =
-        std::fmin(curr_road_right_width,
-                  std::fmax(curr_lane_right_width, adc_sl_boundary.end_l()));
-    // Update the boundary.
+  }
+
+  // Calculate the proper boundary based on lane-width, road-width, and
+  // ADC's position. The loop is branch free so that it gets vectorized; the
+  // results are written over the lane width buffers.
+  const double adc_start_l = adc_sl_boundary.start_l();
+  const double adc_end_l = adc_sl_boundary.end_l();
+  const double adc_buffer = GetBufferBetweenADCCenterAndEdge();
+  double* const left_bounds = lane_left_widths_.data();
+  double* const right_bounds = lane_right_widths_.data();
+  const double* const road_left_widths = road_left_widths_.data();
+  const double* const road_right_widths = road_right_widths_.data();
+  for (size_t i = 0; i < num_points; ++i) {
+    left_bounds[i] =
+        std::max(-road_left_widths[i], std::min(-left_bounds[i], adc_start_l)) +
+        adc_buffer;
+    right_bounds[i] =
+        std::min(road_right_widths[i], std::max(right_bounds[i], adc_end_l)) -
+        adc_buffer;
+  }
+
+  // Update the boundary.
+  for (size_t i = 0; i < num_points; ++i) {
     std::get<1>((*path_boundaries)[i]) =
-        std::fmax(std::get<1>((*path_boundaries)[i]),
-                  curr_left_bound + GetBufferBetweenADCCenterAndEdge());
+        std::fmax(std::get<1>((*path_boundaries)[i]), left_bounds[i]);
     std::get<2>((*path_boundaries)[i]) =
-        std::fmin(std::get<2>((*path_boundaries)[i]),
-                  curr_right_bound - GetBufferBetweenADCCenterAndEdge());
+        std::fmin(std::get<2>((*path_boundaries)[i]), right_bounds[i]);
   }
 
   return true;
@@ -193,7 +222,7 @@ bool PathBoundsDecider::GetBoundariesFromStaticObstacles(
     const IndexedList<std::string, Obstacle>& indexed_obstacles,
     std::vector<std::tuple<double, double, double>>* const path_boundaries) {
   // Preprocessing.
-  auto sorted_obstacles = SortObstaclesForSweepLine(indexed_obstacles);
+  const auto& sorted_obstacles = SortObstaclesForSweepLine(indexed_obstacles);
   double center_line = adc_frenet_l_;
   size_t obs_idx = 0;
   int path_blocked_idx = -1;
@@ -319,11 +348,10 @@ double PathBoundsDecider::GetBufferBetweenADCCenterAndEdge() {
 }
 
 // The tuple contains (is_start_s, s, l_min, l_max, obstacle_id)
-std::vector<std::tuple<int, double, double, double, std::string>>
+const std::vector<std::tuple<int, double, double, double, std::string>>&
 PathBoundsDecider::SortObstaclesForSweepLine(
     const IndexedList<std::string, Obstacle>& indexed_obstacles) {
-  std::vector<std::tuple<int, double, double, double, std::string>>
-      sorted_obstacles;
+  std::unordered_map<std::string, ObstacleBox> obstacle_boxes;
 
   // Go through every obstacle and preprocess it.
   for (const auto* obstacle : indexed_obstacles.Items()) {
@@ -339,31 +367,63 @@ PathBoundsDecider::SortObstaclesForSweepLine(
     if (obstacle->PerceptionSLBoundary().end_s() < adc_frenet_s_) {
       continue;
     }
-    // Decompose each obstacle's rectangle into two edges: one at
-    // start_s; the other at end_s.
-    const auto obstacle_sl = obstacle->PerceptionSLBoundary();
-    sorted_obstacles.emplace_back(1, obstacle_sl.start_s() - kObstacleSBuffer,
-                                  obstacle_sl.start_l() - kObstacleLBuffer,
-                                  obstacle_sl.end_l() + kObstacleLBuffer,
-                                  obstacle->Id());
-    sorted_obstacles.emplace_back(0, obstacle_sl.end_s() + kObstacleSBuffer,
-                                  obstacle_sl.start_l() - kObstacleLBuffer,
-                                  obstacle_sl.end_l() + kObstacleLBuffer,
-                                  obstacle->Id());
+    const auto& obstacle_sl = obstacle->PerceptionSLBoundary();
+    obstacle_boxes.emplace(
+        obstacle->Id(),
+        ObstacleBox(obstacle_sl.start_s() - kObstacleSBuffer,
+                    obstacle_sl.end_s() + kObstacleSBuffer,
+                    obstacle_sl.start_l() - kObstacleLBuffer,
+                    obstacle_sl.end_l() + kObstacleLBuffer));
+  }
+
+  // Drop the events of the obstacles that are gone, fell behind ADC, or
+  // moved since the last cycle.
+  std::unordered_set<std::string> stale_ids;
+  for (const auto& cached_box : cached_obstacle_boxes_) {
+    auto iter = obstacle_boxes.find(cached_box.first);
+    if (iter == obstacle_boxes.end() || iter->second != cached_box.second) {
+      stale_ids.insert(cached_box.first);
+    }
+  }
+  if (!stale_ids.empty()) {
+    cached_sweep_line_events_.erase(
+        std::remove_if(cached_sweep_line_events_.begin(),
+                       cached_sweep_line_events_.end(),
+                       [&stale_ids](const SweepLineEvent& event) {
+                         return stale_ids.count(std::get<4>(event)) > 0;
+                       }),
+        cached_sweep_line_events_.end());
+  }
+
+  // Decompose each new obstacle's rectangle into two edges: one at
+  // start_s; the other at end_s. Then merge them into the sorted list.
+  std::vector<SweepLineEvent> new_events;
+  for (const auto& box : obstacle_boxes) {
+    auto iter = cached_obstacle_boxes_.find(box.first);
+    if (iter != cached_obstacle_boxes_.end() && iter->second == box.second) {
+      continue;
+    }
+    new_events.emplace_back(1, std::get<0>(box.second),
+                            std::get<2>(box.second), std::get<3>(box.second),
+                            box.first);
+    new_events.emplace_back(0, std::get<1>(box.second),
+                            std::get<2>(box.second), std::get<3>(box.second),
+                            box.first);
+  }
+  if (!new_events.empty()) {
+    std::sort(new_events.begin(), new_events.end(), SweepLineEventLess);
+    const size_t num_kept_events = cached_sweep_line_events_.size();
+    cached_sweep_line_events_.insert(
+        cached_sweep_line_events_.end(),
+        std::make_move_iterator(new_events.begin()),
+        std::make_move_iterator(new_events.end()));
+    std::inplace_merge(cached_sweep_line_events_.begin(),
+                       cached_sweep_line_events_.begin() + num_kept_events,
+                       cached_sweep_line_events_.end(), SweepLineEventLess);
   }
 
-  // Sort.
-  sort(sorted_obstacles.begin(), sorted_obstacles.end(),
-       [](const std::tuple<int, double, double, double, std::string>& lhs,
-          const std::tuple<int, double, double, double, std::string>& rhs) {
-         if (std::get<1>(lhs) != std::get<1>(rhs)) {
-           return std::get<1>(lhs) < std::get<1>(rhs);
-         } else {
-           return std::get<0>(lhs) < std::get<0>(rhs);
-         }
-       });
-
-  return sorted_obstacles;
+  cached_obstacle_boxes_ = std::move(obstacle_boxes);
+  return cached_sweep_line_events_;
 }
 
 }  // namespace planning
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/planning/proto/decider_config.pb.h"
@@ -54,13 +55,31 @@ class PathBoundsDecider : public Decider {
 
   double GetBufferBetweenADCCenterAndEdge();
 
-  std::vector<std::tuple<int, double, double, double, std::string>>
+  /**
+   * @brief Returns the sweep-line events (is_start_s, s, l_min, l_max, id)
+   * sorted by s. The list is kept across cycles and only the events of the
+   * obstacles that appeared, disappeared or moved are re-inserted.
+   */
+  const std::vector<std::tuple<int, double, double, double, std::string>>&
   SortObstaclesForSweepLine(
       const IndexedList<std::string, Obstacle>& indexed_obstacles);
 
  private:
+  // (start_s, end_s, l_min, l_max) of an obstacle, buffers included.
+  using ObstacleBox = std::tuple<double, double, double, double>;
+
   double adc_frenet_s_ = 0.0;
   double adc_frenet_l_ = 0.0;
+
+  std::unordered_map<std::string, ObstacleBox> cached_obstacle_boxes_;
+  std::vector<std::tuple<int, double, double, double, std::string>>
+      cached_sweep_line_events_;
+
+  // Per s-station scratch buffers of GetBoundariesFromRoadsAndADC.
+  std::vector<double> lane_left_widths_;
+  std::vector<double> lane_right_widths_;
+  std::vector<double> road_left_widths_;
+  std::vector<double> road_right_widths_;
 };
 
 }  // namespace planning
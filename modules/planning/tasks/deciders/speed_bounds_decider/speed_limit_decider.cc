@@ -22,13 +22,13 @@
 
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/decision.pb.h"
 
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
-#include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
@@ -88,6 +88,22 @@ Status SpeedLimitDecider::GetSpeedLimits(
 
   std::vector<double> avg_kappa;
   GetAvgKappa(path_data_.discretized_path(), &avg_kappa);
+
+  // the obstacles that may slow down the path points, collected once rather
+  // than for every path point
+  std::vector<const Obstacle*> nudge_obstacles;
+  if (FLAGS_enable_nudge_slowdown) {
+    for (const auto* const_obstacle : obstacles.Items()) {
+      if (const_obstacle->IsVirtual()) {
+        continue;
+      }
+      if (!const_obstacle->LateralDecision().has_nudge()) {
+        continue;
+      }
+      nudge_obstacles.push_back(const_obstacle);
+    }
+  }
+
   const auto& discretized_path = path_data_.discretized_path();
   const auto& frenet_path = path_data_.frenet_frame_path();
   for (uint32_t i = 0; i < discretized_path.size(); ++i) {
@@ -126,14 +142,7 @@ Status SpeedLimitDecider::GetSpeedLimits(
 
     // (3) speed limit from nudge obstacles
     double nudge_obstacle_speed_limit = std::numeric_limits<double>::max();
-    for (const auto* const_obstacle : obstacles.Items()) {
-      if (const_obstacle->IsVirtual()) {
-        continue;
-      }
-      if (!const_obstacle->LateralDecision().has_nudge()) {
-        continue;
-      }
-
+    for (const auto* const_obstacle : nudge_obstacles) {
       /* ref line:
        * -------------------------------
        *    start_s   end_s
@@ -179,20 +188,13 @@ Status SpeedLimitDecider::GetSpeedLimits(
       }
     }
 
-    double curr_speed_limit = 0.0;
-    if (FLAGS_enable_nudge_slowdown) {
-      curr_speed_limit =
-          std::fmax(speed_bounds_config_.lowest_speed(),
-                    common::util::MinElement(std::vector<double>{
-                        speed_limit_on_reference_line, centri_acc_speed_limit,
-                        centri_jerk_speed_limit, nudge_obstacle_speed_limit}));
-    } else {
-      curr_speed_limit =
-          std::fmax(speed_bounds_config_.lowest_speed(),
-                    common::util::MinElement(std::vector<double>{
-                        speed_limit_on_reference_line, centri_acc_speed_limit,
-                        centri_jerk_speed_limit}));
-    }
+    // nudge_obstacle_speed_limit stays at max without nudge slowdown
+    const double curr_speed_limit =
+        std::fmax(speed_bounds_config_.lowest_speed(),
+                  std::fmin(std::fmin(speed_limit_on_reference_line,
+                                      centri_acc_speed_limit),
+                            std::fmin(centri_jerk_speed_limit,
+                                      nudge_obstacle_speed_limit)));
 
     speed_limit_data->AppendSpeedLimit(path_s, curr_speed_limit);
     // TODO(Jinyun) implement
@@ -44,6 +44,8 @@ namespace planning {
 using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
+using apollo::common::math::AABoxKDTree2d;
+using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 using apollo::common::util::StrCat;
@@ -51,6 +53,7 @@ using apollo::common::util::StrCat;
 namespace {
 constexpr double boundary_t_buffer = 0.1;
 constexpr double boundary_s_buffer = 1.0;
+constexpr size_t default_num_point = 50;
 }  // namespace
 
 StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
@@ -67,7 +70,75 @@ StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_distance_(planning_distance),
       planning_time_(planning_time),
-      is_change_lane_(is_change_lane) {}
+      is_change_lane_(is_change_lane) {
+  BuildPathBoxIndex();
+}
+
+void StBoundaryMapper::BuildPathBoxIndex() {
+  const auto& path_points = path_data_.discretized_path();
+  if (path_points.empty()) {
+    return;
+  }
+  if (path_points.size() > 2 * default_num_point) {
+    const auto ratio = path_points.size() / default_num_point;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_ = DiscretizedPath(sampled_path_points);
+  } else {
+    sampled_path_ = DiscretizedPath(path_points);
+  }
+
+  station_step_ = vehicle_param_.front_edge_to_center();
+  if (station_step_ <= 0.0) {
+    AERROR << "Invalid front_edge_to_center: " << station_step_;
+    return;
+  }
+  const double path_len =
+      std::min(FLAGS_max_trajectory_len, sampled_path_.Length());
+  for (double path_s = 0.0; path_s < path_len; path_s += station_step_) {
+    const auto path_point =
+        sampled_path_.Evaluate(path_s + sampled_path_.front().s());
+    station_s_.push_back(path_s);
+    station_boxes_.push_back(
+        GetADCBox(path_point, speed_bounds_config_.boundary_buffer()));
+  }
+  path_boxes_.reserve(station_boxes_.size());
+  for (size_t i = 0; i < station_boxes_.size(); ++i) {
+    path_boxes_.emplace_back(i, station_boxes_[i]);
+  }
+
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 4;
+  path_box_tree_.reset(new AABoxKDTree2d<PathBox>(path_boxes_, params));
+}
+
+int StBoundaryMapper::FindFirstOverlapStation(const Box2d& obs_box) const {
+  if (path_box_tree_ == nullptr) {
+    return -1;
+  }
+  // any point shared by the two boxes is within half the obstacle diagonal of
+  // its center, so stations farther away than that can not overlap.
+  constexpr double kRadiusBuffer = 1e-6;
+  const auto candidates = path_box_tree_->GetObjects(
+      obs_box.center(), obs_box.diagonal() / 2.0 + kRadiusBuffer);
+  std::vector<size_t> indices;
+  indices.reserve(candidates.size());
+  for (const auto* candidate : candidates) {
+    indices.push_back(candidate->index());
+  }
+  std::sort(indices.begin(), indices.end());
+  for (const size_t index : indices) {
+    if (obs_box.HasOverlap(station_boxes_[index])) {
+      return static_cast<int>(index);
+    }
+  }
+  return -1;
+}
 
 Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   const auto& obstacles = path_decision->obstacles();
@@ -280,20 +351,7 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
       }
     }
   } else {
-    const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path = DiscretizedPath(sampled_path_points);
-    } else {
-      discretized_path = DiscretizedPath(path_points);
-    }
+    const auto& discretized_path = sampled_path_;
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
       const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
@@ -304,63 +362,56 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
         continue;
       }
 
-      const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
-                         speed_bounds_config_.boundary_buffer())) {
-          // found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
+      const int station = FindFirstOverlapStation(obs_box);
+      if (station >= 0) {
+        // found overlap, start searching with higher resolution
+        const double path_s = station_s_[station];
+        const double backward_distance = -station_step_;
+        const double forward_distance = vehicle_param_.length() +
+                                        vehicle_param_.width() +
+                                        obs_box.length() + obs_box.width();
+        const double default_min_step = 0.1;  // in meters
+        const double fine_tuning_step_length = std::fmin(
+            default_min_step, discretized_path.Length() / default_num_point);
+
+        bool find_low = false;
+        bool find_high = false;
+        double low_s = std::fmax(0.0, path_s + backward_distance);
+        double high_s =
+            std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+        while (low_s < high_s) {
+          if (find_low && find_high) {
+            break;
+          }
+          if (!find_low) {
+            const auto& point_low = discretized_path.Evaluate(
+                low_s + discretized_path.front().s());
+            if (!CheckOverlap(point_low, obs_box,
+                              speed_bounds_config_.boundary_buffer())) {
+              low_s += fine_tuning_step_length;
+            } else {
+              find_low = true;
             }
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - speed_bounds_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + speed_bounds_config_.point_extension(),
-                trajectory_point_time);
+          if (!find_high) {
+            const auto& point_high = discretized_path.Evaluate(
+                high_s + discretized_path.front().s());
+            if (!CheckOverlap(point_high, obs_box,
+                              speed_bounds_config_.boundary_buffer())) {
+              high_s -= fine_tuning_step_length;
+            } else {
+              find_high = true;
+            }
           }
-          break;
+        }
+        if (find_high && find_low) {
+          lower_points->emplace_back(
+              low_s - speed_bounds_config_.point_extension(),
+              trajectory_point_time);
+          upper_points->emplace_back(
+              high_s + speed_bounds_config_.point_extension(),
+              trajectory_point_time);
         }
       }
     }
@@ -430,6 +481,11 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(GetADCBox(path_point, buffer));
+}
+
+Box2d StBoundaryMapper::GetADCBox(const PathPoint& path_point,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -451,10 +507,8 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
           .rotate(path_point.theta());
   Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 }  // namespace planning
@@ -20,13 +20,18 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/planning/proto/speed_bounds_decider_config.pb.h"
 
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
 #include "modules/common/status/status.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -50,10 +55,49 @@ class StBoundaryMapper {
 
  private:
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
+  FRIEND_TEST(StBoundaryMapperTest, path_box_index_test);
+
+  // ADC box at one coarse station of the path, stored in the kd-tree used to
+  // pick overlap candidates for an obstacle box.
+  class PathBox {
+   public:
+    PathBox(const size_t index, const apollo::common::math::Box2d& box)
+        : index_(index), aabox_(box.GetAABox()) {}
+    const apollo::common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const apollo::common::math::Vec2d& point) const {
+      return aabox_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const apollo::common::math::Vec2d& point) const {
+      const double distance = aabox_.DistanceTo(point);
+      return distance * distance;
+    }
+    size_t index() const { return index_; }
+
+   private:
+    size_t index_ = 0;
+    apollo::common::math::AABox2d aabox_;
+  };
+
   bool CheckOverlap(const apollo::common::PathPoint& path_point,
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  apollo::common::math::Box2d GetADCBox(
+      const apollo::common::PathPoint& path_point, const double buffer) const;
+
+  /**
+   * Samples the path at the coarse overlap search step and indexes the ADC
+   * boxes of the stations, so that each obstacle box only runs the exact
+   * overlap test against the stations it may touch.
+   */
+  void BuildPathBoxIndex();
+
+  /**
+   * Returns the first coarse station (in path order) whose ADC box overlaps
+   * obs_box, or -1 if there is none.
+   */
+  int FindFirstOverlapStation(const apollo::common::math::Box2d& obs_box) const;
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
@@ -81,6 +125,15 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+
+  // coarse overlap search over the sampled path
+  DiscretizedPath sampled_path_;
+  double station_step_ = 0.0;
+  std::vector<double> station_s_;
+  std::vector<apollo::common::math::Box2d> station_boxes_;
+  std::vector<PathBox> path_boxes_;
+  std::unique_ptr<apollo::common::math::AABoxKDTree2d<PathBox>>
+      path_box_tree_;
 };
 
 }  // namespace planning
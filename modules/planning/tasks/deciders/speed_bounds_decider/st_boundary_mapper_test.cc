@@ -16,6 +16,8 @@
 
 #include "modules/planning/tasks/deciders/speed_bounds_decider/st_boundary_mapper.h"
 
+#include <cmath>
+
 #include "gmock/gmock.h"
 
 #include "cyber/common/log.h"
@@ -90,5 +92,36 @@ TEST_F(StBoundaryMapperTest, check_overlap_test) {
   EXPECT_TRUE(mapper.CheckOverlap(path_point, box, 0.0));
 }
 
+TEST_F(StBoundaryMapperTest, path_box_index_test) {
+  SpeedBoundsDeciderConfig config;
+  SLBoundary adc_sl_boundary;
+  StBoundaryMapper mapper(adc_sl_boundary, config, *reference_line_, path_data_,
+                          70.0, 10.0, false);
+  ASSERT_FALSE(mapper.station_boxes_.empty());
+
+  // the indexed search must agree with a scan over all stations
+  const auto& path = path_data_.discretized_path();
+  int num_overlap = 0;
+  for (size_t i = 0; i < path.size(); i += 5) {
+    for (const double offset : {-6.0, -2.0, 0.0, 1.5, 4.0}) {
+      const double theta = path[i].theta();
+      const common::math::Vec2d center(
+          path[i].x() - offset * std::sin(theta),
+          path[i].y() + offset * std::cos(theta));
+      const common::math::Box2d box(center, theta + offset, 4.0, 2.0);
+      int expected = -1;
+      for (size_t j = 0; j < mapper.station_boxes_.size(); ++j) {
+        if (box.HasOverlap(mapper.station_boxes_[j])) {
+          expected = static_cast<int>(j);
+          break;
+        }
+      }
+      EXPECT_EQ(expected, mapper.FindFirstOverlapStation(box));
+      num_overlap += expected >= 0 ? 1 : 0;
+    }
+  }
+  EXPECT_GT(num_overlap, 0);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -159,6 +159,89 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
   return cost * unit_t_;
 }
 
+void DpStCost::InitTimeSlices(const std::vector<double>& t_values) {
+  constexpr double kIgnoreDistance = 200.0;
+  constexpr double kSafeTimeBuffer = 3.0;
+  time_slices_.assign(t_values.size(), TimeSlice());
+  for (const auto* obstacle : obstacles_) {
+    if (!obstacle->IsBlockingObstacle()) {
+      continue;
+    }
+    const auto& boundary = obstacle->st_boundary();
+    if (boundary.min_s() > kIgnoreDistance) {
+      continue;
+    }
+    const auto lower_points = boundary.lower_points();
+    const auto upper_points = boundary.upper_points();
+    for (size_t i = 0; i < t_values.size(); ++i) {
+      const double t = t_values[i];
+      if (t < boundary.min_t() || t > boundary.max_t()) {
+        continue;
+      }
+      double s_upper = 0.0;
+      double s_lower = 0.0;
+      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
+
+      // the unclipped s range at t, inside it is what
+      // STBoundary::IsPointInBoundary() reports as in the boundary
+      double block_lower = kInf;
+      double block_upper = -kInf;
+      if (t > boundary.min_t() && t < boundary.max_t()) {
+        auto right = std::lower_bound(
+            lower_points.begin(), lower_points.end(), t,
+            [](const STPoint& p, const double t) { return p.t() < t; });
+        const size_t r = std::distance(lower_points.begin(), right);
+        const size_t l = r - 1;
+        const double ratio = (t - upper_points[l].t()) /
+                             (upper_points[r].t() - upper_points[l].t());
+        const double upper =
+            upper_points[l].s() +
+            ratio * (upper_points[r].s() - upper_points[l].s());
+        const double lower =
+            lower_points[l].s() +
+            ratio * (lower_points[r].s() - lower_points[l].s());
+        block_lower = std::min(lower, upper);
+        block_upper = std::max(lower, upper);
+      }
+
+      auto& slice = time_slices_[i];
+      slice.s_lower.push_back(s_lower);
+      slice.s_upper.push_back(s_upper);
+      slice.block_lower.push_back(block_lower);
+      slice.block_upper.push_back(block_upper);
+      slice.follow_len.push_back(obstacle->speed() * kSafeTimeBuffer);
+    }
+  }
+}
+
+void DpStCost::GetObstacleCosts(const uint32_t index_t, const double* s,
+                                const size_t n, double* costs) const {
+  constexpr double kSafeDistance = 20.0;
+  const double weight = config_.obstacle_weight() *
+                        config_.default_obstacle_cost() * unit_t_;
+  std::fill(costs, costs + n, 0.0);
+  const auto& slice = time_slices_[index_t];
+  // one obstacle at a time over all points, the inner loop has no branches
+  // so that the compiler can vectorize it
+  for (size_t k = 0; k < slice.s_lower.size(); ++k) {
+    const double s_lower = slice.s_lower[k];
+    const double s_upper = slice.s_upper[k];
+    const double block_lower = slice.block_lower[k];
+    const double block_upper = slice.block_upper[k];
+    const double follow_len = slice.follow_len[k];
+    for (size_t i = 0; i < n; ++i) {
+      const double behind = follow_len - s_lower + s[i];
+      const double ahead = kSafeDistance + s_upper - s[i];
+      const double cost_behind =
+          (s[i] < s_lower && behind >= 0.0) ? behind * behind : 0.0;
+      const double cost_ahead =
+          (s[i] > s_upper && ahead >= 0.0) ? ahead * ahead : 0.0;
+      const bool blocked = s[i] > block_lower && s[i] < block_upper;
+      costs[i] += blocked ? kInf : weight * (cost_behind + cost_ahead);
+    }
+  }
+}
+
 double DpStCost::GetReferenceCost(const STPoint& point,
                                   const STPoint& reference_point) const {
   return config_.reference_weight() * (point.s() - reference_point.s()) *
@@ -45,6 +45,24 @@ class DpStCost {
 
   double GetObstacleCost(const StGraphPoint& point);
 
+  /**
+   * @brief Collect the s ranges of the blocking obstacles at every time
+   * slice of the graph, so that GetObstacleCosts() needs no boundary lookups.
+   * @param t_values t of every column of the graph
+   */
+  void InitTimeSlices(const std::vector<double>& t_values);
+
+  /**
+   * @brief Same cost as GetObstacleCost() for n points of one time slice.
+   * Must be called after InitTimeSlices().
+   * @param index_t column of the points
+   * @param s s of each point
+   * @param n number of points
+   * @param costs output, cost of each point
+   */
+  void GetObstacleCosts(const uint32_t index_t, const double* s,
+                        const size_t n, double* costs) const;
+
   double GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
 
@@ -88,6 +106,19 @@ class DpStCost {
 
   std::vector<std::pair<double, double>> keep_clear_range_;
 
+  // obstacles that matter at one t, one entry per obstacle in every array
+  struct TimeSlice {
+    // s range that costs are measured from
+    std::vector<double> s_lower;
+    std::vector<double> s_upper;
+    // a point strictly inside is blocked
+    std::vector<double> block_lower;
+    std::vector<double> block_upper;
+    // distance behind s_lower where following starts to cost
+    std::vector<double> follow_len;
+  };
+  std::vector<TimeSlice> time_slices_;
+
   std::array<double, 200> accel_cost_;
   std::array<double, 400> jerk_cost_;
 };
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+#include "modules/planning/tasks/optimizers/dp_st_speed/dp_st_cost.h"
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(DpStCostTest, obstacle_costs_of_time_slice) {
+  DpStSpeedConfig config;
+  config.set_matrix_dimension_s(150);
+  config.set_matrix_dimension_t(8);
+  config.set_obstacle_weight(1.0);
+  config.set_default_obstacle_cost(1e4);
+
+  // one obstacle ahead in the middle of the horizon, one that is not blocking
+  std::list<Obstacle> obstacle_list;
+  std::vector<const Obstacle*> obstacles;
+  for (const double start_s : {30.0, 10.0}) {
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    point_pairs.emplace_back(STPoint(start_s, 1.0),
+                             STPoint(start_s + 15.0, 1.0));
+    point_pairs.emplace_back(STPoint(start_s + 10.0, 6.0),
+                             STPoint(start_s + 25.0, 6.0));
+    obstacle_list.emplace_back();
+    obstacle_list.back().SetId("o" + std::to_string(obstacles.size()));
+    obstacle_list.back().SetStBoundary(STBoundary(point_pairs));
+    obstacle_list.back().SetBlockingObstacle(start_s > 20.0);
+    obstacles.push_back(&obstacle_list.back());
+  }
+
+  const double total_time = 7.0;
+  common::TrajectoryPoint init_point;
+  DpStCost cost(config, total_time, obstacles, init_point);
+  DpStCost point_cost(config, total_time, obstacles, init_point);
+
+  const double unit_t = total_time / (config.matrix_dimension_t() - 1);
+  const double unit_s = 0.8;
+  std::vector<double> t_values;
+  double t = 0.0;
+  for (int i = 0; i < config.matrix_dimension_t(); ++i, t += unit_t) {
+    t_values.push_back(t);
+  }
+  std::vector<double> s_values;
+  double s = 0.0;
+  for (int j = 0; j < config.matrix_dimension_s(); ++j, s += unit_s) {
+    s_values.push_back(s);
+  }
+  cost.InitTimeSlices(t_values);
+
+  int num_blocked = 0;
+  std::vector<double> costs(s_values.size());
+  for (uint32_t i = 0; i < t_values.size(); ++i) {
+    cost.GetObstacleCosts(i, s_values.data(), s_values.size(), costs.data());
+    for (uint32_t j = 0; j < s_values.size(); ++j) {
+      StGraphPoint point;
+      point.Init(i, j, STPoint(s_values[j], t_values[i]));
+      const double expected = point_cost.GetObstacleCost(point);
+      if (std::isinf(expected)) {
+        EXPECT_TRUE(std::isinf(costs[j]));
+        ++num_blocked;
+      } else {
+        EXPECT_NEAR(expected, costs[j], 1e-9 * std::fmax(1.0, expected));
+      }
+    }
+  }
+  EXPECT_GT(num_blocked, 0);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -150,14 +150,32 @@ Status DpStGraph::InitCostTable() {
   cost_table_ = std::vector<std::vector<StGraphPoint>>(
       dim_t, std::vector<StGraphPoint>(dim_s, StGraphPoint()));
 
+  row_s_.resize(dim_s);
+  double curr_s = 0.0;
+  for (uint32_t j = 0; j < dim_s; ++j, curr_s += unit_s_) {
+    row_s_[j] = curr_s;
+  }
+
+  std::vector<double> t_values(dim_t);
   double curr_t = 0.0;
   for (uint32_t i = 0; i < cost_table_.size(); ++i, curr_t += unit_t_) {
     auto& cost_table_i = cost_table_[i];
-    double curr_s = 0.0;
-    for (uint32_t j = 0; j < cost_table_i.size(); ++j, curr_s += unit_s_) {
-      cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
+    for (uint32_t j = 0; j < cost_table_i.size(); ++j) {
+      cost_table_i[j].Init(i, j, STPoint(row_s_[j], curr_t));
     }
+    t_values[i] = curr_t;
   }
+  dp_st_cost_.InitTimeSlices(t_values);
+
+  // the speed limits only depend on the row
+  const auto& speed_limit = st_graph_data_.speed_limit();
+  speed_limit_by_row_.resize(dim_s);
+  soft_speed_limit_by_row_.resize(dim_s);
+  for (uint32_t j = 0; j < dim_s; ++j) {
+    speed_limit_by_row_[j] = speed_limit.GetSpeedLimitByS(unit_s_ * j);
+    soft_speed_limit_by_row_[j] = speed_limit.GetSoftSpeedLimitByS(unit_s_ * j);
+  }
+  column_obstacle_cost_.resize(dim_s);
   return Status::OK();
 }
 
@@ -175,19 +193,23 @@ Status DpStGraph::CalculateTotalCost() {
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-          results.push_back(
-              cyber::Async(&DpStGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
-        }
+      dp_st_cost_.GetObstacleCosts(static_cast<uint32_t>(c),
+                                   row_s_.data() + next_lowest_row, count,
+                                   column_obstacle_cost_.data());
+      for (int i = 0; i < count; ++i) {
+        cost_table_[c][next_lowest_row + i].SetObstacleCost(
+            column_obstacle_cost_[i]);
       }
+      auto calculate_cost = [this, c](size_t r) {
+        CalculateCostAt(StGraphMessage(static_cast<uint32_t>(c),
+                                       static_cast<int32_t>(r)));
+      };
       if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-        for (auto& result : results) {
-          result.get();
+        cyber::ParallelFor(next_lowest_row, next_highest_row + 1, 8,
+                           calculate_cost);
+      } else {
+        for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
+          calculate_cost(r);
         }
       }
     }
@@ -241,11 +263,10 @@ void DpStGraph::GetRowRange(const StGraphPoint& point, size_t* next_highest_row,
   }
 }
 
-void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
-  const uint32_t c = msg->c;
-  const uint32_t r = msg->r;
+void DpStGraph::CalculateCostAt(const StGraphMessage& msg) {
+  const uint32_t c = msg.c;
+  const uint32_t r = msg.r;
   auto& cost_cr = cost_table_[c][r];
-  cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
   if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
     return;
   }
@@ -257,10 +278,8 @@ void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
     return;
   }
 
-  double speed_limit =
-      st_graph_data_.speed_limit().GetSpeedLimitByS(unit_s_ * r);
-  double soft_speed_limit =
-      st_graph_data_.speed_limit().GetSoftSpeedLimitByS(unit_s_ * r);
+  const double speed_limit = speed_limit_by_row_[r];
+  const double soft_speed_limit = soft_speed_limit_by_row_[r];
 
   if (c == 1) {
     const double acc = (r * unit_s_ / unit_t_ - init_point_.v()) / unit_t_;
@@ -63,7 +63,7 @@ class DpStGraph {
     uint32_t c;
     uint32_t r;
   };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  void CalculateCostAt(const StGraphMessage& msg);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
@@ -107,6 +107,14 @@ class DpStGraph {
   // cost_table_[t][s]
   // row: s, col: t --- NOTICE: Please do NOT change.
   std::vector<std::vector<StGraphPoint>> cost_table_;
+
+  // s of every row, and the speed limits there
+  std::vector<double> row_s_;
+  std::vector<double> speed_limit_by_row_;
+  std::vector<double> soft_speed_limit_by_row_;
+
+  // obstacle costs of the rows of one column
+  std::vector<double> column_obstacle_cost_;
 };
 
 }  // namespace planning
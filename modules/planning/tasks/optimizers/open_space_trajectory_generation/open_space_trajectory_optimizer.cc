@@ -20,6 +20,12 @@
 
 #include "modules/planning/tasks/optimizers/open_space_trajectory_generation/open_space_trajectory_optimizer.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "cyber/task/task.h"
+#include "modules/planning/common/planning_gflags.h"
+
 namespace apollo {
 namespace planning {
 
@@ -108,31 +114,9 @@ common::Status OpenSpaceTrajectoryOptimizer::Plan(
                   "State warm start problem failed to solve");
   }
   // load Warm Start result(horizon is timestep number minus one)
-  size_t horizon = result.x.size() - 1;
-  Eigen::MatrixXd xWS = Eigen::MatrixXd::Zero(4, horizon + 1);
-  Eigen::MatrixXd uWS = Eigen::MatrixXd::Zero(2, horizon);
-  Eigen::VectorXd x = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(
-      result.x.data(), horizon + 1);
-  Eigen::VectorXd y = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(
-      result.y.data(), horizon + 1);
-  Eigen::VectorXd phi = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(
-      result.phi.data(), horizon + 1);
-  Eigen::VectorXd v = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(
-      result.v.data(), horizon + 1);
-  Eigen::VectorXd steer = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(
-      result.steer.data(), horizon);
-  Eigen::VectorXd a =
-      Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(result.a.data(), horizon);
-  xWS.row(0) = x;
-  xWS.row(1) = y;
-  xWS.row(2) = phi;
-  xWS.row(3) = v;
-  uWS.row(0) = steer;
-  uWS.row(1) = a;
-
-  // Result container for distance approach problem
-  Eigen::MatrixXd l_warm_up;
-  Eigen::MatrixXd n_warm_up;
+  Eigen::MatrixXd xWS;
+  Eigen::MatrixXd uWS;
+  LoadWarmStart(result, &xWS, &uWS);
 
   // load vehicle configuration
   const common::VehicleParam& vehicle_param_ =
@@ -147,46 +131,48 @@ common::Status OpenSpaceTrajectoryOptimizer::Plan(
   // Get obstacle num
   size_t obstacles_num = obstacles_vertices_vec.size();
 
-  // Get timestep delta t
-  double ts = config_.planner_open_space_config().delta_t();
-
-  if (FLAGS_use_dual_variable_warm_start) {
-    if (dual_variable_warm_start_->Solve(
-            horizon, ts, ego, obstacles_num, obstacles_edges_num, obstacles_A,
-            obstacles_b, xWS, &l_warm_up, &n_warm_up)) {
-      ADEBUG << "Dual variable problem solved successfully!";
-    } else {
-      ADEBUG << "Dual variable problem failed to solve";
-      return Status(ErrorCode::PLANNING_ERROR,
-                    "Dual variable problem failed to solve");
-    }
-  } else {
-    l_warm_up =
-        0.5 * Eigen::MatrixXd::Ones(obstacles_edges_num.sum(), horizon + 1);
-    n_warm_up = 0.5 * Eigen::MatrixXd::Ones(4 * obstacles_num, horizon + 1);
-  }
-
   // Result Containers for distance approach trajectory smoothing problem
   Eigen::MatrixXd state_result_ds;
   Eigen::MatrixXd control_result_ds;
   Eigen::MatrixXd time_result_ds;
-  Eigen::MatrixXd dual_l_result_ds;
-  Eigen::MatrixXd dual_n_result_ds;
 
-  if (distance_approach_->Solve(
-          x0, xF, last_time_u, horizon, ts, ego, xWS, uWS, l_warm_up, n_warm_up,
-          XYbounds, obstacles_num, obstacles_edges_num, obstacles_A,
-          obstacles_b, &state_result_ds, &control_result_ds, &time_result_ds,
-          &dual_l_result_ds, &dual_n_result_ds)) {
-    ADEBUG << "Distance approach problem solved successfully!";
-  } else {
-    ADEBUG << "Distance approach problem failed to solve";
-    return Status(ErrorCode::PLANNING_ERROR,
-                  "Distance approach problem failed to solve");
+  bool smoothed = false;
+  if (FLAGS_enable_parallel_trajectory_smoothing) {
+    std::vector<HybridAStartResult> partitioned_results;
+    PartitionByGear(result, &partitioned_results);
+    if (partitioned_results.size() > 1) {
+      smoothed = SmoothPartitions(
+          partitioned_results, x0, xF, last_time_u, ego, XYbounds,
+          obstacles_num, obstacles_edges_num, obstacles_A, obstacles_b,
+          &state_result_ds, &control_result_ds, &time_result_ds);
+      if (!smoothed) {
+        AWARN << "Gear partitioned smoothing failed, smooth the whole "
+                 "warm start trajectory";
+      }
+    }
+  }
+
+  if (!smoothed) {
+    Eigen::MatrixXd l_warm_up;
+    Eigen::MatrixXd n_warm_up;
+    if (!GenerateDualWarmStart(xWS, ego, obstacles_num, obstacles_edges_num,
+                               obstacles_A, obstacles_b, &l_warm_up,
+                               &n_warm_up)) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Dual variable problem failed to solve");
+    }
+    if (!GenerateDistanceApproachTraj(
+            x0, xF, last_time_u, ego, xWS, uWS, l_warm_up, n_warm_up,
+            XYbounds, obstacles_num, obstacles_edges_num, obstacles_A,
+            obstacles_b, &state_result_ds, &control_result_ds,
+            &time_result_ds)) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Distance approach problem failed to solve");
+    }
   }
 
   // rescale the states to the world frame
-  for (size_t i = 0; i < horizon + 1; ++i) {
+  for (Eigen::Index i = 0; i < state_result_ds.cols(); ++i) {
     PathPointDeNormalizing(rotate_angle, translate_origin,
                            &(state_result_ds(0, i)), &(state_result_ds(1, i)),
                            &(state_result_ds(2, i)));
@@ -197,6 +183,199 @@ common::Status OpenSpaceTrajectoryOptimizer::Plan(
   return Status::OK();
 }
 
+void OpenSpaceTrajectoryOptimizer::LoadWarmStart(
+    const HybridAStartResult& result, Eigen::MatrixXd* xWS,
+    Eigen::MatrixXd* uWS) {
+  const size_t horizon = result.x.size() - 1;
+  *xWS = Eigen::MatrixXd::Zero(4, horizon + 1);
+  *uWS = Eigen::MatrixXd::Zero(2, horizon);
+  for (size_t i = 0; i < horizon + 1; ++i) {
+    (*xWS)(0, i) = result.x[i];
+    (*xWS)(1, i) = result.y[i];
+    (*xWS)(2, i) = result.phi[i];
+    (*xWS)(3, i) = result.v[i];
+  }
+  for (size_t i = 0; i < horizon; ++i) {
+    (*uWS)(0, i) = result.steer[i];
+    (*uWS)(1, i) = result.a[i];
+  }
+}
+
+void OpenSpaceTrajectoryOptimizer::PartitionByGear(
+    const HybridAStartResult& result,
+    std::vector<HybridAStartResult>* partitioned_results) {
+  partitioned_results->clear();
+  const size_t horizon = result.x.size() - 1;
+  size_t start = 0;
+  for (size_t i = 1; i <= horizon; ++i) {
+    // the vehicle stops at a gear switch, which ends one partition and
+    // starts the next
+    const bool gear_switch =
+        i < horizon && result.v[i - 1] * result.v[i] < 0.0;
+    if (!gear_switch && i < horizon) {
+      continue;
+    }
+    HybridAStartResult partition;
+    partition.x.assign(result.x.begin() + start, result.x.begin() + i + 1);
+    partition.y.assign(result.y.begin() + start, result.y.begin() + i + 1);
+    partition.phi.assign(result.phi.begin() + start,
+                         result.phi.begin() + i + 1);
+    partition.v.assign(result.v.begin() + start, result.v.begin() + i + 1);
+    if (start > 0) {
+      partition.v.front() = 0.0;
+    }
+    partition.v.back() = 0.0;
+    partition.steer.assign(result.steer.begin() + start,
+                           result.steer.begin() + i);
+    partition.a.assign(result.a.begin() + start, result.a.begin() + i);
+    partitioned_results->push_back(std::move(partition));
+    start = i;
+  }
+}
+
+bool OpenSpaceTrajectoryOptimizer::SmoothPartitions(
+    const std::vector<HybridAStartResult>& partitioned_results,
+    const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+    const Eigen::MatrixXd& last_time_u, const Eigen::MatrixXd& ego,
+    const std::vector<double>& XYbounds, const size_t obstacles_num,
+    const Eigen::MatrixXi& obstacles_edges_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    Eigen::MatrixXd* state_result_ds, Eigen::MatrixXd* control_result_ds,
+    Eigen::MatrixXd* time_result_ds) {
+  const size_t size = partitioned_results.size();
+  std::vector<Eigen::MatrixXd> xWS(size);
+  std::vector<Eigen::MatrixXd> uWS(size);
+  std::vector<Eigen::MatrixXd> l_warm_up(size);
+  std::vector<Eigen::MatrixXd> n_warm_up(size);
+  for (size_t i = 0; i < size; ++i) {
+    LoadWarmStart(partitioned_results[i], &xWS[i], &uWS[i]);
+  }
+
+  // OSQP problems are independent, ipopt with MUMPS is not reentrant and
+  // stays sequential
+  std::vector<uint8_t> dual_solved(size, 0);
+  auto solve_dual = [&](const size_t i) {
+    dual_solved[i] = GenerateDualWarmStart(
+        xWS[i], ego, obstacles_num, obstacles_edges_num, obstacles_A,
+        obstacles_b, &l_warm_up[i], &n_warm_up[i]);
+  };
+  if (FLAGS_use_dual_variable_warm_start &&
+      config_.planner_open_space_config()
+              .dual_variable_warm_start_config()
+              .qp_format() == OSQP) {
+    cyber::ParallelFor(static_cast<size_t>(0), size, 1, solve_dual);
+  } else {
+    for (size_t i = 0; i < size; ++i) {
+      solve_dual(i);
+    }
+  }
+  if (std::find(dual_solved.begin(), dual_solved.end(), 0) !=
+      dual_solved.end()) {
+    return false;
+  }
+
+  std::vector<Eigen::MatrixXd> state_results(size);
+  std::vector<Eigen::MatrixXd> control_results(size);
+  std::vector<Eigen::MatrixXd> time_results(size);
+  Eigen::Index states_size = 0;
+  Eigen::Index controls_size = 0;
+  for (size_t i = 0; i < size; ++i) {
+    Eigen::MatrixXd partition_x0 = xWS[i].col(0);
+    Eigen::MatrixXd partition_xF = xWS[i].col(xWS[i].cols() - 1);
+    Eigen::MatrixXd partition_last_time_u = Eigen::MatrixXd::Zero(2, 1);
+    if (i == 0) {
+      partition_x0 = x0;
+      partition_last_time_u = last_time_u;
+    }
+    if (i + 1 == size) {
+      partition_xF = xF;
+    }
+    if (!GenerateDistanceApproachTraj(
+            partition_x0, partition_xF, partition_last_time_u, ego, xWS[i],
+            uWS[i], l_warm_up[i], n_warm_up[i], XYbounds, obstacles_num,
+            obstacles_edges_num, obstacles_A, obstacles_b, &state_results[i],
+            &control_results[i], &time_results[i])) {
+      return false;
+    }
+    // consecutive partitions share the gear switch state, keep it once
+    const Eigen::Index horizon = xWS[i].cols() - 1;
+    states_size += i + 1 == size ? state_results[i].cols() : horizon;
+    controls_size += i + 1 == size ? control_results[i].cols() : horizon;
+  }
+
+  state_result_ds->resize(4, states_size);
+  control_result_ds->resize(2, controls_size);
+  time_result_ds->resize(1, states_size);
+  Eigen::Index state_index = 0;
+  Eigen::Index control_index = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const Eigen::Index horizon = xWS[i].cols() - 1;
+    const Eigen::Index states =
+        i + 1 == size ? state_results[i].cols() : horizon;
+    const Eigen::Index controls =
+        i + 1 == size ? control_results[i].cols() : horizon;
+    state_result_ds->middleCols(state_index, states) =
+        state_results[i].leftCols(states);
+    time_result_ds->middleCols(state_index, states) =
+        time_results[i].leftCols(states);
+    control_result_ds->middleCols(control_index, controls) =
+        control_results[i].leftCols(controls);
+    state_index += states;
+    control_index += controls;
+  }
+  return true;
+}
+
+bool OpenSpaceTrajectoryOptimizer::GenerateDualWarmStart(
+    const Eigen::MatrixXd& xWS, const Eigen::MatrixXd& ego,
+    const size_t obstacles_num, const Eigen::MatrixXi& obstacles_edges_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    Eigen::MatrixXd* l_warm_up, Eigen::MatrixXd* n_warm_up) {
+  const size_t horizon = xWS.cols() - 1;
+  if (!FLAGS_use_dual_variable_warm_start) {
+    *l_warm_up =
+        0.5 * Eigen::MatrixXd::Ones(obstacles_edges_num.sum(), horizon + 1);
+    *n_warm_up = 0.5 * Eigen::MatrixXd::Ones(4 * obstacles_num, horizon + 1);
+    return true;
+  }
+  const double ts = config_.planner_open_space_config().delta_t();
+  if (dual_variable_warm_start_->Solve(horizon, ts, ego, obstacles_num,
+                                       obstacles_edges_num, obstacles_A,
+                                       obstacles_b, xWS, l_warm_up,
+                                       n_warm_up)) {
+    ADEBUG << "Dual variable problem solved successfully!";
+    return true;
+  }
+  ADEBUG << "Dual variable problem failed to solve";
+  return false;
+}
+
+bool OpenSpaceTrajectoryOptimizer::GenerateDistanceApproachTraj(
+    const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+    const Eigen::MatrixXd& last_time_u, const Eigen::MatrixXd& ego,
+    const Eigen::MatrixXd& xWS, const Eigen::MatrixXd& uWS,
+    const Eigen::MatrixXd& l_warm_up, const Eigen::MatrixXd& n_warm_up,
+    const std::vector<double>& XYbounds, const size_t obstacles_num,
+    const Eigen::MatrixXi& obstacles_edges_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    Eigen::MatrixXd* state_result_ds, Eigen::MatrixXd* control_result_ds,
+    Eigen::MatrixXd* time_result_ds) {
+  const size_t horizon = xWS.cols() - 1;
+  const double ts = config_.planner_open_space_config().delta_t();
+  Eigen::MatrixXd dual_l_result_ds;
+  Eigen::MatrixXd dual_n_result_ds;
+  if (distance_approach_->Solve(
+          x0, xF, last_time_u, horizon, ts, ego, xWS, uWS, l_warm_up, n_warm_up,
+          XYbounds, obstacles_num, obstacles_edges_num, obstacles_A,
+          obstacles_b, state_result_ds, control_result_ds, time_result_ds,
+          &dual_l_result_ds, &dual_n_result_ds)) {
+    ADEBUG << "Distance approach problem solved successfully!";
+    return true;
+  }
+  ADEBUG << "Distance approach problem failed to solve";
+  return false;
+}
+
 bool OpenSpaceTrajectoryOptimizer::IsInitPointNearDestination(
     const common::TrajectoryPoint& planning_init_point,
     const std::vector<double>& end_pose, double rotate_angle,
@@ -62,6 +62,13 @@ class OpenSpaceTrajectoryOptimizer {
     *optimized_trajectory = optimized_trajectory_;
   }
 
+  /**
+   * @brief split the warm start trajectory at gear switches, neighbouring
+   * partitions share the switch state with zero speed.
+   */
+  void PartitionByGear(const HybridAStartResult& result,
+                       std::vector<HybridAStartResult>* partitioned_results);
+
  private:
   bool IsInitPointNearDestination(
       const common::TrajectoryPoint& planning_init_point,
@@ -76,6 +83,42 @@ class OpenSpaceTrajectoryOptimizer {
                               const common::math::Vec2d& translate_origin,
                               double* x, double* y, double* phi);
 
+  void LoadWarmStart(const HybridAStartResult& result, Eigen::MatrixXd* xWS,
+                     Eigen::MatrixXd* uWS);
+
+  /**
+   * @brief smooth every partition as its own problem and join the results.
+   */
+  bool SmoothPartitions(
+      const std::vector<HybridAStartResult>& partitioned_results,
+      const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+      const Eigen::MatrixXd& last_time_u, const Eigen::MatrixXd& ego,
+      const std::vector<double>& XYbounds, const size_t obstacles_num,
+      const Eigen::MatrixXi& obstacles_edges_num,
+      const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+      Eigen::MatrixXd* state_result_ds, Eigen::MatrixXd* control_result_ds,
+      Eigen::MatrixXd* time_result_ds);
+
+  bool GenerateDualWarmStart(const Eigen::MatrixXd& xWS,
+                             const Eigen::MatrixXd& ego,
+                             const size_t obstacles_num,
+                             const Eigen::MatrixXi& obstacles_edges_num,
+                             const Eigen::MatrixXd& obstacles_A,
+                             const Eigen::MatrixXd& obstacles_b,
+                             Eigen::MatrixXd* l_warm_up,
+                             Eigen::MatrixXd* n_warm_up);
+
+  bool GenerateDistanceApproachTraj(
+      const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+      const Eigen::MatrixXd& last_time_u, const Eigen::MatrixXd& ego,
+      const Eigen::MatrixXd& xWS, const Eigen::MatrixXd& uWS,
+      const Eigen::MatrixXd& l_warm_up, const Eigen::MatrixXd& n_warm_up,
+      const std::vector<double>& XYbounds, const size_t obstacles_num,
+      const Eigen::MatrixXi& obstacles_edges_num,
+      const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+      Eigen::MatrixXd* state_result_ds, Eigen::MatrixXd* control_result_ds,
+      Eigen::MatrixXd* time_result_ds);
+
   void LoadTrajectory(const Eigen::MatrixXd& state_result_ds,
                       const Eigen::MatrixXd& control_result_ds,
                       const Eigen::MatrixXd& time_result_ds);
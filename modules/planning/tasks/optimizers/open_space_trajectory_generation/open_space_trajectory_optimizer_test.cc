@@ -35,5 +35,47 @@ class OpenSpaceTrajectoryOptimizerTest : public ::testing::Test {
   OpenSpaceTrajectoryOptimizerConfig config;
 };
 
+TEST_F(OpenSpaceTrajectoryOptimizerTest, PartitionByGear) {
+  OpenSpaceTrajectoryOptimizer open_space_trajectory_optimizer(config);
+  // forward, backward and forward again
+  const std::vector<double> v{1.0,  1.0,  1.0, 1.0, 1.0, -1.0, -1.0,
+                              -1.0, -1.0, 1.0, 1.0, 1.0, 0.0};
+  HybridAStartResult result;
+  for (size_t i = 0; i < v.size(); ++i) {
+    result.x.push_back(static_cast<double>(i));
+    result.y.push_back(0.0);
+    result.phi.push_back(0.0);
+    result.v.push_back(v[i]);
+    if (i + 1 < v.size()) {
+      result.a.push_back(0.0);
+      result.steer.push_back(0.0);
+    }
+  }
+
+  std::vector<HybridAStartResult> partitioned_results;
+  open_space_trajectory_optimizer.PartitionByGear(result,
+                                                  &partitioned_results);
+  ASSERT_EQ(partitioned_results.size(), 3);
+  EXPECT_EQ(partitioned_results[0].x.size(), 6);
+  EXPECT_EQ(partitioned_results[1].x.size(), 5);
+  EXPECT_EQ(partitioned_results[2].x.size(), 4);
+  for (size_t i = 0; i < partitioned_results.size(); ++i) {
+    const auto& partition = partitioned_results[i];
+    EXPECT_EQ(partition.steer.size() + 1, partition.x.size());
+    EXPECT_EQ(partition.a.size() + 1, partition.x.size());
+    EXPECT_DOUBLE_EQ(partition.v.back(), 0.0);
+    if (i > 0) {
+      EXPECT_DOUBLE_EQ(partition.v.front(), 0.0);
+      EXPECT_DOUBLE_EQ(partition.x.front(),
+                       partitioned_results[i - 1].x.back());
+    }
+  }
+
+  result.v.assign(v.size(), 1.0);
+  open_space_trajectory_optimizer.PartitionByGear(result,
+                                                  &partitioned_results);
+  EXPECT_EQ(partitioned_results.size(), 1);
+}
+
 }  // namespace planning
 }  // namespace apollo
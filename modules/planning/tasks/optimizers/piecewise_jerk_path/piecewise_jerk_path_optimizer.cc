@@ -25,7 +25,6 @@
 #include <vector>
 
 #include "modules/planning/common/planning_gflags.h"
-#include "modules/planning/math/finite_element_qp/fem_1d_qp_problem.h"
 
 namespace apollo {
 namespace planning {
@@ -65,8 +64,22 @@ common::Status PiecewiseJerkPathOptimizer::Process(
   std::array<double, 3> init_lateral_state{frenet_point.l(), frenet_point.dl(),
                                            frenet_point.ddl()};
 
-  auto fem_1d_qp_ = std::make_unique<Fem1dQpProblem>(
-      num_of_points, init_lateral_state, delta_s, w, FLAGS_lateral_jerk_bound);
+  // the problem matrices only depend on these, otherwise start over
+  if (fem_1d_qp_ == nullptr || num_of_points != num_of_points_ ||
+      delta_s != delta_s_ || w != w_) {
+    fem_1d_qp_ = std::make_unique<Fem1dQpProblem>(
+        num_of_points, init_lateral_state, delta_s, w,
+        FLAGS_lateral_jerk_bound);
+    num_of_points_ = num_of_points;
+    delta_s_ = delta_s;
+    w_ = w;
+  } else {
+    fem_1d_qp_->ResetInitConditions(init_lateral_state);
+    // the reference line may be new, measure the last start point on it
+    fem_1d_qp_->SetWarmStartOffset(
+        frenet_point.s() - reference_line.GetFrenetPoint(last_init_point_).s());
+  }
+  last_init_point_ = init_point.path_point();
 
   auto start_time = std::chrono::system_clock::now();
 
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+
+#include "modules/planning/math/finite_element_qp/fem_1d_qp_problem.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -36,6 +40,14 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
                          const ReferenceLine& reference_line,
                          const common::TrajectoryPoint& init_point,
                          PathData* const path_data) override;
+
+ private:
+  // kept so that the solver is warm started by the previous cycle
+  std::unique_ptr<Fem1dQpProblem> fem_1d_qp_;
+  size_t num_of_points_ = 0;
+  double delta_s_ = 0.0;
+  std::array<double, 5> w_ = {};
+  common::PathPoint last_init_point_;
 };
 
 }  // namespace planning
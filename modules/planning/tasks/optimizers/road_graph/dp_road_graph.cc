@@ -20,6 +20,7 @@
 
 #include "modules/planning/tasks/optimizers/road_graph/dp_road_graph.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/task/task.h"
@@ -129,6 +130,16 @@ bool DpRoadGraph::GenerateMinCostPath(
       obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_,
       reference_line_info_.AdcSlBoundary());
 
+  // the curves between two levels all start from the station of a level
+  std::vector<double> start_s(1, init_sl_point_.s());
+  for (const auto &level_points : path_waypoints) {
+    if (!level_points.empty()) {
+      start_s.push_back(level_points.front().s());
+    }
+  }
+  trajectory_cost.PrepareStations(
+      start_s, *std::max_element(start_s.begin(), start_s.end()));
+
   std::list<std::list<DpRoadGraphNode>> graph_nodes;
 
   // find one point from first row
@@ -151,26 +162,47 @@ bool DpRoadGraph::GenerateMinCostPath(
     const auto &level_points = path_waypoints[level];
 
     graph_nodes.emplace_back();
-    std::vector<std::future<void>> results;
-
-    for (size_t i = 0; i < level_points.size(); ++i) {
-      const auto &cur_point = level_points[i];
-
+    std::vector<DpRoadGraphNode *> cur_nodes;
+    cur_nodes.reserve(level_points.size());
+    for (const auto &cur_point : level_points) {
       graph_nodes.back().emplace_back(cur_point, nullptr);
+      cur_nodes.push_back(&(graph_nodes.back().back()));
+    }
 
-      auto msg = std::make_shared<RoadGraphMessage>(
-          prev_dp_nodes, level, total_level, &trajectory_cost, &front,
-          &(graph_nodes.back().back()));
-
-      if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        results.emplace_back(cyber::Async(&DpRoadGraph::UpdateNode, this, msg));
-      } else {
-        UpdateNode(msg);
+    // the edges to the level are evaluated in chunks, then applied to their
+    // nodes in order
+    std::vector<RoadGraphEdge> edges;
+    edges.reserve(cur_nodes.size() * (prev_dp_nodes.size() + 1));
+    for (auto *cur_node : cur_nodes) {
+      for (const auto &prev_dp_node : prev_dp_nodes) {
+        edges.emplace_back();
+        edges.back().prev_node = &prev_dp_node;
+        edges.back().cur_node = cur_node;
+      }
+      // try to connect the current point with the first point directly
+      if (reference_line_info_.IsChangeLanePath() && level >= 2) {
+        edges.emplace_back();
+        edges.back().prev_node = &front;
+        edges.back().cur_node = cur_node;
+        edges.back().from_init_point = true;
       }
     }
+    auto evaluate_edge = [&](size_t i) {
+      EvaluateEdge(static_cast<uint32_t>(level),
+                   static_cast<uint32_t>(total_level), &trajectory_cost,
+                   &edges[i]);
+    };
     if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-      for (auto &result : results) {
-        result.get();
+      constexpr size_t kEdgesPerTask = 4;
+      cyber::ParallelFor(0, edges.size(), kEdgesPerTask, evaluate_edge);
+    } else {
+      for (size_t i = 0; i < edges.size(); ++i) {
+        evaluate_edge(i);
+      }
+    }
+    for (const auto &edge : edges) {
+      if (edge.is_valid) {
+        edge.cur_node->UpdateCost(edge.prev_node, edge.curve, edge.cost);
       }
     }
   }
@@ -203,50 +235,46 @@ bool DpRoadGraph::GenerateMinCostPath(
   return true;
 }
 
-void DpRoadGraph::UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg) {
-  DCHECK_NOTNULL(msg);
-  DCHECK_NOTNULL(msg->trajectory_cost);
-  DCHECK_NOTNULL(msg->front);
-  DCHECK_NOTNULL(msg->cur_node);
-  for (const auto &prev_dp_node : msg->prev_nodes) {
-    const auto &prev_sl_point = prev_dp_node.sl_point;
-    const auto &cur_point = msg->cur_node->sl_point;
-    double init_dl = 0.0;
-    double init_ddl = 0.0;
-    if (msg->level == 1) {
-      init_dl = init_frenet_frame_point_.dl();
-      init_ddl = init_frenet_frame_point_.ddl();
-    }
-    QuinticPolynomialCurve1d curve(prev_sl_point.l(), init_dl, init_ddl,
-                                   cur_point.l(), 0.0, 0.0,
-                                   cur_point.s() - prev_sl_point.s());
-
-    if (!IsValidCurve(curve)) {
-      continue;
-    }
-    const auto cost =
-        msg->trajectory_cost->Calculate(curve, prev_sl_point.s(), cur_point.s(),
-                                        msg->level, msg->total_level) +
-        prev_dp_node.min_cost;
-
-    msg->cur_node->UpdateCost(&prev_dp_node, curve, cost);
-  }
-
-  // try to connect the current point with the first point directly
-  if (reference_line_info_.IsChangeLanePath() && msg->level >= 2) {
+void DpRoadGraph::EvaluateEdge(const uint32_t level,
+                               const uint32_t total_level,
+                               TrajectoryCost *trajectory_cost,
+                               RoadGraphEdge *edge) {
+  DCHECK_NOTNULL(trajectory_cost);
+  DCHECK_NOTNULL(edge);
+  const auto &cur_point = edge->cur_node->sl_point;
+  if (edge->from_init_point) {
     const double init_dl = init_frenet_frame_point_.dl();
     const double init_ddl = init_frenet_frame_point_.ddl();
-    QuinticPolynomialCurve1d curve(
-        init_sl_point_.l(), init_dl, init_ddl, msg->cur_node->sl_point.l(), 0.0,
-        0.0, msg->cur_node->sl_point.s() - init_sl_point_.s());
-    if (!IsValidCurve(curve)) {
+    edge->curve = QuinticPolynomialCurve1d(
+        init_sl_point_.l(), init_dl, init_ddl, cur_point.l(), 0.0, 0.0,
+        cur_point.s() - init_sl_point_.s());
+    if (!IsValidCurve(edge->curve)) {
       return;
     }
-    const auto cost = msg->trajectory_cost->Calculate(
-        curve, init_sl_point_.s(), msg->cur_node->sl_point.s(), msg->level,
-        msg->total_level);
-    msg->cur_node->UpdateCost(msg->front, curve, cost);
+    edge->cost = trajectory_cost->Calculate(edge->curve, init_sl_point_.s(),
+                                            cur_point.s(), level, total_level);
+    edge->is_valid = true;
+    return;
+  }
+
+  const auto &prev_sl_point = edge->prev_node->sl_point;
+  double init_dl = 0.0;
+  double init_ddl = 0.0;
+  if (level == 1) {
+    init_dl = init_frenet_frame_point_.dl();
+    init_ddl = init_frenet_frame_point_.ddl();
+  }
+  edge->curve = QuinticPolynomialCurve1d(prev_sl_point.l(), init_dl, init_ddl,
+                                         cur_point.l(), 0.0, 0.0,
+                                         cur_point.s() - prev_sl_point.s());
+
+  if (!IsValidCurve(edge->curve)) {
+    return;
   }
+  edge->cost = trajectory_cost->Calculate(edge->curve, prev_sl_point.s(),
+                                          cur_point.s(), level, total_level) +
+               edge->prev_node->min_cost;
+  edge->is_valid = true;
 }
 
 bool DpRoadGraph::IsValidCurve(const QuinticPolynomialCurve1d &curve) const {
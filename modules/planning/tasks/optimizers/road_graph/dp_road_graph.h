@@ -107,25 +107,18 @@ class DpRoadGraph {
                     const double end_s, const uint32_t curr_level,
                     const uint32_t total_level, ComparableCost *cost);
 
-  struct RoadGraphMessage {
-    RoadGraphMessage(const std::list<DpRoadGraphNode> &_prev_nodes,
-                     const uint32_t _level, const uint32_t _total_level,
-                     TrajectoryCost *_trajectory_cost, DpRoadGraphNode *_front,
-                     DpRoadGraphNode *_cur_node)
-        : prev_nodes(_prev_nodes),
-          level(_level),
-          total_level(_total_level),
-          trajectory_cost(_trajectory_cost),
-          front(_front),
-          cur_node(_cur_node) {}
-    const std::list<DpRoadGraphNode> &prev_nodes;
-    const uint32_t level;
-    const uint32_t total_level;
-    TrajectoryCost *trajectory_cost = nullptr;
-    DpRoadGraphNode *front = nullptr;
+  // a curve from a node of the previous level, or from the init point on
+  // lane change paths, to a node of the current level
+  struct RoadGraphEdge {
+    const DpRoadGraphNode *prev_node = nullptr;
     DpRoadGraphNode *cur_node = nullptr;
+    bool from_init_point = false;
+    bool is_valid = false;
+    QuinticPolynomialCurve1d curve;
+    ComparableCost cost;
   };
-  void UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg);
+  void EvaluateEdge(const uint32_t level, const uint32_t total_level,
+                    TrajectoryCost *trajectory_cost, RoadGraphEdge *edge);
 
  private:
   DpPolyPathConfig config_;
@@ -26,6 +26,7 @@
 #include "modules/common/proto/pnc_point.pb.h"
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/angle.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -38,6 +39,13 @@ using apollo::common::math::Box2d;
 using apollo::common::math::Sigmoid;
 using apollo::common::math::Vec2d;
 
+namespace {
+
+// curve samples this close to the ADC are never off road
+constexpr double kIgnoreDistance = 5.0;
+
+}  // namespace
+
 TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
                                const ReferenceLine &reference_line,
                                const bool is_change_lane_path,
@@ -104,11 +112,74 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
       dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
+
+  // the ADC reaches the same stations at the time stamps for all curves,
+  // the reference points are kept up to the end of the reference line
+  if (!dynamic_obstacle_boxes_.empty()) {
+    double time_stamp = 0.0;
+    for (uint32_t index = 0; index < num_of_time_stamps_;
+         ++index, time_stamp += config_.eval_time_interval()) {
+      common::SpeedPoint speed_point;
+      heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
+      const double ref_s = speed_point.s() + init_sl_point_.s();
+      time_stamp_s_.push_back(ref_s);
+      if (ref_s <= reference_line_->Length() &&
+          time_stamp_points_.size() + 1 == time_stamp_s_.size()) {
+        time_stamp_points_.push_back(reference_line_->GetReferencePoint(ref_s));
+      }
+    }
+  }
+}
+
+void TrajectoryCost::PrepareStations(const std::vector<double> &start_s,
+                                     const double max_end_s) {
+  stations_.clear();
+  const double back_edge_to_center = common::VehicleConfigHelper::Instance()
+                                         ->GetConfig()
+                                         .vehicle_param()
+                                         .back_edge_to_center();
+  for (const double station_s : start_s) {
+    if (FindStation(station_s) != nullptr) {
+      continue;
+    }
+    Station station;
+    station.start_s = station_s;
+    for (double curve_s = 0.0; curve_s < (max_end_s - station_s);
+         curve_s += config_.path_resolution()) {
+      double left_width = 0.0;
+      double right_width = 0.0;
+      reference_line_->GetLaneWidth(curve_s + station_s, &left_width,
+                                    &right_width);
+      station.lane_widths.emplace_back(left_width, right_width);
+    }
+    // obstacles across the reference line and obstacles ending behind the
+    // ADC at every sample never add a cost, see GetCostFromObsSL()
+    for (size_t i = 0; i < static_obstacle_sl_boundaries_.size(); ++i) {
+      const auto &sl_boundary = static_obstacle_sl_boundaries_[i];
+      if (sl_boundary.start_l() * sl_boundary.end_l() <= 0.0 ||
+          sl_boundary.end_s() < station_s - back_edge_to_center) {
+        continue;
+      }
+      station.static_obstacle_indices.push_back(i);
+    }
+    stations_.push_back(std::move(station));
+  }
+}
+
+const TrajectoryCost::Station *TrajectoryCost::FindStation(
+    const double start_s) const {
+  for (const auto &station : stations_) {
+    if (station.start_s == start_s) {
+      return &station;
+    }
+  }
+  return nullptr;
 }
 
 ComparableCost TrajectoryCost::CalculatePathCost(
     const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s, const uint32_t curr_level, const uint32_t total_level) {
+    const double end_s, const uint32_t curr_level, const uint32_t total_level,
+    const Station *station) {
   ComparableCost cost;
   double path_cost = 0.0;
   std::function<double(const double)> quasi_softmax = [this](const double x) {
@@ -118,14 +189,21 @@ ComparableCost TrajectoryCost::CalculatePathCost(
     return (b + std::exp(-k * (x - l0))) / (1.0 + std::exp(-k * (x - l0)));
   };
 
+  size_t sample = 0;
   for (double curve_s = 0.0; curve_s < (end_s - start_s);
-       curve_s += config_.path_resolution()) {
+       curve_s += config_.path_resolution(), ++sample) {
     const double l = curve.Evaluate(0, curve_s);
 
     path_cost += l * l * config_.path_l_cost() * quasi_softmax(std::fabs(l));
 
     const double dl = std::fabs(curve.Evaluate(1, curve_s));
-    if (IsOffRoad(curve_s + start_s, l, dl, is_change_lane_path_)) {
+    const bool is_off_road =
+        station != nullptr && sample < station->lane_widths.size()
+            ? IsOffRoad(curve_s + start_s, l, dl,
+                        station->lane_widths[sample].first,
+                        station->lane_widths[sample].second)
+            : IsOffRoad(curve_s + start_s, l, dl, is_change_lane_path_);
+    if (is_off_road) {
       cost.cost_items[ComparableCost::OUT_OF_BOUNDARY] = true;
     }
 
@@ -148,7 +226,18 @@ ComparableCost TrajectoryCost::CalculatePathCost(
 bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
                                const double dl,
                                const bool is_change_lane_path) {
-  constexpr double kIgnoreDistance = 5.0;
+  if (ref_s - init_sl_point_.s() < kIgnoreDistance) {
+    return false;
+  }
+  double left_width = 0.0;
+  double right_width = 0.0;
+  reference_line_->GetLaneWidth(ref_s, &left_width, &right_width);
+  return IsOffRoad(ref_s, l, dl, left_width, right_width);
+}
+
+bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
+                               const double dl, const double left_width,
+                               const double right_width) const {
   if (ref_s - init_sl_point_.s() < kIgnoreDistance) {
     return false;
   }
@@ -169,10 +258,6 @@ bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
   const double r_l = param.back_edge_to_center();
   const double r = std::sqrt(r_w * r_w + r_l * r_l);
 
-  double left_width = 0.0;
-  double right_width = 0.0;
-  reference_line_->GetLaneWidth(ref_s, &left_width, &right_width);
-
   double left_bound = std::max(init_sl_point_.l() + r + buffer, left_width);
   double right_bound = std::min(init_sl_point_.l() - r - buffer, -right_width);
   if (rear_center.y() + r + buffer / 2.0 > left_bound ||
@@ -189,11 +274,21 @@ bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
 
 ComparableCost TrajectoryCost::CalculateStaticObstacleCost(
     const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s) {
+    const double end_s, const Station *station) {
   ComparableCost obstacle_cost;
+  if (station != nullptr && station->static_obstacle_indices.empty()) {
+    return obstacle_cost;
+  }
   for (double curr_s = start_s; curr_s <= end_s;
        curr_s += config_.path_resolution()) {
     const double curr_l = curve.Evaluate(0, curr_s - start_s);
+    if (station != nullptr) {
+      for (const size_t index : station->static_obstacle_indices) {
+        obstacle_cost += GetCostFromObsSL(
+            curr_s, curr_l, static_obstacle_sl_boundaries_[index]);
+      }
+      continue;
+    }
     for (const auto &obs_sl_boundary : static_obstacle_sl_boundaries_) {
       obstacle_cost += GetCostFromObsSL(curr_s, curr_l, obs_sl_boundary);
     }
@@ -213,9 +308,14 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
   double time_stamp = 0.0;
   for (size_t index = 0; index < num_of_time_stamps_;
        ++index, time_stamp += config_.eval_time_interval()) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    double ref_s = speed_point.s() + init_sl_point_.s();
+    double ref_s = 0.0;
+    if (index < time_stamp_s_.size()) {
+      ref_s = time_stamp_s_[index];
+    } else {
+      common::SpeedPoint speed_point;
+      heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
+      ref_s = speed_point.s() + init_sl_point_.s();
+    }
     if (ref_s < start_s) {
       continue;
     }
@@ -227,8 +327,10 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     const double l = curve.Evaluate(0, s);
     const double dl = curve.Evaluate(1, s);
 
-    const common::SLPoint sl = common::util::MakeSLPoint(ref_s, l);
-    const Box2d ego_box = GetBoxFromSLPoint(sl, dl);
+    const Box2d ego_box =
+        index < time_stamp_points_.size()
+            ? GetBoxFromReferencePoint(time_stamp_points_[index], l, dl)
+            : GetBoxFromSLPoint(common::util::MakeSLPoint(ref_s, l), dl);
     for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
       obstacle_cost +=
           GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
@@ -325,19 +427,35 @@ Box2d TrajectoryCost::GetBoxFromSLPoint(const common::SLPoint &sl,
                vehicle_param_.width());
 }
 
-// TODO(All): optimize obstacle cost calculation time
+Box2d TrajectoryCost::GetBoxFromReferencePoint(
+    const ReferencePoint &reference_point, const double l,
+    const double dl) const {
+  const auto angle =
+      common::math::Angle16::from_rad(reference_point.heading());
+  const Vec2d xy_point(reference_point.x() - common::math::sin(angle) * l,
+                       reference_point.y() + common::math::cos(angle) * l);
+
+  const double one_minus_kappa_r_d = 1 - reference_point.kappa() * l;
+  const double delta_theta = std::atan2(dl, one_minus_kappa_r_d);
+  const double theta =
+      common::math::NormalizeAngle(delta_theta + reference_point.heading());
+  return Box2d(xy_point, theta, vehicle_param_.length(),
+               vehicle_param_.width());
+}
+
 ComparableCost TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
                                          const double start_s,
                                          const double end_s,
                                          const uint32_t curr_level,
                                          const uint32_t total_level) {
   ComparableCost total_cost;
+  const Station *station = FindStation(start_s);
   // path cost
-  total_cost +=
-      CalculatePathCost(curve, start_s, end_s, curr_level, total_level);
+  total_cost += CalculatePathCost(curve, start_s, end_s, curr_level,
+                                  total_level, station);
 
   // static obstacle cost
-  total_cost += CalculateStaticObstacleCost(curve, start_s, end_s);
+  total_cost += CalculateStaticObstacleCost(curve, start_s, end_s, station);
 
   // dynamic obstacle cost
   total_cost += CalculateDynamicObstacleCost(curve, start_s, end_s);
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -52,14 +53,38 @@ class TrajectoryCost {
                            const uint32_t curr_level,
                            const uint32_t total_level);
 
+  /**
+   * @brief Precompute what the costs of all curves starting at the same
+   * station share, the lane widths along them and the static obstacles that
+   * do not end behind them. The waypoints of a level share one station.
+   * Calculate() computes curves from other stations directly. Not thread
+   * safe, call before Calculate().
+   * @param start_s The stations curves start from.
+   * @param max_end_s The farthest end of a curve.
+   */
+  void PrepareStations(const std::vector<double> &start_s,
+                       const double max_end_s);
+
  private:
+  struct Station {
+    double start_s = 0.0;
+    // left and right lane widths at the samples of CalculatePathCost()
+    std::vector<std::pair<double, double>> lane_widths;
+    // the static obstacles that can add a cost to curves from start_s, in
+    // static_obstacle_sl_boundaries_
+    std::vector<size_t> static_obstacle_indices;
+  };
+
+  const Station *FindStation(const double start_s) const;
+
   ComparableCost CalculatePathCost(const QuinticPolynomialCurve1d &curve,
                                    const double start_s, const double end_s,
                                    const uint32_t curr_level,
-                                   const uint32_t total_level);
+                                   const uint32_t total_level,
+                                   const Station *station);
   ComparableCost CalculateStaticObstacleCost(
       const QuinticPolynomialCurve1d &curve, const double start_s,
-      const double end_s);
+      const double end_s, const Station *station);
   ComparableCost CalculateDynamicObstacleCost(
       const QuinticPolynomialCurve1d &curve, const double start_s,
       const double end_s) const;
@@ -74,9 +99,17 @@ class TrajectoryCost {
   common::math::Box2d GetBoxFromSLPoint(const common::SLPoint &sl,
                                         const double dl) const;
 
+  // same as GetBoxFromSLPoint() at the station of the reference point
+  common::math::Box2d GetBoxFromReferencePoint(
+      const ReferencePoint &reference_point, const double l,
+      const double dl) const;
+
   bool IsOffRoad(const double ref_s, const double l, const double dl,
                  const bool is_change_lane_path);
 
+  bool IsOffRoad(const double ref_s, const double l, const double dl,
+                 const double left_width, const double right_width) const;
+
   const DpPolyPathConfig config_;
   const ReferenceLine *reference_line_ = nullptr;
   bool is_change_lane_path_ = false;
@@ -89,6 +122,12 @@ class TrajectoryCost {
   std::vector<double> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
+
+  std::vector<Station> stations_;
+  // the station and reference point the heuristic speed reaches at each
+  // time stamp of CalculateDynamicObstacleCost()
+  std::vector<double> time_stamp_s_;
+  std::vector<ReferencePoint> time_stamp_points_;
 };
 
 }  // namespace planning
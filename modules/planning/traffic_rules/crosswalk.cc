@@ -61,7 +61,11 @@ Status Crosswalk::ApplyRule(Frame* const frame,
   CHECK_NOTNULL(frame);
   CHECK_NOTNULL(reference_line_info);
 
-  if (!FindCrosswalks(reference_line_info)) {
+  if (!prepared_) {
+    prepared_stops_.clear();
+  }
+  prepared_ = false;
+  if (!FindCrosswalks(*reference_line_info)) {
     PlanningContext::MutablePlanningStatus()->clear_crosswalk();
     return Status::OK();
   }
@@ -70,6 +74,45 @@ Status Crosswalk::ApplyRule(Frame* const frame,
   return Status::OK();
 }
 
+void Crosswalk::Prepare(const Frame& frame,
+                        const ReferenceLineInfo& reference_line_info) {
+  prepared_stops_.clear();
+  prepared_ = true;
+  if (!FindCrosswalks(reference_line_info)) {
+    return;
+  }
+
+  const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
+  for (const auto* crosswalk_overlap : crosswalk_overlaps_) {
+    // passed crosswalks are skipped by MakeDecisions
+    if (adc_front_edge_s - crosswalk_overlap->end_s >
+        config_.crosswalk().min_pass_s_distance()) {
+      continue;
+    }
+    auto crosswalk_ptr = HDMapUtil::BaseMap().GetCrosswalkById(
+        hdmap::MakeMapId(crosswalk_overlap->object_id));
+    auto& stops = prepared_stops_[crosswalk_ptr->id().id()];
+    for (const auto* obstacle :
+         reference_line_info.path_decision().obstacles().Items()) {
+      stops[obstacle->Id()] =
+          CheckStopForObstacle(reference_line_info, crosswalk_ptr, *obstacle);
+    }
+  }
+}
+
+bool Crosswalk::IsStopForObstacle(const ReferenceLineInfo& reference_line_info,
+                                  const CrosswalkInfoConstPtr crosswalk_ptr,
+                                  const Obstacle& obstacle) {
+  auto crosswalk_it = prepared_stops_.find(crosswalk_ptr->id().id());
+  if (crosswalk_it != prepared_stops_.end()) {
+    auto it = crosswalk_it->second.find(obstacle.Id());
+    if (it != crosswalk_it->second.end()) {
+      return it->second;
+    }
+  }
+  return CheckStopForObstacle(reference_line_info, crosswalk_ptr, obstacle);
+}
+
 void Crosswalk::MakeDecisions(Frame* const frame,
                               ReferenceLineInfo* const reference_line_info) {
   CHECK_NOTNULL(frame);
@@ -135,7 +178,7 @@ void Crosswalk::MakeDecisions(Frame* const frame,
     std::vector<std::string> pedestrians;
     for (const auto* obstacle : path_decision->obstacles().Items()) {
       bool stop =
-          CheckStopForObstacle(reference_line_info, crosswalk_ptr, *obstacle);
+          IsStopForObstacle(*reference_line_info, crosswalk_ptr, *obstacle);
 
       const std::string& obstacle_id = obstacle->Id();
       const PerceptionObstacle& perception_obstacle = obstacle->Perception();
@@ -242,12 +285,10 @@ void Crosswalk::MakeDecisions(Frame* const frame,
   ADEBUG << "crosswalk_status: " << mutable_crosswalk_status->DebugString();
 }
 
-bool Crosswalk::FindCrosswalks(ReferenceLineInfo* const reference_line_info) {
-  CHECK_NOTNULL(reference_line_info);
-
+bool Crosswalk::FindCrosswalks(const ReferenceLineInfo& reference_line_info) {
   crosswalk_overlaps_.clear();
   const std::vector<hdmap::PathOverlap>& crosswalk_overlaps =
-      reference_line_info->reference_line().map_path().crosswalk_overlaps();
+      reference_line_info.reference_line().map_path().crosswalk_overlaps();
   for (const hdmap::PathOverlap& crosswalk_overlap : crosswalk_overlaps) {
     crosswalk_overlaps_.push_back(&crosswalk_overlap);
   }
@@ -255,17 +296,15 @@ bool Crosswalk::FindCrosswalks(ReferenceLineInfo* const reference_line_info) {
 }
 
 bool Crosswalk::CheckStopForObstacle(
-    ReferenceLineInfo* const reference_line_info,
+    const ReferenceLineInfo& reference_line_info,
     const CrosswalkInfoConstPtr crosswalk_ptr, const Obstacle& obstacle) {
-  CHECK_NOTNULL(reference_line_info);
-
   std::string crosswalk_id = crosswalk_ptr->id().id();
 
   const PerceptionObstacle& perception_obstacle = obstacle.Perception();
   const std::string& obstacle_id = obstacle.Id();
   PerceptionObstacle::Type obstacle_type = perception_obstacle.type();
   std::string obstacle_type_name = PerceptionObstacle_Type_Name(obstacle_type);
-  double adc_end_edge_s = reference_line_info->AdcSlBoundary().start_s();
+  double adc_end_edge_s = reference_line_info.AdcSlBoundary().start_s();
 
   // check type
   if (obstacle_type != PerceptionObstacle::PEDESTRIAN &&
@@ -293,7 +332,7 @@ bool Crosswalk::CheckStopForObstacle(
     return false;
   }
 
-  const auto& reference_line = reference_line_info->reference_line();
+  const auto& reference_line = reference_line_info.reference_line();
 
   common::SLPoint obstacle_sl_point;
   reference_line.XYToSL(
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/planning/traffic_rules/traffic_rule.h"
@@ -33,16 +34,26 @@ class Crosswalk : public TrafficRule {
   explicit Crosswalk(const TrafficRuleConfig& config);
   virtual ~Crosswalk() = default;
 
-  common::Status ApplyRule(Frame* const frame,
-                           ReferenceLineInfo* const reference_line_info);
+  common::Status ApplyRule(
+      Frame* const frame,
+      ReferenceLineInfo* const reference_line_info) override;
+
+  // checks every obstacle against the crosswalks ahead
+  bool HasPrepare() const override { return true; }
+  void Prepare(const Frame& frame,
+               const ReferenceLineInfo& reference_line_info) override;
 
  private:
   void MakeDecisions(Frame* const frame,
                      ReferenceLineInfo* const reference_line_info);
-  bool FindCrosswalks(ReferenceLineInfo* const reference_line_info);
-  bool CheckStopForObstacle(ReferenceLineInfo* const reference_line_info,
+  bool FindCrosswalks(const ReferenceLineInfo& reference_line_info);
+  bool CheckStopForObstacle(const ReferenceLineInfo& reference_line_info,
                             const hdmap::CrosswalkInfoConstPtr crosswalk_ptr,
                             const Obstacle& obstacle);
+  // the prepared result, obstacles added by earlier rules are checked here
+  bool IsStopForObstacle(const ReferenceLineInfo& reference_line_info,
+                         const hdmap::CrosswalkInfoConstPtr crosswalk_ptr,
+                         const Obstacle& obstacle);
   int BuildStopDecision(Frame* frame,
                         ReferenceLineInfo* const reference_line_info,
                         hdmap::PathOverlap* const crosswalk_overlap,
@@ -51,6 +62,10 @@ class Crosswalk : public TrafficRule {
  private:
   static constexpr char const* const CROSSWALK_VO_ID_PREFIX = "CW_";
   std::vector<const hdmap::PathOverlap*> crosswalk_overlaps_;
+  bool prepared_ = false;
+  // crosswalk id -> obstacle id -> whether to stop for it
+  std::unordered_map<std::string, std::unordered_map<std::string, bool>>
+      prepared_stops_;
 };
 
 }  // namespace planning
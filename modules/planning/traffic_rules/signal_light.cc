@@ -45,14 +45,26 @@ SignalLight::SignalLight(const TrafficRuleConfig& config)
 
 Status SignalLight::ApplyRule(Frame* const frame,
                               ReferenceLineInfo* const reference_line_info) {
-  if (!FindValidSignalLight(reference_line_info)) {
+  if (!prepared_) {
+    Prepare(*frame, *reference_line_info);
+  }
+  prepared_ = false;
+  if (!has_signal_light_) {
     return Status::OK();
   }
-  ReadSignals(frame->local_view().traffic_light);
   MakeDecisions(frame, reference_line_info);
   return Status::OK();
 }
 
+void SignalLight::Prepare(const Frame& frame,
+                          const ReferenceLineInfo& reference_line_info) {
+  prepared_ = true;
+  has_signal_light_ = FindValidSignalLight(reference_line_info);
+  if (has_signal_light_) {
+    ReadSignals(frame.local_view().traffic_light);
+  }
+}
+
 void SignalLight::ReadSignals(
     const std::shared_ptr<TrafficLightDetection>& traffic_light) {
   detected_signals_.clear();
@@ -73,9 +85,9 @@ void SignalLight::ReadSignals(
 }
 
 bool SignalLight::FindValidSignalLight(
-    ReferenceLineInfo* const reference_line_info) {
+    const ReferenceLineInfo& reference_line_info) {
   const std::vector<hdmap::PathOverlap>& signal_lights =
-      reference_line_info->reference_line().map_path().signal_overlaps();
+      reference_line_info.reference_line().map_path().signal_overlaps();
   if (signal_lights.size() <= 0) {
     ADEBUG << "No signal lights from reference line.";
     return false;
@@ -83,7 +95,7 @@ bool SignalLight::FindValidSignalLight(
   signal_lights_from_path_.clear();
   for (const hdmap::PathOverlap& signal_light : signal_lights) {
     if (signal_light.start_s + config_.signal_light().min_pass_s_distance() >
-        reference_line_info->AdcSlBoundary().end_s()) {
+        reference_line_info.AdcSlBoundary().end_s()) {
       signal_lights_from_path_.push_back(signal_light);
     }
   }
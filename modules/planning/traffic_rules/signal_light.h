@@ -37,13 +37,19 @@ class SignalLight : public TrafficRule {
 
   virtual ~SignalLight() = default;
 
-  common::Status ApplyRule(Frame* const frame,
-                           ReferenceLineInfo* const reference_line_info);
+  common::Status ApplyRule(
+      Frame* const frame,
+      ReferenceLineInfo* const reference_line_info) override;
+
+  // finds the signals ahead and their detected colors
+  bool HasPrepare() const override { return true; }
+  void Prepare(const Frame& frame,
+               const ReferenceLineInfo& reference_line_info) override;
 
  private:
   void ReadSignals(
       const std::shared_ptr<perception::TrafficLightDetection>& traffic_light);
-  bool FindValidSignalLight(ReferenceLineInfo* const reference_line_info);
+  bool FindValidSignalLight(const ReferenceLineInfo& reference_line_info);
   perception::TrafficLight GetSignal(const std::string& signal_id);
   void MakeDecisions(Frame* const frame,
                      ReferenceLineInfo* const reference_line_info);
@@ -56,6 +62,8 @@ class SignalLight : public TrafficRule {
 
  private:
   static constexpr char const* const SIGNAL_LIGHT_VO_ID_PREFIX = "SL_";
+  bool prepared_ = false;
+  bool has_signal_light_ = false;
   std::vector<hdmap::PathOverlap> signal_lights_from_path_;
   std::unordered_map<std::string, const apollo::perception::TrafficLight*>
       detected_signals_;
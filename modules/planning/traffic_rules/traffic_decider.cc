@@ -21,8 +21,14 @@
 #include "modules/planning/traffic_rules/traffic_decider.h"
 
 #include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cyber/task/task.h"
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/traffic_rules/backside_vehicle.h"
 #include "modules/planning/traffic_rules/change_lane.h"
@@ -36,6 +42,8 @@
 
 namespace apollo {
 namespace planning {
+
+using apollo::common::time::Clock;
 using common::Status;
 
 apollo::common::util::Factory<TrafficRuleConfig::RuleId, TrafficRule,
@@ -136,6 +144,7 @@ Status TrafficDecider::Execute(Frame *frame,
   CHECK_NOTNULL(frame);
   CHECK_NOTNULL(reference_line_info);
 
+  std::vector<std::unique_ptr<TrafficRule>> rules;
   for (const auto &rule_config : rule_configs_.config()) {
     if (!rule_config.enabled()) {
       ADEBUG << "Rule " << rule_config.rule_id() << " not enabled";
@@ -146,9 +155,41 @@ Status TrafficDecider::Execute(Frame *frame,
       AERROR << "Could not find rule " << rule_config.DebugString();
       continue;
     }
-    rule->ApplyRule(frame, reference_line_info);
-    ADEBUG << "Applied rule "
-           << TrafficRuleConfig::RuleId_Name(rule_config.rule_id());
+    rules.push_back(std::move(rule));
+  }
+
+  // the read only prepare steps do not depend on each other
+  std::vector<double> time_ms(rules.size(), 0.0);
+  std::vector<size_t> prepared;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (rules[i]->HasPrepare()) {
+      prepared.push_back(i);
+    }
+  }
+  const auto prepare = [&](size_t k) {
+    const double start_timestamp = Clock::NowInSeconds();
+    rules[prepared[k]]->Prepare(*frame, *reference_line_info);
+    time_ms[prepared[k]] = (Clock::NowInSeconds() - start_timestamp) * 1000;
+  };
+  if (FLAGS_enable_parallel_traffic_rules && prepared.size() > 1) {
+    cyber::ParallelFor(static_cast<size_t>(0), prepared.size(), 1, prepare);
+  } else {
+    for (size_t k = 0; k < prepared.size(); ++k) {
+      prepare(k);
+    }
+  }
+
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const double start_timestamp = Clock::NowInSeconds();
+    rules[i]->ApplyRule(frame, reference_line_info);
+    time_ms[i] += (Clock::NowInSeconds() - start_timestamp) * 1000;
+
+    const auto &rule_name = TrafficRuleConfig::RuleId_Name(rules[i]->Id());
+    auto *rule_stats =
+        reference_line_info->mutable_latency_stats()->add_task_stats();
+    rule_stats->set_name("TrafficRule::" + rule_name);
+    rule_stats->set_time_ms(time_ms[i]);
+    ADEBUG << "Applied rule " << rule_name << " in " << time_ms[i] << " ms";
   }
 
   BuildPlanningTarget(reference_line_info);
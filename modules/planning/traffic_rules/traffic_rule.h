@@ -37,6 +37,17 @@ class TrafficRule {
   virtual common::Status ApplyRule(
       Frame* const frame, ReferenceLineInfo* const reference_line_info) = 0;
 
+  // Rules with a prepare step do their read only work in Prepare(), which
+  // TrafficDecider runs for all rules before applying any of them, possibly
+  // concurrently. Prepare() may only read the local view, the hd map and the
+  // obstacles the reference line was built with, and keep its results in the
+  // rule. Decisions, virtual obstacles and the planning context are written
+  // by an earlier rule's ApplyRule(), so they are left to ApplyRule(), which
+  // runs in config order.
+  virtual bool HasPrepare() const { return false; }
+  virtual void Prepare(const Frame& frame,
+                       const ReferenceLineInfo& reference_line_info) {}
+
  protected:
   TrafficRuleConfig config_;
 };
@@ -35,6 +35,7 @@ std::size_t FeatureOutput::idx_feature_ = 0;
 std::size_t FeatureOutput::idx_learning_ = 0;
 std::size_t FeatureOutput::idx_prediction_result_ = 0;
 std::size_t FeatureOutput::idx_frame_env_ = 0;
+std::unique_ptr<FeatureStreamWriter> FeatureOutput::stream_writer_;
 
 void FeatureOutput::Close() {
   ADEBUG << "Close feature output";
@@ -60,6 +61,8 @@ void FeatureOutput::Close() {
       break;
     }
   }
+  // Waits for the background writer to write all queued records.
+  stream_writer_.reset();
   Clear();
 }
 
@@ -75,15 +78,52 @@ bool FeatureOutput::Ready() {
   return true;
 }
 
+FeatureStreamWriter* FeatureOutput::StreamWriter() {
+  if (stream_writer_ == nullptr) {
+    std::string name;
+    switch (FLAGS_prediction_offline_mode) {
+      case 1: {
+        name = "feature";
+        break;
+      }
+      case 2: {
+        name = "datalearn";
+        break;
+      }
+      case 3: {
+        name = "prediction_result";
+        break;
+      }
+      default: {
+        name = "frame_env";
+        break;
+      }
+    }
+    stream_writer_.reset(new FeatureStreamWriter(
+        StrCat(FLAGS_prediction_data_dir, "/", name),
+        FLAGS_feature_stream_max_queue_size,
+        FLAGS_feature_stream_num_records_per_chunk,
+        static_cast<size_t>(FLAGS_feature_stream_max_file_size_mb) << 20));
+  }
+  return stream_writer_.get();
+}
+
 void FeatureOutput::InsertFeatureProto(const Feature& feature) {
+  if (FLAGS_enable_feature_stream_output) {
+    StreamWriter()->Write(feature);
+    return;
+  }
   features_.add_feature()->CopyFrom(feature);
 }
 
 void FeatureOutput::InsertDataForLearning(
     const Feature& feature, const std::vector<double>& feature_values,
     const std::string& category) {
+  DataForLearning stream_data_for_learning;
   DataForLearning* data_for_learning =
-      list_data_for_learning_.add_data_for_learning();
+      FLAGS_enable_feature_stream_output
+          ? &stream_data_for_learning
+          : list_data_for_learning_.add_data_for_learning();
   data_for_learning->set_id(feature.id());
   data_for_learning->set_timestamp(feature.timestamp());
   for (size_t i = 0; i < feature_values.size(); ++i) {
@@ -92,21 +132,34 @@ void FeatureOutput::InsertDataForLearning(
   data_for_learning->set_category(category);
   ADEBUG << "Insert [" << category << "] data for learning with size = "
          << feature_values.size();
+  if (FLAGS_enable_feature_stream_output) {
+    StreamWriter()->Write(stream_data_for_learning);
+  }
 }
 
 void FeatureOutput::InsertPredictionResult(
     const int obstacle_id, const PredictionObstacle& prediction_obstacle) {
+  PredictionResult stream_prediction_result;
   PredictionResult* prediction_result =
-      list_prediction_result_.add_prediction_result();
+      FLAGS_enable_feature_stream_output
+          ? &stream_prediction_result
+          : list_prediction_result_.add_prediction_result();
   prediction_result->set_id(obstacle_id);
   prediction_result->set_timestamp(prediction_obstacle.timestamp());
   for (int i = 0; i < prediction_obstacle.trajectory_size(); ++i) {
     prediction_result->add_trajectory()->CopyFrom(
         prediction_obstacle.trajectory(i));
   }
+  if (FLAGS_enable_feature_stream_output) {
+    StreamWriter()->Write(stream_prediction_result);
+  }
 }
 
 void FeatureOutput::InsertFrameEnv(const FrameEnv& frame_env) {
+  if (FLAGS_enable_feature_stream_output) {
+    StreamWriter()->Write(frame_env);
+    return;
+  }
   list_frame_env_.add_frame_env()->CopyFrom(frame_env);
 }
 
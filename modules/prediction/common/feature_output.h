@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "modules/prediction/common/feature_stream_writer.h"
 #include "modules/prediction/proto/offline_features.pb.h"
 
 namespace apollo {
@@ -108,6 +110,13 @@ class FeatureOutput {
 
   static int SizeOfFrameEnv();
 
+ private:
+  /**
+   * @brief Get the stream writer of the offline mode, created on first use
+   * @return The stream writer
+   */
+  static FeatureStreamWriter* StreamWriter();
+
  private:
   static Features features_;
   static std::size_t idx_feature_;
@@ -117,6 +126,7 @@ class FeatureOutput {
   static std::size_t idx_prediction_result_;
   static ListFrameEnv list_frame_env_;
   static std::size_t idx_frame_env_;
+  static std::unique_ptr<FeatureStreamWriter> stream_writer_;
 };
 
 }  // namespace prediction
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/common/feature_stream_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "google/protobuf/io/coded_stream.h"
+
+namespace apollo {
+namespace prediction {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileInputStream;
+using google::protobuf::io::FileOutputStream;
+using google::protobuf::io::GzipInputStream;
+using google::protobuf::io::GzipOutputStream;
+
+FeatureStreamWriter::FeatureStreamWriter(const std::string& file_prefix,
+                                         const size_t max_queue_size,
+                                         const size_t num_records_per_chunk,
+                                         const size_t max_file_size)
+    : file_prefix_(file_prefix),
+      max_queue_size_(std::max(max_queue_size, static_cast<size_t>(1))),
+      num_records_per_chunk_(
+          std::max(num_records_per_chunk, static_cast<size_t>(1))),
+      max_file_size_(max_file_size) {
+  thread_ = std::thread(&FeatureStreamWriter::Loop, this);
+}
+
+FeatureStreamWriter::~FeatureStreamWriter() { Close(); }
+
+bool FeatureStreamWriter::Write(const google::protobuf::Message& message) {
+  std::string record;
+  if (!message.SerializeToString(&record)) {
+    AERROR << "Failed to serialize " << message.GetTypeName();
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock,
+                 [this] { return closed_ || queue_.size() < max_queue_size_; });
+  if (closed_) {
+    return false;
+  }
+  queue_.push_back(std::move(record));
+  not_empty_.notify_one();
+  return true;
+}
+
+void FeatureStreamWriter::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  not_empty_.notify_all();
+  not_full_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+size_t FeatureStreamWriter::NumWrittenRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_written_records_;
+}
+
+std::vector<std::string> FeatureStreamWriter::FileNames() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return file_names_;
+}
+
+void FeatureStreamWriter::Loop() {
+  while (true) {
+    std::deque<std::string> records;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        break;
+      }
+      records.swap(queue_);
+    }
+    not_full_.notify_all();
+
+    size_t num_written = 0;
+    for (const auto& record : records) {
+      if (WriteRecord(record)) {
+        ++num_written;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_written_records_ += num_written;
+  }
+  CloseFile();
+}
+
+bool FeatureStreamWriter::OpenFile() {
+  std::string file_name;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_name = file_prefix_ + "." + std::to_string(file_names_.size()) +
+                ".bin.gz";
+    file_names_.push_back(file_name);
+  }
+  fd_ = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  file_stream_.reset(new FileOutputStream(fd_));
+  GzipOutputStream::Options options;
+  options.format = GzipOutputStream::GZIP;
+  gzip_stream_.reset(new GzipOutputStream(file_stream_.get(), options));
+  num_records_in_chunk_ = 0;
+  return true;
+}
+
+void FeatureStreamWriter::CloseFile() {
+  if (fd_ < 0) {
+    return;
+  }
+  gzip_stream_->Close();
+  gzip_stream_.reset();
+  file_stream_->Close();
+  file_stream_.reset();
+  fd_ = -1;
+}
+
+bool FeatureStreamWriter::WriteRecord(const std::string& record) {
+  if (fd_ < 0 && !OpenFile()) {
+    return false;
+  }
+  {
+    CodedOutputStream coded_stream(gzip_stream_.get());
+    coded_stream.WriteVarint32(static_cast<uint32_t>(record.size()));
+    coded_stream.WriteString(record);
+    if (coded_stream.HadError()) {
+      AERROR << "Failed to write a record of size " << record.size();
+      return false;
+    }
+  }
+  if (++num_records_in_chunk_ >= num_records_per_chunk_) {
+    gzip_stream_->Flush();
+    num_records_in_chunk_ = 0;
+    if (max_file_size_ > 0 &&
+        static_cast<size_t>(file_stream_->ByteCount()) >= max_file_size_) {
+      CloseFile();
+    }
+  }
+  return true;
+}
+
+bool FeatureStreamWriter::ReadRecords(const std::string& file_name,
+                                      std::vector<std::string>* records) {
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  bool success = true;
+  {
+    FileInputStream file_stream(fd);
+    GzipInputStream gzip_stream(&file_stream, GzipInputStream::GZIP);
+    while (true) {
+      // A stream per record keeps the total bytes limit of every stream
+      // far away, whatever the size of the file.
+      CodedInputStream coded_stream(&gzip_stream);
+      uint32_t size = 0;
+      if (!coded_stream.ReadVarint32(&size)) {
+        break;
+      }
+      std::string record;
+      if (!coded_stream.ReadString(&record, static_cast<int>(size))) {
+        AERROR << "Broken record in " << file_name;
+        success = false;
+        break;
+      }
+      records->push_back(std::move(record));
+    }
+  }
+  close(fd);
+  return success;
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Bounded queue and background thread to stream offline features
+ *        into compressed files
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/message.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * Every record is written as a varint32 size followed by the serialized
+ * message into a gzip stream. The stream is flushed every chunk so that a
+ * file cut off by a crash is still readable up to the last chunk, and a new
+ * file is started once the compressed size reaches the max file size.
+ */
+class FeatureStreamWriter {
+ public:
+  /**
+   * @brief Constructor
+   * @param Prefix of the output files, a file is named prefix.N.bin.gz
+   * @param Max number of records queued before Write blocks
+   * @param Number of records per compressed chunk
+   * @param Compressed size in bytes to start a new file at
+   */
+  FeatureStreamWriter(const std::string& file_prefix,
+                      const size_t max_queue_size,
+                      const size_t num_records_per_chunk,
+                      const size_t max_file_size);
+
+  /**
+   * @brief Destructor, writes all queued records
+   */
+  ~FeatureStreamWriter();
+
+  /**
+   * @brief Queue a message to write, blocks while the queue is full
+   * @param The message
+   * @return False if the writer is closed
+   */
+  bool Write(const google::protobuf::Message& message);
+
+  /**
+   * @brief Write all queued records and close the current file
+   */
+  void Close();
+
+  /**
+   * @brief Get the number of records written to files so far
+   */
+  size_t NumWrittenRecords() const;
+
+  /**
+   * @brief Get the names of the files written so far
+   */
+  std::vector<std::string> FileNames() const;
+
+  /**
+   * @brief Read back all records of a file written by the writer
+   * @param File name
+   * @param Serialized records
+   * @return True if the file is read to the end without a broken record
+   */
+  static bool ReadRecords(const std::string& file_name,
+                          std::vector<std::string>* records);
+
+ private:
+  void Loop();
+
+  bool OpenFile();
+
+  void CloseFile();
+
+  bool WriteRecord(const std::string& record);
+
+ private:
+  const std::string file_prefix_;
+  const size_t max_queue_size_;
+  const size_t num_records_per_chunk_;
+  const size_t max_file_size_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<std::string> queue_;
+  bool closed_ = false;
+  size_t num_written_records_ = 0;
+  std::vector<std::string> file_names_;
+
+  // Only used by the writing thread.
+  int fd_ = -1;
+  std::unique_ptr<google::protobuf::io::FileOutputStream> file_stream_;
+  std::unique_ptr<google::protobuf::io::GzipOutputStream> gzip_stream_;
+  size_t num_records_in_chunk_ = 0;
+
+  std::thread thread_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/common/feature_stream_writer.h"
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(FeatureStreamWriterTest, WriteAndRead) {
+  const std::string prefix = "/tmp/feature_stream_writer_test";
+  std::vector<std::string> file_names;
+  {
+    FeatureStreamWriter writer(prefix, 4, 8, 1);
+    for (int i = 0; i < 100; ++i) {
+      Feature feature;
+      feature.set_id(i);
+      feature.set_timestamp(0.1 * i);
+      EXPECT_TRUE(writer.Write(feature));
+    }
+    writer.Close();
+    EXPECT_FALSE(writer.Write(Feature()));
+    EXPECT_EQ(100, writer.NumWrittenRecords());
+    file_names = writer.FileNames();
+  }
+  // Every chunk of 8 records exceeds the max file size of 1 byte.
+  EXPECT_EQ(13, file_names.size());
+
+  int id = 0;
+  for (const auto& file_name : file_names) {
+    std::vector<std::string> records;
+    EXPECT_TRUE(FeatureStreamWriter::ReadRecords(file_name, &records));
+    for (const auto& record : records) {
+      Feature feature;
+      EXPECT_TRUE(feature.ParseFromString(record));
+      EXPECT_EQ(id, feature.id());
+      EXPECT_DOUBLE_EQ(0.1 * id, feature.timestamp());
+      ++id;
+    }
+    std::remove(file_name.c_str());
+  }
+  EXPECT_EQ(100, id);
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -31,31 +31,38 @@ using apollo::hdmap::JunctionInfo;
 using apollo::hdmap::LaneInfo;
 using ConstLaneInfoPtr = std::shared_ptr<const LaneInfo>;
 
-std::shared_ptr<const JunctionInfo> JunctionAnalyzer::junction_info_ptr_;
-std::unordered_map<std::string, JunctionExit> JunctionAnalyzer::junction_exits_;
-std::unordered_map<std::string, JunctionFeature>
-    JunctionAnalyzer::junction_features_;
+std::unordered_map<std::string, JunctionAnalyzer::JunctionCache>
+    JunctionAnalyzer::junction_caches_;
+JunctionAnalyzer::JunctionCache* JunctionAnalyzer::junction_cache_ = nullptr;
 
 void JunctionAnalyzer::Init(const std::string& junction_id) {
-  if (junction_info_ptr_ != nullptr &&
-      junction_info_ptr_->id().id() == junction_id) {
+  if (junction_cache_ != nullptr &&
+      junction_cache_->junction_info_ptr->id().id() == junction_id) {
     return;
   }
-  Clear();
-  junction_info_ptr_ = PredictionMap::JunctionById(junction_id);
+  auto iter = junction_caches_.find(junction_id);
+  if (iter != junction_caches_.end()) {
+    junction_cache_ = &iter->second;
+    return;
+  }
+  auto junction_info_ptr = PredictionMap::JunctionById(junction_id);
+  CHECK_NOTNULL(junction_info_ptr);
+  // elements of an unordered_map keep their address when it grows
+  junction_cache_ = &junction_caches_[junction_id];
+  junction_cache_->junction_info_ptr = junction_info_ptr;
   SetAllJunctionExits();
 }
 
 void JunctionAnalyzer::Clear() {
   // Clear all data
-  junction_info_ptr_ = nullptr;
-  junction_exits_.clear();
-  junction_features_.clear();
+  junction_cache_ = nullptr;
+  junction_caches_.clear();
 }
 
 void JunctionAnalyzer::SetAllJunctionExits() {
-  CHECK_NOTNULL(junction_info_ptr_);
-  for (const auto& overlap_id : junction_info_ptr_->junction().overlap_id()) {
+  CHECK_NOTNULL(junction_cache_);
+  const auto& junction_info_ptr = junction_cache_->junction_info_ptr;
+  for (const auto& overlap_id : junction_info_ptr->junction().overlap_id()) {
     auto overlap_info_ptr = PredictionMap::OverlapById(overlap_id.id());
     if (overlap_info_ptr == nullptr) {
       continue;
@@ -75,7 +82,7 @@ void JunctionAnalyzer::SetAllJunctionExits() {
           junction_exit.set_exit_heading(lane_info_ptr->Heading(s));
           junction_exit.set_exit_width(lane_info_ptr->GetWidth(s));
           // add junction_exit to hashtable
-          junction_exits_[lane_id] = junction_exit;
+          junction_cache_->junction_exits[lane_id] = junction_exit;
         }
       }
     }
@@ -98,7 +105,7 @@ std::vector<JunctionExit> JunctionAnalyzer::GetJunctionExits(
     std::unordered_set<std::string> visited_exit_lanes;
     if (IsExitLane(curr_lane_id) &&
         visited_exit_lanes.find(curr_lane_id) == visited_exit_lanes.end()) {
-      junction_exits.push_back(junction_exits_[curr_lane_id]);
+      junction_exits.push_back(junction_cache_->junction_exits[curr_lane_id]);
       visited_exit_lanes.insert(curr_lane_id);
       continue;
     }
@@ -116,8 +123,11 @@ std::vector<JunctionExit> JunctionAnalyzer::GetJunctionExits(
 
 const JunctionFeature& JunctionAnalyzer::GetJunctionFeature(
     const std::string& start_lane_id) {
-  if (junction_features_.find(start_lane_id) != junction_features_.end()) {
-    return junction_features_[start_lane_id];
+  CHECK_NOTNULL(junction_cache_);
+  auto& junction_features = junction_cache_->junction_features;
+  auto iter = junction_features.find(start_lane_id);
+  if (iter != junction_features.end()) {
+    return iter->second;
   }
   JunctionFeature junction_feature;
   junction_feature.set_junction_id(GetJunctionId());
@@ -129,17 +139,29 @@ const JunctionFeature& JunctionAnalyzer::GetJunctionFeature(
   }
   junction_feature.mutable_enter_lane()->set_lane_id(start_lane_id);
   junction_feature.add_start_lane_id(start_lane_id);
-  junction_features_[start_lane_id] = junction_feature;
-  return junction_features_[start_lane_id];
+  auto& cached_feature = junction_features[start_lane_id];
+  cached_feature.Swap(&junction_feature);
+  return cached_feature;
 }
 
 JunctionFeature JunctionAnalyzer::GetJunctionFeature(
     const std::vector<std::string>& start_lane_ids) {
+  CHECK_NOTNULL(junction_cache_);
+  std::string merged_key;
+  for (const std::string& start_lane_id : start_lane_ids) {
+    merged_key += start_lane_id;
+    merged_key += ',';
+  }
+  auto iter = junction_cache_->merged_features.find(merged_key);
+  if (iter != junction_cache_->merged_features.end()) {
+    return iter->second;
+  }
+
   JunctionFeature merged_junction_feature;
   bool initialized = false;
   std::unordered_map<std::string, JunctionExit> junction_exits_map;
   for (const std::string& start_lane_id : start_lane_ids) {
-    JunctionFeature junction_feature = GetJunctionFeature(start_lane_id);
+    const JunctionFeature& junction_feature = GetJunctionFeature(start_lane_id);
     if (!initialized) {
       merged_junction_feature.set_junction_id(junction_feature.junction_id());
       merged_junction_feature.set_junction_range(
@@ -157,22 +179,28 @@ JunctionFeature JunctionAnalyzer::GetJunctionFeature(
     merged_junction_feature.add_start_lane_id(exit.first);
     merged_junction_feature.add_junction_exit()->CopyFrom(exit.second);
   }
+  junction_cache_->merged_features[merged_key] = merged_junction_feature;
   return merged_junction_feature;
 }
 
 bool JunctionAnalyzer::IsExitLane(const std::string& lane_id) {
-  return junction_exits_.find(lane_id) != junction_exits_.end();
+  return junction_cache_->junction_exits.find(lane_id) !=
+         junction_cache_->junction_exits.end();
 }
 
 const std::string& JunctionAnalyzer::GetJunctionId() {
-  CHECK_NOTNULL(junction_info_ptr_);
-  return junction_info_ptr_->id().id();
+  CHECK_NOTNULL(junction_cache_);
+  return junction_cache_->junction_info_ptr->id().id();
 }
 
 double JunctionAnalyzer::ComputeJunctionRange() {
-  CHECK_NOTNULL(junction_info_ptr_);
-  if (!junction_info_ptr_->junction().has_polygon() ||
-      junction_info_ptr_->junction().polygon().point_size() < 3) {
+  CHECK_NOTNULL(junction_cache_);
+  if (junction_cache_->junction_range >= 0.0) {
+    return junction_cache_->junction_range;
+  }
+  const auto& junction_info_ptr = junction_cache_->junction_info_ptr;
+  if (!junction_info_ptr->junction().has_polygon() ||
+      junction_info_ptr->junction().polygon().point_size() < 3) {
     AERROR << "Junction [" << GetJunctionId()
            << "] has not enough polygon points to compute range";
     return FLAGS_defualt_junction_range;
@@ -181,7 +209,7 @@ double JunctionAnalyzer::ComputeJunctionRange() {
   double x_max = -std::numeric_limits<double>::infinity();
   double y_min = std::numeric_limits<double>::infinity();
   double y_max = -std::numeric_limits<double>::infinity();
-  for (const auto& point : junction_info_ptr_->junction().polygon().point()) {
+  for (const auto& point : junction_info_ptr->junction().polygon().point()) {
     x_min = std::min(x_min, point.x());
     x_max = std::max(x_max, point.x());
     y_min = std::min(y_min, point.y());
@@ -190,6 +218,7 @@ double JunctionAnalyzer::ComputeJunctionRange() {
   double dx = std::abs(x_max - x_min);
   double dy = std::abs(y_max - y_min);
   double range = std::sqrt(dx * dx + dy * dy);
+  junction_cache_->junction_range = range;
   return range;
 }
 
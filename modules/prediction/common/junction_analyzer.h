@@ -30,13 +30,15 @@ namespace prediction {
 class JunctionAnalyzer {
  public:
   /**
-   * @brief Initialize by junction ID, if junction id differs from prev cycle
+   * @brief Initialize by junction ID, if junction id differs from prev cycle.
+   *        The exits and features of a junction are kept across cycles, a
+   *        junction seen before is not searched again.
    * @param junction ID
    */
   static void Init(const std::string& junction_id);
 
   /**
-   * @brief Clear all stored data
+   * @brief Clear all stored data of all junctions
    */
   static void Clear();
 
@@ -69,8 +71,22 @@ class JunctionAnalyzer {
       const std::vector<std::string>& start_lane_ids);
 
  private:
+  // Static data of one junction, computed lazily
+  struct JunctionCache {
+    // junction_info pointer associated to the junction_id
+    std::shared_ptr<const apollo::hdmap::JunctionInfo> junction_info_ptr;
+    // Hashtable: exit_lane_id -> junction_exit
+    std::unordered_map<std::string, JunctionExit> junction_exits;
+    // Hashtable: start_lane_id -> junction_feature
+    std::unordered_map<std::string, JunctionFeature> junction_features;
+    // Hashtable: joined start_lane_ids -> merged junction_feature
+    std::unordered_map<std::string, JunctionFeature> merged_features;
+    // negative until computed
+    double junction_range = -1.0;
+  };
+
   /**
-   * @brief Set all junction exits in the hashtable junction_exits_
+   * @brief Set all junction exits in the hashtable of the junction cache
    */
   static void SetAllJunctionExits();
 
@@ -90,12 +106,10 @@ class JunctionAnalyzer {
   static bool IsExitLane(const std::string& lane_id);
 
  private:
-  // junction_info pointer associated to the input junction_id
-  static std::shared_ptr<const apollo::hdmap::JunctionInfo> junction_info_ptr_;
-  // Hashtable: exit_lane_id -> junction_exit
-  static std::unordered_map<std::string, JunctionExit> junction_exits_;
-  // Hashtable: start_lane_id -> junction_feature
-  static std::unordered_map<std::string, JunctionFeature> junction_features_;
+  // Hashtable: junction_id -> junction_cache
+  static std::unordered_map<std::string, JunctionCache> junction_caches_;
+  // cache of the junction of the current cycle
+  static JunctionCache* junction_cache_;
 };
 
 }  // namespace prediction
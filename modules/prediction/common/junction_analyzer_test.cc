@@ -44,5 +44,24 @@ TEST_F(JunctionAnalyzerTest, MultiLane) {
   JunctionAnalyzer::Clear();
 }
 
+TEST_F(JunctionAnalyzerTest, CachedAcrossCycles) {
+  JunctionAnalyzer::Init("j2");
+  const JunctionFeature* junction_feature =
+      &JunctionAnalyzer::GetJunctionFeature("l61");
+  const std::vector<std::string> start_lane_ids{"l35", "l61", "l114", "l162"};
+  const JunctionFeature merged_junction_feature =
+      JunctionAnalyzer::GetJunctionFeature(start_lane_ids);
+
+  // start a new cycle in the same junction
+  JunctionAnalyzer::Init("j2");
+  EXPECT_EQ(&JunctionAnalyzer::GetJunctionFeature("l61"), junction_feature);
+  EXPECT_EQ(JunctionAnalyzer::GetJunctionFeature(start_lane_ids)
+                .SerializeAsString(),
+            merged_junction_feature.SerializeAsString());
+  EXPECT_NEAR(JunctionAnalyzer::ComputeJunctionRange(), 74.0306, 0.001);
+  EXPECT_NEAR(JunctionAnalyzer::ComputeJunctionRange(), 74.0306, 0.001);
+  JunctionAnalyzer::Clear();
+}
+
 }  // namespace prediction
 }  // namespace apollo
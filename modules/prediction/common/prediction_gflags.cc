@@ -49,6 +49,10 @@ DEFINE_double(lane_search_radius, 3.0, "Search radius for a candidate lane");
 DEFINE_double(lane_search_radius_in_junction, 15.0,
               "Search radius for a candidate lane");
 DEFINE_double(junction_search_radius, 1.0, "Search radius for a junction");
+DEFINE_bool(enable_prediction_map_query_cache, true,
+            "Cache the lane and junction queries of PredictionMap per frame");
+DEFINE_double(prediction_map_query_resolution, 1e-3,
+              "Position and radius resolution of cached map queries");
 DEFINE_double(pedestrian_nearby_lane_search_radius, 3.0,
               "Radius to determine if pedestrian-like obstacle is near lane.");
 
@@ -192,6 +196,26 @@ DEFINE_double(default_l_if_no_obstacle_in_lane_sequence, 10.0,
               "The default l value if no obstacle in the lane sequence.");
 DEFINE_bool(enable_build_current_frame_env, false,
             "If build current frame environment");
+DEFINE_bool(enable_multi_thread_evaluation, false,
+            "If evaluate obstacles in parallel, each thread with its own "
+            "evaluator instances");
+DEFINE_int32(max_num_evaluation_threads, 4,
+             "Max number of threads to evaluate obstacles with");
+DEFINE_bool(enable_multi_thread_prediction, false,
+            "If predict obstacles in parallel, each thread with its own "
+            "predictor instances");
+DEFINE_int32(max_num_prediction_threads, 4,
+             "Max number of threads to predict obstacles with");
+DEFINE_bool(enable_evaluation_budget, false,
+            "If run the expensive evaluators only on caution and nearby "
+            "obstacles within a time budget per frame, and the cost "
+            "evaluator on the others");
+DEFINE_double(evaluation_budget_ms, 30.0,
+              "Time budget per frame for the expensive evaluators of nearby "
+              "obstacles, caution obstacles are never demoted");
+DEFINE_double(expensive_evaluation_distance, 40.0,
+              "Max distance to ego vehicle of the nearby obstacles that "
+              "may use the expensive evaluators");
 
 // Obstacle trajectory
 DEFINE_bool(enable_cruise_regression, false,
@@ -249,6 +273,13 @@ DEFINE_bool(use_bell_curve_for_cost_function, false,
 
 DEFINE_int32(road_graph_max_search_horizon, 20,
              "Maximal search depth for building road graph");
+DEFINE_int32(max_num_cached_lane_graphs, 2000,
+             "Max number of lane graphs kept across frames, "
+             "0 disables the cross-frame lane graph cache");
+DEFINE_double(lane_graph_cache_start_s_resolution, 2.0,
+              "Resolution of lane start s in the lane graph cache keys");
+DEFINE_double(lane_graph_cache_length_resolution, 10.0,
+              "Resolution of search length in the lane graph cache keys");
 
 DEFINE_double(lane_distance_threshold, 3.0,
               "The threshold for distance to ego/neighbor lane "
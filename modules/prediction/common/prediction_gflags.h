@@ -39,6 +39,8 @@ DECLARE_double(max_tracking_dist);
 DECLARE_double(lane_search_radius);
 DECLARE_double(lane_search_radius_in_junction);
 DECLARE_double(junction_search_radius);
+DECLARE_bool(enable_prediction_map_query_cache);
+DECLARE_double(prediction_map_query_resolution);
 DECLARE_double(pedestrian_nearby_lane_search_radius);
 
 // Scenario
@@ -118,6 +120,13 @@ DECLARE_double(time_to_center_if_not_reach);
 DECLARE_double(default_s_if_no_obstacle_in_lane_sequence);
 DECLARE_double(default_l_if_no_obstacle_in_lane_sequence);
 DECLARE_bool(enable_build_current_frame_env);
+DECLARE_bool(enable_multi_thread_evaluation);
+DECLARE_int32(max_num_evaluation_threads);
+DECLARE_bool(enable_multi_thread_prediction);
+DECLARE_int32(max_num_prediction_threads);
+DECLARE_bool(enable_evaluation_budget);
+DECLARE_double(evaluation_budget_ms);
+DECLARE_double(expensive_evaluation_distance);
 
 // Obstacle trajectory
 DECLARE_bool(enable_cruise_regression);
@@ -146,6 +155,9 @@ DECLARE_double(cost_function_sigma);
 DECLARE_bool(use_bell_curve_for_cost_function);
 
 DECLARE_int32(road_graph_max_search_horizon);
+DECLARE_int32(max_num_cached_lane_graphs);
+DECLARE_double(lane_graph_cache_start_s_resolution);
+DECLARE_double(lane_graph_cache_length_resolution);
 
 // scenario feature extraction
 DECLARE_double(lane_distance_threshold);
@@ -17,7 +17,10 @@
 #include "modules/prediction/common/prediction_map.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -35,6 +38,65 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::OverlapInfo;
 using apollo::hdmap::PNCJunctionInfo;
 
+namespace {
+
+// Queries are keyed by position and radius rounded to the query resolution,
+// which is far below the accuracy of the map.
+struct QueryKey {
+  int64_t x;
+  int64_t y;
+  int64_t radius;
+
+  bool operator==(const QueryKey& other) const {
+    return x == other.x && y == other.y && radius == other.radius;
+  }
+};
+
+struct QueryKeyHash {
+  size_t operator()(const QueryKey& key) const {
+    size_t seed = std::hash<int64_t>()(key.x);
+    seed ^= std::hash<int64_t>()(key.y) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    seed ^= std::hash<int64_t>()(key.radius) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    return seed;
+  }
+};
+
+QueryKey MakeQueryKey(const Eigen::Vector2d& point, const double radius) {
+  const double resolution = FLAGS_prediction_map_query_resolution;
+  return {std::llround(point.x() / resolution),
+          std::llround(point.y() / resolution),
+          std::llround(radius / resolution)};
+}
+
+common::PointENU MakePointENU(const Eigen::Vector2d& point) {
+  common::PointENU hdmap_point;
+  hdmap_point.set_x(point.x());
+  hdmap_point.set_y(point.y());
+  return hdmap_point;
+}
+
+// Per frame results of the kd-tree queries. Evaluators may run in parallel,
+// so the maps are guarded, the map queries themselves run unlocked.
+struct QueryCache {
+  std::mutex mutex;
+  std::unordered_map<QueryKey, std::vector<std::shared_ptr<const LaneInfo>>,
+                     QueryKeyHash>
+      lanes;
+  std::unordered_map<QueryKey,
+                     std::vector<std::shared_ptr<const JunctionInfo>>,
+                     QueryKeyHash>
+      junctions;
+};
+
+QueryCache* GetQueryCache() {
+  static QueryCache* cache = new QueryCache();
+  return cache;
+}
+
+}  // namespace
+
 bool PredictionMap::Ready() { return HDMapUtil::BaseMapPtr() != nullptr; }
 
 Eigen::Vector2d PredictionMap::PositionOnLane(
@@ -88,12 +150,7 @@ bool PredictionMap::GetProjection(
 
 bool PredictionMap::HasNearbyLane(const double x, const double y,
                                   const double radius) {
-  common::PointENU point_enu;
-  point_enu.set_x(x);
-  point_enu.set_y(y);
-  std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  HDMapUtil::BaseMap().GetLanes(point_enu, radius, &lanes);
-  return (!lanes.empty());
+  return !GetLanes({x, y}, radius).empty();
 }
 
 bool PredictionMap::ProjectionFromLane(
@@ -128,12 +185,7 @@ bool PredictionMap::IsVirtualLane(const std::string& lane_id) {
 
 bool PredictionMap::OnVirtualLane(const Eigen::Vector2d& point,
                                   const double radius) {
-  std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point[0]);
-  hdmap_point.set_y(point[1]);
-  HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, &lanes);
-  for (const auto& lane : lanes) {
+  for (const auto& lane : GetLanes(point, radius)) {
     if (IsVirtualLane(lane->id().id())) {
       return true;
     }
@@ -149,12 +201,8 @@ void PredictionMap::OnLane(
     std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
   std::vector<std::shared_ptr<const LaneInfo>> candidate_lanes;
 
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point.x());
-  hdmap_point.set_y(point.y());
-  if (HDMapUtil::BaseMap().GetLanesWithHeading(hdmap_point, radius, heading,
-                                               max_lane_angle_diff,
-                                               &candidate_lanes) != 0) {
+  if (GetLanesWithHeading(point, radius, heading, max_lane_angle_diff,
+                          &candidate_lanes) != 0) {
     return;
   }
 
@@ -206,9 +254,8 @@ std::shared_ptr<const LaneInfo> PredictionMap::GetMostLikelyCurrentLane(
     const common::PointENU& position, const double radius, const double heading,
     const double angle_diff_threshold) {
   std::vector<std::shared_ptr<const LaneInfo>> candidate_lanes;
-  if (HDMapUtil::BaseMap().GetLanesWithHeading(position, radius, heading,
-                                               angle_diff_threshold,
-                                               &candidate_lanes) != 0) {
+  if (GetLanesWithHeading({position.x(), position.y()}, radius, heading,
+                          angle_diff_threshold, &candidate_lanes) != 0) {
     return nullptr;
   }
   double min_angle_diff = 2.0 * M_PI;
@@ -262,12 +309,7 @@ bool PredictionMap::IsProjectionApproximateWithinLane(
 
 bool PredictionMap::NearJunction(const Eigen::Vector2d& point,
                                  const double radius) {
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point.x());
-  hdmap_point.set_y(point.y());
-  std::vector<std::shared_ptr<const JunctionInfo>> junctions;
-  HDMapUtil::BaseMap().GetJunctions(hdmap_point, radius, &junctions);
-  return junctions.size() > 0;
+  return !GetJunctions(point, radius).empty();
 }
 
 bool PredictionMap::IsPointInJunction(
@@ -279,11 +321,23 @@ bool PredictionMap::IsPointInJunction(
 
 std::vector<std::shared_ptr<const JunctionInfo>> PredictionMap::GetJunctions(
     const Eigen::Vector2d& point, const double radius) {
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point.x());
-  hdmap_point.set_y(point.y());
   std::vector<std::shared_ptr<const JunctionInfo>> junctions;
-  HDMapUtil::BaseMap().GetJunctions(hdmap_point, radius, &junctions);
+  if (!FLAGS_enable_prediction_map_query_cache) {
+    HDMapUtil::BaseMap().GetJunctions(MakePointENU(point), radius, &junctions);
+    return junctions;
+  }
+  QueryCache* cache = GetQueryCache();
+  const QueryKey key = MakeQueryKey(point, radius);
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto iter = cache->junctions.find(key);
+    if (iter != cache->junctions.end()) {
+      return iter->second;
+    }
+  }
+  HDMapUtil::BaseMap().GetJunctions(MakePointENU(point), radius, &junctions);
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->junctions.emplace(key, junctions);
   return junctions;
 }
 
@@ -482,12 +536,7 @@ std::shared_ptr<const LaneInfo> PredictionMap::GetNeighborLane(
 std::vector<std::string> PredictionMap::NearbyLaneIds(
     const Eigen::Vector2d& point, const double radius) {
   std::vector<std::string> lane_ids;
-  std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point[0]);
-  hdmap_point.set_y(point[1]);
-  HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, &lanes);
-  for (const auto& lane : lanes) {
+  for (const auto& lane : GetLanes(point, radius)) {
     lane_ids.push_back(lane->id().id());
   }
   return lane_ids;
@@ -653,10 +702,96 @@ std::vector<std::shared_ptr<const LaneInfo>> PredictionMap::GetNearbyLanes(
   CHECK(position.has_x() && position.has_y() && position.has_z());
   CHECK(nearby_radius > 0.0);
 
-  std::vector<std::shared_ptr<const LaneInfo>> nearby_lanes;
+  return GetLanes({position.x(), position.y()}, nearby_radius);
+}
 
-  HDMapUtil::BaseMap().GetLanes(position, nearby_radius, &nearby_lanes);
-  return nearby_lanes;
+void PredictionMap::PrefetchNearbyLanes(
+    const std::vector<Eigen::Vector2d>& points, const double radius) {
+  if (!FLAGS_enable_prediction_map_query_cache) {
+    return;
+  }
+  QueryCache* cache = GetQueryCache();
+  std::vector<std::pair<QueryKey, Eigen::Vector2d>> missed_queries;
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    std::unordered_set<QueryKey, QueryKeyHash> keys;
+    for (const auto& point : points) {
+      const QueryKey key = MakeQueryKey(point, radius);
+      if (cache->lanes.count(key) == 0 && keys.insert(key).second) {
+        missed_queries.emplace_back(key, point);
+      }
+    }
+  }
+  std::vector<std::vector<std::shared_ptr<const LaneInfo>>> results(
+      missed_queries.size());
+  for (size_t i = 0; i < missed_queries.size(); ++i) {
+    HDMapUtil::BaseMap().GetLanes(MakePointENU(missed_queries[i].second),
+                                  radius, &results[i]);
+  }
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  for (size_t i = 0; i < missed_queries.size(); ++i) {
+    cache->lanes.emplace(missed_queries[i].first, std::move(results[i]));
+  }
+}
+
+void PredictionMap::ResetQueryCache() {
+  QueryCache* cache = GetQueryCache();
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->lanes.clear();
+  cache->junctions.clear();
+}
+
+std::vector<std::shared_ptr<const LaneInfo>> PredictionMap::GetLanes(
+    const Eigen::Vector2d& point, const double radius) {
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  if (!FLAGS_enable_prediction_map_query_cache) {
+    HDMapUtil::BaseMap().GetLanes(MakePointENU(point), radius, &lanes);
+    return lanes;
+  }
+  QueryCache* cache = GetQueryCache();
+  const QueryKey key = MakeQueryKey(point, radius);
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto iter = cache->lanes.find(key);
+    if (iter != cache->lanes.end()) {
+      return iter->second;
+    }
+  }
+  HDMapUtil::BaseMap().GetLanes(MakePointENU(point), radius, &lanes);
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->lanes.emplace(key, lanes);
+  return lanes;
+}
+
+int PredictionMap::GetLanesWithHeading(
+    const Eigen::Vector2d& point, const double radius, const double heading,
+    const double max_heading_difference,
+    std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
+  // The heading filter runs on the cached lanes so that queries from the
+  // same position with different headings share one kd-tree search.
+  const auto all_lanes = GetLanes(point, radius);
+  if (all_lanes.empty()) {
+    return -1;
+  }
+  lanes->clear();
+  for (const auto& lane : all_lanes) {
+    Vec2d proj_point(0.0, 0.0);
+    double s_offset = 0.0;
+    int s_offset_index = 0;
+    const double distance = lane->DistanceTo({point.x(), point.y()},
+                                             &proj_point, &s_offset,
+                                             &s_offset_index);
+    if (distance > radius) {
+      continue;
+    }
+    const double heading_diff =
+        std::fabs(lane->headings()[s_offset_index] - heading);
+    if (std::fabs(common::math::NormalizeAngle(heading_diff)) <=
+        max_heading_difference) {
+      lanes->push_back(lane);
+    }
+  }
+  return 0;
 }
 
 }  // namespace prediction
@@ -403,7 +403,37 @@ class PredictionMap {
   static std::vector<std::shared_ptr<const hdmap::LaneInfo>> GetNearbyLanes(
       const common::PointENU& position, const double nearby_radius);
 
+  /**
+   * @brief Resolve the nearby lanes of a batch of positions in one pass so
+   *        that the lane queries of this frame on them hit the query cache
+   * @param points Positions in ENU frame
+   * @param radius Search radius around the given positions
+   */
+  static void PrefetchNearbyLanes(const std::vector<Eigen::Vector2d>& points,
+                                  const double radius);
+
+  /**
+   * @brief Drop the lane and junction queries cached in this frame, called
+   *        at the beginning of every frame and whenever the map changes
+   */
+  static void ResetQueryCache();
+
  private:
+  /**
+   * @brief Lanes within a radius of a point, cached per frame
+   */
+  static std::vector<std::shared_ptr<const hdmap::LaneInfo>> GetLanes(
+      const Eigen::Vector2d& point, const double radius);
+
+  /**
+   * @brief Lanes within a radius of a point with a heading close to the
+   *        given heading, same as HDMap::GetLanesWithHeading
+   */
+  static int GetLanesWithHeading(
+      const Eigen::Vector2d& point, const double radius, const double heading,
+      const double max_heading_difference,
+      std::vector<std::shared_ptr<const hdmap::LaneInfo>>* lanes);
+
   static std::shared_ptr<const hdmap::LaneInfo> GetNeighborLane(
       const std::shared_ptr<const hdmap::LaneInfo>& ptr_ego_lane,
       const Eigen::Vector2d& ego_position,
@@ -142,6 +142,38 @@ TEST_F(PredictionMapTest, on_lane) {
   EXPECT_EQ(0, curr_lanes.size());
 }
 
+TEST_F(PredictionMapTest, query_cache) {
+  std::vector<std::shared_ptr<const LaneInfo>> prev_lanes(0);
+  Eigen::Vector2d point(124.85931, 347.52733);
+  double heading = 0.0;
+  double radius = 3.0;
+
+  PredictionMap::ResetQueryCache();
+  PredictionMap::PrefetchNearbyLanes({point}, radius);
+  std::vector<std::shared_ptr<const LaneInfo>> cached_lanes(0);
+  PredictionMap::OnLane(prev_lanes, point, heading, radius, true,
+                        FLAGS_max_num_current_lane, FLAGS_max_lane_angle_diff,
+                        &cached_lanes);
+  EXPECT_TRUE(PredictionMap::HasNearbyLane(point.x(), point.y(), radius));
+
+  FLAGS_enable_prediction_map_query_cache = false;
+  std::vector<std::shared_ptr<const LaneInfo>> lanes(0);
+  PredictionMap::OnLane(prev_lanes, point, heading, radius, true,
+                        FLAGS_max_num_current_lane, FLAGS_max_lane_angle_diff,
+                        &lanes);
+  FLAGS_enable_prediction_map_query_cache = true;
+  ASSERT_EQ(lanes.size(), cached_lanes.size());
+  for (size_t i = 0; i < lanes.size(); ++i) {
+    EXPECT_EQ(lanes[i]->id().id(), cached_lanes[i]->id().id());
+  }
+  common::PointENU position;
+  position.set_x(point.x());
+  position.set_y(point.y());
+  position.set_z(0.0);
+  EXPECT_EQ(PredictionMap::NearbyLaneIds(point, radius).size(),
+            PredictionMap::GetNearbyLanes(position, radius).size());
+}
+
 TEST_F(PredictionMapTest, get_path_heading) {
   std::shared_ptr<const LaneInfo> lane_info = PredictionMap::LaneById("l20");
   common::PointENU point;
@@ -57,3 +57,12 @@ DEFINE_int32(prediction_offline_mode, 0,
 DEFINE_double(replay_timestamp_gap, 10.0,
               "Max timestamp gap for rosbag replay");
 DEFINE_int32(max_num_dump_feature, 50000, "Max number of features to dump");
+DEFINE_bool(enable_feature_stream_output, false,
+            "If stream the dumped data into compressed files from a "
+            "background thread instead of keeping them in memory");
+DEFINE_int32(feature_stream_max_queue_size, 10000,
+             "Max number of records queued for the background writer");
+DEFINE_int32(feature_stream_num_records_per_chunk, 1000,
+             "Number of records per compressed chunk of a stream file");
+DEFINE_int32(feature_stream_max_file_size_mb, 256,
+             "Compressed size in MB to start a new stream file at");
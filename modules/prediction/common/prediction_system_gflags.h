@@ -36,3 +36,7 @@ DECLARE_int32(prediction_offline_mode);
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
 DECLARE_int32(max_num_dump_feature);
+DECLARE_bool(enable_feature_stream_output);
+DECLARE_int32(feature_stream_max_queue_size);
+DECLARE_int32(feature_stream_num_records_per_chunk);
+DECLARE_int32(feature_stream_max_file_size_mb);
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+template <typename T>
+void EraseFront(const size_t n, std::vector<T>* values) {
+  values->erase(values->begin(), values->begin() + n);
+}
+
+}  // namespace
+
+void FeatureHistory::PushFront(const Feature& feature) {
+  uint8_t flags = 0;
+  timestamps_.push_back(feature.timestamp());
+  if (feature.has_position()) {
+    flags |= kHasPosition;
+  }
+  position_xs_.push_back(feature.position().x());
+  position_ys_.push_back(feature.position().y());
+  if (feature.has_velocity()) {
+    flags |= kHasVelocity;
+  }
+  velocity_xs_.push_back(feature.velocity().x());
+  velocity_ys_.push_back(feature.velocity().y());
+  speeds_.push_back(feature.speed());
+  if (feature.has_acceleration()) {
+    flags |= kHasAcceleration;
+  }
+  acceleration_xs_.push_back(feature.acceleration().x());
+  acceleration_ys_.push_back(feature.acceleration().y());
+  if (feature.has_velocity_heading()) {
+    flags |= kHasVelocityHeading;
+  }
+  velocity_headings_.push_back(feature.velocity_heading());
+
+  const LaneFeature& lane_feature = feature.lane().lane_feature();
+  if (feature.has_lane() && feature.lane().has_lane_feature()) {
+    flags |= kHasLaneFeature;
+  }
+  lane_ss_.push_back(lane_feature.lane_s());
+  lane_ls_.push_back(lane_feature.lane_l());
+  angle_diffs_.push_back(lane_feature.angle_diff());
+  dist_lbs_.push_back(lane_feature.dist_to_left_boundary());
+  dist_rbs_.push_back(lane_feature.dist_to_right_boundary());
+  lane_turn_types_.push_back(static_cast<int>(lane_feature.lane_turn_type()));
+  flags_.push_back(flags);
+}
+
+void FeatureHistory::PopBack() {
+  if (empty()) {
+    return;
+  }
+  ++begin_;
+  // popped frames are dropped in bulk, which keeps PopBack amortized O(1)
+  if (begin_ * 2 >= timestamps_.size()) {
+    Compact();
+  }
+}
+
+void FeatureHistory::Clear() {
+  begin_ = timestamps_.size();
+  Compact();
+}
+
+void FeatureHistory::Compact() {
+  EraseFront(begin_, &timestamps_);
+  EraseFront(begin_, &flags_);
+  EraseFront(begin_, &position_xs_);
+  EraseFront(begin_, &position_ys_);
+  EraseFront(begin_, &velocity_xs_);
+  EraseFront(begin_, &velocity_ys_);
+  EraseFront(begin_, &speeds_);
+  EraseFront(begin_, &acceleration_xs_);
+  EraseFront(begin_, &acceleration_ys_);
+  EraseFront(begin_, &velocity_headings_);
+  EraseFront(begin_, &lane_ss_);
+  EraseFront(begin_, &lane_ls_);
+  EraseFront(begin_, &angle_diffs_);
+  EraseFront(begin_, &dist_lbs_);
+  EraseFront(begin_, &dist_rbs_);
+  EraseFront(begin_, &lane_turn_types_);
+  begin_ = 0;
+}
+
+}  // namespace prediction
+}  // namespace apollo
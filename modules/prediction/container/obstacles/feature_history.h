@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Numeric history of an obstacle in structure-of-arrays layout
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+/**
+ * @namespace apollo::prediction
+ * @brief apollo::prediction
+ */
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureHistory
+ * @brief The numeric fields of an obstacle's feature history, one array per
+ *        field. Frames are indexed like Obstacle::feature, where index 0 is
+ *        the latest frame. Frames are stored in time order so that the
+ *        values of a field over the whole history are contiguous.
+ */
+class FeatureHistory {
+ public:
+  /**
+   * @brief Add a frame as the latest one
+   * @param The feature of the frame
+   */
+  void PushFront(const Feature& feature);
+
+  /**
+   * @brief Remove the oldest frame
+   */
+  void PopBack();
+
+  /**
+   * @brief Remove all frames
+   */
+  void Clear();
+
+  size_t size() const { return timestamps_.size() - begin_; }
+
+  bool empty() const { return size() == 0; }
+
+  double timestamp(const size_t i) const { return timestamps_[Index(i)]; }
+
+  bool has_position(const size_t i) const {
+    return (flags_[Index(i)] & kHasPosition) != 0;
+  }
+  double position_x(const size_t i) const { return position_xs_[Index(i)]; }
+  double position_y(const size_t i) const { return position_ys_[Index(i)]; }
+
+  bool has_velocity(const size_t i) const {
+    return (flags_[Index(i)] & kHasVelocity) != 0;
+  }
+  double velocity_x(const size_t i) const { return velocity_xs_[Index(i)]; }
+  double velocity_y(const size_t i) const { return velocity_ys_[Index(i)]; }
+  double speed(const size_t i) const { return speeds_[Index(i)]; }
+
+  bool has_acceleration(const size_t i) const {
+    return (flags_[Index(i)] & kHasAcceleration) != 0;
+  }
+  double acceleration_x(const size_t i) const {
+    return acceleration_xs_[Index(i)];
+  }
+  double acceleration_y(const size_t i) const {
+    return acceleration_ys_[Index(i)];
+  }
+
+  bool has_velocity_heading(const size_t i) const {
+    return (flags_[Index(i)] & kHasVelocityHeading) != 0;
+  }
+  double velocity_heading(const size_t i) const {
+    return velocity_headings_[Index(i)];
+  }
+
+  bool has_lane_feature(const size_t i) const {
+    return (flags_[Index(i)] & kHasLaneFeature) != 0;
+  }
+  double lane_s(const size_t i) const { return lane_ss_[Index(i)]; }
+  double lane_l(const size_t i) const { return lane_ls_[Index(i)]; }
+  double angle_diff(const size_t i) const { return angle_diffs_[Index(i)]; }
+  double dist_to_left_boundary(const size_t i) const {
+    return dist_lbs_[Index(i)];
+  }
+  double dist_to_right_boundary(const size_t i) const {
+    return dist_rbs_[Index(i)];
+  }
+  int lane_turn_type(const size_t i) const {
+    return lane_turn_types_[Index(i)];
+  }
+
+ private:
+  enum Flag : uint8_t {
+    kHasPosition = 1 << 0,
+    kHasVelocity = 1 << 1,
+    kHasAcceleration = 1 << 2,
+    kHasVelocityHeading = 1 << 3,
+    kHasLaneFeature = 1 << 4,
+  };
+
+  size_t Index(const size_t i) const { return timestamps_.size() - 1 - i; }
+
+  void Compact();
+
+  // offset of the oldest frame, frames before it are popped
+  size_t begin_ = 0;
+
+  std::vector<double> timestamps_;
+  std::vector<uint8_t> flags_;
+  std::vector<double> position_xs_;
+  std::vector<double> position_ys_;
+  std::vector<double> velocity_xs_;
+  std::vector<double> velocity_ys_;
+  std::vector<double> speeds_;
+  std::vector<double> acceleration_xs_;
+  std::vector<double> acceleration_ys_;
+  std::vector<double> velocity_headings_;
+  std::vector<double> lane_ss_;
+  std::vector<double> lane_ls_;
+  std::vector<double> angle_diffs_;
+  std::vector<double> dist_lbs_;
+  std::vector<double> dist_rbs_;
+  std::vector<int> lane_turn_types_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
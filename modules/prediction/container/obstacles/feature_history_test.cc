@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(FeatureHistoryTest, PushAndPop) {
+  FeatureHistory history;
+  EXPECT_TRUE(history.empty());
+
+  for (int i = 0; i < 100; ++i) {
+    Feature feature;
+    feature.set_timestamp(0.1 * i);
+    feature.mutable_position()->set_x(static_cast<double>(i));
+    feature.mutable_position()->set_y(-static_cast<double>(i));
+    feature.set_speed(2.0 * i);
+    if (i % 2 == 0) {
+      feature.mutable_lane()->mutable_lane_feature()->set_lane_l(0.5 * i);
+    }
+    history.PushFront(feature);
+  }
+  EXPECT_EQ(100, history.size());
+  EXPECT_DOUBLE_EQ(9.9, history.timestamp(0));
+  EXPECT_DOUBLE_EQ(99.0, history.position_x(0));
+  EXPECT_DOUBLE_EQ(-98.0, history.position_y(1));
+  EXPECT_TRUE(history.has_position(0));
+  EXPECT_FALSE(history.has_velocity(0));
+  EXPECT_FALSE(history.has_lane_feature(0));
+  EXPECT_TRUE(history.has_lane_feature(1));
+  EXPECT_DOUBLE_EQ(49.0, history.lane_l(1));
+
+  for (int i = 0; i < 70; ++i) {
+    history.PopBack();
+  }
+  EXPECT_EQ(30, history.size());
+  EXPECT_DOUBLE_EQ(99.0, history.position_x(0));
+  EXPECT_DOUBLE_EQ(70.0, history.position_x(29));
+  EXPECT_DOUBLE_EQ(140.0, history.speed(29));
+
+  history.Clear();
+  EXPECT_TRUE(history.empty());
+  history.PopBack();
+  EXPECT_TRUE(history.empty());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -86,6 +86,10 @@ Feature* Obstacle::mutable_latest_feature() {
 
 size_t Obstacle::history_size() const { return feature_history_.size(); }
 
+const FeatureHistory& Obstacle::numeric_history() const {
+  return numeric_history_;
+}
+
 const KalmanFilter<double, 6, 2, 0>& Obstacle::kf_motion_tracker() const {
   return kf_motion_tracker_;
 }
@@ -1468,18 +1472,17 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  // Accumulate from the earliest frame on, as the history is stored.
+  const FeatureHistory& history = numeric_history_;
+  start_x = history.position_x(history_size - 1);
+  start_y = history.position_y(history_size - 1);
+  for (int i = history_size - 2; i >= 0; --i) {
+    avg_drift_x += (history.position_x(i) - start_x) / (len - 1);
+    avg_drift_y += (history.position_y(i) - start_y) / (len - 1);
   }
 
-  double delta_ts = feature_history_.front().timestamp() -
-                    feature_history_.back().timestamp();
+  double delta_ts =
+      history.timestamp(0) - history.timestamp(history_size - 1);
   double speed_sensibility =
       std::sqrt(2 * history_size) * 4 * std / ((history_size + 1) * delta_ts);
   if (speed < speed_threshold) {
@@ -1528,6 +1531,7 @@ void Obstacle::SetMotionStatusBySpeed() {
 
 void Obstacle::InsertFeatureToHistory(const Feature& feature) {
   feature_history_.emplace_front(feature);
+  numeric_history_.PushFront(feature);
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1561,6 +1565,7 @@ void Obstacle::DiscardOutdatedHistory() {
   while (latest_ts - feature_history_.back().timestamp() >=
          FLAGS_max_history_time) {
     feature_history_.pop_back();
+    numeric_history_.PopBack();
   }
   auto num_of_discarded_frames = num_of_frames - feature_history_.size();
   if (num_of_discarded_frames > 0) {
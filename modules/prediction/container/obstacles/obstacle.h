@@ -31,6 +31,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/math/kalman_filter.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 #include "modules/prediction/proto/feature.pb.h"
 
 /**
@@ -131,6 +132,13 @@ class Obstacle {
    */
   size_t history_size() const;
 
+  /**
+   * @brief Get the numeric fields of the historical features, each field
+   *        over the history in one array, indexed like feature(i).
+   * @return The numeric history.
+   */
+  const FeatureHistory& numeric_history() const;
+
   /**
    * @brief Get the motion Kalman filter.
    * @return The motion Kalman filter.
@@ -329,6 +337,9 @@ class Obstacle {
 
   std::deque<Feature> feature_history_;
 
+  // numeric fields of feature_history_, kept in sync with it
+  FeatureHistory numeric_history_;
+
   common::math::KalmanFilter<double, 6, 2, 0> kf_motion_tracker_;
 
   common::math::KalmanFilter<double, 2, 2, 4> kf_pedestrian_tracker_;
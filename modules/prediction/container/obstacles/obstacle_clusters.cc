@@ -17,22 +17,37 @@
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <unordered_set>
 
+#include "modules/common/util/string_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/road_graph.h"
 
 namespace apollo {
 namespace prediction {
 
+using ::apollo::common::util::LRUCache;
 using ::apollo::hdmap::LaneInfo;
 
 std::unordered_map<std::string, LaneGraph> ObstacleClusters::lane_graphs_;
+std::unique_ptr<LRUCache<std::string, ObstacleClusters::CachedLaneGraph>>
+    ObstacleClusters::cached_lane_graphs_;
+int ObstacleClusters::num_lane_graph_builds_ = 0;
+int ObstacleClusters::num_lane_graph_cache_hits_ = 0;
 std::unordered_map<std::string, std::vector<LaneObstacle>>
     ObstacleClusters::lane_obstacles_;
 std::unordered_map<std::string, StopSign>
     ObstacleClusters::lane_id_stop_sign_map_;
 
 void ObstacleClusters::Clear() {
+  if (num_lane_graph_builds_ > 0) {
+    ADEBUG << "Lane graph cache hit rate: " << LaneGraphCacheHitRate()
+           << " of " << num_lane_graph_builds_ << " lane graphs";
+  }
+  num_lane_graph_builds_ = 0;
+  num_lane_graph_cache_hits_ = 0;
   lane_graphs_.clear();
   lane_obstacles_.clear();
   lane_id_stop_sign_map_.clear();
@@ -63,14 +78,87 @@ const LaneGraph& ObstacleClusters::GetLaneGraph(
   } else {
     // If this lane_segment has not been used for constructing LaneGraph,
     // construct the LaneGraph and return.
-    RoadGraph road_graph(start_s, length, lane_info_ptr);
-    LaneGraph lane_graph;
-    road_graph.BuildLaneGraph(&lane_graph);
-    lane_graphs_[lane_id] = std::move(lane_graph);
+    lane_graphs_[lane_id] = ObtainLaneGraph(start_s, length, lane_info_ptr);
   }
   return lane_graphs_[lane_id];
 }
 
+LaneGraph ObstacleClusters::ObtainLaneGraph(
+    const double start_s, const double length,
+    std::shared_ptr<const LaneInfo> lane_info_ptr) {
+  ++num_lane_graph_builds_;
+  if (FLAGS_max_num_cached_lane_graphs <= 0 || length < 0.0) {
+    return GetLaneGraphWithoutMemorizing(start_s, length, lane_info_ptr);
+  }
+  if (cached_lane_graphs_ == nullptr) {
+    cached_lane_graphs_.reset(new LRUCache<std::string, CachedLaneGraph>(
+        FLAGS_max_num_cached_lane_graphs));
+  }
+
+  // The cached graph starts at the lower bound of the start s bucket and
+  // reaches beyond both buckets, so it covers every query of its key.
+  const double s_resolution = FLAGS_lane_graph_cache_start_s_resolution;
+  const double length_resolution = FLAGS_lane_graph_cache_length_resolution;
+  const int start_s_index =
+      static_cast<int>(std::floor(start_s / s_resolution));
+  const int length_index =
+      static_cast<int>(std::ceil(length / length_resolution));
+  const std::string key = common::util::StrCat(
+      lane_info_ptr->id().id(), "_", start_s_index, "_", length_index);
+
+  CachedLaneGraph* cached = cached_lane_graphs_->Get(key);
+  if (cached != nullptr && cached->lane_info_ptr.lock() == lane_info_ptr) {
+    ++num_lane_graph_cache_hits_;
+  } else {
+    CachedLaneGraph covering;
+    covering.lane_info_ptr = lane_info_ptr;
+    RoadGraph road_graph(start_s_index * s_resolution,
+                         length_index * length_resolution + s_resolution,
+                         lane_info_ptr);
+    road_graph.BuildLaneGraph(&covering.lane_graph);
+    cached_lane_graphs_->Put(key, std::move(covering));
+    cached = cached_lane_graphs_->Get(key);
+  }
+
+  LaneGraph lane_graph;
+  PruneLaneGraph(cached->lane_graph, start_s, length, &lane_graph);
+  return lane_graph;
+}
+
+void ObstacleClusters::PruneLaneGraph(const LaneGraph& covering_lane_graph,
+                                      const double start_s,
+                                      const double length,
+                                      LaneGraph* const lane_graph) {
+  // Sequences branching beyond the search length collapse into one, keep
+  // the first of them to match the depth first order of RoadGraph.
+  std::unordered_set<std::string> sequence_keys;
+  for (const auto& covering_sequence : covering_lane_graph.lane_sequence()) {
+    LaneSequence lane_sequence;
+    std::string sequence_key;
+    double accumulated_s = 0.0;
+    for (const auto& covering_segment : covering_sequence.lane_segment()) {
+      LaneSegment* lane_segment = lane_sequence.add_lane_segment();
+      lane_segment->CopyFrom(covering_segment);
+      const double segment_start_s =
+          lane_sequence.lane_segment_size() == 1 ? start_s : 0.0;
+      lane_segment->set_start_s(segment_start_s);
+      sequence_key += covering_segment.lane_id() + "|";
+      const double remaining_length =
+          lane_segment->total_length() - segment_start_s;
+      if (accumulated_s + remaining_length >= length) {
+        lane_segment->set_end_s(length - accumulated_s + segment_start_s);
+        break;
+      }
+      lane_segment->set_end_s(lane_segment->total_length());
+      accumulated_s += remaining_length;
+    }
+    if (sequence_keys.insert(sequence_key).second) {
+      lane_sequence.set_label(covering_sequence.label());
+      lane_graph->add_lane_sequence()->Swap(&lane_sequence);
+    }
+  }
+}
+
 LaneGraph ObstacleClusters::GetLaneGraphWithoutMemorizing(
     const double start_s, const double length,
     std::shared_ptr<const LaneInfo> lane_info_ptr) {
@@ -193,6 +281,14 @@ bool ObstacleClusters::BackwardNearbyObstacle(
   return found_one_behind;
 }
 
+double ObstacleClusters::LaneGraphCacheHitRate() {
+  if (num_lane_graph_builds_ == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(num_lane_graph_cache_hits_) /
+         static_cast<double>(num_lane_graph_builds_);
+}
+
 StopSign ObstacleClusters::QueryStopSignByLaneId(const std::string& lane_id) {
   StopSign stop_sign;
   // Find the stop_sign by lane_id in the hashtable
@@ -24,6 +24,7 @@
 
 #include "modules/prediction/proto/feature.pb.h"
 
+#include "modules/common/util/lru_cache.h"
 #include "modules/map/hdmap/hdmap_common.h"
 
 namespace apollo {
@@ -118,6 +119,12 @@ class ObstacleClusters {
    */
   static StopSign QueryStopSignByLaneId(const std::string& lane_id);
 
+  /**
+   * @brief Hit rate of the cross-frame lane graph cache in this frame
+   * @return Ratio of lane graphs served from the cache among those built
+   */
+  static double LaneGraphCacheHitRate();
+
   static std::unordered_map<std::string, std::vector<LaneObstacle>>&
   GetLaneObstacles() {
     return lane_obstacles_;
@@ -128,8 +135,43 @@ class ObstacleClusters {
 
   static void Clear();
 
+  /**
+   * @brief Build a lane graph, reusing a graph of a nearby start s from
+   *        a previous frame when possible
+   * @param lane start s
+   * @param lane total length
+   * @param lane info
+   * @return a corresponding lane graph
+   */
+  static LaneGraph ObtainLaneGraph(
+      const double start_s, const double length,
+      std::shared_ptr<const apollo::hdmap::LaneInfo> lane_info_ptr);
+
+  /**
+   * @brief Cut a lane graph down to the one RoadGraph builds from start_s
+   *        for length, given it covers at least that range
+   * @param the covering lane graph
+   * @param lane start s
+   * @param lane total length
+   * @param the cut lane graph
+   */
+  static void PruneLaneGraph(const LaneGraph& covering_lane_graph,
+                             const double start_s, const double length,
+                             LaneGraph* const lane_graph);
+
+  struct CachedLaneGraph {
+    // a reloaded map has new lane infos, which expires the cached graph
+    std::weak_ptr<const apollo::hdmap::LaneInfo> lane_info_ptr;
+    LaneGraph lane_graph;
+  };
+
  private:
   static std::unordered_map<std::string, LaneGraph> lane_graphs_;
+  static std::unique_ptr<
+      common::util::LRUCache<std::string, CachedLaneGraph>>
+      cached_lane_graphs_;
+  static int num_lane_graph_builds_;
+  static int num_lane_graph_cache_hits_;
   static std::unordered_map<std::string, std::vector<LaneObstacle>>
       lane_obstacles_;
   static std::unordered_map<std::string, StopSign> lane_id_stop_sign_map_;
@@ -47,5 +47,30 @@ TEST_F(ObstacleClustersTest, ObstacleClusters) {
   EXPECT_EQ("l21", lane_graph_2.lane_sequence(0).lane_segment(2).lane_id());
 }
 
+TEST_F(ObstacleClustersTest, LaneGraphCache) {
+  auto lane = PredictionMap::LaneById("l9");
+  const double length = 50.0;
+
+  ObstacleClusters::Init();
+  ObstacleClusters::GetLaneGraph(98.5, length, lane);
+  EXPECT_DOUBLE_EQ(0.0, ObstacleClusters::LaneGraphCacheHitRate());
+
+  // a new frame with a start s in the same bucket reuses the graph
+  ObstacleClusters::Init();
+  const double start_s = 99.0;
+  const LaneGraph &lane_graph =
+      ObstacleClusters::GetLaneGraph(start_s, length, lane);
+  EXPECT_DOUBLE_EQ(1.0, ObstacleClusters::LaneGraphCacheHitRate());
+
+  const LaneGraph expected_lane_graph =
+      ObstacleClusters::GetLaneGraphWithoutMemorizing(start_s, length, lane);
+  ASSERT_EQ(expected_lane_graph.lane_sequence_size(),
+            lane_graph.lane_sequence_size());
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    EXPECT_EQ(expected_lane_graph.lane_sequence(i).ShortDebugString(),
+              lane_graph.lane_sequence(i).ShortDebugString());
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -18,9 +18,11 @@
 
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/junction_analyzer.h"
+#include "modules/prediction/common/prediction_map.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
@@ -112,6 +114,18 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
     BuildCurrentFrameIdMapping(perception_obstacles);
   }
 
+  // Resolve the nearby lanes of all obstacles at once, the per obstacle
+  // queries of this frame are then served from the map query cache.
+  PredictionMap::ResetQueryCache();
+  std::vector<Eigen::Vector2d> positions;
+  positions.reserve(perception_obstacles.perception_obstacle_size());
+  for (const PerceptionObstacle& perception_obstacle :
+       perception_obstacles.perception_obstacle()) {
+    positions.emplace_back(perception_obstacle.position().x(),
+                           perception_obstacle.position().y());
+  }
+  PredictionMap::PrefetchNearbyLanes(positions, FLAGS_lane_search_radius);
+
   // Set up the ObstacleClusters:
   // 1. Initialize ObstacleClusters
   ObstacleClusters::Init();
@@ -17,8 +17,13 @@
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <utility>
 #include <vector>
 
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -54,6 +59,12 @@ bool IsTrainable(const Feature& feature) {
   return true;
 }
 
+// Evaluators that run a network model, others only compute a cost.
+bool IsExpensiveEvaluator(const ObstacleConf::EvaluatorType& type) {
+  return type != ObstacleConf::COST_EVALUATOR &&
+         type != ObstacleConf::CYCLIST_KEEP_LANE_EVALUATOR;
+}
+
 }  // namespace
 
 EvaluatorManager::EvaluatorManager() { RegisterEvaluators(); }
@@ -139,6 +150,7 @@ void EvaluatorManager::Run() {
   }
 
   std::vector<Obstacle*> dynamic_env;
+  std::vector<Obstacle*> obstacles;
   for (int id : obstacles_container->curr_frame_predictable_obstacle_ids()) {
     if (id < 0) {
       ADEBUG << "The obstacle has invalid id [" << id << "].";
@@ -153,23 +165,165 @@ void EvaluatorManager::Run() {
       ADEBUG << "Ignore obstacle [" << id << "] in evaluator_manager";
       continue;
     }
+    obstacles.push_back(obstacle);
+  }
+
+  // The offline modes write features into shared FeatureOutput buffers, so
+  // they always run on the calling thread.
+  size_t num_workers = 1;
+  if (FLAGS_enable_multi_thread_evaluation &&
+      FLAGS_prediction_offline_mode == 0) {
+    num_workers = std::min(
+        obstacles.size(),
+        static_cast<size_t>(std::max(FLAGS_max_num_evaluation_threads, 1)));
+    num_workers = std::max(num_workers, static_cast<size_t>(1));
+  }
+  if (worker_evaluators_.size() + 1 < num_workers) {
+    worker_evaluators_.resize(num_workers - 1);
+  }
 
-    EvaluateObstacle(obstacle, dynamic_env);
+  // The offline modes dump the features of the configured evaluators, so
+  // they are never demoted.
+  const bool enable_budget =
+      FLAGS_enable_evaluation_budget && FLAGS_prediction_offline_mode == 0;
+  size_t num_caution_obstacles = obstacles.size();
+  size_t num_prioritized_obstacles = obstacles.size();
+  if (enable_budget) {
+    num_prioritized_obstacles =
+        PrioritizeObstacles(&obstacles, &num_caution_obstacles);
+  }
+  const auto deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double, std::milli>(
+              FLAGS_evaluation_budget_ms));
+  std::atomic<int> num_demoted(0);
+  const auto demoted = [&](const size_t i) {
+    if (!enable_budget || i < num_caution_obstacles) {
+      return false;
+    }
+    if (i >= num_prioritized_obstacles ||
+        std::chrono::steady_clock::now() > deadline) {
+      ++num_demoted;
+      return true;
+    }
+    return false;
+  };
+
+  std::vector<EvaluatorTimings> timings(num_workers);
+  if (num_workers == 1) {
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      EvaluateObstacleOnWorker(0, obstacles[i], dynamic_env, demoted(i),
+                               &timings[0]);
+    }
+  } else {
+    // Every worker evaluates a contiguous range of obstacles with its own
+    // evaluators, so the results do not depend on the thread scheduling.
+    const size_t num_per_worker =
+        (obstacles.size() + num_workers - 1) / num_workers;
+    cyber::ParallelFor(0, num_workers, 1, [&](const size_t worker_index) {
+      const size_t begin = worker_index * num_per_worker;
+      const size_t end = std::min(obstacles.size(), begin + num_per_worker);
+      for (size_t i = begin; i < end; ++i) {
+        EvaluateObstacleOnWorker(worker_index, obstacles[i], dynamic_env,
+                                 demoted(i), &timings[worker_index]);
+      }
+    });
+  }
+
+  EvaluatorTimings total_timings;
+  for (const auto& worker_timings : timings) {
+    for (const auto& timing : worker_timings) {
+      total_timings[timing.first].time_ms += timing.second.time_ms;
+      total_timings[timing.first].num_obstacles += timing.second.num_obstacles;
+    }
+  }
+  for (const auto& timing : total_timings) {
+    ADEBUG << "Evaluator [" << timing.first << "] evaluated "
+           << timing.second.num_obstacles << " obstacles in "
+           << timing.second.time_ms << " ms on " << num_workers
+           << " threads.";
+  }
+  if (enable_budget) {
+    ADEBUG << num_demoted << " of " << obstacles.size()
+           << " obstacles evaluated by the cost evaluator within budget.";
   }
 }
 
+size_t EvaluatorManager::PrioritizeObstacles(
+    std::vector<Obstacle*>* obstacles, size_t* num_caution_obstacles) {
+  auto pose_container =
+      ContainerManager::Instance()->GetContainer<PoseContainer>(
+          AdapterConfig::LOCALIZATION);
+  const PerceptionObstacle* ego_obstacle =
+      pose_container == nullptr ? nullptr
+                                : pose_container->ToPerceptionObstacle();
+
+  // Rank 0 is caution, 1 is nearby and 2 is the others.
+  using RankedObstacle = std::pair<std::pair<int, double>, Obstacle*>;
+  std::vector<RankedObstacle> ranked;
+  ranked.reserve(obstacles->size());
+  for (Obstacle* obstacle : *obstacles) {
+    const Feature& feature = obstacle->latest_feature();
+    if (feature.priority().priority() == ObstaclePriority::CAUTION) {
+      ranked.push_back({{0, 0.0}, obstacle});
+      continue;
+    }
+    double distance = 0.0;
+    if (ego_obstacle != nullptr) {
+      distance = std::hypot(
+          feature.position().x() - ego_obstacle->position().x(),
+          feature.position().y() - ego_obstacle->position().y());
+    }
+    const int rank = distance <= FLAGS_expensive_evaluation_distance ? 1 : 2;
+    ranked.push_back({{rank, distance}, obstacle});
+  }
+  std::stable_sort(
+      ranked.begin(), ranked.end(),
+      [](const RankedObstacle& lhs, const RankedObstacle& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+  *num_caution_obstacles = 0;
+  size_t num_prioritized_obstacles = 0;
+  for (size_t i = 0; i < ranked.size(); ++i) {
+    (*obstacles)[i] = ranked[i].second;
+    if (ranked[i].first.first == 0) {
+      ++*num_caution_obstacles;
+    }
+    if (ranked[i].first.first <= 1) {
+      ++num_prioritized_obstacles;
+    }
+  }
+  return num_prioritized_obstacles;
+}
+
 void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
                                         std::vector<Obstacle*> dynamic_env) {
+  EvaluatorTimings timings;
+  EvaluateObstacleOnWorker(0, obstacle, dynamic_env, false, &timings);
+}
+
+void EvaluatorManager::EvaluateObstacleOnWorker(
+    const size_t worker_index, Obstacle* obstacle,
+    const std::vector<Obstacle*>& dynamic_env, const bool demoted,
+    EvaluatorTimings* timings) {
+  const auto select_evaluator = [&](const ObstacleConf::EvaluatorType& type) {
+    return GetWorkerEvaluator(demoted && IsExpensiveEvaluator(type)
+                                  ? ObstacleConf::COST_EVALUATOR
+                                  : type,
+                              worker_index);
+  };
   Evaluator* evaluator = nullptr;
   // Select different evaluators depending on the obstacle's type.
   switch (obstacle->type()) {
     case PerceptionObstacle::VEHICLE: {
       if (obstacle->HasJunctionFeatureWithExits() &&
           !obstacle->IsCloseToJunctionExit()) {
-        evaluator = GetEvaluator(vehicle_in_junction_evaluator_);
+        evaluator = select_evaluator(vehicle_in_junction_evaluator_);
         CHECK_NOTNULL(evaluator);
       } else if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(vehicle_on_lane_evaluator_);
+        evaluator = select_evaluator(vehicle_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       } else {
         ADEBUG << "Obstacle: " << obstacle->id()
@@ -180,7 +334,7 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
     }
     case PerceptionObstacle::BICYCLE: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
+        evaluator = select_evaluator(cyclist_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       }
       break;
@@ -190,7 +344,7 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
     }
     default: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(default_on_lane_evaluator_);
+        evaluator = select_evaluator(default_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       }
       break;
@@ -199,14 +353,34 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
 
   // Evaluate using the selected evaluator.
   if (evaluator != nullptr) {
-    if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
+    const auto start_time = std::chrono::steady_clock::now();
+    const std::string name = evaluator->GetName();
+    if (name == "LANE_SCANNING_EVALUATOR") {
       // For evaluators that need surrounding obstacles' info.
       evaluator->Evaluate(obstacle, dynamic_env);
     } else {
       // For evaluators that don't need surrounding info.
       evaluator->Evaluate(obstacle);
     }
+    const std::chrono::duration<double, std::milli> diff =
+        std::chrono::steady_clock::now() - start_time;
+    auto& timing = (*timings)[name];
+    timing.time_ms += diff.count();
+    ++timing.num_obstacles;
+  }
+}
+
+Evaluator* EvaluatorManager::GetWorkerEvaluator(
+    const ObstacleConf::EvaluatorType& type, const size_t worker_index) {
+  if (worker_index == 0) {
+    return GetEvaluator(type);
+  }
+  auto& evaluators = worker_evaluators_[worker_index - 1];
+  auto it = evaluators.find(type);
+  if (it == evaluators.end()) {
+    it = evaluators.emplace(type, CreateEvaluator(type)).first;
   }
+  return it->second.get();
 }
 
 void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle) {
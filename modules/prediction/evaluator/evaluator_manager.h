@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "cyber/common/macros.h"
@@ -65,6 +66,42 @@ class EvaluatorManager {
   void EvaluateObstacle(Obstacle* obstacle);
 
  private:
+  // Time spent in one evaluator during a cycle.
+  struct EvaluatorTiming {
+    double time_ms = 0.0;
+    int num_obstacles = 0;
+  };
+  using EvaluatorTimings = std::map<std::string, EvaluatorTiming>;
+
+  /**
+   * @brief Evaluate an obstacle with the evaluator instances of a worker
+   * @param Worker index, 0 is the calling thread
+   * @param Obstacle pointer
+   * @param vector of all Obstacles
+   * @param If to use the cost evaluator instead of an expensive one
+   * @param Timings of the worker to add to
+   */
+  void EvaluateObstacleOnWorker(const size_t worker_index, Obstacle* obstacle,
+                                const std::vector<Obstacle*>& dynamic_env,
+                                const bool demoted, EvaluatorTimings* timings);
+
+  /**
+   * @brief Order the obstacles for the evaluation budget, caution obstacles
+   * first, then nearby obstacles by distance to ego vehicle, then the others
+   * @param Obstacles to evaluate
+   * @param Number of caution obstacles, never demoted
+   * @return Number of caution and nearby obstacles
+   */
+  size_t PrioritizeObstacles(std::vector<Obstacle*>* obstacles,
+                             size_t* num_caution_obstacles);
+
+  /**
+   * @brief Get the evaluator of a worker, created on first use for workers
+   * other than 0 which uses the registered evaluators
+   */
+  Evaluator* GetWorkerEvaluator(const ObstacleConf::EvaluatorType& type,
+                                const size_t worker_index);
+
   void BuildCurrentFrameEnv();
 
   /**
@@ -89,6 +126,12 @@ class EvaluatorManager {
  private:
   std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>> evaluators_;
 
+  // Evaluators of the workers 1 to N - 1 in multi-thread evaluation, so that
+  // no evaluator instance is shared by two threads.
+  std::vector<
+      std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>>>
+      worker_evaluators_;
+
   ObstacleConf::EvaluatorType vehicle_on_lane_evaluator_ =
       ObstacleConf::CRUISE_MLP_EVALUATOR;
 
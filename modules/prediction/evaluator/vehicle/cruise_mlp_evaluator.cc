@@ -77,7 +77,14 @@ void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
          << " lane sequences with probabilities:";
   // For every possible lane sequence, extract features that are needed
   // to feed into our trained model.
-  // Then compute the likelihood of the obstacle moving onto that laneseq.
+  // Then compute the likelihood of the obstacle moving onto that laneseq,
+  // with one batched model run per model for all its lane sequences.
+  std::vector<LaneSequence*> go_lane_sequences;
+  std::vector<Eigen::MatrixXf> go_lane_features;
+  std::vector<Eigen::MatrixXf> go_obs_features;
+  std::vector<LaneSequence*> cutin_lane_sequences;
+  std::vector<Eigen::MatrixXf> cutin_lane_features;
+  std::vector<Eigen::MatrixXf> cutin_obs_features;
   for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
     LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
     CHECK_NOTNULL(lane_sequence_ptr);
@@ -105,16 +112,43 @@ void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
         feature_values, OBSTACLE_FEATURE_SIZE + INTERACTION_FEATURE_SIZE,
         static_cast<int>(feature_values.size()), SINGLE_LANE_FEATURE_SIZE,
         LANE_POINTS_SIZE);
-    Eigen::MatrixXf model_output;
     if (lane_sequence_ptr->vehicle_on_lane()) {
-      go_model_ptr_->Run({lane_feature_mat, obs_feature_mat}, &model_output);
+      go_lane_sequences.push_back(lane_sequence_ptr);
+      go_lane_features.push_back(std::move(lane_feature_mat));
+      go_obs_features.push_back(std::move(obs_feature_mat));
     } else {
-      cutin_model_ptr_->Run({lane_feature_mat, obs_feature_mat}, &model_output);
+      cutin_lane_sequences.push_back(lane_sequence_ptr);
+      cutin_lane_features.push_back(std::move(lane_feature_mat));
+      cutin_obs_features.push_back(std::move(obs_feature_mat));
     }
-    double probability = model_output(0, 0);
-    double finish_time = model_output(0, 1);
-    lane_sequence_ptr->set_probability(probability);
-    lane_sequence_ptr->set_time_to_lane_center(finish_time);
+  }
+
+  RunModelBatch(*go_model_ptr_, go_lane_features, go_obs_features,
+                &go_lane_sequences);
+  RunModelBatch(*cutin_model_ptr_, cutin_lane_features, cutin_obs_features,
+                &cutin_lane_sequences);
+}
+
+void CruiseMLPEvaluator::RunModelBatch(
+    const network::CruiseModel& model,
+    const std::vector<Eigen::MatrixXf>& lane_features,
+    const std::vector<Eigen::MatrixXf>& obs_features,
+    std::vector<LaneSequence*>* lane_sequences) {
+  if (lane_sequences->empty()) {
+    return;
+  }
+  Eigen::MatrixXf obs_feature_batch(obs_features.size(),
+                                    obs_features.front().cols());
+  for (size_t i = 0; i < obs_features.size(); ++i) {
+    obs_feature_batch.row(i) = obs_features[i].row(0);
+  }
+  Eigen::MatrixXf model_output;
+  model.RunBatch(lane_features, obs_feature_batch, &model_output);
+  for (size_t i = 0; i < lane_sequences->size(); ++i) {
+    double probability = model_output(i, 0);
+    double finish_time = model_output(i, 1);
+    (*lane_sequences)[i]->set_probability(probability);
+    (*lane_sequences)[i]->set_time_to_lane_center(finish_time);
   }
 }
 
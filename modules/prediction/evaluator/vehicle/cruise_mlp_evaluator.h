@@ -97,6 +97,19 @@ class CruiseMLPEvaluator : public Evaluator {
   void LoadModels(const std::string& go_model_file,
                   const std::string& cutin_model_file);
 
+  /**
+   * @brief Run a model once for a batch of lane sequences and set their
+   *        probabilities and times to lane center
+   * @param Model to run
+   * @param Lane feature matrix of every lane sequence
+   * @param Obstacle feature row of every lane sequence
+   * @param Lane sequences to update
+   */
+  void RunModelBatch(const network::CruiseModel& model,
+                     const std::vector<Eigen::MatrixXf>& lane_features,
+                     const std::vector<Eigen::MatrixXf>& obs_features,
+                     std::vector<LaneSequence*>* lane_sequences);
+
   /**
    * @brief Compute probability of a junction exit
    */
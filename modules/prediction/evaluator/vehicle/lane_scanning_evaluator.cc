@@ -150,30 +150,26 @@ bool LaneScanningEvaluator::ExtractObstacleFeatures(
   // Starting from the most recent timestamp and going backward.
   ADEBUG << "Obstacle has " << obstacle_ptr->history_size()
          << " history timestamps.";
-  for (std::size_t i = 0; i < std::min(obstacle_ptr->history_size(),
-                                       FLAGS_cruise_historical_frame_length);
+  const FeatureHistory& history = obstacle_ptr->numeric_history();
+  for (std::size_t i = 0;
+       i < std::min(history.size(), FLAGS_cruise_historical_frame_length);
        ++i) {
-    const Feature& feature = obstacle_ptr->feature(i);
-    if (!feature.IsInitialized()) {
-      has_history[i] = 0.0;
-      continue;
-    }
     if (i != 0 && has_history[i - 1] == 0.0) {
       has_history[i] = 0.0;
       continue;
     }
     // Extract normalized position info.
-    if (feature.has_position()) {
+    if (history.has_position(i)) {
       pos_history[i] = WorldCoordToObjCoord(
-          std::make_pair(feature.position().x(), feature.position().y()),
+          std::make_pair(history.position_x(i), history.position_y(i)),
           obs_curr_pos, obs_curr_heading);
     } else {
       has_history[i] = 0.0;
     }
     // Extract normalized velocity info.
-    if (feature.has_velocity()) {
+    if (history.has_velocity(i)) {
       auto vel_end = WorldCoordToObjCoord(
-          std::make_pair(feature.velocity().x(), feature.velocity().y()),
+          std::make_pair(history.velocity_x(i), history.velocity_y(i)),
           obs_curr_pos, obs_curr_heading);
       auto vel_begin = WorldCoordToObjCoord(std::make_pair(0.0, 0.0),
                                             obs_curr_pos, obs_curr_heading);
@@ -183,11 +179,10 @@ bool LaneScanningEvaluator::ExtractObstacleFeatures(
       has_history[i] = 0.0;
     }
     // Extract normalized acceleration info.
-    if (feature.has_acceleration()) {
-      auto acc_end =
-          WorldCoordToObjCoord(std::make_pair(feature.acceleration().x(),
-                                              feature.acceleration().y()),
-                               obs_curr_pos, obs_curr_heading);
+    if (history.has_acceleration(i)) {
+      auto acc_end = WorldCoordToObjCoord(
+          std::make_pair(history.acceleration_x(i), history.acceleration_y(i)),
+          obs_curr_pos, obs_curr_heading);
       auto acc_begin = WorldCoordToObjCoord(std::make_pair(0.0, 0.0),
                                             obs_curr_pos, obs_curr_heading);
       acc_history[i] = std::make_pair(acc_end.first - acc_begin.first,
@@ -196,14 +191,14 @@ bool LaneScanningEvaluator::ExtractObstacleFeatures(
       has_history[i] = 0.0;
     }
     // Extract velocity heading info.
-    if (feature.has_velocity_heading()) {
+    if (history.has_velocity_heading(i)) {
       vel_heading_history[i] =
-          WorldAngleToObjAngle(feature.velocity_heading(), obs_curr_heading);
+          WorldAngleToObjAngle(history.velocity_heading(i), obs_curr_heading);
       if (i != 0) {
         vel_heading_changing_rate_history[i] =
             (vel_heading_history[i] - vel_heading_history[i - 1]) /
-            (feature.timestamp() - prev_timestamp + FLAGS_double_precision);
-        prev_timestamp = feature.timestamp();
+            (history.timestamp(i) - prev_timestamp + FLAGS_double_precision);
+        prev_timestamp = history.timestamp(i);
       }
     } else {
       has_history[i] = 0.0;
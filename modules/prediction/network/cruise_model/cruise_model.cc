@@ -133,6 +133,89 @@ void CruiseModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
   (*output)(0, 1) = time_to_lane_center;
 }
 
+void CruiseModel::RunBatch(const std::vector<Eigen::MatrixXf>& lane_features,
+                           const Eigen::MatrixXf& obs_features,
+                           Eigen::MatrixXf* outputs) const {
+  const int batch_size = static_cast<int>(lane_features.size());
+  CHECK_EQ(obs_features.rows(), batch_size);
+  outputs->resize(batch_size, 2);
+  if (batch_size == 0) {
+    return;
+  }
+
+  // Step 1-3: Run lane feature conv 1d and pooling for every sample
+  for (int i = 0; i < batch_size; ++i) {
+    Eigen::MatrixXf lane_conv1d_0_output;
+    lane_conv1d_0_->Run({lane_features[i]}, &lane_conv1d_0_output);
+    Eigen::MatrixXf lane_activation_1_output;
+    lane_activation_1_->Run(lane_conv1d_0_output, &lane_activation_1_output);
+    Eigen::MatrixXf lane_conv1d_2_output;
+    lane_conv1d_2_->Run({lane_activation_1_output}, &lane_conv1d_2_output);
+    Eigen::MatrixXf lane_maxpool1d_output;
+    lane_maxpool1d_->Run({lane_conv1d_2_output}, &lane_maxpool1d_output);
+    Eigen::MatrixXf lane_avgpool1d_output;
+    lane_avgpool1d_->Run({lane_conv1d_2_output}, &lane_avgpool1d_output);
+    Eigen::MatrixXf lane_feature;
+    concatenate_->Run({FlattenMatrix(lane_maxpool1d_output),
+                       FlattenMatrix(lane_avgpool1d_output)},
+                      &lane_feature);
+    if (i == 0) {
+      lane_batch_.resize(batch_size, lane_feature.cols());
+    }
+    lane_batch_.row(i) = lane_feature.row(0);
+  }
+
+  // Step 4: Run obstacle feature fully connected
+  obs_linear_0_->Run(obs_features, &buffer_a_);
+  obs_activation_1_->Run(buffer_a_, &buffer_b_);
+  obs_linear_3_->Run(buffer_b_, &buffer_a_);
+  obs_activation_4_->Run(buffer_a_, &obs_batch_);
+
+  // Step 5: Concatenate [lane_feature, obstacle_feature]
+  feature_batch_.resize(batch_size, lane_batch_.cols() + obs_batch_.cols());
+  feature_batch_ << lane_batch_, obs_batch_;
+
+  // Step 6: Get classification results
+  classify_linear_0_->Run(feature_batch_, &buffer_a_);
+  classify_activation_1_->Run(buffer_a_, &buffer_b_);
+  classify_linear_3_->Run(buffer_b_, &buffer_a_);
+  classify_activation_4_->Run(buffer_a_, &buffer_b_);
+  classify_linear_6_->Run(buffer_b_, &buffer_a_);
+  classify_activation_7_->Run(buffer_a_, &buffer_b_);
+  classify_linear_9_->Run(buffer_b_, &classify_hidden_batch_);
+  classify_activation_10_->Run(classify_hidden_batch_, &buffer_a_);
+  CHECK_EQ(buffer_a_.cols(), 1);
+  outputs->col(0) = buffer_a_.col(0);
+
+  // Step 7: Get regression results
+  outputs->col(1).setConstant(
+      static_cast<float>(FLAGS_time_to_center_if_not_reach));
+  if (!FLAGS_enable_cruise_regression ||
+      (outputs->col(0).array() <
+       static_cast<float>(FLAGS_lane_sequence_threshold_cruise))
+          .all()) {
+    return;
+  }
+
+  regress_input_batch_.resize(
+      batch_size, feature_batch_.cols() + classify_hidden_batch_.cols());
+  regress_input_batch_ << feature_batch_, classify_hidden_batch_;
+  regress_linear_0_->Run(regress_input_batch_, &buffer_a_);
+  regress_activation_1_->Run(buffer_a_, &buffer_b_);
+  regress_linear_3_->Run(buffer_b_, &buffer_a_);
+  regress_activation_4_->Run(buffer_a_, &buffer_b_);
+  regress_linear_6_->Run(buffer_b_, &buffer_a_);
+  regress_activation_7_->Run(buffer_a_, &buffer_b_);
+  regress_linear_9_->Run(buffer_b_, &buffer_a_);
+  regress_activation_10_->Run(buffer_a_, &buffer_b_);
+  for (int i = 0; i < batch_size; ++i) {
+    if ((*outputs)(i, 0) >=
+        static_cast<float>(FLAGS_lane_sequence_threshold_cruise)) {
+      (*outputs)(i, 1) = buffer_b_(i, 0);
+    }
+  }
+}
+
 bool CruiseModel::LoadModel(
     const CruiseModelParameter& cruise_model_parameter) {
   CHECK(cruise_model_parameter.has_lane_feature_conv());
@@ -45,6 +45,19 @@ class CruiseModel : public NetModel {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) const override;
 
+  /**
+   * @brief Compute the model outputs of a batch of samples. The lane
+   *        feature convolution runs per sample, every fully connected layer
+   *        runs once for the whole batch. Activation buffers are kept
+   *        across calls, so a model must not be shared between threads.
+   * @param Lane feature matrix of every sample
+   * @param Obstacle features, one sample per row
+   * @param Outputs, one (probability, time to lane center) row per sample
+   */
+  void RunBatch(const std::vector<Eigen::MatrixXf>& lane_features,
+                const Eigen::MatrixXf& obs_features,
+                Eigen::MatrixXf* outputs) const;
+
  private:
   // LaneFeatureConvParameter
   std::unique_ptr<Conv1d> lane_conv1d_0_ =
@@ -109,6 +122,15 @@ class CruiseModel : public NetModel {
   // Concatenate
   std::unique_ptr<Concatenate> concatenate_ =
       std::unique_ptr<Concatenate>(new Concatenate());
+
+  // Activation buffers of RunBatch
+  mutable Eigen::MatrixXf lane_batch_;
+  mutable Eigen::MatrixXf obs_batch_;
+  mutable Eigen::MatrixXf feature_batch_;
+  mutable Eigen::MatrixXf classify_hidden_batch_;
+  mutable Eigen::MatrixXf regress_input_batch_;
+  mutable Eigen::MatrixXf buffer_a_;
+  mutable Eigen::MatrixXf buffer_b_;
 };
 
 }  // namespace network
@@ -55,10 +55,25 @@ bool Dense::Load(const LayerParameter& layer_pb) {
 }
 
 bool Dense::Load(const DenseParameter& dense_pb) {
-  if (!dense_pb.has_weights() || !LoadTensor(dense_pb.weights(), &weights_)) {
+  if (!dense_pb.has_weights()) {
     AERROR << "Fail to Load weights!";
     return false;
   }
+  if (IsQuantizedTensor(dense_pb.weights())) {
+    // keep int8 weights, the float copy would undo the memory saving
+    weights_.resize(0, 0);
+    if (!LoadQuantizedTensor(dense_pb.weights(), &quantized_weights_,
+                             &weight_scales_)) {
+      AERROR << "Fail to Load quantized weights!";
+      return false;
+    }
+  } else {
+    quantized_weights_.resize(0, 0);
+    if (!LoadTensor(dense_pb.weights(), &weights_)) {
+      AERROR << "Fail to Load weights!";
+      return false;
+    }
+  }
   if (!dense_pb.has_bias() || !LoadTensor(dense_pb.bias(), &bias_)) {
     AERROR << "Fail to Load bias!";
     return false;
@@ -82,15 +97,37 @@ bool Dense::Load(const DenseParameter& dense_pb) {
 void Dense::Run(const std::vector<Eigen::MatrixXf>& inputs,
                 Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf prod = static_cast<Eigen::MatrixXf>(inputs[0] * weights_);
+  Run(inputs[0], output);
+}
+
+void Dense::Run(const Eigen::MatrixXf& input, Eigen::MatrixXf* output) {
+  if (quantized_weights_.size() > 0) {
+    RunQuantized(input, output);
+  } else {
+    output->noalias() = input * weights_;
+  }
   if (use_bias_) {
-    Eigen::MatrixXf sum = prod.rowwise() + bias_.transpose();
-    prod = sum;
+    output->rowwise() += bias_.transpose();
   }
-  *output = prod.unaryExpr(kactivation_);
+  *output = output->unaryExpr(kactivation_);
   CHECK_EQ(output->cols(), units_);
 }
 
+void Dense::RunQuantized(const Eigen::MatrixXf& input,
+                         Eigen::MatrixXf* output) {
+  CHECK_EQ(input.cols(), quantized_weights_.rows());
+  // samples as columns so that both operands of each dot are contiguous
+  transposed_input_ = input.transpose();
+  output->resize(input.rows(), quantized_weights_.cols());
+  for (int j = 0; j < quantized_weights_.cols(); ++j) {
+    const auto weights_j = quantized_weights_.col(j).cast<float>();
+    for (int i = 0; i < input.rows(); ++i) {
+      (*output)(i, j) =
+          transposed_input_.col(i).dot(weights_j) * weight_scales_(j);
+    }
+  }
+}
+
 bool Conv1d::Load(const LayerParameter& layer_pb) {
   if (!Layer::Load(layer_pb)) {
     AERROR << "Fail to Load LayerParameter!";
@@ -265,7 +302,11 @@ bool Activation::Load(const ActivationParameter& activation_pb) {
 void Activation::Run(const std::vector<Eigen::MatrixXf>& inputs,
                      Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  *output = inputs[0].unaryExpr(kactivation_);
+  Run(inputs[0], output);
+}
+
+void Activation::Run(const Eigen::MatrixXf& input, Eigen::MatrixXf* output) {
+  *output = input.unaryExpr(kactivation_);
 }
 
 bool BatchNormalization::Load(const LayerParameter& layer_pb) {
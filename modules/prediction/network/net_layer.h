@@ -129,10 +129,35 @@ class Dense : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output of a batch, one sample per input row,
+   *        as a single matrix product. The storage of output is reused
+   *        when its size does not change.
+   * @param Input of a network layer
+   * @param Output of a network layer will be returned
+   */
+  void Run(const Eigen::MatrixXf& input, Eigen::MatrixXf* output);
+
+  /**
+   * @brief Check if the layer runs on int8 quantized weights
+   * @return True if the weights are quantized, otherwise False
+   */
+  bool IsQuantized() const { return quantized_weights_.size() > 0; }
+
  private:
+  /**
+   * @brief Compute x*w with int8 weights dequantized per output unit
+   * @param Input of a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunQuantized(const Eigen::MatrixXf& input, Eigen::MatrixXf* output);
+
   int units_;
   bool use_bias_;
   Eigen::MatrixXf weights_;
+  QuantizedMatrix quantized_weights_;
+  Eigen::VectorXf weight_scales_;
+  Eigen::MatrixXf transposed_input_;
   Eigen::VectorXf bias_;
   std::function<float(float)> kactivation_;
 };
@@ -276,6 +301,14 @@ class Activation : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input, the storage of
+   *        output is reused when its size does not change.
+   * @param Input of a network layer
+   * @param Output of a network layer will be returned
+   */
+  void Run(const Eigen::MatrixXf& input, Eigen::MatrixXf* output);
+
  private:
   std::function<float(float)> kactivation_;
 };
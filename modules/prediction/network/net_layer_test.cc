@@ -53,6 +53,75 @@ TEST(LayerTest, dense_test) {
   EXPECT_EQ(output(0, 0), 2.0);
 }
 
+TEST(LayerTest, dense_batch_test) {
+  LayerParameter layer_pb;
+  layer_pb.mutable_dense()->set_units(2);
+  layer_pb.mutable_dense()->set_activation("relu");
+  auto* weights = layer_pb.mutable_dense()->mutable_weights();
+  weights->add_shape(3);
+  weights->add_shape(2);
+  for (float w : {1.0f, -1.0f, 0.5f, 2.0f, -2.0f, 0.25f}) {
+    weights->add_data(w);
+  }
+  layer_pb.mutable_dense()->mutable_bias()->add_shape(2);
+  layer_pb.mutable_dense()->mutable_bias()->add_data(0.5);
+  layer_pb.mutable_dense()->mutable_bias()->add_data(-0.5);
+  Dense dense;
+  EXPECT_TRUE(dense.Load(layer_pb));
+
+  Eigen::MatrixXf batch(4, 3);
+  batch << 1.0, 2.0, 3.0, -1.0, 0.5, 2.0, 0.0, 0.0, 0.0, 3.0, -2.0, 1.0;
+  Eigen::MatrixXf batch_output;
+  dense.Run(batch, &batch_output);
+  ASSERT_EQ(batch_output.rows(), 4);
+  ASSERT_EQ(batch_output.cols(), 2);
+  for (int i = 0; i < batch.rows(); ++i) {
+    Eigen::MatrixXf output;
+    dense.Run(std::vector<Eigen::MatrixXf>{batch.row(i)}, &output);
+    EXPECT_FLOAT_EQ(output(0, 0), batch_output(i, 0));
+    EXPECT_FLOAT_EQ(output(0, 1), batch_output(i, 1));
+  }
+}
+
+TEST(LayerTest, dense_quantized_test) {
+  LayerParameter layer_pb;
+  layer_pb.mutable_dense()->set_units(2);
+  layer_pb.mutable_dense()->set_activation("linear");
+  auto* weights = layer_pb.mutable_dense()->mutable_weights();
+  weights->add_shape(3);
+  weights->add_shape(2);
+  for (float w : {1.0f, -1.0f, 0.5f, 2.0f, -2.0f, 0.25f}) {
+    weights->add_data(w);
+  }
+  layer_pb.mutable_dense()->mutable_bias()->add_shape(2);
+  layer_pb.mutable_dense()->mutable_bias()->add_data(0.5);
+  layer_pb.mutable_dense()->mutable_bias()->add_data(-0.5);
+  Dense dense;
+  EXPECT_TRUE(dense.Load(layer_pb));
+  EXPECT_FALSE(dense.IsQuantized());
+
+  LayerParameter quantized_pb = layer_pb;
+  EXPECT_TRUE(QuantizeTensor(layer_pb.dense().weights(),
+                             quantized_pb.mutable_dense()->mutable_weights()));
+  Dense quantized_dense;
+  EXPECT_TRUE(quantized_dense.Load(quantized_pb));
+  EXPECT_TRUE(quantized_dense.IsQuantized());
+
+  Eigen::MatrixXf batch(2, 3);
+  batch << 1.0, 2.0, 3.0, -1.0, 0.5, 2.0;
+  Eigen::MatrixXf output;
+  Eigen::MatrixXf quantized_output;
+  dense.Run(batch, &output);
+  quantized_dense.Run(batch, &quantized_output);
+  ASSERT_EQ(quantized_output.rows(), 2);
+  ASSERT_EQ(quantized_output.cols(), 2);
+  for (int i = 0; i < output.rows(); ++i) {
+    for (int j = 0; j < output.cols(); ++j) {
+      EXPECT_NEAR(output(i, j), quantized_output(i, j), 0.05);
+    }
+  }
+}
+
 TEST(LayerTest, activation_test) {
   LayerParameter layer_pb;
   Activation act;
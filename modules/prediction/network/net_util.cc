@@ -16,6 +16,8 @@
 
 #include "modules/prediction/network/net_util.h"
 
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 
 #include "cyber/common/log.h"
@@ -24,6 +26,31 @@ namespace apollo {
 namespace prediction {
 namespace network {
 
+namespace {
+
+int TensorSize(const TensorParameter& tensor_pb) {
+  return IsQuantizedTensor(tensor_pb)
+             ? static_cast<int>(tensor_pb.quantized_data().size())
+             : tensor_pb.data_size();
+}
+
+float TensorScale(const TensorParameter& tensor_pb, const int index) {
+  if (tensor_pb.scale_size() == 1) {
+    return tensor_pb.scale(0);
+  }
+  return tensor_pb.scale(index % tensor_pb.scale_size());
+}
+
+float TensorValue(const TensorParameter& tensor_pb, const int index) {
+  if (!IsQuantizedTensor(tensor_pb)) {
+    return static_cast<float>(tensor_pb.data(index));
+  }
+  const int8_t value = static_cast<int8_t>(tensor_pb.quantized_data()[index]);
+  return static_cast<float>(value) * TensorScale(tensor_pb, index);
+}
+
+}  // namespace
+
 float sigmoid(const float x) { return 1.0f / (1.0f + std::exp(-x)); }
 
 float tanh(const float x) { return std::tanh(x); }
@@ -64,7 +91,7 @@ std::function<float(float)> serialize_to_function(const std::string& str) {
 }
 
 bool LoadTensor(const TensorParameter& tensor_pb, Eigen::MatrixXf* matrix) {
-  if (tensor_pb.data_size() == 0 || tensor_pb.shape_size() == 0) {
+  if (TensorSize(tensor_pb) == 0 || tensor_pb.shape_size() == 0) {
     AERROR << "Fail to load the necessary fields!";
     return false;
   }
@@ -72,7 +99,7 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::MatrixXf* matrix) {
     ADEBUG << "Load tensor size: (1, " << tensor_pb.shape(0) << ")";
     matrix->resize(1, tensor_pb.shape(0));
     for (int i = 0; i < tensor_pb.shape(0); ++i) {
-      (*matrix)(0, i) = static_cast<float>(tensor_pb.data(i));
+      (*matrix)(0, i) = TensorValue(tensor_pb, i);
     }
     return true;
   }
@@ -82,15 +109,14 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::MatrixXf* matrix) {
   matrix->resize(tensor_pb.shape(0), tensor_pb.shape(1));
   for (int i = 0; i < tensor_pb.shape(0); ++i) {
     for (int j = 0; j < tensor_pb.shape(1); ++j) {
-      (*matrix)(i, j) =
-          static_cast<float>(tensor_pb.data(i * tensor_pb.shape(1) + j));
+      (*matrix)(i, j) = TensorValue(tensor_pb, i * tensor_pb.shape(1) + j);
     }
   }
   return true;
 }
 
 bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector) {
-  if (tensor_pb.data_size() == 0 || tensor_pb.shape_size() == 0) {
+  if (TensorSize(tensor_pb) == 0 || tensor_pb.shape_size() == 0) {
     AERROR << "Fail to load the necessary fields!";
     return false;
   }
@@ -99,7 +125,7 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector) {
   if (tensor_pb.shape_size() == 1) {
     vector->resize(tensor_pb.shape(0));
     for (int i = 0; i < tensor_pb.shape(0); ++i) {
-      (*vector)(i) = static_cast<float>(tensor_pb.data(i));
+      (*vector)(i) = TensorValue(tensor_pb, i);
     }
   }
   return true;
@@ -107,20 +133,20 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector) {
 
 bool LoadTensor(const TensorParameter& tensor_pb,
                 std::vector<Eigen::MatrixXf>* const tensor3d) {
-  if (tensor_pb.data_size() == 0 || tensor_pb.shape_size() != 3) {
+  if (TensorSize(tensor_pb) == 0 || tensor_pb.shape_size() != 3) {
     AERROR << "Fail to load the necessary fields!";
     return false;
   }
   int num_depth = tensor_pb.shape(0);
   int num_row = tensor_pb.shape(1);
   int num_col = tensor_pb.shape(2);
-  CHECK_EQ(tensor_pb.data_size(), num_depth * num_row * num_col);
+  CHECK_EQ(TensorSize(tensor_pb), num_depth * num_row * num_col);
   int tensor_pb_index = 0;
   for (int k = 0; k < num_depth; ++k) {
     Eigen::MatrixXf matrix = Eigen::MatrixXf::Zero(num_row, num_col);
     for (int i = 0; i < num_row; ++i) {
       for (int j = 0; j < num_col; ++j) {
-        matrix(i, j) = tensor_pb.data(tensor_pb_index);
+        matrix(i, j) = TensorValue(tensor_pb, tensor_pb_index);
         ++tensor_pb_index;
       }
     }
@@ -130,6 +156,69 @@ bool LoadTensor(const TensorParameter& tensor_pb,
   return true;
 }
 
+bool IsQuantizedTensor(const TensorParameter& tensor_pb) {
+  return tensor_pb.has_quantized_data() && tensor_pb.scale_size() > 0;
+}
+
+bool LoadQuantizedTensor(const TensorParameter& tensor_pb,
+                         QuantizedMatrix* matrix, Eigen::VectorXf* scales) {
+  if (!IsQuantizedTensor(tensor_pb) || tensor_pb.shape_size() != 2) {
+    AERROR << "Fail to load the necessary fields!";
+    return false;
+  }
+  const int num_row = tensor_pb.shape(0);
+  const int num_col = tensor_pb.shape(1);
+  if (TensorSize(tensor_pb) != num_row * num_col ||
+      (tensor_pb.scale_size() != 1 && tensor_pb.scale_size() != num_col)) {
+    AERROR << "Inconsistent quantized tensor size!";
+    return false;
+  }
+  const std::string& data = tensor_pb.quantized_data();
+  matrix->resize(num_row, num_col);
+  scales->resize(num_col);
+  for (int j = 0; j < num_col; ++j) {
+    (*scales)(j) = TensorScale(tensor_pb, j);
+    for (int i = 0; i < num_row; ++i) {
+      (*matrix)(i, j) = static_cast<int8_t>(data[i * num_col + j]);
+    }
+  }
+  return true;
+}
+
+bool QuantizeTensor(const TensorParameter& tensor_pb,
+                    TensorParameter* const quantized_pb) {
+  if (IsQuantizedTensor(tensor_pb) || tensor_pb.data_size() == 0) {
+    return false;
+  }
+  const int size = tensor_pb.data_size();
+  // per column scales keep the error of each output unit independent
+  const int num_scale = tensor_pb.shape_size() == 2 ? tensor_pb.shape(1) : 1;
+  if (num_scale <= 0 || size % num_scale != 0) {
+    AERROR << "Inconsistent tensor size!";
+    return false;
+  }
+  std::vector<float> max_abs(num_scale, 0.0f);
+  for (int i = 0; i < size; ++i) {
+    max_abs[i % num_scale] =
+        std::max(max_abs[i % num_scale], std::abs(tensor_pb.data(i)));
+  }
+
+  quantized_pb->Clear();
+  quantized_pb->mutable_shape()->CopyFrom(tensor_pb.shape());
+  for (const float value : max_abs) {
+    quantized_pb->add_scale(value > 0.0f ? value / 127.0f : 1.0f);
+  }
+  std::string* data = quantized_pb->mutable_quantized_data();
+  data->resize(size);
+  for (int i = 0; i < size; ++i) {
+    const float value =
+        std::round(tensor_pb.data(i) / quantized_pb->scale(i % num_scale));
+    (*data)[i] = static_cast<char>(
+        static_cast<int8_t>(std::max(-127.0f, std::min(127.0f, value))));
+  }
+  return true;
+}
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
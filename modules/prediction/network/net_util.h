@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,12 @@ namespace apollo {
 namespace prediction {
 namespace network {
 
+/**
+ * @brief int8 weights of a quantized layer
+ */
+using QuantizedMatrix =
+    Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic>;
+
 /**
  * @brief sigmoid function:
  *        f(x) = 1 / (1 + exp(-x))
@@ -109,6 +116,35 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector);
 bool LoadTensor(const TensorParameter& tensor_pb,
                 std::vector<Eigen::MatrixXf>* const tensor3d);
 
+/**
+ * @brief check if a protobuf message stores int8 quantized values,
+ *        LoadTensor dequantizes such a tensor on loading
+ * @param protobuf message in the form of TensorParameter
+ * @return True if the tensor is quantized, otherwise False
+ */
+bool IsQuantizedTensor(const TensorParameter& tensor_pb);
+
+/**
+ * @brief load int8 matrix value and per column scales from a quantized
+ *        protobuf message, real values are matrix(i, j) * scales(j)
+ * @param protobuf message in the form of TensorParameter
+ * @param QuantizedMatrix will be returned
+ * @param Eigen::VectorXf of scales will be returned
+ * @return True if load data successively, otherwise False
+ */
+bool LoadQuantizedTensor(const TensorParameter& tensor_pb,
+                         QuantizedMatrix* matrix, Eigen::VectorXf* scales);
+
+/**
+ * @brief quantize a float tensor to symmetric int8 values with a scale per
+ *        column of a 2-d tensor, or a single scale otherwise
+ * @param protobuf message in the form of TensorParameter
+ * @param quantized protobuf message will be returned
+ * @return True if quantized successively, otherwise False
+ */
+bool QuantizeTensor(const TensorParameter& tensor_pb,
+                    TensorParameter* const quantized_pb);
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
@@ -77,6 +77,37 @@ TEST(NetworkUtil, LoadTensor_test) {
   EXPECT_FLOAT_EQ(mat(1, 1), 4.0);
 }
 
+TEST(NetworkUtil, QuantizeTensor_test) {
+  TensorParameter tensor_pb;
+  TensorParameter quantized_pb;
+  EXPECT_FALSE(QuantizeTensor(tensor_pb, &quantized_pb));
+
+  tensor_pb.add_shape(2);
+  tensor_pb.add_shape(2);
+  for (float value : {1.0f, -0.02f, -0.5f, 0.04f}) {
+    tensor_pb.add_data(value);
+  }
+  EXPECT_TRUE(QuantizeTensor(tensor_pb, &quantized_pb));
+  EXPECT_TRUE(IsQuantizedTensor(quantized_pb));
+  EXPECT_EQ(quantized_pb.data_size(), 0);
+  EXPECT_EQ(quantized_pb.scale_size(), 2);
+  EXPECT_FALSE(QuantizeTensor(quantized_pb, &tensor_pb));
+
+  Eigen::MatrixXf mat;
+  EXPECT_TRUE(LoadTensor(quantized_pb, &mat));
+  EXPECT_NEAR(mat(0, 0), 1.0, 1e-2);
+  EXPECT_NEAR(mat(0, 1), -0.02, 1e-3);
+  EXPECT_NEAR(mat(1, 0), -0.5, 1e-2);
+  EXPECT_NEAR(mat(1, 1), 0.04, 1e-3);
+
+  QuantizedMatrix quantized_mat;
+  Eigen::VectorXf scales;
+  EXPECT_TRUE(LoadQuantizedTensor(quantized_pb, &quantized_mat, &scales));
+  EXPECT_EQ(quantized_mat(0, 0), 127);
+  EXPECT_EQ(quantized_mat(1, 1), 127);
+  EXPECT_FLOAT_EQ(scales(1), 0.04f / 127.0f);
+}
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @brief Quantize the weights of a network model to int8 and check the
+ *        accuracy of the quantized model against the float one
+ * @param input_model_file: float model, e.g. cruise_go_vehicle_model.bin
+ * @param output_model_file: quantized model to write
+ * @param feature_file: ListDataForLearning recorded in offline mode 2
+ */
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/prediction/network/cruise_model/cruise_model.h"
+#include "modules/prediction/network/net_util.h"
+#include "modules/prediction/proto/cruise_model.pb.h"
+#include "modules/prediction/proto/network_model.pb.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
+DEFINE_string(input_model_file, "", "Float model file to quantize.");
+DEFINE_string(output_model_file, "", "Quantized model file to write.");
+DEFINE_string(model_type, "cruise",
+              "cruise for a CruiseModelParameter, net for a NetParameter.");
+DEFINE_string(feature_file, "",
+              "ListDataForLearning of recorded features for the accuracy "
+              "check, random features are used if empty.");
+DEFINE_int32(num_check_samples, 1000,
+             "Max number of samples in the accuracy check.");
+DEFINE_int32(obstacle_feature_size, 23 + 5 * 9,
+             "Size of the obstacle features of the cruise model.");
+DEFINE_int32(interaction_feature_size, 8,
+             "Size of the interaction features of the cruise model.");
+DEFINE_int32(single_lane_feature_size, 4,
+             "Size of the features of one lane point of the cruise model.");
+DEFINE_int32(lane_points_size, 20,
+             "Number of lane points of the cruise model.");
+
+namespace apollo {
+namespace prediction {
+
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::SetProtoToBinaryFile;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+// Quantize every weight tensor in place, biases and other 1-d tensors stay
+// float as they are small and cheap to keep exact.
+int QuantizeTensors(Message* message) {
+  if (message->GetDescriptor() == TensorParameter::descriptor()) {
+    auto* tensor_pb = static_cast<TensorParameter*>(message);
+    TensorParameter quantized_pb;
+    if (tensor_pb->shape_size() < 2 ||
+        !network::QuantizeTensor(*tensor_pb, &quantized_pb)) {
+      return 0;
+    }
+    tensor_pb->Swap(&quantized_pb);
+    return 1;
+  }
+  if (message->GetDescriptor() == VerificationSample::descriptor()) {
+    return 0;
+  }
+  const Reflection* reflection = message->GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(*message, &fields);
+  int num_quantized = 0;
+  for (const FieldDescriptor* field : fields) {
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      for (int i = 0; i < reflection->FieldSize(*message, field); ++i) {
+        num_quantized += QuantizeTensors(
+            reflection->MutableRepeatedMessage(message, field, i));
+      }
+    } else {
+      num_quantized +=
+          QuantizeTensors(reflection->MutableMessage(message, field));
+    }
+  }
+  return num_quantized;
+}
+
+void LoadCheckSamples(std::vector<Eigen::MatrixXf>* lane_features,
+                      std::vector<Eigen::MatrixXf>* obs_features) {
+  const int lane_offset =
+      FLAGS_obstacle_feature_size + FLAGS_interaction_feature_size;
+  const int feature_size =
+      lane_offset + FLAGS_single_lane_feature_size * FLAGS_lane_points_size;
+  ListDataForLearning list_data;
+  if (!FLAGS_feature_file.empty() &&
+      !GetProtoFromFile(FLAGS_feature_file, &list_data)) {
+    AERROR << "Unable to load feature file: " << FLAGS_feature_file;
+  }
+  for (const auto& data : list_data.data_for_learning()) {
+    if (static_cast<int>(lane_features->size()) >= FLAGS_num_check_samples) {
+      break;
+    }
+    if (data.features_for_learning_size() != feature_size) {
+      continue;
+    }
+    Eigen::MatrixXf obs_feature(1, FLAGS_obstacle_feature_size);
+    for (int i = 0; i < FLAGS_obstacle_feature_size; ++i) {
+      obs_feature(0, i) = static_cast<float>(data.features_for_learning(i));
+    }
+    Eigen::MatrixXf lane_feature(FLAGS_single_lane_feature_size,
+                                 FLAGS_lane_points_size);
+    int index = lane_offset;
+    for (int i = 0; i < FLAGS_single_lane_feature_size; ++i) {
+      for (int j = 0; j < FLAGS_lane_points_size; ++j) {
+        lane_feature(i, j) =
+            static_cast<float>(data.features_for_learning(index++));
+      }
+    }
+    obs_features->push_back(obs_feature);
+    lane_features->push_back(lane_feature);
+  }
+  if (!lane_features->empty()) {
+    return;
+  }
+
+  AWARN << "No recorded features, check accuracy on random features.";
+  std::mt19937 generator(0);
+  std::normal_distribution<float> distribution(0.0f, 1.0f);
+  auto random = [&](float) { return distribution(generator); };
+  for (int k = 0; k < FLAGS_num_check_samples; ++k) {
+    obs_features->push_back(
+        Eigen::MatrixXf(1, FLAGS_obstacle_feature_size).unaryExpr(random));
+    lane_features->push_back(
+        Eigen::MatrixXf(FLAGS_single_lane_feature_size,
+                        FLAGS_lane_points_size)
+            .unaryExpr(random));
+  }
+}
+
+void CheckCruiseModelAccuracy(const CruiseModelParameter& float_param,
+                              const CruiseModelParameter& quantized_param) {
+  network::CruiseModel float_model;
+  network::CruiseModel quantized_model;
+  float_model.LoadModel(float_param);
+  quantized_model.LoadModel(quantized_param);
+
+  std::vector<Eigen::MatrixXf> lane_features;
+  std::vector<Eigen::MatrixXf> obs_features;
+  LoadCheckSamples(&lane_features, &obs_features);
+
+  float max_probability_error = 0.0f;
+  float sum_probability_error = 0.0f;
+  float max_time_error = 0.0f;
+  int num_flipped = 0;
+  for (size_t i = 0; i < lane_features.size(); ++i) {
+    Eigen::MatrixXf float_output;
+    Eigen::MatrixXf quantized_output;
+    float_model.Run({lane_features[i], obs_features[i]}, &float_output);
+    quantized_model.Run({lane_features[i], obs_features[i]},
+                        &quantized_output);
+    const float probability_error =
+        std::abs(float_output(0, 0) - quantized_output(0, 0));
+    max_probability_error = std::max(max_probability_error, probability_error);
+    sum_probability_error += probability_error;
+    max_time_error = std::max(
+        max_time_error, std::abs(float_output(0, 1) - quantized_output(0, 1)));
+    if ((float_output(0, 0) >= 0.5f) != (quantized_output(0, 0) >= 0.5f)) {
+      ++num_flipped;
+    }
+  }
+  AINFO << "Checked " << lane_features.size() << " samples"
+        << ", max probability error: " << max_probability_error
+        << ", mean probability error: "
+        << sum_probability_error /
+               static_cast<float>(std::max<size_t>(lane_features.size(), 1))
+        << ", max time to center error: " << max_time_error
+        << ", flipped decisions: " << num_flipped;
+}
+
+template <typename ModelParameter>
+bool QuantizeModelFile(ModelParameter* quantized_param) {
+  if (!GetProtoFromFile(FLAGS_input_model_file, quantized_param)) {
+    AERROR << "Unable to load model file: " << FLAGS_input_model_file;
+    return false;
+  }
+  const size_t float_size = quantized_param->ByteSizeLong();
+  const int num_quantized = QuantizeTensors(quantized_param);
+  AINFO << "Quantized " << num_quantized << " tensors, model size "
+        << float_size << " -> " << quantized_param->ByteSizeLong() << " bytes";
+  if (!SetProtoToBinaryFile(*quantized_param, FLAGS_output_model_file)) {
+    AERROR << "Unable to write model file: " << FLAGS_output_model_file;
+    return false;
+  }
+  return true;
+}
+
+bool Run() {
+  if (FLAGS_model_type == "cruise") {
+    CruiseModelParameter quantized_param;
+    if (!QuantizeModelFile(&quantized_param)) {
+      return false;
+    }
+    CruiseModelParameter float_param;
+    GetProtoFromFile(FLAGS_input_model_file, &float_param);
+    CheckCruiseModelAccuracy(float_param, quantized_param);
+    return true;
+  }
+  if (FLAGS_model_type == "net") {
+    NetParameter quantized_param;
+    return QuantizeModelFile(&quantized_param);
+  }
+  AERROR << "Unknown model type: " << FLAGS_model_type;
+  return false;
+}
+
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::prediction::Run() ? 0 : 1;
+}
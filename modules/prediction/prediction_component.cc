@@ -23,6 +23,7 @@
 #include "cyber/record/record_reader.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/util/message_util.h"
+#include "modules/common/util/trace_util.h"
 
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/junction_analyzer.h"
@@ -95,6 +96,9 @@ bool PredictionComponent::Proc(
     ADEBUG << "Prediction finished running in test mode";
   }
 
+  // Traces the published obstacles back to the perception sensor frame.
+  common::util::TraceScope trace_scope(perception_obstacles->header());
+
   // Update relative map if needed
   // AdapterManager::Observe();
   if (FLAGS_use_navigation_mode && !PredictionMap::Ready()) {
@@ -16,6 +16,10 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/task/task.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
@@ -138,84 +142,152 @@ void PredictorManager::Run() {
           AdapterConfig::PLANNING_TRAJECTORY);
 
   CHECK_NOTNULL(obstacles_container);
+  std::vector<Obstacle*> obstacles;
+  std::vector<PerceptionObstacle> perception_obstacles;
   for (const int id : obstacles_container->curr_frame_obstacle_ids()) {
     if (id < 0) {
       ADEBUG << "The obstacle has invalid id [" << id << "].";
       continue;
     }
-
-    PredictionObstacle prediction_obstacle;
-    Obstacle* obstacle = obstacles_container->GetObstacle(id);
-
-    PerceptionObstacle perception_obstacle =
-        obstacles_container->GetPerceptionObstacle(id);
     // if obstacle == nullptr, that means obstacle is not predictable
     // Checkout the logic of non-predictable in obstacle.cc
-    if (obstacle != nullptr) {
-      PredictObstacle(obstacle, &prediction_obstacle, adc_trajectory_container);
+    obstacles.push_back(obstacles_container->GetObstacle(id));
+    perception_obstacles.push_back(
+        obstacles_container->GetPerceptionObstacle(id));
+  }
+
+  // The offline modes write results into shared FeatureOutput buffers, so
+  // they always run on the calling thread.
+  size_t num_workers = 1;
+  if (FLAGS_enable_multi_thread_prediction &&
+      FLAGS_prediction_offline_mode == 0) {
+    num_workers = std::min(
+        obstacles.size(),
+        static_cast<size_t>(std::max(FLAGS_max_num_prediction_threads, 1)));
+    num_workers = std::max(num_workers, static_cast<size_t>(1));
+  }
+  if (worker_predictors_.size() + 1 < num_workers) {
+    worker_predictors_.resize(num_workers - 1);
+  }
+
+  std::vector<PredictionObstacle> prediction_obstacles(obstacles.size());
+  std::vector<PredictorTimings> timings(num_workers);
+  auto predict = [&](const size_t worker_index, const size_t i) {
+    PredictionObstacle* prediction_obstacle = &prediction_obstacles[i];
+    if (obstacles[i] != nullptr) {
+      PredictObstacleOnWorker(worker_index, obstacles[i], prediction_obstacle,
+                              adc_trajectory_container, &timings[worker_index]);
     } else {  // obstacle == nullptr
-      prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-      prediction_obstacle.set_is_static(true);
+      prediction_obstacle->set_timestamp(perception_obstacles[i].timestamp());
+      prediction_obstacle->set_is_static(true);
     }
-
-    prediction_obstacle.set_predicted_period(
+    prediction_obstacle->set_predicted_period(
         FLAGS_prediction_trajectory_time_length);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
-        perception_obstacle);
+    prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
+        perception_obstacles[i]);
+  };
+
+  if (num_workers == 1) {
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      predict(0, i);
+    }
+  } else {
+    // Every worker predicts a contiguous range of obstacles with its own
+    // predictors into its own slots, so the output keeps the obstacle order.
+    const size_t num_per_worker =
+        (obstacles.size() + num_workers - 1) / num_workers;
+    cyber::ParallelFor(0, num_workers, 1, [&](const size_t worker_index) {
+      const size_t begin = worker_index * num_per_worker;
+      const size_t end = std::min(obstacles.size(), begin + num_per_worker);
+      for (size_t i = begin; i < end; ++i) {
+        predict(worker_index, i);
+      }
+    });
+  }
+
+  for (auto& prediction_obstacle : prediction_obstacles) {
+    prediction_obstacles_.add_prediction_obstacle()->Swap(
+        &prediction_obstacle);
+  }
 
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
+  PredictorTimings total_timings;
+  for (const auto& worker_timings : timings) {
+    for (const auto& timing : worker_timings) {
+      total_timings[timing.first].time_ms += timing.second.time_ms;
+      total_timings[timing.first].num_obstacles += timing.second.num_obstacles;
+    }
+  }
+  for (const auto& timing : total_timings) {
+    ADEBUG << "Predictor [" << timing.first << "] predicted "
+           << timing.second.num_obstacles << " obstacles in "
+           << timing.second.time_ms << " ms on " << num_workers
+           << " threads.";
   }
 }
 
 void PredictorManager::PredictObstacle(
     Obstacle* obstacle, PredictionObstacle* const prediction_obstacle,
     ADCTrajectoryContainer* adc_trajectory_container) {
+  PredictorTimings timings;
+  PredictObstacleOnWorker(0, obstacle, prediction_obstacle,
+                          adc_trajectory_container, &timings);
+}
+
+void PredictorManager::PredictObstacleOnWorker(
+    const size_t worker_index, Obstacle* obstacle,
+    PredictionObstacle* const prediction_obstacle,
+    ADCTrajectoryContainer* adc_trajectory_container,
+    PredictorTimings* timings) {
   CHECK_NOTNULL(obstacle);
   Predictor* predictor = nullptr;
+  ObstacleConf::PredictorType predictor_type = ObstacleConf::EMPTY_PREDICTOR;
+  const auto select_predictor = [&](const ObstacleConf::PredictorType& type) {
+    predictor_type = type;
+    return GetWorkerPredictor(type, worker_index);
+  };
   prediction_obstacle->set_timestamp(obstacle->timestamp());
   if (obstacle->ToIgnore()) {
     ADEBUG << "Ignore obstacle [" << obstacle->id() << "]";
-    predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
+    predictor = select_predictor(ObstacleConf::EMPTY_PREDICTOR);
     prediction_obstacle->mutable_priority()->set_priority(
         ObstaclePriority::IGNORE);
   } else if (obstacle->IsStill()) {
     ADEBUG << "Still obstacle [" << obstacle->id() << "]";
-    predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
+    predictor = select_predictor(ObstacleConf::EMPTY_PREDICTOR);
   } else {
     switch (obstacle->type()) {
       case PerceptionObstacle::VEHICLE: {
         if (obstacle->HasJunctionFeatureWithExits() &&
             !obstacle->IsCloseToJunctionExit()) {
-          predictor = GetPredictor(vehicle_in_junction_predictor_);
+          predictor = select_predictor(vehicle_in_junction_predictor_);
           CHECK_NOTNULL(predictor);
         } else if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(vehicle_on_lane_predictor_);
+          predictor = select_predictor(vehicle_on_lane_predictor_);
           CHECK_NOTNULL(predictor);
         } else {
-          predictor = GetPredictor(vehicle_off_lane_predictor_);
+          predictor = select_predictor(vehicle_off_lane_predictor_);
           CHECK_NOTNULL(predictor);
         }
         break;
       }
       case PerceptionObstacle::PEDESTRIAN: {
-        predictor = GetPredictor(pedestrian_predictor_);
+        predictor = select_predictor(pedestrian_predictor_);
         break;
       }
       case PerceptionObstacle::BICYCLE: {
         if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(cyclist_on_lane_predictor_);
+          predictor = select_predictor(cyclist_on_lane_predictor_);
           // TODO(kechxu) add a specific predictor in junction
         } else {
-          predictor = GetPredictor(cyclist_off_lane_predictor_);
+          predictor = select_predictor(cyclist_off_lane_predictor_);
         }
         break;
       }
       default: {
         if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(default_on_lane_predictor_);
+          predictor = select_predictor(default_on_lane_predictor_);
         } else {
-          predictor = GetPredictor(default_off_lane_predictor_);
+          predictor = select_predictor(default_off_lane_predictor_);
         }
         break;
       }
@@ -223,6 +295,7 @@ void PredictorManager::PredictObstacle(
   }
 
   if (predictor != nullptr) {
+    const auto start_time = std::chrono::steady_clock::now();
     predictor->Predict(obstacle);
     if (FLAGS_enable_trim_prediction_trajectory &&
         obstacle->type() == PerceptionObstacle::VEHICLE) {
@@ -232,6 +305,11 @@ void PredictorManager::PredictObstacle(
     for (const auto& trajectory : predictor->trajectories()) {
       prediction_obstacle->add_trajectory()->CopyFrom(trajectory);
     }
+    const std::chrono::duration<double, std::milli> diff =
+        std::chrono::steady_clock::now() - start_time;
+    auto& timing = (*timings)[predictor_type];
+    timing.time_ms += diff.count();
+    ++timing.num_obstacles;
   }
   prediction_obstacle->set_timestamp(obstacle->timestamp());
   prediction_obstacle->mutable_priority()->CopyFrom(
@@ -242,6 +320,19 @@ void PredictorManager::PredictObstacle(
   }
 }
 
+Predictor* PredictorManager::GetWorkerPredictor(
+    const ObstacleConf::PredictorType& type, const size_t worker_index) {
+  if (worker_index == 0) {
+    return GetPredictor(type);
+  }
+  auto& predictors = worker_predictors_[worker_index - 1];
+  auto it = predictors.find(type);
+  if (it == predictors.end()) {
+    it = predictors.emplace(type, CreatePredictor(type)).first;
+  }
+  return it->second.get();
+}
+
 std::unique_ptr<Predictor> PredictorManager::CreatePredictor(
     const ObstacleConf::PredictorType& type) {
   std::unique_ptr<Predictor> predictor_ptr(nullptr);
@@ -23,6 +23,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "modules/prediction/predictor/predictor.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -75,6 +77,34 @@ class PredictorManager {
   const PredictionObstacles& prediction_obstacles();
 
  private:
+  // Time spent in one predictor during a cycle.
+  struct PredictorTiming {
+    double time_ms = 0.0;
+    int num_obstacles = 0;
+  };
+  using PredictorTimings =
+      std::map<ObstacleConf::PredictorType, PredictorTiming>;
+
+  /**
+   * @brief Predict an obstacle with the predictor instances of a worker
+   * @param Worker index, 0 is the calling thread
+   * @param A pointer to the specific obstacle
+   * @param A pointer to prediction_obstacle
+   * @param A pointer to adc_trajectory_container
+   * @param Timings of the worker to add to
+   */
+  void PredictObstacleOnWorker(const size_t worker_index, Obstacle* obstacle,
+                               PredictionObstacle* const prediction_obstacle,
+                               ADCTrajectoryContainer* adc_trajectory_container,
+                               PredictorTimings* timings);
+
+  /**
+   * @brief Get the predictor of a worker, created on first use for workers
+   * other than 0 which uses the registered predictors
+   */
+  Predictor* GetWorkerPredictor(const ObstacleConf::PredictorType& type,
+                                const size_t worker_index);
+
   /**
    * @brief Register a predictor by type
    * @param Predictor type
@@ -97,6 +127,12 @@ class PredictorManager {
  private:
   std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>> predictors_;
 
+  // Predictors of the workers 1 to N - 1 in multi-thread prediction, so that
+  // no predictor instance is shared by two threads.
+  std::vector<
+      std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>>>
+      worker_predictors_;
+
   ObstacleConf::PredictorType vehicle_on_lane_predictor_ =
       ObstacleConf::LANE_SEQUENCE_PREDICTOR;
 
@@ -30,5 +30,26 @@ DEFINE_double(min_length_for_lane_change, 1.0,
 DEFINE_bool(enable_change_lane_in_result, true,
             "contain change lane operator in result");
 
+DEFINE_int32(routing_num_landmarks, 16,
+             "number of landmarks topo_creator stores with the graph for the "
+             "A* landmark heuristic, 0 to store none");
+
+DEFINE_bool(enable_routing_landmark_heuristic, true,
+            "bound the A* search with the landmarks of the graph if it has "
+            "them, instead of the anchor point distance");
+
+DEFINE_bool(enable_routing_compact_graph, true,
+            "memory map the compact graph topo_creator writes next to the "
+            "routing map instead of parsing the routing map, if it is not "
+            "older than the routing map");
+
+DEFINE_int32(routing_result_cache_size, 128,
+             "number of routing results the navigator keeps for repeated "
+             "requests, 0 to disable the cache");
+
+DEFINE_double(routing_result_cache_start_s_bucket, 5.0,
+              "meters, requests starting within the same bucket of s on the "
+              "same lane share a cached routing result");
+
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
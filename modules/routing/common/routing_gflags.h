@@ -23,4 +23,9 @@ DECLARE_string(routing_node_name);
 
 DECLARE_double(min_length_for_lane_change);
 DECLARE_bool(enable_change_lane_in_result);
+DECLARE_int32(routing_num_landmarks);
+DECLARE_bool(enable_routing_landmark_heuristic);
+DECLARE_bool(enable_routing_compact_graph);
+DECLARE_int32(routing_result_cache_size);
+DECLARE_double(routing_result_cache_start_s_bucket);
 DECLARE_uint32(routing_response_history_interval_ms);
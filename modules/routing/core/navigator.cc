@@ -16,6 +16,10 @@
 
 #include "modules/routing/core/navigator.h"
 
+#include <sys/stat.h>
+
+#include <cmath>
+
 #include "cyber/common/file.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -28,6 +32,37 @@ namespace {
 
 using common::ErrorCode;
 
+// the compact graph is only used when topo_creator wrote it with or after
+// the routing map
+bool IsCompactGraphUpToDate(const std::string& topo_file_path,
+                            const std::string& compact_file_path) {
+  struct stat topo_stat;
+  struct stat compact_stat;
+  return stat(topo_file_path.c_str(), &topo_stat) == 0 &&
+         stat(compact_file_path.c_str(), &compact_stat) == 0 &&
+         compact_stat.st_mtime >= topo_stat.st_mtime;
+}
+
+bool LoadTopoGraph(const std::string& topo_file_path, TopoGraph* topo_graph) {
+  const std::string compact_file_path =
+      CompactTopoGraph::FilePath(topo_file_path);
+  if (FLAGS_enable_routing_compact_graph &&
+      IsCompactGraphUpToDate(topo_file_path, compact_file_path)) {
+    if (topo_graph->LoadCompactGraph(compact_file_path, true)) {
+      AINFO << "Use compact topology graph " << compact_file_path;
+      return true;
+    }
+    AWARN << "Failed to load compact topology graph " << compact_file_path
+          << ", fall back to " << topo_file_path;
+  }
+  Graph graph;
+  if (!cyber::common::GetProtoFromFile(topo_file_path, &graph)) {
+    AERROR << "Failed to read topology graph from " << topo_file_path;
+    return false;
+  }
+  return topo_graph->LoadGraph(graph);
+}
+
 bool ShowRequestInfo(const RoutingRequest& request, const TopoGraph* graph) {
   for (const auto& wp : request.waypoint()) {
     const auto* node = graph->GetNode(wp.id());
@@ -81,6 +116,31 @@ void SetErrorCode(const common::ErrorCode& error_code_id,
   }
 }
 
+// The waypoints and the blacklist of a request. The start s is rounded down
+// to a bucket so that rerouting from a bit further along the same lane
+// shares the result.
+std::string ResultCacheKey(const RoutingRequest& request) {
+  std::string key;
+  for (int i = 0; i < request.waypoint_size(); ++i) {
+    const auto& waypoint = request.waypoint(i);
+    double s = waypoint.s();
+    if (i == 0 && FLAGS_routing_result_cache_start_s_bucket > 0.0) {
+      s = std::floor(s / FLAGS_routing_result_cache_start_s_bucket);
+    }
+    key += waypoint.id() + "@" + std::to_string(s) + ";";
+  }
+  key += "|";
+  for (const auto& lane : request.blacklisted_lane()) {
+    key += lane.id() + "@" + std::to_string(lane.start_s()) + "," +
+           std::to_string(lane.end_s()) + ";";
+  }
+  key += "|";
+  for (const auto& road_id : request.blacklisted_road()) {
+    key += road_id + ";";
+  }
+  return key;
+}
+
 void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
   AINFO << "Route lane id\tis virtual\tstart s\tend s";
   for (const auto& node : nodes) {
@@ -93,20 +153,19 @@ void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
 }  // namespace
 
 Navigator::Navigator(const std::string& topo_file_path) {
-  Graph graph;
-  if (!cyber::common::GetProtoFromFile(topo_file_path, &graph)) {
-    AERROR << "Failed to read topology graph from " << topo_file_path;
-    return;
-  }
-
   graph_.reset(new TopoGraph());
-  if (!graph_->LoadGraph(graph)) {
+  if (!LoadTopoGraph(topo_file_path, graph_.get())) {
     AINFO << "Failed to init navigator graph failed! File path: "
           << topo_file_path;
     return;
   }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
+  if (FLAGS_routing_result_cache_size > 0) {
+    result_cache_.reset(
+        new common::util::LRUCache<std::string, std::vector<NodeWithRange>>(
+            FLAGS_routing_result_cache_size));
+  }
   is_ready_ = true;
   AINFO << "The navigator is ready.";
 }
@@ -149,6 +208,37 @@ bool Navigator::MergeRoute(
   return true;
 }
 
+bool Navigator::GetCachedRoute(
+    const RoutingRequest& request, const std::string& key,
+    std::vector<NodeWithRange>* const result_nodes) {
+  if (result_cache_ == nullptr) {
+    return false;
+  }
+  ++num_cache_queries_;
+  const auto* cached_nodes = result_cache_->Get(key);
+  // the cached route starts on the first lane a bit before the start s it
+  // was searched for, it still holds for a start s further along that range
+  const double start_s = request.waypoint(0).s();
+  if (cached_nodes == nullptr || cached_nodes->empty() ||
+      start_s < cached_nodes->front().StartS() ||
+      start_s >= cached_nodes->front().EndS()) {
+    return false;
+  }
+  *result_nodes = *cached_nodes;
+  ++num_cache_hits_;
+  ADEBUG << "Use cached routing result, cache hit rate: "
+         << ResultCacheHitRate();
+  return true;
+}
+
+double Navigator::ResultCacheHitRate() const {
+  if (num_cache_queries_ == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(num_cache_hits_) /
+         static_cast<double>(num_cache_queries_);
+}
+
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
     const std::vector<double>& way_s,
@@ -224,11 +314,19 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   }
 
   std::vector<NodeWithRange> result_nodes;
-  if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s, &result_nodes)) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
-                 "Failed to find route with request!",
-                 response->mutable_status());
-    return false;
+  const std::string cache_key =
+      result_cache_ == nullptr ? std::string() : ResultCacheKey(request);
+  if (!GetCachedRoute(request, cache_key, &result_nodes)) {
+    if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s,
+                               &result_nodes)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to find route with request!",
+                   response->mutable_status());
+      return false;
+    }
+    if (result_cache_ != nullptr && !result_nodes.empty()) {
+      result_cache_->Put(cache_key, result_nodes);
+    }
   }
   if (result_nodes.empty()) {
     SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE, "Failed to result nodes!",
@@ -249,6 +347,9 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   SetErrorCode(ErrorCode::OK, "Success!", response->mutable_status());
 
   PrintDebugData(result_nodes);
+  if (result_cache_ != nullptr) {
+    AINFO << "Routing result cache hit rate: " << ResultCacheHitRate();
+  }
   return true;
 }
 
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "modules/common/util/lru_cache.h"
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
 
@@ -36,6 +37,9 @@ class Navigator {
   bool SearchRoute(const RoutingRequest& request,
                    RoutingResponse* const response);
 
+  // share of the requests answered from the routing result cache
+  double ResultCacheHitRate() const;
+
  private:
   bool Init(const RoutingRequest& request, const TopoGraph* graph,
             std::vector<const TopoNode*>* const way_nodes,
@@ -51,6 +55,9 @@ class Navigator {
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
 
+  bool GetCachedRoute(const RoutingRequest& request, const std::string& key,
+                      std::vector<NodeWithRange>* const result_nodes);
+
  private:
   bool is_ready_ = false;
   std::unique_ptr<TopoGraph> graph_;
@@ -59,6 +66,13 @@ class Navigator {
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+
+  // merged result nodes of recent requests by their cache key
+  std::unique_ptr<
+      common::util::LRUCache<std::string, std::vector<NodeWithRange>>>
+      result_cache_;
+  uint64_t num_cache_queries_ = 0;
+  uint64_t num_cache_hits_ = 0;
 };
 
 }  // namespace routing
@@ -0,0 +1,510 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/compact_topo_graph.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'T', 'C', 'S', 'R', '0', '0', '1'};
+constexpr size_t kAlignment = 8;
+
+// Every section is its size in bytes followed by the data, padded so that
+// the next section starts aligned.
+class SectionWriter {
+ public:
+  explicit SectionWriter(std::vector<char>* buffer) : buffer_(buffer) {}
+
+  void AppendRaw(const void* data, size_t bytes) {
+    const char* begin = static_cast<const char*>(data);
+    buffer_->insert(buffer_->end(), begin, begin + bytes);
+    buffer_->resize((buffer_->size() + kAlignment - 1) / kAlignment *
+                    kAlignment);
+  }
+
+  template <typename T>
+  void Append(const std::vector<T>& values) {
+    const uint64_t bytes = values.size() * sizeof(T);
+    AppendRaw(&bytes, sizeof(bytes));
+    AppendRaw(values.data(), bytes);
+  }
+
+ private:
+  std::vector<char>* buffer_;
+};
+
+class SectionReader {
+ public:
+  SectionReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  const void* ReadRaw(size_t bytes) {
+    if (bytes > size_ - pos_) {
+      return nullptr;
+    }
+    const void* begin = data_ + pos_;
+    pos_ = std::min(size_, (pos_ + bytes + kAlignment - 1) / kAlignment *
+                               kAlignment);
+    return begin;
+  }
+
+  template <typename T>
+  bool Read(const T** values, uint64_t* count) {
+    const auto* bytes = static_cast<const uint64_t*>(ReadRaw(sizeof(uint64_t)));
+    if (bytes == nullptr || *bytes % sizeof(T) != 0) {
+      return false;
+    }
+    *values = static_cast<const T*>(ReadRaw(*bytes));
+    *count = *bytes / sizeof(T);
+    return *values != nullptr;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+bool IsValidOffsets(const uint32_t* offsets, uint64_t size, uint64_t total) {
+  if (offsets[0] != 0 || offsets[size - 1] != total) {
+    return false;
+  }
+  for (uint64_t i = 1; i < size; ++i) {
+    if (offsets[i] < offsets[i - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsValidIndices(const uint32_t* indices, uint64_t size, uint32_t bound) {
+  return std::all_of(indices, indices + size,
+                     [bound](const uint32_t index) { return index < bound; });
+}
+
+void AppendRanges(const google::protobuf::RepeatedPtrField<CurveRange>& ranges,
+                  std::vector<uint32_t>* offsets,
+                  std::vector<CompactTopoGraph::Range>* out_ranges) {
+  for (const auto& range : ranges) {
+    out_ranges->push_back({range.start().s(), range.end().s()});
+  }
+  offsets->push_back(static_cast<uint32_t>(out_ranges->size()));
+}
+
+}  // namespace
+
+bool CompactTopoGraph::SampleCentralCurve(const hdmap::Curve& curve,
+                                          Point* samples) {
+  int total_size = 0;
+  for (const auto& seg : curve.segment()) {
+    total_size += seg.line_segment().point_size();
+  }
+  if (total_size == 0) {
+    return false;
+  }
+  // the same middle point TopoNode always took as the anchor point
+  int anchor_index = static_cast<int>(total_size * 0.5);
+  int index = 0;
+  for (const auto& seg : curve.segment()) {
+    for (const auto& point : seg.line_segment().point()) {
+      const Point sample = {point.x(), point.y(), point.z()};
+      if (index == 0) {
+        samples[0] = sample;
+      }
+      if (index == anchor_index) {
+        samples[1] = sample;
+      }
+      samples[2] = sample;
+      ++index;
+    }
+  }
+  return true;
+}
+
+std::string CompactTopoGraph::FilePath(const std::string& routing_map_file) {
+  const auto slash_pos = routing_map_file.find_last_of('/');
+  const auto dot_pos = routing_map_file.find_last_of('.');
+  if (dot_pos == std::string::npos ||
+      (slash_pos != std::string::npos && dot_pos < slash_pos)) {
+    return routing_map_file + ".csr";
+  }
+  return routing_map_file.substr(0, dot_pos) + ".csr";
+}
+
+CompactTopoGraph::~CompactTopoGraph() { Clear(); }
+
+void CompactTopoGraph::Clear() {
+  if (mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  std::vector<char>().swap(buffer_);
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  header_ = {};
+}
+
+bool CompactTopoGraph::Build(const Graph& graph) {
+  Clear();
+  if (graph.node_size() == 0) {
+    AERROR << "No nodes found in topology graph.";
+    return false;
+  }
+  const uint32_t num_nodes = static_cast<uint32_t>(graph.node_size());
+
+  std::unordered_map<std::string, uint32_t> node_index_map;
+  std::map<std::string, std::vector<uint32_t>> road_nodes_map;
+  for (uint32_t i = 0; i < num_nodes; ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+    road_nodes_map[graph.node(i).road_id()].push_back(i);
+  }
+
+  std::vector<uint32_t> edge_from;
+  std::vector<uint32_t> out_offsets(num_nodes + 1, 0);
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    if (from_iter == node_index_map.end() ||
+        node_index_map.count(edge.to_lane_id()) == 0) {
+      AERROR << "Edge " << edge.from_lane_id() << " -> " << edge.to_lane_id()
+             << " has no nodes in the topology graph.";
+      return false;
+    }
+    edge_from.push_back(from_iter->second);
+    ++out_offsets[from_iter->second + 1];
+  }
+  std::partial_sum(out_offsets.begin(), out_offsets.end(),
+                   out_offsets.begin());
+  const uint32_t num_edges = static_cast<uint32_t>(graph.edge_size());
+  std::vector<uint32_t> edge_to(num_edges);
+  std::vector<double> edge_cost(num_edges);
+  std::vector<uint32_t> edge_direction(num_edges);
+  std::vector<uint32_t> next_edge(out_offsets.begin(), out_offsets.end() - 1);
+  for (uint32_t i = 0; i < num_edges; ++i) {
+    const auto& edge = graph.edge(i);
+    const uint32_t index = next_edge[edge_from[i]]++;
+    edge_to[index] = node_index_map[edge.to_lane_id()];
+    edge_cost[index] = edge.cost();
+    edge_direction[index] = static_cast<uint32_t>(edge.direction_type());
+  }
+
+  std::vector<char> strings;
+  std::vector<uint32_t> string_offsets = {0};
+  auto add_string = [&strings, &string_offsets](const std::string& str) {
+    strings.insert(strings.end(), str.begin(), str.end());
+    string_offsets.push_back(static_cast<uint32_t>(strings.size()));
+  };
+  add_string(graph.hdmap_version());
+  add_string(graph.hdmap_district());
+  for (const auto& node : graph.node()) {
+    add_string(node.lane_id());
+  }
+  std::vector<uint32_t> node_road(num_nodes);
+  std::vector<uint32_t> road_offsets = {0};
+  std::vector<uint32_t> road_nodes;
+  for (const auto& road : road_nodes_map) {
+    add_string(road.first);
+    for (const uint32_t node : road.second) {
+      node_road[node] = static_cast<uint32_t>(road_offsets.size() - 1);
+      road_nodes.push_back(node);
+    }
+    road_offsets.push_back(static_cast<uint32_t>(road_nodes.size()));
+  }
+
+  std::vector<uint32_t> lane_order(num_nodes);
+  std::iota(lane_order.begin(), lane_order.end(), 0);
+  std::stable_sort(lane_order.begin(), lane_order.end(),
+                   [&graph](const uint32_t a, const uint32_t b) {
+                     return graph.node(a).lane_id() < graph.node(b).lane_id();
+                   });
+
+  std::vector<double> node_length;
+  std::vector<double> node_cost;
+  std::vector<uint32_t> node_flags;
+  std::vector<Point> curve_samples(num_nodes * kNumCurveSamples,
+                                   Point{0.0, 0.0, 0.0});
+  std::vector<uint32_t> left_offsets = {0};
+  std::vector<Range> left_ranges;
+  std::vector<uint32_t> right_offsets = {0};
+  std::vector<Range> right_ranges;
+  for (uint32_t i = 0; i < num_nodes; ++i) {
+    const auto& node = graph.node(i);
+    node_length.push_back(node.length());
+    node_cost.push_back(node.cost());
+    uint32_t flags = node.is_virtual() ? kVirtual : 0;
+    if (SampleCentralCurve(node.central_curve(),
+                           &curve_samples[i * kNumCurveSamples])) {
+      flags |= kHasCurve;
+    }
+    node_flags.push_back(flags);
+    AppendRanges(node.left_out(), &left_offsets, &left_ranges);
+    AppendRanges(node.right_out(), &right_offsets, &right_ranges);
+  }
+
+  uint32_t num_landmarks = static_cast<uint32_t>(graph.landmark_size());
+  for (const auto& landmark : graph.landmark()) {
+    if (landmark.forward_cost_size() != graph.node_size() ||
+        landmark.backward_cost_size() != graph.node_size()) {
+      AERROR << "Landmark " << landmark.lane_id()
+             << " doesn't match the graph nodes, ignore all landmarks.";
+      num_landmarks = 0;
+      break;
+    }
+  }
+  std::vector<float> landmark_forward(num_nodes * num_landmarks);
+  std::vector<float> landmark_backward(num_nodes * num_landmarks);
+  for (uint32_t k = 0; k < num_landmarks; ++k) {
+    const auto& landmark = graph.landmark(k);
+    for (uint32_t i = 0; i < num_nodes; ++i) {
+      landmark_forward[i * num_landmarks + k] = landmark.forward_cost(i);
+      landmark_backward[i * num_landmarks + k] = landmark.backward_cost(i);
+    }
+  }
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.num_nodes = num_nodes;
+  header.num_edges = num_edges;
+  header.num_roads = static_cast<uint32_t>(road_nodes_map.size());
+  header.num_landmarks = num_landmarks;
+
+  SectionWriter writer(&buffer_);
+  writer.AppendRaw(&header, sizeof(header));
+  writer.Append(strings);
+  writer.Append(string_offsets);
+  writer.Append(lane_order);
+  writer.Append(node_length);
+  writer.Append(node_cost);
+  writer.Append(node_flags);
+  writer.Append(node_road);
+  writer.Append(curve_samples);
+  writer.Append(left_offsets);
+  writer.Append(left_ranges);
+  writer.Append(right_offsets);
+  writer.Append(right_ranges);
+  writer.Append(out_offsets);
+  writer.Append(edge_to);
+  writer.Append(edge_cost);
+  writer.Append(edge_direction);
+  writer.Append(road_offsets);
+  writer.Append(road_nodes);
+  writer.Append(landmark_forward);
+  writer.Append(landmark_backward);
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  if (!Parse()) {
+    AERROR << "Failed to build the compact topology graph.";
+    Clear();
+    return false;
+  }
+  return true;
+}
+
+bool CompactTopoGraph::Parse() {
+  SectionReader reader(data_, size_);
+  const void* header = reader.ReadRaw(sizeof(Header));
+  if (header == nullptr) {
+    return false;
+  }
+  std::memcpy(&header_, header, sizeof(Header));
+  auto read = [&reader](auto* array) {
+    return reader.Read(&array->data, &array->size);
+  };
+  if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+      !read(&strings_) || !read(&string_offsets_) || !read(&lane_order_) ||
+      !read(&node_length_) || !read(&node_cost_) || !read(&node_flags_) ||
+      !read(&node_road_) || !read(&curve_samples_) || !read(&left_offsets_) ||
+      !read(&left_ranges_) || !read(&right_offsets_) ||
+      !read(&right_ranges_) || !read(&out_offsets_) || !read(&edge_to_) ||
+      !read(&edge_cost_) || !read(&edge_direction_) ||
+      !read(&road_offsets_) || !read(&road_nodes_) ||
+      !read(&landmark_forward_) || !read(&landmark_backward_) ||
+      !reader.AtEnd()) {
+    header_ = {};
+    return false;
+  }
+
+  const uint64_t num_nodes = header_.num_nodes;
+  const uint64_t num_edges = header_.num_edges;
+  const uint64_t num_roads = header_.num_roads;
+  const uint64_t num_costs = num_nodes * header_.num_landmarks;
+  const bool valid =
+      num_nodes > 0 && string_offsets_.size == 2 + num_nodes + num_roads + 1 &&
+      lane_order_.size == num_nodes && node_length_.size == num_nodes &&
+      node_cost_.size == num_nodes && node_flags_.size == num_nodes &&
+      node_road_.size == num_nodes &&
+      curve_samples_.size == num_nodes * kNumCurveSamples &&
+      left_offsets_.size == num_nodes + 1 &&
+      right_offsets_.size == num_nodes + 1 &&
+      out_offsets_.size == num_nodes + 1 && edge_to_.size == num_edges &&
+      edge_cost_.size == num_edges && edge_direction_.size == num_edges &&
+      road_offsets_.size == num_roads + 1 && road_nodes_.size == num_nodes &&
+      landmark_forward_.size == num_costs &&
+      landmark_backward_.size == num_costs &&
+      IsValidOffsets(string_offsets_.data, string_offsets_.size,
+                     strings_.size) &&
+      IsValidOffsets(left_offsets_.data, left_offsets_.size,
+                     left_ranges_.size) &&
+      IsValidOffsets(right_offsets_.data, right_offsets_.size,
+                     right_ranges_.size) &&
+      IsValidOffsets(out_offsets_.data, out_offsets_.size, num_edges) &&
+      IsValidOffsets(road_offsets_.data, road_offsets_.size, num_nodes) &&
+      IsValidIndices(lane_order_.data, num_nodes, header_.num_nodes) &&
+      IsValidIndices(node_road_.data, num_nodes, header_.num_roads) &&
+      IsValidIndices(edge_to_.data, num_edges, header_.num_nodes) &&
+      IsValidIndices(road_nodes_.data, num_nodes, header_.num_nodes);
+  if (!valid) {
+    header_ = {};
+  }
+  return valid;
+}
+
+bool CompactTopoGraph::Save(const std::string& file_path) const {
+  if (data_ == nullptr) {
+    AERROR << "No compact topology graph to save.";
+    return false;
+  }
+  std::ofstream ofs(file_path, std::ios::binary | std::ios::trunc);
+  ofs.write(data_, size_);
+  if (!ofs) {
+    AERROR << "Failed to write compact topology graph " << file_path;
+    return false;
+  }
+  return true;
+}
+
+bool CompactTopoGraph::Load(const std::string& file_path, bool use_mmap) {
+  Clear();
+  const int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Open file failed, file: " << file_path << ", errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(Header)) {
+    AERROR << "Stat file failed or file too small, file: " << file_path;
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  if (use_mmap) {
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+      AERROR << "Mmap file failed, file: " << file_path << ", errno: " << errno;
+      return false;
+    }
+    data_ = static_cast<const char*>(addr);
+    mapped_ = true;
+  } else {
+    buffer_.resize(size);
+    const ssize_t read_size = read(fd, buffer_.data(), size);
+    close(fd);
+    if (read_size != static_cast<ssize_t>(size)) {
+      AERROR << "Read file failed, file: " << file_path;
+      Clear();
+      return false;
+    }
+    data_ = buffer_.data();
+  }
+  size_ = size;
+  if (!Parse()) {
+    AERROR << "Invalid compact topology graph " << file_path;
+    Clear();
+    return false;
+  }
+  return true;
+}
+
+std::string CompactTopoGraph::String(uint32_t id) const {
+  if (string_offsets_.data == nullptr) {
+    return std::string();
+  }
+  const uint32_t begin = string_offsets_.data[id];
+  return std::string(strings_.data + begin,
+                     string_offsets_.data[id + 1] - begin);
+}
+
+int CompactTopoGraph::Compare(uint32_t id, const std::string& str) const {
+  const uint32_t begin = string_offsets_.data[id];
+  const size_t size = string_offsets_.data[id + 1] - begin;
+  const int ret = std::memcmp(strings_.data + begin, str.data(),
+                              std::min(size, str.size()));
+  if (ret != 0) {
+    return ret;
+  }
+  return size < str.size() ? -1 : (size > str.size() ? 1 : 0);
+}
+
+int CompactTopoGraph::NodeIndex(const std::string& lane_id) const {
+  const uint32_t* end = lane_order_.data + header_.num_nodes;
+  const uint32_t* iter = std::lower_bound(
+      lane_order_.data, end, lane_id,
+      [this](const uint32_t node, const std::string& id) {
+        return Compare(LaneString(node), id) < 0;
+      });
+  if (iter == end || Compare(LaneString(*iter), lane_id) != 0) {
+    return -1;
+  }
+  return static_cast<int>(*iter);
+}
+
+void CompactTopoGraph::GetNodesByRoadId(const std::string& road_id,
+                                        std::vector<int>* nodes) const {
+  uint32_t low = 0;
+  uint32_t high = header_.num_roads;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (Compare(RoadString(mid), road_id) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low == header_.num_roads || Compare(RoadString(low), road_id) != 0) {
+    return;
+  }
+  nodes->insert(nodes->end(), road_nodes_.data + road_offsets_.data[low],
+                road_nodes_.data + road_offsets_.data[low + 1]);
+}
+
+std::vector<CompactTopoGraph::Range> CompactTopoGraph::Ranges(
+    const Array<uint32_t>& offsets, const Array<Range>& ranges,
+    int node) const {
+  return std::vector<Range>(ranges.data + offsets.data[node],
+                            ranges.data + offsets.data[node + 1]);
+}
+
+}  // namespace routing
+}  // namespace apollo
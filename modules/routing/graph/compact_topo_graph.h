@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class CompactTopoGraph
+ * @brief Read only topology graph in compressed sparse row form. Nodes are
+ * numbered in the order of the Graph proto and the out edges of node i are
+ * [OutEdgeBegin(i), OutEdgeEnd(i)) of the edge arrays. Everything lives in
+ * one buffer that is either built from a Graph or memory mapped from the
+ * file Save() writes, so loading a precompiled graph is a single mmap.
+ */
+class CompactTopoGraph {
+ public:
+  struct Point {
+    double x;
+    double y;
+    double z;
+  };
+  struct Range {
+    double start_s;
+    double end_s;
+  };
+
+  // samples of a central curve: first point, anchor point and last point
+  static constexpr int kNumCurveSamples = 3;
+
+  /**
+   * @brief Sample the first point, the middle point by point count and the
+   * last point of the curve, false if it has no points.
+   */
+  static bool SampleCentralCurve(const hdmap::Curve& curve, Point* samples);
+
+  /**
+   * @brief Path of the compact graph file topo_creator writes next to the
+   * routing map file.
+   */
+  static std::string FilePath(const std::string& routing_map_file);
+
+  CompactTopoGraph() = default;
+  ~CompactTopoGraph();
+
+  CompactTopoGraph(const CompactTopoGraph&) = delete;
+  CompactTopoGraph& operator=(const CompactTopoGraph&) = delete;
+
+  bool Build(const Graph& graph);
+  bool Save(const std::string& file_path) const;
+  bool Load(const std::string& file_path, bool use_mmap);
+  bool IsMapped() const { return mapped_; }
+
+  std::string MapVersion() const { return String(0); }
+  std::string MapDistrict() const { return String(1); }
+
+  int NumNodes() const { return static_cast<int>(header_.num_nodes); }
+  int NumEdges() const { return static_cast<int>(header_.num_edges); }
+  int NumLandmarks() const { return static_cast<int>(header_.num_landmarks); }
+
+  /**
+   * @brief Index of the node of a lane by binary search, -1 if not found.
+   */
+  int NodeIndex(const std::string& lane_id) const;
+  void GetNodesByRoadId(const std::string& road_id,
+                        std::vector<int>* nodes) const;
+
+  std::string LaneId(int node) const { return String(LaneString(node)); }
+  std::string RoadId(int node) const {
+    return String(RoadString(node_road_.data[node]));
+  }
+  double Length(int node) const { return node_length_.data[node]; }
+  double Cost(int node) const { return node_cost_.data[node]; }
+  bool IsVirtual(int node) const {
+    return (node_flags_.data[node] & kVirtual) != 0;
+  }
+  bool HasCentralCurve(int node) const {
+    return (node_flags_.data[node] & kHasCurve) != 0;
+  }
+  const Point* CurveSamples(int node) const {
+    return curve_samples_.data + node * kNumCurveSamples;
+  }
+  std::vector<Range> LeftOutRanges(int node) const {
+    return Ranges(left_offsets_, left_ranges_, node);
+  }
+  std::vector<Range> RightOutRanges(int node) const {
+    return Ranges(right_offsets_, right_ranges_, node);
+  }
+
+  int OutEdgeBegin(int node) const {
+    return static_cast<int>(out_offsets_.data[node]);
+  }
+  int OutEdgeEnd(int node) const {
+    return static_cast<int>(out_offsets_.data[node + 1]);
+  }
+  int EdgeTo(int edge) const { return static_cast<int>(edge_to_.data[edge]); }
+  double EdgeCost(int edge) const { return edge_cost_.data[edge]; }
+  Edge::DirectionType EdgeDirection(int edge) const {
+    return static_cast<Edge::DirectionType>(edge_direction_.data[edge]);
+  }
+
+  // NumLandmarks() costs of a node, negative if not connected
+  const float* LandmarkForwardCosts(int node) const {
+    return landmark_forward_.data + node * header_.num_landmarks;
+  }
+  const float* LandmarkBackwardCosts(int node) const {
+    return landmark_backward_.data + node * header_.num_landmarks;
+  }
+
+ private:
+  enum NodeFlag : uint32_t {
+    kVirtual = 1,
+    kHasCurve = 2,
+  };
+
+  struct Header {
+    char magic[8];
+    uint32_t num_nodes;
+    uint32_t num_edges;
+    uint32_t num_roads;
+    uint32_t num_landmarks;
+  };
+
+  template <typename T>
+  struct Array {
+    const T* data = nullptr;
+    uint64_t size = 0;
+  };
+
+  void Clear();
+  bool Parse();
+  uint32_t LaneString(int node) const { return 2 + node; }
+  uint32_t RoadString(uint32_t road) const {
+    return 2 + header_.num_nodes + road;
+  }
+  std::string String(uint32_t id) const;
+  int Compare(uint32_t id, const std::string& str) const;
+  std::vector<Range> Ranges(const Array<uint32_t>& offsets,
+                            const Array<Range>& ranges, int node) const;
+
+  // owned buffer of a built or read graph, or the mapped file
+  std::vector<char> buffer_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+
+  Header header_ = {};
+  // version, district, lane ids in node order then road ids in sorted order
+  Array<char> strings_;
+  Array<uint32_t> string_offsets_;
+  // node indices sorted by lane id
+  Array<uint32_t> lane_order_;
+  Array<double> node_length_;
+  Array<double> node_cost_;
+  Array<uint32_t> node_flags_;
+  Array<uint32_t> node_road_;
+  Array<Point> curve_samples_;
+  Array<uint32_t> left_offsets_;
+  Array<Range> left_ranges_;
+  Array<uint32_t> right_offsets_;
+  Array<Range> right_ranges_;
+  Array<uint32_t> out_offsets_;
+  Array<uint32_t> edge_to_;
+  Array<double> edge_cost_;
+  Array<uint32_t> edge_direction_;
+  Array<uint32_t> road_offsets_;
+  Array<uint32_t> road_nodes_;
+  Array<float> landmark_forward_;
+  Array<float> landmark_backward_;
+};
+
+}  // namespace routing
+}  // namespace apollo
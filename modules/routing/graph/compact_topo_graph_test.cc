@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/compact_topo_graph.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr char kTestFile[] = "/tmp/compact_topo_graph_test.csr";
+
+void ExpectGraphForTest(const CompactTopoGraph& graph) {
+  EXPECT_EQ(TEST_MAP_VERSION, graph.MapVersion());
+  EXPECT_EQ(TEST_MAP_DISTRICT, graph.MapDistrict());
+  ASSERT_EQ(4, graph.NumNodes());
+  ASSERT_EQ(6, graph.NumEdges());
+
+  EXPECT_EQ(0, graph.NodeIndex(TEST_L1));
+  EXPECT_EQ(3, graph.NodeIndex(TEST_L4));
+  EXPECT_EQ(-1, graph.NodeIndex(TEST_L5));
+  EXPECT_EQ(TEST_L3, graph.LaneId(2));
+  EXPECT_EQ(TEST_R2, graph.RoadId(2));
+  EXPECT_DOUBLE_EQ(TEST_LANE_LENGTH, graph.Length(1));
+  EXPECT_DOUBLE_EQ(TEST_LANE_COST, graph.Cost(1));
+  EXPECT_TRUE(graph.IsVirtual(1));
+  EXPECT_FALSE(graph.HasCentralCurve(1));
+
+  const auto left_out = graph.LeftOutRanges(0);
+  ASSERT_EQ(1, left_out.size());
+  EXPECT_DOUBLE_EQ(TEST_START_S, left_out[0].start_s);
+  EXPECT_DOUBLE_EQ(TEST_END_S, left_out[0].end_s);
+
+  // out edges of L1 in the order of the graph: right to L2, forward to L3
+  ASSERT_EQ(2, graph.OutEdgeEnd(0) - graph.OutEdgeBegin(0));
+  const int edge = graph.OutEdgeBegin(0);
+  EXPECT_EQ(1, graph.EdgeTo(edge));
+  EXPECT_EQ(Edge::RIGHT, graph.EdgeDirection(edge));
+  EXPECT_EQ(2, graph.EdgeTo(edge + 1));
+  EXPECT_EQ(Edge::FORWARD, graph.EdgeDirection(edge + 1));
+  EXPECT_DOUBLE_EQ(TEST_EDGE_COST, graph.EdgeCost(edge + 1));
+
+  std::vector<int> nodes;
+  graph.GetNodesByRoadId(TEST_R2, &nodes);
+  EXPECT_EQ(std::vector<int>({2, 3}), nodes);
+  graph.GetNodesByRoadId(TEST_R3, &nodes);
+  EXPECT_EQ(2, nodes.size());
+}
+
+}  // namespace
+
+TEST(CompactTopoGraphTest, Build) {
+  Graph graph;
+  GetGraphForTest(&graph);
+  CompactTopoGraph compact_graph;
+  ASSERT_TRUE(compact_graph.Build(graph));
+  EXPECT_FALSE(compact_graph.IsMapped());
+  ExpectGraphForTest(compact_graph);
+  EXPECT_EQ(0, compact_graph.NumLandmarks());
+
+  GetEdgeForTest(graph.add_edge(), TEST_L1, TEST_L5, Edge::FORWARD);
+  EXPECT_FALSE(compact_graph.Build(graph));
+  EXPECT_FALSE(compact_graph.Build(Graph()));
+}
+
+TEST(CompactTopoGraphTest, SaveAndLoad) {
+  Graph graph;
+  GetGraphForTest(&graph);
+  auto* landmark = graph.add_landmark();
+  landmark->set_lane_id(TEST_L1);
+  for (const float cost : {0.0f, 1.0f, 3.0f, -1.0f}) {
+    landmark->add_forward_cost(cost);
+    landmark->add_backward_cost(cost);
+  }
+  CompactTopoGraph built_graph;
+  ASSERT_TRUE(built_graph.Build(graph));
+  ASSERT_TRUE(built_graph.Save(kTestFile));
+
+  for (const bool use_mmap : {true, false}) {
+    CompactTopoGraph loaded_graph;
+    ASSERT_TRUE(loaded_graph.Load(kTestFile, use_mmap));
+    EXPECT_EQ(use_mmap, loaded_graph.IsMapped());
+    ExpectGraphForTest(loaded_graph);
+    ASSERT_EQ(1, loaded_graph.NumLandmarks());
+    EXPECT_FLOAT_EQ(3.0f, loaded_graph.LandmarkForwardCosts(2)[0]);
+    EXPECT_FLOAT_EQ(-1.0f, loaded_graph.LandmarkBackwardCosts(3)[0]);
+  }
+
+  // a truncated file is refused
+  std::ofstream(kTestFile, std::ios::binary | std::ios::trunc) << "RTCSR001";
+  CompactTopoGraph bad_graph;
+  EXPECT_FALSE(bad_graph.Load(kTestFile, true));
+  EXPECT_EQ(0, bad_graph.NumNodes());
+}
+
+TEST(CompactTopoGraphTest, FilePath) {
+  EXPECT_EQ("/apollo/map/routing_map.csr",
+            CompactTopoGraph::FilePath("/apollo/map/routing_map.bin"));
+  EXPECT_EQ("/apollo/map.v1/routing_map.csr",
+            CompactTopoGraph::FilePath("/apollo/map.v1/routing_map"));
+}
+
+}  // namespace routing
+}  // namespace apollo
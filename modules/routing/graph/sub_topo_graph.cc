@@ -116,13 +116,14 @@ void SubTopoGraph::GetSubInEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(to_node, &sub_nodes)) {
+  const auto* sub_nodes =
+      from_node->IsSubNode() || to_node->IsSubNode() ? nullptr
+                                                     : GetSubNodes(to_node);
+  if (sub_nodes == nullptr) {
     sub_edges->insert(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* in_edge : sub_node->InFromAllEdge()) {
       if (in_edge->FromNode() == from_node) {
         sub_edges->insert(in_edge);
@@ -136,13 +137,14 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(from_node, &sub_nodes)) {
+  const auto* sub_nodes =
+      from_node->IsSubNode() || to_node->IsSubNode() ? nullptr
+                                                     : GetSubNodes(from_node);
+  if (sub_nodes == nullptr) {
     sub_edges->insert(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* out_edge : sub_node->OutToAllEdge()) {
       if (out_edge->ToNode() == to_node) {
         sub_edges->insert(out_edge);
@@ -178,39 +180,31 @@ void SubTopoGraph::InitSubNodeByValidRange(
     if (range.Length() < MIN_INTERNAL_FOR_NODE) {
       continue;
     }
-    std::shared_ptr<TopoNode> sub_topo_node_ptr;
-    sub_topo_node_ptr.reset(new TopoNode(topo_node, range));
-    sub_node_vec.emplace_back(sub_topo_node_ptr.get(), range);
-    sub_node_set.insert(sub_topo_node_ptr.get());
-    sub_node_sorted_vec.push_back(sub_topo_node_ptr.get());
-    topo_nodes_.push_back(std::move(sub_topo_node_ptr));
+    topo_nodes_.emplace_back(topo_node, range);
+    auto* sub_topo_node = &topo_nodes_.back();
+    sub_node_vec.emplace_back(sub_topo_node, range);
+    sub_node_set.insert(sub_topo_node);
+    sub_node_sorted_vec.push_back(sub_topo_node);
   }
 
   for (size_t i = 1; i < sub_node_sorted_vec.size(); ++i) {
     auto* pre_node = sub_node_sorted_vec[i - 1];
     auto* next_node = sub_node_sorted_vec[i];
     if (IsCloseEnough(pre_node->EndS(), next_node->StartS())) {
-      Edge edge;
-      edge.set_from_lane_id(topo_node->LaneId());
-      edge.set_to_lane_id(topo_node->LaneId());
-      edge.set_direction_type(Edge::FORWARD);
-      edge.set_cost(0.0);
-      std::shared_ptr<TopoEdge> topo_edge_ptr;
-      topo_edge_ptr.reset(new TopoEdge(edge, pre_node, next_node));
-      pre_node->AddOutEdge(topo_edge_ptr.get());
-      next_node->AddInEdge(topo_edge_ptr.get());
-      topo_edges_.push_back(std::move(topo_edge_ptr));
+      topo_edges_.emplace_back(0.0, TET_FORWARD, pre_node, next_node);
+      pre_node->AddOutEdge(&topo_edges_.back());
+      next_node->AddInEdge(&topo_edges_.back());
     }
   }
 }
 
 void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (!GetSubNodes(topo_node, &sub_nodes)) {
+  const auto* sub_nodes = GetSubNodes(topo_node);
+  if (sub_nodes == nullptr) {
     return;
   }
 
-  for (auto* sub_node : sub_nodes) {
+  for (auto* sub_node : *sub_nodes) {
     InitInSubNodeSubEdge(sub_node, topo_node->InFromAllEdge());
     InitOutSubNodeSubEdge(sub_node, topo_node->OutToAllEdge());
   }
@@ -218,76 +212,71 @@ void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
 
 void SubTopoGraph::InitInSubNodeSubEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::unordered_set<const TopoEdge*>& origin_edge) {
   for (const auto* in_edge : origin_edge) {
-    if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
-      for (auto* sub_from_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(in_edge->FromNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_from_node : *other_sub_nodes) {
         if (!sub_from_node->IsOverlapEnough(sub_node, in_edge)) {
           continue;
         }
-        std::shared_ptr<TopoEdge> topo_edge_ptr;
-        topo_edge_ptr.reset(
-            new TopoEdge(in_edge->PbEdge(), sub_from_node, sub_node));
-        sub_node->AddInEdge(topo_edge_ptr.get());
-        sub_from_node->AddOutEdge(topo_edge_ptr.get());
-        topo_edges_.push_back(std::move(topo_edge_ptr));
+        const auto* topo_edge = AddSubEdge(in_edge, sub_from_node, sub_node);
+        sub_node->AddInEdge(topo_edge);
+        sub_from_node->AddOutEdge(topo_edge);
       }
     } else if (in_edge->FromNode()->IsOverlapEnough(sub_node, in_edge)) {
-      std::shared_ptr<TopoEdge> topo_edge_ptr;
-      topo_edge_ptr.reset(
-          new TopoEdge(in_edge->PbEdge(), in_edge->FromNode(), sub_node));
-      sub_node->AddInEdge(topo_edge_ptr.get());
-      topo_edges_.push_back(std::move(topo_edge_ptr));
+      const auto* topo_edge =
+          AddSubEdge(in_edge, in_edge->FromNode(), sub_node);
+      sub_node->AddInEdge(topo_edge);
     }
   }
 }
 
 void SubTopoGraph::InitOutSubNodeSubEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::unordered_set<const TopoEdge*>& origin_edge) {
   for (const auto* out_edge : origin_edge) {
-    if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
-      for (auto* sub_to_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(out_edge->ToNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_to_node : *other_sub_nodes) {
         if (!sub_node->IsOverlapEnough(sub_to_node, out_edge)) {
           continue;
         }
-        std::shared_ptr<TopoEdge> topo_edge_ptr;
-        topo_edge_ptr.reset(
-            new TopoEdge(out_edge->PbEdge(), sub_node, sub_to_node));
-        sub_node->AddOutEdge(topo_edge_ptr.get());
-        sub_to_node->AddInEdge(topo_edge_ptr.get());
-        topo_edges_.push_back(std::move(topo_edge_ptr));
+        const auto* topo_edge = AddSubEdge(out_edge, sub_node, sub_to_node);
+        sub_node->AddOutEdge(topo_edge);
+        sub_to_node->AddInEdge(topo_edge);
       }
     } else if (sub_node->IsOverlapEnough(out_edge->ToNode(), out_edge)) {
-      std::shared_ptr<TopoEdge> topo_edge_ptr;
-      topo_edge_ptr.reset(
-          new TopoEdge(out_edge->PbEdge(), sub_node, out_edge->ToNode()));
-      sub_node->AddOutEdge(topo_edge_ptr.get());
-      topo_edges_.push_back(std::move(topo_edge_ptr));
+      const auto* topo_edge =
+          AddSubEdge(out_edge, sub_node, out_edge->ToNode());
+      sub_node->AddOutEdge(topo_edge);
     }
   }
 }
 
-bool SubTopoGraph::GetSubNodes(
-    const TopoNode* node,
-    std::unordered_set<TopoNode*>* const sub_nodes) const {
+const std::unordered_set<TopoNode*>* SubTopoGraph::GetSubNodes(
+    const TopoNode* node) const {
   const auto& iter = sub_node_map_.find(node);
   if (iter == sub_node_map_.end()) {
-    return false;
+    return nullptr;
   }
-  sub_nodes->clear();
-  sub_nodes->insert(iter->second.begin(), iter->second.end());
-  return true;
+  return &iter->second;
+}
+
+TopoEdge* SubTopoGraph::AddSubEdge(const TopoEdge* origin_edge,
+                                   const TopoNode* from_node,
+                                   const TopoNode* to_node) {
+  topo_edges_.emplace_back(origin_edge->Cost(), origin_edge->Type(), from_node,
+                           to_node);
+  return &topo_edges_.back();
 }
 
 void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (!GetSubNodes(topo_node, &sub_nodes)) {
+  const auto* sub_nodes = GetSubNodes(topo_node);
+  if (sub_nodes == nullptr) {
     return;
   }
-  for (auto* sub_node : sub_nodes) {
+  for (auto* sub_node : *sub_nodes) {
     AddPotentialInEdge(sub_node, topo_node->InFromLeftOrRightEdge());
     AddPotentialOutEdge(sub_node, topo_node->OutToLeftOrRightEdge());
   }
@@ -295,66 +284,56 @@ void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
 
 void SubTopoGraph::AddPotentialInEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::unordered_set<const TopoEdge*>& origin_edge) {
   for (const auto* in_edge : origin_edge) {
-    if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
-      for (auto* sub_from_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(in_edge->FromNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_from_node : *other_sub_nodes) {
         if (sub_node->GetInEdgeFrom(sub_from_node) != nullptr) {
           continue;
         }
         if (!IsReachable(sub_from_node, sub_node)) {
           continue;
         }
-        std::shared_ptr<TopoEdge> topo_edge_ptr;
-        topo_edge_ptr.reset(
-            new TopoEdge(in_edge->PbEdge(), sub_from_node, sub_node));
-        sub_node->AddInEdge(topo_edge_ptr.get());
-        sub_from_node->AddOutEdge(topo_edge_ptr.get());
-        topo_edges_.push_back(std::move(topo_edge_ptr));
+        const auto* topo_edge = AddSubEdge(in_edge, sub_from_node, sub_node);
+        sub_node->AddInEdge(topo_edge);
+        sub_from_node->AddOutEdge(topo_edge);
       }
     } else {
       if (sub_node->GetInEdgeFrom(in_edge->FromNode()) != nullptr) {
         continue;
       }
-      std::shared_ptr<TopoEdge> topo_edge_ptr;
-      topo_edge_ptr.reset(
-          new TopoEdge(in_edge->PbEdge(), in_edge->FromNode(), sub_node));
-      sub_node->AddInEdge(topo_edge_ptr.get());
-      topo_edges_.push_back(std::move(topo_edge_ptr));
+      const auto* topo_edge =
+          AddSubEdge(in_edge, in_edge->FromNode(), sub_node);
+      sub_node->AddInEdge(topo_edge);
     }
   }
 }
 
 void SubTopoGraph::AddPotentialOutEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::unordered_set<const TopoEdge*>& origin_edge) {
   for (const auto* out_edge : origin_edge) {
-    if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
-      for (auto* sub_to_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(out_edge->ToNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_to_node : *other_sub_nodes) {
         if (sub_node->GetOutEdgeTo(sub_to_node) != nullptr) {
           continue;
         }
         if (!IsReachable(sub_node, sub_to_node)) {
           continue;
         }
-        std::shared_ptr<TopoEdge> topo_edge_ptr;
-        topo_edge_ptr.reset(
-            new TopoEdge(out_edge->PbEdge(), sub_node, sub_to_node));
-        sub_node->AddOutEdge(topo_edge_ptr.get());
-        sub_to_node->AddInEdge(topo_edge_ptr.get());
-        topo_edges_.push_back(std::move(topo_edge_ptr));
+        const auto* topo_edge = AddSubEdge(out_edge, sub_node, sub_to_node);
+        sub_node->AddOutEdge(topo_edge);
+        sub_to_node->AddInEdge(topo_edge);
       }
     } else {
       if (sub_node->GetOutEdgeTo(out_edge->ToNode()) != nullptr) {
         continue;
       }
-      std::shared_ptr<TopoEdge> topo_edge_ptr;
-      topo_edge_ptr.reset(
-          new TopoEdge(out_edge->PbEdge(), sub_node, out_edge->ToNode()));
-      sub_node->AddOutEdge(topo_edge_ptr.get());
-      topo_edges_.push_back(std::move(topo_edge_ptr));
+      const auto* topo_edge =
+          AddSubEdge(out_edge, sub_node, out_edge->ToNode());
+      sub_node->AddOutEdge(topo_edge);
     }
   }
 }
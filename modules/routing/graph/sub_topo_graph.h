@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include <memory>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -76,25 +76,28 @@ class SubTopoGraph {
 
   void InitInSubNodeSubEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::unordered_set<const TopoEdge*>& origin_edge);
   void InitOutSubNodeSubEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::unordered_set<const TopoEdge*>& origin_edge);
 
-  bool GetSubNodes(const TopoNode* node,
-                   std::unordered_set<TopoNode*>* const sub_nodes) const;
+  const std::unordered_set<TopoNode*>* GetSubNodes(
+      const TopoNode* node) const;
+  TopoEdge* AddSubEdge(const TopoEdge* origin_edge, const TopoNode* from_node,
+                       const TopoNode* to_node);
 
   void AddPotentialEdge(const TopoNode* topo_node);
   void AddPotentialInEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::unordered_set<const TopoEdge*>& origin_edge);
   void AddPotentialOutEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::unordered_set<const TopoEdge*>& origin_edge);
 
  private:
-  std::vector<std::shared_ptr<TopoNode>> topo_nodes_;
-  std::vector<std::shared_ptr<TopoEdge>> topo_edges_;
+  // deques keep the sub nodes and edges in place and allocate them in chunks
+  std::deque<TopoNode> topo_nodes_;
+  std::deque<TopoEdge> topo_edges_;
   std::unordered_map<const TopoNode*, std::vector<NodeWithRange>>
       sub_node_range_sorted_map_;
   std::unordered_map<const TopoNode*, std::unordered_set<TopoNode*>>
@@ -16,92 +16,148 @@
 
 #include "modules/routing/graph/topo_graph.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace apollo {
 namespace routing {
 
 void TopoGraph::Clear() {
+  map_version_.clear();
+  map_district_.clear();
   topo_nodes_.clear();
   topo_edges_.clear();
-  node_index_map_.clear();
+  compact_graph_.reset();
 }
 
-bool TopoGraph::LoadNodes(const Graph& graph) {
-  if (graph.node_size() == 0) {
-    AERROR << "No nodes found in topology graph.";
-    return false;
-  }
-  for (const auto& node : graph.node()) {
-    node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
-    std::shared_ptr<TopoNode> topo_node;
-    topo_node.reset(new TopoNode(node));
-    road_node_map_[node.road_id()].insert(topo_node.get());
-    topo_nodes_.push_back(std::move(topo_node));
+void TopoGraph::LoadNodes() {
+  const int num_nodes = compact_graph_->NumNodes();
+  topo_nodes_.reserve(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    topo_nodes_.emplace_back(new TopoNode(*compact_graph_, i));
   }
-  return true;
 }
 
 // Need to execute load_nodes() firstly
-bool TopoGraph::LoadEdges(const Graph& graph) {
-  if (graph.edge_size() == 0) {
+void TopoGraph::LoadEdges() {
+  if (compact_graph_->NumEdges() == 0) {
     AINFO << "0 edges found in topology graph, but it's fine";
-    return true;
+    return;
   }
-  for (const auto& edge : graph.edge()) {
-    const std::string& from_lane_id = edge.from_lane_id();
-    const std::string& to_lane_id = edge.to_lane_id();
-    if (node_index_map_.count(from_lane_id) != 1 ||
-        node_index_map_.count(to_lane_id) != 1) {
-      return false;
+  topo_edges_.reserve(compact_graph_->NumEdges());
+  for (int from = 0; from < compact_graph_->NumNodes(); ++from) {
+    TopoNode* from_node = topo_nodes_[from].get();
+    for (int edge = compact_graph_->OutEdgeBegin(from);
+         edge < compact_graph_->OutEdgeEnd(from); ++edge) {
+      TopoNode* to_node = topo_nodes_[compact_graph_->EdgeTo(edge)].get();
+      TopoEdgeType type = TET_FORWARD;
+      if (compact_graph_->EdgeDirection(edge) == Edge::LEFT) {
+        type = TET_LEFT;
+      } else if (compact_graph_->EdgeDirection(edge) == Edge::RIGHT) {
+        type = TET_RIGHT;
+      }
+      std::shared_ptr<TopoEdge> topo_edge(new TopoEdge(
+          compact_graph_->EdgeCost(edge), type, from_node, to_node));
+      from_node->AddOutEdge(topo_edge.get());
+      to_node->AddInEdge(topo_edge.get());
+      topo_edges_.push_back(std::move(topo_edge));
     }
-    std::shared_ptr<TopoEdge> topo_edge;
-    TopoNode* from_node = topo_nodes_[node_index_map_[from_lane_id]].get();
-    TopoNode* to_node = topo_nodes_[node_index_map_[to_lane_id]].get();
-    topo_edge.reset(new TopoEdge(edge, from_node, to_node));
-    from_node->AddOutEdge(topo_edge.get());
-    to_node->AddInEdge(topo_edge.get());
-    topo_edges_.push_back(std::move(topo_edge));
   }
-  return true;
 }
 
 bool TopoGraph::LoadGraph(const Graph& graph) {
   Clear();
-
-  map_version_ = graph.hdmap_version();
-  map_district_ = graph.hdmap_district();
-
-  if (!LoadNodes(graph)) {
-    AERROR << "Failed to load nodes from topology graph.";
+  std::unique_ptr<CompactTopoGraph> compact_graph(new CompactTopoGraph());
+  if (!compact_graph->Build(graph)) {
+    AERROR << "Failed to load topology graph.";
     return false;
   }
-  if (!LoadEdges(graph)) {
-    AERROR << "Failed to load edges from topology graph.";
+  return LoadGraph(std::move(compact_graph));
+}
+
+bool TopoGraph::LoadCompactGraph(const std::string& file_path,
+                                 bool use_mmap) {
+  Clear();
+  std::unique_ptr<CompactTopoGraph> compact_graph(new CompactTopoGraph());
+  if (!compact_graph->Load(file_path, use_mmap)) {
+    AERROR << "Failed to load compact topology graph " << file_path;
     return false;
   }
-  AINFO << "Load Topo data succesful.";
+  return LoadGraph(std::move(compact_graph));
+}
+
+bool TopoGraph::LoadGraph(std::unique_ptr<CompactTopoGraph> compact_graph) {
+  compact_graph_ = std::move(compact_graph);
+  map_version_ = compact_graph_->MapVersion();
+  map_district_ = compact_graph_->MapDistrict();
+  LoadNodes();
+  LoadEdges();
+  AINFO << "Load Topo data succesful with " << compact_graph_->NumNodes()
+        << " nodes, " << compact_graph_->NumEdges() << " edges and "
+        << compact_graph_->NumLandmarks() << " landmarks.";
   return true;
 }
 
+bool TopoGraph::HasLandmarks() const {
+  return compact_graph_ != nullptr && compact_graph_->NumLandmarks() > 0;
+}
+
+double TopoGraph::LandmarkLowerBound(const TopoNode* from_node,
+                                     const TopoNode* to_node) const {
+  const int from_index = from_node->Index();
+  const int to_index = to_node->Index();
+  if (!HasLandmarks() || from_index < 0 || to_index < 0 ||
+      from_index >= static_cast<int>(topo_nodes_.size()) ||
+      to_index >= static_cast<int>(topo_nodes_.size()) ||
+      topo_nodes_[from_index].get() != from_node->OriginNode() ||
+      topo_nodes_[to_index].get() != to_node->OriginNode()) {
+    return 0.0;
+  }
+  const int num_landmarks = compact_graph_->NumLandmarks();
+  const float* from_forward = compact_graph_->LandmarkForwardCosts(from_index);
+  const float* to_forward = compact_graph_->LandmarkForwardCosts(to_index);
+  const float* from_backward =
+      compact_graph_->LandmarkBackwardCosts(from_index);
+  const float* to_backward = compact_graph_->LandmarkBackwardCosts(to_index);
+  float bound = 0.0f;
+  for (int k = 0; k < num_landmarks; ++k) {
+    // cost(landmark, to) <= cost(landmark, from) + cost(from, to)
+    if (from_forward[k] >= 0.0f && to_forward[k] >= 0.0f) {
+      bound = std::max(bound, to_forward[k] - from_forward[k]);
+    }
+    // cost(from, landmark) <= cost(from, to) + cost(to, landmark)
+    if (from_backward[k] >= 0.0f && to_backward[k] >= 0.0f) {
+      bound = std::max(bound, from_backward[k] - to_backward[k]);
+    }
+  }
+  return bound;
+}
+
 const std::string& TopoGraph::MapVersion() const { return map_version_; }
 
 const std::string& TopoGraph::MapDistrict() const { return map_district_; }
 
 const TopoNode* TopoGraph::GetNode(const std::string& id) const {
-  const auto& iter = node_index_map_.find(id);
-  if (iter == node_index_map_.end()) {
+  if (compact_graph_ == nullptr) {
     return nullptr;
   }
-  return topo_nodes_[iter->second].get();
+  const int index = compact_graph_->NodeIndex(id);
+  if (index < 0) {
+    return nullptr;
+  }
+  return topo_nodes_[index].get();
 }
 
 void TopoGraph::GetNodesByRoadId(
     const std::string& road_id,
     std::unordered_set<const TopoNode*>* const node_in_road) const {
-  const auto& iter = road_node_map_.find(road_id);
-  if (iter != road_node_map_.end()) {
-    node_in_road->insert(iter->second.begin(), iter->second.end());
+  if (compact_graph_ == nullptr) {
+    return;
+  }
+  std::vector<int> nodes;
+  compact_graph_->GetNodesByRoadId(road_id, &nodes);
+  for (const int index : nodes) {
+    node_in_road->insert(topo_nodes_[index].get());
   }
 }
 
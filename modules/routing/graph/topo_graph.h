@@ -18,11 +18,11 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "modules/routing/graph/compact_topo_graph.h"
 #include "modules/routing/graph/topo_node.h"
 
 namespace apollo {
@@ -34,6 +34,11 @@ class TopoGraph {
   ~TopoGraph() = default;
 
   bool LoadGraph(const Graph& filename);
+  /**
+   * Load the compact graph file topo_creator writes next to the routing map,
+   * mapping it into memory if use_mmap.
+   */
+  bool LoadCompactGraph(const std::string& file_path, bool use_mmap);
 
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
@@ -42,19 +47,27 @@ class TopoGraph {
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
 
+  bool HasLandmarks() const;
+  /**
+   * Lower bound of the search cost from one node to another by the triangle
+   * inequality over the landmarks, sub nodes use their origin node.
+   */
+  double LandmarkLowerBound(const TopoNode* from_node,
+                            const TopoNode* to_node) const;
+
  private:
   void Clear();
-  bool LoadNodes(const Graph& graph);
-  bool LoadEdges(const Graph& graph);
+  bool LoadGraph(std::unique_ptr<CompactTopoGraph> compact_graph);
+  void LoadNodes();
+  void LoadEdges();
 
  private:
   std::string map_version_;
   std::string map_district_;
+  // node i of the compact graph is topo_nodes_[i]
+  std::unique_ptr<CompactTopoGraph> compact_graph_;
   std::vector<std::shared_ptr<TopoNode> > topo_nodes_;
   std::vector<std::shared_ptr<TopoEdge> > topo_edges_;
-  std::unordered_map<std::string, int> node_index_map_;
-  std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
-      road_node_map_;
 };
 
 }  // namespace routing
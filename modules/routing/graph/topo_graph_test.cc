@@ -65,5 +65,74 @@ TEST(TopoGraphTestSuit, test_graph_1) {
   ASSERT_FALSE(node_4->IsSubNode());
 }
 
+TEST(TopoGraphTestSuit, test_landmark_lower_bound) {
+  Graph graph;
+  GetGraphForTest(&graph);
+  // node order is L1, L2, L3, L4
+  auto* landmark_1 = graph.add_landmark();
+  landmark_1->set_lane_id(TEST_L1);
+  for (const float cost : {0.0f, 1.0f, 3.0f, 4.0f}) {
+    landmark_1->add_forward_cost(cost);
+  }
+  for (const float cost : {0.0f, 1.0f, -1.0f, -1.0f}) {
+    landmark_1->add_backward_cost(cost);
+  }
+  auto* landmark_4 = graph.add_landmark();
+  landmark_4->set_lane_id(TEST_L4);
+  for (const float cost : {-1.0f, -1.0f, 1.0f, 0.0f}) {
+    landmark_4->add_forward_cost(cost);
+  }
+  for (const float cost : {4.0f, 3.0f, 1.0f, 0.0f}) {
+    landmark_4->add_backward_cost(cost);
+  }
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ASSERT_TRUE(topo_graph.HasLandmarks());
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_2 = topo_graph.GetNode(TEST_L2);
+  const TopoNode* node_4 = topo_graph.GetNode(TEST_L4);
+  EXPECT_DOUBLE_EQ(4.0, topo_graph.LandmarkLowerBound(node_1, node_4));
+  EXPECT_DOUBLE_EQ(3.0, topo_graph.LandmarkLowerBound(node_2, node_4));
+  EXPECT_DOUBLE_EQ(0.0, topo_graph.LandmarkLowerBound(node_4, node_1));
+
+  // landmarks of another graph are ignored
+  landmark_4->add_forward_cost(0.0f);
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  EXPECT_FALSE(topo_graph.HasLandmarks());
+  EXPECT_DOUBLE_EQ(0.0, topo_graph.LandmarkLowerBound(
+                            topo_graph.GetNode(TEST_L1),
+                            topo_graph.GetNode(TEST_L4)));
+}
+
+TEST(TopoGraphTestSuit, test_compact_graph) {
+  const std::string file_path = "/tmp/topo_graph_test.csr";
+  Graph graph;
+  GetGraphForTest(&graph);
+  CompactTopoGraph compact_graph;
+  ASSERT_TRUE(compact_graph.Build(graph));
+  ASSERT_TRUE(compact_graph.Save(file_path));
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadCompactGraph(file_path, true));
+  ASSERT_EQ(TEST_MAP_VERSION, topo_graph.MapVersion());
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_EQ(0, node_1->Index());
+  ASSERT_EQ(2, node_1->OutToAllEdge().size());
+  ASSERT_EQ(1, node_1->OutToRightEdge().size());
+  const TopoEdge* edge = *node_1->OutToSucEdge().begin();
+  ASSERT_EQ(TEST_L3, edge->ToLaneId());
+  ASSERT_DOUBLE_EQ(TEST_EDGE_COST, edge->Cost());
+  ASSERT_EQ(edge, topo_graph.GetNode(TEST_L3)->GetInEdgeFrom(node_1));
+  std::unordered_set<const TopoNode*> nodes;
+  topo_graph.GetNodesByRoadId(TEST_R2, &nodes);
+  ASSERT_EQ(2, nodes.size());
+  ASSERT_TRUE(topo_graph.GetNode(TEST_L5) == nullptr);
+
+  ASSERT_FALSE(topo_graph.LoadCompactGraph("/tmp/no_such_graph.csr", true));
+  ASSERT_TRUE(topo_graph.GetNode(TEST_L1) == nullptr);
+}
+
 }  // namespace routing
 }  // namespace apollo
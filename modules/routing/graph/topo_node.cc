@@ -17,6 +17,7 @@
 #include "modules/routing/graph/topo_node.h"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -34,13 +35,13 @@ const double kLenghtEpsilon = 1e-6;         // in meter
 using apollo::common::util::FindPtrOrNull;
 using ::google::protobuf::RepeatedPtrField;
 
-void ConvertOutRange(const RepeatedPtrField<CurveRange>& range_vec,
-                     double start_s, double end_s,
-                     std::vector<NodeSRange>* out_range, int* prefer_index) {
+void ConvertOutRange(const std::vector<NodeSRange>& range_vec, double start_s,
+                     double end_s, std::vector<NodeSRange>* out_range,
+                     int* prefer_index) {
   out_range->clear();
   for (const auto& c_range : range_vec) {
-    double s_s = c_range.start().s();
-    double e_s = c_range.end().s();
+    double s_s = c_range.StartS();
+    double e_s = c_range.EndS();
     if (e_s < start_s || s_s > end_s || e_s < s_s) {
       continue;
     }
@@ -61,6 +62,24 @@ void ConvertOutRange(const RepeatedPtrField<CurveRange>& range_vec,
   *prefer_index = max_index;
 }
 
+std::vector<NodeSRange> ToSRanges(
+    const RepeatedPtrField<CurveRange>& range_vec) {
+  std::vector<NodeSRange> s_ranges;
+  for (const auto& c_range : range_vec) {
+    s_ranges.emplace_back(c_range.start().s(), c_range.end().s());
+  }
+  return s_ranges;
+}
+
+std::vector<NodeSRange> ToSRanges(
+    const std::vector<CompactTopoGraph::Range>& range_vec) {
+  std::vector<NodeSRange> s_ranges;
+  for (const auto& c_range : range_vec) {
+    s_ranges.emplace_back(c_range.start_s, c_range.end_s);
+  }
+  return s_ranges;
+}
+
 }  // namespace
 
 bool TopoNode::IsOutRangeEnough(const std::vector<NodeSRange>& range_vec,
@@ -94,77 +113,108 @@ bool TopoNode::IsOutRangeEnough(const std::vector<NodeSRange>& range_vec,
 }
 
 TopoNode::TopoNode(const Node& node)
-    : pb_node_(node), start_s_(0.0), end_s_(pb_node_.length()) {
-  CHECK(pb_node_.length() > kLenghtEpsilon)
-      << "Node length is invalid in pb: " << pb_node_.DebugString();
-  Init();
+    : lane_id_(node.lane_id()),
+      road_id_(node.road_id()),
+      length_(node.length()),
+      cost_(node.cost()),
+      is_virtual_(node.is_virtual()),
+      start_s_(0.0),
+      end_s_(length_) {
+  CHECK(length_ > kLenghtEpsilon)
+      << "Node length is invalid in pb: " << node.DebugString();
+  has_curve_samples_ = CompactTopoGraph::SampleCentralCurve(
+      node.central_curve(), curve_samples_);
+  Init(ToSRanges(node.left_out()), ToSRanges(node.right_out()));
+  origin_node_ = this;
+}
+
+TopoNode::TopoNode(const CompactTopoGraph& graph, int index)
+    : lane_id_(graph.LaneId(index)),
+      road_id_(graph.RoadId(index)),
+      length_(graph.Length(index)),
+      cost_(graph.Cost(index)),
+      is_virtual_(graph.IsVirtual(index)),
+      index_(index),
+      has_curve_samples_(graph.HasCentralCurve(index)),
+      start_s_(0.0),
+      end_s_(length_) {
+  CHECK(length_ > kLenghtEpsilon) << "Node length is invalid for lane: "
+                                  << lane_id_ << ", length: " << length_;
+  std::copy(graph.CurveSamples(index),
+            graph.CurveSamples(index) + CompactTopoGraph::kNumCurveSamples,
+            curve_samples_);
+  Init(ToSRanges(graph.LeftOutRanges(index)),
+       ToSRanges(graph.RightOutRanges(index)));
   origin_node_ = this;
 }
 
 TopoNode::TopoNode(const TopoNode* topo_node, const NodeSRange& range)
-    : TopoNode(topo_node->PbNode()) {
+    : lane_id_(topo_node->lane_id_),
+      road_id_(topo_node->road_id_),
+      length_(topo_node->length_),
+      cost_(topo_node->cost_),
+      is_virtual_(topo_node->is_virtual_),
+      index_(topo_node->index_),
+      has_curve_samples_(topo_node->has_curve_samples_),
+      start_s_(range.StartS()),
+      end_s_(range.EndS()) {
+  std::copy(topo_node->curve_samples_,
+            topo_node->curve_samples_ + CompactTopoGraph::kNumCurveSamples,
+            curve_samples_);
+  // the origin ranges are already clipped to the whole lane
+  Init(topo_node->LeftOutRange(), topo_node->RightOutRange());
   origin_node_ = topo_node;
-  start_s_ = range.StartS();
-  end_s_ = range.EndS();
-  Init();
 }
 
 TopoNode::~TopoNode() {}
 
-void TopoNode::Init() {
+void TopoNode::Init(const std::vector<NodeSRange>& left_out,
+                    const std::vector<NodeSRange>& right_out) {
   if (!FindAnchorPoint()) {
     AWARN << "Be attention!!! Find anchor point failed for lane: " << LaneId();
   }
-  ConvertOutRange(pb_node_.left_out(), start_s_, end_s_,
-                  &left_out_sorted_range_, &left_prefer_range_index_);
+  ConvertOutRange(left_out, start_s_, end_s_, &left_out_sorted_range_,
+                  &left_prefer_range_index_);
 
   is_left_range_enough_ =
       (left_prefer_range_index_ >= 0) &&
       left_out_sorted_range_[left_prefer_range_index_].IsEnoughForChangeLane();
 
-  ConvertOutRange(pb_node_.right_out(), start_s_, end_s_,
-                  &right_out_sorted_range_, &right_prefer_range_index_);
+  ConvertOutRange(right_out, start_s_, end_s_, &right_out_sorted_range_,
+                  &right_prefer_range_index_);
   is_right_range_enough_ = (right_prefer_range_index_ >= 0) &&
                            right_out_sorted_range_[right_prefer_range_index_]
                                .IsEnoughForChangeLane();
 }
 
 bool TopoNode::FindAnchorPoint() {
-  double total_size = 0;
-  for (const auto& seg : CentralCurve().segment()) {
-    total_size += seg.line_segment().point_size();
-  }
-  double rate = (StartS() + EndS()) / 2.0 / Length();
-  int anchor_index = static_cast<int>(total_size * rate);
-  for (const auto& seg : CentralCurve().segment()) {
-    if (anchor_index < seg.line_segment().point_size()) {
-      SetAnchorPoint(seg.line_segment().point(anchor_index));
-      return true;
-    }
-    anchor_index -= seg.line_segment().point_size();
+  if (!has_curve_samples_) {
+    return false;
   }
-  return false;
-}
-
-void TopoNode::SetAnchorPoint(const common::PointENU& anchor_point) {
-  anchor_point_ = anchor_point;
+  // the middle sample is the anchor of the whole lane, sub nodes move it
+  // linearly towards the start or the end sample
+  const double rate = (StartS() + EndS()) / 2.0 / Length();
+  const auto& from = rate < 0.5 ? curve_samples_[0] : curve_samples_[1];
+  const auto& to = rate < 0.5 ? curve_samples_[1] : curve_samples_[2];
+  const double ratio =
+      rate < 0.5 ? rate * 2.0 : std::min(1.0, (rate - 0.5) * 2.0);
+  anchor_point_.set_x(from.x + (to.x - from.x) * ratio);
+  anchor_point_.set_y(from.y + (to.y - from.y) * ratio);
+  anchor_point_.set_z(from.z + (to.z - from.z) * ratio);
+  return true;
 }
 
-const Node& TopoNode::PbNode() const { return pb_node_; }
+int TopoNode::Index() const { return index_; }
 
-double TopoNode::Length() const { return pb_node_.length(); }
+double TopoNode::Length() const { return length_; }
 
-double TopoNode::Cost() const { return pb_node_.cost(); }
+double TopoNode::Cost() const { return cost_; }
 
-bool TopoNode::IsVirtual() const { return pb_node_.is_virtual(); }
+bool TopoNode::IsVirtual() const { return is_virtual_; }
 
-const std::string& TopoNode::LaneId() const { return pb_node_.lane_id(); }
+const std::string& TopoNode::LaneId() const { return lane_id_; }
 
-const std::string& TopoNode::RoadId() const { return pb_node_.road_id(); }
-
-const hdmap::Curve& TopoNode::CentralCurve() const {
-  return pb_node_.central_curve();
-}
+const std::string& TopoNode::RoadId() const { return road_id_; }
 
 const common::PointENU& TopoNode::AnchorPoint() const { return anchor_point_; }
 
@@ -310,32 +360,32 @@ bool TopoNode::IsOutToSucEdgeValid() const {
 
 TopoEdge::TopoEdge(const Edge& edge, const TopoNode* from_node,
                    const TopoNode* to_node)
-    : pb_edge_(edge), from_node_(from_node), to_node_(to_node) {}
+    : cost_(edge.cost()), from_node_(from_node), to_node_(to_node) {
+  if (edge.direction_type() == Edge::LEFT) {
+    type_ = TET_LEFT;
+  } else if (edge.direction_type() == Edge::RIGHT) {
+    type_ = TET_RIGHT;
+  }
+}
+
+TopoEdge::TopoEdge(double cost, TopoEdgeType type, const TopoNode* from_node,
+                   const TopoNode* to_node)
+    : cost_(cost), type_(type), from_node_(from_node), to_node_(to_node) {}
 
 TopoEdge::~TopoEdge() {}
 
-const Edge& TopoEdge::PbEdge() const { return pb_edge_; }
-
-double TopoEdge::Cost() const { return pb_edge_.cost(); }
+double TopoEdge::Cost() const { return cost_; }
 
 const TopoNode* TopoEdge::FromNode() const { return from_node_; }
 
 const TopoNode* TopoEdge::ToNode() const { return to_node_; }
 
 const std::string& TopoEdge::FromLaneId() const {
-  return pb_edge_.from_lane_id();
+  return from_node_->LaneId();
 }
 
-const std::string& TopoEdge::ToLaneId() const { return pb_edge_.to_lane_id(); }
+const std::string& TopoEdge::ToLaneId() const { return to_node_->LaneId(); }
 
-TopoEdgeType TopoEdge::Type() const {
-  if (pb_edge_.direction_type() == Edge::LEFT) {
-    return TET_LEFT;
-  }
-  if (pb_edge_.direction_type() == Edge::RIGHT) {
-    return TET_RIGHT;
-  }
-  return TET_FORWARD;
-}
+TopoEdgeType TopoEdge::Type() const { return type_; }
 }  // namespace routing
 }  // namespace apollo
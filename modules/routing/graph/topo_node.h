@@ -21,6 +21,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "modules/routing/graph/compact_topo_graph.h"
 #include "modules/routing/graph/topo_range.h"
 #include "modules/routing/proto/topo_graph.pb.h"
 
@@ -36,18 +37,19 @@ class TopoNode {
 
  public:
   explicit TopoNode(const Node& node);
+  TopoNode(const CompactTopoGraph& graph, int index);
   TopoNode(const TopoNode* topo_node, const NodeSRange& range);
 
   ~TopoNode();
 
-  const Node& PbNode() const;
+  // index of the node in its CompactTopoGraph, -1 if not from one
+  int Index() const;
   double Length() const;
   double Cost() const;
   bool IsVirtual() const;
 
   const std::string& LaneId() const;
   const std::string& RoadId() const;
-  const hdmap::Curve& CentralCurve() const;
   const common::PointENU& AnchorPoint() const;
   const std::vector<NodeSRange>& LeftOutRange() const;
   const std::vector<NodeSRange>& RightOutRange() const;
@@ -78,11 +80,20 @@ class TopoNode {
   void AddOutEdge(const TopoEdge* edge);
 
  private:
-  void Init();
+  void Init(const std::vector<NodeSRange>& left_out,
+            const std::vector<NodeSRange>& right_out);
   bool FindAnchorPoint();
-  void SetAnchorPoint(const common::PointENU& anchor_point);
 
-  Node pb_node_;
+  std::string lane_id_;
+  std::string road_id_;
+  double length_ = 0.0;
+  double cost_ = 0.0;
+  bool is_virtual_ = false;
+  int index_ = -1;
+  // start, middle and end point of the central curve if it has points
+  bool has_curve_samples_ = false;
+  CompactTopoGraph::Point
+      curve_samples_[CompactTopoGraph::kNumCurveSamples] = {};
   common::PointENU anchor_point_;
 
   double start_s_;
@@ -122,10 +133,11 @@ class TopoEdge {
  public:
   TopoEdge(const Edge& edge, const TopoNode* from_node,
            const TopoNode* to_node);
+  TopoEdge(double cost, TopoEdgeType type, const TopoNode* from_node,
+           const TopoNode* to_node);
 
   ~TopoEdge();
 
-  const Edge& PbEdge() const;
   double Cost() const;
   const std::string& FromLaneId() const;
   const std::string& ToLaneId() const;
@@ -135,7 +147,8 @@ class TopoEdge {
   const TopoNode* ToNode() const;
 
  private:
-  Edge pb_edge_;
+  double cost_ = 0.0;
+  TopoEdgeType type_ = TET_FORWARD;
   const TopoNode* from_node_ = nullptr;
   const TopoNode* to_node_ = nullptr;
 };
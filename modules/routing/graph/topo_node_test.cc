@@ -88,7 +88,7 @@ TEST(TopoNodeTestSuit, basic_test) {
   Node node;
   GetNodeDetailForTest(&node, TEST_L1, TEST_R1);
   TopoNode topo_node(node);
-  ASSERT_EQ(node.DebugString(), topo_node.PbNode().DebugString());
+  ASSERT_EQ(-1, topo_node.Index());
   ASSERT_EQ(TEST_L1, topo_node.LaneId());
   ASSERT_EQ(TEST_R1, topo_node.RoadId());
   ASSERT_DOUBLE_EQ(TEST_MIDDLE_S, topo_node.AnchorPoint().x());
@@ -98,6 +98,25 @@ TEST(TopoNodeTestSuit, basic_test) {
   ASSERT_TRUE(topo_node.IsVirtual());
 }
 
+TEST(TopoNodeTestSuit, sub_node_test) {
+  Node node;
+  GetNodeDetailForTest(&node, TEST_L1, TEST_R1);
+  TopoNode topo_node(node);
+  TopoNode sub_node(&topo_node,
+                    NodeSRange(TEST_LANE_LENGTH / 2, TEST_LANE_LENGTH));
+  ASSERT_TRUE(sub_node.IsSubNode());
+  ASSERT_EQ(&topo_node, sub_node.OriginNode());
+  ASSERT_EQ(TEST_L1, sub_node.LaneId());
+  ASSERT_EQ(TEST_R1, sub_node.RoadId());
+  // halfway between the anchor of the lane and its last point
+  ASSERT_DOUBLE_EQ((TEST_MIDDLE_S + TEST_END_S) / 2,
+                   sub_node.AnchorPoint().x());
+  ASSERT_EQ(1, sub_node.LeftOutRange().size());
+  ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH / 2,
+                   sub_node.LeftOutRange().front().StartS());
+  ASSERT_DOUBLE_EQ(TEST_END_S, sub_node.LeftOutRange().front().EndS());
+}
+
 TEST(TopoEdgeTestSuit, basic_test) {
   Node node_1;
   Node node_2;
@@ -113,7 +132,6 @@ TEST(TopoEdgeTestSuit, basic_test) {
   const TopoNode* tn_2 = &topo_node_2;
   TopoEdge topo_edge(edge, tn_1, tn_2);
 
-  ASSERT_EQ(edge.DebugString(), topo_edge.PbEdge().DebugString());
   ASSERT_DOUBLE_EQ(TEST_EDGE_COST, topo_edge.Cost());
   ASSERT_EQ(TEST_L1, topo_edge.FromLaneId());
   ASSERT_EQ(TEST_L2, topo_edge.ToLaneId());
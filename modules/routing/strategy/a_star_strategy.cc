@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <queue>
 
@@ -213,6 +214,9 @@ void AStarStrategy::Clear() {
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (use_landmarks_) {
+    return graph_->LandmarkLowerBound(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = fabs(src_point.x() - dest_point.x()) +
@@ -225,7 +229,11 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
   Clear();
-  AINFO << "Start A* search algorithm.";
+  graph_ = graph;
+  use_landmarks_ =
+      FLAGS_enable_routing_landmark_heuristic && graph->HasLandmarks();
+  AINFO << "Start A* search algorithm"
+        << (use_landmarks_ ? " with landmarks." : ".");
 
   std::priority_queue<SearchNode> open_set_detail;
 
@@ -289,7 +297,10 @@ bool AStarStrategy::Search(const TopoGraph* graph,
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
       double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      // the anchor point heuristic has always been kept in g_score_, the
+      // landmark bound is a true lower bound and is kept out of it
+      const double score = use_landmarks_ ? tentative_g_score : f;
+      if (open_set_.count(to_node) != 0 && score >= g_score_[to_node]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
@@ -309,7 +320,7 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         enter_s_[to_node] = to_node_enter_s;
       }
 
-      g_score_[to_node] = f;
+      g_score_[to_node] = score;
       SearchNode next_node(to_node);
       next_node.f = f;
       open_set_detail.push(next_node);
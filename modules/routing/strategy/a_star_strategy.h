@@ -34,6 +34,9 @@ class AStarStrategy : public Strategy {
                       const TopoNode* src_node, const TopoNode* dest_node,
                       std::vector<NodeWithRange>* const result_nodes);
 
+  // nodes expanded by the last search
+  std::size_t NumExpandedNodes() const { return closed_set_.size(); }
+
  private:
   void Clear();
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
@@ -42,6 +45,8 @@ class AStarStrategy : public Strategy {
 
  private:
   bool change_lane_enabled_;
+  const TopoGraph* graph_ = nullptr;
+  bool use_landmarks_ = false;
   std::unordered_set<const TopoNode*> open_set_;
   std::unordered_set<const TopoNode*> closed_set_;
   std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * Times A* searches between random lanes of a routing graph, with the anchor
+ * point heuristic and with the landmark heuristic. Landmarks are created on
+ * the fly when the graph file has none.
+ **/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+DEFINE_string(benchmark_graph_file, "",
+              "routing graph to search, the routing map of --map_dir if empty");
+DEFINE_int32(benchmark_queries, 200, "random lane pairs to route between");
+
+namespace apollo {
+namespace routing {
+namespace {
+
+struct Timing {
+  int found = 0;
+  double search_ms = 0.0;
+  double expanded_nodes = 0.0;
+};
+
+Timing RunQueries(const TopoGraph& topo_graph,
+                  const std::vector<std::pair<const TopoNode*,
+                                              const TopoNode*>>& queries,
+                  const bool use_landmarks) {
+  FLAGS_enable_routing_landmark_heuristic = use_landmarks;
+  const std::unordered_map<const TopoNode*, std::vector<NodeSRange>>
+      black_map;
+  SubTopoGraph sub_graph(black_map);
+  AStarStrategy strategy(FLAGS_enable_change_lane_in_result);
+  Timing timing;
+  std::vector<NodeWithRange> result_nodes;
+  for (const auto& query : queries) {
+    const auto start = std::chrono::steady_clock::now();
+    if (strategy.Search(&topo_graph, &sub_graph, query.first, query.second,
+                        &result_nodes)) {
+      ++timing.found;
+    }
+    timing.search_ms += std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    timing.expanded_nodes += static_cast<double>(strategy.NumExpandedNodes());
+  }
+  timing.search_ms /= static_cast<double>(queries.size());
+  timing.expanded_nodes /= static_cast<double>(queries.size());
+  return timing;
+}
+
+int Run() {
+  const std::string graph_file = FLAGS_benchmark_graph_file.empty()
+                                     ? hdmap::RoutingMapFile()
+                                     : FLAGS_benchmark_graph_file;
+  Graph graph;
+  if (!cyber::common::GetProtoFromFile(graph_file, &graph)) {
+    AERROR << "Failed to read routing graph from " << graph_file;
+    return -1;
+  }
+  if (graph.landmark_size() == 0) {
+    landmark_creator::CreateLandmarks(FLAGS_routing_num_landmarks, &graph);
+  }
+  TopoGraph topo_graph;
+  if (!topo_graph.LoadGraph(graph) || graph.node_size() < 2) {
+    AERROR << "Failed to load routing graph from " << graph_file;
+    return -1;
+  }
+
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> node_index(0, graph.node_size() - 1);
+  std::vector<std::pair<const TopoNode*, const TopoNode*>> queries;
+  for (int i = 0; i < FLAGS_benchmark_queries; ++i) {
+    queries.emplace_back(
+        topo_graph.GetNode(graph.node(node_index(generator)).lane_id()),
+        topo_graph.GetNode(graph.node(node_index(generator)).lane_id()));
+  }
+
+  std::cout << graph.node_size() << " nodes, " << graph.edge_size()
+            << " edges, " << graph.landmark_size() << " landmarks"
+            << std::endl;
+  for (const bool use_landmarks : {false, true}) {
+    const auto timing = RunQueries(topo_graph, queries, use_landmarks);
+    std::cout << (use_landmarks ? "landmarks" : "anchor points") << ": "
+              << timing.found << "/" << queries.size() << " found, "
+              << timing.search_ms << " ms and " << timing.expanded_nodes
+              << " expanded nodes per search" << std::endl;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace routing
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::routing::Run();
+}
@@ -19,12 +19,15 @@
 #include <vector>
 
 #include "cyber/common/file.h"
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/compact_topo_graph.h"
 #include "modules/routing/topo_creator/edge_creator.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
 namespace apollo {
@@ -42,6 +45,9 @@ using ::google::protobuf::RepeatedPtrField;
 
 namespace {
 
+// nodes or edges created by one task
+constexpr size_t kCreateGrain = 64;
+
 bool IsAllowedToCross(const LaneBoundary& boundary) {
   for (const auto& boundary_type : boundary.boundary_type()) {
     if (boundary_type.types(0) != LaneBoundaryType::DOTTED_YELLOW &&
@@ -61,7 +67,14 @@ GraphCreator::GraphCreator(const std::string& base_map_file_path,
       dump_topo_file_path_(dump_topo_file_path),
       routing_conf_(routing_conf) {}
 
-bool GraphCreator::Create() {
+GraphCreator::GraphCreator(const hdmap::Map& base_map,
+                           const std::string& dump_topo_file_path,
+                           const RoutingConfig& routing_conf)
+    : dump_topo_file_path_(dump_topo_file_path),
+      pbmap_(base_map),
+      routing_conf_(routing_conf) {}
+
+bool GraphCreator::LoadBaseMap() {
   if (EndWith(base_map_file_path_, ".xml")) {
     if (!hdmap::adapter::OpendriveAdapter::LoadData(base_map_file_path_,
                                                     &pbmap_)) {
@@ -74,6 +87,14 @@ bool GraphCreator::Create() {
       return false;
     }
   }
+  return true;
+}
+
+bool GraphCreator::Create() {
+  // the base map is given to the constructor if it has no file path
+  if (!base_map_file_path_.empty() && !LoadBaseMap()) {
+    return false;
+  }
 
   AINFO << "Number of lanes: " << pbmap_.lane_size();
 
@@ -82,7 +103,8 @@ bool GraphCreator::Create() {
 
   node_index_map_.clear();
   road_id_map_.clear();
-  showed_edge_id_set_.clear();
+  showed_edge_set_.clear();
+  edge_ends_.clear();
 
   for (const auto& road : pbmap_.road()) {
     for (const auto& section : road.section()) {
@@ -96,6 +118,8 @@ bool GraphCreator::Create() {
   const double min_turn_radius =
       VehicleConfigHelper::GetConfig().vehicle_param().min_turn_radius();
 
+  // the lanes of the nodes, in the order of the nodes
+  std::vector<const hdmap::Lane*> node_lanes;
   for (const auto& lane : pbmap_.lane()) {
     const auto& lane_id = lane.id().id();
     if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
@@ -108,40 +132,57 @@ bool GraphCreator::Create() {
       ADEBUG << "The u-turn lane radius is too small for the vehicle to turn";
       continue;
     }
+    node_index_map_[lane_id] = static_cast<int>(node_lanes.size());
+    node_lanes.push_back(&lane);
+    graph_.add_node();
+  }
+
+  // every node and edge is created into its own slot of the graph, so the
+  // graph is the same whatever the number of threads
+  cyber::ParallelFor(0, node_lanes.size(), kCreateGrain, [&](size_t i) {
+    const auto& lane = *node_lanes[i];
+    const auto& lane_id = lane.id().id();
     AINFO << "Current lane id: " << lane_id;
-    node_index_map_[lane_id] = graph_.node_size();
     const auto iter = road_id_map_.find(lane_id);
     if (iter != road_id_map_.end()) {
       node_creator::GetPbNode(lane, iter->second, routing_conf_,
-                              graph_.add_node());
+                              graph_.mutable_node(static_cast<int>(i)));
     } else {
       AWARN << "Failed to find road id of lane " << lane_id;
-      node_creator::GetPbNode(lane, "", routing_conf_, graph_.add_node());
+      node_creator::GetPbNode(lane, "", routing_conf_,
+                              graph_.mutable_node(static_cast<int>(i)));
     }
-  }
+  });
 
-  for (const auto& lane : pbmap_.lane()) {
-    const auto& lane_id = lane.id().id();
-    if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
-      ADEBUG << "Ignored lane id: " << lane_id
-             << " because its type is NOT CITY_DRIVING.";
-      continue;
-    }
-    const auto& from_node = graph_.node(node_index_map_[lane_id]);
-
-    AddEdge(from_node, lane.successor_id(), Edge::FORWARD);
+  for (size_t i = 0; i < node_lanes.size(); ++i) {
+    const auto& lane = *node_lanes[i];
+    const int from_index = static_cast<int>(i);
+    AddEdge(from_index, lane.successor_id(), Edge::FORWARD);
     if (lane.length() < FLAGS_min_length_for_lane_change) {
       continue;
     }
     if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
-      AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT);
+      AddEdge(from_index, lane.left_neighbor_forward_lane_id(), Edge::LEFT);
     }
 
     if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
-      AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT);
+      AddEdge(from_index, lane.right_neighbor_forward_lane_id(), Edge::RIGHT);
     }
   }
 
+  for (size_t i = 0; i < edge_ends_.size(); ++i) {
+    graph_.add_edge();
+  }
+  cyber::ParallelFor(0, edge_ends_.size(), kCreateGrain, [&](size_t i) {
+    const auto& ends = edge_ends_[i];
+    edge_creator::GetPbEdge(graph_.node(ends.from_index),
+                            graph_.node(ends.to_index), ends.type,
+                            routing_conf_,
+                            graph_.mutable_edge(static_cast<int>(i)));
+  });
+
+  landmark_creator::CreateLandmarks(FLAGS_routing_num_landmarks, &graph_);
+
   if (!EndWith(dump_topo_file_path_, ".bin") &&
       !EndWith(dump_topo_file_path_, ".txt")) {
     AERROR << "Failed to dump topo data into file, incorrect file type "
@@ -161,15 +202,17 @@ bool GraphCreator::Create() {
     return false;
   }
   AINFO << "Bin file is dumped successfully. Path: " << bin_file;
+  CompactTopoGraph compact_graph;
+  const std::string compact_file = CompactTopoGraph::FilePath(bin_file);
+  if (!compact_graph.Build(graph_) || !compact_graph.Save(compact_file)) {
+    AERROR << "Failed to dump compact topo data into file " << compact_file;
+    return false;
+  }
+  AINFO << "Compact file is dumped successfully. Path: " << compact_file;
   return true;
 }
 
-std::string GraphCreator::GetEdgeID(const std::string& from_id,
-                                    const std::string& to_id) {
-  return from_id + "->" + to_id;
-}
-
-void GraphCreator::AddEdge(const Node& from_node,
+void GraphCreator::AddEdge(const int from_index,
                            const RepeatedPtrField<Id>& to_node_vec,
                            const Edge::DirectionType& type) {
   for (const auto& to_id : to_node_vec) {
@@ -178,18 +221,16 @@ void GraphCreator::AddEdge(const Node& from_node,
       ADEBUG << "Ignored lane [id = " << to_id.id();
       continue;
     }
-    const std::string edge_id = GetEdgeID(from_node.lane_id(), to_id.id());
-    if (showed_edge_id_set_.count(edge_id) != 0) {
-      continue;
-    }
-    showed_edge_id_set_.insert(edge_id);
     const auto& iter = node_index_map_.find(to_id.id());
     if (iter == node_index_map_.end()) {
       continue;
     }
-    const auto& to_node = graph_.node(iter->second);
-    edge_creator::GetPbEdge(from_node, to_node, type, routing_conf_,
-                            graph_.add_edge());
+    const uint64_t edge_key = (static_cast<uint64_t>(from_index) << 32) |
+                              static_cast<uint32_t>(iter->second);
+    if (!showed_edge_set_.insert(edge_key).second) {
+      continue;
+    }
+    edge_ends_.push_back({from_index, iter->second, type});
   }
 }
 
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "modules/map/proto/map.pb.h"
 #include "modules/routing/proto/routing_config.pb.h"
@@ -33,16 +35,32 @@ class GraphCreator {
                const std::string& dump_topo_file_path,
                const RoutingConfig& routing_conf);
 
+  /**
+   * @brief Create the graph of a base map already loaded, e.g. by a map tool
+   * writing all the maps from one parse.
+   */
+  GraphCreator(const hdmap::Map& base_map,
+               const std::string& dump_topo_file_path,
+               const RoutingConfig& routing_conf);
+
   ~GraphCreator() = default;
 
   bool Create();
 
  private:
+  bool LoadBaseMap();
+
+  // the nodes an edge to create connects
+  struct EdgeEnds {
+    int from_index;
+    int to_index;
+    Edge::DirectionType type;
+  };
+
   void InitForbiddenLanes();
-  std::string GetEdgeID(const std::string& from_id, const std::string& to_id);
 
   void AddEdge(
-      const Node& from_node,
+      const int from_index,
       const ::google::protobuf::RepeatedPtrField<hdmap::Id>& to_node_vec,
       const Edge::DirectionType& type);
 
@@ -55,7 +73,9 @@ class GraphCreator {
   Graph graph_;
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::string> road_id_map_;
-  std::unordered_set<std::string> showed_edge_id_set_;
+  // node indices of the edges added, from index in the high bits
+  std::unordered_set<uint64_t> showed_edge_set_;
+  std::vector<EdgeEnds> edge_ends_;
   std::unordered_set<std::string> forbidden_lane_id_set_;
 
   const RoutingConfig& routing_conf_;
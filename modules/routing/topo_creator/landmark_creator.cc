@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+struct Arc {
+  int to = 0;
+  double cost = 0.0;
+};
+
+using Adjacency = std::vector<std::vector<Arc>>;
+
+std::vector<double> Dijkstra(const Adjacency& adjacency, int source) {
+  std::vector<double> costs(adjacency.size(), kInfinity);
+  using Entry = std::pair<double, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  costs[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty()) {
+    const Entry top = queue.top();
+    queue.pop();
+    if (top.first > costs[top.second]) {
+      continue;
+    }
+    for (const Arc& arc : adjacency[top.second]) {
+      const double cost = top.first + arc.cost;
+      if (cost < costs[arc.to]) {
+        costs[arc.to] = cost;
+        queue.emplace(cost, arc.to);
+      }
+    }
+  }
+  return costs;
+}
+
+float ToLandmarkCost(const double cost) {
+  return std::isinf(cost) ? -1.0f : static_cast<float>(cost);
+}
+
+}  // namespace
+
+double GetSearchCost(const Edge& edge, const Node& from_node,
+                     const Node& to_node) {
+  double cost = edge.cost() + to_node.cost();
+  if (edge.direction_type() != Edge::FORWARD) {
+    cost -= (from_node.cost() + to_node.cost()) / 2.0;
+  }
+  // a lower bound has to hold on every path, negative costs would break
+  // the shortest path search
+  return std::max(0.0, cost);
+}
+
+void CreateLandmarks(int num_landmarks, Graph* graph) {
+  CHECK_NOTNULL(graph);
+  graph->clear_landmark();
+  const int num_nodes = graph->node_size();
+  num_landmarks = std::min(num_landmarks, num_nodes);
+  if (num_landmarks <= 0) {
+    return;
+  }
+
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < num_nodes; ++i) {
+    node_index_map[graph->node(i).lane_id()] = i;
+  }
+  Adjacency forward(num_nodes);
+  Adjacency backward(num_nodes);
+  for (const auto& edge : graph->edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      continue;
+    }
+    const int from = from_iter->second;
+    const int to = to_iter->second;
+    const double cost =
+        GetSearchCost(edge, graph->node(from), graph->node(to));
+    forward[from].push_back({to, cost});
+    backward[to].push_back({from, cost});
+  }
+
+  // distance of every node to the closest landmark picked so far, nodes
+  // unreachable from all of them are the farthest
+  std::vector<double> closest(num_nodes, kInfinity);
+  int next = 0;
+  for (int k = 0; k <= num_landmarks; ++k) {
+    // the two searches are independent, run them side by side
+    std::vector<double> costs[2];
+    cyber::ParallelFor(0, 2, 1, [&](size_t i) {
+      costs[i] = Dijkstra(i == 0 ? forward : backward, next);
+    });
+    const std::vector<double>& forward_costs = costs[0];
+    const std::vector<double>& backward_costs = costs[1];
+    if (k == 1) {
+      // the first search only seeds the selection, node 0 isn't a landmark
+      std::fill(closest.begin(), closest.end(), kInfinity);
+    }
+    if (k > 0) {
+      auto* landmark = graph->add_landmark();
+      landmark->set_lane_id(graph->node(next).lane_id());
+      for (int i = 0; i < num_nodes; ++i) {
+        landmark->add_forward_cost(ToLandmarkCost(forward_costs[i]));
+        landmark->add_backward_cost(ToLandmarkCost(backward_costs[i]));
+      }
+    }
+    for (int i = 0; i < num_nodes; ++i) {
+      closest[i] =
+          std::min(closest[i], std::min(forward_costs[i], backward_costs[i]));
+    }
+    const auto farthest = std::max_element(closest.begin(), closest.end());
+    if (*farthest <= 0.0) {
+      // every node is a landmark already
+      break;
+    }
+    next = static_cast<int>(farthest - closest.begin());
+  }
+  AINFO << "Created " << graph->landmark_size() << " routing landmarks.";
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+/**
+ * Cost of moving over an edge as AStarStrategy counts it: the edge and the
+ * node it enters, with half of both node costs taken off for lane changes.
+ */
+double GetSearchCost(const Edge& edge, const Node& from_node,
+                     const Node& to_node);
+
+/**
+ * Pick num_landmarks nodes spread over the graph, each as far as possible
+ * from the ones picked before, and add the search costs from and to each of
+ * them to the graph.
+ */
+void CreateLandmarks(int num_landmarks, Graph* graph);
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
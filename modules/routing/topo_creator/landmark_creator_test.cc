@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+namespace {
+
+void AddNode(const std::string& lane_id, const double cost, Graph* graph) {
+  auto* node = graph->add_node();
+  node->set_lane_id(lane_id);
+  node->set_length(10.0);
+  node->set_cost(cost);
+}
+
+void AddEdge(const std::string& from, const std::string& to,
+             const double cost, const Edge::DirectionType type,
+             Graph* graph) {
+  auto* edge = graph->add_edge();
+  edge->set_from_lane_id(from);
+  edge->set_to_lane_id(to);
+  edge->set_cost(cost);
+  edge->set_direction_type(type);
+}
+
+}  // namespace
+
+TEST(LandmarkCreatorTest, GetSearchCost) {
+  Node from_node;
+  from_node.set_cost(1.0);
+  Node to_node;
+  to_node.set_cost(3.0);
+  Edge edge;
+  edge.set_cost(5.0);
+  edge.set_direction_type(Edge::FORWARD);
+  EXPECT_DOUBLE_EQ(8.0, GetSearchCost(edge, from_node, to_node));
+  edge.set_direction_type(Edge::LEFT);
+  EXPECT_DOUBLE_EQ(6.0, GetSearchCost(edge, from_node, to_node));
+  edge.set_cost(0.0);
+  from_node.set_cost(10.0);
+  EXPECT_DOUBLE_EQ(0.0, GetSearchCost(edge, from_node, to_node));
+}
+
+TEST(LandmarkCreatorTest, CreateLandmarks) {
+  Graph graph;
+  AddNode("L1", 1.0, &graph);
+  AddNode("L2", 2.0, &graph);
+  AddNode("L3", 3.0, &graph);
+  AddEdge("L1", "L2", 0.5, Edge::FORWARD, &graph);
+  AddEdge("L2", "L3", 0.5, Edge::FORWARD, &graph);
+
+  CreateLandmarks(0, &graph);
+  EXPECT_EQ(0, graph.landmark_size());
+
+  // the end of the chain is the farthest from L1, then L1 from it
+  CreateLandmarks(2, &graph);
+  ASSERT_EQ(2, graph.landmark_size());
+  const auto& last = graph.landmark(0);
+  EXPECT_EQ("L3", last.lane_id());
+  ASSERT_EQ(3, last.forward_cost_size());
+  EXPECT_FLOAT_EQ(-1.0f, last.forward_cost(0));
+  EXPECT_FLOAT_EQ(-1.0f, last.forward_cost(1));
+  EXPECT_FLOAT_EQ(0.0f, last.forward_cost(2));
+  EXPECT_FLOAT_EQ(6.0f, last.backward_cost(0));
+  EXPECT_FLOAT_EQ(3.5f, last.backward_cost(1));
+  EXPECT_FLOAT_EQ(0.0f, last.backward_cost(2));
+  const auto& first = graph.landmark(1);
+  EXPECT_EQ("L1", first.lane_id());
+  EXPECT_FLOAT_EQ(0.0f, first.forward_cost(0));
+  EXPECT_FLOAT_EQ(2.5f, first.forward_cost(1));
+  EXPECT_FLOAT_EQ(6.0f, first.forward_cost(2));
+  EXPECT_FLOAT_EQ(-1.0f, first.backward_cost(1));
+
+  // no more landmarks than nodes
+  CreateLandmarks(10, &graph);
+  EXPECT_EQ(3, graph.landmark_size());
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
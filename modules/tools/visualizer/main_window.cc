@@ -57,7 +57,6 @@ const char* licenseMessage =
     "See the License for the specific language governing permissions and\n"
     "limitations under the License.\n";
 
-const char* pcTempObjGroupName = "pointcloud";
 const char* pcVertexPath = ":/shaders/pointcloud.vert";
 const char* pcFragPath = ":/shaders/grid_pointcloud.frag";
 const char* gridVertexPath = ":/shaders/grid.vert";
@@ -176,8 +175,11 @@ MainWindow::MainWindow(QWidget* parent)
 
       pointcloud_top_item_(nullptr),
       pointcloud_comboBox_(new QComboBox),
+      pointcloud_colormap_comboBox_(new QComboBox),
+      pointcloud_lod_comboBox_(new QComboBox),
       pointcloud_button_(new QPushButton),
       pointcloud_channel_Reader_(nullptr),
+      pointcloud_(nullptr),
 
       pointcloud_reader_mutex_(),
 
@@ -221,10 +223,25 @@ MainWindow::MainWindow(QWidget* parent)
   pointcloud_button_->setStyleSheet(globalTreeItemStyle);
   pointcloud_comboBox_->setStyleSheet(globalTreeItemStyle);
 
+  // in the order of PointCloud::Colormap
+  pointcloud_colormap_comboBox_->addItem("IntensityRamp");
+  pointcloud_colormap_comboBox_->addItem("Jet");
+  pointcloud_colormap_comboBox_->setStyleSheet(globalTreeItemStyle);
+  // item i keeps every (1 << i)-th point
+  pointcloud_lod_comboBox_->addItem("Full");
+  pointcloud_lod_comboBox_->addItem("1/2");
+  pointcloud_lod_comboBox_->addItem("1/4");
+  pointcloud_lod_comboBox_->addItem("1/8");
+  pointcloud_lod_comboBox_->setStyleSheet(globalTreeItemStyle);
+
   connect(pointcloud_button_, SIGNAL(clicked(bool)), this,
           SLOT(PlayRenderableObject(bool)));
   connect(pointcloud_comboBox_, SIGNAL(currentIndexChanged(int)), this,
           SLOT(ChangePointCloudChannel()));
+  connect(pointcloud_colormap_comboBox_, SIGNAL(currentIndexChanged(int)),
+          this, SLOT(ChangePointCloudColormap(int)));
+  connect(pointcloud_lod_comboBox_, SIGNAL(currentIndexChanged(int)), this,
+          SLOT(ChangePointCloudLevelOfDetail(int)));
 
   connect(ui_->treeWidget, SIGNAL(itemSelectionChanged()), this,
           SLOT(UpdateActions()));
@@ -679,6 +696,20 @@ void MainWindow::ActionOpenPointCloud(void) {
     }
   }
 
+  if (pointcloud_ == nullptr) {
+    // one point cloud renders every message of the channel
+    pointcloud_ = new PointCloud(1, 4, pointcloud_shader_);
+    if (!ui_->sceneWidget->AddPermanentRenderObj(pointcloud_)) {
+      delete pointcloud_;
+      pointcloud_ = nullptr;
+      QMessageBox::warning(this, tr("NO Enough Memory"),
+                           tr("Cannot create PointCloud!!!"), QMessageBox::Ok);
+      return;
+    }
+    ChangePointCloudColormap(pointcloud_colormap_comboBox_->currentIndex());
+    ChangePointCloudLevelOfDetail(pointcloud_lod_comboBox_->currentIndex());
+  }
+
   if (pointcloud_top_item_ == nullptr) {
     pointcloud_top_item_ = new QTreeWidgetItem(ui_->treeWidget);
     if (pointcloud_top_item_ == nullptr) {
@@ -699,6 +730,28 @@ void MainWindow::ActionOpenPointCloud(void) {
     item->setText(0, "ChannelName");
     ui_->treeWidget->setItemWidget(item, 1, pointcloud_comboBox_);
 
+    item = new QTreeWidgetItem(pointcloud_top_item_);
+    if (item == nullptr) {
+      QMessageBox::warning(this, tr("NO Enough Memory"),
+                           tr("Cannot create tree item for colormap!!!"),
+                           QMessageBox::Ok);
+      return;
+    }
+
+    item->setText(0, "Colormap");
+    ui_->treeWidget->setItemWidget(item, 1, pointcloud_colormap_comboBox_);
+
+    item = new QTreeWidgetItem(pointcloud_top_item_);
+    if (item == nullptr) {
+      QMessageBox::warning(this, tr("NO Enough Memory"),
+                           tr("Cannot create tree item for level of detail!!!"),
+                           QMessageBox::Ok);
+      return;
+    }
+
+    item->setText(0, "LevelOfDetail");
+    ui_->treeWidget->setItemWidget(item, 1, pointcloud_lod_comboBox_);
+
     item = new QTreeWidgetItem(pointcloud_top_item_);
     if (item == nullptr) {
       QMessageBox::warning(this, tr("NO Enough Memory"),
@@ -858,15 +911,8 @@ void MainWindow::PointCloudReaderCallback(
     const std::shared_ptr<const apollo::drivers::PointCloud>& pdata) {
   pointcloud_reader_mutex_.lock();
   pointcloud_reader_mutex_.unlock();
-  PointCloud* pc = new PointCloud(pdata->point_size(), 4, pointcloud_shader_);
-  if (pc) {
-    if (!pc->FillData(pdata) ||
-        !ui_->sceneWidget->AddTempRenderableObj(pcTempObjGroupName, pc)) {
-      delete pc;
-    }
-  } else {
-    std::cerr << "-----Cannot create PointCloud----------" << std::endl;
-  }
+  // decoded on this reader thread, uploaded by the next repaint
+  pointcloud_->FillData(pdata);
 }
 
 void MainWindow::PlayRenderableObject(bool b) {
@@ -1085,6 +1131,18 @@ void MainWindow::ChangePointCloudChannel() {
   }
 }
 
+void MainWindow::ChangePointCloudColormap(int index) {
+  if (pointcloud_ != nullptr) {
+    pointcloud_->set_colormap(index);
+  }
+}
+
+void MainWindow::ChangePointCloudLevelOfDetail(int index) {
+  if (pointcloud_ != nullptr) {
+    pointcloud_->set_level_of_detail_step(1 << index);
+  }
+}
+
 void MainWindow::ChangeVideoImgChannel() {
   QComboBox* obj = static_cast<QComboBox*>(QObject::sender());
   VideoImgProxy* theVideoImg =
@@ -29,6 +29,7 @@
 class FixedAspectRatioWidget;
 class Texture;
 class Grid;
+class PointCloud;
 class QAction;
 class QComboBox;
 class QTreeWidgetItem;
@@ -60,6 +61,8 @@ class MainWindow : public QMainWindow {
   void ActionOpenPointCloud(void);
   void PlayRenderableObject(bool);
   void ChangePointCloudChannel(void);
+  void ChangePointCloudColormap(int index);
+  void ChangePointCloudLevelOfDetail(int index);
 
   void ActionOpenImage(void);
   void PlayVideoImage(bool b);
@@ -125,8 +128,11 @@ class MainWindow : public QMainWindow {
 
   QTreeWidgetItem* pointcloud_top_item_;
   QComboBox* pointcloud_comboBox_;
+  QComboBox* pointcloud_colormap_comboBox_;
+  QComboBox* pointcloud_lod_comboBox_;
   QPushButton* pointcloud_button_;
   CyberChannReader<apollo::drivers::PointCloud>* pointcloud_channel_Reader_;
+  PointCloud* pointcloud_;
 
   QMutex pointcloud_reader_mutex_;
 
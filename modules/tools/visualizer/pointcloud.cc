@@ -16,49 +16,101 @@
 
 #include "modules/tools/visualizer/pointcloud.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstring>
 
 PointCloud::PointCloud(
     int pointCount, int vertexElementCount,
     const std::shared_ptr<QOpenGLShaderProgram>& shaderProgram)
-    : RenderableObject(pointCount, vertexElementCount, shaderProgram),
-      buffer_(nullptr) {}
-
-PointCloud::~PointCloud(void) {
-  if (buffer_) {
-    delete[] buffer_;
-    buffer_ = nullptr;
-  }
-}
+    : RenderableObject(kRingSlotCount * pointCount, vertexElementCount,
+                       shaderProgram),
+      frames_(),
+      writing_frame_(0),
+      ready_frame_(1),
+      drawing_frame_(2),
+      has_new_frame_(false),
+      frame_mutex_(),
+      slot_capacity_(pointCount),
+      slot_(0),
+      slot_point_count_(0),
+      level_of_detail_step_(1),
+      colormap_(INTENSITY_RAMP) {}
 
 bool PointCloud::FillVertexBuffer(GLfloat* pBuffer) {
-  if (buffer_ && pBuffer) {
-    memcpy(pBuffer, buffer_, VertexBufferSize());
-    delete[] buffer_;
-    buffer_ = nullptr;
-    return true;
-  } else {
-    std::cout << "---Error!!! cannot upload data to Graphics Card----"
-              << std::endl;
-    return false;
-  }
+  // the slots are filled by Draw as frames arrive
+  return pBuffer != nullptr;
 }
 
 bool PointCloud::FillData(
     const std::shared_ptr<const apollo::drivers::PointCloud>& pdata) {
-  assert(vertex_count() == pdata->point_size());
-  buffer_ = new GLfloat[vertex_count() * vertex_element_count()];
-  if (buffer_) {
-    GLfloat* tmp = buffer_;
+  const int step = std::max(level_of_detail_step_.load(), 1);
+  const int pointCount = (pdata->point_size() + step - 1) / step;
+
+  // only this thread touches the writing frame
+  std::vector<GLfloat>& frame = frames_[writing_frame_];
+  frame.resize(pointCount * vertex_element_count());
+  GLfloat* tmp = frame.data();
+  for (int i = 0; i < pdata->point_size();
+       i += step, tmp += vertex_element_count()) {
+    const apollo::drivers::PointXYZIT& point = pdata->point(i);
+    tmp[0] = point.x();
+    tmp[1] = point.z();
+    tmp[2] = -point.y();
+    tmp[3] = static_cast<float>(point.intensity());
+  }
+
+  std::lock_guard<std::mutex> lock(frame_mutex_);
+  std::swap(writing_frame_, ready_frame_);
+  has_new_frame_ = true;
+  return true;
+}
 
-    for (int i = 0; i < vertex_count(); ++i, tmp += vertex_element_count()) {
-      const apollo::drivers::PointXYZIT& point = pdata->point(i);
-      tmp[0] = point.x();
-      tmp[1] = point.z();
-      tmp[2] = -point.y();
-      tmp[3] = static_cast<float>(point.intensity());
+void PointCloud::Draw(void) {
+  bool hasNewFrame = false;
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (has_new_frame_) {
+      std::swap(drawing_frame_, ready_frame_);
+      has_new_frame_ = false;
+      hasNewFrame = true;
     }
-    return true;
   }
-  return false;
+  if (hasNewFrame) {
+    UploadFrame();
+  }
+  if (slot_point_count_ > 0) {
+    glDrawArrays(GetPrimitiveType(), slot_ * slot_capacity_,
+                 slot_point_count_);
+  }
+}
+
+void PointCloud::UploadFrame(void) {
+  const std::vector<GLfloat>& frame = frames_[drawing_frame_];
+  const int pointCount =
+      static_cast<int>(frame.size()) / vertex_element_count();
+  const int size = static_cast<int>(frame.size() * sizeof(GLfloat));
+
+  vbo_.bind();
+  if (pointCount > slot_capacity_) {
+    // grow with headroom, the point count varies from message to message
+    slot_capacity_ = pointCount + pointCount / 4;
+    set_vertex_count(kRingSlotCount * slot_capacity_);
+    vbo_.allocate(VertexBufferSize());
+  }
+  slot_ = (slot_ + 1) % kRingSlotCount;
+  const int offset = slot_ * slot_capacity_ * vertex_element_count() *
+                     static_cast<int>(sizeof(GLfloat));
+
+  void* pBuffer = vbo_.mapRange(offset, size,
+                                QOpenGLBuffer::RangeWrite |
+                                    QOpenGLBuffer::RangeInvalidate |
+                                    QOpenGLBuffer::RangeUnsynchronized);
+  if (pBuffer) {
+    memcpy(pBuffer, frame.data(), size);
+    vbo_.unmap();
+  } else {
+    vbo_.write(offset, frame.data(), size);
+  }
+  vbo_.release();
+  slot_point_count_ = pointCount;
 }
@@ -16,25 +16,74 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/tools/visualizer/renderable_object.h"
 
 class QOpenGLShaderProgram;
 
+/* A point cloud which keeps one vertex buffer for its whole life. FillData
+ * decodes each message on the thread of its channel reader into one of three
+ * frames, and Draw uploads the latest frame into the next slot of a ring in
+ * the vertex buffer, so neither waits for the other nor for the slot the GPU
+ * may still be drawing. */
 class PointCloud : public RenderableObject {
  public:
-  explicit PointCloud(int pointCount = 1, int vertex_element_count = 3,
+  enum Colormap {
+    INTENSITY_RAMP,
+    JET,
+  };
+
+  explicit PointCloud(int pointCount = 1, int vertex_element_count = 4,
                       const std::shared_ptr<QOpenGLShaderProgram>&
                           shaderProgram = NullRenderableObj);
-  ~PointCloud(void);
+  ~PointCloud(void) {}
 
   virtual GLenum GetPrimitiveType(void) const { return GL_POINTS; }
 
+  void SetupExtraUniforms(void) override {
+    shader_program_->setUniformValue("colormap", colormap_);
+  }
+
+  int colormap(void) const { return colormap_; }
+  void set_colormap(int colormap) { colormap_ = colormap; }
+
+  // every level_of_detail_step-th point of a message is kept
+  int level_of_detail_step(void) const { return level_of_detail_step_; }
+  void set_level_of_detail_step(int step) { level_of_detail_step_ = step; }
+
+  // called by one channel reader at a time, concurrently with Render
   bool FillData(
       const std::shared_ptr<const apollo::drivers::PointCloud>& pData);
 
+ protected:
+  bool FillVertexBuffer(GLfloat* pBuffer) override;
+  void Draw(void) override;
+  QOpenGLBuffer::UsagePattern GetUsagePattern(void) const override {
+    return QOpenGLBuffer::StreamDraw;
+  }
+
  private:
-  virtual bool FillVertexBuffer(GLfloat* vertexBuffer);
+  static constexpr int kRingSlotCount = 3;
+
+  void UploadFrame(void);
+
+  // the frames being written, ready to draw and drawn
+  std::vector<GLfloat> frames_[3];
+  int writing_frame_;
+  int ready_frame_;
+  int drawing_frame_;
+  bool has_new_frame_;
+  std::mutex frame_mutex_;
+
+  // points of each slot of the vertex buffer
+  int slot_capacity_;
+  int slot_;
+  int slot_point_count_;
 
-  GLfloat* buffer_;
+  std::atomic<int> level_of_detail_step_;
+  int colormap_;
 };
@@ -94,7 +94,7 @@ bool RenderableObject::Init(
     vao_.destroy();
     return false;
   }
-  vbo_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+  vbo_.setUsagePattern(GetUsagePattern());
   vbo_.bind();
 
   vbo_.allocate(VertexBufferSize());
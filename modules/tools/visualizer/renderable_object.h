@@ -71,6 +71,9 @@ class RenderableObject : protected QOpenGLFunctions {
   virtual void Draw(void) {
     glDrawArrays(GetPrimitiveType(), 0, vertex_count());
   }
+  virtual QOpenGLBuffer::UsagePattern GetUsagePattern(void) const {
+    return QOpenGLBuffer::StaticDraw;
+  }
 
   virtual void SetupAllAttrPointer(void) {
     glEnableVertexAttribArray(0);
@@ -18,12 +18,22 @@
 
 layout(location = 0) in vec4 vertPos;
 uniform mat4 mvp;
+uniform int colormap; // 0: intensity ramp, 1: jet
 out vec3 Color;
 
 void main(void)
 {
     gl_Position = mvp * vec4(vertPos.xyz, 1.0);
 
+    if(colormap == 1)
+    {
+        float t = clamp(vertPos.w / 255.0, 0.0, 1.0);
+        Color = clamp(vec3(1.5 - abs(4.0 * t - 3.0),
+                           1.5 - abs(4.0 * t - 2.0),
+                           1.5 - abs(4.0 * t - 1.0)), 0.0, 1.0);
+        return;
+    }
+
     float g = smoothstep(0.0, 256, vertPos.w);
     float r = 0.0;
     float b = 0.0;
@@ -16,6 +16,8 @@
 
 #include "modules/transform/buffer.h"
 
+#include "Eigen/Geometry"
+
 #include "cyber/cyber.h"
 
 namespace apollo {
@@ -23,7 +25,40 @@ namespace transform {
 
 static constexpr float kSecondToNanoFactor = 1e9f;
 
-Buffer::Buffer() : BufferCore() { Init(); }
+constexpr int Buffer::kMaxEdgeHistoryNum;
+constexpr uint64_t Buffer::kEdgeHistorySize;
+
+namespace {
+
+template <typename IsometryType>
+void IsometryToCyber(const IsometryType& transform,
+                     const std::string& frame_id,
+                     const std::string& child_frame_id, double timestamp_sec,
+                     apollo::transform::TransformStamped* trans_stamped) {
+  trans_stamped->mutable_header()->set_timestamp_sec(timestamp_sec);
+  trans_stamped->mutable_header()->set_frame_id(frame_id);
+  trans_stamped->set_child_frame_id(child_frame_id);
+  const Eigen::Vector3d translation = transform.translation();
+  const Eigen::Quaterniond rotation(transform.rotation());
+  auto* cyber_transform = trans_stamped->mutable_transform();
+  cyber_transform->mutable_translation()->set_x(translation.x());
+  cyber_transform->mutable_translation()->set_y(translation.y());
+  cyber_transform->mutable_translation()->set_z(translation.z());
+  cyber_transform->mutable_rotation()->set_qx(rotation.x());
+  cyber_transform->mutable_rotation()->set_qy(rotation.y());
+  cyber_transform->mutable_rotation()->set_qz(rotation.z());
+  cyber_transform->mutable_rotation()->set_qw(rotation.w());
+}
+
+}  // namespace
+
+Buffer::Buffer() : BufferCore() {
+  for (int i = 0; i < LOOKUP_PATH_NUM; ++i) {
+    lookup_count_[i].store(0);
+    lookup_nanoseconds_[i].store(0);
+  }
+  Init();
+}
 
 int Buffer::Init() {
   std::string node_name =
@@ -71,6 +106,7 @@ void Buffer::SubscriptionCallbackImpl(
   if (now.ToNanosecond() < last_update_.ToNanosecond()) {
     AINFO << "Detected jump back in time. Clearing TF buffer.";
     clear();
+    edge_history_epoch_.fetch_add(1, std::memory_order_release);
     // cache static transform stamped again.
     for (auto& msg : static_msgs_) {
       setTransform(msg, authority, true);
@@ -108,11 +144,283 @@ void Buffer::SubscriptionCallbackImpl(
         static_msgs_.push_back(trans_stamped);
       }
       setTransform(trans_stamped, authority, is_static);
+      if (!is_static) {
+        AddToEdgeHistory(trans_stamped);
+      }
     } catch (tf2::TransformException& ex) {
       std::string temp = ex.what();
       AERROR << "Failure to set recieved transform:" << temp.c_str();
     }
   }
+  if (is_static) {
+    UpdateStaticFrames();
+  }
+}
+
+const Buffer::EdgeHistory* Buffer::FindEdgeHistory(
+    const std::string& frame_id, const std::string& child_frame_id) const {
+  const int edge_history_num =
+      edge_history_num_.load(std::memory_order_acquire);
+  for (int i = 0; i < edge_history_num; ++i) {
+    const EdgeHistory* history = edge_histories_[i].get();
+    if (history->child_frame_id == child_frame_id &&
+        history->frame_id == frame_id) {
+      return history;
+    }
+  }
+  return nullptr;
+}
+
+void Buffer::AddToEdgeHistory(
+    const geometry_msgs::TransformStamped& trans_stamped) {
+  EdgeHistory* history = const_cast<EdgeHistory*>(FindEdgeHistory(
+      trans_stamped.header.frame_id, trans_stamped.child_frame_id));
+  if (history == nullptr) {
+    const int edge_history_num =
+        edge_history_num_.load(std::memory_order_relaxed);
+    if (edge_history_num == kMaxEdgeHistoryNum) {
+      return;
+    }
+    edge_histories_[edge_history_num].reset(new EdgeHistory(
+        trans_stamped.header.frame_id, trans_stamped.child_frame_id));
+    history = edge_histories_[edge_history_num].get();
+    edge_history_num_.store(edge_history_num + 1, std::memory_order_release);
+  }
+
+  const uint64_t epoch = edge_history_epoch_.load(std::memory_order_acquire);
+  if (history->epoch.load(std::memory_order_relaxed) != epoch) {
+    history->transforms.Clear();
+    history->epoch.store(epoch, std::memory_order_release);
+  }
+  EdgeTransform transform;
+  transform.translation[0] = trans_stamped.transform.translation.x;
+  transform.translation[1] = trans_stamped.transform.translation.y;
+  transform.translation[2] = trans_stamped.transform.translation.z;
+  transform.rotation[0] = trans_stamped.transform.rotation.x;
+  transform.rotation[1] = trans_stamped.transform.rotation.y;
+  transform.rotation[2] = trans_stamped.transform.rotation.z;
+  transform.rotation[3] = trans_stamped.transform.rotation.w;
+  const double timestamp_sec =
+      static_cast<double>(trans_stamped.header.stamp) / kSecondToNanoFactor;
+  if (!history->transforms.Push(timestamp_sec, transform)) {
+    // an older stamp does not jump the clock back, start over like tf2
+    // does when it drops its cache
+    history->transforms.Clear();
+    history->transforms.Push(timestamp_sec, transform);
+  }
+}
+
+bool Buffer::LookupEdgeHistory(
+    const std::string& target_frame, const std::string& source_frame,
+    uint64_t time_nanosecond,
+    apollo::transform::TransformStamped* trans_stamped) const {
+  const EdgeHistory* history = FindEdgeHistory(target_frame, source_frame);
+  Isometry transform;
+  double timestamp_sec = 0.0;
+  if (history == nullptr ||
+      !InterpolateEdgeHistory(*history, time_nanosecond, &transform,
+                              &timestamp_sec)) {
+    return false;
+  }
+  IsometryToCyber(transform, target_frame, source_frame, timestamp_sec,
+                  trans_stamped);
+  return true;
+}
+
+bool Buffer::InterpolateEdgeHistory(const EdgeHistory& history,
+                                    uint64_t time_nanosecond,
+                                    Isometry* transform,
+                                    double* timestamp_sec) const {
+  if (history.epoch.load(std::memory_order_acquire) !=
+      edge_history_epoch_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  EdgeTransformBuffer::Entry before;
+  EdgeTransformBuffer::Entry after;
+  double ratio = 0.0;
+  if (time_nanosecond == 0) {
+    // 0 asks for the latest transform
+    if (!history.transforms.GetLatest(&after)) {
+      return false;
+    }
+    before = after;
+    *timestamp_sec = after.timestamp;
+  } else {
+    const double time_sec =
+        static_cast<double>(time_nanosecond) / kSecondToNanoFactor;
+    if (!history.transforms.GetBracket(time_sec, &before, &after)) {
+      return false;
+    }
+    ratio =
+        (time_sec - before.timestamp) / (after.timestamp - before.timestamp);
+    *timestamp_sec = static_cast<double>(time_nanosecond) / 1e9;
+  }
+
+  const Eigen::Vector3d before_translation(before.value.translation);
+  const Eigen::Vector3d after_translation(after.value.translation);
+  const Eigen::Quaterniond before_rotation(
+      before.value.rotation[3], before.value.rotation[0],
+      before.value.rotation[1], before.value.rotation[2]);
+  const Eigen::Quaterniond after_rotation(
+      after.value.rotation[3], after.value.rotation[0],
+      after.value.rotation[1], after.value.rotation[2]);
+  transform->setIdentity();
+  transform->translate(before_translation +
+                       (after_translation - before_translation) * ratio);
+  transform->rotate(before_rotation.slerp(ratio, after_rotation));
+  return true;
+}
+
+void Buffer::UpdateStaticFrames() {
+  // the latest static transform of a child frame wins, like in tf2
+  std::unordered_map<std::string, const geometry_msgs::TransformStamped*>
+      parents;
+  for (const auto& msg : static_msgs_) {
+    parents[msg.child_frame_id] = &msg;
+  }
+
+  std::unordered_map<std::string, StaticFrame> static_frames;
+  for (const auto& parent : parents) {
+    // walk up to the root, then compose the chain back down
+    std::vector<const geometry_msgs::TransformStamped*> chain;
+    std::string frame_id = parent.first;
+    while (chain.size() <= parents.size()) {
+      const auto it = parents.find(frame_id);
+      if (it == parents.end()) {
+        break;
+      }
+      chain.push_back(it->second);
+      frame_id = it->second->header.frame_id;
+    }
+    if (chain.size() > parents.size()) {
+      AERROR << "Static transforms of frame " << parent.first
+             << " form a loop, skip caching them.";
+      continue;
+    }
+    StaticFrame& root = static_frames[frame_id];
+    root.root = frame_id;
+    root.root_transform.setIdentity();
+
+    StaticFrame static_frame;
+    static_frame.root = frame_id;
+    static_frame.root_transform.setIdentity();
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      const auto& transform = (*it)->transform;
+      static_frame.root_transform.translate(
+          Eigen::Vector3d(transform.translation.x, transform.translation.y,
+                          transform.translation.z));
+      static_frame.root_transform.rotate(
+          Eigen::Quaterniond(transform.rotation.w, transform.rotation.x,
+                             transform.rotation.y, transform.rotation.z)
+              .normalized());
+    }
+    static_frames[parent.first] = static_frame;
+  }
+
+  cyber::base::WriteLockGuard<cyber::base::AtomicRWLock> lock(
+      static_frames_lock_);
+  static_frames_.swap(static_frames);
+}
+
+bool Buffer::LookupStaticChain(
+    const std::string& target_frame, const std::string& source_frame,
+    uint64_t time_nanosecond,
+    apollo::transform::TransformStamped* trans_stamped) const {
+  Isometry transform;
+  double timestamp_sec = static_cast<double>(time_nanosecond) / 1e9;
+  {
+    cyber::base::ReadLockGuard<cyber::base::AtomicRWLock> lock(
+        static_frames_lock_);
+    const auto target_it = static_frames_.find(target_frame);
+    const auto source_it = static_frames_.find(source_frame);
+    if (target_it == static_frames_.end() &&
+        source_it == static_frames_.end()) {
+      return false;
+    }
+    const auto root_of = [this](const std::string& frame_id,
+                                Isometry* root_transform) -> std::string {
+      const auto it = static_frames_.find(frame_id);
+      if (it == static_frames_.end()) {
+        root_transform->setIdentity();
+        return frame_id;
+      }
+      *root_transform = it->second.root_transform;
+      return it->second.root;
+    };
+    Isometry target_transform;
+    Isometry source_transform;
+    const std::string target_root = root_of(target_frame, &target_transform);
+    const std::string source_root = root_of(source_frame, &source_transform);
+
+    if (target_root == source_root) {
+      transform = target_transform.inverse() * source_transform;
+    } else {
+      // look for the /tf link between the two static trees, it may point
+      // either way
+      const EdgeHistory* history = nullptr;
+      bool is_inverse = false;
+      Isometry target_side_transform;
+      Isometry source_side_transform;
+      const int edge_history_num =
+          edge_history_num_.load(std::memory_order_acquire);
+      for (int i = 0; i < edge_history_num && history == nullptr; ++i) {
+        const EdgeHistory* edge = edge_histories_[i].get();
+        if (root_of(edge->frame_id, &target_side_transform) == target_root &&
+            root_of(edge->child_frame_id, &source_side_transform) ==
+                source_root) {
+          history = edge;
+        } else if (root_of(edge->child_frame_id, &target_side_transform) ==
+                       target_root &&
+                   root_of(edge->frame_id, &source_side_transform) ==
+                       source_root) {
+          history = edge;
+          is_inverse = true;
+        }
+      }
+      Isometry edge_transform;
+      if (history == nullptr ||
+          !InterpolateEdgeHistory(*history, time_nanosecond, &edge_transform,
+                                  &timestamp_sec)) {
+        return false;
+      }
+      if (is_inverse) {
+        edge_transform = edge_transform.inverse();
+      }
+      transform = target_transform.inverse() * target_side_transform *
+                  edge_transform * source_side_transform.inverse() *
+                  source_transform;
+    }
+  }
+  IsometryToCyber(transform, target_frame, source_frame, timestamp_sec,
+                  trans_stamped);
+  return true;
+}
+
+void Buffer::RecordLookup(LookupPath path, uint64_t start_nanosecond) const {
+  lookup_count_[path].fetch_add(1, std::memory_order_relaxed);
+  lookup_nanoseconds_[path].fetch_add(
+      cyber::Time::Now().ToNanosecond() - start_nanosecond,
+      std::memory_order_relaxed);
+}
+
+Buffer::LookupStats Buffer::GetLookupStats() const {
+  const auto mean_latency_us = [this](LookupPath path) {
+    const uint64_t count = lookup_count_[path].load(std::memory_order_relaxed);
+    const uint64_t nanoseconds =
+        lookup_nanoseconds_[path].load(std::memory_order_relaxed);
+    return count == 0 ? 0.0
+                      : static_cast<double>(nanoseconds) /
+                            static_cast<double>(count) / 1e3;
+  };
+  LookupStats stats;
+  stats.edge_history_count = lookup_count_[EDGE_HISTORY].load();
+  stats.edge_history_latency_us = mean_latency_us(EDGE_HISTORY);
+  stats.static_chain_count = lookup_count_[STATIC_CHAIN].load();
+  stats.static_chain_latency_us = mean_latency_us(STATIC_CHAIN);
+  stats.buffer_core_count = lookup_count_[BUFFER_CORE].load();
+  stats.buffer_core_latency_us = mean_latency_us(BUFFER_CORE);
+  return stats;
 }
 
 void Buffer::TF2MsgToCyber(
@@ -149,11 +457,23 @@ void Buffer::TF2MsgToCyber(
 apollo::transform::TransformStamped Buffer::lookupTransform(
     const std::string& target_frame, const std::string& source_frame,
     const cyber::Time& time, const float timeout_second) const {
+  const uint64_t start_nanosecond = cyber::Time::Now().ToNanosecond();
+  apollo::transform::TransformStamped trans_stamped;
+  if (LookupEdgeHistory(target_frame, source_frame, time.ToNanosecond(),
+                        &trans_stamped)) {
+    RecordLookup(EDGE_HISTORY, start_nanosecond);
+    return trans_stamped;
+  }
+  if (LookupStaticChain(target_frame, source_frame, time.ToNanosecond(),
+                        &trans_stamped)) {
+    RecordLookup(STATIC_CHAIN, start_nanosecond);
+    return trans_stamped;
+  }
   tf2::Time tf2_time(time.ToNanosecond());
   geometry_msgs::TransformStamped tf2_trans_stamped =
       lookupTransform(target_frame, source_frame, tf2_time);
-  apollo::transform::TransformStamped trans_stamped;
   TF2MsgToCyber(tf2_trans_stamped, trans_stamped);
+  RecordLookup(BUFFER_CORE, start_nanosecond);
   return trans_stamped;
 }
 
@@ -173,6 +493,13 @@ bool Buffer::canTransform(const std::string& target_frame,
                           const std::string& source_frame,
                           const cyber::Time& time, const float timeout_second,
                           std::string* errstr) const {
+  apollo::transform::TransformStamped trans_stamped;
+  if (LookupEdgeHistory(target_frame, source_frame, time.ToNanosecond(),
+                        &trans_stamped) ||
+      LookupStaticChain(target_frame, source_frame, time.ToNanosecond(),
+                        &trans_stamped)) {
+    return true;
+  }
   uint64_t timeout_ns =
       static_cast<uint64_t>(timeout_second * kSecondToNanoFactor);
   uint64_t start_time = cyber::Time::Now().ToNanosecond();
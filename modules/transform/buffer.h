@@ -16,13 +16,20 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "Eigen/Geometry"
+
 #include "tf2/buffer_core.h"
 #include "tf2/convert.h"
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/time_indexed_ring_buffer.h"
 #include "cyber/node/node.h"
 #include "modules/transform/buffer_interface.h"
 
@@ -115,7 +122,61 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
                             const float timeout_second = 0.01f,
                             std::string* errstr = nullptr) const;
 
+  /**
+   * @brief How many single time lookups were answered from the /tf
+   * histories, from the cached static chains and by tf2::BufferCore, and
+   * their mean latency in microseconds
+   */
+  struct LookupStats {
+    uint64_t edge_history_count = 0;
+    double edge_history_latency_us = 0.0;
+    uint64_t static_chain_count = 0;
+    double static_chain_latency_us = 0.0;
+    uint64_t buffer_core_count = 0;
+    double buffer_core_latency_us = 0.0;
+  };
+  LookupStats GetLookupStats() const;
+
  private:
+  // A transform received on /tf, rotation is qx, qy, qz, qw.
+  struct EdgeTransform {
+    double translation[3];
+    double rotation[4];
+  };
+  typedef cyber::base::TimeIndexedRingBuffer<EdgeTransform> EdgeTransformBuffer;
+
+  // The recent transforms of one frame pair published on /tf. They are
+  // pushed by the /tf callback only and read by lookups without taking the
+  // BufferCore lock. The history is stale when its epoch is behind the
+  // buffer's, i.e. the buffer was cleared after a jump back in time.
+  struct EdgeHistory {
+    EdgeHistory(const std::string& frame_id, const std::string& child_frame_id)
+        : frame_id(frame_id),
+          child_frame_id(child_frame_id),
+          transforms(kEdgeHistorySize) {}
+    const std::string frame_id;
+    const std::string child_frame_id;
+    EdgeTransformBuffer transforms;
+    std::atomic<uint64_t> epoch = {0};
+  };
+
+  typedef Eigen::Transform<double, 3, Eigen::Isometry, Eigen::DontAlign>
+      Isometry;
+
+  // A frame of the /tf_static forest with the composed transform from the
+  // root of its tree, the frame without a static parent, to it.
+  struct StaticFrame {
+    std::string root;
+    Isometry root_transform;
+  };
+
+  enum LookupPath {
+    EDGE_HISTORY = 0,
+    STATIC_CHAIN = 1,
+    BUFFER_CORE = 2,
+    LOOKUP_PATH_NUM = 3,
+  };
+
   void SubscriptionCallback(
       const std::shared_ptr<const apollo::transform::TransformStampeds>&
           transform);
@@ -127,6 +188,44 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
           transform,
       bool is_static);
 
+  const EdgeHistory* FindEdgeHistory(const std::string& frame_id,
+                                     const std::string& child_frame_id) const;
+  void AddToEdgeHistory(const geometry_msgs::TransformStamped& trans_stamped);
+
+  /**
+   * @brief Look up a transform that was published directly between the two
+   * frames from its history, without locking.
+   * @return false if the frames are not one /tf pair or time is out of the
+   * history, the caller then falls back to tf2::BufferCore
+   */
+  bool LookupEdgeHistory(
+      const std::string& target_frame, const std::string& source_frame,
+      uint64_t time_nanosecond,
+      apollo::transform::TransformStamped* trans_stamped) const;
+  bool InterpolateEdgeHistory(const EdgeHistory& history,
+                              uint64_t time_nanosecond, Isometry* transform,
+                              double* timestamp_sec) const;
+
+  /**
+   * @brief Rebuild the composed static chains from all static transforms
+   * received so far, called when /tf_static changes.
+   */
+  void UpdateStaticFrames();
+
+  /**
+   * @brief Look up a transform whose frames are joined by static links and
+   * at most one /tf link, the static parts come from the cached chains and
+   * only the /tf link is interpolated.
+   * @return false if the frames are not joined that way, the caller then
+   * falls back to tf2::BufferCore
+   */
+  bool LookupStaticChain(
+      const std::string& target_frame, const std::string& source_frame,
+      uint64_t time_nanosecond,
+      apollo::transform::TransformStamped* trans_stamped) const;
+
+  void RecordLookup(LookupPath path, uint64_t start_nanosecond) const;
+
   void TF2MsgToCyber(
       const geometry_msgs::TransformStamped& tf2_trans_stamped,
       apollo::transform::TransformStamped& trans_stamped) const;  // NOLINT
@@ -137,6 +236,20 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
   std::shared_ptr<cyber::Reader<apollo::transform::TransformStampeds>>
       message_subscriber_tf_static_;
 
+  static constexpr int kMaxEdgeHistoryNum = 64;
+  static constexpr uint64_t kEdgeHistorySize = 1000;
+  std::array<std::unique_ptr<EdgeHistory>, kMaxEdgeHistoryNum>
+      edge_histories_;
+  std::atomic<int> edge_history_num_ = {0};
+  std::atomic<uint64_t> edge_history_epoch_ = {0};
+
+  std::unordered_map<std::string, StaticFrame> static_frames_;
+  mutable cyber::base::AtomicRWLock static_frames_lock_;
+
+  mutable std::array<std::atomic<uint64_t>, LOOKUP_PATH_NUM> lookup_count_;
+  mutable std::array<std::atomic<uint64_t>, LOOKUP_PATH_NUM>
+      lookup_nanoseconds_;
+
   cyber::Time last_update_;
   std::vector<geometry_msgs::TransformStamped> static_msgs_;
   DECLARE_SINGLETON(Buffer)
@@ -37,5 +37,15 @@ DEFINE_string(hdmap_file_name,
               "/apollo/modules/map/data/sunnyvale_big_loop/base_map.bin",
               "hdmap file name");
 DEFINE_double(traffic_light_distance, 1000.0, "traffic light distance");
+DEFINE_bool(x2v_trafficlight_push, true,
+            "publish v2x trafficlight as soon as it arrives from obu instead "
+            "of by x2v trafficlight timer");
+DEFINE_bool(v2x_carstatus_streaming, false,
+            "stream car status to obu in batches instead of unary calls");
+DEFINE_int32(v2x_carstatus_batch_size, 10,
+             "max car status msgs queued for one stream write, the oldest "
+             "ones are dropped beyond it");
+DEFINE_int32(v2x_latency_report_count, 100,
+             "number of msgs between two reports of grpc latency");
 }  // namespace v2x
 }  // namespace apollo
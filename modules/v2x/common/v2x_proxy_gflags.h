@@ -35,5 +35,9 @@ DECLARE_bool(debug_flag);
 DECLARE_int64(v2x_carstatus_timer_frequency);
 DECLARE_string(hdmap_file_name);
 DECLARE_double(traffic_light_distance);
+DECLARE_bool(x2v_trafficlight_push);
+DECLARE_bool(v2x_carstatus_streaming);
+DECLARE_int32(v2x_carstatus_batch_size);
+DECLARE_int32(v2x_latency_report_count);
 }  // namespace v2x
 }  // namespace apollo
@@ -71,10 +71,19 @@ V2xProxy::V2xProxy()
     AFATAL << "Failed to init os interface or obu interface";
     return;
   }
+  if (FLAGS_x2v_trafficlight_push) {
+    // published at once on the grpc thread instead of by the timer
+    obu_interface_->SetV2xTrafficLightCallback(
+        [this](const std::shared_ptr<IntersectionTrafficLightData>& msg) {
+          PublishTrafficLight(msg);
+        });
+  }
   first_flag_reader_ = node_->CreateReader<StatusResponse>(
       "/apollo/v2x/inner/sync_flag",
       [this](const std::shared_ptr<const StatusResponse>& msg) {
-        x2v_trafficlight_timer_->Start();
+        if (!FLAGS_x2v_trafficlight_push) {
+          x2v_trafficlight_timer_->Start();
+        }
       });
   if (first_flag_reader_ == nullptr) {
     AERROR << "Create sync flag reader failed";
@@ -86,6 +95,11 @@ V2xProxy::V2xProxy()
   init_flag_ = true;
 }
 
+V2xProxy::~V2xProxy() {
+  // stop the grpc threads first, they may publish traffic light with hdmap
+  obu_interface_.reset();
+}
+
 bool V2xProxy::InitFlag() { return init_flag_; }
 
 bool V2xProxy::TrafficLightProc(CurrentLaneTrafficLight* msg) {
@@ -127,20 +141,25 @@ bool V2xProxy::TrafficLightProc(CurrentLaneTrafficLight* msg) {
 void V2xProxy::OnX2vTrafficLightTimer() {
   x2v_trafficlight_->Clear();
   obu_interface_->GetV2xTrafficLightFromObu(x2v_trafficlight_);
-  if (!x2v_trafficlight_->has_current_lane_trafficlight()) {
+  PublishTrafficLight(x2v_trafficlight_);
+}
+
+void V2xProxy::PublishTrafficLight(
+    const std::shared_ptr<IntersectionTrafficLightData>& msg) {
+  if (!msg->has_current_lane_trafficlight()) {
     AERROR << "Error:v2x trafficlight ignore, no traffic light contained.";
     return;
   }
-  auto current_traff = x2v_trafficlight_->mutable_current_lane_trafficlight();
+  auto current_traff = msg->mutable_current_lane_trafficlight();
   if (current_traff->single_traffic_light_size() <= 0) {
     AERROR << "Error:v2x trafficlight ignore, no traffic light contained.";
     return;
   }
-  ADEBUG << x2v_trafficlight_->DebugString();
+  ADEBUG << msg->DebugString();
   if (!TrafficLightProc(current_traff)) {
     return;
   }
-  os_interface_->SendV2xTrafficLightToOs(x2v_trafficlight_);
+  os_interface_->SendV2xTrafficLightToOs(msg);
 }
 
 void V2xProxy::OnV2xCarStatusTimer() {
@@ -36,7 +36,7 @@ namespace v2x {
 class V2xProxy {
  public:
   V2xProxy();
-  ~V2xProxy() {}
+  ~V2xProxy();
   bool InitFlag();
 
  private:
@@ -54,6 +54,12 @@ class V2xProxy {
    */
   void OnX2vTrafficLightTimer();
 
+  /* function that publishes traffic light from obu to apollo os
+  @param input traffic light msg, mutated by the proc according to hdmap
+  */
+  void PublishTrafficLight(
+      const std::shared_ptr<IntersectionTrafficLightData> &msg);
+
   /* function car to obu car status timer callback
    */
   void OnV2xCarStatusTimer();
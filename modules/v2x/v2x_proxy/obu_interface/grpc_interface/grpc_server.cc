@@ -27,7 +27,9 @@ namespace v2x {
 using apollo::perception::PerceptionObstacles;
 using grpc::Status;
 
-GrpcServerImpl::GrpcServerImpl() : node_(cyber::CreateNode("v2x_grpc_server")) {
+GrpcServerImpl::GrpcServerImpl()
+    : traffic_light_latency_("obu to car trafficlight"),
+      node_(cyber::CreateNode("v2x_grpc_server")) {
   CHECK(node_) << "Create v2x grpc server node failed";
   first_flag_writer_ =
       node_->CreateWriter<StatusResponse>("/apollo/v2x/inner/sync_flag");
@@ -65,22 +67,43 @@ grpc::Status GrpcServerImpl::SendV2xTrafficLight(
     grpc::ServerContext* /* context */,
     const IntersectionTrafficLightData* request, StatusResponse* response) {
   ADEBUG << "Received SendV2xTrafficLight request from client! \n";
-  if (request->current_lane_trafficlight().single_traffic_light_size() == 0) {
+  if (!ReceiveTrafficLight(*request, response)) {
+    return Status::CANCELLED;
+  }
+  response->set_status(true);
+  ADEBUG << "SendV2xTrafficLight response success.";
+  return Status::OK;
+}
+
+bool GrpcServerImpl::ReceiveTrafficLight(
+    const IntersectionTrafficLightData& request, StatusResponse* response) {
+  if (request.current_lane_trafficlight().single_traffic_light_size() == 0) {
     response->set_status(false);
     response->set_info("error v2x traffic light size == 0");
     AERROR << "SendV2xTrafficLight request has no traffic light";
-    return Status::CANCELLED;
+    return false;
   }
-  if (!request->has_header()) {
+  if (!request.has_header()) {
     response->set_status(false);
     response->set_info(
         "error no header in IntersectionTrafficLightData request");
     AERROR << "SendV2xTrafficLight request has no header";
-    return Status::CANCELLED;
+    return false;
+  }
+  if (request.header().has_timestamp_sec()) {
+    traffic_light_latency_.Add(
+        (cyber::Time::Now().ToSecond() - request.header().timestamp_sec()) *
+        1000.0);
   }
+  std::shared_ptr<IntersectionTrafficLightData> trafficlight;
+  TrafficLightCallback callback;
   {
     std::lock_guard<std::mutex> guard(traffic_light_mutex_);
-    latest_trafficlight_.CopyFrom(*request);
+    latest_trafficlight_.CopyFrom(request);
+    if (traffic_light_callback_) {
+      trafficlight = std::make_shared<IntersectionTrafficLightData>(request);
+      callback = traffic_light_callback_;
+    }
   }
   if (first_recv_flag_) {
     auto msg = std::make_shared<StatusResponse>();
@@ -92,9 +115,101 @@ grpc::Status GrpcServerImpl::SendV2xTrafficLight(
       AERROR << "grpc sync flag send failed";
     }
   }
-  response->set_status(true);
-  ADEBUG << "SendV2xTrafficLight response success.";
-  return Status::OK;
+  if (callback) {
+    callback(trafficlight);
+  }
+  return true;
+}
+
+/* one v2x trafficlight stream, which has at most one operation in flight on
+the completion queue and is the tag of it
+*/
+class GrpcServerImpl::TrafficLightStream {
+ public:
+  TrafficLightStream(GrpcServerImpl* server, grpc::ServerCompletionQueue* cq)
+      : server_(server), cq_(cq), reader_(&context_) {
+    server_->RequestStreamV2xTrafficLight(&context_, &reader_, cq_, cq_,
+                                          this);
+  }
+
+  /* function that advances the stream when its operation completes, called
+  with stream_mutex_ locked
+  @param input whether the operation succeeded
+  */
+  void Proceed(const bool ok) {
+    if (server_->stream_stopped_) {
+      delete this;
+      return;
+    }
+    switch (state_) {
+      case State::kConnecting:
+        if (!ok) {
+          delete this;
+          return;
+        }
+        // wait for the next stream while serving this one
+        new TrafficLightStream(server_, cq_);
+        state_ = State::kReading;
+        reader_.Read(&request_, this);
+        return;
+      case State::kReading:
+        if (!ok) {
+          // the client has finished writing
+          response_.set_status(rejected_count_ == 0);
+          state_ = State::kFinishing;
+          reader_.Finish(response_, Status::OK, this);
+          return;
+        }
+        if (!server_->ReceiveTrafficLight(request_, &response_)) {
+          ++rejected_count_;
+        }
+        request_.Clear();
+        reader_.Read(&request_, this);
+        return;
+      case State::kFinishing:
+        delete this;
+        return;
+    }
+  }
+
+ private:
+  enum class State { kConnecting, kReading, kFinishing };
+
+  GrpcServerImpl* server_;
+  grpc::ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  grpc::ServerAsyncReader<StatusResponse, IntersectionTrafficLightData> reader_;
+  State state_ = State::kConnecting;
+  IntersectionTrafficLightData request_;
+  StatusResponse response_;
+  int rejected_count_ = 0;
+};
+
+void GrpcServerImpl::HandleStreams(grpc::ServerCompletionQueue* cq) {
+  {
+    std::lock_guard<std::mutex> guard(stream_mutex_);
+    if (!stream_stopped_) {
+      new TrafficLightStream(this, cq);
+    }
+  }
+  void* tag = nullptr;
+  bool ok = false;
+  while (cq->Next(&tag, &ok)) {
+    std::lock_guard<std::mutex> guard(stream_mutex_);
+    static_cast<TrafficLightStream*>(tag)->Proceed(ok);
+  }
+}
+
+void GrpcServerImpl::StopStreams() {
+  // no operation is started after this, so the queue can be shut down
+  std::lock_guard<std::mutex> guard(stream_mutex_);
+  stream_stopped_ = true;
+}
+
+void GrpcServerImpl::SetTrafficLightCallback(
+    const TrafficLightCallback& callback) {
+  std::lock_guard<std::mutex> guard(traffic_light_mutex_);
+  traffic_light_callback_ = callback;
 }
 
 void GrpcServerImpl::GetMsgFromGrpc(
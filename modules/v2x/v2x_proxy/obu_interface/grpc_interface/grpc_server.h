@@ -21,16 +21,29 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 
 #include "cyber/cyber.h"
 #include "modules/v2x/proto/v2x_service_obu_to_car.grpc.pb.h"
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/latency_counter.h"
 
 namespace apollo {
 namespace v2x {
 
-class GrpcServerImpl final : public ObuToCar::Service {
+/* serves the unary methods synchronously and StreamV2xTrafficLight on a
+completion queue
+*/
+class GrpcServerImpl final
+    : public ObuToCar::WithAsyncMethod_StreamV2xTrafficLight<
+          ObuToCar::Service> {
  public:
+  using TrafficLightCallback =
+      std::function<void(const std::shared_ptr<IntersectionTrafficLightData>&)>;
+
   /* construct function
    */
   GrpcServerImpl();
@@ -56,6 +69,23 @@ class GrpcServerImpl final : public ObuToCar::Service {
                                    const IntersectionTrafficLightData* request,
                                    StatusResponse* response);
 
+  /* function that serves the v2x trafficlight streams until the completion
+  queue is shut down
+  @param input completion queue of the server
+  */
+  void HandleStreams(grpc::ServerCompletionQueue* cq);
+
+  /* function that stops serving the streams, called before the server and
+  the completion queue are shut down
+  */
+  void StopStreams();
+
+  /* function that sets the callback of every v2x trafficlight received, from
+  either the unary or the streaming method
+  @param input callback on the grpc thread the trafficlight is received by
+  */
+  void SetTrafficLightCallback(const TrafficLightCallback& callback);
+
   /* function that get latest msg from grpc
   @param output shared_ptr
   */
@@ -64,12 +94,25 @@ class GrpcServerImpl final : public ObuToCar::Service {
   void GetMsgFromGrpc(const std::shared_ptr<IntersectionTrafficLightData>& ptr);
 
  private:
+  class TrafficLightStream;
+
+  /* function that verifies and stores the v2x trafficlight received
+  @param input v2x trafficlight
+  @param output response with the error of an invalid trafficlight
+  */
+  bool ReceiveTrafficLight(const IntersectionTrafficLightData& request,
+                           StatusResponse* response);
+
   std::mutex traffic_light_mutex_;
   std::mutex obstacles_mutex_;
   apollo::perception::PerceptionObstacles latest_obstacles_;
   IntersectionTrafficLightData latest_trafficlight_;
+  TrafficLightCallback traffic_light_callback_;
+  LatencyCounter traffic_light_latency_;
   bool init_flag_ = false;
-  bool first_recv_flag_ = true;
+  std::atomic<bool> first_recv_flag_{true};
+  std::mutex stream_mutex_;
+  bool stream_stopped_ = false;
   std::unique_ptr<cyber::Node> node_;
   std::shared_ptr<cyber::Writer<StatusResponse>> first_flag_writer_ = nullptr;
 };
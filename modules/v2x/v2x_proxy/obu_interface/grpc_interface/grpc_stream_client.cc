@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file grpc_stream_client.cc
+ * @brief define v2x proxy module and onboard unit interface grpc async
+ * streaming implement
+ */
+
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/grpc_stream_client.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace v2x {
+
+using grpc::Channel;
+using grpc::ClientContext;
+
+GrpcStreamClientImpl::GrpcStreamClientImpl(std::shared_ptr<Channel> channel)
+    : stub_(CarToObu::NewStub(channel)), ack_latency_("car status ack") {
+  thread_ptr_.reset(
+      new std::thread(&GrpcStreamClientImpl::ThreadRunCompletionQueue, this));
+  AINFO << "GrpcStreamClientImpl initial success";
+  init_flag_ = true;
+}
+
+GrpcStreamClientImpl::~GrpcStreamClientImpl() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    exit_flag_ = true;
+    if (stream_ == nullptr) {
+      cq_.Shutdown();
+    } else {
+      // the queue is shut down once the cancelled stream is finished
+      context_->TryCancel();
+    }
+  }
+  thread_ptr_->join();
+  AINFO << "close grpc stream client success, " << dropped_count_
+        << " car status msgs dropped";
+}
+
+void GrpcStreamClientImpl::SendMsgToGrpc(
+    const std::shared_ptr<CarStatus> &msg) {
+  // verify CarStatus msg valid
+  if (!msg->has_localization()) {
+    AERROR << "SendCarStatusToObu msg is not valid";
+    return;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (exit_flag_) {
+    return;
+  }
+  auto *car_status = pending_batch_.mutable_car_status();
+  if (car_status->size() >= std::max(FLAGS_v2x_carstatus_batch_size, 1)) {
+    car_status->DeleteSubrange(0, 1);
+    ++dropped_count_;
+    AWARN_EVERY(100) << "stream of car status is behind, " << dropped_count_
+                     << " msgs dropped";
+  }
+  car_status->Add()->CopyFrom(*msg);
+  if (stream_ == nullptr) {
+    StartStream();
+  } else if (connected_ && !broken_ && !write_in_flight_) {
+    WriteBatch();
+  }
+}
+
+void GrpcStreamClientImpl::ThreadRunCompletionQueue() {
+  void *tag = nullptr;
+  bool ok = false;
+  while (cq_.Next(&tag, &ok)) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    OnCompletion(static_cast<Operation>(reinterpret_cast<intptr_t>(tag)), ok);
+  }
+}
+
+void GrpcStreamClientImpl::OnCompletion(const Operation operation,
+                                        const bool ok) {
+  switch (operation) {
+    case Operation::kStart:
+      connected_ = ok;
+      break;
+    case Operation::kWrite:
+      write_in_flight_ = false;
+      break;
+    case Operation::kRead:
+      read_in_flight_ = false;
+      if (ok && !unacked_batches_.empty()) {
+        const std::chrono::duration<double, std::milli> time_used =
+            std::chrono::steady_clock::now() - unacked_batches_.front();
+        unacked_batches_.pop_front();
+        ack_latency_.Add(time_used.count());
+        if (!ack_.updated()) {
+          AERROR << "stream StreamCarStatus batch not updated by obu";
+        }
+      }
+      break;
+    case Operation::kFinish:
+      if (!finish_status_.ok()) {
+        AERROR << "stream StreamCarStatus error : code "
+               << finish_status_.error_code() << " "
+               << finish_status_.error_message();
+      }
+      stream_.reset();
+      context_.reset();
+      connected_ = false;
+      broken_ = false;
+      unacked_batches_.clear();
+      if (exit_flag_) {
+        cq_.Shutdown();
+      }
+      return;
+  }
+  if (!ok || exit_flag_) {
+    broken_ = true;
+  }
+  if (broken_) {
+    // finish only once no read or write is in flight any more
+    if (!read_in_flight_ && !write_in_flight_) {
+      stream_->Finish(&finish_status_, ToTag(Operation::kFinish));
+    }
+    return;
+  }
+  if (!read_in_flight_) {
+    read_in_flight_ = true;
+    stream_->Read(&ack_, ToTag(Operation::kRead));
+  }
+  if (!write_in_flight_ && pending_batch_.car_status_size() > 0) {
+    WriteBatch();
+  }
+}
+
+void *GrpcStreamClientImpl::ToTag(const Operation operation) {
+  return reinterpret_cast<void *>(static_cast<intptr_t>(operation));
+}
+
+void GrpcStreamClientImpl::StartStream() {
+  context_.reset(new ClientContext());
+  stream_ = stub_->AsyncStreamCarStatus(context_.get(), &cq_,
+                                        ToTag(Operation::kStart));
+}
+
+void GrpcStreamClientImpl::WriteBatch() {
+  sending_batch_.Clear();
+  sending_batch_.Swap(&pending_batch_);
+  write_in_flight_ = true;
+  unacked_batches_.push_back(std::chrono::steady_clock::now());
+  stream_->Write(sending_batch_, ToTag(Operation::kWrite));
+}
+
+}  // namespace v2x
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file grpc_stream_client.h
+ * @brief define v2x proxy module and onboard unit interface grpc async
+ * streaming implement
+ */
+
+#pragma once
+
+#include <grpc++/grpc++.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "modules/v2x/common/v2x_proxy_gflags.h"
+#include "modules/v2x/proto/v2x_service_car_to_obu.grpc.pb.h"
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/latency_counter.h"
+
+namespace apollo {
+namespace v2x {
+
+/* car status client over one bidirectional stream, driven by a completion
+queue. Msgs sent while the previous write is in flight are batched into the
+next write, and every batch is acked by the obu. The stream is reconnected by
+the next msg after it broke.
+*/
+class GrpcStreamClientImpl {
+ public:
+  /* construct function
+  @param input grpc channel to the obu
+  */
+  explicit GrpcStreamClientImpl(std::shared_ptr<grpc::Channel> channel);
+
+  ~GrpcStreamClientImpl();
+
+  bool InitFlag() { return init_flag_; }
+
+  /*function that queues car status msg for the next write of the stream
+  @param input carstatus type msg shared ptr
+  */
+  void SendMsgToGrpc(const std::shared_ptr<CarStatus> &msg);
+
+ private:
+  enum class Operation { kStart = 1, kWrite, kRead, kFinish };
+
+  static void *ToTag(Operation operation);
+
+  /* thread function that handles the completion queue
+   */
+  void ThreadRunCompletionQueue();
+
+  /* functions that advance the stream, called with mutex_ locked
+   */
+  void OnCompletion(Operation operation, bool ok);
+  void StartStream();
+  void WriteBatch();
+
+  std::unique_ptr<CarToObu::Stub> stub_;
+  grpc::CompletionQueue cq_;
+  std::unique_ptr<std::thread> thread_ptr_;
+
+  std::mutex mutex_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  std::unique_ptr<grpc::ClientAsyncReaderWriter<CarStatusBatch, UpdateStatus>>
+      stream_;
+  bool connected_ = false;
+  bool broken_ = false;
+  bool read_in_flight_ = false;
+  bool write_in_flight_ = false;
+  bool exit_flag_ = false;
+  CarStatusBatch pending_batch_;
+  // the batch of the write in flight
+  CarStatusBatch sending_batch_;
+  UpdateStatus ack_;
+  grpc::Status finish_status_;
+  // write times of the batches not acked yet
+  std::deque<std::chrono::steady_clock::time_point> unacked_batches_;
+  LatencyCounter ack_latency_;
+  uint64_t dropped_count_ = 0;
+  bool init_flag_ = false;
+};
+
+}  // namespace v2x
+}  // namespace apollo
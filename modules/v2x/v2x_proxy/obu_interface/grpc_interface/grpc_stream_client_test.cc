@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file grpc_stream_client_test.cc
+ * @brief test v2x proxy module and onboard unit interface grpc async
+ * streaming implement
+ */
+
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/grpc_stream_client.h"
+
+#include "cyber/cyber.h"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace v2x {
+
+TEST(GrpcStreamClientImplTest, SendWithoutObu) {
+  apollo::cyber::Init("grpc_stream_client_test");
+  GrpcStreamClientImpl grpc_client(
+      grpc::CreateChannel(FLAGS_grpc_client_host + ":" + FLAGS_grpc_client_port,
+                          grpc::InsecureChannelCredentials()));
+  EXPECT_TRUE(grpc_client.InitFlag());
+  // the stream fails to connect and is finished by the destructor
+  auto msg = std::make_shared<CarStatus>();
+  msg->mutable_localization()->mutable_header()->set_timestamp_sec(1.0);
+  grpc_client.SendMsgToGrpc(msg);
+  grpc_client.SendMsgToGrpc(msg);
+}
+}  // namespace v2x
+}  // namespace apollo
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file latency_counter.cc
+ * @brief define latency statistics of v2x proxy grpc msgs
+ */
+
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/latency_counter.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/v2x/common/v2x_proxy_gflags.h"
+
+namespace apollo {
+namespace v2x {
+
+LatencyCounter::LatencyCounter(const std::string &name) : name_(name) {}
+
+void LatencyCounter::Add(const double latency_ms) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  ++count_;
+  sum_ms_ += latency_ms;
+  max_ms_ = std::max(max_ms_, latency_ms);
+  ++report_count_;
+  report_sum_ms_ += latency_ms;
+  report_max_ms_ = std::max(report_max_ms_, latency_ms);
+  if (report_count_ <
+      static_cast<uint64_t>(std::max(FLAGS_v2x_latency_report_count, 1))) {
+    return;
+  }
+  AINFO << name_ << " latency of last " << report_count_
+        << " msgs: mean " << report_sum_ms_ / static_cast<double>(report_count_)
+        << "ms, max " << report_max_ms_ << "ms";
+  report_count_ = 0;
+  report_sum_ms_ = 0.0;
+  report_max_ms_ = 0.0;
+}
+
+uint64_t LatencyCounter::count() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return count_;
+}
+
+double LatencyCounter::mean_ms() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return count_ == 0 ? 0.0 : sum_ms_ / static_cast<double>(count_);
+}
+
+double LatencyCounter::max_ms() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return max_ms_;
+}
+
+}  // namespace v2x
+}  // namespace apollo
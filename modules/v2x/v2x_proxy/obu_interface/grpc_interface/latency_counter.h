@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file latency_counter.h
+ * @brief define latency statistics of v2x proxy grpc msgs
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace apollo {
+namespace v2x {
+
+class LatencyCounter {
+ public:
+  /* construct function
+  @param input name of the msgs in the latency reports
+  */
+  explicit LatencyCounter(const std::string &name);
+
+  ~LatencyCounter() {}
+
+  /* function that adds the latency of one msg, and reports the latency of
+  every FLAGS_v2x_latency_report_count msgs
+  @param input latency in ms
+  */
+  void Add(double latency_ms);
+
+  /* functions that return the statistics of all msgs added
+   */
+  uint64_t count() const;
+  double mean_ms() const;
+  double max_ms() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::string name_;
+  uint64_t count_ = 0;
+  double sum_ms_ = 0.0;
+  double max_ms_ = 0.0;
+  // statistics since the last report
+  uint64_t report_count_ = 0;
+  double report_sum_ms_ = 0.0;
+  double report_max_ms_ = 0.0;
+};
+
+}  // namespace v2x
+}  // namespace apollo
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file latency_counter_test.cc
+ * @brief test latency statistics of v2x proxy grpc msgs
+ */
+
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/latency_counter.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/v2x/common/v2x_proxy_gflags.h"
+
+namespace apollo {
+namespace v2x {
+
+TEST(LatencyCounterTest, Add) {
+  FLAGS_v2x_latency_report_count = 2;
+  LatencyCounter counter("test");
+  EXPECT_EQ(0U, counter.count());
+  EXPECT_DOUBLE_EQ(0.0, counter.mean_ms());
+  counter.Add(1.0);
+  counter.Add(5.0);
+  counter.Add(3.0);
+  EXPECT_EQ(3U, counter.count());
+  EXPECT_DOUBLE_EQ(3.0, counter.mean_ms());
+  EXPECT_DOUBLE_EQ(5.0, counter.max_ms());
+}
+}  // namespace v2x
+}  // namespace apollo
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 namespace apollo {
@@ -41,6 +42,10 @@ class ObuInterFaceBase {
   virtual void SendCarStatusToObu(const std::shared_ptr<CarStatus> &msg) {}
   virtual void SendObstaclesToObu(
       const std::shared_ptr<apollo::perception::PerceptionObstacles> &msg) {}
+  virtual void SetV2xTrafficLightCallback(
+      const std::function<
+          void(const std::shared_ptr<IntersectionTrafficLightData> &)>
+          &callback) {}
 };
 
 }  // namespace v2x
@@ -31,10 +31,16 @@ using grpc::ServerBuilder;
 
 ObuInterFaceGrpcImpl::ObuInterFaceGrpcImpl() {
   AINFO << "ObuInterFaceGrpcImpl Start Construct.";
-  grpc_client_ = std::make_shared<GrpcClientImpl>(
+  auto channel =
       grpc::CreateChannel(FLAGS_grpc_client_host + ":" + FLAGS_grpc_client_port,
-                          grpc::InsecureChannelCredentials()));
+                          grpc::InsecureChannelCredentials());
+  grpc_client_ = std::make_shared<GrpcClientImpl>(channel);
   grpc_client_init_flag_ = grpc_client_->InitFlag();
+  if (FLAGS_v2x_carstatus_streaming) {
+    grpc_stream_client_ = std::make_shared<GrpcStreamClientImpl>(channel);
+    grpc_client_init_flag_ =
+        grpc_client_init_flag_ && grpc_stream_client_->InitFlag();
+  }
   bool res_client = InitialClient();
   CHECK(res_client) << "ObuInterFaceGrpcImpl grpc client initial failed";
   grpc_server_ = std::make_shared<GrpcServerImpl>();
@@ -45,9 +51,6 @@ ObuInterFaceGrpcImpl::ObuInterFaceGrpcImpl() {
 }
 
 ObuInterFaceGrpcImpl::~ObuInterFaceGrpcImpl() {
-  // if (server_ != nullptr) {
-  //     server_->Shutdown();
-  // }
   if (thread_ptr_ == nullptr) {
     AINFO << "close obu interface success";
     return;
@@ -55,8 +58,15 @@ ObuInterFaceGrpcImpl::~ObuInterFaceGrpcImpl() {
   {
     std::unique_lock<std::mutex> lck(mutex_);
     exit_flag_ = true;
+    // the streams have to stop before the completion queue shuts down
+    grpc_server_->StopStreams();
+    if (server_ != nullptr) {
+      server_->Shutdown();
+    }
+    if (cq_ != nullptr) {
+      cq_->Shutdown();
+    }
   }
-  condition_.notify_all();
   thread_ptr_->join();
   AINFO << "close obu interface success";
 }
@@ -75,6 +85,9 @@ bool ObuInterFaceGrpcImpl::InitialServer() {
 
 void ObuInterFaceGrpcImpl::ThreadRunServer() {
   std::unique_lock<std::mutex> lck(mutex_);
+  if (exit_flag_) {
+    return;
+  }
   auto start = std::chrono::steady_clock::now();
   std::string server_address(FLAGS_grpc_server_host + ":" +
                              FLAGS_grpc_server_port);
@@ -82,18 +95,24 @@ void ObuInterFaceGrpcImpl::ThreadRunServer() {
   // Listen on the given address without any authentication mechanism.
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
   // Register "service" as the instance through which we'll communicate with
-  // clients. In this case it corresponds to an *synchronous* service.
+  // clients. Its unary methods are *synchronous*, its streaming method is
+  // served on the completion queue.
   builder.RegisterService(grpc_server_.get());
+  cq_ = builder.AddCompletionQueue();
   // Finally assemble the server.
   auto tmp = builder.BuildAndStart();
   server_ = std::move(tmp);
+  if (server_ == nullptr) {
+    AERROR << "ObuInterFaceGrpcImpl grpc server failed to listen on : "
+           << server_address;
+    return;
+  }
   auto end = std::chrono::steady_clock::now();
   std::chrono::duration<double> time_used = end - start;
   AINFO << "ObuInterFaceGrpcImpl grpc server has listening on : "
         << server_address << " time used : " << time_used.count();
-  condition_.wait(lck, [&]() { return exit_flag_; });
-  // server_->Wait();
-  // cyber::Spin();
+  lck.unlock();
+  grpc_server_->HandleStreams(cq_.get());
 }
 
 void ObuInterFaceGrpcImpl::GetV2xObstaclesFromObu(
@@ -107,12 +126,22 @@ void ObuInterFaceGrpcImpl::GetV2xTrafficLightFromObu(
 }
 void ObuInterFaceGrpcImpl::SendCarStatusToObu(
     const std::shared_ptr<CarStatus> &msg) {
+  if (grpc_stream_client_ != nullptr) {
+    grpc_stream_client_->SendMsgToGrpc(msg);
+    return;
+  }
   grpc_client_->SendMsgToGrpc(msg);
 }
 void ObuInterFaceGrpcImpl::SendObstaclesToObu(
     const std::shared_ptr<PerceptionObstacles> &msg) {
   grpc_client_->SendMsgToGrpc(msg);
 }
+void ObuInterFaceGrpcImpl::SetV2xTrafficLightCallback(
+    const std::function<
+        void(const std::shared_ptr<IntersectionTrafficLightData> &)>
+        &callback) {
+  grpc_server_->SetTrafficLightCallback(callback);
+}
 
 }  // namespace v2x
 }  // namespace apollo
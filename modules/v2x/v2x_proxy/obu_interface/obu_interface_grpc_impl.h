@@ -25,6 +25,7 @@
 
 #include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/grpc_client.h"
 #include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/grpc_server.h"
+#include "modules/v2x/v2x_proxy/obu_interface/grpc_interface/grpc_stream_client.h"
 #include "modules/v2x/v2x_proxy/obu_interface/obu_interface_abstract_class.h"
 
 namespace apollo {
@@ -68,6 +69,14 @@ class ObuInterFaceGrpcImpl : public ObuInterFaceBase {
       const std::shared_ptr<apollo::perception::PerceptionObstacles> &msg)
       override;
 
+  /* function that set the callback of every v2x traffic light received
+  @param input callback on the grpc thread the traffic light is received by
+  */
+  void SetV2xTrafficLightCallback(
+      const std::function<
+          void(const std::shared_ptr<IntersectionTrafficLightData> &)>
+          &callback) override;
+
   /* function that return init flag
    */
   bool InitFlag() { return init_succ_; }
@@ -77,7 +86,9 @@ class ObuInterFaceGrpcImpl : public ObuInterFaceBase {
    */
   void ThreadRunServer();
   std::shared_ptr<GrpcClientImpl> grpc_client_;
+  std::shared_ptr<GrpcStreamClientImpl> grpc_stream_client_;
   std::shared_ptr<GrpcServerImpl> grpc_server_;
+  std::unique_ptr<grpc::ServerCompletionQueue> cq_;
   std::unique_ptr<grpc::Server> server_;
 
   bool grpc_client_init_flag_ = false;
@@ -87,7 +98,6 @@ class ObuInterFaceGrpcImpl : public ObuInterFaceBase {
   bool exit_flag_ = false;
   std::unique_ptr<std::thread> thread_ptr_;
   std::mutex mutex_;
-  std::condition_variable condition_;
 };
 
 }  // namespace v2x